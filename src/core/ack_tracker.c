@@ -124,6 +124,7 @@ QuicAckTrackerAckPacket(
         // we just received, we consider it reordering.
         //
         Connection->Stats.Recv.ReorderedPackets++;
+        QuicSendShortenAckDelay(&Connection->Send);
     }
 
     if (!QuicRangeAddValue(&Tracker->PacketNumbersToAck, PacketNumber)) {
@@ -147,6 +148,20 @@ QuicAckTrackerAckPacket(
         Tracker->LargestPacketNumberRecvTime = RecvTimeUs;
     }
 
+    //
+    // The packet is the new largest one, but doesn't directly follow the
+    // previously received packet number, so there might have been loss.
+    //
+    const BOOLEAN GapBeforeLargest =
+        NewLargestPacketNumber &&
+        QuicRangeSize(&Tracker->PacketNumbersToAck) > 1 && // There are more than two ranges, i.e. a gap somewhere.
+        QuicRangeGet(
+            &Tracker->PacketNumbersToAck,
+            QuicRangeSize(&Tracker->PacketNumbersToAck) - 1)->Count == 1; // The gap is right before the last packet number.
+    if (GapBeforeLargest) {
+        QuicSendShortenAckDelay(&Connection->Send);
+    }
+
     switch (ECN) {
         case CXPLAT_ECN_ECT_1:
             Tracker->NonZeroRecvECN = TRUE;
@@ -159,6 +174,7 @@ QuicAckTrackerAckPacket(
         case CXPLAT_ECN_CE:
             Tracker->NonZeroRecvECN = TRUE;
             Tracker->ReceivedECN.CE_Count++;
+            QuicSendShortenAckDelay(&Connection->Send);
             break;
         default:
             break;
@@ -195,12 +211,7 @@ QuicAckTrackerAckPacket(
     if (AckType == QUIC_ACK_TYPE_ACK_IMMEDIATE ||
         Connection->Settings.MaxAckDelayMs == 0 ||
         (Tracker->AckElicitingPacketsToAcknowledge >= (uint16_t)Connection->PacketTolerance) ||
-        (!Connection->State.IgnoreReordering &&
-         (NewLargestPacketNumber &&
-          QuicRangeSize(&Tracker->PacketNumbersToAck) > 1 && // There are more than two ranges, i.e. a gap somewhere.
-            QuicRangeGet(
-            &Tracker->PacketNumbersToAck,
-          QuicRangeSize(&Tracker->PacketNumbersToAck) - 1)->Count == 1))) { // The gap is right before the last packet number.
+        (!Connection->State.IgnoreReordering && GapBeforeLargest)) {
         //
         // Send the ACK immediately.
         //
@@ -0,0 +1,234 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Library-wide 0-RTT anti-replay filter, used by servers that accept 0-RTT
+    when QUIC_PARAM_GLOBAL_ZERO_RTT_ANTI_REPLAY is set.
+
+    Each ClientHello random sets QUIC_ANTI_REPLAY_HASH_COUNT bits in the
+    current generation of its shard's bloom filter. A random whose bits are all
+    already set in either generation has (most likely) been seen before. When
+    the current generation is a window old, the older generation is cleared and
+    becomes the current one, so every random is remembered for at least one
+    window and at most two.
+
+--*/
+
+#include "precomp.h"
+#ifdef QUIC_CLOG
+#include "anti_replay.c.clog.h"
+#endif
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicAntiReplayInitialize(
+    _Out_ QUIC_ANTI_REPLAY* AntiReplay
+    )
+{
+    CxPlatZeroMemory(AntiReplay, sizeof(*AntiReplay));
+    for (uint32_t i = 0; i < QUIC_ANTI_REPLAY_SHARDS; ++i) {
+        CxPlatDispatchLockInitialize(&AntiReplay->Shards[i].Lock);
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicAntiReplayUninitialize(
+    _In_ QUIC_ANTI_REPLAY* AntiReplay
+    )
+{
+    for (uint32_t i = 0; i < QUIC_ANTI_REPLAY_SHARDS; ++i) {
+        if (AntiReplay->Shards[i].Bits != NULL) {
+            CXPLAT_FREE(AntiReplay->Shards[i].Bits, QUIC_POOL_ANTI_REPLAY);
+        }
+        CxPlatDispatchLockUninitialize(&AntiReplay->Shards[i].Lock);
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicAntiReplaySetConfig(
+    _In_ QUIC_ANTI_REPLAY* AntiReplay,
+    _In_ const QUIC_ZERO_RTT_ANTI_REPLAY* Config
+    )
+{
+    QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
+    uint64_t* NewBits[QUIC_ANTI_REPLAY_SHARDS] = {0};
+    uint64_t HashKeys[2] = {0};
+    uint32_t BitCount = 0;
+
+    if (Config->WindowMs != 0) {
+        if (Config->MaxEntries == 0 ||
+            Config->MaxEntries > QUIC_ZERO_RTT_ANTI_REPLAY_MAX_ENTRIES) {
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
+
+        //
+        // Size each generation of each shard for its share of the entries,
+        // rounded up to a power of 2 so bits can be picked with a mask.
+        //
+        const uint64_t MinBitCount =
+            ((uint64_t)Config->MaxEntries * QUIC_ANTI_REPLAY_BITS_PER_ENTRY) /
+            QUIC_ANTI_REPLAY_SHARDS;
+        BitCount = QUIC_ANTI_REPLAY_MIN_BITS;
+        while (BitCount < MinBitCount) {
+            BitCount <<= 1;
+        }
+
+        Status = CxPlatRandom(sizeof(HashKeys), HashKeys);
+        if (QUIC_FAILED(Status)) {
+            return Status;
+        }
+
+        const size_t Size = 2 * (size_t)(BitCount / 8);
+        for (uint32_t i = 0; i < QUIC_ANTI_REPLAY_SHARDS; ++i) {
+            NewBits[i] = CXPLAT_ALLOC_NONPAGED(Size, QUIC_POOL_ANTI_REPLAY);
+            if (NewBits[i] == NULL) {
+                QuicTraceEvent(
+                    AllocFailure,
+                    "Allocation of '%s' failed. (%llu bytes)",
+                    "anti-replay filter",
+                    Size);
+                Status = QUIC_STATUS_OUT_OF_MEMORY;
+                goto Exit;
+            }
+            CxPlatZeroMemory(NewBits[i], Size);
+        }
+    }
+
+    AntiReplay->HashKeys[0] = HashKeys[0];
+    AntiReplay->HashKeys[1] = HashKeys[1];
+
+    const uint64_t TimeNow = CxPlatTimeUs64();
+    for (uint32_t i = 0; i < QUIC_ANTI_REPLAY_SHARDS; ++i) {
+        QUIC_ANTI_REPLAY_SHARD* Shard = &AntiReplay->Shards[i];
+        CxPlatDispatchLockAcquire(&Shard->Lock);
+        uint64_t* OldBits = Shard->Bits;
+        Shard->Bits = NewBits[i];
+        Shard->BitCount = BitCount;
+        Shard->Current = 0;
+        Shard->GenerationStartUs = TimeNow;
+        Shard->WindowUs = MS_TO_US((uint64_t)Config->WindowMs);
+        CxPlatDispatchLockRelease(&Shard->Lock);
+        NewBits[i] = OldBits; // Freed below.
+    }
+    AntiReplay->Config = *Config;
+
+Exit:
+
+    for (uint32_t i = 0; i < QUIC_ANTI_REPLAY_SHARDS; ++i) {
+        if (NewBits[i] != NULL) {
+            CXPLAT_FREE(NewBits[i], QUIC_POOL_ANTI_REPLAY);
+        }
+    }
+
+    return Status;
+}
+
+//
+// Finalizes a 64-bit hash (the murmur3 mixer).
+//
+static
+uint64_t
+QuicAntiReplayMix(
+    _In_ uint64_t Value
+    )
+{
+    Value ^= Value >> 33;
+    Value *= 0xff51afd7ed558ccdull;
+    Value ^= Value >> 33;
+    Value *= 0xc4ceb9fe1a85ec53ull;
+    Value ^= Value >> 33;
+    return Value;
+}
+
+//
+// Hashes the whole random, one word at a time, with the given key.
+//
+static
+uint64_t
+QuicAntiReplayHash(
+    _In_reads_(QUIC_CLIENT_RANDOM_LENGTH / sizeof(uint64_t))
+        const uint64_t* Words,
+    _In_ uint64_t Key
+    )
+{
+    uint64_t Hash = Key;
+    for (uint32_t i = 0; i < QUIC_CLIENT_RANDOM_LENGTH / sizeof(uint64_t); ++i) {
+        Hash = QuicAntiReplayMix(Hash ^ Words[i]);
+    }
+    return Hash;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicAntiReplayCheck(
+    _In_ QUIC_ANTI_REPLAY* AntiReplay,
+    _In_reads_(QUIC_CLIENT_RANDOM_LENGTH)
+        const uint8_t* ClientRandom
+    )
+{
+    uint64_t Words[QUIC_CLIENT_RANDOM_LENGTH / sizeof(uint64_t)];
+    CxPlatCopyMemory(Words, ClientRandom, sizeof(Words));
+
+    //
+    // Double hashing: bit i is Hash1 + i * Hash2. The shard is picked by the
+    // high half of Hash1, which no filter is large enough to index with.
+    //
+    const uint64_t Hash1 = QuicAntiReplayHash(Words, AntiReplay->HashKeys[0]);
+    const uint64_t Hash2 = QuicAntiReplayHash(Words, AntiReplay->HashKeys[1]) | 1;
+
+    QUIC_ANTI_REPLAY_SHARD* Shard =
+        &AntiReplay->Shards[(Hash1 >> 32) % QUIC_ANTI_REPLAY_SHARDS];
+    const uint64_t TimeNow = CxPlatTimeUs64();
+    BOOLEAN Fresh = FALSE;
+
+    CxPlatDispatchLockAcquire(&Shard->Lock);
+
+    if (Shard->Bits == NULL) {
+        Fresh = TRUE; // Disabled.
+        goto Exit;
+    }
+
+    const uint64_t Elapsed = CxPlatTimeDiff64(Shard->GenerationStartUs, TimeNow);
+    if (Elapsed >= Shard->WindowUs) {
+        const uint32_t Words64 = Shard->BitCount / 64;
+        if (Elapsed >= 2 * Shard->WindowUs) {
+            CxPlatZeroMemory(Shard->Bits, 2 * (size_t)Words64 * sizeof(uint64_t));
+        } else {
+            Shard->Current ^= 1;
+            CxPlatZeroMemory(
+                Shard->Bits + Shard->Current * Words64,
+                (size_t)Words64 * sizeof(uint64_t));
+        }
+        Shard->GenerationStartUs = TimeNow;
+    }
+
+    const uint64_t Mask = Shard->BitCount - 1;
+    uint64_t* Current = Shard->Bits + Shard->Current * (Shard->BitCount / 64);
+    uint64_t* Previous = Shard->Bits + (Shard->Current ^ 1) * (Shard->BitCount / 64);
+    BOOLEAN InCurrent = TRUE, InPrevious = TRUE;
+
+    for (uint32_t i = 0; i < QUIC_ANTI_REPLAY_HASH_COUNT; ++i) {
+        const uint64_t Bit = (Hash1 + i * Hash2) & Mask;
+        const uint64_t Flag = 1ull << (Bit % 64);
+        if (!(Current[Bit / 64] & Flag)) {
+            InCurrent = FALSE;
+            Current[Bit / 64] |= Flag;
+        }
+        if (!(Previous[Bit / 64] & Flag)) {
+            InPrevious = FALSE;
+        }
+    }
+
+    Fresh = !InCurrent && !InPrevious;
+
+Exit:
+
+    CxPlatDispatchLockRelease(&Shard->Lock);
+
+    return Fresh;
+}
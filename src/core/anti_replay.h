@@ -0,0 +1,97 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+--*/
+
+#pragma once
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+typedef struct QUIC_CACHEALIGN QUIC_ANTI_REPLAY_SHARD {
+
+    CXPLAT_DISPATCH_LOCK Lock;
+
+    //
+    // The two generations of the shard's bloom filter, each BitCount bits, in
+    // one allocation. NULL when the filter is disabled.
+    //
+    uint64_t* Bits;
+    uint32_t BitCount;
+
+    //
+    // The generation new ClientHellos are added to, and when it started.
+    //
+    uint8_t Current;
+    uint64_t GenerationStartUs;
+    uint64_t WindowUs;
+
+} QUIC_ANTI_REPLAY_SHARD;
+
+//
+// A time-windowed filter of the ClientHello randoms of resumed handshakes on
+// servers that accept 0-RTT. A ClientHello seen before within the window is a
+// replay, so its resumption (and 0-RTT) is rejected. Each shard is a pair of
+// bloom filters, covering the current and previous window; the older one is
+// cleared whenever a window ends. False positives only cost a full handshake.
+// Shards are picked by a keyed hash of the random, and each has its own lock.
+//
+typedef struct QUIC_ANTI_REPLAY {
+
+    //
+    // The configuration last set. WindowMs is zero when disabled.
+    //
+    QUIC_ZERO_RTT_ANTI_REPLAY Config;
+
+    //
+    // Random keys for the hashes of the randoms, so that clients can't choose
+    // which shard they go to or which bits their ClientHellos set. Only
+    // changed while every shard is reset, so they're read without a lock.
+    //
+    uint64_t HashKeys[2];
+
+    QUIC_ANTI_REPLAY_SHARD Shards[QUIC_ANTI_REPLAY_SHARDS];
+
+} QUIC_ANTI_REPLAY;
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicAntiReplayInitialize(
+    _Out_ QUIC_ANTI_REPLAY* AntiReplay
+    );
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicAntiReplayUninitialize(
+    _In_ QUIC_ANTI_REPLAY* AntiReplay
+    );
+
+//
+// Enables, resizes or (with a zero window) disables the filter. Any
+// ClientHellos already recorded are forgotten.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicAntiReplaySetConfig(
+    _In_ QUIC_ANTI_REPLAY* AntiReplay,
+    _In_ const QUIC_ZERO_RTT_ANTI_REPLAY* Config
+    );
+
+//
+// Records the ClientHello random and returns TRUE if it wasn't seen within
+// the window (or the filter is disabled). Returns FALSE for a likely replay.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicAntiReplayCheck(
+    _In_ QUIC_ANTI_REPLAY* AntiReplay,
+    _In_reads_(QUIC_CLIENT_RANDOM_LENGTH)
+        const uint8_t* ClientRandom
+    );
+
+#if defined(__cplusplus)
+}
+#endif
@@ -990,100 +990,26 @@ Error:
     return Status;
 }
 
+//
+// Appends a chain of send requests to the stream's API send queue and either
+// flushes it inline or queues an operation to do so. On failure, the caller
+// still owns the send requests.
+//
 _IRQL_requires_max_(DISPATCH_LEVEL)
+static
 QUIC_STATUS
-QUIC_API
-MsQuicStreamSend(
-    _In_ _Pre_defensive_ HQUIC Handle,
-    _In_reads_(BufferCount) _Pre_defensive_
-        const QUIC_BUFFER * const Buffers,
-    _In_ uint32_t BufferCount,
-    _In_ QUIC_SEND_FLAGS Flags,
-    _In_opt_ void* ClientSendContext
+QuicStreamQueueApiSendRequests(
+    _In_ QUIC_STREAM* Stream,
+    _In_ QUIC_SEND_REQUEST* SendRequests,
+    _In_ BOOLEAN IsPriority
     )
 {
     QUIC_STATUS Status;
-    QUIC_STREAM* Stream;
-    QUIC_CONNECTION* Connection;
-    uint64_t TotalLength;
-    QUIC_SEND_REQUEST* SendRequest;
+    QUIC_CONNECTION* Connection = Stream->Connection;
     BOOLEAN QueueOper = TRUE;
-    const BOOLEAN IsPriority = !!(Flags & QUIC_SEND_FLAG_PRIORITY_WORK);
     BOOLEAN SendInline;
     QUIC_OPERATION* Oper;
 
-    QuicTraceEvent(
-        ApiEnter,
-        "[ api] Enter %u (%p).",
-        QUIC_TRACE_API_STREAM_SEND,
-        Handle);
-
-    if (!IS_STREAM_HANDLE(Handle) ||
-        (Buffers == NULL && BufferCount != 0)) {
-        Status = QUIC_STATUS_INVALID_PARAMETER;
-        goto Exit;
-    }
-
-#pragma prefast(suppress: __WARNING_25024, "Pointer cast already validated.")
-    Stream = (QUIC_STREAM*)Handle;
-
-    CXPLAT_TEL_ASSERT(!Stream->Flags.HandleClosed);
-    CXPLAT_TEL_ASSERT(!Stream->Flags.Freed);
-
-    Connection = Stream->Connection;
-
-    QUIC_CONN_VERIFY(Connection, !Connection->State.Freed);
-    QUIC_CONN_VERIFY(Connection,
-        (Connection->WorkerThreadID == CxPlatCurThreadID()) ||
-        !Connection->State.HandleClosed);
-
-    if (Connection->State.ClosedRemotely) {
-        Status = QUIC_STATUS_ABORTED;
-        goto Exit;
-    }
-
-    TotalLength = 0;
-    for (uint32_t i = 0; i < BufferCount; ++i) {
-        TotalLength += Buffers[i].Length;
-    }
-
-    if (TotalLength > UINT32_MAX) {
-        QuicTraceEvent(
-            StreamError,
-            "[strm][%p] ERROR, %s.",
-            Stream,
-            "Send request total length exceeds max");
-        Status = QUIC_STATUS_INVALID_PARAMETER;
-        goto Exit;
-    }
-
-#pragma prefast(suppress: __WARNING_6014, "Memory is correctly freed (QuicStreamCompleteSendRequest).")
-    SendRequest = CxPlatPoolAlloc(&Connection->Worker->SendRequestPool);
-    if (SendRequest == NULL) {
-        Status = QUIC_STATUS_OUT_OF_MEMORY;
-        QuicTraceEvent(
-            AllocFailure,
-            "Allocation of '%s' failed. (%llu bytes)",
-            "Stream Send request",
-            0);
-        goto Exit;
-    }
-
-    QuicTraceEvent(
-        StreamAppSend,
-        "[strm][%p] App queuing send [%llu bytes, %u buffers, 0x%x flags]",
-        Stream,
-        TotalLength,
-        BufferCount,
-        Flags);
-
-    SendRequest->Next = NULL;
-    SendRequest->Buffers = Buffers;
-    SendRequest->BufferCount = BufferCount;
-    SendRequest->Flags = Flags & ~QUIC_SEND_FLAGS_INTERNAL;
-    SendRequest->TotalLength = TotalLength;
-    SendRequest->ClientContext = ClientSendContext;
-
 #pragma warning(push)
 #pragma warning(disable:6240) // CXPLAT_AT_DISPATCH only really does anything for kernel mode
     SendInline =
@@ -1104,7 +1030,7 @@ MsQuicStreamSend(
             ApiSendRequestsTail = &((*ApiSendRequestsTail)->Next);
             QueueOper = FALSE; // Not necessary if the previous send hasn't been flushed yet.
         }
-        *ApiSendRequestsTail = SendRequest;
+        *ApiSendRequestsTail = SendRequests;
         Status = QUIC_STATUS_SUCCESS;
 
         if (!SendInline && QueueOper) {
@@ -1119,8 +1045,7 @@ MsQuicStreamSend(
     CxPlatDispatchLockRelease(&Stream->ApiSendRequestLock);
 
     if (QUIC_FAILED(Status)) {
-        CxPlatPoolFree(&Connection->Worker->SendRequestPool, SendRequest);
-        goto Exit;
+        return Status; // The caller still owns the send requests.
     }
 
     //
@@ -1164,7 +1089,7 @@ MsQuicStreamSend(
             //
             if (InterlockedCompareExchange16(
                     (short*)&Connection->BackUpOperUsed, 1, 0) != 0) {
-                goto Exit; // It's already started the shutdown.
+                return Status; // It's already started the shutdown.
             }
             Oper = &Connection->BackUpOper;
             Oper->FreeAfterProcess = FALSE;
@@ -1176,7 +1101,7 @@ MsQuicStreamSend(
             Oper->API_CALL.Context->CONN_SHUTDOWN.RegistrationShutdown = FALSE;
             Oper->API_CALL.Context->CONN_SHUTDOWN.TransportShutdown = TRUE;
             QuicConnQueueHighestPriorityOper(Connection, Oper);
-            goto Exit;
+            return Status;
         }
 
         Oper->API_CALL.Context->Type = QUIC_API_TYPE_STRM_SEND;
@@ -1192,38 +1117,38 @@ MsQuicStreamSend(
         }
     }
 
-Exit:
-
-    QuicTraceEvent(
-        ApiExitStatus,
-        "[ api] Exit %u",
-        Status);
-
     return Status;
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
 QUIC_STATUS
 QUIC_API
-MsQuicStreamReceiveSetEnabled(
+MsQuicStreamSend(
     _In_ _Pre_defensive_ HQUIC Handle,
-    _In_ BOOLEAN IsEnabled
+    _In_reads_(BufferCount) _Pre_defensive_
+        const QUIC_BUFFER * const Buffers,
+    _In_ uint32_t BufferCount,
+    _In_ QUIC_SEND_FLAGS Flags,
+    _In_opt_ void* ClientSendContext
     )
 {
     QUIC_STATUS Status;
     QUIC_STREAM* Stream;
     QUIC_CONNECTION* Connection;
-    QUIC_OPERATION* Oper;
+    uint64_t TotalLength;
+    QUIC_SEND_REQUEST* SendRequest;
+    const BOOLEAN IsPriority = !!(Flags & QUIC_SEND_FLAG_PRIORITY_WORK);
 
     QuicTraceEvent(
         ApiEnter,
         "[ api] Enter %u (%p).",
-        QUIC_TRACE_API_STREAM_RECEIVE_SET_ENABLED,
+        QUIC_TRACE_API_STREAM_SEND,
         Handle);
 
-    if (!IS_STREAM_HANDLE(Handle)) {
+    if (!IS_STREAM_HANDLE(Handle) ||
+        (Buffers == NULL && BufferCount != 0)) {
         Status = QUIC_STATUS_INVALID_PARAMETER;
-        goto Error;
+        goto Exit;
     }
 
 #pragma prefast(suppress: __WARNING_25024, "Pointer cast already validated.")
@@ -1239,34 +1164,61 @@ MsQuicStreamReceiveSetEnabled(
         (Connection->WorkerThreadID == CxPlatCurThreadID()) ||
         !Connection->State.HandleClosed);
 
-    Oper = QuicOperationAlloc(Connection->Worker, QUIC_OPER_TYPE_API_CALL);
-    if (Oper == NULL) {
+    if (Connection->State.ClosedRemotely) {
+        Status = QUIC_STATUS_ABORTED;
+        goto Exit;
+    }
+
+    TotalLength = 0;
+    for (uint32_t i = 0; i < BufferCount; ++i) {
+        TotalLength += Buffers[i].Length;
+    }
+
+    if (TotalLength > UINT32_MAX) {
+        QuicTraceEvent(
+            StreamError,
+            "[strm][%p] ERROR, %s.",
+            Stream,
+            "Send request total length exceeds max");
+        Status = QUIC_STATUS_INVALID_PARAMETER;
+        goto Exit;
+    }
+
+#pragma prefast(suppress: __WARNING_6014, "Memory is correctly freed (QuicStreamCompleteSendRequest).")
+    SendRequest = CxPlatPoolAlloc(&Connection->Worker->SendRequestPool);
+    if (SendRequest == NULL) {
         Status = QUIC_STATUS_OUT_OF_MEMORY;
         QuicTraceEvent(
             AllocFailure,
             "Allocation of '%s' failed. (%llu bytes)",
-            "STRM_RECV_SET_ENABLED, operation",
+            "Stream Send request",
             0);
-        goto Error;
+        goto Exit;
     }
-    Oper->API_CALL.Context->Type = QUIC_API_TYPE_STRM_RECV_SET_ENABLED;
-    Oper->API_CALL.Context->STRM_RECV_SET_ENABLED.Stream = Stream;
-    Oper->API_CALL.Context->STRM_RECV_SET_ENABLED.IsEnabled = IsEnabled;
 
-    //
-    // Async stream operations need to hold a ref on the stream so that the
-    // stream isn't freed before the operation can be processed. The ref is
-    // released after the operation is processed.
-    //
-    QuicStreamAddRef(Stream, QUIC_STREAM_REF_OPERATION);
+    QuicTraceEvent(
+        StreamAppSend,
+        "[strm][%p] App queuing send [%llu bytes, %u buffers, 0x%x flags]",
+        Stream,
+        TotalLength,
+        BufferCount,
+        Flags);
 
-    //
-    // Queue the operation but don't wait for the completion.
-    //
-    QuicConnQueueOper(Connection, Oper);
-    Status = QUIC_STATUS_PENDING;
+    SendRequest->Next = NULL;
+    SendRequest->Buffers = Buffers;
+    SendRequest->BufferCount = BufferCount;
+    SendRequest->Flags = Flags & ~QUIC_SEND_FLAGS_INTERNAL;
+    SendRequest->TotalLength = TotalLength;
+    SendRequest->ClientContext = ClientSendContext;
+    SendRequest->SendTime =
+        Connection->LatencyHistograms != NULL ? CxPlatTimeUs64() : 0;
 
-Error:
+    Status = QuicStreamQueueApiSendRequests(Stream, SendRequest, IsPriority);
+    if (QUIC_FAILED(Status)) {
+        CxPlatPoolFree(&Connection->Worker->SendRequestPool, SendRequest);
+    }
+
+Exit:
 
     QuicTraceEvent(
         ApiExitStatus,
@@ -1277,27 +1229,596 @@ Error:
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
-void
+QUIC_STATUS
 QUIC_API
-MsQuicStreamReceiveComplete(
+MsQuicStreamSendBatch(
     _In_ _Pre_defensive_ HQUIC Handle,
-    _In_ uint64_t BufferLength
+    _In_reads_(RequestCount) _Pre_defensive_
+        const QUIC_STREAM_SEND_BATCH_REQUEST* Requests,
+    _In_ uint32_t RequestCount,
+    _In_ QUIC_SEND_FLAGS Flags,
+    _In_opt_ void* ClientSendContext
     )
 {
+    QUIC_STATUS Status;
     QUIC_STREAM* Stream;
-    QUIC_CONNECTION* Connection;
-    QUIC_OPERATION* Oper;
+    QUIC_CONNECTION* Connection = NULL;
+    QUIC_SEND_REQUEST* Head = NULL;
+    QUIC_SEND_REQUEST** Tail = &Head;
+    const BOOLEAN IsPriority = !!(Flags & QUIC_SEND_FLAG_PRIORITY_WORK);
 
     QuicTraceEvent(
         ApiEnter,
         "[ api] Enter %u (%p).",
-        QUIC_TRACE_API_STREAM_RECEIVE_COMPLETE,
+        QUIC_TRACE_API_STREAM_SEND_BATCH,
         Handle);
 
-    if (!IS_STREAM_HANDLE(Handle)) {
+    if (!IS_STREAM_HANDLE(Handle) ||
+        Requests == NULL ||
+        RequestCount == 0) {
+        Status = QUIC_STATUS_INVALID_PARAMETER;
+        goto Exit;
+    }
+
+#pragma prefast(suppress: __WARNING_25024, "Pointer cast already validated.")
+    Stream = (QUIC_STREAM*)Handle;
+
+    CXPLAT_TEL_ASSERT(!Stream->Flags.HandleClosed);
+    CXPLAT_TEL_ASSERT(!Stream->Flags.Freed);
+
+    Connection = Stream->Connection;
+
+    QUIC_CONN_VERIFY(Connection, !Connection->State.Freed);
+    QUIC_CONN_VERIFY(Connection,
+        (Connection->WorkerThreadID == CxPlatCurThreadID()) ||
+        !Connection->State.HandleClosed);
+
+    if (Connection->State.ClosedRemotely) {
+        Status = QUIC_STATUS_ABORTED;
         goto Exit;
     }
 
+    //
+    // Build the whole chain of send requests up front, so that the batch is
+    // queued with a single lock acquisition and (at most) one operation. All
+    // but the last request are marked as batched, so that only the last one
+    // indicates a send completion.
+    //
+    for (uint32_t i = 0; i < RequestCount; ++i) {
+        const QUIC_STREAM_SEND_BATCH_REQUEST* Request = &Requests[i];
+        if (Request->Buffers == NULL && Request->BufferCount != 0) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            goto Exit;
+        }
+
+        uint64_t TotalLength = 0;
+        for (uint32_t j = 0; j < Request->BufferCount; ++j) {
+            TotalLength += Request->Buffers[j].Length;
+        }
+        if (TotalLength > UINT32_MAX) {
+            QuicTraceEvent(
+                StreamError,
+                "[strm][%p] ERROR, %s.",
+                Stream,
+                "Send request total length exceeds max");
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            goto Exit;
+        }
+
+#pragma prefast(suppress: __WARNING_6014, "Memory is correctly freed (QuicStreamCompleteSendRequest).")
+        QUIC_SEND_REQUEST* SendRequest =
+            CxPlatPoolAlloc(&Connection->Worker->SendRequestPool);
+        if (SendRequest == NULL) {
+            Status = QUIC_STATUS_OUT_OF_MEMORY;
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "Stream Send request",
+                0);
+            goto Exit;
+        }
+
+        QUIC_SEND_FLAGS RequestFlags = Flags & ~QUIC_SEND_FLAGS_INTERNAL;
+        if (i != 0) {
+            RequestFlags &= ~QUIC_SEND_FLAG_START;
+        }
+        if (i != RequestCount - 1) {
+            RequestFlags &= ~QUIC_SEND_FLAG_FIN;
+            RequestFlags |= QUIC_SEND_FLAG_BATCHED;
+        }
+
+        QuicTraceEvent(
+            StreamAppSend,
+            "[strm][%p] App queuing send [%llu bytes, %u buffers, 0x%x flags]",
+            Stream,
+            TotalLength,
+            Request->BufferCount,
+            RequestFlags);
+
+        SendRequest->Next = NULL;
+        SendRequest->Buffers = Request->Buffers;
+        SendRequest->BufferCount = Request->BufferCount;
+        SendRequest->Flags = RequestFlags;
+        SendRequest->TotalLength = TotalLength;
+        SendRequest->ClientContext = ClientSendContext;
+        SendRequest->SendTime =
+            Connection->LatencyHistograms != NULL ? CxPlatTimeUs64() : 0;
+
+        *Tail = SendRequest;
+        Tail = &SendRequest->Next;
+    }
+
+    Status = QuicStreamQueueApiSendRequests(Stream, Head, IsPriority);
+    if (QUIC_SUCCEEDED(Status)) {
+        Head = NULL; // Ownership transferred.
+    }
+
+Exit:
+
+    while (Head != NULL) {
+        QUIC_SEND_REQUEST* SendRequest = Head;
+        Head = Head->Next;
+        CxPlatPoolFree(&Connection->Worker->SendRequestPool, SendRequest);
+    }
+
+    QuicTraceEvent(
+        ApiExitStatus,
+        "[ api] Exit %u",
+        Status);
+
+    return Status;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QUIC_API
+MsQuicStreamReceiveSetEnabled(
+    _In_ _Pre_defensive_ HQUIC Handle,
+    _In_ BOOLEAN IsEnabled
+    )
+{
+    QUIC_STATUS Status;
+    QUIC_STREAM* Stream;
+    QUIC_CONNECTION* Connection;
+    QUIC_OPERATION* Oper;
+
+    QuicTraceEvent(
+        ApiEnter,
+        "[ api] Enter %u (%p).",
+        QUIC_TRACE_API_STREAM_RECEIVE_SET_ENABLED,
+        Handle);
+
+    if (!IS_STREAM_HANDLE(Handle)) {
+        Status = QUIC_STATUS_INVALID_PARAMETER;
+        goto Error;
+    }
+
+#pragma prefast(suppress: __WARNING_25024, "Pointer cast already validated.")
+    Stream = (QUIC_STREAM*)Handle;
+
+    CXPLAT_TEL_ASSERT(!Stream->Flags.HandleClosed);
+    CXPLAT_TEL_ASSERT(!Stream->Flags.Freed);
+
+    Connection = Stream->Connection;
+
+    QUIC_CONN_VERIFY(Connection, !Connection->State.Freed);
+    QUIC_CONN_VERIFY(Connection,
+        (Connection->WorkerThreadID == CxPlatCurThreadID()) ||
+        !Connection->State.HandleClosed);
+
+    Oper = QuicOperationAlloc(Connection->Worker, QUIC_OPER_TYPE_API_CALL);
+    if (Oper == NULL) {
+        Status = QUIC_STATUS_OUT_OF_MEMORY;
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "STRM_RECV_SET_ENABLED, operation",
+            0);
+        goto Error;
+    }
+    Oper->API_CALL.Context->Type = QUIC_API_TYPE_STRM_RECV_SET_ENABLED;
+    Oper->API_CALL.Context->STRM_RECV_SET_ENABLED.Stream = Stream;
+    Oper->API_CALL.Context->STRM_RECV_SET_ENABLED.IsEnabled = IsEnabled;
+
+    //
+    // Async stream operations need to hold a ref on the stream so that the
+    // stream isn't freed before the operation can be processed. The ref is
+    // released after the operation is processed.
+    //
+    QuicStreamAddRef(Stream, QUIC_STREAM_REF_OPERATION);
+
+    //
+    // Queue the operation but don't wait for the completion.
+    //
+    QuicConnQueueOper(Connection, Oper);
+    Status = QUIC_STATUS_PENDING;
+
+Error:
+
+    QuicTraceEvent(
+        ApiExitStatus,
+        "[ api] Exit %u",
+        Status);
+
+    return Status;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QUIC_API
+MsQuicStreamProvideReceiveBuffers(
+    _In_ _Pre_defensive_ HQUIC Handle,
+    _In_ uint32_t BufferCount,
+    _In_reads_(BufferCount) _Pre_defensive_
+        const QUIC_BUFFER* Buffers
+    )
+{
+    QUIC_STATUS Status;
+    QUIC_STREAM* Stream;
+    QUIC_CONNECTION* Connection;
+    QUIC_OPERATION* Oper;
+    CXPLAT_LIST_ENTRY ChunkList;
+
+    CxPlatListInitializeHead(&ChunkList);
+
+    QuicTraceEvent(
+        ApiEnter,
+        "[ api] Enter %u (%p).",
+        QUIC_TRACE_API_STREAM_PROVIDE_RECEIVE_BUFFERS,
+        Handle);
+
+    if (!IS_STREAM_HANDLE(Handle) ||
+        BufferCount == 0 ||
+        Buffers == NULL) {
+        Status = QUIC_STATUS_INVALID_PARAMETER;
+        goto Error;
+    }
+
+#pragma prefast(suppress: __WARNING_25024, "Pointer cast already validated.")
+    Stream = (QUIC_STREAM*)Handle;
+
+    CXPLAT_TEL_ASSERT(!Stream->Flags.HandleClosed);
+    CXPLAT_TEL_ASSERT(!Stream->Flags.Freed);
+
+    Connection = Stream->Connection;
+
+    QUIC_CONN_VERIFY(Connection, !Connection->State.Freed);
+    QUIC_CONN_VERIFY(Connection,
+        (Connection->WorkerThreadID == CxPlatCurThreadID()) ||
+        !Connection->State.HandleClosed);
+
+    for (uint32_t i = 0; i < BufferCount; ++i) {
+        if (Buffers[i].Buffer == NULL ||
+            Buffers[i].Length == 0 ||
+            Buffers[i].Length > 0x7FFFFFFF) { // QUIC_RECV_CHUNK.AllocLength is 31 bits
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            goto Error;
+        }
+    }
+
+    //
+    // The chunk headers are allocated here so that the worker never has to
+    // fail the operation for lack of memory.
+    //
+    for (uint32_t i = 0; i < BufferCount; ++i) {
+        QUIC_RECV_CHUNK* Chunk =
+            CXPLAT_ALLOC_NONPAGED(sizeof(QUIC_RECV_CHUNK), QUIC_POOL_RECVBUF);
+        if (Chunk == NULL) {
+            Status = QUIC_STATUS_OUT_OF_MEMORY;
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "STRM_PROVIDE_RECV_BUFFERS, chunk",
+                sizeof(QUIC_RECV_CHUNK));
+            goto Error;
+        }
+        Chunk->AllocLength = Buffers[i].Length;
+        Chunk->ExternalReference = FALSE;
+        Chunk->Buffer = Buffers[i].Buffer;
+        CxPlatListInsertTail(&ChunkList, &Chunk->Link);
+    }
+
+    Oper = QuicOperationAlloc(Connection->Worker, QUIC_OPER_TYPE_API_CALL);
+    if (Oper == NULL) {
+        Status = QUIC_STATUS_OUT_OF_MEMORY;
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "STRM_PROVIDE_RECV_BUFFERS, operation",
+            0);
+        goto Error;
+    }
+    Oper->API_CALL.Context->Type = QUIC_API_TYPE_STRM_PROVIDE_RECV_BUFFERS;
+    Oper->API_CALL.Context->STRM_PROVIDE_RECV_BUFFERS.Stream = Stream;
+    CxPlatListInitializeHead(&Oper->API_CALL.Context->STRM_PROVIDE_RECV_BUFFERS.Chunks);
+    CxPlatListMoveItems(&ChunkList, &Oper->API_CALL.Context->STRM_PROVIDE_RECV_BUFFERS.Chunks);
+
+    //
+    // Async stream operations need to hold a ref on the stream so that the
+    // stream isn't freed before the operation can be processed. The ref is
+    // released after the operation is processed.
+    //
+    QuicStreamAddRef(Stream, QUIC_STREAM_REF_OPERATION);
+
+    //
+    // Queue the operation but don't wait for the completion.
+    //
+    QuicConnQueueOper(Connection, Oper);
+    Status = QUIC_STATUS_PENDING;
+
+Error:
+
+    while (!CxPlatListIsEmpty(&ChunkList)) {
+        CXPLAT_FREE(
+            CXPLAT_CONTAINING_RECORD(
+                CxPlatListRemoveHead(&ChunkList), QUIC_RECV_CHUNK, Link),
+            QUIC_POOL_RECVBUF);
+    }
+
+    QuicTraceEvent(
+        ApiExitStatus,
+        "[ api] Exit %u",
+        Status);
+
+    return Status;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QUIC_API
+MsQuicStreamReceiveComplete(
+    _In_ _Pre_defensive_ HQUIC Handle,
+    _In_ uint64_t BufferLength
+    )
+{
+    QUIC_STREAM* Stream;
+    QUIC_CONNECTION* Connection;
+    QUIC_OPERATION* Oper;
+
+    QuicTraceEvent(
+        ApiEnter,
+        "[ api] Enter %u (%p).",
+        QUIC_TRACE_API_STREAM_RECEIVE_COMPLETE,
+        Handle);
+
+    if (!IS_STREAM_HANDLE(Handle)) {
+        goto Exit;
+    }
+
+#pragma prefast(suppress: __WARNING_25024, "Pointer cast already validated.")
+    Stream = (QUIC_STREAM*)Handle;
+
+    CXPLAT_TEL_ASSERT(!Stream->Flags.HandleClosed);
+    CXPLAT_TEL_ASSERT(!Stream->Flags.Freed);
+
+    Connection = Stream->Connection;
+
+    QUIC_CONN_VERIFY(Connection, !Connection->State.Freed);
+    QUIC_CONN_VERIFY(Connection,
+        (Connection->WorkerThreadID == CxPlatCurThreadID()) ||
+        !Connection->State.HandleClosed);
+
+    QUIC_CONN_VERIFY(Connection,
+        (Stream->RecvPendingLength == 0) || // Stream might have been shutdown already
+        BufferLength <= Stream->RecvPendingLength);
+
+    QuicTraceEvent(
+        StreamAppReceiveCompleteCall,
+        "[strm][%p] Receive complete call [%llu bytes]",
+        Stream,
+        BufferLength);
+
+    InterlockedExchangeAdd64(
+        (int64_t*)&Stream->RecvCompletionLength, (int64_t)BufferLength);
+
+    if (Connection->WorkerThreadID == CxPlatCurThreadID() &&
+        Stream->Flags.ReceiveCallActive) {
+        goto Exit; // No need to queue a completion operation when run inline
+    }
+
+    Oper = InterlockedFetchAndClearPointer((void**)&Stream->ReceiveCompleteOperation);
+    if (Oper) {
+        //
+        // Async stream operations need to hold a ref on the stream so that the
+        // stream isn't freed before the operation can be processed. The ref is
+        // released after the operation is processed.
+        //
+        QuicStreamAddRef(Stream, QUIC_STREAM_REF_OPERATION);
+
+        //
+        // Queue the operation but don't wait for the completion.
+        //
+        QuicConnQueueOper(Connection, Oper);
+    }
+
+Exit:
+
+    QuicTraceEvent(
+        ApiExit,
+        "[ api] Exit");
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QUIC_API
+MsQuicStreamReceiveCompleteBatch(
+    _In_ _Pre_defensive_ HQUIC Handle,
+    _In_reads_(StreamCount) _Pre_defensive_
+        const HQUIC* Streams,
+    _In_reads_(StreamCount)
+        const uint64_t* BufferLengths,
+    _In_ uint32_t StreamCount
+    )
+{
+    QUIC_CONNECTION* Connection;
+    QUIC_STREAM** Pending = NULL;
+    uint32_t PendingCount = 0;
+
+    QuicTraceEvent(
+        ApiEnter,
+        "[ api] Enter %u (%p).",
+        QUIC_TRACE_API_STREAM_RECEIVE_COMPLETE_BATCH,
+        Handle);
+
+    if (!IS_CONN_HANDLE(Handle) ||
+        Streams == NULL ||
+        BufferLengths == NULL ||
+        StreamCount == 0 ||
+        StreamCount > UINT32_MAX / sizeof(QUIC_STREAM*)) {
+        goto Exit;
+    }
+
+#pragma prefast(suppress: __WARNING_25024, "Pointer cast already validated.")
+    Connection = (QUIC_CONNECTION*)Handle;
+
+    QUIC_CONN_VERIFY(Connection, !Connection->State.Freed);
+    QUIC_CONN_VERIFY(Connection,
+        (Connection->WorkerThreadID == CxPlatCurThreadID()) ||
+        !Connection->State.HandleClosed);
+
+    const BOOLEAN OnWorker = Connection->WorkerThreadID == CxPlatCurThreadID();
+    if (!OnWorker) {
+        //
+        // If this fails, each stream's own completion operation is queued
+        // instead.
+        //
+        Pending =
+            CXPLAT_ALLOC_NONPAGED(
+                StreamCount * sizeof(QUIC_STREAM*),
+                QUIC_POOL_STREAM_RECV_COMPLETE_BATCH);
+        if (Pending == NULL) {
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "Stream receive complete batch",
+                StreamCount * sizeof(QUIC_STREAM*));
+        }
+    }
+
+    for (uint32_t i = 0; i < StreamCount; ++i) {
+        if (!IS_STREAM_HANDLE(Streams[i])) {
+            continue;
+        }
+
+#pragma prefast(suppress: __WARNING_25024, "Pointer cast already validated.")
+        QUIC_STREAM* Stream = (QUIC_STREAM*)Streams[i];
+
+        CXPLAT_TEL_ASSERT(!Stream->Flags.HandleClosed);
+        CXPLAT_TEL_ASSERT(!Stream->Flags.Freed);
+        QUIC_CONN_VERIFY(Connection, Stream->Connection == Connection);
+        QUIC_CONN_VERIFY(Connection,
+            (Stream->RecvPendingLength == 0) || // Stream might have been shutdown already
+            BufferLengths[i] <= Stream->RecvPendingLength);
+
+        QuicTraceEvent(
+            StreamAppReceiveCompleteCall,
+            "[strm][%p] Receive complete call [%llu bytes]",
+            Stream,
+            BufferLengths[i]);
+
+        InterlockedExchangeAdd64(
+            (int64_t*)&Stream->RecvCompletionLength, (int64_t)BufferLengths[i]);
+
+        if (OnWorker && Stream->Flags.ReceiveCallActive) {
+            continue; // No need to queue a completion operation when run inline
+        }
+
+        QUIC_OPERATION* Oper =
+            InterlockedFetchAndClearPointer((void**)&Stream->ReceiveCompleteOperation);
+        if (Oper) {
+            //
+            // Async stream operations need to hold a ref on the stream so that
+            // the stream isn't freed before the operation can be processed.
+            // The ref is released after the operation is processed.
+            //
+            QuicStreamAddRef(Stream, QUIC_STREAM_REF_OPERATION);
+            if (Pending != NULL) {
+                //
+                // The stream's own operation stays claimed until the batch is
+                // processed, so any further completions are picked up then.
+                //
+                Pending[PendingCount++] = Stream;
+            } else {
+                QuicConnQueueOper(Connection, Oper);
+            }
+        }
+    }
+
+    if (PendingCount != 0) {
+        QUIC_OPERATION* Oper =
+            QuicOperationAlloc(Connection->Worker, QUIC_OPER_TYPE_API_CALL);
+        if (Oper != NULL) {
+            Oper->API_CALL.Context->Type = QUIC_API_TYPE_STRM_RECV_COMPLETE_BATCH;
+            Oper->API_CALL.Context->STRM_RECV_COMPLETE_BATCH.Streams = Pending;
+            Oper->API_CALL.Context->STRM_RECV_COMPLETE_BATCH.Count = PendingCount;
+            Pending = NULL; // Owned by the operation now.
+
+            //
+            // Queue the operation but don't wait for the completion.
+            //
+            QuicConnQueueOper(Connection, Oper);
+
+        } else {
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "STRM_RECV_COMPLETE_BATCH operation",
+                0);
+            for (uint32_t i = 0; i < PendingCount; ++i) {
+                QuicConnQueueOper(
+                    Connection,
+                    &Pending[i]->ReceiveCompleteOperationStorage);
+            }
+        }
+    }
+
+    if (Pending != NULL) {
+        CXPLAT_FREE(Pending, QUIC_POOL_STREAM_RECV_COMPLETE_BATCH);
+    }
+
+Exit:
+
+    QuicTraceEvent(
+        ApiExit,
+        "[ api] Exit");
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QUIC_API
+MsQuicStreamReceive(
+    _In_ _Pre_defensive_ HQUIC Handle,
+    _In_reads_(BufferCount) _Pre_defensive_
+        const QUIC_BUFFER* Buffers,
+    _In_ uint32_t BufferCount,
+    _Out_ _Pre_defensive_ uint64_t* BytesReceived,
+    _Out_opt_ QUIC_RECEIVE_FLAGS* Flags
+    )
+{
+    CXPLAT_PASSIVE_CODE();
+
+    QUIC_STATUS Status;
+    QUIC_STREAM* Stream;
+    QUIC_CONNECTION* Connection;
+    QUIC_RECEIVE_FLAGS LocalFlags;
+
+    QuicTraceEvent(
+        ApiEnter,
+        "[ api] Enter %u (%p).",
+        QUIC_TRACE_API_STREAM_RECEIVE,
+        Handle);
+
+    if (!IS_STREAM_HANDLE(Handle) ||
+        (Buffers == NULL && BufferCount != 0) ||
+        BytesReceived == NULL) {
+        Status = QUIC_STATUS_INVALID_PARAMETER;
+        goto Error;
+    }
+
+    if (Flags == NULL) {
+        Flags = &LocalFlags;
+    }
+
 #pragma prefast(suppress: __WARNING_25024, "Pointer cast already validated.")
     Stream = (QUIC_STREAM*)Handle;
 
@@ -1307,48 +1828,58 @@ MsQuicStreamReceiveComplete(
     Connection = Stream->Connection;
 
     QUIC_CONN_VERIFY(Connection, !Connection->State.Freed);
-    QUIC_CONN_VERIFY(Connection,
-        (Connection->WorkerThreadID == CxPlatCurThreadID()) ||
-        !Connection->State.HandleClosed);
-
-    QUIC_CONN_VERIFY(Connection,
-        (Stream->RecvPendingLength == 0) || // Stream might have been shutdown already
-        BufferLength <= Stream->RecvPendingLength);
 
-    QuicTraceEvent(
-        StreamAppReceiveCompleteCall,
-        "[strm][%p] Receive complete call [%llu bytes]",
-        Stream,
-        BufferLength);
+    if (Connection->WorkerThreadID == CxPlatCurThreadID()) {
+        //
+        // Execute this blocking API call inline if called on the worker thread.
+        //
+        BOOLEAN AlreadyInline = Connection->State.InlineApiExecution;
+        if (!AlreadyInline) {
+            Connection->State.InlineApiExecution = TRUE;
+        }
+        Status = QuicStreamReceiveInto(Stream, Buffers, BufferCount, BytesReceived, Flags);
+        if (!AlreadyInline) {
+            Connection->State.InlineApiExecution = FALSE;
+        }
+        goto Error;
+    }
 
-    InterlockedExchangeAdd64(
-        (int64_t*)&Stream->RecvCompletionLength, (int64_t)BufferLength);
+    QUIC_OPERATION Oper = { 0 };
+    QUIC_API_CONTEXT ApiCtx;
+    CXPLAT_EVENT CompletionEvent;
 
-    if (Connection->WorkerThreadID == CxPlatCurThreadID() &&
-        Stream->Flags.ReceiveCallActive) {
-        goto Exit; // No need to queue a completion operation when run inline
-    }
+    Oper.Type = QUIC_OPER_TYPE_API_CALL;
+    Oper.FreeAfterProcess = FALSE;
+    Oper.API_CALL.Context = &ApiCtx;
 
-    Oper = InterlockedFetchAndClearPointer((void**)&Stream->ReceiveCompleteOperation);
-    if (Oper) {
-        //
-        // Async stream operations need to hold a ref on the stream so that the
-        // stream isn't freed before the operation can be processed. The ref is
-        // released after the operation is processed.
-        //
-        QuicStreamAddRef(Stream, QUIC_STREAM_REF_OPERATION);
+    ApiCtx.Type = QUIC_API_TYPE_STRM_RECEIVE;
+    CxPlatEventInitialize(&CompletionEvent, TRUE, FALSE);
+    ApiCtx.Completed = &CompletionEvent;
+    ApiCtx.Status = &Status;
+    ApiCtx.STRM_RECEIVE.Stream = Stream;
+    ApiCtx.STRM_RECEIVE.Buffers = Buffers;
+    ApiCtx.STRM_RECEIVE.BufferCount = BufferCount;
+    ApiCtx.STRM_RECEIVE.BytesReceived = BytesReceived;
+    ApiCtx.STRM_RECEIVE.Flags = Flags;
 
-        //
-        // Queue the operation but don't wait for the completion.
-        //
-        QuicConnQueueOper(Connection, Oper);
-    }
+    //
+    // Queue the operation and wait for it to be processed.
+    //
+    QuicConnQueueOper(Connection, &Oper);
+    QuicTraceEvent(
+        ApiWaitOperation,
+        "[ api] Waiting on operation");
+    CxPlatEventWaitForever(CompletionEvent);
+    CxPlatEventUninitialize(CompletionEvent);
 
-Exit:
+Error:
 
     QuicTraceEvent(
-        ApiExit,
-        "[ api] Exit");
+        ApiExitStatus,
+        "[ api] Exit %u",
+        Status);
+
+    return Status;
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -1660,14 +2191,312 @@ MsQuicDatagramSend(
     SendRequest->Next = NULL;
     SendRequest->Buffers = Buffers;
     SendRequest->BufferCount = BufferCount;
-    SendRequest->Flags = Flags;
+    SendRequest->Flags = Flags & ~QUIC_SEND_FLAGS_INTERNAL;
     SendRequest->TotalLength = TotalLength;
     SendRequest->ClientContext = ClientSendContext;
 
-    Status = QuicDatagramQueueSend(&Connection->Datagram, SendRequest);
+    Status = QuicDatagramQueueSend(&Connection->Datagram, SendRequest, SendRequest);
+
+Error:
+
+    QuicTraceEvent(
+        ApiExitStatus,
+        "[ api] Exit %u",
+        Status);
+
+    return Status;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QUIC_API
+MsQuicDatagramSendBatch(
+    _In_ _Pre_defensive_ HQUIC Handle,
+    _In_reads_(DatagramCount) _Pre_defensive_
+        const QUIC_BUFFER* const Datagrams,
+    _In_ uint32_t DatagramCount,
+    _In_ QUIC_SEND_FLAGS Flags,
+    _In_reads_opt_(DatagramCount)
+        void* const* ClientSendContexts
+    )
+{
+    QUIC_STATUS Status;
+    QUIC_CONNECTION* Connection;
+    QUIC_SEND_REQUEST* Head = NULL;
+    QUIC_SEND_REQUEST** Tail = &Head;
+    QUIC_SEND_REQUEST* Last = NULL;
+
+    QuicTraceEvent(
+        ApiEnter,
+        "[ api] Enter %u (%p).",
+        QUIC_TRACE_API_DATAGRAM_SEND_BATCH,
+        Handle);
+
+    if (!IS_CONN_HANDLE(Handle) ||
+        Datagrams == NULL ||
+        DatagramCount == 0) {
+        Status = QUIC_STATUS_INVALID_PARAMETER;
+        goto Error;
+    }
+
+#pragma prefast(suppress: __WARNING_25024, "Pointer cast already validated.")
+    Connection = (QUIC_CONNECTION*)Handle;
+
+    CXPLAT_TEL_ASSERT(!Connection->State.Freed);
+
+    //
+    // Build the whole chain of send requests up front, so that the batch is
+    // queued with a single lock acquisition and operation.
+    //
+    for (uint32_t i = 0; i < DatagramCount; ++i) {
+#pragma prefast(suppress: __WARNING_6014, "Memory is correctly freed (...).")
+        QUIC_SEND_REQUEST* SendRequest =
+            CxPlatPoolAlloc(&Connection->Worker->SendRequestPool);
+        if (SendRequest == NULL) {
+            Status = QUIC_STATUS_OUT_OF_MEMORY;
+            goto Error;
+        }
+
+        SendRequest->Next = NULL;
+        SendRequest->Buffers = &Datagrams[i];
+        SendRequest->BufferCount = 1;
+        SendRequest->Flags = Flags & ~QUIC_SEND_FLAGS_INTERNAL;
+        SendRequest->TotalLength = Datagrams[i].Length;
+        SendRequest->ClientContext =
+            ClientSendContexts != NULL ? ClientSendContexts[i] : NULL;
+
+        *Tail = SendRequest;
+        Tail = &SendRequest->Next;
+        Last = SendRequest;
+    }
+
+    Status = QuicDatagramQueueSend(&Connection->Datagram, Head, Last);
+    Head = NULL; // Ownership transferred, even on failure.
+
+Error:
+
+    while (Head != NULL) {
+        QUIC_SEND_REQUEST* SendRequest = Head;
+        Head = Head->Next;
+        CxPlatPoolFree(&Connection->Worker->SendRequestPool, SendRequest);
+    }
+
+    QuicTraceEvent(
+        ApiExitStatus,
+        "[ api] Exit %u",
+        Status);
+
+    return Status;
+}
+
+//
+// Frees a stream opened by MsQuicStreamOpenAndSend that was never handed back
+// to the app, along with its (never flushed) initial send request.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+static
+void
+QuicStreamOpenAndSendAbandon(
+    _In_ __drv_freesMem(Mem) QUIC_STREAM* Stream
+    )
+{
+    if (Stream->ApiSendRequests != NULL) {
+        CxPlatPoolFree(
+            &Stream->Connection->Worker->SendRequestPool,
+            Stream->ApiSendRequests);
+        Stream->ApiSendRequests = NULL;
+    }
+    Stream->Flags.HandleClosed = TRUE;
+    Stream->Flags.ShutdownComplete = TRUE;
+    Stream->ClientCallbackHandler = NULL;
+    QuicStreamRelease(Stream, QUIC_STREAM_REF_APP);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QUIC_API
+MsQuicStreamOpenAndSend(
+    _In_ _Pre_defensive_ HQUIC Handle,
+    _Inout_updates_(RequestCount) _Pre_defensive_
+        QUIC_STREAM_OPEN_SEND_REQUEST* Requests,
+    _In_ uint32_t RequestCount
+    )
+{
+    QUIC_STATUS Status;
+    QUIC_CONNECTION* Connection;
+    QUIC_STREAM_OPEN_AND_SEND_ENTRY* Entries = NULL;
+    uint32_t StreamCount = 0;
+    BOOLEAN IsPriority = FALSE;
+
+    QuicTraceEvent(
+        ApiEnter,
+        "[ api] Enter %u (%p).",
+        QUIC_TRACE_API_STREAM_OPEN_AND_SEND,
+        Handle);
+
+    if (!IS_CONN_HANDLE(Handle) ||
+        Requests == NULL ||
+        RequestCount == 0 ||
+        RequestCount > UINT32_MAX / sizeof(QUIC_STREAM_OPEN_AND_SEND_ENTRY)) {
+        Status = QUIC_STATUS_INVALID_PARAMETER;
+        goto Error;
+    }
+
+    for (uint32_t i = 0; i < RequestCount; ++i) {
+        const QUIC_STREAM_OPEN_SEND_REQUEST* Request = &Requests[i];
+        if (Request->Handler == NULL ||
+            (Request->Buffers == NULL && Request->BufferCount != 0)) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            goto Error;
+        }
+        uint64_t TotalLength = 0;
+        for (uint32_t j = 0; j < Request->BufferCount; ++j) {
+            TotalLength += Request->Buffers[j].Length;
+        }
+        if (TotalLength > UINT32_MAX) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            goto Error;
+        }
+        if (Request->StartFlags & QUIC_STREAM_START_FLAG_PRIORITY_WORK) {
+            IsPriority = TRUE;
+        }
+    }
+
+#pragma prefast(suppress: __WARNING_25024, "Pointer cast already validated.")
+    Connection = (QUIC_CONNECTION*)Handle;
+
+    QUIC_CONN_VERIFY(Connection, !Connection->State.Freed);
+
+    BOOLEAN ClosedLocally = Connection->State.ClosedLocally;
+    if (ClosedLocally || Connection->State.ClosedRemotely) {
+        Status =
+            ClosedLocally ?
+            QUIC_STATUS_INVALID_STATE :
+            QUIC_STATUS_ABORTED;
+        goto Error;
+    }
+
+    Entries =
+        CXPLAT_ALLOC_NONPAGED(
+            RequestCount * sizeof(QUIC_STREAM_OPEN_AND_SEND_ENTRY),
+            QUIC_POOL_STREAM_OPEN_BATCH);
+    if (Entries == NULL) {
+        Status = QUIC_STATUS_OUT_OF_MEMORY;
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "Stream open batch",
+            RequestCount * sizeof(QUIC_STREAM_OPEN_AND_SEND_ENTRY));
+        goto Error;
+    }
+
+    //
+    // Open every stream and queue its initial send directly. Nothing else can
+    // reference these streams yet, so no locks are needed until the single
+    // operation is queued to start them all.
+    //
+    for (uint32_t i = 0; i < RequestCount; ++i) {
+        const QUIC_STREAM_OPEN_SEND_REQUEST* Request = &Requests[i];
+        QUIC_STREAM* Stream;
+
+        Status = QuicStreamInitialize(Connection, FALSE, Request->OpenFlags, &Stream);
+        if (QUIC_FAILED(Status)) {
+            goto Error;
+        }
+
+        Stream->ClientCallbackHandler = Request->Handler;
+        Stream->ClientContext = Request->Context;
+        Entries[StreamCount].Stream = Stream;
+        Entries[StreamCount].Flags = Request->StartFlags;
+        StreamCount++;
+
+#pragma prefast(suppress: __WARNING_6014, "Memory is correctly freed (QuicStreamCompleteSendRequest).")
+        QUIC_SEND_REQUEST* SendRequest =
+            CxPlatPoolAlloc(&Connection->Worker->SendRequestPool);
+        if (SendRequest == NULL) {
+            Status = QUIC_STATUS_OUT_OF_MEMORY;
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "Stream Send request",
+                0);
+            goto Error;
+        }
+
+        uint64_t TotalLength = 0;
+        for (uint32_t j = 0; j < Request->BufferCount; ++j) {
+            TotalLength += Request->Buffers[j].Length;
+        }
+
+        QuicTraceEvent(
+            StreamAppSend,
+            "[strm][%p] App queuing send [%llu bytes, %u buffers, 0x%x flags]",
+            Stream,
+            TotalLength,
+            Request->BufferCount,
+            Request->SendFlags);
+
+        //
+        // The start is driven by StartFlags, so a START send flag is dropped
+        // rather than having the flush try to start the stream a second time.
+        //
+        SendRequest->Next = NULL;
+        SendRequest->Buffers = Request->Buffers;
+        SendRequest->BufferCount = Request->BufferCount;
+        SendRequest->Flags =
+            Request->SendFlags & ~(QUIC_SEND_FLAGS_INTERNAL | QUIC_SEND_FLAG_START);
+        SendRequest->TotalLength = TotalLength;
+        SendRequest->ClientContext = Request->ClientSendContext;
+        SendRequest->SendTime =
+            Connection->LatencyHistograms != NULL ? CxPlatTimeUs64() : 0;
+        Stream->ApiSendRequests = SendRequest;
+    }
+
+    QUIC_OPERATION* Oper =
+        QuicOperationAlloc(Connection->Worker, QUIC_OPER_TYPE_API_CALL);
+    if (Oper == NULL) {
+        Status = QUIC_STATUS_OUT_OF_MEMORY;
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "STRM_OPEN_AND_SEND operation",
+            0);
+        goto Error;
+    }
+    Oper->API_CALL.Context->Type = QUIC_API_TYPE_STRM_OPEN_AND_SEND;
+    Oper->API_CALL.Context->STRM_OPEN_AND_SEND.Entries = Entries;
+    Oper->API_CALL.Context->STRM_OPEN_AND_SEND.Count = StreamCount;
+
+    for (uint32_t i = 0; i < StreamCount; ++i) {
+        //
+        // Each stream holds a ref for the operation, released once it has
+        // been processed, same as a separate StreamStart call.
+        //
+        QuicStreamAddRef(Entries[i].Stream, QUIC_STREAM_REF_OPERATION);
+        Requests[i].Stream = (HQUIC)Entries[i].Stream;
+    }
+    Entries = NULL; // Owned by the operation now.
+    StreamCount = 0;
+
+    //
+    // Queue the operation but don't wait for the completion.
+    //
+    if (IsPriority) {
+        QuicConnQueuePriorityOper(Connection, Oper);
+    } else {
+        QuicConnQueueOper(Connection, Oper);
+    }
+    Status = QUIC_STATUS_PENDING;
 
 Error:
 
+    for (uint32_t i = 0; i < StreamCount; ++i) {
+        QuicStreamOpenAndSendAbandon(Entries[i].Stream);
+    }
+    if (Entries != NULL) {
+        CXPLAT_FREE(Entries, QUIC_POOL_STREAM_OPEN_BATCH);
+    }
+
     QuicTraceEvent(
         ApiExitStatus,
         "[ api] Exit %u",
@@ -1821,3 +2650,40 @@ Error:
 
     return Status;
 }
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QUIC_API
+MsQuicExecutionGetEventQ(
+    _In_ uint16_t Index,
+    _Out_ QUIC_EVENTQ* EventQ
+    )
+{
+#ifdef _KERNEL_MODE
+    UNREFERENCED_PARAMETER(Index);
+    UNREFERENCED_PARAMETER(EventQ);
+    return QUIC_STATUS_NOT_SUPPORTED;
+#else
+    if (EventQ == NULL) {
+        return QUIC_STATUS_INVALID_PARAMETER;
+    }
+    return CxPlatWorkerPoolGetEventQHandle(&MsQuicLib.WorkerPool, Index, EventQ);
+#endif
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+uint32_t
+QUIC_API
+MsQuicExecutionPoll(
+    _In_ uint16_t Index,
+    _In_ uint32_t WaitTimeMs
+    )
+{
+#ifdef _KERNEL_MODE
+    UNREFERENCED_PARAMETER(Index);
+    UNREFERENCED_PARAMETER(WaitTimeMs);
+    return UINT32_MAX;
+#else
+    return CxPlatWorkerPoolPoll(&MsQuicLib.WorkerPool, Index, WaitTimeMs);
+#endif
+}
@@ -31,6 +31,17 @@ MsQuicRegistrationShutdown(
     _In_ _Pre_defensive_ QUIC_UINT62 ErrorCode
     );
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+uint32_t
+QUIC_API
+MsQuicRegistrationPollEvents(
+    _In_ _Pre_defensive_ HQUIC Handle,
+    _Out_writes_to_(EventCount, return) _Pre_defensive_
+        QUIC_QUEUED_EVENT* Events,
+    _In_ uint32_t EventCount,
+    _In_ uint32_t TimeoutMs
+    );
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 QUIC_STATUS
 QUIC_API
@@ -216,6 +227,30 @@ MsQuicStreamReceiveComplete(
     _In_ uint64_t BufferLength
     );
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QUIC_API
+MsQuicStreamReceiveCompleteBatch(
+    _In_ _Pre_defensive_ HQUIC Handle,
+    _In_reads_(StreamCount) _Pre_defensive_
+        const HQUIC* Streams,
+    _In_reads_(StreamCount)
+        const uint64_t* BufferLengths,
+    _In_ uint32_t StreamCount
+    );
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QUIC_API
+MsQuicStreamReceive(
+    _In_ _Pre_defensive_ HQUIC Handle,
+    _In_reads_(BufferCount) _Pre_defensive_
+        const QUIC_BUFFER* Buffers,
+    _In_ uint32_t BufferCount,
+    _Out_ _Pre_defensive_ uint64_t* BytesReceived,
+    _Out_opt_ QUIC_RECEIVE_FLAGS* Flags
+    );
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 QUIC_STATUS
 QUIC_API
@@ -224,6 +259,16 @@ MsQuicStreamReceiveSetEnabled(
     _In_ BOOLEAN IsEnabled
     );
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QUIC_API
+MsQuicStreamProvideReceiveBuffers(
+    _In_ _Pre_defensive_ HQUIC Stream,
+    _In_ uint32_t BufferCount,
+    _In_reads_(BufferCount) _Pre_defensive_
+        const QUIC_BUFFER* Buffers
+    );
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 QUIC_STATUS
 QUIC_API
@@ -262,6 +307,41 @@ MsQuicDatagramSend(
     _In_opt_ void* ClientSendContext
     );
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QUIC_API
+MsQuicDatagramSendBatch(
+    _In_ _Pre_defensive_ HQUIC Handle,
+    _In_reads_(DatagramCount) _Pre_defensive_
+        const QUIC_BUFFER* const Datagrams,
+    _In_ uint32_t DatagramCount,
+    _In_ QUIC_SEND_FLAGS Flags,
+    _In_reads_opt_(DatagramCount)
+        void* const* ClientSendContexts
+    );
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QUIC_API
+MsQuicStreamSendBatch(
+    _In_ _Pre_defensive_ HQUIC Handle,
+    _In_reads_(RequestCount) _Pre_defensive_
+        const QUIC_STREAM_SEND_BATCH_REQUEST* Requests,
+    _In_ uint32_t RequestCount,
+    _In_ QUIC_SEND_FLAGS Flags,
+    _In_opt_ void* ClientSendContext
+    );
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QUIC_API
+MsQuicStreamOpenAndSend(
+    _In_ _Pre_defensive_ HQUIC Handle,
+    _Inout_updates_(RequestCount) _Pre_defensive_
+        QUIC_STREAM_OPEN_SEND_REQUEST* Requests,
+    _In_ uint32_t RequestCount
+    );
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 QUIC_STATUS
 QUIC_API
@@ -278,3 +358,19 @@ MsQuicConnectionCertificateValidationComplete(
     _In_ BOOLEAN Result,
     _In_ QUIC_TLS_ALERT_CODES TlsAlert
     );
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QUIC_API
+MsQuicExecutionGetEventQ(
+    _In_ uint16_t Index,
+    _Out_ QUIC_EVENTQ* EventQ
+    );
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+uint32_t
+QUIC_API
+MsQuicExecutionPoll(
+    _In_ uint16_t Index,
+    _In_ uint32_t WaitTimeMs
+    );
@@ -26,6 +26,21 @@ typedef enum BBR_STATE {
 
 } BBR_STATE;
 
+//
+// The phases of the BBRv3 ProbeBw cycle
+//
+typedef enum BBR_PROBE_BW_PHASE {
+
+    BBR_PROBE_BW_PHASE_DOWN,
+
+    BBR_PROBE_BW_PHASE_CRUISE,
+
+    BBR_PROBE_BW_PHASE_REFILL,
+
+    BBR_PROBE_BW_PHASE_UP
+
+} BBR_PROBE_BW_PHASE;
+
 typedef enum RECOVERY_STATE {
 
     RECOVERY_STATE_NOT_RECOVERY = 0,
@@ -109,8 +124,74 @@ const uint32_t kBbrMaxBandwidthFilterLen = 10;
 
 const uint32_t kBbrMaxAckHeightFilterLen = 10;
 
+//
+// BBRv3 pacing and cwnd gains
+//
+const uint32_t kBbr3StartupPacingGain = GAIN_UNIT * 277 / 100;
+
+const uint32_t kBbr3StartupCwndGain = GAIN_UNIT * 2;
+
+const uint32_t kBbr3DrainPacingGain = GAIN_UNIT * 35 / 100;
+
+const uint32_t kBbr3CwndGain = GAIN_UNIT * 2;
+
+const uint32_t kBbr3ProbeDownPacingGain = GAIN_UNIT * 90 / 100;
+
+const uint32_t kBbr3ProbeUpPacingGain = GAIN_UNIT * 5 / 4;
+
+const uint32_t kBbr3ProbeUpCwndGain = GAIN_UNIT * 225 / 100;
+
+const uint32_t kBbr3ProbeRttCwndGain = GAIN_UNIT / 2;
+
+//
+// Multiplicative decrease applied to the BBRv3 bounds on congestion
+//
+const uint32_t kBbr3Beta = GAIN_UNIT * 7 / 10;
+
+//
+// Fraction of InflightHi left unused while cruising, to leave room for other
+// flows
+//
+const uint32_t kBbr3Headroom = GAIN_UNIT * 15 / 100;
+
+//
+// Loss and ECN-CE mark rates (in percent) above which BBRv3 considers inflight
+// too high
+//
+const uint32_t kBbr3LossThresholdPercent = 2;
+
+const uint32_t kBbr3EcnThresholdPercent = 50;
+
+//
+// The number of loss events in a round trip, with a loss rate over the
+// threshold, that ends STARTUP
+//
+const uint32_t kBbr3StartupFullLossCount = 6;
+
+//
+// The time between bandwidth probes is randomized between these
+//
+const uint64_t kBbr3ProbeBwMinWaitInUs = S_TO_US(2);
+
+const uint64_t kBbr3ProbeBwMaxWaitInUs = S_TO_US(3);
+
+//
+// Upper bound on the round trips between bandwidth probes, so as to be fair
+// to Reno/Cubic flows
+//
+const uint32_t kBbr3ProbeBwMaxRounds = 63;
+
+//
+// How often BBRv3 enters ProbeRtt
+//
+const uint32_t kBbr3ProbeRttIntervalInUs = S_TO_US(5);
+
+//
+// Updates the bandwidth filter with the delivery rate samples of the acked
+// packets. Returns the largest sample, or zero if there were none.
+//
 _IRQL_requires_max_(DISPATCH_LEVEL)
-void
+uint64_t
 BbrBandwidthFilterOnPacketAcked(
     _In_ BBR_BANDWIDTH_FILTER* b,
     _In_ const QUIC_ACK_EVENT* AckEvent,
@@ -122,6 +203,7 @@ BbrBandwidthFilterOnPacketAcked(
     }
 
     uint64_t TimeNow = AckEvent->TimeNow;
+    uint64_t MaxDeliveryRate = 0;
 
     QUIC_SENT_PACKET_METADATA* AckedPacketsIterator = AckEvent->AckedPackets;
     while (AckedPacketsIterator != NULL) {
@@ -172,6 +254,9 @@ BbrBandwidthFilterOnPacketAcked(
         }
 
         uint64_t DeliveryRate = CXPLAT_MIN(SendRate, AckRate);
+        if (DeliveryRate > MaxDeliveryRate) {
+            MaxDeliveryRate = DeliveryRate;
+        }
 
         QUIC_SLIDING_WINDOW_EXTREMUM_ENTRY Entry = (QUIC_SLIDING_WINDOW_EXTREMUM_ENTRY) { .Value = 0, .Time = 0 };
         QUIC_STATUS Status = QuicSlidingWindowExtremumGet(&b->WindowedMaxFilter, &Entry);
@@ -185,6 +270,8 @@ BbrBandwidthFilterOnPacketAcked(
             QuicSlidingWindowExtremumUpdateMax(&b->WindowedMaxFilter, DeliveryRate, RttCounter);
         }
     }
+
+    return MaxDeliveryRate;
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -201,6 +288,56 @@ BbrCongestionControlGetBandwidth(
     return 0;
 }
 
+//
+// The bandwidth used for pacing and the congestion window. For BBRv3 this is
+// the max bandwidth, bounded by the short-term BandwidthLo.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint64_t
+BbrCongestionControlGetModelBandwidth(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    uint64_t Bandwidth = BbrCongestionControlGetBandwidth(Cc);
+    if (Cc->Bbr.IsBbr3 && Cc->Bbr.BandwidthLo < Bandwidth) {
+        Bandwidth = Cc->Bbr.BandwidthLo;
+    }
+    return Bandwidth;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+BbrCongestionControlGetInflightWithHeadroom(
+    _In_ const QUIC_CONGESTION_CONTROL_BBR* Bbr
+    )
+{
+    if (Bbr->InflightHi == UINT32_MAX) {
+        return UINT32_MAX;
+    }
+    return Bbr->InflightHi - (uint32_t)((uint64_t)Bbr->InflightHi * kBbr3Headroom / GAIN_UNIT);
+}
+
+//
+// Returns the BBRv3 bound on bytes in flight. While cruising or probing RTT,
+// headroom is left below InflightHi. Otherwise, InflightHi is the bound.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+BbrCongestionControlGetInflightBound(
+    _In_ const QUIC_CONGESTION_CONTROL_BBR* Bbr
+    )
+{
+    uint32_t Bound;
+    if (Bbr->BbrState == BBR_STATE_PROBE_RTT ||
+        (Bbr->BbrState == BBR_STATE_PROBE_BW &&
+         Bbr->ProbeBwPhase == BBR_PROBE_BW_PHASE_CRUISE)) {
+        Bound = BbrCongestionControlGetInflightWithHeadroom(Bbr);
+    } else {
+        Bound = Bbr->InflightHi;
+    }
+    return CXPLAT_MIN(Bound, Bbr->InflightLo);
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 BOOLEAN
 BbrCongestionControlInRecovery(
@@ -225,14 +362,134 @@ BbrCongestionControlGetCongestionWindow(
     uint32_t MinCongestionWindow = kMinCwndInMss * DatagramPayloadLength;
 
     if (Bbr->BbrState == BBR_STATE_PROBE_RTT) {
+        if (Bbr->IsBbr3 && Bbr->MinRtt != UINT64_MAX) {
+            //
+            // BBRv3 only drains down to half the BDP to probe RTT.
+            //
+            uint64_t Bdp =
+                BbrCongestionControlGetModelBandwidth(Cc) * Bbr->MinRtt / kMicroSecsInSec / BW_UNIT;
+            uint64_t ProbeRttCwnd = Bdp * kBbr3ProbeRttCwndGain / GAIN_UNIT;
+            ProbeRttCwnd = CXPLAT_MIN(ProbeRttCwnd, Bbr->CongestionWindow);
+            ProbeRttCwnd = CXPLAT_MIN(ProbeRttCwnd, BbrCongestionControlGetInflightBound(Bbr));
+            return (uint32_t)CXPLAT_MAX(ProbeRttCwnd, MinCongestionWindow);
+        }
         return MinCongestionWindow;
     }
 
+    uint32_t CongestionWindow = Bbr->CongestionWindow;
+
     if (BbrCongestionControlInRecovery(Cc)) {
-        return CXPLAT_MIN(Bbr->CongestionWindow, Bbr->RecoveryWindow);
+        CongestionWindow = CXPLAT_MIN(CongestionWindow, Bbr->RecoveryWindow);
+    }
+
+    if (Bbr->IsBbr3) {
+        CongestionWindow = CXPLAT_MIN(CongestionWindow, BbrCongestionControlGetInflightBound(Bbr));
+        CongestionWindow = CXPLAT_MAX(CongestionWindow, MinCongestionWindow);
+    }
+
+    return CongestionWindow;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+BbrCongestionControlStartProbeBwDown(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint64_t TimeNow
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR *Bbr = &Cc->Bbr;
+
+    Bbr->ProbeBwPhase = BBR_PROBE_BW_PHASE_DOWN;
+    Bbr->ProbeBwPhaseStart = TimeNow;
+    Bbr->PacingGain = kBbr3ProbeDownPacingGain;
+    Bbr->CwndGain = kBbr3CwndGain;
+
+    //
+    // A new cycle starts: pick when to probe for bandwidth next.
+    //
+    uint32_t RandomValue = 0;
+    CxPlatRandom(sizeof(uint32_t), &RandomValue);
+    Bbr->CycleStart = TimeNow;
+    Bbr->RoundsSinceBwProbe = 0;
+    Bbr->BwProbeWait =
+        kBbr3ProbeBwMinWaitInUs +
+        RandomValue % (kBbr3ProbeBwMaxWaitInUs - kBbr3ProbeBwMinWaitInUs);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+BbrCongestionControlStartProbeBwCruise(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint64_t TimeNow
+    )
+{
+    Cc->Bbr.ProbeBwPhase = BBR_PROBE_BW_PHASE_CRUISE;
+    Cc->Bbr.ProbeBwPhaseStart = TimeNow;
+    Cc->Bbr.PacingGain = GAIN_UNIT;
+    Cc->Bbr.CwndGain = kBbr3CwndGain;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+BbrCongestionControlStartProbeBwRefill(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint64_t TimeNow
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR *Bbr = &Cc->Bbr;
+
+    //
+    // Forget the short-term bounds before probing, so that the probe can
+    // find out if more bandwidth is available.
+    //
+    Bbr->InflightLo = UINT32_MAX;
+    Bbr->BandwidthLo = UINT64_MAX;
+
+    Bbr->ProbeUpRounds = 0;
+    Bbr->ProbeUpAcked = 0;
+    Bbr->ProbeUpCount = UINT32_MAX;
+
+    Bbr->ProbeBwPhase = BBR_PROBE_BW_PHASE_REFILL;
+    Bbr->ProbeBwPhaseStart = TimeNow;
+    Bbr->PacingGain = GAIN_UNIT;
+    Bbr->CwndGain = kBbr3CwndGain;
+}
+
+//
+// Sets how fast InflightHi grows while probing up: the growth doubles every
+// round trip, starting at one MSS per round trip.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+BbrCongestionControlRaiseInflightHiSlope(
+    _In_ QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR *Bbr = &Cc->Bbr;
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+
+    const uint16_t DatagramPayloadLength =
+        QuicPathGetDatagramPayloadSize(&Connection->Paths[0]);
+
+    Bbr->ProbeUpCount =
+        CXPLAT_MAX(Bbr->CongestionWindow >> Bbr->ProbeUpRounds, (uint32_t)DatagramPayloadLength);
+    if (Bbr->ProbeUpRounds < 30) {
+        Bbr->ProbeUpRounds++;
     }
+}
 
-    return Bbr->CongestionWindow;
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+BbrCongestionControlStartProbeBwUp(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint64_t TimeNow
+    )
+{
+    Cc->Bbr.ProbeBwPhase = BBR_PROBE_BW_PHASE_UP;
+    Cc->Bbr.ProbeBwPhaseStart = TimeNow;
+    Cc->Bbr.PacingGain = kBbr3ProbeUpPacingGain;
+    Cc->Bbr.CwndGain = kBbr3ProbeUpCwndGain;
+    BbrCongestionControlRaiseInflightHiSlope(Cc);
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -245,6 +502,12 @@ BbrCongestionControlTransitToProbeBw(
     QUIC_CONGESTION_CONTROL_BBR *Bbr = &Cc->Bbr;
 
     Bbr->BbrState = BBR_STATE_PROBE_BW;
+
+    if (Bbr->IsBbr3) {
+        BbrCongestionControlStartProbeBwDown(Cc, CongestionEventTime);
+        return;
+    }
+
     Bbr->CwndGain = kCwndGain;
 
     uint32_t RandomValue = 0;
@@ -263,8 +526,8 @@ BbrCongestionControlTransitToStartup(
     )
 {
     Cc->Bbr.BbrState = BBR_STATE_STARTUP;
-    Cc->Bbr.PacingGain = kHighGain;
-    Cc->Bbr.CwndGain = kHighGain;
+    Cc->Bbr.PacingGain = Cc->Bbr.IsBbr3 ? kBbr3StartupPacingGain : kHighGain;
+    Cc->Bbr.CwndGain = Cc->Bbr.IsBbr3 ? kBbr3StartupCwndGain : kHighGain;
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -299,37 +562,6 @@ QuicConnLogBbr(
         BbrCongestionControlIsAppLimited(Cc));
 }
 
-_IRQL_requires_max_(DISPATCH_LEVEL)
-void
-BbrCongestionControlIndicateConnectionEvent(
-    _In_ QUIC_CONNECTION* const Connection,
-    _In_ const QUIC_CONGESTION_CONTROL* Cc
-    )
-{
-    const QUIC_CONGESTION_CONTROL_BBR* Bbr = &Cc->Bbr;
-    const QUIC_PATH* Path = &Connection->Paths[0];
-    QUIC_CONNECTION_EVENT Event;
-    Event.Type = QUIC_CONNECTION_EVENT_NETWORK_STATISTICS;
-    Event.NETWORK_STATISTICS.BytesInFlight = Bbr->BytesInFlight;
-    Event.NETWORK_STATISTICS.PostedBytes = Connection->SendBuffer.PostedBytes;
-    Event.NETWORK_STATISTICS.IdealBytes = Connection->SendBuffer.IdealBytes;
-    Event.NETWORK_STATISTICS.SmoothedRTT = Path->SmoothedRtt;
-    Event.NETWORK_STATISTICS.CongestionWindow = BbrCongestionControlGetCongestionWindow(Cc);
-    Event.NETWORK_STATISTICS.Bandwidth = BbrCongestionControlGetBandwidth(Cc) / BW_UNIT;
-
-    QuicTraceLogConnVerbose(
-        IndicateDataAcked,
-        Connection,
-        "Indicating QUIC_CONNECTION_EVENT_NETWORK_STATISTICS [BytesInFlight=%u,PostedBytes=%llu,IdealBytes=%llu,SmoothedRTT=%llu,CongestionWindow=%u,Bandwidth=%llu]",
-        Event.NETWORK_STATISTICS.BytesInFlight,
-        Event.NETWORK_STATISTICS.PostedBytes,
-        Event.NETWORK_STATISTICS.IdealBytes,
-        Event.NETWORK_STATISTICS.SmoothedRTT,
-        Event.NETWORK_STATISTICS.CongestionWindow,
-        Event.NETWORK_STATISTICS.Bandwidth);
-    QuicConnIndicateEvent(Connection, &Event);
-}
-
 _IRQL_requires_max_(DISPATCH_LEVEL)
 BOOLEAN
 BbrCongestionControlCanSend(
@@ -589,7 +821,7 @@ BbrCongestionControlGetTargetCwnd(
 {
     QUIC_CONGESTION_CONTROL_BBR* Bbr = &Cc->Bbr;
 
-    uint64_t BandwidthEst = BbrCongestionControlGetBandwidth(Cc);
+    uint64_t BandwidthEst = BbrCongestionControlGetModelBandwidth(Cc);
 
     if (!BandwidthEst || Bbr->MinRtt == UINT32_MAX) {
         return (uint64_t)(Gain) * Bbr->InitialCongestionWindow / GAIN_UNIT;
@@ -611,7 +843,7 @@ BbrCongestionControlGetSendAllowance(
     QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
     QUIC_CONGESTION_CONTROL_BBR* Bbr = &Cc->Bbr;
 
-    uint64_t BandwidthEst = BbrCongestionControlGetBandwidth(Cc);
+    uint64_t BandwidthEst = BbrCongestionControlGetModelBandwidth(Cc);
     uint32_t CongestionWindow = BbrCongestionControlGetCongestionWindow(Cc);
 
     uint32_t SendAllowance = 0;
@@ -682,8 +914,8 @@ BbrCongestionControlTransitToDrain(
     )
 {
     Cc->Bbr.BbrState = BBR_STATE_DRAIN;
-    Cc->Bbr.PacingGain = kDrainGain;
-    Cc->Bbr.CwndGain = kHighGain;
+    Cc->Bbr.PacingGain = Cc->Bbr.IsBbr3 ? kBbr3DrainPacingGain : kDrainGain;
+    Cc->Bbr.CwndGain = Cc->Bbr.IsBbr3 ? kBbr3StartupCwndGain : kHighGain;
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -695,7 +927,7 @@ BbrCongestionControlSetSendQuantum(
     QUIC_CONGESTION_CONTROL_BBR *Bbr = &Cc->Bbr;
     QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
 
-    uint64_t Bandwidth = BbrCongestionControlGetBandwidth(Cc);
+    uint64_t Bandwidth = BbrCongestionControlGetModelBandwidth(Cc);
 
     uint64_t PacingRate = Bandwidth * Bbr->PacingGain / GAIN_UNIT;
 
@@ -754,6 +986,298 @@ BbrCongestionControlUpdateCongestionWindow(
     QuicConnLogBbr(QuicCongestionControlGetConnection(Cc));
 }
 
+//
+// (BBRv3) Returns TRUE if the loss or ECN-CE mark rate in the current round
+// trip shows that there is too much data in flight.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+BbrCongestionControlIsInflightTooHigh(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    const QUIC_CONGESTION_CONTROL_BBR* Bbr = &Cc->Bbr;
+
+    if (Bbr->BytesLostInRound > 0) {
+        uint64_t Inflight =
+            (uint64_t)Bbr->BytesInFlight + Bbr->BytesDeliveredInRound + Bbr->BytesLostInRound;
+        if ((uint64_t)Bbr->BytesLostInRound * 100 > Inflight * kBbr3LossThresholdPercent) {
+            return TRUE;
+        }
+    }
+
+    if (Bbr->CePacketsInRound > 0) {
+        const QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+        const uint16_t DatagramPayloadLength =
+            QuicPathGetDatagramPayloadSize(&Connection->Paths[0]);
+        uint64_t PacketsDelivered =
+            CXPLAT_MAX(Bbr->BytesDeliveredInRound / DatagramPayloadLength, 1);
+        if (Bbr->CePacketsInRound * 100 > PacketsDelivered * kBbr3EcnThresholdPercent) {
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
+//
+// (BBRv3) Called when loss or ECN shows too much data in flight. While probing
+// for bandwidth, this caps InflightHi near the inflight that caused it and
+// stops the probe.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+BbrCongestionControlHandleInflightTooHigh(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint32_t InflightAtSignal,
+    _In_ uint64_t TimeNow
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR* Bbr = &Cc->Bbr;
+
+    if (Bbr->BbrState == BBR_STATE_STARTUP) {
+        //
+        // Persistent loss (or ECN) in STARTUP means the pipe is full, even if
+        // the bandwidth estimate is still growing.
+        //
+        if (Bbr->LossEventsInRound >= kBbr3StartupFullLossCount ||
+            Bbr->CePacketsInRound > 0) {
+            Bbr->BtlbwFound = TRUE;
+            Bbr->InflightHi =
+                CXPLAT_MAX(InflightAtSignal, BbrCongestionControlGetTargetCwnd(Cc, GAIN_UNIT));
+        }
+        return;
+    }
+
+    if (Bbr->BbrState != BBR_STATE_PROBE_BW ||
+        (Bbr->ProbeBwPhase != BBR_PROBE_BW_PHASE_REFILL &&
+         Bbr->ProbeBwPhase != BBR_PROBE_BW_PHASE_UP)) {
+        return;
+    }
+
+    if (!BbrCongestionControlIsAppLimited(Cc)) {
+        uint32_t TargetInflight =
+            (uint32_t)((uint64_t)BbrCongestionControlGetTargetCwnd(Cc, GAIN_UNIT) * kBbr3Beta / GAIN_UNIT);
+        Bbr->InflightHi = CXPLAT_MAX(InflightAtSignal, TargetInflight);
+    }
+
+    if (Bbr->ProbeBwPhase == BBR_PROBE_BW_PHASE_UP) {
+        BbrCongestionControlStartProbeBwDown(Cc, TimeNow);
+    }
+}
+
+//
+// (BBRv3) Called at the end of each round trip. Reduces the short-term bounds
+// if the round trip had loss or ECN, and starts tracking the next round trip.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+BbrCongestionControlOnRoundEnd(
+    _In_ QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR* Bbr = &Cc->Bbr;
+
+    BOOLEAN ProbingBandwidth =
+        Bbr->BbrState == BBR_STATE_STARTUP ||
+        (Bbr->BbrState == BBR_STATE_PROBE_BW &&
+         (Bbr->ProbeBwPhase == BBR_PROBE_BW_PHASE_REFILL ||
+          Bbr->ProbeBwPhase == BBR_PROBE_BW_PHASE_UP));
+
+    if (!ProbingBandwidth && (Bbr->LossInRound || Bbr->EcnInRound)) {
+        if (Bbr->BandwidthLo == UINT64_MAX) {
+            Bbr->BandwidthLo = BbrCongestionControlGetBandwidth(Cc);
+        }
+        if (Bbr->InflightLo == UINT32_MAX) {
+            Bbr->InflightLo = Bbr->CongestionWindow;
+        }
+        Bbr->BandwidthLo =
+            CXPLAT_MAX(Bbr->BandwidthLatest, Bbr->BandwidthLo * kBbr3Beta / GAIN_UNIT);
+        Bbr->InflightLo =
+            CXPLAT_MAX(
+                Bbr->BytesDeliveredInRound,
+                (uint32_t)((uint64_t)Bbr->InflightLo * kBbr3Beta / GAIN_UNIT));
+    }
+
+    if (Bbr->BbrState == BBR_STATE_PROBE_BW &&
+        Bbr->ProbeBwPhase == BBR_PROBE_BW_PHASE_UP) {
+        BbrCongestionControlRaiseInflightHiSlope(Cc);
+    }
+
+    Bbr->RoundsSinceBwProbe++;
+
+    Bbr->LossInRound = FALSE;
+    Bbr->EcnInRound = FALSE;
+    Bbr->BytesDeliveredInRound = 0;
+    Bbr->BandwidthLatest = 0;
+    Bbr->BytesLostInRound = 0;
+    Bbr->LossEventsInRound = 0;
+    Bbr->CePacketsInRound = 0;
+}
+
+//
+// (BBRv3) Grows InflightHi while probing up, if the flow is actually using
+// all of it.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+BbrCongestionControlProbeInflightHiUpward(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint32_t BytesAcked
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR* Bbr = &Cc->Bbr;
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+
+    if (Bbr->InflightHi == UINT32_MAX ||
+        BbrCongestionControlIsAppLimited(Cc) ||
+        Bbr->CongestionWindow < Bbr->InflightHi) {
+        return;
+    }
+
+    const uint16_t DatagramPayloadLength =
+        QuicPathGetDatagramPayloadSize(&Connection->Paths[0]);
+
+    Bbr->ProbeUpAcked += BytesAcked;
+    if (Bbr->ProbeUpAcked >= Bbr->ProbeUpCount) {
+        uint32_t Delta = Bbr->ProbeUpAcked / Bbr->ProbeUpCount;
+        Bbr->ProbeUpAcked -= Delta * Bbr->ProbeUpCount;
+        uint64_t InflightHi = (uint64_t)Bbr->InflightHi + (uint64_t)Delta * DatagramPayloadLength;
+        Bbr->InflightHi = (uint32_t)CXPLAT_MIN(InflightHi, UINT32_MAX - 1);
+    }
+}
+
+//
+// (BBRv3) Returns TRUE if it's time to probe for more bandwidth: either the
+// randomized wait has passed, or as many round trips as a Reno flow would take
+// to grow its window by the BDP.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+BbrCongestionControlIsTimeToProbeBw(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint64_t TimeNow
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR* Bbr = &Cc->Bbr;
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+
+    if (CxPlatTimeDiff64(Bbr->CycleStart, TimeNow) >= Bbr->BwProbeWait) {
+        return TRUE;
+    }
+
+    const uint16_t DatagramPayloadLength =
+        QuicPathGetDatagramPayloadSize(&Connection->Paths[0]);
+
+    uint32_t RenoRounds = BbrCongestionControlGetTargetCwnd(Cc, GAIN_UNIT) / DatagramPayloadLength;
+    return Bbr->RoundsSinceBwProbe >= CXPLAT_MIN(RenoRounds, kBbr3ProbeBwMaxRounds);
+}
+
+//
+// (BBRv3) Moves through the ProbeBw cycle: DOWN drains the queue built by the
+// last probe, CRUISE holds the rate with headroom for other flows, REFILL fills
+// the pipe for one round trip, and UP probes for more bandwidth.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+BbrCongestionControlUpdateProbeBwPhase(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ BOOLEAN NewRoundTrip,
+    _In_ uint64_t TimeNow,
+    _In_ uint32_t BytesAcked
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR* Bbr = &Cc->Bbr;
+
+    switch (Bbr->ProbeBwPhase) {
+    case BBR_PROBE_BW_PHASE_DOWN:
+        if (BbrCongestionControlIsTimeToProbeBw(Cc, TimeNow)) {
+            BbrCongestionControlStartProbeBwRefill(Cc, TimeNow);
+        } else if (
+            Bbr->BytesInFlight <=
+                CXPLAT_MIN(
+                    BbrCongestionControlGetTargetCwnd(Cc, GAIN_UNIT),
+                    BbrCongestionControlGetInflightWithHeadroom(Bbr))) {
+            BbrCongestionControlStartProbeBwCruise(Cc, TimeNow);
+        }
+        break;
+
+    case BBR_PROBE_BW_PHASE_CRUISE:
+        if (BbrCongestionControlIsTimeToProbeBw(Cc, TimeNow)) {
+            BbrCongestionControlStartProbeBwRefill(Cc, TimeNow);
+        }
+        break;
+
+    case BBR_PROBE_BW_PHASE_REFILL:
+        if (NewRoundTrip) {
+            BbrCongestionControlStartProbeBwUp(Cc, TimeNow);
+        }
+        break;
+
+    case BBR_PROBE_BW_PHASE_UP:
+        BbrCongestionControlProbeInflightHiUpward(Cc, BytesAcked);
+        if (CxPlatTimeDiff64(Bbr->ProbeBwPhaseStart, TimeNow) > Bbr->MinRtt &&
+            Bbr->BytesInFlight >= BbrCongestionControlGetTargetCwnd(Cc, kBbr3ProbeUpPacingGain)) {
+            BbrCongestionControlStartProbeBwDown(Cc, TimeNow);
+        }
+        break;
+    }
+}
+
+//
+// HyStart++ (RFC 9406) style delay increase detection for STARTUP. If the
+// minimum RTT of the current round trip exceeds the previous round's by more
+// than a (clamped) eighth, a queue is building at the bottleneck, so STARTUP
+// ends without waiting for bandwidth growth to stall. This keeps STARTUP from
+// overshooting into deep buffers.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+static
+void
+BbrCongestionControlCheckStartupDelayIncrease(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ BOOLEAN NewRoundTrip,
+    _In_ const QUIC_ACK_EVENT* AckEvent
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR* Bbr = &Cc->Bbr;
+
+    if (NewRoundTrip) {
+        Bbr->StartupMinRttInLastRound = Bbr->StartupMinRttInCurrentRound;
+        Bbr->StartupMinRttInCurrentRound = UINT64_MAX;
+        Bbr->StartupRttSampleCount = 0;
+    }
+
+    if (!AckEvent->MinRttValid) {
+        return;
+    }
+
+    Bbr->StartupMinRttInCurrentRound =
+        CXPLAT_MIN(Bbr->StartupMinRttInCurrentRound, AckEvent->MinRtt);
+    Bbr->StartupRttSampleCount++;
+
+    if (Bbr->StartupMinRttInLastRound == UINT64_MAX ||
+        Bbr->StartupRttSampleCount < QUIC_HYSTART_DEFAULT_N_SAMPLING) {
+        return;
+    }
+
+    const uint64_t Eta =
+        CXPLAT_MIN(
+            QUIC_HYSTART_DEFAULT_MAX_ETA,
+            CXPLAT_MAX(
+                QUIC_HYSTART_DEFAULT_MIN_ETA,
+                Bbr->StartupMinRttInLastRound / 8));
+    if (Bbr->StartupMinRttInCurrentRound >= Bbr->StartupMinRttInLastRound + Eta) {
+        QuicTraceLogConnInfo(
+            BbrStartupDelayExit,
+            QuicCongestionControlGetConnection(Cc),
+            "BBR startup exit on delay increase (MinRtt %llu us, last round %llu us)",
+            Bbr->StartupMinRttInCurrentRound,
+            Bbr->StartupMinRttInLastRound);
+        Bbr->BtlbwFound = TRUE;
+    }
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 BOOLEAN
 BbrCongestionControlOnDataAcknowledged(
@@ -771,7 +1295,11 @@ BbrCongestionControlOnDataAcknowledged(
             Cc, AckEvent->NumTotalAckedRetransmittableBytes, AckEvent->NumRetransmittableBytes);
 
         if (Connection->Settings.NetStatsEventEnabled) {
-            BbrCongestionControlIndicateConnectionEvent(Connection, Cc);
+            QuicCongestionControlIndicateNetworkStatistics(
+                Cc,
+                Bbr->BytesInFlight,
+                BbrCongestionControlGetCongestionWindow(Cc),
+                BbrCongestionControlGetBandwidth(Cc) / BW_UNIT);
         }
         return BbrCongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
     }
@@ -782,8 +1310,10 @@ BbrCongestionControlOnDataAcknowledged(
     Bbr->BytesInFlight -= AckEvent->NumRetransmittableBytes;
 
     if (AckEvent->MinRttValid) {
+        const uint32_t MinRttExpiration =
+            Bbr->IsBbr3 ? kBbr3ProbeRttIntervalInUs : kBbrMinRttExpirationInMicroSecs;
         Bbr->RttSampleExpired = Bbr->MinRttTimestampValid ?
-           CxPlatTimeAtOrBefore64(Bbr->MinRttTimestamp + kBbrMinRttExpirationInMicroSecs, AckEvent->TimeNow) :
+           CxPlatTimeAtOrBefore64(Bbr->MinRttTimestamp + MinRttExpiration, AckEvent->TimeNow) :
            FALSE;
         if (Bbr->RttSampleExpired || Bbr->MinRtt > AckEvent->MinRtt) {
             Bbr->MinRtt = AckEvent->MinRtt;
@@ -803,7 +1333,18 @@ BbrCongestionControlOnDataAcknowledged(
     BOOLEAN LastAckedPacketAppLimited =
         AckEvent->AckedPackets == NULL ? FALSE : AckEvent->IsLargestAckedPacketAppLimited;
 
-    BbrBandwidthFilterOnPacketAcked(&Bbr->BandwidthFilter, AckEvent, Bbr->RoundTripCounter);
+    uint64_t DeliveryRate =
+        BbrBandwidthFilterOnPacketAcked(&Bbr->BandwidthFilter, AckEvent, Bbr->RoundTripCounter);
+
+    if (Bbr->IsBbr3) {
+        if (NewRoundTrip) {
+            BbrCongestionControlOnRoundEnd(Cc);
+        }
+        Bbr->BytesDeliveredInRound += AckEvent->NumRetransmittableBytes;
+        if (DeliveryRate > Bbr->BandwidthLatest) {
+            Bbr->BandwidthLatest = DeliveryRate;
+        }
+    }
 
     if (BbrCongestionControlInRecovery(Cc)) {
         CXPLAT_DBG_ASSERT(Bbr->EndOfRecoveryValid);
@@ -823,7 +1364,11 @@ BbrCongestionControlOnDataAcknowledged(
 
     BbrCongestionControlUpdateAckAggregation(Cc, AckEvent);
 
-    if (Bbr->BbrState == BBR_STATE_PROBE_BW) {
+    if (Bbr->BbrState == BBR_STATE_PROBE_BW && Bbr->IsBbr3) {
+        BbrCongestionControlUpdateProbeBwPhase(
+            Cc, NewRoundTrip, AckEvent->TimeNow, AckEvent->NumRetransmittableBytes);
+
+    } else if (Bbr->BbrState == BBR_STATE_PROBE_BW) {
         BOOLEAN ShouldAdvancePacingGainCycle = CxPlatTimeDiff64(AckEvent->TimeNow, Bbr->CycleStart) > Bbr->MinRtt;
 
         if (Bbr->PacingGain > GAIN_UNIT && !AckEvent->HasLoss &&
@@ -845,6 +1390,10 @@ BbrCongestionControlOnDataAcknowledged(
         }
     }
 
+    if (Bbr->HyStartEnabled && Bbr->BbrState == BBR_STATE_STARTUP && !Bbr->BtlbwFound) {
+        BbrCongestionControlCheckStartupDelayIncrease(Cc, NewRoundTrip, AckEvent);
+    }
+
     if (!Bbr->BtlbwFound && NewRoundTrip && !LastAckedPacketAppLimited) {
         uint64_t BandwidthTarget = (uint64_t)(Bbr->LastEstimatedStartupBandwidth * kStartupGrowthTarget / GAIN_UNIT);
         uint64_t CurrentBandwidth = BbrCongestionControlGetBandwidth(Cc);
@@ -883,7 +1432,11 @@ BbrCongestionControlOnDataAcknowledged(
         Cc, AckEvent->NumTotalAckedRetransmittableBytes, AckEvent->NumRetransmittableBytes);
 
     if (Connection->Settings.NetStatsEventEnabled) {
-        BbrCongestionControlIndicateConnectionEvent(Connection, Cc);
+        QuicCongestionControlIndicateNetworkStatistics(
+            Cc,
+            Bbr->BytesInFlight,
+            BbrCongestionControlGetCongestionWindow(Cc),
+            BbrCongestionControlGetBandwidth(Cc) / BW_UNIT);
     }
 
     return BbrCongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
@@ -919,6 +1472,18 @@ BbrCongestionControlOnDataLost(
     CXPLAT_DBG_ASSERT(Bbr->BytesInFlight >= LossEvent->NumRetransmittableBytes);
     Bbr->BytesInFlight -= LossEvent->NumRetransmittableBytes;
 
+    if (Bbr->IsBbr3) {
+        Bbr->LossInRound = TRUE;
+        Bbr->BytesLostInRound += LossEvent->NumRetransmittableBytes;
+        Bbr->LossEventsInRound++;
+        if (BbrCongestionControlIsInflightTooHigh(Cc)) {
+            BbrCongestionControlHandleInflightTooHigh(
+                Cc,
+                Bbr->BytesInFlight + LossEvent->NumRetransmittableBytes,
+                CxPlatTimeUs64());
+        }
+    }
+
     uint32_t RecoveryWindow = Bbr->RecoveryWindow;
     uint32_t MinCongestionWindow = kMinCwndInMss * DatagramPayloadLength;
 
@@ -951,6 +1516,42 @@ BbrCongestionControlOnDataLost(
     QuicConnLogBbr(QuicCongestionControlGetConnection(Cc));
 }
 
+//
+// (BBRv3) ECN-CE marks are treated like loss: they reduce the short-term
+// bounds at the end of the round trip and, if frequent enough, stop a
+// bandwidth probe.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+BbrCongestionControlOnEcn(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_ECN_EVENT* EcnEvent
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR *Bbr = &Cc->Bbr;
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+
+    BOOLEAN PreviousCanSendState = BbrCongestionControlCanSend(Cc);
+
+    if (!Bbr->EcnInRound) {
+        QuicTraceEvent(
+            ConnCongestionV2,
+            "[conn][%p] Congestion event: IsEcn=%hu",
+            Connection,
+            TRUE);
+        Connection->Stats.Send.EcnCongestionCount++;
+        Bbr->EcnInRound = TRUE;
+    }
+
+    Bbr->CePacketsInRound += EcnEvent->NewCeCount;
+    if (BbrCongestionControlIsInflightTooHigh(Cc)) {
+        BbrCongestionControlHandleInflightTooHigh(Cc, Bbr->BytesInFlight, CxPlatTimeUs64());
+    }
+
+    BbrCongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
+    QuicConnLogBbr(Connection);
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 BOOLEAN
 BbrCongestionControlOnSpuriousCongestionEvent(
@@ -980,6 +1581,33 @@ BbrCongestionControlSetAppLimited(
     Bbr->BandwidthFilter.AppLimitedExitTarget = LargestSentPacketNumber;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+BbrCongestionControlResetBbr3State(
+    _In_ QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR* Bbr = &Cc->Bbr;
+
+    Bbr->ProbeBwPhase = BBR_PROBE_BW_PHASE_DOWN;
+    Bbr->ProbeBwPhaseStart = 0;
+    Bbr->InflightHi = UINT32_MAX;
+    Bbr->InflightLo = UINT32_MAX;
+    Bbr->BandwidthLo = UINT64_MAX;
+    Bbr->LossInRound = FALSE;
+    Bbr->EcnInRound = FALSE;
+    Bbr->BytesDeliveredInRound = 0;
+    Bbr->BandwidthLatest = 0;
+    Bbr->BytesLostInRound = 0;
+    Bbr->LossEventsInRound = 0;
+    Bbr->CePacketsInRound = 0;
+    Bbr->ProbeUpCount = UINT32_MAX;
+    Bbr->ProbeUpAcked = 0;
+    Bbr->ProbeUpRounds = 0;
+    Bbr->RoundsSinceBwProbe = 0;
+    Bbr->BwProbeWait = 0;
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 void
 BbrCongestionControlReset(
@@ -1007,8 +1635,8 @@ BbrCongestionControlReset(
     Bbr->RecoveryState = RECOVERY_STATE_NOT_RECOVERY;
     Bbr->BbrState = BBR_STATE_STARTUP;
     Bbr->RoundTripCounter = 0;
-    Bbr->CwndGain = kHighGain;
-    Bbr->PacingGain = kHighGain;
+    Bbr->CwndGain = Bbr->IsBbr3 ? kBbr3StartupCwndGain : kHighGain;
+    Bbr->PacingGain = Bbr->IsBbr3 ? kBbr3StartupPacingGain : kHighGain;
     Bbr->BtlbwFound = FALSE;
     Bbr->SendQuantum = 0;
     Bbr->SlowStartupRoundCounter = 0 ;
@@ -1017,6 +1645,9 @@ BbrCongestionControlReset(
     Bbr->AggregatedAckBytes = 0;
     Bbr->ExitingQuiescence = FALSE;
     Bbr->LastEstimatedStartupBandwidth = 0;
+    Bbr->StartupMinRttInCurrentRound = UINT64_MAX;
+    Bbr->StartupMinRttInLastRound = UINT64_MAX;
+    Bbr->StartupRttSampleCount = 0;
 
     Bbr->AckAggregationStartTimeValid = FALSE;
     Bbr->AckAggregationStartTime = CxPlatTimeUs64();
@@ -1045,6 +1676,8 @@ BbrCongestionControlReset(
     Bbr->BandwidthFilter.AppLimited = FALSE;
     Bbr->BandwidthFilter.AppLimitedExitTarget = 0;
 
+    BbrCongestionControlResetBbr3State(Cc);
+
     BbrCongestionControlLogOutFlowStatus(Cc);
     QuicConnLogBbr(Connection);
 }
@@ -1068,6 +1701,28 @@ static const QUIC_CONGESTION_CONTROL QuicCongestionControlBbr = {
     .QuicCongestionControlGetBytesInFlightMax = BbrCongestionControlGetBytesInFlightMax,
     .QuicCongestionControlIsAppLimited = BbrCongestionControlIsAppLimited,
     .QuicCongestionControlSetAppLimited = BbrCongestionControlSetAppLimited,
+    .QuicCongestionControlIsInRecovery = BbrCongestionControlInRecovery,
+};
+
+static const QUIC_CONGESTION_CONTROL QuicCongestionControlBbr3 = {
+    .Name = "BBRv3",
+    .QuicCongestionControlCanSend = BbrCongestionControlCanSend,
+    .QuicCongestionControlSetExemption = BbrCongestionControlSetExemption,
+    .QuicCongestionControlReset = BbrCongestionControlReset,
+    .QuicCongestionControlGetSendAllowance = BbrCongestionControlGetSendAllowance,
+    .QuicCongestionControlGetCongestionWindow = BbrCongestionControlGetCongestionWindow,
+    .QuicCongestionControlOnDataSent = BbrCongestionControlOnDataSent,
+    .QuicCongestionControlOnDataInvalidated = BbrCongestionControlOnDataInvalidated,
+    .QuicCongestionControlOnDataAcknowledged = BbrCongestionControlOnDataAcknowledged,
+    .QuicCongestionControlOnDataLost = BbrCongestionControlOnDataLost,
+    .QuicCongestionControlOnEcn = BbrCongestionControlOnEcn,
+    .QuicCongestionControlOnSpuriousCongestionEvent = BbrCongestionControlOnSpuriousCongestionEvent,
+    .QuicCongestionControlLogOutFlowStatus = BbrCongestionControlLogOutFlowStatus,
+    .QuicCongestionControlGetExemptions = BbrCongestionControlGetExemptions,
+    .QuicCongestionControlGetBytesInFlightMax = BbrCongestionControlGetBytesInFlightMax,
+    .QuicCongestionControlIsAppLimited = BbrCongestionControlIsAppLimited,
+    .QuicCongestionControlSetAppLimited = BbrCongestionControlSetAppLimited,
+    .QuicCongestionControlIsInRecovery = BbrCongestionControlInRecovery,
 };
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -1087,6 +1742,7 @@ BbrCongestionControlInitialize(
         QuicPathGetDatagramPayloadSize(&Connection->Paths[0]);
 
     Bbr->InitialCongestionWindowPackets = Settings->InitialWindowPackets;
+    Bbr->HyStartEnabled = Settings->HyStartEnabled;
 
     Bbr->CongestionWindow = Bbr->InitialCongestionWindowPackets * DatagramPayloadLength;
     Bbr->InitialCongestionWindow = Bbr->InitialCongestionWindowPackets * DatagramPayloadLength;
@@ -1099,8 +1755,8 @@ BbrCongestionControlInitialize(
     Bbr->RecoveryState = RECOVERY_STATE_NOT_RECOVERY;
     Bbr->BbrState = BBR_STATE_STARTUP;
     Bbr->RoundTripCounter = 0;
-    Bbr->CwndGain = kHighGain;
-    Bbr->PacingGain = kHighGain;
+    Bbr->CwndGain = Bbr->IsBbr3 ? kBbr3StartupCwndGain : kHighGain;
+    Bbr->PacingGain = Bbr->IsBbr3 ? kBbr3StartupPacingGain : kHighGain;
     Bbr->BtlbwFound = FALSE;
     Bbr->SendQuantum = 0;
     Bbr->SlowStartupRoundCounter = 0 ;
@@ -1109,6 +1765,9 @@ BbrCongestionControlInitialize(
     Bbr->AggregatedAckBytes = 0;
     Bbr->ExitingQuiescence = FALSE;
     Bbr->LastEstimatedStartupBandwidth = 0;
+    Bbr->StartupMinRttInCurrentRound = UINT64_MAX;
+    Bbr->StartupMinRttInLastRound = UINT64_MAX;
+    Bbr->StartupRttSampleCount = 0;
     Bbr->CycleStart = 0;
 
     Bbr->AckAggregationStartTimeValid = FALSE;
@@ -1141,6 +1800,28 @@ BbrCongestionControlInitialize(
         .AppLimitedExitTarget = 0,
     };
 
+    BbrCongestionControlResetBbr3State(Cc);
+
     QuicConnLogOutFlowStats(Connection);
     QuicConnLogBbr(Connection);
 }
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlInitialize(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_SETTINGS_INTERNAL* Settings
+    )
+{
+    BbrCongestionControlInitialize(Cc, Settings);
+
+    //
+    // BBRv3 shares the BBR state and most of the logic, so just switch the
+    // function table and the gains.
+    //
+    QUIC_CONGESTION_CONTROL_BBR Bbr = Cc->Bbr;
+    *Cc = QuicCongestionControlBbr3;
+    Cc->Bbr = Bbr;
+    Cc->Bbr.IsBbr3 = TRUE;
+    BbrCongestionControlTransitToStartup(Cc);
+}
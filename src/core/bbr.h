@@ -79,6 +79,28 @@ typedef struct QUIC_CONGESTION_CONTROL_BBR {
     //
     BOOLEAN MinRttTimestampValid: 1;
 
+    //
+    // If TRUE, this is the BBRv3 variant, which bounds inflight based on loss
+    // and ECN signals and uses the BBRv3 ProbeBw cycle
+    //
+    BOOLEAN IsBbr3 : 1;
+
+    //
+    // (BBRv3) If TRUE, there has been loss in the current round trip
+    //
+    BOOLEAN LossInRound : 1;
+
+    //
+    // (BBRv3) If TRUE, there have been ECN-CE marks in the current round trip
+    //
+    BOOLEAN EcnInRound : 1;
+
+    //
+    // If TRUE, STARTUP also ends when the RTT grows (HyStart++ style delay
+    // increase detection), not only when bandwidth stops growing
+    //
+    BOOLEAN HyStartEnabled : 1;
+
     //
     // The size of the initial congestion window in packets
     //
@@ -184,6 +206,18 @@ typedef struct QUIC_CONGESTION_CONTROL_BBR {
     //
     uint64_t LastEstimatedStartupBandwidth;
 
+    //
+    // The minimum RTT seen in the current and previous round trips during
+    // STARTUP, for delay increase detection
+    //
+    uint64_t StartupMinRttInCurrentRound; // microseconds
+    uint64_t StartupMinRttInLastRound; // microseconds
+
+    //
+    // The number of RTT samples in the current round trip during STARTUP
+    //
+    uint32_t StartupRttSampleCount;
+
     //
     // Indicates whether to exit ProbeRtt if there're at least one RTT round with the
     // minimum cwnd
@@ -213,6 +247,58 @@ typedef struct QUIC_CONGESTION_CONTROL_BBR {
     //
     BBR_BANDWIDTH_FILTER BandwidthFilter;
 
+    //
+    // (BBRv3) Current phase of the ProbeBw cycle, and the time it started
+    //
+    uint32_t ProbeBwPhase;
+    uint64_t ProbeBwPhaseStart;
+
+    //
+    // (BBRv3) Long-term upper bound on bytes in flight. Set when probing for
+    // bandwidth runs into too much loss or ECN, and grown while probing up.
+    // UINT32_MAX if unbounded.
+    //
+    uint32_t InflightHi;
+
+    //
+    // (BBRv3) Short-term lower bounds on bytes in flight and bandwidth. Reduced
+    // after round trips with loss or ECN, and reset when probing for bandwidth.
+    // UINT32_MAX and UINT64_MAX if unbounded.
+    //
+    uint32_t InflightLo;
+    uint64_t BandwidthLo;
+
+    //
+    // (BBRv3) Bytes delivered and the max delivery rate in the current round
+    // trip
+    //
+    uint32_t BytesDeliveredInRound;
+    uint64_t BandwidthLatest;
+
+    //
+    // (BBRv3) Bytes lost, loss events and ECN-CE marked packets in the
+    // current round trip
+    //
+    uint32_t BytesLostInRound;
+    uint32_t LossEventsInRound;
+    uint64_t CePacketsInRound;
+
+    //
+    // (BBRv3) Bytes to be acked per MSS of InflightHi growth while probing
+    // up, the bytes acked towards the next growth, and the number of round
+    // trips spent probing up
+    //
+    uint32_t ProbeUpCount;
+    uint32_t ProbeUpAcked;
+    uint32_t ProbeUpRounds;
+
+    //
+    // (BBRv3) Round trips since the last bandwidth probe, and the randomized
+    // time to wait between probes
+    //
+    uint32_t RoundsSinceBwProbe;
+    uint64_t BwProbeWait; // microseconds
+
 } QUIC_CONGESTION_CONTROL_BBR;
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -221,3 +307,10 @@ BbrCongestionControlInitialize(
     _In_ QUIC_CONGESTION_CONTROL* Cc,
     _In_ const QUIC_SETTINGS_INTERNAL* Settings
     );
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+Bbr3CongestionControlInitialize(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_SETTINGS_INTERNAL* Settings
+    );
@@ -0,0 +1,966 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Microbenchmarks for the core data structures and primitives on the hot
+    path. Each benchmark reports the average time per operation, and the
+    results can be saved to and compared against a CSV baseline to catch
+    regressions over time.
+
+--*/
+
+#include "precomp.h"
+#include "quic_toeplitz.h"
+#ifdef QUIC_CLOG
+#include "CoreBench.cpp.clog.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+extern "C"
+void
+MsQuicCalculatePartitionMask(
+    void
+    );
+
+#define BENCH_DEFAULT_ITERATIONS    1000000
+#define BENCH_DEFAULT_RUNS          5
+#define BENCH_DEFAULT_THRESHOLD     10
+
+//
+// Consumes benchmark outputs so the compiler can't optimize the work away.
+//
+static volatile uint64_t BenchSink;
+
+//
+// Each benchmark does its own setup, times only the operations it measures,
+// and returns the average number of nanoseconds per operation.
+//
+typedef double (*BENCH_FN)(uint32_t Iterations);
+
+struct BENCH {
+    const char* Name;
+    BENCH_FN Run;
+};
+
+static
+double
+NsPerOp(
+    _In_ uint64_t StartUs,
+    _In_ uint64_t Operations
+    )
+{
+    uint64_t ElapsedUs = CxPlatTimeDiff64(StartUs, CxPlatTimeUs64());
+    return Operations == 0 ? 0.0 : (double)ElapsedUs * 1000.0 / (double)Operations;
+}
+
+//
+// QUIC_RANGE
+//
+
+static
+double
+BenchRangeAddInOrder(
+    _In_ uint32_t Iterations
+    )
+{
+    //
+    // The common ACK tracking case: every new value extends the last subrange.
+    //
+    QUIC_RANGE Range;
+    QuicRangeInitialize(QUIC_MAX_RANGE_ACK_PACKETS * sizeof(QUIC_SUBRANGE), &Range);
+    BOOLEAN Updated;
+    uint64_t Start = CxPlatTimeUs64();
+    for (uint32_t i = 0; i < Iterations; ++i) {
+        BenchSink += (uint64_t)(size_t)QuicRangeAddRange(&Range, i, 1, &Updated);
+    }
+    double Result = NsPerOp(Start, Iterations);
+    QuicRangeUninitialize(&Range);
+    return Result;
+}
+
+static
+double
+BenchRangeAddGaps(
+    _In_ uint32_t Iterations
+    )
+{
+    //
+    // Every value creates a new subrange, as with heavy loss or reordering. The
+    // range is reset every 256 values so it stays at a realistic size.
+    //
+    QUIC_RANGE Range;
+    QuicRangeInitialize(QUIC_MAX_RANGE_ACK_PACKETS * sizeof(QUIC_SUBRANGE), &Range);
+    BOOLEAN Updated;
+    uint64_t Start = CxPlatTimeUs64();
+    for (uint32_t i = 0; i < Iterations; ++i) {
+        if ((i & 0xFF) == 0) {
+            QuicRangeReset(&Range);
+        }
+        BenchSink += (uint64_t)(size_t)QuicRangeAddRange(&Range, 2ull * i, 1, &Updated);
+    }
+    double Result = NsPerOp(Start, Iterations);
+    QuicRangeUninitialize(&Range);
+    return Result;
+}
+
+static
+double
+BenchRangeRemove(
+    _In_ uint32_t Iterations
+    )
+{
+    //
+    // Punches holes into one large subrange, splitting it every time. The
+    // range is refilled every 256 removals; the refill counts as an operation.
+    //
+    QUIC_RANGE Range;
+    QuicRangeInitialize(QUIC_MAX_RANGE_ACK_PACKETS * sizeof(QUIC_SUBRANGE), &Range);
+    BOOLEAN Updated;
+    uint64_t Operations = 0;
+    uint64_t Start = CxPlatTimeUs64();
+    for (uint32_t i = 0; i < Iterations; ++i) {
+        if ((i & 0xFF) == 0) {
+            QuicRangeReset(&Range);
+            (void)QuicRangeAddRange(&Range, 0, 512, &Updated);
+            ++Operations;
+        }
+        BenchSink += QuicRangeRemoveRange(&Range, 2ull * (i & 0xFF) + 1, 1);
+        ++Operations;
+    }
+    double Result = NsPerOp(Start, Operations);
+    QuicRangeUninitialize(&Range);
+    return Result;
+}
+
+//
+// QUIC_RECV_BUFFER
+//
+
+#define BENCH_RECV_BUFFER_LENGTH    0x10000
+#define BENCH_RECV_WRITE_LENGTH     1200
+
+static
+double
+BenchRecvBuffer(
+    _In_ uint32_t Iterations,
+    _In_ QUIC_RECV_BUF_MODE Mode
+    )
+{
+    //
+    // One in-order packet's worth of stream data is written, read and drained
+    // per operation, as a stream receiving at line rate would.
+    //
+    QUIC_RECV_BUFFER RecvBuffer;
+    if (QUIC_FAILED(
+        QuicRecvBufferInitialize(
+            &RecvBuffer,
+            BENCH_RECV_BUFFER_LENGTH,
+            BENCH_RECV_BUFFER_LENGTH,
+            Mode,
+            NULL,
+            NULL))) {
+        return 0.0;
+    }
+
+    uint8_t Data[BENCH_RECV_WRITE_LENGTH];
+    CxPlatZeroMemory(Data, sizeof(Data));
+    QUIC_BUFFER Buffers[3];
+    uint64_t Offset = 0;
+
+    uint64_t Start = CxPlatTimeUs64();
+    for (uint32_t i = 0; i < Iterations; ++i) {
+        uint64_t WriteLimit = BENCH_RECV_BUFFER_LENGTH;
+        BOOLEAN NewDataReady;
+        if (QUIC_FAILED(
+            QuicRecvBufferWrite(
+                &RecvBuffer,
+                Offset,
+                sizeof(Data),
+                Data,
+                &WriteLimit,
+                &NewDataReady))) {
+            break;
+        }
+        Offset += sizeof(Data);
+
+        uint64_t ReadOffset;
+        uint32_t BufferCount = ARRAYSIZE(Buffers);
+        QuicRecvBufferRead(&RecvBuffer, &ReadOffset, &BufferCount, Buffers);
+        uint64_t ReadLength = 0;
+        for (uint32_t j = 0; j < BufferCount; ++j) {
+            ReadLength += Buffers[j].Length;
+        }
+        BenchSink += QuicRecvBufferDrain(&RecvBuffer, ReadLength);
+    }
+    double Result = NsPerOp(Start, Iterations);
+    QuicRecvBufferUninitialize(&RecvBuffer);
+    return Result;
+}
+
+static double BenchRecvBufferSingle(uint32_t Iterations) { return BenchRecvBuffer(Iterations, QUIC_RECV_BUF_MODE_SINGLE); }
+static double BenchRecvBufferCircular(uint32_t Iterations) { return BenchRecvBuffer(Iterations, QUIC_RECV_BUF_MODE_CIRCULAR); }
+static double BenchRecvBufferMultiple(uint32_t Iterations) { return BenchRecvBuffer(Iterations, QUIC_RECV_BUF_MODE_MULTIPLE); }
+
+//
+// CXPLAT_HASHTABLE
+//
+
+#define BENCH_HASHTABLE_ENTRIES     0x10000
+
+static
+uint64_t
+BenchSignature(
+    _In_ uint32_t Index
+    )
+{
+    return (uint64_t)CxPlatHashSimple(sizeof(Index), (const uint8_t*)&Index);
+}
+
+static
+double
+BenchHashtable(
+    _In_ uint32_t Iterations,
+    _In_ BOOLEAN MeasureLookup,
+    _In_ BOOLEAN OpenAddressing
+    )
+{
+    //
+    // The table is grown from its minimum size, so inserts include the cost of
+    // the table expanding, like a binding accumulating connections.
+    //
+    std::unique_ptr<CXPLAT_HASHTABLE_ENTRY[]> Entries(
+        new CXPLAT_HASHTABLE_ENTRY[BENCH_HASHTABLE_ENTRIES]);
+    uint64_t InsertUs = 0;
+    uint64_t InsertOperations = 0;
+    uint64_t LookupUs = 0;
+    uint64_t LookupOperations = 0;
+
+    for (uint32_t Done = 0; Done < Iterations; Done += BENCH_HASHTABLE_ENTRIES) {
+        CXPLAT_HASHTABLE Table;
+        if (!(OpenAddressing ?
+                CxPlatHashtableInitializeOpenEx(&Table, CXPLAT_HASH_MIN_SIZE) :
+                CxPlatHashtableInitializeEx(&Table, CXPLAT_HASH_MIN_SIZE))) {
+            return 0.0;
+        }
+
+        uint64_t Start = CxPlatTimeUs64();
+        for (uint32_t i = 0; i < BENCH_HASHTABLE_ENTRIES; ++i) {
+            CxPlatHashtableInsert(&Table, &Entries[i], BenchSignature(i), NULL);
+        }
+        InsertUs += CxPlatTimeDiff64(Start, CxPlatTimeUs64());
+        InsertOperations += BENCH_HASHTABLE_ENTRIES;
+
+        Start = CxPlatTimeUs64();
+        for (uint32_t i = 0; i < BENCH_HASHTABLE_ENTRIES; ++i) {
+            BenchSink += (uint64_t)(size_t)CxPlatHashtableLookup(&Table, BenchSignature(i), NULL);
+        }
+        LookupUs += CxPlatTimeDiff64(Start, CxPlatTimeUs64());
+        LookupOperations += BENCH_HASHTABLE_ENTRIES;
+
+        for (uint32_t i = 0; i < BENCH_HASHTABLE_ENTRIES; ++i) {
+            CxPlatHashtableRemove(&Table, &Entries[i], NULL);
+        }
+        CxPlatHashtableUninitialize(&Table);
+    }
+
+    return MeasureLookup ?
+        (double)LookupUs * 1000.0 / (double)LookupOperations :
+        (double)InsertUs * 1000.0 / (double)InsertOperations;
+}
+
+static double BenchHashtableInsert(uint32_t Iterations) { return BenchHashtable(Iterations, FALSE, FALSE); }
+static double BenchHashtableLookup(uint32_t Iterations) { return BenchHashtable(Iterations, TRUE, FALSE); }
+static double BenchHashtableOpenInsert(uint32_t Iterations) { return BenchHashtable(Iterations, FALSE, TRUE); }
+static double BenchHashtableOpenLookup(uint32_t Iterations) { return BenchHashtable(Iterations, TRUE, TRUE); }
+
+//
+// QUIC_VAR_INT
+//
+
+#define BENCH_VAR_INT_COUNT         1024
+
+static
+void
+BenchVarIntValues(
+    _Out_writes_(BENCH_VAR_INT_COUNT) QUIC_VAR_INT* Values
+    )
+{
+    //
+    // A mix of all four encoded lengths, weighted towards the small ones as
+    // they are in frames.
+    //
+    for (uint32_t i = 0; i < BENCH_VAR_INT_COUNT; ++i) {
+        switch (i & 7) {
+        case 0: case 1: case 2: Values[i] = i & 0x3F; break;
+        case 3: case 4: Values[i] = 0x40 + i; break;
+        case 5: case 6: Values[i] = 0x4000 + i * 997ull; break;
+        default: Values[i] = 0x40000000ull + i * 104729ull; break;
+        }
+    }
+}
+
+static
+double
+BenchVarIntEncode(
+    _In_ uint32_t Iterations
+    )
+{
+    QUIC_VAR_INT Values[BENCH_VAR_INT_COUNT];
+    BenchVarIntValues(Values);
+    uint8_t Buffer[BENCH_VAR_INT_COUNT * sizeof(uint64_t)];
+
+    uint64_t Operations = 0;
+    uint64_t Start = CxPlatTimeUs64();
+    for (uint32_t i = 0; i < Iterations; i += BENCH_VAR_INT_COUNT) {
+        uint8_t* Head = Buffer;
+        for (uint32_t j = 0; j < BENCH_VAR_INT_COUNT; ++j) {
+            Head = QuicVarIntEncode(Values[j], Head);
+        }
+        BenchSink += (uint64_t)(Head - Buffer);
+        Operations += BENCH_VAR_INT_COUNT;
+    }
+    return NsPerOp(Start, Operations);
+}
+
+static
+double
+BenchVarIntDecode(
+    _In_ uint32_t Iterations
+    )
+{
+    QUIC_VAR_INT Values[BENCH_VAR_INT_COUNT];
+    BenchVarIntValues(Values);
+    uint8_t Buffer[BENCH_VAR_INT_COUNT * sizeof(uint64_t)];
+    uint8_t* Head = Buffer;
+    for (uint32_t j = 0; j < BENCH_VAR_INT_COUNT; ++j) {
+        Head = QuicVarIntEncode(Values[j], Head);
+    }
+    const uint16_t BufferLength = (uint16_t)(Head - Buffer);
+
+    uint64_t Operations = 0;
+    uint64_t Start = CxPlatTimeUs64();
+    for (uint32_t i = 0; i < Iterations; i += BENCH_VAR_INT_COUNT) {
+        uint16_t Offset = 0;
+        QUIC_VAR_INT Value;
+        while (QuicVarIntDecode(BufferLength, Buffer, &Offset, &Value)) {
+            BenchSink += Value;
+        }
+        Operations += BENCH_VAR_INT_COUNT;
+    }
+    return NsPerOp(Start, Operations);
+}
+
+//
+// CXPLAT_TOEPLITZ_HASH
+//
+
+static
+double
+BenchToeplitz(
+    _In_ uint32_t Iterations,
+    _In_ bool TablesOnly
+    )
+{
+    //
+    // Hashes the largest input: a 20 byte CID plus an IPv6 address and port.
+    // TablesOnly forces the portable nibble table implementation, for
+    // comparison with the carry-less multiply one.
+    //
+    std::unique_ptr<CXPLAT_TOEPLITZ_HASH> Toeplitz(new CXPLAT_TOEPLITZ_HASH);
+    CxPlatRandom(sizeof(Toeplitz->HashKey), Toeplitz->HashKey);
+    CxPlatToeplitzHashInitialize(Toeplitz.get());
+#ifdef CXPLAT_TOEPLITZ_CLMUL
+    if (TablesOnly) {
+        Toeplitz->UseClmul = FALSE;
+    }
+#else
+    UNREFERENCED_PARAMETER(TablesOnly);
+#endif
+
+    uint8_t Input[CXPLAT_TOEPLITZ_INPUT_SIZE];
+    CxPlatRandom(sizeof(Input), Input);
+
+    uint64_t Start = CxPlatTimeUs64();
+    for (uint32_t i = 0; i < Iterations; ++i) {
+        Input[0] = (uint8_t)i;
+        BenchSink += CxPlatToeplitzHashCompute(Toeplitz.get(), Input, sizeof(Input), 0);
+    }
+    return NsPerOp(Start, Iterations);
+}
+
+static double BenchToeplitzCompute(uint32_t Iterations) { return BenchToeplitz(Iterations, false); }
+static double BenchToeplitzTables(uint32_t Iterations) { return BenchToeplitz(Iterations, true); }
+
+//
+// CxPlatTimeUs64
+//
+
+static
+double
+BenchTimeNow(
+    _In_ uint32_t Iterations
+    )
+{
+    uint64_t Start = CxPlatTimeUs64();
+    for (uint32_t i = 0; i < Iterations; ++i) {
+        BenchSink += CxPlatTimeUs64();
+    }
+    return NsPerOp(Start, Iterations);
+}
+
+//
+// QUIC_TIMER_WHEEL
+//
+
+#define BENCH_TIMER_CONNECTIONS     4096
+
+//
+// The timer wheel and lookup only use a few fields of the connections, so
+// zeroed connections are enough. An extra reference is held on each so they
+// are never freed by the code under test.
+//
+static
+std::vector<std::unique_ptr<QUIC_CONNECTION>>
+BenchNewConnections(
+    _In_ uint32_t Count
+    )
+{
+    std::vector<std::unique_ptr<QUIC_CONNECTION>> Connections;
+    for (uint32_t i = 0; i < Count; ++i) {
+        Connections.emplace_back(new QUIC_CONNECTION);
+        QUIC_CONNECTION* Connection = Connections.back().get();
+        CxPlatZeroMemory(Connection, sizeof(*Connection));
+        Connection->EarliestExpirationTime = UINT64_MAX;
+        QuicConnAddRef(Connection, QUIC_CONN_REF_HANDLE_OWNER);
+    }
+    return Connections;
+}
+
+static
+double
+BenchTimerWheelUpdate(
+    _In_ uint32_t Iterations
+    )
+{
+    //
+    // Moves connections to new expiration times spread over a few seconds, as
+    // every send and ACK does.
+    //
+    QUIC_TIMER_WHEEL TimerWheel;
+    if (QUIC_FAILED(QuicTimerWheelInitialize(&TimerWheel))) {
+        return 0.0;
+    }
+    auto Connections = BenchNewConnections(BENCH_TIMER_CONNECTIONS);
+    const uint64_t Now = CxPlatTimeUs64();
+
+    uint64_t Start = CxPlatTimeUs64();
+    for (uint32_t i = 0; i < Iterations; ++i) {
+        QUIC_CONNECTION* Connection = Connections[i % BENCH_TIMER_CONNECTIONS].get();
+        Connection->EarliestExpirationTime = Now + (i * 2654435761u) % 4000000;
+        QuicTimerWheelUpdateConnection(&TimerWheel, Connection);
+    }
+    double Result = NsPerOp(Start, Iterations);
+
+    for (auto& Connection : Connections) {
+        QuicTimerWheelRemoveConnection(&TimerWheel, Connection.get());
+    }
+    QuicTimerWheelUninitialize(&TimerWheel);
+    return Result;
+}
+
+static
+double
+BenchTimerWheelRemove(
+    _In_ uint32_t Iterations
+    )
+{
+    QUIC_TIMER_WHEEL TimerWheel;
+    if (QUIC_FAILED(QuicTimerWheelInitialize(&TimerWheel))) {
+        return 0.0;
+    }
+    auto Connections = BenchNewConnections(BENCH_TIMER_CONNECTIONS);
+    const uint64_t Now = CxPlatTimeUs64();
+
+    uint64_t RemoveUs = 0;
+    uint64_t Operations = 0;
+    for (uint32_t Done = 0; Done < Iterations; Done += BENCH_TIMER_CONNECTIONS) {
+        for (uint32_t i = 0; i < BENCH_TIMER_CONNECTIONS; ++i) {
+            QUIC_CONNECTION* Connection = Connections[i].get();
+            Connection->EarliestExpirationTime = Now + (i * 2654435761u) % 4000000;
+            QuicTimerWheelUpdateConnection(&TimerWheel, Connection);
+        }
+        uint64_t Start = CxPlatTimeUs64();
+        for (uint32_t i = 0; i < BENCH_TIMER_CONNECTIONS; ++i) {
+            QuicTimerWheelRemoveConnection(&TimerWheel, Connections[i].get());
+        }
+        RemoveUs += CxPlatTimeDiff64(Start, CxPlatTimeUs64());
+        Operations += BENCH_TIMER_CONNECTIONS;
+    }
+
+    QuicTimerWheelUninitialize(&TimerWheel);
+    return (double)RemoveUs * 1000.0 / (double)Operations;
+}
+
+//
+// QUIC_LOOKUP
+//
+
+#define BENCH_LOOKUP_CIDS           0x4000
+#define BENCH_LOOKUP_CONNECTIONS    1024
+#define BENCH_LOOKUP_PARTITIONS     8
+#define BENCH_LOOKUP_CID_LENGTH     QUIC_MIN_INITIAL_CONNECTION_ID_LENGTH
+
+static
+double
+BenchLookupLocalCid(
+    _In_ uint32_t Iterations
+    )
+{
+    //
+    // A server binding with maximized partitioning, so the receive path's
+    // lock free table lookup is measured. Each connection has several CIDs, to
+    // get a realistic table size without allocating that many connections.
+    //
+    const uint16_t OriginalPartitionCount = MsQuicLib.PartitionCount;
+    MsQuicLib.PartitionCount = BENCH_LOOKUP_PARTITIONS;
+    MsQuicCalculatePartitionMask();
+
+    QUIC_LOOKUP Lookup;
+    QuicLookupInitialize(&Lookup);
+    if (!QuicLookupMaximizePartitioning(&Lookup)) {
+        QuicLookupUninitialize(&Lookup);
+        MsQuicLib.PartitionCount = OriginalPartitionCount;
+        MsQuicCalculatePartitionMask();
+        return 0.0;
+    }
+
+    auto Connections = BenchNewConnections(BENCH_LOOKUP_CONNECTIONS);
+    std::vector<QUIC_CID_HASH_ENTRY*> Cids(BENCH_LOOKUP_CIDS, nullptr);
+    for (uint32_t i = 0; i < BENCH_LOOKUP_CIDS; ++i) {
+        QUIC_CID_HASH_ENTRY* Entry =
+            (QUIC_CID_HASH_ENTRY*)CXPLAT_ALLOC_NONPAGED(
+                sizeof(QUIC_CID_HASH_ENTRY) + BENCH_LOOKUP_CID_LENGTH,
+                QUIC_POOL_CIDHASH);
+        if (Entry == NULL) {
+            break;
+        }
+        CxPlatZeroMemory(Entry, sizeof(QUIC_CID_HASH_ENTRY) + BENCH_LOOKUP_CID_LENGTH);
+        Entry->Connection = Connections[i % BENCH_LOOKUP_CONNECTIONS].get();
+        Entry->CID.Length = BENCH_LOOKUP_CID_LENGTH;
+        CxPlatRandom(BENCH_LOOKUP_CID_LENGTH, Entry->CID.Data);
+        if (!QuicLookupAddLocalCid(&Lookup, Entry, NULL)) {
+            CXPLAT_FREE(Entry, QUIC_POOL_CIDHASH);
+            break;
+        }
+        Cids[i] = Entry;
+    }
+
+    uint64_t Operations = 0;
+    uint64_t Start = CxPlatTimeUs64();
+    for (uint32_t i = 0; i < Iterations; ++i) {
+        QUIC_CID_HASH_ENTRY* Entry = Cids[(i * 40503u) % BENCH_LOOKUP_CIDS];
+        if (Entry == NULL) {
+            continue;
+        }
+        QUIC_CONNECTION* Connection =
+            QuicLookupFindConnectionByLocalCid(
+                &Lookup, Entry->CID.Data, Entry->CID.Length);
+        if (Connection != NULL) {
+            QuicConnRelease(Connection, QUIC_CONN_REF_LOOKUP_RESULT);
+        }
+        BenchSink += (uint64_t)(size_t)Connection;
+        ++Operations;
+    }
+    double Result = NsPerOp(Start, Operations);
+
+    for (auto Entry : Cids) {
+        if (Entry != NULL) {
+            CXPLAT_SLIST_ENTRY* Head = &Entry->Link;
+            Entry->Link.Next = NULL;
+            QuicLookupRemoveLocalCid(&Lookup, Entry, &Head);
+            CXPLAT_FREE(Entry, QUIC_POOL_CIDHASH);
+        }
+    }
+    QuicLookupUninitialize(&Lookup);
+    MsQuicLib.PartitionCount = OriginalPartitionCount;
+    MsQuicCalculatePartitionMask();
+    return Result;
+}
+
+//
+// Packet protection
+//
+
+#define BENCH_PACKET_LENGTH         1200
+#define BENCH_HEADER_LENGTH         20
+
+struct BENCH_CRYPT {
+    CXPLAT_KEY* Key {nullptr};
+    CXPLAT_HP_KEY* HpKey {nullptr};
+    uint8_t Iv[CXPLAT_IV_LENGTH];
+    uint8_t Header[BENCH_HEADER_LENGTH];
+    uint8_t Packets[QUIC_MAX_CRYPTO_BATCH_COUNT][BENCH_PACKET_LENGTH];
+
+    bool Initialize() {
+        uint8_t RawKey[16];
+        CxPlatRandom(sizeof(RawKey), RawKey);
+        CxPlatRandom(sizeof(Iv), Iv);
+        CxPlatRandom(sizeof(Header), Header);
+        CxPlatRandom(sizeof(Packets), Packets);
+        return
+            QUIC_SUCCEEDED(CxPlatKeyCreate(CXPLAT_AEAD_AES_128_GCM, RawKey, &Key)) &&
+            QUIC_SUCCEEDED(CxPlatHpKeyCreate(CXPLAT_AEAD_AES_128_GCM, RawKey, &HpKey));
+    }
+
+    ~BENCH_CRYPT() {
+        CxPlatKeyFree(Key);
+        CxPlatHpKeyFree(HpKey);
+    }
+
+    void PacketIv(uint64_t PacketNumber, uint8_t* PacketIv) {
+        QuicCryptoCombineIvAndPacketNumber(Iv, (uint8_t*)&PacketNumber, PacketIv);
+    }
+};
+
+static
+double
+BenchEncrypt(
+    _In_ uint32_t Iterations
+    )
+{
+    std::unique_ptr<BENCH_CRYPT> Crypt(new BENCH_CRYPT);
+    if (!Crypt->Initialize()) {
+        return 0.0;
+    }
+
+    uint8_t Iv[CXPLAT_IV_LENGTH];
+    uint64_t Start = CxPlatTimeUs64();
+    for (uint32_t i = 0; i < Iterations; ++i) {
+        Crypt->PacketIv(i, Iv);
+        BenchSink +=
+            CxPlatEncrypt(
+                Crypt->Key,
+                Iv,
+                BENCH_HEADER_LENGTH,
+                Crypt->Header,
+                BENCH_PACKET_LENGTH,
+                Crypt->Packets[0]);
+    }
+    return NsPerOp(Start, Iterations);
+}
+
+static
+double
+BenchDecrypt(
+    _In_ uint32_t Iterations
+    )
+{
+    //
+    // Decryption fails if the ciphertext doesn't authenticate, so a fresh copy
+    // of an encrypted packet is decrypted every time. The copy is timed too.
+    //
+    std::unique_ptr<BENCH_CRYPT> Crypt(new BENCH_CRYPT);
+    if (!Crypt->Initialize()) {
+        return 0.0;
+    }
+
+    uint8_t Iv[CXPLAT_IV_LENGTH];
+    Crypt->PacketIv(0, Iv);
+    if (QUIC_FAILED(
+        CxPlatEncrypt(
+            Crypt->Key,
+            Iv,
+            BENCH_HEADER_LENGTH,
+            Crypt->Header,
+            BENCH_PACKET_LENGTH,
+            Crypt->Packets[0]))) {
+        return 0.0;
+    }
+
+    uint64_t Start = CxPlatTimeUs64();
+    for (uint32_t i = 0; i < Iterations; ++i) {
+        CxPlatCopyMemory(Crypt->Packets[1], Crypt->Packets[0], BENCH_PACKET_LENGTH);
+        BenchSink +=
+            CxPlatDecrypt(
+                Crypt->Key,
+                Iv,
+                BENCH_HEADER_LENGTH,
+                Crypt->Header,
+                BENCH_PACKET_LENGTH,
+                Crypt->Packets[1]);
+    }
+    return NsPerOp(Start, Iterations);
+}
+
+static
+double
+BenchEncryptBatch(
+    _In_ uint32_t Iterations
+    )
+{
+    std::unique_ptr<BENCH_CRYPT> Crypt(new BENCH_CRYPT);
+    if (!Crypt->Initialize()) {
+        return 0.0;
+    }
+
+    CXPLAT_CRYPT_BATCH_ENTRY Entries[QUIC_MAX_CRYPTO_BATCH_COUNT];
+    for (uint32_t j = 0; j < QUIC_MAX_CRYPTO_BATCH_COUNT; ++j) {
+        Entries[j].AuthData = Crypt->Header;
+        Entries[j].AuthDataLength = BENCH_HEADER_LENGTH;
+        Entries[j].Buffer = Crypt->Packets[j];
+        Entries[j].BufferLength = BENCH_PACKET_LENGTH;
+    }
+
+    uint64_t Operations = 0;
+    uint64_t Start = CxPlatTimeUs64();
+    for (uint32_t i = 0; i < Iterations; i += QUIC_MAX_CRYPTO_BATCH_COUNT) {
+        for (uint32_t j = 0; j < QUIC_MAX_CRYPTO_BATCH_COUNT; ++j) {
+            Crypt->PacketIv(i + j, Entries[j].Iv);
+        }
+        BenchSink +=
+            CxPlatEncryptBatch(
+                Crypt->Key, QUIC_MAX_CRYPTO_BATCH_COUNT, Entries);
+        Operations += QUIC_MAX_CRYPTO_BATCH_COUNT;
+    }
+    return NsPerOp(Start, Operations);
+}
+
+static
+double
+BenchHpMask(
+    _In_ uint32_t Iterations,
+    _In_ uint8_t BatchSize
+    )
+{
+    //
+    // Reported per packet, so the single and batched numbers compare directly.
+    //
+    std::unique_ptr<BENCH_CRYPT> Crypt(new BENCH_CRYPT);
+    if (!Crypt->Initialize()) {
+        return 0.0;
+    }
+
+    uint8_t Samples[CXPLAT_HP_SAMPLE_LENGTH * QUIC_MAX_CRYPTO_BATCH_COUNT];
+    uint8_t Mask[CXPLAT_HP_SAMPLE_LENGTH * QUIC_MAX_CRYPTO_BATCH_COUNT];
+    CxPlatRandom(sizeof(Samples), Samples);
+
+    uint64_t Operations = 0;
+    uint64_t Start = CxPlatTimeUs64();
+    for (uint32_t i = 0; i < Iterations; i += BatchSize) {
+        Samples[0] = (uint8_t)i;
+        BenchSink += CxPlatHpComputeMask(Crypt->HpKey, BatchSize, Samples, Mask);
+        BenchSink += Mask[0];
+        Operations += BatchSize;
+    }
+    return NsPerOp(Start, Operations);
+}
+
+static double BenchHpMaskSingle(uint32_t Iterations) { return BenchHpMask(Iterations, 1); }
+static double BenchHpMaskBatch(uint32_t Iterations) { return BenchHpMask(Iterations, QUIC_MAX_CRYPTO_BATCH_COUNT); }
+
+static const BENCH Benchmarks[] = {
+    { "Range.AddInOrder",           BenchRangeAddInOrder },
+    { "Range.AddGaps",              BenchRangeAddGaps },
+    { "Range.Remove",               BenchRangeRemove },
+    { "RecvBuffer.Single",          BenchRecvBufferSingle },
+    { "RecvBuffer.Circular",        BenchRecvBufferCircular },
+    { "RecvBuffer.Multiple",        BenchRecvBufferMultiple },
+    { "Hashtable.Insert",           BenchHashtableInsert },
+    { "Hashtable.Lookup",           BenchHashtableLookup },
+    { "Hashtable.OpenInsert",       BenchHashtableOpenInsert },
+    { "Hashtable.OpenLookup",       BenchHashtableOpenLookup },
+    { "VarInt.Encode",              BenchVarIntEncode },
+    { "VarInt.Decode",              BenchVarIntDecode },
+    { "Toeplitz.Compute",           BenchToeplitzCompute },
+    { "Toeplitz.ComputeTables",     BenchToeplitzTables },
+    { "Time.Now",                   BenchTimeNow },
+    { "TimerWheel.Update",          BenchTimerWheelUpdate },
+    { "TimerWheel.Remove",          BenchTimerWheelRemove },
+    { "Lookup.FindByLocalCid",      BenchLookupLocalCid },
+    { "Crypt.Encrypt",              BenchEncrypt },
+    { "Crypt.Decrypt",              BenchDecrypt },
+    { "Crypt.EncryptBatch",         BenchEncryptBatch },
+    { "Crypt.HpMask",               BenchHpMaskSingle },
+    { "Crypt.HpMaskBatch",          BenchHpMaskBatch },
+};
+
+//
+// Reads a CSV file of name,ns_per_op lines, as written by -out.
+//
+static
+bool
+ReadBaseline(
+    _In_z_ const char* FileName,
+    _Out_ std::map<std::string, double>& Baseline
+    )
+{
+    Baseline.clear();
+    FILE* File = fopen(FileName, "r");
+    if (File == NULL) {
+        return false;
+    }
+    char Line[256];
+    while (fgets(Line, sizeof(Line), File) != NULL) {
+        char* Comma = strchr(Line, ',');
+        if (Comma == NULL) {
+            continue;
+        }
+        *Comma = '\0';
+        char* End;
+        double Value = strtod(Comma + 1, &End);
+        if (End != Comma + 1) {
+            Baseline[Line] = Value;
+        }
+    }
+    fclose(File);
+    return true;
+}
+
+static
+const char*
+GetValue(
+    _In_ int argc,
+    _In_reads_(argc) char** argv,
+    _In_z_ const char* Name
+    )
+{
+    const size_t NameLen = strlen(Name);
+    for (int i = 1; i < argc; ++i) {
+        if (argv[i][0] == '-' &&
+            strncmp(argv[i] + 1, Name, NameLen) == 0 &&
+            argv[i][NameLen + 1] == ':') {
+            return argv[i] + NameLen + 2;
+        }
+    }
+    return NULL;
+}
+
+static
+void
+PrintUsage()
+{
+    printf(
+        "Usage: msquiccorebench [options]\n"
+        "\n"
+        "  -filter:<substring>     Only runs the benchmarks whose name contains the substring.\n"
+        "  -iterations:<count>     The number of operations per run. (def:%u)\n"
+        "  -runs:<count>           The number of runs of each benchmark; the fastest is reported. (def:%u)\n"
+        "  -out:<file>             Writes the results to a CSV file (name,ns_per_op).\n"
+        "  -baseline:<file>        Compares the results to a CSV file written by -out.\n"
+        "  -threshold:<percent>    How much slower than the baseline is a regression. (def:%u)\n"
+        "\n",
+        BENCH_DEFAULT_ITERATIONS,
+        BENCH_DEFAULT_RUNS,
+        BENCH_DEFAULT_THRESHOLD);
+}
+
+int
+main(
+    _In_ int argc,
+    _In_reads_(argc) _Null_terminated_ char** argv
+    )
+{
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "-?") || !strcmp(argv[i], "-help")) {
+            PrintUsage();
+            return 0;
+        }
+    }
+
+    const char* Filter = GetValue(argc, argv, "filter");
+    const char* OutFile = GetValue(argc, argv, "out");
+    const char* BaselineFile = GetValue(argc, argv, "baseline");
+    const char* Value;
+    uint32_t Iterations = BENCH_DEFAULT_ITERATIONS;
+    uint32_t Runs = BENCH_DEFAULT_RUNS;
+    uint32_t Threshold = BENCH_DEFAULT_THRESHOLD;
+    if ((Value = GetValue(argc, argv, "iterations")) != NULL) {
+        Iterations = (uint32_t)strtoul(Value, NULL, 10);
+    }
+    if ((Value = GetValue(argc, argv, "runs")) != NULL) {
+        Runs = (uint32_t)strtoul(Value, NULL, 10);
+    }
+    if ((Value = GetValue(argc, argv, "threshold")) != NULL) {
+        Threshold = (uint32_t)strtoul(Value, NULL, 10);
+    }
+    if (Iterations == 0 || Runs == 0) {
+        PrintUsage();
+        return 1;
+    }
+
+    std::map<std::string, double> Baseline;
+    if (BaselineFile != NULL && !ReadBaseline(BaselineFile, Baseline)) {
+        printf("Failed to read baseline file '%s'\n", BaselineFile);
+        return 1;
+    }
+
+    FILE* Out = NULL;
+    if (OutFile != NULL && (Out = fopen(OutFile, "w")) == NULL) {
+        printf("Failed to open output file '%s'\n", OutFile);
+        return 1;
+    }
+
+    CxPlatSystemLoad();
+    if (QUIC_FAILED(CxPlatInitialize())) {
+        printf("CxPlatInitialize failed\n");
+        CxPlatSystemUnload();
+        if (Out != NULL) {
+            fclose(Out);
+        }
+        return 1;
+    }
+
+    uint32_t Regressions = 0;
+    for (const BENCH& Bench : Benchmarks) {
+        if (Filter != NULL && strstr(Bench.Name, Filter) == NULL) {
+            continue;
+        }
+
+        double Best = 0.0;
+        for (uint32_t Run = 0; Run < Runs; ++Run) {
+            double Result = Bench.Run(Iterations);
+            if (Run == 0 || Result < Best) {
+                Best = Result;
+            }
+        }
+
+        printf("%-24s %10.2f ns/op", Bench.Name, Best);
+        auto Previous = Baseline.find(Bench.Name);
+        if (Previous != Baseline.end() && Previous->second > 0.0) {
+            double Change = (Best - Previous->second) * 100.0 / Previous->second;
+            printf("  (%+.1f%% vs %.2f)", Change, Previous->second);
+            if (Change > (double)Threshold) {
+                printf("  REGRESSION");
+                ++Regressions;
+            }
+        }
+        printf("\n");
+
+        if (Out != NULL) {
+            fprintf(Out, "%s,%.2f\n", Bench.Name, Best);
+        }
+    }
+
+    CxPlatUninitialize();
+    CxPlatSystemUnload();
+    CxPlatZeroMemory(&MsQuicLib, sizeof(MsQuicLib));
+    if (Out != NULL) {
+        fclose(Out);
+    }
+
+    if (Regressions != 0) {
+        printf("%u benchmark(s) regressed more than %u%%\n", Regressions, Threshold);
+        return 1;
+    }
+    return 0;
+}
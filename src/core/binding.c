@@ -33,6 +33,56 @@ CXPLAT_STATIC_ASSERT(
     QUIC_DPLPMTUD_MIN_MTU - 48 >= MAX_VER_NEG_PACKET_LENGTH,
     "Too many supported version numbers! Requires too big of buffer for response!");
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+void
+QuicBindingFreeListenerLocks(
+    _In_ QUIC_BINDING* Binding
+    )
+{
+    if (Binding->ListenerLocks != NULL) {
+        for (uint16_t i = 0; i < MsQuicLib.PartitionCount; ++i) {
+            CxPlatDispatchRwLockUninitialize(&Binding->ListenerLocks[i].Lock);
+        }
+        CXPLAT_FREE(Binding->ListenerLocks, QUIC_POOL_LISTENER_LOCK);
+        Binding->ListenerLocks = NULL;
+    }
+}
+
+//
+// Acquires exclusive access to the binding's listener list, which requires the
+// main lock and every per-partition listener lock.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+void
+QuicBindingAcquireListenersExclusive(
+    _In_ QUIC_BINDING* Binding
+    )
+{
+    CxPlatDispatchRwLockAcquireExclusive(&Binding->RwLock);
+    if (Binding->ListenerLocks != NULL) {
+        for (uint16_t i = 0; i < MsQuicLib.PartitionCount; ++i) {
+            CxPlatDispatchRwLockAcquireExclusive(&Binding->ListenerLocks[i].Lock);
+        }
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+void
+QuicBindingReleaseListenersExclusive(
+    _In_ QUIC_BINDING* Binding
+    )
+{
+    if (Binding->ListenerLocks != NULL) {
+        for (uint16_t i = MsQuicLib.PartitionCount; i > 0; --i) {
+            CxPlatDispatchRwLockReleaseExclusive(&Binding->ListenerLocks[i - 1].Lock);
+        }
+    }
+    CxPlatDispatchRwLockReleaseExclusive(&Binding->RwLock);
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 QUIC_STATUS
 QuicBindingInitialize(
@@ -55,6 +105,7 @@ QuicBindingInitialize(
         goto Error;
     }
 
+    Binding->OwnerType = QUIC_SOCKET_OWNER_BINDING;
     Binding->RefCount = 0; // No refs until it's added to the library's list
     Binding->Exclusive = !(UdpConfig->Flags & CXPLAT_SOCKET_FLAG_SHARE);
     Binding->ServerOwned = !!(UdpConfig->Flags & CXPLAT_SOCKET_SERVER_OWNED);
@@ -62,6 +113,11 @@ QuicBindingInitialize(
     Binding->StatelessOperCount = 0;
     CxPlatDispatchRwLockInitialize(&Binding->RwLock);
     CxPlatDispatchLockInitialize(&Binding->StatelessOperLock);
+    CxPlatDispatchLockInitialize(&Binding->SourceRateLock);
+    Binding->SourceRates = NULL;
+    Binding->ListenerLocks = NULL;
+    Binding->VerNegVersions = NULL;
+    Binding->VerNegVersionsLength = 0;
     CxPlatListInitializeHead(&Binding->Listeners);
     QuicLookupInitialize(&Binding->Lookup);
     if (!CxPlatHashtableInitializeEx(&Binding->StatelessOperTable, CXPLAT_HASH_MIN_SIZE)) {
@@ -71,6 +127,43 @@ QuicBindingInitialize(
     HashTableInitialized = TRUE;
     CxPlatListInitializeHead(&Binding->StatelessOperList);
 
+    if (Binding->ServerOwned) {
+        Binding->SourceRates =
+            CXPLAT_ALLOC_NONPAGED(
+                QUIC_SOURCE_RATE_TABLE_SIZE * sizeof(QUIC_SOURCE_RATE_ENTRY),
+                QUIC_POOL_SOURCE_RATE);
+        if (Binding->SourceRates == NULL) {
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "source rate table",
+                QUIC_SOURCE_RATE_TABLE_SIZE * sizeof(QUIC_SOURCE_RATE_ENTRY));
+            Status = QUIC_STATUS_OUT_OF_MEMORY;
+            goto Error;
+        }
+        CxPlatZeroMemory(
+            Binding->SourceRates,
+            QUIC_SOURCE_RATE_TABLE_SIZE * sizeof(QUIC_SOURCE_RATE_ENTRY));
+        CxPlatRandom(sizeof(Binding->SourceRateSeed), &Binding->SourceRateSeed);
+
+        Binding->ListenerLocks =
+            CXPLAT_ALLOC_NONPAGED(
+                MsQuicLib.PartitionCount * sizeof(QUIC_BINDING_LISTENER_LOCK),
+                QUIC_POOL_LISTENER_LOCK);
+        if (Binding->ListenerLocks == NULL) {
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "listener locks",
+                MsQuicLib.PartitionCount * sizeof(QUIC_BINDING_LISTENER_LOCK));
+            Status = QUIC_STATUS_OUT_OF_MEMORY;
+            goto Error;
+        }
+        for (uint16_t i = 0; i < MsQuicLib.PartitionCount; ++i) {
+            CxPlatDispatchRwLockInitialize(&Binding->ListenerLocks[i].Lock);
+        }
+    }
+
     //
     // Random reserved version number for version negotation.
     //
@@ -79,6 +172,12 @@ QuicBindingInitialize(
         (Binding->RandomReservedVersion & ~QUIC_VERSION_RESERVED_MASK) |
         QUIC_VERSION_RESERVED;
 
+    if (Binding->ServerOwned &&
+        !QuicBindingUpdateVersionNegotiation(Binding)) {
+        Status = QUIC_STATUS_OUT_OF_MEMORY;
+        goto Error;
+    }
+
 #ifdef QUIC_COMPARTMENT_ID
     Binding->CompartmentId = UdpConfig->CompartmentId;
 
@@ -175,6 +274,14 @@ Error:
             if (HashTableInitialized) {
                 CxPlatHashtableUninitialize(&Binding->StatelessOperTable);
             }
+            if (Binding->SourceRates != NULL) {
+                CXPLAT_FREE(Binding->SourceRates, QUIC_POOL_SOURCE_RATE);
+            }
+            QuicBindingFreeListenerLocks(Binding);
+            if (Binding->VerNegVersions != NULL) {
+                CXPLAT_FREE(Binding->VerNegVersions, QUIC_POOL_VER_NEG_TEMPLATE);
+            }
+            CxPlatDispatchLockUninitialize(&Binding->SourceRateLock);
             CxPlatDispatchLockUninitialize(&Binding->StatelessOperLock);
             CxPlatDispatchRwLockUninitialize(&Binding->RwLock);
             CXPLAT_FREE(Binding, QUIC_POOL_BINDING);
@@ -198,6 +305,12 @@ QuicBindingUninitialize(
     CXPLAT_TEL_ASSERT(Binding->RefCount == 0);
     CXPLAT_TEL_ASSERT(CxPlatListIsEmpty(&Binding->Listeners));
 
+    //
+    // Drop any datagrams the network emulator is still holding for the
+    // binding. Any received from now on are processed directly.
+    //
+    QuicNetEmuRemoveBinding(&MsQuicLib.NetEmu, Binding);
+
     //
     // Delete the datapath binding. This function blocks until all receive
     // upcalls have completed.
@@ -229,6 +342,14 @@ QuicBindingUninitialize(
     QuicLookupUninitialize(&Binding->Lookup);
     CxPlatDispatchLockUninitialize(&Binding->StatelessOperLock);
     CxPlatHashtableUninitialize(&Binding->StatelessOperTable);
+    if (Binding->SourceRates != NULL) {
+        CXPLAT_FREE(Binding->SourceRates, QUIC_POOL_SOURCE_RATE);
+    }
+    QuicBindingFreeListenerLocks(Binding);
+    if (Binding->VerNegVersions != NULL) {
+        CXPLAT_FREE(Binding->VerNegVersions, QUIC_POOL_VER_NEG_TEMPLATE);
+    }
+    CxPlatDispatchLockUninitialize(&Binding->SourceRateLock);
     CxPlatDispatchRwLockUninitialize(&Binding->RwLock);
 
     QuicTraceEvent(
@@ -327,7 +448,7 @@ QuicBindingRegisterListener(
     const BOOLEAN NewWildCard = NewListener->WildCard;
     const QUIC_ADDRESS_FAMILY NewFamily = QuicAddrGetFamily(NewAddr);
 
-    CxPlatDispatchRwLockAcquireExclusive(&Binding->RwLock);
+    QuicBindingAcquireListenersExclusive(Binding);
 
     //
     // For a single binding, listeners are saved in a linked list, sorted by
@@ -397,7 +518,7 @@ QuicBindingRegisterListener(
         }
     }
 
-    CxPlatDispatchRwLockReleaseExclusive(&Binding->RwLock);
+    QuicBindingReleaseListenersExclusive(Binding);
 
     if (MaximizeLookup &&
         !QuicLookupMaximizePartitioning(&Binding->Lookup)) {
@@ -414,6 +535,7 @@ QUIC_LISTENER*
 QuicBindingGetListener(
     _In_ QUIC_BINDING* Binding,
     _In_opt_ QUIC_CONNECTION* Connection,
+    _In_ uint16_t PartitionIndex,
     _Inout_ QUIC_NEW_CONNECTION_INFO* Info
     )
 {
@@ -426,7 +548,23 @@ QuicBindingGetListener(
     BOOLEAN FailedAlpnMatch = FALSE;
     BOOLEAN FailedAddrMatch = TRUE;
 
-    CxPlatDispatchRwLockAcquireShared(&Binding->RwLock);
+    //
+    // Filter the client's ALPNs once, rather than per listener.
+    //
+    QUIC_ALPN_FILTER ClientAlpnFilter;
+    QuicAlpnFilterBuild(
+        Info->ClientAlpnListLength,
+        Info->ClientAlpnList,
+        &ClientAlpnFilter);
+
+    //
+    // Only the connection's partition's lock is needed to find the listener,
+    // so that concurrent accepts on different partitions don't contend.
+    //
+    CXPLAT_DISPATCH_RW_LOCK* Lock =
+        Binding->ListenerLocks != NULL ?
+            &Binding->ListenerLocks[PartitionIndex].Lock : &Binding->RwLock;
+    CxPlatDispatchRwLockAcquireShared(Lock);
 
     for (CXPLAT_LIST_ENTRY* Link = Binding->Listeners.Flink;
         Link != &Binding->Listeners;
@@ -448,8 +586,8 @@ QuicBindingGetListener(
         }
         FailedAddrMatch = FALSE;
 
-        if (QuicListenerMatchesAlpn(ExistingListener, Info)) {
-            if (CxPlatRefIncrementNonZero(&ExistingListener->RefCount, 1)) {
+        if (QuicListenerMatchesAlpn(ExistingListener, &ClientAlpnFilter, Info)) {
+            if (QuicListenerAcquirePartitionRef(ExistingListener, PartitionIndex)) {
                 Listener = ExistingListener;
             }
             goto Done;
@@ -460,7 +598,7 @@ QuicBindingGetListener(
 
 Done:
 
-    CxPlatDispatchRwLockReleaseShared(&Binding->RwLock);
+    CxPlatDispatchRwLockReleaseShared(Lock);
 
     if (FailedAddrMatch) {
         QuicTraceEvent(
@@ -487,9 +625,9 @@ QuicBindingUnregisterListener(
     _In_ QUIC_LISTENER* Listener
     )
 {
-    CxPlatDispatchRwLockAcquireExclusive(&Binding->RwLock);
+    QuicBindingAcquireListenersExclusive(Binding);
     CxPlatListEntryRemove(&Listener->Link);
-    CxPlatDispatchRwLockReleaseExclusive(&Binding->RwLock);
+    QuicBindingReleaseListenersExclusive(Binding);
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -502,9 +640,12 @@ QuicBindingAcceptConnection(
 {
     //
     // Find a listener that matches the incoming connection request, by IP, port
-    // and ALPN.
+    // and ALPN. The listener reference is taken (and released) on the
+    // connection's partition.
     //
-    QUIC_LISTENER* Listener = QuicBindingGetListener(Binding, Connection, Info);
+    const uint16_t PartitionIndex = QuicPartitionIdGetIndex(Connection->PartitionID);
+    QUIC_LISTENER* Listener =
+        QuicBindingGetListener(Binding, Connection, PartitionIndex, Info);
     if (Listener == NULL) {
         QuicTraceEvent(
             ConnError,
@@ -553,7 +694,7 @@ QuicBindingAcceptConnection(
 
 Error:
 
-    QuicListenerRelease(Listener, TRUE);
+    QuicListenerReleasePartitionRef(Listener, PartitionIndex, TRUE);
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -602,6 +743,28 @@ QuicBindingMoveSourceConnectionIDs(
         &BindingSrc->Lookup, &BindingDest->Lookup, Connection);
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicBindingAddStandbyConnection(
+    _In_ QUIC_BINDING* Binding,
+    _In_ QUIC_CONNECTION* Connection
+    )
+{
+    return
+        Binding->Exclusive &&
+        QuicLookupAddStandbyConnection(&Binding->Lookup, Connection);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicBindingRemoveStandbyConnection(
+    _In_ QUIC_BINDING* Binding,
+    _In_ QUIC_CONNECTION* Connection
+    )
+{
+    QuicLookupRemoveStandbyConnection(&Binding->Lookup, Connection);
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 void
 QuicBindingOnConnectionHandshakeConfirmed(
@@ -784,6 +947,178 @@ QuicBindingQueueStatelessOperation(
     return TRUE;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicBindingUpdateVersionNegotiation(
+    _In_ QUIC_BINDING* Binding
+    )
+{
+    const uint32_t* SupportedVersions;
+    uint32_t SupportedVersionsLength;
+    if (MsQuicLib.Settings.IsSet.VersionSettings) {
+        SupportedVersions = MsQuicLib.Settings.VersionSettings->OfferedVersions;
+        SupportedVersionsLength = MsQuicLib.Settings.VersionSettings->OfferedVersionsLength;
+    } else {
+        SupportedVersions = DefaultSupportedVersionsList;
+        SupportedVersionsLength = ARRAYSIZE(DefaultSupportedVersionsList);
+    }
+
+    const uint16_t VersionsLength =
+        (uint16_t)((1 + SupportedVersionsLength) * sizeof(uint32_t));
+    uint32_t* Versions =
+        CXPLAT_ALLOC_NONPAGED(VersionsLength, QUIC_POOL_VER_NEG_TEMPLATE);
+    if (Versions == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "vn template",
+            VersionsLength);
+        return FALSE;
+    }
+
+    Versions[0] = Binding->RandomReservedVersion;
+    CxPlatCopyMemory(
+        Versions + 1,
+        SupportedVersions,
+        SupportedVersionsLength * sizeof(uint32_t));
+
+    CxPlatDispatchRwLockAcquireExclusive(&Binding->RwLock);
+    uint32_t* OldVersions = Binding->VerNegVersions;
+    Binding->VerNegVersions = Versions;
+    Binding->VerNegVersionsLength = VersionsLength;
+    CxPlatDispatchRwLockReleaseExclusive(&Binding->RwLock);
+
+    if (OldVersions != NULL) {
+        CXPLAT_FREE(OldVersions, QUIC_POOL_VER_NEG_TEMPLATE);
+    }
+
+    return TRUE;
+}
+
+//
+// Writes a Version Negotiation packet, in response to the received packet, with
+// the binding's precomputed version list.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+static
+QUIC_BUFFER*
+QuicBindingWriteVersionNegotiation(
+    _In_ QUIC_BINDING* Binding,
+    _In_ const QUIC_RX_PACKET* RecvPacket,
+    _In_ CXPLAT_SEND_DATA* SendData
+    )
+{
+    QUIC_BUFFER* SendDatagram = NULL;
+
+    CXPLAT_DBG_ASSERT(RecvPacket->DestCid != NULL);
+    CXPLAT_DBG_ASSERT(RecvPacket->SourceCid != NULL);
+
+    CxPlatDispatchRwLockAcquireShared(&Binding->RwLock);
+
+    if (Binding->VerNegVersions == NULL) {
+        goto Exit;
+    }
+
+    const uint16_t PacketLength =
+        sizeof(QUIC_VERSION_NEGOTIATION_PACKET) +               // Header
+        RecvPacket->SourceCidLen +
+        sizeof(uint8_t) +
+        RecvPacket->DestCidLen +
+        Binding->VerNegVersionsLength;                          // Reserved + supported versions
+
+    SendDatagram =
+        CxPlatSendDataAllocBuffer(SendData, PacketLength);
+    if (SendDatagram == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "vn datagram",
+            PacketLength);
+        goto Exit;
+    }
+
+    QUIC_VERSION_NEGOTIATION_PACKET* VerNeg =
+        (QUIC_VERSION_NEGOTIATION_PACKET*)SendDatagram->Buffer;
+    CXPLAT_DBG_ASSERT(SendDatagram->Length == PacketLength);
+
+    VerNeg->IsLongHeader = TRUE;
+    VerNeg->Version = QUIC_VERSION_VER_NEG;
+
+    uint8_t* Buffer = VerNeg->DestCid;
+    VerNeg->DestCidLength = RecvPacket->SourceCidLen;
+    CxPlatCopyMemory(
+        Buffer,
+        RecvPacket->SourceCid,
+        RecvPacket->SourceCidLen);
+    Buffer += RecvPacket->SourceCidLen;
+
+    *Buffer = RecvPacket->DestCidLen;
+    Buffer++;
+    CxPlatCopyMemory(
+        Buffer,
+        RecvPacket->DestCid,
+        RecvPacket->DestCidLen);
+    Buffer += RecvPacket->DestCidLen;
+
+    uint8_t RandomValue = 0;
+    CxPlatRandom(sizeof(uint8_t), &RandomValue);
+    VerNeg->Unused = 0x7F & RandomValue;
+
+    CxPlatCopyMemory(
+        Buffer,
+        Binding->VerNegVersions,
+        Binding->VerNegVersionsLength);
+
+    QuicTraceLogVerbose(
+        PacketTxVersionNegotiation,
+        "[S][TX][-] VN");
+
+Exit:
+
+    CxPlatDispatchRwLockReleaseShared(&Binding->RwLock);
+
+    return SendDatagram;
+}
+
+//
+// Statelessly responds to a packet with an unsupported version, directly on
+// the receive path. Unlike the other stateless operations, this doesn't need a
+// worker, because the response is never larger than the received packet.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+static
+void
+QuicBindingSendVersionNegotiation(
+    _In_ QUIC_BINDING* Binding,
+    _In_ const QUIC_RX_PACKET* RecvPacket
+    )
+{
+    CXPLAT_SEND_CONFIG SendConfig = { RecvPacket->Route, 0, CXPLAT_ECN_NON_ECT, 0 };
+    CXPLAT_SEND_DATA* SendData = CxPlatSendDataAlloc(Binding->Socket, &SendConfig);
+    if (SendData == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "stateless send data",
+            0);
+        return;
+    }
+
+    QUIC_BUFFER* SendDatagram =
+        QuicBindingWriteVersionNegotiation(Binding, RecvPacket, SendData);
+    if (SendDatagram == NULL) {
+        CxPlatSendDataFree(SendData);
+        return;
+    }
+
+    QuicBindingSend(
+        Binding,
+        RecvPacket->Route,
+        SendData,
+        SendDatagram->Length,
+        1);
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicBindingProcessStatelessOperation(
@@ -816,79 +1151,14 @@ QuicBindingProcessStatelessOperation(
 
     if (OperationType == QUIC_OPER_TYPE_VERSION_NEGOTIATION) {
 
-        CXPLAT_DBG_ASSERT(RecvPacket->DestCid != NULL);
-        CXPLAT_DBG_ASSERT(RecvPacket->SourceCid != NULL);
-
-        const uint32_t* SupportedVersions;
-        uint32_t SupportedVersionsLength;
-        if (MsQuicLib.Settings.IsSet.VersionSettings) {
-            SupportedVersions = MsQuicLib.Settings.VersionSettings->OfferedVersions;
-            SupportedVersionsLength = MsQuicLib.Settings.VersionSettings->OfferedVersionsLength;
-        } else {
-            SupportedVersions = DefaultSupportedVersionsList;
-            SupportedVersionsLength = ARRAYSIZE(DefaultSupportedVersionsList);
-        }
-
-        const uint16_t PacketLength =
-            sizeof(QUIC_VERSION_NEGOTIATION_PACKET) +               // Header
-            RecvPacket->SourceCidLen +
-            sizeof(uint8_t) +
-            RecvPacket->DestCidLen +
-            sizeof(uint32_t) +                                      // One random version
-            (uint16_t)(SupportedVersionsLength * sizeof(uint32_t)); // Our actual supported versions
-
         SendDatagram =
-            CxPlatSendDataAllocBuffer(SendData, PacketLength);
+            QuicBindingWriteVersionNegotiation(Binding, RecvPacket, SendData);
         if (SendDatagram == NULL) {
-            QuicTraceEvent(
-                AllocFailure,
-                "Allocation of '%s' failed. (%llu bytes)",
-                "vn datagram",
-                PacketLength);
             goto Exit;
         }
 
-        QUIC_VERSION_NEGOTIATION_PACKET* VerNeg =
-            (QUIC_VERSION_NEGOTIATION_PACKET*)SendDatagram->Buffer;
-        CXPLAT_DBG_ASSERT(SendDatagram->Length == PacketLength);
-
-        VerNeg->IsLongHeader = TRUE;
-        VerNeg->Version = QUIC_VERSION_VER_NEG;
-
-        uint8_t* Buffer = VerNeg->DestCid;
-        VerNeg->DestCidLength = RecvPacket->SourceCidLen;
-        CxPlatCopyMemory(
-            Buffer,
-            RecvPacket->SourceCid,
-            RecvPacket->SourceCidLen);
-        Buffer += RecvPacket->SourceCidLen;
-
-        *Buffer = RecvPacket->DestCidLen;
-        Buffer++;
-        CxPlatCopyMemory(
-            Buffer,
-            RecvPacket->DestCid,
-            RecvPacket->DestCidLen);
-        Buffer += RecvPacket->DestCidLen;
-
-        uint8_t RandomValue = 0;
-        CxPlatRandom(sizeof(uint8_t), &RandomValue);
-        VerNeg->Unused = 0x7F & RandomValue;
-
-        CxPlatCopyMemory(Buffer, &Binding->RandomReservedVersion, sizeof(uint32_t));
-        Buffer += sizeof(uint32_t);
-
-        CxPlatCopyMemory(
-            Buffer,
-            SupportedVersions,
-            SupportedVersionsLength * sizeof(uint32_t));
-
         RecvPacket->ReleaseDeferred = FALSE;
 
-        QuicTraceLogVerbose(
-            PacketTxVersionNegotiation,
-            "[S][TX][-] VN");
-
     } else if (OperationType == QUIC_OPER_TYPE_STATELESS_RESET) {
 
         CXPLAT_DBG_ASSERT(RecvPacket->DestCid != NULL);
@@ -1170,9 +1440,7 @@ QuicBindingPreprocessPacket(
                 QuicPacketLogDrop(Binding, Packet, "Too small to send VN");
 
             } else {
-                *ReleaseDatagram =
-                    !QuicBindingQueueStatelessOperation(
-                        Binding, QUIC_OPER_TYPE_VERSION_NEGOTIATION, Packet);
+                QuicBindingSendVersionNegotiation(Binding, Packet);
             }
             return FALSE;
         }
@@ -1199,6 +1467,91 @@ QuicBindingPreprocessPacket(
     return TRUE;
 }
 
+//
+// Refills a token bucket for the time elapsed and tries to take one attempt
+// out of it. The bucket holds up to one second's worth of attempts.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+static
+BOOLEAN
+QuicSourceRateTakeToken(
+    _Inout_ uint32_t* Tokens,
+    _In_ uint32_t Rate,
+    _In_ uint32_t ElapsedMs
+    )
+{
+    const uint32_t Capacity = Rate * 1000;
+    const uint64_t NewTokens = (uint64_t)*Tokens + (uint64_t)ElapsedMs * Rate;
+    *Tokens = NewTokens > Capacity ? Capacity : (uint32_t)NewTokens;
+    if (*Tokens < 1000) {
+        return FALSE;
+    }
+    *Tokens -= 1000;
+    return TRUE;
+}
+
+//
+// Charges a new connection attempt to the packet's source address prefix and
+// returns what to do with it, based on the configured per-source rates.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+static
+QUIC_SOURCE_RATE_ACTION
+QuicBindingCheckSourceRate(
+    _In_ QUIC_BINDING* Binding,
+    _In_ const QUIC_RX_PACKET* Packet
+    )
+{
+    const QUIC_SOURCE_RATE_LIMIT Limit = MsQuicLib.SourceRateLimit;
+    if (Binding->SourceRates == NULL ||
+        (Limit.RetryRate == 0 && Limit.DropRate == 0)) {
+        return QUIC_SOURCE_RATE_ACCEPT;
+    }
+
+    //
+    // Hash the (seeded) source prefix to find its entry.
+    //
+    const QUIC_ADDR* RemoteAddress = &Packet->Route->RemoteAddress;
+    uint8_t Key[sizeof(uint32_t) + 16] = {0};
+    CxPlatCopyMemory(Key, &Binding->SourceRateSeed, sizeof(uint32_t));
+    const uint8_t* Address;
+    uint8_t PrefixLength;
+    if (QuicAddrGetFamily(RemoteAddress) == QUIC_ADDRESS_FAMILY_INET) {
+        Address = (const uint8_t*)&RemoteAddress->Ipv4.sin_addr;
+        PrefixLength = Limit.Ipv4PrefixLength;
+    } else {
+        Address = (const uint8_t*)&RemoteAddress->Ipv6.sin6_addr;
+        PrefixLength = Limit.Ipv6PrefixLength;
+    }
+    uint8_t* Prefix = Key + sizeof(uint32_t);
+    CxPlatCopyMemory(Prefix, Address, (PrefixLength + 7) / 8);
+    if (PrefixLength % 8 != 0) {
+        Prefix[PrefixLength / 8] &= (uint8_t)(0xFF << (8 - PrefixLength % 8));
+    }
+    const uint32_t Index =
+        CxPlatHashSimple(sizeof(Key), Key) & (QUIC_SOURCE_RATE_TABLE_SIZE - 1);
+
+    QUIC_SOURCE_RATE_ACTION Action = QUIC_SOURCE_RATE_ACCEPT;
+    const uint32_t Now = CxPlatTimeMs32();
+
+    CxPlatDispatchLockAcquire(&Binding->SourceRateLock);
+    QUIC_SOURCE_RATE_ENTRY* Entry = &Binding->SourceRates[Index];
+    const uint32_t ElapsedMs = Now - Entry->LastTimeMs;
+    Entry->LastTimeMs = Now;
+    if (Limit.DropRate != 0 &&
+        !QuicSourceRateTakeToken(&Entry->DropTokens, Limit.DropRate, ElapsedMs)) {
+        Action = QUIC_SOURCE_RATE_DROP;
+    }
+    if (Limit.RetryRate != 0 &&
+        !QuicSourceRateTakeToken(&Entry->RetryTokens, Limit.RetryRate, ElapsedMs) &&
+        Action == QUIC_SOURCE_RATE_ACCEPT) {
+        Action = QUIC_SOURCE_RATE_RETRY;
+    }
+    CxPlatDispatchLockRelease(&Binding->SourceRateLock);
+
+    return Action;
+}
+
 //
 // Returns TRUE if we should respond to the connection attempt with a Retry
 // packet.
@@ -1211,6 +1564,7 @@ QuicBindingShouldRetryConnection(
     _In_ uint16_t TokenLength,
     _In_reads_(TokenLength)
         const uint8_t* Token,
+    _In_ BOOLEAN SourceOverRate,
     _Inout_ BOOLEAN* DropPacket
     )
 {
@@ -1218,8 +1572,9 @@ QuicBindingShouldRetryConnection(
     // This is only called once we've determined we can create a new connection.
     // If there is a token, it validates the token. If there is no token, then
     // the function checks to see if the binding currently has too many
-    // connections in the handshake state already. If so, it requests the client
-    // to retry its connection attempt to prove source address ownership.
+    // connections in the handshake state already, or if the library is under
+    // high memory pressure. If so, it requests the client to retry its
+    // connection attempt to prove source address ownership.
     //
 
     if (TokenLength != 0) {
@@ -1238,6 +1593,18 @@ QuicBindingShouldRetryConnection(
         }
     }
 
+    //
+    // Sources exceeding their rate of new connections must prove they own
+    // their address, even when the library as a whole isn't under pressure.
+    //
+    if (SourceOverRate) {
+        return TRUE;
+    }
+
+    if (QuicLibraryGetMemoryPressure() >= QUIC_MEMORY_PRESSURE_HIGH) {
+        return TRUE;
+    }
+
     uint64_t CurrentMemoryLimit =
         (MsQuicLib.Settings.RetryMemoryLimit * CxPlatTotalMemory) / UINT16_MAX;
 
@@ -1353,7 +1720,7 @@ Exit:
 
     } else {
         NewConnection->SourceCids.Next = NULL;
-        CXPLAT_FREE(SourceCid, QUIC_POOL_CIDHASH);
+        QuicCidFreeSource(SourceCid);
         QuicConnRelease(NewConnection, QUIC_CONN_REF_LOOKUP_RESULT);
 #pragma prefast(suppress:6001, "SAL doesn't understand ref counts")
         QuicConnRelease(NewConnection, QUIC_CONN_REF_HANDLE_OWNER);
@@ -1560,9 +1927,25 @@ QuicBindingDeliverPackets(
 
         CXPLAT_DBG_ASSERT(Binding->ServerOwned);
 
+        //
+        // Apply the per-source rate limits before any further (decryption)
+        // work is done for the packet.
+        //
+        const QUIC_SOURCE_RATE_ACTION SourceRateAction =
+            QuicBindingCheckSourceRate(Binding, Packets);
+        if (SourceRateAction == QUIC_SOURCE_RATE_DROP) {
+            QuicPacketLogDrop(Binding, Packets, "Source rate limit exceeded");
+            return FALSE;
+        }
+
         BOOLEAN DropPacket = FALSE;
         if (QuicBindingShouldRetryConnection(
-                Binding, Packets, TokenLength, Token, &DropPacket)) {
+                Binding,
+                Packets,
+                TokenLength,
+                Token,
+                SourceRateAction == QUIC_SOURCE_RATE_RETRY,
+                &DropPacket)) {
             return
                 QuicBindingQueueStatelessOperation(
                     Binding, QUIC_OPER_TYPE_RETRY, Packets);
@@ -1597,7 +1980,31 @@ QuicBindingReceive(
     CXPLAT_DBG_ASSERT(RecvCallbackContext != NULL);
     CXPLAT_DBG_ASSERT(DatagramChain != NULL);
 
+    if (*(QUIC_SOCKET_OWNER_TYPE*)RecvCallbackContext == QUIC_SOCKET_OWNER_DATAGRAM_RELAY) {
+        QuicDatagramRelayReceive(
+            (QUIC_DATAGRAM_RELAY*)RecvCallbackContext,
+            DatagramChain);
+        return;
+    }
+
     QUIC_BINDING* Binding = (QUIC_BINDING*)RecvCallbackContext;
+    CXPLAT_DBG_ASSERT(Socket == Binding->Socket);
+
+    if (MsQuicLib.NetEmu.Enabled &&
+        QuicNetEmuReceive(&MsQuicLib.NetEmu, Binding, DatagramChain)) {
+        return;
+    }
+
+    QuicBindingReceiveDatagrams(Binding, DatagramChain);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicBindingReceiveDatagrams(
+    _In_ QUIC_BINDING* Binding,
+    _In_ CXPLAT_RECV_DATA* DatagramChain
+    )
+{
     CXPLAT_RECV_DATA* ReleaseChain = NULL;
     CXPLAT_RECV_DATA** ReleaseChainTail = &ReleaseChain;
     CXPLAT_RECV_DATA* SubChain = NULL;
@@ -1607,8 +2014,7 @@ QuicBindingReceive(
     uint32_t SubChainBytes = 0;
     uint32_t TotalChainLength = 0;
     uint32_t TotalDatagramBytes = 0;
-
-    CXPLAT_DBG_ASSERT(Socket == Binding->Socket);
+    QuicStageCyclesStart(ReceiveStart);
 
     //
     // Breaks the chain of datagrams into subchains by destination CID and
@@ -1648,6 +2054,7 @@ QuicBindingReceive(
         Packet->DestCidLen = 0;
         Packet->SourceCidLen = 0;
         Packet->KeyType = QUIC_PACKET_KEY_INITIAL;
+        Packet->HoldCount = 0;
         Packet->Flags = 0;
 
         CXPLAT_DBG_ASSERT(Packet->PacketId != 0);
@@ -1699,7 +2106,11 @@ QuicBindingReceive(
             QUIC_RX_PACKET* SubChainPacket = (QUIC_RX_PACKET*)SubChain;
             if ((Packet->DestCidLen != SubChainPacket->DestCidLen ||
                  memcmp(Packet->DestCid, SubChainPacket->DestCid, Packet->DestCidLen) != 0)) {
-                if (!QuicBindingDeliverPackets(Binding, (QUIC_RX_PACKET*)SubChain, SubChainLength, SubChainBytes)) {
+                QuicStageCyclesStart(DeliverStart);
+                BOOLEAN Delivered =
+                    QuicBindingDeliverPackets(Binding, (QUIC_RX_PACKET*)SubChain, SubChainLength, SubChainBytes);
+                QuicStageCyclesEnd(QUIC_PERF_STAGE_DELIVER, DeliverStart, SubChainLength);
+                if (!Delivered) {
                     *ReleaseChainTail = SubChain;
                     ReleaseChainTail = SubChainDataTail;
                 }
@@ -1741,7 +2152,11 @@ QuicBindingReceive(
         //
         // Deliver the last subchain.
         //
-        if (!QuicBindingDeliverPackets(Binding, (QUIC_RX_PACKET*)SubChain, SubChainLength, SubChainBytes)) {
+        QuicStageCyclesStart(DeliverStart);
+        BOOLEAN Delivered =
+            QuicBindingDeliverPackets(Binding, (QUIC_RX_PACKET*)SubChain, SubChainLength, SubChainBytes);
+        QuicStageCyclesEnd(QUIC_PERF_STAGE_DELIVER, DeliverStart, SubChainLength);
+        if (!Delivered) {
             *ReleaseChainTail = SubChain;
             ReleaseChainTail = SubChainTail; // cppcheck-suppress unreadVariable; NOLINT
         }
@@ -1754,6 +2169,7 @@ QuicBindingReceive(
     QuicPerfCounterAdd(QUIC_PERF_COUNTER_UDP_RECV, TotalChainLength);
     QuicPerfCounterAdd(QUIC_PERF_COUNTER_UDP_RECV_BYTES, TotalDatagramBytes);
     QuicPerfCounterIncrement(QUIC_PERF_COUNTER_UDP_RECV_EVENTS);
+    QuicStageCyclesEnd(QUIC_PERF_STAGE_RECEIVE, ReceiveStart, TotalChainLength);
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -1769,6 +2185,10 @@ QuicBindingUnreachable(
     CXPLAT_DBG_ASSERT(Context != NULL);
     CXPLAT_DBG_ASSERT(RemoteAddress != NULL);
 
+    if (*(QUIC_SOCKET_OWNER_TYPE*)Context == QUIC_SOCKET_OWNER_DATAGRAM_RELAY) {
+        return; // Relayed UDP is best effort; the peer's loss is the app's problem.
+    }
+
     QUIC_BINDING* Binding = (QUIC_BINDING*)Context;
 
     QUIC_CONNECTION* Connection =
@@ -1792,6 +2212,8 @@ QuicBindingSend(
     _In_ uint32_t DatagramsToSend
     )
 {
+    QuicStageCyclesStart(SendStart);
+
 #if QUIC_TEST_DATAPATH_HOOKS_ENABLED
     QUIC_TEST_DATAPATH_HOOKS* Hooks = MsQuicLib.TestDatapathHooks;
     if (Hooks != NULL) {
@@ -1820,6 +2242,8 @@ QuicBindingSend(
     }
 #endif
 
+    QuicStageCyclesEnd(QUIC_PERF_STAGE_DATAPATH_SEND, SendStart, DatagramsToSend);
+
     QuicPerfCounterAdd(QUIC_PERF_COUNTER_UDP_SEND, DatagramsToSend);
     QuicPerfCounterAdd(QUIC_PERF_COUNTER_UDP_SEND_BYTES, BytesToSend);
     QuicPerfCounterIncrement(QUIC_PERF_COUNTER_UDP_SEND_CALLS);
@@ -101,6 +101,12 @@ typedef struct QUIC_RX_PACKET {
     //
     QUIC_PACKET_KEY_TYPE KeyType;
 
+    //
+    // Number of zero-copy stream receives still referencing the decrypted
+    // payload of this datagram.
+    //
+    uint16_t HoldCount;
+
     union {
     uint32_t Flags;
     struct {
@@ -166,6 +172,12 @@ typedef struct QUIC_RX_PACKET {
     // Flag indicating the packet contained a non-probing frame.
     //
     BOOLEAN HasNonProbingFrame : 1;
+
+    //
+    // Flag indicating the connection is done processing the packet, but it is
+    // still held by a stream, so it is returned once HoldCount drops to zero.
+    //
+    BOOLEAN ReturnDeferred : 1;
     };
     };
 
@@ -179,17 +191,70 @@ typedef enum QUIC_BINDING_LOOKUP_TYPE {
 
 } QUIC_BINDING_LOOKUP_TYPE;
 
+//
+// A per-partition copy of the listener lock, so that new connections on
+// different partitions don't contend on the same lock (cache line).
+//
+typedef struct QUIC_CACHEALIGN QUIC_BINDING_LISTENER_LOCK {
+
+    CXPLAT_DISPATCH_RW_LOCK Lock;
+
+} QUIC_BINDING_LISTENER_LOCK;
+
+//
+// Token buckets for the new connection attempts of a source address prefix.
+// The tokens are in thousandths of an attempt.
+//
+typedef struct QUIC_SOURCE_RATE_ENTRY {
+    uint32_t LastTimeMs;
+    uint32_t RetryTokens;
+    uint32_t DropTokens;
+} QUIC_SOURCE_RATE_ENTRY;
+
+//
+// The number of source rate entries per server binding. Sources are hashed
+// into the table without tracking their actual prefix, so colliding sources
+// share their limits.
+//
+#define QUIC_SOURCE_RATE_TABLE_SIZE 1024
+
+typedef enum QUIC_SOURCE_RATE_ACTION {
+    QUIC_SOURCE_RATE_ACCEPT,
+    QUIC_SOURCE_RATE_RETRY,
+    QUIC_SOURCE_RATE_DROP
+} QUIC_SOURCE_RATE_ACTION;
+
+//
+// The library's datapath callbacks are shared by every socket it creates. Each
+// socket's callback context starts with one of these, so the callbacks can
+// tell bindings apart from the other socket owners.
+//
+typedef enum QUIC_SOCKET_OWNER_TYPE {
+    QUIC_SOCKET_OWNER_BINDING,
+    QUIC_SOCKET_OWNER_DATAGRAM_RELAY
+} QUIC_SOCKET_OWNER_TYPE;
+
 //
 // Represents a UDP binding of local IP address and UDP port, and optionally
 // remote IP address.
 //
 typedef struct QUIC_BINDING {
 
+    //
+    // Always QUIC_SOCKET_OWNER_BINDING. Must be the first field.
+    //
+    QUIC_SOCKET_OWNER_TYPE OwnerType;
+
     //
     // The link in the library's global list of bindings.
     //
     CXPLAT_LIST_ENTRY Link;
 
+    //
+    // The entry in the library's binding hash table.
+    //
+    CXPLAT_HASHTABLE_ENTRY HashEntry;
+
     //
     // Indicates whether the binding is exclusively owned already. Defaults
     // to TRUE.
@@ -210,6 +275,12 @@ typedef struct QUIC_BINDING {
     //
     BOOLEAN Connected : 1;
 
+    //
+    // Set when the binding is being cleaned up, so the network emulator stops
+    // holding its datagrams. Protected by the emulator's lock.
+    //
+    BOOLEAN NetEmuBypass;
+
     //
     // Number of (connection and listener) references to the binding.
     //
@@ -220,6 +291,15 @@ typedef struct QUIC_BINDING {
     //
     uint32_t RandomReservedVersion;
 
+    //
+    // The precomputed version list of the Version Negotiation packets sent by
+    // this binding: the random reserved version followed by the supported
+    // versions. Only allocated for server owned bindings. Protected by RwLock
+    // and rebuilt when the library's version settings change.
+    //
+    uint32_t* VerNegVersions;
+    uint16_t VerNegVersionsLength; // In bytes
+
 #ifdef QUIC_COMPARTMENT_ID
     //
     // The network compartment ID.
@@ -256,6 +336,21 @@ typedef struct QUIC_BINDING {
     CXPLAT_POOL StatelessOperCtxPool;
     uint32_t StatelessOperCount;
 
+    //
+    // Per-source rate limiting of new connection attempts. Only allocated for
+    // server owned bindings.
+    //
+    CXPLAT_DISPATCH_LOCK SourceRateLock;
+    QUIC_SOURCE_RATE_ENTRY* SourceRates;
+    uint32_t SourceRateSeed;
+
+    //
+    // Per-partition listener locks. Only allocated for server owned bindings.
+    // Looking up a listener only acquires the lock of the connection's
+    // partition; (un)registering a listener acquires all of them.
+    //
+    QUIC_BINDING_LISTENER_LOCK* ListenerLocks;
+
     struct {
 
         struct {
@@ -272,6 +367,18 @@ typedef struct QUIC_BINDING {
 CXPLAT_DATAPATH_RECEIVE_CALLBACK QuicBindingReceive;
 CXPLAT_DATAPATH_UNREACHABLE_CALLBACK QuicBindingUnreachable;
 
+//
+// Processes a chain of received datagrams, all from the same partition. Used by
+// QuicBindingReceive, and by the network emulator to deliver the datagrams it
+// held back.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicBindingReceiveDatagrams(
+    _In_ QUIC_BINDING* Binding,
+    _In_ CXPLAT_RECV_DATA* DatagramChain
+    );
+
 //
 // Initializes a new binding.
 //
@@ -331,6 +438,7 @@ QUIC_LISTENER*
 QuicBindingGetListener(
     _In_ QUIC_BINDING* Binding,
     _In_opt_ QUIC_CONNECTION* Connection,
+    _In_ uint16_t PartitionIndex,
     _Inout_ QUIC_NEW_CONNECTION_INFO* Info
     );
 
@@ -409,6 +517,24 @@ QuicBindingMoveSourceConnectionIDs(
     _In_ QUIC_CONNECTION* Connection
     );
 
+//
+// Delivers the packets received on an exclusive binding to a client connection
+// whose source CIDs are on another binding, for its standby path.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicBindingAddStandbyConnection(
+    _In_ QUIC_BINDING* Binding,
+    _In_ QUIC_CONNECTION* Connection
+    );
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicBindingRemoveStandbyConnection(
+    _In_ QUIC_BINDING* Binding,
+    _In_ QUIC_CONNECTION* Connection
+    );
+
 //
 // Indicates to the binding that the connection is no longer accepting
 // handshake/long header packets.
@@ -431,6 +557,16 @@ QuicBindingQueueStatelessOperation(
     _In_ QUIC_RX_PACKET* Packet
     );
 
+//
+// Rebuilds the binding's precomputed Version Negotiation version list from the
+// current library settings.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicBindingUpdateVersionNegotiation(
+    _In_ QUIC_BINDING* Binding
+    );
+
 //
 // Processes a stateless operation that was queued.
 //
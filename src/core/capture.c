@@ -0,0 +1,395 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Sampled packet capture, in pcapng format. See capture.h.
+
+    Each datagram is written as an Enhanced Packet Block on a single raw IP
+    interface, with IPv4 or IPv6 and UDP headers made up from the path's
+    addresses. Checksums are left as zero. TLS secrets are written as NSS key
+    log lines in Decryption Secrets Blocks, right before the first captured
+    datagram of the connection after they became available.
+
+--*/
+
+#include "precomp.h"
+#ifdef QUIC_CLOG
+#include "capture.c.clog.h"
+#endif
+
+#define PCAPNG_BLOCK_SECTION_HEADER         0x0A0D0D0A
+#define PCAPNG_BLOCK_INTERFACE_DESCRIPTION  0x00000001
+#define PCAPNG_BLOCK_ENHANCED_PACKET        0x00000006
+#define PCAPNG_BLOCK_DECRYPTION_SECRETS     0x0000000A
+#define PCAPNG_BYTE_ORDER_MAGIC             0x1A2B3C4D
+#define PCAPNG_LINKTYPE_RAW                 101
+#define PCAPNG_SECRETS_TLS_KEY_LOG          0x544C534B // "TLSK"
+#define PCAPNG_OPTION_END                   0
+#define PCAPNG_OPTION_EPB_FLAGS             2
+#define PCAPNG_EPB_FLAG_INBOUND             1
+#define PCAPNG_EPB_FLAG_OUTBOUND            2
+
+#define PCAPNG_PAD(Length) (((Length) + 3) & ~3u)
+
+//
+// Block type, total length, interface ID, timestamp (2), captured length,
+// original length, the flags option, the end of options and the trailing
+// total length.
+//
+#define QUIC_CAPTURE_EPB_OVERHEAD           (7 * sizeof(uint32_t) + 12 + sizeof(uint32_t))
+
+//
+// Block type, total length, secrets type, secrets length and the trailing
+// total length.
+//
+#define QUIC_CAPTURE_DSB_OVERHEAD           (5 * sizeof(uint32_t))
+
+#define QUIC_CAPTURE_UDP_HEADER_LENGTH      8
+#define QUIC_CAPTURE_IPV4_HEADER_LENGTH     20
+#define QUIC_CAPTURE_IPV6_HEADER_LENGTH     40
+
+typedef struct QUIC_CAPTURE_SECRET_LABEL {
+    const char* Label;
+    size_t Offset;
+} QUIC_CAPTURE_SECRET_LABEL;
+
+//
+// In the order of the QUIC_TLS_SECRETS IsSet bits, after ClientRandom.
+//
+static const QUIC_CAPTURE_SECRET_LABEL QuicCaptureSecretLabels[] = {
+    { "CLIENT_EARLY_TRAFFIC_SECRET ", FIELD_OFFSET(QUIC_TLS_SECRETS, ClientEarlyTrafficSecret) },
+    { "CLIENT_HANDSHAKE_TRAFFIC_SECRET ", FIELD_OFFSET(QUIC_TLS_SECRETS, ClientHandshakeTrafficSecret) },
+    { "SERVER_HANDSHAKE_TRAFFIC_SECRET ", FIELD_OFFSET(QUIC_TLS_SECRETS, ServerHandshakeTrafficSecret) },
+    { "CLIENT_TRAFFIC_SECRET_0 ", FIELD_OFFSET(QUIC_TLS_SECRETS, ClientTrafficSecret0) },
+    { "SERVER_TRAFFIC_SECRET_0 ", FIELD_OFFSET(QUIC_TLS_SECRETS, ServerTrafficSecret0) },
+};
+
+//
+// The longest label, the client random and a secret in hex, the spaces and
+// the new line, for each secret.
+//
+#define QUIC_CAPTURE_MAX_SECRETS_LENGTH \
+    (ARRAYSIZE(QuicCaptureSecretLabels) * (33 + 2 * 32 + 1 + 2 * QUIC_TLS_SECRETS_MAX_SECRET_LEN + 1))
+
+static
+void
+QuicCaptureAppend(
+    _Inout_ QUIC_CAPTURE_BUFFER* Buffer,
+    _In_reads_bytes_(Length) const void* Data,
+    _In_ uint32_t Length
+    )
+{
+    CxPlatCopyMemory(Buffer->Data + Buffer->Length, Data, Length);
+    Buffer->Length += Length;
+}
+
+static
+void
+QuicCaptureAppend16(
+    _Inout_ QUIC_CAPTURE_BUFFER* Buffer,
+    _In_ uint16_t Value
+    )
+{
+    QuicCaptureAppend(Buffer, &Value, sizeof(Value));
+}
+
+static
+void
+QuicCaptureAppend32(
+    _Inout_ QUIC_CAPTURE_BUFFER* Buffer,
+    _In_ uint32_t Value
+    )
+{
+    QuicCaptureAppend(Buffer, &Value, sizeof(Value));
+}
+
+static
+void
+QuicCaptureAppendPadding(
+    _Inout_ QUIC_CAPTURE_BUFFER* Buffer,
+    _In_ uint32_t Length
+    )
+{
+    while (Length & 3) {
+        Buffer->Data[Buffer->Length++] = 0;
+        ++Length;
+    }
+}
+
+static
+void
+QuicCaptureAppendHex(
+    _Inout_ QUIC_CAPTURE_BUFFER* Buffer,
+    _In_reads_bytes_(Length) const uint8_t* Data,
+    _In_ uint32_t Length
+    )
+{
+    static const char HexDigits[] = "0123456789abcdef";
+    for (uint32_t i = 0; i < Length; ++i) {
+        Buffer->Data[Buffer->Length++] = (uint8_t)HexDigits[Data[i] >> 4];
+        Buffer->Data[Buffer->Length++] = (uint8_t)HexDigits[Data[i] & 0xF];
+    }
+}
+
+//
+// Returns the IsSet bits of the secrets, in the order of
+// QuicCaptureSecretLabels.
+//
+static
+uint8_t
+QuicCaptureGetSecretsMask(
+    _In_ const QUIC_TLS_SECRETS* Secrets
+    )
+{
+    return
+        (uint8_t)(
+        (Secrets->IsSet.ClientEarlyTrafficSecret ? 0x01 : 0) |
+        (Secrets->IsSet.ClientHandshakeTrafficSecret ? 0x02 : 0) |
+        (Secrets->IsSet.ServerHandshakeTrafficSecret ? 0x04 : 0) |
+        (Secrets->IsSet.ClientTrafficSecret0 ? 0x08 : 0) |
+        (Secrets->IsSet.ServerTrafficSecret0 ? 0x10 : 0));
+}
+
+static
+void
+QuicCaptureWriteSecrets(
+    _Inout_ QUIC_CAPTURE_BUFFER* Buffer,
+    _Inout_ QUIC_CAPTURE_SECRETS* Secrets,
+    _In_ uint8_t NewMask
+    )
+{
+    const uint32_t BlockStart = Buffer->Length;
+    QuicCaptureAppend32(Buffer, PCAPNG_BLOCK_DECRYPTION_SECRETS);
+    QuicCaptureAppend32(Buffer, 0); // Total length, filled in below.
+    QuicCaptureAppend32(Buffer, PCAPNG_SECRETS_TLS_KEY_LOG);
+    QuicCaptureAppend32(Buffer, 0); // Secrets length, filled in below.
+
+    const uint32_t SecretsStart = Buffer->Length;
+    for (uint8_t i = 0; i < ARRAYSIZE(QuicCaptureSecretLabels); ++i) {
+        if (!(NewMask & (1 << i))) {
+            continue;
+        }
+        const char* Label = QuicCaptureSecretLabels[i].Label;
+        QuicCaptureAppend(Buffer, Label, (uint32_t)strlen(Label));
+        QuicCaptureAppendHex(
+            Buffer,
+            Secrets->Secrets.ClientRandom,
+            sizeof(Secrets->Secrets.ClientRandom));
+        Buffer->Data[Buffer->Length++] = ' ';
+        QuicCaptureAppendHex(
+            Buffer,
+            (const uint8_t*)&Secrets->Secrets + QuicCaptureSecretLabels[i].Offset,
+            Secrets->Secrets.SecretLength);
+        Buffer->Data[Buffer->Length++] = '\n';
+    }
+    const uint32_t SecretsLength = Buffer->Length - SecretsStart;
+    QuicCaptureAppendPadding(Buffer, SecretsLength);
+
+    const uint32_t BlockLength = Buffer->Length - BlockStart + sizeof(uint32_t);
+    QuicCaptureAppend32(Buffer, BlockLength);
+    CxPlatCopyMemory(Buffer->Data + BlockStart + 4, &BlockLength, sizeof(BlockLength));
+    CxPlatCopyMemory(Buffer->Data + BlockStart + 12, &SecretsLength, sizeof(SecretsLength));
+
+    Secrets->WrittenMask |= NewMask;
+}
+
+static
+void
+QuicCaptureAppendAddress(
+    _Inout_ QUIC_CAPTURE_BUFFER* Buffer,
+    _In_ const QUIC_ADDR* Address,
+    _In_ BOOLEAN IsIpv6
+    )
+{
+    if (QuicAddrGetFamily(Address) == QUIC_ADDRESS_FAMILY_INET6) {
+        QuicCaptureAppend(Buffer, &Address->Ipv6.sin6_addr, 16);
+    } else {
+        if (IsIpv6) {
+            //
+            // The other address is IPv6, so write this one as IPv4-mapped.
+            //
+            static const uint8_t MappedPrefix[12] = {
+                0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xFF, 0xFF
+            };
+            QuicCaptureAppend(Buffer, MappedPrefix, sizeof(MappedPrefix));
+        }
+        QuicCaptureAppend(Buffer, &Address->Ipv4.sin_addr, 4);
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicCaptureBufferUninitialize(
+    _In_ QUIC_CAPTURE_BUFFER* Buffer
+    )
+{
+    if (Buffer->Data != NULL) {
+        CXPLAT_FREE(Buffer->Data, QUIC_POOL_CAPTURE);
+        Buffer->Data = NULL;
+    }
+    Buffer->Length = 0;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicCaptureWriteDatagram(
+    _Inout_ QUIC_CAPTURE_BUFFER* Buffer,
+    _Inout_opt_ QUIC_CAPTURE_SECRETS* Secrets,
+    _In_ BOOLEAN IsSend,
+    _In_ const QUIC_ADDR* SourceAddress,
+    _In_ const QUIC_ADDR* DestinationAddress,
+    _In_reads_bytes_(Length) const uint8_t* Data,
+    _In_ uint16_t Length
+    )
+{
+    const BOOLEAN IsIpv6 =
+        QuicAddrGetFamily(SourceAddress) == QUIC_ADDRESS_FAMILY_INET6 ||
+        QuicAddrGetFamily(DestinationAddress) == QUIC_ADDRESS_FAMILY_INET6;
+    const uint32_t UdpLength = QUIC_CAPTURE_UDP_HEADER_LENGTH + (uint32_t)Length;
+    const uint32_t IpLength =
+        (IsIpv6 ? QUIC_CAPTURE_IPV6_HEADER_LENGTH : QUIC_CAPTURE_IPV4_HEADER_LENGTH) +
+        UdpLength;
+    const uint32_t RecordLength =
+        QUIC_CAPTURE_EPB_OVERHEAD + PCAPNG_PAD(IpLength) +
+        QUIC_CAPTURE_DSB_OVERHEAD + QUIC_CAPTURE_MAX_SECRETS_LENGTH;
+
+    if (RecordLength > QUIC_CAPTURE_BUFFER_SIZE || IpLength > UINT16_MAX) {
+        Buffer->DroppedCount++;
+        return;
+    }
+
+    if (Buffer->Data == NULL) {
+        Buffer->Data = CXPLAT_ALLOC_NONPAGED(QUIC_CAPTURE_BUFFER_SIZE, QUIC_POOL_CAPTURE);
+        if (Buffer->Data == NULL) {
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "capture buffer",
+                QUIC_CAPTURE_BUFFER_SIZE);
+            Buffer->DroppedCount++;
+            return;
+        }
+        Buffer->Length = 0;
+        Buffer->EpochOffsetUs =
+            MS_TO_US((uint64_t)CxPlatTimeEpochMs64()) - CxPlatTimeUs64();
+
+    } else if (Buffer->Length + RecordLength > QUIC_CAPTURE_BUFFER_SIZE) {
+        QuicCaptureFlush(Buffer);
+    }
+
+    if (Secrets != NULL && Secrets->Secrets.IsSet.ClientRandom) {
+        const uint8_t NewMask =
+            QuicCaptureGetSecretsMask(&Secrets->Secrets) & ~Secrets->WrittenMask;
+        if (NewMask != 0) {
+            QuicCaptureWriteSecrets(Buffer, Secrets, NewMask);
+        }
+    }
+
+    const uint64_t TimeUs = CxPlatTimeUs64() + Buffer->EpochOffsetUs;
+    const uint32_t BlockLength = QUIC_CAPTURE_EPB_OVERHEAD + PCAPNG_PAD(IpLength);
+    QuicCaptureAppend32(Buffer, PCAPNG_BLOCK_ENHANCED_PACKET);
+    QuicCaptureAppend32(Buffer, BlockLength);
+    QuicCaptureAppend32(Buffer, 0); // Interface ID
+    QuicCaptureAppend32(Buffer, (uint32_t)(TimeUs >> 32));
+    QuicCaptureAppend32(Buffer, (uint32_t)TimeUs);
+    QuicCaptureAppend32(Buffer, IpLength); // Captured length
+    QuicCaptureAppend32(Buffer, IpLength); // Original length
+
+    uint8_t* Header = Buffer->Data + Buffer->Length;
+    if (IsIpv6) {
+        CxPlatZeroMemory(Header, 8);
+        Header[0] = 0x60;
+        Header[4] = (uint8_t)(UdpLength >> 8);
+        Header[5] = (uint8_t)UdpLength;
+        Header[6] = 17; // UDP
+        Header[7] = 64; // Hop limit
+        Buffer->Length += 8;
+    } else {
+        CxPlatZeroMemory(Header, 12);
+        Header[0] = 0x45;
+        Header[2] = (uint8_t)(IpLength >> 8);
+        Header[3] = (uint8_t)IpLength;
+        Header[6] = 0x40; // Don't fragment
+        Header[8] = 64; // TTL
+        Header[9] = 17; // UDP
+        Buffer->Length += 12;
+    }
+    QuicCaptureAppendAddress(Buffer, SourceAddress, IsIpv6);
+    QuicCaptureAppendAddress(Buffer, DestinationAddress, IsIpv6);
+
+    const uint16_t SourcePort = QuicAddrGetPort(SourceAddress);
+    const uint16_t DestinationPort = QuicAddrGetPort(DestinationAddress);
+    Header = Buffer->Data + Buffer->Length;
+    Header[0] = (uint8_t)(SourcePort >> 8);
+    Header[1] = (uint8_t)SourcePort;
+    Header[2] = (uint8_t)(DestinationPort >> 8);
+    Header[3] = (uint8_t)DestinationPort;
+    Header[4] = (uint8_t)(UdpLength >> 8);
+    Header[5] = (uint8_t)UdpLength;
+    Header[6] = 0;
+    Header[7] = 0;
+    Buffer->Length += QUIC_CAPTURE_UDP_HEADER_LENGTH;
+
+    QuicCaptureAppend(Buffer, Data, Length);
+    QuicCaptureAppendPadding(Buffer, IpLength);
+
+    QuicCaptureAppend16(Buffer, PCAPNG_OPTION_EPB_FLAGS);
+    QuicCaptureAppend16(Buffer, sizeof(uint32_t));
+    QuicCaptureAppend32(
+        Buffer, IsSend ? PCAPNG_EPB_FLAG_OUTBOUND : PCAPNG_EPB_FLAG_INBOUND);
+    QuicCaptureAppend32(Buffer, PCAPNG_OPTION_END);
+    QuicCaptureAppend32(Buffer, BlockLength);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicCaptureFlush(
+    _Inout_ QUIC_CAPTURE_BUFFER* Buffer
+    )
+{
+    if (Buffer->Length == 0) {
+        return;
+    }
+
+    const QUIC_PACKET_CAPTURE_CONFIG Config = MsQuicLib.PacketCapture;
+    if (Config.Handler != NULL) {
+        Config.Handler(Config.Context, Buffer->Data, Buffer->Length);
+    }
+
+    Buffer->Length = 0;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicCaptureWriteHeader(
+    _In_ const QUIC_PACKET_CAPTURE_CONFIG* Config
+    )
+{
+    const struct {
+        uint32_t SectionType;
+        uint32_t SectionLength;
+        uint32_t ByteOrderMagic;
+        uint16_t MajorVersion;
+        uint16_t MinorVersion;
+        uint32_t DataLength[2];
+        uint32_t SectionTrailingLength;
+        uint32_t InterfaceType;
+        uint32_t InterfaceLength;
+        uint16_t LinkType;
+        uint16_t Reserved;
+        uint32_t SnapLength;
+        uint32_t InterfaceTrailingLength;
+    } Header = {
+        PCAPNG_BLOCK_SECTION_HEADER, 28, PCAPNG_BYTE_ORDER_MAGIC, 1, 0,
+        { UINT32_MAX, UINT32_MAX }, // Unspecified
+        28,
+        PCAPNG_BLOCK_INTERFACE_DESCRIPTION, 20, PCAPNG_LINKTYPE_RAW, 0,
+        0, // No limit
+        20
+    };
+    CXPLAT_STATIC_ASSERT(sizeof(Header) == 48, "No padding expected");
+    Config->Handler(Config->Context, (const uint8_t*)&Header, sizeof(Header));
+}
@@ -0,0 +1,125 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Sampled packet capture, in pcapng format. Like qlog, captured datagrams
+    are written into their worker's buffer, which only that worker's thread
+    ever touches, and the worker flushes the buffer to the app's
+    QUIC_PACKET_CAPTURE_CONFIG handler before going idle or once it fills up.
+
+    Datagrams are captured as they are on the wire (encrypted), behind
+    synthetic IP and UDP headers. The TLS secrets of captured connections are
+    embedded in Decryption Secrets Blocks, so the capture can be decrypted by
+    tools like Wireshark without a separate key log file.
+
+--*/
+
+#pragma once
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+typedef struct QUIC_CAPTURE_BUFFER {
+
+    //
+    // Allocated on the first captured datagram, so workers that never capture
+    // anything don't pay for it.
+    //
+    uint8_t* Data;
+    uint32_t Length;
+
+    //
+    // The number of datagrams left until the next sampled one.
+    //
+    uint32_t SampleCountdown;
+
+    //
+    // Converts CxPlatTimeUs64 to microseconds since the Unix epoch.
+    //
+    uint64_t EpochOffsetUs;
+
+    //
+    // Datagrams lost because the buffer couldn't be allocated or they were too
+    // large.
+    //
+    uint64_t DroppedCount;
+
+} QUIC_CAPTURE_BUFFER;
+
+//
+// The TLS secrets of a connection that may be captured, and which of them have
+// been written to the capture yet.
+//
+typedef struct QUIC_CAPTURE_SECRETS {
+
+    QUIC_TLS_SECRETS Secrets;
+    uint8_t WrittenMask;
+
+} QUIC_CAPTURE_SECRETS;
+
+//
+// Returns TRUE if the next datagram should be captured, when sampling 1 in
+// SampleRate datagrams.
+//
+inline
+BOOLEAN
+QuicCaptureSample(
+    _Inout_ QUIC_CAPTURE_BUFFER* Buffer,
+    _In_ uint32_t SampleRate
+    )
+{
+    if (Buffer->SampleCountdown > 1) {
+        Buffer->SampleCountdown--;
+        return FALSE;
+    }
+    Buffer->SampleCountdown = SampleRate;
+    return TRUE;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicCaptureBufferUninitialize(
+    _In_ QUIC_CAPTURE_BUFFER* Buffer
+    );
+
+//
+// Appends a datagram, preceded by any secrets that weren't written yet,
+// flushing the buffer first if it is full.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicCaptureWriteDatagram(
+    _Inout_ QUIC_CAPTURE_BUFFER* Buffer,
+    _Inout_opt_ QUIC_CAPTURE_SECRETS* Secrets,
+    _In_ BOOLEAN IsSend,
+    _In_ const QUIC_ADDR* SourceAddress,
+    _In_ const QUIC_ADDR* DestinationAddress,
+    _In_reads_bytes_(Length) const uint8_t* Data,
+    _In_ uint16_t Length
+    );
+
+//
+// Passes all buffered blocks to the app's handler, if it has one.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicCaptureFlush(
+    _Inout_ QUIC_CAPTURE_BUFFER* Buffer
+    );
+
+//
+// Passes the pcapng section and interface headers to a newly set handler.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicCaptureWriteHeader(
+    _In_ const QUIC_PACKET_CAPTURE_CONFIG* Config
+    );
+
+#if defined(__cplusplus)
+}
+#endif
@@ -10,9 +10,18 @@ Abstract:
 --*/
 
 //
-// The maximum CID server ID length used by MsQuic.
+// The maximum CID server ID length used by MsQuic. For QUIC-LB this is the
+// first octet plus the (possibly encrypted) server ID and nonce, which is
+// whatever is left of a v1 CID after the PID and payload.
 //
-#define QUIC_MAX_CID_SID_LENGTH                 5
+#define QUIC_MAX_CID_SID_LENGTH                 11
+
+//
+// The QUIC-LB config rotation bits are the top 3 bits of the first octet. All
+// ones marks a CID that load balancers can't route.
+//
+#define QUIC_LB_CONFIG_ID_SHIFT                 5
+#define QUIC_LB_CONFIG_ID_UNROUTABLE            7
 
 //
 // The index of the byte we use for partition ID lookup, in the connection ID.
@@ -172,120 +181,6 @@ typedef struct QUIC_CID_HASH_ENTRY {
 
 } QUIC_CID_HASH_ENTRY;
 
-//
-// Creates a new null/empty source connection ID, that will be used on the
-// receive path.
-//
-inline
-_Success_(return != NULL)
-QUIC_CID_HASH_ENTRY*
-QuicCidNewNullSource(
-    _In_ QUIC_CONNECTION* Connection
-    )
-{
-    QUIC_CID_HASH_ENTRY* Entry =
-        (QUIC_CID_HASH_ENTRY*)CXPLAT_ALLOC_NONPAGED(
-            sizeof(QUIC_CID_HASH_ENTRY),
-            QUIC_POOL_CIDHASH);
-
-    if (Entry != NULL) {
-        Entry->Connection = Connection;
-        CxPlatZeroMemory(&Entry->CID, sizeof(Entry->CID));
-    }
-
-    return Entry;
-}
-
-//
-// Creates a source connection ID from a pre-existing CID buffer.
-//
-inline
-_Success_(return != NULL)
-QUIC_CID_HASH_ENTRY*
-QuicCidNewSource(
-    _In_ QUIC_CONNECTION* Connection,
-    _In_ uint8_t Length,
-    _In_reads_(Length)
-        const uint8_t* const Data
-    )
-{
-    QUIC_CID_HASH_ENTRY* Entry =
-        (QUIC_CID_HASH_ENTRY*)
-        CXPLAT_ALLOC_NONPAGED(
-            sizeof(QUIC_CID_HASH_ENTRY) +
-            Length,
-            QUIC_POOL_CIDHASH);
-
-    if (Entry != NULL) {
-        Entry->Connection = Connection;
-        CxPlatZeroMemory(&Entry->CID, sizeof(Entry->CID));
-        Entry->CID.Length = Length;
-        if (Length != 0) {
-            memcpy(Entry->CID.Data, Data, Length);
-        }
-    }
-
-    return Entry;
-}
-
-//
-// Used for the client's Initial packet (and 0-RTT), this creates a random
-// destination connection ID.
-//
-inline
-_Success_(return != NULL)
-QUIC_CID_LIST_ENTRY*
-QuicCidNewRandomDestination(
-    )
-{
-    QUIC_CID_LIST_ENTRY* Entry =
-        (QUIC_CID_LIST_ENTRY*)
-        CXPLAT_ALLOC_NONPAGED(
-            sizeof(QUIC_CID_LIST_ENTRY) +
-            QUIC_MIN_INITIAL_CONNECTION_ID_LENGTH,
-            QUIC_POOL_CIDLIST);
-
-    if (Entry != NULL) {
-        QUIC_CID_CLEAR_PATH(Entry);
-        CxPlatZeroMemory(&Entry->CID, sizeof(Entry->CID));
-        Entry->CID.Length = QUIC_MIN_INITIAL_CONNECTION_ID_LENGTH;
-        CxPlatRandom(QUIC_MIN_INITIAL_CONNECTION_ID_LENGTH, Entry->CID.Data);
-    }
-
-    return Entry;
-}
-
-//
-// Creates a destination connection ID from a pre-existing CID buffer.
-//
-inline
-_Success_(return != NULL)
-QUIC_CID_LIST_ENTRY*
-QuicCidNewDestination(
-    _In_ uint8_t Length,
-    _In_reads_(Length)
-        const uint8_t* const Data
-    )
-{
-    QUIC_CID_LIST_ENTRY* Entry =
-        (QUIC_CID_LIST_ENTRY*)
-        CXPLAT_ALLOC_NONPAGED(
-            sizeof(QUIC_CID_LIST_ENTRY) +
-            Length,
-            QUIC_POOL_CIDLIST);
-
-    if (Entry != NULL) {
-        QUIC_CID_CLEAR_PATH(Entry);
-        CxPlatZeroMemory(&Entry->CID, sizeof(Entry->CID));
-        Entry->CID.Length = Length;
-        if (Length != 0) {
-            memcpy(Entry->CID.Data, Data, Length);
-        }
-    }
-
-    return Entry;
-}
-
 //
 // Helpers for logging connection IDs.
 //
@@ -84,6 +84,7 @@ MsQuicConfigurationOpen(
     Configuration->ClientContext = Context;
     Configuration->Registration = Registration;
     CxPlatRefInitialize(&Configuration->RefCount);
+    QuicTpCacheInitialize(&Configuration->TPCache);
 
     Configuration->AlpnListLength = (uint16_t)AlpnListLength;
     AlpnList = Configuration->AlpnList;
@@ -206,6 +207,7 @@ MsQuicConfigurationOpen(
 Error:
 
     if (QUIC_FAILED(Status) && Configuration != NULL) {
+        QuicTpCacheUninitialize(&Configuration->TPCache);
         CxPlatStorageClose(Configuration->AppSpecificStorage);
 #ifdef QUIC_SILO
         CxPlatStorageClose(Configuration->Storage);
@@ -239,6 +241,8 @@ QuicConfigurationUninitialize(
     CxPlatListEntryRemove(&Configuration->Link);
     CxPlatLockRelease(&Configuration->Registration->ConfigLock);
 
+    QuicTicketCachePurge(&MsQuicLib.TicketCache, Configuration);
+
     if (Configuration->SecurityConfig != NULL) {
         CxPlatTlsSecConfigDelete(Configuration->SecurityConfig);
     }
@@ -254,6 +258,7 @@ QuicConfigurationUninitialize(
 #endif
 
     QuicSettingsCleanup(&Configuration->Settings);
+    QuicTpCacheUninitialize(&Configuration->TPCache);
 
     CxPlatRundownRelease(&Configuration->Registration->Rundown);
 
@@ -68,6 +68,12 @@ typedef struct QUIC_CONFIGURATION {
     //
     QUIC_SETTINGS_INTERNAL Settings;
 
+    //
+    // The server transport parameters shared by this configuration's
+    // connections, already encoded.
+    //
+    QUIC_TP_CACHE TPCache;
+
     uint16_t AlpnListLength;
     uint8_t AlpnList[0];
 
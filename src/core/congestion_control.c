@@ -26,6 +26,14 @@ QuicCongestionControlInitialize(
 {
     CXPLAT_DBG_ASSERT(Settings->CongestionControlAlgorithm < QUIC_CONGESTION_CONTROL_ALGORITHM_MAX);
 
+    if (QuicCongestionControlGetConnection(Cc)->CustomCongestionControl != NULL) {
+        //
+        // An app provided algorithm takes precedence over the setting.
+        //
+        CustomCongestionControlInitialize(Cc, Settings);
+        return;
+    }
+
     switch (Settings->CongestionControlAlgorithm) {
     default:
         QuicTraceLogConnWarning(
@@ -40,5 +48,88 @@ QuicCongestionControlInitialize(
     case QUIC_CONGESTION_CONTROL_ALGORITHM_BBR:
         BbrCongestionControlInitialize(Cc, Settings);
         break;
+    case QUIC_CONGESTION_CONTROL_ALGORITHM_BBR3:
+        Bbr3CongestionControlInitialize(Cc, Settings);
+        break;
+    case QUIC_CONGESTION_CONTROL_ALGORITHM_PRAGUE:
+        PragueCongestionControlInitialize(Cc, Settings);
+        break;
+    case QUIC_CONGESTION_CONTROL_ALGORITHM_COPA:
+        CopaCongestionControlInitialize(Cc, Settings);
+        break;
+    }
+}
+
+//
+// Returns TRUE if New differs from Old by at least Percent percent.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+static
+BOOLEAN
+QuicNetStatChanged(
+    _In_ uint64_t Old,
+    _In_ uint64_t New,
+    _In_ uint8_t Percent
+    )
+{
+    const uint64_t Diff = New > Old ? New - Old : Old - New;
+    return Diff * 100 >= Old * Percent;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicCongestionControlIndicateNetworkStatistics(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint32_t BytesInFlight,
+    _In_ uint32_t CongestionWindow,
+    _In_ uint64_t Bandwidth
+    )
+{
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    CXPLAT_DBG_ASSERT(Connection->Settings.NetStatsEventEnabled);
+
+    const QUIC_PATH* Path = &Connection->Paths[0];
+    const uint8_t Threshold = Connection->Settings.NetStatsEventThreshold;
+    if (Threshold != 0) {
+        //
+        // Indicate at most once per RTT, and only once the RTT, congestion
+        // window or bandwidth moved by at least the threshold.
+        //
+        const uint64_t TimeNow = CxPlatTimeUs64();
+        if (Connection->LastNetStats.TimeUs != 0) {
+            if (CxPlatTimeDiff64(Connection->LastNetStats.TimeUs, TimeNow) < Path->SmoothedRtt) {
+                return;
+            }
+            if (!QuicNetStatChanged(Connection->LastNetStats.SmoothedRtt, Path->SmoothedRtt, Threshold) &&
+                !QuicNetStatChanged(Connection->LastNetStats.CongestionWindow, CongestionWindow, Threshold) &&
+                !QuicNetStatChanged(Connection->LastNetStats.Bandwidth, Bandwidth, Threshold)) {
+                return;
+            }
+        }
+        Connection->LastNetStats.TimeUs = TimeNow;
+        Connection->LastNetStats.SmoothedRtt = Path->SmoothedRtt;
+        Connection->LastNetStats.CongestionWindow = CongestionWindow;
+        Connection->LastNetStats.Bandwidth = Bandwidth;
     }
+
+    QUIC_CONNECTION_EVENT Event;
+    Event.Type = QUIC_CONNECTION_EVENT_NETWORK_STATISTICS;
+    Event.NETWORK_STATISTICS.BytesInFlight = BytesInFlight;
+    Event.NETWORK_STATISTICS.PostedBytes = Connection->SendBuffer.PostedBytes;
+    Event.NETWORK_STATISTICS.IdealBytes = Connection->SendBuffer.IdealBytes;
+    Event.NETWORK_STATISTICS.SmoothedRTT = Path->SmoothedRtt;
+    Event.NETWORK_STATISTICS.CongestionWindow = CongestionWindow;
+    Event.NETWORK_STATISTICS.Bandwidth = Bandwidth;
+
+    QuicTraceLogConnVerbose(
+        IndicateDataAcked,
+        Connection,
+        "Indicating QUIC_CONNECTION_EVENT_NETWORK_STATISTICS [BytesInFlight=%u,PostedBytes=%llu,IdealBytes=%llu,SmoothedRTT=%llu,CongestionWindow=%u,Bandwidth=%llu]",
+        Event.NETWORK_STATISTICS.BytesInFlight,
+        Event.NETWORK_STATISTICS.PostedBytes,
+        Event.NETWORK_STATISTICS.IdealBytes,
+        Event.NETWORK_STATISTICS.SmoothedRTT,
+        Event.NETWORK_STATISTICS.CongestionWindow,
+        Event.NETWORK_STATISTICS.Bandwidth);
+    QuicConnIndicateEvent(Connection, &Event);
 }
@@ -5,8 +5,23 @@
 
 --*/
 
+//
+// Path state saved from a previous connection (in a resumption ticket) that
+// may be used to speed up the start of a resumed connection.
+//
+typedef struct QUIC_CONGESTION_CONTROL_SAVED_STATE {
+
+    uint32_t Rtt; // microseconds
+
+    uint32_t CongestionWindow; // bytes
+
+} QUIC_CONGESTION_CONTROL_SAVED_STATE;
+
 #include "bbr.h"
 #include "cubic.h"
+#include "prague.h"
+#include "copa.h"
+#include "custom_cc.h"
 
 typedef struct QUIC_ACK_EVENT {
 
@@ -73,6 +88,11 @@ typedef struct QUIC_ECN_EVENT {
 
     uint64_t LargestSentPacketNumber;
 
+    //
+    // Number of packets newly reported as CE marked.
+    //
+    uint64_t NewCeCount;
+
 } QUIC_ECN_EVENT;
 
 typedef struct QUIC_CONGESTION_CONTROL {
@@ -82,6 +102,12 @@ typedef struct QUIC_CONGESTION_CONTROL {
     //
     const char* Name;
 
+    //
+    // TRUE if the algorithm is an L4S scalable congestion control, i.e. it
+    // sends with ECT(1) and reacts to the extent of CE marking.
+    //
+    BOOLEAN IsL4s;
+
     BOOLEAN (*QuicCongestionControlCanSend)(
         _In_ struct QUIC_CONGESTION_CONTROL* Cc
         );
@@ -131,6 +157,11 @@ typedef struct QUIC_CONGESTION_CONTROL {
         _In_ struct QUIC_CONGESTION_CONTROL* Cc
         );
 
+    void (*QuicCongestionControlSetSavedState)(
+        _In_ struct QUIC_CONGESTION_CONTROL* Cc,
+        _In_ const QUIC_CONGESTION_CONTROL_SAVED_STATE* SavedState
+        );
+
     void (*QuicCongestionControlLogOutFlowStatus)(
         _In_ const struct QUIC_CONGESTION_CONTROL* Cc
         );
@@ -155,12 +186,19 @@ typedef struct QUIC_CONGESTION_CONTROL {
         _In_ struct QUIC_CONGESTION_CONTROL* Cc
         );
 
+    BOOLEAN (*QuicCongestionControlIsInRecovery)(
+        _In_ const struct QUIC_CONGESTION_CONTROL* Cc
+        );
+
     //
     // Algorithm specific state.
     //
     union {
         QUIC_CONGESTION_CONTROL_CUBIC Cubic;
         QUIC_CONGESTION_CONTROL_BBR Bbr;
+        QUIC_CONGESTION_CONTROL_PRAGUE Prague;
+        QUIC_CONGESTION_CONTROL_COPA Copa;
+        QUIC_CONGESTION_CONTROL_CUSTOM Custom;
     };
 
 } QUIC_CONGESTION_CONTROL;
@@ -175,6 +213,21 @@ QuicCongestionControlInitialize(
     _In_ const QUIC_SETTINGS_INTERNAL* Settings
     );
 
+//
+// Indicates QUIC_CONNECTION_EVENT_NETWORK_STATISTICS to the app, unless
+// NetStatsEventThreshold is set and the values haven't changed enough since the
+// last indication. Called by the algorithms after processing an ACK, when
+// NetStatsEventEnabled is set.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicCongestionControlIndicateNetworkStatistics(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint32_t BytesInFlight,
+    _In_ uint32_t CongestionWindow,
+    _In_ uint64_t Bandwidth
+    );
+
 //
 // Returns TRUE if more bytes can be sent on the network.
 //
@@ -298,6 +351,23 @@ QuicCongestionControlOnEcn(
     }
 }
 
+//
+// Called with the path state saved by a previous connection, before any data
+// is sent. Algorithms without support for reusing it ignore it.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+inline
+void
+QuicCongestionControlSetSavedState(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_CONGESTION_CONTROL_SAVED_STATE* SavedState
+    )
+{
+    if (Cc->QuicCongestionControlSetSavedState) {
+        Cc->QuicCongestionControlSetSavedState(Cc, SavedState);
+    }
+}
+
 //
 // Called when all recently considered lost data was actually acknowledged.
 //
@@ -370,3 +440,17 @@ QuicCongestionControlSetAppLimited(
 {
     Cc->QuicCongestionControlSetAppLimited(Cc);
 }
+
+//
+// Returns TRUE if the algorithm is currently recovering from a congestion
+// event.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+inline
+BOOLEAN
+QuicCongestionControlIsInRecovery(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    return Cc->QuicCongestionControlIsInRecovery(Cc);
+}
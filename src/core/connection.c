@@ -15,8 +15,9 @@ Abstract:
     The connection drains operations in the QuicConnDrainOperations function.
     The only requirement here is that this function is not called in parallel
     on multiple threads. The function will drain up to QUIC_SETTINGS_INTERNAL's
-    MaxOperationsPerDrain operations per call, so as to not starve any other
-    work.
+    MaxOperationsPerDrain operations per call, times its registration's
+    scheduling weight, or until a send flush runs out of its time budget, so
+    as to not starve any other work.
 
     While most of the connection specific work is managed by other modules,
     the following things are managed in this file:
@@ -51,6 +52,12 @@ QuicConnApplyNewSettings(
     _In_ const QUIC_SETTINGS_INTERNAL* NewSettings
     );
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnProcessKeepAliveOperation(
+    _In_ QUIC_CONNECTION* Connection
+    );
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 _Must_inspect_result_
 _Success_(return == QUIC_STATUS_SUCCESS)
@@ -77,8 +84,9 @@ QuicConnAlloc(
     const uint16_t PartitionId = QuicPartitionIdCreate(PartitionIndex);
     CXPLAT_DBG_ASSERT(PartitionIndex == QuicPartitionIdGetIndex(PartitionId));
 
+    QUIC_LIBRARY_PP* PerProc = QuicLibraryGetPartitionPerProc(PartitionIndex);
     QUIC_CONNECTION* Connection =
-        CxPlatPoolAlloc(&QuicLibraryGetPerProc()->ConnectionPool);
+        QuicObjectReserveAlloc(&PerProc->ConnectionReserve, &PerProc->ConnectionPool);
     if (Connection == NULL) {
         QuicTraceEvent(
             AllocFailure,
@@ -120,8 +128,7 @@ QuicConnAlloc(
     Connection->PeerPacketTolerance = QUIC_MIN_ACK_SEND_NUMBER;
     Connection->PeerTransportParams.AckDelayExponent = QUIC_TP_ACK_DELAY_EXPONENT_DEFAULT;
     Connection->ReceiveQueueTail = &Connection->ReceiveQueue;
-    QuicSettingsCopy(&Connection->Settings, &MsQuicLib.Settings);
-    Connection->Settings.IsSetFlags = 0; // Just grab the global values, not IsSet flags.
+    QuicSettingsInherit(&Connection->Settings, &MsQuicLib.Settings);
     CxPlatDispatchLockInitialize(&Connection->ReceiveQueueLock);
     CxPlatListInitializeHead(&Connection->DestCids);
     QuicStreamSetInitialize(&Connection->Streams);
@@ -155,6 +162,7 @@ QuicConnAlloc(
     for (QUIC_CONN_TIMER_TYPE Type = 0; Type < QUIC_CONN_TIMER_COUNT; ++Type) {
         Connection->ExpirationTimes[Type] = UINT64_MAX;
     }
+    Connection->PacingExpirationTime = UINT64_MAX;
 
     if (IsServer) {
 
@@ -285,12 +293,11 @@ Error:
         }
     }
     if (Packet != NULL && Connection->SourceCids.Next != NULL) {
-        CXPLAT_FREE(
+        QuicCidFreeSource(
             CXPLAT_CONTAINING_RECORD(
                 Connection->SourceCids.Next,
                 QUIC_CID_HASH_ENTRY,
-                Link),
-            QUIC_POOL_CIDHASH);
+                Link));
         Connection->SourceCids.Next = NULL;
     }
     while (!CxPlatListIsEmpty(&Connection->DestCids)) {
@@ -299,7 +306,7 @@ Error:
                 CxPlatListRemoveHead(&Connection->DestCids),
                 QUIC_CID_LIST_ENTRY,
                 Link);
-        CXPLAT_FREE(CID, QUIC_POOL_CIDLIST);
+        QuicCidFreeDestination(CID);
     }
     QuicConnRelease(Connection, QUIC_CONN_REF_HANDLE_OWNER);
 
@@ -345,12 +352,14 @@ QuicConnFree(
                 CxPlatListRemoveHead(&Connection->DestCids),
                 QUIC_CID_LIST_ENTRY,
                 Link);
-        CXPLAT_FREE(CID, QUIC_POOL_CIDLIST);
+        QuicCidFreeDestination(CID);
     }
     QuicConnUnregister(Connection);
     if (Connection->Worker != NULL) {
         QuicTimerWheelRemoveConnection(&Connection->Worker->TimerWheel, Connection);
+        QuicPacingWheelRemoveConnection(&Connection->Worker->PacingWheel, Connection);
         QuicOperationQueueClear(Connection->Worker, &Connection->OperQ);
+        InterlockedDecrement(&Connection->Worker->ConnectionCount);
     }
     if (Connection->ReceiveQueue != NULL) {
         QUIC_RX_PACKET* Packet = Connection->ReceiveQueue;
@@ -369,6 +378,15 @@ QuicConnFree(
     QuicOperationQueueUninitialize(&Connection->OperQ);
     QuicStreamSetUninitialize(&Connection->Streams);
     QuicSendBufferUninitialize(&Connection->SendBuffer);
+    if (Connection->LatencyHistograms != NULL) {
+        CXPLAT_FREE(Connection->LatencyHistograms, QUIC_POOL_LATENCY_HISTOGRAMS);
+    }
+    if (Connection->CaptureSecrets != NULL) {
+        CXPLAT_FREE(Connection->CaptureSecrets, QUIC_POOL_CAPTURE_SECRETS);
+    }
+    if (Connection->StandbyPaths != NULL) {
+        CXPLAT_FREE(Connection->StandbyPaths, QUIC_POOL_STANDBY_PATHS);
+    }
     QuicDatagramSendShutdown(&Connection->Datagram);
     QuicDatagramUninitialize(&Connection->Datagram);
     if (Connection->Configuration != NULL) {
@@ -407,7 +425,9 @@ QuicConnFree(
         ConnDestroyed,
         "[conn][%p] Destroyed",
         Connection);
-    CxPlatPoolFree(&QuicLibraryGetPerProc()->ConnectionPool, Connection);
+    QUIC_LIBRARY_PP* PerProc =
+        QuicLibraryGetPartitionPerProc(QuicPartitionIdGetIndex(Connection->PartitionID));
+    QuicObjectReserveFree(&PerProc->ConnectionReserve, &PerProc->ConnectionPool, Connection);
 
 #if DEBUG
     InterlockedDecrement(&MsQuicLib.ConnectionCount);
@@ -553,6 +573,89 @@ QuicConnQueueTraceRundown(
     }
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicConnQueueSettingsChanged(
+    _In_ QUIC_CONNECTION* Connection
+    )
+{
+    QUIC_OPERATION* Oper;
+    if ((Oper = QuicOperationAlloc(Connection->Worker, QUIC_OPER_TYPE_SETTINGS_CHANGED)) != NULL) {
+        QuicConnQueueOper(Connection, Oper);
+    } else {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "settings changed operation",
+            0);
+    }
+}
+
+//
+// Picks up reloaded settings, on the connection's worker. Only the tunables in
+// QuicSettingsCopyLive that the app didn't set itself (on the configuration
+// or connection) follow the new values.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnProcessSettingsChanged(
+    _In_ QUIC_CONNECTION* Connection
+    )
+{
+    const QUIC_SETTINGS_INTERNAL* Source =
+        Connection->Configuration != NULL ?
+            &Connection->Configuration->Settings : &MsQuicLib.Settings;
+
+    QuicTraceLogConnInfo(
+        ApplySettings,
+        Connection,
+        "Applying new settings");
+
+    const uint16_t OldCongestionControlAlgorithm =
+        Connection->Settings.CongestionControlAlgorithm;
+    const uint32_t OldKeepAliveIntervalMs = Connection->Settings.KeepAliveIntervalMs;
+
+    QuicSettingsCopyLive(&Connection->Settings, Source);
+
+    //
+    // The max ACK delay was sent to the peer as a transport parameter, so once
+    // started it may only go down (ACKing sooner is always allowed). It also
+    // belongs to the peer once it has sent an ACK_FREQUENCY frame.
+    //
+    if (!Connection->Settings.IsSet.MaxAckDelayMs &&
+        Connection->NextRecvAckFreqSeqNum == 0 &&
+        (!Connection->State.Started ||
+         Source->MaxAckDelayMs < Connection->Settings.MaxAckDelayMs)) {
+        Connection->Settings.MaxAckDelayMs = Source->MaxAckDelayMs;
+    }
+
+    if (Connection->Settings.CongestionControlAlgorithm != OldCongestionControlAlgorithm &&
+        Connection->CustomCongestionControl == NULL) {
+        //
+        // Switch algorithms in place. The new one starts from its initial
+        // window, but has to account for the packets already in flight, or
+        // their ACKs would underflow its counters.
+        //
+        const uint32_t BytesInFlight =
+            QuicLossDetectionGetBytesInFlight(&Connection->LossDetection);
+        QuicCongestionControlInitialize(&Connection->CongestionControl, &Connection->Settings);
+        if (BytesInFlight != 0) {
+            QuicCongestionControlOnDataSent(&Connection->CongestionControl, BytesInFlight);
+        }
+    }
+
+    if (Connection->State.Started &&
+        Connection->Settings.KeepAliveIntervalMs != OldKeepAliveIntervalMs) {
+        if (Connection->Settings.KeepAliveIntervalMs != 0) {
+            QuicConnProcessKeepAliveOperation(Connection);
+        } else {
+            QuicConnTimerCancel(Connection, QUIC_CONN_TIMER_KEEP_ALIVE);
+        }
+    }
+
+    QuicSettingsDump(&Connection->Settings);
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicConnTraceRundownOper(
@@ -657,6 +760,61 @@ QuicConnTraceRundownOper(
     QuicStreamSetTraceRundown(&Connection->Streams);
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicConnGetMemoryUsage(
+    _In_ const QUIC_CONNECTION* Connection,
+    _Inout_ QUIC_MEMORY_USAGE* Usage
+    )
+{
+    Usage->ConnectionBytes += sizeof(QUIC_CONNECTION) - sizeof(Connection->Paths);
+    Usage->PathBytes += sizeof(Connection->Paths);
+    for (uint32_t i = 0; i < ARRAYSIZE(Connection->Packets); ++i) {
+        if (Connection->Packets[i] != NULL) {
+            Usage->PacketSpaceBytes += sizeof(QUIC_PACKET_SPACE);
+        }
+    }
+    Usage->StreamBytes += Connection->MemoryUsage.Streams;
+    Usage->SendBufferBytes += Connection->MemoryUsage.SendBuffer;
+    Usage->RecvBufferBytes += Connection->MemoryUsage.RecvBuffer;
+    Usage->SentPacketMetadataBytes += Connection->MemoryUsage.SentPackets;
+    if (Connection->LossDetection.SentPacketArena.Buffer != NULL) {
+        Usage->SentPacketMetadataBytes += QUIC_SENT_PACKET_ARENA_SIZE;
+    }
+    Usage->TlsBytes +=
+        Connection->MemoryUsage.CryptoRecvBuffer +
+        Connection->Crypto.TlsState.BufferAllocLength;
+}
+
+//
+// Events that only carry information to the app, and so can be posted to the
+// registration's event queue to be processed later. Events that the app must
+// respond to inline, or whose data doesn't outlive the indication, always go
+// to the callback handler.
+//
+static
+BOOLEAN
+QuicConnEventIsQueueable(
+    _In_ QUIC_CONNECTION_EVENT_TYPE Type
+    )
+{
+    switch (Type) {
+    case QUIC_CONNECTION_EVENT_CONNECTED:
+    case QUIC_CONNECTION_EVENT_SHUTDOWN_INITIATED_BY_TRANSPORT:
+    case QUIC_CONNECTION_EVENT_SHUTDOWN_INITIATED_BY_PEER:
+    case QUIC_CONNECTION_EVENT_SHUTDOWN_COMPLETE:
+    case QUIC_CONNECTION_EVENT_PEER_STREAM_STARTED:
+    case QUIC_CONNECTION_EVENT_STREAMS_AVAILABLE:
+    case QUIC_CONNECTION_EVENT_PEER_NEEDS_STREAMS:
+    case QUIC_CONNECTION_EVENT_IDEAL_PROCESSOR_CHANGED:
+    case QUIC_CONNECTION_EVENT_DATAGRAM_STATE_CHANGED:
+    case QUIC_CONNECTION_EVENT_DATAGRAM_SEND_STATE_CHANGED:
+        return TRUE;
+    default:
+        return FALSE;
+    }
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 QUIC_STATUS
 QuicConnIndicateEvent(
@@ -665,6 +823,20 @@ QuicConnIndicateEvent(
     )
 {
     QUIC_STATUS Status;
+    if (Connection->Registration != NULL &&
+        Connection->Registration->EventQueue != NULL &&
+        !Connection->State.HandleClosed &&
+        QuicConnEventIsQueueable(Event->Type)) {
+        QUIC_QUEUED_EVENT QueuedEvent;
+        QueuedEvent.Type = QUIC_QUEUED_EVENT_TYPE_CONNECTION;
+        QueuedEvent.Handle = (HQUIC)Connection;
+        QueuedEvent.Context = Connection->ClientContext;
+        QueuedEvent.CONNECTION = *Event;
+        if (QuicEventQueuePost(Connection->Registration->EventQueue, &QueuedEvent)) {
+            return QUIC_STATUS_SUCCESS;
+        }
+    }
+
     if (Connection->ClientCallbackHandler != NULL) {
         //
         // MsQuic shouldn't indicate reentrancy to the app when at all possible.
@@ -708,6 +880,7 @@ QuicConnQueueOper(
         CXPLAT_DBG_ASSERT(Connection->SourceCids.Next != NULL || CxPlatIsRandomMemoryFailureEnabled());
     }
 #endif
+    QuicUsdtProbe(oper_queue, Connection, Oper->Type);
     if (QuicOperationEnqueue(&Connection->OperQ, Oper)) {
         //
         // The connection needs to be queued on the worker because this was the
@@ -730,6 +903,7 @@ QuicConnQueuePriorityOper(
         CXPLAT_DBG_ASSERT(Connection->SourceCids.Next != NULL || CxPlatIsRandomMemoryFailureEnabled());
     }
 #endif
+    QuicUsdtProbe(oper_queue, Connection, Oper->Type);
     if (QuicOperationEnqueuePriority(&Connection->OperQ, Oper)) {
         //
         // The connection needs to be queued on the worker because this was the
@@ -746,6 +920,7 @@ QuicConnQueueHighestPriorityOper(
     _In_ QUIC_OPERATION* Oper
     )
 {
+    QuicUsdtProbe(oper_queue, Connection, Oper->Type);
     if (QuicOperationEnqueueFront(&Connection->OperQ, Oper)) {
         //
         // The connection needs to be queued on the worker because this was the
@@ -772,6 +947,11 @@ QuicConnUpdateRtt(
         LatestRtt = 1;
     }
 
+    if (Connection->LatencyHistograms != NULL) {
+        QuicLatencyHistogramRecord(&Connection->LatencyHistograms->Rtt, LatestRtt);
+    }
+    QuicPerfHistogramRecord(QUIC_PERF_HISTOGRAM_RTT, LatestRtt);
+
     BOOLEAN NewMinRtt = FALSE;
     Path->LatestRttSample = LatestRtt;
     if (LatestRtt < Path->MinRtt) {
@@ -821,6 +1001,13 @@ QuicConnUpdateRtt(
         (uint32_t)(Path->SmoothedRtt / 1000), (uint32_t)(Path->SmoothedRtt % 1000),
         (uint32_t)(Path->RttVariance / 1000), (uint32_t)(Path->RttVariance % 1000),
         (uint32_t)(Path->OneWayDelay / 1000), (uint32_t)(Path->OneWayDelay % 1000));
+    QuicConnQlog(
+        Connection,
+        QUIC_QLOG_EVENT_METRICS_UPDATED,
+        0,
+        LatestRtt,
+        Path->SmoothedRtt,
+        Path->RttVariance);
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -864,7 +1051,7 @@ QuicConnGenerateNewSourceCid(
             return NULL;
         }
         if (!QuicBindingAddSourceConnectionID(Connection->Paths[0].Binding, SourceCid)) {
-            CXPLAT_FREE(SourceCid, QUIC_POOL_CIDHASH);
+            QuicCidFreeSource(SourceCid);
             SourceCid = NULL;
             if (++TryCount > QUIC_CID_MAX_COLLISION_RETRY) {
                 QuicTraceEvent(
@@ -975,6 +1162,53 @@ QuicConnGenerateNewSourceCids(
     }
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnMoveToPartition(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ uint16_t PartitionIndex
+    )
+{
+    CXPLAT_DBG_ASSERT(Connection->Registration);
+    CXPLAT_DBG_ASSERT(!Connection->Registration->NoPartitioning);
+    CXPLAT_DBG_ASSERT(PartitionIndex != QuicPartitionIdGetIndex(Connection->PartitionID));
+    Connection->PartitionID = QuicPartitionIdCreate(PartitionIndex);
+    QuicConnGenerateNewSourceCids(Connection, TRUE);
+    Connection->State.UpdateWorker = TRUE;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+QuicConnTryRebalance(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ uint16_t PartitionIndex
+    )
+{
+    if (Connection->Registration == NULL ||
+        Connection->Registration->NoPartitioning ||
+        !Connection->State.Connected ||
+        !Connection->State.HandshakeConfirmed ||
+        QuicConnIsClosed(Connection) ||
+        Connection->State.UpdateWorker ||
+        PartitionIndex == QuicPartitionIdGetIndex(Connection->PartitionID)) {
+        return FALSE;
+    }
+
+    QuicTraceLogConnInfo(
+        ConnRebalance,
+        Connection,
+        "Rebalancing to partition %hu",
+        PartitionIndex);
+
+    //
+    // Pin the active path to the new partition, so that the next packet
+    // received on the old one doesn't move the connection straight back.
+    //
+    Connection->Paths[0].PartitionUpdated = TRUE;
+    QuicConnMoveToPartition(Connection, PartitionIndex);
+    return TRUE;
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 QUIC_CID_LIST_ENTRY*
 QuicConnGetUnusedDestCid(
@@ -1176,7 +1410,29 @@ QuicConnTimerSetEx(
     _In_ uint64_t TimeNow
     )
 {
-    const uint64_t NewExpirationTime = TimeNow + Delay;
+    uint64_t NewExpirationTime = TimeNow + Delay;
+
+    //
+    // Timers that don't need to be precise are aligned to multiples of the
+    // slack, so that those of many (mostly idle) connections expire together
+    // and are handled in one pass of the worker. Keep-alives are moved earlier,
+    // since a late one could let the peer's idle timeout expire; the others
+    // are moved later.
+    //
+    const uint64_t SlackUs = MsQuicLib.TimerSlackUs;
+    if (SlackUs != 0) {
+        if (Type == QUIC_CONN_TIMER_KEEP_ALIVE) {
+            const uint64_t Aligned = NewExpirationTime - (NewExpirationTime % SlackUs);
+            if (Aligned > TimeNow) {
+                NewExpirationTime = Aligned;
+            }
+        } else if (Type == QUIC_CONN_TIMER_IDLE ||
+                   Type == QUIC_CONN_TIMER_HIBERNATE ||
+                   (Type == QUIC_CONN_TIMER_STANDBY_PROBE && Delay != 0)) {
+            NewExpirationTime += SlackUs - 1;
+            NewExpirationTime -= NewExpirationTime % SlackUs;
+        }
+    }
 
     QuicTraceEvent(
         ConnSetTimer,
@@ -1229,6 +1485,58 @@ QuicConnTimerCancel(
     }
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnPacingTimerSet(
+    _Inout_ QUIC_CONNECTION* Connection,
+    _In_ uint64_t DelayUs
+    )
+{
+    const uint64_t TimeNow = CxPlatTimeUs64();
+
+    QuicTraceEvent(
+        ConnSetTimer,
+        "[conn][%p] Setting %hhu, delay=%llu us",
+        Connection,
+        (uint8_t)QUIC_CONN_TIMER_PACING,
+        DelayUs);
+
+    Connection->PacingExpirationTime = TimeNow + DelayUs;
+    QuicPacingWheelUpdateConnection(&Connection->Worker->PacingWheel, Connection, TimeNow);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnPacingTimerCancel(
+    _Inout_ QUIC_CONNECTION* Connection
+    )
+{
+    if (Connection->PacingExpirationTime != UINT64_MAX) {
+        Connection->PacingExpirationTime = UINT64_MAX;
+        QuicPacingWheelRemoveConnection(&Connection->Worker->PacingWheel, Connection);
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnPacingTimerExpired(
+    _Inout_ QUIC_CONNECTION* Connection
+    )
+{
+    Connection->PacingExpirationTime = UINT64_MAX;
+    QuicTraceEvent(
+        ConnExpiredTimer,
+        "[conn][%p] %hhu expired",
+        Connection,
+        (uint8_t)QUIC_CONN_TIMER_PACING);
+    QuicTraceEvent(
+        ConnExecTimerOper,
+        "[conn][%p] Execute: %u",
+        Connection,
+        QUIC_CONN_TIMER_PACING);
+    (void)QuicSendFlush(&Connection->Send);
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicConnTimerExpired(
@@ -1260,12 +1568,15 @@ QuicConnTimerExpired(
                     QUIC_CONN_TIMER_ACK_DELAY);
                 QuicSendProcessDelayedAckTimer(&Connection->Send);
                 FlushSendImmediate = TRUE;
-            } else if (Type == QUIC_CONN_TIMER_PACING) {
+            } else if (Type == QUIC_CONN_TIMER_SEND_COALESCE) {
+                //
+                // The held sends are flushed below.
+                //
                 QuicTraceEvent(
                     ConnExecTimerOper,
                     "[conn][%p] Execute: %u",
                     Connection,
-                    QUIC_CONN_TIMER_PACING);
+                    QUIC_CONN_TIMER_SEND_COALESCE);
                 FlushSendImmediate = TRUE;
             } else {
                 QUIC_OPERATION* Oper;
@@ -1332,6 +1643,87 @@ QuicConnIndicateShutdownBegin(
     (void)QuicConnIndicateEvent(Connection, &Event);
 }
 
+//
+// Seeds a new client connection's path with the metrics cached by a previous
+// connection to the same server, instead of starting from the defaults.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+void
+QuicConnSeedPathMetrics(
+    _In_ QUIC_CONNECTION* Connection
+    )
+{
+    QUIC_PATH* Path = &Connection->Paths[0];
+    QUIC_PATH_METRICS Metrics;
+    if (!QuicPathMetricsCacheLookup(
+            &MsQuicLib.PathMetricsCache, &Path->Route.RemoteAddress, &Metrics)) {
+        return;
+    }
+
+    //
+    // An initial RTT explicitly configured by the app takes precedence.
+    //
+    if (Metrics.SmoothedRtt != 0 && !Connection->Settings.IsSet.InitialRttMs) {
+        Path->SmoothedRtt = Metrics.SmoothedRtt;
+        Path->RttVariance = Path->SmoothedRtt / 2;
+    }
+
+    //
+    // A previous congestion window is only reused through Careful Resume,
+    // which validates it before relying on it.
+    //
+    if (Connection->Settings.CarefulResumeEnabled) {
+        QUIC_CONGESTION_CONTROL_SAVED_STATE SavedState;
+        SavedState.Rtt = Metrics.MinRtt;
+        SavedState.CongestionWindow = Metrics.CongestionWindow;
+        QuicCongestionControlSetSavedState(
+            &Connection->CongestionControl,
+            &SavedState);
+    }
+
+    QuicTraceLogConnInfo(
+        PathMetricsSeeded,
+        Connection,
+        "Seeded path metrics: srtt=%u us, min_rtt=%u us, cwnd=%u, mtu=%hu",
+        Metrics.SmoothedRtt,
+        Metrics.MinRtt,
+        Metrics.CongestionWindow,
+        Metrics.Mtu);
+}
+
+//
+// Caches a client connection's final path metrics for later connections to
+// the same server.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+void
+QuicConnCachePathMetrics(
+    _In_ QUIC_CONNECTION* Connection
+    )
+{
+    const QUIC_PATH* Path = &Connection->Paths[0];
+    if (!QuicConnIsClient(Connection) || !Path->GotFirstRttSample) {
+        return;
+    }
+
+    QUIC_PATH_METRICS Metrics = { 0 };
+    Metrics.SmoothedRtt = (uint32_t)CXPLAT_MIN(Path->SmoothedRtt, UINT32_MAX);
+    Metrics.MinRtt = (uint32_t)CXPLAT_MIN(Path->MinRtt, UINT32_MAX);
+    Metrics.CongestionWindow =
+        QuicCongestionControlGetCongestionWindow(&Connection->CongestionControl);
+    if (Path->MtuDiscovery.IsSearchComplete) {
+        //
+        // Otherwise the MTU may just not have been probed yet, so leave any
+        // cached MTU alone.
+        //
+        Metrics.Mtu = Path->Mtu;
+    }
+    QuicPathMetricsCacheUpdate(
+        &MsQuicLib.PathMetricsCache, &Path->Route.RemoteAddress, &Metrics);
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicConnOnShutdownComplete(
@@ -1351,9 +1743,12 @@ QuicConnOnShutdownComplete(
         Connection,
         Connection->State.ShutdownCompleteTimedOut);
 
+    QuicConnCachePathMetrics(Connection);
+
     //
     // Clean up any pending state that is irrelevant now.
     //
+    QuicConnRemoveStandbyPaths(Connection);
     QUIC_PATH* Path = &Connection->Paths[0];
     if (Path->Binding != NULL) {
         if (Path->EncryptionOffloading) {
@@ -1371,6 +1766,7 @@ QuicConnOnShutdownComplete(
     // Clean up the rest of the internal state.
     //
     QuicTimerWheelRemoveConnection(&Connection->Worker->TimerWheel, Connection);
+    QuicPacingWheelRemoveConnection(&Connection->Worker->PacingWheel, Connection);
     QuicLossDetectionUninitialize(&Connection->LossDetection);
     QuicSendUninitialize(&Connection->Send);
     QuicDatagramSendShutdown(&Connection->Datagram);
@@ -1427,6 +1823,35 @@ QuicErrorCodeToStatus(
     }
 }
 
+//
+// Logs the flight recorder's events, oldest first, so abnormal closes can be
+// diagnosed from a trace that only starts capturing warnings at that point.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+void
+QuicConnFlightRecorderLog(
+    _In_ QUIC_CONNECTION* Connection
+    )
+{
+    const QUIC_FLIGHT_RECORDER* Recorder = &Connection->FlightRecorder;
+    const uint32_t Count =
+        CXPLAT_MIN(Recorder->Count, QUIC_FLIGHT_RECORDER_EVENT_COUNT);
+    for (uint32_t i = Recorder->Count - Count; i != Recorder->Count; ++i) {
+        const QUIC_FLIGHT_RECORDER_EVENT* Event =
+            &Recorder->Events[i & (QUIC_FLIGHT_RECORDER_EVENT_COUNT - 1)];
+        QuicTraceLogConnWarning(
+            FlightRecorderEvent,
+            Connection,
+            "Flight recorder: Time=%llu Type=%u Value=%llu Detail=%u",
+            Event->TimeUs,
+            Event->Type,
+            Event->Value,
+            Event->Detail);
+        UNREFERENCED_PARAMETER(Event);
+    }
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicConnTryClose(
@@ -1583,6 +2008,10 @@ QuicConnTryClose(
             ++TimerType) {
             QuicConnTimerCancel(Connection, TimerType);
         }
+        QuicConnTimerCancel(Connection, QUIC_CONN_TIMER_HIBERNATE);
+        QuicConnTimerCancel(Connection, QUIC_CONN_TIMER_SEND_COALESCE);
+        QuicConnTimerCancel(Connection, QUIC_CONN_TIMER_ADDRESS_RACE);
+        QuicConnTimerCancel(Connection, QUIC_CONN_TIMER_STANDBY_PROBE);
 
         if (ResultQuicStatus) {
             Connection->CloseStatus = (QUIC_STATUS)ErrorCode;
@@ -1595,6 +2024,14 @@ QuicConnTryClose(
             }
         }
 
+        QuicConnFlightRecord(
+            Connection,
+            ClosedRemotely ?
+                QUIC_FLIGHT_RECORDER_EVENT_CLOSED_REMOTELY :
+                QUIC_FLIGHT_RECORDER_EVENT_CLOSED_LOCALLY,
+            ErrorCode,
+            !!(Flags & QUIC_CLOSE_APPLICATION));
+
         if (Flags & QUIC_CLOSE_APPLICATION) {
             Connection->State.AppClosed = TRUE;
         }
@@ -1646,6 +2083,9 @@ QuicConnTryClose(
                 ErrorCode,
                 ClosedRemotely,
                 !!(Flags & QUIC_CLOSE_QUIC_STATUS));
+            if (QUIC_FAILED(Connection->CloseStatus)) {
+                QuicConnFlightRecorderLog(Connection);
+            }
         }
 
         //
@@ -1727,6 +2167,47 @@ QuicConnOnQuicVersionSet(
     }
 }
 
+//
+// Resolves the server name in both address families for address racing. The
+// IPv6 address is tried first, and the IPv4 one is kept as the alternate. If
+// only one family resolves, there's nothing to race.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+QUIC_STATUS
+QuicConnResolveRaceAddresses(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_z_ const char* ServerName
+    )
+{
+    QUIC_ADDR* RemoteAddress = &Connection->Paths[0].Route.RemoteAddress;
+    QUIC_ADDR Ipv4Address = {0};
+    QuicAddrSetFamily(RemoteAddress, QUIC_ADDRESS_FAMILY_INET6);
+    QuicAddrSetFamily(&Ipv4Address, QUIC_ADDRESS_FAMILY_INET);
+
+    const QUIC_STATUS Ipv6Status =
+        CxPlatDataPathResolveAddress(MsQuicLib.Datapath, ServerName, RemoteAddress);
+    const QUIC_STATUS Ipv4Status =
+        CxPlatDataPathResolveAddress(MsQuicLib.Datapath, ServerName, &Ipv4Address);
+
+    if (QUIC_FAILED(Ipv6Status)) {
+        *RemoteAddress = Ipv4Address;
+        return Ipv4Status;
+    }
+
+    if (QUIC_SUCCEEDED(Ipv4Status)) {
+        Connection->AddressRaceAlternate = Ipv4Address;
+        QuicTraceLogConnInfo(
+            AddressRaceStarted,
+            Connection,
+            "Racing %!ADDR! against %!ADDR!",
+            CASTED_CLOG_BYTEARRAY(sizeof(*RemoteAddress), RemoteAddress),
+            CASTED_CLOG_BYTEARRAY(sizeof(Ipv4Address), &Ipv4Address));
+    }
+
+    return QUIC_STATUS_SUCCESS;
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 QUIC_STATUS
 QuicConnStart(
@@ -1792,11 +2273,17 @@ QuicConnStart(
         //
         // Resolve the server name to IP address.
         //
-        Status =
-            CxPlatDataPathResolveAddress(
-                MsQuicLib.Datapath,
-                ServerName,
-                &Path->Route.RemoteAddress);
+        if (Family == QUIC_ADDRESS_FAMILY_UNSPEC &&
+            Connection->AddressRaceDelayMs != 0 &&
+            !Connection->State.LocalAddressSet) {
+            Status = QuicConnResolveRaceAddresses(Connection, ServerName);
+        } else {
+            Status =
+                CxPlatDataPathResolveAddress(
+                    MsQuicLib.Datapath,
+                    ServerName,
+                    &Path->Route.RemoteAddress);
+        }
 
 #ifdef QUIC_COMPARTMENT_ID
         if (RevertCompartmentId) {
@@ -1923,6 +2410,13 @@ QuicConnStart(
             MS_TO_US(Connection->Settings.KeepAliveIntervalMs));
     }
 
+    if (QuicAddrGetFamily(&Connection->AddressRaceAlternate) != QUIC_ADDRESS_FAMILY_UNSPEC) {
+        QuicConnTimerSet(
+            Connection,
+            QUIC_CONN_TIMER_ADDRESS_RACE,
+            MS_TO_US(Connection->AddressRaceDelayMs));
+    }
+
 Exit:
 
     if (ServerName != NULL) {
@@ -2013,12 +2507,24 @@ QuicConnSendResumptionTicket(
     uint8_t* TicketBuffer = NULL;
     uint32_t TicketLength = 0;
     uint8_t AlpnLength = Connection->Crypto.TlsState.NegotiatedAlpn[0];
+    QUIC_CONGESTION_CONTROL_SAVED_STATE SavedState = {0};
+    const QUIC_PATH* Path = &Connection->Paths[0];
 
     if (Connection->HandshakeTP == NULL) {
         Status = QUIC_STATUS_OUT_OF_MEMORY;
         goto Error;
     }
 
+    if (Connection->Settings.CarefulResumeEnabled && Path->GotFirstRttSample) {
+        //
+        // Save the current path state so a resumed connection can use it to
+        // skip most of slow start (Careful Resume).
+        //
+        SavedState.Rtt = (uint32_t)CXPLAT_MIN(Path->MinRtt, UINT32_MAX);
+        SavedState.CongestionWindow =
+            QuicCongestionControlGetCongestionWindow(&Connection->CongestionControl);
+    }
+
     Status =
         QuicCryptoEncodeServerTicket(
             Connection,
@@ -2028,6 +2534,7 @@ QuicConnSendResumptionTicket(
             Connection->HandshakeTP,
             AlpnLength,
             Connection->Crypto.TlsState.NegotiatedAlpn + 1,
+            &SavedState,
             &TicketBuffer,
             &TicketLength);
     if (QUIC_FAILED(Status)) {
@@ -2075,6 +2582,7 @@ QuicConnRecvResumptionTicket(
 
         const uint8_t* AppData = NULL;
         uint32_t AppDataLength = 0;
+        QUIC_CONGESTION_CONTROL_SAVED_STATE SavedState;
 
         QUIC_STATUS Status =
             QuicCryptoDecodeServerTicket(
@@ -2085,7 +2593,8 @@ QuicConnRecvResumptionTicket(
                 Connection->Configuration->AlpnListLength,
                 &ResumedTP,
                 &AppData,
-                &AppDataLength);
+                &AppDataLength,
+                &SavedState);
         if (QUIC_FAILED(Status)) {
             goto Error;
         }
@@ -2112,15 +2621,33 @@ QuicConnRecvResumptionTicket(
             goto Error;
         }
 
-        QUIC_CONNECTION_EVENT Event;
-        Event.Type = QUIC_CONNECTION_EVENT_RESUMED;
-        Event.RESUMED.ResumptionStateLength = (uint16_t)AppDataLength;
-        Event.RESUMED.ResumptionState = (AppDataLength > 0) ? AppData : NULL;
-        QuicTraceLogConnVerbose(
-            IndicateResumed,
-            Connection,
-            "Indicating QUIC_CONNECTION_EVENT_RESUMED");
-        Status = QuicConnIndicateEvent(Connection, &Event);
+        if (Connection->Settings.ServerResumptionLevel == QUIC_SERVER_RESUME_AND_ZERORTT &&
+            !Connection->Crypto.AntiReplayChecked) {
+            //
+            // A ClientHello seen before could be an attacker replaying the
+            // client's 0-RTT data, so fall back to a full handshake.
+            //
+            Connection->Crypto.AntiReplayChecked = TRUE;
+            if (!QuicAntiReplayCheck(&MsQuicLib.AntiReplay, Connection->Crypto.ClientRandom)) {
+                QuicTraceEvent(
+                    ConnError,
+                    "[conn][%p] ERROR, %s.",
+                    Connection,
+                    "Resumption Ticket rejected as a possible 0-RTT replay");
+                goto Error;
+            }
+        }
+
+        QUIC_CONNECTION_EVENT Event;
+        Event.Type = QUIC_CONNECTION_EVENT_RESUMED;
+        Event.RESUMED.ResumptionStateLength = (uint16_t)AppDataLength;
+        Event.RESUMED.ResumptionState = (AppDataLength > 0) ? AppData : NULL;
+        Event.RESUMED.ClientRandom = Connection->Crypto.ClientRandom;
+        QuicTraceLogConnVerbose(
+            IndicateResumed,
+            Connection,
+            "Indicating QUIC_CONNECTION_EVENT_RESUMED");
+        Status = QuicConnIndicateEvent(Connection, &Event);
         if (Status == QUIC_STATUS_SUCCESS) {
             QuicTraceEvent(
                 ConnServerResumeTicket,
@@ -2144,6 +2671,12 @@ QuicConnRecvResumptionTicket(
             Connection->Crypto.TicketValidationPending = FALSE;
         }
 
+        if (ResumptionAccepted && Connection->Settings.CarefulResumeEnabled) {
+            QuicCongestionControlSetSavedState(
+                &Connection->CongestionControl,
+                &SavedState);
+        }
+
     } else {
 
         const uint8_t* ClientTicket = NULL;
@@ -2171,6 +2704,17 @@ QuicConnRecvResumptionTicket(
                 "Indicating QUIC_CONNECTION_EVENT_RESUMPTION_TICKET_RECEIVED");
             (void)QuicConnIndicateEvent(Connection, &Event);
 
+            if (Connection->Settings.ResumptionTicketCacheEnabled &&
+                Connection->RemoteServerName != NULL &&
+                ClientTicketLength <= UINT16_MAX) {
+                QuicTicketCacheInsert(
+                    &MsQuicLib.TicketCache,
+                    Connection->Configuration,
+                    Connection->RemoteServerName,
+                    (uint16_t)ClientTicketLength,
+                    ClientTicket);
+            }
+
             CXPLAT_FREE(ClientTicket, QUIC_POOL_CLIENT_CRYPTO_TICKET);
             ResumptionAccepted = TRUE;
         }
@@ -2198,23 +2742,7 @@ QuicConnCleanupServerResumptionState(
             Connection->HandshakeTP = NULL;
         }
 
-        QUIC_CRYPTO* Crypto = &Connection->Crypto;
-
-        QuicTraceLogConnInfo(
-            CryptoStateDiscard,
-            Connection,
-            "TLS state no longer needed");
-        if (Crypto->TLS != NULL) {
-            CxPlatTlsUninitialize(Crypto->TLS);
-            Crypto->TLS = NULL;
-        }
-        if (Crypto->Initialized) {
-            QuicRecvBufferUninitialize(&Crypto->RecvBuffer);
-            QuicRangeUninitialize(&Crypto->SparseAckRanges);
-            CXPLAT_FREE(Crypto->TlsState.Buffer, QUIC_POOL_TLS_BUFFER);
-            Crypto->TlsState.Buffer = NULL;
-            Crypto->Initialized = FALSE;
-        }
+        QuicCryptoReleaseHandshakeState(&Connection->Crypto);
     }
 }
 
@@ -2224,6 +2752,56 @@ QuicConnPostAcceptValidatePeerTransportParameters(
     _In_ QUIC_CONNECTION* Connection
     );
 
+//
+// Fills in the preferred address transport parameter, along with a new source
+// CID for the client to use with it.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+QUIC_STATUS
+QuicConnGeneratePreferredAddress(
+    _In_ QUIC_CONNECTION* Connection,
+    _Inout_ QUIC_TRANSPORT_PARAMETERS* LocalTP
+    )
+{
+    //
+    // The CID in the preferred address always has sequence number 1, so it is
+    // generated right after the initial one and never sent in a
+    // NEW_CONNECTION_ID frame.
+    //
+    CXPLAT_DBG_ASSERT(Connection->NextSourceCidSequenceNumber == 1);
+    QUIC_CID_HASH_ENTRY* SourceCid = QuicConnGenerateNewSourceCid(Connection, FALSE);
+    if (SourceCid == NULL) {
+        return QUIC_STATUS_INTERNAL_ERROR;
+    }
+    SourceCid->CID.NeedsToSend = FALSE;
+
+    QUIC_STATUS Status =
+        QuicLibraryGenerateStatelessResetToken(
+            SourceCid->CID.Data,
+            LocalTP->PreferredAddressResetToken);
+    if (QUIC_FAILED(Status)) {
+        QuicTraceEvent(
+            ConnErrorStatus,
+            "[conn][%p] ERROR, %u, %s.",
+            Connection,
+            Status,
+            "QuicLibraryGenerateStatelessResetToken");
+        return Status;
+    }
+
+    LocalTP->Flags |= QUIC_TP_FLAG_PREFERRED_ADDRESS;
+    LocalTP->PreferredAddressIpv4 = Connection->PreferredAddress.Ipv4Address;
+    LocalTP->PreferredAddressIpv6 = Connection->PreferredAddress.Ipv6Address;
+    LocalTP->PreferredAddressCidLength = SourceCid->CID.Length;
+    CxPlatCopyMemory(
+        LocalTP->PreferredAddressCid,
+        SourceCid->CID.Data,
+        SourceCid->CID.Length);
+
+    return QUIC_STATUS_SUCCESS;
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 QUIC_STATUS
 QuicConnGenerateLocalTransportParameters(
@@ -2320,6 +2898,15 @@ QuicConnGenerateLocalTransportParameters(
         LocalTP->Flags |= QUIC_TP_FLAG_RELIABLE_RESET_ENABLED;
     }
 
+    if (Connection->Datagram.FecConfig.MaxBlockSize != 0) {
+        LocalTP->Flags |= QUIC_TP_FLAG_DATAGRAM_FEC;
+    }
+
+    if (Connection->StreamCompression.CodecId != 0) {
+        LocalTP->Flags |= QUIC_TP_FLAG_STREAM_COMPRESSION;
+        LocalTP->StreamCompressionCodecId = Connection->StreamCompression.CodecId;
+    }
+
     if (Connection->Settings.OneWayDelayEnabled) {
         LocalTP->Flags |= QUIC_TP_FLAG_TIMESTAMP_RECV_ENABLED |
                           QUIC_TP_FLAG_TIMESTAMP_SEND_ENABLED;
@@ -2358,6 +2945,14 @@ QuicConnGenerateLocalTransportParameters(
             return Status;
         }
 
+        if (QuicAddrGetFamily(&Connection->PreferredAddress.Ipv4Address) != QUIC_ADDRESS_FAMILY_UNSPEC ||
+            QuicAddrGetFamily(&Connection->PreferredAddress.Ipv6Address) != QUIC_ADDRESS_FAMILY_UNSPEC) {
+            Status = QuicConnGeneratePreferredAddress(Connection, LocalTP);
+            if (QUIC_FAILED(Status)) {
+                return Status;
+            }
+        }
+
         if (Connection->OrigDestCID != NULL) {
             CXPLAT_DBG_ASSERT(Connection->OrigDestCID->Length <= QUIC_MAX_CONNECTION_ID_LENGTH_V1);
             LocalTP->Flags |= QUIC_TP_FLAG_ORIGINAL_DESTINATION_CONNECTION_ID;
@@ -2436,6 +3031,50 @@ QuicConnSetConfiguration(
 
     if (QuicConnIsClient(Connection)) {
 
+        if (Connection->Settings.ResumptionTicketCacheEnabled &&
+            Connection->Stats.QuicVersion == 0 &&
+            Connection->Crypto.ResumptionTicket == NULL &&
+            Connection->RemoteServerName != NULL) {
+            //
+            // The app didn't set a ticket itself, so use the one cached by the
+            // last connection to the same server, if any.
+            //
+            uint8_t* CachedTicket;
+            uint16_t CachedTicketLength;
+            if (QuicTicketCacheTake(
+                    &MsQuicLib.TicketCache,
+                    Configuration,
+                    Connection->RemoteServerName,
+                    &CachedTicket,
+                    &CachedTicketLength)) {
+                Status =
+                    QuicCryptoDecodeClientTicket(
+                        Connection,
+                        CachedTicketLength,
+                        CachedTicket,
+                        &Connection->PeerTransportParams,
+                        &Connection->Crypto.ResumptionTicket,
+                        &Connection->Crypto.ResumptionTicketLength,
+                        &Connection->Stats.QuicVersion);
+                QuicTicketCacheFreeTicket(CachedTicket);
+                if (QUIC_SUCCEEDED(Status)) {
+                    QuicTraceLogConnInfo(
+                        CachedResumptionTicketUsed,
+                        Connection,
+                        "Using cached resumption ticket");
+                    QuicConnOnQuicVersionSet(Connection);
+                    Status = QuicConnProcessPeerTransportParameters(Connection, TRUE);
+                    CXPLAT_DBG_ASSERT(QUIC_SUCCEEDED(Status));
+                    Status = QuicCryptoOnVersionChange(&Connection->Crypto);
+                    if (QUIC_FAILED(Status)) {
+                        goto Error;
+                    }
+                } else {
+                    Connection->Stats.QuicVersion = 0;
+                }
+            }
+        }
+
         if (Connection->Stats.QuicVersion == 0) {
             //
             // Only initialize the version if not already done (by the
@@ -2480,6 +3119,8 @@ QuicConnSetConfiguration(
             DestCid->CID.Data,
             DestCid->CID.Length);
 
+        QuicConnSeedPathMetrics(Connection);
+
     } else {
         if (!QuicConnPostAcceptValidatePeerTransportParameters(Connection)) {
             QuicConnTransportError(Connection, QUIC_ERROR_CONNECTION_REFUSED);
@@ -2683,9 +3324,12 @@ QuicConnProcessPeerVersionNegotiationTP(
         }
 
         //
-        // Attempt to upgrade the connection to a compatible version the server prefers.
+        // Attempt to upgrade the connection to the most preferred compatible
+        // version of the server. Only the first match is used, so the Initial
+        // keys are only rederived once.
         //
-        for (uint32_t ServerVersionIdx = 0; ServerVersionIdx < CurrentVersionIndex; ++ServerVersionIdx) {
+        BOOLEAN Upgraded = FALSE;
+        for (uint32_t ServerVersionIdx = 0; !Upgraded && ServerVersionIdx < CurrentVersionIndex; ++ServerVersionIdx) {
             if (QuicIsVersionReserved(SupportedVersions[ServerVersionIdx])) {
                 continue;
             }
@@ -2717,6 +3361,8 @@ QuicConnProcessPeerVersionNegotiationTP(
                         QuicConnTransportError(Connection, QUIC_ERROR_VERSION_NEGOTIATION_ERROR);
                         return QUIC_STATUS_INTERNAL_ERROR;
                     }
+                    Upgraded = TRUE;
+                    break;
                 }
             }
         }
@@ -2891,6 +3537,12 @@ QuicConnProcessPeerTransportParameters(
     }
 
     if (!FromResumptionTicket) {
+        Connection->State.StreamCompressionNegotiated =
+            Connection->StreamCompression.CodecId != 0 &&
+            (Connection->PeerTransportParams.Flags & QUIC_TP_FLAG_STREAM_COMPRESSION) &&
+            Connection->PeerTransportParams.StreamCompressionCodecId ==
+                Connection->StreamCompression.CodecId;
+
         if (Connection->Settings.VersionNegotiationExtEnabled &&
             Connection->PeerTransportParams.Flags & QUIC_TP_FLAG_VERSION_NEGOTIATION) {
             Status = QuicConnProcessPeerVersionNegotiationTP(Connection);
@@ -2930,15 +3582,44 @@ QuicConnProcessPeerTransportParameters(
         }
 
         if (Connection->PeerTransportParams.Flags & QUIC_TP_FLAG_PREFERRED_ADDRESS) {
-            /*QuicTraceLogConnInfo(
+            QuicTraceLogConnInfo(
                 PeerPreferredAddress,
                 Connection,
-                "Peer configured preferred address %!ADDR!",
-                CASTED_CLOG_BYTEARRAY(sizeof(Connection->PeerTransportParams.PreferredAddress), &Connection->PeerTransportParams.PreferredAddress));*/
+                "Peer configured preferred address %!ADDR! %!ADDR!",
+                CASTED_CLOG_BYTEARRAY(sizeof(Connection->PeerTransportParams.PreferredAddressIpv4), &Connection->PeerTransportParams.PreferredAddressIpv4),
+                CASTED_CLOG_BYTEARRAY(sizeof(Connection->PeerTransportParams.PreferredAddressIpv6), &Connection->PeerTransportParams.PreferredAddressIpv6));
 
             //
-            // TODO - Implement preferred address feature.
+            // The CID that goes with the preferred address has sequence number
+            // 1 and may be used like any other CID the server provided.
             //
+            QUIC_CID_LIST_ENTRY* DestCid =
+                QuicCidNewDestination(
+                    Connection->PeerTransportParams.PreferredAddressCidLength,
+                    Connection->PeerTransportParams.PreferredAddressCid);
+            if (DestCid == NULL) {
+                QuicTraceEvent(
+                    AllocFailure,
+                    "Allocation of '%s' failed. (%llu bytes)",
+                    "preferred address DestCid",
+                    sizeof(QUIC_CID_LIST_ENTRY) + Connection->PeerTransportParams.PreferredAddressCidLength);
+                Status = QUIC_STATUS_OUT_OF_MEMORY;
+                goto Error;
+            }
+            DestCid->CID.HasResetToken = TRUE;
+            DestCid->CID.SequenceNumber = 1;
+            CxPlatCopyMemory(
+                DestCid->ResetToken,
+                Connection->PeerTransportParams.PreferredAddressResetToken,
+                QUIC_STATELESS_RESET_TOKEN_LENGTH);
+            QuicTraceEvent(
+                ConnDestCidAdded,
+                "[conn][%p] (SeqNum=%llu) New Destination CID: %!CID!",
+                Connection,
+                DestCid->CID.SequenceNumber,
+                CASTED_CLOG_BYTEARRAY(DestCid->CID.Length, DestCid->CID.Data));
+            CxPlatListInsertTail(&Connection->DestCids, &DestCid->Link);
+            Connection->DestCidCount++;
         }
 
         if (Connection->Settings.GreaseQuicBitEnabled &&
@@ -3287,6 +3968,33 @@ QuicConnQueueRouteCompletion(
     QuicConnRelease(Connection, QUIC_CONN_REF_ROUTE);
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Function_class_(CXPLAT_TLS_PROCESS_COMPLETE_CALLBACK)
+void
+QuicConnQueueTlsCompletion(
+    _In_ QUIC_CONNECTION* Connection
+    )
+{
+    QUIC_OPERATION* ConnOper =
+        QuicOperationAlloc(Connection->Worker, QUIC_OPER_TYPE_TLS_COMPLETE);
+    if (ConnOper != NULL) {
+        QuicConnQueueOper(Connection, ConnOper);
+    } else if (InterlockedCompareExchange16((short*)&Connection->BackUpOperUsed, 1, 0) == 0) {
+        QUIC_OPERATION* Oper = &Connection->BackUpOper;
+        Oper->FreeAfterProcess = FALSE;
+        Oper->Type = QUIC_OPER_TYPE_API_CALL;
+        Oper->API_CALL.Context = &Connection->BackupApiContext;
+        Oper->API_CALL.Context->Type = QUIC_API_TYPE_CONN_SHUTDOWN;
+        Oper->API_CALL.Context->CONN_SHUTDOWN.Flags = QUIC_CONNECTION_SHUTDOWN_FLAG_SILENT;
+        Oper->API_CALL.Context->CONN_SHUTDOWN.ErrorCode = QUIC_ERROR_INTERNAL_ERROR;
+        Oper->API_CALL.Context->CONN_SHUTDOWN.RegistrationShutdown = FALSE;
+        Oper->API_CALL.Context->CONN_SHUTDOWN.TransportShutdown = TRUE;
+        QuicConnQueueHighestPriorityOper(Connection, Oper);
+    }
+
+    QuicConnRelease(Connection, QUIC_CONN_REF_TLS);
+}
+
 //
 // Updates the current destination CID to the received packet's source CID, if
 // not already equal. Only used during the handshake, on the client side.
@@ -3345,7 +4053,7 @@ QuicConnUpdateDestCid(
             // so we must allocate a new one and free the old one.
             //
             CxPlatListEntryRemove(&DestCid->Link);
-            CXPLAT_FREE(DestCid, QUIC_POOL_CIDLIST);
+            QuicCidFreeDestination(DestCid);
             DestCid =
                 QuicCidNewDestination(
                     Packet->SourceCidLen,
@@ -3686,12 +4394,9 @@ QuicConnGetKeyOrDeferDatagram(
                 // Add it to the list of pending packets that are waiting on a
                 // key to decrypt with.
                 //
-                QUIC_RX_PACKET** Tail = &Packets->DeferredPackets;
-                while (*Tail != NULL) {
-                    Tail = (QUIC_RX_PACKET**)&((*Tail)->Next);
-                }
-                *Tail = Packet;
-                (*Tail)->Next = NULL;
+                Packet->Next = NULL;
+                *Packets->DeferredPacketsTail = Packet;
+                Packets->DeferredPacketsTail = (QUIC_RX_PACKET**)&Packet->Next;
             }
         }
 
@@ -4299,6 +5004,19 @@ QuicConnRecvDecryptAndAuthenticate(
         Packet->PacketNumber,
         Packet->IsShortHeader ? QUIC_TRACE_PACKET_ONE_RTT : (Packet->LH->Type + 1),
         Packet->HeaderLength + Packet->PayloadLength);
+    QuicConnQlog(
+        Connection,
+        QUIC_QLOG_EVENT_PACKET_RECEIVED,
+        (uint8_t)(Packet->IsShortHeader ? QUIC_TRACE_PACKET_ONE_RTT : (Packet->LH->Type + 1)),
+        Packet->PacketNumber,
+        Packet->HeaderLength + Packet->PayloadLength,
+        0);
+    QuicUsdtProbe(
+        packet_recv,
+        Connection,
+        Packet->PacketNumber,
+        Packet->IsShortHeader ? QUIC_TRACE_PACKET_ONE_RTT : (Packet->LH->Type + 1),
+        Packet->HeaderLength + Packet->PayloadLength);
 
     //
     // Process any connection ID updates as necessary.
@@ -4484,10 +5202,7 @@ QuicConnRecvFrames(
         switch (FrameType) {
 
         case QUIC_FRAME_PADDING: {
-            while (Offset < PayloadLength &&
-                Payload[Offset] == QUIC_FRAME_PADDING) {
-                Offset += sizeof(uint8_t);
-            }
+            QuicPaddingFrameSkip(PayloadLength, Payload, &Offset);
             break;
         }
 
@@ -4873,6 +5588,12 @@ QuicConnRecvFrames(
                 (Frame.BidirectionalStreams ?
                  STREAM_ID_FLAG_IS_BI_DIR : STREAM_ID_FLAG_IS_UNI_DIR);
 
+            //
+            // Credit withheld under memory pressure is only given back when
+            // the peer asks for it, or when another of its streams closes.
+            //
+            QuicStreamSetGrantWithheldStreams(&Connection->Streams);
+
             const QUIC_STREAM_TYPE_INFO* Info = &Connection->Streams.Types[Type];
 
             if (Info->MaxTotalStreamCount > Frame.StreamLimit) {
@@ -5003,7 +5724,7 @@ QuicConnRecvFrames(
                     &IsLastCid);
             if (SourceCid != NULL) {
                 BOOLEAN CidAlreadyRetired = SourceCid->CID.Retired;
-                CXPLAT_FREE(SourceCid, QUIC_POOL_CIDHASH);
+                QuicCidFreeSource(SourceCid);
                 if (IsLastCid) {
                     QuicTraceEvent(
                         ConnError,
@@ -5049,7 +5770,11 @@ QuicConnRecvFrames(
 
             Path->SendResponse = TRUE;
             CxPlatCopyMemory(Path->Response, Frame.Data, sizeof(Frame.Data));
-            QuicSendSetSendFlag(&Connection->Send, QUIC_CONN_SEND_FLAG_PATH_RESPONSE);
+            QuicSendSetSendFlag(
+                &Connection->Send,
+                Path->IsStandby ? // Responded to on the path itself.
+                    QUIC_CONN_SEND_FLAG_PATH_CHALLENGE :
+                    QUIC_CONN_SEND_FLAG_PATH_RESPONSE);
 
             AckEliciting = TRUE;
             break;
@@ -5074,10 +5799,15 @@ QuicConnRecvFrames(
             CXPLAT_DBG_ASSERT(Connection->PathsCount <= QUIC_MAX_PATH_COUNT);
             for (uint8_t i = 0; i < Connection->PathsCount; ++i) {
                 QUIC_PATH* TempPath = &Connection->Paths[i];
-                if (!TempPath->IsPeerValidated &&
+                if ((!TempPath->IsPeerValidated || TempPath->IsStandby) &&
                     !memcmp(Frame.Data, TempPath->Challenge, sizeof(Frame.Data))) {
-                    QuicPerfCounterIncrement(QUIC_PERF_COUNTER_PATH_VALIDATED);
-                    QuicPathSetValid(Connection, TempPath, QUIC_PATH_VALID_PATH_RESPONSE);
+                    if (TempPath->IsStandby) {
+                        QuicConnOnStandbyPathResponse(Connection, TempPath);
+                    }
+                    if (!TempPath->IsPeerValidated) {
+                        QuicPerfCounterIncrement(QUIC_PERF_COUNTER_PATH_VALIDATED);
+                        QuicPathSetValid(Connection, TempPath, QUIC_PATH_VALID_PATH_RESPONSE);
+                    }
                     break;
                 }
             }
@@ -5365,7 +6095,7 @@ QuicConnRecvPostProcessing(
     if (!(*Path)->GotValidPacket) {
         (*Path)->GotValidPacket = TRUE;
 
-        if (!(*Path)->IsActive) {
+        if (!(*Path)->IsActive && !(*Path)->IsStandby) {
 
             //
             // This is the first valid packet received on this non-active path.
@@ -5439,7 +6169,8 @@ QuicConnRecvPostProcessing(
 
     if (Packet->HasNonProbingFrame &&
         Packet->NewLargestPacketNumber &&
-        !(*Path)->IsActive) {
+        !(*Path)->IsActive &&
+        !(*Path)->IsStandby) { // The client decides when to use those.
         //
         // The peer has sent a non-probing frame on a path other than the active
         // one. This signals their intent to switch active paths.
@@ -5492,6 +6223,7 @@ QuicConnRecvDatagramBatch(
         return;
     }
 
+    QuicStageCyclesStart(HpStart);
     if (Packet->Encrypted &&
         Connection->State.HeaderProtectionEnabled) {
         if (QUIC_FAILED(
@@ -5506,15 +6238,22 @@ QuicConnRecvDatagramBatch(
     } else {
         CxPlatZeroMemory(HpMask, BatchCount * CXPLAT_HP_SAMPLE_LENGTH);
     }
+    QuicStageCyclesEnd(QUIC_PERF_STAGE_DECRYPT, HpStart, 0);
 
     for (uint8_t i = 0; i < BatchCount; ++i) {
         CXPLAT_DBG_ASSERT(Packets[i]->Allocated);
         CXPLAT_ECN_TYPE ECN = CXPLAT_ECN_FROM_TOS(Packets[i]->TypeOfService);
         Packet = Packets[i];
         CXPLAT_DBG_ASSERT(Packet->PacketId != 0);
-        if (!QuicConnRecvPrepareDecrypt(
-                Connection, Packet, HpMask + i * CXPLAT_HP_SAMPLE_LENGTH) ||
-            !QuicConnRecvDecryptAndAuthenticate(Connection, Path, Packet)) {
+
+        QuicStageCyclesStart(DecryptStart);
+        const BOOLEAN Decrypted =
+            QuicConnRecvPrepareDecrypt(
+                Connection, Packet, HpMask + i * CXPLAT_HP_SAMPLE_LENGTH) &&
+            QuicConnRecvDecryptAndAuthenticate(Connection, Path, Packet);
+        QuicStageCyclesEnd(QUIC_PERF_STAGE_DECRYPT, DecryptStart, 1);
+
+        if (!Decrypted) {
             if (Connection->State.CompatibleVerNegotiationAttempted &&
                 !Connection->State.CompatibleVerNegotiationCompleted) {
                 //
@@ -5524,7 +6263,15 @@ QuicConnRecvDatagramBatch(
                 Connection->Stats.QuicVersion = Connection->OriginalQuicVersion;
                 Connection->State.CompatibleVerNegotiationAttempted = FALSE;
             }
-        } else if (QuicConnRecvFrames(Connection, Path, Packet, ECN)) {
+            continue;
+        }
+
+        QuicStageCyclesStart(FramesStart);
+        const BOOLEAN FramesProcessed =
+            QuicConnRecvFrames(Connection, Path, Packet, ECN);
+        QuicStageCyclesEnd(QUIC_PERF_STAGE_FRAMES, FramesStart, 1);
+
+        if (FramesProcessed) {
 
             QuicConnRecvPostProcessing(Connection, &Path, Packet);
             RecvState->ResetIdleTimeout |= Packet->CompletelyValid;
@@ -5549,6 +6296,138 @@ QuicConnRecvDatagramBatch(
     }
 }
 
+//
+// Returns a chain of processed packets to the datapath, except those still
+// held by a stream for zero-copy receive. Those are unlinked and returned
+// individually once the last hold is released.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnReturnRecvPackets(
+    _In_ QUIC_RX_PACKET* ReleaseChain
+    )
+{
+    QUIC_RX_PACKET** Tail = &ReleaseChain;
+    while (*Tail != NULL) {
+        QUIC_RX_PACKET* Packet = *Tail;
+        if (Packet->HoldCount != 0) {
+            *Tail = (QUIC_RX_PACKET*)Packet->Next;
+            Packet->Next = NULL;
+            Packet->ReturnDeferred = TRUE;
+        } else {
+            Tail = (QUIC_RX_PACKET**)&Packet->Next;
+        }
+    }
+
+    if (ReleaseChain != NULL) {
+        CxPlatRecvDataReturn((CXPLAT_RECV_DATA*)ReleaseChain);
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicConnReleaseHeldPacket(
+    _In_ QUIC_RX_PACKET* Packet
+    )
+{
+    CXPLAT_DBG_ASSERT(Packet->HoldCount != 0);
+    if (--Packet->HoldCount == 0 && Packet->ReturnDeferred) {
+        CXPLAT_DBG_ASSERT(Packet->Next == NULL);
+        CxPlatRecvDataReturn((CXPLAT_RECV_DATA*)Packet);
+    }
+}
+
+//
+// Moves the client's active path over to the server's preferred address on a
+// new binding, with a fresh destination CID.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+void
+QuicConnMigrateToPreferredAddress(
+    _In_ QUIC_CONNECTION* Connection
+    )
+{
+    CXPLAT_DBG_ASSERT(QuicConnIsClient(Connection));
+    CXPLAT_DBG_ASSERT(Connection->PeerTransportParams.Flags & QUIC_TP_FLAG_PREFERRED_ADDRESS);
+    QUIC_PATH* Path = &Connection->Paths[0];
+
+    if (!Connection->Settings.MigrationEnabled ||
+        Connection->State.ClosedLocally || Connection->State.ClosedRemotely) {
+        return;
+    }
+
+    //
+    // Only the address of the family already in use is considered, since that
+    // is the one known to be routable.
+    //
+    const QUIC_ADDR* PreferredAddress =
+        QuicAddrGetFamily(&Path->Route.RemoteAddress) == QUIC_ADDRESS_FAMILY_INET ?
+            &Connection->PeerTransportParams.PreferredAddressIpv4 :
+            &Connection->PeerTransportParams.PreferredAddressIpv6;
+    if (QuicAddrGetFamily(PreferredAddress) == QUIC_ADDRESS_FAMILY_UNSPEC ||
+        QuicAddrCompare(PreferredAddress, &Path->Route.RemoteAddress)) {
+        return;
+    }
+
+    QUIC_BINDING* OldBinding = Path->Binding;
+
+    CXPLAT_UDP_CONFIG UdpConfig = {0};
+    UdpConfig.LocalAddress = NULL;
+    UdpConfig.RemoteAddress = PreferredAddress;
+    UdpConfig.Flags = Connection->State.ShareBinding ? CXPLAT_SOCKET_FLAG_SHARE : 0;
+    UdpConfig.InterfaceIndex = 0;
+#ifdef QUIC_COMPARTMENT_ID
+    UdpConfig.CompartmentId = Connection->Configuration->CompartmentId;
+#endif
+#ifdef QUIC_OWNING_PROCESS
+    UdpConfig.OwningProcess = Connection->Configuration->OwningProcess;
+#endif
+    QUIC_STATUS Status =
+        QuicLibraryGetBinding(
+            &UdpConfig,
+            &Path->Binding);
+    if (QUIC_FAILED(Status)) {
+        Path->Binding = OldBinding;
+        QuicTraceEvent(
+            ConnErrorStatus,
+            "[conn][%p] ERROR, %u, %s.",
+            Connection,
+            Status,
+            "Get binding for preferred address");
+        return;
+    }
+
+    QuicBindingMoveSourceConnectionIDs(OldBinding, Path->Binding, Connection);
+    QuicLibraryReleaseBinding(OldBinding);
+
+    Path->Route.RemoteAddress = *PreferredAddress;
+    Path->Route.Queue = NULL;
+    Path->Route.State = RouteUnresolved;
+    QuicBindingGetLocalAddress(Path->Binding, &Path->Route.LocalAddress);
+    QuicTraceLogConnInfo(
+        PreferredAddressMigration,
+        Connection,
+        "Migrated to preferred address %!ADDR!",
+        CASTED_CLOG_BYTEARRAY(sizeof(Path->Route.RemoteAddress), &Path->Route.RemoteAddress));
+
+    //
+    // The CID from the preferred address was provided right after the initial
+    // one, so it's the first unused one picked here.
+    //
+    if (QuicConnRetireCurrentDestCid(Connection, Path)) {
+        Path->InitiatedCidUpdate = TRUE;
+    }
+
+    //
+    // Nothing learned about the old server address applies to the new one.
+    // Probe the new path immediately.
+    //
+    QuicCongestionControlReset(&Connection->CongestionControl, FALSE);
+    QuicLossDetectionOnActivePathChanged(&Connection->LossDetection);
+    QuicSendSetSendFlag(&Connection->Send, QUIC_CONN_SEND_FLAG_PING);
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicConnRecvDatagrams(
@@ -5639,6 +6518,17 @@ QuicConnRecvDatagrams(
             Connection->Stats.Recv.TotalBytes += Packet->BufferLength;
             QuicConnLogInFlowStats(Connection);
 
+            if (QuicConnPacketCaptureSample(Connection)) {
+                QuicCaptureWriteDatagram(
+                    &Connection->Worker->CaptureBuffer,
+                    Connection->CaptureSecrets,
+                    FALSE,
+                    &Packet->Route->RemoteAddress,
+                    &Packet->Route->LocalAddress,
+                    Packet->Buffer,
+                    Packet->BufferLength);
+            }
+
             if (!CurrentPath->IsPeerValidated) {
                 QuicPathIncrementAllowance(
                     Connection,
@@ -5750,7 +6640,10 @@ QuicConnRecvDatagrams(
                         &RecvState);
                     BatchCount = 0;
                 }
-                CxPlatRecvDataReturn((CXPLAT_RECV_DATA*)ReleaseChain);
+                QuicDatagramIndicateReceiveBatch(&Connection->Datagram);
+                QuicDatagramFlushRelays(&Connection->Datagram);
+                QuicStreamSetIndicateReceiveBatch(&Connection->Streams);
+                QuicConnReturnRecvPackets(ReleaseChain);
                 ReleaseChain = NULL;
                 ReleaseChainTail = &ReleaseChain;
                 ReleaseChainCount = 0;
@@ -5769,6 +6662,14 @@ QuicConnRecvDatagrams(
         BatchCount = 0; // cppcheck-suppress unreadVariable; NOLINT
     }
 
+    //
+    // Indicate any batched datagrams and stream receives before their packets
+    // are returned, and send what was relayed.
+    //
+    QuicDatagramIndicateReceiveBatch(&Connection->Datagram);
+    QuicDatagramFlushRelays(&Connection->Datagram);
+    QuicStreamSetIndicateReceiveBatch(&Connection->Streams);
+
     if (Connection->State.DelayedApplicationError && Connection->CloseStatus == 0) {
         //
         // We received transport APPLICATION_ERROR, but didn't receive the expected
@@ -5788,7 +6689,7 @@ QuicConnRecvDatagrams(
     }
 
     if (ReleaseChain != NULL) {
-        CxPlatRecvDataReturn((CXPLAT_RECV_DATA*)ReleaseChain);
+        QuicConnReturnRecvPackets(ReleaseChain);
     }
 
     if (QuicConnIsServer(Connection) &&
@@ -5822,14 +6723,14 @@ QuicConnRecvDatagrams(
         }
     }
 
+    if (Connection->State.PreferredAddressMigrationPending) {
+        Connection->State.PreferredAddressMigrationPending = FALSE;
+        QuicConnMigrateToPreferredAddress(Connection);
+    }
+
     if (!Connection->State.UpdateWorker && Connection->State.Connected &&
         !Connection->State.ShutdownComplete && RecvState.UpdatePartitionId) {
-        CXPLAT_DBG_ASSERT(Connection->Registration);
-        CXPLAT_DBG_ASSERT(!Connection->Registration->NoPartitioning);
-        CXPLAT_DBG_ASSERT(RecvState.PartitionIndex != QuicPartitionIdGetIndex(Connection->PartitionID));
-        Connection->PartitionID = QuicPartitionIdCreate(RecvState.PartitionIndex);
-        QuicConnGenerateNewSourceCids(Connection, TRUE);
-        Connection->State.UpdateWorker = TRUE;
+        QuicConnMoveToPartition(Connection, RecvState.PartitionIndex);
     }
 }
 
@@ -5904,6 +6805,9 @@ QuicConnDiscardDeferred0Rtt(
             DeferredPacketsTail = (QUIC_RX_PACKET**)&Packet->Next;
         }
     }
+    *DeferredPacketsTail = NULL;
+    *ReleaseChainTail = NULL;
+    Packets->DeferredPacketsTail = DeferredPacketsTail;
 
     if (ReleaseChain != NULL) {
         CxPlatRecvDataReturn((CXPLAT_RECV_DATA*)ReleaseChain);
@@ -5916,7 +6820,20 @@ QuicConnFlushDeferred(
     _In_ QUIC_CONNECTION* Connection
     )
 {
-    for (uint8_t i = 1; i <= (uint8_t)Connection->Crypto.TlsState.ReadKey; ++i) {
+    //
+    // Gather every deferred packet that can now be decrypted into a single
+    // chain, so they are all processed (and batched) in one receive pass.
+    // Packets still waiting on a later key are left where they are instead of
+    // being run through the receive path only to be deferred again, which
+    // could happen to 1-RTT packets sharing a packet space with 0-RTT ones.
+    //
+    QUIC_RX_PACKET* FlushChain = NULL;
+    QUIC_RX_PACKET** FlushChainTail = &FlushChain;
+    uint32_t FlushChainCount = 0;
+    uint8_t GatheredLevels = 0;
+    const QUIC_PACKET_KEY_TYPE ReadKey = Connection->Crypto.TlsState.ReadKey;
+
+    for (uint8_t i = 1; i <= (uint8_t)ReadKey; ++i) {
 
         if (Connection->Crypto.TlsState.ReadKeys[i] == NULL) {
             continue;
@@ -5926,20 +6843,41 @@ QuicConnFlushDeferred(
             QuicKeyTypeToEncryptLevel((QUIC_PACKET_KEY_TYPE)i);
         QUIC_PACKET_SPACE* Packets = Connection->Packets[EncryptLevel];
 
-        if (Packets->DeferredPackets != NULL) {
-            QUIC_RX_PACKET* DeferredPackets = Packets->DeferredPackets;
-            uint8_t DeferredPacketsCount = Packets->DeferredPacketsCount;
+        if (Packets->DeferredPackets == NULL ||
+            (GatheredLevels & (1 << EncryptLevel))) {
+            continue;
+        }
+        GatheredLevels |= (uint8_t)(1 << EncryptLevel);
+
+        QUIC_RX_PACKET* DeferredPackets = Packets->DeferredPackets;
+        Packets->DeferredPackets = NULL;
+        Packets->DeferredPacketsTail = &Packets->DeferredPackets;
 
-            Packets->DeferredPacketsCount = 0;
-            Packets->DeferredPackets = NULL;
+        while (DeferredPackets != NULL) {
+            QUIC_RX_PACKET* Packet = DeferredPackets;
+            DeferredPackets = (QUIC_RX_PACKET*)DeferredPackets->Next;
 
-            QuicConnRecvDatagrams(
-                Connection,
-                DeferredPackets,
-                DeferredPacketsCount,
-                0, // Unused for deferred datagrams
-                TRUE);
+            if (Packet->KeyType > ReadKey) {
+                *Packets->DeferredPacketsTail = Packet;
+                Packets->DeferredPacketsTail = (QUIC_RX_PACKET**)&Packet->Next;
+            } else {
+                Packets->DeferredPacketsCount--;
+                *FlushChainTail = Packet;
+                FlushChainTail = (QUIC_RX_PACKET**)&Packet->Next;
+                FlushChainCount++;
+            }
         }
+        *Packets->DeferredPacketsTail = NULL;
+    }
+
+    if (FlushChain != NULL) {
+        *FlushChainTail = NULL;
+        QuicConnRecvDatagrams(
+            Connection,
+            FlushChain,
+            FlushChainCount,
+            0, // Unused for deferred datagrams
+            TRUE);
     }
 }
 
@@ -6084,6 +7022,13 @@ QuicConnResetIdleTimeout(
             QUIC_CONN_TIMER_KEEP_ALIVE,
             MS_TO_US(Connection->Settings.KeepAliveIntervalMs));
     }
+
+    if (Connection->Settings.HibernateTimeoutMs != 0) {
+        QuicConnTimerSet(
+            Connection,
+            QUIC_CONN_TIMER_HIBERNATE,
+            MS_TO_US(Connection->Settings.HibernateTimeoutMs));
+    }
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -6125,23 +7070,60 @@ QuicConnProcessKeepAliveOperation(
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
-QuicConnUpdatePeerPacketTolerance(
-    _In_ QUIC_CONNECTION* Connection,
-    _In_ uint8_t NewPacketTolerance
+QuicConnProcessHibernateTimerOperation(
+    _In_ QUIC_CONNECTION* Connection
     )
 {
-    if (Connection->PeerTransportParams.Flags & QUIC_TP_FLAG_MIN_ACK_DELAY &&
-        Connection->PeerPacketTolerance != NewPacketTolerance) {
-        QuicTraceLogConnInfo(
-            UpdatePeerPacketTolerance,
-            Connection,
-            "Updating peer packet tolerance to %hhu",
-            NewPacketTolerance);
-        Connection->SendAckFreqSeqNum++;
-        Connection->PeerPacketTolerance = NewPacketTolerance;
-        QuicSendSetSendFlag(
-            &Connection->Send,
-            QUIC_CONN_SEND_FLAG_ACK_FREQUENCY);
+    //
+    // Nothing has been sent or received for a while, so free the memory only
+    // needed while data is flowing. Receive buffers are allocated again as
+    // soon as new data arrives.
+    //
+    uint32_t FreedCount =
+        QuicStreamSetCompactRecvBuffers(&Connection->Streams);
+
+    //
+    // The crypto stream may still receive post-handshake messages (e.g. new
+    // session tickets), but after the handshake is confirmed its buffer is
+    // normally empty.
+    //
+    if (Connection->State.HandshakeConfirmed &&
+        Connection->Crypto.Initialized &&
+        QuicRecvBufferCompact(&Connection->Crypto.RecvBuffer)) {
+        FreedCount++;
+    }
+
+    //
+    // The sent packet arena is only freed if nothing is left in flight.
+    //
+    (void)QuicSentPacketArenaTrim(&Connection->LossDetection.SentPacketArena);
+
+    QuicTraceLogConnVerbose(
+        Hibernate,
+        Connection,
+        "Hibernating, freed %u receive buffers",
+        FreedCount);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnUpdatePeerPacketTolerance(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ uint8_t NewPacketTolerance
+    )
+{
+    if (Connection->PeerTransportParams.Flags & QUIC_TP_FLAG_MIN_ACK_DELAY &&
+        Connection->PeerPacketTolerance != NewPacketTolerance) {
+        QuicTraceLogConnInfo(
+            UpdatePeerPacketTolerance,
+            Connection,
+            "Updating peer packet tolerance to %hhu",
+            NewPacketTolerance);
+        Connection->SendAckFreqSeqNum++;
+        Connection->PeerPacketTolerance = NewPacketTolerance;
+        QuicSendSetSendFlag(
+            &Connection->Send,
+            QUIC_CONN_SEND_FLAG_ACK_FREQUENCY);
     }
 }
 
@@ -6187,6 +7169,7 @@ QuicConnParamSet(
             break;
         }
 
+        QUIC_ADDR OldLocalAddress = Connection->Paths[0].Route.LocalAddress;
         Connection->State.LocalAddressSet = TRUE;
         CxPlatCopyMemory(&Connection->Paths[0].Route.LocalAddress, Buffer, sizeof(QUIC_ADDR));
         QuicTraceEvent(
@@ -6248,6 +7231,29 @@ QuicConnParamSet(
                 Connection,
                 CASTED_CLOG_BYTEARRAY(sizeof(Connection->Paths[0].Route.LocalAddress), &Connection->Paths[0].Route.LocalAddress));
 
+            //
+            // Switch to a fresh destination CID so the peer (and observers)
+            // can't link the new path to the old one.
+            //
+            if (QuicConnRetireCurrentDestCid(Connection, &Connection->Paths[0])) {
+                Connection->Paths[0].InitiatedCidUpdate = TRUE;
+            }
+
+            //
+            // A new local IP is most likely a new network, so the congestion
+            // state learned on the old one doesn't apply. Port only changes
+            // keep it.
+            //
+            if (QuicAddrGetFamily(&OldLocalAddress) != QuicAddrGetFamily(&Connection->Paths[0].Route.LocalAddress) ||
+                !QuicAddrCompareIp(&OldLocalAddress, &Connection->Paths[0].Route.LocalAddress)) {
+                QuicCongestionControlReset(&Connection->CongestionControl, FALSE);
+            }
+
+            //
+            // Don't wait for the old path's PTO to discover that outstanding
+            // data needs to go out again; probe the new path immediately.
+            //
+            QuicLossDetectionOnActivePathChanged(&Connection->LossDetection);
             QuicSendSetSendFlag(&Connection->Send, QUIC_CONN_SEND_FLAG_PING);
         }
 
@@ -6412,8 +7418,7 @@ QuicConnParamSet(
             break;
         }
 
-        Connection->State.UseRoundRobinStreamScheduling =
-            Scheme == QUIC_STREAM_SCHEDULING_SCHEME_ROUND_ROBIN;
+        QuicSendSetStreamSchedulingScheme(&Connection->Send, Scheme);
 
         QuicTraceLogConnInfo(
             UpdateStreamSchedulingScheme,
@@ -6613,153 +7618,560 @@ QuicConnParamSet(
         return QUIC_STATUS_SUCCESS;
     }
 
-    //
-    // Private
-    //
+    case QUIC_PARAM_CONN_SEND_MEMORY_REGION:
 
-    case QUIC_PARAM_CONN_FORCE_KEY_UPDATE:
+        if (BufferLength != sizeof(QUIC_BUFFER) || Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
 
-        if (!Connection->State.Connected ||
-            Connection->Packets[QUIC_ENCRYPT_LEVEL_1_RTT] == NULL ||
-            Connection->Packets[QUIC_ENCRYPT_LEVEL_1_RTT]->AwaitingKeyPhaseConfirmation ||
-            !Connection->State.HandshakeConfirmed) {
+        Status =
+            QuicSendBufferRegisterMemory(
+                &Connection->SendBuffer,
+                (const QUIC_BUFFER*)Buffer);
+        break;
+
+    case QUIC_PARAM_CONN_DATAGRAM_BATCH_RECEIVE_ENABLED:
+
+        if (BufferLength != sizeof(BOOLEAN) || Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        if (QUIC_CONN_BAD_START_STATE(Connection)) {
             Status = QUIC_STATUS_INVALID_STATE;
             break;
         }
 
-        QuicTraceLogConnVerbose(
-            ForceKeyUpdate,
-            Connection,
-            "Forcing key update");
+        Status =
+            QuicDatagramSetBatchReceiveEnabled(
+                &Connection->Datagram,
+                *(BOOLEAN*)Buffer);
+        break;
 
-        Status = QuicCryptoGenerateNewKeys(Connection);
-        if (QUIC_FAILED(Status)) {
-            QuicTraceEvent(
-                ConnErrorStatus,
-                "[conn][%p] ERROR, %u, %s.",
-                Connection,
-                Status,
-                "Forced key update");
+    case QUIC_PARAM_CONN_STREAM_BATCH_RECEIVE_ENABLED:
+
+        if (BufferLength != sizeof(BOOLEAN) || Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
             break;
         }
 
-        QuicCryptoUpdateKeyPhase(Connection, TRUE);
+        if (QUIC_CONN_BAD_START_STATE(Connection)) {
+            Status = QUIC_STATUS_INVALID_STATE;
+            break;
+        }
+
+        Status =
+            QuicStreamSetSetBatchReceiveEnabled(
+                &Connection->Streams,
+                *(BOOLEAN*)Buffer);
+        break;
+
+    case QUIC_PARAM_CONN_STREAM_GROUP:
+
+        if (BufferLength != sizeof(QUIC_STREAM_GROUP_PARAMETERS) || Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        Status =
+            QuicStreamSetConfigureGroup(
+                &Connection->Streams,
+                (const QUIC_STREAM_GROUP_PARAMETERS*)Buffer);
+        break;
+
+    case QUIC_PARAM_CONN_LATENCY_HISTOGRAMS_ENABLED:
+
+        if (BufferLength != sizeof(BOOLEAN) || Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        if (*(BOOLEAN*)Buffer && Connection->LatencyHistograms == NULL) {
+            Connection->LatencyHistograms =
+                CXPLAT_ALLOC_NONPAGED(
+                    sizeof(QUIC_CONNECTION_LATENCY_HISTOGRAMS),
+                    QUIC_POOL_LATENCY_HISTOGRAMS);
+            if (Connection->LatencyHistograms == NULL) {
+                QuicTraceEvent(
+                    AllocFailure,
+                    "Allocation of '%s' failed. (%llu bytes)",
+                    "latency histograms",
+                    sizeof(QUIC_CONNECTION_LATENCY_HISTOGRAMS));
+                Status = QUIC_STATUS_OUT_OF_MEMORY;
+                break;
+            }
+            CxPlatZeroMemory(
+                Connection->LatencyHistograms,
+                sizeof(QUIC_CONNECTION_LATENCY_HISTOGRAMS));
+
+        } else if (!*(BOOLEAN*)Buffer && Connection->LatencyHistograms != NULL) {
+            CXPLAT_FREE(Connection->LatencyHistograms, QUIC_POOL_LATENCY_HISTOGRAMS);
+            Connection->LatencyHistograms = NULL;
+        }
+
         Status = QUIC_STATUS_SUCCESS;
         break;
 
-    case QUIC_PARAM_CONN_FORCE_CID_UPDATE:
+    case QUIC_PARAM_CONN_QLOG_ENABLED:
 
-        if (!Connection->State.Connected ||
-            !Connection->State.HandshakeConfirmed) {
-            Status = QUIC_STATUS_INVALID_STATE;
+        if (BufferLength != sizeof(BOOLEAN) || Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
             break;
         }
 
-        QuicTraceLogConnVerbose(
-            ForceCidUpdate,
-            Connection,
-            "Forcing destination CID update");
+        Connection->State.QlogEnabled = !!*(BOOLEAN*)Buffer;
 
-        if (!QuicConnRetireCurrentDestCid(Connection, &Connection->Paths[0])) {
-            Status = QUIC_STATUS_INVALID_STATE;
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
+    case QUIC_PARAM_CONN_PACKET_CAPTURE_ENABLED:
+
+        if (BufferLength != sizeof(BOOLEAN) || Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
             break;
         }
 
-        Connection->Paths[0].InitiatedCidUpdate = TRUE;
+        Connection->State.PacketCaptureEnabled = !!*(BOOLEAN*)Buffer;
+
         Status = QUIC_STATUS_SUCCESS;
         break;
 
-    case QUIC_PARAM_CONN_TEST_TRANSPORT_PARAMETER:
+    case QUIC_PARAM_CONN_DATAGRAM_UDP_RELAY:
 
-        if (BufferLength != sizeof(QUIC_PRIVATE_TRANSPORT_PARAMETER)) {
+        if (BufferLength != sizeof(QUIC_DATAGRAM_UDP_RELAY) || Buffer == NULL) {
             Status = QUIC_STATUS_INVALID_PARAMETER;
             break;
         }
 
-        if (QUIC_CONN_BAD_START_STATE(Connection)) {
+        if (!Connection->Settings.DatagramReceiveEnabled) {
             Status = QUIC_STATUS_INVALID_STATE;
             break;
         }
 
-        CxPlatCopyMemory(
-            &Connection->TestTransportParameter, Buffer, BufferLength);
-        Connection->State.TestTransportParameterSet = TRUE;
+        Status =
+            QuicDatagramSetUdpRelay(
+                &Connection->Datagram,
+                (const QUIC_DATAGRAM_UDP_RELAY*)Buffer);
+        break;
+
+    case QUIC_PARAM_CONN_SEND_FLUSH_BUDGET:
+
+        if (BufferLength != sizeof(uint32_t) || Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        Connection->Send.FlushBudgetUs = *(uint32_t*)Buffer;
 
         QuicTraceLogConnVerbose(
-            TestTPSet,
+            SendFlushBudgetUpdated,
             Connection,
-            "Setting Test Transport Parameter (type %x, %hu bytes)",
-            Connection->TestTransportParameter.Type,
-            Connection->TestTransportParameter.Length);
+            "Updated send flush budget = %u us",
+            Connection->Send.FlushBudgetUs);
 
         Status = QUIC_STATUS_SUCCESS;
         break;
 
-    case QUIC_PARAM_CONN_KEEP_ALIVE_PADDING:
+    case QUIC_PARAM_CONN_SEND_COALESCING_DELAY:
 
-        if (BufferLength != sizeof(Connection->KeepAlivePadding)) {
+        if (BufferLength != sizeof(uint32_t) || Buffer == NULL ||
+            *(uint32_t*)Buffer > QUIC_MAX_SEND_COALESCING_DELAY_US) {
             Status = QUIC_STATUS_INVALID_PARAMETER;
             break;
         }
 
-        Connection->KeepAlivePadding = *(uint16_t*)Buffer;
+        QuicSendSetCoalescingDelay(&Connection->Send, *(uint32_t*)Buffer);
+
+        QuicTraceLogConnVerbose(
+            SendCoalescingDelayUpdated,
+            Connection,
+            "Updated send coalescing delay = %u us",
+            Connection->Send.CoalescingDelayUs);
+
         Status = QUIC_STATUS_SUCCESS;
         break;
 
-#if QUIC_TEST_DISABLE_VNE_TP_GENERATION
-    case QUIC_PARAM_CONN_DISABLE_VNE_TP_GENERATION:
+    case QUIC_PARAM_CONN_ADDRESS_RACE_DELAY:
 
-        if (BufferLength != sizeof(BOOLEAN) || Buffer == NULL) {
+        if (BufferLength != sizeof(uint32_t) || Buffer == NULL ||
+            *(uint32_t*)Buffer > QUIC_MAX_ADDRESS_RACE_DELAY_MS ||
+            QuicConnIsServer(Connection)) {
             Status = QUIC_STATUS_INVALID_PARAMETER;
             break;
         }
 
-        Connection->State.DisableVneTp = *(BOOLEAN*)Buffer;
+        if (QUIC_CONN_BAD_START_STATE(Connection)) {
+            Status = QUIC_STATUS_INVALID_STATE;
+            break;
+        }
+
+        Connection->AddressRaceDelayMs = *(uint32_t*)Buffer;
+
+        QuicTraceLogConnVerbose(
+            AddressRaceDelayUpdated,
+            Connection,
+            "Updated address race delay = %u ms",
+            Connection->AddressRaceDelayMs);
+
         Status = QUIC_STATUS_SUCCESS;
         break;
-#endif
 
-    default:
-        Status = QUIC_STATUS_INVALID_PARAMETER;
+    case QUIC_PARAM_CONN_DATAGRAM_FEC: {
+
+        if (BufferLength != sizeof(QUIC_DATAGRAM_FEC_CONFIG) || Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        const QUIC_DATAGRAM_FEC_CONFIG* Config = (const QUIC_DATAGRAM_FEC_CONFIG*)Buffer;
+        if ((Config->MinBlockSize != 0 || Config->MaxBlockSize != 0) &&
+            (Config->MinBlockSize < 2 ||
+             Config->MinBlockSize > Config->MaxBlockSize ||
+             Config->MaxBlockSize > QUIC_DATAGRAM_FEC_MAX_BLOCK_SIZE)) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        if (QUIC_CONN_BAD_START_STATE(Connection)) {
+            Status = QUIC_STATUS_INVALID_STATE;
+            break;
+        }
+
+        Connection->Datagram.FecConfig = *Config;
+
+        QuicTraceLogConnVerbose(
+            DatagramFecConfigUpdated,
+            Connection,
+            "Updated datagram FEC block size = %hhu to %hhu",
+            Config->MinBlockSize,
+            Config->MaxBlockSize);
+
+        Status = QUIC_STATUS_SUCCESS;
         break;
     }
 
-    return Status;
-}
+    case QUIC_PARAM_CONN_STANDBY_PATHS: {
 
-#define STATISTICS_HAS_FIELD(Size, Field) \
-    (Size >= QUIC_STRUCT_SIZE_THRU_FIELD(QUIC_STATISTICS_V2, Field))
+        if (BufferLength != sizeof(QUIC_STANDBY_PATHS) || Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
 
-_IRQL_requires_max_(PASSIVE_LEVEL)
-static
-QUIC_STATUS
-QuicConnGetV2Statistics(
-    _In_ const QUIC_CONNECTION* Connection,
-    _In_ BOOLEAN IsPlat,
-    _Inout_ uint32_t* StatsLength,
-    _Out_writes_bytes_opt_(*StatsLength)
-        QUIC_STATISTICS_V2* Stats
-    )
-{
-    const uint32_t MinimumStatsSize = QUIC_STATISTICS_V2_SIZE_1;
+        const QUIC_STANDBY_PATHS* Config = (const QUIC_STANDBY_PATHS*)Buffer;
+        if (Config->LocalAddressCount > QUIC_MAX_STANDBY_PATHS ||
+            Config->ProbeIntervalMs > QUIC_MAX_STANDBY_PROBE_INTERVAL_MS) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+        uint32_t i;
+        for (i = 0; i < Config->LocalAddressCount; ++i) {
+            if (!QuicAddrIsValid(&Config->LocalAddresses[i]) ||
+                QuicAddrIsWildCard(&Config->LocalAddresses[i])) {
+                break;
+            }
+        }
+        if (i != Config->LocalAddressCount) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
 
-    if (*StatsLength == 0) {
-        *StatsLength = sizeof(QUIC_STATISTICS_V2);
-        return QUIC_STATUS_BUFFER_TOO_SMALL;
-    }
+        if (QuicConnIsServer(Connection) || Connection->State.ClosedLocally) {
+            Status = QUIC_STATUS_INVALID_STATE;
+            break;
+        }
 
-    if (*StatsLength < MinimumStatsSize) {
-        *StatsLength = MinimumStatsSize;
-        return QUIC_STATUS_BUFFER_TOO_SMALL;
-    }
+        if (Connection->StandbyPaths == NULL) {
+            if (Config->LocalAddressCount == 0) {
+                Status = QUIC_STATUS_SUCCESS;
+                break;
+            }
+            Connection->StandbyPaths =
+                CXPLAT_ALLOC_NONPAGED(sizeof(QUIC_STANDBY_PATH_SET), QUIC_POOL_STANDBY_PATHS);
+            if (Connection->StandbyPaths == NULL) {
+                QuicTraceEvent(
+                    AllocFailure,
+                    "Allocation of '%s' failed. (%llu bytes)",
+                    "Standby paths",
+                    sizeof(QUIC_STANDBY_PATH_SET));
+                Status = QUIC_STATUS_OUT_OF_MEMORY;
+                break;
+            }
+            CxPlatZeroMemory(Connection->StandbyPaths, sizeof(QUIC_STANDBY_PATH_SET));
+        }
 
-    if (Stats == NULL) {
-        return QUIC_STATUS_INVALID_PARAMETER;
+        Connection->StandbyPaths->Config = *Config;
+
+        QuicTraceLogConnVerbose(
+            StandbyPathsUpdated,
+            Connection,
+            "Updated standby paths, count = %u, probe interval = %u ms",
+            Config->LocalAddressCount,
+            Config->ProbeIntervalMs);
+
+        //
+        // Otherwise the paths are started once the handshake is confirmed.
+        //
+        QuicConnUpdateStandbyPaths(Connection);
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
     }
 
-    const QUIC_PATH* Path = &Connection->Paths[0];
+    case QUIC_PARAM_CONN_STREAM_COMPRESSION: {
 
-    Stats->CorrelationId = Connection->Stats.CorrelationId;
+        if (BufferLength != sizeof(QUIC_STREAM_COMPRESSION_CONFIG) || Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        const QUIC_STREAM_COMPRESSION_CONFIG* Config =
+            (const QUIC_STREAM_COMPRESSION_CONFIG*)Buffer;
+        if (Config->CodecId != 0 &&
+            (Config->Compress == NULL || Config->Decompress == NULL)) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        if (QUIC_CONN_BAD_START_STATE(Connection)) {
+            Status = QUIC_STATUS_INVALID_STATE;
+            break;
+        }
+
+        Connection->StreamCompression = *Config;
+
+        QuicTraceLogConnVerbose(
+            StreamCompressionUpdated,
+            Connection,
+            "Updated stream compression codec = %u",
+            Config->CodecId);
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+    }
+
+    case QUIC_PARAM_CONN_DATAGRAM_SEND_POLICY: {
+
+        if (BufferLength != sizeof(QUIC_DATAGRAM_SEND_POLICY) || Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        //
+        // Only applies to datagrams queued from now on.
+        //
+        const QUIC_DATAGRAM_SEND_POLICY* Policy = (const QUIC_DATAGRAM_SEND_POLICY*)Buffer;
+        Connection->Datagram.SendPolicy = *Policy;
+
+        QuicTraceLogConnVerbose(
+            DatagramSendPolicyUpdated,
+            Connection,
+            "Updated datagram max queue delay = %u us (priority %u us)",
+            Policy->MaxQueueDelayUs,
+            Policy->PriorityMaxQueueDelayUs);
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+    }
+
+    case QUIC_PARAM_CONN_CUSTOM_CONGESTION_CONTROL: {
+
+        if (BufferLength != sizeof(QUIC_CUSTOM_CONGESTION_CONTROL) || Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        const QUIC_CUSTOM_CONGESTION_CONTROL* Custom =
+            (const QUIC_CUSTOM_CONGESTION_CONTROL*)Buffer;
+        if (Custom->Reset == NULL ||
+            Custom->OnDataAcknowledged == NULL ||
+            Custom->OnDataLost == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        if (QUIC_CONN_BAD_START_STATE(Connection)) {
+            Status = QUIC_STATUS_INVALID_STATE;
+            break;
+        }
+
+        Connection->CustomCongestionControl = Custom;
+        QuicCongestionControlInitialize(&Connection->CongestionControl, &Connection->Settings);
+
+        QuicTraceLogConnInfo(
+            CustomCongestionControlSet,
+            Connection,
+            "Using app congestion control %s",
+            Connection->CongestionControl.Name);
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+    }
+
+    //
+    // Private
+    //
+
+    case QUIC_PARAM_CONN_FORCE_KEY_UPDATE:
+
+        if (!Connection->State.Connected ||
+            Connection->Packets[QUIC_ENCRYPT_LEVEL_1_RTT] == NULL ||
+            Connection->Packets[QUIC_ENCRYPT_LEVEL_1_RTT]->AwaitingKeyPhaseConfirmation ||
+            !Connection->State.HandshakeConfirmed) {
+            Status = QUIC_STATUS_INVALID_STATE;
+            break;
+        }
+
+        QuicTraceLogConnVerbose(
+            ForceKeyUpdate,
+            Connection,
+            "Forcing key update");
+
+        Status = QuicCryptoGenerateNewKeys(Connection);
+        if (QUIC_FAILED(Status)) {
+            QuicTraceEvent(
+                ConnErrorStatus,
+                "[conn][%p] ERROR, %u, %s.",
+                Connection,
+                Status,
+                "Forced key update");
+            break;
+        }
+
+        QuicCryptoUpdateKeyPhase(Connection, TRUE);
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
+    case QUIC_PARAM_CONN_FORCE_CID_UPDATE:
+
+        if (!Connection->State.Connected ||
+            !Connection->State.HandshakeConfirmed) {
+            Status = QUIC_STATUS_INVALID_STATE;
+            break;
+        }
+
+        QuicTraceLogConnVerbose(
+            ForceCidUpdate,
+            Connection,
+            "Forcing destination CID update");
+
+        if (!QuicConnRetireCurrentDestCid(Connection, &Connection->Paths[0])) {
+            Status = QUIC_STATUS_INVALID_STATE;
+            break;
+        }
+
+        Connection->Paths[0].InitiatedCidUpdate = TRUE;
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
+    case QUIC_PARAM_CONN_TEST_TRANSPORT_PARAMETER:
+
+        if (BufferLength != sizeof(QUIC_PRIVATE_TRANSPORT_PARAMETER)) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        if (QUIC_CONN_BAD_START_STATE(Connection)) {
+            Status = QUIC_STATUS_INVALID_STATE;
+            break;
+        }
+
+        CxPlatCopyMemory(
+            &Connection->TestTransportParameter, Buffer, BufferLength);
+        Connection->State.TestTransportParameterSet = TRUE;
+
+        QuicTraceLogConnVerbose(
+            TestTPSet,
+            Connection,
+            "Setting Test Transport Parameter (type %x, %hu bytes)",
+            Connection->TestTransportParameter.Type,
+            Connection->TestTransportParameter.Length);
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
+    case QUIC_PARAM_CONN_KEEP_ALIVE_PADDING:
+
+        if (BufferLength != sizeof(Connection->KeepAlivePadding)) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        Connection->KeepAlivePadding = *(uint16_t*)Buffer;
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
+#if QUIC_TEST_DISABLE_VNE_TP_GENERATION
+    case QUIC_PARAM_CONN_DISABLE_VNE_TP_GENERATION:
+
+        if (BufferLength != sizeof(BOOLEAN) || Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        Connection->State.DisableVneTp = *(BOOLEAN*)Buffer;
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+#endif
+
+    default:
+        Status = QUIC_STATUS_INVALID_PARAMETER;
+        break;
+    }
+
+    return Status;
+}
+
+#define STATISTICS_HAS_FIELD(Size, Field) \
+    (Size >= QUIC_STRUCT_SIZE_THRU_FIELD(QUIC_STATISTICS_V2, Field))
+
+//
+// Returns the total time spent in a blocked state, including the time since
+// it was last entered, if it still is.
+//
+static
+uint64_t
+QuicConnGetBlockedTime(
+    _In_ const QUIC_FLOW_BLOCKED_TIMING_TRACKER* Tracker,
+    _In_ uint64_t Now
+    )
+{
+    return
+        Tracker->CumulativeTimeUs +
+        (Tracker->LastStartTimeUs != 0 ?
+            CxPlatTimeDiff64(Tracker->LastStartTimeUs, Now) : 0);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+QUIC_STATUS
+QuicConnGetV2Statistics(
+    _In_ const QUIC_CONNECTION* Connection,
+    _In_ BOOLEAN IsPlat,
+    _Inout_ uint32_t* StatsLength,
+    _Out_writes_bytes_opt_(*StatsLength)
+        QUIC_STATISTICS_V2* Stats
+    )
+{
+    const uint32_t MinimumStatsSize = QUIC_STATISTICS_V2_SIZE_1;
+
+    if (*StatsLength == 0) {
+        *StatsLength = sizeof(QUIC_STATISTICS_V2);
+        return QUIC_STATUS_BUFFER_TOO_SMALL;
+    }
+
+    if (*StatsLength < MinimumStatsSize) {
+        *StatsLength = MinimumStatsSize;
+        return QUIC_STATUS_BUFFER_TOO_SMALL;
+    }
+
+    if (Stats == NULL) {
+        return QUIC_STATUS_INVALID_PARAMETER;
+    }
+
+    const QUIC_PATH* Path = &Connection->Paths[0];
+
+    Stats->CorrelationId = Connection->Stats.CorrelationId;
     Stats->VersionNegotiation = Connection->Stats.VersionNegotiation;
     Stats->StatelessRetry = Connection->Stats.StatelessRetry;
     Stats->ResumptionAttempted = Connection->Stats.ResumptionAttempted;
@@ -6767,6 +8179,8 @@ QuicConnGetV2Statistics(
     Stats->GreaseBitNegotiated = Connection->Stats.GreaseBitNegotiated;
     Stats->EncryptionOffloaded = Connection->Stats.EncryptionOffloaded;
     Stats->EcnCapable = Path->EcnValidationState == ECN_VALIDATION_CAPABLE;
+    Stats->L4sEnabled =
+        Stats->EcnCapable && Connection->CongestionControl.IsL4s;
     Stats->Rtt = (uint32_t)Path->SmoothedRtt;
     Stats->MinRtt = (uint32_t)Path->MinRtt;
     Stats->MaxRtt = (uint32_t)Path->MaxRtt;
@@ -6821,6 +8235,32 @@ QuicConnGetV2Statistics(
     if (STATISTICS_HAS_FIELD(*StatsLength, SendEcnCongestionCount)) {
         Stats->SendEcnCongestionCount = Connection->Stats.Send.EcnCongestionCount;
     }
+    if (STATISTICS_HAS_FIELD(*StatsLength, SendL4sAlpha)) {
+        Stats->SendL4sAlpha =
+            Connection->CongestionControl.IsL4s ?
+                Connection->CongestionControl.Prague.Alpha >> (PRAGUE_ALPHA_SHIFT - 10) :
+                0;
+    }
+    if (STATISTICS_HAS_FIELD(*StatsLength, SendCeMarkedPackets)) {
+        Stats->SendCeMarkedPackets = Connection->Stats.Send.CeMarkedPackets;
+    }
+    if (STATISTICS_HAS_FIELD(*StatsLength, SendAppLimitedTimeUs)) {
+        const uint64_t Now = CxPlatTimeUs64();
+        Stats->SendSchedulingLimitedTimeUs =
+            QuicConnGetBlockedTime(&Connection->BlockedTimings.Scheduling, Now);
+        Stats->SendPacingLimitedTimeUs =
+            QuicConnGetBlockedTime(&Connection->BlockedTimings.Pacing, Now);
+        Stats->SendCongestionLimitedTimeUs =
+            QuicConnGetBlockedTime(&Connection->BlockedTimings.CongestionControl, Now);
+        Stats->SendAmplificationLimitedTimeUs =
+            QuicConnGetBlockedTime(&Connection->BlockedTimings.AmplificationProt, Now);
+        Stats->SendConnFlowControlLimitedTimeUs =
+            QuicConnGetBlockedTime(&Connection->BlockedTimings.FlowControl, Now);
+        Stats->SendStreamFlowControlLimitedTimeUs =
+            QuicConnGetBlockedTime(&Connection->BlockedTimings.StreamFlowControl, Now);
+        Stats->SendAppLimitedTimeUs =
+            QuicConnGetBlockedTime(&Connection->BlockedTimings.App, Now);
+    }
 
     *StatsLength = CXPLAT_MIN(*StatsLength, sizeof(QUIC_STATISTICS_V2));
 
@@ -6995,21 +8435,315 @@ QuicConnParamGet(
         Stats->Recv.ValidAckFrames = Connection->Stats.Recv.ValidAckFrames;
         Stats->Misc.KeyUpdateCount = Connection->Stats.Misc.KeyUpdateCount;
 
-        if (Param == QUIC_PARAM_CONN_STATISTICS_PLAT) {
-            Stats->Timing.Start = CxPlatTimeUs64ToPlat(Stats->Timing.Start); // cppcheck-suppress selfAssignment
-            Stats->Timing.InitialFlightEnd = CxPlatTimeUs64ToPlat(Stats->Timing.InitialFlightEnd); // cppcheck-suppress selfAssignment
-            Stats->Timing.HandshakeFlightEnd = CxPlatTimeUs64ToPlat(Stats->Timing.HandshakeFlightEnd); // cppcheck-suppress selfAssignment
+        if (Param == QUIC_PARAM_CONN_STATISTICS_PLAT) {
+            Stats->Timing.Start = CxPlatTimeUs64ToPlat(Stats->Timing.Start); // cppcheck-suppress selfAssignment
+            Stats->Timing.InitialFlightEnd = CxPlatTimeUs64ToPlat(Stats->Timing.InitialFlightEnd); // cppcheck-suppress selfAssignment
+            Stats->Timing.HandshakeFlightEnd = CxPlatTimeUs64ToPlat(Stats->Timing.HandshakeFlightEnd); // cppcheck-suppress selfAssignment
+        }
+
+        *BufferLength = sizeof(QUIC_STATISTICS);
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+    }
+
+    case QUIC_PARAM_CONN_SHARE_UDP_BINDING:
+
+        if (*BufferLength < sizeof(uint8_t)) {
+            *BufferLength = sizeof(uint8_t);
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        *BufferLength = sizeof(uint8_t);
+        *(uint8_t*)Buffer = Connection->State.ShareBinding;
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
+    case QUIC_PARAM_CONN_LOCAL_BIDI_STREAM_COUNT:
+        Type =
+            QuicConnIsServer(Connection) ?
+                STREAM_ID_FLAG_IS_SERVER | STREAM_ID_FLAG_IS_BI_DIR :
+                STREAM_ID_FLAG_IS_CLIENT | STREAM_ID_FLAG_IS_BI_DIR;
+        goto Get_Stream_Count;
+
+    case QUIC_PARAM_CONN_LOCAL_UNIDI_STREAM_COUNT:
+        Type =
+            QuicConnIsServer(Connection) ?
+                STREAM_ID_FLAG_IS_SERVER | STREAM_ID_FLAG_IS_UNI_DIR :
+                STREAM_ID_FLAG_IS_CLIENT | STREAM_ID_FLAG_IS_UNI_DIR;
+        goto Get_Stream_Count;
+
+    Get_Stream_Count:
+        if (*BufferLength < sizeof(uint16_t)) {
+            *BufferLength = sizeof(uint16_t);
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        *BufferLength = sizeof(uint16_t);
+        *(uint16_t*)Buffer =
+            QuicStreamSetGetCountAvailable(&Connection->Streams, Type);
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
+    case QUIC_PARAM_CONN_MAX_STREAM_IDS:
+
+        if (*BufferLength < sizeof(uint64_t) * NUMBER_OF_STREAM_TYPES) {
+            *BufferLength = sizeof(uint64_t) * NUMBER_OF_STREAM_TYPES;
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        *BufferLength = sizeof(uint64_t) * NUMBER_OF_STREAM_TYPES;
+        QuicStreamSetGetMaxStreamIDs(&Connection->Streams, (uint64_t*)Buffer);
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
+    case QUIC_PARAM_CONN_CLOSE_REASON_PHRASE:
+
+        if (Connection->CloseReasonPhrase == NULL) {
+            Status = QUIC_STATUS_NOT_FOUND;
+            break;
+        }
+
+        Length = (uint32_t)strlen(Connection->CloseReasonPhrase) + 1;
+        if (*BufferLength < Length) {
+            *BufferLength = Length;
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        *BufferLength = Length;
+        CxPlatCopyMemory(Buffer, Connection->CloseReasonPhrase, Length);
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
+    case QUIC_PARAM_CONN_STREAM_SCHEDULING_SCHEME:
+
+        if (*BufferLength < sizeof(QUIC_STREAM_SCHEDULING_SCHEME)) {
+            *BufferLength = sizeof(QUIC_STREAM_SCHEDULING_SCHEME);
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        *BufferLength = sizeof(QUIC_STREAM_SCHEDULING_SCHEME);
+        *(QUIC_STREAM_SCHEDULING_SCHEME*)Buffer =
+            (QUIC_STREAM_SCHEDULING_SCHEME)Connection->Send.StreamSchedulingScheme;
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
+    case QUIC_PARAM_CONN_DATAGRAM_RECEIVE_ENABLED:
+
+        if (*BufferLength < sizeof(BOOLEAN)) {
+            *BufferLength = sizeof(BOOLEAN);
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        *BufferLength = sizeof(BOOLEAN);
+        *(BOOLEAN*)Buffer = Connection->Settings.DatagramReceiveEnabled;
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
+    case QUIC_PARAM_CONN_DATAGRAM_SEND_ENABLED:
+
+        if (*BufferLength < sizeof(BOOLEAN)) {
+            *BufferLength = sizeof(BOOLEAN);
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        *BufferLength = sizeof(BOOLEAN);
+        *(BOOLEAN*)Buffer = Connection->Datagram.SendEnabled;
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
+    case QUIC_PARAM_CONN_DISABLE_1RTT_ENCRYPTION:
+
+        if (*BufferLength < sizeof(BOOLEAN)) {
+            *BufferLength = sizeof(BOOLEAN);
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        *BufferLength = sizeof(BOOLEAN);
+        *(BOOLEAN*)Buffer = Connection->State.Disable1RttEncrytion;
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
+    case QUIC_PARAM_CONN_STATISTICS_V2:
+    case QUIC_PARAM_CONN_STATISTICS_V2_PLAT: {
+
+        Status =
+            QuicConnGetV2Statistics(
+                Connection,
+                Param == QUIC_PARAM_CONN_STATISTICS_V2_PLAT,
+                BufferLength,
+                (QUIC_STATISTICS_V2*)Buffer);
+        break;
+    }
+
+    case QUIC_PARAM_CONN_ORIG_DEST_CID:
+        if (Connection->OrigDestCID == NULL) {
+            Status = QUIC_STATUS_INVALID_STATE;
+            break;
+        }
+        if (*BufferLength < Connection->OrigDestCID->Length) {
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            *BufferLength = Connection->OrigDestCID->Length;
+            break;
+        }
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+        CxPlatCopyMemory(
+            Buffer,
+            Connection->OrigDestCID->Data,
+            Connection->OrigDestCID->Length);
+        //
+        // Tell app how much buffer we copied.
+        //
+        *BufferLength = Connection->OrigDestCID->Length;
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
+    case QUIC_PARAM_CONN_DATAGRAM_BATCH_RECEIVE_ENABLED:
+
+        if (*BufferLength < sizeof(BOOLEAN)) {
+            *BufferLength = sizeof(BOOLEAN);
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        *BufferLength = sizeof(BOOLEAN);
+        *(BOOLEAN*)Buffer = Connection->Datagram.RecvBatch != NULL;
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
+    case QUIC_PARAM_CONN_STREAM_BATCH_RECEIVE_ENABLED:
+
+        if (*BufferLength < sizeof(BOOLEAN)) {
+            *BufferLength = sizeof(BOOLEAN);
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        *BufferLength = sizeof(BOOLEAN);
+        *(BOOLEAN*)Buffer = Connection->Streams.RecvBatch != NULL;
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
+    case QUIC_PARAM_CONN_LATENCY_HISTOGRAMS_ENABLED:
+
+        if (*BufferLength < sizeof(BOOLEAN)) {
+            *BufferLength = sizeof(BOOLEAN);
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        *BufferLength = sizeof(BOOLEAN);
+        *(BOOLEAN*)Buffer = Connection->LatencyHistograms != NULL;
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
+    case QUIC_PARAM_CONN_LATENCY_HISTOGRAMS:
+
+        if (Connection->LatencyHistograms == NULL) {
+            Status = QUIC_STATUS_INVALID_STATE;
+            break;
+        }
+
+        if (*BufferLength < sizeof(QUIC_CONNECTION_LATENCY_HISTOGRAMS)) {
+            *BufferLength = sizeof(QUIC_CONNECTION_LATENCY_HISTOGRAMS);
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
         }
 
-        *BufferLength = sizeof(QUIC_STATISTICS);
+        *BufferLength = sizeof(QUIC_CONNECTION_LATENCY_HISTOGRAMS);
+        CxPlatCopyMemory(
+            Buffer,
+            Connection->LatencyHistograms,
+            sizeof(QUIC_CONNECTION_LATENCY_HISTOGRAMS));
+
         Status = QUIC_STATUS_SUCCESS;
         break;
-    }
 
-    case QUIC_PARAM_CONN_SHARE_UDP_BINDING:
+    case QUIC_PARAM_CONN_QLOG_ENABLED:
 
-        if (*BufferLength < sizeof(uint8_t)) {
-            *BufferLength = sizeof(uint8_t);
+        if (*BufferLength < sizeof(BOOLEAN)) {
+            *BufferLength = sizeof(BOOLEAN);
             Status = QUIC_STATUS_BUFFER_TOO_SMALL;
             break;
         }
@@ -7019,29 +8753,16 @@ QuicConnParamGet(
             break;
         }
 
-        *BufferLength = sizeof(uint8_t);
-        *(uint8_t*)Buffer = Connection->State.ShareBinding;
+        *BufferLength = sizeof(BOOLEAN);
+        *(BOOLEAN*)Buffer = Connection->State.QlogEnabled;
 
         Status = QUIC_STATUS_SUCCESS;
         break;
 
-    case QUIC_PARAM_CONN_LOCAL_BIDI_STREAM_COUNT:
-        Type =
-            QuicConnIsServer(Connection) ?
-                STREAM_ID_FLAG_IS_SERVER | STREAM_ID_FLAG_IS_BI_DIR :
-                STREAM_ID_FLAG_IS_CLIENT | STREAM_ID_FLAG_IS_BI_DIR;
-        goto Get_Stream_Count;
-
-    case QUIC_PARAM_CONN_LOCAL_UNIDI_STREAM_COUNT:
-        Type =
-            QuicConnIsServer(Connection) ?
-                STREAM_ID_FLAG_IS_SERVER | STREAM_ID_FLAG_IS_UNI_DIR :
-                STREAM_ID_FLAG_IS_CLIENT | STREAM_ID_FLAG_IS_UNI_DIR;
-        goto Get_Stream_Count;
+    case QUIC_PARAM_CONN_PACKET_CAPTURE_ENABLED:
 
-    Get_Stream_Count:
-        if (*BufferLength < sizeof(uint16_t)) {
-            *BufferLength = sizeof(uint16_t);
+        if (*BufferLength < sizeof(BOOLEAN)) {
+            *BufferLength = sizeof(BOOLEAN);
             Status = QUIC_STATUS_BUFFER_TOO_SMALL;
             break;
         }
@@ -7051,42 +8772,70 @@ QuicConnParamGet(
             break;
         }
 
-        *BufferLength = sizeof(uint16_t);
-        *(uint16_t*)Buffer =
-            QuicStreamSetGetCountAvailable(&Connection->Streams, Type);
+        *BufferLength = sizeof(BOOLEAN);
+        *(BOOLEAN*)Buffer = Connection->State.PacketCaptureEnabled;
 
         Status = QUIC_STATUS_SUCCESS;
         break;
 
-    case QUIC_PARAM_CONN_MAX_STREAM_IDS:
+    case QUIC_PARAM_CONN_FLIGHT_RECORDER: {
 
-        if (*BufferLength < sizeof(uint64_t) * NUMBER_OF_STREAM_TYPES) {
-            *BufferLength = sizeof(uint64_t) * NUMBER_OF_STREAM_TYPES;
+        const QUIC_FLIGHT_RECORDER* Recorder = &Connection->FlightRecorder;
+        const uint32_t Count =
+            CXPLAT_MIN(Recorder->Count, QUIC_FLIGHT_RECORDER_EVENT_COUNT);
+
+        if (*BufferLength < Count * sizeof(QUIC_FLIGHT_RECORDER_EVENT)) {
+            *BufferLength = Count * sizeof(QUIC_FLIGHT_RECORDER_EVENT);
             Status = QUIC_STATUS_BUFFER_TOO_SMALL;
             break;
         }
 
-        if (Buffer == NULL) {
+        if (Buffer == NULL && Count != 0) {
             Status = QUIC_STATUS_INVALID_PARAMETER;
             break;
         }
 
-        *BufferLength = sizeof(uint64_t) * NUMBER_OF_STREAM_TYPES;
-        QuicStreamSetGetMaxStreamIDs(&Connection->Streams, (uint64_t*)Buffer);
+        //
+        // Oldest event first.
+        //
+        QUIC_FLIGHT_RECORDER_EVENT* Events = (QUIC_FLIGHT_RECORDER_EVENT*)Buffer;
+        for (uint32_t i = 0; i < Count; ++i) {
+            Events[i] =
+                Recorder->Events[
+                    (Recorder->Count - Count + i) & (QUIC_FLIGHT_RECORDER_EVENT_COUNT - 1)];
+        }
+        *BufferLength = Count * sizeof(QUIC_FLIGHT_RECORDER_EVENT);
 
         Status = QUIC_STATUS_SUCCESS;
         break;
+    }
 
-    case QUIC_PARAM_CONN_CLOSE_REASON_PHRASE:
+    case QUIC_PARAM_CONN_SEND_FLUSH_BUDGET:
 
-        if (Connection->CloseReasonPhrase == NULL) {
-            Status = QUIC_STATUS_NOT_FOUND;
+        if (*BufferLength < sizeof(uint32_t)) {
+            *BufferLength = sizeof(uint32_t);
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
             break;
         }
 
-        Length = (uint32_t)strlen(Connection->CloseReasonPhrase) + 1;
-        if (*BufferLength < Length) {
-            *BufferLength = Length;
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        *BufferLength = sizeof(uint32_t);
+        *(uint32_t*)Buffer =
+            Connection->Send.FlushBudgetUs != 0 ?
+                Connection->Send.FlushBudgetUs :
+                QuicSendGetDefaultFlushBudget(Connection->Registration->ExecProfile);
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
+    case QUIC_PARAM_CONN_SEND_COALESCING_DELAY:
+
+        if (*BufferLength < sizeof(uint32_t)) {
+            *BufferLength = sizeof(uint32_t);
             Status = QUIC_STATUS_BUFFER_TOO_SMALL;
             break;
         }
@@ -7096,16 +8845,16 @@ QuicConnParamGet(
             break;
         }
 
-        *BufferLength = Length;
-        CxPlatCopyMemory(Buffer, Connection->CloseReasonPhrase, Length);
+        *BufferLength = sizeof(uint32_t);
+        *(uint32_t*)Buffer = Connection->Send.CoalescingDelayUs;
 
         Status = QUIC_STATUS_SUCCESS;
         break;
 
-    case QUIC_PARAM_CONN_STREAM_SCHEDULING_SCHEME:
+    case QUIC_PARAM_CONN_ADDRESS_RACE_DELAY:
 
-        if (*BufferLength < sizeof(QUIC_STREAM_SCHEDULING_SCHEME)) {
-            *BufferLength = sizeof(QUIC_STREAM_SCHEDULING_SCHEME);
+        if (*BufferLength < sizeof(uint32_t)) {
+            *BufferLength = sizeof(uint32_t);
             Status = QUIC_STATUS_BUFFER_TOO_SMALL;
             break;
         }
@@ -7115,18 +8864,16 @@ QuicConnParamGet(
             break;
         }
 
-        *BufferLength = sizeof(QUIC_STREAM_SCHEDULING_SCHEME);
-        *(QUIC_STREAM_SCHEDULING_SCHEME*)Buffer =
-            Connection->State.UseRoundRobinStreamScheduling ?
-                QUIC_STREAM_SCHEDULING_SCHEME_ROUND_ROBIN : QUIC_STREAM_SCHEDULING_SCHEME_FIFO;
+        *BufferLength = sizeof(uint32_t);
+        *(uint32_t*)Buffer = Connection->AddressRaceDelayMs;
 
         Status = QUIC_STATUS_SUCCESS;
         break;
 
-    case QUIC_PARAM_CONN_DATAGRAM_RECEIVE_ENABLED:
+    case QUIC_PARAM_CONN_DATAGRAM_FEC:
 
-        if (*BufferLength < sizeof(BOOLEAN)) {
-            *BufferLength = sizeof(BOOLEAN);
+        if (*BufferLength < sizeof(QUIC_DATAGRAM_FEC_CONFIG)) {
+            *BufferLength = sizeof(QUIC_DATAGRAM_FEC_CONFIG);
             Status = QUIC_STATUS_BUFFER_TOO_SMALL;
             break;
         }
@@ -7136,16 +8883,16 @@ QuicConnParamGet(
             break;
         }
 
-        *BufferLength = sizeof(BOOLEAN);
-        *(BOOLEAN*)Buffer = Connection->Settings.DatagramReceiveEnabled;
+        *BufferLength = sizeof(QUIC_DATAGRAM_FEC_CONFIG);
+        CxPlatCopyMemory(Buffer, &Connection->Datagram.FecConfig, sizeof(QUIC_DATAGRAM_FEC_CONFIG));
 
         Status = QUIC_STATUS_SUCCESS;
         break;
 
-    case QUIC_PARAM_CONN_DATAGRAM_SEND_ENABLED:
+    case QUIC_PARAM_CONN_STANDBY_PATHS:
 
-        if (*BufferLength < sizeof(BOOLEAN)) {
-            *BufferLength = sizeof(BOOLEAN);
+        if (*BufferLength < sizeof(QUIC_STANDBY_PATHS)) {
+            *BufferLength = sizeof(QUIC_STANDBY_PATHS);
             Status = QUIC_STATUS_BUFFER_TOO_SMALL;
             break;
         }
@@ -7155,16 +8902,20 @@ QuicConnParamGet(
             break;
         }
 
-        *BufferLength = sizeof(BOOLEAN);
-        *(BOOLEAN*)Buffer = Connection->Datagram.SendEnabled;
+        *BufferLength = sizeof(QUIC_STANDBY_PATHS);
+        if (Connection->StandbyPaths != NULL) {
+            CxPlatCopyMemory(Buffer, &Connection->StandbyPaths->Config, sizeof(QUIC_STANDBY_PATHS));
+        } else {
+            CxPlatZeroMemory(Buffer, sizeof(QUIC_STANDBY_PATHS));
+        }
 
         Status = QUIC_STATUS_SUCCESS;
         break;
 
-    case QUIC_PARAM_CONN_DISABLE_1RTT_ENCRYPTION:
+    case QUIC_PARAM_CONN_STREAM_COMPRESSION:
 
-        if (*BufferLength < sizeof(BOOLEAN)) {
-            *BufferLength = sizeof(BOOLEAN);
+        if (*BufferLength < sizeof(QUIC_STREAM_COMPRESSION_CONFIG)) {
+            *BufferLength = sizeof(QUIC_STREAM_COMPRESSION_CONFIG);
             Status = QUIC_STATUS_BUFFER_TOO_SMALL;
             break;
         }
@@ -7174,46 +8925,48 @@ QuicConnParamGet(
             break;
         }
 
-        *BufferLength = sizeof(BOOLEAN);
-        *(BOOLEAN*)Buffer = Connection->State.Disable1RttEncrytion;
+        *BufferLength = sizeof(QUIC_STREAM_COMPRESSION_CONFIG);
+        CxPlatCopyMemory(Buffer, &Connection->StreamCompression, sizeof(QUIC_STREAM_COMPRESSION_CONFIG));
 
         Status = QUIC_STATUS_SUCCESS;
         break;
 
-    case QUIC_PARAM_CONN_STATISTICS_V2:
-    case QUIC_PARAM_CONN_STATISTICS_V2_PLAT: {
+    case QUIC_PARAM_CONN_DATAGRAM_SEND_POLICY:
 
-        Status =
-            QuicConnGetV2Statistics(
-                Connection,
-                Param == QUIC_PARAM_CONN_STATISTICS_V2_PLAT,
-                BufferLength,
-                (QUIC_STATISTICS_V2*)Buffer);
-        break;
-    }
+        if (*BufferLength < sizeof(QUIC_DATAGRAM_SEND_POLICY)) {
+            *BufferLength = sizeof(QUIC_DATAGRAM_SEND_POLICY);
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
 
-    case QUIC_PARAM_CONN_ORIG_DEST_CID:
-        if (Connection->OrigDestCID == NULL) {
-            Status = QUIC_STATUS_INVALID_STATE;
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
             break;
         }
-        if (*BufferLength < Connection->OrigDestCID->Length) {
+
+        *BufferLength = sizeof(QUIC_DATAGRAM_SEND_POLICY);
+        CxPlatCopyMemory(Buffer, &Connection->Datagram.SendPolicy, sizeof(QUIC_DATAGRAM_SEND_POLICY));
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
+    case QUIC_PARAM_CONN_MEMORY_USAGE:
+
+        if (*BufferLength < sizeof(QUIC_MEMORY_USAGE)) {
+            *BufferLength = sizeof(QUIC_MEMORY_USAGE);
             Status = QUIC_STATUS_BUFFER_TOO_SMALL;
-            *BufferLength = Connection->OrigDestCID->Length;
             break;
         }
+
         if (Buffer == NULL) {
             Status = QUIC_STATUS_INVALID_PARAMETER;
             break;
         }
-        CxPlatCopyMemory(
-            Buffer,
-            Connection->OrigDestCID->Data,
-            Connection->OrigDestCID->Length);
-        //
-        // Tell app how much buffer we copied.
-        //
-        *BufferLength = Connection->OrigDestCID->Length;
+
+        *BufferLength = sizeof(QUIC_MEMORY_USAGE);
+        CxPlatZeroMemory(Buffer, sizeof(QUIC_MEMORY_USAGE));
+        QuicConnGetMemoryUsage(Connection, (QUIC_MEMORY_USAGE*)Buffer);
+
         Status = QUIC_STATUS_SUCCESS;
         break;
 
@@ -7272,7 +9025,12 @@ QuicConnApplyNewSettings(
         QuicSendApplyNewSettings(&Connection->Send, &Connection->Settings);
         QuicCongestionControlInitialize(&Connection->CongestionControl, &Connection->Settings);
 
-        if (QuicConnIsClient(Connection) && Connection->Settings.IsSet.VersionSettings) {
+        if (QuicConnIsClient(Connection) &&
+            Connection->Settings.IsSet.VersionSettings &&
+            Connection->Stats.QuicVersion != Connection->Settings.VersionSettings->FullyDeployedVersions[0]) {
+            //
+            // Only rederive the Initial keys if the version actually changes.
+            //
             Connection->Stats.QuicVersion = Connection->Settings.VersionSettings->FullyDeployedVersions[0];
             QuicConnOnQuicVersionSet(Connection);
             //
@@ -7378,6 +9136,17 @@ QuicConnApplyNewSettings(
         }
     }
 
+    if (NewSettings->IsSet.HibernateTimeoutMs && Connection->State.Started) {
+        if (Connection->Settings.HibernateTimeoutMs != 0) {
+            QuicConnTimerSet(
+                Connection,
+                QUIC_CONN_TIMER_HIBERNATE,
+                MS_TO_US(Connection->Settings.HibernateTimeoutMs));
+        } else {
+            QuicConnTimerCancel(Connection, QUIC_CONN_TIMER_HIBERNATE);
+        }
+    }
+
     if (OverWrite) {
         QuicSettingsDumpNew(NewSettings);
     } else {
@@ -7387,6 +9156,54 @@ QuicConnApplyNewSettings(
     return TRUE;
 }
 
+//
+// Records the state changing API calls in the flight recorder. The data path
+// calls are left out so they don't push the rarer events out of it.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+void
+QuicConnFlightRecordApiCall(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ QUIC_API_TYPE Type
+    )
+{
+    QUIC_TRACE_API_TYPE TraceType;
+    switch (Type) {
+    case QUIC_API_TYPE_CONN_CLOSE:
+        TraceType = QUIC_TRACE_API_CONNECTION_CLOSE;
+        break;
+    case QUIC_API_TYPE_CONN_SHUTDOWN:
+        TraceType = QUIC_TRACE_API_CONNECTION_SHUTDOWN;
+        break;
+    case QUIC_API_TYPE_CONN_START:
+        TraceType = QUIC_TRACE_API_CONNECTION_START;
+        break;
+    case QUIC_API_TYPE_CONN_SET_CONFIGURATION:
+        TraceType = QUIC_TRACE_API_CONNECTION_SET_CONFIGURATION;
+        break;
+    case QUIC_API_TYPE_CONN_SEND_RESUMPTION_TICKET:
+        TraceType = QUIC_TRACE_API_CONNECTION_SEND_RESUMPTION_TICKET;
+        break;
+    case QUIC_API_TYPE_CONN_COMPLETE_RESUMPTION_TICKET_VALIDATION:
+        TraceType = QUIC_TRACE_API_CONNECTION_COMPLETE_RESUMPTION_TICKET_VALIDATION;
+        break;
+    case QUIC_API_TYPE_CONN_COMPLETE_CERTIFICATE_VALIDATION:
+        TraceType = QUIC_TRACE_API_CONNECTION_COMPLETE_CERTIFICATE_VALIDATION;
+        break;
+    case QUIC_API_TYPE_STRM_SHUTDOWN:
+        TraceType = QUIC_TRACE_API_STREAM_SHUTDOWN;
+        break;
+    case QUIC_API_TYPE_SET_PARAM:
+        TraceType = QUIC_TRACE_API_SET_PARAM;
+        break;
+    default:
+        return;
+    }
+    QuicConnFlightRecord(
+        Connection, QUIC_FLIGHT_RECORDER_EVENT_API_CALL, TraceType, 0);
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicConnProcessApiOperation(
@@ -7398,6 +9215,8 @@ QuicConnProcessApiOperation(
     QUIC_STATUS* ApiStatus = ApiCtx->Status;
     CXPLAT_EVENT* ApiCompleted = ApiCtx->Completed;
 
+    QuicConnFlightRecordApiCall(Connection, ApiCtx->Type);
+
     switch (ApiCtx->Type) {
 
     case QUIC_API_TYPE_CONN_CLOSE:
@@ -7482,11 +9301,46 @@ QuicConnProcessApiOperation(
             ApiCtx->STRM_SEND.Stream);
         break;
 
+    case QUIC_API_TYPE_STRM_OPEN_AND_SEND:
+        //
+        // Start the streams in order (so they get their IDs in order) and then
+        // flush their initial sends, same as separate start and send calls.
+        // Any start failure is indicated to the app on the stream itself.
+        //
+        for (uint32_t i = 0; i < ApiCtx->STRM_OPEN_AND_SEND.Count; ++i) {
+            QUIC_STREAM_OPEN_AND_SEND_ENTRY* Entry =
+                &ApiCtx->STRM_OPEN_AND_SEND.Entries[i];
+            (void)QuicStreamStart(Entry->Stream, Entry->Flags, FALSE);
+            QuicStreamSendFlush(Entry->Stream);
+        }
+        break;
+
     case QUIC_API_TYPE_STRM_RECV_COMPLETE:
         QuicStreamReceiveCompletePending(
             ApiCtx->STRM_RECV_COMPLETE.Stream);
         break;
 
+    case QUIC_API_TYPE_STRM_RECV_COMPLETE_BATCH:
+        for (uint32_t i = 0; i < ApiCtx->STRM_RECV_COMPLETE_BATCH.Count; ++i) {
+            //
+            // This releases the stream's operation ref.
+            //
+            QuicStreamReceiveCompletePending(
+                ApiCtx->STRM_RECV_COMPLETE_BATCH.Streams[i]);
+            ApiCtx->STRM_RECV_COMPLETE_BATCH.Streams[i] = NULL;
+        }
+        break;
+
+    case QUIC_API_TYPE_STRM_RECEIVE:
+        Status =
+            QuicStreamReceiveInto(
+                ApiCtx->STRM_RECEIVE.Stream,
+                ApiCtx->STRM_RECEIVE.Buffers,
+                ApiCtx->STRM_RECEIVE.BufferCount,
+                ApiCtx->STRM_RECEIVE.BytesReceived,
+                ApiCtx->STRM_RECEIVE.Flags);
+        break;
+
     case QUIC_API_TYPE_STRM_RECV_SET_ENABLED:
         Status =
             QuicStreamRecvSetEnabledState(
@@ -7494,6 +9348,13 @@ QuicConnProcessApiOperation(
                 ApiCtx->STRM_RECV_SET_ENABLED.IsEnabled);
         break;
 
+    case QUIC_API_TYPE_STRM_PROVIDE_RECV_BUFFERS:
+        Status =
+            QuicStreamProvideRecvBuffers(
+                ApiCtx->STRM_PROVIDE_RECV_BUFFERS.Stream,
+                &ApiCtx->STRM_PROVIDE_RECV_BUFFERS.Chunks);
+        break;
+
     case QUIC_API_TYPE_SET_PARAM:
         Status =
             QuicLibrarySetParam(
@@ -7530,6 +9391,90 @@ QuicConnProcessApiOperation(
     }
 }
 
+//
+// The server hasn't responded on the current address family within the race
+// delay, so move the client over to the other family's address on a new
+// binding and send the Initial again from there. The families keep alternating,
+// with the delay doubling each time, until the server responds on one of them.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+void
+QuicConnProcessAddressRaceTimer(
+    _In_ QUIC_CONNECTION* Connection
+    )
+{
+    CXPLAT_DBG_ASSERT(QuicConnIsClient(Connection));
+    QUIC_PATH* Path = &Connection->Paths[0];
+
+    if (QuicAddrGetFamily(&Connection->AddressRaceAlternate) == QUIC_ADDRESS_FAMILY_UNSPEC ||
+        Connection->State.GotFirstServerResponse ||
+        Connection->State.ClosedLocally || Connection->State.ClosedRemotely) {
+        return;
+    }
+
+    QUIC_ADDR NewRemoteAddress = Connection->AddressRaceAlternate;
+    QuicAddrSetPort(&NewRemoteAddress, QuicAddrGetPort(&Path->Route.RemoteAddress));
+
+    QUIC_BINDING* OldBinding = Path->Binding;
+
+    CXPLAT_UDP_CONFIG UdpConfig = {0};
+    UdpConfig.LocalAddress = NULL;
+    UdpConfig.RemoteAddress = &NewRemoteAddress;
+    UdpConfig.Flags = Connection->State.ShareBinding ? CXPLAT_SOCKET_FLAG_SHARE : 0;
+    UdpConfig.InterfaceIndex = 0;
+    UdpConfig.PartitionIndex = QuicPartitionIdGetIndex(Connection->PartitionID);
+#ifdef QUIC_COMPARTMENT_ID
+    UdpConfig.CompartmentId = Connection->Configuration->CompartmentId;
+#endif
+#ifdef QUIC_OWNING_PROCESS
+    UdpConfig.OwningProcess = Connection->Configuration->OwningProcess;
+#endif
+    QUIC_STATUS Status =
+        QuicLibraryGetBinding(
+            &UdpConfig,
+            &Path->Binding);
+    if (QUIC_FAILED(Status)) {
+        Path->Binding = OldBinding;
+        QuicTraceEvent(
+            ConnErrorStatus,
+            "[conn][%p] ERROR, %u, %s.",
+            Connection,
+            Status,
+            "Get binding for address race");
+        QuicAddrSetFamily(&Connection->AddressRaceAlternate, QUIC_ADDRESS_FAMILY_UNSPEC);
+        return;
+    }
+
+    QuicBindingMoveSourceConnectionIDs(OldBinding, Path->Binding, Connection);
+    QuicLibraryReleaseBinding(OldBinding);
+
+    Connection->AddressRaceAlternate = Path->Route.RemoteAddress;
+    Path->Route.RemoteAddress = NewRemoteAddress;
+    Path->Route.Queue = NULL;
+    Path->Route.State = RouteUnresolved;
+    QuicBindingGetLocalAddress(Path->Binding, &Path->Route.LocalAddress);
+    QuicTraceLogConnInfo(
+        AddressRaceSwitch,
+        Connection,
+        "Switched to racing address %!ADDR!",
+        CASTED_CLOG_BYTEARRAY(sizeof(Path->Route.RemoteAddress), &Path->Route.RemoteAddress));
+
+    //
+    // The handshake hasn't started as far as the server is concerned, so the
+    // destination CID stays the same and the Initial is simply sent again.
+    //
+    QuicConnRestart(Connection, FALSE);
+
+    if (Connection->AddressRaceSwitchCount < QUIC_ADDRESS_RACE_MAX_BACKOFF) {
+        Connection->AddressRaceSwitchCount++;
+    }
+    QuicConnTimerSet(
+        Connection,
+        QUIC_CONN_TIMER_ADDRESS_RACE,
+        MS_TO_US((uint64_t)Connection->AddressRaceDelayMs << Connection->AddressRaceSwitchCount));
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicConnProcessExpiredTimer(
@@ -7550,6 +9495,15 @@ QuicConnProcessExpiredTimer(
     case QUIC_CONN_TIMER_SHUTDOWN:
         QuicConnProcessShutdownTimerOperation(Connection);
         break;
+    case QUIC_CONN_TIMER_HIBERNATE:
+        QuicConnProcessHibernateTimerOperation(Connection);
+        break;
+    case QUIC_CONN_TIMER_ADDRESS_RACE:
+        QuicConnProcessAddressRaceTimer(Connection);
+        break;
+    case QUIC_CONN_TIMER_STANDBY_PROBE:
+        QuicConnUpdateStandbyPaths(Connection);
+        break;
     default:
         CXPLAT_FRE_ASSERT(FALSE);
         break;
@@ -7565,9 +9519,12 @@ QuicConnDrainOperations(
 {
     QUIC_OPERATION* Oper;
     const uint32_t MaxOperationCount =
-        Connection->Settings.MaxOperationsPerDrain;
+        Connection->Settings.MaxOperationsPerDrain *
+        (Connection->Registration != NULL ?
+            Connection->Registration->SchedulingWeight : 1);
     uint32_t OperationCount = 0;
     BOOLEAN HasMoreWorkToDo = TRUE;
+    BOOLEAN YieldWorker = FALSE;
 
     CXPLAT_PASSIVE_CODE();
 
@@ -7605,6 +9562,7 @@ QuicConnDrainOperations(
         }
 
         QuicOperLog(Connection, Oper);
+        QuicUsdtProbe(oper_dequeue, Connection, Oper->Type);
 
         BOOLEAN FreeOper = Oper->FreeAfterProcess;
 
@@ -7658,11 +9616,14 @@ QuicConnDrainOperations(
                 Connection->Send.FlushOperationPending = FALSE;
             } else {
                 //
-                // Still have more data to send. Put the operation back on the
-                // queue.
+                // Still have more data to send, but the flush used up its
+                // budget. Put the operation back on the queue and yield the
+                // worker, so other connections get to run before the next
+                // flush.
                 //
                 FreeOper = FALSE;
                 (void)QuicOperationEnqueue(&Connection->OperQ, Oper);
+                YieldWorker = TRUE;
             }
             break;
 
@@ -7673,6 +9634,13 @@ QuicConnDrainOperations(
             QuicConnProcessExpiredTimer(Connection, Oper->TIMER_EXPIRED.Type);
             break;
 
+        case QUIC_OPER_TYPE_TLS_COMPLETE:
+            if (Connection->State.ShutdownComplete) {
+                break; // Ignore if already shutdown
+            }
+            QuicCryptoTlsProcessComplete(&Connection->Crypto);
+            break;
+
         case QUIC_OPER_TYPE_TRACE_RUNDOWN:
             QuicConnTraceRundownOper(Connection);
             break;
@@ -7685,6 +9653,13 @@ QuicConnDrainOperations(
                 Connection, Oper->ROUTE.PhysicalAddress, Oper->ROUTE.PathId, Oper->ROUTE.Succeeded);
             break;
 
+        case QUIC_OPER_TYPE_SETTINGS_CHANGED:
+            if (Connection->State.ClosedLocally || Connection->State.ClosedRemotely) {
+                break; // Nothing left to tune.
+            }
+            QuicConnProcessSettingsChanged(Connection);
+            break;
+
         default:
             CXPLAT_FRE_ASSERT(FALSE);
             break;
@@ -7697,7 +9672,12 @@ QuicConnDrainOperations(
         }
 
         Connection->Stats.Schedule.OperationCount++;
+        Connection->Worker->OperationsProcessed++;
         QuicPerfCounterIncrement(QUIC_PERF_COUNTER_CONN_OPER_COMPLETED);
+
+        if (YieldWorker) {
+            break;
+        }
     }
 
     if (Connection->State.ProcessShutdownComplete) {
@@ -7716,6 +9696,14 @@ QuicConnDrainOperations(
         }
     }
 
+    if (!HasMoreWorkToDo && !Connection->State.ShutdownComplete) {
+        //
+        // The operation queue is drained, so use the idle time to do any
+        // deferred key derivation.
+        //
+        QuicCryptoPrepareNextKeyPhase(&Connection->Crypto);
+    }
+
     QuicStreamSetDrainClosedStreams(&Connection->Streams);
 
     QuicConnValidate(Connection);
@@ -8,6 +8,10 @@
 #include "connection.h.clog.h"
 #endif
 
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
 typedef struct QUIC_LISTENER QUIC_LISTENER;
 
 //
@@ -133,12 +137,6 @@ typedef union QUIC_CONNECTION_STATE {
         //
         BOOLEAN TestTransportParameterSet : 1;
 
-        //
-        // Indicates the connection is using the round robin stream scheduling
-        // scheme.
-        //
-        BOOLEAN UseRoundRobinStreamScheduling : 1;
-
         //
         // Indicates that this connection has resumption enabled and needs to
         // keep the TLS state and transport parameters until it is done sending
@@ -200,6 +198,29 @@ typedef union QUIC_CONNECTION_STATE {
         //
         BOOLEAN DelayedApplicationError : 1;
 
+        //
+        // The handshake was confirmed and the client should now migrate to the
+        // server's preferred address.
+        //
+        BOOLEAN PreferredAddressMigrationPending : 1;
+
+        //
+        // The app enabled qlog output (QUIC_PARAM_CONN_QLOG_ENABLED).
+        //
+        BOOLEAN QlogEnabled : 1;
+
+        //
+        // The app enabled capturing all of the connection's packets
+        // (QUIC_PARAM_CONN_PACKET_CAPTURE_ENABLED).
+        //
+        BOOLEAN PacketCaptureEnabled : 1;
+
+        //
+        // Both endpoints use the same stream compression codec
+        // (QUIC_PARAM_CONN_STREAM_COMPRESSION).
+        //
+        BOOLEAN StreamCompressionNegotiated : 1;
+
 #ifdef CxPlatVerifierEnabledByAddr
         //
         // The calling app is being verified (app or driver verifier).
@@ -231,6 +252,8 @@ typedef enum QUIC_CONNECTION_REF {
     QUIC_CONN_REF_TIMER_WHEEL,          // The timer wheel is tracking the connection.
     QUIC_CONN_REF_ROUTE,                // Route resolution is undergoing.
     QUIC_CONN_REF_STREAM,               // A stream depends on the connection.
+    QUIC_CONN_REF_PACING_WHEEL,         // The pacing wheel is tracking the connection.
+    QUIC_CONN_REF_TLS,                  // TLS processing may complete asynchronously.
 
     QUIC_CONN_REF_COUNT
 
@@ -285,6 +308,7 @@ typedef struct QUIC_CONN_STATS {
 
         uint64_t TotalBytes;            // Sum of UDP payloads
         uint64_t TotalStreamBytes;      // Sum of stream payloads
+        uint64_t CeMarkedPackets;       // Packets the peer reported as CE marked.
 
         uint32_t CongestionCount;
         uint32_t EcnCongestionCount;
@@ -311,6 +335,24 @@ typedef struct QUIC_CONN_STATS {
 
 } QUIC_CONN_STATS;
 
+//
+// A ring of the connection's most recent notable events: state changes,
+// losses, PTOs, congestion events and state changing API calls. It is always
+// on, so an abnormal close can be diagnosed without tracing having been
+// enabled beforehand, and is only written on the worker thread.
+//
+typedef struct QUIC_FLIGHT_RECORDER {
+
+    QUIC_FLIGHT_RECORDER_EVENT Events[QUIC_FLIGHT_RECORDER_EVENT_COUNT];
+
+    //
+    // Total number of events recorded. The next one is written at index
+    // Count % QUIC_FLIGHT_RECORDER_EVENT_COUNT.
+    //
+    uint32_t Count;
+
+} QUIC_FLIGHT_RECORDER;
+
 //
 // Connection-specific state.
 //   N.B. In general, all variables should only be written on the QUIC worker
@@ -325,9 +367,48 @@ typedef struct QUIC_CONNECTION {
 #endif
 
     //
-    // Link into the registrations's list of connections.
+    // ---------------------------------------------------------------------
+    // Hot state: touched on every received or sent packet, or every time the
+    // connection is scheduled on its worker. Kept together at the front of
+    // the struct so the per-packet paths stay within as few cache lines as
+    // possible. See ConnectionLayoutTest.cpp before moving fields around.
+    // ---------------------------------------------------------------------
     //
-    CXPLAT_LIST_ENTRY RegistrationLink;
+
+    //
+    // Number of references to the handle.
+    //
+    long RefCount;
+
+#if DEBUG
+    //
+    // Detailed ref counts
+    //
+    short RefTypeCount[QUIC_CONN_REF_COUNT];
+#endif
+
+    //
+    // The current connnection state/flags.
+    //
+    QUIC_CONNECTION_STATE State;
+
+    //
+    // The worker that is processing this connection.
+    //
+    QUIC_WORKER* Worker;
+
+    //
+    // The current worker thread ID. 0 if not being processed right now.
+    //
+    CXPLAT_THREAD_ID WorkerThreadID;
+
+    //
+    // Indicates whether a worker is currently processing a connection.
+    // N.B. Multi-threaded access, synchronized by worker's connection lock.
+    //
+    BOOLEAN WorkerProcessing : 1;
+    BOOLEAN HasQueuedWork : 1;
+    BOOLEAN HasPriorityWork : 1;
 
     //
     // Link in the worker's connection queue.
@@ -341,109 +422,214 @@ typedef struct QUIC_CONNECTION {
     CXPLAT_LIST_ENTRY TimerLink;
 
     //
-    // The worker that is processing this connection.
+    // Link in the worker pacing wheel's list.
     //
-    QUIC_WORKER* Worker;
+    CXPLAT_LIST_ENTRY PacingLink;
 
     //
-    // The top level registration this connection is a part of.
+    // Set of current reasons sending more packets is currently blocked.
     //
-    QUIC_REGISTRATION* Registration;
+    uint8_t OutFlowBlockedReasons; // Set of QUIC_FLOW_BLOCKED_* flags
 
     //
-    // The configuration for this connection.
+    // Ack Delay Exponent. Used to scale actual wire encoded value by
+    // 2 ^ ack_delay_exponent.
     //
-    QUIC_CONFIGURATION* Configuration;
+    uint8_t AckDelayExponent;
 
     //
-    // The settings for this connection. Some values may be inherited from the
-    // global settings, the configuration setting or explicitly set by the app.
+    // The number of packets that must be received before eliciting an immediate
+    // acknowledgment. May be updated by the peer via the ACK_FREQUENCY frame.
     //
-    QUIC_SETTINGS_INTERNAL Settings;
+    uint8_t PacketTolerance;
 
     //
-    // Number of references to the handle.
+    // Number of paths the connection is currently tracking.
     //
-    long RefCount;
+    _Field_range_(0, QUIC_MAX_PATH_COUNT)
+    uint8_t PathsCount;
 
-#if DEBUG
     //
-    // Detailed ref counts
+    // Receive packet queue.
     //
-    short RefTypeCount[QUIC_CONN_REF_COUNT];
-#endif
+    uint32_t ReceiveQueueCount;
+    uint32_t ReceiveQueueByteCount;
+    QUIC_RX_PACKET* ReceiveQueue;
+    QUIC_RX_PACKET** ReceiveQueueTail;
+    CXPLAT_DISPATCH_LOCK ReceiveQueueLock;
 
     //
-    // The current connnection state/flags.
+    // The queue of operations to process.
     //
-    QUIC_CONNECTION_STATE State;
+    QUIC_OPERATION_QUEUE OperQ;
 
     //
-    // The current worker thread ID. 0 if not being processed right now.
+    // Expiration time (absolute time in us) for each timer type. We use UINT64_MAX as a sentinel
+    // to indicate that the timer is not set.
     //
-    CXPLAT_THREAD_ID WorkerThreadID;
+    uint64_t ExpirationTimes[QUIC_CONN_TIMER_COUNT];
 
     //
-    // The server ID for the connection ID.
+    // Earliest expiration time of all timers types.
     //
-    uint8_t ServerID[QUIC_MAX_CID_SID_LENGTH];
+    uint64_t EarliestExpirationTime;
 
     //
-    // The partition ID for the connection ID.
+    // Expiration time (absolute time in us) for the next paced send, tracked
+    // by the worker's pacing wheel instead of the timer wheel. UINT64_MAX if
+    // not set.
     //
-    uint16_t PartitionID;
+    uint64_t PacingExpirationTime;
 
     //
-    // Number of non-retired desintation CIDs we currently have cached.
+    // Per-encryption level packet space information.
     //
-    uint8_t DestCidCount;
+    QUIC_PACKET_SPACE* Packets[QUIC_ENCRYPT_LEVEL_COUNT];
 
     //
-    // Number of retired desintation CIDs we currently have cached.
+    // Per-path state. The first entry in the list is the active path. All the
+    // rest (if any) are other tracked paths, sorted from most to least recently
+    // used.
     //
-    uint8_t RetiredDestCidCount;
+    QUIC_PATH Paths[QUIC_MAX_PATH_COUNT];
 
     //
-    // The maximum number of source CIDs to give the peer. This is a minimum of
-    // what we're willing to support and what the peer is willing to accept.
+    // The send manager for the connection.
     //
-    uint8_t SourceCidLimit;
+    QUIC_SEND Send;
+    QUIC_SEND_BUFFER SendBuffer;
 
     //
-    // Number of paths the connection is currently tracking.
+    // Manages all the information for outstanding sent packets.
     //
-    _Field_range_(0, QUIC_MAX_PATH_COUNT)
-    uint8_t PathsCount;
+    QUIC_LOSS_DETECTION LossDetection;
 
     //
-    // The next identifier to use for a new path.
+    // Congestion control state.
     //
-    uint8_t NextPathId;
+    QUIC_CONGESTION_CONTROL CongestionControl;
 
     //
-    // Indicates whether a worker is currently processing a connection.
+    // All the information and management logic for streams.
+    //
+    QUIC_STREAM_SET Streams;
+
+    //
+    // Working space for decoded ACK ranges. All ACK frames that are received
+    // are first decoded into this range.
+    //
+    QUIC_RANGE DecodedAckRanges;
+
+    //
+    // Manages the stream of cryptographic TLS data sent and received.
+    //
+    QUIC_CRYPTO Crypto;
+
+    //
+    // Manages datagrams for the connection.
+    //
+    QUIC_DATAGRAM Datagram;
+
+    //
+    // The handler for the API client's callbacks.
+    //
+    QUIC_CONNECTION_CALLBACK_HANDLER ClientCallbackHandler;
+
+    //
+    // Statistics
+    //
+    QUIC_CONN_STATS Stats;
+
+    //
+    // Latency histograms, only allocated while the app has them enabled (see
+    // QUIC_PARAM_CONN_LATENCY_HISTOGRAMS_ENABLED).
+    //
+    QUIC_CONNECTION_LATENCY_HISTOGRAMS* LatencyHistograms;
+
+    //
+    // The most recent notable events, for diagnosing abnormal closes.
+    //
+    QUIC_FLIGHT_RECORDER FlightRecorder;
+
+    //
+    // ---------------------------------------------------------------------
+    // Cold state: only used during setup, the handshake, close, param calls
+    // or other infrequent events. Starts at Settings.
+    // ---------------------------------------------------------------------
+    //
+
+    //
+    // The settings for this connection. Some values may be inherited from the
+    // global settings, the configuration setting or explicitly set by the app.
+    //
+    QUIC_SETTINGS_INTERNAL Settings;
+
+    //
+    // Link into the registrations's list of connections.
+    //
+    CXPLAT_LIST_ENTRY RegistrationLink;
+
+    //
+    // An idle worker that asked to take this connection over while it was
+    // queued on Worker.
     // N.B. Multi-threaded access, synchronized by worker's connection lock.
     //
-    BOOLEAN WorkerProcessing : 1;
-    BOOLEAN HasQueuedWork : 1;
-    BOOLEAN HasPriorityWork : 1;
+    QUIC_WORKER* StealingWorker;
 
     //
-    // Set of current reasons sending more packets is currently blocked.
+    // TRUE if the connection was placed on another partition's worker, because
+    // its own partition's worker was folded away by the elastic worker pool.
     //
-    uint8_t OutFlowBlockedReasons; // Set of QUIC_FLOW_BLOCKED_* flags
+    BOOLEAN FoldedWorker;
 
     //
-    // Ack Delay Exponent. Used to scale actual wire encoded value by
-    // 2 ^ ack_delay_exponent.
+    // The time spent processing the connection on its worker in the worker's
+    // current load interval, and in the one before it.
     //
-    uint8_t AckDelayExponent;
+    uint64_t LoadIntervalStart;
+    uint32_t BusyTimeUs;
+    uint32_t LastBusyTimeUs;
 
     //
-    // The number of packets that must be received before eliciting an immediate
-    // acknowledgment. May be updated by the peer via the ACK_FREQUENCY frame.
+    // The top level registration this connection is a part of.
     //
-    uint8_t PacketTolerance;
+    QUIC_REGISTRATION* Registration;
+
+    //
+    // The configuration for this connection.
+    //
+    QUIC_CONFIGURATION* Configuration;
+
+    //
+    // The server ID for the connection ID.
+    //
+    uint8_t ServerID[QUIC_MAX_CID_SID_LENGTH];
+
+    //
+    // The partition ID for the connection ID.
+    //
+    uint16_t PartitionID;
+
+    //
+    // Number of non-retired desintation CIDs we currently have cached.
+    //
+    uint8_t DestCidCount;
+
+    //
+    // Number of retired desintation CIDs we currently have cached.
+    //
+    uint8_t RetiredDestCidCount;
+
+    //
+    // The maximum number of source CIDs to give the peer. This is a minimum of
+    // what we're willing to support and what the peer is willing to accept.
+    //
+    uint8_t SourceCidLimit;
+
+    //
+    // The next identifier to use for a new path.
+    //
+    uint8_t NextPathId;
 
     //
     // The number of packets we want the peer to wait before sending an
@@ -473,13 +659,6 @@ typedef struct QUIC_CONNECTION {
     //
     QUIC_VAR_INT RetirePriorTo;
 
-    //
-    // Per-path state. The first entry in the list is the active path. All the
-    // rest (if any) are other tracked paths, sorted from most to least recently
-    // used.
-    //
-    QUIC_PATH Paths[QUIC_MAX_PATH_COUNT];
-
     //
     // The list of connection IDs used for receiving.
     //
@@ -503,29 +682,15 @@ typedef struct QUIC_CONNECTION {
     uint8_t CibirId[2 + QUIC_MAX_CIBIR_LENGTH];
 
     //
-    // Expiration time (absolute time in us) for each timer type. We use UINT64_MAX as a sentinel
-    // to indicate that the timer is not set.
-    //
-    uint64_t ExpirationTimes[QUIC_CONN_TIMER_COUNT];
-
-    //
-    // Earliest expiration time of all timers types.
+    // The preferred addresses the server advertises to the client, inherited
+    // from the listener.
     //
-    uint64_t EarliestExpirationTime;
+    QUIC_PREFERRED_ADDRESS PreferredAddress;
 
     //
-    // Receive packet queue.
+    // Preallocated operation used when an allocation fails while queueing a
+    // critical operation.
     //
-    uint32_t ReceiveQueueCount;
-    uint32_t ReceiveQueueByteCount;
-    QUIC_RX_PACKET* ReceiveQueue;
-    QUIC_RX_PACKET** ReceiveQueueTail;
-    CXPLAT_DISPATCH_LOCK ReceiveQueueLock;
-
-    //
-    // The queue of operations to process.
-    //
-    QUIC_OPERATION_QUEUE OperQ;
     QUIC_OPERATION BackUpOper;
     QUIC_API_CONTEXT BackupApiContext;
     uint16_t BackUpOperUsed;
@@ -553,62 +718,48 @@ typedef struct QUIC_CONNECTION {
     const char* RemoteServerName;
 
     //
-    // The entry into the remote hash lookup table, which is used only during the
-    // handshake.
-    //
-    QUIC_REMOTE_HASH_ENTRY* RemoteHashEntry;
-
-    //
-    // Transport parameters received from the peer.
-    //
-    QUIC_TRANSPORT_PARAMETERS PeerTransportParams;
-
-    //
-    // Working space for decoded ACK ranges. All ACK frames that are received
-    // are first decoded into this range.
-    //
-    QUIC_RANGE DecodedAckRanges;
-
-    //
-    // All the information and management logic for streams.
+    // Address racing (QUIC_PARAM_CONN_ADDRESS_RACE_DELAY). While the client
+    // hasn't heard from the server, the alternate address is the other family's
+    // address of the server (unspecified when not racing).
     //
-    QUIC_STREAM_SET Streams;
+    uint32_t AddressRaceDelayMs;
+    uint8_t AddressRaceSwitchCount;
+    QUIC_ADDR AddressRaceAlternate;
 
     //
-    // Congestion control state.
+    // The client's standby paths (QUIC_PARAM_CONN_STANDBY_PATHS). NULL until
+    // the app configures some.
     //
-    QUIC_CONGESTION_CONTROL CongestionControl;
+    QUIC_STANDBY_PATH_SET* StandbyPaths;
 
     //
-    // Manages all the information for outstanding sent packets.
+    // The app's stream compression codec (QUIC_PARAM_CONN_STREAM_COMPRESSION).
+    // A zero CodecId if none.
     //
-    QUIC_LOSS_DETECTION LossDetection;
+    QUIC_STREAM_COMPRESSION_CONFIG StreamCompression;
 
     //
-    // Per-encryption level packet space information.
-    //
-    QUIC_PACKET_SPACE* Packets[QUIC_ENCRYPT_LEVEL_COUNT];
-
-    //
-    // Manages the stream of cryptographic TLS data sent and received.
-    //
-    QUIC_CRYPTO Crypto;
-
-    //
-    // The send manager for the connection.
+    // The entry into the remote hash lookup table, which is used only during the
+    // handshake.
     //
-    QUIC_SEND Send;
-    QUIC_SEND_BUFFER SendBuffer;
+    QUIC_REMOTE_HASH_ENTRY* RemoteHashEntry;
 
     //
-    // Manages datagrams for the connection.
+    // Transport parameters received from the peer.
     //
-    QUIC_DATAGRAM Datagram;
+    QUIC_TRANSPORT_PARAMETERS PeerTransportParams;
 
     //
-    // The handler for the API client's callbacks.
+    // The values last indicated to the app in
+    // QUIC_CONNECTION_EVENT_NETWORK_STATISTICS. Only tracked when
+    // NetStatsEventThreshold is set.
     //
-    QUIC_CONNECTION_CALLBACK_HANDLER ClientCallbackHandler;
+    struct {
+        uint64_t TimeUs;
+        uint64_t SmoothedRtt;
+        uint64_t Bandwidth;
+        uint32_t CongestionWindow;
+    } LastNetStats;
 
     //
     // (Server-only) Transport parameters used during handshake.
@@ -617,9 +768,18 @@ typedef struct QUIC_CONNECTION {
     QUIC_TRANSPORT_PARAMETERS* HandshakeTP;
 
     //
-    // Statistics
+    // Bytes of memory currently charged to the connection. Streams can be
+    // opened by the app's threads, so that counter is updated atomically. The
+    // rest are only updated on the connection's worker thread. See
+    // QuicConnGetMemoryUsage.
     //
-    QUIC_CONN_STATS Stats;
+    struct {
+        uint64_t Streams;
+        uint64_t SendBuffer;
+        uint64_t RecvBuffer;
+        uint64_t CryptoRecvBuffer;
+        uint64_t SentPackets;
+    } MemoryUsage;
 
     //
     // Mostly test specific state.
@@ -632,6 +792,19 @@ typedef struct QUIC_CONNECTION {
     //
     QUIC_TLS_SECRETS* TlsSecrets;
 
+    //
+    // The TLS secrets for the packet capture, allocated when the TLS session
+    // starts if packets of the connection may be captured and the app didn't
+    // ask for the secrets itself.
+    //
+    QUIC_CAPTURE_SECRETS* CaptureSecrets;
+
+    //
+    // Congestion control callbacks provided by the app, if any. The app keeps
+    // the struct valid for the lifetime of the connection.
+    //
+    const QUIC_CUSTOM_CONGESTION_CONTROL* CustomCongestionControl;
+
     //
     // Previously-attempted QUIC version, after Incompatible Version Negotiation.
     //
@@ -657,6 +830,8 @@ typedef struct QUIC_CONNECTION {
         QUIC_FLOW_BLOCKED_TIMING_TRACKER AmplificationProt;
         QUIC_FLOW_BLOCKED_TIMING_TRACKER CongestionControl;
         QUIC_FLOW_BLOCKED_TIMING_TRACKER FlowControl;
+        QUIC_FLOW_BLOCKED_TIMING_TRACKER StreamFlowControl;
+        QUIC_FLOW_BLOCKED_TIMING_TRACKER App;
     } BlockedTimings;
 
 } QUIC_CONNECTION;
@@ -730,6 +905,78 @@ QuicConnIsClosed(
     return Connection->State.ClosedLocally || Connection->State.ClosedRemotely;
 }
 
+//
+// Records a qlog event in the worker's buffer, if the app enabled qlog for the
+// connection.
+//
+inline
+void
+QuicConnQlog(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ QUIC_QLOG_EVENT_TYPE Type,
+    _In_ uint8_t PacketType,
+    _In_ uint64_t Value0,
+    _In_ uint64_t Value1,
+    _In_ uint64_t Value2
+    )
+{
+    if (Connection->State.QlogEnabled) {
+        QuicQlogWrite(
+            &Connection->Worker->QlogBuffer,
+            Connection,
+            Type,
+            PacketType,
+            Value0,
+            Value1,
+            Value2);
+    }
+}
+
+//
+// Returns TRUE if the connection's next datagram should be captured, either
+// because the app enabled it for the connection or it is sampled.
+//
+inline
+BOOLEAN
+QuicConnPacketCaptureSample(
+    _In_ QUIC_CONNECTION* Connection
+    )
+{
+    if (MsQuicLib.PacketCapture.Handler == NULL) {
+        return FALSE;
+    }
+    if (Connection->State.PacketCaptureEnabled) {
+        return TRUE;
+    }
+    return
+        MsQuicLib.PacketCapture.SampleRate != 0 &&
+        QuicCaptureSample(
+            &Connection->Worker->CaptureBuffer,
+            MsQuicLib.PacketCapture.SampleRate);
+}
+
+//
+// Records an event in the connection's flight recorder, overwriting the oldest
+// one.
+//
+inline
+void
+QuicConnFlightRecord(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ QUIC_FLIGHT_RECORDER_EVENT_TYPE Type,
+    _In_ uint64_t Value,
+    _In_ uint32_t Detail
+    )
+{
+    QUIC_FLIGHT_RECORDER_EVENT* Event =
+        &Connection->FlightRecorder.Events[
+            Connection->FlightRecorder.Count++ & (QUIC_FLIGHT_RECORDER_EVENT_COUNT - 1)];
+    Event->TimeUs = CxPlatTimeUs64();
+    Event->Value = Value;
+    Event->Type = (uint32_t)Type;
+    Event->Detail = Detail;
+}
+
 //
 // Helper to get the owning QUIC_CONNECTION for the stream set module.
 //
@@ -911,6 +1158,12 @@ QuicConnAddOutFlowBlockedReason(
         if (Reason & QUIC_FLOW_BLOCKED_CONN_FLOW_CONTROL) {
             Connection->BlockedTimings.FlowControl.LastStartTimeUs = Now;
         }
+        if (Reason & QUIC_FLOW_BLOCKED_STREAM_FLOW_CONTROL) {
+            Connection->BlockedTimings.StreamFlowControl.LastStartTimeUs = Now;
+        }
+        if (Reason & QUIC_FLOW_BLOCKED_APP) {
+            Connection->BlockedTimings.App.LastStartTimeUs = Now;
+        }
 
         Connection->OutFlowBlockedReasons |= Reason;
         QuicTraceEvent(
@@ -962,6 +1215,18 @@ QuicConnRemoveOutFlowBlockedReason(
                 CxPlatTimeDiff64(Connection->BlockedTimings.FlowControl.LastStartTimeUs, Now);
             Connection->BlockedTimings.FlowControl.LastStartTimeUs = 0;
         }
+        if ((Connection->OutFlowBlockedReasons & QUIC_FLOW_BLOCKED_STREAM_FLOW_CONTROL) &&
+            (Reason & QUIC_FLOW_BLOCKED_STREAM_FLOW_CONTROL)) {
+            Connection->BlockedTimings.StreamFlowControl.CumulativeTimeUs +=
+                CxPlatTimeDiff64(Connection->BlockedTimings.StreamFlowControl.LastStartTimeUs, Now);
+            Connection->BlockedTimings.StreamFlowControl.LastStartTimeUs = 0;
+        }
+        if ((Connection->OutFlowBlockedReasons & QUIC_FLOW_BLOCKED_APP) &&
+            (Reason & QUIC_FLOW_BLOCKED_APP)) {
+            Connection->BlockedTimings.App.CumulativeTimeUs +=
+                CxPlatTimeDiff64(Connection->BlockedTimings.App.LastStartTimeUs, Now);
+            Connection->BlockedTimings.App.LastStartTimeUs = 0;
+        }
 
         Connection->OutFlowBlockedReasons &= ~Reason;
         QuicTraceEvent(
@@ -1126,6 +1391,27 @@ QuicConnQueueTraceRundown(
     _In_ QUIC_CONNECTION* Connection
     );
 
+//
+// Queues a refresh of the connection's live tunables from its configuration,
+// after the global settings were reloaded.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicConnQueueSettingsChanged(
+    _In_ QUIC_CONNECTION* Connection
+    );
+
+//
+// Adds the memory currently used by the connection to Usage. May be called
+// from other threads, in which case the result is only approximate.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicConnGetMemoryUsage(
+    _In_ const QUIC_CONNECTION* Connection,
+    _Inout_ QUIC_MEMORY_USAGE* Usage
+    );
+
 //
 // Indicates an event to the application layer.
 //
@@ -1193,6 +1479,47 @@ QuicConnGenerateNewSourceCids(
     _In_ BOOLEAN ReplaceExistingCids
     );
 
+//
+// Moves the connection to a new partition, replacing its source CIDs with ones
+// for the new partition, and queues it to move to that partition's worker.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnMoveToPartition(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ uint16_t PartitionIndex
+    );
+
+//
+// Moves an established connection to a less loaded partition, if it is in a
+// state where that is possible. Returns TRUE if the move was started.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+QuicConnTryRebalance(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ uint16_t PartitionIndex
+    );
+
+//
+// Returns a destination connection ID that isn't used by any path yet, if any.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_CID_LIST_ENTRY*
+QuicConnGetUnusedDestCid(
+    _In_ const QUIC_CONNECTION* Connection
+    );
+
+//
+// Retires a destination connection ID, queuing the RETIRE_CONNECTION_ID frame.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnRetireCid(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ QUIC_CID_LIST_ENTRY* DestCid
+    );
+
 //
 // Retires the currently used destination connection ID.
 //
@@ -1352,6 +1679,34 @@ QuicConnTimerCancel(
     _In_ QUIC_CONN_TIMER_TYPE Type
     );
 
+//
+// Schedules the next paced send.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnPacingTimerSet(
+    _Inout_ QUIC_CONNECTION* Connection,
+    _In_ uint64_t DelayUs
+    );
+
+//
+// Cancels the next paced send.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnPacingTimerCancel(
+    _Inout_ QUIC_CONNECTION* Connection
+    );
+
+//
+// Called when the next paced send is due.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnPacingTimerExpired(
+    _Inout_ QUIC_CONNECTION* Connection
+    );
+
 //
 // Called when the next timer(s) expire.
 //
@@ -1459,6 +1814,16 @@ QuicConnDiscardDeferred0Rtt(
     _In_ QUIC_CONNECTION* Connection
     );
 
+//
+// Drops a stream's hold on a received packet, returning the packet to the
+// datapath if the connection was already done with it.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicConnReleaseHeldPacket(
+    _In_ QUIC_RX_PACKET* Packet
+    );
+
 //
 // Processes deferred datagrams for newly derived read keys.
 //
@@ -1578,6 +1943,17 @@ QuicConnQueueRouteCompletion(
     _In_ BOOLEAN Succeeded
     );
 
+//
+// Queues a TLS completion event to a connection for processing, after TLS
+// processing was suspended for an async private key operation.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Function_class_(CXPLAT_TLS_PROCESS_COMPLETE_CALLBACK)
+void
+QuicConnQueueTlsCompletion(
+    _In_ QUIC_CONNECTION* Connection
+    );
+
 //
 // Queues up an update to the packet tolerance we want the peer to use.
 //
@@ -1675,3 +2051,7 @@ QuicMtuDiscoveryCheckSearchCompleteTimeout(
         }
     }
 }
+
+#if defined(__cplusplus)
+}
+#endif
@@ -0,0 +1,591 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    The algorithm used for adjusting CongestionWindow is Copa (Arun and
+    Balakrishnan, NSDI 2018), a delay-based congestion control which targets
+    a bounded queuing delay.
+
+    The queuing delay (dq) is estimated as the difference between the minimum
+    RTT over the last half smoothed RTT (RTTstanding) and the minimum RTT over
+    the last 10 seconds (RTTmin). The target rate is 1 / (Delta * dq) packets
+    per second. On each ACK the window moves towards the target by
+    Velocity / (Delta * CongestionWindow) packets.
+
+    Copa in its default mode doesn't react to loss, except for persistent
+    congestion.
+
+--*/
+
+#include "precomp.h"
+#ifdef QUIC_CLOG
+#include "copa.c.clog.h"
+#endif
+
+#include "copa.h"
+
+//
+// Delta, which trades off throughput against queuing delay, is 1/2. Its
+// inverse is used for integer arithmetic.
+//
+#define COPA_INVERSE_DELTA 2
+
+//
+// Number of round trips the window must move in the same direction before
+// the velocity starts doubling, and the maximum velocity.
+//
+#define COPA_VELOCITY_ROUNDS 3
+#define COPA_MAX_VELOCITY 32
+
+//
+// Lifetime of RTTmin samples.
+//
+const uint64_t kCopaMinRttLifetimeInUs = S_TO_US(10);
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicConnLogCopa(
+    _In_ const QUIC_CONNECTION* const Connection
+    )
+{
+    const QUIC_CONGESTION_CONTROL_COPA* Copa = &Connection->CongestionControl.Copa;
+
+    QuicTraceEvent(
+        ConnCopa,
+        "[conn][%p] Copa: CongestionWindow=%u Velocity=%u RttStanding=%llu RttMin=%llu",
+        Connection,
+        Copa->CongestionWindow,
+        Copa->Velocity,
+        Copa->RttStanding,
+        Copa->RttMin);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+CopaCongestionControlGetMinimumWindow(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    const QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    return
+        (uint32_t)QuicPathGetDatagramPayloadSize(&Connection->Paths[0]) *
+        QUIC_PERSISTENT_CONGESTION_WINDOW_PACKETS;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+CopaCongestionControlCanSend(
+    _In_ QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    QUIC_CONGESTION_CONTROL_COPA* Copa = &Cc->Copa;
+    return Copa->BytesInFlight < Copa->CongestionWindow || Copa->Exemptions > 0;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CopaCongestionControlSetExemption(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint8_t NumPackets
+    )
+{
+    Cc->Copa.Exemptions = NumPackets;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CopaCongestionControlReset(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ BOOLEAN FullReset
+    )
+{
+    QUIC_CONGESTION_CONTROL_COPA* Copa = &Cc->Copa;
+
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    const uint16_t DatagramPayloadLength =
+        QuicPathGetDatagramPayloadSize(&Connection->Paths[0]);
+    Copa->IsInSlowStart = TRUE;
+    Copa->IsInPersistentCongestion = FALSE;
+    Copa->LastRoundIncreased = TRUE;
+    Copa->CongestionWindow = DatagramPayloadLength * Copa->InitialWindowPackets;
+    Copa->BytesInFlightMax = Copa->CongestionWindow / 2;
+    Copa->LastSendAllowance = 0;
+    Copa->Velocity = 1;
+    Copa->SameDirectionRounds = 0;
+    Copa->RoundEnd = Connection->Send.NextPacketNumber;
+    Copa->WindowAtRoundStart = Copa->CongestionWindow;
+    Copa->RttStanding = UINT64_MAX;
+    Copa->RttMin = UINT64_MAX;
+    QuicSlidingWindowExtremumReset(&Copa->RttStandingFilter);
+    QuicSlidingWindowExtremumReset(&Copa->RttMinFilter);
+    if (FullReset) {
+        Copa->BytesInFlight = 0;
+    }
+
+    QuicConnLogOutFlowStats(Connection);
+    QuicConnLogCopa(Connection);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+CopaCongestionControlGetSendAllowance(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint64_t TimeSinceLastSend, // microsec
+    _In_ BOOLEAN TimeSinceLastSendValid
+    )
+{
+    QUIC_CONGESTION_CONTROL_COPA* Copa = &Cc->Copa;
+
+    uint32_t SendAllowance;
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    if (Copa->BytesInFlight >= Copa->CongestionWindow) {
+        //
+        // We are CC blocked, so we can't send anything.
+        //
+        SendAllowance = 0;
+
+    } else if (
+        !TimeSinceLastSendValid ||
+        !Connection->Settings.PacingEnabled ||
+        Copa->RttStanding == UINT64_MAX ||
+        Copa->RttStanding < QUIC_MIN_PACING_RTT) {
+        //
+        // We're not in the necessary state to pace.
+        //
+        SendAllowance = Copa->CongestionWindow - Copa->BytesInFlight;
+
+    } else {
+
+        //
+        // Copa paces at twice the window per RTTstanding, which spreads the
+        // window out without building a standing queue from bursts.
+        //
+        const uint64_t EstimatedWnd = (uint64_t)Copa->CongestionWindow << 1;
+
+        SendAllowance =
+            Copa->LastSendAllowance +
+            (uint32_t)((EstimatedWnd * TimeSinceLastSend) / Copa->RttStanding);
+        if (SendAllowance < Copa->LastSendAllowance || // Overflow case
+            SendAllowance > (Copa->CongestionWindow - Copa->BytesInFlight)) {
+            SendAllowance = Copa->CongestionWindow - Copa->BytesInFlight;
+        }
+
+        Copa->LastSendAllowance = SendAllowance;
+    }
+    return SendAllowance;
+}
+
+//
+// Returns TRUE if we became unblocked.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+CopaCongestionControlUpdateBlockedState(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ BOOLEAN PreviousCanSendState
+    )
+{
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    QuicConnLogOutFlowStats(Connection);
+    if (PreviousCanSendState != CopaCongestionControlCanSend(Cc)) {
+        if (PreviousCanSendState) {
+            QuicConnAddOutFlowBlockedReason(
+                Connection, QUIC_FLOW_BLOCKED_CONGESTION_CONTROL);
+        } else {
+            QuicConnRemoveOutFlowBlockedReason(
+                Connection, QUIC_FLOW_BLOCKED_CONGESTION_CONTROL);
+            Connection->Send.LastFlushTime = CxPlatTimeUs64(); // Reset last flush time
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+//
+// Updates RTTstanding and RTTmin with a new RTT sample.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CopaCongestionControlUpdateRtt(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint64_t RttSample,
+    _In_ uint64_t TimeNow
+    )
+{
+    QUIC_CONGESTION_CONTROL_COPA* Copa = &Cc->Copa;
+    const QUIC_PATH* Path = &QuicCongestionControlGetConnection(Cc)->Paths[0];
+    QUIC_SLIDING_WINDOW_EXTREMUM_ENTRY Entry = { 0, 0 };
+
+    //
+    // The RTTstanding window follows the smoothed RTT.
+    //
+    Copa->RttStandingFilter.EntryLifetime =
+        CXPLAT_MAX(Path->SmoothedRtt / 2, QUIC_MIN_PACING_RTT);
+    QuicSlidingWindowExtremumUpdateMin(&Copa->RttStandingFilter, RttSample, TimeNow);
+    if (QUIC_SUCCEEDED(QuicSlidingWindowExtremumGet(&Copa->RttStandingFilter, &Entry))) {
+        Copa->RttStanding = Entry.Value;
+    }
+
+    QuicSlidingWindowExtremumUpdateMin(&Copa->RttMinFilter, RttSample, TimeNow);
+    if (QUIC_SUCCEEDED(QuicSlidingWindowExtremumGet(&Copa->RttMinFilter, &Entry))) {
+        Copa->RttMin = Entry.Value;
+    }
+}
+
+//
+// Called at the end of each round trip to update the velocity.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CopaCongestionControlOnRoundEnd(
+    _In_ QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    QUIC_CONGESTION_CONTROL_COPA* Copa = &Cc->Copa;
+
+    const BOOLEAN Increased = Copa->CongestionWindow > Copa->WindowAtRoundStart;
+    if (Increased == Copa->LastRoundIncreased) {
+        if (++Copa->SameDirectionRounds >= COPA_VELOCITY_ROUNDS &&
+            Copa->Velocity < COPA_MAX_VELOCITY) {
+            Copa->Velocity <<= 1;
+        }
+    } else {
+        Copa->Velocity = 1;
+        Copa->SameDirectionRounds = 0;
+    }
+
+    Copa->LastRoundIncreased = Increased;
+    Copa->WindowAtRoundStart = Copa->CongestionWindow;
+    Copa->RoundEnd = QuicCongestionControlGetConnection(Cc)->Send.NextPacketNumber;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CopaCongestionControlOnDataSent(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint32_t NumRetransmittableBytes
+    )
+{
+    QUIC_CONGESTION_CONTROL_COPA* Copa = &Cc->Copa;
+
+    BOOLEAN PreviousCanSendState = QuicCongestionControlCanSend(Cc);
+
+    Copa->BytesInFlight += NumRetransmittableBytes;
+    if (Copa->BytesInFlightMax < Copa->BytesInFlight) {
+        Copa->BytesInFlightMax = Copa->BytesInFlight;
+        QuicSendBufferConnectionAdjust(QuicCongestionControlGetConnection(Cc));
+    }
+
+    if (NumRetransmittableBytes > Copa->LastSendAllowance) {
+        Copa->LastSendAllowance = 0;
+    } else {
+        Copa->LastSendAllowance -= NumRetransmittableBytes;
+    }
+
+    if (Copa->Exemptions > 0) {
+        --Copa->Exemptions;
+    }
+
+    CopaCongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+CopaCongestionControlOnDataInvalidated(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint32_t NumRetransmittableBytes
+    )
+{
+    QUIC_CONGESTION_CONTROL_COPA* Copa = &Cc->Copa;
+
+    BOOLEAN PreviousCanSendState = CopaCongestionControlCanSend(Cc);
+
+    CXPLAT_DBG_ASSERT(Copa->BytesInFlight >= NumRetransmittableBytes);
+    Copa->BytesInFlight -= NumRetransmittableBytes;
+
+    return CopaCongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+CopaCongestionControlOnDataAcknowledged(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_ACK_EVENT* AckEvent
+    )
+{
+    QUIC_CONGESTION_CONTROL_COPA* Copa = &Cc->Copa;
+
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    BOOLEAN PreviousCanSendState = CopaCongestionControlCanSend(Cc);
+    const uint32_t BytesAcked = AckEvent->NumRetransmittableBytes;
+
+    CXPLAT_DBG_ASSERT(Copa->BytesInFlight >= BytesAcked);
+    Copa->BytesInFlight -= BytesAcked;
+
+    if (AckEvent->MinRttValid) {
+        CopaCongestionControlUpdateRtt(Cc, AckEvent->MinRtt, AckEvent->TimeNow);
+    }
+
+    if (AckEvent->LargestAck >= Copa->RoundEnd) {
+        CopaCongestionControlOnRoundEnd(Cc);
+    }
+
+    if (Copa->IsInPersistentCongestion) {
+        if (AckEvent->LargestAck > Copa->RecoverySentPacketNumber) {
+            QuicTraceEvent(
+                ConnRecoveryExit,
+                "[conn][%p] Recovery complete",
+                Connection);
+            Copa->IsInPersistentCongestion = FALSE;
+        }
+        goto Exit;
+    }
+
+    if (BytesAcked == 0 || Copa->RttStanding == UINT64_MAX) {
+        goto Exit;
+    }
+
+    const uint16_t DatagramPayloadLength =
+        QuicPathGetDatagramPayloadSize(&Connection->Paths[0]);
+    const uint64_t QueuingDelay =
+        Copa->RttStanding > Copa->RttMin ? Copa->RttStanding - Copa->RttMin : 0;
+
+    //
+    // The current rate (CongestionWindow / RTTstanding) is at or below the
+    // target rate (1 / (Delta * dq)) iff CongestionWindow * Delta * dq <=
+    // RTTstanding, in packets.
+    //
+    const BOOLEAN BelowTarget =
+        (uint64_t)Copa->CongestionWindow * QueuingDelay <=
+        (uint64_t)COPA_INVERSE_DELTA * DatagramPayloadLength * Copa->RttStanding;
+
+    if (Copa->IsInSlowStart) {
+        if (BelowTarget) {
+            //
+            // Double the window every round trip until the target is reached.
+            //
+            Copa->CongestionWindow += BytesAcked;
+            goto Limit;
+        }
+        Copa->IsInSlowStart = FALSE;
+    }
+
+    //
+    // Change the window by Velocity / (Delta * CongestionWindow) packets for
+    // every packet acknowledged.
+    //
+    const uint64_t Change =
+        ((uint64_t)BytesAcked * DatagramPayloadLength * Copa->Velocity * COPA_INVERSE_DELTA) /
+        Copa->CongestionWindow;
+    if (BelowTarget) {
+        Copa->CongestionWindow =
+            (uint32_t)CXPLAT_MIN((uint64_t)Copa->CongestionWindow + Change, UINT32_MAX);
+    } else if (Copa->CongestionWindow > Change + CopaCongestionControlGetMinimumWindow(Cc)) {
+        Copa->CongestionWindow -= (uint32_t)Change;
+    } else {
+        Copa->CongestionWindow = CopaCongestionControlGetMinimumWindow(Cc);
+    }
+
+Limit:
+
+    //
+    // Limit the growth of the window based on the number of bytes we
+    // actually manage to put on the wire.
+    //
+    if (Copa->CongestionWindow > 2 * Copa->BytesInFlightMax) {
+        Copa->CongestionWindow = 2 * Copa->BytesInFlightMax;
+    }
+
+Exit:
+
+    if (Connection->Settings.NetStatsEventEnabled) {
+        QuicCongestionControlIndicateNetworkStatistics(
+            Cc,
+            Copa->BytesInFlight,
+            Copa->CongestionWindow,
+            Copa->CongestionWindow / Connection->Paths[0].SmoothedRtt);
+    }
+
+    return CopaCongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CopaCongestionControlOnDataLost(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_LOSS_EVENT* LossEvent
+    )
+{
+    QUIC_CONGESTION_CONTROL_COPA* Copa = &Cc->Copa;
+
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    BOOLEAN PreviousCanSendState = CopaCongestionControlCanSend(Cc);
+
+    if (LossEvent->PersistentCongestion && !Copa->IsInPersistentCongestion) {
+        QuicTraceEvent(
+            ConnCongestionV2,
+            "[conn][%p] Congestion event: IsEcn=%hu",
+            Connection,
+            FALSE);
+        Connection->Stats.Send.CongestionCount++;
+        QuicTraceEvent(
+            ConnPersistentCongestion,
+            "[conn][%p] Persistent congestion event",
+            Connection);
+        Connection->Stats.Send.PersistentCongestionCount++;
+
+        Connection->Paths[0].Route.State = RouteSuspected; // used only for RAW datapath
+
+        Copa->IsInPersistentCongestion = TRUE;
+        Copa->RecoverySentPacketNumber = LossEvent->LargestSentPacketNumber;
+        Copa->CongestionWindow = CopaCongestionControlGetMinimumWindow(Cc);
+        Copa->Velocity = 1;
+        Copa->SameDirectionRounds = 0;
+    }
+
+    CXPLAT_DBG_ASSERT(Copa->BytesInFlight >= LossEvent->NumRetransmittableBytes);
+    Copa->BytesInFlight -= LossEvent->NumRetransmittableBytes;
+
+    CopaCongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
+    QuicConnLogCopa(Connection);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+CopaCongestionControlOnSpuriousCongestionEvent(
+    _In_ QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    //
+    // Only persistent congestion changes the window on loss, and that is
+    // never undone.
+    //
+    UNREFERENCED_PARAMETER(Cc);
+    return FALSE;
+}
+
+void
+CopaCongestionControlLogOutFlowStatus(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    const QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    const QUIC_PATH* Path = &Connection->Paths[0];
+    const QUIC_CONGESTION_CONTROL_COPA* Copa = &Cc->Copa;
+
+    QuicTraceEvent(
+        ConnOutFlowStatsV2,
+        "[conn][%p] OUT: BytesSent=%llu InFlight=%u CWnd=%u ConnFC=%llu ISB=%llu PostedBytes=%llu SRtt=%llu 1Way=%llu",
+        Connection,
+        Connection->Stats.Send.TotalBytes,
+        Copa->BytesInFlight,
+        Copa->CongestionWindow,
+        Connection->Send.PeerMaxData - Connection->Send.OrderedStreamBytesSent,
+        Connection->SendBuffer.IdealBytes,
+        Connection->SendBuffer.PostedBytes,
+        Path->GotFirstRttSample ? Path->SmoothedRtt : 0,
+        Path->OneWayDelay);
+}
+
+uint32_t
+CopaCongestionControlGetBytesInFlightMax(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    return Cc->Copa.BytesInFlightMax;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint8_t
+CopaCongestionControlGetExemptions(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    return Cc->Copa.Exemptions;
+}
+
+uint32_t
+CopaCongestionControlGetCongestionWindow(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    return Cc->Copa.CongestionWindow;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+CopaCongestionControlIsInRecovery(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    return Cc->Copa.IsInPersistentCongestion;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+CopaCongestionControlIsAppLimited(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    UNREFERENCED_PARAMETER(Cc);
+    return FALSE;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CopaCongestionControlSetAppLimited(
+    _In_ struct QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    UNREFERENCED_PARAMETER(Cc);
+}
+
+static const QUIC_CONGESTION_CONTROL QuicCongestionControlCopa = {
+    .Name = "Copa",
+    .QuicCongestionControlCanSend = CopaCongestionControlCanSend,
+    .QuicCongestionControlSetExemption = CopaCongestionControlSetExemption,
+    .QuicCongestionControlReset = CopaCongestionControlReset,
+    .QuicCongestionControlGetSendAllowance = CopaCongestionControlGetSendAllowance,
+    .QuicCongestionControlOnDataSent = CopaCongestionControlOnDataSent,
+    .QuicCongestionControlOnDataInvalidated = CopaCongestionControlOnDataInvalidated,
+    .QuicCongestionControlOnDataAcknowledged = CopaCongestionControlOnDataAcknowledged,
+    .QuicCongestionControlOnDataLost = CopaCongestionControlOnDataLost,
+    .QuicCongestionControlOnEcn = NULL,
+    .QuicCongestionControlOnSpuriousCongestionEvent = CopaCongestionControlOnSpuriousCongestionEvent,
+    .QuicCongestionControlLogOutFlowStatus = CopaCongestionControlLogOutFlowStatus,
+    .QuicCongestionControlGetExemptions = CopaCongestionControlGetExemptions,
+    .QuicCongestionControlGetBytesInFlightMax = CopaCongestionControlGetBytesInFlightMax,
+    .QuicCongestionControlIsAppLimited = CopaCongestionControlIsAppLimited,
+    .QuicCongestionControlSetAppLimited = CopaCongestionControlSetAppLimited,
+    .QuicCongestionControlGetCongestionWindow = CopaCongestionControlGetCongestionWindow,
+    .QuicCongestionControlIsInRecovery = CopaCongestionControlIsInRecovery,
+};
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CopaCongestionControlInitialize(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_SETTINGS_INTERNAL* Settings
+    )
+{
+    *Cc = QuicCongestionControlCopa;
+
+    QUIC_CONGESTION_CONTROL_COPA* Copa = &Cc->Copa;
+
+    Copa->InitialWindowPackets = Settings->InitialWindowPackets;
+    Copa->RttStandingFilter =
+        QuicSlidingWindowExtremumInitialize(
+            QUIC_MIN_PACING_RTT,
+            kCopaDefaultFilterCapacity,
+            Copa->RttStandingFilterEntries);
+    Copa->RttMinFilter =
+        QuicSlidingWindowExtremumInitialize(
+            kCopaMinRttLifetimeInUs,
+            kCopaDefaultFilterCapacity,
+            Copa->RttMinFilterEntries);
+
+    CopaCongestionControlReset(Cc, TRUE);
+}
@@ -0,0 +1,94 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+--*/
+
+#pragma once
+
+#include "sliding_window_extremum.h"
+
+#define kCopaDefaultFilterCapacity 3
+
+typedef struct QUIC_CONGESTION_CONTROL_COPA {
+
+    //
+    // TRUE until the first time the sending rate exceeds the target rate.
+    //
+    BOOLEAN IsInSlowStart : 1;
+
+    //
+    // This flag indicates a persistent congestion event occurred and CC is
+    // attempting to recover from it.
+    //
+    BOOLEAN IsInPersistentCongestion : 1;
+
+    //
+    // Direction the window moved in during the previous round trip.
+    //
+    BOOLEAN LastRoundIncreased : 1;
+
+    //
+    // The size of the initial congestion window, in packets.
+    //
+    uint32_t InitialWindowPackets;
+
+    uint32_t CongestionWindow; // bytes
+
+    //
+    // The number of bytes considered to be still in the network.
+    //
+    uint32_t BytesInFlight;
+    uint32_t BytesInFlightMax;
+
+    //
+    // The leftover send allowance from a previous send. Only used when pacing.
+    //
+    uint32_t LastSendAllowance; // bytes
+
+    //
+    // A count of packets which can be sent ignoring CongestionWindow.
+    //
+    uint8_t Exemptions;
+
+    //
+    // Velocity multiplier applied to window changes. Doubles every round trip
+    // once the window has moved in the same direction for a few round trips.
+    //
+    uint32_t Velocity;
+    uint32_t SameDirectionRounds;
+
+    //
+    // Packet number that ends the current round trip and the window at the
+    // start of it.
+    //
+    uint64_t RoundEnd;
+    uint32_t WindowAtRoundStart; // bytes
+
+    //
+    // Packet number that ends the current persistent congestion recovery.
+    //
+    uint64_t RecoverySentPacketNumber;
+
+    //
+    // Minimum RTT over the last half smoothed RTT (RTTstanding) and over the
+    // last 10 seconds (RTTmin). Their difference is the queuing delay.
+    //
+    uint64_t RttStanding; // microseconds
+    uint64_t RttMin; // microseconds
+
+    QUIC_SLIDING_WINDOW_EXTREMUM RttStandingFilter;
+    QUIC_SLIDING_WINDOW_EXTREMUM_ENTRY RttStandingFilterEntries[kCopaDefaultFilterCapacity];
+
+    QUIC_SLIDING_WINDOW_EXTREMUM RttMinFilter;
+    QUIC_SLIDING_WINDOW_EXTREMUM_ENTRY RttMinFilterEntries[kCopaDefaultFilterCapacity];
+
+} QUIC_CONGESTION_CONTROL_COPA;
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CopaCongestionControlInitialize(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_SETTINGS_INTERNAL* Settings
+    );
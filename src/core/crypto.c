@@ -30,7 +30,8 @@ CXPLAT_TLS_PEER_CERTIFICATE_RECEIVED_CALLBACK QuicConnPeerCertReceived;
 CXPLAT_TLS_CALLBACKS QuicTlsCallbacks = {
     QuicConnReceiveTP,
     QuicConnRecvResumptionTicket,
-    QuicConnPeerCertReceived
+    QuicConnPeerCertReceived,
+    QuicConnQueueTlsCompletion
 };
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -98,6 +99,92 @@ QuicCryptoValidate(
 #define QuicCryptoValidate(Crypto)
 #endif
 
+//
+// Creates the Initial packet keys for the handshake CID. Servers first look for
+// the Initial secrets in the per-processor cache, because many connections may
+// be created for the same CID when an Initial packet is replayed.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+QUIC_STATUS
+QuicCryptoCreateInitialKeys(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ const QUIC_VERSION_INFO* VersionInfo,
+    _In_ uint8_t CidLength,
+    _In_reads_(CidLength)
+        const uint8_t* const Cid,
+    _Out_ QUIC_PACKET_KEY** ReadKey,
+    _Out_ QUIC_PACKET_KEY** WriteKey
+    )
+{
+    if (QuicConnIsClient(Connection) || CidLength > QUIC_MAX_CONNECTION_ID_LENGTH_V1) {
+        return
+            QuicPacketKeyCreateInitial(
+                QuicConnIsServer(Connection),
+                &VersionInfo->HkdfLabels,
+                VersionInfo->Salt,
+                CidLength,
+                Cid,
+                ReadKey,
+                WriteKey);
+    }
+
+    QUIC_STATUS Status;
+    QUIC_LIBRARY_PP* PerProc = QuicLibraryGetPerProc();
+    QUIC_INITIAL_SECRET_CACHE_ENTRY* Entry =
+        &PerProc->InitialSecretCache[
+            CxPlatHashSimple(CidLength, Cid) % QUIC_INITIAL_SECRET_CACHE_SIZE];
+    CXPLAT_SECRET ClientInitial, ServerInitial;
+    BOOLEAN Found = FALSE;
+
+    CxPlatDispatchLockAcquire(&PerProc->InitialSecretCacheLock);
+    if (Entry->Salt == VersionInfo->Salt &&
+        Entry->CidLength == CidLength &&
+        memcmp(Entry->Cid, Cid, CidLength) == 0) {
+        ClientInitial = Entry->ClientInitial;
+        ServerInitial = Entry->ServerInitial;
+        Found = TRUE;
+    }
+    CxPlatDispatchLockRelease(&PerProc->InitialSecretCacheLock);
+
+    if (!Found) {
+        Status =
+            CxPlatTlsDeriveInitialSecrets(
+                VersionInfo->Salt,
+                Cid,
+                CidLength,
+                &ClientInitial,
+                &ServerInitial);
+        if (QUIC_FAILED(Status)) {
+            goto Exit;
+        }
+
+        CxPlatDispatchLockAcquire(&PerProc->InitialSecretCacheLock);
+        Entry->Salt = VersionInfo->Salt;
+        Entry->CidLength = CidLength;
+        CxPlatCopyMemory(Entry->Cid, Cid, CidLength);
+        Entry->ClientInitial = ClientInitial;
+        Entry->ServerInitial = ServerInitial;
+        CxPlatDispatchLockRelease(&PerProc->InitialSecretCacheLock);
+    }
+
+    Status =
+        QuicPacketKeyCreateInitialFromSecrets(
+            TRUE,
+            &VersionInfo->HkdfLabels,
+            &ClientInitial,
+            &ServerInitial,
+            ReadKey,
+            WriteKey);
+
+Exit:
+
+    CxPlatSecureZeroMemory(&ClientInitial, sizeof(ClientInitial));
+    CxPlatSecureZeroMemory(&ServerInitial, sizeof(ServerInitial));
+
+    return Status;
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 QUIC_STATUS
 QuicCryptoInitialize(
@@ -147,17 +234,20 @@ QuicCryptoInitialize(
         QUIC_MAX_RANGE_ALLOC_SIZE,
         &Crypto->SparseAckRanges);
 
-    Status =
-        QuicRecvBufferInitialize(
-            &Crypto->RecvBuffer,
-            InitialRecvBufferLength,
-            QUIC_DEFAULT_STREAM_FC_WINDOW_SIZE / 2,
-            QUIC_RECV_BUF_MODE_SINGLE,
-            NULL);
-    if (QUIC_FAILED(Status)) {
-        goto Exit;
-    }
+    //
+    // In-order, complete CRYPTO frames are passed straight to TLS (see
+    // QuicCryptoProcessFrameDirect), so the buffer's memory isn't allocated
+    // until a frame actually needs to be held.
+    //
+    QuicRecvBufferInitializeDeferred(
+        &Crypto->RecvBuffer,
+        InitialRecvBufferLength,
+        QUIC_DEFAULT_STREAM_FC_WINDOW_SIZE / 2,
+        QUIC_RECV_BUF_MODE_SINGLE,
+        &QuicLibraryGetPerProc()->RecvChunkPool);
     RecvBufferInitialized = TRUE;
+    QuicRecvBufferSetUsageCounter(
+        &Crypto->RecvBuffer, &Connection->MemoryUsage.CryptoRecvBuffer);
 
     if (QuicConnIsServer(Connection)) {
         CXPLAT_DBG_ASSERT(Connection->SourceCids.Next != NULL);
@@ -183,10 +273,9 @@ QuicCryptoInitialize(
     }
 
     Status =
-        QuicPacketKeyCreateInitial(
-            QuicConnIsServer(Connection),
-            &VersionInfo->HkdfLabels,
-            VersionInfo->Salt,
+        QuicCryptoCreateInitialKeys(
+            Connection,
+            VersionInfo,
             HandshakeCidLength,
             HandshakeCid,
             &Crypto->TlsState.ReadKeys[QUIC_PACKET_KEY_INITIAL],
@@ -305,6 +394,24 @@ QuicCryptoInitializeTls(
     if (QuicConnIsClient(Connection)) {
         TlsConfig.ServerName = Connection->RemoteServerName;
     }
+    if (Connection->TlsSecrets == NULL &&
+        MsQuicLib.PacketCapture.Handler != NULL &&
+        (MsQuicLib.PacketCapture.SampleRate != 0 ||
+         Connection->State.PacketCaptureEnabled)) {
+        //
+        // Some of the connection's packets may be captured, so keep its
+        // secrets for decrypting them. Without them, the capture still
+        // works, but only the Initial packets can be decrypted.
+        //
+        if (Connection->CaptureSecrets == NULL) {
+            Connection->CaptureSecrets =
+                CXPLAT_ALLOC_NONPAGED(sizeof(QUIC_CAPTURE_SECRETS), QUIC_POOL_CAPTURE_SECRETS);
+        }
+        if (Connection->CaptureSecrets != NULL) {
+            CxPlatZeroMemory(Connection->CaptureSecrets, sizeof(QUIC_CAPTURE_SECRETS));
+            Connection->TlsSecrets = &Connection->CaptureSecrets->Secrets;
+        }
+    }
     TlsConfig.TlsSecrets = Connection->TlsSecrets;
 
     TlsConfig.HkdfLabels = &QuicSupportedVersionList[0].HkdfLabels; // Default to latest
@@ -319,14 +426,23 @@ QuicCryptoInitializeTls(
         Connection->Stats.QuicVersion != QUIC_VERSION_DRAFT_29 ?
             TLS_EXTENSION_TYPE_QUIC_TRANSPORT_PARAMETERS :
             TLS_EXTENSION_TYPE_QUIC_TRANSPORT_PARAMETERS_DRAFT;
-    TlsConfig.LocalTPBuffer =
-        QuicCryptoTlsEncodeTransportParameters(
-            Connection,
-            QuicConnIsServer(Connection),
-            Params,
-            (Connection->State.TestTransportParameterSet ?
-                &Connection->TestTransportParameter : NULL),
-            &TlsConfig.LocalTPLength);
+    if (IsServer && !Connection->State.TestTransportParameterSet) {
+        TlsConfig.LocalTPBuffer =
+            QuicCryptoTlsEncodeServerTransportParametersCached(
+                Connection,
+                &Connection->Configuration->TPCache,
+                Params,
+                &TlsConfig.LocalTPLength);
+    } else {
+        TlsConfig.LocalTPBuffer =
+            QuicCryptoTlsEncodeTransportParameters(
+                Connection,
+                QuicConnIsServer(Connection),
+                Params,
+                (Connection->State.TestTransportParameterSet ?
+                    &Connection->TestTransportParameter : NULL),
+                &TlsConfig.LocalTPLength);
+    }
     if (TlsConfig.LocalTPBuffer == NULL) {
         Status = QUIC_STATUS_OUT_OF_MEMORY;
         goto Error;
@@ -446,10 +562,9 @@ QuicCryptoOnVersionChange(
     }
 
     Status =
-        QuicPacketKeyCreateInitial(
-            QuicConnIsServer(Connection),
-            &VersionInfo->HkdfLabels,
-            VersionInfo->Salt,
+        QuicCryptoCreateInitialKeys(
+            Connection,
+            VersionInfo,
             HandshakeCidLength,
             HandshakeCid,
             &Crypto->TlsState.ReadKeys[QUIC_PACKET_KEY_INITIAL],
@@ -491,6 +606,26 @@ QuicCryptoHandshakeConfirmed(
 {
     QUIC_CONNECTION* Connection = QuicCryptoGetConnection(Crypto);
     Connection->State.HandshakeConfirmed = TRUE;
+    QuicConnFlightRecord(
+        Connection, QUIC_FLIGHT_RECORDER_EVENT_HANDSHAKE_CONFIRMED, 0, 0);
+
+    //
+    // Clients move to the server's preferred address once the handshake is
+    // confirmed, after the packets currently being processed.
+    //
+    if (QuicConnIsClient(Connection) &&
+        Connection->PeerTransportParams.Flags & QUIC_TP_FLAG_PREFERRED_ADDRESS) {
+        Connection->State.PreferredAddressMigrationPending = TRUE;
+    }
+
+    //
+    // Standby paths need the handshake confirmed first, since they're only
+    // probed with 1-RTT packets. Start them from the timer, after the packets
+    // currently being processed.
+    //
+    if (QuicConnIsClient(Connection) && Connection->StandbyPaths != NULL) {
+        QuicConnTimerSet(Connection, QUIC_CONN_TIMER_STANDBY_PROBE, 0);
+    }
 
     if (SignalBinding) {
         QUIC_PATH* Path = &Connection->Paths[0];
@@ -499,6 +634,49 @@ QuicCryptoHandshakeConfirmed(
     }
 
     QuicCryptoDiscardKeys(Crypto, QUIC_PACKET_KEY_HANDSHAKE);
+
+    //
+    // 1-RTT key updates are allowed from now on, so get the first one's keys
+    // ready once the connection is idle.
+    //
+    Crypto->NextKeyPhasePending = TRUE;
+
+    //
+    // Servers already release their TLS state as soon as everything they sent
+    // is acknowledged, unless they may still send a resumption ticket. Clients
+    // otherwise hold on to it for the rest of the connection, just in case
+    // the server sends one, so only release it if the app asked to. Encryption
+    // offload needs the TLS object to populate the keys on each new path.
+    //
+    if (QuicConnIsClient(Connection) &&
+        Connection->Settings.ReleaseHandshakeStateEnabled &&
+        !Connection->Settings.EncryptionOffloadAllowed) {
+        QuicCryptoReleaseHandshakeState(Crypto);
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicCryptoReleaseHandshakeState(
+    _In_ QUIC_CRYPTO* Crypto
+    )
+{
+    QuicTraceLogConnInfo(
+        CryptoStateDiscard,
+        QuicCryptoGetConnection(Crypto),
+        "TLS state no longer needed");
+    if (Crypto->TLS != NULL) {
+        CxPlatTlsUninitialize(Crypto->TLS);
+        Crypto->TLS = NULL;
+    }
+    if (Crypto->Initialized) {
+        QuicRecvBufferUninitialize(&Crypto->RecvBuffer);
+        QuicRangeUninitialize(&Crypto->SparseAckRanges);
+        CXPLAT_FREE(Crypto->TlsState.Buffer, QUIC_POOL_TLS_BUFFER);
+        Crypto->TlsState.Buffer = NULL;
+        Crypto->TlsState.BufferAllocLength = 0;
+        Crypto->Initialized = FALSE;
+    }
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -1301,6 +1479,137 @@ Error:
     return Status;
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+void
+QuicCryptoCallTls(
+    _In_ QUIC_CRYPTO* Crypto,
+    _In_reads_bytes_opt_(*BufferLength)
+        const uint8_t* Buffer,
+    _Inout_ uint32_t* BufferLength
+    );
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicCryptoProcessTlsCompletion(
+    _In_ QUIC_CRYPTO* Crypto
+    );
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicCryptoProcessDataComplete(
+    _In_ QUIC_CRYPTO* Crypto,
+    _In_ uint32_t RecvBufferConsumed
+    );
+
+//
+// Passes a CRYPTO frame to TLS directly from the packet, if it is exactly the
+// next expected data, nothing is buffered, and it holds only complete TLS
+// messages. This is the common case, and saves copying each handshake message
+// through the receive buffer. Returns FALSE if the frame must be buffered.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+BOOLEAN
+QuicCryptoProcessFrameDirect(
+    _In_ QUIC_CRYPTO* Crypto,
+    _In_ QUIC_PACKET_KEY_TYPE KeyType,
+    _In_ const QUIC_CRYPTO_EX* const Frame
+    )
+{
+    QUIC_CONNECTION* Connection = QuicCryptoGetConnection(Crypto);
+    QUIC_RECV_BUFFER* RecvBuffer = &Crypto->RecvBuffer;
+    const uint64_t Offset = Crypto->RecvEncryptLevelStartOffset + Frame->Offset;
+
+    if (KeyType == QUIC_PACKET_KEY_1_RTT_OLD ||
+        KeyType == QUIC_PACKET_KEY_1_RTT_NEW) {
+        KeyType = QUIC_PACKET_KEY_1_RTT;
+    }
+
+    if (Frame->Length == 0 ||
+        !Crypto->Initialized ||
+        Crypto->TLS == NULL ||
+        Crypto->CertValidationPending ||
+        Crypto->TlsProcessPending ||
+        Crypto->TicketValidationPending ||
+        (QuicConnIsServer(Connection) && !Connection->State.ListenerAccepted) ||
+        KeyType != Crypto->TlsState.ReadKey ||
+        RecvBuffer->ReadPendingLength != 0 ||
+        RecvBuffer->ReadLength != 0 ||
+        Offset != RecvBuffer->BaseOffset ||
+        Offset != QuicRecvBufferGetTotalLength(RecvBuffer) ||
+        Offset + Frame->Length > RecvBuffer->BaseOffset + RecvBuffer->VirtualBufferLength ||
+        QuicCryptoTlsGetCompleteTlsMessagesLength(
+            Frame->Data, (uint32_t)Frame->Length) != Frame->Length) {
+        return FALSE;
+    }
+
+    QuicTraceLogConnVerbose(
+        RecvCrypto,
+        Connection,
+        "Received %hu crypto bytes, offset=%llu Ready=%hhu",
+        (uint16_t)Frame->Length,
+        Frame->Offset,
+        TRUE);
+
+    QuicCryptoValidate(Crypto);
+
+    uint32_t BufferLength = (uint32_t)Frame->Length;
+    QuicCryptoCallTls(Crypto, Frame->Data, &BufferLength);
+
+    QUIC_STATUS Status;
+    uint64_t WriteLimit = UINT16_MAX;
+    if (BufferLength == Frame->Length &&
+        !Crypto->CertValidationPending &&
+        !Crypto->TicketValidationPending) {
+        //
+        // Everything was consumed, so the buffer only needs to account for it.
+        //
+        Status =
+            QuicRecvBufferWriteExternal(
+                RecvBuffer, Offset, (uint16_t)Frame->Length, &WriteLimit);
+        if (QUIC_SUCCEEDED(Status)) {
+            Crypto->RecvTotalConsumed += BufferLength;
+            QuicCryptoValidate(Crypto);
+            QuicCryptoProcessTlsCompletion(Crypto);
+        }
+
+    } else {
+        //
+        // TLS stopped early (e.g. for an async validation), so the frame is
+        // buffered after all. It's read back out, just as if it had gone
+        // through QuicCryptoProcessData, so that what TLS consumed is drained
+        // (now or once the validation completes) and the rest is read again.
+        //
+        BOOLEAN DataReady;
+        Status =
+            QuicRecvBufferWrite(
+                RecvBuffer,
+                Offset,
+                (uint16_t)Frame->Length,
+                Frame->Data,
+                &WriteLimit,
+                &DataReady);
+        if (QUIC_SUCCEEDED(Status)) {
+            CXPLAT_DBG_ASSERT(DataReady);
+            uint64_t BufferOffset;
+            uint32_t BufferCount = 1;
+            QUIC_BUFFER Buffer;
+            QuicRecvBufferRead(RecvBuffer, &BufferOffset, &BufferCount, &Buffer);
+            CXPLAT_DBG_ASSERT(BufferCount == 1);
+            CXPLAT_DBG_ASSERT(BufferOffset == Offset);
+            CXPLAT_DBG_ASSERT(Buffer.Length == Frame->Length);
+            QuicCryptoProcessDataComplete(Crypto, BufferLength);
+        }
+    }
+
+    if (QUIC_FAILED(Status)) {
+        QuicConnFatalError(Connection, Status, "Crypto receive accounting failed");
+    }
+
+    return TRUE;
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 QUIC_STATUS
 QuicCryptoProcessFrame(
@@ -1312,16 +1621,18 @@ QuicCryptoProcessFrame(
     QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
     BOOLEAN DataReady;
 
-    Status =
-        QuicCryptoProcessDataFrame(
-            Crypto, KeyType, Frame, &DataReady);
-    if (QUIC_FAILED(Status) || !DataReady) {
-        goto Error;
-    }
+    if (!QuicCryptoProcessFrameDirect(Crypto, KeyType, Frame)) {
+        Status =
+            QuicCryptoProcessDataFrame(
+                Crypto, KeyType, Frame, &DataReady);
+        if (QUIC_FAILED(Status) || !DataReady) {
+            goto Error;
+        }
 
-    Status = QuicCryptoProcessData(Crypto, FALSE);
-    if (QUIC_FAILED(Status)) {
-        goto Error;
+        Status = QuicCryptoProcessData(Crypto, FALSE);
+        if (QUIC_FAILED(Status)) {
+            goto Error;
+        }
     }
 
     QUIC_CONNECTION* Connection = QuicCryptoGetConnection(Crypto);
@@ -1611,7 +1922,7 @@ QuicCryptoProcessTlsCompletion(
                 Connection,
                 InitialSourceCid->CID.SequenceNumber,
                 CASTED_CLOG_BYTEARRAY(InitialSourceCid->CID.Length, InitialSourceCid->CID.Data));
-            CXPLAT_FREE(InitialSourceCid, QUIC_POOL_CIDHASH);
+            QuicCidFreeSource(InitialSourceCid);
         }
 
         //
@@ -1620,7 +1931,12 @@ QuicCryptoProcessTlsCompletion(
         // CONNECTED event is indicated to the app).
         //
         Connection->State.Connected = TRUE;
+        QuicConnFlightRecord(
+            Connection, QUIC_FLIGHT_RECORDER_EVENT_CONNECTED, 0, 0);
         QuicPerfCounterIncrement(QUIC_PERF_COUNTER_CONN_CONNECTED);
+        QuicPerfHistogramRecord(
+            QUIC_PERF_HISTOGRAM_HANDSHAKE_TIME,
+            CxPlatTimeDiff64(Connection->Stats.Timing.Start, CxPlatTimeUs64()));
 
         QuicConnGenerateNewSourceCids(Connection, FALSE);
 
@@ -1710,6 +2026,77 @@ QuicCryptoProcessDataComplete(
     QuicCryptoProcessTlsCompletion(Crypto);
 }
 
+//
+// Passes received crypto data (if any) to TLS. If TLS suspends processing on
+// an async private key operation, the connection stays referenced until
+// QuicConnQueueTlsCompletion is called.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+void
+QuicCryptoCallTls(
+    _In_ QUIC_CRYPTO* Crypto,
+    _In_reads_bytes_opt_(*BufferLength)
+        const uint8_t* Buffer,
+    _Inout_ uint32_t* BufferLength
+    )
+{
+    QUIC_CONNECTION* Connection = QuicCryptoGetConnection(Crypto);
+
+    //
+    // Take the reference before the call, because the completion may be
+    // indicated on another thread before the call returns.
+    //
+    QuicConnAddRef(Connection, QUIC_CONN_REF_TLS);
+
+    Crypto->ResultFlags =
+        CxPlatTlsProcessData(
+            Crypto->TLS,
+            CXPLAT_TLS_CRYPTO_DATA,
+            Buffer,
+            BufferLength,
+            &Crypto->TlsState);
+
+    if (Crypto->ResultFlags & CXPLAT_TLS_RESULT_PENDING) {
+        QuicTraceLogConnInfo(
+            TlsProcessPending,
+            Connection,
+            "TLS processing pending async key operation");
+        Crypto->TlsProcessPending = TRUE;
+    } else {
+        QuicConnRelease(Connection, QUIC_CONN_REF_TLS);
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicCryptoTlsProcessComplete(
+    _In_ QUIC_CRYPTO* Crypto
+    )
+{
+    if (!Crypto->TlsProcessPending) {
+        return;
+    }
+
+    Crypto->TlsProcessPending = FALSE;
+    QuicTraceLogConnInfo(
+        TlsProcessResumed,
+        QuicCryptoGetConnection(Crypto),
+        "Resuming TLS processing after async key operation");
+
+    uint32_t BufferLength = 0;
+    QuicCryptoCallTls(Crypto, NULL, &BufferLength);
+    QuicCryptoProcessDataComplete(Crypto, 0);
+
+    if (!Crypto->TlsProcessPending &&
+        QuicRecvBufferHasUnreadData(&Crypto->RecvBuffer)) {
+        //
+        // More data was received while waiting for the key operation.
+        //
+        QuicCryptoProcessData(Crypto, FALSE);
+    }
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicCryptoCustomCertValidationComplete(
@@ -1823,10 +2210,11 @@ QuicCryptoProcessData(
     uint32_t BufferCount = 1;
     QUIC_BUFFER Buffer;
 
-    if (Crypto->CertValidationPending ||
+    if (Crypto->CertValidationPending || Crypto->TlsProcessPending ||
         (Crypto->TicketValidationPending && !Crypto->TicketValidationRejecting)) {
         //
-        // An async validation is pending, don't process any more data until it is complete.
+        // An async validation or key operation is pending, don't process any
+        // more data until it is complete.
         //
         return Status;
     }
@@ -1934,13 +2322,7 @@ QuicCryptoProcessData(
 
     QuicCryptoValidate(Crypto);
 
-    Crypto->ResultFlags =
-        CxPlatTlsProcessData(
-            Crypto->TLS,
-            CXPLAT_TLS_CRYPTO_DATA,
-            Buffer.Buffer,
-            &Buffer.Length,
-            &Crypto->TlsState);
+    QuicCryptoCallTls(Crypto, Buffer.Buffer, &Buffer.Length);
 
     QuicCryptoProcessDataComplete(Crypto, Buffer.Length);
 
@@ -2062,6 +2444,28 @@ Error:
     return Status;
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicCryptoPrepareNextKeyPhase(
+    _In_ QUIC_CRYPTO* Crypto
+    )
+{
+    if (!Crypto->NextKeyPhasePending) {
+        return;
+    }
+    Crypto->NextKeyPhasePending = FALSE;
+
+    if (Crypto->TlsState.ReadKeys[QUIC_PACKET_KEY_1_RTT] == NULL) {
+        return; // The 1-RTT keys have already been discarded.
+    }
+
+    //
+    // A failure here isn't fatal; the keys are derived again on demand when
+    // the next key update is triggered.
+    //
+    (void)QuicCryptoGenerateNewKeys(QuicCryptoGetConnection(Crypto));
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicCryptoUpdateKeyPhase(
@@ -2143,6 +2547,19 @@ QuicCryptoUpdateKeyPhase(
     PacketSpace->AwaitingKeyPhaseConfirmation = TRUE;
 
     PacketSpace->CurrentKeyPhaseBytesSent = 0;
+
+    //
+    // Derive the following key phase's keys later, when the connection has no
+    // other work queued, so that the next update is just a key swap.
+    //
+    Connection->Crypto.NextKeyPhasePending = TRUE;
+
+    if (Connection->Paths[0].EncryptionOffloading) {
+        //
+        // Plumb the new 1-RTT keys and key phase down to the offload.
+        //
+        QuicPathUpdateQeo(Connection, &Connection->Paths[0], CXPLAT_QEO_OPERATION_ADD);
+    }
 }
 
 QUIC_STATUS
@@ -2156,6 +2573,7 @@ QuicCryptoEncodeServerTicket(
     _In_ uint8_t AlpnLength,
     _In_reads_bytes_(AlpnLength)
         const uint8_t* const NegotiatedAlpn,
+    _In_opt_ const QUIC_CONGESTION_CONTROL_SAVED_STATE* SavedState,
     _Outptr_result_buffer_(*TicketLength)
         uint8_t** Ticket,
     _Out_ uint32_t* TicketLength
@@ -2165,6 +2583,9 @@ QuicCryptoEncodeServerTicket(
     uint32_t EncodedTPLength = 0;
     uint8_t* TicketBuffer = NULL;
     const uint8_t* EncodedHSTP = NULL;
+    const uint32_t SavedRtt = SavedState != NULL ? SavedState->Rtt : 0;
+    const uint32_t SavedCongestionWindow =
+        SavedState != NULL ? SavedState->CongestionWindow : 0;
 
     *Ticket = NULL;
     *TicketLength = 0;
@@ -2208,7 +2629,9 @@ QuicCryptoEncodeServerTicket(
         QuicVarIntSize(AppDataLength) +
         AlpnLength +
         EncodedTPLength +
-        AppDataLength);
+        AppDataLength +
+        QuicVarIntSize(SavedRtt) +
+        QuicVarIntSize(SavedCongestionWindow));
 
     TicketBuffer = CXPLAT_ALLOC_NONPAGED(TotalTicketLength, QUIC_POOL_SERVER_CRYPTO_TICKET);
     if (TicketBuffer == NULL) {
@@ -2231,6 +2654,8 @@ QuicCryptoEncodeServerTicket(
     //   Negotiated ALPN [...]
     //   Transport Parameters [...]
     //   App Ticket (omitted if length is zero) [...]
+    //   Saved RTT in microseconds, 0 if none (QUIC_VAR_INT) [1..8]
+    //   Saved Congestion Window in bytes, 0 if none (QUIC_VAR_INT) [1..8]
     //
 
     _Analysis_assume_(sizeof(*TicketBuffer) >= 8);
@@ -2248,6 +2673,8 @@ QuicCryptoEncodeServerTicket(
         CxPlatCopyMemory(TicketCursor, AppResumptionData, AppDataLength);
         TicketCursor += AppDataLength;
     }
+    TicketCursor = QuicVarIntEncode(SavedRtt, TicketCursor);
+    TicketCursor = QuicVarIntEncode(SavedCongestionWindow, TicketCursor);
     CXPLAT_DBG_ASSERT(TicketCursor == TicketBuffer + TotalTicketLength);
 
     *Ticket = TicketBuffer;
@@ -2275,15 +2702,20 @@ QuicCryptoDecodeServerTicket(
     _Inout_ QUIC_TRANSPORT_PARAMETERS* DecodedTP,
     _Outptr_result_buffer_maybenull_(*AppDataLength)
         const uint8_t** AppData,
-    _Out_ uint32_t* AppDataLength
+    _Out_ uint32_t* AppDataLength,
+    _Out_opt_ QUIC_CONGESTION_CONTROL_SAVED_STATE* SavedState
     )
 {
     QUIC_STATUS Status = QUIC_STATUS_INVALID_PARAMETER;
     uint16_t Offset = 0;
     QUIC_VAR_INT TicketVersion = 0, AlpnLength = 0, TPLength = 0, AppTicketLength = 0;
+    QUIC_VAR_INT SavedRtt = 0, SavedCongestionWindow = 0;
 
     *AppData = NULL;
     *AppDataLength = 0;
+    if (SavedState != NULL) {
+        CxPlatZeroMemory(SavedState, sizeof(*SavedState));
+    }
 
     if (!QuicVarIntDecode(TicketLength, Ticket, &Offset, &TicketVersion)) {
         QuicTraceEvent(
@@ -2393,11 +2825,38 @@ QuicCryptoDecodeServerTicket(
     }
     Offset += (uint16_t)TPLength;
 
-    if (TicketLength == Offset + AppTicketLength) {
+    if (TicketLength < Offset + AppTicketLength) {
+        QuicTraceEvent(
+            ConnError,
+            "[conn][%p] ERROR, %s.",
+            Connection,
+            "Resumption Ticket app data length corrupt");
+        goto Error;
+    }
+    const uint8_t* AppTicket = Ticket + Offset;
+    Offset += (uint16_t)AppTicketLength;
+
+    if (!QuicVarIntDecode(TicketLength, Ticket, &Offset, &SavedRtt) ||
+        !QuicVarIntDecode(TicketLength, Ticket, &Offset, &SavedCongestionWindow) ||
+        SavedRtt > UINT32_MAX ||
+        SavedCongestionWindow > UINT32_MAX) {
+        QuicTraceEvent(
+            ConnError,
+            "[conn][%p] ERROR, %s.",
+            Connection,
+            "Resumption Ticket saved path state failed to decode");
+        goto Error;
+    }
+
+    if (TicketLength == Offset) {
         Status = QUIC_STATUS_SUCCESS;
         *AppDataLength = (uint32_t)AppTicketLength;
         if (AppTicketLength > 0) {
-            *AppData = Ticket + Offset;
+            *AppData = AppTicket;
+        }
+        if (SavedState != NULL) {
+            SavedState->Rtt = (uint32_t)SavedRtt;
+            SavedState->CongestionWindow = (uint32_t)SavedCongestionWindow;
         }
     } else {
         QuicTraceEvent(
@@ -39,6 +39,17 @@ typedef struct QUIC_CRYPTO {
     //
     BOOLEAN CertValidationPending : 1;
 
+    //
+    // Indicates TLS processing is suspended on an async private key operation.
+    //
+    BOOLEAN TlsProcessPending : 1;
+
+    //
+    // Indicates the next 1-RTT key phase's keys still need to be derived, once
+    // the connection is idle.
+    //
+    BOOLEAN NextKeyPhasePending : 1;
+
     //
     // The TLS context for processing handshake messages.
     //
@@ -97,8 +108,21 @@ typedef struct QUIC_CRYPTO {
     //
     BOOLEAN TicketValidationPending : 1;
     BOOLEAN TicketValidationRejecting : 1;
+
+    //
+    // Indicates the ClientRandom has been checked against the 0-RTT
+    // anti-replay filter. A ClientHello sent after a HelloRetryRequest keeps
+    // the same random, so it must not be checked again.
+    //
+    BOOLEAN AntiReplayChecked : 1;
     uint32_t PendingValidationBufferLength;
 
+    //
+    // The random of the ClientHello received by a server, checked against the
+    // 0-RTT anti-replay filter when resuming.
+    //
+    uint8_t ClientRandom[QUIC_CLIENT_RANDOM_LENGTH];
+
     //
     // The offset the current receive encryption level starts.
     //
@@ -179,6 +203,17 @@ QuicCryptoHandshakeConfirmed(
     _In_ BOOLEAN SignalBinding
     );
 
+//
+// Frees the TLS object and the crypto stream's buffers once nothing more is
+// expected to be sent or received on the crypto stream. Any CRYPTO frames
+// received afterwards are ignored.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicCryptoReleaseHandshakeState(
+    _In_ QUIC_CRYPTO* Crypto
+    );
+
 //
 // Cleans up the indicated key type so that it cannot be used for encryption or
 // decryption of packets any more. Returns TRUE if keys were actually discarded
@@ -276,6 +311,16 @@ QuicCryptoCustomCertValidationComplete(
     _In_ QUIC_TLS_ALERT_CODES TlsAlert
     );
 
+//
+// Invoked when TLS processing, suspended on an async private key operation, can
+// be resumed.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicCryptoTlsProcessComplete(
+    _In_ QUIC_CRYPTO* Crypto
+    );
+
 //
 // Invoked when the app has completed its custom resumption ticket validation.
 //
@@ -335,6 +380,16 @@ QuicCryptoGenerateNewKeys(
     _In_ QUIC_CONNECTION* Connection
     );
 
+//
+// Derives the next 1-RTT key phase's keys ahead of time, if the last key
+// update left that pending, so the next key update doesn't have to.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicCryptoPrepareNextKeyPhase(
+    _In_ QUIC_CRYPTO* Crypto
+    );
+
 //
 // Shift 1-RTT keys, freeing the old keys and replacing them with the current
 // keys, replacing the current keys with the new keys; update the start packet
@@ -353,6 +408,7 @@ QuicCryptoUpdateKeyPhase (
 // Encode all state the server needs to resume the connection into a ticket
 // ready to be passed to TLS.
 // The buffer returned in Ticket needs to be freed with CXPLAT_FREE().
+// SavedState is the path state to reuse on resumption; NULL saves none.
 // Note: Connection is only used for logging and may be NULL for testing.
 //
 QUIC_STATUS
@@ -366,6 +422,7 @@ QuicCryptoEncodeServerTicket(
     _In_ uint8_t AlpnLength,
     _In_reads_bytes_(AlpnLength)
         const uint8_t* const NegotiatedAlpn,
+    _In_opt_ const QUIC_CONGESTION_CONTROL_SAVED_STATE* SavedState,
     _Outptr_result_buffer_(*TicketLength)
         uint8_t** Ticket,
     _Out_ uint32_t* TicketLength
@@ -377,6 +434,7 @@ QuicCryptoEncodeServerTicket(
 // AppData contains a pointer to the offset within Ticket, so do not free it.
 // AppData contain NULL if the server application didn't pass any resumption
 // data.
+// SavedState is zeroed if the ticket holds no saved path state.
 // Note: Connection is only used for logging and may be NULL for testing.
 //
 QUIC_STATUS
@@ -390,7 +448,8 @@ QuicCryptoDecodeServerTicket(
     _Inout_ QUIC_TRANSPORT_PARAMETERS* DecodedTP,
     _Outptr_result_buffer_maybenull_(*AppDataLength)
         const uint8_t** AppData,
-    _Out_ uint32_t* AppDataLength
+    _Out_ uint32_t* AppDataLength,
+    _Out_opt_ QUIC_CONGESTION_CONTROL_SAVED_STATE* SavedState
     );
 
 //
@@ -68,6 +68,8 @@ typedef enum eSniNameType {
 #define QUIC_TP_ID_GREASE_QUIC_BIT                          0x2AB2          // N/A
 #define QUIC_TP_ID_RELIABLE_RESET_ENABLED                   0x17f7586d2cb570   // varint
 #define QUIC_TP_ID_ENABLE_TIMESTAMP                         0x7158          // varint
+#define QUIC_TP_ID_DATAGRAM_FEC                             0xFF0FEC        // N/A
+#define QUIC_TP_ID_STREAM_COMPRESSION                       0xFF0C0D        // varint
 
 BOOLEAN
 QuicTpIdIsReserved(
@@ -114,6 +116,99 @@ TlsReadUint24(
 #define TlsTransportParamLength(Id, Length) \
     (QuicVarIntSize(Id) + QuicVarIntSize(Length) + (Length))
 
+//
+// The preferred address is an IPv4 address and port, an IPv6 address and port,
+// a length prefixed CID and a stateless reset token.
+//
+#define QUIC_TP_PREFERRED_ADDRESS_MIN_LENGTH \
+    (4 + 2 + 16 + 2 + 1 + QUIC_STATELESS_RESET_TOKEN_LENGTH)
+
+static
+uint16_t
+TlsPreferredAddressLength(
+    _In_ const QUIC_TRANSPORT_PARAMETERS* TransportParams
+    )
+{
+    return QUIC_TP_PREFERRED_ADDRESS_MIN_LENGTH + TransportParams->PreferredAddressCidLength;
+}
+
+static
+void
+TlsEncodePreferredAddress(
+    _In_ const QUIC_TRANSPORT_PARAMETERS* TransportParams,
+    _Out_writes_bytes_(QUIC_TP_PREFERRED_ADDRESS_MIN_LENGTH + QUIC_MAX_CONNECTION_ID_LENGTH_V1)
+        uint8_t* Buffer
+    )
+{
+    //
+    // Absent addresses are encoded as all zeros. The ports are already in
+    // network byte order.
+    //
+    CxPlatZeroMemory(Buffer, 4 + 2 + 16 + 2);
+    if (QuicAddrGetFamily(&TransportParams->PreferredAddressIpv4) == QUIC_ADDRESS_FAMILY_INET) {
+        CxPlatCopyMemory(Buffer, &TransportParams->PreferredAddressIpv4.Ipv4.sin_addr, 4);
+        CxPlatCopyMemory(Buffer + 4, &TransportParams->PreferredAddressIpv4.Ipv4.sin_port, 2);
+    }
+    Buffer += 4 + 2;
+    if (QuicAddrGetFamily(&TransportParams->PreferredAddressIpv6) == QUIC_ADDRESS_FAMILY_INET6) {
+        CxPlatCopyMemory(Buffer, &TransportParams->PreferredAddressIpv6.Ipv6.sin6_addr, 16);
+        CxPlatCopyMemory(Buffer + 16, &TransportParams->PreferredAddressIpv6.Ipv6.sin6_port, 2);
+    }
+    Buffer += 16 + 2;
+    *Buffer++ = TransportParams->PreferredAddressCidLength;
+    CxPlatCopyMemory(
+        Buffer,
+        TransportParams->PreferredAddressCid,
+        TransportParams->PreferredAddressCidLength);
+    Buffer += TransportParams->PreferredAddressCidLength;
+    CxPlatCopyMemory(
+        Buffer,
+        TransportParams->PreferredAddressResetToken,
+        QUIC_STATELESS_RESET_TOKEN_LENGTH);
+}
+
+static
+BOOLEAN
+TlsDecodePreferredAddress(
+    _In_reads_bytes_(Length) const uint8_t* Buffer,
+    _In_ uint16_t Length,
+    _Inout_ QUIC_TRANSPORT_PARAMETERS* TransportParams
+    )
+{
+    if (Length < QUIC_TP_PREFERRED_ADDRESS_MIN_LENGTH) {
+        return FALSE;
+    }
+    const uint8_t CidLength = Buffer[4 + 2 + 16 + 2];
+    if (CidLength == 0 || // Zero-length CIDs can't be used to migrate.
+        CidLength > QUIC_MAX_CONNECTION_ID_LENGTH_V1 ||
+        Length != QUIC_TP_PREFERRED_ADDRESS_MIN_LENGTH + CidLength) {
+        return FALSE;
+    }
+
+    static const uint8_t Zero[16] = { 0 };
+    CxPlatZeroMemory(&TransportParams->PreferredAddressIpv4, sizeof(QUIC_ADDR));
+    CxPlatZeroMemory(&TransportParams->PreferredAddressIpv6, sizeof(QUIC_ADDR));
+    if (memcmp(Buffer, Zero, 4 + 2) != 0) {
+        QuicAddrSetFamily(&TransportParams->PreferredAddressIpv4, QUIC_ADDRESS_FAMILY_INET);
+        CxPlatCopyMemory(&TransportParams->PreferredAddressIpv4.Ipv4.sin_addr, Buffer, 4);
+        CxPlatCopyMemory(&TransportParams->PreferredAddressIpv4.Ipv4.sin_port, Buffer + 4, 2);
+    }
+    Buffer += 4 + 2;
+    if (memcmp(Buffer, Zero, 16) != 0 || Buffer[16] != 0 || Buffer[17] != 0) {
+        QuicAddrSetFamily(&TransportParams->PreferredAddressIpv6, QUIC_ADDRESS_FAMILY_INET6);
+        CxPlatCopyMemory(&TransportParams->PreferredAddressIpv6.Ipv6.sin6_addr, Buffer, 16);
+        CxPlatCopyMemory(&TransportParams->PreferredAddressIpv6.Ipv6.sin6_port, Buffer + 16, 2);
+    }
+    Buffer += 16 + 2 + 1;
+    TransportParams->PreferredAddressCidLength = CidLength;
+    CxPlatCopyMemory(TransportParams->PreferredAddressCid, Buffer, CidLength);
+    CxPlatCopyMemory(
+        TransportParams->PreferredAddressResetToken,
+        Buffer + CidLength,
+        QUIC_STATELESS_RESET_TOKEN_LENGTH);
+    return TRUE;
+}
+
 static
 uint8_t*
 TlsWriteTransportParam(
@@ -523,6 +618,10 @@ QuicCryptoTlsReadClientHello(
             "Parse error. ReadTlsClientHello #2");
         return QUIC_STATUS_INVALID_PARAMETER;
     }
+    CXPLAT_STATIC_ASSERT(
+        TLS_RANDOM_LENGTH == QUIC_CLIENT_RANDOM_LENGTH,
+        "The whole random is kept for anti-replay");
+    CxPlatCopyMemory(Connection->Crypto.ClientRandom, Buffer, TLS_RANDOM_LENGTH);
     BufferLength -= TLS_RANDOM_LENGTH;
     Buffer += TLS_RANDOM_LENGTH;
 
@@ -715,14 +814,22 @@ QuicCryptoTlsReadClientRandom(
     return QUIC_STATUS_SUCCESS;
 }
 
+//
+// Encodes the transport parameters, followed by SuffixLength bytes of already
+// encoded ones.
+//
 _IRQL_requires_max_(DISPATCH_LEVEL)
 _Success_(return != NULL)
+static
 const uint8_t*
-QuicCryptoTlsEncodeTransportParameters(
+QuicCryptoTlsEncodeTransportParametersWithSuffix(
     _In_opt_ QUIC_CONNECTION* Connection,
     _In_ BOOLEAN IsServerTP,
     _In_ const QUIC_TRANSPORT_PARAMETERS *TransportParams,
     _In_opt_ const QUIC_PRIVATE_TRANSPORT_PARAMETER* TestParam,
+    _In_reads_bytes_opt_(SuffixLength)
+        const uint8_t* Suffix,
+    _In_ uint16_t SuffixLength,
     _Out_ uint32_t* TPLen
     )
 {
@@ -823,7 +930,13 @@ QuicCryptoTlsEncodeTransportParameters(
     }
     if (TransportParams->Flags & QUIC_TP_FLAG_PREFERRED_ADDRESS) {
         CXPLAT_DBG_ASSERT(IsServerTP);
-        CXPLAT_FRE_ASSERT(FALSE); // TODO - Implement
+        CXPLAT_FRE_ASSERT(
+            TransportParams->PreferredAddressCidLength > 0 &&
+            TransportParams->PreferredAddressCidLength <= QUIC_MAX_CONNECTION_ID_LENGTH_V1);
+        RequiredTPLen +=
+            TlsTransportParamLength(
+                QUIC_TP_ID_PREFERRED_ADDRESS,
+                TlsPreferredAddressLength(TransportParams));
     }
     if (TransportParams->Flags & QUIC_TP_FLAG_ACTIVE_CONNECTION_ID_LIMIT) {
         RequiredTPLen +=
@@ -904,12 +1017,25 @@ QuicCryptoTlsEncodeTransportParameters(
                 QUIC_TP_ID_ENABLE_TIMESTAMP,
                 QuicVarIntSize(value));
     }
+    if (TransportParams->Flags & QUIC_TP_FLAG_DATAGRAM_FEC) {
+        RequiredTPLen +=
+            TlsTransportParamLength(
+                QUIC_TP_ID_DATAGRAM_FEC,
+                0);
+    }
+    if (TransportParams->Flags & QUIC_TP_FLAG_STREAM_COMPRESSION) {
+        RequiredTPLen +=
+            TlsTransportParamLength(
+                QUIC_TP_ID_STREAM_COMPRESSION,
+                QuicVarIntSize(TransportParams->StreamCompressionCodecId));
+    }
     if (TestParam != NULL) {
         RequiredTPLen +=
             TlsTransportParamLength(
                 TestParam->Type,
                 TestParam->Length);
     }
+    RequiredTPLen += SuffixLength;
 
     CXPLAT_TEL_ASSERT(RequiredTPLen <= UINT16_MAX);
     if (RequiredTPLen > UINT16_MAX) {
@@ -1095,7 +1221,14 @@ QuicCryptoTlsEncodeTransportParameters(
     }
     if (TransportParams->Flags & QUIC_TP_FLAG_PREFERRED_ADDRESS) {
         CXPLAT_DBG_ASSERT(IsServerTP);
-        CXPLAT_FRE_ASSERT(FALSE); // TODO - Implement
+        uint8_t PreferredAddress[QUIC_TP_PREFERRED_ADDRESS_MIN_LENGTH + QUIC_MAX_CONNECTION_ID_LENGTH_V1];
+        TlsEncodePreferredAddress(TransportParams, PreferredAddress);
+        TPBuf =
+            TlsWriteTransportParam(
+                QUIC_TP_ID_PREFERRED_ADDRESS,
+                TlsPreferredAddressLength(TransportParams),
+                PreferredAddress,
+                TPBuf);
         QuicTraceLogConnVerbose(
             EncodeTPPreferredAddress,
             Connection,
@@ -1246,6 +1379,29 @@ QuicCryptoTlsEncodeTransportParameters(
             "TP: Timestamp (%u)",
             value);
     }
+    if (TransportParams->Flags & QUIC_TP_FLAG_DATAGRAM_FEC) {
+        TPBuf =
+            TlsWriteTransportParam(
+                QUIC_TP_ID_DATAGRAM_FEC,
+                0,
+                NULL,
+                TPBuf);
+        QuicTraceLogConnVerbose(
+            EncodeTPDatagramFec,
+            Connection,
+            "TP: Datagram FEC");
+    }
+    if (TransportParams->Flags & QUIC_TP_FLAG_STREAM_COMPRESSION) {
+        TPBuf =
+            TlsWriteTransportParamVarInt(
+                QUIC_TP_ID_STREAM_COMPRESSION,
+                TransportParams->StreamCompressionCodecId, TPBuf);
+        QuicTraceLogConnVerbose(
+            EncodeTPStreamCompression,
+            Connection,
+            "TP: Stream Compression (codec %llu)",
+            TransportParams->StreamCompressionCodecId);
+    }
     if (TestParam != NULL) {
         TPBuf =
             TlsWriteTransportParam(
@@ -1260,6 +1416,10 @@ QuicCryptoTlsEncodeTransportParameters(
             TestParam->Type,
             TestParam->Length);
     }
+    if (SuffixLength != 0) {
+        CxPlatCopyMemory(TPBuf, Suffix, SuffixLength);
+        TPBuf += SuffixLength;
+    }
 
     size_t FinalTPLength = (TPBuf - (TPBufBase + CxPlatTlsTPHeaderSize));
     if (FinalTPLength != RequiredTPLen) {
@@ -1281,6 +1441,181 @@ QuicCryptoTlsEncodeTransportParameters(
     return TPBufBase;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Success_(return != NULL)
+const uint8_t*
+QuicCryptoTlsEncodeTransportParameters(
+    _In_opt_ QUIC_CONNECTION* Connection,
+    _In_ BOOLEAN IsServerTP,
+    _In_ const QUIC_TRANSPORT_PARAMETERS *TransportParams,
+    _In_opt_ const QUIC_PRIVATE_TRANSPORT_PARAMETER* TestParam,
+    _Out_ uint32_t* TPLen
+    )
+{
+    return
+        QuicCryptoTlsEncodeTransportParametersWithSuffix(
+            Connection, IsServerTP, TransportParams, TestParam, NULL, 0, TPLen);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicTpCacheInitialize(
+    _Out_ QUIC_TP_CACHE* Cache
+    )
+{
+    CxPlatZeroMemory(Cache, sizeof(*Cache));
+    CxPlatDispatchLockInitialize(&Cache->Lock);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicTpCacheUninitialize(
+    _In_ QUIC_TP_CACHE* Cache
+    )
+{
+    if (Cache->Buffer != NULL) {
+        CXPLAT_FREE(Cache->Buffer, QUIC_POOL_TLS_TRANSPARAMS);
+        Cache->Buffer = NULL;
+    }
+    QuicCryptoTlsCleanupTransportParameters(&Cache->Key);
+    CxPlatDispatchLockUninitialize(&Cache->Lock);
+}
+
+//
+// Copies the parameters shared by all connections into Shared, zeroing the
+// per-connection ones so that equal inputs compare equal byte for byte.
+// VersionInfo is borrowed from TransportParams.
+//
+static
+void
+QuicTpCacheMakeKey(
+    _In_ const QUIC_TRANSPORT_PARAMETERS* TransportParams,
+    _Out_ QUIC_TRANSPORT_PARAMETERS* Shared
+    )
+{
+    CxPlatZeroMemory(Shared, sizeof(*Shared));
+    Shared->Flags = TransportParams->Flags & ~QUIC_TP_FLAGS_PER_CONNECTION;
+    Shared->IdleTimeout = TransportParams->IdleTimeout;
+    Shared->InitialMaxData = TransportParams->InitialMaxData;
+    Shared->InitialMaxStreamDataBidiLocal = TransportParams->InitialMaxStreamDataBidiLocal;
+    Shared->InitialMaxStreamDataBidiRemote = TransportParams->InitialMaxStreamDataBidiRemote;
+    Shared->InitialMaxStreamDataUni = TransportParams->InitialMaxStreamDataUni;
+    Shared->InitialMaxBidiStreams = TransportParams->InitialMaxBidiStreams;
+    Shared->InitialMaxUniStreams = TransportParams->InitialMaxUniStreams;
+    Shared->MaxUdpPayloadSize = TransportParams->MaxUdpPayloadSize;
+    Shared->AckDelayExponent = TransportParams->AckDelayExponent;
+    Shared->MaxAckDelay = TransportParams->MaxAckDelay;
+    Shared->MinAckDelay = TransportParams->MinAckDelay;
+    Shared->ActiveConnectionIdLimit = TransportParams->ActiveConnectionIdLimit;
+    Shared->MaxDatagramFrameSize = TransportParams->MaxDatagramFrameSize;
+    Shared->CibirLength = TransportParams->CibirLength;
+    Shared->CibirOffset = TransportParams->CibirOffset;
+    Shared->StreamCompressionCodecId = TransportParams->StreamCompressionCodecId;
+    Shared->VersionInfoLength = TransportParams->VersionInfoLength;
+    Shared->VersionInfo = TransportParams->VersionInfo;
+}
+
+static
+BOOLEAN
+QuicTpCacheMatches(
+    _In_ const QUIC_TP_CACHE* Cache,
+    _In_ const QUIC_TRANSPORT_PARAMETERS* Shared
+    )
+{
+    if (Cache->Buffer == NULL) {
+        return FALSE;
+    }
+    QUIC_TRANSPORT_PARAMETERS Key = Cache->Key;
+    Key.VersionInfo = Shared->VersionInfo; // Compared by content below.
+    if (memcmp(&Key, Shared, sizeof(Key)) != 0) {
+        return FALSE;
+    }
+    return
+        !(Shared->Flags & QUIC_TP_FLAG_VERSION_NEGOTIATION) ||
+        memcmp(Cache->Key.VersionInfo, Shared->VersionInfo, Shared->VersionInfoLength) == 0;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Success_(return != NULL)
+const uint8_t*
+QuicCryptoTlsEncodeServerTransportParametersCached(
+    _In_opt_ QUIC_CONNECTION* Connection,
+    _In_ QUIC_TP_CACHE* Cache,
+    _In_ const QUIC_TRANSPORT_PARAMETERS *TransportParams,
+    _Out_ uint32_t* TPLen
+    )
+{
+    //
+    // Transport parameters may appear in any order, so the per-connection ones
+    // are encoded first and the cached shared ones appended after them.
+    //
+    QUIC_TRANSPORT_PARAMETERS PerConnection = *TransportParams;
+    PerConnection.Flags &= QUIC_TP_FLAGS_PER_CONNECTION;
+
+    QUIC_TRANSPORT_PARAMETERS Shared;
+    QuicTpCacheMakeKey(TransportParams, &Shared);
+
+    const uint8_t* TPBuf = NULL;
+    CxPlatDispatchLockAcquire(&Cache->Lock);
+    if (QuicTpCacheMatches(Cache, &Shared)) {
+        TPBuf =
+            QuicCryptoTlsEncodeTransportParametersWithSuffix(
+                Connection,
+                TRUE,
+                &PerConnection,
+                NULL,
+                Cache->Buffer + CxPlatTlsTPHeaderSize,
+                Cache->Length,
+                TPLen);
+        CxPlatDispatchLockRelease(&Cache->Lock);
+        return TPBuf;
+    }
+    CxPlatDispatchLockRelease(&Cache->Lock);
+
+    uint32_t SharedLength;
+    const uint8_t* SharedBuf =
+        QuicCryptoTlsEncodeTransportParameters(
+            Connection, TRUE, &Shared, NULL, &SharedLength);
+    if (SharedBuf == NULL) {
+        return NULL;
+    }
+
+    TPBuf =
+        QuicCryptoTlsEncodeTransportParametersWithSuffix(
+            Connection,
+            TRUE,
+            &PerConnection,
+            NULL,
+            SharedBuf + CxPlatTlsTPHeaderSize,
+            (uint16_t)(SharedLength - CxPlatTlsTPHeaderSize),
+            TPLen);
+
+    //
+    // Replace the cached entry. If the key can't be copied, the entry is
+    // dropped instead.
+    //
+    QUIC_TRANSPORT_PARAMETERS NewKey;
+    if (QUIC_SUCCEEDED(QuicCryptoTlsCopyTransportParameters(&Shared, &NewKey))) {
+        QUIC_TRANSPORT_PARAMETERS OldKey;
+        CxPlatDispatchLockAcquire(&Cache->Lock);
+        const uint8_t* OldBuf = Cache->Buffer;
+        OldKey = Cache->Key;
+        Cache->Key = NewKey;
+        Cache->Buffer = SharedBuf;
+        Cache->Length = (uint16_t)(SharedLength - CxPlatTlsTPHeaderSize);
+        CxPlatDispatchLockRelease(&Cache->Lock);
+        SharedBuf = OldBuf;
+        QuicCryptoTlsCleanupTransportParameters(&OldKey);
+    } else {
+        QuicCryptoTlsCleanupTransportParameters(&NewKey);
+    }
+    if (SharedBuf != NULL) {
+        CXPLAT_FREE(SharedBuf, QUIC_POOL_TLS_TRANSPARAMS);
+    }
+
+    return TPBuf;
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 _Success_(return != FALSE)
 BOOLEAN
@@ -1691,11 +2026,20 @@ QuicCryptoTlsDecodeTransportParameters( // NOLINT(readability-function-size, goo
                     "Client incorrectly provided preferred address");
                 goto Exit;
             }
+            if (!TlsDecodePreferredAddress(TPBuf + Offset, Length, TransportParams)) {
+                QuicTraceEvent(
+                    ConnErrorStatus,
+                    "[conn][%p] ERROR, %u, %s.",
+                    Connection,
+                    Length,
+                    "Invalid QUIC_TP_ID_PREFERRED_ADDRESS");
+                goto Exit;
+            }
+            TransportParams->Flags |= QUIC_TP_FLAG_PREFERRED_ADDRESS;
             QuicTraceLogConnVerbose(
                 DecodeTPPreferredAddress,
                 Connection,
                 "TP: Preferred Address");
-            // TODO - Implement
             break;
 
         case QUIC_TP_ID_ACTIVE_CONNECTION_ID_LIMIT:
@@ -1953,6 +2297,42 @@ QuicCryptoTlsDecodeTransportParameters( // NOLINT(readability-function-size, goo
             break;
         }
 
+        case QUIC_TP_ID_DATAGRAM_FEC:
+            if (Length != 0) {
+                QuicTraceEvent(
+                    ConnErrorStatus,
+                    "[conn][%p] ERROR, %u, %s.",
+                    Connection,
+                    Length,
+                    "Invalid length of QUIC_TP_ID_DATAGRAM_FEC");
+                goto Exit;
+            }
+            TransportParams->Flags |= QUIC_TP_FLAG_DATAGRAM_FEC;
+            QuicTraceLogConnVerbose(
+                DecodeTPDatagramFec,
+                Connection,
+                "TP: Datagram FEC");
+            break;
+
+        case QUIC_TP_ID_STREAM_COMPRESSION:
+            if (!TRY_READ_VAR_INT(TransportParams->StreamCompressionCodecId) ||
+                TransportParams->StreamCompressionCodecId == 0) {
+                QuicTraceEvent(
+                    ConnErrorStatus,
+                    "[conn][%p] ERROR, %u, %s.",
+                    Connection,
+                    Length,
+                    "Invalid QUIC_TP_ID_STREAM_COMPRESSION");
+                goto Exit;
+            }
+            TransportParams->Flags |= QUIC_TP_FLAG_STREAM_COMPRESSION;
+            QuicTraceLogConnVerbose(
+                DecodeTPStreamCompression,
+                Connection,
+                "TP: Stream Compression (codec %llu)",
+                TransportParams->StreamCompressionCodecId);
+            break;
+
         default:
             if (QuicTpIdIsReserved(Id)) {
                 QuicTraceLogConnWarning(
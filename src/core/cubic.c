@@ -124,6 +124,92 @@ CubicCongestionHyStartResetPerRttRound(
     Cubic->MinRttInCurrentRound = UINT64_MAX;
 }
 
+void
+CubicCongestionCarefulResumeChangeState(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ QUIC_CUBIC_CAREFUL_RESUME_STATE NewState
+    )
+{
+    QUIC_CONGESTION_CONTROL_CUBIC* Cubic = &Cc->Cubic;
+    if (Cubic->CarefulResumeState != NewState) {
+        QuicTraceLogConnInfo(
+            CubicCarefulResumeStateChange,
+            QuicCongestionControlGetConnection(Cc),
+            "Careful Resume: State=%u CongestionWindow=%u PipeSize=%u",
+            NewState,
+            Cubic->CongestionWindow,
+            Cubic->CarefulResumePipeSize);
+        Cubic->CarefulResumeState = NewState;
+    }
+}
+
+//
+// Moves through the Careful Resume phases as ACKs arrive. The saved window is
+// only used once an RTT sample shows the path is similar to the saved one, and
+// the jump is considered validated once all the data sent with it is acked.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CubicCongestionCarefulResumeOnAck(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_ACK_EVENT* AckEvent
+    )
+{
+    QUIC_CONGESTION_CONTROL_CUBIC* Cubic = &Cc->Cubic;
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+
+    switch (Cubic->CarefulResumeState) {
+    case CAREFUL_RESUME_RECONNAISSANCE: {
+        if (!AckEvent->MinRttValid) {
+            break;
+        }
+        const uint64_t SavedRtt = Cubic->CarefulResumeSaved.Rtt;
+        const uint32_t JumpWindow = Cubic->CarefulResumeSaved.CongestionWindow / 2;
+        if (AckEvent->MinRtt < SavedRtt / 2 ||
+            AckEvent->MinRtt > SavedRtt * 10 ||
+            JumpWindow <= Cubic->CongestionWindow) {
+            //
+            // The path doesn't look like the saved one (or the saved window
+            // wouldn't help), so just continue with normal slow start.
+            //
+            CubicCongestionCarefulResumeChangeState(Cc, CAREFUL_RESUME_NORMAL);
+            break;
+        }
+        Cubic->CarefulResumePipeSize = Cubic->CongestionWindow;
+        Cubic->CarefulResumeRoundEnd = Connection->Send.NextPacketNumber;
+        Cubic->CongestionWindow = JumpWindow;
+        if (Cubic->BytesInFlightMax < JumpWindow / 2) {
+            //
+            // Don't let the app-limited clamp undo the jump before there has
+            // been a chance to use it.
+            //
+            Cubic->BytesInFlightMax = JumpWindow / 2;
+        }
+        CubicCongestionCarefulResumeChangeState(Cc, CAREFUL_RESUME_UNVALIDATED);
+        break;
+    }
+    case CAREFUL_RESUME_UNVALIDATED:
+        Cubic->CarefulResumePipeSize += AckEvent->NumRetransmittableBytes;
+        if (AckEvent->LargestAck >= Cubic->CarefulResumeRoundEnd) {
+            //
+            // Data sent with the jumped window is now being acked. Wait for
+            // everything sent so far to be acked before trusting it.
+            //
+            Cubic->CarefulResumeRoundEnd = Connection->Send.NextPacketNumber;
+            CubicCongestionCarefulResumeChangeState(Cc, CAREFUL_RESUME_VALIDATING);
+        }
+        break;
+    case CAREFUL_RESUME_VALIDATING:
+        Cubic->CarefulResumePipeSize += AckEvent->NumRetransmittableBytes;
+        if (AckEvent->LargestAck >= Cubic->CarefulResumeRoundEnd) {
+            CubicCongestionCarefulResumeChangeState(Cc, CAREFUL_RESUME_NORMAL);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 BOOLEAN
 CubicCongestionControlCanSend(
@@ -163,12 +249,14 @@ CubicCongestionControlReset(
     CubicCongestionHyStartChangeState(Cc, HYSTART_NOT_STARTED);
     Cubic->IsInRecovery = FALSE;
     Cubic->HasHadCongestionEvent = FALSE;
+    Cubic->IsPrevStateValid = FALSE;
     Cubic->CongestionWindow = DatagramPayloadLength * Cubic->InitialWindowPackets;
     Cubic->BytesInFlightMax = Cubic->CongestionWindow / 2;
     Cubic->LastSendAllowance = 0;
     if (FullReset) {
         Cubic->BytesInFlight = 0;
     }
+    CubicCongestionCarefulResumeChangeState(Cc, CAREFUL_RESUME_NORMAL);
 
     QuicConnLogOutFlowStats(Connection);
     QuicConnLogCubic(Connection);
@@ -294,7 +382,9 @@ CubicCongestionControlOnCongestionEvent(
     // If the congestion event is not triggered by ECN, save previous state,
     // just in case this ends up being spurious.
     //
+    Cubic->IsPrevStateValid = !Ecn;
     if (!Ecn) {
+        Cubic->PrevHyStartState = Cubic->HyStartState;
         Cubic->PrevWindowPrior = Cubic->WindowPrior;
         Cubic->PrevWindowMax = Cubic->WindowMax;
         Cubic->PrevWindowLastMax = Cubic->WindowLastMax;
@@ -365,6 +455,32 @@ CubicCongestionControlOnCongestionEvent(
                 (uint32_t)DatagramPayloadLength * QUIC_PERSISTENT_CONGESTION_WINDOW_PACKETS,
                 Cubic->CongestionWindow * TEN_TIMES_BETA_CUBIC / 10);
     }
+
+    if (Cubic->CarefulResumeState == CAREFUL_RESUME_UNVALIDATED ||
+        Cubic->CarefulResumeState == CAREFUL_RESUME_VALIDATING) {
+        //
+        // Congestion while the saved window is in use: the saved state was
+        // wrong for this path. Fall back to half of what was actually
+        // delivered, rather than a fraction of the jumped window.
+        //
+        const uint32_t RetreatWindow =
+            CXPLAT_MAX(
+                (uint32_t)DatagramPayloadLength * QUIC_PERSISTENT_CONGESTION_WINDOW_PACKETS,
+                Cubic->CarefulResumePipeSize / 2);
+        if (!IsPersistentCongestion && RetreatWindow < Cubic->CongestionWindow) {
+            Cubic->WindowPrior =
+            Cubic->WindowMax =
+            Cubic->WindowLastMax =
+            Cubic->SlowStartThreshold =
+            Cubic->CongestionWindow =
+            Cubic->AimdWindow =
+                RetreatWindow;
+            Cubic->KCubic = 0;
+        }
+        CubicCongestionCarefulResumeChangeState(Cc, CAREFUL_RESUME_SAFE_RETREAT);
+    } else if (Cubic->CarefulResumeState == CAREFUL_RESUME_RECONNAISSANCE) {
+        CubicCongestionCarefulResumeChangeState(Cc, CAREFUL_RESUME_NORMAL);
+    }
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -445,12 +561,19 @@ CubicCongestionControlOnDataAcknowledged(
             Cubic->IsInRecovery = FALSE;
             Cubic->IsInPersistentCongestion = FALSE;
             Cubic->TimeOfCongAvoidStart = TimeNowUs;
+            if (Cubic->CarefulResumeState == CAREFUL_RESUME_SAFE_RETREAT) {
+                CubicCongestionCarefulResumeChangeState(Cc, CAREFUL_RESUME_NORMAL);
+            }
         }
         goto Exit;
     } else if (BytesAcked == 0) {
         goto Exit;
     }
 
+    if (Cubic->CarefulResumeState != CAREFUL_RESUME_NORMAL) {
+        CubicCongestionCarefulResumeOnAck(Cc, AckEvent);
+    }
+
     //
     // Update HyStart++ RTT sample.
     //
@@ -671,27 +794,11 @@ Exit:
     Cubic->TimeOfLastAckValid = TRUE;
 
     if (Connection->Settings.NetStatsEventEnabled) {
-        const QUIC_PATH* Path = &Connection->Paths[0];
-        QUIC_CONNECTION_EVENT Event;
-        Event.Type = QUIC_CONNECTION_EVENT_NETWORK_STATISTICS;
-        Event.NETWORK_STATISTICS.BytesInFlight = Cubic->BytesInFlight;
-        Event.NETWORK_STATISTICS.PostedBytes = Connection->SendBuffer.PostedBytes;
-        Event.NETWORK_STATISTICS.IdealBytes = Connection->SendBuffer.IdealBytes;
-        Event.NETWORK_STATISTICS.SmoothedRTT = Path->SmoothedRtt;
-        Event.NETWORK_STATISTICS.CongestionWindow = Cubic->CongestionWindow;
-        Event.NETWORK_STATISTICS.Bandwidth = Cubic->CongestionWindow / Path->SmoothedRtt;
-
-        QuicTraceLogConnVerbose(
-           IndicateDataAcked,
-           Connection,
-           "Indicating QUIC_CONNECTION_EVENT_NETWORK_STATISTICS [BytesInFlight=%u,PostedBytes=%llu,IdealBytes=%llu,SmoothedRTT=%llu,CongestionWindow=%u,Bandwidth=%llu]",
-           Event.NETWORK_STATISTICS.BytesInFlight,
-           Event.NETWORK_STATISTICS.PostedBytes,
-           Event.NETWORK_STATISTICS.IdealBytes,
-           Event.NETWORK_STATISTICS.SmoothedRTT,
-           Event.NETWORK_STATISTICS.CongestionWindow,
-           Event.NETWORK_STATISTICS.Bandwidth);
-       QuicConnIndicateEvent(Connection, &Event);
+        QuicCongestionControlIndicateNetworkStatistics(
+            Cc,
+            Cubic->BytesInFlight,
+            Cubic->CongestionWindow,
+            Cubic->CongestionWindow / Connection->Paths[0].SmoothedRtt);
     }
 
     return CubicCongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
@@ -764,6 +871,24 @@ CubicCongestionControlOnEcn(
     QuicConnLogCubic(QuicCongestionControlGetConnection(Cc));
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CubicCongestionControlSetSavedState(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_CONGESTION_CONTROL_SAVED_STATE* SavedState
+    )
+{
+    QUIC_CONGESTION_CONTROL_CUBIC* Cubic = &Cc->Cubic;
+
+    if (SavedState->Rtt == 0 || SavedState->CongestionWindow == 0 ||
+        Cubic->HasHadCongestionEvent) {
+        return;
+    }
+
+    Cubic->CarefulResumeSaved = *SavedState;
+    CubicCongestionCarefulResumeChangeState(Cc, CAREFUL_RESUME_RECONNAISSANCE);
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 BOOLEAN
 CubicCongestionControlOnSpuriousCongestionEvent(
@@ -772,7 +897,11 @@ CubicCongestionControlOnSpuriousCongestionEvent(
 {
     QUIC_CONGESTION_CONTROL_CUBIC* Cubic = &Cc->Cubic;
 
-    if (!Cubic->IsInRecovery) {
+    //
+    // The late ACKs proving the loss spurious may arrive after recovery has
+    // already ended, so rely on the saved state rather than IsInRecovery.
+    //
+    if (!Cubic->IsPrevStateValid) {
         return FALSE;
     }
 
@@ -785,18 +914,30 @@ CubicCongestionControlOnSpuriousCongestionEvent(
         Connection);
 
     //
-    // Revert to previous state.
+    // Revert to previous state. If the window already grew back past the
+    // saved one (recovery ended), keep the larger window.
     //
     Cubic->WindowPrior = Cubic->PrevWindowPrior;
     Cubic->WindowMax = Cubic->PrevWindowMax;
     Cubic->WindowLastMax = Cubic->PrevWindowLastMax;
     Cubic->KCubic = Cubic->PrevKCubic;
     Cubic->SlowStartThreshold = Cubic->PrevSlowStartThreshold;
-    Cubic->CongestionWindow = Cubic->PrevCongestionWindow;
-    Cubic->AimdWindow = Cubic->PrevAimdWindow;
+    Cubic->CongestionWindow = CXPLAT_MAX(Cubic->CongestionWindow, Cubic->PrevCongestionWindow);
+    Cubic->AimdWindow = CXPLAT_MAX(Cubic->AimdWindow, Cubic->PrevAimdWindow);
+
+    //
+    // If the loss ended slow start, resume it. HyStart restarts its RTT
+    // sampling rather than resuming a conservative slow start mid-round.
+    //
+    if (Cubic->PrevHyStartState != HYSTART_DONE) {
+        CubicCongestionHyStartResetPerRttRound(Cubic);
+        Cubic->HyStartRoundEnd = Connection->Send.NextPacketNumber;
+        CubicCongestionHyStartChangeState(Cc, HYSTART_NOT_STARTED);
+    }
 
     Cubic->IsInRecovery = FALSE;
     Cubic->HasHadCongestionEvent = FALSE;
+    Cubic->IsPrevStateValid = FALSE;
 
     BOOLEAN Result = CubicCongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
     QuicConnLogCubic(Connection);
@@ -851,6 +992,15 @@ CubicCongestionControlGetCongestionWindow(
     return Cc->Cubic.CongestionWindow;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+CubicCongestionControlIsInRecovery(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    return Cc->Cubic.IsInRecovery;
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 BOOLEAN
 CubicCongestionControlIsAppLimited(
@@ -882,12 +1032,14 @@ static const QUIC_CONGESTION_CONTROL QuicCongestionControlCubic = {
     .QuicCongestionControlOnDataLost = CubicCongestionControlOnDataLost,
     .QuicCongestionControlOnEcn = CubicCongestionControlOnEcn,
     .QuicCongestionControlOnSpuriousCongestionEvent = CubicCongestionControlOnSpuriousCongestionEvent,
+    .QuicCongestionControlSetSavedState = CubicCongestionControlSetSavedState,
     .QuicCongestionControlLogOutFlowStatus = CubicCongestionControlLogOutFlowStatus,
     .QuicCongestionControlGetExemptions = CubicCongestionControlGetExemptions,
     .QuicCongestionControlGetBytesInFlightMax = CubicCongestionControlGetBytesInFlightMax,
     .QuicCongestionControlIsAppLimited = CubicCongestionControlIsAppLimited,
     .QuicCongestionControlSetAppLimited = CubicCongestionControlSetAppLimited,
     .QuicCongestionControlGetCongestionWindow = CubicCongestionControlGetCongestionWindow,
+    .QuicCongestionControlIsInRecovery = CubicCongestionControlIsInRecovery,
 };
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -13,6 +13,19 @@ typedef enum QUIC_CUBIC_HYSTART_STATE {
     HYSTART_DONE = 2
 } QUIC_CUBIC_HYSTART_STATE;
 
+//
+// Careful Resume phases (draft-ietf-tsvwg-careful-resume). The saved path
+// state is only used after the current RTT has been confirmed to be close to
+// the saved one, and the jump is undone if it leads to loss.
+//
+typedef enum QUIC_CUBIC_CAREFUL_RESUME_STATE {
+    CAREFUL_RESUME_NORMAL = 0,          // Not in use, or finished.
+    CAREFUL_RESUME_RECONNAISSANCE = 1,  // Waiting for an RTT sample.
+    CAREFUL_RESUME_UNVALIDATED = 2,     // Window jumped; jump not yet acked.
+    CAREFUL_RESUME_VALIDATING = 3,      // Waiting for the jump to be acked.
+    CAREFUL_RESUME_SAFE_RETREAT = 4     // Loss during the jump; window reduced.
+} QUIC_CUBIC_CAREFUL_RESUME_STATE;
+
 typedef struct QUIC_CONGESTION_CONTROL_CUBIC {
 
     //
@@ -38,6 +51,12 @@ typedef struct QUIC_CONGESTION_CONTROL_CUBIC {
     //
     BOOLEAN TimeOfLastAckValid : 1;
 
+    //
+    // TRUE if the Prev* state was saved by the last congestion event and can
+    // be restored if that event turns out to be spurious.
+    //
+    BOOLEAN IsPrevStateValid : 1;
+
     //
     // The size of the initial congestion window, in packets.
     //
@@ -95,6 +114,7 @@ typedef struct QUIC_CONGESTION_CONTROL_CUBIC {
     // HyStart state.
     //
     QUIC_CUBIC_HYSTART_STATE HyStartState;
+    QUIC_CUBIC_HYSTART_STATE PrevHyStartState;
     uint32_t HyStartAckCount;
     uint64_t MinRttInLastRound; // microseconds
     uint64_t MinRttInCurrentRound; // microseconds
@@ -103,6 +123,14 @@ typedef struct QUIC_CONGESTION_CONTROL_CUBIC {
     uint32_t CWndSlowStartGrowthDivisor;
     uint32_t ConservativeSlowStartRounds;
 
+    //
+    // Careful Resume state.
+    //
+    QUIC_CUBIC_CAREFUL_RESUME_STATE CarefulResumeState;
+    QUIC_CONGESTION_CONTROL_SAVED_STATE CarefulResumeSaved;
+    uint32_t CarefulResumePipeSize; // bytes acked since the jump
+    uint64_t CarefulResumeRoundEnd; // Packet Number
+
     //
     // This variable tracks the largest packet that was outstanding at the time
     // the last congestion event occurred. An ACK for any packet number greater
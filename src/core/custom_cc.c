@@ -0,0 +1,414 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Adapter for a congestion control algorithm provided by the application
+    (QUIC_PARAM_CONN_CUSTOM_CONGESTION_CONTROL).
+
+    Bytes in flight, exemptions and the blocked state are tracked here, the
+    same as for the built-in algorithms. The application only computes the
+    congestion window (and optionally the pacing allowance) from the events
+    it is given.
+
+--*/
+
+#include "precomp.h"
+#ifdef QUIC_CLOG
+#include "custom_cc.c.clog.h"
+#endif
+
+#include "custom_cc.h"
+
+//
+// Applies a congestion window returned by the application. The window is kept
+// at or above the persistent congestion window so that the connection can
+// always make progress.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CustomCongestionControlSetWindow(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint32_t CongestionWindow
+    )
+{
+    const QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    const uint32_t MinimumWindow =
+        (uint32_t)QuicPathGetDatagramPayloadSize(&Connection->Paths[0]) *
+        QUIC_PERSISTENT_CONGESTION_WINDOW_PACKETS;
+    Cc->Custom.CongestionWindow = CXPLAT_MAX(CongestionWindow, MinimumWindow);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+CustomCongestionControlCanSend(
+    _In_ QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    QUIC_CONGESTION_CONTROL_CUSTOM* Custom = &Cc->Custom;
+    return Custom->BytesInFlight < Custom->CongestionWindow || Custom->Exemptions > 0;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CustomCongestionControlSetExemption(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint8_t NumPackets
+    )
+{
+    Cc->Custom.Exemptions = NumPackets;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CustomCongestionControlReset(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ BOOLEAN FullReset
+    )
+{
+    QUIC_CONGESTION_CONTROL_CUSTOM* Custom = &Cc->Custom;
+
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    CustomCongestionControlSetWindow(
+        Cc,
+        Custom->Callbacks.Reset(
+            Custom->Callbacks.Context,
+            FullReset,
+            QuicPathGetDatagramPayloadSize(&Connection->Paths[0])));
+    Custom->BytesInFlightMax = Custom->CongestionWindow / 2;
+    if (FullReset) {
+        Custom->BytesInFlight = 0;
+    }
+
+    QuicConnLogOutFlowStats(Connection);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+CustomCongestionControlGetSendAllowance(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint64_t TimeSinceLastSend, // microsec
+    _In_ BOOLEAN TimeSinceLastSendValid
+    )
+{
+    QUIC_CONGESTION_CONTROL_CUSTOM* Custom = &Cc->Custom;
+
+    if (Custom->BytesInFlight >= Custom->CongestionWindow) {
+        //
+        // We are CC blocked, so we can't send anything.
+        //
+        return 0;
+    }
+
+    const uint32_t WindowAllowance = Custom->CongestionWindow - Custom->BytesInFlight;
+    if (Custom->Callbacks.GetSendAllowance == NULL ||
+        !QuicCongestionControlGetConnection(Cc)->Settings.PacingEnabled) {
+        return WindowAllowance;
+    }
+
+    const uint32_t SendAllowance =
+        Custom->Callbacks.GetSendAllowance(
+            Custom->Callbacks.Context,
+            TimeSinceLastSend,
+            TimeSinceLastSendValid,
+            Custom->BytesInFlight);
+    return CXPLAT_MIN(SendAllowance, WindowAllowance);
+}
+
+//
+// Returns TRUE if we became unblocked.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+CustomCongestionControlUpdateBlockedState(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ BOOLEAN PreviousCanSendState
+    )
+{
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    QuicConnLogOutFlowStats(Connection);
+    if (PreviousCanSendState != CustomCongestionControlCanSend(Cc)) {
+        if (PreviousCanSendState) {
+            QuicConnAddOutFlowBlockedReason(
+                Connection, QUIC_FLOW_BLOCKED_CONGESTION_CONTROL);
+        } else {
+            QuicConnRemoveOutFlowBlockedReason(
+                Connection, QUIC_FLOW_BLOCKED_CONGESTION_CONTROL);
+            Connection->Send.LastFlushTime = CxPlatTimeUs64(); // Reset last flush time
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CustomCongestionControlOnDataSent(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint32_t NumRetransmittableBytes
+    )
+{
+    QUIC_CONGESTION_CONTROL_CUSTOM* Custom = &Cc->Custom;
+
+    BOOLEAN PreviousCanSendState = CustomCongestionControlCanSend(Cc);
+
+    Custom->BytesInFlight += NumRetransmittableBytes;
+    if (Custom->BytesInFlightMax < Custom->BytesInFlight) {
+        Custom->BytesInFlightMax = Custom->BytesInFlight;
+        QuicSendBufferConnectionAdjust(QuicCongestionControlGetConnection(Cc));
+    }
+
+    if (Custom->Exemptions > 0) {
+        --Custom->Exemptions;
+    }
+
+    if (Custom->Callbacks.OnDataSent != NULL) {
+        Custom->Callbacks.OnDataSent(
+            Custom->Callbacks.Context,
+            NumRetransmittableBytes,
+            Custom->BytesInFlight);
+    }
+
+    CustomCongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+CustomCongestionControlOnDataInvalidated(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint32_t NumRetransmittableBytes
+    )
+{
+    QUIC_CONGESTION_CONTROL_CUSTOM* Custom = &Cc->Custom;
+
+    BOOLEAN PreviousCanSendState = CustomCongestionControlCanSend(Cc);
+
+    CXPLAT_DBG_ASSERT(Custom->BytesInFlight >= NumRetransmittableBytes);
+    Custom->BytesInFlight -= NumRetransmittableBytes;
+
+    return CustomCongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+CustomCongestionControlOnDataAcknowledged(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_ACK_EVENT* AckEvent
+    )
+{
+    QUIC_CONGESTION_CONTROL_CUSTOM* Custom = &Cc->Custom;
+
+    BOOLEAN PreviousCanSendState = CustomCongestionControlCanSend(Cc);
+
+    CXPLAT_DBG_ASSERT(Custom->BytesInFlight >= AckEvent->NumRetransmittableBytes);
+    Custom->BytesInFlight -= AckEvent->NumRetransmittableBytes;
+
+    QUIC_CUSTOM_CC_ACK_EVENT Event;
+    Event.TimeNow = AckEvent->TimeNow;
+    Event.LargestAck = AckEvent->LargestAck;
+    Event.LargestSentPacketNumber = AckEvent->LargestSentPacketNumber;
+    Event.SmoothedRtt = AckEvent->SmoothedRtt;
+    Event.MinRtt = AckEvent->MinRtt;
+    Event.NumRetransmittableBytes = AckEvent->NumRetransmittableBytes;
+    Event.BytesInFlight = Custom->BytesInFlight;
+    Event.IsImplicit = AckEvent->IsImplicit;
+    Event.HasLoss = AckEvent->HasLoss;
+    Event.IsLargestAckedPacketAppLimited = AckEvent->IsLargestAckedPacketAppLimited;
+    Event.MinRttValid = AckEvent->MinRttValid;
+
+    CustomCongestionControlSetWindow(
+        Cc,
+        Custom->Callbacks.OnDataAcknowledged(Custom->Callbacks.Context, &Event));
+
+    return CustomCongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CustomCongestionControlOnDataLost(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_LOSS_EVENT* LossEvent
+    )
+{
+    QUIC_CONGESTION_CONTROL_CUSTOM* Custom = &Cc->Custom;
+
+    BOOLEAN PreviousCanSendState = CustomCongestionControlCanSend(Cc);
+
+    CXPLAT_DBG_ASSERT(Custom->BytesInFlight >= LossEvent->NumRetransmittableBytes);
+    Custom->BytesInFlight -= LossEvent->NumRetransmittableBytes;
+
+    QUIC_CUSTOM_CC_LOSS_EVENT Event;
+    Event.LargestPacketNumberLost = LossEvent->LargestPacketNumberLost;
+    Event.LargestSentPacketNumber = LossEvent->LargestSentPacketNumber;
+    Event.NumRetransmittableBytes = LossEvent->NumRetransmittableBytes;
+    Event.BytesInFlight = Custom->BytesInFlight;
+    Event.PersistentCongestion = LossEvent->PersistentCongestion;
+
+    CustomCongestionControlSetWindow(
+        Cc,
+        Custom->Callbacks.OnDataLost(Custom->Callbacks.Context, &Event));
+
+    CustomCongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CustomCongestionControlOnEcn(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_ECN_EVENT* EcnEvent
+    )
+{
+    QUIC_CONGESTION_CONTROL_CUSTOM* Custom = &Cc->Custom;
+
+    if (Custom->Callbacks.OnEcn == NULL) {
+        return;
+    }
+
+    BOOLEAN PreviousCanSendState = CustomCongestionControlCanSend(Cc);
+
+    QUIC_CUSTOM_CC_ECN_EVENT Event;
+    Event.LargestPacketNumberAcked = EcnEvent->LargestPacketNumberAcked;
+    Event.LargestSentPacketNumber = EcnEvent->LargestSentPacketNumber;
+    Event.NewCeCount = EcnEvent->NewCeCount;
+
+    CustomCongestionControlSetWindow(
+        Cc,
+        Custom->Callbacks.OnEcn(Custom->Callbacks.Context, &Event));
+
+    CustomCongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+CustomCongestionControlOnSpuriousCongestionEvent(
+    _In_ QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    //
+    // Spurious loss detection isn't exposed to the application.
+    //
+    UNREFERENCED_PARAMETER(Cc);
+    return FALSE;
+}
+
+void
+CustomCongestionControlLogOutFlowStatus(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    const QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    const QUIC_PATH* Path = &Connection->Paths[0];
+    const QUIC_CONGESTION_CONTROL_CUSTOM* Custom = &Cc->Custom;
+
+    QuicTraceEvent(
+        ConnOutFlowStatsV2,
+        "[conn][%p] OUT: BytesSent=%llu InFlight=%u CWnd=%u ConnFC=%llu ISB=%llu PostedBytes=%llu SRtt=%llu 1Way=%llu",
+        Connection,
+        Connection->Stats.Send.TotalBytes,
+        Custom->BytesInFlight,
+        Custom->CongestionWindow,
+        Connection->Send.PeerMaxData - Connection->Send.OrderedStreamBytesSent,
+        Connection->SendBuffer.IdealBytes,
+        Connection->SendBuffer.PostedBytes,
+        Path->GotFirstRttSample ? Path->SmoothedRtt : 0,
+        Path->OneWayDelay);
+}
+
+uint32_t
+CustomCongestionControlGetBytesInFlightMax(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    return Cc->Custom.BytesInFlightMax;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint8_t
+CustomCongestionControlGetExemptions(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    return Cc->Custom.Exemptions;
+}
+
+uint32_t
+CustomCongestionControlGetCongestionWindow(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    return Cc->Custom.CongestionWindow;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+CustomCongestionControlIsInRecovery(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    UNREFERENCED_PARAMETER(Cc);
+    return FALSE;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+CustomCongestionControlIsAppLimited(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    UNREFERENCED_PARAMETER(Cc);
+    return FALSE;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CustomCongestionControlSetAppLimited(
+    _In_ struct QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    UNREFERENCED_PARAMETER(Cc);
+}
+
+static const QUIC_CONGESTION_CONTROL QuicCongestionControlCustom = {
+    .Name = "Custom",
+    .QuicCongestionControlCanSend = CustomCongestionControlCanSend,
+    .QuicCongestionControlSetExemption = CustomCongestionControlSetExemption,
+    .QuicCongestionControlReset = CustomCongestionControlReset,
+    .QuicCongestionControlGetSendAllowance = CustomCongestionControlGetSendAllowance,
+    .QuicCongestionControlOnDataSent = CustomCongestionControlOnDataSent,
+    .QuicCongestionControlOnDataInvalidated = CustomCongestionControlOnDataInvalidated,
+    .QuicCongestionControlOnDataAcknowledged = CustomCongestionControlOnDataAcknowledged,
+    .QuicCongestionControlOnDataLost = CustomCongestionControlOnDataLost,
+    .QuicCongestionControlOnEcn = CustomCongestionControlOnEcn,
+    .QuicCongestionControlOnSpuriousCongestionEvent = CustomCongestionControlOnSpuriousCongestionEvent,
+    .QuicCongestionControlLogOutFlowStatus = CustomCongestionControlLogOutFlowStatus,
+    .QuicCongestionControlGetExemptions = CustomCongestionControlGetExemptions,
+    .QuicCongestionControlGetBytesInFlightMax = CustomCongestionControlGetBytesInFlightMax,
+    .QuicCongestionControlIsAppLimited = CustomCongestionControlIsAppLimited,
+    .QuicCongestionControlSetAppLimited = CustomCongestionControlSetAppLimited,
+    .QuicCongestionControlGetCongestionWindow = CustomCongestionControlGetCongestionWindow,
+    .QuicCongestionControlIsInRecovery = CustomCongestionControlIsInRecovery,
+};
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CustomCongestionControlInitialize(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_SETTINGS_INTERNAL* Settings
+    )
+{
+    UNREFERENCED_PARAMETER(Settings);
+
+    const QUIC_CUSTOM_CONGESTION_CONTROL* Callbacks =
+        QuicCongestionControlGetConnection(Cc)->CustomCongestionControl;
+    CXPLAT_DBG_ASSERT(Callbacks != NULL);
+
+    *Cc = QuicCongestionControlCustom;
+    Cc->Custom.Callbacks = *Callbacks;
+    if (Callbacks->Name != NULL) {
+        Cc->Name = Callbacks->Name;
+    }
+
+    CustomCongestionControlReset(Cc, TRUE);
+}
@@ -0,0 +1,41 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+--*/
+
+#pragma once
+
+typedef struct QUIC_CONGESTION_CONTROL_CUSTOM {
+
+    //
+    // The application's callbacks, copied from the connection so that each
+    // event is a single indirect call.
+    //
+    QUIC_CUSTOM_CONGESTION_CONTROL Callbacks;
+
+    //
+    // The congestion window most recently returned by the application.
+    //
+    uint32_t CongestionWindow; // bytes
+
+    //
+    // The number of bytes considered to be still in the network.
+    //
+    uint32_t BytesInFlight;
+    uint32_t BytesInFlightMax;
+
+    //
+    // A count of packets which can be sent ignoring CongestionWindow.
+    //
+    uint8_t Exemptions;
+
+} QUIC_CONGESTION_CONTROL_CUSTOM;
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CustomCongestionControlInitialize(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_SETTINGS_INTERNAL* Settings
+    );
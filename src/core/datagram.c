@@ -23,6 +23,13 @@ Abstract:
     DATAGRAM_FRAME_HEADER_LENGTH \
 )
 
+//
+// The client context of the datagrams the library sends itself (relayed
+// payloads and FEC repairs), which are never indicated to the app.
+//
+static uint8_t QuicDatagramInternalContextTag;
+#define QUIC_DATAGRAM_INTERNAL_CLIENT_CONTEXT ((void*)&QuicDatagramInternalContextTag)
+
 #if DEBUG
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
@@ -39,7 +46,9 @@ QuicDatagramValidate(
         CXPLAT_DBG_ASSERT(Datagram->SendQueue == NULL);
         CXPLAT_DBG_ASSERT((Connection->Send.SendFlags & QUIC_CONN_SEND_FLAG_DATAGRAM) == 0);
     } else if ((Connection->Send.SendFlags & QUIC_CONN_SEND_FLAG_DATAGRAM) != 0) {
-        CXPLAT_DBG_ASSERT(Datagram->SendQueue != NULL);
+        CXPLAT_DBG_ASSERT(
+            Datagram->SendQueue != NULL ||
+            (Datagram->Fec != NULL && Datagram->Fec->RepairPending));
     } else if (Connection->State.PeerTransportParameterValid) {
         CXPLAT_DBG_ASSERT(Datagram->SendQueue == NULL);
     }
@@ -81,7 +90,9 @@ QuicDatagramInitialize(
     Datagram->MaxSendLength = UINT16_MAX;
     Datagram->PrioritySendQueueTail = &Datagram->SendQueue;
     Datagram->SendQueueTail = &Datagram->SendQueue;
+    Datagram->ApiQueueTail = &Datagram->ApiQueue;
     CxPlatDispatchLockInitialize(&Datagram->ApiQueueLock);
+    CxPlatListInitializeHead(&Datagram->Relays);
     QuicDatagramValidate(Datagram);
 }
 
@@ -93,6 +104,10 @@ QuicDatagramIndicateSendStateChange(
     _In_ QUIC_DATAGRAM_SEND_STATE State
     )
 {
+    if (*ClientContext == QUIC_DATAGRAM_INTERNAL_CLIENT_CONTEXT) {
+        return;
+    }
+
     QUIC_CONNECTION_EVENT Event;
     Event.Type = QUIC_CONNECTION_EVENT_DATAGRAM_SEND_STATE_CHANGED;
     Event.DATAGRAM_SEND_STATE_CHANGED.ClientContext = *ClientContext;
@@ -108,6 +123,24 @@ QuicDatagramIndicateSendStateChange(
     *ClientContext = Event.DATAGRAM_SEND_STATE_CHANGED.ClientContext;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+static
+void
+QuicDatagramFreeSendRequest(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ QUIC_SEND_REQUEST* SendRequest
+    )
+{
+    if (SendRequest->Flags & QUIC_SEND_FLAG_DGRAM_RELAY) {
+        QUIC_DATAGRAM_RELAY_SEND* RelaySend =
+            CXPLAT_CONTAINING_RECORD(SendRequest, QUIC_DATAGRAM_RELAY_SEND, Request);
+        CxPlatRecvDataReturn(RelaySend->RecvData);
+        CxPlatPoolFree(&Connection->Worker->DatagramRelaySendPool, RelaySend);
+    } else {
+        CxPlatPoolFree(&Connection->Worker->SendRequestPool, SendRequest);
+    }
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicDatagramCancelSend(
@@ -119,7 +152,7 @@ QuicDatagramCancelSend(
         Connection,
         &SendRequest->ClientContext,
         QUIC_DATAGRAM_SEND_CANCELED);
-    CxPlatPoolFree(&Connection->Worker->SendRequestPool, SendRequest);
+    QuicDatagramFreeSendRequest(Connection, SendRequest);
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -135,7 +168,45 @@ QuicDatagramCompleteSend(
         Connection,
         ClientContext,
         QUIC_DATAGRAM_SEND_SENT);
-    CxPlatPoolFree(&Connection->Worker->SendRequestPool, SendRequest);
+    QuicDatagramFreeSendRequest(Connection, SendRequest);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+static
+void
+QuicDatagramRelayFlush(
+    _In_ QUIC_DATAGRAM_RELAY* Relay
+    )
+{
+    CxPlatSocketSend(Relay->Socket, &Relay->Route, Relay->SendData);
+    Relay->SendData = NULL;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+void
+QuicDatagramRelayDelete(
+    _In_ QUIC_DATAGRAM_RELAY* Relay
+    )
+{
+    QuicTraceLogConnInfo(
+        DatagramRelayRemoved,
+        Relay->Connection,
+        "Datagram relay removed [qsid=%llu] [ctx=%llu]",
+        Relay->QuarterStreamId,
+        Relay->ContextId);
+
+    CxPlatListEntryRemove(&Relay->Link);
+    if (Relay->SendData != NULL) {
+        QuicDatagramRelayFlush(Relay);
+    }
+
+    //
+    // No more receive callbacks once the socket is deleted. Payloads already
+    // queued as sends have their own copy of the prefix.
+    //
+    CxPlatSocketDelete(Relay->Socket);
+    CXPLAT_FREE(Relay, QUIC_POOL_DATAGRAM_RELAY);
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -146,6 +217,14 @@ QuicDatagramUninitialize(
 {
     CXPLAT_DBG_ASSERT(Datagram->SendQueue == NULL);
     CXPLAT_DBG_ASSERT(Datagram->ApiQueue == NULL);
+    CXPLAT_DBG_ASSERT(CxPlatListIsEmpty(&Datagram->Relays));
+    if (Datagram->RecvBatch != NULL) {
+        CXPLAT_DBG_ASSERT(Datagram->RecvBatch->Count == 0);
+        CXPLAT_FREE(Datagram->RecvBatch, QUIC_POOL_DATAGRAM_RECV_BATCH);
+    }
+    if (Datagram->Fec != NULL) {
+        CXPLAT_FREE(Datagram->Fec, QUIC_POOL_DATAGRAM_FEC);
+    }
     CxPlatDispatchLockUninitialize(&Datagram->ApiQueueLock);
 }
 
@@ -155,6 +234,14 @@ QuicDatagramSendShutdown(
     _In_ QUIC_DATAGRAM* Datagram
     )
 {
+    //
+    // Relays go first, so they don't queue any more sends.
+    //
+    while (!CxPlatListIsEmpty(&Datagram->Relays)) {
+        QuicDatagramRelayDelete(
+            CXPLAT_CONTAINING_RECORD(Datagram->Relays.Flink, QUIC_DATAGRAM_RELAY, Link));
+    }
+
     if (!Datagram->SendEnabled) {
         return;
     }
@@ -171,6 +258,7 @@ QuicDatagramSendShutdown(
     Datagram->MaxSendLength = 0;
     QUIC_SEND_REQUEST* ApiQueue = Datagram->ApiQueue;
     Datagram->ApiQueue = NULL;
+    Datagram->ApiQueueTail = &Datagram->ApiQueue;
     CxPlatDispatchLockRelease(&Datagram->ApiQueueLock);
 
     QuicSendClearSendFlag(&Connection->Send, QUIC_CONN_SEND_FLAG_DATAGRAM);
@@ -230,6 +318,55 @@ QuicDatagramOnMaxSendLengthChanged(
     QuicDatagramValidate(Datagram);
 }
 
+//
+// Allocates the FEC state once both endpoints are known to use FEC, or frees
+// it if the peer's final transport parameters don't (after 0-RTT). Returns
+// FALSE on allocation failure, since the peer's datagrams can't be read
+// without it.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+BOOLEAN
+QuicDatagramUpdateFec(
+    _In_ QUIC_DATAGRAM* Datagram
+    )
+{
+    QUIC_CONNECTION* Connection = QuicDatagramGetConnection(Datagram);
+    const BOOLEAN Negotiated =
+        Datagram->FecConfig.MaxBlockSize != 0 &&
+        Connection->State.PeerTransportParameterValid &&
+        !!(Connection->PeerTransportParams.Flags & QUIC_TP_FLAG_DATAGRAM_FEC);
+
+    if (!Negotiated) {
+        if (Datagram->Fec != NULL) {
+            CXPLAT_FREE(Datagram->Fec, QUIC_POOL_DATAGRAM_FEC);
+            Datagram->Fec = NULL;
+        }
+        return TRUE;
+    }
+
+    if (Datagram->Fec == NULL) {
+        Datagram->Fec = CXPLAT_ALLOC_NONPAGED(sizeof(QUIC_DATAGRAM_FEC), QUIC_POOL_DATAGRAM_FEC);
+        if (Datagram->Fec == NULL) {
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "datagram FEC",
+                sizeof(QUIC_DATAGRAM_FEC));
+            return FALSE;
+        }
+        QuicDatagramFecInitialize(Datagram->Fec, &Datagram->FecConfig);
+        QuicTraceLogConnInfo(
+            DatagramFecNegotiated,
+            Connection,
+            "Datagram FEC negotiated, block size %hhu to %hhu",
+            Datagram->FecConfig.MinBlockSize,
+            Datagram->FecConfig.MaxBlockSize);
+    }
+
+    return TRUE;
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicDatagramOnSendStateChanged(
@@ -238,6 +375,11 @@ QuicDatagramOnSendStateChanged(
 {
     QUIC_CONNECTION* Connection = QuicDatagramGetConnection(Datagram);
 
+    if (!QuicDatagramUpdateFec(Datagram)) {
+        QuicConnFatalError(Connection, QUIC_STATUS_OUT_OF_MEMORY, "Datagram FEC allocation");
+        return;
+    }
+
     //
     // Until we receive the peer's transport parameters, we assume that
     // datagrams are enabled, with unlimited max length. This allows for the
@@ -281,6 +423,14 @@ QuicDatagramOnSendStateChanged(
         if (NewMaxSendLength > MtuMaxSendLength) {
             NewMaxSendLength = MtuMaxSendLength;
         }
+        if (Datagram->Fec != NULL) {
+            //
+            // Leave room for the FEC header, and for the repair datagram.
+            //
+            NewMaxSendLength =
+                NewMaxSendLength > QUIC_DATAGRAM_FEC_OVERHEAD ?
+                    NewMaxSendLength - QUIC_DATAGRAM_FEC_OVERHEAD : 0;
+        }
     }
 
     if (SendEnabled == Datagram->SendEnabled) {
@@ -318,18 +468,43 @@ QuicDatagramOnSendStateChanged(
     QuicDatagramValidate(Datagram);
 }
 
+//
+// Queues a chain of one or more send requests (linked by Next) at once. On
+// failure, none of them are queued and all are freed.
+//
 _IRQL_requires_max_(DISPATCH_LEVEL)
 QUIC_STATUS
 QuicDatagramQueueSend(
     _In_ QUIC_DATAGRAM* Datagram,
-    _In_ QUIC_SEND_REQUEST* SendRequest
+    _In_ QUIC_SEND_REQUEST* SendRequests,
+    _In_ QUIC_SEND_REQUEST* LastSendRequest
     )
 {
     QUIC_STATUS Status;
     BOOLEAN QueueOper = TRUE;
-    const BOOLEAN IsPriority = !!(SendRequest->Flags & QUIC_SEND_FLAG_PRIORITY_WORK);
+    const BOOLEAN IsPriority = !!(SendRequests->Flags & QUIC_SEND_FLAG_PRIORITY_WORK);
     QUIC_CONNECTION* Connection = QuicDatagramGetConnection(Datagram);
 
+    CXPLAT_DBG_ASSERT(LastSendRequest->Next == NULL);
+
+    uint64_t TimeNow = 0;
+    for (QUIC_SEND_REQUEST* SendRequest = SendRequests;
+         SendRequest != NULL;
+         SendRequest = SendRequest->Next) {
+        const uint32_t MaxQueueDelay =
+            (SendRequest->Flags & QUIC_SEND_FLAG_DGRAM_PRIORITY) ?
+                Datagram->SendPolicy.PriorityMaxQueueDelayUs :
+                Datagram->SendPolicy.MaxQueueDelayUs;
+        if (MaxQueueDelay != 0) {
+            if (TimeNow == 0) {
+                TimeNow = CxPlatTimeUs64();
+            }
+            SendRequest->Deadline = TimeNow + MaxQueueDelay;
+        } else {
+            SendRequest->Deadline = 0;
+        }
+    }
+
     CxPlatDispatchLockAcquire(&Datagram->ApiQueueLock);
     if (!Datagram->SendEnabled) {
         QuicTraceEvent(
@@ -339,27 +514,38 @@ QuicDatagramQueueSend(
             "Datagram send while disabled");
         Status = QUIC_STATUS_INVALID_STATE;
     } else {
-        if (SendRequest->TotalLength > (uint64_t)Datagram->MaxSendLength) {
-            QuicTraceEvent(
-                ConnError,
-                "[conn][%p] ERROR, %s.",
-                Connection,
-                "Datagram send request is longer than allowed");
-            Status = QUIC_STATUS_INVALID_PARAMETER;
-        } else {
-            QUIC_SEND_REQUEST** ApiQueueTail = &Datagram->ApiQueue;
-            while (*ApiQueueTail != NULL) {
-                ApiQueueTail = &((*ApiQueueTail)->Next);
-                QueueOper = FALSE; // Not necessary if the previous send hasn't been flushed yet.
+        Status = QUIC_STATUS_SUCCESS;
+        for (QUIC_SEND_REQUEST* SendRequest = SendRequests;
+             SendRequest != NULL;
+             SendRequest = SendRequest->Next) {
+            if (SendRequest->TotalLength > (uint64_t)Datagram->MaxSendLength) {
+                QuicTraceEvent(
+                    ConnError,
+                    "[conn][%p] ERROR, %s.",
+                    Connection,
+                    "Datagram send request is longer than allowed");
+                Status = QUIC_STATUS_INVALID_PARAMETER;
+                break;
             }
-            *ApiQueueTail = SendRequest;
-            Status = QUIC_STATUS_SUCCESS;
+        }
+        if (QUIC_SUCCEEDED(Status)) {
+            //
+            // The operation is not necessary if the previous send hasn't been
+            // flushed yet.
+            //
+            QueueOper = Datagram->ApiQueue == NULL;
+            *Datagram->ApiQueueTail = SendRequests;
+            Datagram->ApiQueueTail = &LastSendRequest->Next;
         }
     }
     CxPlatDispatchLockRelease(&Datagram->ApiQueueLock);
 
     if (QUIC_FAILED(Status)) {
-        CxPlatPoolFree(&Connection->Worker->SendRequestPool, SendRequest);
+        while (SendRequests != NULL) {
+            QUIC_SEND_REQUEST* SendRequest = SendRequests;
+            SendRequests = SendRequests->Next;
+            QuicDatagramFreeSendRequest(Connection, SendRequest);
+        }
         goto Exit;
     }
 
@@ -409,6 +595,7 @@ QuicDatagramSendFlush(
     CxPlatDispatchLockAcquire(&Datagram->ApiQueueLock);
     QUIC_SEND_REQUEST* ApiQueue = Datagram->ApiQueue;
     Datagram->ApiQueue = NULL;
+    Datagram->ApiQueueTail = &Datagram->ApiQueue;
     CxPlatDispatchLockRelease(&Datagram->ApiQueueLock);
     uint64_t TotalBytesSent = 0;
 
@@ -462,6 +649,26 @@ QuicDatagramSendFlush(
     QuicPerfCounterAdd(QUIC_PERF_COUNTER_APP_SEND_BYTES, TotalBytesSent);
 }
 
+//
+// Removes the first request from the send queue.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+void
+QuicDatagramRemoveHead(
+    _In_ QUIC_DATAGRAM* Datagram
+    )
+{
+    QUIC_SEND_REQUEST* SendRequest = Datagram->SendQueue;
+    if (Datagram->PrioritySendQueueTail == &SendRequest->Next) {
+        Datagram->PrioritySendQueueTail = &Datagram->SendQueue;
+    }
+    if (Datagram->SendQueueTail == &SendRequest->Next) {
+        Datagram->SendQueueTail = &Datagram->SendQueue;
+    }
+    Datagram->SendQueue = SendRequest->Next;
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 BOOLEAN
 QuicDatagramWriteFrame(
@@ -475,9 +682,72 @@ QuicDatagramWriteFrame(
 
     QuicDatagramValidate(Datagram);
 
-    while (Datagram->SendQueue != NULL) {
+    QUIC_DATAGRAM_FEC* Fec = Datagram->Fec;
+    uint8_t FecHeader[QUIC_DATAGRAM_FEC_HEADER_LENGTH];
+    uint64_t TimeNow = 0;
+
+    while (Datagram->SendQueue != NULL || (Fec != NULL && Fec->RepairPending)) {
+
+        if (Fec != NULL && Fec->RepairPending) {
+            //
+            // The repair might not fit anymore if the path MTU shrank since
+            // the block started, in which case the block goes unprotected.
+            //
+            if (QUIC_DATAGRAM_FEC_HEADER_LENGTH + Fec->SendSymbolLength <=
+                    (uint32_t)Datagram->MaxSendLength + QUIC_DATAGRAM_FEC_OVERHEAD) {
+                const QUIC_BUFFER Symbol = { Fec->SendSymbolLength, Fec->SendSymbol };
+                QuicDatagramFecWriteHeader(Fec, FecHeader);
+                if (!QuicDatagramFrameEncodeEx(
+                        FecHeader,
+                        sizeof(FecHeader),
+                        &Symbol,
+                        1,
+                        Symbol.Length,
+                        &Builder->DatagramLength,
+                        (uint16_t)Builder->Datagram->Length - Builder->EncryptionOverhead,
+                        Builder->Datagram->Buffer)) {
+                    Result = TRUE;
+                    goto Exit;
+                }
+                Builder->Metadata->Flags.IsAckEliciting = TRUE;
+                Builder->Metadata->Frames[Builder->Metadata->FrameCount].Type = QUIC_FRAME_DATAGRAM;
+                Builder->Metadata->Frames[Builder->Metadata->FrameCount].DATAGRAM.ClientContext =
+                    QUIC_DATAGRAM_INTERNAL_CLIENT_CONTEXT;
+                ++Builder->Metadata->FrameCount;
+            }
+            QuicDatagramFecOnRepairSent(
+                Fec,
+                Connection->Stats.Send.TotalPackets,
+                Connection->Stats.Send.SuspectedLostPackets);
+            if (Builder->Metadata->FrameCount == QUIC_MAX_FRAMES_PER_PACKET) {
+                Result = TRUE;
+                goto Exit;
+            }
+            continue;
+        }
+
         QUIC_SEND_REQUEST* SendRequest = Datagram->SendQueue;
 
+        if (SendRequest->Deadline != 0) {
+            if (TimeNow == 0) {
+                TimeNow = CxPlatTimeUs64();
+            }
+            if (CxPlatTimeAtOrBefore64(SendRequest->Deadline, TimeNow)) {
+                //
+                // Too stale to be worth the bandwidth, so drop it before it
+                // takes up room in the packet.
+                //
+                QuicTraceLogConnVerbose(
+                    DatagramSendExpired,
+                    Connection,
+                    "Datagram [%p] expired in the send queue",
+                    SendRequest);
+                QuicDatagramRemoveHead(Datagram);
+                QuicDatagramCancelSend(Connection, SendRequest);
+                continue;
+            }
+        }
+
         if (Builder->Metadata->Flags.KeyType == QUIC_PACKET_KEY_0_RTT &&
             !(SendRequest->Flags & QUIC_SEND_FLAG_ALLOW_0_RTT)) {
             CXPLAT_DBG_ASSERT(FALSE);
@@ -490,8 +760,14 @@ QuicDatagramWriteFrame(
         uint16_t AvailableBufferLength =
             (uint16_t)Builder->Datagram->Length - Builder->EncryptionOverhead;
 
+        if (Fec != NULL) {
+            QuicDatagramFecWriteHeader(Fec, FecHeader);
+        }
+
         BOOLEAN HadRoomForDatagram =
             QuicDatagramFrameEncodeEx(
+                FecHeader,
+                Fec != NULL ? sizeof(FecHeader) : 0,
                 SendRequest->Buffers,
                 SendRequest->BufferCount,
                 SendRequest->TotalLength,
@@ -513,13 +789,15 @@ QuicDatagramWriteFrame(
             goto Exit;
         }
 
-        if (Datagram->PrioritySendQueueTail == &SendRequest->Next) {
-            Datagram->PrioritySendQueueTail = &Datagram->SendQueue;
-        }
-        if (Datagram->SendQueueTail == &SendRequest->Next) {
-            Datagram->SendQueueTail = &Datagram->SendQueue;
+        QuicDatagramRemoveHead(Datagram);
+
+        if (Fec != NULL) {
+            QuicDatagramFecOnSourceSent(
+                Fec,
+                SendRequest->Buffers,
+                SendRequest->BufferCount,
+                (uint16_t)SendRequest->TotalLength);
         }
-        Datagram->SendQueue = SendRequest->Next;
 
         Builder->Metadata->Flags.IsAckEliciting = TRUE;
         Builder->Metadata->Frames[Builder->Metadata->FrameCount].Type = QUIC_FRAME_DATAGRAM;
@@ -535,7 +813,7 @@ QuicDatagramWriteFrame(
     }
 
 Exit:
-    if (Datagram->SendQueue == NULL) {
+    if (Datagram->SendQueue == NULL && (Fec == NULL || !Fec->RepairPending)) {
         Connection->Send.SendFlags &= ~QUIC_CONN_SEND_FLAG_DATAGRAM;
     }
 
@@ -544,6 +822,404 @@ Exit:
     return Result;
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicDatagramSetBatchReceiveEnabled(
+    _In_ QUIC_DATAGRAM* Datagram,
+    _In_ BOOLEAN Enabled
+    )
+{
+    if (!Enabled) {
+        if (Datagram->RecvBatch != NULL) {
+            CXPLAT_DBG_ASSERT(Datagram->RecvBatch->Count == 0);
+            CXPLAT_FREE(Datagram->RecvBatch, QUIC_POOL_DATAGRAM_RECV_BATCH);
+            Datagram->RecvBatch = NULL;
+        }
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    if (Datagram->RecvBatch == NULL) {
+        Datagram->RecvBatch =
+            CXPLAT_ALLOC_NONPAGED(
+                sizeof(QUIC_DATAGRAM_RECV_BATCH),
+                QUIC_POOL_DATAGRAM_RECV_BATCH);
+        if (Datagram->RecvBatch == NULL) {
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "datagram receive batch",
+                sizeof(QUIC_DATAGRAM_RECV_BATCH));
+            return QUIC_STATUS_OUT_OF_MEMORY;
+        }
+        Datagram->RecvBatch->Count = 0;
+    }
+
+    return QUIC_STATUS_SUCCESS;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicDatagramIndicateReceiveBatch(
+    _In_ QUIC_DATAGRAM* Datagram
+    )
+{
+    QUIC_DATAGRAM_RECV_BATCH* Batch = Datagram->RecvBatch;
+    if (Batch == NULL || Batch->Count == 0) {
+        return;
+    }
+
+    QUIC_CONNECTION* Connection = QuicDatagramGetConnection(Datagram);
+
+    uint64_t TotalLength = 0;
+    for (uint32_t i = 0; i < Batch->Count; ++i) {
+        TotalLength += Batch->Datagrams[i].Length;
+    }
+
+    QUIC_CONNECTION_EVENT Event;
+    Event.Type = QUIC_CONNECTION_EVENT_DATAGRAM_BATCH_RECEIVED;
+    Event.DATAGRAM_BATCH_RECEIVED.DatagramCount = Batch->Count;
+    Event.DATAGRAM_BATCH_RECEIVED.Datagrams = Batch->Datagrams;
+    Event.DATAGRAM_BATCH_RECEIVED.Flags = Batch->Flags;
+
+    QuicTraceLogConnVerbose(
+        IndicateDatagramBatchReceived,
+        Connection,
+        "Indicating DATAGRAM_BATCH_RECEIVED [count=%u]",
+        Batch->Count);
+    (void)QuicConnIndicateEvent(Connection, &Event);
+
+    Batch->Count = 0;
+    QuicPerfCounterAdd(QUIC_PERF_COUNTER_APP_RECV_BYTES, TotalLength);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicDatagramSetUdpRelay(
+    _In_ QUIC_DATAGRAM* Datagram,
+    _In_ const QUIC_DATAGRAM_UDP_RELAY* Config
+    )
+{
+    QUIC_CONNECTION* Connection = QuicDatagramGetConnection(Datagram);
+
+    if (Config->QuarterStreamId > QUIC_VAR_INT_MAX ||
+        Config->ContextId > QUIC_VAR_INT_MAX) {
+        return QUIC_STATUS_INVALID_PARAMETER;
+    }
+
+    QUIC_DATAGRAM_RELAY* Existing = NULL;
+    for (CXPLAT_LIST_ENTRY* Entry = Datagram->Relays.Flink;
+         Entry != &Datagram->Relays;
+         Entry = Entry->Flink) {
+        QUIC_DATAGRAM_RELAY* Relay =
+            CXPLAT_CONTAINING_RECORD(Entry, QUIC_DATAGRAM_RELAY, Link);
+        if (Relay->QuarterStreamId == Config->QuarterStreamId &&
+            Relay->ContextId == Config->ContextId) {
+            Existing = Relay;
+            break;
+        }
+    }
+
+    if (QuicAddrGetFamily(&Config->RemoteAddress) == QUIC_ADDRESS_FAMILY_UNSPEC) {
+        if (Existing == NULL) {
+            return QUIC_STATUS_NOT_FOUND;
+        }
+        QuicDatagramRelayDelete(Existing);
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    if (!Datagram->SendEnabled || QuicConnIsClosed(Connection)) {
+        return QUIC_STATUS_INVALID_STATE;
+    }
+
+    QUIC_DATAGRAM_RELAY* Relay =
+        CXPLAT_ALLOC_NONPAGED(sizeof(QUIC_DATAGRAM_RELAY), QUIC_POOL_DATAGRAM_RELAY);
+    if (Relay == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "datagram relay",
+            sizeof(QUIC_DATAGRAM_RELAY));
+        return QUIC_STATUS_OUT_OF_MEMORY;
+    }
+    CxPlatZeroMemory(Relay, sizeof(*Relay));
+    Relay->OwnerType = QUIC_SOCKET_OWNER_DATAGRAM_RELAY;
+    Relay->Connection = Connection;
+    Relay->QuarterStreamId = Config->QuarterStreamId;
+    Relay->ContextId = Config->ContextId;
+    uint8_t* PrefixEnd = QuicVarIntEncode(Config->QuarterStreamId, Relay->Prefix);
+    PrefixEnd = QuicVarIntEncode(Config->ContextId, PrefixEnd);
+    Relay->PrefixLength = (uint8_t)(PrefixEnd - Relay->Prefix);
+
+    CXPLAT_UDP_CONFIG UdpConfig = {0};
+    UdpConfig.RemoteAddress = &Config->RemoteAddress;
+    UdpConfig.PartitionIndex = QuicPartitionIdGetIndex(Connection->PartitionID);
+    UdpConfig.CallbackContext = Relay;
+#ifdef QUIC_COMPARTMENT_ID
+    if (Connection->Configuration != NULL) {
+        UdpConfig.CompartmentId = Connection->Configuration->CompartmentId;
+    }
+#endif
+#ifdef QUIC_OWNING_PROCESS
+    if (Connection->Configuration != NULL) {
+        UdpConfig.OwningProcess = Connection->Configuration->OwningProcess;
+    }
+#endif
+
+    QUIC_STATUS Status =
+        CxPlatSocketCreateUdp(MsQuicLib.Datapath, &UdpConfig, &Relay->Socket);
+    if (QUIC_FAILED(Status)) {
+        QuicTraceEvent(
+            ConnErrorStatus,
+            "[conn][%p] ERROR, %u, %s.",
+            Connection,
+            Status,
+            "Create datagram relay socket");
+        CXPLAT_FREE(Relay, QUIC_POOL_DATAGRAM_RELAY);
+        return Status;
+    }
+
+    //
+    // Relayed payloads always go on the socket's normal (non-raw) path, so the
+    // route never needs resolving.
+    //
+    Relay->Route.RemoteAddress = Config->RemoteAddress;
+    CxPlatSocketGetLocalAddress(Relay->Socket, &Relay->Route.LocalAddress);
+    Relay->Route.DatapathType = CXPLAT_DATAPATH_TYPE_USER;
+    Relay->Route.State = RouteResolved;
+
+    if (Existing != NULL) {
+        QuicDatagramRelayDelete(Existing);
+    }
+    CxPlatListInsertTail(&Datagram->Relays, &Relay->Link);
+
+    QuicTraceLogConnInfo(
+        DatagramRelayAdded,
+        Connection,
+        "Datagram relay added [qsid=%llu] [ctx=%llu]",
+        Relay->QuarterStreamId,
+        Relay->ContextId);
+
+    return QUIC_STATUS_SUCCESS;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicDatagramFlushRelays(
+    _In_ QUIC_DATAGRAM* Datagram
+    )
+{
+    for (CXPLAT_LIST_ENTRY* Entry = Datagram->Relays.Flink;
+         Entry != &Datagram->Relays;
+         Entry = Entry->Flink) {
+        QUIC_DATAGRAM_RELAY* Relay =
+            CXPLAT_CONTAINING_RECORD(Entry, QUIC_DATAGRAM_RELAY, Link);
+        if (Relay->SendData != NULL) {
+            QuicDatagramRelayFlush(Relay);
+        }
+    }
+}
+
+//
+// Forwards a received datagram to its relay's UDP target, if it has one.
+// Returns FALSE if the datagram should be indicated to the app instead.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+BOOLEAN
+QuicDatagramRelayForward(
+    _In_ QUIC_DATAGRAM* Datagram,
+    _In_ uint16_t Length,
+    _In_reads_bytes_(Length)
+        const uint8_t* Data
+    )
+{
+    uint16_t Offset = 0;
+    QUIC_VAR_INT QuarterStreamId, ContextId;
+    if (!QuicVarIntDecode(Length, Data, &Offset, &QuarterStreamId) ||
+        !QuicVarIntDecode(Length, Data, &Offset, &ContextId)) {
+        return FALSE;
+    }
+
+    QUIC_DATAGRAM_RELAY* Relay = NULL;
+    for (CXPLAT_LIST_ENTRY* Entry = Datagram->Relays.Flink;
+         Entry != &Datagram->Relays;
+         Entry = Entry->Flink) {
+        QUIC_DATAGRAM_RELAY* Candidate =
+            CXPLAT_CONTAINING_RECORD(Entry, QUIC_DATAGRAM_RELAY, Link);
+        if (Candidate->QuarterStreamId == QuarterStreamId &&
+            Candidate->ContextId == ContextId) {
+            Relay = Candidate;
+            break;
+        }
+    }
+    if (Relay == NULL) {
+        return FALSE;
+    }
+
+    const uint16_t PayloadLength = Length - Offset;
+    if (PayloadLength == 0) {
+        return TRUE; // Nothing to send.
+    }
+
+    //
+    // Only payloads of the segment size can follow each other in a segmented
+    // send; a shorter one ends it, and a longer one needs a new one.
+    //
+    if (Relay->SendData != NULL && PayloadLength > Relay->SendSegmentSize) {
+        QuicDatagramRelayFlush(Relay);
+    }
+
+    if (Relay->SendData == NULL) {
+        CXPLAT_SEND_CONFIG SendConfig = {
+            &Relay->Route, PayloadLength, CXPLAT_ECN_NON_ECT, CXPLAT_SEND_FLAGS_NONE, 0 };
+        Relay->SendData = CxPlatSendDataAlloc(Relay->Socket, &SendConfig);
+        if (Relay->SendData == NULL) {
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "datagram relay send data",
+                0);
+            return TRUE;
+        }
+        Relay->SendSegmentSize = PayloadLength;
+    }
+
+    QUIC_BUFFER* Buffer = CxPlatSendDataAllocBuffer(Relay->SendData, PayloadLength);
+    if (Buffer == NULL) {
+        QuicDatagramRelayFlush(Relay);
+        return TRUE;
+    }
+    CxPlatCopyMemory(Buffer->Buffer, Data + Offset, PayloadLength);
+
+    if (CxPlatSendDataIsFull(Relay->SendData)) {
+        QuicDatagramRelayFlush(Relay);
+    }
+
+    return TRUE;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicDatagramRelayReceive(
+    _In_ QUIC_DATAGRAM_RELAY* Relay,
+    _In_ CXPLAT_RECV_DATA* RecvDataChain
+    )
+{
+    QUIC_CONNECTION* Connection = Relay->Connection;
+    QUIC_DATAGRAM* Datagram = &Connection->Datagram;
+    QUIC_SEND_REQUEST* SendRequests = NULL;
+    QUIC_SEND_REQUEST** SendRequestsTail = &SendRequests;
+    QUIC_SEND_REQUEST* LastSendRequest = NULL;
+
+    //
+    // The payloads are framed straight out of the received buffers, so all it
+    // takes is a pooled send request each, and the whole chain is queued with
+    // a single operation.
+    //
+    CXPLAT_RECV_DATA* RecvData;
+    while ((RecvData = RecvDataChain) != NULL) {
+        RecvDataChain = RecvData->Next;
+        RecvData->Next = NULL;
+
+        //
+        // Drop what can't fit rather than failing the whole chain. The unlocked
+        // read is only a hint; QuicDatagramQueueSend checks it again.
+        //
+        const uint32_t TotalLength = (uint32_t)Relay->PrefixLength + RecvData->BufferLength;
+        if (TotalLength > (uint32_t)Datagram->MaxSendLength) {
+            CxPlatRecvDataReturn(RecvData);
+            continue;
+        }
+
+        QUIC_DATAGRAM_RELAY_SEND* RelaySend =
+            CxPlatPoolAlloc(&Connection->Worker->DatagramRelaySendPool);
+        if (RelaySend == NULL) {
+            CxPlatRecvDataReturn(RecvData);
+            continue;
+        }
+
+        CxPlatCopyMemory(RelaySend->Prefix, Relay->Prefix, Relay->PrefixLength);
+        RelaySend->Buffers[0].Length = Relay->PrefixLength;
+        RelaySend->Buffers[0].Buffer = RelaySend->Prefix;
+        RelaySend->Buffers[1].Length = RecvData->BufferLength;
+        RelaySend->Buffers[1].Buffer = RecvData->Buffer;
+        RelaySend->RecvData = RecvData;
+
+        QUIC_SEND_REQUEST* SendRequest = &RelaySend->Request;
+        SendRequest->Next = NULL;
+        SendRequest->Buffers = RelaySend->Buffers;
+        SendRequest->BufferCount = ARRAYSIZE(RelaySend->Buffers);
+        SendRequest->Flags = QUIC_SEND_FLAG_DGRAM_RELAY;
+        SendRequest->TotalLength = TotalLength;
+        SendRequest->ClientContext = QUIC_DATAGRAM_INTERNAL_CLIENT_CONTEXT;
+        SendRequest->SendTime = 0;
+
+        *SendRequestsTail = SendRequest;
+        SendRequestsTail = &SendRequest->Next;
+        LastSendRequest = SendRequest;
+    }
+
+    if (SendRequests != NULL) {
+        (void)QuicDatagramQueueSend(Datagram, SendRequests, LastSendRequest);
+    }
+}
+
+//
+// Relays, batches or indicates a received datagram. Only datagrams that stay
+// valid until the end of the receive batch can be batched.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+void
+QuicDatagramIndicateReceive(
+    _In_ QUIC_DATAGRAM* Datagram,
+    _In_ QUIC_RECEIVE_FLAGS Flags,
+    _In_ uint16_t Length,
+    _In_reads_bytes_(Length)
+        const uint8_t* Data,
+    _In_ BOOLEAN AllowBatch
+    )
+{
+    QUIC_CONNECTION* Connection = QuicDatagramGetConnection(Datagram);
+
+    if (!CxPlatListIsEmpty(&Datagram->Relays) &&
+        QuicDatagramRelayForward(Datagram, Length, Data)) {
+        return;
+    }
+
+    QUIC_DATAGRAM_RECV_BATCH* Batch = Datagram->RecvBatch;
+    if (Batch != NULL && AllowBatch) {
+        //
+        // The data points into the received packet, which stays valid until
+        // the packets are returned at the end of the receive batch, where the
+        // batch is indicated.
+        //
+        Batch->Datagrams[Batch->Count].Length = Length;
+        Batch->Datagrams[Batch->Count].Buffer = (uint8_t*)Data;
+        Batch->Flags[Batch->Count] = Flags;
+        if (++Batch->Count == QUIC_MAX_DATAGRAM_RECEIVE_BATCH_COUNT) {
+            QuicDatagramIndicateReceiveBatch(Datagram);
+        }
+        return;
+    }
+
+    const QUIC_BUFFER QuicBuffer = { Length, (uint8_t*)Data };
+
+    QUIC_CONNECTION_EVENT Event;
+    Event.Type = QUIC_CONNECTION_EVENT_DATAGRAM_RECEIVED;
+    Event.DATAGRAM_RECEIVED.Buffer = &QuicBuffer;
+    Event.DATAGRAM_RECEIVED.Flags = Flags;
+
+    QuicTraceLogConnVerbose(
+        IndicateDatagramReceived,
+        Connection,
+        "Indicating DATAGRAM_RECEIVED [len=%hu]",
+        Length);
+    (void)QuicConnIndicateEvent(Connection, &Event);
+
+    QuicPerfCounterAdd(QUIC_PERF_COUNTER_APP_RECV_BYTES, QuicBuffer.Length);
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 BOOLEAN
 QuicDatagramProcessFrame(
@@ -566,25 +1242,44 @@ QuicDatagramProcessFrame(
 
     // TODO - If we ever limit max receive length, validate it here.
 
-    const QUIC_BUFFER QuicBuffer = { (uint16_t)Frame.Length, (uint8_t*)Frame.Data };
+    const QUIC_RECEIVE_FLAGS Flags =
+        Packet->EncryptedWith0Rtt ? QUIC_RECEIVE_FLAG_0_RTT : QUIC_RECEIVE_FLAG_NONE;
 
-    QUIC_CONNECTION_EVENT Event;
-    Event.Type = QUIC_CONNECTION_EVENT_DATAGRAM_RECEIVED;
-    Event.DATAGRAM_RECEIVED.Buffer = &QuicBuffer;
-    if (Packet->EncryptedWith0Rtt) {
-        Event.DATAGRAM_RECEIVED.Flags = QUIC_RECEIVE_FLAG_0_RTT;
-    } else {
-        Event.DATAGRAM_RECEIVED.Flags = 0;
+    if (Datagram->Fec == NULL) {
+        QuicDatagramIndicateReceive(
+            Datagram, Flags, (uint16_t)Frame.Length, Frame.Data, TRUE);
+        return TRUE;
     }
 
-    QuicTraceLogConnVerbose(
-        IndicateDatagramReceived,
-        Connection,
-        "Indicating DATAGRAM_RECEIVED [len=%hu]",
-        (uint16_t)Frame.Length);
-    (void)QuicConnIndicateEvent(Connection, &Event);
+    QUIC_BUFFER Payload, Recovered;
+    if (!QuicDatagramFecReceive(
+            Datagram->Fec,
+            (uint16_t)Frame.Length,
+            Frame.Data,
+            &Payload,
+            &Recovered)) {
+        return FALSE;
+    }
 
-    QuicPerfCounterAdd(QUIC_PERF_COUNTER_APP_RECV_BYTES, QuicBuffer.Length);
+    if (Payload.Buffer != NULL) {
+        QuicDatagramIndicateReceive(
+            Datagram, Flags, (uint16_t)Payload.Length, Payload.Buffer, TRUE);
+    }
+
+    if (Recovered.Buffer != NULL) {
+        QuicTraceLogConnVerbose(
+            DatagramFecRecovered,
+            Connection,
+            "Datagram recovered by FEC [len=%u]",
+            Recovered.Length);
+        //
+        // The recovered datagram is in the FEC state, which the next datagram
+        // can overwrite, so it's indicated on its own, after any batched ones.
+        //
+        QuicDatagramIndicateReceiveBatch(Datagram);
+        QuicDatagramIndicateReceive(
+            Datagram, Flags, (uint16_t)Recovered.Length, Recovered.Buffer, FALSE);
+    }
 
     return TRUE;
 }
@@ -5,6 +5,73 @@
 
 --*/
 
+//
+// Received datagrams waiting to be indicated together to the app.
+//
+typedef struct QUIC_DATAGRAM_RECV_BATCH {
+
+    uint32_t Count;
+    QUIC_RECEIVE_FLAGS Flags[QUIC_MAX_DATAGRAM_RECEIVE_BATCH_COUNT];
+    QUIC_BUFFER Datagrams[QUIC_MAX_DATAGRAM_RECEIVE_BATCH_COUNT];
+
+} QUIC_DATAGRAM_RECV_BATCH;
+
+//
+// The largest relay prefix: two 8-byte variable length integers.
+//
+#define QUIC_DATAGRAM_RELAY_MAX_PREFIX 16
+
+//
+// Forwards datagrams of one context to and from a UDP socket, without
+// indicating them to the app (QUIC_PARAM_CONN_DATAGRAM_UDP_RELAY).
+//
+typedef struct QUIC_DATAGRAM_RELAY {
+
+    //
+    // Always QUIC_SOCKET_OWNER_DATAGRAM_RELAY. Must be the first field.
+    //
+    QUIC_SOCKET_OWNER_TYPE OwnerType;
+
+    //
+    // The link in the connection's list of relays.
+    //
+    CXPLAT_LIST_ENTRY Link;
+
+    QUIC_CONNECTION* Connection;
+
+    CXPLAT_SOCKET* Socket;
+    CXPLAT_ROUTE Route;
+
+    uint64_t QuarterStreamId;
+    uint64_t ContextId;
+
+    //
+    // The encoded Quarter Stream ID and Context ID.
+    //
+    uint8_t PrefixLength;
+    uint8_t Prefix[QUIC_DATAGRAM_RELAY_MAX_PREFIX];
+
+    //
+    // Payloads relayed to the UDP target, sent together at the end of the
+    // connection's receive batch. Payloads of the segment size are coalesced
+    // into one segmented send.
+    //
+    CXPLAT_SEND_DATA* SendData;
+    uint16_t SendSegmentSize;
+
+} QUIC_DATAGRAM_RELAY;
+
+//
+// A UDP payload from a relay's target, queued as a datagram send request. It
+// holds on to the received buffer until the datagram is framed.
+//
+typedef struct QUIC_DATAGRAM_RELAY_SEND {
+    QUIC_SEND_REQUEST Request;
+    QUIC_BUFFER Buffers[2]; // The prefix and the payload.
+    CXPLAT_RECV_DATA* RecvData;
+    uint8_t Prefix[QUIC_DATAGRAM_RELAY_MAX_PREFIX];
+} QUIC_DATAGRAM_RELAY_SEND;
+
 typedef struct QUIC_DATAGRAM {
 
     //
@@ -20,8 +87,34 @@ typedef struct QUIC_DATAGRAM {
     // send queue.
     //
     QUIC_SEND_REQUEST* ApiQueue;
+    QUIC_SEND_REQUEST** ApiQueueTail;
     CXPLAT_DISPATCH_LOCK ApiQueueLock;
 
+    //
+    // Only allocated when the app enables batched receive indications. The
+    // buffers point into received packets, so the batch must be indicated
+    // before those packets are returned to the datapath.
+    //
+    QUIC_DATAGRAM_RECV_BATCH* RecvBatch;
+
+    //
+    // List of QUIC_DATAGRAM_RELAY. Only modified on the worker thread.
+    //
+    CXPLAT_LIST_ENTRY Relays;
+
+    //
+    // The local FEC configuration (QUIC_PARAM_CONN_DATAGRAM_FEC), and the FEC
+    // state, only allocated once the peer is known to have enabled FEC too.
+    //
+    QUIC_DATAGRAM_FEC_CONFIG FecConfig;
+    QUIC_DATAGRAM_FEC* Fec;
+
+    //
+    // How long queued datagrams may wait (QUIC_PARAM_CONN_DATAGRAM_SEND_POLICY).
+    // Read without the lock when requests are queued.
+    //
+    QUIC_DATAGRAM_SEND_POLICY SendPolicy;
+
     //
     // The maximum datagram frame we allow the peer to send.
     //
@@ -68,7 +161,8 @@ _IRQL_requires_max_(DISPATCH_LEVEL)
 QUIC_STATUS
 QuicDatagramQueueSend(
     _In_ QUIC_DATAGRAM* Datagram,
-    _In_ QUIC_SEND_REQUEST* SendRequest
+    _In_ QUIC_SEND_REQUEST* SendRequests,
+    _In_ QUIC_SEND_REQUEST* LastSendRequest
     );
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -92,6 +186,51 @@ QuicDatagramIndicateSendStateChange(
     _In_ QUIC_DATAGRAM_SEND_STATE State
     );
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicDatagramSetBatchReceiveEnabled(
+    _In_ QUIC_DATAGRAM* Datagram,
+    _In_ BOOLEAN Enabled
+    );
+
+//
+// Indicates any received datagrams still waiting in the receive batch.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicDatagramIndicateReceiveBatch(
+    _In_ QUIC_DATAGRAM* Datagram
+    );
+
+//
+// Adds, replaces or removes (for an unspecified remote address) a UDP relay.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicDatagramSetUdpRelay(
+    _In_ QUIC_DATAGRAM* Datagram,
+    _In_ const QUIC_DATAGRAM_UDP_RELAY* Config
+    );
+
+//
+// Sends the payloads relayed to UDP targets during the receive batch.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicDatagramFlushRelays(
+    _In_ QUIC_DATAGRAM* Datagram
+    );
+
+//
+// Called on the datapath's receive path for a relay's socket.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicDatagramRelayReceive(
+    _In_ QUIC_DATAGRAM_RELAY* Relay,
+    _In_ CXPLAT_RECV_DATA* RecvDataChain
+    );
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 BOOLEAN
 QuicDatagramProcessFrame(
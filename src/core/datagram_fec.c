@@ -0,0 +1,312 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Forward error correction for datagrams (QUIC_PARAM_CONN_DATAGRAM_FEC).
+
+    Source datagrams are sent in blocks, each followed by a repair datagram
+    holding the XOR of the block's datagrams, each prefixed with its length
+    and padded with zeros to the longest one. The receiver XORs the datagrams
+    of a block it receives into the repair symbol; if exactly one is missing,
+    what's left is that datagram. The sender sizes each block from the loss
+    rate of the connection's packets, so the redundancy follows the path.
+
+--*/
+
+#include "precomp.h"
+#ifdef QUIC_CLOG
+#include "datagram_fec.c.clog.h"
+#endif
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicDatagramFecInitialize(
+    _Out_ QUIC_DATAGRAM_FEC* Fec,
+    _In_ const QUIC_DATAGRAM_FEC_CONFIG* Config
+    )
+{
+    CXPLAT_DBG_ASSERT(Config->MinBlockSize >= 2);
+    CXPLAT_DBG_ASSERT(Config->MinBlockSize <= Config->MaxBlockSize);
+    CXPLAT_DBG_ASSERT(Config->MaxBlockSize <= QUIC_DATAGRAM_FEC_MAX_BLOCK_SIZE);
+
+    CxPlatZeroMemory(Fec, sizeof(*Fec));
+    Fec->MinBlockSize = Config->MinBlockSize;
+    Fec->MaxBlockSize = Config->MaxBlockSize;
+    Fec->SendBlockSize = Config->MaxBlockSize; // No loss measured yet.
+}
+
+//
+// XORs Length bytes into the symbol at Offset.
+//
+static
+void
+QuicDatagramFecXor(
+    _Inout_updates_(QUIC_DATAGRAM_FEC_MAX_SYMBOL)
+        uint8_t* Symbol,
+    _Inout_ uint16_t* SymbolLength,
+    _In_ uint16_t Offset,
+    _In_reads_bytes_(Length)
+        const uint8_t* Data,
+    _In_ uint16_t Length
+    )
+{
+    CXPLAT_DBG_ASSERT((uint32_t)Offset + Length <= QUIC_DATAGRAM_FEC_MAX_SYMBOL);
+    for (uint16_t i = 0; i < Length; ++i) {
+        Symbol[Offset + i] ^= Data[i];
+    }
+    if (Offset + Length > *SymbolLength) {
+        *SymbolLength = Offset + Length;
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicDatagramFecWriteHeader(
+    _In_ const QUIC_DATAGRAM_FEC* Fec,
+    _Out_writes_(QUIC_DATAGRAM_FEC_HEADER_LENGTH)
+        uint8_t* Header
+    )
+{
+    Header[0] =
+        Fec->RepairPending ? QUIC_DATAGRAM_FEC_TYPE_REPAIR : QUIC_DATAGRAM_FEC_TYPE_SOURCE;
+    Header[1] = (uint8_t)(Fec->SendBlockId >> 8);
+    Header[2] = (uint8_t)Fec->SendBlockId;
+    Header[3] = Fec->SendCount; // The source's index, or the repair's source count.
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicDatagramFecOnSourceSent(
+    _Inout_ QUIC_DATAGRAM_FEC* Fec,
+    _In_reads_(BufferCount)
+        const QUIC_BUFFER* const Buffers,
+    _In_ uint32_t BufferCount,
+    _In_ uint16_t TotalLength
+    )
+{
+    CXPLAT_DBG_ASSERT(!Fec->RepairPending);
+    CXPLAT_DBG_ASSERT(sizeof(uint16_t) + TotalLength <= QUIC_DATAGRAM_FEC_MAX_SYMBOL);
+
+    const uint8_t Prefix[sizeof(uint16_t)] = { (uint8_t)(TotalLength >> 8), (uint8_t)TotalLength };
+    QuicDatagramFecXor(
+        Fec->SendSymbol, &Fec->SendSymbolLength, 0, Prefix, sizeof(Prefix));
+    uint16_t Offset = sizeof(Prefix);
+    for (uint32_t i = 0; i < BufferCount; ++i) {
+        QuicDatagramFecXor(
+            Fec->SendSymbol,
+            &Fec->SendSymbolLength,
+            Offset,
+            Buffers[i].Buffer,
+            (uint16_t)Buffers[i].Length);
+        Offset += (uint16_t)Buffers[i].Length;
+    }
+
+    if (++Fec->SendCount == Fec->SendBlockSize) {
+        Fec->RepairPending = TRUE;
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicDatagramFecOnRepairSent(
+    _Inout_ QUIC_DATAGRAM_FEC* Fec,
+    _In_ uint64_t SentPackets,
+    _In_ uint64_t LostPackets
+    )
+{
+    CXPLAT_DBG_ASSERT(Fec->RepairPending);
+
+    //
+    // LossRate is kept in eighths of a per mille, as 8 times the moving
+    // average, so the average doesn't lose its precision to rounding.
+    //
+    const uint64_t Sent = SentPackets - Fec->LastSentPackets;
+    if (Sent >= QUIC_DATAGRAM_FEC_LOSS_SAMPLE) {
+        const uint64_t Lost = LostPackets - Fec->LastLostPackets;
+        const uint32_t Rate = Lost >= Sent ? 1000 : (uint32_t)((1000 * Lost) / Sent);
+        Fec->LossRate = (uint16_t)(Fec->LossRate - Fec->LossRate / 8 + Rate);
+        Fec->LastSentPackets = SentPackets;
+        Fec->LastLostPackets = LostPackets;
+    }
+
+    uint32_t BlockSize =
+        Fec->LossRate == 0 ?
+            Fec->MaxBlockSize :
+            (8 * QUIC_DATAGRAM_FEC_LOSS_TARGET) / Fec->LossRate;
+    if (BlockSize < Fec->MinBlockSize) {
+        BlockSize = Fec->MinBlockSize;
+    } else if (BlockSize > Fec->MaxBlockSize) {
+        BlockSize = Fec->MaxBlockSize;
+    }
+
+    Fec->SendBlockId++;
+    Fec->SendBlockSize = (uint8_t)BlockSize;
+    Fec->SendCount = 0;
+    Fec->RepairPending = FALSE;
+    CxPlatZeroMemory(Fec->SendSymbol, Fec->SendSymbolLength);
+    Fec->SendSymbolLength = 0;
+}
+
+//
+// Finds the receive state of the block, starting it if it's newer than the
+// one in its slot. Returns NULL for blocks too old to recover from.
+//
+static
+QUIC_DATAGRAM_FEC_RECV_BLOCK*
+QuicDatagramFecGetRecvBlock(
+    _Inout_ QUIC_DATAGRAM_FEC* Fec,
+    _In_ uint16_t BlockId
+    )
+{
+    QUIC_DATAGRAM_FEC_RECV_BLOCK* Block =
+        &Fec->RecvBlocks[BlockId % QUIC_DATAGRAM_FEC_RECV_BLOCKS];
+    if (Block->InUse) {
+        if (Block->BlockId == BlockId) {
+            return Block;
+        }
+        if ((int16_t)(BlockId - Block->BlockId) < 0) {
+            return NULL;
+        }
+    }
+
+    CxPlatZeroMemory(Block->Symbol, Block->SymbolLength);
+    Block->SymbolLength = 0;
+    Block->BlockId = BlockId;
+    Block->InUse = TRUE;
+    Block->Done = FALSE;
+    Block->SourceCount = 0;
+    Block->ReceivedMask = 0;
+    return Block;
+}
+
+//
+// Rebuilds the block's missing datagram if it's the only one missing.
+//
+static
+void
+QuicDatagramFecTryRecover(
+    _Inout_ QUIC_DATAGRAM_FEC_RECV_BLOCK* Block,
+    _Out_ QUIC_BUFFER* Recovered
+    )
+{
+    if (Block->SourceCount == 0) {
+        return;
+    }
+
+    const uint32_t AllMask = (uint32_t)((1ull << Block->SourceCount) - 1);
+    const uint32_t Missing = AllMask & ~Block->ReceivedMask;
+    if (Missing == 0) {
+        Block->Done = TRUE;
+        return;
+    }
+    if ((Missing & (Missing - 1)) != 0) {
+        return; // More than one missing.
+    }
+
+    Block->Done = TRUE;
+    const uint16_t Length = (uint16_t)((Block->Symbol[0] << 8) | Block->Symbol[1]);
+    if (sizeof(uint16_t) + Length > Block->SymbolLength) {
+        return; // Inconsistent; the peer sent a bad repair.
+    }
+
+    Block->ReceivedMask |= Missing;
+    Recovered->Buffer = Block->Symbol + sizeof(uint16_t);
+    Recovered->Length = Length;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+_Success_(return != FALSE)
+BOOLEAN
+QuicDatagramFecReceive(
+    _Inout_ QUIC_DATAGRAM_FEC* Fec,
+    _In_ uint16_t Length,
+    _In_reads_bytes_(Length)
+        const uint8_t* Data,
+    _Out_ QUIC_BUFFER* Payload,
+    _Out_ QUIC_BUFFER* Recovered
+    )
+{
+    Payload->Buffer = NULL;
+    Payload->Length = 0;
+    Recovered->Buffer = NULL;
+    Recovered->Length = 0;
+
+    if (Length < QUIC_DATAGRAM_FEC_HEADER_LENGTH) {
+        return FALSE;
+    }
+
+    const uint8_t Type = Data[0];
+    const uint16_t BlockId = (uint16_t)((Data[1] << 8) | Data[2]);
+    const uint8_t Value = Data[3];
+    Data += QUIC_DATAGRAM_FEC_HEADER_LENGTH;
+    Length -= QUIC_DATAGRAM_FEC_HEADER_LENGTH;
+
+    if (Type == QUIC_DATAGRAM_FEC_TYPE_SOURCE) {
+        if (Value >= QUIC_DATAGRAM_FEC_MAX_BLOCK_SIZE) {
+            return FALSE;
+        }
+        Payload->Buffer = (uint8_t*)Data;
+        Payload->Length = Length;
+
+    } else if (Type == QUIC_DATAGRAM_FEC_TYPE_REPAIR) {
+        if (Value < 2 || Value > QUIC_DATAGRAM_FEC_MAX_BLOCK_SIZE ||
+            Length < sizeof(uint16_t) || Length > QUIC_DATAGRAM_FEC_MAX_SYMBOL) {
+            return FALSE;
+        }
+
+    } else {
+        return FALSE;
+    }
+
+    QUIC_DATAGRAM_FEC_RECV_BLOCK* Block = QuicDatagramFecGetRecvBlock(Fec, BlockId);
+    if (Block == NULL) {
+        return TRUE; // Too old to recover anything from.
+    }
+
+    if (Type == QUIC_DATAGRAM_FEC_TYPE_SOURCE) {
+        const uint32_t Bit = 1u << Value;
+        if (Block->ReceivedMask & Bit) {
+            //
+            // Already recovered from the repair datagram.
+            //
+            Payload->Buffer = NULL;
+            Payload->Length = 0;
+            return TRUE;
+        }
+        Block->ReceivedMask |= Bit;
+        if (Block->Done) {
+            return TRUE;
+        }
+        if (Block->SourceCount != 0 && Value >= Block->SourceCount) {
+            return FALSE;
+        }
+        if (sizeof(uint16_t) + Length > QUIC_DATAGRAM_FEC_MAX_SYMBOL) {
+            Block->Done = TRUE; // Can't be part of a repair symbol.
+            return TRUE;
+        }
+
+        const uint8_t Prefix[sizeof(uint16_t)] = { (uint8_t)(Length >> 8), (uint8_t)Length };
+        QuicDatagramFecXor(
+            Block->Symbol, &Block->SymbolLength, 0, Prefix, sizeof(Prefix));
+        QuicDatagramFecXor(
+            Block->Symbol, &Block->SymbolLength, sizeof(Prefix), Data, Length);
+
+    } else {
+        if (Block->SourceCount != 0 || Block->Done) {
+            return TRUE;
+        }
+        if (((uint64_t)Block->ReceivedMask >> Value) != 0) {
+            return FALSE; // A source datagram's index is past the block.
+        }
+        Block->SourceCount = Value;
+        QuicDatagramFecXor(
+            Block->Symbol, &Block->SymbolLength, 0, Data, Length);
+    }
+
+    QuicDatagramFecTryRecover(Block, Recovered);
+
+    return TRUE;
+}
@@ -0,0 +1,186 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+--*/
+
+#pragma once
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//
+// Every datagram sent with FEC starts with a header: its type, the block it
+// belongs to (16 bits, big endian) and, for a source datagram, its index in
+// the block or, for a repair datagram, the number of source datagrams in the
+// block.
+//
+#define QUIC_DATAGRAM_FEC_TYPE_SOURCE       0
+#define QUIC_DATAGRAM_FEC_TYPE_REPAIR       1
+#define QUIC_DATAGRAM_FEC_HEADER_LENGTH     4u
+
+//
+// A repair datagram carries the XOR of the block's source datagrams, each
+// prefixed with its 16-bit length, so source datagrams must leave room for
+// both the header and that length.
+//
+#define QUIC_DATAGRAM_FEC_OVERHEAD          ((uint32_t)(QUIC_DATAGRAM_FEC_HEADER_LENGTH + sizeof(uint16_t)))
+
+//
+// The largest repair symbol (a length prefixed datagram).
+//
+#define QUIC_DATAGRAM_FEC_MAX_SYMBOL        CXPLAT_MAX_MTU
+
+//
+// The number of most recent blocks the receiver can still recover from.
+//
+#define QUIC_DATAGRAM_FEC_RECV_BLOCKS       4
+
+//
+// The block size is picked so that a block is expected to lose a quarter of a
+// datagram, i.e. 250 / the loss rate in per mille.
+//
+#define QUIC_DATAGRAM_FEC_LOSS_TARGET       250
+
+//
+// The number of packets sent between updates of the loss rate estimate.
+//
+#define QUIC_DATAGRAM_FEC_LOSS_SAMPLE       16
+
+typedef struct QUIC_DATAGRAM_FEC_RECV_BLOCK {
+
+    uint16_t BlockId;
+    BOOLEAN InUse : 1;
+
+    //
+    // Set once every source datagram of the block was received or recovered,
+    // or the block can't be recovered from.
+    //
+    BOOLEAN Done : 1;
+
+    //
+    // The number of source datagrams in the block, from its repair datagram.
+    // Zero until the repair datagram is received.
+    //
+    uint8_t SourceCount;
+
+    //
+    // A bit per source datagram received (or recovered).
+    //
+    uint32_t ReceivedMask;
+
+    //
+    // The XOR of the length prefixed datagrams received so far, including the
+    // repair symbol, and the length of the longest one.
+    //
+    uint16_t SymbolLength;
+    uint8_t Symbol[QUIC_DATAGRAM_FEC_MAX_SYMBOL];
+
+} QUIC_DATAGRAM_FEC_RECV_BLOCK;
+
+//
+// The FEC state of a connection's datagrams, only allocated once both
+// endpoints enabled it (QUIC_PARAM_CONN_DATAGRAM_FEC).
+//
+typedef struct QUIC_DATAGRAM_FEC {
+
+    uint8_t MinBlockSize;
+    uint8_t MaxBlockSize;
+
+    //
+    // The block being sent: its ID, size, how many source datagrams were sent
+    // so far and whether they're all sent and the repair datagram is next.
+    //
+    uint16_t SendBlockId;
+    uint8_t SendBlockSize;
+    uint8_t SendCount;
+    BOOLEAN RepairPending;
+
+    //
+    // Smoothed loss rate, in per mille, and the connection's sent and lost
+    // packet counts when it was last updated.
+    //
+    uint16_t LossRate;
+    uint64_t LastSentPackets;
+    uint64_t LastLostPackets;
+
+    //
+    // The XOR of the length prefixed source datagrams of the block being sent,
+    // and the length of the longest one.
+    //
+    uint16_t SendSymbolLength;
+    uint8_t SendSymbol[QUIC_DATAGRAM_FEC_MAX_SYMBOL];
+
+    QUIC_DATAGRAM_FEC_RECV_BLOCK RecvBlocks[QUIC_DATAGRAM_FEC_RECV_BLOCKS];
+
+} QUIC_DATAGRAM_FEC;
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicDatagramFecInitialize(
+    _Out_ QUIC_DATAGRAM_FEC* Fec,
+    _In_ const QUIC_DATAGRAM_FEC_CONFIG* Config
+    );
+
+//
+// Writes the header of the next source datagram (or, if RepairPending is set,
+// of the repair datagram).
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicDatagramFecWriteHeader(
+    _In_ const QUIC_DATAGRAM_FEC* Fec,
+    _Out_writes_(QUIC_DATAGRAM_FEC_HEADER_LENGTH)
+        uint8_t* Header
+    );
+
+//
+// Adds a source datagram that was just framed to the block's repair symbol.
+// Sets RepairPending once the block is complete.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicDatagramFecOnSourceSent(
+    _Inout_ QUIC_DATAGRAM_FEC* Fec,
+    _In_reads_(BufferCount)
+        const QUIC_BUFFER* const Buffers,
+    _In_ uint32_t BufferCount,
+    _In_ uint16_t TotalLength
+    );
+
+//
+// Starts the next block once its repair datagram was framed, sizing it from
+// the connection's sent and (suspected) lost packet counts.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicDatagramFecOnRepairSent(
+    _Inout_ QUIC_DATAGRAM_FEC* Fec,
+    _In_ uint64_t SentPackets,
+    _In_ uint64_t LostPackets
+    );
+
+//
+// Processes a received datagram. Payload is set to the app's datagram, if
+// any (it has no Buffer for repair datagrams). Recovered is set to a lost
+// datagram of the block that could be rebuilt, if any; it points into the FEC
+// state, so it must be used before the next call. Returns FALSE if the
+// datagram is malformed.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+_Success_(return != FALSE)
+BOOLEAN
+QuicDatagramFecReceive(
+    _Inout_ QUIC_DATAGRAM_FEC* Fec,
+    _In_ uint16_t Length,
+    _In_reads_bytes_(Length)
+        const uint8_t* Data,
+    _Out_ QUIC_BUFFER* Payload,
+    _Out_ QUIC_BUFFER* Recovered
+    );
+
+#if defined(__cplusplus)
+}
+#endif
@@ -0,0 +1,166 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Registration event queue, used instead of the callback handlers when the
+    app has set QUIC_PARAM_REGISTRATION_EVENT_QUEUE_ENABLED.
+
+    The queue is a ring buffer protected by a dispatch lock, which doubles in
+    size when full. A manual reset event is kept set while the queue is
+    non-empty so that app threads can block waiting for events.
+
+--*/
+
+#include "precomp.h"
+#ifdef QUIC_CLOG
+#include "event_queue.c.clog.h"
+#endif
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicEventQueueInitialize(
+    _Out_ QUIC_EVENT_QUEUE* Queue
+    )
+{
+    CxPlatZeroMemory(Queue, sizeof(*Queue));
+    CxPlatDispatchLockInitialize(&Queue->Lock);
+    CxPlatEventInitialize(&Queue->Ready, TRUE, FALSE);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicEventQueueUninitialize(
+    _In_ QUIC_EVENT_QUEUE* Queue
+    )
+{
+    if (Queue->Events != NULL) {
+        CXPLAT_FREE(Queue->Events, QUIC_POOL_EVENT_QUEUE);
+    }
+    CxPlatEventUninitialize(Queue->Ready);
+    CxPlatDispatchLockUninitialize(&Queue->Lock);
+}
+
+//
+// Doubles the capacity of the ring buffer, moving the queued events to the
+// start of the new buffer.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+static
+BOOLEAN
+QuicEventQueueGrow(
+    _Inout_ QUIC_EVENT_QUEUE* Queue
+    )
+{
+    const uint32_t NewCapacity =
+        Queue->Capacity == 0 ? QUIC_EVENT_QUEUE_INITIAL_CAPACITY : Queue->Capacity * 2;
+    if (NewCapacity < Queue->Capacity) {
+        return FALSE;
+    }
+
+    QUIC_QUEUED_EVENT* NewEvents =
+        CXPLAT_ALLOC_NONPAGED(
+            (size_t)NewCapacity * sizeof(QUIC_QUEUED_EVENT),
+            QUIC_POOL_EVENT_QUEUE);
+    if (NewEvents == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "event queue",
+            (size_t)NewCapacity * sizeof(QUIC_QUEUED_EVENT));
+        return FALSE;
+    }
+
+    for (uint32_t i = 0; i < Queue->Count; ++i) {
+        NewEvents[i] = Queue->Events[(Queue->Head + i) & (Queue->Capacity - 1)];
+    }
+    if (Queue->Events != NULL) {
+        CXPLAT_FREE(Queue->Events, QUIC_POOL_EVENT_QUEUE);
+    }
+
+    Queue->Events = NewEvents;
+    Queue->Capacity = NewCapacity;
+    Queue->Head = 0;
+    return TRUE;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicEventQueuePost(
+    _In_ QUIC_EVENT_QUEUE* Queue,
+    _In_ const QUIC_QUEUED_EVENT* Event
+    )
+{
+    BOOLEAN Posted = FALSE;
+
+    CxPlatDispatchLockAcquire(&Queue->Lock);
+    if (Queue->Count < Queue->Capacity || QuicEventQueueGrow(Queue)) {
+        Queue->Events[(Queue->Head + Queue->Count) & (Queue->Capacity - 1)] = *Event;
+        if (Queue->Count++ == 0) {
+            CxPlatEventSet(Queue->Ready);
+        }
+        Posted = TRUE;
+    }
+    CxPlatDispatchLockRelease(&Queue->Lock);
+
+    return Posted;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+uint32_t
+QuicEventQueueDequeue(
+    _In_ QUIC_EVENT_QUEUE* Queue,
+    _Out_writes_to_(EventCount, return)
+        QUIC_QUEUED_EVENT* Events,
+    _In_ uint32_t EventCount,
+    _In_ uint32_t TimeoutMs
+    )
+{
+    const uint64_t StartTimeMs = CxPlatTimeMs64();
+    uint32_t Dequeued = 0;
+
+    while (TRUE) {
+        CxPlatDispatchLockAcquire(&Queue->Lock);
+        while (Dequeued < EventCount && Queue->Count != 0) {
+            QUIC_QUEUED_EVENT* Event = &Events[Dequeued++];
+            *Event = Queue->Events[Queue->Head];
+            Queue->Head = (Queue->Head + 1) & (Queue->Capacity - 1);
+            Queue->Count--;
+
+            //
+            // The receive buffers are carried in the queued event itself, so
+            // point the event at the app's copy of them.
+            //
+            if (Event->Type == QUIC_QUEUED_EVENT_TYPE_STREAM &&
+                Event->STREAM.Type == QUIC_STREAM_EVENT_RECEIVE) {
+                Event->STREAM.RECEIVE.Buffers = Event->ReceiveBuffers;
+            }
+        }
+        if (Queue->Count == 0) {
+            CxPlatEventReset(Queue->Ready);
+        }
+        CxPlatDispatchLockRelease(&Queue->Lock);
+
+        if (Dequeued != 0 || TimeoutMs == 0) {
+            break;
+        }
+
+        //
+        // Wait for more events. Another thread may take them first, in which
+        // case keep waiting for whatever is left of the timeout.
+        //
+        if (TimeoutMs == UINT32_MAX) {
+            CxPlatEventWaitForever(Queue->Ready);
+        } else {
+            const uint64_t ElapsedMs = CxPlatTimeDiff64(StartTimeMs, CxPlatTimeMs64());
+            if (ElapsedMs >= TimeoutMs ||
+                !CxPlatEventWaitWithTimeout(Queue->Ready, (uint32_t)(TimeoutMs - ElapsedMs))) {
+                break;
+            }
+        }
+    }
+
+    return Dequeued;
+}
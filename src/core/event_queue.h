@@ -0,0 +1,83 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+--*/
+
+#pragma once
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//
+// A registration-wide queue of connection and stream events, used instead of
+// the callback handlers when the app has enabled it on the registration. The
+// workers post copies of the events and the app's threads dequeue them in
+// batches, either polling or waiting for the queue to become non-empty.
+//
+// Events are kept in a single growable ring buffer, so the events of any one
+// connection (always posted from its worker) are dequeued in the order they
+// were posted.
+//
+typedef struct QUIC_EVENT_QUEUE {
+
+    CXPLAT_DISPATCH_LOCK Lock;
+
+    //
+    // Manual reset event, set while the queue is non-empty.
+    //
+    CXPLAT_EVENT Ready;
+
+    //
+    // Ring buffer of Capacity (a power of 2) events, starting at Head.
+    //
+    QUIC_QUEUED_EVENT* Events;
+    uint32_t Capacity;
+    uint32_t Head;
+    uint32_t Count;
+
+} QUIC_EVENT_QUEUE;
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicEventQueueInitialize(
+    _Out_ QUIC_EVENT_QUEUE* Queue
+    );
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicEventQueueUninitialize(
+    _In_ QUIC_EVENT_QUEUE* Queue
+    );
+
+//
+// Posts a copy of the event. Returns FALSE if the queue couldn't grow to hold
+// it, in which case the caller falls back to the callback handler.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicEventQueuePost(
+    _In_ QUIC_EVENT_QUEUE* Queue,
+    _In_ const QUIC_QUEUED_EVENT* Event
+    );
+
+//
+// Dequeues up to EventCount events, waiting up to TimeoutMs (zero to just
+// poll, UINT32_MAX to wait forever) for the queue to become non-empty.
+// Returns the number of events dequeued.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+uint32_t
+QuicEventQueueDequeue(
+    _In_ QUIC_EVENT_QUEUE* Queue,
+    _Out_writes_to_(EventCount, return)
+        QUIC_QUEUED_EVENT* Events,
+    _In_ uint32_t EventCount,
+    _In_ uint32_t TimeoutMs
+    );
+
+#if defined(__cplusplus)
+}
+#endif
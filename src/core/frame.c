@@ -1166,6 +1166,9 @@ QuicConnCloseFrameDecode(
 _Success_(return != FALSE)
 BOOLEAN
 QuicDatagramFrameEncodeEx(
+    _In_reads_bytes_(PrefixLength)
+        const uint8_t* Prefix,
+    _In_ uint8_t PrefixLength,
     _In_reads_(BufferCount)
         const QUIC_BUFFER* const Buffers,
     _In_ uint32_t BufferCount,
@@ -1181,6 +1184,7 @@ QuicDatagramFrameEncodeEx(
         0b0011000
     }}};
 
+    TotalLength += PrefixLength;
     uint16_t RequiredLength =
         sizeof(uint8_t) +     // Type
         (Type.LEN ? QuicVarIntSize(TotalLength) : 0) +
@@ -1195,6 +1199,10 @@ QuicDatagramFrameEncodeEx(
     if (Type.LEN) {
         Buffer = QuicVarIntEncode(TotalLength, Buffer);
     }
+    if (PrefixLength != 0) {
+        CxPlatCopyMemory(Buffer, Prefix, PrefixLength);
+        Buffer += PrefixLength;
+    }
     for (uint32_t i = 0; i < BufferCount; ++i) {
         if (Buffers[i].Length != 0) {
             CxPlatCopyMemory(Buffer, Buffers[i].Buffer, Buffers[i].Length);
@@ -1307,6 +1315,26 @@ QuicAckFrequencyFrameDecode(
     return TRUE;
 }
 
+_Success_(return != FALSE)
+BOOLEAN
+QuicImmediateAckFrameEncode(
+    _Inout_ uint16_t* Offset,
+    _In_ uint16_t BufferLength,
+    _Out_writes_to_(BufferLength, *Offset) uint8_t* Buffer
+    )
+{
+    uint16_t RequiredLength = QuicVarIntSize(QUIC_FRAME_IMMEDIATE_ACK);
+
+    if (BufferLength < *Offset + RequiredLength) {
+        return FALSE;
+    }
+
+    QuicVarIntEncode(QUIC_FRAME_IMMEDIATE_ACK, Buffer + *Offset);
+    *Offset += RequiredLength;
+
+    return TRUE;
+}
+
 _Success_(return != FALSE)
 BOOLEAN
 QuicTimestampFrameEncode(
@@ -1387,10 +1415,7 @@ QuicFrameLog(
 
     case QUIC_FRAME_PADDING: {
         uint16_t Start = *Offset;
-        while (*Offset < PacketLength &&
-            Packet[*Offset] == QUIC_FRAME_PADDING) {
-            (*Offset) += sizeof(uint8_t);
-        }
+        QuicPaddingFrameSkip(PacketLength, Packet, Offset);
         QuicTraceLogVerbose(
             FrameLogPadding,
             "[%c][%cX][%llu]   PADDING Len:%hu",
@@ -815,6 +815,9 @@ typedef struct _QUIC_DATAGRAM_EX {
 _Success_(return != FALSE)
 BOOLEAN
 QuicDatagramFrameEncodeEx(
+    _In_reads_bytes_(PrefixLength)
+        const uint8_t* Prefix,
+    _In_ uint8_t PrefixLength,
     _In_reads_(BufferCount)
         const QUIC_BUFFER* const Buffers,
     _In_ uint32_t BufferCount,
@@ -871,6 +874,19 @@ QuicAckFrequencyFrameDecode(
     _Out_ QUIC_ACK_FREQUENCY_EX* Frame
     );
 
+//
+// QUIC_IMMEDIATE_ACK Encoding
+//
+
+_Success_(return != FALSE)
+BOOLEAN
+QuicImmediateAckFrameEncode(
+    _Inout_ uint16_t* Offset,
+    _In_ uint16_t BufferLength,
+    _Out_writes_to_(BufferLength, *Offset)
+        uint8_t* Buffer
+    );
+
 //
 // QUIC_FRAME_TIMESTAMP Encoding/Decoding
 //
@@ -963,6 +979,41 @@ QuicStreamFrameSkip(
     }
 }
 
+//
+// Skips over a run of PADDING frames. Padding is all zero bytes, so whole
+// machine words are compared at a time before finishing byte by byte.
+//
+CXPLAT_STATIC_ASSERT(
+    QUIC_FRAME_PADDING == 0,
+    "Bulk padding skip assumes zero padding bytes");
+
+inline
+void
+QuicPaddingFrameSkip(
+    _In_ uint16_t BufferLength,
+    _In_reads_bytes_(BufferLength)
+        const uint8_t * const Buffer,
+    _Inout_
+    _Deref_in_range_(0, BufferLength)
+    _Deref_out_range_(0, BufferLength)
+        uint16_t* Offset
+    )
+{
+    uint16_t i = *Offset;
+    while (i + sizeof(uint64_t) <= BufferLength) {
+        uint64_t Word;
+        memcpy(&Word, Buffer + i, sizeof(Word));
+        if (Word != 0) {
+            break;
+        }
+        i += sizeof(uint64_t);
+    }
+    while (i < BufferLength && Buffer[i] == QUIC_FRAME_PADDING) {
+        i += sizeof(uint8_t);
+    }
+    *Offset = i;
+}
+
 //
 // Logs all the frames in a decrypted packet.
 //
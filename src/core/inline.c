@@ -20,6 +20,26 @@ Abstract:
 #include "inline.c.clog.h"
 #endif
 
+QUIC_CID_HASH_ENTRY*
+QuicCidAllocSource(
+    _In_ uint8_t Length
+    );
+
+void
+QuicCidFreeSource(
+    _In_ __drv_freesMem(Mem) QUIC_CID_HASH_ENTRY* Entry
+    );
+
+QUIC_CID_LIST_ENTRY*
+QuicCidAllocDestination(
+    _In_ uint8_t Length
+    );
+
+void
+QuicCidFreeDestination(
+    _In_ __drv_freesMem(Mem) QUIC_CID_LIST_ENTRY* Entry
+    );
+
 QUIC_CID_LIST_ENTRY*
 QuicCidNewDestination(
     _In_ uint8_t Length,
@@ -134,6 +154,17 @@ QuicStreamFrameSkip(
     _Inout_ uint16_t* Offset
     );
 
+void
+QuicPaddingFrameSkip(
+    _In_ uint16_t BufferLength,
+    _In_reads_bytes_(BufferLength)
+        const uint8_t * const Buffer,
+    _Inout_
+    _Deref_in_range_(0, BufferLength)
+    _Deref_out_range_(0, BufferLength)
+        uint16_t* Offset
+    );
+
 BOOLEAN
 QuicIsVersionSupported(
     _In_ uint32_t Version // Network Byte Order
@@ -186,6 +217,29 @@ QuicPerfCounterTrySnapShot(
     _In_ uint64_t TimeNow
     );
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicPerfHistogramRecord(
+    _In_ QUIC_PERF_HISTOGRAMS Type,
+    _In_ uint64_t ValueUs
+    );
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicPerfExportTryUpdate(
+    _In_ uint64_t TimeNow
+    );
+
+#ifdef QUIC_STAGE_CYCLES
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicStageCyclesRecord(
+    _In_ QUIC_PERF_STAGES Stage,
+    _In_ uint64_t Cycles,
+    _In_ uint32_t Calls
+    );
+#endif
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 void
 QuicStreamAddRef(
@@ -367,6 +421,13 @@ QuicCongestionControlOnEcn(
     _In_ const QUIC_ECN_EVENT* EcnEvent
     );
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicCongestionControlSetSavedState(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_CONGESTION_CONTROL_SAVED_STATE* SavedState
+    );
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 BOOLEAN
 QuicCongestionControlOnSpuriousCongestionEvent(
@@ -409,6 +470,12 @@ QuicCongestionControlSetAppLimited(
     _In_ struct QUIC_CONGESTION_CONTROL* Cc
     );
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicCongestionControlIsInRecovery(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    );
+
 QUIC_CONNECTION*
 QuicCongestionControlGetConnection(
     _In_ const QUIC_CONGESTION_CONTROL* Cc
@@ -822,3 +889,99 @@ BOOLEAN
 QuicOperationHasPriority(
     _In_ QUIC_OPERATION_QUEUE* OperQ
     );
+
+void
+QuicRecvChunkInitialize(
+    _Inout_ QUIC_RECV_CHUNK* Chunk,
+    _In_ uint32_t AllocLength
+    );
+
+BOOLEAN
+QuicMtuDiscoveryProbeCanCarryData(
+    _In_ const QUIC_MTU_DISCOVERY* MtuDiscovery
+    );
+
+BOOLEAN
+QuicPacketBuilderIsFlushBudgetExhausted(
+    _In_ const QUIC_PACKET_BUILDER* Builder
+    );
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_WORKER*
+QuicWorkerPoolGetPartitionWorker(
+    _In_ QUIC_WORKER_POOL* WorkerPool,
+    _In_ uint16_t PartitionIndex
+    );
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicWorkerIsFolded(
+    _In_ const QUIC_WORKER* Worker
+    );
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_LIBRARY_PP*
+QuicLibraryGetPartitionPerProc(
+    uint16_t PartitionIndex
+    );
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void*
+QuicObjectReserveAlloc(
+    _Inout_ QUIC_OBJECT_RESERVE* Reserve,
+    _Inout_ CXPLAT_POOL* Pool
+    );
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicObjectReserveFree(
+    _Inout_ QUIC_OBJECT_RESERVE* Reserve,
+    _Inout_ CXPLAT_POOL* Pool,
+    _In_ void* Entry
+    );
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_MEMORY_PRESSURE_LEVEL
+QuicLibraryGetMemoryPressure(
+    void
+    );
+
+uint32_t
+QuicLatencyHistogramBucket(
+    _In_ uint32_t Value
+    );
+
+void
+QuicLatencyHistogramRecord(
+    _Inout_ QUIC_LATENCY_HISTOGRAM* Histogram,
+    _In_ uint64_t ValueUs
+    );
+
+BOOLEAN
+QuicCaptureSample(
+    _Inout_ QUIC_CAPTURE_BUFFER* Buffer,
+    _In_ uint32_t SampleRate
+    );
+
+void
+QuicConnQlog(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ QUIC_QLOG_EVENT_TYPE Type,
+    _In_ uint8_t PacketType,
+    _In_ uint64_t Value0,
+    _In_ uint64_t Value1,
+    _In_ uint64_t Value2
+    );
+
+BOOLEAN
+QuicConnPacketCaptureSample(
+    _In_ QUIC_CONNECTION* Connection
+    );
+
+void
+QuicConnFlightRecord(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ QUIC_FLIGHT_RECORDER_EVENT_TYPE Type,
+    _In_ uint64_t Value,
+    _In_ uint32_t Detail
+    );
@@ -0,0 +1,52 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    A fixed size log-linear latency histogram: values below 4 get their own
+    bucket and every power of two above that is split into 4 linear buckets,
+    so each bucket is at most 25% wide. Recording a value is a few integer
+    operations and never allocates.
+
+--*/
+
+#pragma once
+
+//
+// Returns the index of the bucket that counts Value.
+//
+inline
+uint32_t
+QuicLatencyHistogramBucket(
+    _In_ uint32_t Value
+    )
+{
+    if (Value < 4) {
+        return Value;
+    }
+#ifdef _WIN32
+    unsigned long Exponent;
+    _BitScanReverse(&Exponent, Value);
+#else
+    const uint32_t Exponent = 31 - (uint32_t)__builtin_clz(Value);
+#endif
+    return 4 * ((uint32_t)Exponent - 1) + ((Value >> (Exponent - 2)) & 3);
+}
+
+inline
+void
+QuicLatencyHistogramRecord(
+    _Inout_ QUIC_LATENCY_HISTOGRAM* Histogram,
+    _In_ uint64_t ValueUs
+    )
+{
+    const uint32_t Value = ValueUs > UINT32_MAX ? UINT32_MAX : (uint32_t)ValueUs;
+    Histogram->Buckets[QuicLatencyHistogramBucket(Value)]++;
+    Histogram->Count++;
+    Histogram->Sum += ValueUs;
+    if (ValueUs > Histogram->Max) {
+        Histogram->Max = ValueUs;
+    }
+}
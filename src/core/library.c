@@ -18,6 +18,15 @@ QUIC_LIBRARY MsQuicLib = { 0 };
 
 QUIC_TRACE_RUNDOWN_CALLBACK QuicTraceRundown;
 
+#ifdef QUIC_USDT
+QUIC_USDT_DEFINE(packet_sent);
+QUIC_USDT_DEFINE(packet_recv);
+QUIC_USDT_DEFINE(packet_lost);
+QUIC_USDT_DEFINE(congestion_window);
+QUIC_USDT_DEFINE(oper_queue);
+QUIC_USDT_DEFINE(oper_dequeue);
+#endif
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicLibApplyLoadBalancingSetting(
@@ -47,6 +56,12 @@ MsQuicLibraryLoad(
         CxPlatLockInitialize(&MsQuicLib.Lock);
         CxPlatDispatchLockInitialize(&MsQuicLib.DatapathLock);
         CxPlatDispatchLockInitialize(&MsQuicLib.StatelessRetryKeysLock);
+        CxPlatDispatchLockInitialize(&MsQuicLib.LoadBalancingLock);
+        CxPlatDispatchLockInitialize(&MsQuicLib.PerfExportLock);
+        QuicPathMetricsCacheInitialize(&MsQuicLib.PathMetricsCache);
+        QuicTicketCacheInitialize(&MsQuicLib.TicketCache);
+        QuicAntiReplayInitialize(&MsQuicLib.AntiReplay);
+        QuicNetEmuInitialize(&MsQuicLib.NetEmu);
         CxPlatListInitializeHead(&MsQuicLib.Registrations);
         CxPlatListInitializeHead(&MsQuicLib.Bindings);
         QuicTraceRundownCallback = QuicTraceRundown;
@@ -56,6 +71,16 @@ MsQuicLibraryLoad(
         MsQuicLib.Version[2] = VER_PATCH;
         MsQuicLib.Version[3] = VER_BUILD_ID;
         MsQuicLib.GitHash = VER_GIT_HASH_STR;
+
+        const uint16_t DefaultProbeSizes[] = QUIC_DPLPMTUD_DEFAULT_PROBE_SIZES;
+        CXPLAT_STATIC_ASSERT(
+            ARRAYSIZE(DefaultProbeSizes) <= QUIC_MAX_MTU_PROBE_SIZES,
+            "Default probe sizes must fit in the table");
+        CxPlatCopyMemory(
+            MsQuicLib.MtuProbeSizes,
+            DefaultProbeSizes,
+            sizeof(DefaultProbeSizes));
+        MsQuicLib.MtuProbeSizeCount = (uint8_t)ARRAYSIZE(DefaultProbeSizes);
     }
 }
 
@@ -73,6 +98,12 @@ MsQuicLibraryUnload(
         QUIC_LIB_VERIFY(MsQuicLib.OpenRefCount == 0);
         QUIC_LIB_VERIFY(!MsQuicLib.InUse);
         MsQuicLib.Loaded = FALSE;
+        QuicNetEmuUninitialize(&MsQuicLib.NetEmu);
+        QuicAntiReplayUninitialize(&MsQuicLib.AntiReplay);
+        QuicTicketCacheUninitialize(&MsQuicLib.TicketCache);
+        QuicPathMetricsCacheUninitialize(&MsQuicLib.PathMetricsCache);
+        CxPlatDispatchLockUninitialize(&MsQuicLib.PerfExportLock);
+        CxPlatDispatchLockUninitialize(&MsQuicLib.LoadBalancingLock);
         CxPlatDispatchLockUninitialize(&MsQuicLib.StatelessRetryKeysLock);
         CxPlatDispatchLockUninitialize(&MsQuicLib.DatapathLock);
         CxPlatLockUninitialize(&MsQuicLib.Lock);
@@ -101,6 +132,87 @@ MsQuicCalculatePartitionMask(
     MsQuicLib.PartitionMask = PartitionCount;
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicObjectReserveInitialize(
+    _In_ uint32_t Size,
+    _In_ uint32_t Tag,
+    _Out_ QUIC_OBJECT_RESERVE* Reserve
+    )
+{
+    CxPlatDispatchLockInitialize(&Reserve->Lock);
+    Reserve->Head.Next = NULL;
+    Reserve->Depth = 0;
+    Reserve->TargetDepth = 0;
+    Reserve->Size = Size;
+    Reserve->Tag = Tag;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicObjectReserveUninitialize(
+    _Inout_ QUIC_OBJECT_RESERVE* Reserve
+    )
+{
+    CXPLAT_SLIST_ENTRY* Entry;
+    while ((Entry = CxPlatListPopEntry(&Reserve->Head)) != NULL) {
+        CXPLAT_FREE(Entry, Reserve->Tag);
+    }
+    Reserve->Depth = 0;
+    CxPlatDispatchLockUninitialize(&Reserve->Lock);
+}
+
+//
+// Sets the reserve's target depth and allocates objects until it is reached.
+// A lower target only takes effect as objects are allocated from it.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicObjectReserveFill(
+    _Inout_ QUIC_OBJECT_RESERVE* Reserve,
+    _In_ uint32_t TargetDepth
+    )
+{
+    Reserve->TargetDepth = TargetDepth;
+    while (Reserve->Depth < TargetDepth) {
+        CXPLAT_SLIST_ENTRY* Entry = CXPLAT_ALLOC_NONPAGED(Reserve->Size, Reserve->Tag);
+        if (Entry == NULL) {
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "reserve object",
+                Reserve->Size);
+            break;
+        }
+        CxPlatDispatchLockAcquire(&Reserve->Lock);
+        CxPlatListPushEntry(&Reserve->Head, Entry);
+        Reserve->Depth++;
+        CxPlatDispatchLockRelease(&Reserve->Lock);
+    }
+}
+
+//
+// Fills each partition's connection reserves up to the configured pre-warm
+// count, if it changed. Afterwards, the reserves refill as objects are freed.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicLibraryPrewarmPartitions(
+    void
+    )
+{
+    const uint32_t Count = MsQuicLib.Settings.ConnectionPoolPrewarmCount;
+    if (Count == MsQuicLib.ConnectionPoolPrewarmCount) {
+        return;
+    }
+    MsQuicLib.ConnectionPoolPrewarmCount = Count;
+    for (uint16_t i = 0; i < MsQuicLib.PartitionCount; ++i) {
+        QUIC_LIBRARY_PP* PerProc = QuicLibraryGetPartitionPerProc(i);
+        QuicObjectReserveFill(&PerProc->ConnectionReserve, Count);
+        QuicObjectReserveFill(&PerProc->PacketSpaceReserve, Count * QUIC_ENCRYPT_LEVEL_COUNT);
+    }
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 MsQuicLibraryFreePartitions(
@@ -110,15 +222,93 @@ MsQuicLibraryFreePartitions(
     if (MsQuicLib.PerProc) {
         for (uint16_t i = 0; i < MsQuicLib.ProcessorCount; ++i) {
             QUIC_LIBRARY_PP* PerProc = &MsQuicLib.PerProc[i];
+            QuicObjectReserveUninitialize(&PerProc->ConnectionReserve);
+            QuicObjectReserveUninitialize(&PerProc->PacketSpaceReserve);
             CxPlatPoolUninitialize(&PerProc->ConnectionPool);
             CxPlatPoolUninitialize(&PerProc->TransportParamPool);
             CxPlatPoolUninitialize(&PerProc->PacketSpacePool);
+            CxPlatPoolUninitialize(&PerProc->SourceCidPool);
+            CxPlatPoolUninitialize(&PerProc->DestCidPool);
+            QuicRecvChunkPoolUninitialize(&PerProc->RecvChunkPool);
             CxPlatLockUninitialize(&PerProc->ResetTokenLock);
             CxPlatHashFree(PerProc->ResetTokenHash);
+            CxPlatDispatchLockUninitialize(&PerProc->InitialSecretCacheLock);
         }
         CXPLAT_FREE(MsQuicLib.PerProc, QUIC_POOL_PERPROC);
         MsQuicLib.PerProc = NULL;
+        MsQuicLib.ConnectionPoolPrewarmCount = 0;
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+uint32_t
+QuicLibraryGetMaxPartitionCount(
+    void
+    )
+{
+    uint32_t MaxPartitionCount = QUIC_MAX_PARTITION_COUNT;
+    if (MsQuicLib.Storage != NULL) {
+        uint32_t MaxPartitionCountLen = sizeof(MaxPartitionCount);
+        CxPlatStorageReadValue(
+            MsQuicLib.Storage,
+            QUIC_SETTING_MAX_PARTITION_COUNT,
+            (uint8_t*)&MaxPartitionCount,
+            &MaxPartitionCountLen);
+        if (MaxPartitionCount == 0) {
+            MaxPartitionCount = QUIC_MAX_PARTITION_COUNT;
+        }
+    }
+    return MaxPartitionCount;
+}
+
+//
+// When the app didn't give an execution config and the process can't use
+// every processor (a restricted affinity mask or cgroup cpuset, or a cgroup
+// CPU quota), build one from the processors it can use. Otherwise there would
+// be a partition and worker per processor, most of them pinned to processors
+// the process never runs on, all competing for the few it does.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicLibraryDeriveExecutionConfig(
+    void
+    )
+{
+    uint32_t ProcessorCount = CxPlatProcAvailableCount();
+    if (MsQuicLib.ExecutionConfig != NULL ||
+        ProcessorCount == 0 ||
+        ProcessorCount >= MsQuicLib.ProcessorCount) {
+        return;
+    }
+
+    const uint32_t MaxPartitionCount = QuicLibraryGetMaxPartitionCount();
+    if (ProcessorCount > MaxPartitionCount) {
+        ProcessorCount = MaxPartitionCount;
+    }
+
+    const size_t ConfigSize =
+        QUIC_EXECUTION_CONFIG_MIN_SIZE + sizeof(uint16_t) * ProcessorCount;
+    QUIC_EXECUTION_CONFIG* Config =
+        CXPLAT_ALLOC_NONPAGED(ConfigSize, QUIC_POOL_EXECUTION_CONFIG);
+    if (Config == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "Execution config",
+            ConfigSize);
+        return; // Fall back to a partition per processor.
+    }
+
+    CxPlatZeroMemory(Config, ConfigSize);
+    Config->ProcessorCount = ProcessorCount;
+    for (uint32_t i = 0; i < ProcessorCount; ++i) {
+        Config->ProcessorList[i] = CxPlatProcAvailableIndex(i);
     }
+    MsQuicLib.ExecutionConfig = Config;
+
+    QuicTraceLogInfo(
+        LibraryExecutionConfigSet,
+        "[ lib] Setting execution config");
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -132,23 +322,14 @@ QuicLibraryInitializePartitions(
     MsQuicLib.ProcessorCount = (uint16_t)CxPlatProcCount();
     CXPLAT_FRE_ASSERT(MsQuicLib.ProcessorCount > 0);
 
+    QuicLibraryDeriveExecutionConfig();
+
     if (MsQuicLib.ExecutionConfig && MsQuicLib.ExecutionConfig->ProcessorCount) {
         MsQuicLib.PartitionCount = (uint16_t)MsQuicLib.ExecutionConfig->ProcessorCount;
     } else {
         MsQuicLib.PartitionCount = MsQuicLib.ProcessorCount;
 
-        uint32_t MaxPartitionCount = QUIC_MAX_PARTITION_COUNT;
-        if (MsQuicLib.Storage != NULL) {
-            uint32_t MaxPartitionCountLen = sizeof(MaxPartitionCount);
-            CxPlatStorageReadValue(
-                MsQuicLib.Storage,
-                QUIC_SETTING_MAX_PARTITION_COUNT,
-                (uint8_t*)&MaxPartitionCount,
-                &MaxPartitionCountLen);
-            if (MaxPartitionCount == 0) {
-                MaxPartitionCount = QUIC_MAX_PARTITION_COUNT;
-            }
-        }
+        const uint32_t MaxPartitionCount = QuicLibraryGetMaxPartitionCount();
         if (MsQuicLib.PartitionCount > MaxPartitionCount) {
             MsQuicLib.PartitionCount = (uint16_t)MaxPartitionCount;
         }
@@ -173,7 +354,13 @@ QuicLibraryInitializePartitions(
         CxPlatPoolInitialize(FALSE, sizeof(QUIC_CONNECTION), QUIC_POOL_CONN, &PerProc->ConnectionPool);
         CxPlatPoolInitialize(FALSE, sizeof(QUIC_TRANSPORT_PARAMETERS), QUIC_POOL_TP, &PerProc->TransportParamPool);
         CxPlatPoolInitialize(FALSE, sizeof(QUIC_PACKET_SPACE), QUIC_POOL_TP, &PerProc->PacketSpacePool);
+        CxPlatPoolInitialize(FALSE, sizeof(QUIC_CID_HASH_ENTRY) + QUIC_MAX_CONNECTION_ID_LENGTH_V1, QUIC_POOL_CIDHASH, &PerProc->SourceCidPool);
+        CxPlatPoolInitialize(FALSE, sizeof(QUIC_CID_LIST_ENTRY) + QUIC_MAX_CONNECTION_ID_LENGTH_V1, QUIC_POOL_CIDLIST, &PerProc->DestCidPool);
+        QuicObjectReserveInitialize(sizeof(QUIC_CONNECTION), QUIC_POOL_CONN, &PerProc->ConnectionReserve);
+        QuicObjectReserveInitialize(sizeof(QUIC_PACKET_SPACE), QUIC_POOL_TP, &PerProc->PacketSpaceReserve);
+        QuicRecvChunkPoolInitialize(&PerProc->RecvChunkPool);
         CxPlatLockInitialize(&PerProc->ResetTokenLock);
+        CxPlatDispatchLockInitialize(&PerProc->InitialSecretCacheLock);
     }
 
     uint8_t ResetHashKey[20];
@@ -194,6 +381,8 @@ QuicLibraryInitializePartitions(
     }
     CxPlatSecureZeroMemory(ResetHashKey, sizeof(ResetHashKey));
 
+    QuicLibraryPrewarmPartitions();
+
     return QUIC_STATUS_SUCCESS;
 }
 
@@ -293,6 +482,60 @@ QuicPerfCounterSnapShot(
         sizeof(PerfCounterSamples));
 }
 
+//
+// Writes every processor's perf counters and histograms to the app's export
+// buffer. If the buffer has fewer entries than there are processors, the
+// extra processors are added into the entries modulo their count.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicPerfExportUpdate(
+    _In_ uint64_t TimeNow
+    )
+{
+    CxPlatDispatchLockAcquire(&MsQuicLib.PerfExportLock);
+
+    QUIC_PERF_EXPORT_HEADER* Header = (QUIC_PERF_EXPORT_HEADER*)MsQuicLib.PerfExport.Buffer;
+    if (Header == NULL || MsQuicLib.PerProc == NULL) {
+        goto Exit;
+    }
+
+    QUIC_PERF_EXPORT_PROCESSOR* Entries = (QUIC_PERF_EXPORT_PROCESSOR*)(Header + 1);
+    const uint32_t EntryCount = MsQuicLib.PerfExportEntryCount;
+
+    InterlockedIncrement64(&Header->Sequence);
+    CxPlatZeroMemory(Entries, EntryCount * sizeof(QUIC_PERF_EXPORT_PROCESSOR));
+
+    for (uint32_t i = 0; i < MsQuicLib.ProcessorCount; ++i) {
+        const QUIC_LIBRARY_PP* PerProc = &MsQuicLib.PerProc[i];
+        QUIC_PERF_EXPORT_PROCESSOR* Entry = &Entries[i % EntryCount];
+
+        for (uint32_t j = 0; j < QUIC_PERF_COUNTER_MAX; ++j) {
+            Entry->Counters[j] += PerProc->PerfCounters[j];
+        }
+
+        for (uint32_t j = 0; j < QUIC_PERF_HISTOGRAM_MAX; ++j) {
+            const QUIC_PERF_HISTOGRAM* Source = &PerProc->PerfHistograms[j];
+            QUIC_LATENCY_HISTOGRAM* Dest = &Entry->Histograms[j];
+            Dest->Count += (uint64_t)Source->Count;
+            Dest->Sum += (uint64_t)Source->Sum;
+            if ((uint64_t)Source->Max > Dest->Max) {
+                Dest->Max = (uint64_t)Source->Max;
+            }
+            for (uint32_t k = 0; k < QUIC_LATENCY_HISTOGRAM_BUCKET_COUNT; ++k) {
+                Dest->Buckets[k] += (uint32_t)Source->Buckets[k];
+            }
+        }
+    }
+
+    Header->UpdateTimeUs = TimeNow;
+    InterlockedIncrement64(&Header->Sequence);
+
+Exit:
+
+    CxPlatDispatchLockRelease(&MsQuicLib.PerfExportLock);
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 MsQuicLibraryOnSettingsChanged(
@@ -312,6 +555,25 @@ MsQuicLibraryOnSettingsChanged(
         (MsQuicLib.Settings.RetryMemoryLimit * CxPlatTotalMemory) / UINT16_MAX;
     QuicLibraryEvaluateSendRetryState();
 
+    if (MsQuicLib.PerProc != NULL) {
+        QuicLibraryPrewarmPartitions();
+    }
+
+    //
+    // Rebuild the bindings' precomputed Version Negotiation packets in case
+    // the supported versions changed. On failure, the old list is kept.
+    //
+    CxPlatDispatchLockAcquire(&MsQuicLib.DatapathLock);
+    for (CXPLAT_LIST_ENTRY* Link = MsQuicLib.Bindings.Flink;
+        Link != &MsQuicLib.Bindings;
+        Link = Link->Flink) {
+        QUIC_BINDING* Binding = CXPLAT_CONTAINING_RECORD(Link, QUIC_BINDING, Link);
+        if (Binding->ServerOwned) {
+            (void)QuicBindingUpdateVersionNegotiation(Binding);
+        }
+    }
+    CxPlatDispatchLockRelease(&MsQuicLib.DatapathLock);
+
     if (UpdateRegistrations) {
         CxPlatLockAcquire(&MsQuicLib.Lock);
 
@@ -355,14 +617,31 @@ MsQuicLibraryInitialize(
 {
     QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
     BOOLEAN PlatformInitialized = FALSE;
+    BOOLEAN BindingsTableInitialized = FALSE;
+
+    CxPlatZeroMemory(&MsQuicLib.StartupTimings, sizeof(MsQuicLib.StartupTimings));
+    const uint64_t StartTime = CxPlatTimeUs64();
 
     Status = CxPlatInitialize();
     if (QUIC_FAILED(Status)) {
         goto Error; // Cannot log anything if platform failed to initialize.
     }
+    MsQuicLib.StartupTimings.PlatformInitUs = CxPlatTimeDiff64(StartTime, CxPlatTimeUs64());
+    MsQuicLib.StartupTimings.CryptoInitUs = CxPlatCryptInitTimeUs;
     CxPlatWorkerPoolInit(&MsQuicLib.WorkerPool);
     PlatformInitialized = TRUE;
 
+    if (!CxPlatHashtableInitializeEx(&MsQuicLib.BindingsTable, CXPLAT_HASH_MIN_SIZE)) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "bindings hash table",
+            0);
+        Status = QUIC_STATUS_OUT_OF_MEMORY;
+        goto Error;
+    }
+    BindingsTableInitialized = TRUE;
+
     CXPLAT_DBG_ASSERT(US_TO_MS(CxPlatGetTimerResolution()) + 1 <= UINT8_MAX);
     MsQuicLib.TimerResolutionMs = (uint8_t)US_TO_MS(CxPlatGetTimerResolution()) + 1;
 
@@ -432,6 +711,8 @@ MsQuicLibraryInitialize(
         MsQuicLib.Version[2],
         MsQuicLib.Version[3]);
 
+    MsQuicLib.StartupTimings.LibraryInitUs = CxPlatTimeDiff64(StartTime, CxPlatTimeUs64());
+
 #ifdef CxPlatVerifierEnabled
     uint32_t Flags;
     MsQuicLib.IsVerifying = CxPlatVerifierEnabled(Flags);
@@ -459,6 +740,9 @@ Error:
             CXPLAT_FREE(MsQuicLib.DefaultCompatibilityList, QUIC_POOL_DEFAULT_COMPAT_VER_LIST);
             MsQuicLib.DefaultCompatibilityList = NULL;
         }
+        if (BindingsTableInitialized) {
+            CxPlatHashtableUninitialize(&MsQuicLib.BindingsTable);
+        }
         if (PlatformInitialized) {
             CxPlatWorkerPoolUninit(&MsQuicLib.WorkerPool);
             CxPlatUninitialize();
@@ -554,6 +838,9 @@ MsQuicLibraryUninitialize(
     // first being cleaned up all listeners and connections.
     //
     CXPLAT_TEL_ASSERT(CxPlatListIsEmpty(&MsQuicLib.Bindings));
+    CxPlatHashtableUninitialize(&MsQuicLib.BindingsTable);
+
+    QuicNetEmuStop(&MsQuicLib.NetEmu);
 
     MsQuicLibraryFreePartitions();
 
@@ -562,6 +849,10 @@ MsQuicLibraryUninitialize(
         MsQuicLib.StatelessRetryKeys[i] = NULL;
     }
 
+    CxPlatHpKeyFree(MsQuicLib.LoadBalancingKey);
+    MsQuicLib.LoadBalancingKey = NULL;
+    MsQuicLib.LoadBalancingConfigSet = FALSE;
+
     QuicSettingsCleanup(&MsQuicLib.Settings);
 
     CXPLAT_FREE(MsQuicLib.DefaultCompatibilityList, QUIC_POOL_DEFAULT_COMPAT_VER_LIST);
@@ -678,6 +969,7 @@ QuicLibraryLazyInitialize(
         goto Exit;
     }
 
+    const uint64_t DatapathInitStart = CxPlatTimeUs64();
     Status =
         CxPlatDataPathInitialize(
             sizeof(QUIC_RX_PACKET),
@@ -687,6 +979,9 @@ QuicLibraryLazyInitialize(
             MsQuicLib.ExecutionConfig,
             &MsQuicLib.Datapath);
     if (QUIC_SUCCEEDED(Status)) {
+        MsQuicLib.StartupTimings.DatapathInitUs =
+            CxPlatTimeDiff64(DatapathInitStart, CxPlatTimeUs64());
+        MsQuicLib.StartupTimings.WorkerPoolStartUs = MsQuicLib.WorkerPool.StartTimeUs;
         QuicTraceEvent(
             DataPathInitialized,
             "[data] Initialized, DatapathFeatures=%u",
@@ -790,6 +1085,16 @@ QuicLibApplyLoadBalancingSetting(
     case QUIC_LOAD_BALANCING_SERVER_ID_FIXED: // 1 + 4 for fixed value
         MsQuicLib.CidServerIdLength = 5;
         break;
+    case QUIC_LOAD_BALANCING_SERVER_ID_QUIC_LB: // 1 + server ID + nonce
+        if (MsQuicLib.LoadBalancingConfigSet) {
+            MsQuicLib.CidServerIdLength =
+                1 +
+                MsQuicLib.LoadBalancingConfig.ServerIdLength +
+                MsQuicLib.LoadBalancingConfig.NonceLength;
+        } else {
+            MsQuicLib.CidServerIdLength = 1; // Unroutable
+        }
+        break;
     }
 
     MsQuicLib.CidTotalLength =
@@ -807,6 +1112,108 @@ QuicLibApplyLoadBalancingSetting(
         MsQuicLib.CidTotalLength);
 }
 
+//
+// QUIC-LB four-pass encryption of the server ID and nonce. The plaintext is
+// split into two halves (sharing the middle nibble if the length is odd), and
+// each pass XORs one half with AES-ECB of the other, padded to a full block
+// with the plaintext length and pass index.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+static
+void
+QuicLibraryLoadBalancingFourPassEncrypt(
+    _In_ CXPLAT_HP_KEY* Key,
+    _In_range_(2, CXPLAT_HP_SAMPLE_LENGTH - 1)
+        uint8_t Length,
+    _Inout_updates_(Length)
+        uint8_t* Block
+    )
+{
+    const uint8_t HalfLength = (Length + 1) / 2;
+    const BOOLEAN Odd = (Length & 1) != 0;
+    uint8_t Left[CXPLAT_HP_SAMPLE_LENGTH / 2];
+    uint8_t Right[CXPLAT_HP_SAMPLE_LENGTH / 2];
+    uint8_t Input[CXPLAT_HP_SAMPLE_LENGTH];
+    uint8_t Mask[CXPLAT_HP_SAMPLE_LENGTH];
+
+    CxPlatCopyMemory(Left, Block, HalfLength);
+    CxPlatCopyMemory(Right, Block + Length - HalfLength, HalfLength);
+    if (Odd) {
+        Left[HalfLength - 1] &= 0xF0;
+        Right[0] &= 0x0F;
+    }
+
+    for (uint8_t Pass = 1; Pass <= 4; ++Pass) {
+        CxPlatZeroMemory(Input, sizeof(Input));
+        if (Pass & 1) {
+            CxPlatCopyMemory(Input, Left, HalfLength);
+            Input[sizeof(Input) - 2] = Length;
+            Input[sizeof(Input) - 1] = Pass;
+            (void)CxPlatHpComputeMask(Key, 1, Input, Mask);
+            for (uint8_t i = 0; i < HalfLength; ++i) {
+                Right[i] ^= Mask[sizeof(Mask) - HalfLength + i];
+            }
+            if (Odd) {
+                Right[0] &= 0x0F;
+            }
+        } else {
+            Input[0] = Length;
+            Input[1] = Pass;
+            CxPlatCopyMemory(Input + sizeof(Input) - HalfLength, Right, HalfLength);
+            (void)CxPlatHpComputeMask(Key, 1, Input, Mask);
+            for (uint8_t i = 0; i < HalfLength; ++i) {
+                Left[i] ^= Mask[i];
+            }
+            if (Odd) {
+                Left[HalfLength - 1] &= 0xF0;
+            }
+        }
+    }
+
+    CxPlatCopyMemory(Block, Left, HalfLength);
+    if (Odd) {
+        Block[HalfLength - 1] |= Right[0];
+        CxPlatCopyMemory(Block + HalfLength, Right + 1, HalfLength - 1);
+    } else {
+        CxPlatCopyMemory(Block + HalfLength, Right, HalfLength);
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicLibraryEncodeLoadBalancingCid(
+    _Out_writes_(MsQuicLib.CidServerIdLength)
+        uint8_t* Cid
+    )
+{
+    //
+    // The first octet carries the config rotation bits, and either the CID
+    // length (minus one) or random bits. The nonce is always random.
+    //
+    CxPlatRandom(MsQuicLib.CidServerIdLength, Cid);
+    const uint8_t RandomBits = Cid[0] & 0x1F;
+
+    CxPlatDispatchLockAcquire(&MsQuicLib.LoadBalancingLock);
+    const QUIC_LOAD_BALANCING_CONFIG* Config = &MsQuicLib.LoadBalancingConfig;
+    if (!MsQuicLib.LoadBalancingConfigSet) {
+        Cid[0] = (uint8_t)((QUIC_LB_CONFIG_ID_UNROUTABLE << QUIC_LB_CONFIG_ID_SHIFT) | RandomBits);
+
+    } else {
+        CXPLAT_DBG_ASSERT(1 + Config->ServerIdLength + Config->NonceLength == MsQuicLib.CidServerIdLength);
+        Cid[0] =
+            (uint8_t)((Config->ConfigId << QUIC_LB_CONFIG_ID_SHIFT) |
+                (Config->EncodeLength ? MsQuicLib.CidTotalLength - 1 : RandomBits));
+        CxPlatCopyMemory(Cid + 1, Config->ServerId, Config->ServerIdLength);
+        if (MsQuicLib.LoadBalancingKey != NULL) {
+            QuicLibraryLoadBalancingFourPassEncrypt(
+                MsQuicLib.LoadBalancingKey,
+                MsQuicLib.CidServerIdLength - 1,
+                Cid + 1);
+        }
+    }
+    CxPlatDispatchLockRelease(&MsQuicLib.LoadBalancingLock);
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 QUIC_STATUS
 QuicLibrarySetGlobalParam(
@@ -844,7 +1251,7 @@ QuicLibrarySetGlobalParam(
             break;
         }
 
-        if (*(uint16_t*)Buffer > QUIC_LOAD_BALANCING_SERVER_ID_IP) {
+        if (*(uint16_t*)Buffer >= QUIC_LOAD_BALANCING_COUNT) {
             Status = QUIC_STATUS_INVALID_PARAMETER;
             break;
         }
@@ -1150,134 +1557,706 @@ QuicLibrarySetGlobalParam(
         }
         break;
 
-    default:
-        Status = QUIC_STATUS_INVALID_PARAMETER;
-        break;
-    }
-
-    return Status;
-}
-
-_IRQL_requires_max_(PASSIVE_LEVEL)
-QUIC_STATUS
-QuicLibraryGetGlobalParam(
-    _In_ uint32_t Param,
-    _Inout_ uint32_t* BufferLength,
-    _Out_writes_bytes_opt_(*BufferLength)
-        void* Buffer
-    )
-{
-    QUIC_STATUS Status;
-    uint32_t GitHashLength;
-
-    switch (Param) {
-    case QUIC_PARAM_GLOBAL_RETRY_MEMORY_PERCENT:
-
-        if (*BufferLength < sizeof(MsQuicLib.Settings.RetryMemoryLimit)) {
-            *BufferLength = sizeof(MsQuicLib.Settings.RetryMemoryLimit);
-            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
-            break;
-        }
+    case QUIC_PARAM_GLOBAL_SEND_BUFFER_LIMIT:
 
-        if (Buffer == NULL) {
+        if (Buffer == NULL ||
+            BufferLength != sizeof(MsQuicLib.SendBufferLimit)) {
             Status = QUIC_STATUS_INVALID_PARAMETER;
             break;
         }
 
-        *BufferLength = sizeof(MsQuicLib.Settings.RetryMemoryLimit);
-        *(uint16_t*)Buffer = MsQuicLib.Settings.RetryMemoryLimit;
+        MsQuicLib.SendBufferLimit = *(uint64_t*)Buffer;
 
         Status = QUIC_STATUS_SUCCESS;
         break;
 
-    case QUIC_PARAM_GLOBAL_SUPPORTED_VERSIONS:
+    case QUIC_PARAM_GLOBAL_MTU_PROBE_SIZES: {
 
-        if (*BufferLength < sizeof(QuicSupportedVersionList)) {
-            *BufferLength = sizeof(QuicSupportedVersionList);
-            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+        if (BufferLength % sizeof(uint16_t) != 0 ||
+            BufferLength > sizeof(MsQuicLib.MtuProbeSizes) ||
+            (BufferLength != 0 && Buffer == NULL)) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
             break;
         }
 
-        if (Buffer == NULL) {
-            Status = QUIC_STATUS_INVALID_PARAMETER;
+        const uint16_t* ProbeSizes = (const uint16_t*)Buffer;
+        const uint8_t ProbeSizeCount = (uint8_t)(BufferLength / sizeof(uint16_t));
+        Status = QUIC_STATUS_SUCCESS;
+        for (uint8_t i = 0; i < ProbeSizeCount; ++i) {
+            if (ProbeSizes[i] < QUIC_DPLPMTUD_MIN_MTU ||
+                ProbeSizes[i] > CXPLAT_MAX_MTU ||
+                (i > 0 && ProbeSizes[i] <= ProbeSizes[i - 1])) {
+                Status = QUIC_STATUS_INVALID_PARAMETER;
+                break;
+            }
+        }
+        if (QUIC_FAILED(Status)) {
             break;
         }
 
-        *BufferLength = sizeof(QuicSupportedVersionList);
-        CxPlatCopyMemory(
-            Buffer,
-            QuicSupportedVersionList,
-            sizeof(QuicSupportedVersionList));
-
-        Status = QUIC_STATUS_SUCCESS;
+        if (ProbeSizeCount != 0) {
+            CxPlatCopyMemory(MsQuicLib.MtuProbeSizes, ProbeSizes, BufferLength);
+        }
+        MsQuicLib.MtuProbeSizeCount = ProbeSizeCount;
         break;
+    }
 
-    case QUIC_PARAM_GLOBAL_LOAD_BALACING_MODE:
-
-        if (*BufferLength < sizeof(uint16_t)) {
-            *BufferLength = sizeof(uint16_t);
-            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
-            break;
-        }
+    case QUIC_PARAM_GLOBAL_MEMORY_BUDGET: {
 
-        if (Buffer == NULL) {
+        if (Buffer == NULL ||
+            BufferLength != sizeof(QUIC_MEMORY_BUDGET)) {
             Status = QUIC_STATUS_INVALID_PARAMETER;
             break;
         }
 
-        *BufferLength = sizeof(uint16_t);
-        *(uint16_t*)Buffer = MsQuicLib.Settings.LoadBalancingMode;
+        const QUIC_MEMORY_BUDGET* Budget = (const QUIC_MEMORY_BUDGET*)Buffer;
+        MsQuicLib.MemoryPressureHandler = Budget->Handler;
+        MsQuicLib.MemoryPressureContext = Budget->Context;
+        MsQuicLib.MemoryLimit = Budget->Limit;
+        QuicLibraryEvaluateMemoryPressure();
 
         Status = QUIC_STATUS_SUCCESS;
         break;
+    }
 
-    case QUIC_PARAM_GLOBAL_PERF_COUNTERS: {
+    case QUIC_PARAM_GLOBAL_SOURCE_RATE_LIMIT: {
 
-        if (*BufferLength < sizeof(int64_t)) {
-            *BufferLength = sizeof(int64_t) * QUIC_PERF_COUNTER_MAX;
-            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+        if (Buffer == NULL ||
+            BufferLength != sizeof(QUIC_SOURCE_RATE_LIMIT)) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
             break;
         }
 
-        if (Buffer == NULL) {
+        const QUIC_SOURCE_RATE_LIMIT* Limit = (const QUIC_SOURCE_RATE_LIMIT*)Buffer;
+        if (Limit->RetryRate > QUIC_SOURCE_RATE_LIMIT_MAX_RATE ||
+            Limit->DropRate > QUIC_SOURCE_RATE_LIMIT_MAX_RATE ||
+            ((Limit->RetryRate != 0 || Limit->DropRate != 0) &&
+             (Limit->Ipv4PrefixLength == 0 || Limit->Ipv4PrefixLength > 32 ||
+              Limit->Ipv6PrefixLength == 0 || Limit->Ipv6PrefixLength > 128))) {
             Status = QUIC_STATUS_INVALID_PARAMETER;
             break;
         }
 
-        if (*BufferLength < QUIC_PERF_COUNTER_MAX * sizeof(int64_t)) {
-            //
-            // Copy as many counters will fit completely in the buffer.
-            //
-            *BufferLength = (*BufferLength / sizeof(int64_t)) * sizeof(int64_t);
-        } else {
-            *BufferLength = QUIC_PERF_COUNTER_MAX * sizeof(int64_t);
-        }
+        MsQuicLib.SourceRateLimit = *Limit;
 
-        QuicLibrarySumPerfCounters(Buffer, *BufferLength);
+        QuicTraceLogInfo(
+            LibrarySourceRateLimitSet,
+            "[ lib] Setting source rate limit, retry=%u/s drop=%u/s",
+            Limit->RetryRate,
+            Limit->DropRate);
 
         Status = QUIC_STATUS_SUCCESS;
         break;
     }
 
-    case QUIC_PARAM_GLOBAL_SETTINGS:
+    case QUIC_PARAM_GLOBAL_TIMER_SLACK:
 
-        Status = QuicSettingsGetSettings(&MsQuicLib.Settings, BufferLength, (QUIC_SETTINGS*)Buffer);
-        break;
+        if (Buffer == NULL ||
+            BufferLength != sizeof(uint32_t) ||
+            *(uint32_t*)Buffer > QUIC_MAX_TIMER_SLACK_MS) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
 
-    case QUIC_PARAM_GLOBAL_VERSION_SETTINGS:
+        MsQuicLib.TimerSlackUs = MS_TO_US((uint64_t)*(uint32_t*)Buffer);
 
-        Status = QuicSettingsGetVersionSettings(&MsQuicLib.Settings, BufferLength, (QUIC_VERSION_SETTINGS*)Buffer);
+        QuicTraceLogInfo(
+            LibraryTimerSlackSet,
+            "[ lib] Setting timer slack, %u ms",
+            *(uint32_t*)Buffer);
+
+        Status = QUIC_STATUS_SUCCESS;
         break;
 
-    case QUIC_PARAM_GLOBAL_GLOBAL_SETTINGS:
+    case QUIC_PARAM_GLOBAL_ZERO_RTT_ANTI_REPLAY:
+
+        if (Buffer == NULL ||
+            BufferLength != sizeof(QUIC_ZERO_RTT_ANTI_REPLAY)) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        CxPlatLockAcquire(&MsQuicLib.Lock);
+        Status =
+            QuicAntiReplaySetConfig(
+                &MsQuicLib.AntiReplay,
+                (const QUIC_ZERO_RTT_ANTI_REPLAY*)Buffer);
+        CxPlatLockRelease(&MsQuicLib.Lock);
+        break;
+
+    case QUIC_PARAM_GLOBAL_PERF_EXPORT: {
+
+        if (Buffer == NULL ||
+            BufferLength != sizeof(QUIC_PERF_EXPORT)) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        const QUIC_PERF_EXPORT* Export = (const QUIC_PERF_EXPORT*)Buffer;
+        if (Export->Buffer != NULL &&
+            (Export->BufferLength < QUIC_PERF_EXPORT_SIZE(1) ||
+             ((size_t)Export->Buffer & 7) != 0 ||
+             Export->IntervalUs < QUIC_PERF_EXPORT_MIN_INTERVAL_US)) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        CxPlatDispatchLockAcquire(&MsQuicLib.PerfExportLock);
+        MsQuicLib.PerfExport = *Export;
+        if (Export->Buffer != NULL) {
+            MsQuicLib.PerfExportEntryCount =
+                (Export->BufferLength - sizeof(QUIC_PERF_EXPORT_HEADER)) /
+                sizeof(QUIC_PERF_EXPORT_PROCESSOR);
+            if (MsQuicLib.PerfExportEntryCount > MsQuicLib.ProcessorCount &&
+                MsQuicLib.ProcessorCount != 0) {
+                MsQuicLib.PerfExportEntryCount = MsQuicLib.ProcessorCount;
+            }
+            CxPlatZeroMemory(
+                Export->Buffer,
+                QUIC_PERF_EXPORT_SIZE(MsQuicLib.PerfExportEntryCount));
+            QUIC_PERF_EXPORT_HEADER* Header = (QUIC_PERF_EXPORT_HEADER*)Export->Buffer;
+            Header->Version = QUIC_PERF_EXPORT_VERSION;
+            Header->ProcessorCount = MsQuicLib.PerfExportEntryCount;
+            Header->CounterCount = QUIC_PERF_COUNTER_MAX;
+            Header->HistogramCount = QUIC_PERF_HISTOGRAM_MAX;
+        } else {
+            MsQuicLib.PerfExportEntryCount = 0;
+        }
+        MsQuicLib.PerfExportEnabled = Export->Buffer != NULL;
+        CxPlatDispatchLockRelease(&MsQuicLib.PerfExportLock);
+
+        QuicTraceLogInfo(
+            LibraryPerfExportSet,
+            "[ lib] Setting perf export, %u entries every %u us",
+            MsQuicLib.PerfExportEntryCount,
+            Export->IntervalUs);
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+    }
+
+    case QUIC_PARAM_GLOBAL_QLOG_HANDLER:
+
+        if (Buffer == NULL ||
+            BufferLength != sizeof(QUIC_QLOG_HANDLER)) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        MsQuicLib.QlogHandler = *(const QUIC_QLOG_HANDLER*)Buffer;
+        if (MsQuicLib.QlogHandler.Handler != NULL) {
+            QuicQlogWriteHeader(&MsQuicLib.QlogHandler);
+        }
+
+        QuicTraceLogInfo(
+            LibraryQlogHandlerSet,
+            "[ lib] Setting qlog handler, %p",
+            (void*)MsQuicLib.QlogHandler.Handler);
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
+    case QUIC_PARAM_GLOBAL_PACKET_CAPTURE:
+
+        if (Buffer == NULL ||
+            BufferLength != sizeof(QUIC_PACKET_CAPTURE_CONFIG)) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        MsQuicLib.PacketCapture = *(const QUIC_PACKET_CAPTURE_CONFIG*)Buffer;
+        if (MsQuicLib.PacketCapture.Handler != NULL) {
+            QuicCaptureWriteHeader(&MsQuicLib.PacketCapture);
+        }
+
+        QuicTraceLogInfo(
+            LibraryPacketCaptureSet,
+            "[ lib] Setting packet capture handler, %p, sample rate %u",
+            (void*)MsQuicLib.PacketCapture.Handler,
+            MsQuicLib.PacketCapture.SampleRate);
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
+    case QUIC_PARAM_GLOBAL_LOAD_BALANCING_CONFIG: {
+
+        if (Buffer == NULL ||
+            BufferLength != sizeof(QUIC_LOAD_BALANCING_CONFIG)) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        //
+        // The server ID and nonce share what's left of a v1 CID with the
+        // partition ID and payload.
+        //
+        const QUIC_LOAD_BALANCING_CONFIG* Config =
+            (const QUIC_LOAD_BALANCING_CONFIG*)Buffer;
+        if (Config->ConfigId >= QUIC_LB_CONFIG_ID_UNROUTABLE ||
+            Config->ServerIdLength == 0 ||
+            Config->ServerIdLength > QUIC_LOAD_BALANCING_MAX_SERVER_ID_LENGTH ||
+            Config->NonceLength < QUIC_LOAD_BALANCING_MIN_NONCE_LENGTH ||
+            1 + Config->ServerIdLength + Config->NonceLength > QUIC_MAX_CID_SID_LENGTH) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        //
+        // Rotating the config while in use is allowed, but the CID length
+        // can't change.
+        //
+        if (MsQuicLib.InUse &&
+            MsQuicLib.Settings.LoadBalancingMode == QUIC_LOAD_BALANCING_SERVER_ID_QUIC_LB &&
+            1 + Config->ServerIdLength + Config->NonceLength != MsQuicLib.CidServerIdLength) {
+            QuicTraceLogError(
+                LibraryLoadBalancingConfigLengthChanged,
+                "[ lib] Tried to change QUIC-LB CID length after library in use!");
+            Status = QUIC_STATUS_INVALID_STATE;
+            break;
+        }
+
+        CXPLAT_HP_KEY* Key = NULL;
+        if (Config->Encrypt) {
+            Status =
+                CxPlatHpKeyCreate(
+                    CXPLAT_AEAD_AES_128_GCM,
+                    Config->Key,
+                    &Key);
+            if (QUIC_FAILED(Status)) {
+                break;
+            }
+        }
+
+        CxPlatDispatchLockAcquire(&MsQuicLib.LoadBalancingLock);
+        CXPLAT_HP_KEY* OldKey = MsQuicLib.LoadBalancingKey;
+        MsQuicLib.LoadBalancingConfig = *Config;
+        MsQuicLib.LoadBalancingKey = Key;
+        MsQuicLib.LoadBalancingConfigSet = TRUE;
+        CxPlatDispatchLockRelease(&MsQuicLib.LoadBalancingLock);
+        CxPlatHpKeyFree(OldKey);
+
+        QuicLibApplyLoadBalancingSetting();
+
+        QuicTraceLogInfo(
+            LibraryLoadBalancingConfigSet,
+            "[ lib] Updated QUIC-LB config = %hhu",
+            Config->ConfigId);
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+    }
+
+    case QUIC_PARAM_GLOBAL_NETWORK_EMULATION:
+
+        if (BufferLength != 0 &&
+            (Buffer == NULL || BufferLength != sizeof(QUIC_NETWORK_EMULATION_SETTINGS))) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        CxPlatLockAcquire(&MsQuicLib.Lock);
+        Status =
+            QuicNetEmuSetSettings(
+                &MsQuicLib.NetEmu,
+                BufferLength == 0 ? NULL : (const QUIC_NETWORK_EMULATION_SETTINGS*)Buffer);
+        CxPlatLockRelease(&MsQuicLib.Lock);
+        break;
+
+    case QUIC_PARAM_GLOBAL_SIMULATION_TIME:
+#ifdef QUIC_SIMULATION
+        if (Buffer == NULL || BufferLength != sizeof(uint64_t)) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        if (*(const uint64_t*)Buffer == UINT64_MAX) {
+            //
+            // The emulator reports UINT64_MAX when nothing is due, so it can't
+            // be delivered up to, and the clock can't run past it anyway.
+            //
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        //
+        // Delivers the emulated datagrams in time order, moving the clock to
+        // each one's delivery time first, so they arrive with the time stamps
+        // they would have had in real time.
+        //
+        {
+            const uint64_t TargetTime = *(const uint64_t*)Buffer;
+            uint64_t TimeNow = CxPlatTimeUs64();
+            uint64_t NextTime;
+            while ((NextTime = QuicNetEmuAdvance(&MsQuicLib.NetEmu, TimeNow)) <= TargetTime) {
+                TimeNow = CxPlatSimulationSetTime(NextTime);
+            }
+            CxPlatSimulationSetTime(TargetTime);
+        }
+
+        Status = QUIC_STATUS_SUCCESS;
+#else
+        Status = QUIC_STATUS_NOT_SUPPORTED;
+#endif
+        break;
+
+    case QUIC_PARAM_GLOBAL_SIMULATION_SEED:
+#ifdef QUIC_SIMULATION
+        if (Buffer == NULL || BufferLength != sizeof(uint64_t)) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        CxPlatSimulationSetSeed(*(const uint64_t*)Buffer);
+
+        Status = QUIC_STATUS_SUCCESS;
+#else
+        Status = QUIC_STATUS_NOT_SUPPORTED;
+#endif
+        break;
+
+    default:
+        Status = QUIC_STATUS_INVALID_PARAMETER;
+        break;
+    }
+
+    return Status;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicLibraryGetGlobalParam(
+    _In_ uint32_t Param,
+    _Inout_ uint32_t* BufferLength,
+    _Out_writes_bytes_opt_(*BufferLength)
+        void* Buffer
+    )
+{
+    QUIC_STATUS Status;
+    uint32_t GitHashLength;
+
+    switch (Param) {
+    case QUIC_PARAM_GLOBAL_RETRY_MEMORY_PERCENT:
+
+        if (*BufferLength < sizeof(MsQuicLib.Settings.RetryMemoryLimit)) {
+            *BufferLength = sizeof(MsQuicLib.Settings.RetryMemoryLimit);
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        *BufferLength = sizeof(MsQuicLib.Settings.RetryMemoryLimit);
+        *(uint16_t*)Buffer = MsQuicLib.Settings.RetryMemoryLimit;
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
+    case QUIC_PARAM_GLOBAL_SUPPORTED_VERSIONS:
+
+        if (*BufferLength < sizeof(QuicSupportedVersionList)) {
+            *BufferLength = sizeof(QuicSupportedVersionList);
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        *BufferLength = sizeof(QuicSupportedVersionList);
+        CxPlatCopyMemory(
+            Buffer,
+            QuicSupportedVersionList,
+            sizeof(QuicSupportedVersionList));
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
+    case QUIC_PARAM_GLOBAL_LOAD_BALACING_MODE:
+
+        if (*BufferLength < sizeof(uint16_t)) {
+            *BufferLength = sizeof(uint16_t);
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        *BufferLength = sizeof(uint16_t);
+        *(uint16_t*)Buffer = MsQuicLib.Settings.LoadBalancingMode;
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
+    case QUIC_PARAM_GLOBAL_PERF_COUNTERS: {
+
+        if (*BufferLength < sizeof(int64_t)) {
+            *BufferLength = sizeof(int64_t) * QUIC_PERF_COUNTER_MAX;
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        if (*BufferLength < QUIC_PERF_COUNTER_MAX * sizeof(int64_t)) {
+            //
+            // Copy as many counters will fit completely in the buffer.
+            //
+            *BufferLength = (*BufferLength / sizeof(int64_t)) * sizeof(int64_t);
+        } else {
+            *BufferLength = QUIC_PERF_COUNTER_MAX * sizeof(int64_t);
+        }
+
+        QuicLibrarySumPerfCounters(Buffer, *BufferLength);
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+    }
+
+    case QUIC_PARAM_GLOBAL_PERF_STAGE_CYCLES: {
+
+#ifdef QUIC_STAGE_CYCLES
+        if (*BufferLength < sizeof(QUIC_PERF_STAGE_CYCLES) * QUIC_PERF_STAGE_MAX) {
+            *BufferLength = sizeof(QUIC_PERF_STAGE_CYCLES) * QUIC_PERF_STAGE_MAX;
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        *BufferLength = sizeof(QUIC_PERF_STAGE_CYCLES) * QUIC_PERF_STAGE_MAX;
+        QUIC_PERF_STAGE_CYCLES* StageCycles = (QUIC_PERF_STAGE_CYCLES*)Buffer;
+        CxPlatZeroMemory(StageCycles, *BufferLength);
+        if (MsQuicLib.PerProc != NULL) {
+            for (uint32_t i = 0; i < MsQuicLib.ProcessorCount; ++i) {
+                for (uint32_t j = 0; j < QUIC_PERF_STAGE_MAX; ++j) {
+                    StageCycles[j].Cycles += MsQuicLib.PerProc[i].StageCycles[j].Cycles;
+                    StageCycles[j].Calls += MsQuicLib.PerProc[i].StageCycles[j].Calls;
+                }
+            }
+        }
+
+        Status = QUIC_STATUS_SUCCESS;
+#else
+        //
+        // Only builds with QUIC_STAGE_CYCLES defined time the pipeline stages.
+        //
+        Status = QUIC_STATUS_NOT_SUPPORTED;
+#endif
+        break;
+    }
+
+    case QUIC_PARAM_GLOBAL_SETTINGS:
+
+        Status = QuicSettingsGetSettings(&MsQuicLib.Settings, BufferLength, (QUIC_SETTINGS*)Buffer);
+        break;
+
+    case QUIC_PARAM_GLOBAL_VERSION_SETTINGS:
+
+        Status = QuicSettingsGetVersionSettings(&MsQuicLib.Settings, BufferLength, (QUIC_VERSION_SETTINGS*)Buffer);
+        break;
+
+    case QUIC_PARAM_GLOBAL_GLOBAL_SETTINGS:
 
         Status = QuicSettingsGetGlobalSettings(&MsQuicLib.Settings, BufferLength, (QUIC_GLOBAL_SETTINGS*)Buffer);
         break;
 
-    case QUIC_PARAM_GLOBAL_LIBRARY_VERSION:
+    case QUIC_PARAM_GLOBAL_LIBRARY_VERSION:
+
+        if (*BufferLength < sizeof(MsQuicLib.Version)) {
+            *BufferLength = sizeof(MsQuicLib.Version);
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        *BufferLength = sizeof(MsQuicLib.Version);
+        CxPlatCopyMemory(Buffer, MsQuicLib.Version, sizeof(MsQuicLib.Version));
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
+    case QUIC_PARAM_GLOBAL_LIBRARY_GIT_HASH:
+
+        GitHashLength = (uint32_t)strlen(MsQuicLib.GitHash) + 1;
+
+        if (*BufferLength < GitHashLength) {
+            *BufferLength = GitHashLength;
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        *BufferLength = GitHashLength;
+        CxPlatCopyMemory(Buffer, MsQuicLib.GitHash, GitHashLength);
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
+    case QUIC_PARAM_GLOBAL_EXECUTION_CONFIG: {
+        if (MsQuicLib.ExecutionConfig == NULL) {
+            *BufferLength = 0;
+            Status = QUIC_STATUS_SUCCESS;
+            break;
+        }
+
+        const uint32_t ConfigLength =
+            QUIC_EXECUTION_CONFIG_MIN_SIZE +
+            sizeof(uint16_t) * MsQuicLib.ExecutionConfig->ProcessorCount;
+
+        if (*BufferLength < ConfigLength) {
+            *BufferLength = ConfigLength;
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        *BufferLength = ConfigLength;
+        CxPlatCopyMemory(Buffer, MsQuicLib.ExecutionConfig, ConfigLength);
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+    }
+
+    case QUIC_PARAM_GLOBAL_TLS_PROVIDER:
+
+        if (*BufferLength < sizeof(QUIC_TLS_PROVIDER)) {
+            *BufferLength = sizeof(QUIC_TLS_PROVIDER);
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        *BufferLength = sizeof(QUIC_TLS_PROVIDER);
+        *(QUIC_TLS_PROVIDER*)Buffer = CxPlatTlsGetProvider();
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
+    case QUIC_PARAM_GLOBAL_SEND_BUFFER_LIMIT:
+
+        if (*BufferLength < sizeof(MsQuicLib.SendBufferLimit)) {
+            *BufferLength = sizeof(MsQuicLib.SendBufferLimit);
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        *BufferLength = sizeof(MsQuicLib.SendBufferLimit);
+        *(uint64_t*)Buffer = MsQuicLib.SendBufferLimit;
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
+    case QUIC_PARAM_GLOBAL_MTU_PROBE_SIZES: {
+
+        const uint32_t Length = MsQuicLib.MtuProbeSizeCount * sizeof(uint16_t);
+        if (*BufferLength < Length) {
+            *BufferLength = Length;
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Length != 0) {
+            if (Buffer == NULL) {
+                Status = QUIC_STATUS_INVALID_PARAMETER;
+                break;
+            }
+            CxPlatCopyMemory(Buffer, MsQuicLib.MtuProbeSizes, Length);
+        }
+        *BufferLength = Length;
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+    }
+
+    case QUIC_PARAM_GLOBAL_WORKER_STATISTICS: {
+
+        //
+        // Registrations are removed from the list before their workers are
+        // cleaned up, so holding the lock keeps every listed worker alive.
+        //
+        CxPlatLockAcquire(&MsQuicLib.Lock);
+
+        uint32_t WorkerCount = 0;
+        for (CXPLAT_LIST_ENTRY* Link = MsQuicLib.Registrations.Flink;
+            Link != &MsQuicLib.Registrations;
+            Link = Link->Flink) {
+            WorkerCount +=
+                CXPLAT_CONTAINING_RECORD(Link, QUIC_REGISTRATION, Link)->WorkerPool->WorkerCount;
+        }
+
+        const uint32_t Length = WorkerCount * sizeof(QUIC_WORKER_STATISTICS);
+        if (*BufferLength < Length) {
+            CxPlatLockRelease(&MsQuicLib.Lock);
+            *BufferLength = Length;
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Length != 0 && Buffer == NULL) {
+            CxPlatLockRelease(&MsQuicLib.Lock);
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        QUIC_WORKER_STATISTICS* Stats = (QUIC_WORKER_STATISTICS*)Buffer;
+        for (CXPLAT_LIST_ENTRY* Link = MsQuicLib.Registrations.Flink;
+            Link != &MsQuicLib.Registrations;
+            Link = Link->Flink) {
+            QUIC_REGISTRATION* Registration =
+                CXPLAT_CONTAINING_RECORD(Link, QUIC_REGISTRATION, Link);
+            QUIC_WORKER_POOL* WorkerPool = Registration->WorkerPool;
+            for (uint16_t i = 0; i < WorkerPool->WorkerCount; ++i) {
+                QuicWorkerGetStatistics(&WorkerPool->Workers[i], Stats);
+                Stats->Registration = (HQUIC)Registration;
+                Stats++;
+            }
+        }
+
+        CxPlatLockRelease(&MsQuicLib.Lock);
+        *BufferLength = Length;
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+    }
+
+    case QUIC_PARAM_GLOBAL_MEMORY_BUDGET: {
 
-        if (*BufferLength < sizeof(MsQuicLib.Version)) {
-            *BufferLength = sizeof(MsQuicLib.Version);
+        if (*BufferLength < sizeof(QUIC_MEMORY_BUDGET)) {
+            *BufferLength = sizeof(QUIC_MEMORY_BUDGET);
             Status = QUIC_STATUS_BUFFER_TOO_SMALL;
             break;
         }
@@ -1287,18 +2266,39 @@ QuicLibraryGetGlobalParam(
             break;
         }
 
-        *BufferLength = sizeof(MsQuicLib.Version);
-        CxPlatCopyMemory(Buffer, MsQuicLib.Version, sizeof(MsQuicLib.Version));
+        QUIC_MEMORY_BUDGET* Budget = (QUIC_MEMORY_BUDGET*)Buffer;
+        Budget->Limit = MsQuicLib.MemoryLimit;
+        Budget->Handler = MsQuicLib.MemoryPressureHandler;
+        Budget->Context = MsQuicLib.MemoryPressureContext;
+        *BufferLength = sizeof(QUIC_MEMORY_BUDGET);
 
         Status = QUIC_STATUS_SUCCESS;
         break;
+    }
 
-    case QUIC_PARAM_GLOBAL_LIBRARY_GIT_HASH:
+    case QUIC_PARAM_GLOBAL_SOURCE_RATE_LIMIT:
 
-        GitHashLength = (uint32_t)strlen(MsQuicLib.GitHash) + 1;
+        if (*BufferLength < sizeof(QUIC_SOURCE_RATE_LIMIT)) {
+            *BufferLength = sizeof(QUIC_SOURCE_RATE_LIMIT);
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
 
-        if (*BufferLength < GitHashLength) {
-            *BufferLength = GitHashLength;
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        *BufferLength = sizeof(QUIC_SOURCE_RATE_LIMIT);
+        CxPlatCopyMemory(Buffer, &MsQuicLib.SourceRateLimit, sizeof(QUIC_SOURCE_RATE_LIMIT));
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
+    case QUIC_PARAM_GLOBAL_ZERO_RTT_ANTI_REPLAY:
+
+        if (*BufferLength < sizeof(QUIC_ZERO_RTT_ANTI_REPLAY)) {
+            *BufferLength = sizeof(QUIC_ZERO_RTT_ANTI_REPLAY);
             Status = QUIC_STATUS_BUFFER_TOO_SMALL;
             break;
         }
@@ -1308,25 +2308,35 @@ QuicLibraryGetGlobalParam(
             break;
         }
 
-        *BufferLength = GitHashLength;
-        CxPlatCopyMemory(Buffer, MsQuicLib.GitHash, GitHashLength);
+        *BufferLength = sizeof(QUIC_ZERO_RTT_ANTI_REPLAY);
+        CxPlatCopyMemory(Buffer, &MsQuicLib.AntiReplay.Config, sizeof(QUIC_ZERO_RTT_ANTI_REPLAY));
 
         Status = QUIC_STATUS_SUCCESS;
         break;
 
-    case QUIC_PARAM_GLOBAL_EXECUTION_CONFIG: {
-        if (MsQuicLib.ExecutionConfig == NULL) {
-            *BufferLength = 0;
-            Status = QUIC_STATUS_SUCCESS;
+    case QUIC_PARAM_GLOBAL_TIMER_SLACK:
+
+        if (*BufferLength < sizeof(uint32_t)) {
+            *BufferLength = sizeof(uint32_t);
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
             break;
         }
 
-        const uint32_t ConfigLength =
-            QUIC_EXECUTION_CONFIG_MIN_SIZE +
-            sizeof(uint16_t) * MsQuicLib.ExecutionConfig->ProcessorCount;
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
 
-        if (*BufferLength < ConfigLength) {
-            *BufferLength = ConfigLength;
+        *BufferLength = sizeof(uint32_t);
+        *(uint32_t*)Buffer = (uint32_t)US_TO_MS(MsQuicLib.TimerSlackUs);
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
+    case QUIC_PARAM_GLOBAL_PERF_EXPORT:
+
+        if (*BufferLength < sizeof(QUIC_PERF_EXPORT)) {
+            *BufferLength = sizeof(QUIC_PERF_EXPORT);
             Status = QUIC_STATUS_BUFFER_TOO_SMALL;
             break;
         }
@@ -1336,16 +2346,16 @@ QuicLibraryGetGlobalParam(
             break;
         }
 
-        *BufferLength = ConfigLength;
-        CxPlatCopyMemory(Buffer, MsQuicLib.ExecutionConfig, ConfigLength);
+        *BufferLength = sizeof(QUIC_PERF_EXPORT);
+        CxPlatCopyMemory(Buffer, &MsQuicLib.PerfExport, sizeof(QUIC_PERF_EXPORT));
+
         Status = QUIC_STATUS_SUCCESS;
         break;
-    }
 
-    case QUIC_PARAM_GLOBAL_TLS_PROVIDER:
+    case QUIC_PARAM_GLOBAL_QLOG_HANDLER:
 
-        if (*BufferLength < sizeof(QUIC_TLS_PROVIDER)) {
-            *BufferLength = sizeof(QUIC_TLS_PROVIDER);
+        if (*BufferLength < sizeof(QUIC_QLOG_HANDLER)) {
+            *BufferLength = sizeof(QUIC_QLOG_HANDLER);
             Status = QUIC_STATUS_BUFFER_TOO_SMALL;
             break;
         }
@@ -1355,8 +2365,46 @@ QuicLibraryGetGlobalParam(
             break;
         }
 
-        *BufferLength = sizeof(QUIC_TLS_PROVIDER);
-        *(QUIC_TLS_PROVIDER*)Buffer = CxPlatTlsGetProvider();
+        *BufferLength = sizeof(QUIC_QLOG_HANDLER);
+        CxPlatCopyMemory(Buffer, &MsQuicLib.QlogHandler, sizeof(QUIC_QLOG_HANDLER));
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
+    case QUIC_PARAM_GLOBAL_PACKET_CAPTURE:
+
+        if (*BufferLength < sizeof(QUIC_PACKET_CAPTURE_CONFIG)) {
+            *BufferLength = sizeof(QUIC_PACKET_CAPTURE_CONFIG);
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        *BufferLength = sizeof(QUIC_PACKET_CAPTURE_CONFIG);
+        CxPlatCopyMemory(Buffer, &MsQuicLib.PacketCapture, sizeof(QUIC_PACKET_CAPTURE_CONFIG));
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
+    case QUIC_PARAM_GLOBAL_MEMORY_PRESSURE:
+
+        if (*BufferLength < sizeof(QUIC_MEMORY_PRESSURE_LEVEL)) {
+            *BufferLength = sizeof(QUIC_MEMORY_PRESSURE_LEVEL);
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        *BufferLength = sizeof(QUIC_MEMORY_PRESSURE_LEVEL);
+        *(QUIC_MEMORY_PRESSURE_LEVEL*)Buffer = QuicLibraryGetMemoryPressure();
 
         Status = QUIC_STATUS_SUCCESS;
         break;
@@ -1384,6 +2432,41 @@ QuicLibraryGetGlobalParam(
         Status = QUIC_STATUS_SUCCESS;
         break;
 
+    case QUIC_PARAM_GLOBAL_DATAPATH_STATISTICS: {
+
+        if (MsQuicLib.Datapath == NULL) {
+            Status = QUIC_STATUS_INVALID_STATE;
+            break;
+        }
+
+        //
+        // The raw datapath's queues are fixed once it's initialized, so the
+        // count doesn't change between the two calls.
+        //
+        const uint32_t QueueCount =
+            CxPlatDataPathGetQueueStatistics(MsQuicLib.Datapath, NULL, 0);
+        const uint32_t Length = QueueCount * sizeof(QUIC_DATAPATH_QUEUE_STATISTICS);
+        if (*BufferLength < Length) {
+            *BufferLength = Length;
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Length != 0 && Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        if (QueueCount != 0) {
+            CxPlatDataPathGetQueueStatistics(
+                MsQuicLib.Datapath, (QUIC_DATAPATH_QUEUE_STATISTICS*)Buffer, QueueCount);
+        }
+        *BufferLength = Length;
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+    }
+
     case QUIC_PARAM_GLOBAL_VERSION_NEGOTIATION_ENABLED:
 
         if (*BufferLength < sizeof(BOOLEAN)) {
@@ -1440,6 +2523,70 @@ QuicLibraryGetGlobalParam(
         Status = QUIC_STATUS_SUCCESS;
         break;
 
+    case QUIC_PARAM_GLOBAL_NETWORK_EMULATION:
+
+        if (*BufferLength < sizeof(QUIC_NETWORK_EMULATION_SETTINGS)) {
+            *BufferLength = sizeof(QUIC_NETWORK_EMULATION_SETTINGS);
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        *BufferLength = sizeof(QUIC_NETWORK_EMULATION_SETTINGS);
+        QuicNetEmuGetSettings(&MsQuicLib.NetEmu, (QUIC_NETWORK_EMULATION_SETTINGS*)Buffer);
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
+    case QUIC_PARAM_GLOBAL_STARTUP_TIMINGS:
+
+        if (*BufferLength < sizeof(QUIC_STARTUP_TIMINGS)) {
+            *BufferLength = sizeof(QUIC_STARTUP_TIMINGS);
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        *BufferLength = sizeof(QUIC_STARTUP_TIMINGS);
+        CxPlatCopyMemory(Buffer, &MsQuicLib.StartupTimings, sizeof(QUIC_STARTUP_TIMINGS));
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
+    case QUIC_PARAM_GLOBAL_SIMULATION_TIME:
+#ifdef QUIC_SIMULATION
+        if (*BufferLength < sizeof(QUIC_SIMULATION_STATE)) {
+            *BufferLength = sizeof(QUIC_SIMULATION_STATE);
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        {
+            QUIC_SIMULATION_STATE* State = (QUIC_SIMULATION_STATE*)Buffer;
+            *BufferLength = sizeof(QUIC_SIMULATION_STATE);
+            State->TimeUs = CxPlatTimeUs64();
+            State->NextDeliveryUs = QuicNetEmuAdvance(&MsQuicLib.NetEmu, State->TimeUs);
+        }
+
+        Status = QUIC_STATUS_SUCCESS;
+#else
+        Status = QUIC_STATUS_NOT_SUPPORTED;
+#endif
+        break;
+
     default:
         Status = QUIC_STATUS_INVALID_PARAMETER;
         break;
@@ -1798,8 +2945,18 @@ MsQuicOpenVersion(
     Api->StreamSend = MsQuicStreamSend;
     Api->StreamReceiveComplete = MsQuicStreamReceiveComplete;
     Api->StreamReceiveSetEnabled = MsQuicStreamReceiveSetEnabled;
+    Api->StreamProvideReceiveBuffers = MsQuicStreamProvideReceiveBuffers;
 
     Api->DatagramSend = MsQuicDatagramSend;
+    Api->DatagramSendBatch = MsQuicDatagramSendBatch;
+    Api->StreamOpenAndSend = MsQuicStreamOpenAndSend;
+    Api->StreamReceiveCompleteBatch = MsQuicStreamReceiveCompleteBatch;
+    Api->StreamReceive = MsQuicStreamReceive;
+    Api->RegistrationPollEvents = MsQuicRegistrationPollEvents;
+    Api->StreamSendBatch = MsQuicStreamSendBatch;
+
+    Api->ExecutionGetEventQ = MsQuicExecutionGetEventQ;
+    Api->ExecutionPoll = MsQuicExecutionPoll;
 
     *QuicApi = Api;
 
@@ -1838,6 +2995,69 @@ MsQuicClose(
     }
 }
 
+//
+// Unconnected (listening) bindings always use wildcard addresses, so they are
+// indexed by local port alone. Connected bindings are indexed by their full
+// local and remote address pair.
+//
+#define QuicLibraryBindingPortHash(Port) ((uint64_t)(Port))
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+static
+uint64_t
+QuicLibraryBindingTupleHash(
+    _In_ const QUIC_ADDR* LocalAddress,
+    _In_ const QUIC_ADDR* RemoteAddress
+    )
+{
+    //
+    // Always set a bit above the port range so that a tuple hash can never
+    // collide with a port hash.
+    //
+    return
+        ((uint64_t)QuicAddrHash(LocalAddress) << 32) |
+        (uint64_t)QuicAddrHash(RemoteAddress) |
+        0x10000ull;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+static
+uint64_t
+QuicLibraryBindingHash(
+    _In_ QUIC_BINDING* Binding
+    )
+{
+    QUIC_ADDR LocalAddr;
+    QuicBindingGetLocalAddress(Binding, &LocalAddr);
+    if (Binding->Connected) {
+        QUIC_ADDR RemoteAddr;
+        QuicBindingGetRemoteAddress(Binding, &RemoteAddr);
+        return QuicLibraryBindingTupleHash(&LocalAddr, &RemoteAddr);
+    }
+    return QuicLibraryBindingPortHash(QuicAddrGetPort(&LocalAddr));
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+static
+void
+QuicLibraryInsertBinding(
+    _In_ QUIC_BINDING* Binding
+    )
+{
+    if (CxPlatListIsEmpty(&MsQuicLib.Bindings)) {
+        QuicTraceLogInfo(
+            LibraryInUse,
+            "[ lib] Now in use.");
+        MsQuicLib.InUse = TRUE;
+    }
+    CxPlatListInsertTail(&MsQuicLib.Bindings, &Binding->Link);
+    CxPlatHashtableInsert(
+        &MsQuicLib.BindingsTable,
+        &Binding->HashEntry,
+        QuicLibraryBindingHash(Binding),
+        NULL);
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 QUIC_BINDING*
 QuicLibraryLookupBinding(
@@ -1848,12 +3068,27 @@ QuicLibraryLookupBinding(
     _In_opt_ const QUIC_ADDR* RemoteAddress
     )
 {
-    for (CXPLAT_LIST_ENTRY* Link = MsQuicLib.Bindings.Flink;
-        Link != &MsQuicLib.Bindings;
-        Link = Link->Flink) {
+    CXPLAT_HASHTABLE_LOOKUP_CONTEXT Context;
+    CXPLAT_HASHTABLE_ENTRY* Entry;
+
+    //
+    // First look for a server (unconnected/listening) binding on the local
+    // port. Note: We don't check the remote address, because we want to return
+    // a match even if the caller is looking for a connected socket so that we
+    // can inform them there is already a listening socket using the local port.
+    //
+    const uint16_t LocalPort = QuicAddrGetPort(LocalAddress);
+    for (Entry =
+            CxPlatHashtableLookup(
+                &MsQuicLib.BindingsTable,
+                QuicLibraryBindingPortHash(LocalPort),
+                &Context);
+        Entry != NULL;
+        Entry = CxPlatHashtableLookupNext(&MsQuicLib.BindingsTable, &Context)) {
 
         QUIC_BINDING* Binding =
-            CXPLAT_CONTAINING_RECORD(Link, QUIC_BINDING, Link);
+            CXPLAT_CONTAINING_RECORD(Entry, QUIC_BINDING, HashEntry);
+        CXPLAT_DBG_ASSERT(!Binding->Connected);
 
 #ifdef QUIC_COMPARTMENT_ID
         if (CompartmentId != Binding->CompartmentId) {
@@ -1863,35 +3098,43 @@ QuicLibraryLookupBinding(
 
         QUIC_ADDR BindingLocalAddr;
         QuicBindingGetLocalAddress(Binding, &BindingLocalAddr);
+        if (QuicAddrGetPort(&BindingLocalAddr) == LocalPort) {
+            return Binding;
+        }
+    }
 
-        if (Binding->Connected) {
-            //
-            // For client/connected bindings we need to match on both local and
-            // remote addresses/ports.
-            //
-            if (RemoteAddress &&
-                QuicAddrCompare(LocalAddress, &BindingLocalAddr)) {
-                QUIC_ADDR BindingRemoteAddr;
-                QuicBindingGetRemoteAddress(Binding, &BindingRemoteAddr);
-                if (QuicAddrCompare(RemoteAddress, &BindingRemoteAddr)) {
-                    return Binding;
-                }
-            }
+    if (RemoteAddress == NULL) {
+        return NULL;
+    }
 
-        } else {
-            //
-            // For server (unconnected/listening) bindings we always use wildcard
-            // addresses, so we simply need to match on local port.
-            //
-            if (QuicAddrGetPort(&BindingLocalAddr) == QuicAddrGetPort(LocalAddress)) {
-                //
-                // Note: We don't check the remote address, because we want to
-                // return a match even if the caller is looking for a connected
-                // socket so that we can inform them there is already a listening
-                // socket using the local port.
-                //
-                return Binding;
-            }
+    //
+    // For client/connected bindings we need to match on both local and
+    // remote addresses/ports.
+    //
+    for (Entry =
+            CxPlatHashtableLookup(
+                &MsQuicLib.BindingsTable,
+                QuicLibraryBindingTupleHash(LocalAddress, RemoteAddress),
+                &Context);
+        Entry != NULL;
+        Entry = CxPlatHashtableLookupNext(&MsQuicLib.BindingsTable, &Context)) {
+
+        QUIC_BINDING* Binding =
+            CXPLAT_CONTAINING_RECORD(Entry, QUIC_BINDING, HashEntry);
+        CXPLAT_DBG_ASSERT(Binding->Connected);
+
+#ifdef QUIC_COMPARTMENT_ID
+        if (CompartmentId != Binding->CompartmentId) {
+            continue;
+        }
+#endif
+
+        QUIC_ADDR BindingLocalAddr, BindingRemoteAddr;
+        QuicBindingGetLocalAddress(Binding, &BindingLocalAddr);
+        QuicBindingGetRemoteAddress(Binding, &BindingRemoteAddr);
+        if (QuicAddrCompare(LocalAddress, &BindingLocalAddr) &&
+            QuicAddrCompare(RemoteAddress, &BindingRemoteAddr)) {
+            return Binding;
         }
     }
 
@@ -2059,14 +3302,8 @@ NewBinding:
         //
         // No other thread beat us, insert this binding into the list.
         //
-        if (CxPlatListIsEmpty(&MsQuicLib.Bindings)) {
-            QuicTraceLogInfo(
-                LibraryInUse,
-                "[ lib] Now in use.");
-            MsQuicLib.InUse = TRUE;
-        }
         (*NewBinding)->RefCount++;
-        CxPlatListInsertTail(&MsQuicLib.Bindings, &(*NewBinding)->Link);
+        QuicLibraryInsertBinding(*NewBinding);
     }
 
     CxPlatDispatchLockRelease(&MsQuicLib.DatapathLock);
@@ -2160,6 +3397,7 @@ QuicLibraryReleaseBinding(
     CXPLAT_DBG_ASSERT(Binding->RefCount > 0);
     if (--Binding->RefCount == 0) {
         CxPlatListEntryRemove(&Binding->Link);
+        CxPlatHashtableRemove(&MsQuicLib.BindingsTable, &Binding->HashEntry, NULL);
         Uninitialize = TRUE;
 
         if (CxPlatListIsEmpty(&MsQuicLib.Bindings)) {
@@ -2391,6 +3629,7 @@ QuicLibraryOnHandshakeConnectionAdded(
         (int64_t*)&MsQuicLib.CurrentHandshakeMemoryUsage,
         (int64_t)QUIC_CONN_HANDSHAKE_MEMORY_USAGE);
     QuicLibraryEvaluateSendRetryState();
+    QuicLibraryEvaluateMemoryPressure();
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -2403,6 +3642,7 @@ QuicLibraryOnHandshakeConnectionRemoved(
         (int64_t*)&MsQuicLib.CurrentHandshakeMemoryUsage,
         -1 * (int64_t)QUIC_CONN_HANDSHAKE_MEMORY_USAGE);
     QuicLibraryEvaluateSendRetryState();
+    QuicLibraryEvaluateMemoryPressure();
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -2423,6 +3663,50 @@ QuicLibraryEvaluateSendRetryState(
     }
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicLibraryEvaluateMemoryPressure(
+    void
+    )
+{
+    const uint64_t Limit = MsQuicLib.MemoryLimit;
+    QUIC_MEMORY_PRESSURE_LEVEL NewLevel = QUIC_MEMORY_PRESSURE_NONE;
+    if (Limit != 0) {
+        const uint64_t Usage =
+            MsQuicLib.CurrentHandshakeMemoryUsage +
+            MsQuicLib.CurrentSendBufferUsage +
+            MsQuicLib.CurrentRecvBufferUsage;
+        if (Usage >= Limit) {
+            NewLevel = QUIC_MEMORY_PRESSURE_CRITICAL;
+        } else if (Usage >= Limit - Limit / 4) {
+            NewLevel = QUIC_MEMORY_PRESSURE_HIGH;
+        } else if (Usage >= Limit / 2) {
+            NewLevel = QUIC_MEMORY_PRESSURE_ELEVATED;
+        }
+    }
+
+    //
+    // Only the thread that actually moves the level reports the change, so the
+    // app sees each transition exactly once.
+    //
+    const long OldLevel = MsQuicLib.MemoryPressureLevel;
+    if ((long)NewLevel == OldLevel ||
+        InterlockedCompareExchange(
+            &MsQuicLib.MemoryPressureLevel, (long)NewLevel, OldLevel) != OldLevel) {
+        return;
+    }
+
+    QuicTraceLogInfo(
+        LibraryMemoryPressureUpdated,
+        "[ lib] New memory pressure level, %u",
+        (uint32_t)NewLevel);
+
+    QUIC_MEMORY_PRESSURE_CALLBACK_HANDLER Handler = MsQuicLib.MemoryPressureHandler;
+    if (Handler != NULL) {
+        Handler(MsQuicLib.MemoryPressureContext, NewLevel);
+    }
+}
+
 CXPLAT_STATIC_ASSERT(
     CXPLAT_HASH_SHA256_SIZE >= QUIC_STATELESS_RESET_TOKEN_LENGTH,
     "Stateless reset token must be shorter than hash size used");
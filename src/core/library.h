@@ -40,9 +40,54 @@ typedef struct QUIC_HANDLE {
 
 } QUIC_HANDLE;
 
+//
+// Pre-allocated objects held on top of a pool. Unlike the pool, which only
+// keeps a limited number of freed objects around, the reserve is filled ahead
+// of time to a configurable depth, so that a burst of allocations doesn't have
+// to go to the system allocator.
+//
+typedef struct QUIC_OBJECT_RESERVE {
+
+    CXPLAT_DISPATCH_LOCK Lock;
+    CXPLAT_SLIST_ENTRY Head;
+    uint32_t Depth;
+    uint32_t TargetDepth;
+    uint32_t Size;
+    uint32_t Tag;
+
+} QUIC_OBJECT_RESERVE;
+
 //
 // Per-processor storage for global library state.
 //
+//
+// Initial secrets recently derived by a server for a version and destination
+// CID. Initial secrets can be computed by anyone from the CID, so keeping them
+// around exposes nothing.
+//
+typedef struct QUIC_INITIAL_SECRET_CACHE_ENTRY {
+
+    const uint8_t* Salt; // Identifies the version. NULL if the entry is unused.
+    uint8_t CidLength;
+    uint8_t Cid[QUIC_MAX_CONNECTION_ID_LENGTH_V1];
+    CXPLAT_SECRET ClientInitial;
+    CXPLAT_SECRET ServerInitial;
+
+} QUIC_INITIAL_SECRET_CACHE_ENTRY;
+
+//
+// A QUIC_LATENCY_HISTOGRAM updated with interlocked operations, since threads
+// running on the same processor share it.
+//
+typedef struct QUIC_PERF_HISTOGRAM {
+
+    int64_t Count;
+    int64_t Sum;
+    int64_t Max;
+    int64_t Buckets[QUIC_LATENCY_HISTOGRAM_BUCKET_COUNT];
+
+} QUIC_PERF_HISTOGRAM;
+
 typedef struct QUIC_CACHEALIGN QUIC_LIBRARY_PP {
 
     //
@@ -50,6 +95,13 @@ typedef struct QUIC_CACHEALIGN QUIC_LIBRARY_PP {
     //
     CXPLAT_POOL ConnectionPool;
 
+    //
+    // Pre-warmed QUIC_CONNECTIONs and QUIC_PACKET_SPACEs, for the partitions'
+    // processors only.
+    //
+    QUIC_OBJECT_RESERVE ConnectionReserve;
+    QUIC_OBJECT_RESERVE PacketSpaceReserve;
+
     //
     // Pool for QUIC_TRANSPORT_PARAMETERs.
     //
@@ -60,12 +112,31 @@ typedef struct QUIC_CACHEALIGN QUIC_LIBRARY_PP {
     //
     CXPLAT_POOL PacketSpacePool;
 
+    //
+    // Pools for source and destination connection IDs, sized for the longest
+    // QUIC v1 connection ID.
+    //
+    CXPLAT_POOL SourceCidPool;
+    CXPLAT_POOL DestCidPool;
+
+    //
+    // Pools for stream and crypto receive buffer chunks.
+    //
+    QUIC_RECV_CHUNK_POOL RecvChunkPool;
+
     //
     // Used for generating stateless reset hashes.
     //
     CXPLAT_HASH* ResetTokenHash;
     CXPLAT_LOCK ResetTokenLock;
 
+    //
+    // Recently derived server Initial secrets, so that Initial packets
+    // replayed (e.g. from many source addresses) don't repeat the derivation.
+    //
+    CXPLAT_DISPATCH_LOCK InitialSecretCacheLock;
+    QUIC_INITIAL_SECRET_CACHE_ENTRY InitialSecretCache[QUIC_INITIAL_SECRET_CACHE_SIZE];
+
     uint64_t SendBatchId;
     uint64_t SendPacketId;
     uint64_t ReceivePacketId;
@@ -75,6 +146,19 @@ typedef struct QUIC_CACHEALIGN QUIC_LIBRARY_PP {
     //
     int64_t PerfCounters[QUIC_PERF_COUNTER_MAX];
 
+    //
+    // Per-processor latency histograms, only recorded while the perf export
+    // is enabled.
+    //
+    QUIC_PERF_HISTOGRAM PerfHistograms[QUIC_PERF_HISTOGRAM_MAX];
+
+#ifdef QUIC_STAGE_CYCLES
+    //
+    // Per-processor cycles spent in each pipeline stage.
+    //
+    QUIC_PERF_STAGE_CYCLES StageCycles[QUIC_PERF_STAGE_MAX];
+#endif
+
 } QUIC_LIBRARY_PP;
 
 //
@@ -205,6 +289,103 @@ typedef struct QUIC_LIBRARY {
     //
     uint64_t CurrentHandshakeMemoryUsage;
 
+    //
+    // The maximum total bytes copied into send buffers across all connections,
+    // or zero for no limit. Ideal send buffer sizes are scaled down as the
+    // usage approaches this limit.
+    //
+    uint64_t SendBufferLimit;
+
+    //
+    // The number of connections the partitions' reserves were last filled to.
+    //
+    uint32_t ConnectionPoolPrewarmCount;
+
+    //
+    // The current total bytes copied into send buffers across all connections.
+    //
+    uint64_t CurrentSendBufferUsage;
+
+    //
+    // The current total bytes allocated for receive buffer chunks across all
+    // connections.
+    //
+    uint64_t CurrentRecvBufferUsage;
+
+    //
+    // The hard memory budget, in bytes, for handshake, send buffer and receive
+    // buffer usage combined, or zero for no limit.
+    //
+    uint64_t MemoryLimit;
+
+    //
+    // The current QUIC_MEMORY_PRESSURE_LEVEL derived from the usage and the
+    // memory budget, and the app's (optional) callback for changes to it.
+    //
+    long MemoryPressureLevel;
+    QUIC_MEMORY_PRESSURE_CALLBACK_HANDLER MemoryPressureHandler;
+    void* MemoryPressureContext;
+
+    //
+    // Per-source rate limits for new connection attempts on server bindings.
+    // Rates of zero disable the corresponding limit.
+    //
+    QUIC_SOURCE_RATE_LIMIT SourceRateLimit;
+
+    //
+    // The slack (in us) allowed for connections' idle, keep-alive and
+    // hibernate timers, so that they expire together (QUIC_PARAM_GLOBAL_TIMER_SLACK).
+    //
+    uint64_t TimerSlackUs;
+
+    //
+    // The app's handler for qlog output, from QUIC_PARAM_GLOBAL_QLOG_HANDLER.
+    //
+    QUIC_QLOG_HANDLER QlogHandler;
+
+    //
+    // The app's packet capture handler and sample rate, from
+    // QUIC_PARAM_GLOBAL_PACKET_CAPTURE.
+    //
+    QUIC_PACKET_CAPTURE_CONFIG PacketCapture;
+
+    //
+    // The in-process network emulator, from
+    // QUIC_PARAM_GLOBAL_NETWORK_EMULATION.
+    //
+    QUIC_NET_EMU NetEmu;
+
+    //
+    // How long the phases of the library's startup took, for
+    // QUIC_PARAM_GLOBAL_STARTUP_TIMINGS.
+    //
+    QUIC_STARTUP_TIMINGS StartupTimings;
+
+    //
+    // Common MTUs for DPLPMTUD to probe before its incremental search, in
+    // increasing order.
+    //
+    uint16_t MtuProbeSizes[QUIC_MAX_MTU_PROBE_SIZES];
+    uint8_t MtuProbeSizeCount;
+
+    //
+    // The MTU, RTT and congestion window last measured to recently used remote
+    // addresses. New paths to these addresses start from there.
+    //
+    QUIC_PATH_METRICS_CACHE PathMetricsCache;
+
+    //
+    // The last resumption ticket received for recently used server names, for
+    // clients with ResumptionTicketCacheEnabled set.
+    //
+    QUIC_TICKET_CACHE TicketCache;
+
+    //
+    // The ClientHellos of recently resumed handshakes, for servers that accept
+    // 0-RTT to detect replays (QUIC_PARAM_GLOBAL_ZERO_RTT_ANTI_REPLAY).
+    //
+    QUIC_ANTI_REPLAY AntiReplay;
+
     //
     // Handle to global persistent storage (registry).
     //
@@ -230,6 +411,13 @@ typedef struct QUIC_LIBRARY {
     //
     CXPLAT_LIST_ENTRY Bindings;
 
+    //
+    // Index of all UDP bindings, keyed by local port for unconnected bindings
+    // and by the local/remote address pair for connected ones. Protected by
+    // DatapathLock, same as the Bindings list.
+    //
+    CXPLAT_HASHTABLE BindingsTable;
+
     //
     // Contains all (server) connections currently not in an app's registration.
     //
@@ -256,6 +444,20 @@ typedef struct QUIC_LIBRARY {
     //
     int64_t StatelessRetryKeysExpiration[2];
 
+    //
+    // Controls access to the QUIC-LB config and key, which may be rotated
+    // while in use.
+    //
+    CXPLAT_DISPATCH_LOCK LoadBalancingLock;
+
+    //
+    // The QUIC-LB config for QUIC_LOAD_BALANCING_SERVER_ID_QUIC_LB, and the
+    // AES-128-ECB key for it, if it encrypts.
+    //
+    BOOLEAN LoadBalancingConfigSet;
+    QUIC_LOAD_BALANCING_CONFIG LoadBalancingConfig;
+    CXPLAT_HP_KEY* LoadBalancingKey;
+
     //
     // The Toeplitz hash used for hashing received long header packets.
     //
@@ -281,6 +483,18 @@ typedef struct QUIC_LIBRARY {
     uint64_t PerfCounterSamplesTime;
     int64_t PerfCounterSamples[QUIC_PERF_COUNTER_MAX];
 
+    //
+    // The app's buffer that per-processor perf counters and histograms are
+    // exported to (QUIC_PARAM_GLOBAL_PERF_EXPORT), the time it was last
+    // updated, and the lock that keeps the buffer from changing during an
+    // update.
+    //
+    CXPLAT_DISPATCH_LOCK PerfExportLock;
+    QUIC_PERF_EXPORT PerfExport;
+    uint32_t PerfExportEntryCount;
+    BOOLEAN PerfExportEnabled;
+    uint64_t PerfExportTime;
+
     //
     // The worker pool
     //
@@ -338,6 +552,19 @@ QuicLibraryGetPartitionProcessor(
     return PartitionIndex;
 }
 
+//
+// Returns the current memory pressure level.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+inline
+QUIC_MEMORY_PRESSURE_LEVEL
+QuicLibraryGetMemoryPressure(
+    void
+    )
+{
+    return (QUIC_MEMORY_PRESSURE_LEVEL)MsQuicLib.MemoryPressureLevel;
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 inline
 QUIC_LIBRARY_PP*
@@ -351,6 +578,75 @@ QuicLibraryGetPerProc(
     return &MsQuicLib.PerProc[CurrentProc];
 }
 
+//
+// Returns the per-processor state for the partition's processor.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+inline
+QUIC_LIBRARY_PP*
+QuicLibraryGetPartitionPerProc(
+    uint16_t PartitionIndex
+    )
+{
+    CXPLAT_DBG_ASSERT(MsQuicLib.PerProc != NULL);
+    const uint16_t Proc =
+        QuicLibraryGetPartitionProcessor(PartitionIndex) % MsQuicLib.ProcessorCount;
+    return &MsQuicLib.PerProc[Proc];
+}
+
+//
+// Allocates from the reserve, or the pool once the reserve is empty.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+inline
+void*
+QuicObjectReserveAlloc(
+    _Inout_ QUIC_OBJECT_RESERVE* Reserve,
+    _Inout_ CXPLAT_POOL* Pool
+    )
+{
+    void* Entry = NULL;
+    if (Reserve->Depth != 0) {
+        CxPlatDispatchLockAcquire(&Reserve->Lock);
+        Entry = CxPlatListPopEntry(&Reserve->Head);
+        if (Entry != NULL) {
+            Reserve->Depth--;
+        }
+        CxPlatDispatchLockRelease(&Reserve->Lock);
+    }
+    if (Entry == NULL) {
+        Entry = CxPlatPoolAlloc(Pool);
+    }
+    return Entry;
+}
+
+//
+// Frees to the reserve, if it is below its target depth, or to the pool.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+inline
+void
+QuicObjectReserveFree(
+    _Inout_ QUIC_OBJECT_RESERVE* Reserve,
+    _Inout_ CXPLAT_POOL* Pool,
+    _In_ void* Entry
+    )
+{
+    if (Reserve->Depth < Reserve->TargetDepth) {
+        CxPlatDispatchLockAcquire(&Reserve->Lock);
+        if (Reserve->Depth < Reserve->TargetDepth) {
+            CxPlatListPushEntry(&Reserve->Head, (CXPLAT_SLIST_ENTRY*)Entry);
+            Reserve->Depth++;
+            Entry = NULL;
+        }
+        CxPlatDispatchLockRelease(&Reserve->Lock);
+        if (Entry == NULL) {
+            return;
+        }
+    }
+    CxPlatPoolFree(Pool, Entry);
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 inline
 uint16_t
@@ -445,6 +741,283 @@ QuicPerfCounterTrySnapShot(
     QuicPerfCounterSnapShot(TimeDiff);
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+inline
+void
+QuicPerfHistogramRecord(
+    _In_ QUIC_PERF_HISTOGRAMS Type,
+    _In_ uint64_t ValueUs
+    )
+{
+    CXPLAT_DBG_ASSERT(Type >= 0 && Type < QUIC_PERF_HISTOGRAM_MAX);
+    if (!MsQuicLib.PerfExportEnabled) {
+        return;
+    }
+
+    QUIC_PERF_HISTOGRAM* Histogram = &QuicLibraryGetPerProc()->PerfHistograms[Type];
+    const uint32_t Value = ValueUs > UINT32_MAX ? UINT32_MAX : (uint32_t)ValueUs;
+    InterlockedIncrement64(&Histogram->Buckets[QuicLatencyHistogramBucket(Value)]);
+    InterlockedIncrement64(&Histogram->Count);
+    InterlockedExchangeAdd64(&Histogram->Sum, (int64_t)ValueUs);
+    if ((int64_t)ValueUs > Histogram->Max) {
+        Histogram->Max = (int64_t)ValueUs; // Racy, but only ever a little off.
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicPerfExportUpdate(
+    _In_ uint64_t TimeNow
+    );
+
+#ifdef QUIC_STAGE_CYCLES
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+inline
+void
+QuicStageCyclesRecord(
+    _In_ QUIC_PERF_STAGES Stage,
+    _In_ uint64_t Cycles,
+    _In_ uint32_t Calls
+    )
+{
+    CXPLAT_DBG_ASSERT(Stage >= 0 && Stage < QUIC_PERF_STAGE_MAX);
+    QUIC_PERF_STAGE_CYCLES* StageCycles = &QuicLibraryGetPerProc()->StageCycles[Stage];
+    InterlockedExchangeAdd64((int64_t*)&StageCycles->Cycles, (int64_t)Cycles);
+    InterlockedExchangeAdd64((int64_t*)&StageCycles->Calls, (int64_t)Calls);
+}
+
+//
+// Times a pipeline stage. Start declares a local holding the start count, so
+// each timed region needs its own name.
+//
+#define QuicStageCyclesStart(Start) \
+    const uint64_t Start = CxPlatCycleCount()
+#define QuicStageCyclesEnd(Stage, Start, Calls) \
+    QuicStageCyclesRecord(Stage, CxPlatCycleCount() - (Start), Calls)
+
+#else
+
+#define QuicStageCyclesStart(Start)
+#define QuicStageCyclesEnd(Stage, Start, Calls)
+
+#endif
+
+//
+// Updates the app's perf export buffer, if it is enabled and due.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+inline
+void
+QuicPerfExportTryUpdate(
+    _In_ uint64_t TimeNow
+    )
+{
+    if (!MsQuicLib.PerfExportEnabled) {
+        return;
+    }
+
+    uint64_t TimeLast = MsQuicLib.PerfExportTime;
+    if (CxPlatTimeDiff64(TimeLast, TimeNow) < MsQuicLib.PerfExport.IntervalUs) {
+        return; // Not time to update yet.
+    }
+
+    if ((int64_t)TimeLast !=
+        InterlockedCompareExchange64(
+            (int64_t*)&MsQuicLib.PerfExportTime,
+            (int64_t)TimeNow,
+            (int64_t)TimeLast)) {
+        return; // Someone else already is updating.
+    }
+
+    QuicPerfExportUpdate(TimeNow);
+}
+
+//
+// Allocates the memory for a source connection ID of the given length. All
+// connection IDs allowed by QUIC v1 and v2 come from a per-processor pool, so
+// CID churn (new CIDs, retirement, migration) doesn't hit the heap.
+//
+inline
+_Success_(return != NULL)
+QUIC_CID_HASH_ENTRY*
+QuicCidAllocSource(
+    _In_ uint8_t Length
+    )
+{
+    if (Length <= QUIC_MAX_CONNECTION_ID_LENGTH_V1) {
+        return (QUIC_CID_HASH_ENTRY*)CxPlatPoolAlloc(&QuicLibraryGetPerProc()->SourceCidPool);
+    }
+    return
+        (QUIC_CID_HASH_ENTRY*)
+        CXPLAT_ALLOC_NONPAGED(
+            sizeof(QUIC_CID_HASH_ENTRY) +
+            Length,
+            QUIC_POOL_CIDHASH);
+}
+
+//
+// Frees a source connection ID allocated with QuicCidAllocSource.
+//
+inline
+void
+QuicCidFreeSource(
+    _In_ __drv_freesMem(Mem) QUIC_CID_HASH_ENTRY* Entry
+    )
+{
+    if (Entry->CID.Length <= QUIC_MAX_CONNECTION_ID_LENGTH_V1) {
+        CxPlatPoolFree(&QuicLibraryGetPerProc()->SourceCidPool, Entry);
+    } else {
+        CXPLAT_FREE(Entry, QUIC_POOL_CIDHASH);
+    }
+}
+
+//
+// Allocates the memory for a destination connection ID of the given length.
+//
+inline
+_Success_(return != NULL)
+QUIC_CID_LIST_ENTRY*
+QuicCidAllocDestination(
+    _In_ uint8_t Length
+    )
+{
+    if (Length <= QUIC_MAX_CONNECTION_ID_LENGTH_V1) {
+        return (QUIC_CID_LIST_ENTRY*)CxPlatPoolAlloc(&QuicLibraryGetPerProc()->DestCidPool);
+    }
+    return
+        (QUIC_CID_LIST_ENTRY*)
+        CXPLAT_ALLOC_NONPAGED(
+            sizeof(QUIC_CID_LIST_ENTRY) +
+            Length,
+            QUIC_POOL_CIDLIST);
+}
+
+//
+// Frees a destination connection ID allocated with QuicCidAllocDestination.
+//   N.B. The CID may have been shortened in place since it was allocated, in
+//   which case a larger heap allocation ends up in the pool. That is harmless.
+//
+inline
+void
+QuicCidFreeDestination(
+    _In_ __drv_freesMem(Mem) QUIC_CID_LIST_ENTRY* Entry
+    )
+{
+    if (Entry->CID.Length <= QUIC_MAX_CONNECTION_ID_LENGTH_V1) {
+        CxPlatPoolFree(&QuicLibraryGetPerProc()->DestCidPool, Entry);
+    } else {
+        CXPLAT_FREE(Entry, QUIC_POOL_CIDLIST);
+    }
+}
+
+//
+// Creates a new null/empty source connection ID, that will be used on the
+// receive path.
+//
+inline
+_Success_(return != NULL)
+QUIC_CID_HASH_ENTRY*
+QuicCidNewNullSource(
+    _In_ QUIC_CONNECTION* Connection
+    )
+{
+    QUIC_CID_HASH_ENTRY* Entry = QuicCidAllocSource(0);
+
+    if (Entry != NULL) {
+        Entry->Connection = Connection;
+        CxPlatZeroMemory(&Entry->CID, sizeof(Entry->CID));
+    }
+
+    return Entry;
+}
+
+//
+// Creates a source connection ID from a pre-existing CID buffer.
+//
+inline
+_Success_(return != NULL)
+QUIC_CID_HASH_ENTRY*
+QuicCidNewSource(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ uint8_t Length,
+    _In_reads_(Length)
+        const uint8_t* const Data
+    )
+{
+    QUIC_CID_HASH_ENTRY* Entry = QuicCidAllocSource(Length);
+
+    if (Entry != NULL) {
+        Entry->Connection = Connection;
+        CxPlatZeroMemory(&Entry->CID, sizeof(Entry->CID));
+        Entry->CID.Length = Length;
+        if (Length != 0) {
+            memcpy(Entry->CID.Data, Data, Length);
+        }
+    }
+
+    return Entry;
+}
+
+//
+// Used for the client's Initial packet (and 0-RTT), this creates a random
+// destination connection ID.
+//
+inline
+_Success_(return != NULL)
+QUIC_CID_LIST_ENTRY*
+QuicCidNewRandomDestination(
+    )
+{
+    QUIC_CID_LIST_ENTRY* Entry =
+        QuicCidAllocDestination(QUIC_MIN_INITIAL_CONNECTION_ID_LENGTH);
+
+    if (Entry != NULL) {
+        QUIC_CID_CLEAR_PATH(Entry);
+        CxPlatZeroMemory(&Entry->CID, sizeof(Entry->CID));
+        Entry->CID.Length = QUIC_MIN_INITIAL_CONNECTION_ID_LENGTH;
+        CxPlatRandom(QUIC_MIN_INITIAL_CONNECTION_ID_LENGTH, Entry->CID.Data);
+    }
+
+    return Entry;
+}
+
+//
+// Creates a destination connection ID from a pre-existing CID buffer.
+//
+inline
+_Success_(return != NULL)
+QUIC_CID_LIST_ENTRY*
+QuicCidNewDestination(
+    _In_ uint8_t Length,
+    _In_reads_(Length)
+        const uint8_t* const Data
+    )
+{
+    QUIC_CID_LIST_ENTRY* Entry = QuicCidAllocDestination(Length);
+
+    if (Entry != NULL) {
+        QUIC_CID_CLEAR_PATH(Entry);
+        CxPlatZeroMemory(&Entry->CID, sizeof(Entry->CID));
+        Entry->CID.Length = Length;
+        if (Length != 0) {
+            memcpy(Entry->CID.Data, Data, Length);
+        }
+    }
+
+    return Entry;
+}
+
+//
+// Writes the QUIC-LB encoded server ID of a new source connection ID.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicLibraryEncodeLoadBalancingCid(
+    _Out_writes_(MsQuicLib.CidServerIdLength)
+        uint8_t* Cid
+    );
+
 //
 // Creates a random, new source connection ID, that will be used on the receive
 // path.
@@ -466,12 +1039,7 @@ QuicCidNewRandomSource(
     CXPLAT_DBG_ASSERT(MsQuicLib.CidTotalLength == MsQuicLib.CidServerIdLength + QUIC_CID_PID_LENGTH + QUIC_CID_PAYLOAD_LENGTH);
     CXPLAT_DBG_ASSERT(QUIC_CID_PAYLOAD_LENGTH > PrefixLength);
 
-    QUIC_CID_HASH_ENTRY* Entry =
-        (QUIC_CID_HASH_ENTRY*)
-        CXPLAT_ALLOC_NONPAGED(
-            sizeof(QUIC_CID_HASH_ENTRY) +
-            MsQuicLib.CidTotalLength,
-            QUIC_POOL_CIDHASH);
+    QUIC_CID_HASH_ENTRY* Entry = QuicCidAllocSource(MsQuicLib.CidTotalLength);
 
     if (Entry != NULL) {
         Entry->Connection = Connection;
@@ -479,10 +1047,12 @@ QuicCidNewRandomSource(
         Entry->CID.Length = MsQuicLib.CidTotalLength;
 
         uint8_t* Data = Entry->CID.Data;
-        if (ServerID != NULL) {
-            CxPlatCopyMemory(Data, ServerID, MsQuicLib.CidServerIdLength);
-        } else {
+        if (ServerID == NULL) {
             CxPlatRandom(MsQuicLib.CidServerIdLength, Data);
+        } else if (MsQuicLib.Settings.LoadBalancingMode == QUIC_LOAD_BALANCING_SERVER_ID_QUIC_LB) {
+            QuicLibraryEncodeLoadBalancingCid(Data);
+        } else {
+            CxPlatCopyMemory(Data, ServerID, MsQuicLib.CidServerIdLength);
         }
         Data += MsQuicLib.CidServerIdLength;
 
@@ -636,6 +1206,16 @@ QuicLibraryOnHandshakeConnectionRemoved(
     void
     );
 
+//
+// Called when any of the usage counters tracked against the memory budget
+// change. Updates the memory pressure level and notifies the app.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicLibraryEvaluateMemoryPressure(
+    void
+    );
+
 //
 // Generates a stateless reset token for the given connection ID.
 //
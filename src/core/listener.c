@@ -20,6 +20,62 @@ QuicListenerStopAsync(
     _In_ QUIC_LISTENER* Listener
     );
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicListenerReleaseStartRefs(
+    _In_ QUIC_LISTENER* Listener,
+    _In_ BOOLEAN IndicateEvent
+    );
+
+typedef struct QUIC_LISTENER_SNI_ENTRY {
+
+    CXPLAT_HASHTABLE_ENTRY HashEntry;
+    QUIC_CONFIGURATION* Configuration;
+    uint16_t ServerNameLength;
+    char ServerName[0]; // Lower case
+
+} QUIC_LISTENER_SNI_ENTRY;
+
+//
+// An immutable map from server name to configuration. The listener swaps in a
+// new table when the app sets QUIC_PARAM_LISTENER_SNI_CONFIGURATIONS.
+//
+typedef struct QUIC_LISTENER_SNI_TABLE {
+
+    CXPLAT_HASHTABLE Table;
+
+    //
+    // Used when the server name isn't in the table. May be NULL.
+    //
+    QUIC_CONFIGURATION* DefaultConfiguration;
+
+} QUIC_LISTENER_SNI_TABLE;
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+void
+QuicListenerSniTableFree(
+    _In_ __drv_freesMem(Mem) QUIC_LISTENER_SNI_TABLE* SniTable
+    )
+{
+    CXPLAT_HASHTABLE_ENUMERATOR Enumerator;
+    CXPLAT_HASHTABLE_ENTRY* Entry;
+    CxPlatHashtableEnumerateBegin(&SniTable->Table, &Enumerator);
+    while ((Entry = CxPlatHashtableEnumerateNext(&SniTable->Table, &Enumerator)) != NULL) {
+        QUIC_LISTENER_SNI_ENTRY* SniEntry =
+            CXPLAT_CONTAINING_RECORD(Entry, QUIC_LISTENER_SNI_ENTRY, HashEntry);
+        CxPlatHashtableRemove(&SniTable->Table, Entry, NULL);
+        QuicConfigurationRelease(SniEntry->Configuration);
+        CXPLAT_FREE(SniEntry, QUIC_POOL_LISTENER_SNI);
+    }
+    CxPlatHashtableEnumerateEnd(&SniTable->Table, &Enumerator);
+    CxPlatHashtableUninitialize(&SniTable->Table);
+    if (SniTable->DefaultConfiguration != NULL) {
+        QuicConfigurationRelease(SniTable->DefaultConfiguration);
+    }
+    CXPLAT_FREE(SniTable, QUIC_POOL_LISTENER_SNI);
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 QUIC_STATUS
 QUIC_API
@@ -69,6 +125,7 @@ MsQuicListenerOpen(
     Listener->ClientContext = Context;
     Listener->Stopped = TRUE;
     CxPlatEventInitialize(&Listener->StopEvent, TRUE, TRUE);
+    CxPlatDispatchRwLockInitialize(&Listener->SniLock);
 
 #ifdef QUIC_SILO
     Listener->Silo = QuicSiloGetCurrentServer();
@@ -89,6 +146,7 @@ MsQuicListenerOpen(
 
     if (RegistrationShuttingDown) {
         CxPlatRundownRelease(&Registration->Rundown);
+        CxPlatDispatchRwLockUninitialize(&Listener->SniLock);
         CxPlatEventUninitialize(Listener->StopEvent);
         CXPLAT_FREE(Listener, QUIC_POOL_LISTENER);
         Listener = NULL;
@@ -141,6 +199,13 @@ QuicListenerFree(
     CxPlatDispatchLockRelease(&Listener->Registration->ConnectionLock);
 
     CxPlatRefUninitialize(&Listener->RefCount);
+    if (Listener->Partitions != NULL) {
+        CXPLAT_FREE(Listener->Partitions, QUIC_POOL_LISTENER_PARTITION);
+    }
+    if (Listener->SniTable != NULL) {
+        QuicListenerSniTableFree(Listener->SniTable);
+    }
+    CxPlatDispatchRwLockUninitialize(&Listener->SniLock);
     CxPlatEventUninitialize(Listener->StopEvent);
     CXPLAT_DBG_ASSERT(Listener->AlpnList == NULL);
     CXPLAT_FREE(Listener, QUIC_POOL_LISTENER);
@@ -281,6 +346,11 @@ MsQuicListenerStart(
         AlpnList += AlpnBuffers[i].Length;
     }
 
+    QuicAlpnFilterBuild(
+        Listener->AlpnListLength,
+        Listener->AlpnList,
+        &Listener->AlpnFilter);
+
     if (LocalAddress != NULL) {
         CxPlatCopyMemory(&Listener->LocalAddress, LocalAddress, sizeof(QUIC_ADDR));
         Listener->WildCard = QuicAddrIsWildCard(LocalAddress);
@@ -329,6 +399,26 @@ MsQuicListenerStart(
             UdpConfig.CibirIdLength);
     }
 
+    // for steering short header packets to the partition owning their CID
+    UdpConfig.CidPartitionIdOffset = MsQuicLib.CidServerIdLength;
+    UdpConfig.CidPartitionMask = MsQuicLib.PartitionMask;
+    UdpConfig.CidPartitionCount = MsQuicLib.PartitionCount;
+
+    // for early filtering of invalid packets by the RAW datapath
+    UdpConfig.FilterCidLength = MsQuicLib.CidTotalLength;
+    if (MsQuicLib.Settings.LoadBalancingMode == QUIC_LOAD_BALANCING_SERVER_ID_FIXED) {
+        //
+        // Only a fixed server ID is known up front. The others depend on the
+        // local address or are encrypted.
+        //
+        UdpConfig.FilterServerIdOffset = 1; // After the random first byte.
+        UdpConfig.FilterServerIdLength = sizeof(MsQuicLib.Settings.FixedServerID);
+        CxPlatCopyMemory(
+            UdpConfig.FilterServerId,
+            &MsQuicLib.Settings.FixedServerID,
+            sizeof(MsQuicLib.Settings.FixedServerID));
+    }
+
     CXPLAT_TEL_ASSERT(Listener->Binding == NULL);
     Status =
         QuicLibraryGetBinding(
@@ -347,6 +437,16 @@ MsQuicListenerStart(
     Listener->Stopped = FALSE;
     CxPlatEventReset(Listener->StopEvent);
     CxPlatRefInitialize(&Listener->RefCount);
+    if (Listener->Partitions != NULL) {
+        //
+        // Each partition holds a reference on the listener until it is
+        // stopped, and the partition's own base reference is released then.
+        //
+        for (uint16_t i = 0; i < MsQuicLib.PartitionCount; ++i) {
+            CxPlatRefInitialize(&Listener->Partitions[i].RefCount);
+        }
+        CxPlatRefIncrementNonZero(&Listener->RefCount, MsQuicLib.PartitionCount);
+    }
 
     Status = QuicBindingRegisterListener(Listener->Binding, Listener);
     if (QUIC_FAILED(Status)) {
@@ -356,7 +456,7 @@ MsQuicListenerStart(
             Listener,
             Status,
             "Register with binding");
-        QuicListenerRelease(Listener, FALSE);
+        QuicListenerReleaseStartRefs(Listener, FALSE);
         goto Error;
     }
 
@@ -476,6 +576,61 @@ QuicListenerRelease(
     }
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicListenerAcquirePartitionRef(
+    _In_ QUIC_LISTENER* Listener,
+    _In_ uint16_t PartitionIndex
+    )
+{
+    if (Listener->Partitions != NULL) {
+        CXPLAT_DBG_ASSERT(PartitionIndex < MsQuicLib.PartitionCount);
+        return
+            CxPlatRefIncrementNonZero(
+                &Listener->Partitions[PartitionIndex].RefCount, 1);
+    }
+    return CxPlatRefIncrementNonZero(&Listener->RefCount, 1);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicListenerReleasePartitionRef(
+    _In_ QUIC_LISTENER* Listener,
+    _In_ uint16_t PartitionIndex,
+    _In_ BOOLEAN IndicateEvent
+    )
+{
+    if (Listener->Partitions != NULL) {
+        CXPLAT_DBG_ASSERT(PartitionIndex < MsQuicLib.PartitionCount);
+        if (CxPlatRefDecrement(&Listener->Partitions[PartitionIndex].RefCount)) {
+            QuicListenerRelease(Listener, IndicateEvent);
+        }
+    } else {
+        QuicListenerRelease(Listener, IndicateEvent);
+    }
+}
+
+//
+// Releases the references taken when the listener was started. The last one
+// released completes the stop.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicListenerReleaseStartRefs(
+    _In_ QUIC_LISTENER* Listener,
+    _In_ BOOLEAN IndicateEvent
+    )
+{
+    if (Listener->Partitions != NULL) {
+        for (uint16_t i = 0; i < MsQuicLib.PartitionCount; ++i) {
+            if (CxPlatRefDecrement(&Listener->Partitions[i].RefCount)) {
+                QuicListenerRelease(Listener, IndicateEvent);
+            }
+        }
+    }
+    QuicListenerRelease(Listener, IndicateEvent);
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicListenerStopAsync(
@@ -487,7 +642,7 @@ QuicListenerStopAsync(
         QuicLibraryReleaseBinding(Listener->Binding);
         Listener->Binding = NULL;
 
-        QuicListenerRelease(Listener, TRUE);
+        QuicListenerReleaseStartRefs(Listener, TRUE);
     }
 }
 
@@ -537,10 +692,57 @@ QuicListenerTraceRundown(
     }
 }
 
+//
+// Returns the filter bit for a length prefixed ALPN.
+//
+static
+uint8_t
+QuicAlpnFilterIndex(
+    _In_reads_(Alpn[0] + 1)
+        const uint8_t* Alpn
+    )
+{
+    return (uint8_t)(Alpn[0] * 31 + Alpn[1] * 7 + Alpn[Alpn[0]]);
+}
+
+static
+BOOLEAN
+QuicAlpnFilterContains(
+    _In_ const QUIC_ALPN_FILTER* Filter,
+    _In_reads_(Alpn[0] + 1)
+        const uint8_t* Alpn
+    )
+{
+    const uint8_t Index = QuicAlpnFilterIndex(Alpn);
+    return (Filter->Bits[Index / 64] & (1ull << (Index % 64))) != 0;
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicAlpnFilterBuild(
+    _In_ uint16_t AlpnListLength,
+    _In_reads_(AlpnListLength)
+        const uint8_t* AlpnList,
+    _Out_ QUIC_ALPN_FILTER* Filter
+    )
+{
+    CxPlatZeroMemory(Filter, sizeof(*Filter));
+    while (AlpnListLength != 0 &&
+           AlpnList[0] != 0 &&
+           AlpnList[0] + 1 <= AlpnListLength) {
+        const uint8_t Index = QuicAlpnFilterIndex(AlpnList);
+        Filter->Bits[Index / 64] |= 1ull << (Index % 64);
+        AlpnListLength -= AlpnList[0] + 1;
+        AlpnList += AlpnList[0] + 1;
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+static
 const uint8_t*
-QuicListenerFindAlpnInList(
+QuicListenerFindAlpnInFilteredList(
     _In_ const QUIC_LISTENER* Listener,
+    _In_ const QUIC_ALPN_FILTER* OtherAlpnFilter,
     _In_ uint16_t OtherAlpnListLength,
     _In_reads_(OtherAlpnListLength)
         const uint8_t* OtherAlpnList
@@ -549,24 +751,32 @@ QuicListenerFindAlpnInList(
     const uint8_t* AlpnList = Listener->AlpnList;
     uint16_t AlpnListLength = Listener->AlpnListLength;
 
+    uint64_t Overlap = 0;
+    for (uint32_t i = 0; i < ARRAYSIZE(OtherAlpnFilter->Bits); ++i) {
+        Overlap |= Listener->AlpnFilter.Bits[i] & OtherAlpnFilter->Bits[i];
+    }
+    if (Overlap == 0) {
+        return NULL; // No ALPN can match.
+    }
+
     //
     // We want to respect the server's ALPN preference order (i.e. Listener) and
     // not the client's. So we loop over every ALPN in the listener and then see
-    // if there is a match in the client's list.
+    // if there is a match in the client's list. Only ALPNs that pass the other
+    // list's filter need the full comparison.
     //
 
     while (AlpnListLength != 0) {
         CXPLAT_ANALYSIS_ASSUME(AlpnList[0] + 1 <= AlpnListLength);
-        const uint8_t* Result =
+        if (QuicAlpnFilterContains(OtherAlpnFilter, AlpnList) &&
             CxPlatTlsAlpnFindInList(
                 OtherAlpnListLength,
                 OtherAlpnList,
                 AlpnList[0],
-                AlpnList + 1);
-        if (Result != NULL) {
+                AlpnList + 1) != NULL) {
             //
-            // Return AlpnList instead of Result, since Result points into what
-            // might be a temporary buffer.
+            // Return AlpnList instead of the match in the other list, since
+            // that points into what might be a temporary buffer.
             //
             return AlpnList;
         }
@@ -585,8 +795,9 @@ QuicListenerHasAlpnOverlap(
     )
 {
     return
-        QuicListenerFindAlpnInList(
+        QuicListenerFindAlpnInFilteredList(
             Listener1,
+            &Listener2->AlpnFilter,
             Listener2->AlpnListLength,
             Listener2->AlpnList) != NULL;
 }
@@ -595,11 +806,16 @@ _IRQL_requires_max_(DISPATCH_LEVEL)
 BOOLEAN
 QuicListenerMatchesAlpn(
     _In_ const QUIC_LISTENER* Listener,
+    _In_ const QUIC_ALPN_FILTER* ClientAlpnFilter,
     _In_ QUIC_NEW_CONNECTION_INFO* Info
     )
 {
     const uint8_t* Alpn =
-        QuicListenerFindAlpnInList(Listener, Info->ClientAlpnListLength, Info->ClientAlpnList);
+        QuicListenerFindAlpnInFilteredList(
+            Listener,
+            ClientAlpnFilter,
+            Info->ClientAlpnListLength,
+            Info->ClientAlpnList);
     if (Alpn != NULL) {
         Info->NegotiatedAlpnLength = Alpn[0]; // The length prefixed to the ALPN buffer.
         Info->NegotiatedAlpn = Alpn + 1;
@@ -608,6 +824,276 @@ QuicListenerMatchesAlpn(
     return FALSE;
 }
 
+static
+char
+QuicSniToLower(
+    _In_ char Char
+    )
+{
+    return (Char >= 'A' && Char <= 'Z') ? (char)(Char - 'A' + 'a') : Char;
+}
+
+//
+// Case insensitive hash of a server name. Wildcard hashes a leading '*' first,
+// so that "*" + ".example.com" hashes the same as "*.example.com".
+//
+static
+QUIC_NO_SANITIZE("unsigned-integer-overflow")
+uint32_t
+QuicSniHash(
+    _In_ BOOLEAN Wildcard,
+    _In_ uint16_t Length,
+    _In_reads_(Length)
+        const char* Name
+    )
+{
+    uint32_t Hash = 5387;
+    if (Wildcard) {
+        Hash = ((Hash << 5) - Hash) + (uint8_t)'*';
+    }
+    for (uint16_t i = 0; i < Length; ++i) {
+        Hash = ((Hash << 5) - Hash) + (uint8_t)QuicSniToLower(Name[i]);
+    }
+    return Hash;
+}
+
+static
+QUIC_LISTENER_SNI_ENTRY*
+QuicListenerSniTableLookup(
+    _In_ const QUIC_LISTENER_SNI_TABLE* SniTable,
+    _In_ BOOLEAN Wildcard,
+    _In_ uint16_t Length,
+    _In_reads_(Length)
+        const char* Name
+    )
+{
+    const uint16_t EntryLength = Length + (Wildcard ? 1 : 0);
+    CXPLAT_HASHTABLE_LOOKUP_CONTEXT Context;
+    CXPLAT_HASHTABLE_ENTRY* Entry =
+        CxPlatHashtableLookup(
+            &SniTable->Table,
+            QuicSniHash(Wildcard, Length, Name),
+            &Context);
+    while (Entry != NULL) {
+        QUIC_LISTENER_SNI_ENTRY* SniEntry =
+            CXPLAT_CONTAINING_RECORD(Entry, QUIC_LISTENER_SNI_ENTRY, HashEntry);
+        if (SniEntry->ServerNameLength == EntryLength &&
+            (!Wildcard || SniEntry->ServerName[0] == '*')) {
+            const char* EntryName = SniEntry->ServerName + (Wildcard ? 1 : 0);
+            uint16_t i = 0;
+            while (i < Length && EntryName[i] == QuicSniToLower(Name[i])) {
+                ++i;
+            }
+            if (i == Length) {
+                return SniEntry;
+            }
+        }
+        Entry = CxPlatHashtableLookupNext(&SniTable->Table, &Context);
+    }
+    return NULL;
+}
+
+//
+// Returns the configuration mapped to the client's server name, with a
+// reference added, or NULL if there isn't one.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+static
+QUIC_CONFIGURATION*
+QuicListenerGetSniConfiguration(
+    _In_ QUIC_LISTENER* Listener,
+    _In_ const QUIC_NEW_CONNECTION_INFO* Info
+    )
+{
+    QUIC_CONFIGURATION* Configuration = NULL;
+
+    if (Listener->SniTable == NULL) {
+        return NULL; // Not configured; skip the lock.
+    }
+
+    CxPlatDispatchRwLockAcquireShared(&Listener->SniLock);
+    const QUIC_LISTENER_SNI_TABLE* SniTable = Listener->SniTable;
+    if (SniTable != NULL) {
+        const QUIC_LISTENER_SNI_ENTRY* SniEntry = NULL;
+        const uint16_t Length = Info->ServerNameLength;
+        const char* Name = Info->ServerName;
+        if (Length != 0 && Name != NULL) {
+            SniEntry = QuicListenerSniTableLookup(SniTable, FALSE, Length, Name);
+            if (SniEntry == NULL) {
+                //
+                // Try a wildcard for the first label.
+                //
+                uint16_t Dot = 0;
+                while (Dot < Length && Name[Dot] != '.') {
+                    ++Dot;
+                }
+                if (Dot != 0 && Dot < Length) {
+                    SniEntry =
+                        QuicListenerSniTableLookup(
+                            SniTable, TRUE, Length - Dot, Name + Dot);
+                }
+            }
+        }
+        Configuration =
+            SniEntry != NULL ?
+                SniEntry->Configuration : SniTable->DefaultConfiguration;
+        if (Configuration != NULL) {
+            QuicConfigurationAddRef(Configuration);
+        }
+    }
+    CxPlatDispatchRwLockReleaseShared(&Listener->SniLock);
+
+    return Configuration;
+}
+
+//
+// Builds a new table from the app's array of mappings.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+QUIC_STATUS
+QuicListenerSniTableCreate(
+    _In_ uint32_t Count,
+    _In_reads_(Count)
+        const QUIC_LISTENER_SNI_CONFIGURATION* Mappings,
+    _Outptr_ QUIC_LISTENER_SNI_TABLE** NewSniTable
+    )
+{
+    QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
+
+    QUIC_LISTENER_SNI_TABLE* SniTable =
+        CXPLAT_ALLOC_NONPAGED(sizeof(QUIC_LISTENER_SNI_TABLE), QUIC_POOL_LISTENER_SNI);
+    if (SniTable == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "listener SNI table",
+            sizeof(QUIC_LISTENER_SNI_TABLE));
+        return QUIC_STATUS_OUT_OF_MEMORY;
+    }
+    CxPlatZeroMemory(SniTable, sizeof(QUIC_LISTENER_SNI_TABLE));
+
+    if (!CxPlatHashtableInitializeEx(&SniTable->Table, CXPLAT_HASH_MIN_SIZE)) {
+        CXPLAT_FREE(SniTable, QUIC_POOL_LISTENER_SNI);
+        return QUIC_STATUS_OUT_OF_MEMORY;
+    }
+
+    for (uint32_t i = 0; i < Count; ++i) {
+        const HQUIC Handle = Mappings[i].Configuration;
+        if (Handle == NULL || Handle->Type != QUIC_HANDLE_TYPE_CONFIGURATION) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            goto Error;
+        }
+#pragma prefast(suppress: __WARNING_25024, "Pointer cast already validated.")
+        QUIC_CONFIGURATION* Configuration = (QUIC_CONFIGURATION*)Handle;
+        if (Configuration->SecurityConfig == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER; // No credential loaded.
+            goto Error;
+        }
+
+        if (Mappings[i].ServerName == NULL) {
+            if (SniTable->DefaultConfiguration != NULL) {
+                Status = QUIC_STATUS_INVALID_PARAMETER; // Duplicate default.
+                goto Error;
+            }
+            QuicConfigurationAddRef(Configuration);
+            SniTable->DefaultConfiguration = Configuration;
+            continue;
+        }
+
+        const size_t Length = strnlen(Mappings[i].ServerName, QUIC_MAX_SNI_LENGTH + 1);
+        if (Length == 0 || Length > QUIC_MAX_SNI_LENGTH) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            goto Error;
+        }
+        const char* Name = Mappings[i].ServerName;
+        const BOOLEAN Wildcard = Name[0] == '*';
+        if (Wildcard && (Length < 3 || Name[1] != '.')) {
+            Status = QUIC_STATUS_INVALID_PARAMETER; // Only "*.<name>".
+            goto Error;
+        }
+        if (QuicListenerSniTableLookup(
+                SniTable,
+                Wildcard,
+                (uint16_t)Length - (Wildcard ? 1 : 0),
+                Name + (Wildcard ? 1 : 0)) != NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER; // Duplicate name.
+            goto Error;
+        }
+
+        QUIC_LISTENER_SNI_ENTRY* SniEntry =
+            CXPLAT_ALLOC_NONPAGED(
+                sizeof(QUIC_LISTENER_SNI_ENTRY) + Length,
+                QUIC_POOL_LISTENER_SNI);
+        if (SniEntry == NULL) {
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "listener SNI entry",
+                sizeof(QUIC_LISTENER_SNI_ENTRY) + Length);
+            Status = QUIC_STATUS_OUT_OF_MEMORY;
+            goto Error;
+        }
+        for (size_t j = 0; j < Length; ++j) {
+            SniEntry->ServerName[j] = QuicSniToLower(Name[j]);
+        }
+        SniEntry->ServerNameLength = (uint16_t)Length;
+        QuicConfigurationAddRef(Configuration);
+        SniEntry->Configuration = Configuration;
+        (void)CxPlatHashtableInsert(
+            &SniTable->Table,
+            &SniEntry->HashEntry,
+            QuicSniHash(FALSE, (uint16_t)Length, Name),
+            NULL);
+    }
+
+    *NewSniTable = SniTable;
+    return QUIC_STATUS_SUCCESS;
+
+Error:
+
+    QuicListenerSniTableFree(SniTable);
+    return Status;
+}
+
+//
+// Gives the connection the configuration mapped to its server name, if any.
+// This is queued the same way as the app calling ConnectionSetConfiguration
+// from the NEW_CONNECTION event, so a configuration the app sets there is
+// applied first and takes precedence.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+void
+QuicListenerQueueSniConfiguration(
+    _In_ QUIC_LISTENER* Listener,
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ const QUIC_NEW_CONNECTION_INFO* Info
+    )
+{
+    QUIC_CONFIGURATION* Configuration =
+        QuicListenerGetSniConfiguration(Listener, Info);
+    if (Configuration == NULL) {
+        return;
+    }
+
+    QUIC_OPERATION* Oper =
+        QuicOperationAlloc(Connection->Worker, QUIC_OPER_TYPE_API_CALL);
+    if (Oper == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "CONN_SET_CONFIGURATION operation",
+            0);
+        QuicConfigurationRelease(Configuration);
+        return;
+    }
+
+    Oper->API_CALL.Context->Type = QUIC_API_TYPE_CONN_SET_CONFIGURATION;
+    Oper->API_CALL.Context->CONN_SET_CONFIGURATION.Configuration = Configuration;
+    QuicConnQueueOper(Connection, Oper);
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 BOOLEAN
 QuicListenerClaimConnection(
@@ -674,9 +1160,42 @@ QuicListenerClaimConnection(
         Connection->State.UpdateWorker = TRUE;
     }
 
+    if (!Connection->State.HandleClosed &&
+        Connection->Configuration == NULL) {
+        QuicListenerQueueSniConfiguration(Listener, Connection, Info);
+    }
+
     return !Connection->State.HandleClosed;
 }
 
+//
+// Updates the accept stats, on the connection's partition if the listener is
+// partitioned.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+void
+QuicListenerOnAcceptResult(
+    _In_ QUIC_LISTENER* Listener,
+    _In_ const QUIC_CONNECTION* Connection,
+    _In_ BOOLEAN Accepted
+    )
+{
+    uint64_t* Accepts = &Listener->TotalAcceptedConnections;
+    uint64_t* Rejects = &Listener->TotalRejectedConnections;
+    if (Listener->Partitions != NULL) {
+        QUIC_LISTENER_PARTITION* Partition =
+            &Listener->Partitions[QuicPartitionIdGetIndex(Connection->PartitionID)];
+        Accepts = &Partition->TotalAcceptedConnections;
+        Rejects = &Partition->TotalRejectedConnections;
+    }
+    if (Accepted) {
+        (*Accepts)++;
+    } else {
+        (*Rejects)++;
+    }
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicListenerAcceptConnection(
@@ -685,6 +1204,19 @@ QuicListenerAcceptConnection(
     _In_ const QUIC_NEW_CONNECTION_INFO* Info
     )
 {
+    if (Listener->Draining) {
+        QuicTraceEvent(
+            ConnError,
+            "[conn][%p] ERROR, %s.",
+            Connection,
+            "Connection rejected by listener (draining)");
+        QuicConnTransportError(
+            Connection,
+            QUIC_ERROR_CONNECTION_REFUSED);
+        QuicListenerOnAcceptResult(Listener, Connection, FALSE);
+        return;
+    }
+
     if (!QuicRegistrationAcceptConnection(
             Listener->Registration,
             Connection)) {
@@ -696,7 +1228,7 @@ QuicListenerAcceptConnection(
         QuicConnTransportError(
             Connection,
             QUIC_ERROR_CONNECTION_REFUSED);
-        Listener->TotalRejectedConnections++;
+        QuicListenerOnAcceptResult(Listener, Connection, FALSE);
         QuicPerfCounterIncrement(QUIC_PERF_COUNTER_CONN_LOAD_REJECT);
         return;
     }
@@ -716,17 +1248,19 @@ QuicListenerAcceptConnection(
             Connection->CibirId[1]);
     }
 
+    Connection->PreferredAddress = Listener->PreferredAddress;
+
     if (!QuicConnGenerateNewSourceCid(Connection, TRUE)) {
         return;
     }
 
     if (!QuicListenerClaimConnection(Listener, Connection, Info)) {
-        Listener->TotalRejectedConnections++;
+        QuicListenerOnAcceptResult(Listener, Connection, FALSE);
         QuicPerfCounterIncrement(QUIC_PERF_COUNTER_CONN_APP_REJECT);
         return;
     }
 
-    Listener->TotalAcceptedConnections++;
+    QuicListenerOnAcceptResult(Listener, Connection, TRUE);
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -768,6 +1302,143 @@ QuicListenerParamSet(
         return QUIC_STATUS_SUCCESS;
     }
 
+    if (Param == QUIC_PARAM_LISTENER_PREFERRED_ADDRESS) {
+        if (BufferLength == 0) {
+            CxPlatZeroMemory(&Listener->PreferredAddress, sizeof(Listener->PreferredAddress));
+            return QUIC_STATUS_SUCCESS;
+        }
+        if (BufferLength != sizeof(QUIC_PREFERRED_ADDRESS) || Buffer == NULL) {
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
+
+        const QUIC_PREFERRED_ADDRESS* PreferredAddress = (const QUIC_PREFERRED_ADDRESS*)Buffer;
+        QUIC_ADDRESS_FAMILY Ipv4Family = QuicAddrGetFamily(&PreferredAddress->Ipv4Address);
+        QUIC_ADDRESS_FAMILY Ipv6Family = QuicAddrGetFamily(&PreferredAddress->Ipv6Address);
+        if ((Ipv4Family != QUIC_ADDRESS_FAMILY_UNSPEC &&
+             (Ipv4Family != QUIC_ADDRESS_FAMILY_INET ||
+              QuicAddrGetPort(&PreferredAddress->Ipv4Address) == 0)) ||
+            (Ipv6Family != QUIC_ADDRESS_FAMILY_UNSPEC &&
+             (Ipv6Family != QUIC_ADDRESS_FAMILY_INET6 ||
+              QuicAddrGetPort(&PreferredAddress->Ipv6Address) == 0))) {
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
+
+        //
+        // Clients can only migrate with a non-zero length CID.
+        //
+        if (MsQuicLib.CidTotalLength == 0) {
+            return QUIC_STATUS_INVALID_STATE;
+        }
+
+        Listener->PreferredAddress = *PreferredAddress;
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    if (Param == QUIC_PARAM_LISTENER_DRAIN) {
+        if (BufferLength != sizeof(uint8_t) || Buffer == NULL) {
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
+
+        Listener->Draining = *(uint8_t*)Buffer != FALSE;
+
+        QuicTraceLogVerbose(
+            ListenerDrainSet,
+            "[list][%p] Draining set to %hhu",
+            Listener,
+            Listener->Draining);
+
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    if (Param == QUIC_PARAM_LISTENER_PARTITIONED) {
+        if (BufferLength != sizeof(uint8_t) || Buffer == NULL) {
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
+
+        if (!Listener->Stopped) {
+            return QUIC_STATUS_INVALID_STATE;
+        }
+
+        const BOOLEAN Partitioned = *(uint8_t*)Buffer != FALSE;
+        if (Partitioned && Listener->Partitions == NULL) {
+            const size_t PartitionsSize =
+                MsQuicLib.PartitionCount * sizeof(QUIC_LISTENER_PARTITION);
+            Listener->Partitions =
+                CXPLAT_ALLOC_NONPAGED(PartitionsSize, QUIC_POOL_LISTENER_PARTITION);
+            if (Listener->Partitions == NULL) {
+                QuicTraceEvent(
+                    AllocFailure,
+                    "Allocation of '%s' failed. (%llu bytes)",
+                    "listener partitions",
+                    PartitionsSize);
+                return QUIC_STATUS_OUT_OF_MEMORY;
+            }
+            CxPlatZeroMemory(Listener->Partitions, PartitionsSize);
+
+        } else if (!Partitioned && Listener->Partitions != NULL) {
+            //
+            // Keep the stats accumulated so far.
+            //
+            for (uint16_t i = 0; i < MsQuicLib.PartitionCount; ++i) {
+                Listener->TotalAcceptedConnections +=
+                    Listener->Partitions[i].TotalAcceptedConnections;
+                Listener->TotalRejectedConnections +=
+                    Listener->Partitions[i].TotalRejectedConnections;
+            }
+            CXPLAT_FREE(Listener->Partitions, QUIC_POOL_LISTENER_PARTITION);
+            Listener->Partitions = NULL;
+        }
+
+        QuicTraceLogVerbose(
+            ListenerPartitionedSet,
+            "[list][%p] Partitioned set to %hhu",
+            Listener,
+            Partitioned);
+
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    if (Param == QUIC_PARAM_LISTENER_SNI_CONFIGURATIONS) {
+        if (BufferLength % sizeof(QUIC_LISTENER_SNI_CONFIGURATION) != 0 ||
+            (BufferLength != 0 && Buffer == NULL)) {
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
+
+        const uint32_t Count = BufferLength / sizeof(QUIC_LISTENER_SNI_CONFIGURATION);
+        QUIC_LISTENER_SNI_TABLE* SniTable = NULL;
+        if (Count != 0) {
+            QUIC_STATUS Status =
+                QuicListenerSniTableCreate(
+                    Count,
+                    (const QUIC_LISTENER_SNI_CONFIGURATION*)Buffer,
+                    &SniTable);
+            if (QUIC_FAILED(Status)) {
+                return Status;
+            }
+        }
+
+        //
+        // Swap in the new table. Connections being accepted hold the lock
+        // only long enough to reference their configuration.
+        //
+        CxPlatDispatchRwLockAcquireExclusive(&Listener->SniLock);
+        QUIC_LISTENER_SNI_TABLE* OldSniTable = Listener->SniTable;
+        Listener->SniTable = SniTable;
+        CxPlatDispatchRwLockReleaseExclusive(&Listener->SniLock);
+
+        if (OldSniTable != NULL) {
+            QuicListenerSniTableFree(OldSniTable);
+        }
+
+        QuicTraceLogVerbose(
+            ListenerSniConfigurationsSet,
+            "[list][%p] SNI configurations set (%u)",
+            Listener,
+            Count);
+
+        return QUIC_STATUS_SUCCESS;
+    }
+
     return QUIC_STATUS_INVALID_PARAMETER;
 }
 
@@ -822,6 +1493,14 @@ QuicListenerParamGet(
 
         Stats->TotalAcceptedConnections = Listener->TotalAcceptedConnections;
         Stats->TotalRejectedConnections = Listener->TotalRejectedConnections;
+        if (Listener->Partitions != NULL) {
+            for (uint16_t i = 0; i < MsQuicLib.PartitionCount; ++i) {
+                Stats->TotalAcceptedConnections +=
+                    Listener->Partitions[i].TotalAcceptedConnections;
+                Stats->TotalRejectedConnections +=
+                    Listener->Partitions[i].TotalRejectedConnections;
+            }
+        }
 
         if (Listener->Binding != NULL) {
             Stats->BindingRecvDroppedPackets = Listener->Binding->Stats.Recv.DroppedPackets;
@@ -854,6 +1533,63 @@ QuicListenerParamGet(
         Status = QUIC_STATUS_SUCCESS;
         break;
 
+    case QUIC_PARAM_LISTENER_PREFERRED_ADDRESS:
+
+        if (*BufferLength < sizeof(QUIC_PREFERRED_ADDRESS)) {
+            *BufferLength = sizeof(QUIC_PREFERRED_ADDRESS);
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        *BufferLength = sizeof(QUIC_PREFERRED_ADDRESS);
+        CxPlatCopyMemory(Buffer, &Listener->PreferredAddress, sizeof(QUIC_PREFERRED_ADDRESS));
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
+    case QUIC_PARAM_LISTENER_DRAIN:
+
+        if (*BufferLength < sizeof(uint8_t)) {
+            *BufferLength = sizeof(uint8_t);
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        *BufferLength = sizeof(uint8_t);
+        *(uint8_t*)Buffer = Listener->Draining;
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
+    case QUIC_PARAM_LISTENER_PARTITIONED:
+
+        if (*BufferLength < sizeof(uint8_t)) {
+            *BufferLength = sizeof(uint8_t);
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        *BufferLength = sizeof(uint8_t);
+        *(uint8_t*)Buffer = Listener->Partitions != NULL;
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
     default:
         Status = QUIC_STATUS_INVALID_PARAMETER;
         break;
@@ -5,6 +5,37 @@
 
 --*/
 
+//
+// Per-partition listener state, used when the listener is partitioned so that
+// accepting connections on different partitions doesn't share cache lines.
+//
+typedef struct QUIC_CACHEALIGN QUIC_LISTENER_PARTITION {
+
+    //
+    // Active references held by connections being accepted on this partition,
+    // plus one while the listener is started. The last partition reference
+    // releases a reference on the listener.
+    //
+    CXPLAT_REF_COUNT RefCount;
+
+    //
+    // Stats for the partition.
+    //
+    uint64_t TotalAcceptedConnections;
+    uint64_t TotalRejectedConnections;
+
+} QUIC_LISTENER_PARTITION;
+
+//
+// A bitmap of a hash of each ALPN in a list, used to rule out most ALPNs in a
+// list before comparing them byte by byte.
+//
+#define QUIC_ALPN_FILTER_BITS 256
+
+typedef struct QUIC_ALPN_FILTER {
+    uint64_t Bits[QUIC_ALPN_FILTER_BITS / 64];
+} QUIC_ALPN_FILTER;
+
 //
 // Represents the Listener specific state.
 //
@@ -36,6 +67,12 @@ typedef struct QUIC_LISTENER {
     //
     BOOLEAN NeedsCleanup;
 
+    //
+    // Indicates the app is draining the listener, so new connections are
+    // refused while existing ones continue.
+    //
+    BOOLEAN Draining;
+
     //
     // The thread ID that the listener is actively indicating a stop compelete
     // callback on.
@@ -95,6 +132,12 @@ typedef struct QUIC_LISTENER {
     uint64_t TotalAcceptedConnections;
     uint64_t TotalRejectedConnections;
 
+    //
+    // Per-partition state, indexed by partition. Only allocated when the app
+    // enables QUIC_PARAM_LISTENER_PARTITIONED.
+    //
+    QUIC_LISTENER_PARTITION* Partitions;
+
     //
     // The application layer protocol negotiation buffers. Encoded in the TLS
     // extension format.
@@ -103,6 +146,23 @@ typedef struct QUIC_LISTENER {
     _Field_size_(AlpnListLength)
     uint8_t* AlpnList;
 
+    //
+    // Filter of the ALPNs in AlpnList, built when the listener is started.
+    //
+    QUIC_ALPN_FILTER AlpnFilter;
+
+    //
+    // Protects SniTable.
+    //
+    CXPLAT_DISPATCH_RW_LOCK SniLock;
+
+    //
+    // The app configured mapping from a client's server name to the
+    // configuration its connection is given, if the app doesn't set one in
+    // the NEW_CONNECTION event. NULL if not configured.
+    //
+    struct QUIC_LISTENER_SNI_TABLE* SniTable;
+
     //
     // An app configured prefix for all connection IDs in this listener. The
     // first byte indicates the length of the ID, the second byte the offset of
@@ -110,6 +170,11 @@ typedef struct QUIC_LISTENER {
     //
     uint8_t CibirId[2 + QUIC_MAX_CIBIR_LENGTH];
 
+    //
+    // The preferred addresses advertised to new connections' clients.
+    //
+    QUIC_PREFERRED_ADDRESS PreferredAddress;
+
 } QUIC_LISTENER;
 
 #ifdef QUIC_SILO
@@ -149,6 +214,40 @@ QuicListenerRelease(
     _In_ BOOLEAN IndicateEvent
     );
 
+//
+// Acquires an active reference on the listener for accepting a connection on
+// the given partition. Returns FALSE if the listener is stopping.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicListenerAcquirePartitionRef(
+    _In_ QUIC_LISTENER* Listener,
+    _In_ uint16_t PartitionIndex
+    );
+
+//
+// Releases an active reference acquired by QuicListenerAcquirePartitionRef.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicListenerReleasePartitionRef(
+    _In_ QUIC_LISTENER* Listener,
+    _In_ uint16_t PartitionIndex,
+    _In_ BOOLEAN IndicateEvent
+    );
+
+//
+// Builds the filter for a TLS extension formatted ALPN list.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicAlpnFilterBuild(
+    _In_ uint16_t AlpnListLength,
+    _In_reads_(AlpnListLength)
+        const uint8_t* AlpnList,
+    _Out_ QUIC_ALPN_FILTER* Filter
+    );
+
 //
 // Returns TRUE if the two listeners have an overlapping ALPN.
 //
@@ -161,12 +260,14 @@ QuicListenerHasAlpnOverlap(
 
 //
 // Returns TRUE if the listener has a matching ALPN. Also updates the new
-// connection info with the matching ALPN.
+// connection info with the matching ALPN. ClientAlpnFilter is the filter of
+// the client's ALPN list.
 //
 _IRQL_requires_max_(DISPATCH_LEVEL)
 BOOLEAN
 QuicListenerMatchesAlpn(
     _In_ const QUIC_LISTENER* Listener,
+    _In_ const QUIC_ALPN_FILTER* ClientAlpnFilter,
     _In_ QUIC_NEW_CONNECTION_INFO* Info
     );
 
@@ -48,6 +48,7 @@ QuicLookupUninitialize(
 {
     CXPLAT_DBG_ASSERT(Lookup->CidCount == 0);
 
+    Lookup->FinalTables = NULL;
     if (Lookup->PartitionCount == 0) {
         CXPLAT_DBG_ASSERT(Lookup->SINGLE.Connection == NULL);
     } else {
@@ -95,7 +96,7 @@ QuicLookupCreateHashTable(
         uint16_t Cleanup = 0;
         uint8_t Failed = FALSE;
         for (uint16_t i = 0; i < PartitionCount; i++) {
-            if (!CxPlatHashtableInitializeEx(&Lookup->HASH.Tables[i].Table, CXPLAT_HASH_MIN_SIZE)) {
+            if (!CxPlatHashtableInitializeOpenEx(&Lookup->HASH.Tables[i].Table, CXPLAT_HASH_MIN_SIZE)) {
                 Cleanup = i;
                 Failed = TRUE;
                 break;
@@ -251,7 +252,7 @@ QuicLookupMaximizePartitioning(
 
     if (!Lookup->MaximizePartitioning) {
         Result =
-            CxPlatHashtableInitializeEx(
+            CxPlatHashtableInitializeOpenEx(
                 &Lookup->RemoteHashTable, CXPLAT_HASH_MIN_SIZE);
         if (Result) {
             Lookup->MaximizePartitioning = TRUE;
@@ -259,6 +260,15 @@ QuicLookupMaximizePartitioning(
             if (!Result) {
                 CxPlatHashtableUninitialize(&Lookup->RemoteHashTable);
                 Lookup->MaximizePartitioning = FALSE;
+            } else {
+                //
+                // The partition count can't grow any further, so the tables
+                // are final and receive path lookups can stop using RwLock.
+                //
+                CXPLAT_DBG_ASSERT(Lookup->PartitionCount == MsQuicLib.PartitionCount);
+                InterlockedExchangePointer(
+                    (void* volatile*)&Lookup->FinalTables,
+                    Lookup->HASH.Tables);
             }
         }
     }
@@ -488,12 +498,16 @@ QuicLookupInsertLocalCid(
         QUIC_PARTITIONED_HASHTABLE* Table = &Lookup->HASH.Tables[PartitionIndex];
 
         CxPlatDispatchRwLockAcquireExclusive(&Table->RwLock);
-        CxPlatHashtableInsert(
-            &Table->Table,
-            &SourceCid->Entry,
-            Hash,
-            NULL);
+        const BOOLEAN Inserted =
+            CxPlatHashtableInsert(
+                &Table->Table,
+                &SourceCid->Entry,
+                Hash,
+                NULL);
         CxPlatDispatchRwLockReleaseExclusive(&Table->RwLock);
+        if (!Inserted) {
+            return FALSE;
+        }
     }
 
     if (UpdateRefCount) {
@@ -547,11 +561,14 @@ QuicLookupInsertRemoteHash(
         RemoteCid,
         RemoteCidLength);
 
-    CxPlatHashtableInsert(
-        &Lookup->RemoteHashTable,
-        &Entry->Entry,
-        Hash,
-        NULL);
+    if (!CxPlatHashtableInsert(
+            &Lookup->RemoteHashTable,
+            &Entry->Entry,
+            Hash,
+            NULL)) {
+        CXPLAT_FREE(Entry, QUIC_POOL_REMOTE_HASH);
+        return FALSE;
+    }
 
     Connection->RemoteHashEntry = Entry;
 
@@ -634,6 +651,39 @@ QuicLookupFindConnectionByLocalCid(
 {
     uint32_t Hash = CxPlatHashSimple(CIDLen, CID);
 
+    QUIC_PARTITIONED_HASHTABLE* FinalTables =
+        (QUIC_PARTITIONED_HASHTABLE*)QuicReadPtrAcquire((void**)&Lookup->FinalTables);
+    if (FinalTables != NULL) {
+        CXPLAT_DBG_ASSERT(CIDLen >= QUIC_MIN_INITIAL_CONNECTION_ID_LENGTH);
+        CXPLAT_DBG_ASSERT(CID != NULL);
+
+        //
+        // The tables can no longer be reallocated, so only the partition's
+        // lock is needed. Removal only synchronizes with this lock too, which
+        // is why the reference must be taken before releasing it.
+        //
+        CXPLAT_STATIC_ASSERT(QUIC_CID_PID_LENGTH == 2, "The code below assumes 2 bytes");
+        uint16_t PartitionIndex;
+        CxPlatCopyMemory(&PartitionIndex, CID + MsQuicLib.CidServerIdLength, 2);
+        PartitionIndex &= MsQuicLib.PartitionMask;
+        PartitionIndex %= Lookup->PartitionCount;
+        QUIC_PARTITIONED_HASHTABLE* Table = &FinalTables[PartitionIndex];
+
+        CxPlatDispatchRwLockAcquireShared(&Table->RwLock);
+        QUIC_CONNECTION* ExistingConnection =
+            QuicHashLookupConnection(
+                &Table->Table,
+                CID,
+                CIDLen,
+                Hash);
+        if (ExistingConnection != NULL) {
+            QuicConnAddRef(ExistingConnection, QUIC_CONN_REF_LOOKUP_RESULT);
+        }
+        CxPlatDispatchRwLockReleaseShared(&Table->RwLock);
+
+        return ExistingConnection;
+    }
+
     CxPlatDispatchRwLockAcquireShared(&Lookup->RwLock);
 
     QUIC_CONNECTION* ExistingConnection =
@@ -880,7 +930,7 @@ QuicLookupRemoveLocalCids(
             CID->CID.IsInLookupTable = FALSE;
             ReleaseRefCount++;
         }
-        CXPLAT_FREE(CID, QUIC_POOL_CIDHASH);
+        QuicCidFreeSource(CID);
     }
     CxPlatDispatchRwLockReleaseExclusive(&Lookup->RwLock);
 
@@ -938,3 +988,47 @@ QuicLookupMoveLocalConnectionIDs(
     }
     CxPlatDispatchRwLockReleaseExclusive(&LookupDest->RwLock);
 }
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicLookupAddStandbyConnection(
+    _In_ QUIC_LOOKUP* Lookup,
+    _In_ QUIC_CONNECTION* Connection
+    )
+{
+    BOOLEAN Result = FALSE;
+
+    CxPlatDispatchRwLockAcquireExclusive(&Lookup->RwLock);
+    if (Lookup->PartitionCount == 0 && Lookup->SINGLE.Connection == NULL) {
+        //
+        // Packets are matched against the connection's own CID list when the
+        // lookup only has a single connection, so no CIDs need to be added.
+        //
+        CXPLAT_DBG_ASSERT(Lookup->CidCount == 0);
+        Lookup->SINGLE.Connection = Connection;
+        Lookup->CidCount++;
+        QuicConnAddRef(Connection, QUIC_CONN_REF_LOOKUP_TABLE);
+        Result = TRUE;
+    }
+    CxPlatDispatchRwLockReleaseExclusive(&Lookup->RwLock);
+
+    return Result;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicLookupRemoveStandbyConnection(
+    _In_ QUIC_LOOKUP* Lookup,
+    _In_ QUIC_CONNECTION* Connection
+    )
+{
+    CxPlatDispatchRwLockAcquireExclusive(&Lookup->RwLock);
+    CXPLAT_DBG_ASSERT(Lookup->PartitionCount == 0);
+    CXPLAT_DBG_ASSERT(Lookup->SINGLE.Connection == Connection);
+    CXPLAT_DBG_ASSERT(Lookup->CidCount == 1);
+    Lookup->SINGLE.Connection = NULL;
+    Lookup->CidCount = 0;
+    CxPlatDispatchRwLockReleaseExclusive(&Lookup->RwLock);
+
+    QuicConnRelease(Connection, QUIC_CONN_REF_LOOKUP_TABLE);
+}
@@ -64,6 +64,14 @@ typedef struct QUIC_LOOKUP {
         } HASH;
     };
 
+    //
+    // Published (with release semantics) once maximized partitioning is in
+    // place. From then on the partitioned tables are never reallocated, so
+    // local CID lookups on the receive path skip RwLock and only take the
+    // lock of the one partition they hit.
+    //
+    QUIC_PARTITIONED_HASHTABLE* volatile FinalTables;
+
     //
     // Remote Hash lookup.
     //
@@ -200,3 +208,23 @@ QuicLookupMoveLocalConnectionIDs(
     _In_ QUIC_LOOKUP* LookupDest,
     _In_ QUIC_CONNECTION* Connection
     );
+
+//
+// Delivers everything received on an otherwise empty lookup to the connection,
+// without moving any of its CIDs there. Used for a client's standby paths,
+// whose CIDs stay on the active path's binding. Fails if the lookup is
+// already in use.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicLookupAddStandbyConnection(
+    _In_ QUIC_LOOKUP* Lookup,
+    _In_ QUIC_CONNECTION* Connection
+    );
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicLookupRemoveStandbyConnection(
+    _In_ QUIC_LOOKUP* Lookup,
+    _In_ QUIC_CONNECTION* Connection
+    );
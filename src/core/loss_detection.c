@@ -54,6 +54,29 @@ Abstract:
 #include "loss_detection.c.clog.h"
 #endif
 
+//
+// Fires the congestion_window USDT probe, after the congestion controller
+// processed an ACK, loss or ECN event.
+//
+#define QuicLossDetectionProbeCongestionWindow(Connection)                     \
+    QuicUsdtProbe(                                                             \
+        congestion_window,                                                     \
+        (Connection),                                                          \
+        QuicCongestionControlGetCongestionWindow(&(Connection)->CongestionControl), \
+        QuicCongestionControlGetBytesInFlightMax(&(Connection)->CongestionControl))
+
+//
+// Records the congestion window in the flight recorder, after a congestion
+// event (loss, ECN or a spurious congestion event being reverted). Unlike the
+// USDT probe, this isn't done for every ACK, to keep the rarer events in it.
+//
+#define QuicLossDetectionRecordCongestionWindow(Connection)                    \
+    QuicConnFlightRecord(                                                      \
+        (Connection),                                                          \
+        QUIC_FLIGHT_RECORDER_EVENT_CONGESTION_WINDOW,                          \
+        QuicCongestionControlGetCongestionWindow(&(Connection)->CongestionControl), \
+        (Connection)->LossDetection.PacketsInFlight)
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 BOOLEAN
 QuicLossDetectionRetransmitFrames(
@@ -87,6 +110,97 @@ QuicLossDetectionInitializeInternalState(
     LossDetection->ProbeCount = 0;
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_SENT_PACKET_METADATA*
+QuicLossDetectionLookupSentPacket(
+    _In_ const QUIC_LOSS_DETECTION* LossDetection,
+    _In_ uint64_t PacketNumber
+    )
+{
+    if (LossDetection->SentPacketIndexSize == 0) {
+        return NULL;
+    }
+    QUIC_SENT_PACKET_METADATA* Packet =
+        LossDetection->SentPacketIndex[
+            PacketNumber & (LossDetection->SentPacketIndexSize - 1)];
+    return
+        (Packet != NULL && Packet->PacketNumber == PacketNumber) ? Packet : NULL;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicLossDetectionUnindexSentPacket(
+    _In_ QUIC_LOSS_DETECTION* LossDetection,
+    _In_ const QUIC_SENT_PACKET_METADATA* Packet
+    )
+{
+    if (LossDetection->SentPacketIndexSize != 0) {
+        QUIC_SENT_PACKET_METADATA** Slot =
+            &LossDetection->SentPacketIndex[
+                Packet->PacketNumber & (LossDetection->SentPacketIndexSize - 1)];
+        if (*Slot == Packet) {
+            *Slot = NULL;
+        }
+    }
+}
+
+//
+// Adds a packet, already appended to the SentPackets list, to the index. If
+// its slot is still held by an older outstanding packet, the index is grown
+// (and rebuilt from the list) until the whole outstanding span fits. Failing
+// that, the newer packet simply takes over the slot.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicLossDetectionIndexSentPacket(
+    _In_ QUIC_LOSS_DETECTION* LossDetection,
+    _In_ QUIC_SENT_PACKET_METADATA* Packet
+    )
+{
+    uint32_t Size = LossDetection->SentPacketIndexSize;
+    if (Size == 0 ||
+        (LossDetection->SentPacketIndex[Packet->PacketNumber & (Size - 1)] != NULL &&
+         Size < QUIC_SENT_PACKET_INDEX_MAX_SIZE)) {
+
+        const uint64_t Span =
+            Packet->PacketNumber - LossDetection->SentPackets->PacketNumber;
+        uint32_t NewSize = Size == 0 ? QUIC_SENT_PACKET_INDEX_INITIAL_SIZE : Size * 2;
+        while (NewSize <= Span && NewSize < QUIC_SENT_PACKET_INDEX_MAX_SIZE) {
+            NewSize *= 2;
+        }
+
+        QUIC_SENT_PACKET_METADATA** NewIndex =
+            CXPLAT_ALLOC_NONPAGED(
+                NewSize * sizeof(QUIC_SENT_PACKET_METADATA*),
+                QUIC_POOL_SENT_PACKET_INDEX);
+        if (NewIndex != NULL) {
+            CxPlatZeroMemory(NewIndex, NewSize * sizeof(QUIC_SENT_PACKET_METADATA*));
+            for (QUIC_SENT_PACKET_METADATA* Iter = LossDetection->SentPackets;
+                 Iter != NULL;
+                 Iter = Iter->Next) {
+                NewIndex[Iter->PacketNumber & (NewSize - 1)] = Iter;
+            }
+            if (LossDetection->SentPacketIndex != NULL) {
+                CXPLAT_FREE(LossDetection->SentPacketIndex, QUIC_POOL_SENT_PACKET_INDEX);
+            }
+            LossDetection->SentPacketIndex = NewIndex;
+            LossDetection->SentPacketIndexSize = NewSize;
+            return;
+        }
+
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "Sent packet index",
+            NewSize * sizeof(QUIC_SENT_PACKET_METADATA*));
+        if (Size == 0) {
+            return;
+        }
+    }
+
+    LossDetection->SentPacketIndex[Packet->PacketNumber & (Size - 1)] = Packet;
+}
+
 #if DEBUG
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
@@ -106,6 +220,24 @@ QuicLossValidate(
     CXPLAT_DBG_ASSERT(Tail == LossDetection->SentPacketsTail);
     CXPLAT_DBG_ASSERT(LossDetection->PacketsInFlight == AckElicitingPackets);
 
+    //
+    // Every index entry must refer to a packet still in the SentPackets list.
+    //
+    uint32_t IndexedPackets = 0;
+    for (QUIC_SENT_PACKET_METADATA* Packet = LossDetection->SentPackets;
+         Packet != NULL;
+         Packet = Packet->Next) {
+        if (QuicLossDetectionLookupSentPacket(LossDetection, Packet->PacketNumber) == Packet) {
+            IndexedPackets++;
+        }
+    }
+    for (uint32_t i = 0; i < LossDetection->SentPacketIndexSize; ++i) {
+        if (LossDetection->SentPacketIndex[i] != NULL) {
+            IndexedPackets--;
+        }
+    }
+    CXPLAT_DBG_ASSERT(IndexedPackets == 0);
+
     Tail = &LossDetection->LostPackets;
     while (*Tail) {
         CXPLAT_DBG_ASSERT(!(*Tail)->Flags.Freed);
@@ -127,6 +259,9 @@ QuicLossDetectionInitialize(
     LossDetection->SentPacketsTail = &LossDetection->SentPackets;
     LossDetection->LostPackets = NULL;
     LossDetection->LostPacketsTail = &LossDetection->LostPackets;
+    LossDetection->SentPacketIndex = NULL;
+    LossDetection->SentPacketIndexSize = 0;
+    QuicSentPacketArenaInitialize(&LossDetection->SentPacketArena);
     QuicLossDetectionInitializeInternalState(LossDetection);
 }
 
@@ -165,6 +300,12 @@ QuicLossDetectionUninitialize(
 
         QuicLossDetectionOnPacketDiscarded(LossDetection, Packet, FALSE);
     }
+    if (LossDetection->SentPacketIndex != NULL) {
+        CXPLAT_FREE(LossDetection->SentPacketIndex, QUIC_POOL_SENT_PACKET_INDEX);
+        LossDetection->SentPacketIndex = NULL;
+        LossDetection->SentPacketIndexSize = 0;
+    }
+    QuicSentPacketArenaUninitialize(&LossDetection->SentPacketArena);
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -192,6 +333,11 @@ QuicLossDetectionReset(
         QuicLossDetectionRetransmitFrames(LossDetection, Packet, TRUE);
     }
     LossDetection->SentPacketsTail = &LossDetection->SentPackets;
+    if (LossDetection->SentPacketIndex != NULL) {
+        CxPlatZeroMemory(
+            LossDetection->SentPacketIndex,
+            LossDetection->SentPacketIndexSize * sizeof(QUIC_SENT_PACKET_METADATA*));
+    }
 
     while (LossDetection->LostPackets != NULL) {
         QUIC_SENT_PACKET_METADATA* Packet = LossDetection->LostPackets;
@@ -392,11 +538,28 @@ QuicLossDetectionOnPacketSent(
     CXPLAT_DBG_ASSERT(TempSentPacket->FrameCount != 0);
 
     //
-    // Allocate a copy of the packet metadata.
+    // Allocate a copy of the packet metadata. Once enough packets are in
+    // flight, the connection's own arena is used, falling back to the worker's
+    // pools if it's full.
     //
-    QUIC_SENT_PACKET_METADATA* SentPacket =
-        QuicSentPacketPoolGetPacketMetadata(
-            &Connection->Worker->SentPacketPool, TempSentPacket->FrameCount);
+    QUIC_SENT_PACKET_METADATA* SentPacket = NULL;
+    BOOLEAN FromArena = FALSE;
+    if (LossDetection->SentPacketArena.Buffer != NULL ||
+        LossDetection->PacketsInFlight >= QUIC_SENT_PACKET_ARENA_THRESHOLD) {
+        SentPacket =
+            QuicSentPacketArenaGetPacketMetadata(
+                &LossDetection->SentPacketArena, TempSentPacket->FrameCount);
+        FromArena = SentPacket != NULL;
+    }
+    if (SentPacket == NULL) {
+        SentPacket =
+            QuicSentPacketPoolGetPacketMetadata(
+                &Connection->Worker->SentPacketPool, TempSentPacket->FrameCount);
+        if (SentPacket != NULL) {
+            Connection->MemoryUsage.SentPackets +=
+                SIZEOF_QUIC_SENT_PACKET_METADATA(TempSentPacket->FrameCount);
+        }
+    }
     if (SentPacket == NULL) {
         //
         // We can't allocate the memory to permanently track this packet so just
@@ -417,6 +580,7 @@ QuicLossDetectionOnPacketSent(
         TempSentPacket,
         sizeof(QUIC_SENT_PACKET_METADATA) +
         sizeof(QUIC_SENT_FRAME_METADATA) * TempSentPacket->FrameCount);
+    SentPacket->Flags.FromArena = FromArena;
 
     LossDetection->LargestSentPacketNumber = TempSentPacket->PacketNumber;
 
@@ -426,6 +590,7 @@ QuicLossDetectionOnPacketSent(
     SentPacket->Next = NULL;
     *LossDetection->SentPacketsTail = SentPacket;
     LossDetection->SentPacketsTail = &SentPacket->Next;
+    QuicLossDetectionIndexSentPacket(LossDetection, SentPacket);
 
     CXPLAT_DBG_ASSERT(
         SentPacket->Flags.KeyType != QUIC_PACKET_KEY_0_RTT ||
@@ -610,7 +775,7 @@ QuicLossDetectionOnPacketAcknowledged(
                 QUIC_CID_VALIDATE_NULL(Connection, DestCid);
                 CXPLAT_DBG_ASSERT(Connection->RetiredDestCidCount > 0);
                 Connection->RetiredDestCidCount--;
-                CXPLAT_FREE(DestCid, QUIC_POOL_CIDLIST);
+                QuicCidFreeDestination(DestCid);
             }
             break;
         }
@@ -915,6 +1080,52 @@ QuicLossDetectionOnPacketDiscarded(
     QuicSentPacketPoolReturnPacketMetadata(Packet, Connection);
 }
 
+//
+// Adjusts the packet tolerance the peer uses (via ACK_FREQUENCY) to the
+// current congestion state. Outside of recovery, the peer only needs to
+// acknowledge a few times per congestion window, so the tolerance is raised
+// (in powers of two) to a fraction of the window. On entering recovery, it is
+// dropped back to the default and the peer is asked to acknowledge
+// immediately, so that losses are detected and repaired quickly.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicLossDetectionUpdatePeerAckFrequency(
+    _In_ QUIC_LOSS_DETECTION* LossDetection
+    )
+{
+    QUIC_CONNECTION* Connection = QuicLossDetectionGetConnection(LossDetection);
+    if (!(Connection->PeerTransportParams.Flags & QUIC_TP_FLAG_MIN_ACK_DELAY)) {
+        return; // Peer doesn't support the ACK_FREQUENCY extension.
+    }
+
+    if (QuicCongestionControlIsInRecovery(&Connection->CongestionControl)) {
+        if (Connection->PeerPacketTolerance > QUIC_MIN_ACK_SEND_NUMBER) {
+            QuicConnUpdatePeerPacketTolerance(Connection, QUIC_MIN_ACK_SEND_NUMBER);
+            QuicSendSetSendFlag(&Connection->Send, QUIC_CONN_SEND_FLAG_IMMEDIATE_ACK);
+        }
+        return;
+    }
+
+    const uint32_t WindowPackets =
+        QuicCongestionControlGetCongestionWindow(&Connection->CongestionControl) /
+        QuicPathGetDatagramPayloadSize(&Connection->Paths[0]);
+    uint8_t PacketTolerance = QUIC_MIN_ACK_SEND_NUMBER;
+    while (PacketTolerance < QUIC_MAX_PEER_PACKET_TOLERANCE &&
+           (uint32_t)PacketTolerance * 2 * QUIC_ACKS_PER_CONGESTION_WINDOW <= WindowPackets) {
+        PacketTolerance *= 2;
+    }
+
+    //
+    // Only ever raise the tolerance here. The send path may have raised it
+    // further to cover a full send batch, and lowering it only happens on
+    // congestion.
+    //
+    if (PacketTolerance > Connection->PeerPacketTolerance) {
+        QuicConnUpdatePeerPacketTolerance(Connection, PacketTolerance);
+    }
+}
+
 //
 // Returns TRUE if any lost retransmittable bytes were detected.
 //
@@ -927,6 +1138,7 @@ QuicLossDetectionDetectAndHandleLostPackets(
 {
     QUIC_CONNECTION* Connection = QuicLossDetectionGetConnection(LossDetection);
     uint32_t LostRetransmittableBytes = 0;
+    uint32_t OtherPathLostBytes = 0;
     QUIC_SENT_PACKET_METADATA* Packet;
 
     if (LossDetection->LostPackets != NULL) {
@@ -941,6 +1153,7 @@ QuicLossDetectionDetectAndHandleLostPackets(
                 2);
         while ((Packet = LossDetection->LostPackets) != NULL &&
                 Packet->PacketNumber < LossDetection->LargestAck &&
+                CxPlatTimeAtOrBefore64(Packet->SentTime, TimeNow) &&
                 CxPlatTimeDiff64(Packet->SentTime, TimeNow) > TwoPto) {
             QuicTraceLogVerbose(
                 PacketTxForget,
@@ -1001,6 +1214,24 @@ QuicLossDetectionDetectAndHandleLostPackets(
                         Packet->PacketNumber,
                         QuicPacketTraceType(Packet),
                         QUIC_TRACE_PACKET_LOSS_FACK);
+                    QuicConnQlog(
+                        Connection,
+                        QUIC_QLOG_EVENT_PACKET_LOST,
+                        QuicPacketTraceType(Packet),
+                        Packet->PacketNumber,
+                        QUIC_TRACE_PACKET_LOSS_FACK,
+                        0);
+                    QuicUsdtProbe(
+                        packet_lost,
+                        Connection,
+                        Packet->PacketNumber,
+                        QuicPacketTraceType(Packet),
+                        QUIC_TRACE_PACKET_LOSS_FACK);
+                    QuicConnFlightRecord(
+                        Connection,
+                        QUIC_FLIGHT_RECORDER_EVENT_PACKET_LOST,
+                        Packet->PacketNumber,
+                        QUIC_TRACE_PACKET_LOSS_FACK);
                 }
             } else if (Packet->PacketNumber < LossDetection->LargestAck &&
                         CxPlatTimeAtOrBefore64(Packet->SentTime + TimeReorderThreshold, TimeNow)) {
@@ -1018,6 +1249,24 @@ QuicLossDetectionDetectAndHandleLostPackets(
                         Packet->PacketNumber,
                         QuicPacketTraceType(Packet),
                         QUIC_TRACE_PACKET_LOSS_RACK);
+                    QuicConnQlog(
+                        Connection,
+                        QUIC_QLOG_EVENT_PACKET_LOST,
+                        QuicPacketTraceType(Packet),
+                        Packet->PacketNumber,
+                        QUIC_TRACE_PACKET_LOSS_RACK,
+                        0);
+                    QuicUsdtProbe(
+                        packet_lost,
+                        Connection,
+                        Packet->PacketNumber,
+                        QuicPacketTraceType(Packet),
+                        QUIC_TRACE_PACKET_LOSS_RACK);
+                    QuicConnFlightRecord(
+                        Connection,
+                        QUIC_FLIGHT_RECORDER_EVENT_PACKET_LOST,
+                        Packet->PacketNumber,
+                        QUIC_TRACE_PACKET_LOSS_RACK);
                 }
             } else {
                 break;
@@ -1027,11 +1276,21 @@ QuicLossDetectionDetectAndHandleLostPackets(
             QuicPerfCounterIncrement(QUIC_PERF_COUNTER_PKTS_SUSPECTED_LOST);
             if (Packet->Flags.IsAckEliciting) {
                 LossDetection->PacketsInFlight--;
-                LostRetransmittableBytes += Packet->PacketLength;
+                if (Packet->PathId == Path->ID) {
+                    LostRetransmittableBytes += Packet->PacketLength;
+                } else {
+                    //
+                    // Losses on other paths (probes of standby paths or
+                    // packets sent before a migration) say nothing about
+                    // congestion on the active one (RFC 9002, Section 9.4).
+                    //
+                    OtherPathLostBytes += Packet->PacketLength;
+                }
                 QuicLossDetectionRetransmitFrames(LossDetection, Packet, FALSE);
             }
 
             LargestLostPacketNumber = Packet->PacketNumber;
+            QuicLossDetectionUnindexSentPacket(LossDetection, Packet);
             if (PrevPacket == NULL) {
                 LossDetection->SentPackets = Packet->Next;
                 if (Packet->Next == NULL) {
@@ -1052,6 +1311,13 @@ QuicLossDetectionDetectAndHandleLostPackets(
 
         QuicLossValidate(LossDetection);
 
+        if (OtherPathLostBytes > 0 &&
+            QuicCongestionControlOnDataInvalidated(
+                &Connection->CongestionControl,
+                OtherPathLostBytes)) {
+            QuicSendQueueFlush(&Connection->Send, REASON_CONGESTION_CONTROL);
+        }
+
         if (LostRetransmittableBytes > 0) {
             if (LossDetection->ProbeCount > QUIC_PERSISTENT_CONGESTION_THRESHOLD) {
                 //
@@ -1070,6 +1336,9 @@ QuicLossDetectionDetectAndHandleLostPackets(
             };
 
             QuicCongestionControlOnDataLost(&Connection->CongestionControl, &LossEvent);
+            QuicLossDetectionProbeCongestionWindow(Connection);
+            QuicLossDetectionRecordCongestionWindow(Connection);
+            QuicLossDetectionUpdatePeerAckFrequency(LossDetection);
             //
             // Send packets from any previously blocked streams.
             //
@@ -1152,6 +1421,7 @@ QuicLossDetectionDiscardPackets(
         QUIC_SENT_PACKET_METADATA* NextPacket = Packet->Next;
 
         if (Packet->Flags.KeyType == KeyType) {
+            QuicLossDetectionUnindexSentPacket(LossDetection, Packet);
             if (PrevPacket != NULL) {
                 PrevPacket->Next = NextPacket;
                 if (NextPacket == NULL) {
@@ -1221,9 +1491,27 @@ QuicLossDetectionDiscardPackets(
             //
             QuicSendQueueFlush(&Connection->Send, REASON_CONGESTION_CONTROL);
         }
+        QuicLossDetectionProbeCongestionWindow(Connection);
     }
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+uint32_t
+QuicLossDetectionGetBytesInFlight(
+    _In_ const QUIC_LOSS_DETECTION* LossDetection
+    )
+{
+    uint32_t BytesInFlight = 0;
+    for (const QUIC_SENT_PACKET_METADATA* Packet = LossDetection->SentPackets;
+        Packet != NULL;
+        Packet = Packet->Next) {
+        if (Packet->Flags.IsAckEliciting) {
+            BytesInFlight += Packet->PacketLength;
+        }
+    }
+    return BytesInFlight;
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicLossDetectionOnZeroRttRejected(
@@ -1245,6 +1533,7 @@ QuicLossDetectionOnZeroRttRejected(
         QUIC_SENT_PACKET_METADATA* NextPacket = Packet->Next;
 
         if (Packet->Flags.KeyType == QUIC_PACKET_KEY_0_RTT) {
+            QuicLossDetectionUnindexSentPacket(LossDetection, Packet);
             if (PrevPacket != NULL) {
                 PrevPacket->Next = NextPacket;
                 if (NextPacket == NULL) {
@@ -1377,6 +1666,8 @@ QuicLossDetectionProcessAckBlocks(
                     //
                     QuicSendQueueFlush(&Connection->Send, REASON_CONGESTION_CONTROL);
                 }
+                QuicLossDetectionProbeCongestionWindow(Connection);
+                QuicLossDetectionRecordCongestionWindow(Connection);
             }
         }
 
@@ -1384,6 +1675,20 @@ QuicLossDetectionProcessAckBlocks(
         // Now find all the acknowledged packets in the SentPackets list.
         //
         if (*SentPacketsStart != NULL) {
+            if ((*SentPacketsStart)->PacketNumber < AckBlock->Low) {
+                //
+                // The packet just below the block is usually still outstanding
+                // (it's part of the gap the peer hasn't received), so use the
+                // index to jump straight to it instead of walking every
+                // outstanding packet in between.
+                //
+                QUIC_SENT_PACKET_METADATA* PrevPacket =
+                    QuicLossDetectionLookupSentPacket(LossDetection, AckBlock->Low - 1);
+                if (PrevPacket != NULL &&
+                    PrevPacket->PacketNumber >= (*SentPacketsStart)->PacketNumber) {
+                    SentPacketsStart = &PrevPacket->Next;
+                }
+            }
             while (*SentPacketsStart && (*SentPacketsStart)->PacketNumber < AckBlock->Low) {
                 SentPacketsStart = &((*SentPacketsStart)->Next);
             }
@@ -1391,6 +1696,7 @@ QuicLossDetectionProcessAckBlocks(
             QUIC_SENT_PACKET_METADATA** End = SentPacketsStart;
             while (*End && (*End)->PacketNumber <= QuicRangeGetHigh(AckBlock)) {
 
+                QuicLossDetectionUnindexSentPacket(LossDetection, *End);
                 if ((*End)->Flags.IsAckEliciting) {
                     LossDetection->PacketsInFlight--;
                     AckedRetransmittableBytes += (*End)->PacketLength;
@@ -1458,7 +1764,13 @@ QuicLossDetectionProcessAckBlocks(
             return;
         }
 
-        uint64_t PacketRtt = CxPlatTimeDiff64(PacketMeta->SentTime, TimeNow);
+        //
+        // Packets paced out by the datapath have their departure time as
+        // their sent time, which may be a hair ahead of our clock.
+        //
+        uint64_t PacketRtt =
+            CxPlatTimeAtOrBefore64(PacketMeta->SentTime, TimeNow) ?
+                CxPlatTimeDiff64(PacketMeta->SentTime, TimeNow) : 0;
         QuicTraceLogVerbose(
             PacketTxAcked,
             "[%c][TX][%llu] ACKed (%u.%03u ms)",
@@ -1518,8 +1830,14 @@ QuicLossDetectionProcessAckBlocks(
             BOOLEAN EcnValidated = TRUE;
             int64_t EctCeDeltaSum = 0;
             if (Ecn != NULL) {
+                //
+                // L4S congestion controls send with ECT(1) instead of ECT(0).
+                //
+                const BOOLEAN IsL4s = Connection->CongestionControl.IsL4s;
+                const uint64_t EctCount = IsL4s ? Ecn->ECT_1_Count : Ecn->ECT_0_Count;
+                const uint64_t OtherEctCount = IsL4s ? Ecn->ECT_0_Count : Ecn->ECT_1_Count;
                 EctCeDeltaSum += Ecn->CE_Count - Packets->EcnCeCounter;
-                EctCeDeltaSum += Ecn->ECT_0_Count - Packets->EcnEctCounter;
+                EctCeDeltaSum += EctCount - Packets->EcnEctCounter;
                 //
                 // Conditions where ECN validation fails:
                 // 1. Reneging ECN counts from the peer.
@@ -1527,13 +1845,15 @@ QuicLossDetectionProcessAckBlocks(
                 //
                 if (EctCeDeltaSum < 0 ||
                     EctCeDeltaSum < EcnEctCounter ||
-                    Ecn->ECT_1_Count != 0 ||
-                    Connection->Send.NumPacketsSentWithEct < Ecn->ECT_0_Count) {
+                    OtherEctCount != 0 ||
+                    Connection->Send.NumPacketsSentWithEct < EctCount) {
                     EcnValidated = FALSE;
                 } else {
                     BOOLEAN NewCE = Ecn->CE_Count > Packets->EcnCeCounter;
+                    uint64_t NewCeCount = NewCE ? Ecn->CE_Count - Packets->EcnCeCounter : 0;
+                    Connection->Stats.Send.CeMarkedPackets += NewCeCount;
                     Packets->EcnCeCounter = Ecn->CE_Count;
-                    Packets->EcnEctCounter = Ecn->ECT_0_Count;
+                    Packets->EcnEctCounter = EctCount;
                     if (Path->EcnValidationState <= ECN_VALIDATION_UNKNOWN) {
                         Path->EcnValidationState = ECN_VALIDATION_CAPABLE;
                         QuicTraceEvent(
@@ -1548,8 +1868,11 @@ QuicLossDetectionProcessAckBlocks(
                         QUIC_ECN_EVENT EcnEvent = {
                             .LargestPacketNumberAcked = LargestAckedPacketNum,
                             .LargestSentPacketNumber = LossDetection->LargestSentPacketNumber,
+                            .NewCeCount = NewCeCount,
                         };
                         QuicCongestionControlOnEcn(&Connection->CongestionControl, &EcnEvent);
+                        QuicLossDetectionProbeCongestionWindow(Connection);
+                        QuicLossDetectionRecordCongestionWindow(Connection);
                     }
                 }
             } else {
@@ -1609,6 +1932,9 @@ QuicLossDetectionProcessAckBlocks(
             //
             QuicSendQueueFlush(&Connection->Send, REASON_CONGESTION_CONTROL);
         }
+        QuicLossDetectionProbeCongestionWindow(Connection);
+
+        QuicLossDetectionUpdatePeerAckFrequency(LossDetection);
     }
 
     LossDetection->ProbeCount = 0;
@@ -1714,6 +2040,11 @@ QuicLossDetectionScheduleProbe(
         Connection,
         "probe round %hu",
         LossDetection->ProbeCount);
+    QuicConnFlightRecord(
+        Connection,
+        QUIC_FLIGHT_RECORDER_EVENT_PROBE_TIMEOUT,
+        LossDetection->ProbeCount,
+        0);
 
     //
     // Below, we will schedule a fixed number packets to be retransmitted. What
@@ -1771,6 +2102,24 @@ QuicLossDetectionScheduleProbe(
                 Packet->PacketNumber,
                 QuicPacketTraceType(Packet),
                 QUIC_TRACE_PACKET_LOSS_PROBE);
+            QuicConnQlog(
+                Connection,
+                QUIC_QLOG_EVENT_PACKET_LOST,
+                QuicPacketTraceType(Packet),
+                Packet->PacketNumber,
+                QUIC_TRACE_PACKET_LOSS_PROBE,
+                0);
+            QuicUsdtProbe(
+                packet_lost,
+                Connection,
+                Packet->PacketNumber,
+                QuicPacketTraceType(Packet),
+                QUIC_TRACE_PACKET_LOSS_PROBE);
+            QuicConnFlightRecord(
+                Connection,
+                QUIC_FLIGHT_RECORDER_EVENT_PACKET_LOST,
+                Packet->PacketNumber,
+                QUIC_TRACE_PACKET_LOSS_PROBE);
             if (QuicLossDetectionRetransmitFrames(LossDetection, Packet, FALSE) &&
                 --NumPackets == 0) {
                 return;
@@ -1787,6 +2136,33 @@ QuicLossDetectionScheduleProbe(
     QuicSendSetSendFlag(&Connection->Send, QUIC_CONN_SEND_FLAG_PING);
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicLossDetectionOnActivePathChanged(
+    _In_ QUIC_LOSS_DETECTION* LossDetection
+    )
+{
+    if (LossDetection->PacketsInFlight == 0) {
+        return;
+    }
+
+    QUIC_CONNECTION* Connection = QuicLossDetectionGetConnection(LossDetection);
+    QuicTraceLogConnInfo(
+        ProbeOnPathChange,
+        Connection,
+        "Probing new active path (ProbeCount=%hu)",
+        LossDetection->ProbeCount);
+
+    //
+    // Anything still outstanding was most likely sent on a path that is no
+    // longer usable. Rather than waiting out a (possibly backed off) PTO that
+    // was armed for the old path, start over and probe the new one right away.
+    //
+    LossDetection->ProbeCount = 0;
+    QuicLossDetectionScheduleProbe(LossDetection);
+    QuicLossDetectionUpdateTimer(LossDetection, FALSE);
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicLossDetectionProcessTimerOperation(
@@ -1823,6 +2199,7 @@ QuicLossDetectionProcessTimerOperation(
     uint64_t TimeNow = CxPlatTimeUs64();
 
     if (OldestPacket != NULL &&
+        CxPlatTimeAtOrBefore64(OldestPacket->SentTime, TimeNow) &&
         CxPlatTimeDiff64(OldestPacket->SentTime, TimeNow) >=
             MS_TO_US((uint64_t)Connection->Settings.DisconnectTimeoutMs)) {
         //
@@ -1843,8 +2220,15 @@ QuicLossDetectionProcessTimerOperation(
         // Probe or RACK timeout. If no packets can be inferred lost right now,
         // send probes.
         //
+        // A client with a standby path fails over to it rather than keep
+        // probing the active path once that has gone a few PTOs unanswered.
+        //
         if (!QuicLossDetectionDetectAndHandleLostPackets(LossDetection, TimeNow)) {
-            QuicLossDetectionScheduleProbe(LossDetection);
+            if (LossDetection->ProbeCount + 1 < QUIC_STANDBY_FAILOVER_PTO_COUNT ||
+                Connection->StandbyPaths == NULL ||
+                !QuicConnFailoverToStandbyPath(Connection)) {
+                QuicLossDetectionScheduleProbe(LossDetection);
+            }
         }
 
         QuicLossDetectionUpdateTimer(LossDetection, FALSE);
@@ -73,6 +73,21 @@ typedef struct QUIC_LOSS_DETECTION {
     QUIC_SENT_PACKET_METADATA* SentPackets;
     QUIC_SENT_PACKET_METADATA** SentPacketsTail;
 
+    //
+    // Index of the outstanding packets by packet number, so that ACK blocks
+    // can be mapped directly onto the SentPackets list. The slot for a packet
+    // is its packet number modulo SentPacketIndexSize (a power of two). The
+    // index is only a hint: a missing entry means the list is walked instead.
+    //
+    QUIC_SENT_PACKET_METADATA** SentPacketIndex;
+    uint32_t SentPacketIndexSize;
+
+    //
+    // Metadata for the sent packets of busy connections is allocated from
+    // here, instead of the worker's pools.
+    //
+    QUIC_SENT_PACKET_ARENA SentPacketArena;
+
     //
     // Lost packets. The purpose of this list is to remember packets a little
     // while after we decide they are lost, in case we were wrong and the ACK
@@ -127,6 +142,16 @@ QuicLossDetectionOnZeroRttRejected(
     _In_ QUIC_LOSS_DETECTION* LossDetection
     );
 
+//
+// Returns the bytes of ack-eliciting packets that are still outstanding, which
+// is what the congestion controller counts as in flight.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+uint32_t
+QuicLossDetectionGetBytesInFlight(
+    _In_ const QUIC_LOSS_DETECTION* LossDetection
+    );
+
 //
 // Resets the timer based on the current state.
 //
@@ -179,6 +204,16 @@ QuicLossDetectionProcessAckFrame(
     _Out_ BOOLEAN* InvalidFrame
     );
 
+//
+// Called when the active path changes to a new local or remote address.
+// Immediately probes the new path with any outstanding data.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicLossDetectionOnActivePathChanged(
+    _In_ QUIC_LOSS_DETECTION* LossDetection
+    );
+
 //
 // Called when the loss detection timer fires.
 //
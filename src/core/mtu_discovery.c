@@ -23,9 +23,14 @@ Abstract:
     trigger a new MTU discovery period, unless maximum allowed MTU is already
     reached.
 
-    The current algorithm is very simplistic, increasing by 80 bytes each
-    probe. A special case is added so 1500 is always a checked value, as 1500
-    is often the max allowed over the internet.
+    Probe sizes are picked to converge quickly. The MTU recently discovered
+    to the same remote IP (by any connection) is probed first. Then the
+    largest entry of the global probe size table (QUIC_PARAM_GLOBAL_MTU_PROBE_SIZES)
+    that is still allowed is probed, falling back to increasing by
+    QUIC_DPLPMTUD_INCREMENT bytes each probe. If a probe that jumped more than
+    one increment fails, the search continues below that size instead of
+    stopping. The first probe at a cached size is expected to succeed, so it
+    is allowed to carry stream data instead of padding.
 
 --*/
 
@@ -59,6 +64,11 @@ QuicMtuDiscoveryMoveToSearchComplete(
         CXPLAT_CONTAINING_RECORD(MtuDiscovery, QUIC_PATH, MtuDiscovery);
     MtuDiscovery->IsSearchComplete = TRUE;
     MtuDiscovery->SearchCompleteEnterTimeUs = CxPlatTimeUs64();
+    MtuDiscovery->FailedProbeSize = 0;
+    QUIC_PATH_METRICS Metrics = { 0 };
+    Metrics.Mtu = Path->Mtu;
+    QuicPathMetricsCacheUpdate(
+        &MsQuicLib.PathMetricsCache, &Path->Route.RemoteAddress, &Metrics);
     QuicTraceLogConnInfo(
         MtuSearchComplete,
         Connection,
@@ -80,28 +90,37 @@ QuicGetNextProbeSize(
     // N.B. This algorithm must always be increasing. Other logic in the module
     // depends on that behavior.
     //
+    uint16_t UpperBound = MtuDiscovery->MaxMtu;
+    if (MtuDiscovery->FailedProbeSize != 0 &&
+        MtuDiscovery->FailedProbeSize - 1 < UpperBound) {
+        UpperBound = MtuDiscovery->FailedProbeSize - 1;
+    }
 
     //
-    // Jump automatically to 1280 to return algorithm to ideal case. 1280 should
-    // be supported in most scenarios. With minimum being 1248, this will always
-    // be less then a full increment.
+    // Another connection recently found this MTU to the same peer, so try it
+    // first.
     //
-    if (Path->Mtu < 1280) {
-        return CXPLAT_MIN(1280, MtuDiscovery->MaxMtu);
-    }
-
-    uint16_t Mtu = Path->Mtu + QUIC_DPLPMTUD_INCREMENT;
-    if (Mtu > MtuDiscovery->MaxMtu) {
-        Mtu = MtuDiscovery->MaxMtu;
+    if (MtuDiscovery->CachedMtu > Path->Mtu &&
+        MtuDiscovery->CachedMtu <= UpperBound) {
+        return MtuDiscovery->CachedMtu;
     }
 
     //
-    // Our increasing algorithm might not hit 1500 by default. Ensure that
-    // happens.
+    // Try the largest common MTU that is still allowed.
     //
-    if (!MtuDiscovery->HasProbed1500 && Mtu >= 1500) {
-        MtuDiscovery->HasProbed1500 = TRUE;
-        Mtu = 1500;
+    for (uint8_t i = MsQuicLib.MtuProbeSizeCount; i > 0; --i) {
+        const uint16_t ProbeSize = MsQuicLib.MtuProbeSizes[i - 1];
+        if (ProbeSize <= Path->Mtu) {
+            break;
+        }
+        if (ProbeSize <= UpperBound) {
+            return ProbeSize;
+        }
+    }
+
+    uint16_t Mtu = Path->Mtu + QUIC_DPLPMTUD_INCREMENT;
+    if (Mtu > UpperBound) {
+        Mtu = UpperBound;
     }
     return Mtu;
 }
@@ -161,7 +180,12 @@ QuicMtuDiscoveryPeerValidated(
     // default
     //
     MtuDiscovery->MaxMtu = QuicConnGetMaxMtuForPath(Connection, Path);
-    MtuDiscovery->HasProbed1500 = Path->Mtu >= 1500;
+    QUIC_PATH_METRICS Metrics;
+    MtuDiscovery->CachedMtu =
+        QuicPathMetricsCacheLookup(
+            &MsQuicLib.PathMetricsCache, &Path->Route.RemoteAddress, &Metrics) ?
+        Metrics.Mtu : 0;
+    MtuDiscovery->FailedProbeSize = 0;
     CXPLAT_DBG_ASSERT(Path->Mtu <= MtuDiscovery->MaxMtu);
 
     QuicTraceLogConnInfo(
@@ -253,12 +277,19 @@ QuicMtuDiscoveryProbePacketDiscarded(
         MtuDiscovery->ProbeCount);
 
     //
-    // If we've done max probes, we've found our max, enter search complete
-    // waiting phase. Otherwise send out another probe of the same size.
+    // If we've done max probes, that size is too big. If the probe jumped more
+    // than one increment, keep searching below it. Otherwise we've found our
+    // max, enter search complete waiting phase. If we haven't done max probes,
+    // send out another probe of the same size.
     //
     if (MtuDiscovery->ProbeCount >=
             (int16_t)Connection->Settings.MtuDiscoveryMissingProbeCount - 1) {
-        QuicMtuDiscoveryMoveToSearchComplete(MtuDiscovery, Connection);
+        if (MtuDiscovery->ProbeSize > Path->Mtu + QUIC_DPLPMTUD_INCREMENT) {
+            MtuDiscovery->FailedProbeSize = MtuDiscovery->ProbeSize;
+            QuicMtuDiscoveryMoveToSearching(MtuDiscovery, Connection);
+        } else {
+            QuicMtuDiscoveryMoveToSearchComplete(MtuDiscovery, Connection);
+        }
         return;
     }
     MtuDiscovery->ProbeCount++;
@@ -22,6 +22,18 @@ typedef struct QUIC_MTU_DISCOVERY {
     //
     uint16_t ProbeSize;
 
+    //
+    // The MTU recently discovered to the same remote address by another
+    // connection, or zero.
+    //
+    uint16_t CachedMtu;
+
+    //
+    // The smallest probe size that has failed in the current search, or zero.
+    // Later probes in the search stay below it.
+    //
+    uint16_t FailedProbeSize;
+
     //
     // The amount of probes that have occured at the current size.
     //
@@ -32,11 +44,6 @@ typedef struct QUIC_MTU_DISCOVERY {
     //
     BOOLEAN IsSearchComplete    : 1;
 
-    //
-    // Check for has 1500 been probed to ensure its tested.
-    //
-    BOOLEAN HasProbed1500       : 1;
-
 } QUIC_MTU_DISCOVERY;
 
 //
@@ -80,3 +87,20 @@ QuicMtuDiscoveryProbePacketDiscarded(
     _In_ QUIC_CONNECTION* Connection,
     _In_ uint16_t PacketMtu
     );
+
+//
+// Returns TRUE if the next probe packet may carry retransmittable data instead
+// of just padding. This is only allowed for the first probe at a size already
+// discovered to the same remote address, which is expected to succeed.
+//
+inline
+BOOLEAN
+QuicMtuDiscoveryProbeCanCarryData(
+    _In_ const QUIC_MTU_DISCOVERY* MtuDiscovery
+    )
+{
+    return
+        MtuDiscovery->ProbeCount == 0 &&
+        MtuDiscovery->FailedProbeSize == 0 &&
+        MtuDiscovery->ProbeSize <= MtuDiscovery->CachedMtu;
+}
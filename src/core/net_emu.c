@@ -0,0 +1,475 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    In-process network emulation. See net_emu.h.
+
+    Each direction models a single bottleneck: a datagram waits for the
+    datagrams ahead of it to be serialized at the link's bandwidth, and is tail
+    dropped if the backlog would exceed the buffer. After the bottleneck, it
+    may be lost (independently, or in Gilbert-Elliott bursts), and otherwise
+    it arrives after the propagation delay plus jitter, or straight away if it
+    is picked to be reordered.
+
+    Held datagrams are delivered by a dedicated thread, which sleeps until the
+    next delivery time and polls when that is less than a millisecond away.
+
+--*/
+
+#include "precomp.h"
+#ifdef QUIC_CLOG
+#include "net_emu.c.clog.h"
+#endif
+
+#define QUIC_NET_EMU_RATE_SCALE     1000000 // Rates are per million packets
+
+CXPLAT_THREAD_CALLBACK(QuicNetEmuThread, Context);
+
+//
+// xorshift64*, so runs with the same seed make the same decisions.
+//
+static
+uint32_t
+QuicNetEmuLinkRandom(
+    _Inout_ QUIC_NET_EMU_LINK* Link
+    )
+{
+    Link->Random ^= Link->Random >> 12;
+    Link->Random ^= Link->Random << 25;
+    Link->Random ^= Link->Random >> 27;
+    return (uint32_t)((Link->Random * 0x2545F4914F6CDD1DULL) >> 32);
+}
+
+//
+// Returns TRUE for a random Rate out of every QUIC_NET_EMU_RATE_SCALE calls.
+//
+static
+BOOLEAN
+QuicNetEmuLinkChance(
+    _Inout_ QUIC_NET_EMU_LINK* Link,
+    _In_ uint64_t Rate
+    )
+{
+    return Rate != 0 && (QuicNetEmuLinkRandom(Link) % QUIC_NET_EMU_RATE_SCALE) < Rate;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicNetEmuLinkInitialize(
+    _Out_ QUIC_NET_EMU_LINK* Link,
+    _In_ const QUIC_NETWORK_EMULATION_LINK* Config,
+    _In_ uint64_t Seed
+    )
+{
+    CxPlatZeroMemory(Link, sizeof(*Link));
+    Link->Config = *Config;
+    Link->Random = Seed != 0 ? Seed : 0x9E3779B97F4A7C15ULL;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+static
+BOOLEAN
+QuicNetEmuLinkLost(
+    _Inout_ QUIC_NET_EMU_LINK* Link
+    )
+{
+    const QUIC_NETWORK_EMULATION_LINK* Config = &Link->Config;
+    if (Config->LossRate == 0) {
+        return FALSE;
+    }
+
+    if (Config->LossBurstLength <= 1) {
+        return QuicNetEmuLinkChance(Link, Config->LossRate);
+    }
+
+    if (Config->LossRate >= QUIC_NET_EMU_RATE_SCALE) {
+        return TRUE;
+    }
+
+    //
+    // A two state Markov chain, where every packet is lost in the bad state.
+    // The packet that enters it is the first loss of the burst and each one
+    // after that leaves it with probability 1/BurstLength, which gives the
+    // average burst length. Entering it with probability
+    // p/(BurstLength * (1 - p)) then gives the average loss rate p.
+    //
+    if (Link->InLossBurst) {
+        if (QuicNetEmuLinkChance(Link, QUIC_NET_EMU_RATE_SCALE / Config->LossBurstLength)) {
+            Link->InLossBurst = FALSE;
+            return FALSE;
+        }
+        return TRUE;
+    }
+
+    const uint64_t EnterRate =
+        (uint64_t)Config->LossRate * QUIC_NET_EMU_RATE_SCALE /
+        ((uint64_t)Config->LossBurstLength * (QUIC_NET_EMU_RATE_SCALE - Config->LossRate));
+    if (QuicNetEmuLinkChance(Link, EnterRate)) {
+        Link->InLossBurst = TRUE;
+        return TRUE;
+    }
+    return FALSE;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint64_t
+QuicNetEmuLinkSchedule(
+    _Inout_ QUIC_NET_EMU_LINK* Link,
+    _In_ uint64_t TimeNow,
+    _In_ uint32_t Length
+    )
+{
+    const QUIC_NETWORK_EMULATION_LINK* Config = &Link->Config;
+
+    uint64_t Departure = TimeNow;
+    if (Config->BandwidthKbps != 0) {
+        if (Link->NextFreeTime > TimeNow) {
+            if (Config->QueueBytes != 0) {
+                //
+                // The backlog still includes the datagram on the wire, which
+                // doesn't take up room in the queue. Datagrams on a link are
+                // mostly the same size, so this one fits if the backlog does.
+                //
+                const uint64_t Backlog =
+                    (Link->NextFreeTime - TimeNow) * Config->BandwidthKbps / 8000;
+                if (Backlog > Config->QueueBytes) {
+                    return UINT64_MAX;
+                }
+            }
+            Departure = Link->NextFreeTime;
+        }
+        Departure += (uint64_t)Length * 8000 / Config->BandwidthKbps;
+        Link->NextFreeTime = Departure;
+    }
+
+    //
+    // Lost after the bottleneck, so lost datagrams still use up bandwidth.
+    //
+    if (QuicNetEmuLinkLost(Link)) {
+        return UINT64_MAX;
+    }
+
+    if (QuicNetEmuLinkChance(Link, Config->ReorderRate)) {
+        return Departure;
+    }
+
+    uint64_t Delivery = Departure + Config->DelayUs;
+    if (Config->JitterUs != 0) {
+        Delivery += QuicNetEmuLinkRandom(Link) % ((uint64_t)Config->JitterUs + 1);
+    }
+    return Delivery;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicNetEmuInitialize(
+    _Out_ QUIC_NET_EMU* Emu
+    )
+{
+    CxPlatZeroMemory(Emu, sizeof(*Emu));
+    CxPlatDispatchLockInitialize(&Emu->Lock);
+    CxPlatListInitializeHead(&Emu->Packets);
+    CxPlatPoolInitialize(FALSE, sizeof(QUIC_NET_EMU_PACKET), QUIC_POOL_NET_EMU, &Emu->PacketPool);
+    CxPlatEventInitialize(&Emu->Wake, FALSE, FALSE);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicNetEmuStop(
+    _Inout_ QUIC_NET_EMU* Emu
+    )
+{
+    CxPlatDispatchLockAcquire(&Emu->Lock);
+    Emu->Enabled = FALSE;
+    Emu->ShuttingDown = TRUE;
+    CxPlatDispatchLockRelease(&Emu->Lock);
+
+    if (Emu->ThreadRunning) {
+        CxPlatEventSet(Emu->Wake);
+        CxPlatThreadWait(&Emu->Thread);
+        CxPlatThreadDelete(&Emu->Thread);
+        Emu->ThreadRunning = FALSE;
+    }
+    Emu->ShuttingDown = FALSE;
+
+    CXPLAT_DBG_ASSERT(CxPlatListIsEmpty(&Emu->Packets));
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicNetEmuUninitialize(
+    _In_ QUIC_NET_EMU* Emu
+    )
+{
+    CXPLAT_DBG_ASSERT(!Emu->ThreadRunning);
+    CxPlatEventUninitialize(Emu->Wake);
+    CxPlatPoolUninitialize(&Emu->PacketPool);
+    CxPlatDispatchLockUninitialize(&Emu->Lock);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicNetEmuSetSettings(
+    _Inout_ QUIC_NET_EMU* Emu,
+    _In_opt_ const QUIC_NETWORK_EMULATION_SETTINGS* Settings
+    )
+{
+    if (Settings == NULL) {
+        CxPlatDispatchLockAcquire(&Emu->Lock);
+        Emu->Enabled = FALSE;
+        CxPlatDispatchLockRelease(&Emu->Lock);
+        return QUIC_STATUS_SUCCESS;
+    }
+
+#ifndef QUIC_SIMULATION
+    if (!Emu->ThreadRunning) {
+        CXPLAT_THREAD_CONFIG ThreadConfig = {
+            CXPLAT_THREAD_FLAG_HIGH_PRIORITY,
+            0,
+            "quic_netemu",
+            QuicNetEmuThread,
+            Emu
+        };
+        QUIC_STATUS Status = CxPlatThreadCreate(&ThreadConfig, &Emu->Thread);
+        if (QUIC_FAILED(Status)) {
+            return Status;
+        }
+        Emu->ThreadRunning = TRUE;
+    }
+#endif
+
+    CxPlatDispatchLockAcquire(&Emu->Lock);
+
+    uint64_t Seed = Settings->RandomSeed;
+    if (Seed == 0) {
+        CxPlatRandom(sizeof(Seed), &Seed);
+    }
+    Emu->RandomSeed = Settings->RandomSeed;
+    QuicNetEmuLinkInitialize(&Emu->ClientToServer, &Settings->ClientToServer, Seed * 2 + 1);
+    QuicNetEmuLinkInitialize(&Emu->ServerToClient, &Settings->ServerToClient, Seed * 2 + 2);
+    Emu->Enabled = TRUE;
+
+    QuicTraceLogInfo(
+        NetEmuSettingsSet,
+        "[ lib] Network emulation enabled, %u kbps/%u us up, %u kbps/%u us down",
+        Settings->ClientToServer.BandwidthKbps,
+        Settings->ClientToServer.DelayUs,
+        Settings->ServerToClient.BandwidthKbps,
+        Settings->ServerToClient.DelayUs);
+
+    CxPlatDispatchLockRelease(&Emu->Lock);
+
+    return QUIC_STATUS_SUCCESS;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicNetEmuGetSettings(
+    _In_ QUIC_NET_EMU* Emu,
+    _Out_ QUIC_NETWORK_EMULATION_SETTINGS* Settings
+    )
+{
+    CxPlatZeroMemory(Settings, sizeof(*Settings));
+    CxPlatDispatchLockAcquire(&Emu->Lock);
+    if (Emu->Enabled) {
+        Settings->ClientToServer = Emu->ClientToServer.Config;
+        Settings->ServerToClient = Emu->ServerToClient.Config;
+        Settings->RandomSeed = Emu->RandomSeed;
+    }
+    CxPlatDispatchLockRelease(&Emu->Lock);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicNetEmuReceive(
+    _Inout_ QUIC_NET_EMU* Emu,
+    _In_ QUIC_BINDING* Binding,
+    _In_ CXPLAT_RECV_DATA* DatagramChain
+    )
+{
+    CXPLAT_RECV_DATA* DropChain = NULL;
+    CXPLAT_RECV_DATA** DropChainTail = &DropChain;
+    BOOLEAN Wake = FALSE;
+
+    CxPlatDispatchLockAcquire(&Emu->Lock);
+
+    if (!Emu->Enabled || Binding->NetEmuBypass) {
+        CxPlatDispatchLockRelease(&Emu->Lock);
+        return FALSE;
+    }
+
+    QUIC_NET_EMU_LINK* Link =
+        Binding->ServerOwned ? &Emu->ClientToServer : &Emu->ServerToClient;
+    const uint64_t TimeNow = CxPlatTimeUs64();
+
+    CXPLAT_RECV_DATA* Datagram;
+    while ((Datagram = DatagramChain) != NULL) {
+        DatagramChain = Datagram->Next;
+        Datagram->Next = NULL;
+
+        const uint64_t DeliveryTime =
+            QuicNetEmuLinkSchedule(Link, TimeNow, Datagram->BufferLength);
+        QUIC_NET_EMU_PACKET* Packet =
+            DeliveryTime == UINT64_MAX ?
+                NULL : (QUIC_NET_EMU_PACKET*)CxPlatPoolAlloc(&Emu->PacketPool);
+        if (Packet == NULL) {
+            *DropChainTail = Datagram;
+            DropChainTail = &Datagram->Next;
+            continue;
+        }
+
+        Packet->DeliveryTime = DeliveryTime;
+        Packet->Binding = Binding;
+        Packet->Datagram = Datagram;
+
+        //
+        // Delivery times mostly increase, so search from the tail. Datagrams
+        // with the same delivery time stay in arrival order.
+        //
+        CXPLAT_LIST_ENTRY* Entry = Emu->Packets.Blink;
+        while (Entry != &Emu->Packets &&
+               CXPLAT_CONTAINING_RECORD(Entry, QUIC_NET_EMU_PACKET, Link)->DeliveryTime > DeliveryTime) {
+            Entry = Entry->Blink;
+        }
+        CxPlatListInsertHead(Entry, &Packet->Link);
+        if (Entry == &Emu->Packets) {
+            Wake = TRUE; // New earliest delivery time.
+        }
+    }
+
+    CxPlatDispatchLockRelease(&Emu->Lock);
+
+    if (Wake) {
+        CxPlatEventSet(Emu->Wake);
+    }
+    if (DropChain != NULL) {
+        CxPlatRecvDataReturn(DropChain);
+    }
+
+    return TRUE;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicNetEmuRemoveBinding(
+    _Inout_ QUIC_NET_EMU* Emu,
+    _In_ QUIC_BINDING* Binding
+    )
+{
+    CXPLAT_RECV_DATA* DropChain = NULL;
+    CXPLAT_RECV_DATA** DropChainTail = &DropChain;
+
+    CxPlatDispatchLockAcquire(&Emu->Lock);
+    Binding->NetEmuBypass = TRUE;
+    CXPLAT_LIST_ENTRY* Entry = Emu->Packets.Flink;
+    while (Entry != &Emu->Packets) {
+        QUIC_NET_EMU_PACKET* Packet =
+            CXPLAT_CONTAINING_RECORD(Entry, QUIC_NET_EMU_PACKET, Link);
+        Entry = Entry->Flink;
+        if (Packet->Binding == Binding) {
+            CxPlatListEntryRemove(&Packet->Link);
+            *DropChainTail = Packet->Datagram;
+            DropChainTail = &Packet->Datagram->Next;
+            CxPlatPoolFree(&Emu->PacketPool, Packet);
+        }
+    }
+    CxPlatDispatchLockRelease(&Emu->Lock);
+
+    if (DropChain != NULL) {
+        CxPlatRecvDataReturn(DropChain);
+    }
+}
+
+//
+// Delivers all datagrams due by TimeNow, in chains of consecutive datagrams
+// for the same binding and partition. Returns the next delivery time. Called
+// with the lock held.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+static
+uint64_t
+QuicNetEmuDeliver(
+    _Inout_ QUIC_NET_EMU* Emu,
+    _In_ uint64_t TimeNow
+    )
+{
+    while (!CxPlatListIsEmpty(&Emu->Packets)) {
+        QUIC_NET_EMU_PACKET* Packet =
+            CXPLAT_CONTAINING_RECORD(Emu->Packets.Flink, QUIC_NET_EMU_PACKET, Link);
+        if (Packet->DeliveryTime > TimeNow) {
+            return Packet->DeliveryTime;
+        }
+
+        QUIC_BINDING* Binding = Packet->Binding;
+        CXPLAT_RECV_DATA* Chain = Packet->Datagram;
+        CXPLAT_RECV_DATA** ChainTail = &Chain->Next;
+        CxPlatListEntryRemove(&Packet->Link);
+        CxPlatPoolFree(&Emu->PacketPool, Packet);
+
+        while (!CxPlatListIsEmpty(&Emu->Packets)) {
+            Packet = CXPLAT_CONTAINING_RECORD(Emu->Packets.Flink, QUIC_NET_EMU_PACKET, Link);
+            if (Packet->DeliveryTime > TimeNow ||
+                Packet->Binding != Binding ||
+                Packet->Datagram->PartitionIndex != Chain->PartitionIndex) {
+                break;
+            }
+            *ChainTail = Packet->Datagram;
+            ChainTail = &Packet->Datagram->Next;
+            CxPlatListEntryRemove(&Packet->Link);
+            CxPlatPoolFree(&Emu->PacketPool, Packet);
+        }
+
+        QuicBindingReceiveDatagrams(Binding, Chain);
+    }
+    return UINT64_MAX;
+}
+
+#ifdef QUIC_SIMULATION
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+uint64_t
+QuicNetEmuAdvance(
+    _Inout_ QUIC_NET_EMU* Emu,
+    _In_ uint64_t TimeNow
+    )
+{
+    CxPlatDispatchLockAcquire(&Emu->Lock);
+    const uint64_t NextTime = QuicNetEmuDeliver(Emu, TimeNow);
+    CxPlatDispatchLockRelease(&Emu->Lock);
+    return NextTime;
+}
+
+#endif
+
+CXPLAT_THREAD_CALLBACK(QuicNetEmuThread, Context)
+{
+    QUIC_NET_EMU* Emu = (QUIC_NET_EMU*)Context;
+
+    while (TRUE) {
+        CxPlatDispatchLockAcquire(&Emu->Lock);
+        if (Emu->ShuttingDown) {
+            CxPlatDispatchLockRelease(&Emu->Lock);
+            break;
+        }
+        const uint64_t TimeNow = CxPlatTimeUs64();
+        const uint64_t NextTime = QuicNetEmuDeliver(Emu, TimeNow);
+        CxPlatDispatchLockRelease(&Emu->Lock);
+
+        if (NextTime == UINT64_MAX) {
+            CxPlatEventWaitForever(Emu->Wake);
+        } else if (NextTime - TimeNow >= 1000) {
+            uint64_t Delay = US_TO_MS(NextTime - TimeNow);
+            if (Delay >= (uint64_t)UINT32_MAX) {
+                Delay = UINT32_MAX - 1; // Max has special meaning for most platforms.
+            }
+            CxPlatEventWaitWithTimeout(Emu->Wake, (uint32_t)Delay);
+        } else {
+            CxPlatSchedulerYield();
+        }
+    }
+
+    CXPLAT_THREAD_RETURN(QUIC_STATUS_SUCCESS);
+}
@@ -0,0 +1,200 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    In-process network emulation, for reproducible WAN performance tests on a
+    single machine. When enabled, the datagrams received by every binding are
+    held back and delivered by the emulator's thread as if they had crossed a
+    link with the configured bandwidth, buffer, delay, jitter, loss and
+    reordering. Server owned bindings receive over the client-to-server link
+    and client bindings over the server-to-client one.
+
+--*/
+
+#pragma once
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+typedef struct QUIC_BINDING QUIC_BINDING;
+
+//
+// The state of one direction of the emulated link.
+//
+typedef struct QUIC_NET_EMU_LINK {
+
+    QUIC_NETWORK_EMULATION_LINK Config;
+
+    //
+    // The time the bottleneck finishes sending everything queued on it.
+    //
+    uint64_t NextFreeTime;
+
+    //
+    // State of the random number generator, seeded from the settings.
+    //
+    uint64_t Random;
+
+    //
+    // Whether the link is in a loss burst (Gilbert-Elliott bad state).
+    //
+    BOOLEAN InLossBurst;
+
+} QUIC_NET_EMU_LINK;
+
+//
+// A datagram waiting to be delivered.
+//
+typedef struct QUIC_NET_EMU_PACKET {
+
+    CXPLAT_LIST_ENTRY Link;
+    uint64_t DeliveryTime;
+    QUIC_BINDING* Binding;
+    CXPLAT_RECV_DATA* Datagram;
+
+} QUIC_NET_EMU_PACKET;
+
+typedef struct QUIC_NET_EMU {
+
+    //
+    // Checked without the lock on the receive path, and again with it.
+    //
+    BOOLEAN Enabled;
+
+    //
+    // Whether the thread was created. Only changed at passive level, with
+    // MsQuicLib.Lock held.
+    //
+    BOOLEAN ThreadRunning;
+
+    BOOLEAN ShuttingDown;
+
+    //
+    // Protects everything below, and is held while delivering datagrams so a
+    // binding can't be cleaned up while the emulator is using it.
+    //
+    CXPLAT_DISPATCH_LOCK Lock;
+
+    QUIC_NET_EMU_LINK ClientToServer;
+    QUIC_NET_EMU_LINK ServerToClient;
+    uint32_t RandomSeed;
+
+    //
+    // Held datagrams, in delivery time order.
+    //
+    CXPLAT_LIST_ENTRY Packets;
+    CXPLAT_POOL PacketPool;
+
+    CXPLAT_THREAD Thread;
+    CXPLAT_EVENT Wake;
+
+} QUIC_NET_EMU;
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicNetEmuInitialize(
+    _Out_ QUIC_NET_EMU* Emu
+    );
+
+//
+// Stops the emulator's thread. All bindings must have been cleaned up. Called
+// with MsQuicLib.Lock held.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicNetEmuStop(
+    _Inout_ QUIC_NET_EMU* Emu
+    );
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicNetEmuUninitialize(
+    _In_ QUIC_NET_EMU* Emu
+    );
+
+//
+// Enables the emulator with new settings, or disables it if Settings is NULL.
+// Datagrams already held are still delivered as scheduled. Called with
+// MsQuicLib.Lock held.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicNetEmuSetSettings(
+    _Inout_ QUIC_NET_EMU* Emu,
+    _In_opt_ const QUIC_NETWORK_EMULATION_SETTINGS* Settings
+    );
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicNetEmuGetSettings(
+    _In_ QUIC_NET_EMU* Emu,
+    _Out_ QUIC_NETWORK_EMULATION_SETTINGS* Settings
+    );
+
+//
+// Resets the link's state for a new configuration.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicNetEmuLinkInitialize(
+    _Out_ QUIC_NET_EMU_LINK* Link,
+    _In_ const QUIC_NETWORK_EMULATION_LINK* Config,
+    _In_ uint64_t Seed
+    );
+
+//
+// Passes a datagram of Length bytes, arriving at TimeNow, through the link.
+// Returns the time it should be delivered, or UINT64_MAX if it is dropped.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint64_t
+QuicNetEmuLinkSchedule(
+    _Inout_ QUIC_NET_EMU_LINK* Link,
+    _In_ uint64_t TimeNow,
+    _In_ uint32_t Length
+    );
+
+//
+// Takes ownership of a chain of datagrams received by the binding, if the
+// emulator is enabled. Returns FALSE if the caller should process them itself.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicNetEmuReceive(
+    _Inout_ QUIC_NET_EMU* Emu,
+    _In_ QUIC_BINDING* Binding,
+    _In_ CXPLAT_RECV_DATA* DatagramChain
+    );
+
+#ifdef QUIC_SIMULATION
+//
+// Simulation builds have no emulator thread. Instead the app delivers all
+// datagrams due by TimeNow, on the virtual clock, with this. Returns the next
+// delivery time, or UINT64_MAX if nothing is held.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+uint64_t
+QuicNetEmuAdvance(
+    _Inout_ QUIC_NET_EMU* Emu,
+    _In_ uint64_t TimeNow
+    );
+#endif
+
+//
+// Drops any datagrams held for the binding and stops holding new ones, before
+// the binding is cleaned up.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicNetEmuRemoveBinding(
+    _Inout_ QUIC_NET_EMU* Emu,
+    _In_ QUIC_BINDING* Binding
+    );
+
+#if defined(__cplusplus)
+}
+#endif
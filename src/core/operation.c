@@ -20,6 +20,11 @@ Abstract:
     is the only thread that touches the connection itself, which simplifies
     synchronization.
 
+    Enqueuing is lock-free: producers push onto one of three intrusive stacks
+    (normal, priority and front) with a compare-and-swap. The draining thread
+    takes each stack as a whole with an exchange and moves its operations, in
+    order, into the list it processes from, so only it ever touches that list.
+
 --*/
 
 #include "precomp.h"
@@ -34,7 +39,9 @@ QuicOperationQueueInitialize(
     )
 {
     OperQ->ActivelyProcessing = FALSE;
-    CxPlatDispatchLockInitialize(&OperQ->Lock);
+    OperQ->Pending = NULL;
+    OperQ->PendingPriority = NULL;
+    OperQ->PendingFront = NULL;
     CxPlatListInitializeHead(&OperQ->List);
     OperQ->PriorityTail = &OperQ->List.Flink;
 }
@@ -46,9 +53,11 @@ QuicOperationQueueUninitialize(
     )
 {
     UNREFERENCED_PARAMETER(OperQ);
+    CXPLAT_DBG_ASSERT(OperQ->Pending == NULL);
+    CXPLAT_DBG_ASSERT(OperQ->PendingPriority == NULL);
+    CXPLAT_DBG_ASSERT(OperQ->PendingFront == NULL);
     CXPLAT_DBG_ASSERT(CxPlatListIsEmpty(&OperQ->List));
     CXPLAT_DBG_ASSERT(OperQ->PriorityTail == &OperQ->List.Flink);
-    CxPlatDispatchLockUninitialize(&OperQ->Lock);
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -119,6 +128,41 @@ QuicOperationFree(
             }
         } else if (ApiCtx->Type == QUIC_API_TYPE_STRM_RECV_SET_ENABLED) {
             QuicStreamRelease(ApiCtx->STRM_RECV_SET_ENABLED.Stream, QUIC_STREAM_REF_OPERATION);
+        } else if (ApiCtx->Type == QUIC_API_TYPE_STRM_PROVIDE_RECV_BUFFERS) {
+            //
+            // Free any chunks that weren't handed off to the receive buffer.
+            //
+            while (!CxPlatListIsEmpty(&ApiCtx->STRM_PROVIDE_RECV_BUFFERS.Chunks)) {
+                CXPLAT_FREE(
+                    CXPLAT_CONTAINING_RECORD(
+                        CxPlatListRemoveHead(&ApiCtx->STRM_PROVIDE_RECV_BUFFERS.Chunks),
+                        QUIC_RECV_CHUNK,
+                        Link),
+                    QUIC_POOL_RECVBUF);
+            }
+            QuicStreamRelease(ApiCtx->STRM_PROVIDE_RECV_BUFFERS.Stream, QUIC_STREAM_REF_OPERATION);
+        } else if (ApiCtx->Type == QUIC_API_TYPE_STRM_OPEN_AND_SEND) {
+            for (uint32_t i = 0; i < ApiCtx->STRM_OPEN_AND_SEND.Count; ++i) {
+                QuicStreamRelease(
+                    ApiCtx->STRM_OPEN_AND_SEND.Entries[i].Stream,
+                    QUIC_STREAM_REF_OPERATION);
+            }
+            CXPLAT_FREE(ApiCtx->STRM_OPEN_AND_SEND.Entries, QUIC_POOL_STREAM_OPEN_BATCH);
+        } else if (ApiCtx->Type == QUIC_API_TYPE_STRM_RECV_COMPLETE_BATCH) {
+            //
+            // Streams are cleared from the array as they are processed, so
+            // only the refs of unprocessed ones are released here.
+            //
+            for (uint32_t i = 0; i < ApiCtx->STRM_RECV_COMPLETE_BATCH.Count; ++i) {
+                if (ApiCtx->STRM_RECV_COMPLETE_BATCH.Streams[i] != NULL) {
+                    QuicStreamRelease(
+                        ApiCtx->STRM_RECV_COMPLETE_BATCH.Streams[i],
+                        QUIC_STREAM_REF_OPERATION);
+                }
+            }
+            CXPLAT_FREE(
+                ApiCtx->STRM_RECV_COMPLETE_BATCH.Streams,
+                QUIC_POOL_STREAM_RECV_COMPLETE_BATCH);
         }
         CxPlatPoolFree(&Worker->ApiContextPool, ApiCtx);
     } else if (Oper->Type == QUIC_OPER_TYPE_FLUSH_STREAM_RECV) {
@@ -131,24 +175,113 @@ QuicOperationFree(
     CxPlatPoolFree(&Worker->OperPool, Oper);
 }
 
+//
+// Pushes the operation onto one of the queue's pending stacks. Returns TRUE if
+// the stack was empty and the queue isn't being drained, in which case the
+// caller must schedule the queue to be drained.
+//
 _IRQL_requires_max_(DISPATCH_LEVEL)
 BOOLEAN
-QuicOperationEnqueue(
+QuicOperationPush(
     _In_ QUIC_OPERATION_QUEUE* OperQ,
+    _Inout_ CXPLAT_LIST_ENTRY* volatile * Stack,
     _In_ QUIC_OPERATION* Oper
     )
 {
-    BOOLEAN StartProcessing;
-    CxPlatDispatchLockAcquire(&OperQ->Lock);
 #if DEBUG
     CXPLAT_DBG_ASSERT(Oper->Link.Flink == NULL);
 #endif
-    StartProcessing = CxPlatListIsEmpty(&OperQ->List) && !OperQ->ActivelyProcessing;
-    CxPlatListInsertTail(&OperQ->List, &Oper->Link);
-    CxPlatDispatchLockRelease(&OperQ->Lock);
+    CXPLAT_LIST_ENTRY* Head;
+    do {
+        Head = (CXPLAT_LIST_ENTRY*)QuicReadPtrNoFence((void**)Stack);
+        Oper->Link.Flink = Head;
+    } while (InterlockedCompareExchangePointer(
+                (void* volatile*)Stack, &Oper->Link, Head) != Head);
+
+    //
+    // N.B. The interlocked operation above is a full barrier, which pairs with
+    // the one in QuicOperationDequeue, so that either this thread sees the
+    // queue is no longer being drained, or the draining thread sees this
+    // operation.
+    //
     QuicPerfCounterIncrement(QUIC_PERF_COUNTER_CONN_OPER_QUEUED);
     QuicPerfCounterIncrement(QUIC_PERF_COUNTER_CONN_OPER_QUEUE_DEPTH);
-    return StartProcessing;
+    return Head == NULL && !OperQ->ActivelyProcessing;
+}
+
+//
+// Takes all the operations off a pending stack and returns them in the order
+// they were pushed, linked through Link.Flink.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+CXPLAT_LIST_ENTRY*
+QuicOperationPopAll(
+    _Inout_ CXPLAT_LIST_ENTRY* volatile * Stack
+    )
+{
+    if (QuicReadPtrNoFence((void**)Stack) == NULL) {
+        return NULL;
+    }
+
+    CXPLAT_LIST_ENTRY* Entry =
+        (CXPLAT_LIST_ENTRY*)InterlockedFetchAndClearPointer((void* volatile*)Stack);
+    CXPLAT_LIST_ENTRY* Reversed = NULL;
+    while (Entry != NULL) {
+        CXPLAT_LIST_ENTRY* Next = Entry->Flink;
+        Entry->Flink = Reversed;
+        Reversed = Entry;
+        Entry = Next;
+    }
+    return Reversed;
+}
+
+//
+// Moves all pending operations into the list the queue is drained from.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicOperationQueueFlushPending(
+    _In_ QUIC_OPERATION_QUEUE* OperQ
+    )
+{
+    CXPLAT_LIST_ENTRY* Entry = QuicOperationPopAll(&OperQ->PendingPriority);
+    while (Entry != NULL) {
+        CXPLAT_LIST_ENTRY* Next = Entry->Flink;
+        CxPlatListInsertTail(*OperQ->PriorityTail, Entry);
+        OperQ->PriorityTail = &Entry->Flink;
+        Entry = Next;
+    }
+
+    Entry = QuicOperationPopAll(&OperQ->Pending);
+    while (Entry != NULL) {
+        CXPLAT_LIST_ENTRY* Next = Entry->Flink;
+        CxPlatListInsertTail(&OperQ->List, Entry);
+        Entry = Next;
+    }
+
+    //
+    // Front operations are inserted last, one at a time at the head, so that
+    // the most recent one ends up first.
+    //
+    Entry = QuicOperationPopAll(&OperQ->PendingFront);
+    while (Entry != NULL) {
+        CXPLAT_LIST_ENTRY* Next = Entry->Flink;
+        CxPlatListInsertHead(&OperQ->List, Entry);
+        if (OperQ->PriorityTail == &OperQ->List.Flink) {
+            OperQ->PriorityTail = &Entry->Flink;
+        }
+        Entry = Next;
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicOperationEnqueue(
+    _In_ QUIC_OPERATION_QUEUE* OperQ,
+    _In_ QUIC_OPERATION* Oper
+    )
+{
+    return QuicOperationPush(OperQ, &OperQ->Pending, Oper);
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -158,18 +291,7 @@ QuicOperationEnqueuePriority(
     _In_ QUIC_OPERATION* Oper
     )
 {
-    BOOLEAN StartProcessing;
-    CxPlatDispatchLockAcquire(&OperQ->Lock);
-#if DEBUG
-    CXPLAT_DBG_ASSERT(Oper->Link.Flink == NULL);
-#endif
-    StartProcessing = CxPlatListIsEmpty(&OperQ->List) && !OperQ->ActivelyProcessing;
-    CxPlatListInsertTail(*OperQ->PriorityTail, &Oper->Link);
-    OperQ->PriorityTail = &Oper->Link.Flink;
-    CxPlatDispatchLockRelease(&OperQ->Lock);
-    QuicPerfCounterIncrement(QUIC_PERF_COUNTER_CONN_OPER_QUEUED);
-    QuicPerfCounterIncrement(QUIC_PERF_COUNTER_CONN_OPER_QUEUE_DEPTH);
-    return StartProcessing;
+    return QuicOperationPush(OperQ, &OperQ->PendingPriority, Oper);
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -179,20 +301,7 @@ QuicOperationEnqueueFront(
     _In_ QUIC_OPERATION* Oper
     )
 {
-    BOOLEAN StartProcessing;
-    CxPlatDispatchLockAcquire(&OperQ->Lock);
-#if DEBUG
-    CXPLAT_DBG_ASSERT(Oper->Link.Flink == NULL);
-#endif
-    StartProcessing = CxPlatListIsEmpty(&OperQ->List) && !OperQ->ActivelyProcessing;
-    CxPlatListInsertHead(&OperQ->List, &Oper->Link);
-    if (OperQ->PriorityTail == &OperQ->List.Flink) {
-        OperQ->PriorityTail = &Oper->Link.Flink;
-    }
-    CxPlatDispatchLockRelease(&OperQ->Lock);
-    QuicPerfCounterIncrement(QUIC_PERF_COUNTER_CONN_OPER_QUEUED);
-    QuicPerfCounterIncrement(QUIC_PERF_COUNTER_CONN_OPER_QUEUE_DEPTH);
-    return StartProcessing;
+    return QuicOperationPush(OperQ, &OperQ->PendingFront, Oper);
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -201,28 +310,36 @@ QuicOperationDequeue(
     _In_ QUIC_OPERATION_QUEUE* OperQ
     )
 {
-    QUIC_OPERATION* Oper;
-    CxPlatDispatchLockAcquire(&OperQ->Lock);
+    QuicOperationQueueFlushPending(OperQ);
+
     if (CxPlatListIsEmpty(&OperQ->List)) {
-        OperQ->ActivelyProcessing = FALSE;
-        Oper = NULL;
-    } else {
-        OperQ->ActivelyProcessing = TRUE;
-        Oper =
-            CXPLAT_CONTAINING_RECORD(
-                CxPlatListRemoveHead(&OperQ->List), QUIC_OPERATION, Link);
-#if DEBUG
-        Oper->Link.Flink = NULL;
-#endif
-        if (OperQ->PriorityTail == &Oper->Link.Flink) {
-            OperQ->PriorityTail = &OperQ->List.Flink;
+        //
+        // Mark the queue as no longer being drained, so that the next enqueue
+        // schedules it again. Then check once more for an operation enqueued
+        // in the meantime, by a thread that still saw the queue as being
+        // drained and so didn't schedule it.
+        //
+        InterlockedFetchAndClearBoolean(&OperQ->ActivelyProcessing);
+        if (OperQ->Pending == NULL &&
+            OperQ->PendingPriority == NULL &&
+            OperQ->PendingFront == NULL) {
+            return NULL;
         }
+        QuicOperationQueueFlushPending(OperQ);
     }
-    CxPlatDispatchLockRelease(&OperQ->Lock);
 
-    if (Oper != NULL) {
-        QuicPerfCounterDecrement(QUIC_PERF_COUNTER_CONN_OPER_QUEUE_DEPTH);
+    OperQ->ActivelyProcessing = TRUE;
+    QUIC_OPERATION* Oper =
+        CXPLAT_CONTAINING_RECORD(
+            CxPlatListRemoveHead(&OperQ->List), QUIC_OPERATION, Link);
+#if DEBUG
+    Oper->Link.Flink = NULL;
+#endif
+    if (OperQ->PriorityTail == &Oper->Link.Flink) {
+        OperQ->PriorityTail = &OperQ->List.Flink;
     }
+
+    QuicPerfCounterDecrement(QUIC_PERF_COUNTER_CONN_OPER_QUEUE_DEPTH);
     return Oper;
 }
 
@@ -236,11 +353,10 @@ QuicOperationQueueClear(
     CXPLAT_LIST_ENTRY OldList;
     CxPlatListInitializeHead(&OldList);
 
-    CxPlatDispatchLockAcquire(&OperQ->Lock);
     OperQ->ActivelyProcessing = FALSE;
+    QuicOperationQueueFlushPending(OperQ);
     CxPlatListMoveItems(&OperQ->List, &OldList);
     OperQ->PriorityTail = &OperQ->List.Flink;
-    CxPlatDispatchLockRelease(&OperQ->Lock);
 
     int64_t OperationsDequeued = 0;
 
@@ -270,6 +386,19 @@ QuicOperationQueueClear(
                         ApiCtx->STRM_START.Stream,
                         QUIC_STREAM_SHUTDOWN_FLAG_ABORT | QUIC_STREAM_SHUTDOWN_FLAG_IMMEDIATE,
                         0);
+                } else if (ApiCtx->Type == QUIC_API_TYPE_STRM_OPEN_AND_SEND) {
+                    //
+                    // None of these streams were started, and each has a send
+                    // queued, so they're all failed and aborted.
+                    //
+                    for (uint32_t i = 0; i < ApiCtx->STRM_OPEN_AND_SEND.Count; ++i) {
+                        QUIC_STREAM* Stream = ApiCtx->STRM_OPEN_AND_SEND.Entries[i].Stream;
+                        QuicStreamIndicateStartComplete(Stream, QUIC_STATUS_ABORTED);
+                        QuicStreamShutdown(
+                            Stream,
+                            QUIC_STREAM_SHUTDOWN_FLAG_ABORT | QUIC_STREAM_SHUTDOWN_FLAG_IMMEDIATE,
+                            0);
+                    }
                 }
             }
             QuicOperationFree(Worker, Oper);
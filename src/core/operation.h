@@ -9,6 +9,10 @@
 #include "operation.h.clog.h"
 #endif
 
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
 typedef struct QUIC_SEND_REQUEST QUIC_SEND_REQUEST;
 
 //
@@ -27,10 +31,11 @@ typedef enum QUIC_OPERATION_TYPE {
     QUIC_OPER_TYPE_UNREACHABLE,         // Process UDP unreachable event.
     QUIC_OPER_TYPE_FLUSH_STREAM_RECV,   // Indicate a stream data to the app.
     QUIC_OPER_TYPE_FLUSH_SEND,          // Frame packets and send them.
-    QUIC_OPER_TYPE_DEPRECATED,          // No longer used.
+    QUIC_OPER_TYPE_TLS_COMPLETE,        // A pending TLS process call can be resumed.
     QUIC_OPER_TYPE_TIMER_EXPIRED,       // A timer expired.
     QUIC_OPER_TYPE_TRACE_RUNDOWN,       // A trace rundown was triggered.
     QUIC_OPER_TYPE_ROUTE_COMPLETION,    // Process route completion event.
+    QUIC_OPER_TYPE_SETTINGS_CHANGED,    // The global settings were reloaded.
 
     //
     // All stateless operations follow.
@@ -63,9 +68,21 @@ typedef enum QUIC_API_TYPE {
     QUIC_API_TYPE_DATAGRAM_SEND,
     QUIC_API_TYPE_CONN_COMPLETE_RESUMPTION_TICKET_VALIDATION,
     QUIC_API_TYPE_CONN_COMPLETE_CERTIFICATE_VALIDATION,
+    QUIC_API_TYPE_STRM_PROVIDE_RECV_BUFFERS,
+    QUIC_API_TYPE_STRM_OPEN_AND_SEND,
+    QUIC_API_TYPE_STRM_RECV_COMPLETE_BATCH,
+    QUIC_API_TYPE_STRM_RECEIVE,
 
 } QUIC_API_TYPE;
 
+//
+// A stream opened by StreamOpenAndSend, waiting to be started.
+//
+typedef struct QUIC_STREAM_OPEN_AND_SEND_ENTRY {
+    QUIC_STREAM* Stream;
+    QUIC_STREAM_START_FLAGS Flags;
+} QUIC_STREAM_OPEN_AND_SEND_ENTRY;
+
 //
 // Context for an API call. This is allocated separately from QUIC_OPERATION
 // so that non-API-call operations will take less space.
@@ -154,6 +171,25 @@ typedef struct QUIC_API_CONTEXT {
             QUIC_STREAM* Stream;
             BOOLEAN IsEnabled;
         } STRM_RECV_SET_ENABLED;
+        struct {
+            QUIC_STREAM* Stream;
+            CXPLAT_LIST_ENTRY Chunks;
+        } STRM_PROVIDE_RECV_BUFFERS;
+        struct {
+            QUIC_STREAM_OPEN_AND_SEND_ENTRY* Entries;
+            uint32_t Count;
+        } STRM_OPEN_AND_SEND;
+        struct {
+            QUIC_STREAM** Streams;
+            uint32_t Count;
+        } STRM_RECV_COMPLETE_BATCH;
+        struct {
+            QUIC_STREAM* Stream;
+            const QUIC_BUFFER* Buffers;
+            uint32_t BufferCount;
+            uint64_t* BytesReceived;
+            QUIC_RECEIVE_FLAGS* Flags;
+        } STRM_RECEIVE;
 
         struct {
             HQUIC Handle;
@@ -173,12 +209,16 @@ typedef struct QUIC_API_CONTEXT {
 
 typedef enum QUIC_CONN_TIMER_TYPE {
 
-    QUIC_CONN_TIMER_PACING,
+    QUIC_CONN_TIMER_PACING,             // Tracked by the worker's pacing wheel.
     QUIC_CONN_TIMER_ACK_DELAY,
     QUIC_CONN_TIMER_LOSS_DETECTION,
     QUIC_CONN_TIMER_KEEP_ALIVE,
     QUIC_CONN_TIMER_IDLE,
     QUIC_CONN_TIMER_SHUTDOWN,
+    QUIC_CONN_TIMER_HIBERNATE,
+    QUIC_CONN_TIMER_SEND_COALESCE,      // Processed inline, like ACK_DELAY.
+    QUIC_CONN_TIMER_ADDRESS_RACE,
+    QUIC_CONN_TIMER_STANDBY_PROBE,
 
     QUIC_CONN_TIMER_COUNT
 
@@ -292,9 +332,18 @@ typedef struct QUIC_OPERATION_QUEUE {
     BOOLEAN ActivelyProcessing;
 
     //
-    // Queue of pending operations.
+    // Operations enqueued by any thread, but not yet moved into List by the
+    // thread draining the queue. Each is a lock-free stack (most recently
+    // enqueued first) linked through the operations' Link.Flink.
+    //
+    CXPLAT_LIST_ENTRY* volatile Pending;
+    CXPLAT_LIST_ENTRY* volatile PendingPriority;
+    CXPLAT_LIST_ENTRY* volatile PendingFront;
+
+    //
+    // Queue of operations to process. Only accessed by the thread draining the
+    // queue.
     //
-    CXPLAT_DISPATCH_LOCK Lock;
     CXPLAT_LIST_ENTRY List;
     CXPLAT_LIST_ENTRY** PriorityTail; // Tail of the priority queue.
 
@@ -339,7 +388,8 @@ QuicOperationFree(
     );
 
 //
-// Returns TRUE if the operation queue has priority operations queued.
+// Returns TRUE if the operation queue has priority operations queued. Must be
+// called on the thread draining the queue.
 //
 _IRQL_requires_max_(DISPATCH_LEVEL)
 inline
@@ -348,10 +398,10 @@ QuicOperationHasPriority(
     _In_ QUIC_OPERATION_QUEUE* OperQ
     )
 {
-    CxPlatDispatchLockAcquire(&OperQ->Lock);
-    BOOLEAN HasPriorityWork = (&OperQ->List.Flink != OperQ->PriorityTail);
-    CxPlatDispatchLockRelease(&OperQ->Lock);
-    return HasPriorityWork;
+    return
+        &OperQ->List.Flink != OperQ->PriorityTail ||
+        QuicReadPtrNoFence((void**)&OperQ->PendingPriority) != NULL ||
+        QuicReadPtrNoFence((void**)&OperQ->PendingFront) != NULL;
 }
 
 //
@@ -389,7 +439,8 @@ QuicOperationEnqueueFront(
     );
 
 //
-// Dequeues an operation. Returns NULL if the queue is empty.
+// Dequeues an operation. Returns NULL if the queue is empty. Only one thread
+// may drain the queue at a time.
 //
 _IRQL_requires_max_(DISPATCH_LEVEL)
 QUIC_OPERATION*
@@ -406,3 +457,7 @@ QuicOperationQueueClear(
     _In_ QUIC_WORKER* Worker,
     _In_ QUIC_OPERATION_QUEUE* OperQ
     );
+
+#if defined(__cplusplus)
+}
+#endif
@@ -538,7 +538,24 @@ QuicPacketValidateInitialToken(
         return FALSE;
     }
 
+    //
+    // The timestamp is only authenticated, not encrypted, so it can be checked
+    // before paying for the decryption. Tokens are only accepted with the
+    // current or previous stateless retry key, so a timestamp outside of those
+    // two key windows can't be valid.
+    //
     QUIC_TOKEN_CONTENTS Token;
+    CxPlatCopyMemory(&Token.Authenticated, TokenBuffer, sizeof(Token.Authenticated));
+    const int64_t Now = CxPlatTimeEpochMs64();
+    const int64_t CurrentKeyStart =
+        (Now / QUIC_STATELESS_RETRY_KEY_LIFETIME_MS) * QUIC_STATELESS_RETRY_KEY_LIFETIME_MS;
+    if ((int64_t)Token.Authenticated.Timestamp < CurrentKeyStart - QUIC_STATELESS_RETRY_KEY_LIFETIME_MS ||
+        (int64_t)Token.Authenticated.Timestamp >= CurrentKeyStart + QUIC_STATELESS_RETRY_KEY_LIFETIME_MS) {
+        QuicPacketLogDrop(Owner, Packet, "Retry Token Expired");
+        *DropPacket = TRUE;
+        return FALSE;
+    }
+
     if (!QuicRetryTokenDecrypt(Packet, TokenBuffer, &Token)) {
         QuicPacketLogDrop(Owner, Packet, "Retry Token Decryption Failure");
         *DropPacket = TRUE;
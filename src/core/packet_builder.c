@@ -87,6 +87,41 @@ QuicPacketBuilderValidate(
 #define QuicPacketBuilderValidate(Builder, ShouldHaveData) // no-op
 #endif
 
+//
+// Calculates how many datagrams each send batch may carry, based on the
+// path's pacing rate. Returns zero if the batches aren't limited beyond what
+// the datapath supports.
+//
+static
+uint16_t
+QuicPacketBuilderGetMaxBatchSegments(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ const QUIC_PATH* Path
+    )
+{
+    if (!Connection->Settings.PacingEnabled ||
+        !Path->GotFirstRttSample ||
+        Path->SmoothedRtt < QUIC_MIN_PACING_RTT) {
+        return 0;
+    }
+
+    //
+    // The pacing rate is the congestion window per RTT, so the data released
+    // in a fraction of the RTT is the same fraction of the window.
+    //
+    uint32_t Segments =
+        QuicCongestionControlGetCongestionWindow(&Connection->CongestionControl) /
+        (QUIC_SEND_BATCH_RTT_DIVISOR * (uint32_t)Path->Mtu);
+    if (Segments < QUIC_MIN_SEND_BATCH_SEGMENTS) {
+        Segments = QUIC_MIN_SEND_BATCH_SEGMENTS;
+    }
+    const uint16_t DatapathMax = CxPlatDataPathGetMaxSendSegments(MsQuicLib.Datapath);
+    if (Segments >= DatapathMax) {
+        return 0;
+    }
+    return (uint16_t)Segments;
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 _Success_(return != FALSE)
 BOOLEAN
@@ -102,9 +137,11 @@ QuicPacketBuilderInitialize(
     Builder->PacketBatchSent = FALSE;
     Builder->PacketBatchRetransmittable = FALSE;
     Builder->WrittenConnectionCloseFrame = FALSE;
+    Builder->CoalescedSend = FALSE;
     Builder->Metadata = &Builder->MetadataStorage.Metadata;
     Builder->EncryptionOverhead = CXPLAT_ENCRYPTION_OVERHEAD;
     Builder->TotalDatagramsLength = 0;
+    Builder->FlushBudgetUs = 0;
 
     if (Connection->SourceCids.Next == NULL) {
         QuicTraceLogConnWarning(
@@ -122,9 +159,31 @@ QuicPacketBuilderInitialize(
 
     uint64_t TimeNow = CxPlatTimeUs64();
     uint64_t TimeSinceLastSend;
+    Builder->PacingInterval = 0;
     if (Connection->Send.LastFlushTimeValid) {
         TimeSinceLastSend =
             CxPlatTimeDiff64(Connection->Send.LastFlushTime, TimeNow);
+        if (Connection->Settings.PacingEnabled &&
+            Path->GotFirstRttSample &&
+            Path->SmoothedRtt >= QUIC_MIN_PACING_RTT &&
+            (CxPlatDataPathGetSupportedFeatures(MsQuicLib.Datapath) & CXPLAT_DATAPATH_FEATURE_SEND_TXTIME)) {
+            //
+            // The datapath can hold packets until their departure time, so
+            // grant the allowance up to the offload horizon now and stamp
+            // each batch with when it should actually go out. Only the time
+            // not already granted by a previous flush is counted.
+            //
+            uint64_t PacingStartTime = Connection->Send.LastFlushTime;
+            if (Connection->Send.PacingOffloadTime > PacingStartTime &&
+                Connection->Send.PacingOffloadTime <= TimeNow + QUIC_SEND_PACING_OFFLOAD_HORIZON) {
+                PacingStartTime = Connection->Send.PacingOffloadTime;
+            }
+            Connection->Send.PacingOffloadTime = TimeNow + QUIC_SEND_PACING_OFFLOAD_HORIZON;
+            TimeSinceLastSend =
+                CxPlatTimeDiff64(PacingStartTime, Connection->Send.PacingOffloadTime);
+            Builder->PacingStartTime = PacingStartTime;
+            Builder->PacingInterval = TimeSinceLastSend;
+        }
     } else {
         TimeSinceLastSend = 0;
     }
@@ -136,6 +195,8 @@ QuicPacketBuilderInitialize(
     if (Builder->SendAllowance > Path->Allowance) {
         Builder->SendAllowance = Path->Allowance;
     }
+    Builder->PacingAllowance = Builder->SendAllowance;
+    Builder->MaxBatchSegments = QuicPacketBuilderGetMaxBatchSegments(Connection, Path);
     Connection->Send.LastFlushTime = TimeNow;
     Connection->Send.LastFlushTimeValid = TRUE;
 
@@ -159,6 +220,60 @@ QuicPacketBuilderCleanup(
     CxPlatSecureZeroMemory(Builder->HpMask, sizeof(Builder->HpMask));
 }
 
+//
+// Calculates the departure time for a new batch, based on how much of the
+// flush's send allowance has already been used. Returns zero if the batch
+// should be sent immediately.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+uint64_t
+QuicPacketBuilderGetBatchTxTime(
+    _In_ const QUIC_PACKET_BUILDER* Builder
+    )
+{
+    if (Builder->PacingInterval == 0 || Builder->PacingAllowance == 0) {
+        return 0;
+    }
+
+    const uint64_t BytesUsed = Builder->PacingAllowance - Builder->SendAllowance;
+    const uint64_t TxTime =
+        Builder->PacingStartTime +
+        (BytesUsed * Builder->PacingInterval) / Builder->PacingAllowance;
+    return CxPlatTimeAtOrBefore64(TxTime, CxPlatTimeUs64()) ? 0 : TxTime;
+}
+
+static
+BOOLEAN
+QuicPacketBuilderIsInitialType(
+    _In_ const QUIC_CONNECTION* Connection,
+    _In_ uint8_t PacketType
+    )
+{
+    return
+        (Connection->Stats.QuicVersion == QUIC_VERSION_2 && PacketType == QUIC_INITIAL_V2) ||
+        (Connection->Stats.QuicVersion != QUIC_VERSION_2 && PacketType == QUIC_INITIAL_V1);
+}
+
+//
+// The length datagrams carrying Initial packets are padded to: the path's
+// MTU or, if we're limited by amplification protection, up to that limit.
+//
+static
+uint16_t
+QuicPacketBuilderInitialDatagramLength(
+    _In_ const QUIC_PACKET_BUILDER* Builder
+    )
+{
+    uint16_t Length =
+        MaxUdpPayloadSizeForFamily(
+            QuicAddrGetFamily(&Builder->Path->Route.RemoteAddress),
+            Builder->Path->Mtu);
+    if ((uint32_t)Length > Builder->Datagram->Length) {
+        Length = (uint16_t)Builder->Datagram->Length;
+    }
+    return Length;
+}
+
 //
 // This function makes sure the current send buffer and other related data is
 // prepared for writing the requested data. If there was already a QUIC packet
@@ -238,7 +353,7 @@ QuicPacketBuilderPrepare(
             QuicPacketBuilderFinalize(Builder, FlushDatagrams);
         }
         if (Builder->SendData == NULL &&
-            Builder->TotalCountDatagrams >= QUIC_MAX_DATAGRAMS_PER_SEND) {
+            QuicPacketBuilderIsFlushBudgetExhausted(Builder)) {
             goto Error;
         }
         NewQuicPacket = TRUE;
@@ -263,12 +378,45 @@ QuicPacketBuilderPrepare(
                     MaxUdpPayloadSizeForFamily(
                         QuicAddrGetFamily(&Builder->Path->Route.RemoteAddress),
                         DatagramSize),
-                Builder->EcnEctSet ? CXPLAT_ECN_ECT_0 : CXPLAT_ECN_NON_ECT,
-                Builder->Connection->Registration->ExecProfile == QUIC_EXECUTION_PROFILE_TYPE_MAX_THROUGHPUT ?
-                    CXPLAT_SEND_FLAGS_MAX_THROUGHPUT : CXPLAT_SEND_FLAGS_NONE
+                !Builder->EcnEctSet ?
+                    CXPLAT_ECN_NON_ECT :
+                    (Connection->CongestionControl.IsL4s ? CXPLAT_ECN_ECT_1 : CXPLAT_ECN_ECT_0),
+                (Builder->Connection->Registration->ExecProfile == QUIC_EXECUTION_PROFILE_TYPE_MAX_THROUGHPUT ?
+                    CXPLAT_SEND_FLAGS_MAX_THROUGHPUT : CXPLAT_SEND_FLAGS_NONE) |
+                //
+                // Workers on the shared worker pool run on the same threads
+                // as the datapath, so sends can be held until the end of
+                // the worker's loop and batched with other connections'.
+                //
+                (Builder->Connection->Worker->IsExternal ?
+                    CXPLAT_SEND_FLAGS_DEFERRED : CXPLAT_SEND_FLAGS_NONE),
+                QuicPacketBuilderGetBatchTxTime(Builder),
+                IsPathMtuDiscovery ? 0 : Builder->MaxBatchSegments
             };
-            Builder->SendData =
-                CxPlatSendDataAlloc(Builder->Path->Binding->Socket, &SendConfig);
+            Builder->BatchTxTime = SendConfig.TxTime;
+            if (QuicConnIsClient(Connection) &&
+                Connection->State.ShareBinding &&
+                !IsPathMtuDiscovery &&
+                SendConfig.TxTime == 0) {
+                //
+                // Client connections sharing a binding (e.g. a pool of
+                // connections to the same server) are usually sending to the
+                // same remote, so append to the worker's shared batch to get
+                // them all out in one segmented send. The batch isn't this
+                // connection's alone, so its pacing doesn't limit the size.
+                //
+                SendConfig.MaxSegments = 0;
+                Builder->SendData =
+                    QuicWorkerAllocCoalescedSend(
+                        Connection->Worker,
+                        Builder->Path->Binding,
+                        &SendConfig);
+                Builder->CoalescedSend = Builder->SendData != NULL;
+            } else {
+                Builder->SendData =
+                    CxPlatSendDataAlloc(Builder->Path->Binding->Socket, &SendConfig);
+                SendDataAllocated = TRUE;
+            }
             if (Builder->SendData == NULL) {
                 QuicTraceEvent(
                     AllocFailure,
@@ -277,7 +425,6 @@ QuicPacketBuilderPrepare(
                     0);
                 goto Error;
             }
-            SendDataAllocated = TRUE;
         }
 
         uint16_t NewDatagramLength =
@@ -326,24 +473,16 @@ QuicPacketBuilderPrepare(
                 Builder->MinimumDatagramLength = NewDatagramLength;
             }
 
-        } else if ((Connection->Stats.QuicVersion == QUIC_VERSION_2 && NewPacketType == QUIC_INITIAL_V2) ||
-            (Connection->Stats.QuicVersion != QUIC_VERSION_2 && NewPacketType == QUIC_INITIAL_V1)) {
+        } else if (QuicConnIsClient(Connection) &&
+            QuicPacketBuilderIsInitialType(Connection, NewPacketType)) {
 
             //
-            // Make sure to pad Initial packets.
+            // Clients must pad every datagram carrying an Initial packet. The
+            // space is filled with the next packets of the flight (0-RTT or
+            // Handshake) before any padding is added, in finalize. Servers
+            // only pad once an Initial packet turns out to be ack-eliciting.
             //
-            Builder->MinimumDatagramLength =
-                MaxUdpPayloadSizeForFamily(
-                    QuicAddrGetFamily(&Builder->Path->Route.RemoteAddress),
-                    Builder->Path->Mtu);
-
-            if ((uint32_t)Builder->MinimumDatagramLength > Builder->Datagram->Length) {
-                //
-                // On server, if we're limited by amplification protection, just
-                // pad up to that limit instead.
-                //
-                Builder->MinimumDatagramLength = (uint16_t)Builder->Datagram->Length;
-            }
+            Builder->MinimumDatagramLength = QuicPacketBuilderInitialDatagramLength(Builder);
 
         } else if (IsPathMtuDiscovery) {
             Builder->MinimumDatagramLength = NewDatagramLength;
@@ -661,14 +800,34 @@ QuicPacketBuilderFinalizeHeaderProtection(
     )
 {
     CXPLAT_DBG_ASSERT(Builder->Key != NULL);
+    QuicStageCyclesStart(EncryptStart);
 
     QUIC_STATUS Status;
+    if (QUIC_FAILED(
+        Status =
+        CxPlatEncryptBatch(
+            Builder->Key->PacketKey,
+            Builder->BatchCount,
+            Builder->CryptBatch))) {
+        QuicConnFatalError(Builder->Connection, Status, "Encryption failure");
+        return;
+    }
+
+    uint8_t CipherBatch[CXPLAT_HP_SAMPLE_LENGTH * QUIC_MAX_CRYPTO_BATCH_COUNT];
+    for (uint8_t i = 0; i < Builder->BatchCount; ++i) {
+        uint8_t* PnStart = Builder->CryptBatch[i].Buffer - Builder->PacketNumberLength;
+        CxPlatCopyMemory(
+            CipherBatch + i * CXPLAT_HP_SAMPLE_LENGTH,
+            PnStart + 4,
+            CXPLAT_HP_SAMPLE_LENGTH);
+    }
+
     if (QUIC_FAILED(
         Status =
         CxPlatHpComputeMask(
             Builder->Key->HeaderKey,
             Builder->BatchCount,
-            Builder->CipherBatch,
+            CipherBatch,
             Builder->HpMask))) {
         CXPLAT_TEL_ASSERT(FALSE);
         QuicConnFatalError(Builder->Connection, Status, "HP failure");
@@ -677,7 +836,7 @@ QuicPacketBuilderFinalizeHeaderProtection(
 
     for (uint8_t i = 0; i < Builder->BatchCount; ++i) {
         uint16_t Offset = i * CXPLAT_HP_SAMPLE_LENGTH;
-        uint8_t* Header = Builder->HeaderBatch[i];
+        uint8_t* Header = Builder->CryptBatch[i].Buffer - Builder->CryptBatch[i].AuthDataLength;
         Header[0] ^= (Builder->HpMask[Offset] & 0x1f); // Bottom 5 bits for SH
         Header += 1 + Builder->Path->DestCid->CID.Length;
         for (uint8_t j = 0; j < Builder->PacketNumberLength; ++j) {
@@ -685,6 +844,7 @@ QuicPacketBuilderFinalizeHeaderProtection(
         }
     }
 
+    QuicStageCyclesEnd(QUIC_PERF_STAGE_ENCRYPT, EncryptStart, Builder->BatchCount);
     Builder->BatchCount = 0;
 }
 
@@ -745,6 +905,20 @@ QuicPacketBuilderFinalize(
     uint16_t ExpectedFinalDatagramLength =
         Builder->DatagramLength + Builder->EncryptionOverhead;
 
+    if (QuicConnIsServer(Connection) &&
+        Builder->Metadata->Flags.IsAckEliciting &&
+        QuicPacketBuilderIsInitialType(Connection, Builder->PacketType)) {
+        //
+        // Servers only need to pad datagrams carrying ack-eliciting Initial
+        // packets (RFC 9000, Section 14.1). ACK-only ones aren't, so they don't
+        // spend the amplification allowance on padding.
+        //
+        const uint16_t InitialDatagramLength = QuicPacketBuilderInitialDatagramLength(Builder);
+        if (Builder->MinimumDatagramLength < InitialDatagramLength) {
+            Builder->MinimumDatagramLength = InitialDatagramLength;
+        }
+    }
+
     if (FlushBatchedDatagrams ||
         Builder->PacketType == SEND_PACKET_SHORT_HEADER_TYPE ||
         (uint16_t)Builder->Datagram->Length - ExpectedFinalDatagramLength < QUIC_MIN_PACKET_SPARE_SPACE) {
@@ -837,51 +1011,63 @@ QuicPacketBuilderFinalize(
 
         uint8_t* Payload = Header + Builder->HeaderLength;
 
-        uint8_t Iv[CXPLAT_MAX_IV_LENGTH];
-        QuicCryptoCombineIvAndPacketNumber(Builder->Key->Iv, (uint8_t*) &Builder->Metadata->PacketNumber, Iv);
-
         QUIC_STATUS Status;
-        if (QUIC_FAILED(
-            Status =
-            CxPlatEncrypt(
-                Builder->Key->PacketKey,
-                Iv,
-                Builder->HeaderLength,
-                Header,
-                PayloadLength,
-                Payload))) {
-            QuicConnFatalError(Connection, Status, "Encryption failure");
-            goto Exit;
-        }
+        if (Connection->State.HeaderProtectionEnabled &&
+            Builder->PacketType == SEND_PACKET_SHORT_HEADER_TYPE) {
+            CXPLAT_DBG_ASSERT(Builder->BatchCount < QUIC_MAX_CRYPTO_BATCH_COUNT);
 
-        QuicTraceEvent(
-            PacketFinalize,
-            "[pack][%llu] Finalizing",
-            Builder->Metadata->PacketId);
+            //
+            // Batch both the payload encryption and the header protection for
+            // short header packets. Both are completed together in
+            // QuicPacketBuilderFinalizeHeaderProtection.
+            //
 
-        if (Connection->State.HeaderProtectionEnabled) {
+            CXPLAT_CRYPT_BATCH_ENTRY* Entry = &Builder->CryptBatch[Builder->BatchCount];
+            QuicCryptoCombineIvAndPacketNumber(Builder->Key->Iv, (uint8_t*) &Builder->Metadata->PacketNumber, Entry->Iv);
+            Entry->AuthData = Header;
+            Entry->AuthDataLength = Builder->HeaderLength;
+            Entry->Buffer = Payload;
+            Entry->BufferLength = PayloadLength;
 
-            uint8_t* PnStart = Payload - Builder->PacketNumberLength;
+            QuicTraceEvent(
+                PacketFinalize,
+                "[pack][%llu] Finalizing",
+                Builder->Metadata->PacketId);
 
-            if (Builder->PacketType == SEND_PACKET_SHORT_HEADER_TYPE) {
-                CXPLAT_DBG_ASSERT(Builder->BatchCount < QUIC_MAX_CRYPTO_BATCH_COUNT);
+            if (++Builder->BatchCount == QUIC_MAX_CRYPTO_BATCH_COUNT) {
+                QuicPacketBuilderFinalizeHeaderProtection(Builder);
+            }
 
-                //
-                // Batch the header protection for short header packets.
-                //
+        } else {
 
-                CxPlatCopyMemory(
-                    Builder->CipherBatch + Builder->BatchCount * CXPLAT_HP_SAMPLE_LENGTH,
-                    PnStart + 4,
-                    CXPLAT_HP_SAMPLE_LENGTH);
-                Builder->HeaderBatch[Builder->BatchCount] = Header;
+            QuicStageCyclesStart(EncryptStart);
+            uint8_t Iv[CXPLAT_MAX_IV_LENGTH];
+            QuicCryptoCombineIvAndPacketNumber(Builder->Key->Iv, (uint8_t*) &Builder->Metadata->PacketNumber, Iv);
+
+            if (QUIC_FAILED(
+                Status =
+                CxPlatEncrypt(
+                    Builder->Key->PacketKey,
+                    Iv,
+                    Builder->HeaderLength,
+                    Header,
+                    PayloadLength,
+                    Payload))) {
+                QuicConnFatalError(Connection, Status, "Encryption failure");
+                goto Exit;
+            }
 
-                if (++Builder->BatchCount == QUIC_MAX_CRYPTO_BATCH_COUNT) {
-                    QuicPacketBuilderFinalizeHeaderProtection(Builder);
-                }
+            QuicTraceEvent(
+                PacketFinalize,
+                "[pack][%llu] Finalizing",
+                Builder->Metadata->PacketId);
+
+            if (Connection->State.HeaderProtectionEnabled) {
+
+                uint8_t* PnStart = Payload - Builder->PacketNumberLength;
 
-            } else {
                 CXPLAT_DBG_ASSERT(Builder->BatchCount == 0);
+                CXPLAT_DBG_ASSERT(Builder->PacketType != SEND_PACKET_SHORT_HEADER_TYPE);
 
                 //
                 // Individually do header protection for long header packets as
@@ -905,6 +1091,7 @@ QuicPacketBuilderFinalize(
                     PnStart[i] ^= Builder->HpMask[1 + i];
                 }
             }
+            QuicStageCyclesEnd(QUIC_PERF_STAGE_ENCRYPT, EncryptStart, 1);
         }
 
         //
@@ -935,6 +1122,14 @@ QuicPacketBuilderFinalize(
                 goto Exit;
             }
 
+            //
+            // Any batched packets must be encrypted with the old key before
+            // the switch.
+            //
+            if (Builder->BatchCount != 0) {
+                QuicPacketBuilderFinalizeHeaderProtection(Builder);
+            }
+
             QuicCryptoUpdateKeyPhase(Connection, TRUE);
 
             //
@@ -959,7 +1154,15 @@ QuicPacketBuilderFinalize(
     //
     CXPLAT_DBG_ASSERT(Builder->Metadata->FrameCount != 0);
 
-    Builder->Metadata->SentTime = CxPlatTimeUs64();
+    //
+    // A batch held by the datapath until its departure time doesn't actually
+    // leave until then, so use that as the sent time. Otherwise, the RTT
+    // samples would include the time spent waiting to be paced out.
+    //
+    const uint64_t TimeNow = CxPlatTimeUs64();
+    Builder->Metadata->SentTime =
+        CxPlatTimeAtOrBefore64(Builder->BatchTxTime, TimeNow) ?
+            TimeNow : Builder->BatchTxTime;
     Builder->Metadata->PacketLength =
         Builder->HeaderLength + PayloadLength;
     Builder->Metadata->Flags.EcnEctSet = Builder->EcnEctSet;
@@ -970,6 +1173,19 @@ QuicPacketBuilderFinalize(
         Builder->Metadata->PacketNumber,
         QuicPacketTraceType(Builder->Metadata),
         Builder->Metadata->PacketLength);
+    QuicConnQlog(
+        Connection,
+        QUIC_QLOG_EVENT_PACKET_SENT,
+        QuicPacketTraceType(Builder->Metadata),
+        Builder->Metadata->PacketNumber,
+        Builder->Metadata->PacketLength,
+        0);
+    QuicUsdtProbe(
+        packet_sent,
+        Connection,
+        Builder->Metadata->PacketNumber,
+        QuicPacketTraceType(Builder->Metadata),
+        Builder->Metadata->PacketLength);
     QuicLossDetectionOnPacketSent(
         &Connection->LossDetection,
         Builder->Path,
@@ -1001,6 +1217,23 @@ Exit:
             if (Builder->Metadata->Flags.EcnEctSet) {
                 ++Connection->Send.NumPacketsSentWithEct;
             }
+            if (QuicConnPacketCaptureSample(Connection)) {
+                //
+                // The datagram is captured as it goes on the wire, so finish
+                // encrypting the batch early.
+                //
+                if (Builder->BatchCount != 0) {
+                    QuicPacketBuilderFinalizeHeaderProtection(Builder);
+                }
+                QuicCaptureWriteDatagram(
+                    &Connection->Worker->CaptureBuffer,
+                    Connection->CaptureSecrets,
+                    TRUE,
+                    &Builder->Path->Route.LocalAddress,
+                    &Builder->Path->Route.RemoteAddress,
+                    Builder->Datagram->Buffer,
+                    (uint16_t)Builder->DatagramLength);
+            }
             Builder->Datagram->Length = Builder->DatagramLength;
             Builder->Datagram = NULL;
             ++Builder->TotalCountDatagrams;
@@ -1037,7 +1270,11 @@ Exit:
             Builder->Datagram = NULL;
             Builder->DatagramLength = 0;
         }
-        if (Builder->SendData != NULL) {
+        if (Builder->CoalescedSend) {
+            QuicWorkerReleaseCoalescedSend(Builder->Connection->Worker, 0, 0);
+            Builder->CoalescedSend = FALSE;
+            Builder->SendData = NULL;
+        } else if (Builder->SendData != NULL) {
             CxPlatSendDataFree(Builder->SendData);
             Builder->SendData = NULL;
         }
@@ -1062,12 +1299,20 @@ QuicPacketBuilderSendBatch(
         "Sending batch. %hu datagrams",
         (uint16_t)Builder->TotalCountDatagrams);
 
-    QuicBindingSend(
-        Builder->Path->Binding,
-        &Builder->Path->Route,
-        Builder->SendData,
-        Builder->TotalDatagramsLength,
-        Builder->TotalCountDatagrams);
+    if (Builder->CoalescedSend) {
+        QuicWorkerReleaseCoalescedSend(
+            Builder->Connection->Worker,
+            Builder->TotalDatagramsLength,
+            Builder->TotalCountDatagrams);
+        Builder->CoalescedSend = FALSE;
+    } else {
+        QuicBindingSend(
+            Builder->Path->Binding,
+            &Builder->Path->Route,
+            Builder->SendData,
+            Builder->TotalDatagramsLength,
+            Builder->TotalCountDatagrams);
+    }
 
     Builder->PacketBatchSent = TRUE;
     Builder->SendData = NULL;
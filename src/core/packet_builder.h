@@ -42,9 +42,10 @@ typedef struct QUIC_PACKET_BUILDER {
     QUIC_PACKET_KEY* Key;
 
     //
-    // Cipher text across multiple packets to batch header protection.
+    // Short header packets whose payload encryption is batched along with
+    // header protection.
     //
-    uint8_t CipherBatch[CXPLAT_HP_SAMPLE_LENGTH * QUIC_MAX_CRYPTO_BATCH_COUNT];
+    CXPLAT_CRYPT_BATCH_ENTRY CryptBatch[QUIC_MAX_CRYPTO_BATCH_COUNT];
 
     //
     // Output header protection mask.
@@ -52,11 +53,6 @@ typedef struct QUIC_PACKET_BUILDER {
     uint8_t HpMask[CXPLAT_HP_SAMPLE_LENGTH * QUIC_MAX_CRYPTO_BATCH_COUNT];
 
 
-    //
-    // Headers that need to be batched.
-    //
-    uint8_t* HeaderBatch[QUIC_MAX_CRYPTO_BATCH_COUNT];
-
     //
     // Indicates a batch of packets has been sent.
     //
@@ -83,6 +79,12 @@ typedef struct QUIC_PACKET_BUILDER {
     //
     uint8_t WrittenConnectionCloseFrame : 1;
 
+    //
+    // Indicates SendData is the worker's coalesced send batch, shared with
+    // other connections on the same binding and remote address.
+    //
+    uint8_t CoalescedSend : 1;
+
     //
     // The total number of datagrams that have been created.
     //
@@ -146,8 +148,37 @@ typedef struct QUIC_PACKET_BUILDER {
     //
     uint32_t SendAllowance;
 
+    //
+    // When pacing is offloaded to the datapath, the send allowance granted
+    // for this flush and the time interval it is spread over. The interval
+    // is zero when not offloading.
+    //
+    uint32_t PacingAllowance;
+    uint64_t PacingStartTime;
+    uint64_t PacingInterval;
+
+    //
+    // The departure time the current send batch was stamped with, or zero if
+    // it is sent immediately.
+    //
+    uint64_t BatchTxTime;
+
+    //
+    // The maximum number of datagrams in each send batch of this flush, or
+    // zero for the datapath's limit. See QUIC_SEND_BATCH_RTT_DIVISOR.
+    //
+    uint16_t MaxBatchSegments;
+
     uint64_t BatchId;
 
+    //
+    // The time the current send flush started and its time budget. When the
+    // budget is zero, the flush is limited by QUIC_MAX_DATAGRAMS_PER_SEND
+    // instead.
+    //
+    uint64_t FlushStartTime;
+    uint32_t FlushBudgetUs;
+
     //
     // Represents the metadata of the current QUIC packet.
     //
@@ -172,6 +203,27 @@ QuicPacketBuilderInitialize(
     _In_ QUIC_PATH* Path
     );
 
+//
+// Returns TRUE if the send flush using the builder has used up its budget and
+// shouldn't start any new datagrams.
+//
+inline
+BOOLEAN
+QuicPacketBuilderIsFlushBudgetExhausted(
+    _In_ const QUIC_PACKET_BUILDER* Builder
+    )
+{
+    if (Builder->TotalCountDatagrams >= QUIC_MAX_DATAGRAMS_PER_FLUSH) {
+        return TRUE;
+    }
+    if (Builder->FlushBudgetUs == 0) {
+        return Builder->TotalCountDatagrams >= QUIC_MAX_DATAGRAMS_PER_SEND;
+    }
+    return
+        Builder->TotalCountDatagrams != 0 &&
+        CxPlatTimeDiff64(Builder->FlushStartTime, CxPlatTimeUs64()) >= Builder->FlushBudgetUs;
+}
+
 //
 // Cleans up any leftover data still buffered for send.
 //
@@ -23,7 +23,10 @@ QuicPacketSpaceInitialize(
     _Out_ QUIC_PACKET_SPACE** NewPackets
     )
 {
-    QUIC_PACKET_SPACE* Packets = CxPlatPoolAlloc(&QuicLibraryGetPerProc()->PacketSpacePool);
+    QUIC_LIBRARY_PP* PerProc =
+        QuicLibraryGetPartitionPerProc(QuicPartitionIdGetIndex(Connection->PartitionID));
+    QUIC_PACKET_SPACE* Packets =
+        QuicObjectReserveAlloc(&PerProc->PacketSpaceReserve, &PerProc->PacketSpacePool);
     if (Packets == NULL) {
         QuicTraceEvent(
             AllocFailure,
@@ -36,6 +39,7 @@ QuicPacketSpaceInitialize(
     CxPlatZeroMemory(Packets, sizeof(QUIC_PACKET_SPACE));
     Packets->Connection = Connection;
     Packets->EncryptLevel = EncryptLevel;
+    Packets->DeferredPacketsTail = &Packets->DeferredPackets;
     QuicAckTrackerInitialize(&Packets->AckTracker);
 
     *NewPackets = Packets;
@@ -61,7 +65,9 @@ QuicPacketSpaceUninitialize(
     }
 
     QuicAckTrackerUninitialize(&Packets->AckTracker);
-    CxPlatPoolFree(&QuicLibraryGetPerProc()->PacketSpacePool, Packets);
+    QUIC_LIBRARY_PP* PerProc =
+        QuicLibraryGetPartitionPerProc(QuicPartitionIdGetIndex(Packets->Connection->PartitionID));
+    QuicObjectReserveFree(&PerProc->PacketSpaceReserve, &PerProc->PacketSpacePool, Packets);
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -77,6 +77,7 @@ typedef struct QUIC_PACKET_SPACE {
     // List of received packets that we don't have the key for yet.
     //
     QUIC_RX_PACKET* DeferredPackets;
+    QUIC_RX_PACKET** DeferredPacketsTail;
 
     //
     // Information related to packets that have been received and need to be
@@ -47,6 +47,28 @@ QuicPathInitialize(
         Path->ID);
 }
 
+//
+// Finds the standby path state for the path ID, if any.
+//
+static
+QUIC_STANDBY_PATH*
+QuicConnGetStandbyPath(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ uint8_t PathId
+    )
+{
+    if (Connection->StandbyPaths == NULL) {
+        return NULL;
+    }
+    for (uint8_t i = 0; i < QUIC_MAX_STANDBY_PATHS; ++i) {
+        QUIC_STANDBY_PATH* Entry = &Connection->StandbyPaths->Paths[i];
+        if (Entry->InUse && Entry->PathId == PathId) {
+            return Entry;
+        }
+    }
+    return NULL;
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicPathRemove(
@@ -69,6 +91,21 @@ QuicPathRemove(
         "Path[%hhu] Removed",
         Path->ID);
 
+    if (Path->IsStandby) {
+        //
+        // Standby paths own their binding and CID.
+        //
+        QUIC_STANDBY_PATH* Entry = QuicConnGetStandbyPath(Connection, Path->ID);
+        if (Entry != NULL) {
+            Entry->InUse = FALSE;
+        }
+        QuicBindingRemoveStandbyConnection(Path->Binding, Connection);
+        QuicLibraryReleaseBinding(Path->Binding);
+        if (Path->DestCid->CID.Length != 0) {
+            QuicConnRetireCid(Connection, Path->DestCid);
+        }
+    }
+
 #if DEBUG
     if (Path->DestCid) {
         QUIC_CID_CLEAR_PATH(Path->DestCid);
@@ -305,6 +342,388 @@ QuicPathSetActive(
     CXPLAT_DBG_ASSERT(!Path->DestCid->CID.Retired);
 }
 
+//
+// Returns TRUE if the address has the same IP as one of the configured
+// standby local addresses. The port isn't compared, since the configured ones
+// usually leave it for the binding to pick.
+//
+static
+BOOLEAN
+QuicStandbyPathsHasAddress(
+    _In_ const QUIC_STANDBY_PATHS* Config,
+    _In_ const QUIC_ADDR* Address
+    )
+{
+    for (uint32_t i = 0; i < Config->LocalAddressCount; ++i) {
+        if (QuicAddrGetFamily(&Config->LocalAddresses[i]) == QuicAddrGetFamily(Address) &&
+            QuicAddrCompareIp(&Config->LocalAddresses[i], Address)) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+//
+// Adds a standby path from the local address to the active path's remote
+// address, on its own binding, and queues its validation. Returns TRUE if the
+// path was added.
+//
+static
+BOOLEAN
+QuicConnAddStandbyPath(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ const QUIC_ADDR* LocalAddress
+    )
+{
+    QUIC_STANDBY_PATH_SET* Set = Connection->StandbyPaths;
+    QUIC_PATH* ActivePath = &Connection->Paths[0];
+    CXPLAT_DBG_ASSERT(Connection->PathsCount < QUIC_MAX_PATH_COUNT);
+
+    if (QuicAddrGetFamily(LocalAddress) !=
+        QuicAddrGetFamily(&ActivePath->Route.RemoteAddress)) {
+        return FALSE; // Can't reach the peer from this address.
+    }
+
+    QUIC_STANDBY_PATH* Entry = NULL;
+    for (uint8_t i = 0; i < QUIC_MAX_STANDBY_PATHS; ++i) {
+        if (!Set->Paths[i].InUse) {
+            Entry = &Set->Paths[i];
+            break;
+        }
+    }
+    if (Entry == NULL) {
+        return FALSE;
+    }
+
+    QUIC_CID_LIST_ENTRY* DestCid;
+    if (ActivePath->DestCid->CID.Length == 0) {
+        DestCid = ActivePath->DestCid;
+    } else {
+        //
+        // Each path needs its own CID so that the peer can't link them.
+        //
+        DestCid = QuicConnGetUnusedDestCid(Connection);
+        if (DestCid == NULL) {
+            QuicTraceLogConnWarning(
+                NoCidForStandbyPath,
+                Connection,
+                "No unused CID for standby path");
+            return FALSE;
+        }
+    }
+
+    //
+    // The binding is always exclusive, since it only delivers packets to this
+    // connection.
+    //
+    CXPLAT_UDP_CONFIG UdpConfig = {0};
+    UdpConfig.LocalAddress = LocalAddress;
+    UdpConfig.RemoteAddress = &ActivePath->Route.RemoteAddress;
+    UdpConfig.Flags = 0;
+    UdpConfig.InterfaceIndex = 0;
+    UdpConfig.PartitionIndex = QuicPartitionIdGetIndex(Connection->PartitionID);
+#ifdef QUIC_COMPARTMENT_ID
+    UdpConfig.CompartmentId = Connection->Configuration->CompartmentId;
+#endif
+#ifdef QUIC_OWNING_PROCESS
+    UdpConfig.OwningProcess = Connection->Configuration->OwningProcess;
+#endif
+    QUIC_BINDING* Binding;
+    QUIC_STATUS Status = QuicLibraryGetBinding(&UdpConfig, &Binding);
+    if (QUIC_FAILED(Status)) {
+        QuicTraceEvent(
+            ConnErrorStatus,
+            "[conn][%p] ERROR, %u, %s.",
+            Connection,
+            Status,
+            "Get binding for standby path");
+        return FALSE;
+    }
+
+    if (!QuicBindingAddStandbyConnection(Binding, Connection)) {
+        QuicTraceEvent(
+            ConnError,
+            "[conn][%p] ERROR, %s.",
+            Connection,
+            "Standby path binding already in use");
+        QuicLibraryReleaseBinding(Binding);
+        return FALSE;
+    }
+
+    QUIC_PATH* Path = &Connection->Paths[Connection->PathsCount];
+    QuicPathInitialize(Connection, Path);
+    Connection->PathsCount++;
+
+    Path->IsStandby = TRUE;
+    Path->Binding = Binding;
+    Path->DestCid = DestCid;
+    if (DestCid->CID.Length != 0) {
+        QUIC_CID_SET_PATH(Connection, DestCid, Path);
+        DestCid->CID.UsedLocally = TRUE;
+    }
+    Path->Route.RemoteAddress = ActivePath->Route.RemoteAddress;
+    Path->Route.State = RouteUnresolved;
+    QuicBindingGetLocalAddress(Binding, &Path->Route.LocalAddress);
+    Path->Allowance = UINT32_MAX; // Clients aren't amplification limited.
+    QuicPathValidate(Path);
+
+    Path->SendChallenge = TRUE;
+    Path->PathValidationStartTime = CxPlatTimeUs64();
+    CxPlatRandom(sizeof(Path->Challenge), Path->Challenge);
+
+    Entry->InUse = TRUE;
+    Entry->PathId = Path->ID;
+    Entry->UnansweredProbes = 1;
+    Entry->LossRate = 0;
+    Entry->ProbeSentTime = Path->PathValidationStartTime;
+
+    QuicTraceLogConnInfo(
+        StandbyPathAdded,
+        Connection,
+        "Path[%hhu] Standby from %!ADDR!",
+        Path->ID,
+        CASTED_CLOG_BYTEARRAY(sizeof(Path->Route.LocalAddress), &Path->Route.LocalAddress));
+
+    return TRUE;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnUpdateStandbyPaths(
+    _In_ QUIC_CONNECTION* Connection
+    )
+{
+    QUIC_STANDBY_PATH_SET* Set = Connection->StandbyPaths;
+    if (Set == NULL ||
+        !Connection->State.HandshakeConfirmed ||
+        Connection->State.ClosedLocally || Connection->State.ClosedRemotely) {
+        return;
+    }
+
+    const BOOLEAN Allowed =
+        Connection->Settings.MigrationEnabled &&
+        !(Connection->PeerTransportParams.Flags & QUIC_TP_FLAG_DISABLE_ACTIVE_MIGRATION);
+
+    //
+    // Drop the standby paths that are no longer configured, or are to a
+    // different peer address than the active path now uses.
+    //
+    for (uint8_t i = Connection->PathsCount - 1; i > 0; i--) {
+        const QUIC_PATH* Path = &Connection->Paths[i];
+        if (Path->IsStandby &&
+            (!Allowed ||
+             !QuicStandbyPathsHasAddress(&Set->Config, &Path->Route.LocalAddress) ||
+             !QuicAddrCompare(&Path->Route.RemoteAddress, &Connection->Paths[0].Route.RemoteAddress))) {
+            QuicPathRemove(Connection, i);
+        }
+    }
+
+    uint8_t ProbeCount = 0;
+    if (Allowed) {
+        for (uint32_t i = 0; i < Set->Config.LocalAddressCount; ++i) {
+            const QUIC_ADDR* LocalAddress = &Set->Config.LocalAddresses[i];
+            BOOLEAN Found = FALSE;
+            for (uint8_t j = 0; j < Connection->PathsCount; ++j) {
+                if (QuicAddrGetFamily(&Connection->Paths[j].Route.LocalAddress) == QuicAddrGetFamily(LocalAddress) &&
+                    QuicAddrCompareIp(&Connection->Paths[j].Route.LocalAddress, LocalAddress)) {
+                    Found = TRUE;
+                    break;
+                }
+            }
+            if (Found) {
+                continue;
+            }
+            if (Connection->PathsCount == QUIC_MAX_PATH_COUNT) {
+                break;
+            }
+            if (QuicConnAddStandbyPath(Connection, LocalAddress)) {
+                ProbeCount++;
+            }
+        }
+    }
+
+    //
+    // Probe the validated paths, unless the connection has been idle since
+    // the last round (nothing sent but the probes themselves).
+    //
+    const BOOLEAN AppActive =
+        Connection->Stats.Send.RetransmittablePackets - Set->LastSendCount >
+            Set->LastProbeCount;
+    const uint64_t TimeNow = CxPlatTimeUs64();
+    for (uint8_t i = 0; i < QUIC_MAX_STANDBY_PATHS; ++i) {
+        QUIC_STANDBY_PATH* Entry = &Set->Paths[i];
+        if (!Entry->InUse) {
+            continue;
+        }
+        uint8_t PathIndex;
+        QUIC_PATH* Path = QuicConnGetPathByID(Connection, Entry->PathId, &PathIndex);
+        CXPLAT_DBG_ASSERT(Path != NULL);
+        if (Path == NULL || !Path->IsPeerValidated || Path->SendChallenge || !AppActive) {
+            continue;
+        }
+
+        if (Entry->UnansweredProbes != 0) {
+            Entry->LossRate = (uint16_t)(Entry->LossRate - Entry->LossRate / 8 + 125);
+        }
+        if (Entry->UnansweredProbes != UINT8_MAX) {
+            Entry->UnansweredProbes++;
+        }
+        CxPlatRandom(sizeof(Path->Challenge), Path->Challenge);
+        Path->SendChallenge = TRUE;
+        Entry->ProbeSentTime = TimeNow;
+        ProbeCount++;
+    }
+
+    if (ProbeCount != 0) {
+        QuicSendSetSendFlag(&Connection->Send, QUIC_CONN_SEND_FLAG_PATH_CHALLENGE);
+    }
+    Set->LastSendCount = Connection->Stats.Send.RetransmittablePackets;
+    Set->LastProbeCount = ProbeCount;
+
+    if (Set->Config.LocalAddressCount != 0 && Allowed) {
+        QuicConnTimerSet(
+            Connection,
+            QUIC_CONN_TIMER_STANDBY_PROBE,
+            MS_TO_US(
+                (uint64_t)(Set->Config.ProbeIntervalMs != 0 ?
+                    Set->Config.ProbeIntervalMs : QUIC_DEFAULT_STANDBY_PROBE_INTERVAL_MS)));
+    } else {
+        QuicConnTimerCancel(Connection, QUIC_CONN_TIMER_STANDBY_PROBE);
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnOnStandbyPathResponse(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ QUIC_PATH* Path
+    )
+{
+    QUIC_STANDBY_PATH* Entry = QuicConnGetStandbyPath(Connection, Path->ID);
+    if (Entry == NULL || Entry->UnansweredProbes == 0) {
+        return;
+    }
+
+    //
+    // The sample only updates the path's own estimate, which becomes the
+    // connection's if it's failed over to.
+    //
+    uint64_t LatestRtt = CxPlatTimeDiff64(Entry->ProbeSentTime, CxPlatTimeUs64());
+    if (LatestRtt == 0) {
+        LatestRtt = 1;
+    }
+    Path->LatestRttSample = LatestRtt;
+    if (LatestRtt < Path->MinRtt) {
+        Path->MinRtt = LatestRtt;
+    }
+    if (LatestRtt > Path->MaxRtt) {
+        Path->MaxRtt = LatestRtt;
+    }
+    if (!Path->GotFirstRttSample) {
+        Path->GotFirstRttSample = TRUE;
+        Path->SmoothedRtt = LatestRtt;
+        Path->RttVariance = LatestRtt / 2;
+    } else {
+        if (Path->SmoothedRtt > LatestRtt) {
+            Path->RttVariance = (3 * Path->RttVariance + Path->SmoothedRtt - LatestRtt) / 4;
+        } else {
+            Path->RttVariance = (3 * Path->RttVariance + LatestRtt - Path->SmoothedRtt) / 4;
+        }
+        Path->SmoothedRtt = (7 * Path->SmoothedRtt + LatestRtt) / 8;
+    }
+
+    Entry->UnansweredProbes = 0;
+    Entry->LossRate -= Entry->LossRate / 8;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+QuicConnFailoverToStandbyPath(
+    _In_ QUIC_CONNECTION* Connection
+    )
+{
+    QUIC_STANDBY_PATH_SET* Set = Connection->StandbyPaths;
+    if (Set == NULL || Connection->State.ClosedLocally || Connection->State.ClosedRemotely) {
+        return FALSE;
+    }
+
+    //
+    // Pick the validated path answering its probes with the least loss, then
+    // the lowest RTT.
+    //
+    QUIC_STANDBY_PATH* Best = NULL;
+    QUIC_PATH* BestPath = NULL;
+    for (uint8_t i = 0; i < QUIC_MAX_STANDBY_PATHS; ++i) {
+        QUIC_STANDBY_PATH* Entry = &Set->Paths[i];
+        if (!Entry->InUse || Entry->UnansweredProbes > 1) {
+            continue;
+        }
+        uint8_t PathIndex;
+        QUIC_PATH* Path = QuicConnGetPathByID(Connection, Entry->PathId, &PathIndex);
+        if (Path == NULL || !Path->IsPeerValidated) {
+            continue;
+        }
+        if (Best == NULL ||
+            Entry->LossRate < Best->LossRate ||
+            (Entry->LossRate == Best->LossRate && Path->SmoothedRtt < BestPath->SmoothedRtt)) {
+            Best = Entry;
+            BestPath = Path;
+        }
+    }
+    if (Best == NULL) {
+        return FALSE;
+    }
+
+    QUIC_BINDING* OldBinding = Connection->Paths[0].Binding;
+    const uint8_t OldPathId = Connection->Paths[0].ID;
+    const uint8_t NewPathId = BestPath->ID;
+
+    QuicBindingRemoveStandbyConnection(BestPath->Binding, Connection);
+    QuicBindingMoveSourceConnectionIDs(OldBinding, BestPath->Binding, Connection);
+    Best->InUse = FALSE;
+    BestPath->IsStandby = FALSE;
+
+    QuicPathSetActive(Connection, BestPath);
+
+    //
+    // The old active path is where the standby one was. It's presumed dead,
+    // so drop it along with its binding and CID.
+    //
+    uint8_t OldPathIndex;
+    QUIC_PATH* OldPath = QuicConnGetPathByID(Connection, OldPathId, &OldPathIndex);
+    CXPLAT_DBG_ASSERT(OldPath != NULL);
+    if (OldPath->DestCid->CID.Length != 0) {
+        QuicConnRetireCid(Connection, OldPath->DestCid);
+    }
+    QuicPathRemove(Connection, OldPathIndex);
+    QuicLibraryReleaseBinding(OldBinding);
+
+    QuicTraceLogConnInfo(
+        StandbyPathFailover,
+        Connection,
+        "Failed over from Path[%hhu] to standby Path[%hhu]",
+        OldPathId,
+        NewPathId);
+
+    QuicLossDetectionOnActivePathChanged(&Connection->LossDetection);
+    QuicSendSetSendFlag(&Connection->Send, QUIC_CONN_SEND_FLAG_PING);
+
+    return TRUE;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnRemoveStandbyPaths(
+    _In_ QUIC_CONNECTION* Connection
+    )
+{
+    for (uint8_t i = Connection->PathsCount - 1; i > 0; i--) {
+        if (Connection->Paths[i].IsStandby) {
+            QuicPathRemove(Connection, i);
+        }
+    }
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicPathUpdateQeo(
@@ -356,6 +775,20 @@ QuicPathUpdateQeo(
                 Connection,
                 "Path[%hhu] QEO enabled",
                 Path->ID);
+        } else if (Path->EncryptionOffloading) {
+            //
+            // The offload couldn't take the new keys (after a key update), so
+            // fall back to doing the crypto in software.
+            //
+            Offloads[0].Operation = CXPLAT_QEO_OPERATION_REMOVE;
+            Offloads[1].Operation = CXPLAT_QEO_OPERATION_REMOVE;
+            (void)CxPlatSocketUpdateQeo(Path->Binding->Socket, Offloads, 2);
+            Path->EncryptionOffloading = FALSE;
+            QuicTraceLogConnInfo(
+                PathQeoDisabled,
+                Connection,
+                "Path[%hhu] QEO disabled",
+                Path->ID);
         }
         CxPlatSecureZeroMemory(Offloads, sizeof(Offloads));
     } else {
@@ -369,3 +802,137 @@ QuicPathUpdateQeo(
             Path->ID);
     }
 }
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicPathMetricsCacheInitialize(
+    _Out_ QUIC_PATH_METRICS_CACHE* Cache
+    )
+{
+    CxPlatZeroMemory(Cache, sizeof(*Cache));
+    for (uint32_t i = 0; i < QUIC_PATH_METRICS_CACHE_SETS; ++i) {
+        CxPlatDispatchLockInitialize(&Cache->Sets[i].Lock);
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicPathMetricsCacheUninitialize(
+    _In_ QUIC_PATH_METRICS_CACHE* Cache
+    )
+{
+    for (uint32_t i = 0; i < QUIC_PATH_METRICS_CACHE_SETS; ++i) {
+        CxPlatDispatchLockUninitialize(&Cache->Sets[i].Lock);
+    }
+}
+
+static
+QUIC_PATH_METRICS_CACHE_SET*
+QuicPathMetricsCacheGetSet(
+    _In_ QUIC_PATH_METRICS_CACHE* Cache,
+    _In_ const QUIC_ADDR* RemoteAddress
+    )
+{
+    //
+    // The cache is keyed by remote IP only, since none of the metrics depend
+    // on the port.
+    //
+    QUIC_ADDR Address = *RemoteAddress;
+    QuicAddrSetPort(&Address, 0);
+    return &Cache->Sets[QuicAddrHash(&Address) % QUIC_PATH_METRICS_CACHE_SETS];
+}
+
+static
+BOOLEAN
+QuicPathMetricsCacheEntryMatches(
+    _In_ const QUIC_PATH_METRICS_CACHE_ENTRY* Entry,
+    _In_ const QUIC_ADDR* RemoteAddress
+    )
+{
+    return
+        Entry->TimeUs != 0 &&
+        QuicAddrGetFamily(&Entry->RemoteAddress) == QuicAddrGetFamily(RemoteAddress) &&
+        QuicAddrCompareIp(&Entry->RemoteAddress, RemoteAddress);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Success_(return != FALSE)
+BOOLEAN
+QuicPathMetricsCacheLookup(
+    _In_ QUIC_PATH_METRICS_CACHE* Cache,
+    _In_ const QUIC_ADDR* RemoteAddress,
+    _Out_ QUIC_PATH_METRICS* Metrics
+    )
+{
+    BOOLEAN Found = FALSE;
+    QUIC_PATH_METRICS_CACHE_SET* Set =
+        QuicPathMetricsCacheGetSet(Cache, RemoteAddress);
+    const uint64_t TimeNow = CxPlatTimeUs64();
+
+    CxPlatDispatchLockAcquire(&Set->Lock);
+    for (uint32_t i = 0; i < QUIC_PATH_METRICS_CACHE_WAYS; ++i) {
+        const QUIC_PATH_METRICS_CACHE_ENTRY* Entry = &Set->Entries[i];
+        if (QuicPathMetricsCacheEntryMatches(Entry, RemoteAddress)) {
+            if (CxPlatTimeDiff64(Entry->TimeUs, TimeNow) < QUIC_PATH_METRICS_CACHE_TIMEOUT) {
+                *Metrics = Entry->Metrics;
+                Found = TRUE;
+            }
+            break;
+        }
+    }
+    CxPlatDispatchLockRelease(&Set->Lock);
+
+    return Found;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicPathMetricsCacheUpdate(
+    _In_ QUIC_PATH_METRICS_CACHE* Cache,
+    _In_ const QUIC_ADDR* RemoteAddress,
+    _In_ const QUIC_PATH_METRICS* Metrics
+    )
+{
+    QUIC_PATH_METRICS_CACHE_SET* Set =
+        QuicPathMetricsCacheGetSet(Cache, RemoteAddress);
+    const uint64_t TimeNow = CxPlatTimeUs64();
+
+    CxPlatDispatchLockAcquire(&Set->Lock);
+
+    //
+    // Use the address's existing entry, or else replace the least recently
+    // updated one in the set.
+    //
+    QUIC_PATH_METRICS_CACHE_ENTRY* Entry = &Set->Entries[0];
+    for (uint32_t i = 0; i < QUIC_PATH_METRICS_CACHE_WAYS; ++i) {
+        if (QuicPathMetricsCacheEntryMatches(&Set->Entries[i], RemoteAddress)) {
+            Entry = &Set->Entries[i];
+            break;
+        }
+        if (Set->Entries[i].TimeUs < Entry->TimeUs) {
+            Entry = &Set->Entries[i];
+        }
+    }
+
+    if (!QuicPathMetricsCacheEntryMatches(Entry, RemoteAddress) ||
+        CxPlatTimeDiff64(Entry->TimeUs, TimeNow) >= QUIC_PATH_METRICS_CACHE_TIMEOUT) {
+        Entry->RemoteAddress = *RemoteAddress;
+        CxPlatZeroMemory(&Entry->Metrics, sizeof(Entry->Metrics));
+    }
+
+    if (Metrics->SmoothedRtt != 0) {
+        Entry->Metrics.SmoothedRtt = Metrics->SmoothedRtt;
+    }
+    if (Metrics->MinRtt != 0) {
+        Entry->Metrics.MinRtt = Metrics->MinRtt;
+    }
+    if (Metrics->CongestionWindow != 0) {
+        Entry->Metrics.CongestionWindow = Metrics->CongestionWindow;
+    }
+    if (Metrics->Mtu != 0) {
+        Entry->Metrics.Mtu = Metrics->Mtu;
+    }
+    Entry->TimeUs = TimeNow;
+
+    CxPlatDispatchLockRelease(&Set->Lock);
+}
@@ -5,6 +5,10 @@
 
 --*/
 
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
 //
 // ECN validation state transition:
 //
@@ -116,6 +120,12 @@ typedef struct QUIC_PATH {
     //
     BOOLEAN EncryptionOffloading : 1;
 
+    //
+    // Indicates this is one of the client's standby paths, which has its own
+    // binding and is only probed until the connection fails over to it.
+    //
+    BOOLEAN IsStandby : 1;
+
     //
     // The ending time of ECN validation testing state in microseconds.
     //
@@ -265,6 +275,174 @@ QuicPathGetDatagramPayloadSize(
             QuicAddrGetFamily(&Path->Route.RemoteAddress), Path->Mtu);
 }
 
+//
+// Metrics last measured on a path to a remote IP address. Zero means unknown.
+//
+typedef struct QUIC_PATH_METRICS {
+
+    uint32_t SmoothedRtt;       // microseconds
+    uint32_t MinRtt;            // microseconds
+    uint32_t CongestionWindow;  // bytes
+    uint16_t Mtu;
+
+} QUIC_PATH_METRICS;
+
+typedef struct QUIC_PATH_METRICS_CACHE_ENTRY {
+
+    QUIC_ADDR RemoteAddress;
+    uint64_t TimeUs;
+    QUIC_PATH_METRICS Metrics;
+
+} QUIC_PATH_METRICS_CACHE_ENTRY;
+
+typedef struct QUIC_CACHEALIGN QUIC_PATH_METRICS_CACHE_SET {
+
+    CXPLAT_DISPATCH_LOCK Lock;
+    QUIC_PATH_METRICS_CACHE_ENTRY Entries[QUIC_PATH_METRICS_CACHE_WAYS];
+
+} QUIC_PATH_METRICS_CACHE_SET;
+
+//
+// A bounded cache of path metrics, keyed by remote IP address, shared by all
+// connections so that new ones to a recently used peer don't have to start
+// from defaults. It is split into independently locked sets, indexed by a hash
+// of the address, so that connections on different workers rarely contend.
+//
+typedef struct QUIC_PATH_METRICS_CACHE {
+
+    QUIC_PATH_METRICS_CACHE_SET Sets[QUIC_PATH_METRICS_CACHE_SETS];
+
+} QUIC_PATH_METRICS_CACHE;
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicPathMetricsCacheInitialize(
+    _Out_ QUIC_PATH_METRICS_CACHE* Cache
+    );
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicPathMetricsCacheUninitialize(
+    _In_ QUIC_PATH_METRICS_CACHE* Cache
+    );
+
+//
+// Copies out the metrics cached for the remote IP address, if there are any
+// that have not expired.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Success_(return != FALSE)
+BOOLEAN
+QuicPathMetricsCacheLookup(
+    _In_ QUIC_PATH_METRICS_CACHE* Cache,
+    _In_ const QUIC_ADDR* RemoteAddress,
+    _Out_ QUIC_PATH_METRICS* Metrics
+    );
+
+//
+// Caches metrics for the remote IP address. Zero fields don't replace what is
+// already cached, so callers can update only what they measured.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicPathMetricsCacheUpdate(
+    _In_ QUIC_PATH_METRICS_CACHE* Cache,
+    _In_ const QUIC_ADDR* RemoteAddress,
+    _In_ const QUIC_PATH_METRICS* Metrics
+    );
+
+//
+// The probing state of one of the client's standby paths.
+//
+typedef struct QUIC_STANDBY_PATH {
+
+    BOOLEAN InUse;
+    uint8_t PathId;
+
+    //
+    // The number of probes sent since the last response. A path with more
+    // than the latest probe unanswered isn't failed over to.
+    //
+    uint8_t UnansweredProbes;
+
+    //
+    // Smoothed fraction of probes lost, in per mille.
+    //
+    uint16_t LossRate;
+
+    //
+    // When the current probe was sent, for RTT samples.
+    //
+    uint64_t ProbeSentTime;
+
+} QUIC_STANDBY_PATH;
+
+//
+// A client's standby paths (QUIC_PARAM_CONN_STANDBY_PATHS), only allocated
+// once the app sets them. Each one is a path from another local address, on
+// its own binding, that is validated and then probed with a PATH_CHALLENGE
+// every interval, tracking its RTT and probe loss. Packets received on it are
+// delivered through QuicBindingAddStandbyConnection, since the connection's
+// CIDs stay on the active path's binding until it fails over.
+//
+typedef struct QUIC_STANDBY_PATH_SET {
+
+    QUIC_STANDBY_PATHS Config;
+
+    //
+    // The connection's count of sent retransmittable packets, and the number of
+    // probes queued, at the last probe round. Standby paths are only probed if
+    // the connection sent something else since, so that probing doesn't keep
+    // an idle connection alive.
+    //
+    uint64_t LastSendCount;
+    uint8_t LastProbeCount;
+
+    QUIC_STANDBY_PATH Paths[QUIC_MAX_STANDBY_PATHS];
+
+} QUIC_STANDBY_PATH_SET;
+
+//
+// Brings the standby paths in line with the configured local addresses, and
+// probes the validated ones. Called when the configuration is set, once the
+// handshake is confirmed, and every probe interval.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnUpdateStandbyPaths(
+    _In_ QUIC_CONNECTION* Connection
+    );
+
+//
+// Processes the peer's response to a standby path's probe.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnOnStandbyPathResponse(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ QUIC_PATH* Path
+    );
+
+//
+// Makes the best validated standby path the active one, moving the
+// connection's CIDs over to its binding and dropping the old active path.
+// Returns FALSE if no standby path is usable.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+QuicConnFailoverToStandbyPath(
+    _In_ QUIC_CONNECTION* Connection
+    );
+
+//
+// Removes all the standby paths, releasing their bindings.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnRemoveStandbyPaths(
+    _In_ QUIC_CONNECTION* Connection
+    );
+
 typedef enum QUIC_PATH_VALID_REASON {
     QUIC_PATH_VALID_INITIAL_TOKEN,
     QUIC_PATH_VALID_HANDSHAKE_PACKET,
@@ -321,3 +499,7 @@ QuicPathUpdateQeo(
     _In_ QUIC_PATH* Path,
     _In_ CXPLAT_QEO_OPERATION Operation
     );
+
+#if defined(__cplusplus)
+}
+#endif
@@ -0,0 +1,668 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    The algorithm used for adjusting CongestionWindow is a Prague-like scalable
+    congestion control for L4S (RFC9330, RFC9331, draft-briscoe-iccrg-prague-
+    congestion-control).
+
+    Packets are sent with the ECT(1) codepoint. Once per round trip the window
+    is reduced in proportion to the moving average (Alpha) of the fraction of
+    CE marked packets, as in DCTCP (RFC8257). Loss is still handled like Reno.
+
+--*/
+
+#include "precomp.h"
+#ifdef QUIC_CLOG
+#include "prague.c.clog.h"
+#endif
+
+#include "prague.h"
+
+//
+// Gain of the Alpha moving average, as a right shift (g = 1/16).
+//
+#define PRAGUE_ALPHA_GAIN_SHIFT 4
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicConnLogPrague(
+    _In_ const QUIC_CONNECTION* const Connection
+    )
+{
+    const QUIC_CONGESTION_CONTROL_PRAGUE* Prague = &Connection->CongestionControl.Prague;
+
+    QuicTraceEvent(
+        ConnPrague,
+        "[conn][%p] Prague: Alpha=%u SlowStartThreshold=%u CongestionWindow=%u",
+        Connection,
+        Prague->Alpha,
+        Prague->SlowStartThreshold,
+        Prague->CongestionWindow);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+PragueCongestionControlGetMinimumWindow(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    const QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    return
+        (uint32_t)QuicPathGetDatagramPayloadSize(&Connection->Paths[0]) *
+        QUIC_PERSISTENT_CONGESTION_WINDOW_PACKETS;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+PragueCongestionControlResetRound(
+    _In_ QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    QUIC_CONGESTION_CONTROL_PRAGUE* Prague = &Cc->Prague;
+    Prague->RoundEnd = QuicCongestionControlGetConnection(Cc)->Send.NextPacketNumber;
+    Prague->EctPacketsInRound = 0;
+    Prague->CePacketsInRound = 0;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+PragueCongestionControlCanSend(
+    _In_ QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    QUIC_CONGESTION_CONTROL_PRAGUE* Prague = &Cc->Prague;
+    return Prague->BytesInFlight < Prague->CongestionWindow || Prague->Exemptions > 0;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+PragueCongestionControlSetExemption(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint8_t NumPackets
+    )
+{
+    Cc->Prague.Exemptions = NumPackets;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+PragueCongestionControlReset(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ BOOLEAN FullReset
+    )
+{
+    QUIC_CONGESTION_CONTROL_PRAGUE* Prague = &Cc->Prague;
+
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    const uint16_t DatagramPayloadLength =
+        QuicPathGetDatagramPayloadSize(&Connection->Paths[0]);
+    Prague->SlowStartThreshold = UINT32_MAX;
+    Prague->IsInRecovery = FALSE;
+    Prague->IsInPersistentCongestion = FALSE;
+    Prague->HasHadCongestionEvent = FALSE;
+    Prague->CongestionWindow = DatagramPayloadLength * Prague->InitialWindowPackets;
+    Prague->BytesInFlightMax = Prague->CongestionWindow / 2;
+    Prague->AimdAccumulator = 0;
+    Prague->LastSendAllowance = 0;
+    Prague->Alpha = PRAGUE_ALPHA_UNIT;
+    PragueCongestionControlResetRound(Cc);
+    if (FullReset) {
+        Prague->BytesInFlight = 0;
+    }
+
+    QuicConnLogOutFlowStats(Connection);
+    QuicConnLogPrague(Connection);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+PragueCongestionControlGetSendAllowance(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint64_t TimeSinceLastSend, // microsec
+    _In_ BOOLEAN TimeSinceLastSendValid
+    )
+{
+    QUIC_CONGESTION_CONTROL_PRAGUE* Prague = &Cc->Prague;
+
+    uint32_t SendAllowance;
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    if (Prague->BytesInFlight >= Prague->CongestionWindow) {
+        //
+        // We are CC blocked, so we can't send anything.
+        //
+        SendAllowance = 0;
+
+    } else if (
+        !TimeSinceLastSendValid ||
+        !Connection->Settings.PacingEnabled ||
+        !Connection->Paths[0].GotFirstRttSample ||
+        Connection->Paths[0].SmoothedRtt < QUIC_MIN_PACING_RTT) {
+        //
+        // We're not in the necessary state to pace.
+        //
+        SendAllowance = Prague->CongestionWindow - Prague->BytesInFlight;
+
+    } else {
+
+        //
+        // Pace at the window of the next round trip: double the current window
+        // in slow start. In congestion avoidance the window only grows by one
+        // packet per round trip, so a 1/8th margin is enough to keep the
+        // window full. L4S queues are shallow, so pacing closely matters more
+        // here than for the classic algorithms.
+        //
+        uint64_t EstimatedWnd;
+        if (Prague->CongestionWindow < Prague->SlowStartThreshold) {
+            EstimatedWnd = (uint64_t)Prague->CongestionWindow << 1;
+            if (EstimatedWnd > Prague->SlowStartThreshold) {
+                EstimatedWnd = Prague->SlowStartThreshold;
+            }
+        } else {
+            EstimatedWnd = Prague->CongestionWindow + (Prague->CongestionWindow >> 3);
+        }
+
+        SendAllowance =
+            Prague->LastSendAllowance +
+            (uint32_t)((EstimatedWnd * TimeSinceLastSend) / Connection->Paths[0].SmoothedRtt);
+        if (SendAllowance < Prague->LastSendAllowance || // Overflow case
+            SendAllowance > (Prague->CongestionWindow - Prague->BytesInFlight)) {
+            SendAllowance = Prague->CongestionWindow - Prague->BytesInFlight;
+        }
+
+        Prague->LastSendAllowance = SendAllowance;
+    }
+    return SendAllowance;
+}
+
+//
+// Returns TRUE if we became unblocked.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+PragueCongestionControlUpdateBlockedState(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ BOOLEAN PreviousCanSendState
+    )
+{
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    QuicConnLogOutFlowStats(Connection);
+    if (PreviousCanSendState != PragueCongestionControlCanSend(Cc)) {
+        if (PreviousCanSendState) {
+            QuicConnAddOutFlowBlockedReason(
+                Connection, QUIC_FLOW_BLOCKED_CONGESTION_CONTROL);
+        } else {
+            QuicConnRemoveOutFlowBlockedReason(
+                Connection, QUIC_FLOW_BLOCKED_CONGESTION_CONTROL);
+            Connection->Send.LastFlushTime = CxPlatTimeUs64(); // Reset last flush time
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+//
+// Called at the end of each round trip to fold the fraction of CE marked
+// packets into Alpha: Alpha = (1 - g) * Alpha + g * F.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+PragueCongestionControlUpdateAlpha(
+    _In_ QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    QUIC_CONGESTION_CONTROL_PRAGUE* Prague = &Cc->Prague;
+
+    if (Prague->EctPacketsInRound != 0) {
+        const uint64_t Fraction =
+            (CXPLAT_MIN(Prague->CePacketsInRound, Prague->EctPacketsInRound) << PRAGUE_ALPHA_SHIFT) /
+            Prague->EctPacketsInRound;
+        Prague->Alpha =
+            Prague->Alpha -
+            (Prague->Alpha >> PRAGUE_ALPHA_GAIN_SHIFT) +
+            (uint32_t)(Fraction >> PRAGUE_ALPHA_GAIN_SHIFT);
+    }
+
+    PragueCongestionControlResetRound(Cc);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+PragueCongestionControlOnCongestionEvent(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ BOOLEAN IsPersistentCongestion
+    )
+{
+    QUIC_CONGESTION_CONTROL_PRAGUE* Prague = &Cc->Prague;
+
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    QuicTraceEvent(
+        ConnCongestionV2,
+        "[conn][%p] Congestion event: IsEcn=%hu",
+        Connection,
+        FALSE);
+    Connection->Stats.Send.CongestionCount++;
+
+    Prague->IsInRecovery = TRUE;
+    Prague->HasHadCongestionEvent = TRUE;
+
+    //
+    // Save previous state, just in case this ends up being spurious.
+    //
+    Prague->PrevSlowStartThreshold = Prague->SlowStartThreshold;
+    Prague->PrevCongestionWindow = Prague->CongestionWindow;
+
+    if (IsPersistentCongestion && !Prague->IsInPersistentCongestion) {
+
+        QuicTraceEvent(
+            ConnPersistentCongestion,
+            "[conn][%p] Persistent congestion event",
+            Connection);
+        Connection->Stats.Send.PersistentCongestionCount++;
+
+        Connection->Paths[0].Route.State = RouteSuspected; // used only for RAW datapath
+
+        Prague->IsInPersistentCongestion = TRUE;
+        Prague->SlowStartThreshold =
+            CXPLAT_MAX(
+                PragueCongestionControlGetMinimumWindow(Cc),
+                Prague->CongestionWindow / 2);
+        Prague->CongestionWindow = PragueCongestionControlGetMinimumWindow(Cc);
+
+    } else {
+
+        Prague->SlowStartThreshold =
+        Prague->CongestionWindow =
+            CXPLAT_MAX(
+                PragueCongestionControlGetMinimumWindow(Cc),
+                Prague->CongestionWindow / 2);
+    }
+
+    Prague->AimdAccumulator = 0;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+PragueCongestionControlOnDataSent(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint32_t NumRetransmittableBytes
+    )
+{
+    QUIC_CONGESTION_CONTROL_PRAGUE* Prague = &Cc->Prague;
+
+    BOOLEAN PreviousCanSendState = QuicCongestionControlCanSend(Cc);
+
+    Prague->BytesInFlight += NumRetransmittableBytes;
+    if (Prague->BytesInFlightMax < Prague->BytesInFlight) {
+        Prague->BytesInFlightMax = Prague->BytesInFlight;
+        QuicSendBufferConnectionAdjust(QuicCongestionControlGetConnection(Cc));
+    }
+
+    if (NumRetransmittableBytes > Prague->LastSendAllowance) {
+        Prague->LastSendAllowance = 0;
+    } else {
+        Prague->LastSendAllowance -= NumRetransmittableBytes;
+    }
+
+    if (Prague->Exemptions > 0) {
+        --Prague->Exemptions;
+    }
+
+    PragueCongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+PragueCongestionControlOnDataInvalidated(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint32_t NumRetransmittableBytes
+    )
+{
+    QUIC_CONGESTION_CONTROL_PRAGUE* Prague = &Cc->Prague;
+
+    BOOLEAN PreviousCanSendState = PragueCongestionControlCanSend(Cc);
+
+    CXPLAT_DBG_ASSERT(Prague->BytesInFlight >= NumRetransmittableBytes);
+    Prague->BytesInFlight -= NumRetransmittableBytes;
+
+    return PragueCongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+PragueCongestionControlOnDataAcknowledged(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_ACK_EVENT* AckEvent
+    )
+{
+    QUIC_CONGESTION_CONTROL_PRAGUE* Prague = &Cc->Prague;
+
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    BOOLEAN PreviousCanSendState = PragueCongestionControlCanSend(Cc);
+    uint32_t BytesAcked = AckEvent->NumRetransmittableBytes;
+
+    CXPLAT_DBG_ASSERT(Prague->BytesInFlight >= BytesAcked);
+    Prague->BytesInFlight -= BytesAcked;
+
+    //
+    // Count the ECT packets acknowledged in this round. The CE marked subset
+    // is reported through the ACK frame's ECN counts before this is called.
+    //
+    for (const QUIC_SENT_PACKET_METADATA* Packet = AckEvent->AckedPackets;
+         Packet != NULL;
+         Packet = Packet->Next) {
+        if (Packet->Flags.EcnEctSet) {
+            Prague->EctPacketsInRound++;
+        }
+    }
+
+    if (AckEvent->LargestAck >= Prague->RoundEnd) {
+        PragueCongestionControlUpdateAlpha(Cc);
+    }
+
+    if (Prague->IsInRecovery) {
+        if (AckEvent->LargestAck > Prague->RecoverySentPacketNumber) {
+            QuicTraceEvent(
+                ConnRecoveryExit,
+                "[conn][%p] Recovery complete",
+                Connection);
+            Prague->IsInRecovery = FALSE;
+            Prague->IsInPersistentCongestion = FALSE;
+        }
+        goto Exit;
+    } else if (BytesAcked == 0) {
+        goto Exit;
+    }
+
+    if (Prague->CongestionWindow < Prague->SlowStartThreshold) {
+
+        //
+        // Slow Start
+        //
+
+        Prague->CongestionWindow += BytesAcked;
+        BytesAcked = 0;
+        if (Prague->CongestionWindow >= Prague->SlowStartThreshold) {
+            //
+            // Treat the bytes beyond SlowStartThreshold as if they were
+            // acknowledged during Congestion Avoidance below.
+            //
+            BytesAcked = Prague->CongestionWindow - Prague->SlowStartThreshold;
+            Prague->CongestionWindow = Prague->SlowStartThreshold;
+        }
+    }
+
+    if (BytesAcked > 0) {
+
+        //
+        // Congestion Avoidance: grow by one packet per window of acknowledged
+        // bytes (RFC3465 byte counting).
+        //
+        const uint16_t DatagramPayloadLength =
+            QuicPathGetDatagramPayloadSize(&Connection->Paths[0]);
+        Prague->AimdAccumulator += BytesAcked;
+        if (Prague->AimdAccumulator >= Prague->CongestionWindow) {
+            Prague->AimdAccumulator -= Prague->CongestionWindow;
+            Prague->CongestionWindow += DatagramPayloadLength;
+        }
+    }
+
+    //
+    // Limit the growth of the window based on the number of bytes we
+    // actually manage to put on the wire.
+    //
+    if (Prague->CongestionWindow > 2 * Prague->BytesInFlightMax) {
+        Prague->CongestionWindow = 2 * Prague->BytesInFlightMax;
+    }
+
+Exit:
+
+    if (Connection->Settings.NetStatsEventEnabled) {
+        QuicCongestionControlIndicateNetworkStatistics(
+            Cc,
+            Prague->BytesInFlight,
+            Prague->CongestionWindow,
+            Prague->CongestionWindow / Connection->Paths[0].SmoothedRtt);
+    }
+
+    return PragueCongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+PragueCongestionControlOnDataLost(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_LOSS_EVENT* LossEvent
+    )
+{
+    QUIC_CONGESTION_CONTROL_PRAGUE* Prague = &Cc->Prague;
+
+    BOOLEAN PreviousCanSendState = PragueCongestionControlCanSend(Cc);
+
+    //
+    // If data is lost after the most recent congestion event (or if there
+    // hasn't been a congestion event yet) then treat this loss as a new
+    // congestion event.
+    //
+    if (!Prague->HasHadCongestionEvent ||
+        LossEvent->LargestPacketNumberLost > Prague->RecoverySentPacketNumber) {
+
+        Prague->RecoverySentPacketNumber = LossEvent->LargestSentPacketNumber;
+        PragueCongestionControlOnCongestionEvent(
+            Cc,
+            LossEvent->PersistentCongestion);
+    }
+
+    CXPLAT_DBG_ASSERT(Prague->BytesInFlight >= LossEvent->NumRetransmittableBytes);
+    Prague->BytesInFlight -= LossEvent->NumRetransmittableBytes;
+
+    PragueCongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
+    QuicConnLogPrague(QuicCongestionControlGetConnection(Cc));
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+PragueCongestionControlOnEcn(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_ECN_EVENT* EcnEvent
+    )
+{
+    QUIC_CONGESTION_CONTROL_PRAGUE* Prague = &Cc->Prague;
+
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    BOOLEAN PreviousCanSendState = PragueCongestionControlCanSend(Cc);
+
+    Prague->CePacketsInRound += EcnEvent->NewCeCount;
+
+    //
+    // Unlike the classic response, CE marks don't stop window growth. The
+    // window is reduced at most once per round trip, by Alpha / 2.
+    //
+    if (!Prague->HasHadCongestionEvent ||
+        EcnEvent->LargestPacketNumberAcked > Prague->RecoverySentPacketNumber) {
+
+        Prague->RecoverySentPacketNumber = EcnEvent->LargestSentPacketNumber;
+        Prague->HasHadCongestionEvent = TRUE;
+
+        QuicTraceEvent(
+            ConnCongestionV2,
+            "[conn][%p] Congestion event: IsEcn=%hu",
+            Connection,
+            TRUE);
+        Connection->Stats.Send.CongestionCount++;
+        Connection->Stats.Send.EcnCongestionCount++;
+
+        const uint32_t Reduction =
+            (uint32_t)(((uint64_t)Prague->CongestionWindow * Prague->Alpha) >> (PRAGUE_ALPHA_SHIFT + 1));
+        Prague->SlowStartThreshold =
+        Prague->CongestionWindow =
+            CXPLAT_MAX(
+                PragueCongestionControlGetMinimumWindow(Cc),
+                Prague->CongestionWindow - Reduction);
+    }
+
+    PragueCongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
+    QuicConnLogPrague(Connection);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+PragueCongestionControlOnSpuriousCongestionEvent(
+    _In_ QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    QUIC_CONGESTION_CONTROL_PRAGUE* Prague = &Cc->Prague;
+
+    if (!Prague->IsInRecovery) {
+        return FALSE;
+    }
+
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    BOOLEAN PreviousCanSendState = QuicCongestionControlCanSend(Cc);
+
+    QuicTraceEvent(
+        ConnSpuriousCongestion,
+        "[conn][%p] Spurious congestion event",
+        Connection);
+
+    Prague->SlowStartThreshold = Prague->PrevSlowStartThreshold;
+    Prague->CongestionWindow = Prague->PrevCongestionWindow;
+
+    Prague->IsInRecovery = FALSE;
+    Prague->HasHadCongestionEvent = FALSE;
+
+    BOOLEAN Result = PragueCongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
+    QuicConnLogPrague(Connection);
+    return Result;
+}
+
+void
+PragueCongestionControlLogOutFlowStatus(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    const QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    const QUIC_PATH* Path = &Connection->Paths[0];
+    const QUIC_CONGESTION_CONTROL_PRAGUE* Prague = &Cc->Prague;
+
+    QuicTraceEvent(
+        ConnOutFlowStatsV2,
+        "[conn][%p] OUT: BytesSent=%llu InFlight=%u CWnd=%u ConnFC=%llu ISB=%llu PostedBytes=%llu SRtt=%llu 1Way=%llu",
+        Connection,
+        Connection->Stats.Send.TotalBytes,
+        Prague->BytesInFlight,
+        Prague->CongestionWindow,
+        Connection->Send.PeerMaxData - Connection->Send.OrderedStreamBytesSent,
+        Connection->SendBuffer.IdealBytes,
+        Connection->SendBuffer.PostedBytes,
+        Path->GotFirstRttSample ? Path->SmoothedRtt : 0,
+        Path->OneWayDelay);
+}
+
+uint32_t
+PragueCongestionControlGetBytesInFlightMax(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    return Cc->Prague.BytesInFlightMax;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint8_t
+PragueCongestionControlGetExemptions(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    return Cc->Prague.Exemptions;
+}
+
+uint32_t
+PragueCongestionControlGetCongestionWindow(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    return Cc->Prague.CongestionWindow;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+PragueCongestionControlIsInRecovery(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    return Cc->Prague.IsInRecovery;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+PragueCongestionControlIsAppLimited(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    UNREFERENCED_PARAMETER(Cc);
+    return FALSE;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+PragueCongestionControlSetAppLimited(
+    _In_ struct QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    UNREFERENCED_PARAMETER(Cc);
+}
+
+static const QUIC_CONGESTION_CONTROL QuicCongestionControlPrague = {
+    .Name = "Prague",
+    .IsL4s = TRUE,
+    .QuicCongestionControlCanSend = PragueCongestionControlCanSend,
+    .QuicCongestionControlSetExemption = PragueCongestionControlSetExemption,
+    .QuicCongestionControlReset = PragueCongestionControlReset,
+    .QuicCongestionControlGetSendAllowance = PragueCongestionControlGetSendAllowance,
+    .QuicCongestionControlOnDataSent = PragueCongestionControlOnDataSent,
+    .QuicCongestionControlOnDataInvalidated = PragueCongestionControlOnDataInvalidated,
+    .QuicCongestionControlOnDataAcknowledged = PragueCongestionControlOnDataAcknowledged,
+    .QuicCongestionControlOnDataLost = PragueCongestionControlOnDataLost,
+    .QuicCongestionControlOnEcn = PragueCongestionControlOnEcn,
+    .QuicCongestionControlOnSpuriousCongestionEvent = PragueCongestionControlOnSpuriousCongestionEvent,
+    .QuicCongestionControlLogOutFlowStatus = PragueCongestionControlLogOutFlowStatus,
+    .QuicCongestionControlGetExemptions = PragueCongestionControlGetExemptions,
+    .QuicCongestionControlGetBytesInFlightMax = PragueCongestionControlGetBytesInFlightMax,
+    .QuicCongestionControlIsAppLimited = PragueCongestionControlIsAppLimited,
+    .QuicCongestionControlSetAppLimited = PragueCongestionControlSetAppLimited,
+    .QuicCongestionControlGetCongestionWindow = PragueCongestionControlGetCongestionWindow,
+    .QuicCongestionControlIsInRecovery = PragueCongestionControlIsInRecovery,
+};
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+PragueCongestionControlInitialize(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_SETTINGS_INTERNAL* Settings
+    )
+{
+    *Cc = QuicCongestionControlPrague;
+
+    QUIC_CONGESTION_CONTROL_PRAGUE* Prague = &Cc->Prague;
+
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    const uint16_t DatagramPayloadLength =
+        QuicPathGetDatagramPayloadSize(&Connection->Paths[0]);
+    Prague->SlowStartThreshold = UINT32_MAX;
+    Prague->InitialWindowPackets = Settings->InitialWindowPackets;
+    Prague->CongestionWindow = DatagramPayloadLength * Prague->InitialWindowPackets;
+    Prague->BytesInFlightMax = Prague->CongestionWindow / 2;
+
+    //
+    // Start with the conservative estimate that all packets are marked, so the
+    // first CE response halves the window (as in DCTCP).
+    //
+    Prague->Alpha = PRAGUE_ALPHA_UNIT;
+    PragueCongestionControlResetRound(Cc);
+
+    QuicConnLogOutFlowStats(Connection);
+    QuicConnLogPrague(Connection);
+}
@@ -49,14 +49,21 @@
 #include "lookup.h"
 #include "timer_wheel.h"
 #include "settings.h"
+#include "range.h"
+#include "recv_buffer.h"
+#include "ticket_cache.h"
+#include "anti_replay.h"
+#include "event_queue.h"
+#include "latency_histogram.h"
+#include "qlog.h"
+#include "capture.h"
+#include "net_emu.h"
 #include "library.h"
 #include "operation.h"
 #include "binding.h"
 #include "api.h"
 #include "registration.h"
 #include "configuration.h"
-#include "range.h"
-#include "recv_buffer.h"
 #include "send_buffer.h"
 #include "frame.h"
 #include "packet.h"
@@ -69,7 +76,9 @@
 #include "send.h"
 #include "crypto.h"
 #include "stream.h"
+#include "stream_compress.h"
 #include "stream_set.h"
+#include "datagram_fec.h"
 #include "datagram.h"
 #include "version_neg.h"
 #include "connection.h"
@@ -77,4 +86,7 @@
 #include "listener.h"
 #include "cubic.h"
 #include "bbr.h"
+#include "prague.h"
+#include "copa.h"
+#include "custom_cc.h"
 #include "sliding_window_extremum.h"
@@ -0,0 +1,288 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    qlog event output. See qlog.h.
+
+    Records are formatted into a text buffer that is allocated right after
+    the record array, so a flush from deep in the send or receive path doesn't
+    need a large stack buffer. The formatting is hand rolled because it only
+    ever needs decimal and hex integers, and works the same in kernel mode.
+
+--*/
+
+#include "precomp.h"
+#ifdef QUIC_CLOG
+#include "qlog.c.clog.h"
+#endif
+
+//
+// An upper bound on the length of a single formatted record.
+//
+#define QUIC_QLOG_MAX_RECORD_LENGTH 384
+
+#define QUIC_QLOG_TEXT_BUFFER_SIZE  4096
+
+CXPLAT_STATIC_ASSERT(
+    QUIC_QLOG_TEXT_BUFFER_SIZE >= 2 * QUIC_QLOG_MAX_RECORD_LENGTH,
+    "The text buffer should hold several records");
+
+typedef struct QUIC_QLOG_WRITER {
+    QUIC_QLOG_HANDLER Handler;
+    char* Text;
+    uint32_t Length;
+} QUIC_QLOG_WRITER;
+
+static const char* const QuicQlogPacketTypes[] = {
+    "version_negotiation",
+    "initial",
+    "0RTT",
+    "handshake",
+    "retry",
+    "1RTT"
+};
+
+static const char* const QuicQlogLossTriggers[] = {
+    "time_threshold",       // QUIC_TRACE_PACKET_LOSS_RACK
+    "reordering_threshold", // QUIC_TRACE_PACKET_LOSS_FACK
+    "pto_expired"           // QUIC_TRACE_PACKET_LOSS_PROBE
+};
+
+static
+void
+QuicQlogAppend(
+    _Inout_ QUIC_QLOG_WRITER* Writer,
+    _In_z_ const char* String
+    )
+{
+    const uint32_t Length = (uint32_t)strlen(String);
+    CXPLAT_DBG_ASSERT(Writer->Length + Length <= QUIC_QLOG_TEXT_BUFFER_SIZE);
+    CxPlatCopyMemory(Writer->Text + Writer->Length, String, Length);
+    Writer->Length += Length;
+}
+
+static
+void
+QuicQlogAppendUInt(
+    _Inout_ QUIC_QLOG_WRITER* Writer,
+    _In_ uint64_t Value,
+    _In_ uint8_t MinDigits
+    )
+{
+    char Digits[20];
+    uint8_t Count = 0;
+    do {
+        Digits[Count++] = (char)('0' + Value % 10);
+        Value /= 10;
+    } while (Value != 0 || Count < MinDigits);
+    while (Count != 0) {
+        Writer->Text[Writer->Length++] = Digits[--Count];
+    }
+}
+
+static
+void
+QuicQlogAppendHex(
+    _Inout_ QUIC_QLOG_WRITER* Writer,
+    _In_ uint64_t Value
+    )
+{
+    static const char HexDigits[] = "0123456789abcdef";
+    Writer->Text[Writer->Length++] = '0';
+    Writer->Text[Writer->Length++] = 'x';
+    for (int8_t Shift = 60; Shift >= 0; Shift -= 4) {
+        Writer->Text[Writer->Length++] = HexDigits[(Value >> Shift) & 0xF];
+    }
+}
+
+//
+// qlog times are in milliseconds.
+//
+static
+void
+QuicQlogAppendTime(
+    _Inout_ QUIC_QLOG_WRITER* Writer,
+    _In_ uint64_t TimeUs
+    )
+{
+    QuicQlogAppendUInt(Writer, TimeUs / 1000, 1);
+    Writer->Text[Writer->Length++] = '.';
+    QuicQlogAppendUInt(Writer, TimeUs % 1000, 3);
+}
+
+static
+void
+QuicQlogDeliver(
+    _Inout_ QUIC_QLOG_WRITER* Writer
+    )
+{
+    if (Writer->Length != 0) {
+        Writer->Handler.Handler(Writer->Handler.Context, Writer->Text, Writer->Length);
+        Writer->Length = 0;
+    }
+}
+
+static
+void
+QuicQlogFormatRecord(
+    _Inout_ QUIC_QLOG_WRITER* Writer,
+    _In_ const QUIC_QLOG_RECORD* Record
+    )
+{
+    const uint32_t Start = Writer->Length;
+
+    QuicQlogAppend(Writer, "\x1e{\"time\":");
+    QuicQlogAppendTime(Writer, Record->TimeUs);
+    QuicQlogAppend(Writer, ",\"name\":\"");
+    switch (Record->Type) {
+    case QUIC_QLOG_EVENT_PACKET_SENT:
+        QuicQlogAppend(Writer, "transport:packet_sent");
+        break;
+    case QUIC_QLOG_EVENT_PACKET_RECEIVED:
+        QuicQlogAppend(Writer, "transport:packet_received");
+        break;
+    case QUIC_QLOG_EVENT_PACKET_LOST:
+        QuicQlogAppend(Writer, "recovery:packet_lost");
+        break;
+    default:
+        QuicQlogAppend(Writer, "recovery:metrics_updated");
+        break;
+    }
+    QuicQlogAppend(Writer, "\",\"group_id\":\"");
+    QuicQlogAppendHex(Writer, (uint64_t)(size_t)Record->Connection);
+    QuicQlogAppend(Writer, "\",\"data\":{");
+
+    if (Record->Type == QUIC_QLOG_EVENT_METRICS_UPDATED) {
+        QuicQlogAppend(Writer, "\"latest_rtt\":");
+        QuicQlogAppendTime(Writer, Record->Values[0]);
+        QuicQlogAppend(Writer, ",\"smoothed_rtt\":");
+        QuicQlogAppendTime(Writer, Record->Values[1]);
+        QuicQlogAppend(Writer, ",\"rtt_variance\":");
+        QuicQlogAppendTime(Writer, Record->Values[2]);
+
+    } else {
+        QuicQlogAppend(Writer, "\"header\":{\"packet_type\":\"");
+        QuicQlogAppend(
+            Writer,
+            Record->PacketType < ARRAYSIZE(QuicQlogPacketTypes) ?
+                QuicQlogPacketTypes[Record->PacketType] : "unknown");
+        QuicQlogAppend(Writer, "\",\"packet_number\":");
+        QuicQlogAppendUInt(Writer, Record->Values[0], 1);
+        QuicQlogAppend(Writer, "}");
+        if (Record->Type == QUIC_QLOG_EVENT_PACKET_LOST) {
+            QuicQlogAppend(Writer, ",\"trigger\":\"");
+            QuicQlogAppend(
+                Writer,
+                Record->Values[1] < ARRAYSIZE(QuicQlogLossTriggers) ?
+                    QuicQlogLossTriggers[Record->Values[1]] : "unknown");
+            QuicQlogAppend(Writer, "\"");
+        } else {
+            QuicQlogAppend(Writer, ",\"raw\":{\"length\":");
+            QuicQlogAppendUInt(Writer, Record->Values[1], 1);
+            QuicQlogAppend(Writer, "}");
+        }
+    }
+
+    QuicQlogAppend(Writer, "}}\n");
+    CXPLAT_DBG_ASSERT(Writer->Length - Start <= QUIC_QLOG_MAX_RECORD_LENGTH);
+    UNREFERENCED_PARAMETER(Start);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicQlogBufferUninitialize(
+    _In_ QUIC_QLOG_BUFFER* Buffer
+    )
+{
+    if (Buffer->Records != NULL) {
+        CXPLAT_FREE(Buffer->Records, QUIC_POOL_QLOG);
+        Buffer->Records = NULL;
+    }
+    Buffer->Count = 0;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicQlogWrite(
+    _Inout_ QUIC_QLOG_BUFFER* Buffer,
+    _In_ const void* Connection,
+    _In_ QUIC_QLOG_EVENT_TYPE Type,
+    _In_ uint8_t PacketType,
+    _In_ uint64_t Value0,
+    _In_ uint64_t Value1,
+    _In_ uint64_t Value2
+    )
+{
+    if (Buffer->Records == NULL) {
+        const size_t AllocSize =
+            QUIC_QLOG_BUFFER_RECORD_COUNT * sizeof(QUIC_QLOG_RECORD) +
+            QUIC_QLOG_TEXT_BUFFER_SIZE;
+        Buffer->Records = CXPLAT_ALLOC_NONPAGED(AllocSize, QUIC_POOL_QLOG);
+        if (Buffer->Records == NULL) {
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "qlog buffer",
+                AllocSize);
+            Buffer->DroppedCount++;
+            return;
+        }
+        Buffer->Count = 0;
+
+    } else if (Buffer->Count == QUIC_QLOG_BUFFER_RECORD_COUNT) {
+        QuicQlogFlush(Buffer);
+    }
+
+    QUIC_QLOG_RECORD* Record = &Buffer->Records[Buffer->Count++];
+    Record->TimeUs = CxPlatTimeUs64();
+    Record->Connection = Connection;
+    Record->Values[0] = Value0;
+    Record->Values[1] = Value1;
+    Record->Values[2] = Value2;
+    Record->Type = (uint8_t)Type;
+    Record->PacketType = PacketType;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicQlogFlush(
+    _Inout_ QUIC_QLOG_BUFFER* Buffer
+    )
+{
+    if (Buffer->Count == 0) {
+        return;
+    }
+
+    QUIC_QLOG_WRITER Writer;
+    Writer.Handler = MsQuicLib.QlogHandler;
+    Writer.Text = (char*)(Buffer->Records + QUIC_QLOG_BUFFER_RECORD_COUNT);
+    Writer.Length = 0;
+
+    if (Writer.Handler.Handler != NULL) {
+        for (uint32_t i = 0; i < Buffer->Count; ++i) {
+            if (Writer.Length + QUIC_QLOG_MAX_RECORD_LENGTH > QUIC_QLOG_TEXT_BUFFER_SIZE) {
+                QuicQlogDeliver(&Writer);
+            }
+            QuicQlogFormatRecord(&Writer, &Buffer->Records[i]);
+        }
+        QuicQlogDeliver(&Writer);
+    }
+
+    Buffer->Count = 0;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicQlogWriteHeader(
+    _In_ const QUIC_QLOG_HANDLER* Handler
+    )
+{
+    static const char Header[] =
+        "\x1e{\"qlog_version\":\"0.3\",\"qlog_format\":\"JSON-SEQ\","
+        "\"title\":\"msquic\",\"trace\":{\"common_fields\":"
+        "{\"time_format\":\"absolute\"},\"vantage_point\":{\"type\":\"unknown\"}}}\n";
+    Handler->Handler(Handler->Context, Header, sizeof(Header) - 1);
+}
@@ -0,0 +1,98 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    qlog (draft-ietf-quic-qlog) event output. Connections with qlog enabled
+    write small binary records into their worker's buffer, which only that
+    worker's thread ever touches, so recording needs no locks or atomics.
+    Records are only formatted as JSON text sequences when the worker flushes
+    them to the app's QUIC_QLOG_HANDLER, which it does before going idle or
+    once the buffer fills up.
+
+--*/
+
+#pragma once
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+typedef enum QUIC_QLOG_EVENT_TYPE {
+    QUIC_QLOG_EVENT_PACKET_SENT,        // Values: PacketNumber, Length
+    QUIC_QLOG_EVENT_PACKET_RECEIVED,    // Values: PacketNumber, Length
+    QUIC_QLOG_EVENT_PACKET_LOST,        // Values: PacketNumber, QUIC_TRACE_PACKET_LOSS_REASON
+    QUIC_QLOG_EVENT_METRICS_UPDATED,    // Values: LatestRtt, SmoothedRtt, RttVariance (us)
+} QUIC_QLOG_EVENT_TYPE;
+
+typedef struct QUIC_QLOG_RECORD {
+
+    uint64_t TimeUs;
+    const void* Connection;
+    uint64_t Values[3];
+    uint8_t Type;       // QUIC_QLOG_EVENT_TYPE
+    uint8_t PacketType; // QUIC_TRACE_PACKET_TYPE
+
+} QUIC_QLOG_RECORD;
+
+typedef struct QUIC_QLOG_BUFFER {
+
+    //
+    // Allocated on the first record, so workers that never see a qlog enabled
+    // connection don't pay for it.
+    //
+    QUIC_QLOG_RECORD* Records;
+    uint32_t Count;
+
+    //
+    // Records lost because the buffer couldn't be allocated.
+    //
+    uint64_t DroppedCount;
+
+} QUIC_QLOG_BUFFER;
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicQlogBufferUninitialize(
+    _In_ QUIC_QLOG_BUFFER* Buffer
+    );
+
+//
+// Appends a record, flushing the buffer first if it is full.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicQlogWrite(
+    _Inout_ QUIC_QLOG_BUFFER* Buffer,
+    _In_ const void* Connection,
+    _In_ QUIC_QLOG_EVENT_TYPE Type,
+    _In_ uint8_t PacketType,
+    _In_ uint64_t Value0,
+    _In_ uint64_t Value1,
+    _In_ uint64_t Value2
+    );
+
+//
+// Formats all buffered records and passes them to the app's handler, if it
+// has one.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicQlogFlush(
+    _Inout_ QUIC_QLOG_BUFFER* Buffer
+    );
+
+//
+// Passes the qlog file header to a newly set handler.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicQlogWriteHeader(
+    _In_ const QUIC_QLOG_HANDLER* Handler
+    );
+
+#if defined(__cplusplus)
+}
+#endif
@@ -73,6 +73,23 @@ typedef struct QUIC_RX_PACKET QUIC_RX_PACKET;
 //
 #define QUIC_PACKET_REORDER_THRESHOLD           3
 
+//
+// The initial and maximum number of slots in the packet number index of
+// outstanding sent packets. The index doubles when the span of outstanding
+// packet numbers no longer fits.
+//
+#define QUIC_SENT_PACKET_INDEX_INITIAL_SIZE     64
+#define QUIC_SENT_PACKET_INDEX_MAX_SIZE         0x10000
+
+//
+// The size (in bytes) of a connection's sent packet metadata arena, and the
+// number of packets that must be in flight before a connection allocates it.
+// Until then, and whenever the arena is full, sent packet metadata comes from
+// the worker's pools instead.
+//
+#define QUIC_SENT_PACKET_ARENA_SIZE             0x10000
+#define QUIC_SENT_PACKET_ARENA_THRESHOLD        32
+
 //
 // The max expected reordering in terms of time
 // (for RACK loss detection).
@@ -103,6 +120,18 @@ typedef struct QUIC_RX_PACKET QUIC_RX_PACKET;
 //
 #define QUIC_MIN_ACK_SEND_NUMBER                2
 
+//
+// The largest packet tolerance we ask the peer to use (via the ACK_FREQUENCY
+// frame) during steady state bulk transfer.
+//
+#define QUIC_MAX_PEER_PACKET_TOLERANCE          16
+
+//
+// The number of acknowledgments per congestion window we aim for when raising
+// the peer's packet tolerance.
+//
+#define QUIC_ACKS_PER_CONGESTION_WINDOW         4
+
 //
 // The size of the stateless reset token.
 //
@@ -171,6 +200,20 @@ typedef struct QUIC_RX_PACKET QUIC_RX_PACKET;
 //
 #define QUIC_MAX_OPERATIONS_PER_DRAIN           16
 
+//
+// How much a registration's egress rate limit lets build up while its
+// connections are idle, in microseconds worth of the rate, and the smallest
+// such burst regardless of the rate, so a full send batch can still go out.
+//
+#define QUIC_REGISTRATION_EGRESS_BURST_US       10000
+#define QUIC_REGISTRATION_EGRESS_MIN_BURST      65536
+
+//
+// The longest time, in microseconds, an incremental walk of a registration's
+// connections holds the connection lock before letting others take it.
+//
+#define QUIC_REGISTRATION_ENUM_SLICE_US         500
+
 //
 // Used as a hint for the maximum number of UDP datagrams to send for each
 // FLUSH_SEND operation. The actual number will generally exceed this value up
@@ -178,12 +221,184 @@ typedef struct QUIC_RX_PACKET QUIC_RX_PACKET;
 //
 #define QUIC_MAX_DATAGRAMS_PER_SEND             40
 
+//
+// The time budget (in microseconds) of each FLUSH_SEND operation, per
+// execution profile. Once it runs out, the flush stops at the next batch
+// boundary and the connection yields the worker to other connections. The
+// budget replaces QUIC_MAX_DATAGRAMS_PER_SEND for the main send flush.
+//
+#define QUIC_SEND_FLUSH_BUDGET_LOW_LATENCY_US       200
+#define QUIC_SEND_FLUSH_BUDGET_MAX_THROUGHPUT_US    500
+#define QUIC_SEND_FLUSH_BUDGET_SCAVENGER_US         50
+#define QUIC_SEND_FLUSH_BUDGET_REAL_TIME_US         100
+
+//
+// The maximum time (in microseconds) an app can have small stream sends held
+// for coalescing (QUIC_PARAM_CONN_SEND_COALESCING_DELAY).
+//
+#define QUIC_MAX_SEND_COALESCING_DELAY_US           25000
+
+//
+// The maximum slack (in milliseconds) the app can allow idle, keep-alive and
+// hibernate timers (QUIC_PARAM_GLOBAL_TIMER_SLACK).
+//
+#define QUIC_MAX_TIMER_SLACK_MS                     10000
+
+//
+// The maximum delay (in milliseconds) a client can wait for the server before
+// moving its Initial to the other address family
+// (QUIC_PARAM_CONN_ADDRESS_RACE_DELAY), and the most times the delay doubles
+// as the client keeps alternating families without hearing back.
+//
+#define QUIC_MAX_ADDRESS_RACE_DELAY_MS              10000
+#define QUIC_ADDRESS_RACE_MAX_BACKOFF               4
+
+//
+// The default and maximum intervals (in milliseconds) between probes of each
+// standby path (QUIC_PARAM_CONN_STANDBY_PATHS), and the number of probe
+// timeouts on the active path after which the client fails over to one. A
+// single probe timeout is often just a lost tail packet.
+//
+#define QUIC_DEFAULT_STANDBY_PROBE_INTERVAL_MS      1000
+#define QUIC_MAX_STANDBY_PROBE_INTERVAL_MS          60000
+#define QUIC_STANDBY_FAILOVER_PTO_COUNT             2
+
+//
+// The minimum and maximum number of slots in each stream type's direct index
+// (see QUIC_STREAM_TYPE_INFO). Must be powers of 2.
+//
+#define QUIC_STREAM_INDEX_MIN_SIZE                  16
+#define QUIC_STREAM_INDEX_MAX_SIZE                  4096
+
+//
+// The maximum number of UDP datagrams any single FLUSH_SEND operation sends,
+// regardless of its time budget.
+//
+#define QUIC_MAX_DATAGRAMS_PER_FLUSH            64
+
+CXPLAT_STATIC_ASSERT(
+    QUIC_MAX_DATAGRAMS_PER_FLUSH < UINT8_MAX / 2,
+    "The datagram count of a flush (plus the last USO batch) must fit in uint8_t");
+
+//
+// A segmented send leaves the host as a single burst, so when pacing, each
+// send batch is limited to the data the pacer releases in this fraction of
+// the RTT (i.e. the congestion window divided by the divisor). Fast paths get
+// batches up to the datapath's limit and slow ones stay smooth. The batch is
+// never limited to fewer than QUIC_MIN_SEND_BATCH_SEGMENTS datagrams.
+//
+#define QUIC_SEND_BATCH_RTT_DIVISOR             8
+#define QUIC_MIN_SEND_BATCH_SEGMENTS            2
+
+//
+// The maximum number of worker loop iterations a partially filled send batch,
+// shared by connections on the same binding and remote address, is held for
+// before it is sent.
+//
+#define QUIC_MAX_COALESCED_SEND_HOLD_COUNT      4
+
+//
+// The number of qlog records a worker buffers before it flushes them to the
+// app's handler, even if it still has work to do.
+//
+#define QUIC_QLOG_BUFFER_RECORD_COUNT           1024
+
+//
+// The number of bytes of pcapng blocks a worker buffers before it flushes
+// them to the app's packet capture handler.
+//
+#define QUIC_CAPTURE_BUFFER_SIZE                0x10000
+
+//
+// The number of recent events each connection's flight recorder keeps.
+//
+#define QUIC_FLIGHT_RECORDER_EVENT_COUNT        16
+CXPLAT_STATIC_ASSERT(IS_POWER_OF_TWO(QUIC_FLIGHT_RECORDER_EVENT_COUNT), "Must be power of two");
+
+//
+// The maximum number of queued connections a worker dequeues and processes per
+// loop iteration. The batch's connection state is prefetched up front, so the
+// cache misses overlap instead of being taken one connection at a time. One
+// disables batching.
+//
+#define QUIC_WORKER_CONNECTION_BATCH_SIZE       4
+
+//
+// The average queue delay (in us) a worker must have before its idle sibling
+// workers start taking queued connections from it.
+//
+#define QUIC_WORKER_STEAL_MIN_QUEUE_DELAY_US    1000
+
+//
+// The maximum number of queued connections an idle worker looks through on a
+// sibling worker for one it can take.
+//
+#define QUIC_WORKER_STEAL_MAX_SCAN              8
+
+//
+// The interval (in us) over which the busy time of each worker, and of each of
+// its connections, is measured for rebalancing connections between workers.
+//
+#define QUIC_WORKER_LOAD_INTERVAL_US            1000000
+
+//
+// The difference in busy percentage between a worker and its least loaded
+// sibling that, once sustained for QUIC_WORKER_REBALANCE_INTERVAL_COUNT load
+// intervals, causes one of the worker's connections to be moved.
+//
+#define QUIC_WORKER_REBALANCE_MIN_LOAD_GAP      25
+#define QUIC_WORKER_REBALANCE_INTERVAL_COUNT    5
+
+//
+// The extra load a worker on another NUMA node is treated as having, both in
+// busy percentage and in queue delay (in us), when choosing a worker to move
+// connections to. Connections moved across nodes lose locality of all their
+// memory, so this is only worth it for a larger imbalance.
+//
+#define QUIC_WORKER_REMOTE_NODE_LOAD_PENALTY    15
+#define QUIC_WORKER_REMOTE_NODE_QUEUE_DELAY_US  2000
+
+//
+// With elastic workers, the average queue delay (in us) of an active worker
+// that causes another worker to be activated, and the minimum time (in us)
+// between two activations.
+//
+#define QUIC_WORKER_ELASTIC_SCALE_UP_QUEUE_DELAY_US 1000
+#define QUIC_WORKER_ELASTIC_SCALE_UP_INTERVAL_US    50000
+
+//
+// With elastic workers, the busy percentage the remaining active workers must
+// stay under, on average, for a worker to be folded away, and the minimum
+// time (in us) since the last activation or folding before doing so.
+//
+#define QUIC_WORKER_ELASTIC_SCALE_DOWN_BUSY_PERCENT 40
+#define QUIC_WORKER_ELASTIC_SCALE_DOWN_INTERVAL_US  5000000
+
+//
+// With adaptive polling, the largest share (in percent) of each load interval
+// a worker may spend polling for new work instead of sleeping.
+//
+#define QUIC_WORKER_ADAPTIVE_POLL_BUDGET_PERCENT    25
+
 //
 // The number of packets we write for a single stream before going to the next
 // one in the round robin.
 //
 #define QUIC_STREAM_SEND_BATCH_COUNT            8
 
+//
+// The number of bytes of send credit, per unit of stream weight, a stream is
+// granted each round of the weighted fair scheduling scheme. A stream's weight
+// is derived from the upper byte of its priority (1 to 256).
+//
+#define QUIC_STREAM_SEND_WEIGHTED_QUANTUM       128
+
+//
+// The number of RFC 9218 priority classes used by the extensible priority
+// scheduling scheme: one for each urgency, split by incremental or not.
+//
+#define QUIC_STREAM_PRIORITY_CLASS_COUNT        ((QUIC_STREAM_PRIORITY_URGENCY_MAX + 1) * 2)
+
 //
 // The maximum number of received packets to batch process at a time.
 //
@@ -344,6 +559,12 @@ CXPLAT_STATIC_ASSERT(
 //
 #define QUIC_MAX_IDEAL_SEND_BUFFER_SIZE         0x8000000 // 134217728
 
+//
+// The maximum number of app memory regions that can be registered for
+// by-reference send buffering on a connection.
+//
+#define QUIC_MAX_SEND_MEMORY_REGIONS            8
+
 //
 // The minimum number of bytes of send allowance we must have before we will
 // send another packet.
@@ -374,6 +595,10 @@ CXPLAT_STATIC_ASSERT(
     QUIC_MAX_PATH_COUNT <= QUIC_ACTIVE_CONNECTION_ID_LIMIT,
     "Should always have enough CIDs for all paths");
 
+CXPLAT_STATIC_ASSERT(
+    QUIC_MAX_STANDBY_PATHS < QUIC_MAX_PATH_COUNT,
+    "Standby paths must leave room for the active path");
+
 //
 // The default value for pacing being enabled or not.
 //
@@ -389,6 +614,12 @@ CXPLAT_STATIC_ASSERT(
 //
 #define QUIC_SEND_PACING_INTERVAL               1000
 
+//
+// The number of microseconds ahead of time paced sends are handed to the
+// datapath, when it supports scheduling their departure (i.e. SO_TXTIME).
+//
+#define QUIC_SEND_PACING_OFFLOAD_HORIZON        4000
+
 //
 // The maximum number of bytes to send in a given key phase
 // before performing a key phase update. Roughly, 274GB.
@@ -421,6 +652,12 @@ CXPLAT_STATIC_ASSERT(
 //
 #define QUIC_DEFAULT_LOAD_BALANCING_MODE        QUIC_LOAD_BALANCING_DISABLED
 
+//
+// The default and maximum number of connections pre-allocated per partition.
+//
+#define QUIC_DEFAULT_CONNECTION_POOL_PREWARM_COUNT  0
+#define QUIC_MAX_CONNECTION_POOL_PREWARM_COUNT      65536
+
 //
 // The default value for datagrams being enabled or not.
 //
@@ -442,7 +679,7 @@ CXPLAT_STATIC_ASSERT(
 // Version of the wire-format for resumption tickets.
 // This needs to be incremented for each change in order or count of fields.
 //
-#define CXPLAT_TLS_RESUMPTION_TICKET_VERSION      1
+#define CXPLAT_TLS_RESUMPTION_TICKET_VERSION      2
 
 //
 // Version of the blob for client resumption tickets.
@@ -482,6 +719,82 @@ CXPLAT_STATIC_ASSERT(
 //
 #define QUIC_DPLPMTUD_INCREMENT                     80
 
+//
+// The maximum number of entries in the DPLPMTUD probe size table.
+//
+#define QUIC_MAX_MTU_PROBE_SIZES                    8
+
+//
+// The default DPLPMTUD probe size table, in increasing order. These are common
+// path MTUs (IPv6 minimum, tunneled and Ethernet), which are probed, largest
+// allowed first, before falling back to QUIC_DPLPMTUD_INCREMENT steps.
+//
+#define QUIC_DPLPMTUD_DEFAULT_PROBE_SIZES           { 1280, 1400, 1450, 1500 }
+
+//
+// Shape of the path metrics cache, which remembers the MTU, RTT and congestion
+// window last measured to recently used remote addresses for new connections.
+// Each set has its own lock and holds a few addresses, of which the least
+// recently updated one is replaced. Entries older than the timeout (in
+// microseconds) are ignored.
+//
+#define QUIC_PATH_METRICS_CACHE_SETS                64
+#define QUIC_PATH_METRICS_CACHE_WAYS                4
+#define QUIC_PATH_METRICS_CACHE_TIMEOUT             QUIC_DPLPMTUD_RAISE_TIMER_TIMEOUT
+
+//
+// Shape of the client resumption ticket cache, which keeps the last ticket
+// received for each server name and configuration. Each set has its own lock
+// and holds a few tickets, of which the oldest one is replaced. Tickets older
+// than the timeout (in microseconds), or longer than the maximum length, are
+// not used.
+//
+#define QUIC_TICKET_CACHE_SETS                      64
+#define QUIC_TICKET_CACHE_WAYS                      4
+#define QUIC_TICKET_CACHE_TIMEOUT                   S_TO_US(2 * 60 * 60ull)
+#define QUIC_TICKET_CACHE_MAX_TICKET_LENGTH         4096
+
+//
+// The length of the random in a TLS ClientHello.
+//
+#define QUIC_CLIENT_RANDOM_LENGTH                   32
+
+//
+// Shape of the 0-RTT anti-replay filter (QUIC_PARAM_GLOBAL_ZERO_RTT_ANTI_REPLAY).
+// With 16 bits per expected entry and 4 hashes, each generation of the bloom
+// filter has a false positive rate of about 0.25% when full. Each shard has
+// at least the minimum number of bits per generation. The shard count must be
+// a power of 2.
+//
+#define QUIC_ANTI_REPLAY_SHARDS                     16
+#define QUIC_ANTI_REPLAY_HASH_COUNT                 4
+#define QUIC_ANTI_REPLAY_BITS_PER_ENTRY             16
+#define QUIC_ANTI_REPLAY_MIN_BITS                   1024
+
+//
+// The number of events a registration event queue initially has room for.
+// The queue doubles in size whenever it fills up. Must be a power of 2.
+//
+#define QUIC_EVENT_QUEUE_INITIAL_CAPACITY           256
+
+//
+// The number of recently derived server Initial secrets each processor caches,
+// indexed by a hash of the destination CID.
+//
+#define QUIC_INITIAL_SECRET_CACHE_SIZE              8
+
+//
+// The maximum number of received datagrams indicated together in a single
+// QUIC_CONNECTION_EVENT_DATAGRAM_BATCH_RECEIVED event.
+//
+#define QUIC_MAX_DATAGRAM_RECEIVE_BATCH_COUNT       64
+
+//
+// The maximum number of streams indicated together in a single
+// QUIC_CONNECTION_EVENT_STREAM_BATCH_RECEIVED event.
+//
+#define QUIC_MAX_STREAM_RECEIVE_BATCH_COUNT         32
+
 //
 // The default congestion control algorithm
 //
@@ -532,6 +845,58 @@ CXPLAT_STATIC_ASSERT(
 //
 #define QUIC_DEFAULT_STREAM_MULTI_RECEIVE_ENABLED    FALSE
 
+//
+// The default settings for reusing the congestion state saved in resumption
+// tickets (Careful Resume).
+//
+#define QUIC_DEFAULT_CAREFUL_RESUME_ENABLED          FALSE
+
+//
+// The default settings for freeing the TLS and crypto stream state as soon as
+// the handshake is confirmed.
+//
+#define QUIC_DEFAULT_RELEASE_HANDSHAKE_STATE_ENABLED FALSE
+
+//
+// The default settings for caching client resumption tickets in the library
+// and using them automatically on new connections.
+//
+#define QUIC_DEFAULT_RESUMPTION_TICKET_CACHE_ENABLED FALSE
+
+//
+// The default settings for adapting the local ACK delay to the observed
+// reordering, loss and congestion marks.
+//
+#define QUIC_DEFAULT_ADAPTIVE_ACK_DELAY_ENABLED     FALSE
+
+//
+// When the adaptive ACK delay is enabled, each delayed ACK timer expiration
+// grows the delay by MaxAckDelayMs >> this value, until it is back at
+// MaxAckDelayMs.
+//
+#define QUIC_ADAPTIVE_ACK_DELAY_GROWTH_SHIFT        3
+
+//
+// The default percent change in RTT, congestion window or bandwidth needed to
+// indicate QUIC_CONNECTION_EVENT_NETWORK_STATISTICS. Zero indicates the event
+// on every ACK.
+//
+#define QUIC_DEFAULT_NET_STATS_EVENT_THRESHOLD       0
+
+//
+// The default time (in milliseconds) without any packets sent or received
+// after which a connection releases the memory it only needs while active.
+// Zero disables hibernation.
+//
+#define QUIC_DEFAULT_HIBERNATE_TIMEOUT_MS            0
+
+//
+// The default minimum connection flow control credit (in bytes) a server
+// grants in its first 1-RTT packet after accepting 0-RTT. Zero disables the
+// early grant.
+//
+#define QUIC_DEFAULT_EARLY_CREDIT_WINDOW             0
+
 //
 // The number of rounds in Cubic Slow Start to sample RTT.
 //
@@ -589,6 +954,8 @@ CXPLAT_STATIC_ASSERT(
 #define QUIC_TP_FLAG_TIMESTAMP_RECV_ENABLED                 0x01000000
 #define QUIC_TP_FLAG_TIMESTAMP_SEND_ENABLED                 0x02000000
 #define QUIC_TP_FLAG_TIMESTAMP_SHIFT                        24
+#define QUIC_TP_FLAG_DATAGRAM_FEC                           0x04000000
+#define QUIC_TP_FLAG_STREAM_COMPRESSION                     0x08000000
 
 #define QUIC_TP_MAX_PACKET_SIZE_DEFAULT                     65527
 #define QUIC_TP_MAX_UDP_PAYLOAD_SIZE_MIN                    1200
@@ -621,6 +988,7 @@ CXPLAT_STATIC_ASSERT(
 #define QUIC_SETTING_RETRY_MEMORY_FRACTION          "RetryMemoryFraction"
 #define QUIC_SETTING_LOAD_BALANCING_MODE            "LoadBalancingMode"
 #define QUIC_SETTING_FIXED_SERVER_ID                "FixedServerID"
+#define QUIC_SETTING_CONNECTION_POOL_PREWARM_COUNT  "ConnectionPoolPrewarmCount"
 #define QUIC_SETTING_MAX_WORKER_QUEUE_DELAY         "MaxWorkerQueueDelayMs"
 #define QUIC_SETTING_MAX_STATELESS_OPERATIONS       "MaxStatelessOperations"
 #define QUIC_SETTING_MAX_BINDING_STATELESS_OPERATIONS "MaxBindingStatelessOperations"
@@ -639,6 +1007,13 @@ CXPLAT_STATIC_ASSERT(
 #define QUIC_SETTING_ONE_WAY_DELAY_ENABLED          "OneWayDelayEnabled"
 #define QUIC_SETTING_NET_STATS_EVENT_ENABLED        "NetStatsEventEnabled"
 #define QUIC_SETTING_STREAM_MULTI_RECEIVE_ENABLED   "StreamMultiReceiveEnabled"
+#define QUIC_SETTING_CAREFUL_RESUME_ENABLED         "CarefulResumeEnabled"
+#define QUIC_SETTING_RELEASE_HANDSHAKE_STATE_ENABLED "ReleaseHandshakeStateEnabled"
+#define QUIC_SETTING_RESUMPTION_TICKET_CACHE_ENABLED "ResumptionTicketCacheEnabled"
+#define QUIC_SETTING_ADAPTIVE_ACK_DELAY_ENABLED     "AdaptiveAckDelayEnabled"
+#define QUIC_SETTING_NET_STATS_EVENT_THRESHOLD      "NetStatsEventThreshold"
+#define QUIC_SETTING_HIBERNATE_TIMEOUT_MS           "HibernateTimeoutMs"
+#define QUIC_SETTING_EARLY_CREDIT_WINDOW            "EarlyCreditWindow"
 
 #define QUIC_SETTING_INITIAL_WINDOW_PACKETS         "InitialWindowPackets"
 #define QUIC_SETTING_SEND_IDLE_TIMEOUT_MS           "SendIdleTimeoutMs"
@@ -8,6 +8,13 @@ Abstract:
     A set of unique 64-bit values, stored as an array of subranges ordered from
     smallest to largest.
 
+    The array is used as a circular buffer (see QUIC_RANGE.Head). Dropping the
+    smallest subranges (as the ACK tracker and the send/receive buffers do as
+    data is acknowledged or drained) is O(1), and inserting or removing a
+    subrange only shifts the subranges on the shorter side of it. Under heavy
+    loss and reordering most changes happen close to the largest values, so
+    they stay cheap even with thousands of subranges.
+
 --*/
 
 #include "precomp.h"
@@ -23,6 +30,7 @@ QuicRangeInitialize(
     )
 {
     Range->UsedLength = 0;
+    Range->Head = 0;
     Range->AllocLength = QUIC_RANGE_INITIAL_SUB_COUNT;
     Range->MaxAllocSize = MaxAllocSize;
     CXPLAT_FRE_ASSERT(sizeof(QUIC_SUBRANGE) * QUIC_RANGE_INITIAL_SUB_COUNT < MaxAllocSize);
@@ -47,6 +55,83 @@ QuicRangeReset(
     )
 {
     Range->UsedLength = 0;
+    Range->Head = 0;
+}
+
+//
+// Copies a number of subranges, starting at the given index, into a flat
+// array.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicRangeCopyOut(
+    _In_ const QUIC_RANGE* Range,
+    _In_ uint32_t Index,
+    _In_ uint32_t Count,
+    _Out_writes_(Count) QUIC_SUBRANGE* Dest
+    )
+{
+    if (Count == 0) {
+        return;
+    }
+    const uint32_t Start = (Range->Head + Index) & (Range->AllocLength - 1);
+    const uint32_t FirstCount = CXPLAT_MIN(Count, Range->AllocLength - Start);
+    memcpy(Dest, Range->SubRanges + Start, FirstCount * sizeof(QUIC_SUBRANGE));
+    if (FirstCount < Count) {
+        memcpy(
+            Dest + FirstCount,
+            Range->SubRanges,
+            (Count - FirstCount) * sizeof(QUIC_SUBRANGE));
+    }
+}
+
+//
+// Moves a number of subranges from one index to another, taking care of the
+// wrap around the end of the array. The source and destination may overlap.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicRangeMoveSubranges(
+    _Inout_ QUIC_RANGE* Range,
+    _In_ uint32_t DestIndex,
+    _In_ uint32_t SrcIndex,
+    _In_ uint32_t Count
+    )
+{
+    const uint32_t Mask = Range->AllocLength - 1;
+    if (DestIndex < SrcIndex) {
+        //
+        // Moving down, so copy from the front.
+        //
+        while (Count != 0) {
+            const uint32_t Src = (Range->Head + SrcIndex) & Mask;
+            const uint32_t Dest = (Range->Head + DestIndex) & Mask;
+            uint32_t Run = CXPLAT_MIN(Count, Range->AllocLength - Src);
+            Run = CXPLAT_MIN(Run, Range->AllocLength - Dest);
+            memmove(
+                Range->SubRanges + Dest,
+                Range->SubRanges + Src,
+                Run * sizeof(QUIC_SUBRANGE));
+            SrcIndex += Run;
+            DestIndex += Run;
+            Count -= Run;
+        }
+    } else if (DestIndex > SrcIndex) {
+        //
+        // Moving up, so copy from the back.
+        //
+        while (Count != 0) {
+            const uint32_t SrcEnd = ((Range->Head + SrcIndex + Count - 1) & Mask) + 1;
+            const uint32_t DestEnd = ((Range->Head + DestIndex + Count - 1) & Mask) + 1;
+            uint32_t Run = CXPLAT_MIN(Count, SrcEnd);
+            Run = CXPLAT_MIN(Run, DestEnd);
+            memmove(
+                Range->SubRanges + DestEnd - Run,
+                Range->SubRanges + SrcEnd - Run,
+                Run * sizeof(QUIC_SUBRANGE));
+            Count -= Run;
+        }
+    }
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -87,32 +172,19 @@ QuicRangeGrow(
     //
 
     CXPLAT_DBG_ASSERT(Range->SubRanges != 0);
-    if (NextIndex == 0) {
-        memcpy(
-            NewSubRanges + 1,
-            Range->SubRanges,
-            Range->UsedLength * sizeof(QUIC_SUBRANGE));
-    } else if (NextIndex == Range->UsedLength) {
-        memcpy(
-            NewSubRanges,
-            Range->SubRanges,
-            Range->UsedLength * sizeof(QUIC_SUBRANGE));
-    } else {
-        memcpy(
-            NewSubRanges,
-            Range->SubRanges,
-            NextIndex * sizeof(QUIC_SUBRANGE));
-        memcpy(
-            NewSubRanges + NextIndex + 1,
-            Range->SubRanges + NextIndex,
-            (Range->UsedLength - NextIndex) * sizeof(QUIC_SUBRANGE));
-    }
+    QuicRangeCopyOut(Range, 0, NextIndex, NewSubRanges);
+    QuicRangeCopyOut(
+        Range,
+        NextIndex,
+        Range->UsedLength - NextIndex,
+        NewSubRanges + NextIndex + 1);
 
     if (Range->AllocLength != QUIC_RANGE_INITIAL_SUB_COUNT) {
         CXPLAT_FREE(Range->SubRanges, QUIC_POOL_RANGE);
     }
     Range->SubRanges = NewSubRanges;
     Range->AllocLength = NewAllocLength;
+    Range->Head = 0;
     Range->UsedLength++; // For the next write index.
 
     return TRUE;
@@ -132,46 +204,42 @@ QuicRangeMakeSpace(
     CXPLAT_DBG_ASSERT(*Index <= Range->UsedLength);
 
     if (Range->UsedLength == Range->AllocLength) {
-        if (!QuicRangeGrow(Range, *Index)) {
-            //
-            // We either can't or aren't allowed to grow any more. If we weren't
-            // trying to append to the front, age out the smallest values to
-            // make room for a new larger one.
-            //
-            if (Range->MaxAllocSize == QUIC_MAX_RANGE_ALLOC_SIZE ||
-                *Index == 0) {
-                return NULL;
-            }
+        if (QuicRangeGrow(Range, *Index)) {
+            return QuicRangeGet(Range, *Index);
+        }
 
-            if (*Index > 1) {
-                memmove(
-                    Range->SubRanges,
-                    Range->SubRanges + 1,
-                    (*Index - 1) * sizeof(QUIC_SUBRANGE));
-            }
-            (*Index)--; // Actually going to be inserting 1 before where requested.
+        //
+        // We either can't or aren't allowed to grow any more. If we weren't
+        // trying to append to the front, age out the smallest values to
+        // make room for a new larger one.
+        //
+        if (Range->MaxAllocSize == QUIC_MAX_RANGE_ALLOC_SIZE ||
+            *Index == 0) {
+            return NULL;
         }
+
+        Range->Head = (Range->Head + 1) & (Range->AllocLength - 1);
+        Range->UsedLength--;
+        (*Index)--; // Actually going to be inserting 1 before where requested.
+    }
+
+    CXPLAT_DBG_ASSERT(Range->SubRanges != 0);
+    if (*Index < Range->UsedLength - *Index) {
+        //
+        // Closer to the front, so shift the smaller subranges down a slot.
+        //
+        Range->Head = (Range->Head - 1) & (Range->AllocLength - 1);
+        QuicRangeMoveSubranges(Range, 0, 1, *Index);
     } else {
-        CXPLAT_DBG_ASSERT(Range->SubRanges != 0);
-        if (*Index == 0) {
-            memmove(
-                Range->SubRanges + 1,
-                Range->SubRanges,
-                Range->UsedLength * sizeof(QUIC_SUBRANGE));
-        } else if (*Index == Range->UsedLength) {
-            //
-            // No need to copy. Appending to the end.
-            //
-        } else {
-            memmove(
-                Range->SubRanges + *Index + 1,
-                Range->SubRanges + *Index,
-                (Range->UsedLength - *Index) * sizeof(QUIC_SUBRANGE));
-        }
-        Range->UsedLength++; // For the new write.
+        //
+        // Closer to the end (or appending), so shift the larger subranges up a
+        // slot.
+        //
+        QuicRangeMoveSubranges(Range, *Index + 1, *Index, Range->UsedLength - *Index);
     }
+    Range->UsedLength++; // For the new write.
 
-    return Range->SubRanges + *Index;
+    return QuicRangeGet(Range, *Index);
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -185,14 +253,21 @@ QuicRangeRemoveSubranges(
     CXPLAT_DBG_ASSERT(Count > 0);
     CXPLAT_DBG_ASSERT(Index + Count <= Range->UsedLength);
 
-    if (Index + Count < Range->UsedLength) {
-        memmove(
-            Range->SubRanges + Index,
-            Range->SubRanges + Index + Count,
-            (Range->UsedLength - Index - Count) * sizeof(QUIC_SUBRANGE));
+    const uint32_t TailCount = Range->UsedLength - Index - Count;
+    if (Index < TailCount) {
+        //
+        // Fewer subranges before the removed ones, so shift those up instead.
+        //
+        QuicRangeMoveSubranges(Range, Count, 0, Index);
+        Range->Head = (Range->Head + Count) & (Range->AllocLength - 1);
+    } else {
+        QuicRangeMoveSubranges(Range, Index, Index + Count, TailCount);
     }
 
     Range->UsedLength -= Count;
+    if (Range->UsedLength == 0) {
+        Range->Head = 0;
+    }
 
     if (Range->AllocLength >= QUIC_RANGE_INITIAL_SUB_COUNT * 2 &&
         Range->UsedLength < Range->AllocLength / 4) {
@@ -210,13 +285,11 @@ QuicRangeRemoveSubranges(
                 return FALSE;
             }
         }
-        memcpy(
-            NewSubRanges,
-            Range->SubRanges,
-            Range->UsedLength * sizeof(QUIC_SUBRANGE));
+        QuicRangeCopyOut(Range, 0, Range->UsedLength, NewSubRanges);
         CXPLAT_FREE(Range->SubRanges, QUIC_POOL_RANGE);
         Range->SubRanges = NewSubRanges;
         Range->AllocLength = NewAllocLength;
+        Range->Head = 0;
         return TRUE;
     }
 
@@ -363,12 +436,12 @@ QuicRangeAddRange(
 
         uint32_t RemoveCount = j - (i + 1);
         if (RemoveCount != 0) {
-            if (QuicRangeRemoveSubranges(Range, i + 1, RemoveCount)) {
-                //
-                // The subranges were reallocated, so update our Sub pointer.
-                //
-                Sub = QuicRangeGet(Range, i);
-            }
+            QuicRangeRemoveSubranges(Range, i + 1, RemoveCount);
+            //
+            // The subranges may have been moved or reallocated, so update our
+            // Sub pointer.
+            //
+            Sub = QuicRangeGet(Range, i);
         }
     }
 
@@ -403,22 +476,27 @@ QuicRangeRemoveRange(
     //
 
     uint32_t i;
-    QUIC_SUBRANGE* Sub = NULL;
+    QUIC_SUBRANGE* Sub;
     QUIC_SUBRANGE* Test;
 
+    if (Count == 0) {
+        return TRUE;
+    }
+
     //
     // Find the leftmost overlapping subrange.
     //
-    for (i = 0; (Test = QuicRangeGetSafe(Range, i)) != NULL; i++) {
-        if (Test->Low < Low + Count &&
-            Test->Low + Test->Count > Low) {
-            Sub = Test;
-            break;
-        }
-    }
-    if (Sub == NULL) {
+    QUIC_RANGE_SEARCH_KEY Key = { Low, Low + Count - 1 };
+    int Result = QuicRangeSearch(Range, &Key);
+    if (IS_INSERT_INDEX(Result)) {
         return TRUE;
     }
+    i = (uint32_t)Result;
+    while ((Test = QuicRangeGetSafe(Range, i - 1)) != NULL &&
+            QuicRangeCompare(&Key, Test) == 0) {
+        --i;
+    }
+    Sub = QuicRangeGet(Range, i);
 
     if (Sub->Low + Sub->Count > Low + Count &&
         Sub->Low < Low) {
@@ -432,7 +510,7 @@ QuicRangeRemoveRange(
         if (NewSub == NULL) {
             return FALSE;
         }
-        *NewSub = *Sub;
+        *NewSub = *QuicRangeGet(Range, i + 1); // Sub may have moved.
         Sub = NewSub;
     }
 
@@ -479,22 +557,19 @@ QuicRangeSetMin(
     )
 {
     //
-    // Drop all values less than "low".
+    // Drop all values less than "low". Only the subrange containing "low" (if
+    // any) needs to be trimmed; all the ones before it are removed.
     //
-    uint32_t i = 0;
-    QUIC_SUBRANGE* Sub = NULL;
-    while (i < QuicRangeSize(Range)) {
-        Sub = QuicRangeGet(Range, i);
-        if (Sub->Low >= Low) {
-            break;
-        }
-
-        if (QuicRangeGetHigh(Sub) >= Low) {
-            Sub->Count -= Low - Sub->Low;
-            Sub->Low = Low;
-            break;
-        }
-        i++;
+    uint32_t i;
+    QUIC_RANGE_SEARCH_KEY Key = { Low, Low };
+    int Result = QuicRangeSearch(Range, &Key);
+    if (IS_FIND_INDEX(Result)) {
+        i = (uint32_t)Result;
+        QUIC_SUBRANGE* Sub = QuicRangeGet(Range, i);
+        Sub->Count -= Low - Sub->Low;
+        Sub->Low = Low;
+    } else {
+        i = INSERT_INDEX_TO_FIND_INDEX(Result);
     }
     if (i > 0) {
         QuicRangeRemoveSubranges(Range, 0, i);
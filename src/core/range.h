@@ -55,6 +55,13 @@ typedef struct QUIC_RANGE {
     //
     uint32_t UsedLength;
 
+    //
+    // The array slot holding the smallest subrange. The array is used as a
+    // circular buffer so that the smallest subranges can be dropped, and new
+    // ones inserted near either end, without shifting the whole array.
+    //
+    uint32_t Head;
+
     //
     // The number of allocated subranges in the 'SubRanges' array.
     //
@@ -96,7 +103,7 @@ QuicRangeGet(
     _In_ uint32_t Index
     )
 {
-    return &Range->SubRanges[Index];
+    return &Range->SubRanges[(Range->Head + Index) & (Range->AllocLength - 1)];
 }
 
 //
@@ -110,7 +117,7 @@ QuicRangeGetSafe(
     _In_ uint32_t Index
     )
 {
-    return Index < QuicRangeSize(Range) ? &Range->SubRanges[Index] : NULL;
+    return Index < QuicRangeSize(Range) ? QuicRangeGet(Range, Index) : NULL;
 }
 
 //
@@ -286,7 +293,9 @@ QuicRangeAddValue(
 // O(n)      when QUIC_RANGE_USE_BINARY_SEARCH == 0
 // O(log(n)) when QUIC_RANGE_USE_BINARY_SEARCH == 1
 // Adds a range of contiguous values. Returns the updated subrange if
-// successful or NULL on an allocation failure.
+// successful or NULL on an allocation failure. Creating a new subrange only
+// shifts the subranges between the insert point and the nearer end, so
+// inserts close to the largest (or smallest) values stay cheap.
 //
 _IRQL_requires_max_(DISPATCH_LEVEL)
 _Success_(return != NULL)
@@ -299,8 +308,10 @@ QuicRangeAddRange(
     );
 
 //
+// O(min(Index, n - Index - Count))
 // Removes a number of subranges from the range. Returns TRUE if the list was
-// shrunk (reallocated) because of the removal operation.
+// shrunk (reallocated) because of the removal operation. Either way, pointers
+// to the remaining subranges may no longer be valid.
 //
 _IRQL_requires_max_(DISPATCH_LEVEL)
 BOOLEAN
@@ -311,8 +322,9 @@ QuicRangeRemoveSubranges(
     );
 
 //
-// O(n) Removes a range of values from the range object. Returns TRUE if
-// successful or FALSE on an allocation failure.
+// O(log(n)) to find the values, plus the cost of removing any subranges they
+// fully cover. Removes a range of values from the range object. Returns TRUE
+// if successful or FALSE on an allocation failure.
 //
 _IRQL_requires_max_(DISPATCH_LEVEL)
 _Success_(return != FALSE)
@@ -324,7 +336,7 @@ QuicRangeRemoveRange(
     );
 
 //
-// Drops all values in the range below the input value.
+// O(log(n)) Drops all values in the range below the input value.
 //
 _IRQL_requires_max_(DISPATCH_LEVEL)
 void
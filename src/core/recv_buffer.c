@@ -24,7 +24,13 @@ Abstract:
 
     When physical buffer space runs out, assuming more 'virtual' space is
     available, the physical buffer will be reallocated and copied over.
-    Physical buffer space always doubles in size as it grows.
+    Physical buffer space always doubles in size as it grows. In multiple
+    receive mode, nothing is copied; the new chunk is simply chained after the
+    existing ones.
+
+    Chunks up to 64KB are allocated from size-classed pools (usually the
+    per-processor ones owned by the library) so that growing and shrinking
+    many streams doesn't constantly hit the general purpose allocator.
 
     The VirtualBufferLength is what is used to report the maximum allowed
     stream offset to the peer. Again, if the application drains at a fast
@@ -38,7 +44,17 @@ Abstract:
     commit. We must always be willing/able to allocate the buffer length
     advertised to the peer.
 
-    Currently, only growing the virtual buffer length is supported.
+    The virtual buffer length may also shrink (for instance, when the app
+    drains a stream slowly), but never below what was already advertised to
+    the peer. The physical buffer isn't affected.
+
+    In app-owned mode, the chunks are provided by the application and are never
+    reallocated or used as circular buffers. The buffer only has as much
+    physical space as the app has provided, and a write beyond that space fails
+    with QUIC_STATUS_OUT_OF_MEMORY so that the packet is dropped and later
+    retransmitted by the peer. The virtual buffer length is kept at least as
+    large as the provided space, and shrinks as data is drained because that
+    memory is handed back to the app.
 
 --*/
 
@@ -47,6 +63,117 @@ Abstract:
 #include "recv_buffer.c.clog.h"
 #endif
 
+CXPLAT_STATIC_ASSERT(
+    QUIC_DEFAULT_STREAM_RECV_BUFFER_SIZE >= QUIC_RECV_CHUNK_POOL_MIN_LENGTH,
+    "The default stream receive buffer should come from a chunk pool");
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicRecvChunkPoolInitialize(
+    _Inout_ QUIC_RECV_CHUNK_POOL* ChunkPool
+    )
+{
+    for (uint32_t i = 0; i < ARRAYSIZE(ChunkPool->Pools); i++) {
+        CxPlatPoolInitialize(
+            FALSE,
+            sizeof(QUIC_RECV_CHUNK) + (QUIC_RECV_CHUNK_POOL_MIN_LENGTH << i),
+            QUIC_POOL_RECVBUF,
+            ChunkPool->Pools + i);
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicRecvChunkPoolUninitialize(
+    _In_ QUIC_RECV_CHUNK_POOL* ChunkPool
+    )
+{
+    for (uint32_t i = 0; i < ARRAYSIZE(ChunkPool->Pools); i++) {
+        CxPlatPoolUninitialize(ChunkPool->Pools + i);
+    }
+}
+
+//
+// Returns the pool for the size class of the chunk length, or NULL if the
+// length isn't pooled.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+CXPLAT_POOL*
+QuicRecvChunkPoolGetPool(
+    _In_opt_ QUIC_RECV_CHUNK_POOL* ChunkPool,
+    _In_ uint32_t AllocLength
+    )
+{
+    if (ChunkPool != NULL) {
+        uint32_t ClassLength = QUIC_RECV_CHUNK_POOL_MIN_LENGTH;
+        for (uint32_t i = 0; i < ARRAYSIZE(ChunkPool->Pools); i++, ClassLength <<= 1) {
+            if (AllocLength == ClassLength) {
+                return ChunkPool->Pools + i;
+            }
+        }
+    }
+    return NULL;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_RECV_CHUNK*
+QuicRecvBufferAllocChunk(
+    _In_ QUIC_RECV_BUFFER* RecvBuffer,
+    _In_ uint32_t AllocLength
+    )
+{
+    CXPLAT_POOL* Pool = QuicRecvChunkPoolGetPool(RecvBuffer->ChunkPool, AllocLength);
+    QUIC_RECV_CHUNK* Chunk =
+        Pool != NULL ?
+            CxPlatPoolAlloc(Pool) :
+            CXPLAT_ALLOC_NONPAGED(sizeof(QUIC_RECV_CHUNK) + AllocLength, QUIC_POOL_RECVBUF);
+    if (Chunk == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "recv_buffer",
+            sizeof(QUIC_RECV_CHUNK) + AllocLength);
+        return NULL;
+    }
+    QuicRecvChunkInitialize(Chunk, AllocLength);
+    if (RecvBuffer->UsageCounter != NULL) {
+        *RecvBuffer->UsageCounter += AllocLength;
+    }
+    InterlockedExchangeAdd64(
+        (int64_t*)&MsQuicLib.CurrentRecvBufferUsage, (int64_t)AllocLength);
+    QuicLibraryEvaluateMemoryPressure();
+    return Chunk;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicRecvBufferFreeChunk(
+    _In_ QUIC_RECV_BUFFER* RecvBuffer,
+    _In_ QUIC_RECV_CHUNK* Chunk
+    )
+{
+    if (Chunk == RecvBuffer->PreallocatedChunk) {
+        return;
+    }
+    if (RecvBuffer->RecvMode == QUIC_RECV_BUF_MODE_APP_OWNED) {
+        CXPLAT_FREE(Chunk, QUIC_POOL_RECVBUF); // Only the header is ours.
+        return;
+    }
+    if (RecvBuffer->UsageCounter != NULL) {
+        *RecvBuffer->UsageCounter -= Chunk->AllocLength;
+    }
+    InterlockedExchangeAdd64(
+        (int64_t*)&MsQuicLib.CurrentRecvBufferUsage,
+        -1 * (int64_t)Chunk->AllocLength);
+    QuicLibraryEvaluateMemoryPressure();
+    CXPLAT_POOL* Pool = QuicRecvChunkPoolGetPool(RecvBuffer->ChunkPool, Chunk->AllocLength);
+    if (Pool != NULL) {
+        CxPlatPoolFree(Pool, Chunk);
+    } else {
+        CXPLAT_FREE(Chunk, QUIC_POOL_RECVBUF);
+    }
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 QUIC_STATUS // TODO - Can only fail if PreallocatedChunk == NULL
 QuicRecvBufferInitialize(
@@ -54,11 +181,34 @@ QuicRecvBufferInitialize(
     _In_ uint32_t AllocBufferLength,
     _In_ uint32_t VirtualBufferLength,
     _In_ QUIC_RECV_BUF_MODE RecvMode,
-    _In_opt_ QUIC_RECV_CHUNK* PreallocatedChunk
+    _In_opt_ QUIC_RECV_CHUNK* PreallocatedChunk,
+    _In_opt_ QUIC_RECV_CHUNK_POOL* ChunkPool
     )
 {
     QUIC_STATUS Status;
 
+    RecvBuffer->ChunkPool = ChunkPool;
+    RecvBuffer->UsageCounter = NULL;
+
+    if (RecvMode == QUIC_RECV_BUF_MODE_APP_OWNED) {
+        //
+        // All chunks will be provided by the app later.
+        //
+        CXPLAT_DBG_ASSERT(PreallocatedChunk == NULL);
+        UNREFERENCED_PARAMETER(AllocBufferLength);
+        QuicRangeInitialize(QUIC_MAX_RANGE_ALLOC_SIZE, &RecvBuffer->WrittenRanges);
+        CxPlatListInitializeHead(&RecvBuffer->Chunks);
+        RecvBuffer->PreallocatedChunk = NULL;
+        RecvBuffer->BaseOffset = 0;
+        RecvBuffer->ReadStart = 0;
+        RecvBuffer->ReadPendingLength = 0;
+        RecvBuffer->ReadLength = 0;
+        RecvBuffer->Capacity = 0;
+        RecvBuffer->VirtualBufferLength = VirtualBufferLength;
+        RecvBuffer->RecvMode = RecvMode;
+        return QUIC_STATUS_SUCCESS;
+    }
+
     CXPLAT_DBG_ASSERT(AllocBufferLength != 0 && (AllocBufferLength & (AllocBufferLength - 1)) == 0);       // Power of 2
     CXPLAT_DBG_ASSERT(VirtualBufferLength != 0 && (VirtualBufferLength & (VirtualBufferLength - 1)) == 0); // Power of 2
     CXPLAT_DBG_ASSERT(AllocBufferLength <= VirtualBufferLength);
@@ -69,13 +219,8 @@ QuicRecvBufferInitialize(
         Chunk = PreallocatedChunk;
     } else {
         RecvBuffer->PreallocatedChunk = NULL;
-        Chunk = CXPLAT_ALLOC_NONPAGED(sizeof(QUIC_RECV_CHUNK) + AllocBufferLength, QUIC_POOL_RECVBUF);
+        Chunk = QuicRecvBufferAllocChunk(RecvBuffer, AllocBufferLength);
         if (Chunk == NULL) {
-            QuicTraceEvent(
-                AllocFailure,
-                "Allocation of '%s' failed. (%llu bytes)",
-                "recv_buffer",
-                sizeof(QUIC_RECV_CHUNK) + AllocBufferLength);
             Status = QUIC_STATUS_OUT_OF_MEMORY;
             goto Error;
         }
@@ -84,8 +229,7 @@ QuicRecvBufferInitialize(
     QuicRangeInitialize(QUIC_MAX_RANGE_ALLOC_SIZE, &RecvBuffer->WrittenRanges);
     CxPlatListInitializeHead(&RecvBuffer->Chunks);
     CxPlatListInsertHead(&RecvBuffer->Chunks, &Chunk->Link);
-    Chunk->AllocLength = AllocBufferLength;
-    Chunk->ExternalReference = FALSE;
+    QuicRecvChunkInitialize(Chunk, AllocBufferLength);
     RecvBuffer->BaseOffset = 0;
     RecvBuffer->ReadStart = 0;
     RecvBuffer->ReadPendingLength = 0;
@@ -100,6 +244,75 @@ Error:
     return Status;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicRecvBufferInitializeDeferred(
+    _Inout_ QUIC_RECV_BUFFER* RecvBuffer,
+    _In_ uint32_t AllocBufferLength,
+    _In_ uint32_t VirtualBufferLength,
+    _In_ QUIC_RECV_BUF_MODE RecvMode,
+    _In_opt_ QUIC_RECV_CHUNK_POOL* ChunkPool
+    )
+{
+    if (RecvMode == QUIC_RECV_BUF_MODE_APP_OWNED) {
+        QUIC_STATUS Status =
+            QuicRecvBufferInitialize(
+                RecvBuffer,
+                AllocBufferLength,
+                VirtualBufferLength,
+                RecvMode,
+                NULL,
+                ChunkPool);
+        CXPLAT_DBG_ASSERT(QUIC_SUCCEEDED(Status)); // Can't fail in app-owned mode.
+        UNREFERENCED_PARAMETER(Status);
+        return;
+    }
+
+    CXPLAT_DBG_ASSERT(AllocBufferLength != 0 && (AllocBufferLength & (AllocBufferLength - 1)) == 0);       // Power of 2
+    CXPLAT_DBG_ASSERT(VirtualBufferLength != 0 && (VirtualBufferLength & (VirtualBufferLength - 1)) == 0); // Power of 2
+    CXPLAT_DBG_ASSERT(AllocBufferLength <= VirtualBufferLength);
+
+    //
+    // No chunk is allocated yet. Capacity holds the length of the first chunk,
+    // which is allocated on the first write (see QuicRecvBufferWrite).
+    //
+    RecvBuffer->ChunkPool = ChunkPool;
+    RecvBuffer->UsageCounter = NULL;
+    QuicRangeInitialize(QUIC_MAX_RANGE_ALLOC_SIZE, &RecvBuffer->WrittenRanges);
+    CxPlatListInitializeHead(&RecvBuffer->Chunks);
+    RecvBuffer->PreallocatedChunk = NULL;
+    RecvBuffer->BaseOffset = 0;
+    RecvBuffer->ReadStart = 0;
+    RecvBuffer->ReadPendingLength = 0;
+    RecvBuffer->ReadLength = 0;
+    RecvBuffer->Capacity = AllocBufferLength;
+    RecvBuffer->VirtualBufferLength = VirtualBufferLength;
+    RecvBuffer->RecvMode = RecvMode;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicRecvBufferSetUsageCounter(
+    _Inout_ QUIC_RECV_BUFFER* RecvBuffer,
+    _In_ uint64_t* UsageCounter
+    )
+{
+    CXPLAT_DBG_ASSERT(RecvBuffer->UsageCounter == NULL);
+    RecvBuffer->UsageCounter = UsageCounter;
+    if (RecvBuffer->RecvMode == QUIC_RECV_BUF_MODE_APP_OWNED) {
+        return;
+    }
+
+    for (CXPLAT_LIST_ENTRY* Entry = RecvBuffer->Chunks.Flink;
+         Entry != &RecvBuffer->Chunks;
+         Entry = Entry->Flink) {
+        QUIC_RECV_CHUNK* Chunk = CXPLAT_CONTAINING_RECORD(Entry, QUIC_RECV_CHUNK, Link);
+        if (Chunk != RecvBuffer->PreallocatedChunk) {
+            *UsageCounter += Chunk->AllocLength;
+        }
+    }
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 void
 QuicRecvBufferUninitialize(
@@ -113,9 +326,7 @@ QuicRecvBufferUninitialize(
                 CxPlatListRemoveHead(&RecvBuffer->Chunks),
                 QUIC_RECV_CHUNK,
                 Link);
-        if (Chunk != RecvBuffer->PreallocatedChunk) {
-            CXPLAT_FREE(Chunk, QUIC_POOL_RECVBUF);
-        }
+        QuicRecvBufferFreeChunk(RecvBuffer, Chunk);
     }
 }
 
@@ -174,6 +385,19 @@ QuicRecvBufferIncreaseVirtualBufferLength(
     RecvBuffer->VirtualBufferLength = NewLength;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicRecvBufferDecreaseVirtualBufferLength(
+    _In_ QUIC_RECV_BUFFER* RecvBuffer,
+    _In_ uint32_t NewLength
+    )
+{
+    CXPLAT_DBG_ASSERT(RecvBuffer->RecvMode != QUIC_RECV_BUF_MODE_APP_OWNED);
+    CXPLAT_DBG_ASSERT(NewLength != 0 && (NewLength & (NewLength - 1)) == 0); // Power of 2
+    CXPLAT_DBG_ASSERT(NewLength <= RecvBuffer->VirtualBufferLength);
+    RecvBuffer->VirtualBufferLength = NewLength;
+}
+
 //
 // Allocates a new contiguous buffer of the target size. Depending on the
 // receive mode and any external references, this may copy the existing buffer,
@@ -198,21 +422,23 @@ QuicRecvBufferResize(
     CXPLAT_DBG_ASSERT(TargetBufferLength > LastChunk->AllocLength); // Should only be called when buffer needs to grow
     BOOLEAN LastChunkIsFirst = LastChunk->Link.Blink == &RecvBuffer->Chunks;
 
-    QUIC_RECV_CHUNK* NewChunk =
-        CXPLAT_ALLOC_NONPAGED(sizeof(QUIC_RECV_CHUNK) + TargetBufferLength, QUIC_POOL_RECVBUF);
+    QUIC_RECV_CHUNK* NewChunk = QuicRecvBufferAllocChunk(RecvBuffer, TargetBufferLength);
     if (NewChunk == NULL) {
-        QuicTraceEvent(
-            AllocFailure,
-            "Allocation of '%s' failed. (%llu bytes)",
-            "recv_buffer",
-            sizeof(QUIC_RECV_CHUNK) + TargetBufferLength);
         return FALSE;
     }
 
-    NewChunk->AllocLength = TargetBufferLength;
-    NewChunk->ExternalReference = FALSE;
     CxPlatListInsertTail(&RecvBuffer->Chunks, &NewChunk->Link);
 
+    if (RecvBuffer->RecvMode == QUIC_RECV_BUF_MODE_MULTIPLE) {
+        //
+        // In multiple receive mode, chunks after the first are always used
+        // linearly, so the new chunk can just be chained after the existing
+        // ones, whether or not they are referenced by the app. This avoids
+        // copying the buffered data every time the buffer grows.
+        //
+        return TRUE;
+    }
+
     if (!LastChunk->ExternalReference) {
         //
         // If the last chunk isn't externally referenced, then we can just
@@ -258,23 +484,17 @@ QuicRecvBufferResize(
         }
 
         CxPlatListEntryRemove(&LastChunk->Link);
-        if (LastChunk != RecvBuffer->PreallocatedChunk) {
-            CXPLAT_FREE(LastChunk, QUIC_POOL_RECVBUF);
-        }
+        QuicRecvBufferFreeChunk(RecvBuffer, LastChunk);
 
         return TRUE;
     }
 
     //
-    // If the chunk is already referenced, and if we're in multiple receive
-    // mode, we can just add the new chunk to the end of the list. Otherwise,
-    // we need to copy the data from the existing chunks into the new chunk.
+    // The chunk is already referenced, so we need to copy the data from the
+    // existing chunks into the new chunk, and keep the old one around until
+    // the app is done with it.
     //
 
-    if (RecvBuffer->RecvMode == QUIC_RECV_BUF_MODE_MULTIPLE) {
-        return TRUE;
-    }
-
     //
     // If it's the first chunk, then it may not start from the beginning.
     //
@@ -306,6 +526,10 @@ QuicRecvBufferGetTotalAllocLength(
     _In_ QUIC_RECV_BUFFER* RecvBuffer
     )
 {
+    if (RecvBuffer->RecvMode == QUIC_RECV_BUF_MODE_APP_OWNED) {
+        return RecvBuffer->Capacity;
+    }
+
     if (RecvBuffer->RecvMode != QUIC_RECV_BUF_MODE_MULTIPLE) {
         //
         // In single and circular mode, the last chunk is the only chunk being
@@ -357,6 +581,60 @@ QuicRecvBufferGetTotalAllocLength(
     return AllocLength;
 }
 
+//
+// Copies data into app-owned chunks. These are always used linearly: the first
+// chunk starts at ReadStart and the write may span any number of the
+// following chunks.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicRecvBufferCopyIntoAppOwnedChunks(
+    _In_ QUIC_RECV_BUFFER* RecvBuffer,
+    _In_ uint64_t WriteOffset,
+    _In_ uint16_t WriteLength,
+    _In_reads_bytes_(WriteLength)
+        uint8_t const* WriteBuffer
+    )
+{
+    CXPLAT_DBG_ASSERT(!CxPlatListIsEmpty(&RecvBuffer->Chunks));
+    CXPLAT_DBG_ASSERT(WriteOffset + WriteLength <= RecvBuffer->BaseOffset + RecvBuffer->Capacity);
+
+    QUIC_RECV_CHUNK* Chunk =
+        CXPLAT_CONTAINING_RECORD(
+            RecvBuffer->Chunks.Flink,
+            QUIC_RECV_CHUNK,
+            Link);
+    uint64_t ChunkOffset = RecvBuffer->ReadStart + (WriteOffset - RecvBuffer->BaseOffset);
+    while (ChunkOffset >= Chunk->AllocLength) {
+        ChunkOffset -= Chunk->AllocLength;
+        Chunk =
+            CXPLAT_CONTAINING_RECORD(
+                Chunk->Link.Flink,
+                QUIC_RECV_CHUNK,
+                Link);
+    }
+
+    while (TRUE) {
+        uint32_t CopyLength = Chunk->AllocLength - (uint32_t)ChunkOffset;
+        if (CopyLength > WriteLength) {
+            CopyLength = WriteLength;
+        }
+        CxPlatCopyMemory(Chunk->Buffer + ChunkOffset, WriteBuffer, CopyLength);
+        WriteLength -= (uint16_t)CopyLength;
+        if (WriteLength == 0) {
+            break;
+        }
+        WriteBuffer += CopyLength;
+        ChunkOffset = 0;
+        CXPLAT_DBG_ASSERT(Chunk->Link.Flink != &RecvBuffer->Chunks);
+        Chunk =
+            CXPLAT_CONTAINING_RECORD(
+                Chunk->Link.Flink,
+                QUIC_RECV_CHUNK,
+                Link);
+    }
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 void
 QuicRecvBufferCopyIntoChunks(
@@ -385,7 +663,10 @@ QuicRecvBufferCopyIntoChunks(
         WriteBuffer += Diff;
     }
 
-    if (RecvBuffer->RecvMode != QUIC_RECV_BUF_MODE_MULTIPLE) {
+    if (RecvBuffer->RecvMode == QUIC_RECV_BUF_MODE_APP_OWNED) {
+        QuicRecvBufferCopyIntoAppOwnedChunks(RecvBuffer, WriteOffset, WriteLength, WriteBuffer);
+
+    } else if (RecvBuffer->RecvMode != QUIC_RECV_BUF_MODE_MULTIPLE) {
         //
         // In single/circular mode we always just write to the last chunk.
         //
@@ -574,8 +855,32 @@ QuicRecvBufferWrite(
     // to support rolling back those changes on the possible allocation failure
     // here.
     //
+    if (CxPlatListIsEmpty(&RecvBuffer->Chunks) &&
+        RecvBuffer->RecvMode != QUIC_RECV_BUF_MODE_APP_OWNED) {
+        //
+        // The buffer was initialized without a chunk, so this is the first
+        // write that actually needs to copy any data. Allocate it now.
+        //
+        QUIC_RECV_CHUNK* Chunk =
+            QuicRecvBufferAllocChunk(RecvBuffer, RecvBuffer->Capacity);
+        if (Chunk == NULL) {
+            return QUIC_STATUS_OUT_OF_MEMORY;
+        }
+        CxPlatListInsertHead(&RecvBuffer->Chunks, &Chunk->Link);
+        QuicRecvChunkInitialize(Chunk, RecvBuffer->Capacity);
+        RecvBuffer->ReadStart = 0;
+    }
+
     uint32_t AllocLength = QuicRecvBufferGetTotalAllocLength(RecvBuffer);
     if (AbsoluteLength > RecvBuffer->BaseOffset + AllocLength) {
+        if (RecvBuffer->RecvMode == QUIC_RECV_BUF_MODE_APP_OWNED) {
+            //
+            // App-owned buffers can't be grown. The app hasn't provided enough
+            // space yet, so fail the write and let the peer retransmit.
+            //
+            return QUIC_STATUS_OUT_OF_MEMORY;
+        }
+
         //
         // If we don't currently have enough room then we will want to resize
         // the last chunk to be big enough to hold everything. We do this by
@@ -589,6 +894,15 @@ QuicRecvBufferWrite(
         while (AbsoluteLength > RecvBuffer->BaseOffset + NewBufferLength + RecvBuffer->ReadPendingLength) {
             NewBufferLength <<= 1;
         }
+
+        //
+        // Under high memory pressure, buffers don't grow past what they
+        // already have. The data is dropped and the peer retransmits it once
+        // the app has drained some of the buffer.
+        //
+        if (QuicLibraryGetMemoryPressure() >= QUIC_MEMORY_PRESSURE_HIGH) {
+            return QUIC_STATUS_OUT_OF_MEMORY;
+        }
         if (!QuicRecvBufferResize(RecvBuffer, NewBufferLength)) {
             return QUIC_STATUS_OUT_OF_MEMORY;
         }
@@ -632,6 +946,62 @@ QuicRecvBufferWrite(
     return QUIC_STATUS_SUCCESS;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Success_(return == QUIC_STATUS_SUCCESS)
+QUIC_STATUS
+QuicRecvBufferWriteExternal(
+    _In_ QUIC_RECV_BUFFER* RecvBuffer,
+    _In_ uint64_t WriteOffset,
+    _In_ uint16_t WriteLength,
+    _Inout_ uint64_t* WriteLimit
+    )
+{
+    CXPLAT_DBG_ASSERT(WriteLength != 0);
+    CXPLAT_DBG_ASSERT(RecvBuffer->RecvMode != QUIC_RECV_BUF_MODE_APP_OWNED);
+    CXPLAT_DBG_ASSERT(RecvBuffer->RecvMode != QUIC_RECV_BUF_MODE_MULTIPLE);
+    CXPLAT_DBG_ASSERT(RecvBuffer->ReadPendingLength == 0);
+    CXPLAT_DBG_ASSERT(RecvBuffer->ReadLength == 0);
+    CXPLAT_DBG_ASSERT(WriteOffset == RecvBuffer->BaseOffset);
+    CXPLAT_DBG_ASSERT(WriteOffset == QuicRecvBufferGetTotalLength(RecvBuffer));
+
+    //
+    // Same flow control checks as a regular write. Since the buffer is empty,
+    // all the bytes are new.
+    //
+    uint64_t AbsoluteLength = WriteOffset + WriteLength;
+    if (AbsoluteLength > RecvBuffer->BaseOffset + RecvBuffer->VirtualBufferLength ||
+        WriteLength > *WriteLimit) {
+        return QUIC_STATUS_BUFFER_TOO_SMALL;
+    }
+    *WriteLimit = WriteLength;
+
+    BOOLEAN WrittenRangesUpdated;
+    QUIC_SUBRANGE* UpdatedRange =
+        QuicRangeAddRange(
+            &RecvBuffer->WrittenRanges,
+            WriteOffset,
+            WriteLength,
+            &WrittenRangesUpdated);
+    if (!UpdatedRange) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "recv_buffer range",
+            0);
+        return QUIC_STATUS_OUT_OF_MEMORY;
+    }
+    CXPLAT_DBG_ASSERT(UpdatedRange->Low == 0);
+
+    //
+    // Nothing is copied, so the bytes are immediately considered drained and
+    // the (empty) chunks restart from the beginning.
+    //
+    RecvBuffer->BaseOffset += WriteLength;
+    RecvBuffer->ReadStart = 0;
+
+    return QUIC_STATUS_SUCCESS;
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 void
 QuicRecvBufferRead(
@@ -646,10 +1016,12 @@ QuicRecvBufferRead(
     CXPLAT_DBG_ASSERT(!CxPlatListIsEmpty(&RecvBuffer->Chunks)); // Should always have at least one chunk
     CXPLAT_DBG_ASSERT(
         RecvBuffer->ReadPendingLength == 0 ||
-        RecvBuffer->RecvMode == QUIC_RECV_BUF_MODE_MULTIPLE);
+        RecvBuffer->RecvMode == QUIC_RECV_BUF_MODE_MULTIPLE ||
+        RecvBuffer->RecvMode == QUIC_RECV_BUF_MODE_APP_OWNED);
     CXPLAT_DBG_ASSERT(
         RecvBuffer->Chunks.Flink->Flink == &RecvBuffer->Chunks || // Should only have one buffer if not using multiple receive mode
-        RecvBuffer->RecvMode == QUIC_RECV_BUF_MODE_MULTIPLE);
+        RecvBuffer->RecvMode == QUIC_RECV_BUF_MODE_MULTIPLE ||
+        RecvBuffer->RecvMode == QUIC_RECV_BUF_MODE_APP_OWNED);
 
     //
     // Find the length of the data written in the front, after the BaseOffset.
@@ -712,6 +1084,59 @@ QuicRecvBufferRead(
             Buffers[0].Buffer = Chunk->Buffer + ReadStart;
         }
 
+    } else if (RecvBuffer->RecvMode == QUIC_RECV_BUF_MODE_APP_OWNED) {
+        CXPLAT_DBG_ASSERT(RecvBuffer->ReadPendingLength < ContiguousLength); // Shouldn't call read if there is nothing new to read
+        uint64_t UnreadLength = ContiguousLength - RecvBuffer->ReadPendingLength;
+        CXPLAT_DBG_ASSERT(*BufferCount >= 1);
+
+        //
+        // App-owned chunks aren't circular, so each chunk the unread data
+        // touches is returned as one buffer, up to the number of buffers the
+        // caller passed in. Any remaining data is returned by the next read.
+        //
+        uint64_t ChunkReadOffset = RecvBuffer->ReadStart + RecvBuffer->ReadPendingLength;
+        QUIC_RECV_CHUNK* Chunk =
+            CXPLAT_CONTAINING_RECORD(
+                RecvBuffer->Chunks.Flink,
+                QUIC_RECV_CHUNK,
+                Link);
+        while (ChunkReadOffset >= Chunk->AllocLength) {
+            ChunkReadOffset -= Chunk->AllocLength;
+            Chunk =
+                CXPLAT_CONTAINING_RECORD(
+                    Chunk->Link.Flink,
+                    QUIC_RECV_CHUNK,
+                    Link);
+        }
+
+        uint32_t Count = 0;
+        uint64_t ReadLength = 0;
+        while (TRUE) {
+            uint32_t ChunkReadLength = Chunk->AllocLength - (uint32_t)ChunkReadOffset;
+            if (ChunkReadLength > UnreadLength) {
+                ChunkReadLength = (uint32_t)UnreadLength;
+            }
+            Buffers[Count].Length = ChunkReadLength;
+            Buffers[Count].Buffer = Chunk->Buffer + ChunkReadOffset;
+            Chunk->ExternalReference = TRUE;
+            ReadLength += ChunkReadLength;
+            UnreadLength -= ChunkReadLength;
+            if (++Count == *BufferCount || UnreadLength == 0) {
+                break;
+            }
+            ChunkReadOffset = 0;
+            CXPLAT_DBG_ASSERT(Chunk->Link.Flink != &RecvBuffer->Chunks);
+            Chunk =
+                CXPLAT_CONTAINING_RECORD(
+                    Chunk->Link.Flink,
+                    QUIC_RECV_CHUNK,
+                    Link);
+        }
+
+        *BufferCount = Count;
+        *BufferOffset = RecvBuffer->BaseOffset + RecvBuffer->ReadPendingLength;
+        RecvBuffer->ReadPendingLength += ReadLength;
+
     } else {
         CXPLAT_DBG_ASSERT(RecvBuffer->ReadPendingLength < ContiguousLength); // Shouldn't call read if there is nothing new to read
         uint64_t UnreadLength = ContiguousLength - RecvBuffer->ReadPendingLength;
@@ -744,6 +1169,7 @@ QuicRecvBufferRead(
         }
         CXPLAT_DBG_ASSERT(*BufferCount >= 3);
         CXPLAT_DBG_ASSERT(ChunkReadOffset <= UINT32_MAX);
+        const uint32_t MaxBufferCount = *BufferCount;
 
         ChunkReadLength -= (uint32_t)ChunkReadOffset;
         if (IsFirstChunk) {
@@ -775,23 +1201,32 @@ QuicRecvBufferRead(
         }
         Chunk->ExternalReference = TRUE;
 
-        if (UnreadLength > ChunkReadLength) {
+        //
+        // Chunks are chained as the buffer grows, so the unread data may span
+        // any number of the following chunks. Return as many of them as there
+        // is room for; the rest is returned by the next read.
+        //
+        uint64_t ReadLength = ChunkReadLength;
+        while (ReadLength < UnreadLength && *BufferCount < MaxBufferCount) {
             CXPLAT_DBG_ASSERT(Chunk->Link.Flink != &RecvBuffer->Chunks); // There must be another chunk to read from
-            ChunkReadLength = (uint32_t)UnreadLength - ChunkReadLength;
             Chunk =
                 CXPLAT_CONTAINING_RECORD(
                     Chunk->Link.Flink,
                     QUIC_RECV_CHUNK,
                     Link);
-            CXPLAT_DBG_ASSERT(ChunkReadLength <= Chunk->AllocLength); // Shouldn't be able to read more than the chunk size
+            ChunkReadLength = Chunk->AllocLength;
+            if (ChunkReadLength > UnreadLength - ReadLength) {
+                ChunkReadLength = (uint32_t)(UnreadLength - ReadLength);
+            }
             Buffers[*BufferCount].Length = ChunkReadLength;
             Buffers[*BufferCount].Buffer = Chunk->Buffer;
             *BufferCount = *BufferCount + 1;
             Chunk->ExternalReference = TRUE;
+            ReadLength += ChunkReadLength;
         }
 
         *BufferOffset = RecvBuffer->BaseOffset + RecvBuffer->ReadPendingLength;
-        RecvBuffer->ReadPendingLength += UnreadLength;
+        RecvBuffer->ReadPendingLength += ReadLength;
 
 #if DEBUG
         uint64_t TotalBuffersLength = 0;
@@ -829,9 +1264,7 @@ QuicRecvBufferPartialDrain(
         // operating on the next one.
         //
         CxPlatListEntryRemove(&Chunk->Link);
-        if (Chunk != RecvBuffer->PreallocatedChunk) {
-            CXPLAT_FREE(Chunk, QUIC_POOL_RECVBUF);
-        }
+        QuicRecvBufferFreeChunk(RecvBuffer, Chunk);
 
         CXPLAT_DBG_ASSERT(!CxPlatListIsEmpty(&RecvBuffer->Chunks));
         Chunk =
@@ -936,9 +1369,7 @@ QuicRecvBufferFullDrain(
     // Cleanup the chunk that was just drained.
     //
     CxPlatListEntryRemove(&Chunk->Link);
-    if (Chunk != RecvBuffer->PreallocatedChunk) {
-        CXPLAT_FREE(Chunk, QUIC_POOL_RECVBUF);
-    }
+    QuicRecvBufferFreeChunk(RecvBuffer, Chunk);
 
     if (RecvBuffer->RecvMode == QUIC_RECV_BUF_MODE_MULTIPLE) {
         //
@@ -961,6 +1392,46 @@ QuicRecvBufferFullDrain(
     return DrainLength;
 }
 
+//
+// Handles draining app-owned chunks. Fully consumed chunks are released back
+// to the app, and the drained space no longer counts towards the virtual
+// buffer length. Returns TRUE if there is no more data available to be read.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicRecvBufferAppOwnedDrain(
+    _In_ QUIC_RECV_BUFFER* RecvBuffer,
+    _In_ uint64_t DrainLength
+    )
+{
+    CXPLAT_DBG_ASSERT(DrainLength <= RecvBuffer->Capacity);
+    CXPLAT_DBG_ASSERT(DrainLength <= RecvBuffer->VirtualBufferLength);
+
+    RecvBuffer->BaseOffset += DrainLength;
+    RecvBuffer->ReadPendingLength -= DrainLength;
+    RecvBuffer->Capacity -= (uint32_t)DrainLength;
+    RecvBuffer->VirtualBufferLength -= (uint32_t)DrainLength;
+
+    uint64_t ChunkOffset = RecvBuffer->ReadStart + DrainLength;
+    while (!CxPlatListIsEmpty(&RecvBuffer->Chunks)) {
+        QUIC_RECV_CHUNK* Chunk =
+            CXPLAT_CONTAINING_RECORD(
+                RecvBuffer->Chunks.Flink,
+                QUIC_RECV_CHUNK,
+                Link);
+        if (ChunkOffset < Chunk->AllocLength) {
+            Chunk->ExternalReference = RecvBuffer->ReadPendingLength != 0;
+            break;
+        }
+        ChunkOffset -= Chunk->AllocLength;
+        CxPlatListEntryRemove(&Chunk->Link);
+        QuicRecvBufferFreeChunk(RecvBuffer, Chunk);
+    }
+    RecvBuffer->ReadStart = (uint32_t)ChunkOffset;
+
+    return !QuicRecvBufferHasUnreadData(RecvBuffer);
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 BOOLEAN
 QuicRecvBufferDrain(
@@ -969,6 +1440,9 @@ QuicRecvBufferDrain(
     )
 {
     CXPLAT_DBG_ASSERT(DrainLength <= RecvBuffer->ReadPendingLength);
+    if (RecvBuffer->RecvMode == QUIC_RECV_BUF_MODE_APP_OWNED) {
+        return QuicRecvBufferAppOwnedDrain(RecvBuffer, DrainLength);
+    }
     if (RecvBuffer->RecvMode != QUIC_RECV_BUF_MODE_MULTIPLE) {
         RecvBuffer->ReadPendingLength = 0;
     }
@@ -995,6 +1469,34 @@ QuicRecvBufferDrain(
     return TRUE;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QuicRecvBufferProvideChunks(
+    _In_ QUIC_RECV_BUFFER* RecvBuffer,
+    _Inout_ CXPLAT_LIST_ENTRY* Chunks
+    )
+{
+    CXPLAT_DBG_ASSERT(RecvBuffer->RecvMode == QUIC_RECV_BUF_MODE_APP_OWNED);
+    CXPLAT_DBG_ASSERT(!CxPlatListIsEmpty(Chunks));
+
+    uint64_t NewCapacity = RecvBuffer->Capacity;
+    for (CXPLAT_LIST_ENTRY* Link = Chunks->Flink; Link != Chunks; Link = Link->Flink) {
+        NewCapacity +=
+            CXPLAT_CONTAINING_RECORD(Link, QUIC_RECV_CHUNK, Link)->AllocLength;
+    }
+    if (NewCapacity > UINT32_MAX) {
+        return QUIC_STATUS_INVALID_PARAMETER;
+    }
+
+    RecvBuffer->Capacity = (uint32_t)NewCapacity;
+    if (RecvBuffer->VirtualBufferLength < RecvBuffer->Capacity) {
+        RecvBuffer->VirtualBufferLength = RecvBuffer->Capacity;
+    }
+    CxPlatListMoveItems(Chunks, &RecvBuffer->Chunks);
+
+    return QUIC_STATUS_SUCCESS;
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 void
 QuicRecvBufferResetRead(
@@ -1011,3 +1513,51 @@ QuicRecvBufferResetRead(
     Chunk->ExternalReference = FALSE;
     RecvBuffer->ReadPendingLength = 0;
 }
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicRecvBufferCompact(
+    _In_ QUIC_RECV_BUFFER* RecvBuffer
+    )
+{
+    if (RecvBuffer->RecvMode == QUIC_RECV_BUF_MODE_APP_OWNED ||
+        RecvBuffer->PreallocatedChunk != NULL ||
+        CxPlatListIsEmpty(&RecvBuffer->Chunks) ||
+        RecvBuffer->ReadPendingLength != 0 ||
+        QuicRecvBufferGetTotalLength(RecvBuffer) != RecvBuffer->BaseOffset) {
+        return FALSE;
+    }
+
+    CXPLAT_LIST_ENTRY* Entry = RecvBuffer->Chunks.Flink;
+    while (Entry != &RecvBuffer->Chunks) {
+        if (CXPLAT_CONTAINING_RECORD(Entry, QUIC_RECV_CHUNK, Link)->ExternalReference) {
+            return FALSE;
+        }
+        Entry = Entry->Flink;
+    }
+
+    //
+    // Keep the size of the last (largest) chunk so the buffer doesn't need to
+    // grow all over again once data starts arriving.
+    //
+    const uint32_t AllocLength =
+        CXPLAT_CONTAINING_RECORD(
+            RecvBuffer->Chunks.Blink,
+            QUIC_RECV_CHUNK,
+            Link)->AllocLength;
+
+    while (!CxPlatListIsEmpty(&RecvBuffer->Chunks)) {
+        QUIC_RECV_CHUNK* Chunk =
+            CXPLAT_CONTAINING_RECORD(
+                CxPlatListRemoveHead(&RecvBuffer->Chunks),
+                QUIC_RECV_CHUNK,
+                Link);
+        QuicRecvBufferFreeChunk(RecvBuffer, Chunk);
+    }
+
+    RecvBuffer->ReadStart = 0;
+    RecvBuffer->ReadLength = 0;
+    RecvBuffer->Capacity = AllocLength;
+
+    return TRUE;
+}
@@ -12,7 +12,8 @@ extern "C" {
 typedef enum QUIC_RECV_BUF_MODE {
     QUIC_RECV_BUF_MODE_SINGLE,      // Only one receive with a single contiguous buffer at a time.
     QUIC_RECV_BUF_MODE_CIRCULAR,    // Only one receive that may indicate two contiguous buffers at a time.
-    QUIC_RECV_BUF_MODE_MULTIPLE     // Multiple independent receives that may indicate up to two contiguous buffers at a time.
+    QUIC_RECV_BUF_MODE_MULTIPLE,    // Multiple independent receives that may indicate up to two contiguous buffers at a time.
+    QUIC_RECV_BUF_MODE_APP_OWNED    // Multiple independent receives into buffers provided by the app.
 } QUIC_RECV_BUF_MODE;
 
 //
@@ -22,9 +23,55 @@ typedef struct QUIC_RECV_CHUNK {
     CXPLAT_LIST_ENTRY Link;         // Link in the list of chunks.
     uint32_t AllocLength : 31;      // Allocation size of Buffer
     uint32_t ExternalReference : 1; // Indicates the buffer is being used externally.
-    uint8_t Buffer[0];
+    uint8_t* Buffer;                // Follows the chunk, unless provided by the app.
 } QUIC_RECV_CHUNK;
 
+//
+// Initializes a chunk header for a buffer of the given length allocated
+// immediately after it.
+//
+inline
+void
+QuicRecvChunkInitialize(
+    _Inout_ QUIC_RECV_CHUNK* Chunk,
+    _In_ uint32_t AllocLength
+    )
+{
+    Chunk->AllocLength = AllocLength;
+    Chunk->ExternalReference = FALSE;
+    Chunk->Buffer = (uint8_t*)(Chunk + 1);
+}
+
+//
+// Chunk lengths served from a QUIC_RECV_CHUNK_POOL. Chunk lengths are always a
+// power of 2, so each pooled length maps to exactly one size class. Larger
+// chunks are allocated directly, since keeping them cached would cost more
+// memory than the allocations save.
+//
+#define QUIC_RECV_CHUNK_POOL_MIN_LENGTH     0x1000  // 4KB
+#define QUIC_RECV_CHUNK_POOL_CLASS_COUNT    5       // 4KB to 64KB
+
+//
+// A collection of object pools, one for each size class of chunk.
+//
+typedef struct QUIC_RECV_CHUNK_POOL {
+
+    CXPLAT_POOL Pools[QUIC_RECV_CHUNK_POOL_CLASS_COUNT];
+
+} QUIC_RECV_CHUNK_POOL;
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicRecvChunkPoolInitialize(
+    _Inout_ QUIC_RECV_CHUNK_POOL* ChunkPool
+    );
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicRecvChunkPoolUninitialize(
+    _In_ QUIC_RECV_CHUNK_POOL* ChunkPool
+    );
+
 typedef struct QUIC_RECV_BUFFER {
 
     //
@@ -37,6 +84,16 @@ typedef struct QUIC_RECV_BUFFER {
     //
     QUIC_RECV_CHUNK* PreallocatedChunk;
 
+    //
+    // Optional, pool that chunks are allocated from and freed back to.
+    //
+    QUIC_RECV_CHUNK_POOL* ChunkPool;
+
+    //
+    // Optional, counter that the length of allocated chunks is charged to.
+    //
+    uint64_t* UsageCounter;
+
     //
     // The ranges that currently have bytes written to them.
     //
@@ -72,6 +129,9 @@ typedef struct QUIC_RECV_BUFFER {
     // Basically same as Chunk->AllocLength of first chunk, but start shrinking
     // by drain operation after next chunk is allocated.
     //
+    // In app-owned mode, this is the total unused space remaining in all the
+    // chunks provided by the app, starting at BaseOffset.
+    //
     uint32_t Capacity;
 
     //
@@ -89,7 +149,36 @@ QuicRecvBufferInitialize(
     _In_ uint32_t AllocBufferLength,
     _In_ uint32_t VirtualBufferLength,
     _In_ QUIC_RECV_BUF_MODE RecvMode,
-    _In_opt_ QUIC_RECV_CHUNK* PreallocatedChunk
+    _In_opt_ QUIC_RECV_CHUNK* PreallocatedChunk,
+    _In_opt_ QUIC_RECV_CHUNK_POOL* ChunkPool
+    );
+
+//
+// Same as QuicRecvBufferInitialize (without a preallocated chunk), except the
+// first chunk isn't allocated until data is actually written into the buffer.
+// Buffers that never receive any data (or only ever receive it via
+// QuicRecvBufferWriteExternal) then never allocate any memory.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicRecvBufferInitializeDeferred(
+    _Inout_ QUIC_RECV_BUFFER* RecvBuffer,
+    _In_ uint32_t AllocBufferLength,
+    _In_ uint32_t VirtualBufferLength,
+    _In_ QUIC_RECV_BUF_MODE RecvMode,
+    _In_opt_ QUIC_RECV_CHUNK_POOL* ChunkPool
+    );
+
+//
+// Charges the length of all chunks the buffer allocates, including the ones it
+// already has, to UsageCounter. Preallocated and app-owned chunks aren't
+// charged.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicRecvBufferSetUsageCounter(
+    _Inout_ QUIC_RECV_BUFFER* RecvBuffer,
+    _In_ uint64_t* UsageCounter
     );
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -128,6 +217,17 @@ QuicRecvBufferIncreaseVirtualBufferLength(
     _In_ uint32_t NewLength
     );
 
+//
+// Shrinks the buffer's virtual buffer length. The caller must make sure the
+// new length still covers everything already advertised to the peer.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicRecvBufferDecreaseVirtualBufferLength(
+    _In_ QUIC_RECV_BUFFER* RecvBuffer,
+    _In_ uint32_t NewLength
+    );
+
 //
 // Buffers a (possibly out-of-order or duplicate) range of bytes.
 //
@@ -146,6 +246,23 @@ QuicRecvBufferWrite(
     _Out_ BOOLEAN* NewDataReady
     );
 
+//
+// Accounts for an in-order range of bytes that is delivered to the client
+// from an external buffer, instead of being copied into the receive buffer.
+// The receive buffer must not contain any unread or out-of-order data, and
+// WriteOffset must be the next expected byte offset. On success, the range is
+// treated as already read and drained.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Success_(return == QUIC_STATUS_SUCCESS)
+QUIC_STATUS
+QuicRecvBufferWriteExternal(
+    _In_ QUIC_RECV_BUFFER* RecvBuffer,
+    _In_ uint64_t WriteOffset,
+    _In_ uint16_t WriteLength,
+    _Inout_ uint64_t* WriteLimit
+    );
+
 //
 // Returns a pointer into the buffer for data ready to be delivered to the
 // client.
@@ -179,6 +296,31 @@ QuicRecvBufferDrain(
     _In_ uint64_t DrainLength
     );
 
+//
+// Appends app provided chunks to the end of an app-owned mode buffer. On
+// success, the chunks are moved out of the input list and are owned by the
+// buffer (the memory they point to is still owned by the app).
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QuicRecvBufferProvideChunks(
+    _In_ QUIC_RECV_BUFFER* RecvBuffer,
+    _Inout_ CXPLAT_LIST_ENTRY* Chunks
+    );
+
+//
+// Frees all the chunks of a buffer that has no data left in it, returning it
+// to the same state as QuicRecvBufferInitializeDeferred. The next write
+// allocates a chunk of the same size as the last one. Returns FALSE (and does
+// nothing) if the buffer still holds data, has a read pending or doesn't own
+// its chunks.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicRecvBufferCompact(
+    _In_ QUIC_RECV_BUFFER* RecvBuffer
+    );
+
 //
 // Indicates the caller is abandoning any pending read.
 //   N.B. Currently only supported for QUIC_RECV_BUF_MODE_SINGLE mode.
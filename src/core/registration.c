@@ -81,8 +81,12 @@ MsQuicRegistrationOpen(
     CxPlatLockInitialize(&Registration->ConfigLock);
     CxPlatListInitializeHead(&Registration->Configurations);
     CxPlatDispatchLockInitialize(&Registration->ConnectionLock);
+    CxPlatDispatchLockInitialize(&Registration->EgressLock);
+    Registration->SchedulingWeight = 1;
     CxPlatListInitializeHead(&Registration->Connections);
     CxPlatListInitializeHead(&Registration->Listeners);
+    CxPlatLockInitialize(&Registration->EnumLock);
+    CxPlatListInitializeHead(&Registration->EnumCursor);
     CxPlatRundownInitialize(&Registration->Rundown);
     Registration->AppNameLength = (uint8_t)(AppNameLength + 1);
     if (AppNameLength != 0) {
@@ -130,6 +134,8 @@ Error:
 
     if (Registration != NULL) {
         CxPlatRundownUninitialize(&Registration->Rundown);
+        CxPlatDispatchLockUninitialize(&Registration->EgressLock);
+        CxPlatLockUninitialize(&Registration->EnumLock);
         CxPlatDispatchLockUninitialize(&Registration->ConnectionLock);
         CxPlatLockUninitialize(&Registration->ConfigLock);
         CXPLAT_FREE(Registration, QUIC_POOL_REGISTRATION);
@@ -176,9 +182,16 @@ MsQuicRegistrationClose(
 
         QuicWorkerPoolUninitialize(Registration->WorkerPool);
         CxPlatRundownUninitialize(&Registration->Rundown);
+        CxPlatDispatchLockUninitialize(&Registration->EgressLock);
+        CxPlatLockUninitialize(&Registration->EnumLock);
         CxPlatDispatchLockUninitialize(&Registration->ConnectionLock);
         CxPlatLockUninitialize(&Registration->ConfigLock);
 
+        if (Registration->EventQueue != NULL) {
+            QuicEventQueueUninitialize(Registration->EventQueue);
+            CXPLAT_FREE(Registration->EventQueue, QUIC_POOL_EVENT_QUEUE);
+        }
+
         CXPLAT_FREE(Registration, QUIC_POOL_REGISTRATION);
 
         QuicTraceEvent(
@@ -227,6 +240,11 @@ MsQuicRegistrationShutdown(
         CXPLAT_LIST_ENTRY* Entry = Registration->Connections.Flink;
         while (Entry != &Registration->Connections) {
 
+            if (Entry == &Registration->EnumCursor) {
+                Entry = Entry->Flink;
+                continue;
+            }
+
             QUIC_CONNECTION* Connection =
                 CXPLAT_CONTAINING_RECORD(Entry, QUIC_CONNECTION, RegistrationLink);
 
@@ -266,6 +284,56 @@ Exit:
         "[ api] Exit");
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+uint32_t
+QUIC_API
+MsQuicRegistrationPollEvents(
+    _In_ _Pre_defensive_ HQUIC Handle,
+    _Out_writes_to_(EventCount, return) _Pre_defensive_
+        QUIC_QUEUED_EVENT* Events,
+    _In_ uint32_t EventCount,
+    _In_ uint32_t TimeoutMs
+    )
+{
+    uint32_t Dequeued = 0;
+
+    QuicTraceEvent(
+        ApiEnter,
+        "[ api] Enter %u (%p).",
+        QUIC_TRACE_API_REGISTRATION_POLL_EVENTS,
+        Handle);
+
+    if (Handle != NULL && Handle->Type == QUIC_HANDLE_TYPE_REGISTRATION &&
+        Events != NULL && EventCount != 0) {
+#pragma prefast(suppress: __WARNING_25024, "Pointer cast already validated.")
+        QUIC_REGISTRATION* Registration = (QUIC_REGISTRATION*)Handle;
+        if (Registration->EventQueue != NULL) {
+            Dequeued =
+                QuicEventQueueDequeue(
+                    Registration->EventQueue, Events, EventCount, TimeoutMs);
+        }
+    }
+
+    QuicTraceEvent(
+        ApiExit,
+        "[ api] Exit");
+
+    return Dequeued;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Function_class_(QUIC_REGISTRATION_CONNECTION_CALLBACK)
+static
+void
+QuicRegistrationTraceRundownConnection(
+    _In_ QUIC_CONNECTION* Connection,
+    _Inout_opt_ void* Context
+    )
+{
+    UNREFERENCED_PARAMETER(Context);
+    QuicConnQueueTraceRundown(Connection);
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicRegistrationTraceRundown(
@@ -290,16 +358,8 @@ QuicRegistrationTraceRundown(
 
     CxPlatLockRelease(&Registration->ConfigLock);
 
-    CxPlatDispatchLockAcquire(&Registration->ConnectionLock);
-
-    for (CXPLAT_LIST_ENTRY* Link = Registration->Connections.Flink;
-        Link != &Registration->Connections;
-        Link = Link->Flink) {
-        QuicConnQueueTraceRundown(
-            CXPLAT_CONTAINING_RECORD(Link, QUIC_CONNECTION, RegistrationLink));
-    }
-
-    CxPlatDispatchLockRelease(&Registration->ConnectionLock);
+    QuicRegistrationEnumerateConnections(
+        Registration, QuicRegistrationTraceRundownConnection, NULL);
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -318,6 +378,66 @@ QuicRegistrationSettingsChanged(
     }
 
     CxPlatLockRelease(&Registration->ConfigLock);
+
+    //
+    // Existing connections pick up the live tunables from their (now updated)
+    // configuration on their own workers.
+    //
+    CxPlatDispatchLockAcquire(&Registration->ConnectionLock);
+
+    for (CXPLAT_LIST_ENTRY* Link = Registration->Connections.Flink;
+        Link != &Registration->Connections;
+        Link = Link->Flink) {
+        if (Link == &Registration->EnumCursor) {
+            continue;
+        }
+        QuicConnQueueSettingsChanged(
+            CXPLAT_CONTAINING_RECORD(Link, QUIC_CONNECTION, RegistrationLink));
+    }
+
+    CxPlatDispatchLockRelease(&Registration->ConnectionLock);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicRegistrationEnumerateConnections(
+    _In_ QUIC_REGISTRATION* Registration,
+    _In_ QUIC_REGISTRATION_CONNECTION_CALLBACK_HANDLER Callback,
+    _Inout_opt_ void* Context
+    )
+{
+    CXPLAT_LIST_ENTRY* Cursor = &Registration->EnumCursor;
+
+    CxPlatLockAcquire(&Registration->EnumLock);
+    CxPlatDispatchLockAcquire(&Registration->ConnectionLock);
+    CxPlatListInsertHead(&Registration->Connections, Cursor);
+
+    while (Cursor->Flink != &Registration->Connections) {
+        const uint64_t SliceStart = CxPlatTimeUs64();
+        do {
+            //
+            // Move the cursor past the connection before visiting it, so the
+            // walk resumes after it even if it's closed once the lock drops.
+            //
+            CXPLAT_LIST_ENTRY* Entry = Cursor->Flink;
+            CxPlatListEntryRemove(Cursor);
+            CxPlatListInsertHead(Entry, Cursor);
+            Callback(
+                CXPLAT_CONTAINING_RECORD(Entry, QUIC_CONNECTION, RegistrationLink),
+                Context);
+        } while (Cursor->Flink != &Registration->Connections &&
+                 CxPlatTimeDiff64(SliceStart, CxPlatTimeUs64()) < QUIC_REGISTRATION_ENUM_SLICE_US);
+
+        if (Cursor->Flink != &Registration->Connections) {
+            CxPlatDispatchLockRelease(&Registration->ConnectionLock);
+            CxPlatSchedulerYield();
+            CxPlatDispatchLockAcquire(&Registration->ConnectionLock);
+        }
+    }
+
+    CxPlatListEntryRemove(Cursor);
+    CxPlatDispatchLockRelease(&Registration->ConnectionLock);
+    CxPlatLockRelease(&Registration->EnumLock);
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -334,7 +454,9 @@ QuicRegistrationAcceptConnection(
     // TODO - Look for other worker instead if the proposed worker is overloaded?
     //
 
-    return !QuicWorkerIsOverloaded(&Registration->WorkerPool->Workers[Index]);
+    return
+        !QuicWorkerIsOverloaded(
+            QuicWorkerPoolGetPartitionWorker(Registration->WorkerPool, Index));
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -351,9 +473,92 @@ QuicRegistrationQueueNewConnection(
     // TODO - Look for other worker instead if the proposed worker is overloaded?
     //
 
-    QuicWorkerAssignConnection(
-        &Registration->WorkerPool->Workers[Index],
-        Connection);
+    QUIC_WORKER* Worker = QuicWorkerPoolGetPartitionWorker(Registration->WorkerPool, Index);
+    Connection->FoldedWorker = Worker->PartitionIndex != Index;
+    QuicWorkerAssignConnection(Worker, Connection);
+}
+
+//
+// Refills the egress token bucket for the time elapsed since the last refill.
+// The bucket holds QUIC_REGISTRATION_EGRESS_BURST_US worth of the rate. Must
+// be called with the EgressLock held.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+static
+uint64_t
+QuicRegistrationRefillEgress(
+    _Inout_ QUIC_REGISTRATION* Registration,
+    _In_ uint64_t TimeNow
+    )
+{
+    const uint64_t Rate = Registration->MaxEgressRate;
+    uint64_t Capacity = (Rate * QUIC_REGISTRATION_EGRESS_BURST_US) / S_TO_US(1);
+    if (Capacity < QUIC_REGISTRATION_EGRESS_MIN_BURST) {
+        Capacity = QUIC_REGISTRATION_EGRESS_MIN_BURST;
+    }
+
+    uint64_t Elapsed = CxPlatTimeDiff64(Registration->EgressRefillTime, TimeNow);
+    if (Elapsed > S_TO_US(1)) {
+        Elapsed = S_TO_US(1);
+    }
+
+    //
+    // Only move the refill time forward once some credit is given, so that
+    // frequent sends at low rates don't keep losing the fraction.
+    //
+    const uint64_t Credit = (Elapsed * Rate) / S_TO_US(1);
+    if (Credit != 0) {
+        Registration->EgressTokens += Credit;
+        Registration->EgressRefillTime = TimeNow;
+    }
+    if (Registration->EgressTokens > Capacity) {
+        Registration->EgressTokens = Capacity;
+    }
+
+    return Capacity;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+QuicRegistrationAcquireEgress(
+    _In_ QUIC_REGISTRATION* Registration,
+    _In_ uint32_t Requested
+    )
+{
+    if (Registration->MaxEgressRate == 0 || Requested == 0) {
+        return Requested;
+    }
+
+    CxPlatDispatchLockAcquire(&Registration->EgressLock);
+    if (Registration->MaxEgressRate != 0) {
+        (void)QuicRegistrationRefillEgress(Registration, CxPlatTimeUs64());
+        if (Requested > Registration->EgressTokens) {
+            Requested = (uint32_t)Registration->EgressTokens;
+        }
+        Registration->EgressTokens -= Requested;
+    }
+    CxPlatDispatchLockRelease(&Registration->EgressLock);
+
+    return Requested;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicRegistrationReleaseEgress(
+    _In_ QUIC_REGISTRATION* Registration,
+    _In_ uint32_t Unused
+    )
+{
+    if (Registration->MaxEgressRate == 0 || Unused == 0) {
+        return;
+    }
+
+    CxPlatDispatchLockAcquire(&Registration->EgressLock);
+    if (Registration->MaxEgressRate != 0) {
+        Registration->EgressTokens += Unused;
+        (void)QuicRegistrationRefillEgress(Registration, CxPlatTimeUs64());
+    }
+    CxPlatDispatchLockRelease(&Registration->EgressLock);
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -366,11 +571,122 @@ QuicRegistrationParamSet(
         const void* Buffer
     )
 {
-    UNREFERENCED_PARAMETER(Registration);
-    UNREFERENCED_PARAMETER(Param);
-    UNREFERENCED_PARAMETER(BufferLength);
-    UNREFERENCED_PARAMETER(Buffer);
-    return QUIC_STATUS_INVALID_PARAMETER;
+    QUIC_STATUS Status;
+
+    switch (Param) {
+    case QUIC_PARAM_REGISTRATION_EVENT_QUEUE_ENABLED: {
+
+        if (BufferLength != sizeof(BOOLEAN) || Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        //
+        // The queue can only be enabled, and must be enabled before any
+        // connection is opened so that no events are lost between it and
+        // the callbacks.
+        //
+        if (!*(BOOLEAN*)Buffer) {
+            Status =
+                Registration->EventQueue == NULL ?
+                    QUIC_STATUS_SUCCESS : QUIC_STATUS_INVALID_STATE;
+            break;
+        }
+
+        QUIC_EVENT_QUEUE* EventQueue =
+            CXPLAT_ALLOC_NONPAGED(sizeof(QUIC_EVENT_QUEUE), QUIC_POOL_EVENT_QUEUE);
+        if (EventQueue == NULL) {
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "event queue",
+                sizeof(QUIC_EVENT_QUEUE));
+            Status = QUIC_STATUS_OUT_OF_MEMORY;
+            break;
+        }
+        QuicEventQueueInitialize(EventQueue);
+
+        CxPlatDispatchLockAcquire(&Registration->ConnectionLock);
+        if (Registration->EventQueue != NULL) {
+            Status = QUIC_STATUS_SUCCESS;
+        } else if (Registration->Connections.Flink != &Registration->Connections &&
+                   (Registration->Connections.Flink != &Registration->EnumCursor ||
+                    Registration->Connections.Blink != &Registration->EnumCursor)) {
+            Status = QUIC_STATUS_INVALID_STATE;
+        } else {
+            Registration->EventQueue = EventQueue;
+            EventQueue = NULL;
+            Status = QUIC_STATUS_SUCCESS;
+        }
+        CxPlatDispatchLockRelease(&Registration->ConnectionLock);
+
+        if (EventQueue != NULL) {
+            QuicEventQueueUninitialize(EventQueue);
+            CXPLAT_FREE(EventQueue, QUIC_POOL_EVENT_QUEUE);
+        }
+        break;
+    }
+
+    case QUIC_PARAM_REGISTRATION_QOS: {
+
+        if (BufferLength != sizeof(QUIC_REGISTRATION_QOS) || Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        const QUIC_REGISTRATION_QOS* Qos = (const QUIC_REGISTRATION_QOS*)Buffer;
+        if (Qos->SchedulingWeight == 0 ||
+            Qos->SchedulingWeight > QUIC_REGISTRATION_QOS_MAX_WEIGHT) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        Registration->SchedulingWeight = Qos->SchedulingWeight;
+
+        //
+        // A new limit starts with a full burst, so that changing it doesn't
+        // stall connections that are already sending.
+        //
+        CxPlatDispatchLockAcquire(&Registration->EgressLock);
+        Registration->MaxEgressRate = Qos->MaxEgressRate;
+        Registration->EgressTokens = UINT64_MAX;
+        Registration->EgressRefillTime = CxPlatTimeUs64();
+        if (Registration->MaxEgressRate != 0) {
+            (void)QuicRegistrationRefillEgress(
+                Registration, Registration->EgressRefillTime);
+        }
+        CxPlatDispatchLockRelease(&Registration->EgressLock);
+
+        QuicTraceLogVerbose(
+            RegistrationQosSet,
+            "[ reg][%p] QoS set, Weight=%u, MaxEgressRate=%llu",
+            Registration,
+            Qos->SchedulingWeight,
+            Qos->MaxEgressRate);
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+    }
+
+    default:
+        Status = QUIC_STATUS_INVALID_PARAMETER;
+        break;
+    }
+
+    return Status;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Function_class_(QUIC_REGISTRATION_CONNECTION_CALLBACK)
+static
+void
+QuicRegistrationGetConnectionMemoryUsage(
+    _In_ QUIC_CONNECTION* Connection,
+    _Inout_opt_ void* Context
+    )
+{
+    CXPLAT_DBG_ASSERT(Context != NULL);
+    QuicConnGetMemoryUsage(Connection, (QUIC_MEMORY_USAGE*)Context);
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -383,9 +699,101 @@ QuicRegistrationParamGet(
         void* Buffer
     )
 {
-    UNREFERENCED_PARAMETER(Registration);
-    UNREFERENCED_PARAMETER(Param);
-    UNREFERENCED_PARAMETER(BufferLength);
-    UNREFERENCED_PARAMETER(Buffer);
-    return QUIC_STATUS_INVALID_PARAMETER;
+    QUIC_STATUS Status;
+
+    switch (Param) {
+    case QUIC_PARAM_REGISTRATION_SEND_BUFFER_USAGE:
+
+        if (*BufferLength < sizeof(uint64_t)) {
+            *BufferLength = sizeof(uint64_t);
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        *BufferLength = sizeof(uint64_t);
+        *(uint64_t*)Buffer = Registration->CurrentSendBufferUsage;
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
+    case QUIC_PARAM_REGISTRATION_MEMORY_USAGE: {
+
+        if (*BufferLength < sizeof(QUIC_MEMORY_USAGE)) {
+            *BufferLength = sizeof(QUIC_MEMORY_USAGE);
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        //
+        // The connections' counters are read while their workers may be
+        // updating them, and connections come and go during the walk, so the
+        // sum is only a snapshot.
+        //
+        QUIC_MEMORY_USAGE* Usage = (QUIC_MEMORY_USAGE*)Buffer;
+        CxPlatZeroMemory(Usage, sizeof(QUIC_MEMORY_USAGE));
+        QuicRegistrationEnumerateConnections(
+            Registration, QuicRegistrationGetConnectionMemoryUsage, Usage);
+        *BufferLength = sizeof(QUIC_MEMORY_USAGE);
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+    }
+
+    case QUIC_PARAM_REGISTRATION_EVENT_QUEUE_ENABLED:
+
+        if (*BufferLength < sizeof(BOOLEAN)) {
+            *BufferLength = sizeof(BOOLEAN);
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        *BufferLength = sizeof(BOOLEAN);
+        *(BOOLEAN*)Buffer = Registration->EventQueue != NULL;
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
+    case QUIC_PARAM_REGISTRATION_QOS:
+
+        if (*BufferLength < sizeof(QUIC_REGISTRATION_QOS)) {
+            *BufferLength = sizeof(QUIC_REGISTRATION_QOS);
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        *BufferLength = sizeof(QUIC_REGISTRATION_QOS);
+        ((QUIC_REGISTRATION_QOS*)Buffer)->SchedulingWeight =
+            Registration->SchedulingWeight;
+        ((QUIC_REGISTRATION_QOS*)Buffer)->MaxEgressRate =
+            Registration->MaxEgressRate;
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
+    default:
+        Status = QUIC_STATUS_INVALID_PARAMETER;
+        break;
+    }
+
+    return Status;
 }
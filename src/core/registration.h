@@ -21,6 +21,21 @@ typedef enum QUIC_CONNECTION_ACCEPT_RESULT {
     QUIC_CONNECTION_REJECT_APP
 } QUIC_CONNECTION_ACCEPT_RESULT;
 
+//
+// Called for each connection by QuicRegistrationEnumerateConnections, with the
+// registration's connection lock held.
+//
+typedef
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Function_class_(QUIC_REGISTRATION_CONNECTION_CALLBACK)
+void
+(QUIC_REGISTRATION_CONNECTION_CALLBACK)(
+    _In_ QUIC_CONNECTION* Connection,
+    _Inout_opt_ void* Context
+    );
+
+typedef QUIC_REGISTRATION_CONNECTION_CALLBACK *QUIC_REGISTRATION_CONNECTION_CALLBACK_HANDLER;
+
 //
 // Represents per application registration state.
 //
@@ -95,6 +110,14 @@ typedef struct QUIC_REGISTRATION {
     //
     CXPLAT_LIST_ENTRY Listeners;
 
+    //
+    // Serializes incremental walks of the Connections list. While a walk is in
+    // progress, EnumCursor sits in the list right after the last connection
+    // visited, so every other walker of the list must skip it.
+    //
+    CXPLAT_LOCK EnumLock;
+    CXPLAT_LIST_ENTRY EnumCursor;
+
     //
     // Rundown for all child objects.
     //
@@ -105,6 +128,34 @@ typedef struct QUIC_REGISTRATION {
     //
     uint64_t ShutdownErrorCode;
 
+    //
+    // The current total bytes copied into send buffers by the registration's
+    // connections.
+    //
+    uint64_t CurrentSendBufferUsage;
+
+    //
+    // Queue the connection and stream events are posted to, instead of being
+    // indicated to the callback handlers, if enabled by the app.
+    //
+    QUIC_EVENT_QUEUE* EventQueue;
+
+    //
+    // Relative share of time on shared workers the registration's connections
+    // get. Each drain of a connection runs up to this many times its
+    // MaxOperationsPerDrain operations before yielding to the next connection.
+    //
+    uint32_t SchedulingWeight;
+
+    //
+    // Optional limit on the bytes per second sent by all the registration's
+    // connections, enforced with a token bucket shared by every worker.
+    //
+    CXPLAT_DISPATCH_LOCK EgressLock;
+    uint64_t MaxEgressRate;
+    uint64_t EgressTokens;
+    uint64_t EgressRefillTime;
+
     //
     // Name of the application layer.
     //
@@ -163,6 +214,42 @@ QuicRegistrationQueueNewConnection(
     _In_ QUIC_CONNECTION* Connection
     );
 
+//
+// Calls Callback for each of the registration's connections, in slices of at
+// most QUIC_REGISTRATION_ENUM_SLICE_US. The connection lock is released and
+// the thread yields between slices, so that walking many connections doesn't
+// stall the workers registering and closing connections. Connections opened
+// or closed during the walk may or may not be visited.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicRegistrationEnumerateConnections(
+    _In_ QUIC_REGISTRATION* Registration,
+    _In_ QUIC_REGISTRATION_CONNECTION_CALLBACK_HANDLER Callback,
+    _Inout_opt_ void* Context
+    );
+
+//
+// Takes up to Requested bytes out of the registration's egress rate limit and
+// returns how many may be sent now. Returns Requested if there is no limit.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+QuicRegistrationAcquireEgress(
+    _In_ QUIC_REGISTRATION* Registration,
+    _In_ uint32_t Requested
+    );
+
+//
+// Returns bytes taken by QuicRegistrationAcquireEgress that weren't sent.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicRegistrationReleaseEgress(
+    _In_ QUIC_REGISTRATION* Registration,
+    _In_ uint32_t Unused
+    );
+
 //
 // Sets a registration parameter.
 //
@@ -87,13 +87,12 @@ QuicSendReset(
 {
     Send->SendFlags = 0;
     Send->LastFlushTime = 0;
+    Send->PacingOffloadTime = 0;
     if (Send->DelayedAckTimerActive) {
         QuicConnTimerCancel(QuicSendGetConnection(Send), QUIC_CONN_TIMER_ACK_DELAY);
         Send->DelayedAckTimerActive = FALSE;
     }
-    QuicConnTimerCancel(
-        QuicSendGetConnection(Send),
-        QUIC_CONN_TIMER_PACING);
+    QuicConnPacingTimerCancel(QuicSendGetConnection(Send));
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -139,19 +138,85 @@ QuicSendQueueFlush(
     }
 }
 
+//
+// The extensible priority class of a stream. Lower classes are sent first and,
+// within an urgency, non-incremental streams are sent before incremental ones.
+//
+uint8_t
+QuicSendStreamPriorityClass(
+    _In_ const QUIC_STREAM* Stream
+    )
+{
+    return (uint8_t)((Stream->PriorityUrgency << 1) | Stream->PriorityIncremental);
+}
+
+//
+// The send credit granted to a stream each weighted fair round.
+//
+int32_t
+QuicSendStreamQuantum(
+    _In_ const QUIC_STREAM* Stream
+    )
+{
+    return (int32_t)((Stream->SendWeight + 1) * QUIC_STREAM_SEND_WEIGHTED_QUANTUM);
+}
+
+//
+// Whether the stream takes turns with other streams of the same priority, for
+// the FIFO and round robin schemes. Grouped streams follow their group.
+//
+BOOLEAN
+QuicSendStreamRotates(
+    _In_ const QUIC_SEND* Send,
+    _In_ const QUIC_STREAM* Stream
+    )
+{
+    return
+        Stream->GroupId != 0 ?
+            Stream->PriorityIncremental :
+            Send->StreamSchedulingScheme == QUIC_STREAM_SCHEDULING_SCHEME_ROUND_ROBIN;
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
-QuicSendQueueFlushForStream(
+QuicSendInsertStream(
     _In_ QUIC_SEND* Send,
-    _In_ QUIC_STREAM* Stream,
-    _In_ BOOLEAN DelaySend
+    _In_ QUIC_STREAM* Stream
     )
 {
-    if (Stream->SendLink.Flink == NULL) {
+    CXPLAT_LIST_ENTRY* Entry;
+
+    switch (Send->StreamSchedulingScheme) {
+    case QUIC_STREAM_SCHEDULING_SCHEME_WEIGHTED_FAIR:
         //
-        // Not previously queued, so add the stream to the end of the queue.
+        // The queue is in round order, so new streams go to the end with a
+        // full round of credit.
         //
-        CXPLAT_LIST_ENTRY* Entry = Send->SendStreams.Blink;
+        Stream->SendDeficit = QuicSendStreamQuantum(Stream);
+        CxPlatListInsertTail(&Send->SendStreams, &Stream->SendLink);
+        break;
+
+    case QUIC_STREAM_SCHEDULING_SCHEME_EXTENSIBLE_PRIORITY: {
+        //
+        // Insert after the last stream of the same class or, if the class is
+        // empty, after the last stream of the closest more urgent class.
+        //
+        const uint8_t Class = QuicSendStreamPriorityClass(Stream);
+        Entry = &Send->SendStreams;
+        for (int32_t i = Class; i >= 0; --i) {
+            if (Send->PriorityClassTails[i] != NULL) {
+                Entry = Send->PriorityClassTails[i];
+                break;
+            }
+        }
+        CxPlatListInsertHead(Entry, &Stream->SendLink); // Insert after current Entry
+        Stream->SendPriorityClass = Class;
+        Send->PriorityClassTails[Class] = &Stream->SendLink;
+        break;
+    }
+
+    default:
+        Entry = Send->SendStreams.Blink;
         while (Entry != &Send->SendStreams) {
             //
             // Search back to front for the right place (based on priority) to
@@ -164,6 +229,43 @@ QuicSendQueueFlushForStream(
             Entry = Entry->Blink;
         }
         CxPlatListInsertHead(Entry, &Stream->SendLink); // Insert after current Entry
+        break;
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSendRemoveStream(
+    _In_ QUIC_SEND* Send,
+    _In_ QUIC_STREAM* Stream
+    )
+{
+    if (Send->StreamSchedulingScheme == QUIC_STREAM_SCHEDULING_SCHEME_EXTENSIBLE_PRIORITY) {
+        const uint8_t Class = Stream->SendPriorityClass;
+        if (Send->PriorityClassTails[Class] == &Stream->SendLink) {
+            CXPLAT_LIST_ENTRY* Prev = Stream->SendLink.Blink;
+            Send->PriorityClassTails[Class] =
+                (Prev != &Send->SendStreams &&
+                 CXPLAT_CONTAINING_RECORD(Prev, QUIC_STREAM, SendLink)->SendPriorityClass == Class) ?
+                    Prev : NULL;
+        }
+    }
+    CxPlatListEntryRemove(&Stream->SendLink);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSendQueueFlushForStream(
+    _In_ QUIC_SEND* Send,
+    _In_ QUIC_STREAM* Stream,
+    _In_ BOOLEAN DelaySend
+    )
+{
+    if (Stream->SendLink.Flink == NULL) {
+        //
+        // Not previously queued, so add the stream to the queue.
+        //
+        QuicSendInsertStream(Send, Stream);
         QuicStreamAddRef(Stream, QUIC_STREAM_REF_SEND);
     }
 
@@ -193,21 +295,89 @@ QuicSendUpdateStreamPriority(
     )
 {
     CXPLAT_DBG_ASSERT(Stream->SendLink.Flink != NULL);
-    CxPlatListEntryRemove(&Stream->SendLink);
 
-    CXPLAT_LIST_ENTRY* Entry = Send->SendStreams.Blink;
-    while (Entry != &Send->SendStreams) {
+    if (Send->StreamSchedulingScheme == QUIC_STREAM_SCHEDULING_SCHEME_WEIGHTED_FAIR) {
         //
-        // Search back to front for the right place (based on priority) to
-        // insert the stream.
+        // Priority only changes the stream's quantum for the next round.
         //
-        if (Stream->SendPriority <=
-            CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, SendLink)->SendPriority) {
-            break;
+        return;
+    }
+
+    QuicSendRemoveStream(Send, Stream);
+    QuicSendInsertStream(Send, Stream);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSendUpdateStreamGroupPriority(
+    _In_ QUIC_SEND* Send,
+    _In_ CXPLAT_LIST_ENTRY* GroupStreams
+    )
+{
+    if (Send->StreamSchedulingScheme == QUIC_STREAM_SCHEDULING_SCHEME_WEIGHTED_FAIR) {
+        return; // Weights only change the streams' quantums for the next round.
+    }
+
+    //
+    // Pull all the group's queued streams out of the queue and then insert them
+    // back together. All members share the same priority, so only the first
+    // needs to search for its position and the rest follow it, keeping their
+    // relative order. Extensible priority inserts in constant time already.
+    //
+    CXPLAT_LIST_ENTRY Requeue;
+    CxPlatListInitializeHead(&Requeue);
+    for (CXPLAT_LIST_ENTRY* Entry = GroupStreams->Flink;
+         Entry != GroupStreams;
+         Entry = Entry->Flink) {
+        QUIC_STREAM* Stream = CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, GroupLink);
+        if (Stream->SendLink.Flink != NULL) {
+            QuicSendRemoveStream(Send, Stream);
+            CxPlatListInsertTail(&Requeue, &Stream->SendLink);
+        }
+    }
+
+    CXPLAT_LIST_ENTRY* Prev = NULL;
+    while (!CxPlatListIsEmpty(&Requeue)) {
+        QUIC_STREAM* Stream =
+            CXPLAT_CONTAINING_RECORD(
+                CxPlatListRemoveHead(&Requeue), QUIC_STREAM, SendLink);
+        if (Prev == NULL ||
+            Send->StreamSchedulingScheme == QUIC_STREAM_SCHEDULING_SCHEME_EXTENSIBLE_PRIORITY) {
+            QuicSendInsertStream(Send, Stream);
+        } else {
+            CxPlatListInsertHead(Prev, &Stream->SendLink); // Insert after Prev
         }
-        Entry = Entry->Blink;
+        Prev = &Stream->SendLink;
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSendSetStreamSchedulingScheme(
+    _In_ QUIC_SEND* Send,
+    _In_ QUIC_STREAM_SCHEDULING_SCHEME Scheme
+    )
+{
+    if (Send->StreamSchedulingScheme == (uint8_t)Scheme) {
+        return;
+    }
+
+    //
+    // Each scheme keeps the queue in its own order, so requeue all the streams
+    // in their existing order under the new scheme.
+    //
+    CXPLAT_LIST_ENTRY Streams;
+    CxPlatListInitializeHead(&Streams);
+    CxPlatListMoveItems(&Send->SendStreams, &Streams);
+    CxPlatZeroMemory(Send->PriorityClassTails, sizeof(Send->PriorityClassTails));
+    Send->StreamSchedulingScheme = (uint8_t)Scheme;
+
+    while (!CxPlatListIsEmpty(&Streams)) {
+        QUIC_STREAM* Stream =
+            CXPLAT_CONTAINING_RECORD(
+                CxPlatListRemoveHead(&Streams), QUIC_STREAM, SendLink);
+        QuicSendInsertStream(Send, Stream);
     }
-    CxPlatListInsertHead(Entry, &Stream->SendLink); // Insert after current Entry
 }
 
 #if DEBUG
@@ -273,6 +443,7 @@ QuicSendClear(
 
         QuicStreamRelease(Stream, QUIC_STREAM_REF_SEND);
     }
+    CxPlatZeroMemory(Send->PriorityClassTails, sizeof(Send->PriorityClassTails));
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -436,8 +607,6 @@ QuicSendClearStreamSendFlag(
     _In_ uint32_t SendFlags
     )
 {
-    UNREFERENCED_PARAMETER(Send);
-
     if (Stream->SendFlags & SendFlags) {
 
         QuicTraceLogStreamVerbose(
@@ -455,7 +624,7 @@ QuicSendClearStreamSendFlag(
             //
             // Since there are no flags left, remove the stream from the queue.
             //
-            CxPlatListEntryRemove(&Stream->SendLink);
+            QuicSendRemoveStream(Send, Stream);
             Stream->SendLink.Flink = NULL;
             QuicStreamRelease(Stream, QUIC_STREAM_REF_SEND);
         }
@@ -591,8 +760,8 @@ QuicSendWriteFrames(
         uint8_t i;
         for (i = 0; i < Connection->PathsCount; ++i) {
             QUIC_PATH* TempPath = &Connection->Paths[i];
-            if (!TempPath->SendResponse) {
-                continue;
+            if (!TempPath->SendResponse || TempPath->IsStandby) {
+                continue; // Standby paths respond on the path itself.
             }
 
             QUIC_PATH_RESPONSE_EX Frame = { 0 };
@@ -917,6 +1086,22 @@ QuicSendWriteFrames(
             }
         }
 
+        if (Send->SendFlags & QUIC_CONN_SEND_FLAG_IMMEDIATE_ACK) {
+
+            if (QuicImmediateAckFrameEncode(
+                    &Builder->DatagramLength,
+                    AvailableBufferLength,
+                    Builder->Datagram->Buffer)) {
+
+                Send->SendFlags &= ~QUIC_CONN_SEND_FLAG_IMMEDIATE_ACK;
+                if (QuicPacketBuilderAddFrame(Builder, QUIC_FRAME_IMMEDIATE_ACK, TRUE)) {
+                    return TRUE;
+                }
+            } else {
+                RanOutOfRoom = TRUE;
+            }
+        }
+
         if (Send->SendFlags & QUIC_CONN_SEND_FLAG_DATAGRAM) {
             RanOutOfRoom = QuicDatagramWriteFrame(&Connection->Datagram, Builder);
             if (Builder->Metadata->FrameCount == QUIC_MAX_FRAMES_PER_PACKET) {
@@ -987,9 +1172,11 @@ QuicSendGetNextStream(
     _Out_ uint32_t* PacketCount
     )
 {
-    QUIC_CONNECTION* Connection = QuicSendGetConnection(Send);
-    CXPLAT_DBG_ASSERT(!QuicConnIsClosed(Connection) || CxPlatListIsEmpty(&Send->SendStreams));
+    CXPLAT_DBG_ASSERT(
+        !QuicConnIsClosed(QuicSendGetConnection(Send)) ||
+        CxPlatListIsEmpty(&Send->SendStreams));
 
+    CXPLAT_LIST_ENTRY* FirstRotated = NULL;
     CXPLAT_LIST_ENTRY* Entry = Send->SendStreams.Flink;
     while (Entry != &Send->SendStreams) {
 
@@ -1006,7 +1193,51 @@ QuicSendGetNextStream(
         //
         if (QuicSendCanSendStreamNow(Stream)) {
 
-            if (Connection->State.UseRoundRobinStreamScheduling) {
+            if (Send->StreamSchedulingScheme == QUIC_STREAM_SCHEDULING_SCHEME_WEIGHTED_FAIR) {
+                if (Stream->SendDeficit <= 0 &&
+                    Entry != FirstRotated &&
+                    Entry->Flink != &Send->SendStreams) {
+                    //
+                    // The stream has used up its credit for this round. Grant
+                    // it credit for the next one and move it to the end.
+                    //
+                    Stream->SendDeficit += QuicSendStreamQuantum(Stream);
+                    Entry = Entry->Flink;
+                    CxPlatListEntryRemove(&Stream->SendLink);
+                    CxPlatListInsertTail(&Send->SendStreams, &Stream->SendLink);
+                    if (FirstRotated == NULL) {
+                        FirstRotated = &Stream->SendLink;
+                    }
+                    continue;
+                }
+
+                if (Stream->SendDeficit <= 0) {
+                    //
+                    // Every sendable stream is out of credit for this round, or
+                    // this is the only one left, so start a new round with it.
+                    //
+                    Stream->SendDeficit = QuicSendStreamQuantum(Stream);
+                }
+
+                *PacketCount = UINT32_MAX;
+
+            } else if (Send->StreamSchedulingScheme == QUIC_STREAM_SCHEDULING_SCHEME_EXTENSIBLE_PRIORITY) {
+                if (Stream->PriorityIncremental) {
+                    //
+                    // Incremental streams take turns with the other streams in
+                    // their class, so move the stream to the end of its class.
+                    //
+                    if (Send->PriorityClassTails[Stream->SendPriorityClass] != &Stream->SendLink) {
+                        QuicSendRemoveStream(Send, Stream);
+                        QuicSendInsertStream(Send, Stream);
+                    }
+                    *PacketCount = QUIC_STREAM_SEND_BATCH_COUNT;
+
+                } else { // Non-incremental streams are sent to completion in order.
+                    *PacketCount = UINT32_MAX;
+                }
+
+            } else if (QuicSendStreamRotates(Send, Stream)) {
                 //
                 // Move the stream after any streams of the same priority. Start
                 // with the "next" entry in the list and keep going until the
@@ -1081,7 +1312,7 @@ CxPlatIsRouteReady(
 
 //
 // This function sends a path challenge frame out on all paths that currently
-// need one sent.
+// need one sent, along with any response owed on a standby path.
 //
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
@@ -1098,7 +1329,8 @@ QuicSendPathChallenges(
     for (uint8_t i = 0; i < Connection->PathsCount; ++i) {
 
         QUIC_PATH* Path = &Connection->Paths[i];
-        if (!Connection->Paths[i].SendChallenge ||
+        const BOOLEAN SendResponse = Path->IsStandby && Path->SendResponse;
+        if ((!Connection->Paths[i].SendChallenge && !SendResponse) ||
             Connection->Paths[i].Allowance < QUIC_MIN_SEND_ALLOWANCE) {
             continue;
         }
@@ -1141,29 +1373,54 @@ QuicSendPathChallenges(
         uint16_t AvailableBufferLength =
             (uint16_t)Builder.Datagram->Length - Builder.EncryptionOverhead;
 
-        QUIC_PATH_CHALLENGE_EX Frame;
-        CxPlatCopyMemory(Frame.Data, Path->Challenge, sizeof(Frame.Data));
+        if (Path->SendChallenge) {
+            QUIC_PATH_CHALLENGE_EX Frame;
+            CxPlatCopyMemory(Frame.Data, Path->Challenge, sizeof(Frame.Data));
 
-        BOOLEAN Result =
-            QuicPathChallengeFrameEncode(
-                QUIC_FRAME_PATH_CHALLENGE,
-                &Frame,
-                &Builder.DatagramLength,
-                AvailableBufferLength,
-                Builder.Datagram->Buffer);
+            BOOLEAN Result =
+                QuicPathChallengeFrameEncode(
+                    QUIC_FRAME_PATH_CHALLENGE,
+                    &Frame,
+                    &Builder.DatagramLength,
+                    AvailableBufferLength,
+                    Builder.Datagram->Buffer);
 
-        CXPLAT_DBG_ASSERT(Result);
-        if (Result) {
-            CxPlatCopyMemory(
-                Builder.Metadata->Frames[0].PATH_CHALLENGE.Data,
-                Frame.Data,
-                sizeof(Frame.Data));
+            CXPLAT_DBG_ASSERT(Result);
+            if (Result) {
+                CxPlatCopyMemory(
+                    Builder.Metadata->Frames[0].PATH_CHALLENGE.Data,
+                    Frame.Data,
+                    sizeof(Frame.Data));
 
-            Result = QuicPacketBuilderAddFrame(&Builder, QUIC_FRAME_PATH_CHALLENGE, TRUE);
-            CXPLAT_DBG_ASSERT(!Result);
-            UNREFERENCED_PARAMETER(Result);
+                Result = QuicPacketBuilderAddFrame(&Builder, QUIC_FRAME_PATH_CHALLENGE, TRUE);
+                CXPLAT_DBG_ASSERT(!Result);
+                UNREFERENCED_PARAMETER(Result);
 
-            Path->SendChallenge = FALSE;
+                Path->SendChallenge = FALSE;
+            }
+        }
+
+        if (SendResponse) {
+            //
+            // The peer validates a standby path by the response coming back on
+            // it, so it's sent here rather than on the active path.
+            //
+            QUIC_PATH_RESPONSE_EX Frame;
+            CxPlatCopyMemory(Frame.Data, Path->Response, sizeof(Frame.Data));
+
+            if (QuicPathChallengeFrameEncode(
+                    QUIC_FRAME_PATH_RESPONSE,
+                    &Frame,
+                    &Builder.DatagramLength,
+                    AvailableBufferLength,
+                    Builder.Datagram->Buffer)) {
+                CxPlatCopyMemory(
+                    Builder.Metadata->Frames[Builder.Metadata->FrameCount].PATH_RESPONSE.Data,
+                    Frame.Data,
+                    sizeof(Frame.Data));
+                (void)QuicPacketBuilderAddFrame(&Builder, QUIC_FRAME_PATH_RESPONSE, TRUE);
+                Path->SendResponse = FALSE;
+            }
         }
 
         QuicPacketBuilderFinalize(&Builder, TRUE);
@@ -1172,6 +1429,127 @@ QuicSendPathChallenges(
 #pragma warning(pop)
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+uint32_t
+QuicSendGetDefaultFlushBudget(
+    _In_ QUIC_EXECUTION_PROFILE ExecProfile
+    )
+{
+    switch (ExecProfile) {
+    case QUIC_EXECUTION_PROFILE_TYPE_MAX_THROUGHPUT:
+        return QUIC_SEND_FLUSH_BUDGET_MAX_THROUGHPUT_US;
+    case QUIC_EXECUTION_PROFILE_TYPE_SCAVENGER:
+        return QUIC_SEND_FLUSH_BUDGET_SCAVENGER_US;
+    case QUIC_EXECUTION_PROFILE_TYPE_REAL_TIME:
+        return QUIC_SEND_FLUSH_BUDGET_REAL_TIME_US;
+    default:
+        return QUIC_SEND_FLUSH_BUDGET_LOW_LATENCY_US;
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+QuicSendCoalesceStreamData(
+    _In_ QUIC_SEND* Send,
+    _In_ uint64_t Length,
+    _In_ QUIC_SEND_FLAGS Flags
+    )
+{
+    QUIC_CONNECTION* Connection = QuicSendGetConnection(Send);
+
+    //
+    // A FIN means nothing more is coming on the stream, and the app already
+    // decided for delayed sends, so neither is held. Nor is anything sent
+    // during the handshake.
+    //
+    if (Send->CoalescingDelayUs == 0 ||
+        (Flags & (QUIC_SEND_FLAG_FIN | QUIC_SEND_FLAG_DELAY_SEND)) ||
+        !Connection->State.Connected) {
+        return FALSE;
+    }
+
+    Send->CoalescedBytes += Length;
+    if (Send->CoalescedBytes >=
+            QuicPathGetDatagramPayloadSize(&Connection->Paths[0])) {
+        //
+        // There's enough to fill a packet, so flush everything held so far.
+        //
+        return FALSE;
+    }
+
+    if (Connection->ExpirationTimes[QUIC_CONN_TIMER_SEND_COALESCE] == UINT64_MAX) {
+        QuicConnTimerSet(
+            Connection,
+            QUIC_CONN_TIMER_SEND_COALESCE,
+            Send->CoalescingDelayUs);
+    }
+    return TRUE;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSendSetCoalescingDelay(
+    _In_ QUIC_SEND* Send,
+    _In_ uint32_t DelayUs
+    )
+{
+    Send->CoalescingDelayUs = DelayUs;
+    if (DelayUs == 0 && Send->CoalescedBytes != 0) {
+        QuicSendQueueFlush(Send, REASON_STREAM_FLAGS);
+    }
+}
+
+//
+// Tracks whether the connection is app limited (nothing queued to send) or
+// only has stream flow control blocked data left, for the send limited time
+// statistics. The other blocked reasons are tracked where they are hit.
+//
+static
+void
+QuicSendUpdateIdleBlockedReasons(
+    _In_ QUIC_SEND* Send,
+    _In_ BOOLEAN OutOfData
+    )
+{
+    QUIC_CONNECTION* Connection = QuicSendGetConnection(Send);
+    if (!OutOfData) {
+        QuicConnRemoveOutFlowBlockedReason(
+            Connection,
+            QUIC_FLOW_BLOCKED_APP | QUIC_FLOW_BLOCKED_STREAM_FLOW_CONTROL);
+    } else if (CxPlatListIsEmpty(&Send->SendStreams)) {
+        QuicConnRemoveOutFlowBlockedReason(
+            Connection, QUIC_FLOW_BLOCKED_STREAM_FLOW_CONTROL);
+        QuicConnAddOutFlowBlockedReason(Connection, QUIC_FLOW_BLOCKED_APP);
+    } else {
+        //
+        // Streams are queued, but none of them can send anything. Unless it's
+        // because of connection flow control (tracked separately), look for
+        // one waiting on stream flow control.
+        //
+        QuicConnRemoveOutFlowBlockedReason(Connection, QUIC_FLOW_BLOCKED_APP);
+        BOOLEAN StreamBlocked = FALSE;
+        if (!(Connection->OutFlowBlockedReasons & QUIC_FLOW_BLOCKED_CONN_FLOW_CONTROL)) {
+            for (CXPLAT_LIST_ENTRY* Entry = Send->SendStreams.Flink;
+                Entry != &Send->SendStreams;
+                Entry = Entry->Flink) {
+                QUIC_STREAM* Stream =
+                    CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, SendLink);
+                if (Stream->OutFlowBlockedReasons & QUIC_FLOW_BLOCKED_STREAM_FLOW_CONTROL) {
+                    StreamBlocked = TRUE;
+                    break;
+                }
+            }
+        }
+        if (StreamBlocked) {
+            QuicConnAddOutFlowBlockedReason(
+                Connection, QUIC_FLOW_BLOCKED_STREAM_FLOW_CONTROL);
+        } else {
+            QuicConnRemoveOutFlowBlockedReason(
+                Connection, QUIC_FLOW_BLOCKED_STREAM_FLOW_CONTROL);
+        }
+    }
+}
+
 typedef enum QUIC_SEND_RESULT {
 
     QUIC_SEND_COMPLETE,
@@ -1183,8 +1561,9 @@ typedef enum QUIC_SEND_RESULT {
 #pragma warning(push)
 #pragma warning(disable:6001) // SAL is confused by the QuicConnAddRef followed by QuicConnRelease.
 _IRQL_requires_max_(PASSIVE_LEVEL)
+static
 BOOLEAN
-QuicSendFlush(
+QuicSendFlushPackets(
     _In_ QUIC_SEND* Send
     )
 {
@@ -1197,10 +1576,18 @@ QuicSendFlush(
         return TRUE;
     }
 
-    QuicConnTimerCancel(Connection, QUIC_CONN_TIMER_PACING);
+    QuicConnPacingTimerCancel(Connection);
     QuicConnRemoveOutFlowBlockedReason(
         Connection, QUIC_FLOW_BLOCKED_SCHEDULING | QUIC_FLOW_BLOCKED_PACING);
 
+    if (Send->CoalescedBytes != 0) {
+        //
+        // Everything held for coalescing goes out with this flush.
+        //
+        Send->CoalescedBytes = 0;
+        QuicConnTimerCancel(Connection, QUIC_CONN_TIMER_SEND_COALESCE);
+    }
+
     if (Path->DestCid == NULL) {
         return TRUE;
     }
@@ -1216,6 +1603,7 @@ QuicSendFlush(
     }
 
     if (Send->SendFlags == 0 && CxPlatListIsEmpty(&Send->SendStreams)) {
+        QuicSendUpdateIdleBlockedReasons(Send, TRUE);
         return TRUE;
     }
 
@@ -1231,6 +1619,7 @@ QuicSendFlush(
     QUIC_SEND_RESULT Result = QUIC_SEND_INCOMPLETE;
     QUIC_STREAM* Stream = NULL;
     uint32_t StreamPacketCount = 0;
+    BOOLEAN OutOfData = FALSE;
 
     if (Send->SendFlags & QUIC_CONN_SEND_FLAG_PATH_CHALLENGE) {
         Send->SendFlags &= ~QUIC_CONN_SEND_FLAG_PATH_CHALLENGE;
@@ -1248,6 +1637,21 @@ QuicSendFlush(
     }
     _Analysis_assume_(Builder.Metadata != NULL);
 
+    Builder.FlushStartTime = TimeNow;
+    Builder.FlushBudgetUs =
+        Send->FlushBudgetUs != 0 ?
+            Send->FlushBudgetUs :
+            QuicSendGetDefaultFlushBudget(Connection->Registration->ExecProfile);
+
+    //
+    // Everything this flush may send counts against the registration's
+    // egress rate limit up front, and what isn't sent is given back after.
+    // When the limit leaves nothing, the flush is delayed like for pacing.
+    //
+    Builder.SendAllowance =
+        QuicRegistrationAcquireEgress(Connection->Registration, Builder.SendAllowance);
+    Builder.PacingAllowance = Builder.SendAllowance;
+
     if (Builder.Path->EcnValidationState == ECN_VALIDATION_CAPABLE) {
         Builder.EcnEctSet = TRUE;
     } else if (Builder.Path->EcnValidationState == ECN_VALIDATION_TESTING) {
@@ -1315,14 +1719,16 @@ QuicSendFlush(
                 if (QuicCongestionControlCanSend(&Connection->CongestionControl)) {
                     //
                     // The current pacing chunk is finished. We need to schedule a
-                    // new pacing send.
+                    // new pacing send. If the datapath is pacing the sends out,
+                    // we're already ahead, so there's no need to wake up as often.
                     //
                     QuicConnAddOutFlowBlockedReason(
                         Connection, QUIC_FLOW_BLOCKED_PACING);
-                    QuicConnTimerSet(
+                    QuicConnPacingTimerSet(
                         Connection,
-                        QUIC_CONN_TIMER_PACING,
-                        QUIC_SEND_PACING_INTERVAL);
+                        Builder.PacingInterval != 0 ?
+                            QUIC_SEND_PACING_OFFLOAD_HORIZON / 2 :
+                            QUIC_SEND_PACING_INTERVAL);
                     Result = QUIC_SEND_DELAYED_PACING;
                 } else {
                     //
@@ -1368,6 +1774,27 @@ QuicSendFlush(
                 Builder.Datagram->Buffer[Builder.DatagramLength++] = QUIC_FRAME_PING;
                 Builder.Metadata->Frames[Builder.Metadata->FrameCount++].Type = QUIC_FRAME_PING;
                 WrotePacketFrames = TRUE;
+
+                //
+                // If the probe is expected to succeed, fill the rest of it with
+                // stream data instead of padding. If it's lost anyway, the data
+                // is retransmitted like any other lost frame.
+                //
+                if (QuicMtuDiscoveryProbeCanCarryData(&Builder.Path->MtuDiscovery) &&
+                    (Stream != NULL ||
+                     (Stream = QuicSendGetNextStream(Send, &StreamPacketCount)) != NULL)) {
+                    const uint16_t PrevDatagramLength = Builder.DatagramLength;
+                    QuicStreamSendWrite(Stream, &Builder);
+                    if (Send->StreamSchedulingScheme == QUIC_STREAM_SCHEDULING_SCHEME_WEIGHTED_FAIR) {
+                        Stream->SendDeficit -= (int32_t)(Builder.DatagramLength - PrevDatagramLength);
+                    }
+                    if (Stream->SendFlags == 0 && Stream->SendLink.Flink != NULL) {
+                        QuicSendRemoveStream(Send, Stream);
+                        Stream->SendLink.Flink = NULL;
+                        QuicStreamRelease(Stream, QUIC_STREAM_REF_SEND);
+                        Stream = NULL;
+                    }
+                }
             } else {
                 WrotePacketFrames = FALSE;
             }
@@ -1394,19 +1821,28 @@ QuicSendFlush(
             //
             // Write the stream frames.
             //
+            const uint16_t PrevDatagramLength = Builder.DatagramLength;
             WrotePacketFrames |= QuicStreamSendWrite(Stream, &Builder);
+            if (Send->StreamSchedulingScheme == QUIC_STREAM_SCHEDULING_SCHEME_WEIGHTED_FAIR) {
+                //
+                // Charge the stream for what it wrote this round.
+                //
+                Stream->SendDeficit -= (int32_t)(Builder.DatagramLength - PrevDatagramLength);
+            }
 
             if (Stream->SendFlags == 0 && Stream->SendLink.Flink != NULL) {
                 //
                 // If the stream no longer has anything to send, remove it from the
                 // list and release Send's reference on it.
                 //
-                CxPlatListEntryRemove(&Stream->SendLink);
+                QuicSendRemoveStream(Send, Stream);
                 Stream->SendLink.Flink = NULL;
                 QuicStreamRelease(Stream, QUIC_STREAM_REF_SEND);
                 Stream = NULL;
 
             } else if ((WrotePacketFrames && --StreamPacketCount == 0) ||
+                (Send->StreamSchedulingScheme == QUIC_STREAM_SCHEDULING_SCHEME_WEIGHTED_FAIR &&
+                 Stream->SendDeficit <= 0) ||
                 !QuicSendCanSendStreamNow(Stream)) {
                 //
                 // Try a new stream next loop iteration.
@@ -1419,6 +1855,7 @@ QuicSendFlush(
             // Nothing else left to send right now.
             //
             Result = QUIC_SEND_COMPLETE;
+            OutOfData = TRUE;
             break;
         }
 
@@ -1448,7 +1885,7 @@ QuicSendFlush(
 #endif
 
     } while (Builder.SendData != NULL ||
-        Builder.TotalCountDatagrams < QUIC_MAX_DATAGRAMS_PER_SEND);
+        !QuicPacketBuilderIsFlushBudgetExhausted(&Builder));
 
     if (Builder.SendData != NULL) {
         //
@@ -1458,6 +1895,7 @@ QuicSendFlush(
         CXPLAT_DBG_ASSERT(Builder.SendData == NULL);
     }
 
+    QuicRegistrationReleaseEgress(Connection->Registration, Builder.SendAllowance);
     QuicPacketBuilderCleanup(&Builder);
 
     QuicTraceLogConnVerbose(
@@ -1466,11 +1904,14 @@ QuicSendFlush(
         "Flush complete flags=0x%x",
         Send->SendFlags);
 
+    QuicSendUpdateIdleBlockedReasons(Send, OutOfData);
+
     if (Result == QUIC_SEND_INCOMPLETE) {
         //
         // The send is limited by the scheduling logic.
         //
         QuicConnAddOutFlowBlockedReason(Connection, QUIC_FLOW_BLOCKED_SCHEDULING);
+        Connection->Worker->SendFlushesCutShort++;
 
         //
         // We have more data to send so we need to make sure a flush send
@@ -1478,12 +1919,14 @@ QuicSendFlush(
         //
         QuicSendQueueFlush(&Connection->Send, REASON_SCHEDULING);
 
-        if (Builder.TotalCountDatagrams + 1 > Connection->PeerPacketTolerance) {
+        if (Builder.TotalCountDatagrams + 1 > Connection->PeerPacketTolerance &&
+            !QuicCongestionControlIsInRecovery(&Connection->CongestionControl)) {
             //
             // We're scheduling limited, so we should tell the peer to use our
             // (max) batch size + 1 as the peer tolerance as a hint that they
             // should expect more than a single batch before needing to send an
-            // acknowledgment back.
+            // acknowledgment back. Not while recovering from congestion though,
+            // when we want prompt acknowledgments.
             //
             QuicConnUpdatePeerPacketTolerance(Connection, Builder.TotalCountDatagrams + 1);
         }
@@ -1502,6 +1945,38 @@ QuicSendFlush(
 }
 #pragma warning(pop)
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+QuicSendFlush(
+    _In_ QUIC_SEND* Send
+    )
+{
+    QuicStageCyclesStart(SendStart);
+    const BOOLEAN Result = QuicSendFlushPackets(Send);
+    QuicStageCyclesEnd(QUIC_PERF_STAGE_SEND, SendStart, 1);
+    return Result;
+}
+
+//
+// Returns the time (in microseconds) to wait before acknowledging ack-eliciting
+// packets. This is never more than the MaxAckDelayMs the peer was told about.
+//
+static
+uint64_t
+QuicSendGetAckDelayUs(
+    _In_ QUIC_SEND* Send
+    )
+{
+    const QUIC_CONNECTION* Connection = QuicSendGetConnection(Send);
+    const uint64_t MaxAckDelayUs = MS_TO_US(Connection->Settings.MaxAckDelayMs);
+    if (!Connection->Settings.AdaptiveAckDelayEnabled ||
+        Send->AdaptiveAckDelayUs == 0 ||
+        Send->AdaptiveAckDelayUs > MaxAckDelayUs) {
+        return MaxAckDelayUs;
+    }
+    return Send->AdaptiveAckDelayUs;
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 void
 QuicSendStartDelayedAckTimer(
@@ -1524,11 +1999,40 @@ QuicSendStartDelayedAckTimer(
         QuicConnTimerSet(
             Connection,
             QUIC_CONN_TIMER_ACK_DELAY,
-            MS_TO_US(Connection->Settings.MaxAckDelayMs)); // TODO - Use smaller timeout when handshake data is outstanding.
+            QuicSendGetAckDelayUs(Send)); // TODO - Use smaller timeout when handshake data is outstanding.
         Send->DelayedAckTimerActive = TRUE;
     }
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicSendShortenAckDelay(
+    _In_ QUIC_SEND* Send
+    )
+{
+    QUIC_CONNECTION* Connection = QuicSendGetConnection(Send);
+    if (!Connection->Settings.AdaptiveAckDelayEnabled) {
+        return;
+    }
+
+    const uint32_t MinAckDelayUs =
+        CXPLAT_MIN(
+            (uint32_t)MS_TO_US(MsQuicLib.TimerResolutionMs),
+            (uint32_t)MS_TO_US(Connection->Settings.MaxAckDelayMs));
+    uint32_t AckDelayUs = (uint32_t)QuicSendGetAckDelayUs(Send) / 2;
+    if (AckDelayUs < MinAckDelayUs) {
+        AckDelayUs = MinAckDelayUs;
+    }
+    if (AckDelayUs != Send->AdaptiveAckDelayUs) {
+        Send->AdaptiveAckDelayUs = AckDelayUs;
+        QuicTraceLogConnVerbose(
+            ShortenAckDelay,
+            Connection,
+            "Shortened ACK delay to %u us",
+            AckDelayUs);
+    }
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 void
 QuicSendProcessDelayedAckTimer(
@@ -1541,6 +2045,20 @@ QuicSendProcessDelayedAckTimer(
 
     QUIC_CONNECTION* Connection = QuicSendGetConnection(Send);
 
+    if (Send->AdaptiveAckDelayUs != 0) {
+        //
+        // Nothing needed a faster ACK for a whole delay period, so the flow is
+        // stable. Grow the delay back towards MaxAckDelayMs.
+        //
+        const uint32_t MaxAckDelayUs =
+            (uint32_t)MS_TO_US(Connection->Settings.MaxAckDelayMs);
+        Send->AdaptiveAckDelayUs +=
+            CXPLAT_MAX(MaxAckDelayUs >> QUIC_ADAPTIVE_ACK_DELAY_GROWTH_SHIFT, 1);
+        if (Send->AdaptiveAckDelayUs >= MaxAckDelayUs) {
+            Send->AdaptiveAckDelayUs = 0;
+        }
+    }
+
     BOOLEAN AckElicitingPacketsToAcknowledge = FALSE;
     for (uint32_t i = 0; i < QUIC_ENCRYPT_LEVEL_COUNT; ++i) {
         if (Connection->Packets[i] != NULL &&
@@ -145,6 +145,7 @@ QuicPacketTypeToEncryptLevelV2(
 #define QUIC_CONN_SEND_FLAG_ACK_FREQUENCY           0x00008000U
 #define QUIC_CONN_SEND_FLAG_BIDI_STREAMS_BLOCKED    0x00010000U
 #define QUIC_CONN_SEND_FLAG_UNI_STREAMS_BLOCKED     0x00020000U
+#define QUIC_CONN_SEND_FLAG_IMMEDIATE_ACK           0x00040000U
 #define QUIC_CONN_SEND_FLAG_DPLPMTUD                0x80000000U
 
 //
@@ -174,6 +175,7 @@ QuicPacketTypeToEncryptLevelV2(
     QUIC_CONN_SEND_FLAG_PING | \
     QUIC_CONN_SEND_FLAG_DATAGRAM | \
     QUIC_CONN_SEND_FLAG_ACK_FREQUENCY | \
+    QUIC_CONN_SEND_FLAG_IMMEDIATE_ACK | \
     QUIC_CONN_SEND_FLAG_DPLPMTUD | \
     QUIC_CONN_SEND_FLAG_BIDI_STREAMS_BLOCKED | \
     QUIC_CONN_SEND_FLAG_UNI_STREAMS_BLOCKED \
@@ -272,6 +274,37 @@ typedef struct QUIC_SEND {
     //
     uint64_t LastFlushTime;
 
+    //
+    // The app's override of the time budget (in microseconds) for each send
+    // flush, or zero to use the default of the registration's execution
+    // profile.
+    //
+    uint32_t FlushBudgetUs;
+
+    //
+    // The app's maximum time (in microseconds) to hold small stream sends so
+    // that they can be coalesced into fuller packets, or zero if disabled.
+    //
+    uint32_t CoalescingDelayUs;
+
+    //
+    // The current delay (in microseconds) before acknowledging ack-eliciting
+    // packets, when AdaptiveAckDelayEnabled is set. Zero until the first
+    // reordering, loss or congestion mark shortens it below MaxAckDelayMs.
+    //
+    uint32_t AdaptiveAckDelayUs;
+
+    //
+    // Bytes of stream data currently being held for coalescing.
+    //
+    uint64_t CoalescedBytes;
+
+    //
+    // The time up to which send allowance has already been granted, when
+    // pacing is offloaded to the datapath. Always ahead of LastFlushTime.
+    //
+    uint64_t PacingOffloadTime;
+
     //
     // The total number of packets sent with each corresponding ECT codepoint in all encryption
     // level.
@@ -312,11 +345,22 @@ typedef struct QUIC_SEND {
     //
     uint32_t SendFlags;
 
+    //
+    // The QUIC_STREAM_SCHEDULING_SCHEME used to order SendStreams.
+    //
+    uint8_t StreamSchedulingScheme;
+
     //
     // List of streams with data or control frames to send.
     //
     CXPLAT_LIST_ENTRY SendStreams;
 
+    //
+    // The last stream in SendStreams for each priority class, or NULL if the
+    // class is empty. Only maintained for the extensible priority scheme.
+    //
+    CXPLAT_LIST_ENTRY* PriorityClassTails[QUIC_STREAM_PRIORITY_CLASS_COUNT];
+
     //
     // The current token to send with an Initial packet.
     //
@@ -421,9 +465,63 @@ QuicSendUpdateStreamPriority(
     _In_ QUIC_STREAM* Stream
     );
 
+//
+// Updates the order of all the (queued) streams in a stream group in response
+// to a change of the group's priority.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSendUpdateStreamGroupPriority(
+    _In_ QUIC_SEND* Send,
+    _In_ CXPLAT_LIST_ENTRY* GroupStreams
+    );
+
+//
+// Changes the stream scheduling scheme and reorders any queued streams.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSendSetStreamSchedulingScheme(
+    _In_ QUIC_SEND* Send,
+    _In_ QUIC_STREAM_SCHEDULING_SCHEME Scheme
+    );
+
+//
+// Returns the default time budget (in microseconds) of a send flush for
+// connections of the execution profile.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+uint32_t
+QuicSendGetDefaultFlushBudget(
+    _In_ QUIC_EXECUTION_PROFILE ExecProfile
+    );
+
+//
+// Returns TRUE if a newly queued stream send should be held back (treated as
+// delayed) so that it can be coalesced with other sends.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+QuicSendCoalesceStreamData(
+    _In_ QUIC_SEND* Send,
+    _In_ uint64_t Length,
+    _In_ QUIC_SEND_FLAGS Flags
+    );
+
+//
+// Sets the coalescing delay. Zero disables coalescing and flushes anything
+// currently being held.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSendSetCoalescingDelay(
+    _In_ QUIC_SEND* Send,
+    _In_ uint32_t DelayUs
+    );
+
 //
 // Tries to drain all queued data that needs to be sent. Returns TRUE if all the
-// data was drained.
+// data was drained, or FALSE if the flush ran out of its budget first.
 //
 _IRQL_requires_max_(PASSIVE_LEVEL)
 BOOLEAN
@@ -440,6 +538,16 @@ QuicSendStartDelayedAckTimer(
     _In_ QUIC_SEND* Send
     );
 
+//
+// Shortens the adaptive ACK delay after receiving a reordered, out of order or
+// CE marked packet.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicSendShortenAckDelay(
+    _In_ QUIC_SEND* Send
+    );
+
 //
 // Called in response to the delayed ACK timer expiring.
 //
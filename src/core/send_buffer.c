@@ -66,6 +66,7 @@ QuicSendBufferInitialize(
     )
 {
     SendBuffer->IdealBytes = QUIC_DEFAULT_IDEAL_SEND_BUFFER_SIZE;
+    SendBuffer->ScaledIdealBytes = QUIC_DEFAULT_IDEAL_SEND_BUFFER_SIZE;
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -74,7 +75,34 @@ QuicSendBufferUninitialize(
     _In_ QUIC_SEND_BUFFER* SendBuffer
     )
 {
-    UNREFERENCED_PARAMETER(SendBuffer);
+    if (SendBuffer->MemoryRegions != NULL) {
+        CXPLAT_FREE(SendBuffer->MemoryRegions, QUIC_POOL_SEND_MEMORY_REGIONS);
+        SendBuffer->MemoryRegions = NULL;
+        SendBuffer->MemoryRegionCount = 0;
+    }
+}
+
+//
+// Charges (or credits) copied send buffer bytes against the library-wide
+// budget and the owning registration's usage.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicSendBufferUpdateUsage(
+    _In_ QUIC_SEND_BUFFER* SendBuffer,
+    _In_ int64_t Delta
+    )
+{
+    QUIC_CONNECTION* Connection =
+        CXPLAT_CONTAINING_RECORD(SendBuffer, QUIC_CONNECTION, SendBuffer);
+    Connection->MemoryUsage.SendBuffer += Delta;
+    InterlockedExchangeAdd64(
+        (int64_t*)&MsQuicLib.CurrentSendBufferUsage, Delta);
+    if (Connection->Registration != NULL) {
+        InterlockedExchangeAdd64(
+            (int64_t*)&Connection->Registration->CurrentSendBufferUsage, Delta);
+    }
+    QuicLibraryEvaluateMemoryPressure();
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -89,6 +117,7 @@ QuicSendBufferAlloc(
 
     if (Buf != NULL) {
         SendBuffer->BufferedBytes += Size;
+        QuicSendBufferUpdateUsage(SendBuffer, (int64_t)Size);
     } else {
         QuicTraceEvent(
             AllocFailure,
@@ -110,6 +139,73 @@ QuicSendBufferFree(
 {
     CXPLAT_FREE(Buf, QUIC_POOL_SENDBUF);
     SendBuffer->BufferedBytes -= Size;
+    QuicSendBufferUpdateUsage(SendBuffer, -1 * (int64_t)Size);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicSendBufferTrim(
+    _Inout_ QUIC_SEND_BUFFER* SendBuffer,
+    _In_ uint32_t Size,
+    _In_ uint32_t NewSize
+    )
+{
+    CXPLAT_DBG_ASSERT(NewSize <= Size);
+    SendBuffer->BufferedBytes -= Size - NewSize;
+    QuicSendBufferUpdateUsage(SendBuffer, -1 * (int64_t)(Size - NewSize));
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicSendBufferRegisterMemory(
+    _Inout_ QUIC_SEND_BUFFER* SendBuffer,
+    _In_ const QUIC_BUFFER* Region
+    )
+{
+    if (Region->Buffer == NULL || Region->Length == 0) {
+        return QUIC_STATUS_INVALID_PARAMETER;
+    }
+
+    if (SendBuffer->MemoryRegionCount == QUIC_MAX_SEND_MEMORY_REGIONS) {
+        return QUIC_STATUS_INVALID_STATE;
+    }
+
+    if (SendBuffer->MemoryRegions == NULL) {
+        SendBuffer->MemoryRegions =
+            CXPLAT_ALLOC_NONPAGED(
+                QUIC_MAX_SEND_MEMORY_REGIONS * sizeof(QUIC_BUFFER),
+                QUIC_POOL_SEND_MEMORY_REGIONS);
+        if (SendBuffer->MemoryRegions == NULL) {
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "send memory regions",
+                QUIC_MAX_SEND_MEMORY_REGIONS * sizeof(QUIC_BUFFER));
+            return QUIC_STATUS_OUT_OF_MEMORY;
+        }
+    }
+
+    SendBuffer->MemoryRegions[SendBuffer->MemoryRegionCount++] = *Region;
+
+    return QUIC_STATUS_SUCCESS;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicSendBufferIsRegisteredMemory(
+    _In_ const QUIC_SEND_BUFFER* SendBuffer,
+    _In_reads_bytes_(Length) const uint8_t* Buffer,
+    _In_ uint64_t Length
+    )
+{
+    for (uint32_t i = 0; i < SendBuffer->MemoryRegionCount; ++i) {
+        const QUIC_BUFFER* Region = &SendBuffer->MemoryRegions[i];
+        if (Buffer >= Region->Buffer &&
+            (uint64_t)(Buffer - Region->Buffer) + Length <= Region->Length) {
+            return TRUE;
+        }
+    }
+    return FALSE;
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -118,7 +214,9 @@ QuicSendBufferHasSpace(
     _Inout_ QUIC_SEND_BUFFER* SendBuffer
     )
 {
-    return SendBuffer->BufferedBytes < SendBuffer->IdealBytes;
+    return
+        SendBuffer->BufferedBytes <
+        QuicSendBufferGetScaledIdealBytes(SendBuffer->IdealBytes);
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -211,6 +309,41 @@ QuicGetNextIdealBytes(
     return Threshold;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint64_t
+QuicSendBufferGetScaledIdealBytes(
+    _In_ uint64_t IdealBytes
+    )
+{
+    const uint64_t Limit = MsQuicLib.SendBufferLimit;
+    if (Limit == 0) {
+        return IdealBytes; // No library-wide budget.
+    }
+
+    //
+    // Ideal sizes are left alone until half of the budget is used, and then
+    // scaled down linearly to the default as usage approaches the budget. The
+    // scaled value is rounded to the same thresholds used for growth so that
+    // small changes in global usage don't churn ISB indications.
+    //
+    const uint64_t Usage = MsQuicLib.CurrentSendBufferUsage;
+    const uint64_t Half = Limit / 2;
+    if (Usage <= Half) {
+        return IdealBytes;
+    }
+    if (Usage >= Limit || IdealBytes <= QUIC_DEFAULT_IDEAL_SEND_BUFFER_SIZE) {
+        return CXPLAT_MIN(IdealBytes, QUIC_DEFAULT_IDEAL_SEND_BUFFER_SIZE);
+    }
+
+    uint64_t Factor = (Limit - Usage) / CXPLAT_MAX(Half / 256, 1);
+    if (Factor > 256) {
+        Factor = 256;
+    }
+    const uint64_t ScaledBytes =
+        QuicGetNextIdealBytes((uint32_t)((IdealBytes * Factor) / 256));
+    return CXPLAT_MIN(IdealBytes, ScaledBytes);
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicSendBufferStreamAdjust(
@@ -222,7 +355,9 @@ QuicSendBufferStreamAdjust(
     // a minimum of the connection-wide IdealBytes and the value based on the
     // stream's estimated SendWindow.
     //
-    uint64_t ByteCount = Stream->Connection->SendBuffer.IdealBytes;
+    uint64_t ByteCount =
+        QuicSendBufferGetScaledIdealBytes(
+            Stream->Connection->SendBuffer.IdealBytes);
     if ((uint64_t)Stream->SendWindow < ByteCount) {
         const uint64_t SendWindowIdealBytes =
             QuicGetNextIdealBytes(Stream->SendWindow);
@@ -252,21 +387,33 @@ QuicSendBufferConnectionAdjust(
     _In_ QUIC_CONNECTION* Connection
     )
 {
-    if (Connection->SendBuffer.IdealBytes == QUIC_MAX_IDEAL_SEND_BUFFER_SIZE ||
-        Connection->Streams.StreamTable == NULL) {
+    if (Connection->Streams.StreamTable == NULL) {
         return; // Nothing to do.
     }
 
-    const uint64_t NewIdealBytes =
-        QuicGetNextIdealBytes(
-            QuicCongestionControlGetBytesInFlightMax(&Connection->CongestionControl));
-
     //
     // TODO: Currently, IdealBytes only grows and never shrinks. Add appropriate
     // shrinking logic.
     //
-    if (NewIdealBytes > Connection->SendBuffer.IdealBytes) {
-        Connection->SendBuffer.IdealBytes = NewIdealBytes;
+    if (Connection->SendBuffer.IdealBytes != QUIC_MAX_IDEAL_SEND_BUFFER_SIZE) {
+        const uint64_t NewIdealBytes =
+            QuicGetNextIdealBytes(
+                QuicCongestionControlGetBytesInFlightMax(&Connection->CongestionControl));
+        if (NewIdealBytes > Connection->SendBuffer.IdealBytes) {
+            Connection->SendBuffer.IdealBytes = NewIdealBytes;
+        }
+    }
+
+    //
+    // The value indicated to the app may also move with library-wide memory
+    // pressure, in either direction.
+    //
+    const uint64_t ScaledIdealBytes =
+        QuicSendBufferGetScaledIdealBytes(Connection->SendBuffer.IdealBytes);
+    if (ScaledIdealBytes != Connection->SendBuffer.ScaledIdealBytes) {
+        const BOOLEAN Grew =
+            ScaledIdealBytes > Connection->SendBuffer.ScaledIdealBytes;
+        Connection->SendBuffer.ScaledIdealBytes = ScaledIdealBytes;
 
         CXPLAT_HASHTABLE_ENUMERATOR Enumerator;
         CXPLAT_HASHTABLE_ENTRY* Entry;
@@ -279,7 +426,7 @@ QuicSendBufferConnectionAdjust(
         }
         CxPlatHashtableEnumerateEnd(Connection->Streams.StreamTable, &Enumerator);
 
-        if (Connection->Settings.SendBufferingEnabled) {
+        if (Grew && Connection->Settings.SendBufferingEnabled) {
             QuicSendBufferFill(Connection);
         }
     }
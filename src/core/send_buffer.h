@@ -27,6 +27,20 @@ typedef struct QUIC_SEND_BUFFER {
     //
     uint64_t IdealBytes;
 
+    //
+    // IdealBytes scaled down for library-wide send buffer memory pressure, as
+    // last used by QuicSendBufferConnectionAdjust.
+    //
+    uint64_t ScaledIdealBytes;
+
+    //
+    // App memory registered via QUIC_PARAM_CONN_SEND_MEMORY_REGION. Send
+    // requests that lie completely within one of these regions are buffered
+    // by reference instead of being copied.
+    //
+    QUIC_BUFFER* MemoryRegions;
+    uint32_t MemoryRegionCount;
+
 } QUIC_SEND_BUFFER;
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -60,6 +74,40 @@ QuicSendBufferFree(
     _In_ uint32_t Size
     );
 
+//
+// Stops accounting for the unused tail of a buffer from QuicSendBufferAlloc,
+// which must then be freed with NewSize.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicSendBufferTrim(
+    _Inout_ QUIC_SEND_BUFFER* SendBuffer,
+    _In_ uint32_t Size,
+    _In_ uint32_t NewSize
+    );
+
+//
+// Registers an app memory region that must stay valid and unmodified for the
+// rest of the connection's lifetime.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicSendBufferRegisterMemory(
+    _Inout_ QUIC_SEND_BUFFER* SendBuffer,
+    _In_ const QUIC_BUFFER* Region
+    );
+
+//
+// Returns TRUE if the bytes lie completely within a registered memory region.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicSendBufferIsRegisteredMemory(
+    _In_ const QUIC_SEND_BUFFER* SendBuffer,
+    _In_reads_bytes_(Length) const uint8_t* Buffer,
+    _In_ uint64_t Length
+    );
+
 //
 // Buffers pending send requests until the send buffer is full.
 // Should be called when the send buffer is adjusted or bytes are ACKed.
@@ -70,6 +118,16 @@ QuicSendBufferFill(
     _In_ QUIC_CONNECTION* Connection
     );
 
+//
+// Scales an ideal send buffer size down as library-wide send buffer usage
+// approaches QUIC_PARAM_GLOBAL_SEND_BUFFER_LIMIT.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint64_t
+QuicSendBufferGetScaledIdealBytes(
+    _In_ uint64_t IdealBytes
+    );
+
 //
 // Indicates an ISB update to the stream.
 //
@@ -80,7 +138,8 @@ QuicSendBufferStreamAdjust(
     );
 
 //
-// Updates IdealBytes upon change of BytesInFlightMax.
+// Updates IdealBytes upon change of BytesInFlightMax or library-wide send
+// buffer memory pressure.
 //
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
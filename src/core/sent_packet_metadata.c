@@ -14,6 +14,10 @@ Abstract:
     contained in the packet. The allocator uses a different pool for each
     possible size.
 
+    Connections with many packets in flight instead allocate from their own
+    ring arena (QUIC_SENT_PACKET_ARENA), falling back to the pools only when
+    the arena is full.
+
 --*/
 
 #include "precomp.h"
@@ -69,6 +73,174 @@ QuicSentPacketMetadataReleaseFrames(
     }
 }
 
+//
+// Header in front of each allocation in the arena.
+//
+typedef struct QUIC_SENT_PACKET_ARENA_ENTRY {
+
+    //
+    // Length of the allocation, including this header. Always a multiple of
+    // the header size, so that all the entries stay aligned.
+    //
+    uint32_t Length;
+
+    //
+    // TRUE once the allocation has been freed (or if it is just padding at
+    // the end of the ring), so that it may be reclaimed.
+    //
+    uint32_t Freed;
+
+} QUIC_SENT_PACKET_ARENA_ENTRY;
+
+CXPLAT_STATIC_ASSERT(
+    QUIC_SENT_PACKET_ARENA_SIZE % sizeof(QUIC_SENT_PACKET_ARENA_ENTRY) == 0,
+    "Arena must be made up of whole entry headers");
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicSentPacketArenaInitialize(
+    _Out_ QUIC_SENT_PACKET_ARENA* Arena
+    )
+{
+    Arena->Buffer = NULL;
+    Arena->Head = 0;
+    Arena->Tail = 0;
+    Arena->Used = 0;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicSentPacketArenaUninitialize(
+    _In_ QUIC_SENT_PACKET_ARENA* Arena
+    )
+{
+    CXPLAT_DBG_ASSERT(Arena->Used == 0);
+    if (Arena->Buffer != NULL) {
+        CXPLAT_FREE(Arena->Buffer, QUIC_POOL_SENT_PACKET_ARENA);
+        Arena->Buffer = NULL;
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicSentPacketArenaTrim(
+    _In_ QUIC_SENT_PACKET_ARENA* Arena
+    )
+{
+    if (Arena->Buffer == NULL || Arena->Used != 0) {
+        return FALSE;
+    }
+    CXPLAT_FREE(Arena->Buffer, QUIC_POOL_SENT_PACKET_ARENA);
+    Arena->Buffer = NULL;
+    return TRUE;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_SENT_PACKET_METADATA*
+QuicSentPacketArenaGetPacketMetadata(
+    _In_ QUIC_SENT_PACKET_ARENA* Arena,
+    _In_ uint8_t FrameCount
+    )
+{
+    const uint32_t Length =
+        (uint32_t)ALIGN_UP(
+            sizeof(QUIC_SENT_PACKET_ARENA_ENTRY) +
+            SIZEOF_QUIC_SENT_PACKET_METADATA(FrameCount),
+            QUIC_SENT_PACKET_ARENA_ENTRY);
+
+    if (Arena->Buffer == NULL) {
+        Arena->Buffer =
+            CXPLAT_ALLOC_NONPAGED(QUIC_SENT_PACKET_ARENA_SIZE, QUIC_POOL_SENT_PACKET_ARENA);
+        if (Arena->Buffer == NULL) {
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "sent packet arena",
+                QUIC_SENT_PACKET_ARENA_SIZE);
+            return NULL;
+        }
+        Arena->Head = Arena->Tail = Arena->Used = 0;
+    }
+
+    if (Arena->Used == 0) {
+        Arena->Head = Arena->Tail = 0; // Start over to get the most contiguous space.
+    } else if (Arena->Used == QUIC_SENT_PACKET_ARENA_SIZE) {
+        return NULL;
+    }
+
+    if (Arena->Head >= Arena->Tail) {
+        //
+        // The free space is split between the end and the start of the ring.
+        //
+        const uint32_t SpaceAtEnd = QUIC_SENT_PACKET_ARENA_SIZE - Arena->Head;
+        if (SpaceAtEnd < Length) {
+            if (Arena->Tail < Length) {
+                return NULL;
+            }
+            //
+            // Skip the rest of the ring, with padding that is reclaimed along
+            // with the entries before it.
+            //
+            QUIC_SENT_PACKET_ARENA_ENTRY* Padding =
+                (QUIC_SENT_PACKET_ARENA_ENTRY*)(Arena->Buffer + Arena->Head);
+            Padding->Length = SpaceAtEnd;
+            Padding->Freed = TRUE;
+            Arena->Used += SpaceAtEnd;
+            Arena->Head = 0;
+        }
+    } else if (Arena->Tail - Arena->Head < Length) {
+        return NULL;
+    }
+
+    QUIC_SENT_PACKET_ARENA_ENTRY* Entry =
+        (QUIC_SENT_PACKET_ARENA_ENTRY*)(Arena->Buffer + Arena->Head);
+    Entry->Length = Length;
+    Entry->Freed = FALSE;
+    Arena->Head += Length;
+    if (Arena->Head == QUIC_SENT_PACKET_ARENA_SIZE) {
+        Arena->Head = 0;
+    }
+    Arena->Used += Length;
+
+    QUIC_SENT_PACKET_METADATA* Metadata = (QUIC_SENT_PACKET_METADATA*)(Entry + 1);
+#if DEBUG
+    Metadata->Flags.Freed = FALSE;
+#endif
+    return Metadata;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicSentPacketArenaReturnPacketMetadata(
+    _In_ QUIC_SENT_PACKET_ARENA* Arena,
+    _In_ QUIC_SENT_PACKET_METADATA* Metadata
+    )
+{
+    QUIC_SENT_PACKET_ARENA_ENTRY* Entry =
+        ((QUIC_SENT_PACKET_ARENA_ENTRY*)Metadata) - 1;
+    CXPLAT_DBG_ASSERT(!Entry->Freed);
+    Entry->Freed = TRUE;
+
+    //
+    // Reclaim everything at the tail that has been freed. Packets are usually
+    // freed in the order they were sent, so this typically reclaims each
+    // entry as it's freed, or a whole run of entries at once when a lingering
+    // packet at the tail is finally freed.
+    //
+    while (Arena->Used != 0) {
+        Entry = (QUIC_SENT_PACKET_ARENA_ENTRY*)(Arena->Buffer + Arena->Tail);
+        if (!Entry->Freed) {
+            break;
+        }
+        CXPLAT_DBG_ASSERT(Entry->Length <= Arena->Used);
+        Arena->Used -= Entry->Length;
+        Arena->Tail += Entry->Length;
+        if (Arena->Tail == QUIC_SENT_PACKET_ARENA_SIZE) {
+            Arena->Tail = 0;
+        }
+    }
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 void
 QuicSentPacketPoolInitialize(
@@ -132,5 +304,12 @@ QuicSentPacketPoolReturnPacketMetadata(
 #endif
 
     QuicSentPacketMetadataReleaseFrames(Metadata, Connection);
-    CxPlatPoolFree(Connection->Worker->SentPacketPool.Pools + Metadata->FrameCount - 1, Metadata);
+    if (Metadata->Flags.FromArena) {
+        QuicSentPacketArenaReturnPacketMetadata(
+            &Connection->LossDetection.SentPacketArena, Metadata);
+    } else {
+        Connection->MemoryUsage.SentPackets -=
+            SIZEOF_QUIC_SENT_PACKET_METADATA(Metadata->FrameCount);
+        CxPlatPoolFree(Connection->Worker->SentPacketPool.Pools + Metadata->FrameCount - 1, Metadata);
+    }
 }
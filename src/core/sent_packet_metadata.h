@@ -5,6 +5,10 @@
 
 --*/
 
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
 //
 // The maximum number of frames we will write to a single packet.
 //
@@ -98,6 +102,7 @@ typedef struct QUIC_SEND_PACKET_FLAGS {
     BOOLEAN IsAppLimited            : 1;
     BOOLEAN HasLastAckedPacketInfo  : 1;
     BOOLEAN EcnEctSet               : 1;
+    BOOLEAN FromArena               : 1;
 #if DEBUG
     BOOLEAN Freed                   : 1;
 #endif
@@ -247,3 +252,87 @@ QuicSentPacketPoolReturnPacketMetadata(
     _In_ QUIC_SENT_PACKET_METADATA* Metadata,
     _In_ QUIC_CONNECTION* Connection
     );
+
+//
+// A per-connection ring of sent packet metadata. Packets are allocated at the
+// head in the order they are sent and, since they are mostly freed in that
+// same order as ACKs arrive, their space is reclaimed from the tail in bulk
+// without any per-packet pool operations. A packet that lingers (e.g. one
+// declared lost) holds back reclaiming the space after it until it's freed.
+//
+typedef struct QUIC_SENT_PACKET_ARENA {
+
+    //
+    // The ring's memory. NULL until first needed.
+    //
+    uint8_t* Buffer;
+
+    //
+    // Offset of the next allocation.
+    //
+    uint32_t Head;
+
+    //
+    // Offset of the oldest allocation that hasn't been reclaimed yet.
+    //
+    uint32_t Tail;
+
+    //
+    // Number of bytes between Tail and Head, including any padding skipped at
+    // the end of the ring.
+    //
+    uint32_t Used;
+
+} QUIC_SENT_PACKET_ARENA;
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicSentPacketArenaInitialize(
+    _Out_ QUIC_SENT_PACKET_ARENA* Arena
+    );
+
+//
+// Frees the ring's memory. All the metadata allocated from it must have
+// already been freed.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicSentPacketArenaUninitialize(
+    _In_ QUIC_SENT_PACKET_ARENA* Arena
+    );
+
+//
+// Frees the ring's memory if nothing is allocated from it. Returns TRUE if
+// memory was freed. The ring is allocated again when next needed.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicSentPacketArenaTrim(
+    _In_ QUIC_SENT_PACKET_ARENA* Arena
+    );
+
+//
+// Allocates a sent packet metadata item from the ring. Returns NULL if there
+// isn't enough contiguous space left in it.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_SENT_PACKET_METADATA*
+QuicSentPacketArenaGetPacketMetadata(
+    _In_ QUIC_SENT_PACKET_ARENA* Arena,
+    _In_ uint8_t FrameCount
+    );
+
+//
+// Returns a sent packet metadata item to the ring. Callers should use
+// QuicSentPacketPoolReturnPacketMetadata, which handles either allocator.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicSentPacketArenaReturnPacketMetadata(
+    _In_ QUIC_SENT_PACKET_ARENA* Arena,
+    _In_ QUIC_SENT_PACKET_METADATA* Metadata
+    );
+
+#if defined(__cplusplus)
+}
+#endif
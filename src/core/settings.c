@@ -21,6 +21,68 @@ QuicSettingsCopyVersionSettings(
     _In_ BOOLEAN CopyExternalToInternal
     );
 
+//
+// Version settings are never modified once filled in, so copies of settings
+// share them by reference instead of each allocating their own.
+//
+typedef struct QUIC_VERSION_SETTINGS_BLOCK {
+    CXPLAT_REF_COUNT RefCount;
+    QUIC_VERSION_SETTINGS Settings;
+    // The version lists follow.
+} QUIC_VERSION_SETTINGS_BLOCK;
+
+//
+// Allocates version settings with room for VersionsSize bytes of version
+// lists, starting at (Settings + 1).
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+QUIC_VERSION_SETTINGS*
+QuicVersionSettingsAlloc(
+    _In_ size_t VersionsSize
+    )
+{
+    const size_t AllocSize = sizeof(QUIC_VERSION_SETTINGS_BLOCK) + VersionsSize;
+    QUIC_VERSION_SETTINGS_BLOCK* Block =
+        CXPLAT_ALLOC_NONPAGED(AllocSize, QUIC_POOL_VERSION_SETTINGS);
+    if (Block == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "VersionSettings",
+            AllocSize);
+        return NULL;
+    }
+    CxPlatRefInitialize(&Block->RefCount);
+    return &Block->Settings;
+}
+
+static
+QUIC_VERSION_SETTINGS*
+QuicVersionSettingsAddRef(
+    _In_ const QUIC_VERSION_SETTINGS* VersionSettings
+    )
+{
+    QUIC_VERSION_SETTINGS_BLOCK* Block =
+        CXPLAT_CONTAINING_RECORD(VersionSettings, QUIC_VERSION_SETTINGS_BLOCK, Settings);
+    CxPlatRefIncrement(&Block->RefCount);
+    return &Block->Settings;
+}
+
+static
+void
+QuicVersionSettingsRelease(
+    _In_ QUIC_VERSION_SETTINGS* VersionSettings
+    )
+{
+    QUIC_VERSION_SETTINGS_BLOCK* Block =
+        CXPLAT_CONTAINING_RECORD(VersionSettings, QUIC_VERSION_SETTINGS_BLOCK, Settings);
+    if (CxPlatRefDecrement(&Block->RefCount)) {
+        CxPlatRefUninitialize(&Block->RefCount);
+        CXPLAT_FREE(Block, QUIC_POOL_VERSION_SETTINGS);
+    }
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicSettingsSetDefault(
@@ -51,6 +113,9 @@ QuicSettingsSetDefault(
     if (!Settings->IsSet.FixedServerID) {
         Settings->FixedServerID = 0;
     }
+    if (!Settings->IsSet.ConnectionPoolPrewarmCount) {
+        Settings->ConnectionPoolPrewarmCount = QUIC_DEFAULT_CONNECTION_POOL_PREWARM_COUNT;
+    }
     if (!Settings->IsSet.MaxWorkerQueueDelayUs) {
         Settings->MaxWorkerQueueDelayUs = MS_TO_US(QUIC_MAX_WORKER_QUEUE_DELAY);
     }
@@ -168,6 +233,27 @@ QuicSettingsSetDefault(
     if (!Settings->IsSet.StreamMultiReceiveEnabled) {
         Settings->StreamMultiReceiveEnabled = QUIC_DEFAULT_STREAM_MULTI_RECEIVE_ENABLED;
     }
+    if (!Settings->IsSet.CarefulResumeEnabled) {
+        Settings->CarefulResumeEnabled = QUIC_DEFAULT_CAREFUL_RESUME_ENABLED;
+    }
+    if (!Settings->IsSet.ReleaseHandshakeStateEnabled) {
+        Settings->ReleaseHandshakeStateEnabled = QUIC_DEFAULT_RELEASE_HANDSHAKE_STATE_ENABLED;
+    }
+    if (!Settings->IsSet.ResumptionTicketCacheEnabled) {
+        Settings->ResumptionTicketCacheEnabled = QUIC_DEFAULT_RESUMPTION_TICKET_CACHE_ENABLED;
+    }
+    if (!Settings->IsSet.AdaptiveAckDelayEnabled) {
+        Settings->AdaptiveAckDelayEnabled = QUIC_DEFAULT_ADAPTIVE_ACK_DELAY_ENABLED;
+    }
+    if (!Settings->IsSet.NetStatsEventThreshold) {
+        Settings->NetStatsEventThreshold = QUIC_DEFAULT_NET_STATS_EVENT_THRESHOLD;
+    }
+    if (!Settings->IsSet.HibernateTimeoutMs) {
+        Settings->HibernateTimeoutMs = QUIC_DEFAULT_HIBERNATE_TIMEOUT_MS;
+    }
+    if (!Settings->IsSet.EarlyCreditWindow) {
+        Settings->EarlyCreditWindow = QUIC_DEFAULT_EARLY_CREDIT_WINDOW;
+    }
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -201,6 +287,9 @@ QuicSettingsCopy(
     if (!Destination->IsSet.FixedServerID) {
         Destination->FixedServerID = Source->FixedServerID;
     }
+    if (!Destination->IsSet.ConnectionPoolPrewarmCount) {
+        Destination->ConnectionPoolPrewarmCount = Source->ConnectionPoolPrewarmCount;
+    }
     if (!Destination->IsSet.MaxWorkerQueueDelayUs) {
         Destination->MaxWorkerQueueDelayUs = Source->MaxWorkerQueueDelayUs;
     }
@@ -272,12 +361,12 @@ QuicSettingsCopy(
     }
     if (!Destination->IsSet.VersionSettings) {
         if (Destination->VersionSettings) {
-            CXPLAT_FREE(Destination->VersionSettings, QUIC_POOL_VERSION_SETTINGS);
+            QuicVersionSettingsRelease(Destination->VersionSettings);
             Destination->VersionSettings = NULL;
         }
         if (Source->VersionSettings != NULL) {
             Destination->VersionSettings =
-                QuicSettingsCopyVersionSettings(Source->VersionSettings, FALSE);
+                QuicVersionSettingsAddRef(Source->VersionSettings);
         }
     }
 
@@ -336,6 +425,89 @@ QuicSettingsCopy(
     if (!Destination->IsSet.StreamMultiReceiveEnabled) {
         Destination->StreamMultiReceiveEnabled = Source->StreamMultiReceiveEnabled;
     }
+    if (!Destination->IsSet.CarefulResumeEnabled) {
+        Destination->CarefulResumeEnabled = Source->CarefulResumeEnabled;
+    }
+    if (!Destination->IsSet.ReleaseHandshakeStateEnabled) {
+        Destination->ReleaseHandshakeStateEnabled = Source->ReleaseHandshakeStateEnabled;
+    }
+    if (!Destination->IsSet.ResumptionTicketCacheEnabled) {
+        Destination->ResumptionTicketCacheEnabled = Source->ResumptionTicketCacheEnabled;
+    }
+    if (!Destination->IsSet.AdaptiveAckDelayEnabled) {
+        Destination->AdaptiveAckDelayEnabled = Source->AdaptiveAckDelayEnabled;
+    }
+    if (!Destination->IsSet.NetStatsEventThreshold) {
+        Destination->NetStatsEventThreshold = Source->NetStatsEventThreshold;
+    }
+    if (!Destination->IsSet.HibernateTimeoutMs) {
+        Destination->HibernateTimeoutMs = Source->HibernateTimeoutMs;
+    }
+    if (!Destination->IsSet.EarlyCreditWindow) {
+        Destination->EarlyCreditWindow = Source->EarlyCreditWindow;
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSettingsInherit(
+    _Out_ QUIC_SETTINGS_INTERNAL* Destination,
+    _In_ const QUIC_SETTINGS_INTERNAL* Source
+    )
+{
+    *Destination = *Source;
+    Destination->IsSetFlags = 0;
+    if (Destination->VersionSettings != NULL) {
+        (void)QuicVersionSettingsAddRef(Destination->VersionSettings);
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSettingsCopyLive(
+    _Inout_ QUIC_SETTINGS_INTERNAL* Destination,
+    _In_ const QUIC_SETTINGS_INTERNAL* Source
+    )
+{
+    //
+    // Everything here is read where it is used, or (congestion control) is
+    // reinitialized by the caller. Transport parameters already sent to the
+    // peer, stream and connection windows already granted, and anything that
+    // would need buffered data to be reshaped are deliberately left out.
+    //
+    if (!Destination->IsSet.PacingEnabled) {
+        Destination->PacingEnabled = Source->PacingEnabled;
+    }
+    if (!Destination->IsSet.CongestionControlAlgorithm) {
+        Destination->CongestionControlAlgorithm = Source->CongestionControlAlgorithm;
+    }
+    if (!Destination->IsSet.HyStartEnabled) {
+        Destination->HyStartEnabled = Source->HyStartEnabled;
+    }
+    if (!Destination->IsSet.InitialWindowPackets) {
+        Destination->InitialWindowPackets = Source->InitialWindowPackets;
+    }
+    if (!Destination->IsSet.SendIdleTimeoutMs) {
+        Destination->SendIdleTimeoutMs = Source->SendIdleTimeoutMs;
+    }
+    if (!Destination->IsSet.StreamRecvBufferDefault) {
+        Destination->StreamRecvBufferDefault = Source->StreamRecvBufferDefault;
+    }
+    if (!Destination->IsSet.ConnFlowControlWindow) {
+        Destination->ConnFlowControlWindow = Source->ConnFlowControlWindow;
+    }
+    if (!Destination->IsSet.MaxBytesPerKey) {
+        Destination->MaxBytesPerKey = Source->MaxBytesPerKey;
+    }
+    if (!Destination->IsSet.MaxOperationsPerDrain) {
+        Destination->MaxOperationsPerDrain = Source->MaxOperationsPerDrain;
+    }
+    if (!Destination->IsSet.DestCidUpdateIdleTimeoutMs) {
+        Destination->DestCidUpdateIdleTimeoutMs = Source->DestCidUpdateIdleTimeoutMs;
+    }
+    if (!Destination->IsSet.KeepAliveIntervalMs) {
+        Destination->KeepAliveIntervalMs = Source->KeepAliveIntervalMs;
+    }
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -345,22 +517,12 @@ QuicSettingsCopyVersionSettings(
     _In_ BOOLEAN CopyExternalToInternal
     )
 {
-    QUIC_VERSION_SETTINGS* Destination = NULL;
-    size_t AllocSize =
-        sizeof(*Destination) +
-        (Source->AcceptableVersionsLength * sizeof(uint32_t)) +
-        (Source->OfferedVersionsLength * sizeof(uint32_t)) +
-        (Source->FullyDeployedVersionsLength * sizeof(uint32_t));
-    Destination =
-        CXPLAT_ALLOC_NONPAGED(
-            AllocSize,
-            QUIC_POOL_VERSION_SETTINGS);
+    QUIC_VERSION_SETTINGS* Destination =
+        QuicVersionSettingsAlloc(
+            (Source->AcceptableVersionsLength * sizeof(uint32_t)) +
+            (Source->OfferedVersionsLength * sizeof(uint32_t)) +
+            (Source->FullyDeployedVersionsLength * sizeof(uint32_t)));
     if (Destination == NULL) {
-        QuicTraceEvent(
-            AllocFailure,
-            "Allocation of '%s' failed. (%llu bytes)",
-            "VersionSettings",
-            AllocSize);
         return Destination;
     }
     Destination->AcceptableVersions = (uint32_t*)(Destination + 1);
@@ -449,6 +611,13 @@ QuicSettingApply(
         Destination->FixedServerID = Source->FixedServerID;
         Destination->IsSet.FixedServerID = TRUE;
     }
+    if (Source->IsSet.ConnectionPoolPrewarmCount && (!Destination->IsSet.ConnectionPoolPrewarmCount || OverWrite)) {
+        if (Source->ConnectionPoolPrewarmCount > QUIC_MAX_CONNECTION_POOL_PREWARM_COUNT) {
+            return FALSE;
+        }
+        Destination->ConnectionPoolPrewarmCount = Source->ConnectionPoolPrewarmCount;
+        Destination->IsSet.ConnectionPoolPrewarmCount = TRUE;
+    }
     if (Source->IsSet.MaxWorkerQueueDelayUs && (!Destination->IsSet.MaxWorkerQueueDelayUs || OverWrite)) {
         Destination->MaxWorkerQueueDelayUs = Source->MaxWorkerQueueDelayUs;
         Destination->IsSet.MaxWorkerQueueDelayUs = TRUE;
@@ -594,17 +763,13 @@ QuicSettingApply(
     if (Source->IsSet.VersionSettings) {
         if ((Destination->IsSet.VersionSettings && OverWrite) ||
             (!Destination->IsSet.VersionSettings && Destination->VersionSettings != NULL)) {
-            CXPLAT_FREE(Destination->VersionSettings, QUIC_POOL_VERSION_SETTINGS);
+            QuicVersionSettingsRelease(Destination->VersionSettings);
             Destination->VersionSettings = NULL;
             Destination->IsSet.VersionSettings = FALSE;
         }
         if (!Destination->IsSet.VersionSettings && Source->VersionSettings != NULL) {
             Destination->VersionSettings =
-                QuicSettingsCopyVersionSettings(Source->VersionSettings, FALSE);
-            if (Destination->VersionSettings == NULL) {
-                return FALSE;
-            }
-
+                QuicVersionSettingsAddRef(Source->VersionSettings);
             Destination->IsSet.VersionSettings = TRUE;
         }
     }
@@ -711,6 +876,44 @@ QuicSettingApply(
         Destination->StreamMultiReceiveEnabled = Source->StreamMultiReceiveEnabled;
         Destination->IsSet.StreamMultiReceiveEnabled = TRUE;
     }
+
+    if (Source->IsSet.CarefulResumeEnabled && (!Destination->IsSet.CarefulResumeEnabled || OverWrite)) {
+        Destination->CarefulResumeEnabled = Source->CarefulResumeEnabled;
+        Destination->IsSet.CarefulResumeEnabled = TRUE;
+    }
+
+    if (Source->IsSet.ReleaseHandshakeStateEnabled && (!Destination->IsSet.ReleaseHandshakeStateEnabled || OverWrite)) {
+        Destination->ReleaseHandshakeStateEnabled = Source->ReleaseHandshakeStateEnabled;
+        Destination->IsSet.ReleaseHandshakeStateEnabled = TRUE;
+    }
+
+    if (Source->IsSet.ResumptionTicketCacheEnabled && (!Destination->IsSet.ResumptionTicketCacheEnabled || OverWrite)) {
+        Destination->ResumptionTicketCacheEnabled = Source->ResumptionTicketCacheEnabled;
+        Destination->IsSet.ResumptionTicketCacheEnabled = TRUE;
+    }
+
+    if (Source->IsSet.AdaptiveAckDelayEnabled && (!Destination->IsSet.AdaptiveAckDelayEnabled || OverWrite)) {
+        Destination->AdaptiveAckDelayEnabled = Source->AdaptiveAckDelayEnabled;
+        Destination->IsSet.AdaptiveAckDelayEnabled = TRUE;
+    }
+
+    if (Source->IsSet.NetStatsEventThreshold && (!Destination->IsSet.NetStatsEventThreshold || OverWrite)) {
+        if (Source->NetStatsEventThreshold > 100) {
+            return FALSE;
+        }
+        Destination->NetStatsEventThreshold = Source->NetStatsEventThreshold;
+        Destination->IsSet.NetStatsEventThreshold = TRUE;
+    }
+
+    if (Source->IsSet.HibernateTimeoutMs && (!Destination->IsSet.HibernateTimeoutMs || OverWrite)) {
+        Destination->HibernateTimeoutMs = Source->HibernateTimeoutMs;
+        Destination->IsSet.HibernateTimeoutMs = TRUE;
+    }
+
+    if (Source->IsSet.EarlyCreditWindow && (!Destination->IsSet.EarlyCreditWindow || OverWrite)) {
+        Destination->EarlyCreditWindow = Source->EarlyCreditWindow;
+        Destination->IsSet.EarlyCreditWindow = TRUE;
+    }
     return TRUE;
 }
 
@@ -721,7 +924,7 @@ QuicSettingsCleanup(
     )
 {
     if (Settings->VersionSettings) {
-        CXPLAT_FREE(Settings->VersionSettings, QUIC_POOL_VERSION_SETTINGS);
+        QuicVersionSettingsRelease(Settings->VersionSettings);
         Settings->VersionSettings = NULL;
         Settings->IsSet.VersionSettings = FALSE;
     }
@@ -837,6 +1040,19 @@ QuicSettingsLoad(
             &ValueLen);
     }
 
+    if (!Settings->IsSet.ConnectionPoolPrewarmCount) {
+        Value = QUIC_DEFAULT_CONNECTION_POOL_PREWARM_COUNT;
+        ValueLen = sizeof(Value);
+        CxPlatStorageReadValue(
+            Storage,
+            QUIC_SETTING_CONNECTION_POOL_PREWARM_COUNT,
+            (uint8_t*)&Value,
+            &ValueLen);
+        if (Value <= QUIC_MAX_CONNECTION_POOL_PREWARM_COUNT) {
+            Settings->ConnectionPoolPrewarmCount = Value;
+        }
+    }
+
     if (!Settings->IsSet.MaxWorkerQueueDelayUs) {
         Value = QUIC_MAX_WORKER_QUEUE_DELAY;
         ValueLen = sizeof(Value);
@@ -1090,22 +1306,12 @@ QuicSettingsLoad(
                 (uint8_t*)NULL,
                 &FullyDeployedVersionsSize)) &&
             AcceptableVersionsSize && OfferedVersionsSize && FullyDeployedVersionsSize) {
-            QUIC_VERSION_SETTINGS* VersionSettings = NULL;
-            size_t AllocSize =
-                sizeof(*VersionSettings) +
-                AcceptableVersionsSize +
-                OfferedVersionsSize +
-                FullyDeployedVersionsSize;
-            VersionSettings =
-                CXPLAT_ALLOC_NONPAGED(
-                    AllocSize,
-                    QUIC_POOL_VERSION_SETTINGS);
+            QUIC_VERSION_SETTINGS* VersionSettings =
+                QuicVersionSettingsAlloc(
+                    (size_t)AcceptableVersionsSize +
+                    OfferedVersionsSize +
+                    FullyDeployedVersionsSize);
             if (VersionSettings == NULL) {
-                QuicTraceEvent(
-                    AllocFailure,
-                    "Allocation of '%s' failed. (%llu bytes)",
-                    "VersionSettings",
-                    AllocSize);
                 goto VersionSettingsFail;
             }
             VersionSettings->AcceptableVersions = (uint32_t*)(VersionSettings + 1);
@@ -1185,14 +1391,14 @@ QuicSettingsLoad(
                 }
             }
             if (Settings->VersionSettings) {
-                CXPLAT_FREE(Settings->VersionSettings, QUIC_POOL_VERSION_SETTINGS);
+                QuicVersionSettingsRelease(Settings->VersionSettings);
                 Settings->VersionSettings = NULL;
             }
             Settings->VersionSettings = VersionSettings;
             VersionSettings = NULL;
 VersionSettingsFail:
             if (VersionSettings != NULL) {
-                CXPLAT_FREE(VersionSettings, QUIC_POOL_VERSION_SETTINGS);
+                QuicVersionSettingsRelease(VersionSettings);
             }
         } else if (Settings->VersionSettings != NULL) {
             //
@@ -1200,7 +1406,7 @@ VersionSettingsFail:
             // and free them from memory.
             //
             // REVIEW: This would delete versions from memory that are inherited, wouldn't it?
-            CXPLAT_FREE(Settings->VersionSettings, QUIC_POOL_VERSION_SETTINGS);
+            QuicVersionSettingsRelease(Settings->VersionSettings);
             Settings->VersionSettings = NULL;
         }
     }
@@ -1379,6 +1585,74 @@ VersionSettingsFail:
             &ValueLen);
         Settings->StreamMultiReceiveEnabled = !!Value;
     }
+    if (!Settings->IsSet.CarefulResumeEnabled) {
+        Value = QUIC_DEFAULT_CAREFUL_RESUME_ENABLED;
+        ValueLen = sizeof(Value);
+        CxPlatStorageReadValue(
+            Storage,
+            QUIC_SETTING_CAREFUL_RESUME_ENABLED,
+            (uint8_t*)&Value,
+            &ValueLen);
+        Settings->CarefulResumeEnabled = !!Value;
+    }
+    if (!Settings->IsSet.ReleaseHandshakeStateEnabled) {
+        Value = QUIC_DEFAULT_RELEASE_HANDSHAKE_STATE_ENABLED;
+        ValueLen = sizeof(Value);
+        CxPlatStorageReadValue(
+            Storage,
+            QUIC_SETTING_RELEASE_HANDSHAKE_STATE_ENABLED,
+            (uint8_t*)&Value,
+            &ValueLen);
+        Settings->ReleaseHandshakeStateEnabled = !!Value;
+    }
+    if (!Settings->IsSet.ResumptionTicketCacheEnabled) {
+        Value = QUIC_DEFAULT_RESUMPTION_TICKET_CACHE_ENABLED;
+        ValueLen = sizeof(Value);
+        CxPlatStorageReadValue(
+            Storage,
+            QUIC_SETTING_RESUMPTION_TICKET_CACHE_ENABLED,
+            (uint8_t*)&Value,
+            &ValueLen);
+        Settings->ResumptionTicketCacheEnabled = !!Value;
+    }
+    if (!Settings->IsSet.AdaptiveAckDelayEnabled) {
+        Value = QUIC_DEFAULT_ADAPTIVE_ACK_DELAY_ENABLED;
+        ValueLen = sizeof(Value);
+        CxPlatStorageReadValue(
+            Storage,
+            QUIC_SETTING_ADAPTIVE_ACK_DELAY_ENABLED,
+            (uint8_t*)&Value,
+            &ValueLen);
+        Settings->AdaptiveAckDelayEnabled = !!Value;
+    }
+    if (!Settings->IsSet.NetStatsEventThreshold) {
+        Value = QUIC_DEFAULT_NET_STATS_EVENT_THRESHOLD;
+        ValueLen = sizeof(Value);
+        CxPlatStorageReadValue(
+            Storage,
+            QUIC_SETTING_NET_STATS_EVENT_THRESHOLD,
+            (uint8_t*)&Value,
+            &ValueLen);
+        if (Value <= 100) {
+            Settings->NetStatsEventThreshold = (uint8_t)Value;
+        }
+    }
+    if (!Settings->IsSet.HibernateTimeoutMs) {
+        ValueLen = sizeof(Settings->HibernateTimeoutMs);
+        CxPlatStorageReadValue(
+            Storage,
+            QUIC_SETTING_HIBERNATE_TIMEOUT_MS,
+            (uint8_t*)&Settings->HibernateTimeoutMs,
+            &ValueLen);
+    }
+    if (!Settings->IsSet.EarlyCreditWindow) {
+        ValueLen = sizeof(Settings->EarlyCreditWindow);
+        CxPlatStorageReadValue(
+            Storage,
+            QUIC_SETTING_EARLY_CREDIT_WINDOW,
+            (uint8_t*)&Settings->EarlyCreditWindow,
+            &ValueLen);
+    }
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -1396,6 +1670,7 @@ QuicSettingsDump(
     QuicTraceLogVerbose(SettingDumpRetryMemoryLimit,        "[sett] RetryMemoryLimit       = %hu", Settings->RetryMemoryLimit);
     QuicTraceLogVerbose(SettingDumpLoadBalancingMode,       "[sett] LoadBalancingMode      = %hu", Settings->LoadBalancingMode);
     QuicTraceLogVerbose(SettingDumpFixedServerID,           "[sett] FixedServerID          = %u", Settings->FixedServerID);
+    QuicTraceLogVerbose(SettingDumpConnPoolPrewarmCount,    "[sett] ConnPoolPrewarmCount   = %u", Settings->ConnectionPoolPrewarmCount);
     QuicTraceLogVerbose(SettingDumpMaxStatelessOperations,  "[sett] MaxStatelessOperations = %u", Settings->MaxStatelessOperations);
     QuicTraceLogVerbose(SettingDumpMaxWorkerQueueDelayUs,   "[sett] MaxWorkerQueueDelayUs  = %u", Settings->MaxWorkerQueueDelayUs);
     QuicTraceLogVerbose(SettingDumpInitialWindowPackets,    "[sett] InitialWindowPackets   = %u", Settings->InitialWindowPackets);
@@ -1448,6 +1723,13 @@ QuicSettingsDump(
     QuicTraceLogVerbose(SettingOneWayDelayEnabled,          "[sett] OneWayDelayEnabled     = %hhu", Settings->OneWayDelayEnabled);
     QuicTraceLogVerbose(SettingNetStatsEventEnabled,        "[sett] NetStatsEventEnabled   = %hhu", Settings->NetStatsEventEnabled);
     QuicTraceLogVerbose(SettingsStreamMultiReceiveEnabled,  "[sett] StreamMultiReceiveEnabled= %hhu", Settings->StreamMultiReceiveEnabled);
+    QuicTraceLogVerbose(SettingCarefulResumeEnabled,        "[sett] CarefulResumeEnabled   = %hhu", Settings->CarefulResumeEnabled);
+    QuicTraceLogVerbose(SettingReleaseHandshakeStateEnabled, "[sett] ReleaseHandshakeState  = %hhu", Settings->ReleaseHandshakeStateEnabled);
+    QuicTraceLogVerbose(SettingResumptionTicketCacheEnabled, "[sett] ResumptionTicketCache  = %hhu", Settings->ResumptionTicketCacheEnabled);
+    QuicTraceLogVerbose(SettingAdaptiveAckDelayEnabled,     "[sett] AdaptiveAckDelay       = %hhu", Settings->AdaptiveAckDelayEnabled);
+    QuicTraceLogVerbose(SettingNetStatsEventThreshold,      "[sett] NetStatsEventThreshold = %hhu", Settings->NetStatsEventThreshold);
+    QuicTraceLogVerbose(SettingHibernateTimeoutMs,          "[sett] HibernateTimeoutMs     = %u", Settings->HibernateTimeoutMs);
+    QuicTraceLogVerbose(SettingEarlyCreditWindow,           "[sett] EarlyCreditWindow      = %u", Settings->EarlyCreditWindow);
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -1481,6 +1763,9 @@ QuicSettingsDumpNew(
     if (Settings->IsSet.FixedServerID) {
         QuicTraceLogVerbose(SettingDumpLFixedServerID,              "[sett] FixedServerID          = %u", Settings->FixedServerID);
     }
+    if (Settings->IsSet.ConnectionPoolPrewarmCount) {
+        QuicTraceLogVerbose(SettingDumpLConnPoolPrewarmCount,       "[sett] ConnPoolPrewarmCount   = %u", Settings->ConnectionPoolPrewarmCount);
+    }
     if (Settings->IsSet.MaxStatelessOperations) {
         QuicTraceLogVerbose(SettingDumpMaxStatelessOperations,      "[sett] MaxStatelessOperations = %u", Settings->MaxStatelessOperations);
     }
@@ -1612,6 +1897,27 @@ QuicSettingsDumpNew(
     if (Settings->IsSet.StreamMultiReceiveEnabled) {
         QuicTraceLogVerbose(SettingStreamMultiReceiveEnabled,       "[sett] StreamMultiReceiveEnabled  = %hhu", Settings->StreamMultiReceiveEnabled);
     }
+    if (Settings->IsSet.CarefulResumeEnabled) {
+        QuicTraceLogVerbose(SettingDumpCarefulResumeEnabled,        "[sett] CarefulResumeEnabled       = %hhu", Settings->CarefulResumeEnabled);
+    }
+    if (Settings->IsSet.ReleaseHandshakeStateEnabled) {
+        QuicTraceLogVerbose(SettingDumpReleaseHandshakeStateEnabled, "[sett] ReleaseHandshakeState      = %hhu", Settings->ReleaseHandshakeStateEnabled);
+    }
+    if (Settings->IsSet.ResumptionTicketCacheEnabled) {
+        QuicTraceLogVerbose(SettingDumpResumptionTicketCacheEnabled, "[sett] ResumptionTicketCache      = %hhu", Settings->ResumptionTicketCacheEnabled);
+    }
+    if (Settings->IsSet.AdaptiveAckDelayEnabled) {
+        QuicTraceLogVerbose(SettingDumpAdaptiveAckDelayEnabled,     "[sett] AdaptiveAckDelay           = %hhu", Settings->AdaptiveAckDelayEnabled);
+    }
+    if (Settings->IsSet.NetStatsEventThreshold) {
+        QuicTraceLogVerbose(SettingDumpNetStatsEventThreshold,      "[sett] NetStatsEventThreshold     = %hhu", Settings->NetStatsEventThreshold);
+    }
+    if (Settings->IsSet.HibernateTimeoutMs) {
+        QuicTraceLogVerbose(SettingDumpHibernateTimeoutMs,          "[sett] HibernateTimeoutMs         = %u", Settings->HibernateTimeoutMs);
+    }
+    if (Settings->IsSet.EarlyCreditWindow) {
+        QuicTraceLogVerbose(SettingDumpEarlyCreditWindow,           "[sett] EarlyCreditWindow          = %u", Settings->EarlyCreditWindow);
+    }
 }
 
 #define SETTINGS_SIZE_THRU_FIELD(SettingsType, Field) \
@@ -1662,6 +1968,12 @@ QuicSettingsGlobalSettingsToInternal(
         Settings,
         SettingsSize,
         InternalSettings);
+    SETTING_COPY_TO_INTERNAL_SIZED(
+        ConnectionPoolPrewarmCount,
+        QUIC_GLOBAL_SETTINGS,
+        Settings,
+        SettingsSize,
+        InternalSettings);
 
     return QUIC_STATUS_SUCCESS;
 }
@@ -1876,6 +2188,59 @@ QuicSettingsSettingsToInternal(
         SettingsSize,
         InternalSettings);
 
+    SETTING_COPY_FLAG_TO_INTERNAL_SIZED(
+        Flags,
+        CarefulResumeEnabled,
+        QUIC_SETTINGS,
+        Settings,
+        SettingsSize,
+        InternalSettings);
+
+    SETTING_COPY_FLAG_TO_INTERNAL_SIZED(
+        Flags,
+        ReleaseHandshakeStateEnabled,
+        QUIC_SETTINGS,
+        Settings,
+        SettingsSize,
+        InternalSettings);
+
+    SETTING_COPY_FLAG_TO_INTERNAL_SIZED(
+        Flags,
+        ResumptionTicketCacheEnabled,
+        QUIC_SETTINGS,
+        Settings,
+        SettingsSize,
+        InternalSettings);
+
+    SETTING_COPY_FLAG_TO_INTERNAL_SIZED(
+        Flags,
+        AdaptiveAckDelayEnabled,
+        QUIC_SETTINGS,
+        Settings,
+        SettingsSize,
+        InternalSettings);
+
+    SETTING_COPY_TO_INTERNAL_SIZED(
+        NetStatsEventThreshold,
+        QUIC_SETTINGS,
+        Settings,
+        SettingsSize,
+        InternalSettings);
+
+    SETTING_COPY_TO_INTERNAL_SIZED(
+        HibernateTimeoutMs,
+        QUIC_SETTINGS,
+        Settings,
+        SettingsSize,
+        InternalSettings);
+
+    SETTING_COPY_TO_INTERNAL_SIZED(
+        EarlyCreditWindow,
+        QUIC_SETTINGS,
+        Settings,
+        SettingsSize,
+        InternalSettings);
+
     return QUIC_STATUS_SUCCESS;
 }
 
@@ -2045,6 +2410,59 @@ QuicSettingsGetSettings(
         *SettingsLength,
         InternalSettings);
 
+    SETTING_COPY_FLAG_FROM_INTERNAL_SIZED(
+        Flags,
+        CarefulResumeEnabled,
+        QUIC_SETTINGS,
+        Settings,
+        *SettingsLength,
+        InternalSettings);
+
+    SETTING_COPY_FLAG_FROM_INTERNAL_SIZED(
+        Flags,
+        ReleaseHandshakeStateEnabled,
+        QUIC_SETTINGS,
+        Settings,
+        *SettingsLength,
+        InternalSettings);
+
+    SETTING_COPY_FLAG_FROM_INTERNAL_SIZED(
+        Flags,
+        ResumptionTicketCacheEnabled,
+        QUIC_SETTINGS,
+        Settings,
+        *SettingsLength,
+        InternalSettings);
+
+    SETTING_COPY_FLAG_FROM_INTERNAL_SIZED(
+        Flags,
+        AdaptiveAckDelayEnabled,
+        QUIC_SETTINGS,
+        Settings,
+        *SettingsLength,
+        InternalSettings);
+
+    SETTING_COPY_FROM_INTERNAL_SIZED(
+        NetStatsEventThreshold,
+        QUIC_SETTINGS,
+        Settings,
+        *SettingsLength,
+        InternalSettings);
+
+    SETTING_COPY_FROM_INTERNAL_SIZED(
+        HibernateTimeoutMs,
+        QUIC_SETTINGS,
+        Settings,
+        *SettingsLength,
+        InternalSettings);
+
+    SETTING_COPY_FROM_INTERNAL_SIZED(
+        EarlyCreditWindow,
+        QUIC_SETTINGS,
+        Settings,
+        *SettingsLength,
+        InternalSettings);
+
     *SettingsLength = CXPLAT_MIN(*SettingsLength, sizeof(QUIC_SETTINGS));
 
     return QUIC_STATUS_SUCCESS;
@@ -2088,6 +2506,12 @@ QuicSettingsGetGlobalSettings(
         Settings,
         *SettingsLength,
         InternalSettings);
+    SETTING_COPY_FROM_INTERNAL_SIZED(
+        ConnectionPoolPrewarmCount,
+        QUIC_GLOBAL_SETTINGS,
+        Settings,
+        *SettingsLength,
+        InternalSettings);
 
     *SettingsLength = CXPLAT_MIN(*SettingsLength, sizeof(QUIC_GLOBAL_SETTINGS));
 
@@ -62,7 +62,15 @@ typedef struct QUIC_SETTINGS_INTERNAL {
             uint64_t OneWayDelayEnabled                     : 1;
             uint64_t NetStatsEventEnabled                   : 1;
             uint64_t StreamMultiReceiveEnabled              : 1;
-            uint64_t RESERVED                               : 16;
+            uint64_t CarefulResumeEnabled                   : 1;
+            uint64_t NetStatsEventThreshold                 : 1;
+            uint64_t ConnectionPoolPrewarmCount             : 1;
+            uint64_t HibernateTimeoutMs                     : 1;
+            uint64_t ReleaseHandshakeStateEnabled           : 1;
+            uint64_t ResumptionTicketCacheEnabled           : 1;
+            uint64_t EarlyCreditWindow                      : 1;
+            uint64_t AdaptiveAckDelayEnabled                : 1;
+            uint64_t RESERVED                               : 8;
         } IsSet;
     };
 
@@ -88,7 +96,10 @@ typedef struct QUIC_SETTINGS_INTERNAL {
     uint32_t DisconnectTimeoutMs;
     uint32_t KeepAliveIntervalMs;
     uint32_t DestCidUpdateIdleTimeoutMs;
+    uint32_t HibernateTimeoutMs;
+    uint32_t EarlyCreditWindow;
     uint32_t FixedServerID;                 // Global only
+    uint32_t ConnectionPoolPrewarmCount;    // Global only
     uint16_t PeerBidiStreamCount;
     uint16_t PeerUnidiStreamCount;
     uint16_t RetryMemoryLimit;              // Global only
@@ -113,7 +124,12 @@ typedef struct QUIC_SETTINGS_INTERNAL {
     uint8_t OneWayDelayEnabled              : 1;
     uint8_t NetStatsEventEnabled            : 1;
     uint8_t StreamMultiReceiveEnabled       : 1;
+    uint8_t CarefulResumeEnabled            : 1;
+    uint8_t ReleaseHandshakeStateEnabled    : 1;
+    uint8_t ResumptionTicketCacheEnabled    : 1;
+    uint8_t AdaptiveAckDelayEnabled         : 1;
     uint8_t MtuDiscoveryMissingProbeCount;
+    uint8_t NetStatsEventThreshold;
 
 } QUIC_SETTINGS_INTERNAL;
 
@@ -137,6 +153,30 @@ QuicSettingsCopy(
     _In_ const QUIC_SETTINGS_INTERNAL* Source
     );
 
+//
+// Initializes empty settings with all of the parent's values, but none of its
+// IsSet flags. Equivalent to QuicSettingsCopy into empty settings, but a
+// single copy instead of a field at a time. Version settings are shared.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSettingsInherit(
+    _Out_ QUIC_SETTINGS_INTERNAL* Destination,
+    _In_ const QUIC_SETTINGS_INTERNAL* Source
+    );
+
+//
+// Like QuicSettingsCopy, but only for the tunables that can safely change
+// under an established connection (pacing, congestion control, buffer sizes
+// and the like). Used to push reloaded settings to existing connections.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSettingsCopyLive(
+    _Inout_ QUIC_SETTINGS_INTERNAL* Destination,
+    _In_ const QUIC_SETTINGS_INTERNAL* Source
+    );
+
 //
 // Applies the changes from the new settings.
 //
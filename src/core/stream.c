@@ -27,7 +27,6 @@ QuicStreamInitialize(
 {
     QUIC_STATUS Status;
     QUIC_STREAM* Stream;
-    QUIC_RECV_CHUNK* PreallocatedRecvChunk = NULL;
     uint32_t InitialRecvBufferLength;
     QUIC_WORKER* Worker = Connection->Worker;
 
@@ -66,11 +65,25 @@ QuicStreamInitialize(
     Stream->Flags.Allocated = TRUE;
     Stream->Flags.SendEnabled = TRUE;
     Stream->Flags.ReceiveEnabled = TRUE;
-    Stream->Flags.ReceiveMultiple = Connection->Settings.StreamMultiReceiveEnabled;
+    Stream->Flags.UseAppOwnedRecvBuffers = !!(Flags & QUIC_STREAM_OPEN_FLAG_APP_OWNED_BUFFERS);
+    Stream->Flags.ReceiveMultiple =
+        Connection->Settings.StreamMultiReceiveEnabled ||
+        Stream->Flags.UseAppOwnedRecvBuffers;
+    Stream->Flags.ZeroCopyRecv =
+        !!(Flags & QUIC_STREAM_OPEN_FLAG_ZERO_COPY_RECEIVE) &&
+        !Stream->Flags.ReceiveMultiple;
+    Stream->Flags.Compressed =
+        !!(Flags & QUIC_STREAM_OPEN_FLAG_COMPRESSED) &&
+        !Stream->Flags.ReceiveMultiple;
+    if (Stream->Flags.Compressed) {
+        Stream->Flags.ZeroCopyRecv = FALSE;
+    }
     Stream->RecvMaxLength = UINT64_MAX;
     Stream->RefCount = 1;
     Stream->SendRequestsTail = &Stream->SendRequests;
     Stream->SendPriority = QUIC_STREAM_PRIORITY_DEFAULT;
+    Stream->PriorityUrgency = QUIC_STREAM_PRIORITY_URGENCY_DEFAULT;
+    Stream->SendWeight = (uint8_t)(QUIC_STREAM_PRIORITY_DEFAULT >> 8);
     CxPlatDispatchLockInitialize(&Stream->ApiSendRequestLock);
     CxPlatRefInitialize(&Stream->RefCount);
     QuicRangeInitialize(
@@ -113,13 +126,6 @@ QuicStreamInitialize(
     }
 
     InitialRecvBufferLength = Connection->Settings.StreamRecvBufferDefault;
-    if (InitialRecvBufferLength == QUIC_DEFAULT_STREAM_RECV_BUFFER_SIZE) {
-        PreallocatedRecvChunk = CxPlatPoolAlloc(&Worker->DefaultReceiveBufferPool);
-        if (PreallocatedRecvChunk == NULL) {
-            Status = QUIC_STATUS_OUT_OF_MEMORY;
-            goto Exit;
-        }
-    }
 
     const uint32_t FlowControlWindowSize = Stream->Flags.Unidirectional
         ? Connection->Settings.StreamRecvWindowUnidiDefault
@@ -127,27 +133,36 @@ QuicStreamInitialize(
             ? Connection->Settings.StreamRecvWindowBidiRemoteDefault
             : Connection->Settings.StreamRecvWindowBidiLocalDefault;
 
-    Status =
-        QuicRecvBufferInitialize(
-            &Stream->RecvBuffer,
-            InitialRecvBufferLength,
-            FlowControlWindowSize,
-            Stream->Flags.ReceiveMultiple ?
-                QUIC_RECV_BUF_MODE_MULTIPLE : QUIC_RECV_BUF_MODE_CIRCULAR,
-            PreallocatedRecvChunk);
-    if (QUIC_FAILED(Status)) {
-        goto Exit;
-    }
+    //
+    // Many streams never receive any data (e.g. locally opened unidirectional
+    // streams) or only receive a small response, so the receive buffer's
+    // memory isn't allocated until data first needs to be copied into it.
+    //
+    QuicRecvBufferInitializeDeferred(
+        &Stream->RecvBuffer,
+        InitialRecvBufferLength,
+        FlowControlWindowSize,
+        Stream->Flags.UseAppOwnedRecvBuffers ?
+            QUIC_RECV_BUF_MODE_APP_OWNED :
+        Stream->Flags.ReceiveMultiple ?
+            QUIC_RECV_BUF_MODE_MULTIPLE : QUIC_RECV_BUF_MODE_CIRCULAR,
+        Stream->Flags.UseAppOwnedRecvBuffers ?
+            NULL : &QuicLibraryGetPerProc()->RecvChunkPool);
+    QuicRecvBufferSetUsageCounter(
+        &Stream->RecvBuffer, &Connection->MemoryUsage.RecvBuffer);
 
     Stream->MaxAllowedRecvOffset = Stream->RecvBuffer.VirtualBufferLength;
     Stream->RecvWindowLastUpdate = CxPlatTimeUs64();
+    Stream->RecvWindowMin = FlowControlWindowSize;
 
     QuicConnAddRef(Connection, QUIC_CONN_REF_STREAM);
+    InterlockedExchangeAdd64(
+        (int64_t*)&Connection->MemoryUsage.Streams, sizeof(QUIC_STREAM));
 
     Stream->Flags.Initialized = TRUE;
     *NewStream = Stream;
     Stream = NULL;
-    PreallocatedRecvChunk = NULL;
+    Status = QUIC_STATUS_SUCCESS;
 
 Exit:
 
@@ -162,9 +177,6 @@ Exit:
         Stream->Flags.Freed = TRUE;
         CxPlatPoolFree(&Worker->StreamPool, Stream);
     }
-    if (PreallocatedRecvChunk) {
-        CxPlatPoolFree(&Worker->DefaultReceiveBufferPool, PreallocatedRecvChunk);
-    }
 
     return Status;
 }
@@ -198,19 +210,19 @@ QuicStreamFree(
 #endif
     QuicPerfCounterDecrement(QUIC_PERF_COUNTER_STRM_ACTIVE);
 
+    QuicStreamRecvReleaseZeroCopy(Stream);
+    if (Stream->RecvDecoded.Buffer != NULL) {
+        CXPLAT_FREE(Stream->RecvDecoded.Buffer, QUIC_POOL_STREAM_COMPRESS);
+    }
     QuicRecvBufferUninitialize(&Stream->RecvBuffer);
     QuicRangeUninitialize(&Stream->SparseAckRanges);
     CxPlatDispatchLockUninitialize(&Stream->ApiSendRequestLock);
     CxPlatRefUninitialize(&Stream->RefCount);
 
-    if (Stream->RecvBuffer.PreallocatedChunk) {
-        CxPlatPoolFree(
-            &Worker->DefaultReceiveBufferPool,
-            Stream->RecvBuffer.PreallocatedChunk);
-    }
-
     Stream->Flags.Freed = TRUE;
     CxPlatPoolFree(&Worker->StreamPool, Stream);
+    InterlockedExchangeAdd64(
+        (int64_t*)&Connection->MemoryUsage.Streams, -1 * (int64_t)sizeof(QUIC_STREAM));
 
     if (WasStarted) {
 #pragma warning(push)
@@ -225,6 +237,69 @@ QuicStreamFree(
     QuicConnRelease(Connection, QUIC_CONN_REF_STREAM);
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicStreamSwitchToAppOwnedBuffers(
+    _In_ QUIC_STREAM* Stream
+    )
+{
+    if (QuicRecvBufferGetTotalLength(&Stream->RecvBuffer) != 0) {
+        //
+        // Data has already been written into the internal buffer.
+        //
+        return QUIC_STATUS_INVALID_STATE;
+    }
+
+    //
+    // Keep the flow control window that may already have been advertised to
+    // the peer, but drop the internally allocated memory.
+    //
+    const uint32_t VirtualBufferLength = Stream->RecvBuffer.VirtualBufferLength;
+    QuicRecvBufferUninitialize(&Stream->RecvBuffer);
+
+    QUIC_STATUS Status =
+        QuicRecvBufferInitialize(
+            &Stream->RecvBuffer,
+            0,
+            VirtualBufferLength,
+            QUIC_RECV_BUF_MODE_APP_OWNED,
+            NULL,
+            NULL);
+    CXPLAT_DBG_ASSERT(QUIC_SUCCEEDED(Status)); // Can't fail in app-owned mode.
+
+    Stream->Flags.UseAppOwnedRecvBuffers = TRUE;
+    Stream->Flags.ReceiveMultiple = TRUE;
+    Stream->Flags.ZeroCopyRecv = FALSE;
+
+    return Status;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicStreamNegotiateCompression(
+    _In_ QUIC_STREAM* Stream
+    )
+{
+    QUIC_CONNECTION* Connection = Stream->Connection;
+
+    if (!Stream->Flags.Compressed || Stream->Flags.Started) {
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    //
+    // Whether the peer uses the same codec is only known once its (not
+    // resumed) transport parameters are. If it doesn't, send uncompressed.
+    //
+    if (QuicConnIsServer(Connection) ?
+            !Connection->State.PeerTransportParameterValid :
+            !Connection->State.Connected) {
+        return QUIC_STATUS_INVALID_STATE;
+    }
+
+    Stream->Flags.Compressed = Connection->State.StreamCompressionNegotiated;
+    return QUIC_STATUS_SUCCESS;
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 QUIC_STATUS
 QuicStreamStart(
@@ -246,6 +321,11 @@ QuicStreamStart(
     }
 
     if (!IsRemoteStream) {
+        Status = QuicStreamNegotiateCompression(Stream);
+        if (QUIC_FAILED(Status)) {
+            goto Exit;
+        }
+
         uint8_t Type =
             QuicConnIsServer(Stream->Connection) ?
                 STREAM_ID_FLAG_IS_SERVER :
@@ -372,6 +452,10 @@ QuicStreamClose(
     CXPLAT_DBG_ASSERT(!Stream->Flags.HandleClosed);
     Stream->Flags.HandleClosed = TRUE;
 
+    if (Stream->GroupId != 0) {
+        (void)QuicStreamSetJoinGroup(&Stream->Connection->Streams, Stream, 0);
+    }
+
     if (!Stream->Flags.ShutdownComplete) {
 
         if (Stream->Flags.Started && !Stream->Flags.HandleShutdown) {
@@ -441,6 +525,37 @@ QuicStreamTraceRundown(
     // TODO - More state dump.
 }
 
+//
+// Events that only carry information to the app, and so can be posted to the
+// registration's event queue to be processed later. Receives are completed
+// by the app with StreamReceiveComplete, as if it had returned pending.
+//
+static
+BOOLEAN
+QuicStreamEventIsQueueable(
+    _In_ const QUIC_STREAM_EVENT* Event
+    )
+{
+    switch (Event->Type) {
+    case QUIC_STREAM_EVENT_RECEIVE:
+        return
+            Event->RECEIVE.BufferCount <=
+                ARRAYSIZE(((QUIC_QUEUED_EVENT*)NULL)->ReceiveBuffers);
+    case QUIC_STREAM_EVENT_START_COMPLETE:
+    case QUIC_STREAM_EVENT_SEND_COMPLETE:
+    case QUIC_STREAM_EVENT_PEER_SEND_SHUTDOWN:
+    case QUIC_STREAM_EVENT_PEER_SEND_ABORTED:
+    case QUIC_STREAM_EVENT_PEER_RECEIVE_ABORTED:
+    case QUIC_STREAM_EVENT_SEND_SHUTDOWN_COMPLETE:
+    case QUIC_STREAM_EVENT_SHUTDOWN_COMPLETE:
+    case QUIC_STREAM_EVENT_IDEAL_SEND_BUFFER_SIZE:
+    case QUIC_STREAM_EVENT_PEER_ACCEPTED:
+        return TRUE;
+    default:
+        return FALSE;
+    }
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 QUIC_STATUS
 QuicStreamIndicateEvent(
@@ -449,6 +564,35 @@ QuicStreamIndicateEvent(
     )
 {
     QUIC_STATUS Status;
+    QUIC_REGISTRATION* Registration = Stream->Connection->Registration;
+    if (Registration != NULL &&
+        Registration->EventQueue != NULL &&
+        !Stream->Flags.HandleClosed &&
+        !Stream->Connection->State.HandleClosed &&
+        QuicStreamEventIsQueueable(Event)) {
+        QUIC_QUEUED_EVENT QueuedEvent;
+        QueuedEvent.Type = QUIC_QUEUED_EVENT_TYPE_STREAM;
+        QueuedEvent.Handle = (HQUIC)Stream;
+        QueuedEvent.Context = Stream->ClientContext;
+        QueuedEvent.STREAM = *Event;
+        if (Event->Type == QUIC_STREAM_EVENT_RECEIVE) {
+            //
+            // The buffer array is only valid for the indication, so it is
+            // copied into the queued event. The data itself stays valid
+            // until the app completes the receive.
+            //
+            CxPlatCopyMemory(
+                QueuedEvent.ReceiveBuffers,
+                Event->RECEIVE.Buffers,
+                Event->RECEIVE.BufferCount * sizeof(QUIC_BUFFER));
+        }
+        if (QuicEventQueuePost(Registration->EventQueue, &QueuedEvent)) {
+            return
+                Event->Type == QUIC_STREAM_EVENT_RECEIVE ?
+                    QUIC_STATUS_PENDING : QUIC_STATUS_SUCCESS;
+        }
+    }
+
     if (Stream->ClientCallbackHandler != NULL) {
         //
         // MsQuic shouldn't indicate reentrancy to the app when at all
@@ -659,8 +803,14 @@ QuicStreamParamSet(
             break;
         }
 
+        if (Stream->GroupId != 0) {
+            Status = QUIC_STATUS_INVALID_STATE; // Inherited from the group.
+            break;
+        }
+
         if (Stream->SendPriority != *(uint16_t*)Buffer) {
             Stream->SendPriority = *(uint16_t*)Buffer;
+            Stream->SendWeight = (uint8_t)(Stream->SendPriority >> 8);
 
             QuicTraceLogStreamInfo(
                 UpdatePriority,
@@ -680,6 +830,43 @@ QuicStreamParamSet(
         break;
     }
 
+    case QUIC_PARAM_STREAM_PRIORITY_PARAMETERS: {
+
+        if (BufferLength != sizeof(QUIC_STREAM_PRIORITY_PARAMETERS) || Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        const QUIC_STREAM_PRIORITY_PARAMETERS* Params =
+            (const QUIC_STREAM_PRIORITY_PARAMETERS*)Buffer;
+        if (Params->Urgency > QUIC_STREAM_PRIORITY_URGENCY_MAX) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        if (Stream->GroupId != 0) {
+            Status = QUIC_STATUS_INVALID_STATE; // Inherited from the group.
+            break;
+        }
+
+        BOOLEAN Incremental = !!Params->Incremental;
+        if (Stream->PriorityUrgency != Params->Urgency ||
+            Stream->PriorityIncremental != Incremental) {
+            Stream->PriorityUrgency = Params->Urgency;
+            Stream->PriorityIncremental = Incremental;
+
+            if (Stream->Flags.Started && Stream->SendFlags != 0) {
+                //
+                // Update the stream's place in the send queue if necessary.
+                //
+                QuicSendUpdateStreamPriority(&Stream->Connection->Send, Stream);
+            }
+        }
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+    }
+
    case QUIC_PARAM_STREAM_RELIABLE_OFFSET:
 
         if (BufferLength != sizeof(uint64_t) || Buffer == NULL) {
@@ -732,6 +919,20 @@ QuicStreamParamSet(
         Status = QUIC_STATUS_SUCCESS;
         break;
 
+    case QUIC_PARAM_STREAM_GROUP:
+
+        if (BufferLength != sizeof(uint16_t) || Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        Status =
+            QuicStreamSetJoinGroup(
+                &Stream->Connection->Streams,
+                Stream,
+                *(uint16_t*)Buffer);
+        break;
+
     default:
         Status = QUIC_STATUS_INVALID_PARAMETER;
         break;
@@ -816,7 +1017,8 @@ QuicStreamParamGet(
 
         *BufferLength = sizeof(uint64_t);
         *(uint64_t*)Buffer =
-            Stream->Connection->SendBuffer.IdealBytes;
+            QuicSendBufferGetScaledIdealBytes(
+                Stream->Connection->SendBuffer.IdealBytes);
 
         Status = QUIC_STATUS_SUCCESS;
         break;
@@ -840,6 +1042,29 @@ QuicStreamParamGet(
         Status = QUIC_STATUS_SUCCESS;
         break;
 
+    case QUIC_PARAM_STREAM_PRIORITY_PARAMETERS: {
+
+        if (*BufferLength < sizeof(QUIC_STREAM_PRIORITY_PARAMETERS)) {
+            *BufferLength = sizeof(QUIC_STREAM_PRIORITY_PARAMETERS);
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        QUIC_STREAM_PRIORITY_PARAMETERS* Params =
+            (QUIC_STREAM_PRIORITY_PARAMETERS*)Buffer;
+        Params->Urgency = Stream->PriorityUrgency;
+        Params->Incremental = Stream->PriorityIncremental;
+
+        *BufferLength = sizeof(QUIC_STREAM_PRIORITY_PARAMETERS);
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+    }
+
     case QUIC_PARAM_STREAM_STATISTICS: {
 
         if (*BufferLength < sizeof(QUIC_STREAM_STATISTICS)) {
@@ -949,6 +1174,25 @@ QuicStreamParamGet(
         Status = QUIC_STATUS_SUCCESS;
         break;
 
+    case QUIC_PARAM_STREAM_GROUP:
+
+        if (*BufferLength < sizeof(uint16_t)) {
+            *BufferLength = sizeof(uint16_t);
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        *BufferLength = sizeof(uint16_t);
+        *(uint16_t*)Buffer = Stream->GroupId;
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
     default:
         Status = QUIC_STATUS_INVALID_PARAMETER;
         break;
@@ -45,10 +45,18 @@ typedef struct QUIC_CONNECTION QUIC_CONNECTION;
 // Internal send flags. The public ones are defined in msquic.h.
 //
 #define QUIC_SEND_FLAG_BUFFERED     ((QUIC_SEND_FLAGS)0x80000000)
+#define QUIC_SEND_FLAG_REGISTERED   ((QUIC_SEND_FLAGS)0x40000000)
+#define QUIC_SEND_FLAG_BATCHED      ((QUIC_SEND_FLAGS)0x20000000) // Completes with the batch's last request.
+#define QUIC_SEND_FLAG_DGRAM_RELAY  ((QUIC_SEND_FLAGS)0x10000000) // A QUIC_DATAGRAM_RELAY_SEND.
+#define QUIC_SEND_FLAG_COMPRESSED   ((QUIC_SEND_FLAGS)0x08000000) // InternalBuffer holds the compressed data.
 
 #define QUIC_SEND_FLAGS_INTERNAL \
 ( \
-    QUIC_SEND_FLAG_BUFFERED \
+    QUIC_SEND_FLAG_BUFFERED | \
+    QUIC_SEND_FLAG_REGISTERED | \
+    QUIC_SEND_FLAG_BATCHED | \
+    QUIC_SEND_FLAG_DGRAM_RELAY | \
+    QUIC_SEND_FLAG_COMPRESSED \
 )
 
 #define QUIC_STREAM_PRIORITY_DEFAULT 0x7FFF // Medium priority by default
@@ -99,6 +107,18 @@ typedef struct QUIC_SEND_REQUEST {
     //
     void* ClientContext;
 
+    //
+    // When the app queued the request, if the connection's latency histograms
+    // were enabled at the time (zero otherwise).
+    //
+    uint64_t SendTime;
+
+    //
+    // For datagrams, when the request expires if it hasn't been sent yet
+    // (zero if never). See QUIC_DATAGRAM_SEND_POLICY.
+    //
+    uint64_t Deadline;
+
 } QUIC_SEND_REQUEST;
 
 //
@@ -141,6 +161,7 @@ typedef union QUIC_STREAM_FLAGS {
         BOOLEAN ReceiveEnabled          : 1;    // Application is ready for receive callbacks.
         BOOLEAN ReceiveMultiple         : 1;    // The app supports multiple parallel receive indications.
         BOOLEAN ReceiveFlushQueued      : 1;    // The receive flush operation is queued.
+        BOOLEAN ReceiveBatchQueued      : 1;    // Queued for the connection's batched receive event.
         BOOLEAN ReceiveDataPending      : 1;    // Data (or FIN) is queued and ready for delivery.
         BOOLEAN ReceiveCallActive       : 1;    // There is an active receive to the app.
         BOOLEAN SendDelayed             : 1;    // A delayed send is currently queued.
@@ -157,6 +178,9 @@ typedef union QUIC_STREAM_FLAGS {
 
         BOOLEAN InStreamTable           : 1;    // The stream is currently in the connection's table.
         BOOLEAN DelayIdFcUpdate         : 1;    // Delay stream ID FC updates to StreamClose.
+        BOOLEAN UseAppOwnedRecvBuffers  : 1;    // The app provides the buffers stream data is received into.
+        BOOLEAN ZeroCopyRecv            : 1;    // In-order data may be indicated from the received packet.
+        BOOLEAN Compressed              : 1;    // Data is sent and received as compressed blocks.
     };
 } QUIC_STREAM_FLAGS;
 
@@ -300,6 +324,13 @@ typedef struct QUIC_STREAM {
     //
     QUIC_SEND_REQUEST* SendBookmark;
 
+    //
+    // Shortcut pointer: NULL, or the request containing the last byte that
+    // was retransmitted. Recovery repairs lost ranges in increasing offset
+    // order, so this keeps retransmissions from searching the whole queue.
+    //
+    QUIC_SEND_REQUEST* SendRecoveryBookmark;
+
     //
     // Shortcut pointer: NULL, or the next unbuffered send request.
     //
@@ -377,6 +408,36 @@ typedef struct QUIC_STREAM {
     //
     uint16_t SendPriority;
 
+    //
+    // The RFC 9218 urgency and incremental parameters, used by the extensible
+    // priority scheduling scheme.
+    //
+    uint8_t PriorityUrgency;
+    BOOLEAN PriorityIncremental;
+
+    //
+    // The extensible priority class the stream was queued in.
+    //
+    uint8_t SendPriorityClass;
+
+    //
+    // The weight used by the weighted fair scheduling scheme.
+    //
+    uint8_t SendWeight;
+
+    //
+    // The stream group (zero if none) whose scheduling parameters the stream
+    // inherits, and the link in the group's list of streams.
+    //
+    uint8_t GroupId;
+    CXPLAT_LIST_ENTRY GroupLink;
+
+    //
+    // The remaining bytes the stream may send in the current round of the
+    // weighted fair scheduling scheme.
+    //
+    int32_t SendDeficit;
+
     //
     // Recv State
     //
@@ -392,11 +453,41 @@ typedef struct QUIC_STREAM {
     uint64_t RecvWindowBytesDelivered;
     uint64_t RecvWindowLastUpdate;
 
+    //
+    // The initial flow control window, which auto-tuning never shrinks below.
+    //
+    uint32_t RecvWindowMin;
+
     //
     // The structure for tracking received buffers.
     //
     QUIC_RECV_BUFFER RecvBuffer;
 
+    //
+    // In-order stream data that is indicated to the app straight out of the
+    // received packet instead of being copied into RecvBuffer. The packet is
+    // held (not returned to the datapath) until the app completes the data.
+    //
+    struct {
+        QUIC_RX_PACKET* Packet;
+        const uint8_t* Data;
+        uint64_t Offset;
+        uint16_t Length;
+    } RecvZeroCopy;
+
+    //
+    // On a compressed stream, the block currently being indicated to the app,
+    // decompressed out of RecvBuffer (which no longer holds it). Offset is the
+    // block's offset in the decompressed stream.
+    //
+    struct {
+        uint8_t* Buffer;
+        uint64_t Offset;
+        uint32_t Length;
+        uint32_t Consumed;
+        BOOLEAN ZeroRtt;
+    } RecvDecoded;
+
     //
     // The maximum length of 0-RTT secured payload received.
     //
@@ -962,6 +1053,20 @@ QuicStreamRecvShutdown(
     _In_ QUIC_VAR_INT ErrorCode
     );
 
+//
+// Copies the available data directly into the app's buffers, without a
+// receive indication. Receive callbacks must be disabled.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicStreamReceiveInto(
+    _In_ QUIC_STREAM* Stream,
+    _In_reads_(BufferCount) const QUIC_BUFFER* Buffers,
+    _In_ uint32_t BufferCount,
+    _Out_ uint64_t* BytesReceived,
+    _Out_ QUIC_RECEIVE_FLAGS* Flags
+    );
+
 //
 // Completes a receive call that was pended by the app.
 //
@@ -996,6 +1101,76 @@ QuicStreamRecvFlush(
     _In_ QUIC_STREAM* Stream
     );
 
+//
+// The most buffers a single receive indication can contain.
+//
+#define QUIC_STREAM_RECV_INDICATION_BUFFERS 3
+
+//
+// Fills in the next receive indication for the stream and marks the receive
+// call as active. Returns FALSE if there is nothing to indicate.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+QuicStreamRecvPrepareIndication(
+    _In_ QUIC_STREAM* Stream,
+    _Out_ QUIC_STREAM_EVENT* Event,
+    _Out_writes_(QUIC_STREAM_RECV_INDICATION_BUFFERS) QUIC_BUFFER* RecvBuffers
+    );
+
+//
+// Processes the app's result for a receive indication. Returns TRUE if
+// another indication should be made right away.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+QuicStreamRecvCompleteIndication(
+    _In_ QUIC_STREAM* Stream,
+    _In_ QUIC_STATUS Status,
+    _In_ uint64_t TotalBufferLength
+    );
+
+//
+// Drops any zero-copy receive data still held by the stream, allowing the
+// underlying received packet to be returned.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicStreamRecvReleaseZeroCopy(
+    _In_ QUIC_STREAM* Stream
+    );
+
+//
+// Switches a stream that hasn't received any data yet to receive into app
+// provided buffers.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicStreamSwitchToAppOwnedBuffers(
+    _In_ QUIC_STREAM* Stream
+    );
+
+//
+// Decides whether a locally opened stream with the Compressed flag really is
+// compressed, which depends on the peer's transport parameters.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicStreamNegotiateCompression(
+    _In_ QUIC_STREAM* Stream
+    );
+
+//
+// Adds app provided buffers to an app-owned receive buffer. The chunks are
+// consumed on success.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicStreamProvideRecvBuffers(
+    _In_ QUIC_STREAM* Stream,
+    _Inout_ CXPLAT_LIST_ENTRY* Chunks
+    );
+
 //
 // Enables or disables receive callbacks for the stream.
 //
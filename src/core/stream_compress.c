@@ -0,0 +1,245 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Block framing for compressed streams (QUIC_PARAM_CONN_STREAM_COMPRESSION).
+
+    Each send request is split into blocks of up to
+    QUIC_STREAM_COMPRESSION_MAX_BLOCK bytes, which are compressed with the
+    app's codec independently of each other, so that the receiver can
+    decompress a block as soon as all of it arrived, and never needs more than
+    one block of the stream's receive window to make progress. Blocks that
+    don't shrink are sent as is.
+
+--*/
+
+#include "precomp.h"
+#ifdef QUIC_CLOG
+#include "stream_compress.c.clog.h"
+#endif
+
+//
+// Copies Length bytes, starting Offset bytes into Buffers, to Output. Returns
+// the number of bytes copied, which is less if Buffers end first.
+//
+static
+uint32_t
+QuicStreamCompressGather(
+    _In_reads_(BufferCount) const QUIC_BUFFER* Buffers,
+    _In_ uint32_t BufferCount,
+    _In_ uint64_t Offset,
+    _In_ uint32_t Length,
+    _Out_writes_bytes_to_(Length, return) uint8_t* Output
+    )
+{
+    uint32_t Copied = 0;
+    for (uint32_t i = 0; i < BufferCount && Copied < Length; ++i) {
+        if (Offset >= Buffers[i].Length) {
+            Offset -= Buffers[i].Length;
+            continue;
+        }
+        const uint32_t Chunk =
+            CXPLAT_MIN(Buffers[i].Length - (uint32_t)Offset, Length - Copied);
+        CxPlatCopyMemory(Output + Copied, Buffers[i].Buffer + Offset, Chunk);
+        Copied += Chunk;
+        Offset = 0;
+    }
+    return Copied;
+}
+
+//
+// Returns Length bytes, starting Offset bytes into Buffers, if they are all in
+// the same buffer, or NULL otherwise.
+//
+static
+const uint8_t*
+QuicStreamCompressFind(
+    _In_reads_(BufferCount) const QUIC_BUFFER* Buffers,
+    _In_ uint32_t BufferCount,
+    _In_ uint64_t Offset,
+    _In_ uint32_t Length
+    )
+{
+    for (uint32_t i = 0; i < BufferCount; ++i) {
+        if (Offset < Buffers[i].Length) {
+            return Buffers[i].Length - Offset >= Length ? Buffers[i].Buffer + Offset : NULL;
+        }
+        Offset -= Buffers[i].Length;
+    }
+    return NULL;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QuicStreamCompress(
+    _In_ const QUIC_STREAM_COMPRESSION_CONFIG* Config,
+    _In_reads_(BufferCount) const QUIC_BUFFER* Buffers,
+    _In_ uint32_t BufferCount,
+    _In_ uint64_t TotalLength,
+    _Out_writes_bytes_to_(QuicStreamCompressBound(TotalLength), *EncodedLength)
+        uint8_t* Output,
+    _Out_ uint64_t* EncodedLength
+    )
+{
+    QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
+    uint8_t* Scratch = NULL;
+    uint8_t* Out = Output;
+
+    for (uint64_t Offset = 0; Offset < TotalLength;) {
+        const uint32_t BlockLength =
+            (uint32_t)CXPLAT_MIN(TotalLength - Offset, QUIC_STREAM_COMPRESSION_MAX_BLOCK);
+
+        //
+        // Blocks are compressed straight from the app's buffers, unless they
+        // straddle two of them.
+        //
+        const uint8_t* Block =
+            QuicStreamCompressFind(Buffers, BufferCount, Offset, BlockLength);
+        if (Block == NULL) {
+            if (Scratch == NULL) {
+                Scratch = CXPLAT_ALLOC_NONPAGED(QUIC_STREAM_COMPRESSION_MAX_BLOCK, QUIC_POOL_STREAM_COMPRESS);
+                if (Scratch == NULL) {
+                    QuicTraceEvent(
+                        AllocFailure,
+                        "Allocation of '%s' failed. (%llu bytes)",
+                        "stream compression scratch",
+                        QUIC_STREAM_COMPRESSION_MAX_BLOCK);
+                    Status = QUIC_STATUS_OUT_OF_MEMORY;
+                    goto Exit;
+                }
+            }
+            const uint32_t Copied =
+                QuicStreamCompressGather(Buffers, BufferCount, Offset, BlockLength, Scratch);
+            CXPLAT_DBG_ASSERT(Copied == BlockLength);
+            UNREFERENCED_PARAMETER(Copied);
+            Block = Scratch;
+        }
+
+        //
+        // Only keep the compressed payload if it is actually smaller.
+        //
+        uint8_t* Payload = Out + QUIC_STREAM_COMPRESS_HEADER_LENGTH;
+        uint32_t PayloadLength = BlockLength - 1;
+        if (PayloadLength == 0 ||
+            QUIC_FAILED(
+                Config->Compress(
+                    Config->Context, Block, BlockLength, Payload, &PayloadLength)) ||
+            PayloadLength == 0 ||
+            PayloadLength >= BlockLength) {
+            CxPlatCopyMemory(Payload, Block, BlockLength);
+            PayloadLength = BlockLength;
+        }
+
+        Out = QuicVarIntEncode2Bytes(BlockLength, Out);
+        Out = QuicVarIntEncode2Bytes(PayloadLength, Out);
+        Out += PayloadLength;
+        Offset += BlockLength;
+    }
+
+    *EncodedLength = (uint64_t)(Out - Output);
+    CXPLAT_DBG_ASSERT(*EncodedLength <= QuicStreamCompressBound(TotalLength));
+
+Exit:
+
+    if (Scratch != NULL) {
+        CXPLAT_FREE(Scratch, QUIC_POOL_STREAM_COMPRESS);
+    }
+
+    return Status;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QuicStreamDecompress(
+    _In_ const QUIC_STREAM_COMPRESSION_CONFIG* Config,
+    _In_reads_(BufferCount) const QUIC_BUFFER* Buffers,
+    _In_ uint32_t BufferCount,
+    _Out_writes_bytes_to_(QUIC_STREAM_COMPRESSION_MAX_BLOCK, *DecodedLength)
+        uint8_t* Output,
+    _Out_ uint32_t* DecodedLength,
+    _Out_ uint32_t* EncodedLength
+    )
+{
+    uint64_t Available = 0;
+    for (uint32_t i = 0; i < BufferCount; ++i) {
+        Available += Buffers[i].Length;
+    }
+
+    //
+    // The header may itself be split over two buffers.
+    //
+    uint8_t Header[QUIC_STREAM_COMPRESS_MAX_HEADER];
+    const uint16_t HeaderAvailable =
+        (uint16_t)QuicStreamCompressGather(
+            Buffers, BufferCount, 0, sizeof(Header), Header);
+    uint16_t HeaderLength = 0;
+    QUIC_VAR_INT BlockLength, PayloadLength;
+    if (!QuicVarIntDecode(HeaderAvailable, Header, &HeaderLength, &BlockLength) ||
+        !QuicVarIntDecode(HeaderAvailable, Header, &HeaderLength, &PayloadLength)) {
+        return
+            HeaderAvailable < sizeof(Header) ?
+                QUIC_STATUS_PENDING : QUIC_STATUS_PROTOCOL_ERROR;
+    }
+
+    if (BlockLength == 0 ||
+        BlockLength > QUIC_STREAM_COMPRESSION_MAX_BLOCK ||
+        PayloadLength == 0 ||
+        PayloadLength > BlockLength) {
+        return QUIC_STATUS_PROTOCOL_ERROR;
+    }
+
+    if (Available < HeaderLength + PayloadLength) {
+        return QUIC_STATUS_PENDING;
+    }
+
+    *DecodedLength = (uint32_t)BlockLength;
+    *EncodedLength = HeaderLength + (uint32_t)PayloadLength;
+
+    if (PayloadLength == BlockLength) {
+        (void)QuicStreamCompressGather(
+            Buffers, BufferCount, HeaderLength, (uint32_t)PayloadLength, Output);
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    //
+    // The payload is decompressed in place, unless it wraps around the end of
+    // a circular receive buffer.
+    //
+    uint8_t* Copy = NULL;
+    const uint8_t* Payload =
+        QuicStreamCompressFind(Buffers, BufferCount, HeaderLength, (uint32_t)PayloadLength);
+    if (Payload == NULL) {
+        Copy = CXPLAT_ALLOC_NONPAGED((size_t)PayloadLength, QUIC_POOL_STREAM_COMPRESS);
+        if (Copy == NULL) {
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "stream compression scratch",
+                PayloadLength);
+            return QUIC_STATUS_OUT_OF_MEMORY;
+        }
+        (void)QuicStreamCompressGather(
+            Buffers, BufferCount, HeaderLength, (uint32_t)PayloadLength, Copy);
+        Payload = Copy;
+    }
+
+    QUIC_STATUS Status =
+        Config->Decompress(
+            Config->Context,
+            Payload,
+            (uint32_t)PayloadLength,
+            Output,
+            (uint32_t)BlockLength);
+    if (QUIC_FAILED(Status)) {
+        Status = QUIC_STATUS_PROTOCOL_ERROR;
+    }
+
+    if (Copy != NULL) {
+        CXPLAT_FREE(Copy, QUIC_POOL_STREAM_COMPRESS);
+    }
+
+    return Status;
+}
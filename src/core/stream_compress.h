@@ -0,0 +1,70 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+--*/
+
+#pragma once
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//
+// Each block of a compressed stream starts with its decompressed length and
+// the length of its payload, both varints. A payload as long as the
+// decompressed data holds it as is.
+//
+#define QUIC_STREAM_COMPRESS_MAX_HEADER     (2 * sizeof(uint64_t))
+
+//
+// The sender always encodes both lengths in two bytes.
+//
+#define QUIC_STREAM_COMPRESS_HEADER_LENGTH  (2 * sizeof(uint16_t))
+
+//
+// The largest encoding of TotalLength bytes of stream data.
+//
+#define QuicStreamCompressBound(TotalLength) \
+    ((TotalLength) + \
+     (((TotalLength) + QUIC_STREAM_COMPRESSION_MAX_BLOCK - 1) / QUIC_STREAM_COMPRESSION_MAX_BLOCK) * \
+        QUIC_STREAM_COMPRESS_HEADER_LENGTH)
+
+//
+// Encodes TotalLength bytes of Buffers into Output, which must have room for
+// QuicStreamCompressBound(TotalLength) bytes.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QuicStreamCompress(
+    _In_ const QUIC_STREAM_COMPRESSION_CONFIG* Config,
+    _In_reads_(BufferCount) const QUIC_BUFFER* Buffers,
+    _In_ uint32_t BufferCount,
+    _In_ uint64_t TotalLength,
+    _Out_writes_bytes_to_(QuicStreamCompressBound(TotalLength), *EncodedLength)
+        uint8_t* Output,
+    _Out_ uint64_t* EncodedLength
+    );
+
+//
+// Decodes the block at the start of Buffers (the unread part of a receive
+// buffer) into Output. Returns QUIC_STATUS_PENDING if the block hasn't been
+// completely received yet, and QUIC_STATUS_PROTOCOL_ERROR if it is malformed
+// or fails to decompress.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QuicStreamDecompress(
+    _In_ const QUIC_STREAM_COMPRESSION_CONFIG* Config,
+    _In_reads_(BufferCount) const QUIC_BUFFER* Buffers,
+    _In_ uint32_t BufferCount,
+    _Out_writes_bytes_to_(QUIC_STREAM_COMPRESSION_MAX_BLOCK, *DecodedLength)
+        uint8_t* Output,
+    _Out_ uint32_t* DecodedLength,
+    _Out_ uint32_t* EncodedLength
+    );
+
+#if defined(__cplusplus)
+}
+#endif
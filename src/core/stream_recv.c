@@ -296,6 +296,15 @@ QuicStreamProcessResetFrame(
         }
 
         uint64_t TotalReadLength = Stream->RecvBuffer.BaseOffset;
+        if (Stream->RecvPendingLength == 0) {
+            //
+            // Zero-copy data is accounted as drained from the receive buffer
+            // as soon as it arrives. If the app isn't currently reading it, it
+            // never will, so drop it and credit it here instead.
+            //
+            TotalReadLength -= Stream->RecvZeroCopy.Length;
+            QuicStreamRecvReleaseZeroCopy(Stream);
+        }
         if (TotalReadLength < FinalSize) {
             //
             // The final offset is indicating that more data was sent than the
@@ -379,6 +388,7 @@ _IRQL_requires_max_(PASSIVE_LEVEL)
 QUIC_STATUS
 QuicStreamProcessStreamFrame(
     _In_ QUIC_STREAM* Stream,
+    _In_ QUIC_RX_PACKET* Packet,
     _In_ BOOLEAN EncryptedWith0Rtt,
     _In_ const QUIC_STREAM_EX* Frame
     )
@@ -485,20 +495,53 @@ QuicStreamProcessStreamFrame(
             Stream->Connection->Send.MaxData -
             Stream->Connection->Send.OrderedStreamBytesReceived;
 
-        //
-        // Write any nonduplicate data to the receive buffer.
-        // QuicRecvBufferWrite will indicate if there is data to deliver.
-        //
-        Status =
-            QuicRecvBufferWrite(
-                &Stream->RecvBuffer,
-                Frame->Offset,
-                (uint16_t)Frame->Length,
-                Frame->Data,
-                &WriteLength,
-                &ReadyToDeliver);
-        if (QUIC_FAILED(Status)) {
-            goto Error;
+        if (Stream->Flags.ZeroCopyRecv &&
+            Packet->KeyType == QUIC_PACKET_KEY_1_RTT &&
+            Stream->RecvZeroCopy.Packet == NULL &&
+            !Stream->Flags.ReceiveDataPending &&
+            Stream->RecvBuffer.ReadPendingLength == 0 &&
+            Frame->Offset == Stream->RecvBuffer.BaseOffset &&
+            Frame->Offset == QuicRecvBufferGetTotalLength(&Stream->RecvBuffer)) {
+            //
+            // The frame is exactly the next expected data and nothing else is
+            // buffered, so the app can read it directly out of the decrypted
+            // packet. Only 1-RTT packets are used, since they are always the
+            // last in a datagram, which guarantees the datagram isn't going to
+            // be deferred after this point.
+            //
+            Status =
+                QuicRecvBufferWriteExternal(
+                    &Stream->RecvBuffer,
+                    Frame->Offset,
+                    (uint16_t)Frame->Length,
+                    &WriteLength);
+            if (QUIC_FAILED(Status)) {
+                goto Error;
+            }
+
+            Packet->HoldCount++;
+            Stream->RecvZeroCopy.Packet = Packet;
+            Stream->RecvZeroCopy.Data = Frame->Data;
+            Stream->RecvZeroCopy.Offset = Frame->Offset;
+            Stream->RecvZeroCopy.Length = (uint16_t)Frame->Length;
+            ReadyToDeliver = TRUE;
+
+        } else {
+            //
+            // Write any nonduplicate data to the receive buffer.
+            // QuicRecvBufferWrite will indicate if there is data to deliver.
+            //
+            Status =
+                QuicRecvBufferWrite(
+                    &Stream->RecvBuffer,
+                    Frame->Offset,
+                    (uint16_t)Frame->Length,
+                    Frame->Data,
+                    &WriteLength,
+                    &ReadyToDeliver);
+            if (QUIC_FAILED(Status)) {
+                goto Error;
+            }
         }
 
         //
@@ -523,6 +566,23 @@ QuicStreamProcessStreamFrame(
             if (EndOffset > Stream->RecvMax0RttLength) {
                 Stream->RecvMax0RttLength = EndOffset;
             }
+
+            if (Stream->Connection->Settings.EarlyCreditWindow != 0) {
+                //
+                // Top up the connection credit the client just used for 0-RTT
+                // now instead of waiting for the app to read the data, so the
+                // MAX_DATA rides in the server's first 0.5-RTT packet.
+                //
+                uint64_t MinMaxData =
+                    Stream->Connection->Send.OrderedStreamBytesReceived +
+                    Stream->Connection->Settings.EarlyCreditWindow;
+                if (Stream->Connection->Send.MaxData < MinMaxData) {
+                    Stream->Connection->Send.MaxData = MinMaxData;
+                    QuicSendSetSendFlag(
+                        &Stream->Connection->Send,
+                        QUIC_CONN_SEND_FLAG_MAX_DATA);
+                }
+            }
         }
 
         Stream->Connection->Stats.Recv.TotalStreamBytes += Frame->Length;
@@ -540,11 +600,14 @@ QuicStreamProcessStreamFrame(
 
     if (ReadyToDeliver &&
         (Stream->RecvBuffer.RecvMode == QUIC_RECV_BUF_MODE_MULTIPLE ||
+         Stream->RecvBuffer.RecvMode == QUIC_RECV_BUF_MODE_APP_OWNED ||
          Stream->RecvBuffer.ReadPendingLength == 0)) {
         Stream->Flags.ReceiveDataPending = TRUE;
-        QuicStreamRecvQueueFlush(
-            Stream,
-            Stream->RecvBuffer.BaseOffset == Stream->RecvMaxLength);
+        if (!QuicStreamSetQueueReceiveBatch(&Stream->Connection->Streams, Stream)) {
+            QuicStreamRecvQueueFlush(
+                Stream,
+                Stream->RecvBuffer.BaseOffset == Stream->RecvMaxLength);
+        }
     }
 
     QuicTraceLogStreamVerbose(
@@ -713,7 +776,7 @@ QuicStreamRecv(
 
         Status =
             QuicStreamProcessStreamFrame(
-                Stream, Packet->EncryptedWith0Rtt, &Frame);
+                Stream, Packet, Packet->EncryptedWith0Rtt, &Frame);
 
         break;
     }
@@ -738,6 +801,85 @@ QuicStreamRecv(
 // when many short streams are used, in which case we might never actually send a
 // MAX_STREAM_DATA update since each stream's entire payload fits in the initial window.
 //
+//
+// Auto-tunes the stream's flow control window, similar to TCP receive buffer
+// auto-tuning: the window targets twice the bytes the app consumed per RTT
+// since the last update. Fast consumers ramp up to that in one step instead of
+// doubling once per update, and streams the app drains slowly (or that were
+// idle) shrink back towards their initial window, bounding the memory a slow
+// stream can make us commit to.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+void
+QuicStreamTuneRecvWindow(
+    _In_ QUIC_STREAM* Stream,
+    _In_ uint64_t TimeNow
+    )
+{
+    QUIC_CONNECTION* Connection = Stream->Connection;
+    const uint32_t Window = Stream->RecvBuffer.VirtualBufferLength;
+
+    uint64_t Elapsed = CxPlatTimeDiff64(Stream->RecvWindowLastUpdate, TimeNow);
+    if (Elapsed == 0) {
+        Elapsed = 1;
+    }
+    const uint64_t Target =
+        (2 * Stream->RecvWindowBytesDelivered * Connection->Paths[0].SmoothedRtt) / Elapsed;
+
+    if (Target > Window) {
+        //
+        // Limit stream FC window growth by the connection FC window size, and
+        // don't grow it at all once memory is getting tight.
+        //
+        if (Window >= Connection->Settings.ConnFlowControlWindow ||
+            QuicLibraryGetMemoryPressure() >= QUIC_MEMORY_PRESSURE_ELEVATED) {
+            return;
+        }
+
+        uint32_t NewWindow = Window;
+        while (NewWindow < Target &&
+               NewWindow < Connection->Settings.ConnFlowControlWindow &&
+               NewWindow <= UINT32_MAX / 2) {
+            NewWindow <<= 1;
+        }
+
+        QuicTraceLogStreamVerbose(
+            IncreaseRxBuffer,
+            Stream,
+            "Increasing max RX buffer size to %u (MinRtt=%llu; TimeNow=%llu; LastUpdate=%llu)",
+            NewWindow,
+            Connection->Paths[0].MinRtt,
+            TimeNow,
+            Stream->RecvWindowLastUpdate);
+
+        QuicRecvBufferIncreaseVirtualBufferLength(&Stream->RecvBuffer, NewWindow);
+
+    } else if (Target < Window / 4 && Window > Stream->RecvWindowMin) {
+        //
+        // The app consumes far less than the window per RTT, so halve it. It
+        // must still cover everything already advertised to the peer.
+        //
+        const uint64_t Advertised =
+            Stream->MaxAllowedRecvOffset - Stream->RecvBuffer.BaseOffset;
+        uint32_t NewWindow = Window / 2;
+        if (NewWindow < Stream->RecvWindowMin) {
+            NewWindow = Stream->RecvWindowMin;
+        }
+        while (NewWindow < Advertised) {
+            NewWindow <<= 1;
+        }
+        if (NewWindow < Window) {
+            QuicTraceLogStreamVerbose(
+                DecreaseRxBuffer,
+                Stream,
+                "Decreasing max RX buffer size to %u",
+                NewWindow);
+            QuicRecvBufferDecreaseVirtualBufferLength(&Stream->RecvBuffer, NewWindow);
+        }
+    }
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicStreamOnBytesDelivered(
@@ -760,54 +902,18 @@ QuicStreamOnBytesDelivered(
             QUIC_CONN_SEND_FLAG_MAX_DATA);
     }
 
-    if (Stream->RecvWindowBytesDelivered >= RecvBufferDrainThreshold) {
-
-        uint64_t TimeNow = CxPlatTimeUs64();
-
+    if (Stream->RecvBuffer.RecvMode == QUIC_RECV_BUF_MODE_APP_OWNED) {
         //
-        // Limit stream FC window growth by the connection FC window size.
+        // The stream window is only advanced when the app provides more
+        // buffers, so there is no tuning to do here.
         //
-        if (Stream->RecvBuffer.VirtualBufferLength <
-            Stream->Connection->Settings.ConnFlowControlWindow) {
-
-            uint64_t TimeThreshold =
-                ((Stream->RecvWindowBytesDelivered * Stream->Connection->Paths[0].SmoothedRtt) / RecvBufferDrainThreshold);
-            if (CxPlatTimeDiff64(Stream->RecvWindowLastUpdate, TimeNow) <= TimeThreshold) {
-
-                //
-                // Buffer tuning:
-                //
-                // VirtualBufferLength limits the connection's throughput to:
-                //   R = VirtualBufferLength / RTT
-                //
-                // We've delivered data at an average rate of at least:
-                //   R / QUIC_RECV_BUFFER_DRAIN_RATIO
-                //
-                // Double VirtualBufferLength to make sure it doesn't limit
-                // throughput.
-                //
-                // Mainly people complain about flow control when it limits
-                // throughput. But if we grow the buffer limit and then the app
-                // stops receiving data, bytes will pile up in the buffer. We could
-                // add logic to shrink the buffer when the app absorb rate is too
-                // low.
-                //
-
-                QuicTraceLogStreamVerbose(
-                    IncreaseRxBuffer,
-                    Stream,
-                    "Increasing max RX buffer size to %u (MinRtt=%llu; TimeNow=%llu; LastUpdate=%llu)",
-                    Stream->RecvBuffer.VirtualBufferLength * 2,
-                    Stream->Connection->Paths[0].MinRtt,
-                    TimeNow,
-                    Stream->RecvWindowLastUpdate);
+        return;
+    }
 
-                QuicRecvBufferIncreaseVirtualBufferLength(
-                    &Stream->RecvBuffer,
-                    Stream->RecvBuffer.VirtualBufferLength * 2);
-            }
-        }
+    if (Stream->RecvWindowBytesDelivered >= RecvBufferDrainThreshold) {
 
+        uint64_t TimeNow = CxPlatTimeUs64();
+        QuicStreamTuneRecvWindow(Stream, TimeNow);
         Stream->RecvWindowLastUpdate = TimeNow;
         Stream->RecvWindowBytesDelivered = 0;
 
@@ -830,9 +936,14 @@ QuicStreamOnBytesDelivered(
         "Updating flow control window");
 
     CXPLAT_DBG_ASSERT(
-        Stream->RecvBuffer.BaseOffset + Stream->RecvBuffer.VirtualBufferLength >
+        Stream->RecvBuffer.BaseOffset + Stream->RecvBuffer.VirtualBufferLength >=
         Stream->MaxAllowedRecvOffset);
 
+    if (Stream->RecvBuffer.BaseOffset + Stream->RecvBuffer.VirtualBufferLength ==
+        Stream->MaxAllowedRecvOffset) {
+        return; // The window was shrunk, so there's nothing new to advertise.
+    }
+
     Stream->MaxAllowedRecvOffset =
         Stream->RecvBuffer.BaseOffset + Stream->RecvBuffer.VirtualBufferLength;
 
@@ -846,6 +957,284 @@ QuicStreamOnBytesDelivered(
         FALSE);
 }
 
+//
+// Makes sure RecvDecoded holds data of a compressed stream for the app, by
+// decompressing the next block if all of it has been received. Returns FALSE
+// if there is no data to indicate (yet).
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+QuicStreamRecvDecompress(
+    _In_ QUIC_STREAM* Stream
+    )
+{
+    if (Stream->RecvDecoded.Consumed < Stream->RecvDecoded.Length) {
+        return TRUE;
+    }
+
+    if (!QuicRecvBufferHasUnreadData(&Stream->RecvBuffer)) {
+        return FALSE;
+    }
+
+    if (Stream->RecvDecoded.Buffer == NULL) {
+        Stream->RecvDecoded.Buffer =
+            CXPLAT_ALLOC_NONPAGED(QUIC_STREAM_COMPRESSION_MAX_BLOCK, QUIC_POOL_STREAM_COMPRESS);
+        if (Stream->RecvDecoded.Buffer == NULL) {
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "decompressed stream block",
+                QUIC_STREAM_COMPRESSION_MAX_BLOCK);
+            QuicConnTransportError(Stream->Connection, QUIC_ERROR_INTERNAL_ERROR);
+            return FALSE;
+        }
+    }
+
+    QUIC_BUFFER Buffers[QUIC_STREAM_RECV_INDICATION_BUFFERS];
+    uint32_t BufferCount = QUIC_STREAM_RECV_INDICATION_BUFFERS;
+    uint64_t Offset;
+    QuicRecvBufferRead(&Stream->RecvBuffer, &Offset, &BufferCount, Buffers);
+
+    uint32_t DecodedLength = 0, EncodedLength = 0;
+    QUIC_STATUS Status =
+        QuicStreamDecompress(
+            &Stream->Connection->StreamCompression,
+            Buffers,
+            BufferCount,
+            Stream->RecvDecoded.Buffer,
+            &DecodedLength,
+            &EncodedLength);
+    if (Status == QUIC_STATUS_PENDING) {
+        uint64_t ReadLength = 0;
+        for (uint32_t i = 0; i < BufferCount; ++i) {
+            ReadLength += Buffers[i].Length;
+        }
+        if (Offset + ReadLength == Stream->RecvMaxLength) {
+            Status = QUIC_STATUS_PROTOCOL_ERROR; // The stream ends mid-block.
+        }
+    }
+
+    if (QUIC_FAILED(Status) || Status == QUIC_STATUS_PENDING) {
+        (void)QuicRecvBufferDrain(&Stream->RecvBuffer, 0);
+        if (Status != QUIC_STATUS_PENDING) {
+            QuicTraceEvent(
+                StreamError,
+                "[strm][%p] ERROR, %s.",
+                Stream,
+                "Invalid compressed block");
+            QuicConnTransportError(
+                Stream->Connection,
+                Status == QUIC_STATUS_OUT_OF_MEMORY ?
+                    QUIC_ERROR_INTERNAL_ERROR : QUIC_ERROR_PROTOCOL_VIOLATION);
+        }
+        return FALSE;
+    }
+
+    Stream->RecvDecoded.Offset += Stream->RecvDecoded.Length;
+    Stream->RecvDecoded.Length = DecodedLength;
+    Stream->RecvDecoded.Consumed = 0;
+    Stream->RecvDecoded.ZeroRtt = Offset < Stream->RecvMax0RttLength;
+
+    //
+    // The encoded block isn't needed anymore, so its flow control credit goes
+    // back to the peer right away.
+    //
+    (void)QuicRecvBufferDrain(&Stream->RecvBuffer, EncodedLength);
+    QuicStreamOnBytesDelivered(Stream, EncodedLength);
+
+    return TRUE;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+QuicStreamRecvPrepareIndication(
+    _In_ QUIC_STREAM* Stream,
+    _Out_ QUIC_STREAM_EVENT* Event,
+    _Out_writes_(QUIC_STREAM_RECV_INDICATION_BUFFERS) QUIC_BUFFER* RecvBuffers
+    )
+{
+    if (!Stream->Flags.ReceiveDataPending || !Stream->Flags.ReceiveEnabled) {
+        return FALSE;
+    }
+
+    CXPLAT_DBG_ASSERT(!Stream->Flags.SentStopSending);
+
+    CxPlatZeroMemory(Event, sizeof(*Event));
+    Event->Type = QUIC_STREAM_EVENT_RECEIVE;
+    Event->RECEIVE.BufferCount = QUIC_STREAM_RECV_INDICATION_BUFFERS;
+    Event->RECEIVE.Buffers = RecvBuffers;
+
+    if (Stream->Flags.Compressed) {
+        //
+        // Indicate the rest of the current decompressed block.
+        //
+        if (QuicStreamRecvDecompress(Stream)) {
+            RecvBuffers[0].Buffer =
+                Stream->RecvDecoded.Buffer + Stream->RecvDecoded.Consumed;
+            RecvBuffers[0].Length =
+                Stream->RecvDecoded.Length - Stream->RecvDecoded.Consumed;
+            Event->RECEIVE.AbsoluteOffset =
+                Stream->RecvDecoded.Offset + Stream->RecvDecoded.Consumed;
+            Event->RECEIVE.BufferCount = 1;
+            Event->RECEIVE.TotalBufferLength = RecvBuffers[0].Length;
+            if (Stream->RecvDecoded.ZeroRtt) {
+                Event->RECEIVE.Flags |= QUIC_RECEIVE_FLAG_0_RTT;
+            }
+        } else if (Stream->RecvBuffer.BaseOffset == Stream->RecvMaxLength) {
+            Event->RECEIVE.AbsoluteOffset =
+                Stream->RecvDecoded.Offset + Stream->RecvDecoded.Length;
+            Event->RECEIVE.BufferCount = 0;
+        } else {
+            Stream->Flags.ReceiveDataPending = FALSE; // Waiting for the rest of the block.
+            return FALSE;
+        }
+        if (Stream->RecvBuffer.BaseOffset == Stream->RecvMaxLength) {
+            Event->RECEIVE.Flags |= QUIC_RECEIVE_FLAG_FIN;
+        }
+        goto Indicate;
+    }
+
+    //
+    // Try to read the next available buffers. Zero-copy data always
+    // precedes anything in the receive buffer.
+    //
+    BOOLEAN DataAvailable = TRUE;
+    if (Stream->RecvZeroCopy.Packet != NULL) {
+        RecvBuffers[0].Buffer = (uint8_t*)Stream->RecvZeroCopy.Data;
+        RecvBuffers[0].Length = Stream->RecvZeroCopy.Length;
+        Event->RECEIVE.AbsoluteOffset = Stream->RecvZeroCopy.Offset;
+        Event->RECEIVE.BufferCount = 1;
+        Event->RECEIVE.TotalBufferLength = Stream->RecvZeroCopy.Length;
+
+    } else if (QuicRecvBufferHasUnreadData(&Stream->RecvBuffer)) {
+        QuicRecvBufferRead(
+            &Stream->RecvBuffer,
+            &Event->RECEIVE.AbsoluteOffset,
+            &Event->RECEIVE.BufferCount,
+            RecvBuffers);
+        for (uint32_t i = 0; i < Event->RECEIVE.BufferCount; ++i) {
+            Event->RECEIVE.TotalBufferLength += RecvBuffers[i].Length;
+        }
+
+    } else {
+        DataAvailable = FALSE;
+    }
+
+    if (DataAvailable) {
+        CXPLAT_DBG_ASSERT(Event->RECEIVE.TotalBufferLength != 0);
+
+        if (Event->RECEIVE.AbsoluteOffset < Stream->RecvMax0RttLength) {
+            //
+            // This data includes data encrypted with 0-RTT key.
+            //
+            Event->RECEIVE.Flags |= QUIC_RECEIVE_FLAG_0_RTT;
+
+            //
+            // TODO - Split mixed 0-RTT and 1-RTT data?
+            //
+        }
+
+        if (Event->RECEIVE.AbsoluteOffset + Event->RECEIVE.TotalBufferLength == Stream->RecvMaxLength) {
+            //
+            // This data goes all the way to the FIN.
+            //
+            Event->RECEIVE.Flags |= QUIC_RECEIVE_FLAG_FIN;
+        }
+
+    } else {
+        //
+        // FIN only case.
+        //
+        Event->RECEIVE.AbsoluteOffset = Stream->RecvMaxLength;
+        Event->RECEIVE.BufferCount = 0;
+        Event->RECEIVE.Flags |= QUIC_RECEIVE_FLAG_FIN; // TODO - 0-RTT flag?
+    }
+
+Indicate:
+
+    Stream->Flags.ReceiveEnabled = Stream->Flags.ReceiveMultiple;
+    Stream->Flags.ReceiveCallActive = TRUE;
+    Stream->RecvPendingLength += Event->RECEIVE.TotalBufferLength;
+    CXPLAT_DBG_ASSERT(
+        Stream->RecvZeroCopy.Packet != NULL ||
+        Stream->Flags.Compressed ||
+        Stream->RecvPendingLength <= Stream->RecvBuffer.ReadPendingLength);
+
+    return TRUE;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+QuicStreamRecvCompleteIndication(
+    _In_ QUIC_STREAM* Stream,
+    _In_ QUIC_STATUS Status,
+    _In_ uint64_t TotalBufferLength
+    )
+{
+    BOOLEAN FlushRecv;
+
+    Stream->Flags.ReceiveCallActive = FALSE;
+
+    if (Status == QUIC_STATUS_CONTINUE) {
+        CXPLAT_DBG_ASSERT(!Stream->Flags.SentStopSending);
+        InterlockedExchangeAdd64(
+            (int64_t*)&Stream->RecvCompletionLength,
+            (int64_t)TotalBufferLength);
+        FlushRecv = TRUE;
+        //
+        // The app has explicitly indicated it wants to continue to
+        // receive callbacks, even if all the data wasn't drained.
+        //
+        Stream->Flags.ReceiveEnabled = TRUE;
+
+    } else if (Status == QUIC_STATUS_PENDING) {
+        //
+        // The app called the receive complete API inline if
+        // RecvCompletionLength is non-zero.
+        //
+        FlushRecv = (Stream->RecvCompletionLength != 0);
+
+    } else {
+        //
+        // All failure status returns shouldn't be used by the app are
+        // ignored. We fire a telemetry event and treat as success.
+        //
+        CXPLAT_TEL_ASSERTMSG_ARGS(
+            QUIC_SUCCEEDED(Status),
+            "App failed recv callback",
+            Stream->Connection->Registration->AppName,
+            Status, 0);
+
+        InterlockedExchangeAdd64(
+            (int64_t*)&Stream->RecvCompletionLength,
+            (int64_t)TotalBufferLength);
+        FlushRecv = TRUE;
+    }
+
+    if (FlushRecv) {
+        uint64_t BufferLength = Stream->RecvCompletionLength;
+        InterlockedExchangeAdd64(
+            (int64_t*)&Stream->RecvCompletionLength,
+            -(int64_t)BufferLength);
+        FlushRecv = QuicStreamReceiveComplete(Stream, BufferLength);
+    }
+
+    if (!FlushRecv &&
+        Stream->Flags.ReceiveMultiple &&
+        Stream->Flags.ReceiveEnabled &&
+        !Stream->Flags.SentStopSending &&
+        QuicRecvBufferHasUnreadData(&Stream->RecvBuffer)) {
+        //
+        // A single indication may not cover all the chunks the data is
+        // spread over. In multi-receive mode the rest can be indicated
+        // right away, even while the previous receives are still pending.
+        //
+        FlushRecv = TRUE;
+    }
+
+    return FlushRecv;
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicStreamRecvFlush(
@@ -869,62 +1258,10 @@ QuicStreamRecvFlush(
         return;
     }
 
-    BOOLEAN FlushRecv = TRUE;
-    while (FlushRecv) {
-        CXPLAT_DBG_ASSERT(!Stream->Flags.SentStopSending);
-
-        QUIC_BUFFER RecvBuffers[3];
-        QUIC_STREAM_EVENT Event = {0};
-        Event.Type = QUIC_STREAM_EVENT_RECEIVE;
-        Event.RECEIVE.BufferCount = ARRAYSIZE(RecvBuffers);
-        Event.RECEIVE.Buffers = RecvBuffers;
-
-        //
-        // Try to read the next available buffers.
-        //
-        BOOLEAN DataAvailable = QuicRecvBufferHasUnreadData(&Stream->RecvBuffer);
-        if (DataAvailable) {
-            QuicRecvBufferRead(
-                &Stream->RecvBuffer,
-                &Event.RECEIVE.AbsoluteOffset,
-                &Event.RECEIVE.BufferCount,
-                RecvBuffers);
-            for (uint32_t i = 0; i < Event.RECEIVE.BufferCount; ++i) {
-                Event.RECEIVE.TotalBufferLength += RecvBuffers[i].Length;
-            }
-            CXPLAT_DBG_ASSERT(Event.RECEIVE.TotalBufferLength != 0);
-
-            if (Event.RECEIVE.AbsoluteOffset < Stream->RecvMax0RttLength) {
-                //
-                // This data includes data encrypted with 0-RTT key.
-                //
-                Event.RECEIVE.Flags |= QUIC_RECEIVE_FLAG_0_RTT;
-
-                //
-                // TODO - Split mixed 0-RTT and 1-RTT data?
-                //
-            }
-
-            if (Event.RECEIVE.AbsoluteOffset + Event.RECEIVE.TotalBufferLength == Stream->RecvMaxLength) {
-                //
-                // This data goes all the way to the FIN.
-                //
-                Event.RECEIVE.Flags |= QUIC_RECEIVE_FLAG_FIN;
-            }
-
-        } else {
-            //
-            // FIN only case.
-            //
-            Event.RECEIVE.AbsoluteOffset = Stream->RecvMaxLength;
-            Event.RECEIVE.BufferCount = 0;
-            Event.RECEIVE.Flags |= QUIC_RECEIVE_FLAG_FIN; // TODO - 0-RTT flag?
-        }
-
-        Stream->Flags.ReceiveEnabled = Stream->Flags.ReceiveMultiple;
-        Stream->Flags.ReceiveCallActive = TRUE;
-        Stream->RecvPendingLength += Event.RECEIVE.TotalBufferLength;
-        CXPLAT_DBG_ASSERT(Stream->RecvPendingLength <= Stream->RecvBuffer.ReadPendingLength);
+    QuicStageCyclesStart(DeliveryStart);
+    QUIC_BUFFER RecvBuffers[QUIC_STREAM_RECV_INDICATION_BUFFERS];
+    QUIC_STREAM_EVENT Event;
+    while (QuicStreamRecvPrepareIndication(Stream, &Event, RecvBuffers)) {
 
         QuicTraceEvent(
             StreamAppReceive,
@@ -936,52 +1273,130 @@ QuicStreamRecvFlush(
 
         QUIC_STATUS Status = QuicStreamIndicateEvent(Stream, &Event);
 
-        Stream->Flags.ReceiveCallActive = FALSE;
+        if (!QuicStreamRecvCompleteIndication(
+                Stream, Status, Event.RECEIVE.TotalBufferLength)) {
+            break;
+        }
+    }
+    QuicStageCyclesEnd(QUIC_PERF_STAGE_STREAM_DELIVERY, DeliveryStart, 1);
+}
 
-        if (Status == QUIC_STATUS_CONTINUE) {
-            CXPLAT_DBG_ASSERT(!Stream->Flags.SentStopSending);
-            InterlockedExchangeAdd64(
-                (int64_t*)&Stream->RecvCompletionLength,
-                (int64_t)Event.RECEIVE.TotalBufferLength);
-            FlushRecv = TRUE;
-            //
-            // The app has explicitly indicated it wants to continue to
-            // receive callbacks, even if all the data wasn't drained.
-            //
-            Stream->Flags.ReceiveEnabled = TRUE;
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicStreamReceiveInto(
+    _In_ QUIC_STREAM* Stream,
+    _In_reads_(BufferCount) const QUIC_BUFFER* Buffers,
+    _In_ uint32_t BufferCount,
+    _Out_ uint64_t* BytesReceived,
+    _Out_ QUIC_RECEIVE_FLAGS* Flags
+    )
+{
+    *BytesReceived = 0;
+    *Flags = QUIC_RECEIVE_FLAG_NONE;
 
-        } else if (Status == QUIC_STATUS_PENDING) {
-            //
-            // The app called the receive complete API inline if
-            // RecvCompletionLength is non-zero.
-            //
-            FlushRecv = (Stream->RecvCompletionLength != 0);
+    if (Stream->Flags.RemoteNotAllowed ||
+        Stream->Flags.RemoteCloseReset ||
+        Stream->Flags.SentStopSending) {
+        return QUIC_STATUS_INVALID_STATE;
+    }
 
-        } else {
-            //
-            // All failure status returns shouldn't be used by the app are
-            // ignored. We fire a telemetry event and treat as success.
-            //
-            CXPLAT_TEL_ASSERTMSG_ARGS(
-                QUIC_SUCCEEDED(Status),
-                "App failed recv callback",
-                Stream->Connection->Registration->AppName,
-                Status, 0);
-
-            InterlockedExchangeAdd64(
-                (int64_t*)&Stream->RecvCompletionLength,
-                (int64_t)Event.RECEIVE.TotalBufferLength);
-            FlushRecv = TRUE;
+    if (Stream->Flags.RemoteCloseFin) {
+        //
+        // Everything, including the FIN, has already been delivered.
+        //
+        *Flags = QUIC_RECEIVE_FLAG_FIN;
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    if (Stream->Flags.ReceiveEnabled ||
+        Stream->Flags.ReceiveMultiple ||
+        Stream->Flags.UseAppOwnedRecvBuffers ||
+        Stream->RecvPendingLength != 0) {
+        //
+        // Pulled reads can't be mixed with receive indications (including
+        // pending ones) and aren't supported in the multi-receive or app-owned
+        // buffer modes.
+        //
+        return QUIC_STATUS_INVALID_STATE;
+    }
+
+    uint32_t Index = 0;     // The app buffer being filled.
+    uint32_t Offset = 0;    // The offset into that buffer.
+    while (Index < BufferCount) {
+        //
+        // Read the next available data exactly as for a receive indication,
+        // but copy it out and complete it right away instead.
+        //
+        QUIC_BUFFER RecvBuffers[QUIC_STREAM_RECV_INDICATION_BUFFERS];
+        QUIC_STREAM_EVENT Event;
+        Stream->Flags.ReceiveEnabled = TRUE;
+        if (!QuicStreamRecvPrepareIndication(Stream, &Event, RecvBuffers)) {
+            Stream->Flags.ReceiveEnabled = FALSE;
+            break;
+        }
+
+        uint64_t Copied = 0;
+        uint32_t RecvIndex = 0;
+        uint32_t RecvOffset = 0;
+        while (RecvIndex < Event.RECEIVE.BufferCount && Index < BufferCount) {
+            uint32_t Length =
+                CXPLAT_MIN(
+                    RecvBuffers[RecvIndex].Length - RecvOffset,
+                    Buffers[Index].Length - Offset);
+            CxPlatCopyMemory(
+                Buffers[Index].Buffer + Offset,
+                RecvBuffers[RecvIndex].Buffer + RecvOffset,
+                Length);
+            Copied += Length;
+            RecvOffset += Length;
+            Offset += Length;
+            if (RecvOffset == RecvBuffers[RecvIndex].Length) {
+                RecvIndex++;
+                RecvOffset = 0;
+            }
+            if (Offset == Buffers[Index].Length) {
+                Index++;
+                Offset = 0;
+            }
+        }
+
+        *BytesReceived += Copied;
+        *Flags |= Event.RECEIVE.Flags & QUIC_RECEIVE_FLAG_0_RTT;
+        BOOLEAN Done = Copied < Event.RECEIVE.TotalBufferLength;
+        if (!Done && (Event.RECEIVE.Flags & QUIC_RECEIVE_FLAG_FIN)) {
+            *Flags |= QUIC_RECEIVE_FLAG_FIN;
+            Done = TRUE;
         }
 
-        if (FlushRecv) {
-            uint64_t BufferLength = Stream->RecvCompletionLength;
-            InterlockedExchangeAdd64(
-                (int64_t*)&Stream->RecvCompletionLength,
-                -(int64_t)BufferLength);
-            FlushRecv = QuicStreamReceiveComplete(Stream, BufferLength);
+        (void)QuicStreamRecvCompleteIndication(Stream, QUIC_STATUS_SUCCESS, Copied);
+        Stream->Flags.ReceiveEnabled = FALSE;
+
+        if (Done) {
+            break;
         }
     }
+
+    QuicTraceLogStreamVerbose(
+        AppReceiveInto,
+        Stream,
+        "App pulled %llu bytes",
+        *BytesReceived);
+
+    return QUIC_STATUS_SUCCESS;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicStreamRecvReleaseZeroCopy(
+    _In_ QUIC_STREAM* Stream
+    )
+{
+    if (Stream->RecvZeroCopy.Packet != NULL) {
+        QuicConnReleaseHeldPacket(Stream->RecvZeroCopy.Packet);
+        Stream->RecvZeroCopy.Packet = NULL;
+        Stream->RecvZeroCopy.Data = NULL;
+        Stream->RecvZeroCopy.Length = 0;
+    }
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -1036,7 +1451,36 @@ QuicStreamReceiveComplete(
     //
     // Reclaim any buffer space comsumed by the app.
     //
-    if (Stream->RecvPendingLength == 0 ||
+    if (Stream->RecvZeroCopy.Packet != NULL) {
+        //
+        // The app was reading directly from the received packet. Release the
+        // packet once all of its data has been consumed.
+        //
+        CXPLAT_DBG_ASSERT(BufferLength <= Stream->RecvZeroCopy.Length);
+        Stream->RecvZeroCopy.Data += BufferLength;
+        Stream->RecvZeroCopy.Offset += BufferLength;
+        Stream->RecvZeroCopy.Length -= (uint16_t)BufferLength;
+        if (Stream->RecvZeroCopy.Length == 0) {
+            QuicStreamRecvReleaseZeroCopy(Stream);
+            if (!QuicRecvBufferHasUnreadData(&Stream->RecvBuffer)) {
+                Stream->Flags.ReceiveDataPending = FALSE;
+            }
+        }
+
+    } else if (Stream->Flags.Compressed) {
+        //
+        // The block was already drained from the receive buffer when it was
+        // decompressed.
+        //
+        CXPLAT_DBG_ASSERT(
+            BufferLength <= Stream->RecvDecoded.Length - Stream->RecvDecoded.Consumed);
+        Stream->RecvDecoded.Consumed += (uint32_t)BufferLength;
+        if (Stream->RecvDecoded.Consumed == Stream->RecvDecoded.Length &&
+            !QuicRecvBufferHasUnreadData(&Stream->RecvBuffer)) {
+            Stream->Flags.ReceiveDataPending = FALSE;
+        }
+
+    } else if (Stream->RecvPendingLength == 0 ||
         QuicRecvBufferDrain(&Stream->RecvBuffer, BufferLength)) {
         Stream->Flags.ReceiveDataPending = FALSE; // No more pending data to deliver.
     }
@@ -1044,7 +1488,9 @@ QuicStreamReceiveComplete(
     if (BufferLength != 0) {
         Stream->RecvPendingLength -= BufferLength;
         QuicPerfCounterAdd(QUIC_PERF_COUNTER_APP_RECV_BYTES, BufferLength);
-        QuicStreamOnBytesDelivered(Stream, BufferLength);
+        if (!Stream->Flags.Compressed) {
+            QuicStreamOnBytesDelivered(Stream, BufferLength);
+        }
     }
 
     if (Stream->RecvPendingLength == 0) {
@@ -1158,6 +1604,7 @@ QuicStreamRecvSetEnabledState(
 
         if (Stream->Flags.Started && NewRecvEnabled &&
             (Stream->RecvBuffer.RecvMode == QUIC_RECV_BUF_MODE_MULTIPLE ||
+            Stream->RecvBuffer.RecvMode == QUIC_RECV_BUF_MODE_APP_OWNED ||
             Stream->RecvBuffer.ReadPendingLength == 0)) {
             //
             // The application just resumed receive callbacks. Queue a
@@ -1174,3 +1621,49 @@ QuicStreamRecvSetEnabledState(
 
     return QUIC_STATUS_SUCCESS;
 }
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicStreamProvideRecvBuffers(
+    _In_ QUIC_STREAM* Stream,
+    _Inout_ CXPLAT_LIST_ENTRY* Chunks
+    )
+{
+    if (!Stream->Flags.UseAppOwnedRecvBuffers) {
+        return QUIC_STATUS_INVALID_STATE;
+    }
+
+    QUIC_STATUS Status = QuicRecvBufferProvideChunks(&Stream->RecvBuffer, Chunks);
+    if (QUIC_FAILED(Status)) {
+        return Status;
+    }
+
+    //
+    // The new space may extend the flow control window past what has already
+    // been advertised to the peer.
+    //
+    if (Stream->RecvBuffer.BaseOffset + Stream->RecvBuffer.VirtualBufferLength >
+        Stream->MaxAllowedRecvOffset &&
+        !Stream->Flags.RemoteCloseFin &&
+        !Stream->Flags.RemoteCloseReset) {
+
+        QuicTraceLogStreamVerbose(
+            UpdateFlowControl,
+            Stream,
+            "Updating flow control window");
+
+        Stream->MaxAllowedRecvOffset =
+            Stream->RecvBuffer.BaseOffset + Stream->RecvBuffer.VirtualBufferLength;
+
+        QuicSendSetSendFlag(
+            &Stream->Connection->Send,
+            QUIC_CONN_SEND_FLAG_MAX_DATA);
+        QuicSendSetStreamSendFlag(
+            &Stream->Connection->Send,
+            Stream,
+            QUIC_STREAM_SEND_FLAG_MAX_DATA,
+            FALSE);
+    }
+
+    return QUIC_STATUS_SUCCESS;
+}
@@ -422,6 +422,9 @@ QuicStreamCompleteSendRequest(
     if (Stream->SendBookmark == SendRequest) {
         Stream->SendBookmark = SendRequest->Next;
     }
+    if (Stream->SendRecoveryBookmark == SendRequest) {
+        Stream->SendRecoveryBookmark = SendRequest->Next;
+    }
     if (Stream->SendBufferBookmark == SendRequest) {
         Stream->SendBufferBookmark = SendRequest->Next;
         CXPLAT_DBG_ASSERT(
@@ -433,27 +436,48 @@ QuicStreamCompleteSendRequest(
         QuicStreamIndicateStartComplete(Stream, QUIC_STATUS_ABORTED);
     }
 
+    if (!Canceled && SendRequest->SendTime != 0 &&
+        Connection->LatencyHistograms != NULL) {
+        QuicLatencyHistogramRecord(
+            &Connection->LatencyHistograms->SendToAck,
+            CxPlatTimeDiff64(SendRequest->SendTime, CxPlatTimeUs64()));
+    }
+
     if (!(SendRequest->Flags & QUIC_SEND_FLAG_BUFFERED)) {
-        QUIC_STREAM_EVENT Event;
-        Event.Type = QUIC_STREAM_EVENT_SEND_COMPLETE;
-        Event.SEND_COMPLETE.Canceled = Canceled;
-        Event.SEND_COMPLETE.ClientContext = SendRequest->ClientContext;
+        //
+        // Requests complete in order, so only the last request of a batch
+        // indicates the completion, for the whole batch.
+        //
+        if (!(SendRequest->Flags & QUIC_SEND_FLAG_BATCHED)) {
+            QUIC_STREAM_EVENT Event;
+            Event.Type = QUIC_STREAM_EVENT_SEND_COMPLETE;
+            Event.SEND_COMPLETE.Canceled = Canceled;
+            Event.SEND_COMPLETE.ClientContext = SendRequest->ClientContext;
 
-        if (Canceled) {
-            QuicTraceLogStreamVerbose(
-                IndicateSendCanceled,
-                Stream,
-                "Indicating QUIC_STREAM_EVENT_SEND_COMPLETE [%p] (Canceled)",
-                SendRequest);
-        } else {
-            QuicTraceLogStreamVerbose(
-                IndicateSendComplete,
-                Stream,
-                "Indicating QUIC_STREAM_EVENT_SEND_COMPLETE [%p]",
-                SendRequest);
-        }
+            if (Canceled) {
+                QuicTraceLogStreamVerbose(
+                    IndicateSendCanceled,
+                    Stream,
+                    "Indicating QUIC_STREAM_EVENT_SEND_COMPLETE [%p] (Canceled)",
+                    SendRequest);
+            } else {
+                QuicTraceLogStreamVerbose(
+                    IndicateSendComplete,
+                    Stream,
+                    "Indicating QUIC_STREAM_EVENT_SEND_COMPLETE [%p]",
+                    SendRequest);
+            }
 
-        (void)QuicStreamIndicateEvent(Stream, &Event);
+            (void)QuicStreamIndicateEvent(Stream, &Event);
+        }
+        if (SendRequest->Flags & QUIC_SEND_FLAG_COMPRESSED) {
+            QuicSendBufferFree(
+                &Connection->SendBuffer,
+                SendRequest->InternalBuffer.Buffer,
+                SendRequest->InternalBuffer.Length);
+        }
+    } else if (SendRequest->Flags & QUIC_SEND_FLAG_REGISTERED) {
+        Connection->SendBuffer.BufferedBytes -= SendRequest->InternalBuffer.Length;
     } else if (SendRequest->InternalBuffer.Length != 0) {
         QuicSendBufferFree(
             &Connection->SendBuffer,
@@ -473,6 +497,41 @@ QuicStreamCompleteSendRequest(
     CxPlatPoolFree(&Connection->Worker->SendRequestPool, SendRequest);
 }
 
+//
+// Checks if the request's bytes are contiguous and completely within one of
+// the memory regions the app registered with the connection.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+QuicStreamSendRequestIsRegistered(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ const QUIC_SEND_REQUEST* Req
+    )
+{
+    if (Connection->SendBuffer.MemoryRegionCount == 0) {
+        return FALSE;
+    }
+
+    const uint8_t* Start = NULL;
+    const uint8_t* End = NULL;
+    for (uint32_t i = 0; i < Req->BufferCount; ++i) {
+        if (Req->Buffers[i].Length == 0) {
+            continue;
+        }
+        if (Start == NULL) {
+            Start = Req->Buffers[i].Buffer;
+        } else if (Req->Buffers[i].Buffer != End) {
+            return FALSE;
+        }
+        End = Req->Buffers[i].Buffer + Req->Buffers[i].Length;
+    }
+
+    return
+        Start != NULL &&
+        QuicSendBufferIsRegisteredMemory(
+            &Connection->SendBuffer, Start, (uint64_t)(End - Start));
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 QUIC_STATUS
 QuicStreamSendBufferRequest(
@@ -484,7 +543,28 @@ QuicStreamSendBufferRequest(
 
     CXPLAT_DBG_ASSERT(Req->TotalLength <= UINT32_MAX);
 
-    if (Req->TotalLength != 0) {
+    if (Req->Flags & QUIC_SEND_FLAG_COMPRESSED) {
+        //
+        // Compressing already copied the data into an internal buffer.
+        //
+        CXPLAT_DBG_ASSERT(Req->Buffers == &Req->InternalBuffer);
+
+    } else if (Req->TotalLength != 0 &&
+        QuicStreamSendRequestIsRegistered(Connection, Req)) {
+        //
+        // The app guarantees the bytes stay valid and unmodified, so just
+        // reference them in place. They still count against the buffer so
+        // the number of early completions stays bounded.
+        //
+        uint32_t i = 0;
+        while (Req->Buffers[i].Length == 0) {
+            ++i;
+        }
+        Req->InternalBuffer.Buffer = Req->Buffers[i].Buffer;
+        Connection->SendBuffer.BufferedBytes += Req->TotalLength;
+        Req->Flags |= QUIC_SEND_FLAG_REGISTERED;
+
+    } else if (Req->TotalLength != 0) {
         //
         // Copy the request bytes into an internal buffer.
         //
@@ -516,18 +596,20 @@ QuicStreamSendBufferRequest(
         !(Stream->SendBufferBookmark->Flags & QUIC_SEND_FLAG_BUFFERED));
 
     //
-    // Complete the request.
+    // Complete the request (unless a later request of its batch will).
     //
-    QUIC_STREAM_EVENT Event;
-    Event.Type = QUIC_STREAM_EVENT_SEND_COMPLETE;
-    Event.SEND_COMPLETE.Canceled = FALSE;
-    Event.SEND_COMPLETE.ClientContext = Req->ClientContext;
-    QuicTraceLogStreamVerbose(
-        IndicateSendComplete,
-        Stream,
-        "Indicating QUIC_STREAM_EVENT_SEND_COMPLETE [%p]",
-        Req);
-    (void)QuicStreamIndicateEvent(Stream, &Event);
+    if (!(Req->Flags & QUIC_SEND_FLAG_BATCHED)) {
+        QUIC_STREAM_EVENT Event;
+        Event.Type = QUIC_STREAM_EVENT_SEND_COMPLETE;
+        Event.SEND_COMPLETE.Canceled = FALSE;
+        Event.SEND_COMPLETE.ClientContext = Req->ClientContext;
+        QuicTraceLogStreamVerbose(
+            IndicateSendComplete,
+            Stream,
+            "Indicating QUIC_STREAM_EVENT_SEND_COMPLETE [%p]",
+            Req);
+        (void)QuicStreamIndicateEvent(Stream, &Event);
+    }
 
     Req->ClientContext = NULL;
 
@@ -591,6 +673,63 @@ QuicStreamEnqueueSendRequest(
         SendRequest->Flags);
 }
 
+//
+// Replaces the data of a request on a compressed stream with its compressed
+// blocks, in an internal buffer.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicStreamSendCompressRequest(
+    _In_ QUIC_STREAM* Stream,
+    _Inout_ QUIC_SEND_REQUEST* Req
+    )
+{
+    QUIC_CONNECTION* Connection = Stream->Connection;
+
+    const uint64_t Bound = QuicStreamCompressBound(Req->TotalLength);
+    if (Bound > UINT32_MAX) {
+        return QUIC_STATUS_INVALID_PARAMETER;
+    }
+
+    uint8_t* Buf = QuicSendBufferAlloc(&Connection->SendBuffer, (uint32_t)Bound);
+    if (Buf == NULL) {
+        return QUIC_STATUS_OUT_OF_MEMORY;
+    }
+
+    uint64_t EncodedLength;
+    QUIC_STATUS Status =
+        QuicStreamCompress(
+            &Connection->StreamCompression,
+            Req->Buffers,
+            Req->BufferCount,
+            Req->TotalLength,
+            Buf,
+            &EncodedLength);
+    if (QUIC_FAILED(Status)) {
+        QuicSendBufferFree(&Connection->SendBuffer, Buf, (uint32_t)Bound);
+        return Status;
+    }
+
+    QuicSendBufferTrim(&Connection->SendBuffer, (uint32_t)Bound, (uint32_t)EncodedLength);
+
+    QuicTraceLogStreamVerbose(
+        SendRequestCompressed,
+        Stream,
+        "Compressed send request [%p] from %llu to %llu bytes",
+        Req,
+        Req->TotalLength,
+        EncodedLength);
+
+    Req->InternalBuffer.Buffer = Buf;
+    Req->InternalBuffer.Length = (uint32_t)EncodedLength;
+    Req->Buffers = &Req->InternalBuffer;
+    Req->BufferCount = 1;
+    Req->TotalLength = EncodedLength;
+    Req->Flags |= QUIC_SEND_FLAG_COMPRESSED;
+
+    return QUIC_STATUS_SUCCESS;
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicStreamSendFlush(
@@ -631,8 +770,45 @@ QuicStreamSendFlush(
             continue;
         }
 
+        if (Stream->Flags.Compressed && SendRequest->TotalLength != 0) {
+            if (QUIC_FAILED(QuicStreamNegotiateCompression(Stream))) {
+                //
+                // Too early to tell whether to compress (so starting the
+                // stream fails too).
+                //
+                QuicStreamCompleteSendRequest(Stream, SendRequest, TRUE, FALSE);
+                continue;
+            }
+            if (Stream->Flags.Compressed &&
+                QUIC_FAILED(QuicStreamSendCompressRequest(Stream, SendRequest))) {
+                //
+                // The peer can't make sense of the rest of the stream without
+                // this request's data.
+                //
+                QuicStreamCompleteSendRequest(Stream, SendRequest, TRUE, FALSE);
+                QuicStreamSendShutdown(Stream, FALSE, FALSE, FALSE, QUIC_ERROR_INTERNAL_ERROR);
+                continue;
+            }
+        }
+
         QuicStreamEnqueueSendRequest(Stream, SendRequest);
 
+        if ((SendRequest->Flags & QUIC_SEND_FLAG_COMPRESSED) &&
+            Stream->SendBufferBookmark == SendRequest) {
+            //
+            // The app's buffers are no longer needed, so complete the request
+            // right away, whether or not send buffering is enabled.
+            //
+            (void)QuicStreamSendBufferRequest(Stream, SendRequest);
+        }
+
+        const BOOLEAN DelaySend =
+            !!(SendRequest->Flags & QUIC_SEND_FLAG_DELAY_SEND) ||
+            QuicSendCoalesceStreamData(
+                &Stream->Connection->Send,
+                SendRequest->TotalLength,
+                SendRequest->Flags);
+
         if (SendRequest->Flags & QUIC_SEND_FLAG_START && !Stream->Flags.Started) {
             //
             // Start the stream if the flag is set.
@@ -648,7 +824,7 @@ QuicStreamSendFlush(
                 Stream,
                 TRUE,
                 FALSE,
-                !!(SendRequest->Flags & QUIC_SEND_FLAG_DELAY_SEND),
+                DelaySend,
                 0);
         }
 
@@ -656,7 +832,7 @@ QuicStreamSendFlush(
             &Stream->Connection->Send,
             Stream,
             QUIC_STREAM_SEND_FLAG_DATA,
-            !!(SendRequest->Flags & QUIC_SEND_FLAG_DELAY_SEND));
+            DelaySend);
 
         if (Stream->Connection->Settings.SendBufferingEnabled) {
             QuicSendBufferFill(Stream->Connection);
@@ -697,15 +873,23 @@ QuicStreamCopyFromSendRequests(
 
     //
     // Find the send request containing the first byte, using the bookmark if
-    // possible (if the caller is requesting bytes before the bookmark, e.g.
-    // for a retransmission, then we have to do a full search).
+    // possible. If the caller is requesting bytes before the bookmark, i.e.
+    // for a retransmission, then start from the recovery bookmark instead, and
+    // only fall back to a full search if the repair is before that too.
     //
     QUIC_SEND_REQUEST* Req;
+    BOOLEAN IsRetransmission = FALSE;
     if (Stream->SendBookmark != NULL &&
         Stream->SendBookmark->StreamOffset <= Offset) {
         Req = Stream->SendBookmark;
     } else {
-        Req = Stream->SendRequests;
+        IsRetransmission = Stream->SendBookmark != NULL;
+        if (Stream->SendRecoveryBookmark != NULL &&
+            Stream->SendRecoveryBookmark->StreamOffset <= Offset) {
+            Req = Stream->SendRecoveryBookmark;
+        } else {
+            Req = Stream->SendRequests;
+        }
     }
     while (Req->StreamOffset + Req->TotalLength <= Offset) {
         CXPLAT_DBG_ASSERT(Req->Next);
@@ -762,9 +946,14 @@ QuicStreamCopyFromSendRequests(
     }
 
     //
-    // Save the bookmark for later.
+    // Save the bookmark for later. Retransmissions keep their own bookmark so
+    // that they don't pull the new data bookmark back.
     //
-    Stream->SendBookmark = Req;
+    if (IsRetransmission) {
+        Stream->SendRecoveryBookmark = Req;
+    } else {
+        Stream->SendBookmark = Req;
+    }
 }
 
 //
@@ -64,6 +64,18 @@ QuicStreamSetUninitialize(
     if (StreamSet->StreamTable != NULL) {
         CxPlatHashtableUninitialize(StreamSet->StreamTable);
     }
+    if (StreamSet->RecvBatch != NULL) {
+        CXPLAT_DBG_ASSERT(StreamSet->RecvBatch->Count == 0);
+        CXPLAT_FREE(StreamSet->RecvBatch, QUIC_POOL_STREAM_RECV_BATCH);
+    }
+    if (StreamSet->Groups != NULL) {
+        CXPLAT_FREE(StreamSet->Groups, QUIC_POOL_STREAM_GROUP);
+    }
+    for (uint32_t i = 0; i < NUMBER_OF_STREAM_TYPES; ++i) {
+        if (StreamSet->Types[i].Index != NULL) {
+            CXPLAT_FREE(StreamSet->Types[i].Index, QUIC_POOL_STREAM_INDEX);
+        }
+    }
 #if DEBUG
     CxPlatDispatchLockUninitialize(&StreamSet->AllStreamsLock);
 #endif
@@ -89,6 +101,91 @@ QuicStreamSetTraceRundown(
     CxPlatHashtableEnumerateEnd(StreamSet->StreamTable, &Enumerator);
 }
 
+//
+// Grows a type's direct index to (at least) MinSize slots, keeping the
+// streams already in it. Distinct slots stay distinct, since the new size is
+// a multiple of the old one.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+static
+BOOLEAN
+QuicStreamSetGrowIndex(
+    _Inout_ QUIC_STREAM_TYPE_INFO* Info,
+    _In_ uint32_t MinSize
+    )
+{
+    uint32_t NewSize = Info->IndexSize == 0 ? QUIC_STREAM_INDEX_MIN_SIZE : Info->IndexSize;
+    while (NewSize < MinSize && NewSize < QUIC_STREAM_INDEX_MAX_SIZE) {
+        NewSize <<= 1;
+    }
+    if (NewSize == Info->IndexSize) {
+        return FALSE;
+    }
+
+    QUIC_STREAM** NewIndex =
+        CXPLAT_ALLOC_NONPAGED(NewSize * sizeof(QUIC_STREAM*), QUIC_POOL_STREAM_INDEX);
+    if (NewIndex == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "stream index",
+            NewSize * sizeof(QUIC_STREAM*));
+        return FALSE;
+    }
+    CxPlatZeroMemory(NewIndex, NewSize * sizeof(QUIC_STREAM*));
+
+    if (Info->Index != NULL) {
+        for (uint32_t i = 0; i < Info->IndexSize; ++i) {
+            QUIC_STREAM* Stream = Info->Index[i];
+            if (Stream != NULL) {
+                NewIndex[(Stream->ID >> 2) & (NewSize - 1)] = Stream;
+            }
+        }
+        CXPLAT_FREE(Info->Index, QUIC_POOL_STREAM_INDEX);
+    }
+
+    Info->Index = NewIndex;
+    Info->IndexSize = NewSize;
+    return TRUE;
+}
+
+//
+// Adds the stream to its type's direct index, growing the index if its slot is
+// taken. If there's still no room, it's an outlier, only in the hash table.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+static
+void
+QuicStreamSetIndexStream(
+    _Inout_ QUIC_STREAM_SET* StreamSet,
+    _In_ QUIC_STREAM* Stream
+    )
+{
+    QUIC_STREAM_TYPE_INFO* Info = &StreamSet->Types[Stream->ID & STREAM_ID_MASK];
+    const uint64_t StreamCount = Stream->ID >> 2;
+
+    if (Info->IndexSize == 0) {
+        //
+        // Start with enough slots for the peer's whole window (zero for our
+        // own stream types, whose window is set by the peer).
+        //
+        (void)QuicStreamSetGrowIndex(Info, Info->MaxCurrentStreamCount);
+    }
+
+    while (Info->IndexSize != 0) {
+        QUIC_STREAM** Slot = &Info->Index[StreamCount & (Info->IndexSize - 1)];
+        if (*Slot == NULL) {
+            *Slot = Stream;
+            return;
+        }
+        if (!QuicStreamSetGrowIndex(Info, Info->IndexSize << 1)) {
+            break;
+        }
+    }
+
+    Info->IndexOutlierCount++;
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 _Success_(return != FALSE)
 BOOLEAN
@@ -101,7 +198,7 @@ QuicStreamSetInsertStream(
         //
         // Lazily initialize the hash table.
         //
-        if (!CxPlatHashtableInitialize(&StreamSet->StreamTable, CXPLAT_HASH_MIN_SIZE)) {
+        if (!CxPlatHashtableInitializeOpen(&StreamSet->StreamTable, CXPLAT_HASH_MIN_SIZE)) {
             QuicTraceEvent(
                 AllocFailure,
                 "Allocation of '%s' failed. (%llu bytes)",
@@ -110,12 +207,15 @@ QuicStreamSetInsertStream(
             return FALSE;
         }
     }
+    if (!CxPlatHashtableInsert(
+            StreamSet->StreamTable,
+            &Stream->TableEntry,
+            (uint32_t)Stream->ID,
+            NULL)) {
+        return FALSE;
+    }
     Stream->Flags.InStreamTable = TRUE;
-    CxPlatHashtableInsert(
-        StreamSet->StreamTable,
-        &Stream->TableEntry,
-        (uint32_t)Stream->ID,
-        NULL);
+    QuicStreamSetIndexStream(StreamSet, Stream);
     return TRUE;
 }
 
@@ -131,6 +231,17 @@ QuicStreamSetLookupStream(
         return NULL; // No streams have been created yet.
     }
 
+    const QUIC_STREAM_TYPE_INFO* Info = &StreamSet->Types[ID & STREAM_ID_MASK];
+    if (Info->IndexSize != 0) {
+        QUIC_STREAM* Stream = Info->Index[(ID >> 2) & (Info->IndexSize - 1)];
+        if (Stream != NULL && Stream->ID == ID) {
+            return Stream;
+        }
+        if (Info->IndexOutlierCount == 0) {
+            return NULL; // Every stream of this type is in the index.
+        }
+    }
+
     CXPLAT_HASHTABLE_LOOKUP_CONTEXT Context;
     CXPLAT_HASHTABLE_ENTRY* Entry =
         CxPlatHashtableLookup(StreamSet->StreamTable, (uint32_t)ID, &Context);
@@ -170,6 +281,31 @@ QuicStreamSetShutdown(
     CxPlatHashtableEnumerateEnd(StreamSet->StreamTable, &Enumerator);
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+uint32_t
+QuicStreamSetCompactRecvBuffers(
+    _Inout_ QUIC_STREAM_SET* StreamSet
+    )
+{
+    if (StreamSet->StreamTable == NULL) {
+        return 0; // No streams have been created.
+    }
+
+    uint32_t FreedCount = 0;
+    CXPLAT_HASHTABLE_ENUMERATOR Enumerator;
+    CXPLAT_HASHTABLE_ENTRY* Entry;
+    CxPlatHashtableEnumerateBegin(StreamSet->StreamTable, &Enumerator);
+    while ((Entry = CxPlatHashtableEnumerateNext(StreamSet->StreamTable, &Enumerator)) != NULL) {
+        QUIC_STREAM* Stream = CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, TableEntry);
+        if (QuicRecvBufferCompact(&Stream->RecvBuffer)) {
+            FreedCount++;
+        }
+    }
+    CxPlatHashtableEnumerateEnd(StreamSet->StreamTable, &Enumerator);
+
+    return FreedCount;
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicStreamSetReleaseStream(
@@ -191,6 +327,16 @@ QuicStreamSetReleaseStream(
     uint8_t Flags = (uint8_t)(Stream->ID & STREAM_ID_MASK);
     QUIC_STREAM_TYPE_INFO* Info = &StreamSet->Types[Flags];
 
+    QUIC_STREAM** Slot =
+        Info->IndexSize != 0 ?
+            &Info->Index[(Stream->ID >> 2) & (Info->IndexSize - 1)] : NULL;
+    if (Slot != NULL && *Slot == Stream) {
+        *Slot = NULL;
+    } else {
+        CXPLAT_DBG_ASSERT(Info->IndexOutlierCount != 0);
+        Info->IndexOutlierCount--;
+    }
+
     CXPLAT_DBG_ASSERT(Info->CurrentStreamCount != 0);
     Info->CurrentStreamCount--;
 
@@ -202,6 +348,15 @@ QuicStreamSetReleaseStream(
     }
 
     if (Info->CurrentStreamCount < Info->MaxCurrentStreamCount) {
+        if (QuicLibraryGetMemoryPressure() >= QUIC_MEMORY_PRESSURE_CRITICAL) {
+            //
+            // Don't let the peer open new streams while memory is exhausted.
+            // The credit is given back once the pressure eases.
+            //
+            Info->WithheldStreamCount++;
+            return;
+        }
+
         //
         // Since a peer's stream was just closed we should allow the peer to
         // create more streams.
@@ -212,6 +367,33 @@ QuicStreamSetReleaseStream(
             (Flags & STREAM_ID_FLAG_IS_UNI_DIR) ?
                 QUIC_CONN_SEND_FLAG_MAX_STREAMS_UNI :
                 QUIC_CONN_SEND_FLAG_MAX_STREAMS_BIDI);
+        QuicStreamSetGrantWithheldStreams(StreamSet);
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicStreamSetGrantWithheldStreams(
+    _Inout_ QUIC_STREAM_SET* StreamSet
+    )
+{
+    if (QuicLibraryGetMemoryPressure() >= QUIC_MEMORY_PRESSURE_CRITICAL) {
+        return;
+    }
+
+    for (uint8_t Type = 0; Type < NUMBER_OF_STREAM_TYPES; ++Type) {
+        QUIC_STREAM_TYPE_INFO* Info = &StreamSet->Types[Type];
+        if (Info->WithheldStreamCount == 0) {
+            continue;
+        }
+
+        Info->MaxTotalStreamCount += Info->WithheldStreamCount;
+        Info->WithheldStreamCount = 0;
+        QuicSendSetSendFlag(
+            &QuicStreamSetGetConnection(StreamSet)->Send,
+            (Type & STREAM_ID_FLAG_IS_UNI_DIR) ?
+                QUIC_CONN_SEND_FLAG_MAX_STREAMS_UNI :
+                QUIC_CONN_SEND_FLAG_MAX_STREAMS_BIDI);
     }
 }
 
@@ -720,7 +902,8 @@ QuicStreamSetGetStreamForPeer(
                 Stream = NULL; // App accepted but immediately closed the stream.
             } else {
                 CXPLAT_FRE_ASSERTMSG(
-                    Stream->ClientCallbackHandler != NULL,
+                    Stream->ClientCallbackHandler != NULL ||
+                    Connection->Registration->EventQueue != NULL,
                     "App MUST set callback handler!");
                 if (Event.PEER_STREAM_STARTED.Flags & QUIC_STREAM_OPEN_FLAG_DELAY_ID_FC_UPDATES) {
                     Stream->Flags.DelayIdFcUpdate = TRUE;
@@ -729,6 +912,19 @@ QuicStreamSetGetStreamForPeer(
                         Stream,
                         "Configured for delayed ID FC updates");
                 }
+                if (Event.PEER_STREAM_STARTED.Flags & QUIC_STREAM_OPEN_FLAG_APP_OWNED_BUFFERS) {
+                    Status = QuicStreamSwitchToAppOwnedBuffers(Stream);
+                    CXPLAT_DBG_ASSERT(QUIC_SUCCEEDED(Status));
+                } else if (Event.PEER_STREAM_STARTED.Flags & QUIC_STREAM_OPEN_FLAG_COMPRESSED) {
+                    //
+                    // The peer only compresses if it uses the same codec.
+                    //
+                    Stream->Flags.Compressed =
+                        Connection->State.StreamCompressionNegotiated &&
+                        !Stream->Flags.ReceiveMultiple;
+                } else if (Event.PEER_STREAM_STARTED.Flags & QUIC_STREAM_OPEN_FLAG_ZERO_COPY_RECEIVE) {
+                    Stream->Flags.ZeroCopyRecv = !Stream->Flags.ReceiveMultiple;
+                }
             }
 
         } while (Info->TotalStreamCount != StreamCount);
@@ -769,3 +965,267 @@ QuicStreamSetGetMaxStreamIDs(
         MaxStreamIds[i] = (StreamSet->Types[i].MaxTotalStreamCount << 2) | i;
     }
 }
+
+//
+// Copies the group's scheduling parameters to the stream.
+//
+static
+void
+QuicStreamInheritGroup(
+    _Inout_ QUIC_STREAM* Stream,
+    _In_ const QUIC_STREAM_GROUP* Group
+    )
+{
+    Stream->SendPriority = Group->Params.Priority;
+    Stream->SendWeight = Group->Params.Weight;
+    Stream->PriorityUrgency = Group->Params.Urgency;
+    Stream->PriorityIncremental =
+        Group->Params.Scheme == QUIC_STREAM_GROUP_SCHEME_INTERLEAVED;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicStreamSetConfigureGroup(
+    _Inout_ QUIC_STREAM_SET* StreamSet,
+    _In_ const QUIC_STREAM_GROUP_PARAMETERS* Params
+    )
+{
+    if (Params->GroupId == 0 || Params->GroupId > QUIC_STREAM_GROUP_MAX ||
+        Params->Urgency > QUIC_STREAM_PRIORITY_URGENCY_MAX ||
+        (uint32_t)Params->Scheme > QUIC_STREAM_GROUP_SCHEME_INTERLEAVED) {
+        return QUIC_STATUS_INVALID_PARAMETER;
+    }
+
+    if (StreamSet->Groups == NULL) {
+        StreamSet->Groups =
+            CXPLAT_ALLOC_NONPAGED(
+                QUIC_STREAM_GROUP_MAX * sizeof(QUIC_STREAM_GROUP),
+                QUIC_POOL_STREAM_GROUP);
+        if (StreamSet->Groups == NULL) {
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "stream groups",
+                QUIC_STREAM_GROUP_MAX * sizeof(QUIC_STREAM_GROUP));
+            return QUIC_STATUS_OUT_OF_MEMORY;
+        }
+        for (uint32_t i = 0; i < QUIC_STREAM_GROUP_MAX; ++i) {
+            StreamSet->Groups[i].Params.GroupId = 0;
+            CxPlatListInitializeHead(&StreamSet->Groups[i].Streams);
+        }
+    }
+
+    QUIC_STREAM_GROUP* Group = &StreamSet->Groups[Params->GroupId - 1];
+    Group->Params = *Params;
+
+    for (CXPLAT_LIST_ENTRY* Entry = Group->Streams.Flink;
+         Entry != &Group->Streams;
+         Entry = Entry->Flink) {
+        QuicStreamInheritGroup(
+            CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, GroupLink), Group);
+    }
+
+    //
+    // Requeue all the group's queued streams in one pass.
+    //
+    QuicSendUpdateStreamGroupPriority(
+        &QuicStreamSetGetConnection(StreamSet)->Send,
+        &Group->Streams);
+
+    return QUIC_STATUS_SUCCESS;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicStreamSetJoinGroup(
+    _Inout_ QUIC_STREAM_SET* StreamSet,
+    _In_ QUIC_STREAM* Stream,
+    _In_ uint16_t GroupId
+    )
+{
+    QUIC_STREAM_GROUP* Group = NULL;
+    if (GroupId != 0) {
+        if (GroupId > QUIC_STREAM_GROUP_MAX) {
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
+        if (StreamSet->Groups == NULL ||
+            StreamSet->Groups[GroupId - 1].Params.GroupId == 0) {
+            return QUIC_STATUS_INVALID_STATE; // Not configured yet.
+        }
+        Group = &StreamSet->Groups[GroupId - 1];
+    }
+
+    if (Stream->GroupId == GroupId) {
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    if (Stream->GroupId != 0) {
+        CxPlatListEntryRemove(&Stream->GroupLink);
+    }
+    Stream->GroupId = (uint8_t)GroupId;
+
+    if (Group != NULL) {
+        CxPlatListInsertTail(&Group->Streams, &Stream->GroupLink);
+        QuicStreamInheritGroup(Stream, Group);
+        if (Stream->Flags.Started && Stream->SendFlags != 0) {
+            QuicSendUpdateStreamPriority(
+                &QuicStreamSetGetConnection(StreamSet)->Send, Stream);
+        }
+    }
+
+    return QUIC_STATUS_SUCCESS;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicStreamSetSetBatchReceiveEnabled(
+    _Inout_ QUIC_STREAM_SET* StreamSet,
+    _In_ BOOLEAN Enabled
+    )
+{
+    if (!Enabled) {
+        if (StreamSet->RecvBatch != NULL) {
+            CXPLAT_DBG_ASSERT(StreamSet->RecvBatch->Count == 0);
+            CXPLAT_FREE(StreamSet->RecvBatch, QUIC_POOL_STREAM_RECV_BATCH);
+            StreamSet->RecvBatch = NULL;
+        }
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    if (StreamSet->RecvBatch == NULL) {
+        StreamSet->RecvBatch =
+            CXPLAT_ALLOC_NONPAGED(
+                sizeof(QUIC_STREAM_RECV_BATCH),
+                QUIC_POOL_STREAM_RECV_BATCH);
+        if (StreamSet->RecvBatch == NULL) {
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "stream receive batch",
+                sizeof(QUIC_STREAM_RECV_BATCH));
+            return QUIC_STATUS_OUT_OF_MEMORY;
+        }
+        StreamSet->RecvBatch->Count = 0;
+    }
+
+    return QUIC_STATUS_SUCCESS;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+QuicStreamSetQueueReceiveBatch(
+    _Inout_ QUIC_STREAM_SET* StreamSet,
+    _In_ QUIC_STREAM* Stream
+    )
+{
+    QUIC_STREAM_RECV_BATCH* Batch = StreamSet->RecvBatch;
+    if (Batch == NULL || !Stream->Flags.ReceiveEnabled) {
+        //
+        // Streams with receives disabled are flushed directly once the app
+        // enables them again.
+        //
+        return FALSE;
+    }
+
+    if (!Stream->Flags.ReceiveBatchQueued) {
+        //
+        // The batch holds a ref on the stream until it has been indicated,
+        // same as a queued receive flush operation.
+        //
+        Stream->Flags.ReceiveBatchQueued = TRUE;
+        QuicStreamAddRef(Stream, QUIC_STREAM_REF_OPERATION);
+        Batch->Streams[Batch->Count] = Stream;
+        if (++Batch->Count == QUIC_MAX_STREAM_RECEIVE_BATCH_COUNT) {
+            QuicStreamSetIndicateReceiveBatch(StreamSet);
+        }
+    }
+
+    return TRUE;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicStreamSetIndicateReceiveBatch(
+    _Inout_ QUIC_STREAM_SET* StreamSet
+    )
+{
+    QUIC_STREAM_RECV_BATCH* Batch = StreamSet->RecvBatch;
+    if (Batch == NULL) {
+        return;
+    }
+
+    QUIC_CONNECTION* Connection = QuicStreamSetGetConnection(StreamSet);
+
+    while (Batch->Count != 0) {
+
+        uint32_t EntryCount = 0;
+        for (uint32_t i = 0; i < Batch->Count; ++i) {
+            QUIC_STREAM* Stream = Batch->Streams[i];
+            Stream->Flags.ReceiveBatchQueued = FALSE;
+
+            QUIC_STREAM_EVENT Event;
+            if (!QuicStreamRecvPrepareIndication(
+                    Stream, &Event, Batch->Buffers[EntryCount])) {
+                //
+                // Already delivered by a direct flush, or the app disabled
+                // or aborted the receive path since the stream was queued.
+                //
+                QuicStreamRelease(Stream, QUIC_STREAM_REF_OPERATION);
+                continue;
+            }
+
+            QuicTraceEvent(
+                StreamAppReceive,
+                "[strm][%p] Indicating QUIC_STREAM_EVENT_RECEIVE [%llu bytes, %u buffers, 0x%x flags]",
+                Stream,
+                Event.RECEIVE.TotalBufferLength,
+                Event.RECEIVE.BufferCount,
+                Event.RECEIVE.Flags);
+
+            QUIC_STREAM_RECEIVE_BATCH_ENTRY* Entry = &Batch->Entries[EntryCount++];
+            Entry->Stream = (HQUIC)Stream;
+            Entry->StreamContext = Stream->ClientContext;
+            Entry->AbsoluteOffset = Event.RECEIVE.AbsoluteOffset;
+            Entry->TotalBufferLength = Event.RECEIVE.TotalBufferLength;
+            Entry->Buffers = Event.RECEIVE.Buffers;
+            Entry->BufferCount = Event.RECEIVE.BufferCount;
+            Entry->Flags = Event.RECEIVE.Flags;
+            Entry->Status = QUIC_STATUS_SUCCESS;
+        }
+        Batch->Count = 0;
+
+        if (EntryCount == 0) {
+            break;
+        }
+
+        QUIC_CONNECTION_EVENT Event;
+        Event.Type = QUIC_CONNECTION_EVENT_STREAM_BATCH_RECEIVED;
+        Event.STREAM_BATCH_RECEIVED.StreamCount = EntryCount;
+        Event.STREAM_BATCH_RECEIVED.Streams = Batch->Entries;
+
+        QuicTraceLogConnVerbose(
+            IndicateStreamBatchReceived,
+            Connection,
+            "Indicating STREAM_BATCH_RECEIVED [count=%u]",
+            EntryCount);
+        (void)QuicConnIndicateEvent(Connection, &Event);
+
+        //
+        // Complete each stream's indication, as if the status had been
+        // returned from its own receive callback. Streams with more to
+        // indicate right away go back in the batch (keeping their ref) for
+        // another round.
+        //
+        for (uint32_t i = 0; i < EntryCount; ++i) {
+            QUIC_STREAM_RECEIVE_BATCH_ENTRY* Entry = &Batch->Entries[i];
+            QUIC_STREAM* Stream = (QUIC_STREAM*)Entry->Stream;
+            if (QuicStreamRecvCompleteIndication(
+                    Stream, Entry->Status, Entry->TotalBufferLength)) {
+                Stream->Flags.ReceiveBatchQueued = TRUE;
+                Batch->Streams[Batch->Count++] = Stream;
+            } else {
+                QuicStreamRelease(Stream, QUIC_STREAM_REF_OPERATION);
+            }
+        }
+    }
+}
@@ -32,8 +32,48 @@ typedef struct QUIC_STREAM_TYPE_INFO {
     //
     uint16_t CurrentStreamCount;
 
+    //
+    // The number of closed peer streams whose replacement credit has not been
+    // given to the peer yet, because of critical memory pressure.
+    //
+    uint16_t WithheldStreamCount;
+
+    //
+    // Direct index of this type's streams in the hash table, by stream count
+    // (ID >> 2) modulo IndexSize. Stream IDs are allocated sequentially and
+    // the open ones fall within the flow control window, so they almost
+    // always map to distinct slots. A stream whose slot is already taken is
+    // only found via the hash table, and counted as an outlier.
+    //
+    QUIC_STREAM** Index;
+    uint32_t IndexSize; // Power of 2, or zero if not allocated yet.
+    uint32_t IndexOutlierCount;
+
 } QUIC_STREAM_TYPE_INFO;
 
+//
+// Streams with newly readable data waiting to be indicated together to the
+// app. The entries and buffers are only used while indicating the batch.
+//
+typedef struct QUIC_STREAM_RECV_BATCH {
+
+    uint32_t Count;
+    QUIC_STREAM* Streams[QUIC_MAX_STREAM_RECEIVE_BATCH_COUNT];
+    QUIC_STREAM_RECEIVE_BATCH_ENTRY Entries[QUIC_MAX_STREAM_RECEIVE_BATCH_COUNT];
+    QUIC_BUFFER Buffers[QUIC_MAX_STREAM_RECEIVE_BATCH_COUNT][QUIC_STREAM_RECV_INDICATION_BUFFERS];
+
+} QUIC_STREAM_RECV_BATCH;
+
+//
+// A group of streams sharing the same scheduling parameters.
+//
+typedef struct QUIC_STREAM_GROUP {
+
+    QUIC_STREAM_GROUP_PARAMETERS Params; // GroupId is zero if not configured.
+    CXPLAT_LIST_ENTRY Streams;
+
+} QUIC_STREAM_GROUP;
+
 typedef struct QUIC_STREAM_SET {
 
     //
@@ -51,6 +91,19 @@ typedef struct QUIC_STREAM_SET {
     //
     CXPLAT_LIST_ENTRY ClosedStreams;
 
+    //
+    // Streams queued for a batched receive indication, if enabled. Like the
+    // datagram receive batch, it's indicated before the received packets are
+    // returned to the datapath.
+    //
+    QUIC_STREAM_RECV_BATCH* RecvBatch;
+
+    //
+    // The stream groups, indexed by group ID - 1. Allocated when the first
+    // group is configured.
+    //
+    QUIC_STREAM_GROUP* Groups;
+
 #if DEBUG
     //
     // The list of allocated streams for leak tracking.
@@ -97,6 +150,26 @@ QuicStreamSetShutdown(
     _Inout_ QUIC_STREAM_SET* StreamSet
     );
 
+//
+// Frees the receive buffers of all streams that currently hold no received
+// data. Returns the number of buffers freed.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+uint32_t
+QuicStreamSetCompactRecvBuffers(
+    _Inout_ QUIC_STREAM_SET* StreamSet
+    );
+
+//
+// Gives the peer any stream credit withheld because of memory pressure, if the
+// pressure has eased since.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicStreamSetGrantWithheldStreams(
+    _Inout_ QUIC_STREAM_SET* StreamSet
+    );
+
 //
 // Called to inform the stream set that the stream is ready to be cleaned up.
 // The stream set queued the stream for later deletion.
@@ -211,3 +284,58 @@ QuicStreamSetGetMaxStreamIDs(
     _Out_writes_all_(NUMBER_OF_STREAM_TYPES)
         uint64_t* MaxStreamIds
     );
+
+//
+// Creates or updates a stream group, updating the scheduling parameters of all
+// its streams at once.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicStreamSetConfigureGroup(
+    _Inout_ QUIC_STREAM_SET* StreamSet,
+    _In_ const QUIC_STREAM_GROUP_PARAMETERS* Params
+    );
+
+//
+// Moves the stream into a configured group (or out of any group, if GroupId is
+// zero). A stream leaving a group keeps the parameters it inherited.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicStreamSetJoinGroup(
+    _Inout_ QUIC_STREAM_SET* StreamSet,
+    _In_ QUIC_STREAM* Stream,
+    _In_ uint16_t GroupId
+    );
+
+//
+// Enables or disables batching of stream receive indications into a single
+// QUIC_CONNECTION_EVENT_STREAM_BATCH_RECEIVED event.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicStreamSetSetBatchReceiveEnabled(
+    _Inout_ QUIC_STREAM_SET* StreamSet,
+    _In_ BOOLEAN Enabled
+    );
+
+//
+// Queues a stream with newly readable data for the next batched receive
+// indication. Returns FALSE if batching isn't enabled.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+QuicStreamSetQueueReceiveBatch(
+    _Inout_ QUIC_STREAM_SET* StreamSet,
+    _In_ QUIC_STREAM* Stream
+    );
+
+//
+// Indicates all the queued streams to the app in a single batched receive
+// event, if there are any.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicStreamSetIndicateReceiveBatch(
+    _Inout_ QUIC_STREAM_SET* StreamSet
+    );
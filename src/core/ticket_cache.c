@@ -0,0 +1,249 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Library-wide cache of client resumption tickets, used by connections with
+    ResumptionTicketCacheEnabled set.
+
+    The cache has a fixed number of sets, each with a fixed number of entries
+    (ways) and its own lock. Each entry holds the most recent ticket received
+    for a server name and configuration. When a set is full, the oldest ticket
+    in it is replaced.
+
+--*/
+
+#include "precomp.h"
+#ifdef QUIC_CLOG
+#include "ticket_cache.c.clog.h"
+#endif
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicTicketCacheInitialize(
+    _Out_ QUIC_TICKET_CACHE* Cache
+    )
+{
+    CxPlatZeroMemory(Cache, sizeof(*Cache));
+    for (uint32_t i = 0; i < QUIC_TICKET_CACHE_SETS; ++i) {
+        CxPlatDispatchLockInitialize(&Cache->Sets[i].Lock);
+    }
+}
+
+static
+void
+QuicTicketCacheEntryClear(
+    _Inout_ QUIC_TICKET_CACHE_ENTRY* Entry
+    )
+{
+    if (Entry->Buffer != NULL) {
+        CXPLAT_FREE(Entry->Buffer, QUIC_POOL_TICKET_CACHE);
+    }
+    CxPlatZeroMemory(Entry, sizeof(*Entry));
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicTicketCacheUninitialize(
+    _In_ QUIC_TICKET_CACHE* Cache
+    )
+{
+    for (uint32_t i = 0; i < QUIC_TICKET_CACHE_SETS; ++i) {
+        for (uint32_t j = 0; j < QUIC_TICKET_CACHE_WAYS; ++j) {
+            QuicTicketCacheEntryClear(&Cache->Sets[i].Entries[j]);
+        }
+        CxPlatDispatchLockUninitialize(&Cache->Sets[i].Lock);
+    }
+}
+
+static
+QUIC_TICKET_CACHE_SET*
+QuicTicketCacheGetSet(
+    _In_ QUIC_TICKET_CACHE* Cache,
+    _In_ uint16_t ServerNameLength,
+    _In_reads_(ServerNameLength)
+        const char* ServerName
+    )
+{
+    return
+        &Cache->Sets[
+            CxPlatHashSimple(ServerNameLength, (const uint8_t*)ServerName) %
+            QUIC_TICKET_CACHE_SETS];
+}
+
+static
+BOOLEAN
+QuicTicketCacheEntryMatches(
+    _In_ const QUIC_TICKET_CACHE_ENTRY* Entry,
+    _In_ const QUIC_CONFIGURATION* Configuration,
+    _In_ uint16_t ServerNameLength,
+    _In_reads_(ServerNameLength)
+        const char* ServerName
+    )
+{
+    return
+        Entry->TimeUs != 0 &&
+        Entry->Configuration == Configuration &&
+        Entry->ServerNameLength == ServerNameLength &&
+        memcmp(Entry->Buffer + Entry->TicketLength, ServerName, ServerNameLength) == 0;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicTicketCacheInsert(
+    _In_ QUIC_TICKET_CACHE* Cache,
+    _In_ const QUIC_CONFIGURATION* Configuration,
+    _In_z_ const char* ServerName,
+    _In_ uint16_t TicketLength,
+    _In_reads_bytes_(TicketLength)
+        const uint8_t* Ticket
+    )
+{
+    const size_t ServerNameLength = strnlen(ServerName, QUIC_MAX_SNI_LENGTH + 1);
+    if (ServerNameLength == 0 || ServerNameLength > QUIC_MAX_SNI_LENGTH ||
+        TicketLength == 0 || TicketLength > QUIC_TICKET_CACHE_MAX_TICKET_LENGTH) {
+        return;
+    }
+
+    //
+    // Copy the ticket before taking the lock.
+    //
+    uint8_t* Buffer =
+        CXPLAT_ALLOC_NONPAGED(
+            TicketLength + ServerNameLength + 1,
+            QUIC_POOL_TICKET_CACHE);
+    if (Buffer == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "cached resumption ticket",
+            TicketLength + ServerNameLength + 1);
+        return;
+    }
+    CxPlatCopyMemory(Buffer, Ticket, TicketLength);
+    CxPlatCopyMemory(Buffer + TicketLength, ServerName, ServerNameLength + 1);
+
+    QUIC_TICKET_CACHE_SET* Set =
+        QuicTicketCacheGetSet(Cache, (uint16_t)ServerNameLength, ServerName);
+    uint8_t* OldBuffer;
+
+    CxPlatDispatchLockAcquire(&Set->Lock);
+
+    //
+    // Replace the existing ticket for the server, or else the oldest one in
+    // the set.
+    //
+    QUIC_TICKET_CACHE_ENTRY* Entry = &Set->Entries[0];
+    for (uint32_t i = 0; i < QUIC_TICKET_CACHE_WAYS; ++i) {
+        if (QuicTicketCacheEntryMatches(
+                &Set->Entries[i],
+                Configuration,
+                (uint16_t)ServerNameLength,
+                ServerName)) {
+            Entry = &Set->Entries[i];
+            break;
+        }
+        if (Set->Entries[i].TimeUs < Entry->TimeUs) {
+            Entry = &Set->Entries[i];
+        }
+    }
+
+    OldBuffer = Entry->Buffer;
+    Entry->Configuration = Configuration;
+    Entry->TimeUs = CxPlatTimeUs64();
+    Entry->Buffer = Buffer;
+    Entry->TicketLength = TicketLength;
+    Entry->ServerNameLength = (uint16_t)ServerNameLength;
+
+    CxPlatDispatchLockRelease(&Set->Lock);
+
+    if (OldBuffer != NULL) {
+        CXPLAT_FREE(OldBuffer, QUIC_POOL_TICKET_CACHE);
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Success_(return != FALSE)
+BOOLEAN
+QuicTicketCacheTake(
+    _In_ QUIC_TICKET_CACHE* Cache,
+    _In_ const QUIC_CONFIGURATION* Configuration,
+    _In_z_ const char* ServerName,
+    _Outptr_result_buffer_(*TicketLength)
+        uint8_t** Ticket,
+    _Out_ uint16_t* TicketLength
+    )
+{
+    const size_t ServerNameLength = strnlen(ServerName, QUIC_MAX_SNI_LENGTH + 1);
+    if (ServerNameLength == 0 || ServerNameLength > QUIC_MAX_SNI_LENGTH) {
+        return FALSE;
+    }
+
+    QUIC_TICKET_CACHE_SET* Set =
+        QuicTicketCacheGetSet(Cache, (uint16_t)ServerNameLength, ServerName);
+    const uint64_t TimeNow = CxPlatTimeUs64();
+    uint8_t* Buffer = NULL;
+    uint16_t Length = 0;
+    BOOLEAN Expired = FALSE;
+
+    CxPlatDispatchLockAcquire(&Set->Lock);
+    for (uint32_t i = 0; i < QUIC_TICKET_CACHE_WAYS; ++i) {
+        QUIC_TICKET_CACHE_ENTRY* Entry = &Set->Entries[i];
+        if (QuicTicketCacheEntryMatches(
+                Entry,
+                Configuration,
+                (uint16_t)ServerNameLength,
+                ServerName)) {
+            Expired =
+                CxPlatTimeDiff64(Entry->TimeUs, TimeNow) >= QUIC_TICKET_CACHE_TIMEOUT;
+            Buffer = Entry->Buffer;
+            Length = Entry->TicketLength;
+            CxPlatZeroMemory(Entry, sizeof(*Entry));
+            break;
+        }
+    }
+    CxPlatDispatchLockRelease(&Set->Lock);
+
+    if (Buffer == NULL) {
+        return FALSE;
+    }
+
+    if (Expired) {
+        CXPLAT_FREE(Buffer, QUIC_POOL_TICKET_CACHE);
+        return FALSE;
+    }
+
+    *Ticket = Buffer;
+    *TicketLength = Length;
+    return TRUE;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicTicketCacheFreeTicket(
+    _In_ uint8_t* Ticket
+    )
+{
+    CXPLAT_FREE(Ticket, QUIC_POOL_TICKET_CACHE);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicTicketCachePurge(
+    _In_ QUIC_TICKET_CACHE* Cache,
+    _In_ const QUIC_CONFIGURATION* Configuration
+    )
+{
+    for (uint32_t i = 0; i < QUIC_TICKET_CACHE_SETS; ++i) {
+        QUIC_TICKET_CACHE_SET* Set = &Cache->Sets[i];
+        CxPlatDispatchLockAcquire(&Set->Lock);
+        for (uint32_t j = 0; j < QUIC_TICKET_CACHE_WAYS; ++j) {
+            if (Set->Entries[j].Configuration == Configuration) {
+                QuicTicketCacheEntryClear(&Set->Entries[j]);
+            }
+        }
+        CxPlatDispatchLockRelease(&Set->Lock);
+    }
+}
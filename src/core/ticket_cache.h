@@ -0,0 +1,120 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+--*/
+
+#pragma once
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+typedef struct QUIC_TICKET_CACHE_ENTRY {
+
+    //
+    // The configuration the connection that received the ticket was started
+    // with. Only connections started with the same configuration (and so the
+    // same ALPN list and credentials) can use the ticket.
+    //
+    const QUIC_CONFIGURATION* Configuration;
+
+    //
+    // The time the ticket was cached. Zero if the entry is empty.
+    //
+    uint64_t TimeUs;
+
+    //
+    // The ticket, followed by the null terminated server name.
+    //
+    uint8_t* Buffer;
+    uint16_t TicketLength;
+    uint16_t ServerNameLength;
+
+} QUIC_TICKET_CACHE_ENTRY;
+
+typedef struct QUIC_CACHEALIGN QUIC_TICKET_CACHE_SET {
+
+    CXPLAT_DISPATCH_LOCK Lock;
+    QUIC_TICKET_CACHE_ENTRY Entries[QUIC_TICKET_CACHE_WAYS];
+
+} QUIC_TICKET_CACHE_SET;
+
+//
+// A bounded cache of client resumption tickets, keyed by server name and
+// configuration, shared by all connections so that reconnects resume without
+// the app having to store and set tickets itself. Like the path metrics cache,
+// it is split into independently locked sets, indexed by a hash of the server
+// name, so that connections on different workers rarely contend.
+//
+typedef struct QUIC_TICKET_CACHE {
+
+    QUIC_TICKET_CACHE_SET Sets[QUIC_TICKET_CACHE_SETS];
+
+} QUIC_TICKET_CACHE;
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicTicketCacheInitialize(
+    _Out_ QUIC_TICKET_CACHE* Cache
+    );
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicTicketCacheUninitialize(
+    _In_ QUIC_TICKET_CACHE* Cache
+    );
+
+//
+// Caches a copy of a ticket for the server name and configuration, replacing
+// any ticket already cached for them.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicTicketCacheInsert(
+    _In_ QUIC_TICKET_CACHE* Cache,
+    _In_ const QUIC_CONFIGURATION* Configuration,
+    _In_z_ const char* ServerName,
+    _In_ uint16_t TicketLength,
+    _In_reads_bytes_(TicketLength)
+        const uint8_t* Ticket
+    );
+
+//
+// Removes the ticket cached for the server name and configuration, if there
+// is one that has not expired, and returns it. Tickets are single use, so the
+// same ticket is never returned twice. The caller frees the returned buffer
+// with QuicTicketCacheFreeTicket.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Success_(return != FALSE)
+BOOLEAN
+QuicTicketCacheTake(
+    _In_ QUIC_TICKET_CACHE* Cache,
+    _In_ const QUIC_CONFIGURATION* Configuration,
+    _In_z_ const char* ServerName,
+    _Outptr_result_buffer_(*TicketLength)
+        uint8_t** Ticket,
+    _Out_ uint16_t* TicketLength
+    );
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicTicketCacheFreeTicket(
+    _In_ uint8_t* Ticket
+    );
+
+//
+// Drops all the tickets cached for a configuration that is being freed.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicTicketCachePurge(
+    _In_ QUIC_TICKET_CACHE* Cache,
+    _In_ const QUIC_CONFIGURATION* Configuration
+    );
+
+#if defined(__cplusplus)
+}
+#endif
@@ -21,27 +21,38 @@ Abstract:
         The timer wheel itself doesn't care about anything other than that value
         from the connection.
 
-        Slots - This is a very simple hash table of time slots. Each slot holds
-        all connections with a next expiration time modulo the total slot count.
+        Levels - The timer wheel is hierarchical. Level 0 has a slot per tick
+        (about a millisecond) for the next 64 ticks. Each slot of level 1 spans
+        64 ticks, each slot of level 2 spans 64 level 1 slots, and so on. A
+        connection is placed in the lowest level that can hold its expiration
+        time, relative to the wheel's current tick.
 
-        Slot Entry - Each slot is made up of a sorted, doubly-linked list of
-        connections.
+        Slot Entry - Each slot is made up of an unsorted, doubly-linked list of
+        connections. A bitmap per level tracks which slots are non-empty.
 
         Next Expiration - Along with all the connections in the timer wheel, the
         timer wheel also explicitly keeps track of the next expiration time and
         connection for quick next delay calculations.
 
-    With these parts, the timer wheel is able to support insertion, update and
-    removal of any number of timers (and their associated connection).
-
     Insertion or update consists of getting the next expiration time from the
-    connection, calculating the correct slot and then doing an insert into the
-    slot's sorted list of connections. Additionally, the next expiration is
-    updated if the new timer is the soonest to expire.
-
-    Removal consists of removing the connection from the doubly-linked list and
-    updating the timer wheel's next expiration if this connection was currently
-    next to expire.
+    connection, calculating the level and slot, and appending the connection to
+    the slot's list. Removal consists of removing the connection from the
+    doubly-linked list. Both are constant time. The next expiration is updated
+    if the connection is (or was) the soonest to expire, which only then needs
+    a search of the first non-empty slot of each level.
+
+    As the current tick advances, whenever it crosses into the span of a new
+    slot on a higher level, the connections in that slot are cascaded down to
+    the lower levels, until they end up in level 0 and expire. Empty stretches
+    of the wheel are skipped over entirely.
+
+    Paced sends are far more frequent than any other timer, and don't need
+    exact ordering, so they are tracked separately by the worker's pacing wheel
+    instead. The pacing wheel is a calendar queue of fixed width slots, each
+    holding an unsorted list of the connections due at that time. Insertion
+    and removal are constant time, and all the connections in a slot are
+    released together, so the worker wakes up once per slot, instead of once
+    per paced connection.
 
 --*/
 
@@ -51,20 +62,40 @@ Abstract:
 #endif
 
 //
-// The initial count of slots in the timer wheel.
+// Helpers to get the shift (in ticks) of a level's slots, and the index of the
+// slot a tick falls in for a level.
 //
-#define QUIC_TIMER_WHEEL_INITIAL_SLOT_COUNT     32
+#define LEVEL_TICK_SHIFT(Level) ((Level) * QUIC_TIMER_WHEEL_LEVEL_SHIFT)
+#define TICK_TO_SLOT_INDEX(Tick, Level) \
+    ((uint32_t)((Tick) >> LEVEL_TICK_SHIFT(Level)) & (QUIC_TIMER_WHEEL_SLOT_COUNT - 1))
 
 //
-// On average, the max number of connections per slot.
-//
-#define QUIC_TIMER_WHEEL_MAX_LOAD_FACTOR    32
-
+// Returns the index of the first non-empty slot at, or after, Start (wrapping
+// around). The bitmap must not be empty.
 //
-// Helper to get the slot index for a given time.
-//
-#define TIME_TO_SLOT_INDEX(TimerWheel, TimeUs) \
-    ((US_TO_MS(TimeUs) / 1000) % (TimerWheel)->SlotCount)
+_IRQL_requires_max_(PASSIVE_LEVEL)
+uint32_t
+QuicTimerWheelFindSlot(
+    _In_ uint64_t OccupiedSlots,
+    _In_ uint32_t Start
+    )
+{
+    CXPLAT_DBG_ASSERT(OccupiedSlots != 0);
+    const uint64_t Rotated =
+        Start == 0 ?
+            OccupiedSlots :
+            (OccupiedSlots >> Start) | (OccupiedSlots << (QUIC_TIMER_WHEEL_SLOT_COUNT - Start));
+#ifdef _MSC_VER
+    unsigned long Index;
+    if (!_BitScanForward(&Index, (unsigned long)Rotated)) {
+        _BitScanForward(&Index, (unsigned long)(Rotated >> 32));
+        Index += 32;
+    }
+#else
+    const uint32_t Index = (uint32_t)__builtin_ctzll(Rotated);
+#endif
+    return (Start + (uint32_t)Index) & (QUIC_TIMER_WHEEL_SLOT_COUNT - 1);
+}
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
 QUIC_STATUS
@@ -75,19 +106,12 @@ QuicTimerWheelInitialize(
     TimerWheel->NextExpirationTime = UINT64_MAX;
     TimerWheel->ConnectionCount = 0;
     TimerWheel->NextConnection = NULL;
-    TimerWheel->SlotCount = QUIC_TIMER_WHEEL_INITIAL_SLOT_COUNT;
-    TimerWheel->Slots =
-        CXPLAT_ALLOC_NONPAGED(QUIC_TIMER_WHEEL_INITIAL_SLOT_COUNT * sizeof(CXPLAT_LIST_ENTRY), QUIC_POOL_TIMERWHEEL);
-    if (TimerWheel->Slots == NULL) {
-        QuicTraceEvent(
-            AllocFailure,
-            "Allocation of '%s' failed. (%llu bytes)", "timerwheel slots",
-            QUIC_TIMER_WHEEL_INITIAL_SLOT_COUNT * sizeof(CXPLAT_LIST_ENTRY));
-        return QUIC_STATUS_OUT_OF_MEMORY;
-    }
-
-    for (uint32_t i = 0; i < TimerWheel->SlotCount; ++i) {
-        CxPlatListInitializeHead(&TimerWheel->Slots[i]);
+    TimerWheel->CurrentTick = CxPlatTimeUs64() >> QUIC_TIMER_WHEEL_TICK_SHIFT;
+    for (uint32_t i = 0; i < QUIC_TIMER_WHEEL_LEVEL_COUNT; ++i) {
+        TimerWheel->OccupiedSlots[i] = 0;
+        for (uint32_t j = 0; j < QUIC_TIMER_WHEEL_SLOT_COUNT; ++j) {
+            CxPlatListInitializeHead(&TimerWheel->Slots[i][j]);
+        }
     }
 
     return QUIC_STATUS_SUCCESS;
@@ -99,9 +123,9 @@ QuicTimerWheelUninitialize(
     _Inout_ QUIC_TIMER_WHEEL* TimerWheel
     )
 {
-    if (TimerWheel->Slots != NULL) {
-        for (uint32_t i = 0; i < TimerWheel->SlotCount; ++i) {
-            CXPLAT_LIST_ENTRY* ListHead = &TimerWheel->Slots[i];
+    for (uint32_t i = 0; i < QUIC_TIMER_WHEEL_LEVEL_COUNT; ++i) {
+        for (uint32_t j = 0; j < QUIC_TIMER_WHEEL_SLOT_COUNT; ++j) {
+            CXPLAT_LIST_ENTRY* ListHead = &TimerWheel->Slots[i][j];
             CXPLAT_LIST_ENTRY* Entry = ListHead->Flink;
             while (Entry != ListHead) {
                 QUIC_CONNECTION* Connection =
@@ -113,98 +137,72 @@ QuicTimerWheelUninitialize(
                 CXPLAT_DBG_ASSERT(!Connection);
                 Entry = Entry->Flink;
             }
-            CXPLAT_TEL_ASSERT(CxPlatListIsEmpty(&TimerWheel->Slots[i]));
+            CXPLAT_TEL_ASSERT(CxPlatListIsEmpty(ListHead));
         }
-        CXPLAT_TEL_ASSERT(TimerWheel->ConnectionCount == 0);
-        CXPLAT_TEL_ASSERT(TimerWheel->NextConnection == NULL);
-        CXPLAT_TEL_ASSERT(TimerWheel->NextExpirationTime == UINT64_MAX);
-
-        CXPLAT_FREE(TimerWheel->Slots, QUIC_POOL_TIMERWHEEL);
     }
+    CXPLAT_TEL_ASSERT(TimerWheel->ConnectionCount == 0);
+    CXPLAT_TEL_ASSERT(TimerWheel->NextConnection == NULL);
+    CXPLAT_TEL_ASSERT(TimerWheel->NextExpirationTime == UINT64_MAX);
 }
 
+//
+// Places the connection in the slot for its expiration time, relative to the
+// current tick.
+//
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
-QuicTimerWheelResize(
-    _Inout_ QUIC_TIMER_WHEEL* TimerWheel
+QuicTimerWheelInsert(
+    _Inout_ QUIC_TIMER_WHEEL* TimerWheel,
+    _Inout_ QUIC_CONNECTION* Connection
     )
 {
-    uint32_t NewSlotCount = TimerWheel->SlotCount * 2;
-    if (NewSlotCount <= TimerWheel->SlotCount) {
-        //
-        // Max size has been reached.
-        //
-        return;
-    }
-
-    CXPLAT_LIST_ENTRY* NewSlots =
-        CXPLAT_ALLOC_NONPAGED(NewSlotCount * sizeof(CXPLAT_LIST_ENTRY), QUIC_POOL_TIMERWHEEL);
-    if (NewSlots == NULL) {
-        QuicTraceEvent(
-            AllocFailure,
-            "Allocation of '%s' failed. (%llu bytes)", "timerwheel slots (realloc)",
-            NewSlotCount * sizeof(CXPLAT_LIST_ENTRY));
-        return;
+    uint64_t Tick = Connection->EarliestExpirationTime >> QUIC_TIMER_WHEEL_TICK_SHIFT;
+    if (Tick < TimerWheel->CurrentTick) {
+        Tick = TimerWheel->CurrentTick; // Already due.
     }
 
-    QuicTraceLogVerbose(
-        TimerWheelResize,
-        "[time][%p] Resizing timer wheel (new slot count = %u).",
-        TimerWheel,
-        NewSlotCount);
-
-    for (uint32_t i = 0; i < NewSlotCount; ++i) {
-        CxPlatListInitializeHead(&NewSlots[i]);
+    uint32_t Level = 0;
+    const uint64_t Delta = Tick - TimerWheel->CurrentTick;
+    while (Delta >> LEVEL_TICK_SHIFT(Level + 1) != 0) {
+        if (++Level == QUIC_TIMER_WHEEL_LEVEL_COUNT - 1) {
+            if (Delta >> LEVEL_TICK_SHIFT(QUIC_TIMER_WHEEL_LEVEL_COUNT) != 0) {
+                //
+                // Beyond the span of the whole wheel. Park it in the last slot
+                // and it will be placed again when that slot is cascaded.
+                //
+                Tick =
+                    TimerWheel->CurrentTick +
+                    (1ull << LEVEL_TICK_SHIFT(QUIC_TIMER_WHEEL_LEVEL_COUNT)) - 1;
+            }
+            break;
+        }
     }
 
-    uint32_t OldSlotCount = TimerWheel->SlotCount;
-    CXPLAT_LIST_ENTRY* OldSlots = TimerWheel->Slots;
-
-    TimerWheel->SlotCount = NewSlotCount;
-    TimerWheel->Slots = NewSlots;
+    const uint32_t Index = TICK_TO_SLOT_INDEX(Tick, Level);
+    CxPlatListInsertTail(&TimerWheel->Slots[Level][Index], &Connection->TimerLink);
+    TimerWheel->OccupiedSlots[Level] |= 1ull << Index;
+}
 
-    for (uint32_t i = 0; i < OldSlotCount; ++i) {
+//
+// Removes the connection from its slot.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicTimerWheelUnlink(
+    _Inout_ QUIC_TIMER_WHEEL* TimerWheel,
+    _Inout_ QUIC_CONNECTION* Connection
+    )
+{
+    CXPLAT_LIST_ENTRY* Next = Connection->TimerLink.Flink;
+    if (CxPlatListEntryRemove(&Connection->TimerLink)) {
         //
-        // Iterate through each old slot, remove all connections and add them
-        // to the new slots.
+        // The slot is now empty, so Next was the slot's list head.
         //
-        while (!CxPlatListIsEmpty(&OldSlots[i])) {
-            QUIC_CONNECTION* Connection =
-                CXPLAT_CONTAINING_RECORD(
-                    CxPlatListRemoveHead(&OldSlots[i]),
-                    QUIC_CONNECTION,
-                    TimerLink);
-            uint64_t ExpirationTime = Connection->EarliestExpirationTime;
-            CXPLAT_DBG_ASSERT(TimerWheel->SlotCount != 0);
-            uint32_t SlotIndex = TIME_TO_SLOT_INDEX(TimerWheel, ExpirationTime);
-
-            //
-            // Insert the connection into the slot, in the correct order. We search
-            // the slot's list in reverse order, with the assumption that most new
-            // timers will on average be later than existing ones.
-            //
-            CXPLAT_LIST_ENTRY* ListHead = &TimerWheel->Slots[SlotIndex];
-            CXPLAT_LIST_ENTRY* Entry = ListHead->Blink;
-
-            while (Entry != ListHead) {
-                QUIC_CONNECTION* ConnectionEntry =
-                    CXPLAT_CONTAINING_RECORD(Entry, QUIC_CONNECTION, TimerLink);
-                uint64_t EntryExpirationTime = ConnectionEntry->EarliestExpirationTime;
-
-                if (ExpirationTime > EntryExpirationTime) {
-                    break;
-                }
-
-                Entry = Entry->Blink;
-            }
-
-            //
-            // Insert after the current entry.
-            //
-            CxPlatListInsertHead(Entry, &Connection->TimerLink);
-        }
+        const size_t Index = (size_t)(Next - &TimerWheel->Slots[0][0]);
+        CXPLAT_DBG_ASSERT(Index < QUIC_TIMER_WHEEL_LEVEL_COUNT * QUIC_TIMER_WHEEL_SLOT_COUNT);
+        TimerWheel->OccupiedSlots[Index / QUIC_TIMER_WHEEL_SLOT_COUNT] &=
+            ~(1ull << (Index % QUIC_TIMER_WHEEL_SLOT_COUNT));
     }
-    CXPLAT_FREE(OldSlots, QUIC_POOL_TIMERWHEEL);
 }
 
 //
@@ -221,19 +219,35 @@ QuicTimerWheelUpdate(
     TimerWheel->NextConnection = NULL;
 
     //
-    // Loop over the slots to find the connection with the earliest
-    // expiration time.
+    // The earliest connection of each level is in that level's first non-empty
+    // slot, after the current one (except for level 0, where the current slot
+    // is the earliest). A level is skipped if that slot starts after the
+    // earliest expiration found so far.
     //
-    for (uint32_t i = 0; i < TimerWheel->SlotCount; ++i) {
-        if (!CxPlatListIsEmpty(&TimerWheel->Slots[i])) {
+    for (uint32_t Level = 0; Level < QUIC_TIMER_WHEEL_LEVEL_COUNT; ++Level) {
+        if (TimerWheel->OccupiedSlots[Level] == 0) {
+            continue;
+        }
+
+        const uint64_t LevelTick = TimerWheel->CurrentTick >> LEVEL_TICK_SHIFT(Level);
+        const uint32_t Start = TICK_TO_SLOT_INDEX(TimerWheel->CurrentTick, Level) + (Level == 0 ? 0 : 1);
+        const uint32_t Index =
+            QuicTimerWheelFindSlot(
+                TimerWheel->OccupiedSlots[Level],
+                Start & (QUIC_TIMER_WHEEL_SLOT_COUNT - 1));
+        const uint64_t SlotStartTime =
+            (LevelTick + ((Index - Start) & (QUIC_TIMER_WHEEL_SLOT_COUNT - 1)) + (Level == 0 ? 0 : 1))
+                << (LEVEL_TICK_SHIFT(Level) + QUIC_TIMER_WHEEL_TICK_SHIFT);
+        if (Level != 0 && SlotStartTime >= TimerWheel->NextExpirationTime) {
+            continue;
+        }
+
+        CXPLAT_LIST_ENTRY* ListHead = &TimerWheel->Slots[Level][Index];
+        for (CXPLAT_LIST_ENTRY* Entry = ListHead->Flink; Entry != ListHead; Entry = Entry->Flink) {
             QUIC_CONNECTION* ConnectionEntry =
-                CXPLAT_CONTAINING_RECORD(
-                    TimerWheel->Slots[i].Flink,
-                    QUIC_CONNECTION,
-                    TimerLink);
-            uint64_t EntryExpirationTime = ConnectionEntry->EarliestExpirationTime;
-            if (EntryExpirationTime < TimerWheel->NextExpirationTime) {
-                TimerWheel->NextExpirationTime = EntryExpirationTime;
+                CXPLAT_CONTAINING_RECORD(Entry, QUIC_CONNECTION, TimerLink);
+            if (ConnectionEntry->EarliestExpirationTime < TimerWheel->NextExpirationTime) {
+                TimerWheel->NextExpirationTime = ConnectionEntry->EarliestExpirationTime;
                 TimerWheel->NextConnection = ConnectionEntry;
             }
         }
@@ -271,7 +285,7 @@ QuicTimerWheelRemoveConnection(
             "[time][%p] Removing Connection %p.",
             TimerWheel,
             Connection);
-        CxPlatListEntryRemove(&Connection->TimerLink);
+        QuicTimerWheelUnlink(TimerWheel, Connection);
         Connection->TimerLink.Flink = NULL;
         TimerWheel->ConnectionCount--;
 
@@ -296,7 +310,7 @@ QuicTimerWheelUpdateConnection(
         //
         // Connection is already in the timer wheel, so remove it first.
         //
-        CxPlatListEntryRemove(&Connection->TimerLink);
+        QuicTimerWheelUnlink(TimerWheel, Connection);
 
         if (ExpirationTime == UINT64_MAX || Connection->State.ShutdownComplete) {
             //
@@ -321,8 +335,12 @@ QuicTimerWheelUpdateConnection(
     } else if (ExpirationTime != UINT64_MAX && !Connection->State.ShutdownComplete) {
         //
         // It wasn't in the wheel already, so we must be adding it to the wheel.
+        // If the wheel was empty, its current tick may be far behind, so
+        // restart it from the current time.
         //
-        TimerWheel->ConnectionCount++;
+        if (TimerWheel->ConnectionCount++ == 0) {
+            TimerWheel->CurrentTick = CxPlatTimeUs64() >> QUIC_TIMER_WHEEL_TICK_SHIFT;
+        }
         QuicConnAddRef(Connection, QUIC_CONN_REF_TIMER_WHEEL);
 
     } else {
@@ -335,33 +353,7 @@ QuicTimerWheelUpdateConnection(
 
     CXPLAT_DBG_ASSERT(ExpirationTime != UINT64_MAX);
     CXPLAT_DBG_ASSERT(!Connection->State.ShutdownComplete);
-    CXPLAT_DBG_ASSERT(TimerWheel->SlotCount != 0);
-    uint32_t SlotIndex = TIME_TO_SLOT_INDEX(TimerWheel, ExpirationTime);
-
-    //
-    // Insert the connection into the slot, in the correct order. We search
-    // the slot's list in reverse order, with the assumption that most new
-    // timers will on average be later than existing ones.
-    //
-    CXPLAT_LIST_ENTRY* ListHead = &TimerWheel->Slots[SlotIndex];
-    CXPLAT_LIST_ENTRY* Entry = ListHead->Blink;
-
-    while (Entry != ListHead) {
-        QUIC_CONNECTION* ConnectionEntry =
-            CXPLAT_CONTAINING_RECORD(Entry, QUIC_CONNECTION, TimerLink);
-        uint64_t EntryExpirationTime = ConnectionEntry->EarliestExpirationTime;
-
-        if (ExpirationTime > EntryExpirationTime) {
-            break;
-        }
-
-        Entry = Entry->Blink;
-    }
-
-    //
-    // Insert after the current entry.
-    //
-    CxPlatListInsertHead(Entry, &Connection->TimerLink);
+    QuicTimerWheelInsert(TimerWheel, Connection);
 
     QuicTraceLogVerbose(
         TimerWheelUpdateConnection,
@@ -384,15 +376,78 @@ QuicTimerWheelUpdateConnection(
     } else if (Connection == TimerWheel->NextConnection) {
         QuicTimerWheelUpdate(TimerWheel);
     }
+}
 
-    //
-    // Resize the timer wheel if we have too many connections for the
-    // current size.
-    //
-    if (TimerWheel->ConnectionCount >
-        TimerWheel->SlotCount * QUIC_TIMER_WHEEL_MAX_LOAD_FACTOR) {
-        QuicTimerWheelResize(TimerWheel);
+//
+// Moves the connections in the slots of the higher levels that start at the
+// (new) current tick down to the lower levels.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicTimerWheelCascade(
+    _Inout_ QUIC_TIMER_WHEEL* TimerWheel
+    )
+{
+    for (uint32_t Level = 1; Level < QUIC_TIMER_WHEEL_LEVEL_COUNT; ++Level) {
+        if ((TimerWheel->CurrentTick & ((1ull << LEVEL_TICK_SHIFT(Level)) - 1)) != 0) {
+            break; // Not at the start of a slot on this (or any higher) level.
+        }
+
+        const uint32_t Index = TICK_TO_SLOT_INDEX(TimerWheel->CurrentTick, Level);
+        if (TimerWheel->OccupiedSlots[Level] & (1ull << Index)) {
+            CXPLAT_LIST_ENTRY Cascaded;
+            CxPlatListInitializeHead(&Cascaded);
+            CxPlatListMoveItems(&TimerWheel->Slots[Level][Index], &Cascaded);
+            TimerWheel->OccupiedSlots[Level] &= ~(1ull << Index);
+            while (!CxPlatListIsEmpty(&Cascaded)) {
+                QUIC_CONNECTION* Connection =
+                    CXPLAT_CONTAINING_RECORD(
+                        CxPlatListRemoveHead(&Cascaded),
+                        QUIC_CONNECTION,
+                        TimerLink);
+                QuicTimerWheelInsert(TimerWheel, Connection);
+            }
+        }
+    }
+}
+
+//
+// Moves all the connections in the current level 0 slot that have expired to
+// the output list. Returns TRUE if NextConnection was one of them.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+QuicTimerWheelExpireSlot(
+    _Inout_ QUIC_TIMER_WHEEL* TimerWheel,
+    _In_ uint64_t TimeNow,
+    _Inout_ CXPLAT_LIST_ENTRY* OutputListHead
+    )
+{
+    const uint32_t Index = TICK_TO_SLOT_INDEX(TimerWheel->CurrentTick, 0);
+    if (!(TimerWheel->OccupiedSlots[0] & (1ull << Index))) {
+        return FALSE;
     }
+
+    BOOLEAN NeedsUpdate = FALSE;
+    CXPLAT_LIST_ENTRY* ListHead = &TimerWheel->Slots[0][Index];
+    CXPLAT_LIST_ENTRY* Entry = ListHead->Flink;
+    while (Entry != ListHead) {
+        QUIC_CONNECTION* ConnectionEntry =
+            CXPLAT_CONTAINING_RECORD(Entry, QUIC_CONNECTION, TimerLink);
+        Entry = Entry->Flink;
+        if (ConnectionEntry->EarliestExpirationTime > TimeNow) {
+            continue;
+        }
+        QuicTimerWheelUnlink(TimerWheel, ConnectionEntry);
+        CxPlatListInsertTail(OutputListHead, &ConnectionEntry->TimerLink);
+        if (ConnectionEntry == TimerWheel->NextConnection) {
+            NeedsUpdate = TRUE;
+        }
+        QuicConnAddRef(ConnectionEntry, QUIC_CONN_REF_WORKER);
+        QuicConnRelease(ConnectionEntry, QUIC_CONN_REF_TIMER_WHEEL);
+        TimerWheel->ConnectionCount--;
+    }
+    return NeedsUpdate;
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -404,32 +459,205 @@ QuicTimerWheelGetExpired(
     )
 {
     //
-    // Iterate through every slot to find all the connections that now have
-    // expired timers.
+    // Advance the current tick up to the current time, expiring the level 0
+    // slots on the way and cascading the higher levels' slots as their time
+    // comes. Stretches with nothing to expire or cascade are skipped.
     //
-    BOOLEAN NeedsUpdate = FALSE;
-    for (uint32_t i = 0; i < TimerWheel->SlotCount; ++i) {
-        CXPLAT_LIST_ENTRY* ListHead = &TimerWheel->Slots[i];
-        CXPLAT_LIST_ENTRY* Entry = ListHead->Flink;
-        while (Entry != ListHead) {
-            QUIC_CONNECTION* ConnectionEntry =
-                CXPLAT_CONTAINING_RECORD(Entry, QUIC_CONNECTION, TimerLink);
-            uint64_t EntryExpirationTime = ConnectionEntry->EarliestExpirationTime;
-            if (EntryExpirationTime > TimeNow) {
+    const uint64_t NowTick = TimeNow >> QUIC_TIMER_WHEEL_TICK_SHIFT;
+    BOOLEAN NeedsUpdate = QuicTimerWheelExpireSlot(TimerWheel, TimeNow, OutputListHead);
+    while (TimerWheel->CurrentTick < NowTick && TimerWheel->ConnectionCount != 0) {
+        uint64_t NextTick = NowTick;
+        if (TimerWheel->OccupiedSlots[0] != 0) {
+            const uint32_t Current = TICK_TO_SLOT_INDEX(TimerWheel->CurrentTick, 0);
+            const uint32_t Index =
+                QuicTimerWheelFindSlot(
+                    TimerWheel->OccupiedSlots[0],
+                    (Current + 1) & (QUIC_TIMER_WHEEL_SLOT_COUNT - 1));
+            const uint64_t Distance = ((Index - Current - 1) & (QUIC_TIMER_WHEEL_SLOT_COUNT - 1)) + 1;
+            NextTick = CXPLAT_MIN(NextTick, TimerWheel->CurrentTick + Distance);
+        }
+        for (uint32_t Level = 1; Level < QUIC_TIMER_WHEEL_LEVEL_COUNT; ++Level) {
+            if (TimerWheel->OccupiedSlots[Level] != 0) {
+                const uint64_t SlotStart =
+                    ((TimerWheel->CurrentTick >> LEVEL_TICK_SHIFT(Level)) + 1) << LEVEL_TICK_SHIFT(Level);
+                NextTick = CXPLAT_MIN(NextTick, SlotStart);
                 break;
             }
-            Entry = Entry->Flink;
-            CxPlatListEntryRemove(&ConnectionEntry->TimerLink);
-            CxPlatListInsertTail(OutputListHead, &ConnectionEntry->TimerLink);
-            if (ConnectionEntry == TimerWheel->NextConnection) {
-                NeedsUpdate = TRUE;
-            }
-            QuicConnAddRef(ConnectionEntry, QUIC_CONN_REF_WORKER);
-            QuicConnRelease(ConnectionEntry, QUIC_CONN_REF_TIMER_WHEEL);
-            TimerWheel->ConnectionCount--;
         }
+
+        TimerWheel->CurrentTick = NextTick;
+        QuicTimerWheelCascade(TimerWheel);
+        NeedsUpdate |= QuicTimerWheelExpireSlot(TimerWheel, TimeNow, OutputListHead);
+    }
+    if (TimerWheel->ConnectionCount == 0 && TimerWheel->CurrentTick < NowTick) {
+        TimerWheel->CurrentTick = NowTick;
     }
     if (NeedsUpdate) {
         QuicTimerWheelUpdate(TimerWheel);
     }
 }
+
+//
+// Helper to get the pacing wheel slot for a given slot time.
+//
+#define PACING_TIME_TO_SLOT(PacingWheel, SlotTime) \
+    (&(PacingWheel)->Slots[(SlotTime) % QUIC_PACING_WHEEL_SLOT_COUNT])
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicPacingWheelInitialize(
+    _Inout_ QUIC_PACING_WHEEL* PacingWheel
+    )
+{
+    PacingWheel->NextExpirationTime = UINT64_MAX;
+    PacingWheel->ConnectionCount = 0;
+    PacingWheel->CurrentSlotTime = 0;
+    for (uint32_t i = 0; i < QUIC_PACING_WHEEL_SLOT_COUNT; ++i) {
+        CxPlatListInitializeHead(&PacingWheel->Slots[i]);
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicPacingWheelUninitialize(
+    _Inout_ QUIC_PACING_WHEEL* PacingWheel
+    )
+{
+    UNREFERENCED_PARAMETER(PacingWheel);
+    for (uint32_t i = 0; i < QUIC_PACING_WHEEL_SLOT_COUNT; ++i) {
+        CXPLAT_TEL_ASSERT(CxPlatListIsEmpty(&PacingWheel->Slots[i]));
+    }
+    CXPLAT_TEL_ASSERT(PacingWheel->ConnectionCount == 0);
+}
+
+//
+// Called to update NextExpirationTime after slots have expired.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicPacingWheelUpdate(
+    _Inout_ QUIC_PACING_WHEEL* PacingWheel
+    )
+{
+    PacingWheel->NextExpirationTime = UINT64_MAX;
+    if (PacingWheel->ConnectionCount == 0) {
+        return;
+    }
+
+    for (uint64_t SlotTime = PacingWheel->CurrentSlotTime;
+         SlotTime < PacingWheel->CurrentSlotTime + QUIC_PACING_WHEEL_SLOT_COUNT;
+         ++SlotTime) {
+        if (!CxPlatListIsEmpty(PACING_TIME_TO_SLOT(PacingWheel, SlotTime))) {
+            PacingWheel->NextExpirationTime = SlotTime * QUIC_PACING_WHEEL_SLOT_US;
+            break;
+        }
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicPacingWheelRemoveConnection(
+    _Inout_ QUIC_PACING_WHEEL* PacingWheel,
+    _Inout_ QUIC_CONNECTION* Connection
+    )
+{
+    if (Connection->PacingLink.Flink != NULL) {
+        //
+        // The next expiration time is left alone (possibly early) instead of
+        // searching for the next non-empty slot on every removal.
+        //
+        CxPlatListEntryRemove(&Connection->PacingLink);
+        Connection->PacingLink.Flink = NULL;
+        if (--PacingWheel->ConnectionCount == 0) {
+            PacingWheel->NextExpirationTime = UINT64_MAX;
+        }
+        QuicConnRelease(Connection, QUIC_CONN_REF_PACING_WHEEL);
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicPacingWheelUpdateConnection(
+    _Inout_ QUIC_PACING_WHEEL* PacingWheel,
+    _Inout_ QUIC_CONNECTION* Connection,
+    _In_ uint64_t TimeNow
+    )
+{
+    const uint64_t ExpirationTime = Connection->PacingExpirationTime;
+
+    if (ExpirationTime == UINT64_MAX || Connection->State.ShutdownComplete) {
+        QuicPacingWheelRemoveConnection(PacingWheel, Connection);
+        return;
+    }
+
+    if (Connection->PacingLink.Flink != NULL) {
+        //
+        // Connection is already in the pacing wheel, so remove it first.
+        //
+        CxPlatListEntryRemove(&Connection->PacingLink);
+
+    } else {
+        //
+        // It wasn't in the wheel already, so we must be adding it to the wheel.
+        // If the wheel was empty, restart it from the current time.
+        //
+        if (PacingWheel->ConnectionCount++ == 0) {
+            PacingWheel->CurrentSlotTime = TimeNow / QUIC_PACING_WHEEL_SLOT_US;
+        }
+        QuicConnAddRef(Connection, QUIC_CONN_REF_PACING_WHEEL);
+    }
+
+    //
+    // Round up so the send is never released early, but keep it within the
+    // span of slots the wheel currently covers.
+    //
+    uint64_t SlotTime =
+        (ExpirationTime + QUIC_PACING_WHEEL_SLOT_US - 1) / QUIC_PACING_WHEEL_SLOT_US;
+    if (SlotTime < PacingWheel->CurrentSlotTime) {
+        SlotTime = PacingWheel->CurrentSlotTime;
+    } else if (SlotTime >= PacingWheel->CurrentSlotTime + QUIC_PACING_WHEEL_SLOT_COUNT) {
+        SlotTime = PacingWheel->CurrentSlotTime + QUIC_PACING_WHEEL_SLOT_COUNT - 1;
+    }
+
+    CxPlatListInsertTail(
+        PACING_TIME_TO_SLOT(PacingWheel, SlotTime),
+        &Connection->PacingLink);
+
+    if (SlotTime * QUIC_PACING_WHEEL_SLOT_US < PacingWheel->NextExpirationTime) {
+        PacingWheel->NextExpirationTime = SlotTime * QUIC_PACING_WHEEL_SLOT_US;
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicPacingWheelGetExpired(
+    _Inout_ QUIC_PACING_WHEEL* PacingWheel,
+    _In_ uint64_t TimeNow,
+    _Inout_ CXPLAT_LIST_ENTRY* OutputListHead
+    )
+{
+    //
+    // Drain every slot, in order, up to the current time. Every connection in
+    // the wheel is within one revolution of CurrentSlotTime, so this stops
+    // after at most one revolution once the wheel is empty.
+    //
+    const uint64_t NowSlotTime = TimeNow / QUIC_PACING_WHEEL_SLOT_US;
+    while (PacingWheel->ConnectionCount != 0 &&
+           PacingWheel->CurrentSlotTime <= NowSlotTime) {
+        CXPLAT_LIST_ENTRY* ListHead =
+            PACING_TIME_TO_SLOT(PacingWheel, PacingWheel->CurrentSlotTime);
+        while (!CxPlatListIsEmpty(ListHead)) {
+            QUIC_CONNECTION* ConnectionEntry =
+                CXPLAT_CONTAINING_RECORD(
+                    CxPlatListRemoveHead(ListHead),
+                    QUIC_CONNECTION,
+                    PacingLink);
+            CxPlatListInsertTail(OutputListHead, &ConnectionEntry->PacingLink);
+            QuicConnAddRef(ConnectionEntry, QUIC_CONN_REF_WORKER);
+            QuicConnRelease(ConnectionEntry, QUIC_CONN_REF_PACING_WHEEL);
+            PacingWheel->ConnectionCount--;
+        }
+        PacingWheel->CurrentSlotTime++;
+    }
+    QuicPacingWheelUpdate(PacingWheel);
+}
@@ -5,8 +5,26 @@
 
 --*/
 
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
 typedef struct QUIC_CONNECTION QUIC_CONNECTION;
 
+//
+// The width of a tick (the finest granularity) of the timer wheel, as a shift
+// of microseconds. 1 << 10 us is about 1 ms.
+//
+#define QUIC_TIMER_WHEEL_TICK_SHIFT         10
+
+//
+// The timer wheel is made up of several levels, each with the same number of
+// slots. Each slot of a level spans all the slots of the level below it.
+//
+#define QUIC_TIMER_WHEEL_LEVEL_SHIFT        6
+#define QUIC_TIMER_WHEEL_SLOT_COUNT         (1 << QUIC_TIMER_WHEEL_LEVEL_SHIFT)
+#define QUIC_TIMER_WHEEL_LEVEL_COUNT        4
+
 typedef struct QUIC_TIMER_WHEEL {
 
     //
@@ -25,14 +43,21 @@ typedef struct QUIC_TIMER_WHEEL {
     QUIC_CONNECTION* NextConnection;
 
     //
-    // The number of slots in the Slots array.
+    // The time (in ticks) up to which the timer wheel has been processed. The
+    // slot a connection is placed in is relative to it.
     //
-    uint32_t SlotCount;
+    uint64_t CurrentTick;
 
     //
-    // An array of slots in the timer wheel.
+    // For each level, a bit per slot that is set if the slot is non-empty.
     //
-    CXPLAT_LIST_ENTRY* Slots;
+    uint64_t OccupiedSlots[QUIC_TIMER_WHEEL_LEVEL_COUNT];
+
+    //
+    // Each slot holds an unsorted list of the connections expiring in that
+    // slot's span of time.
+    //
+    CXPLAT_LIST_ENTRY Slots[QUIC_TIMER_WHEEL_LEVEL_COUNT][QUIC_TIMER_WHEEL_SLOT_COUNT];
 
 } QUIC_TIMER_WHEEL;
 
@@ -85,3 +110,95 @@ QuicTimerWheelGetExpired(
     _In_ uint64_t TimeNow,
     _Inout_ CXPLAT_LIST_ENTRY* ListHead
     );
+
+//
+// The width (in us) of each slot in the pacing wheel.
+//
+#define QUIC_PACING_WHEEL_SLOT_US           100
+
+//
+// The number of slots in the pacing wheel, which bounds how far in the future
+// a paced send can be scheduled (slot count * slot width).
+//
+#define QUIC_PACING_WHEEL_SLOT_COUNT        256
+
+typedef struct QUIC_PACING_WHEEL {
+
+    //
+    // The time (in us) the next non-empty slot expires, or UINT64_MAX if the
+    // pacing wheel is empty. May be earlier than the actual next expiration.
+    //
+    uint64_t NextExpirationTime;
+
+    //
+    // Total number of connections in the pacing wheel.
+    //
+    uint64_t ConnectionCount;
+
+    //
+    // The time (in slot widths) of the next slot to expire.
+    //
+    uint64_t CurrentSlotTime;
+
+    //
+    // Each slot holds an unsorted list of all connections with a pacing send
+    // due at that slot's time.
+    //
+    CXPLAT_LIST_ENTRY Slots[QUIC_PACING_WHEEL_SLOT_COUNT];
+
+} QUIC_PACING_WHEEL;
+
+//
+// Initializes the pacing wheel's internal structure.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicPacingWheelInitialize(
+    _Inout_ QUIC_PACING_WHEEL* PacingWheel
+    );
+
+//
+// Cleans up the pacing wheel.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicPacingWheelUninitialize(
+    _Inout_ QUIC_PACING_WHEEL* PacingWheel
+    );
+
+//
+// Removes the connection from the pacing wheel.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicPacingWheelRemoveConnection(
+    _Inout_ QUIC_PACING_WHEEL* PacingWheel,
+    _Inout_ QUIC_CONNECTION* Connection
+    );
+
+//
+// Inserts, removes, or moves the connection in the pacing wheel. Called
+// when the connection's pacing expiration time changes.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicPacingWheelUpdateConnection(
+    _Inout_ QUIC_PACING_WHEEL* PacingWheel,
+    _Inout_ QUIC_CONNECTION* Connection,
+    _In_ uint64_t TimeNow
+    );
+
+//
+// Gets all the connections with an expired pacing send.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicPacingWheelGetExpired(
+    _Inout_ QUIC_PACING_WHEEL* PacingWheel,
+    _In_ uint64_t TimeNow,
+    _Inout_ CXPLAT_LIST_ENTRY* ListHead
+    );
+
+#if defined(__cplusplus)
+}
+#endif
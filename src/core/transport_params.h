@@ -115,6 +115,12 @@ typedef struct QUIC_TRANSPORT_PARAMETERS {
     QUIC_VAR_INT CibirLength;
     QUIC_VAR_INT CibirOffset;
 
+    //
+    // The stream compression codec (QUIC_PARAM_CONN_STREAM_COMPRESSION) the
+    // endpoint uses.
+    //
+    QUIC_VAR_INT StreamCompressionCodecId;
+
     //
     // Server specific.
     //
@@ -125,9 +131,15 @@ typedef struct QUIC_TRANSPORT_PARAMETERS {
     uint8_t StatelessResetToken[QUIC_STATELESS_RESET_TOKEN_LENGTH];
 
     //
-    // The server's preferred address.
+    // The server's preferred addresses (unspecified family if not present), the
+    // CID to use with them and that CID's stateless reset token.
     //
-    QUIC_ADDR PreferredAddress;
+    QUIC_ADDR PreferredAddressIpv4;
+    QUIC_ADDR PreferredAddressIpv6;
+    _Field_range_(1, QUIC_MAX_CONNECTION_ID_LENGTH_V1)
+    uint8_t PreferredAddressCidLength;
+    uint8_t PreferredAddressCid[QUIC_MAX_CONNECTION_ID_LENGTH_V1];
+    uint8_t PreferredAddressResetToken[QUIC_STATELESS_RESET_TOKEN_LENGTH];
 
     //
     // The value of the Destination Connection ID field from the first Initial
@@ -168,6 +180,65 @@ QuicCryptoTlsEncodeTransportParameters(
     _Out_ uint32_t* TPLen
     );
 
+//
+// The transport parameters that are unique to each connection: the CIDs and
+// the stateless reset tokens derived from them.
+//
+#define QUIC_TP_FLAGS_PER_CONNECTION \
+    (QUIC_TP_FLAG_ORIGINAL_DESTINATION_CONNECTION_ID | \
+     QUIC_TP_FLAG_INITIAL_SOURCE_CONNECTION_ID | \
+     QUIC_TP_FLAG_RETRY_SOURCE_CONNECTION_ID | \
+     QUIC_TP_FLAG_STATELESS_RESET_TOKEN | \
+     QUIC_TP_FLAG_PREFERRED_ADDRESS)
+
+//
+// Caches the encoding of the server transport parameters shared by all of a
+// configuration's connections (everything but QUIC_TP_FLAGS_PER_CONNECTION),
+// so the handshake only encodes the per-connection ones and appends the rest.
+//
+typedef struct QUIC_TP_CACHE {
+
+    CXPLAT_DISPATCH_LOCK Lock;
+
+    //
+    // The shared parameters Buffer was encoded from. VersionInfo is owned.
+    //
+    QUIC_TRANSPORT_PARAMETERS Key;
+
+    //
+    // The encoded shared parameters, after a CxPlatTlsTPHeaderSize prefix.
+    //
+    const uint8_t* Buffer;
+    uint16_t Length;
+
+} QUIC_TP_CACHE;
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicTpCacheInitialize(
+    _Out_ QUIC_TP_CACHE* Cache
+    );
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicTpCacheUninitialize(
+    _In_ QUIC_TP_CACHE* Cache
+    );
+
+//
+// Same as QuicCryptoTlsEncodeTransportParameters for server TPs, but reuses
+// the cached encoding of the shared parameters when they haven't changed.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Success_(return != NULL)
+const uint8_t*
+QuicCryptoTlsEncodeServerTransportParametersCached(
+    _In_opt_ QUIC_CONNECTION* Connection,
+    _In_ QUIC_TP_CACHE* Cache,
+    _In_ const QUIC_TRANSPORT_PARAMETERS *TransportParams,
+    _Out_ uint32_t* TPLen
+    );
+
 //
 // Decodes QUIC TP buffer.
 //
@@ -0,0 +1,103 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test for the 0-RTT anti-replay filter.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "AntiReplayTest.cpp.clog.h"
+#endif
+
+struct AntiReplayTest : public ::testing::Test
+{
+    QUIC_ANTI_REPLAY* AntiReplay {nullptr};
+
+    void SetUp() override {
+        AntiReplay = new(std::nothrow) QUIC_ANTI_REPLAY;
+        ASSERT_NE(nullptr, AntiReplay);
+        QuicAntiReplayInitialize(AntiReplay);
+    }
+
+    void TearDown() override {
+        if (AntiReplay != nullptr) {
+            QuicAntiReplayUninitialize(AntiReplay);
+            delete AntiReplay;
+        }
+    }
+
+    void Enable(uint32_t WindowMs, uint32_t MaxEntries = 1000) {
+        QUIC_ZERO_RTT_ANTI_REPLAY Config = { WindowMs, MaxEntries };
+        ASSERT_EQ(QUIC_STATUS_SUCCESS, QuicAntiReplaySetConfig(AntiReplay, &Config));
+    }
+
+    static void MakeRandom(uint32_t Index, uint8_t* ClientRandom) {
+        for (uint32_t i = 0; i < QUIC_CLIENT_RANDOM_LENGTH; ++i) {
+            ClientRandom[i] = (uint8_t)(Index * 31 + i * 7 + (Index >> (i % 24)));
+        }
+    }
+};
+
+TEST_F(AntiReplayTest, DisabledAcceptsAll)
+{
+    uint8_t ClientRandom[QUIC_CLIENT_RANDOM_LENGTH];
+    MakeRandom(1, ClientRandom);
+    ASSERT_TRUE(QuicAntiReplayCheck(AntiReplay, ClientRandom));
+    ASSERT_TRUE(QuicAntiReplayCheck(AntiReplay, ClientRandom));
+}
+
+TEST_F(AntiReplayTest, InvalidConfig)
+{
+    QUIC_ZERO_RTT_ANTI_REPLAY Config = { 1000, 0 };
+    ASSERT_EQ(QUIC_STATUS_INVALID_PARAMETER, QuicAntiReplaySetConfig(AntiReplay, &Config));
+    Config.MaxEntries = QUIC_ZERO_RTT_ANTI_REPLAY_MAX_ENTRIES + 1;
+    ASSERT_EQ(QUIC_STATUS_INVALID_PARAMETER, QuicAntiReplaySetConfig(AntiReplay, &Config));
+}
+
+TEST_F(AntiReplayTest, ReplayRejected)
+{
+    Enable(60000);
+    uint8_t ClientRandom[QUIC_CLIENT_RANDOM_LENGTH];
+    MakeRandom(1, ClientRandom);
+    ASSERT_TRUE(QuicAntiReplayCheck(AntiReplay, ClientRandom));
+    ASSERT_FALSE(QuicAntiReplayCheck(AntiReplay, ClientRandom));
+}
+
+TEST_F(AntiReplayTest, DistinctRandomsAccepted)
+{
+    Enable(60000);
+    uint8_t ClientRandom[QUIC_CLIENT_RANDOM_LENGTH];
+    uint32_t Rejected = 0;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        MakeRandom(i, ClientRandom);
+        if (!QuicAntiReplayCheck(AntiReplay, ClientRandom)) {
+            ++Rejected;
+        }
+    }
+    ASSERT_LE(Rejected, 10u); // Bloom filter false positives.
+}
+
+TEST_F(AntiReplayTest, ForgottenAfterTwoWindows)
+{
+    Enable(20);
+    uint8_t ClientRandom[QUIC_CLIENT_RANDOM_LENGTH];
+    MakeRandom(1, ClientRandom);
+    ASSERT_TRUE(QuicAntiReplayCheck(AntiReplay, ClientRandom));
+    CxPlatSleep(50);
+    ASSERT_TRUE(QuicAntiReplayCheck(AntiReplay, ClientRandom));
+}
+
+TEST_F(AntiReplayTest, ResetByConfig)
+{
+    Enable(60000);
+    uint8_t ClientRandom[QUIC_CLIENT_RANDOM_LENGTH];
+    MakeRandom(1, ClientRandom);
+    ASSERT_TRUE(QuicAntiReplayCheck(AntiReplay, ClientRandom));
+    Enable(60000);
+    ASSERT_TRUE(QuicAntiReplayCheck(AntiReplay, ClientRandom));
+}
@@ -0,0 +1,146 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test for the worker packet capture buffer.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "CaptureTest.cpp.clog.h"
+#endif
+
+#include <vector>
+
+static
+void
+QUIC_API
+CaptureTestHandler(
+    _In_opt_ void* Context,
+    _In_reads_bytes_(Length) const uint8_t* Data,
+    _In_ uint32_t Length
+    )
+{
+    auto Output = (std::vector<uint8_t>*)Context;
+    Output->insert(Output->end(), Data, Data + Length);
+}
+
+static
+uint32_t
+Read32(
+    const std::vector<uint8_t>& Output,
+    size_t Offset
+    )
+{
+    uint32_t Value;
+    memcpy(&Value, Output.data() + Offset, sizeof(Value));
+    return Value;
+}
+
+struct CaptureTest : public ::testing::Test
+{
+    QUIC_CAPTURE_BUFFER Buffer;
+    QUIC_PACKET_CAPTURE_CONFIG OriginalConfig;
+    std::vector<uint8_t> Output;
+    QUIC_ADDR Local;
+    QUIC_ADDR Remote;
+
+    void SetUp() override {
+        CxPlatZeroMemory(&Buffer, sizeof(Buffer));
+        OriginalConfig = MsQuicLib.PacketCapture;
+        MsQuicLib.PacketCapture.Handler = CaptureTestHandler;
+        MsQuicLib.PacketCapture.Context = &Output;
+        MsQuicLib.PacketCapture.SampleRate = 0;
+        ASSERT_TRUE(QuicAddrFromString("10.0.0.1", 4433, &Local));
+        ASSERT_TRUE(QuicAddrFromString("10.0.0.2", 5555, &Remote));
+    }
+
+    void TearDown() override {
+        QuicCaptureBufferUninitialize(&Buffer);
+        MsQuicLib.PacketCapture = OriginalConfig;
+    }
+};
+
+TEST_F(CaptureTest, Header)
+{
+    QuicCaptureWriteHeader(&MsQuicLib.PacketCapture);
+    ASSERT_EQ(48u, Output.size());
+    ASSERT_EQ(0x0A0D0D0Au, Read32(Output, 0));   // Section header
+    ASSERT_EQ(0x1A2B3C4Du, Read32(Output, 8));   // Byte order magic
+    ASSERT_EQ(1u, Read32(Output, 28));           // Interface description
+}
+
+TEST_F(CaptureTest, Datagram)
+{
+    const uint8_t Payload[5] = { 0x40, 1, 2, 3, 4 };
+    QuicCaptureWriteDatagram(
+        &Buffer, nullptr, TRUE, &Local, &Remote, Payload, sizeof(Payload));
+    ASSERT_TRUE(Output.empty());
+
+    QuicCaptureFlush(&Buffer);
+    ASSERT_EQ(0u, Buffer.Length);
+
+    const uint32_t IpLength = 20 + 8 + sizeof(Payload);
+    const uint32_t BlockLength = 44 + ((IpLength + 3) & ~3u);
+    ASSERT_EQ((size_t)BlockLength, Output.size());
+    ASSERT_EQ(6u, Read32(Output, 0));            // Enhanced packet block
+    ASSERT_EQ(BlockLength, Read32(Output, 4));
+    ASSERT_EQ(IpLength, Read32(Output, 20));
+    ASSERT_EQ(BlockLength, Read32(Output, BlockLength - 4));
+
+    const uint8_t* Ip = Output.data() + 28;
+    ASSERT_EQ(0x45, Ip[0]);
+    ASSERT_EQ(17, Ip[9]);
+    ASSERT_EQ(0, memcmp(Ip + 12, &Local.Ipv4.sin_addr, 4));
+    ASSERT_EQ(0, memcmp(Ip + 16, &Remote.Ipv4.sin_addr, 4));
+    ASSERT_EQ(4433, (Ip[20] << 8) | Ip[21]);
+    ASSERT_EQ(5555, (Ip[22] << 8) | Ip[23]);
+    ASSERT_EQ(0, memcmp(Ip + 28, Payload, sizeof(Payload)));
+}
+
+TEST_F(CaptureTest, SecretsWrittenOnce)
+{
+    QUIC_CAPTURE_SECRETS Secrets;
+    CxPlatZeroMemory(&Secrets, sizeof(Secrets));
+    Secrets.Secrets.SecretLength = 32;
+    Secrets.Secrets.IsSet.ClientHandshakeTrafficSecret = TRUE;
+
+    const uint8_t Payload[1] = { 0 };
+    QuicCaptureWriteDatagram(
+        &Buffer, &Secrets, FALSE, &Remote, &Local, Payload, sizeof(Payload));
+    ASSERT_EQ(0u, Secrets.WrittenMask); // No client random yet.
+
+    Secrets.Secrets.IsSet.ClientRandom = TRUE;
+    QuicCaptureWriteDatagram(
+        &Buffer, &Secrets, FALSE, &Remote, &Local, Payload, sizeof(Payload));
+    QuicCaptureWriteDatagram(
+        &Buffer, &Secrets, FALSE, &Remote, &Local, Payload, sizeof(Payload));
+    QuicCaptureFlush(&Buffer);
+
+    uint32_t SecretsBlocks = 0, PacketBlocks = 0;
+    for (size_t Offset = 0; Offset < Output.size(); Offset += Read32(Output, Offset + 4)) {
+        if (Read32(Output, Offset) == 0x0000000A) {
+            ++SecretsBlocks;
+            ASSERT_EQ(0x544C534Bu, Read32(Output, Offset + 8));
+            const char Label[] = "CLIENT_HANDSHAKE_TRAFFIC_SECRET ";
+            ASSERT_EQ(0, memcmp(Output.data() + Offset + 16, Label, sizeof(Label) - 1));
+        } else {
+            ++PacketBlocks;
+        }
+    }
+    ASSERT_EQ(1u, SecretsBlocks);
+    ASSERT_EQ(3u, PacketBlocks);
+}
+
+TEST_F(CaptureTest, Sample)
+{
+    uint32_t Sampled = 0;
+    for (uint32_t i = 0; i < 100; ++i) {
+        Sampled += QuicCaptureSample(&Buffer, 10);
+    }
+    ASSERT_EQ(10u, Sampled);
+}
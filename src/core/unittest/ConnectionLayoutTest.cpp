@@ -0,0 +1,91 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test for the hot/cold field layout of QUIC_CONNECTION.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "ConnectionLayoutTest.cpp.clog.h"
+#endif
+
+#define CONN_OFFSET(Field) offsetof(QUIC_CONNECTION, Field)
+#define CONN_FIELD_END(Field) \
+    (CONN_OFFSET(Field) + sizeof(((QUIC_CONNECTION*)0)->Field))
+
+//
+// The start of the cold section of the connection.
+//
+#define CONN_COLD_START CONN_OFFSET(Settings)
+
+TEST(ConnectionLayoutTest, HandleIsFirst)
+{
+    ASSERT_EQ(0u, CONN_OFFSET(_));
+}
+
+TEST(ConnectionLayoutTest, HotFieldsBeforeCold)
+{
+    //
+    // Everything used on the per-packet and scheduling paths must be laid out
+    // ahead of the cold section.
+    //
+    ASSERT_LE(CONN_FIELD_END(RefCount), CONN_COLD_START);
+    ASSERT_LE(CONN_FIELD_END(State), CONN_COLD_START);
+    ASSERT_LE(CONN_FIELD_END(Worker), CONN_COLD_START);
+    ASSERT_LE(CONN_FIELD_END(WorkerThreadID), CONN_COLD_START);
+    ASSERT_LE(CONN_FIELD_END(WorkerLink), CONN_COLD_START);
+    ASSERT_LE(CONN_FIELD_END(TimerLink), CONN_COLD_START);
+    ASSERT_LE(CONN_FIELD_END(PacingLink), CONN_COLD_START);
+    ASSERT_LE(CONN_FIELD_END(OutFlowBlockedReasons), CONN_COLD_START);
+    ASSERT_LE(CONN_FIELD_END(AckDelayExponent), CONN_COLD_START);
+    ASSERT_LE(CONN_FIELD_END(PacketTolerance), CONN_COLD_START);
+    ASSERT_LE(CONN_FIELD_END(PathsCount), CONN_COLD_START);
+    ASSERT_LE(CONN_FIELD_END(ReceiveQueue), CONN_COLD_START);
+    ASSERT_LE(CONN_FIELD_END(ReceiveQueueLock), CONN_COLD_START);
+    ASSERT_LE(CONN_FIELD_END(OperQ), CONN_COLD_START);
+    ASSERT_LE(CONN_FIELD_END(ExpirationTimes), CONN_COLD_START);
+    ASSERT_LE(CONN_FIELD_END(EarliestExpirationTime), CONN_COLD_START);
+    ASSERT_LE(CONN_FIELD_END(PacingExpirationTime), CONN_COLD_START);
+    ASSERT_LE(CONN_FIELD_END(Packets), CONN_COLD_START);
+    ASSERT_LE(CONN_FIELD_END(Paths), CONN_COLD_START);
+    ASSERT_LE(CONN_FIELD_END(Send), CONN_COLD_START);
+    ASSERT_LE(CONN_FIELD_END(LossDetection), CONN_COLD_START);
+    ASSERT_LE(CONN_FIELD_END(CongestionControl), CONN_COLD_START);
+    ASSERT_LE(CONN_FIELD_END(Streams), CONN_COLD_START);
+    ASSERT_LE(CONN_FIELD_END(DecodedAckRanges), CONN_COLD_START);
+    ASSERT_LE(CONN_FIELD_END(Crypto), CONN_COLD_START);
+    ASSERT_LE(CONN_FIELD_END(Datagram), CONN_COLD_START);
+    ASSERT_LE(CONN_FIELD_END(ClientCallbackHandler), CONN_COLD_START);
+    ASSERT_LE(CONN_FIELD_END(Stats), CONN_COLD_START);
+}
+
+TEST(ConnectionLayoutTest, ColdFieldsAfterHot)
+{
+    //
+    // Large or rarely used state must not be interleaved with the hot section.
+    //
+    ASSERT_GE(CONN_OFFSET(Registration), CONN_COLD_START);
+    ASSERT_GE(CONN_OFFSET(Configuration), CONN_COLD_START);
+    ASSERT_GE(CONN_OFFSET(RegistrationLink), CONN_COLD_START);
+    ASSERT_GE(CONN_OFFSET(ServerID), CONN_COLD_START);
+    ASSERT_GE(CONN_OFFSET(CibirId), CONN_COLD_START);
+    ASSERT_GE(CONN_OFFSET(OrigDestCID), CONN_COLD_START);
+    ASSERT_GE(CONN_OFFSET(BackUpOper), CONN_COLD_START);
+    ASSERT_GE(CONN_OFFSET(BackupApiContext), CONN_COLD_START);
+    ASSERT_GE(CONN_OFFSET(CloseReasonPhrase), CONN_COLD_START);
+    ASSERT_GE(CONN_OFFSET(RemoteServerName), CONN_COLD_START);
+    ASSERT_GE(CONN_OFFSET(RemoteHashEntry), CONN_COLD_START);
+    ASSERT_GE(CONN_OFFSET(PeerTransportParams), CONN_COLD_START);
+    ASSERT_GE(CONN_OFFSET(HandshakeTP), CONN_COLD_START);
+    ASSERT_GE(CONN_OFFSET(LastNetStats), CONN_COLD_START);
+    ASSERT_GE(CONN_OFFSET(MemoryUsage), CONN_COLD_START);
+    ASSERT_GE(CONN_OFFSET(TestTransportParameter), CONN_COLD_START);
+    ASSERT_GE(CONN_OFFSET(TlsSecrets), CONN_COLD_START);
+    ASSERT_GE(CONN_OFFSET(CustomCongestionControl), CONN_COLD_START);
+    ASSERT_GE(CONN_OFFSET(BlockedTimings), CONN_COLD_START);
+}
@@ -0,0 +1,208 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test for datagram forward error correction.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "DatagramFecTest.cpp.clog.h"
+#endif
+
+#include <vector>
+
+struct DatagramFecTest : public ::testing::Test
+{
+    QUIC_DATAGRAM_FEC* Sender {nullptr};
+    QUIC_DATAGRAM_FEC* Receiver {nullptr};
+
+    void SetUp() override {
+        QUIC_DATAGRAM_FEC_CONFIG Config = { 2, 4 };
+        Sender = new(std::nothrow) QUIC_DATAGRAM_FEC;
+        Receiver = new(std::nothrow) QUIC_DATAGRAM_FEC;
+        ASSERT_NE(nullptr, Sender);
+        ASSERT_NE(nullptr, Receiver);
+        QuicDatagramFecInitialize(Sender, &Config);
+        QuicDatagramFecInitialize(Receiver, &Config);
+    }
+
+    void TearDown() override {
+        delete Sender;
+        delete Receiver;
+    }
+
+    static std::vector<uint8_t> MakePayload(uint8_t Seed, uint16_t Length) {
+        std::vector<uint8_t> Payload(Length);
+        for (uint16_t i = 0; i < Length; ++i) {
+            Payload[i] = (uint8_t)(Seed * 13 + i);
+        }
+        return Payload;
+    }
+
+    //
+    // Frames a source datagram the way the sender does.
+    //
+    std::vector<uint8_t> SendSource(const std::vector<uint8_t>& Payload) {
+        std::vector<uint8_t> Wire(QUIC_DATAGRAM_FEC_HEADER_LENGTH);
+        QuicDatagramFecWriteHeader(Sender, Wire.data());
+        Wire.insert(Wire.end(), Payload.begin(), Payload.end());
+        QUIC_BUFFER Buffer = { (uint32_t)Payload.size(), (uint8_t*)Payload.data() };
+        QuicDatagramFecOnSourceSent(Sender, &Buffer, 1, (uint16_t)Payload.size());
+        return Wire;
+    }
+
+    std::vector<uint8_t> SendRepair(uint64_t SentPackets = 0, uint64_t LostPackets = 0) {
+        EXPECT_TRUE(Sender->RepairPending);
+        std::vector<uint8_t> Wire(QUIC_DATAGRAM_FEC_HEADER_LENGTH);
+        QuicDatagramFecWriteHeader(Sender, Wire.data());
+        Wire.insert(Wire.end(), Sender->SendSymbol, Sender->SendSymbol + Sender->SendSymbolLength);
+        QuicDatagramFecOnRepairSent(Sender, SentPackets, LostPackets);
+        return Wire;
+    }
+
+    void Receive(const std::vector<uint8_t>& Wire, QUIC_BUFFER* Payload, QUIC_BUFFER* Recovered) {
+        ASSERT_TRUE(
+            QuicDatagramFecReceive(
+                Receiver, (uint16_t)Wire.size(), Wire.data(), Payload, Recovered));
+    }
+};
+
+TEST_F(DatagramFecTest, NoLoss)
+{
+    std::vector<std::vector<uint8_t>> Wires;
+    for (uint8_t i = 0; i < 4; ++i) {
+        ASSERT_FALSE(Sender->RepairPending);
+        Wires.push_back(SendSource(MakePayload(i, 100 + i)));
+    }
+    Wires.push_back(SendRepair());
+
+    QUIC_BUFFER Payload, Recovered;
+    for (uint8_t i = 0; i < 4; ++i) {
+        Receive(Wires[i], &Payload, &Recovered);
+        ASSERT_EQ(100u + i, Payload.Length);
+        ASSERT_EQ(nullptr, Recovered.Buffer);
+    }
+    Receive(Wires[4], &Payload, &Recovered);
+    ASSERT_EQ(nullptr, Payload.Buffer);
+    ASSERT_EQ(nullptr, Recovered.Buffer);
+}
+
+TEST_F(DatagramFecTest, RecoverEachPosition)
+{
+    for (uint8_t Lost = 0; Lost < 4; ++Lost) {
+        std::vector<std::vector<uint8_t>> Wires;
+        for (uint8_t i = 0; i < 4; ++i) {
+            Wires.push_back(SendSource(MakePayload(Lost * 4 + i, (uint16_t)(50 * (i + 1)))));
+        }
+        Wires.push_back(SendRepair());
+
+        QUIC_BUFFER Payload, Recovered;
+        for (uint8_t i = 0; i < 5; ++i) {
+            if (i == Lost) {
+                continue;
+            }
+            Receive(Wires[i], &Payload, &Recovered);
+        }
+
+        auto Expected = MakePayload(Lost * 4 + Lost, (uint16_t)(50 * (Lost + 1)));
+        ASSERT_NE(nullptr, Recovered.Buffer);
+        ASSERT_EQ(Expected.size(), Recovered.Length);
+        ASSERT_EQ(0, memcmp(Expected.data(), Recovered.Buffer, Expected.size()));
+
+        //
+        // The lost datagram showing up late isn't indicated twice.
+        //
+        Receive(Wires[Lost], &Payload, &Recovered);
+        ASSERT_EQ(nullptr, Payload.Buffer);
+    }
+}
+
+TEST_F(DatagramFecTest, TwoLossesNotRecovered)
+{
+    std::vector<std::vector<uint8_t>> Wires;
+    for (uint8_t i = 0; i < 4; ++i) {
+        Wires.push_back(SendSource(MakePayload(i, 64)));
+    }
+    Wires.push_back(SendRepair());
+
+    QUIC_BUFFER Payload, Recovered;
+    Receive(Wires[0], &Payload, &Recovered);
+    Receive(Wires[3], &Payload, &Recovered);
+    Receive(Wires[4], &Payload, &Recovered);
+    ASSERT_EQ(nullptr, Recovered.Buffer);
+}
+
+TEST_F(DatagramFecTest, OldBlockIgnored)
+{
+    QUIC_BUFFER Payload, Recovered;
+    std::vector<uint8_t> First = SendSource(MakePayload(0, 10));
+    for (uint8_t i = 1; i < 4; ++i) {
+        SendSource(MakePayload(i, 10));
+    }
+    SendRepair();
+
+    //
+    // Move the receiver well past the first block.
+    //
+    for (uint32_t Block = 0; Block < QUIC_DATAGRAM_FEC_RECV_BLOCKS; ++Block) {
+        for (uint8_t i = 0; i < 4; ++i) {
+            Receive(SendSource(MakePayload(i, 10)), &Payload, &Recovered);
+        }
+        SendRepair();
+    }
+
+    Receive(First, &Payload, &Recovered);
+    ASSERT_NE(nullptr, Payload.Buffer); // Still indicated.
+    ASSERT_EQ(10u, Payload.Length);
+}
+
+TEST_F(DatagramFecTest, BlockSizeFollowsLoss)
+{
+    ASSERT_EQ(4u, Sender->SendBlockSize);
+
+    uint64_t Sent = 0, Lost = 0;
+    for (uint32_t Block = 0; Block < 32; ++Block) {
+        while (!Sender->RepairPending) {
+            SendSource(MakePayload(0, 10));
+        }
+        Sent += 100;
+        Lost += 10; // 10% loss.
+        SendRepair(Sent, Lost);
+    }
+    ASSERT_EQ(2u, Sender->SendBlockSize);
+
+    for (uint32_t Block = 0; Block < 64; ++Block) {
+        while (!Sender->RepairPending) {
+            SendSource(MakePayload(0, 10));
+        }
+        Sent += 100;
+        SendRepair(Sent, Lost);
+    }
+    ASSERT_EQ(4u, Sender->SendBlockSize);
+}
+
+TEST_F(DatagramFecTest, Malformed)
+{
+    QUIC_BUFFER Payload, Recovered;
+    uint8_t Short[] = { QUIC_DATAGRAM_FEC_TYPE_SOURCE, 0, 0 };
+    ASSERT_FALSE(QuicDatagramFecReceive(Receiver, sizeof(Short), Short, &Payload, &Recovered));
+
+    uint8_t BadType[] = { 7, 0, 0, 0 };
+    ASSERT_FALSE(QuicDatagramFecReceive(Receiver, sizeof(BadType), BadType, &Payload, &Recovered));
+
+    uint8_t BadIndex[] = { QUIC_DATAGRAM_FEC_TYPE_SOURCE, 0, 0, QUIC_DATAGRAM_FEC_MAX_BLOCK_SIZE };
+    ASSERT_FALSE(QuicDatagramFecReceive(Receiver, sizeof(BadIndex), BadIndex, &Payload, &Recovered));
+
+    uint8_t BadCount[] = { QUIC_DATAGRAM_FEC_TYPE_REPAIR, 0, 0, 1, 0, 0 };
+    ASSERT_FALSE(QuicDatagramFecReceive(Receiver, sizeof(BadCount), BadCount, &Payload, &Recovered));
+
+    uint8_t Source[] = { QUIC_DATAGRAM_FEC_TYPE_SOURCE, 0, 1, 3, 0xAA };
+    ASSERT_TRUE(QuicDatagramFecReceive(Receiver, sizeof(Source), Source, &Payload, &Recovered));
+    uint8_t RepairTooFew[] = { QUIC_DATAGRAM_FEC_TYPE_REPAIR, 0, 1, 2, 0, 1, 0xAA };
+    ASSERT_FALSE(QuicDatagramFecReceive(Receiver, sizeof(RepairTooFew), RepairTooFew, &Payload, &Recovered));
+}
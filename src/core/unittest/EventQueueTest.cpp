@@ -0,0 +1,109 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test for the registration event queue.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "EventQueueTest.cpp.clog.h"
+#endif
+
+struct EventQueueTest : public ::testing::Test
+{
+    QUIC_EVENT_QUEUE Queue;
+
+    void SetUp() override {
+        QuicEventQueueInitialize(&Queue);
+    }
+
+    void TearDown() override {
+        QuicEventQueueUninitialize(&Queue);
+    }
+
+    void Post(uintptr_t Id) {
+        QUIC_QUEUED_EVENT Event;
+        CxPlatZeroMemory(&Event, sizeof(Event));
+        Event.Type = QUIC_QUEUED_EVENT_TYPE_CONNECTION;
+        Event.Handle = (HQUIC)Id;
+        Event.CONNECTION.Type = QUIC_CONNECTION_EVENT_STREAMS_AVAILABLE;
+        ASSERT_TRUE(QuicEventQueuePost(&Queue, &Event));
+    }
+};
+
+TEST_F(EventQueueTest, Empty)
+{
+    QUIC_QUEUED_EVENT Event;
+    ASSERT_EQ(0u, QuicEventQueueDequeue(&Queue, &Event, 1, 0));
+    ASSERT_EQ(0u, QuicEventQueueDequeue(&Queue, &Event, 1, 10));
+}
+
+TEST_F(EventQueueTest, InOrderBatches)
+{
+    const uint32_t Count = 3 * QUIC_EVENT_QUEUE_INITIAL_CAPACITY + 7;
+    for (uint32_t i = 0; i < Count; ++i) {
+        Post(i + 1);
+    }
+    ASSERT_EQ(Count, Queue.Count);
+    ASSERT_GE(Queue.Capacity, Count);
+
+    QUIC_QUEUED_EVENT Events[100];
+    uintptr_t Expected = 1;
+    uint32_t Dequeued;
+    while ((Dequeued = QuicEventQueueDequeue(&Queue, Events, ARRAYSIZE(Events), 0)) != 0) {
+        for (uint32_t i = 0; i < Dequeued; ++i) {
+            ASSERT_EQ(QUIC_QUEUED_EVENT_TYPE_CONNECTION, Events[i].Type);
+            ASSERT_EQ(Expected++, (uintptr_t)Events[i].Handle);
+        }
+    }
+    ASSERT_EQ(Count + 1, Expected);
+}
+
+TEST_F(EventQueueTest, Wrap)
+{
+    //
+    // Keep the queue partially full while posting and dequeuing so the ring
+    // wraps around (and grows while wrapped).
+    //
+    QUIC_QUEUED_EVENT Events[16];
+    uintptr_t Posted = 0, Expected = 1;
+    for (uint32_t Round = 0; Round < 400; ++Round) {
+        for (uint32_t i = 0; i < 16 + (Round % 3); ++i) {
+            Post(++Posted);
+        }
+        uint32_t Dequeued = QuicEventQueueDequeue(&Queue, Events, ARRAYSIZE(Events), 0);
+        ASSERT_EQ((uint32_t)ARRAYSIZE(Events), Dequeued);
+        for (uint32_t i = 0; i < Dequeued; ++i) {
+            ASSERT_EQ(Expected++, (uintptr_t)Events[i].Handle);
+        }
+    }
+    ASSERT_GT(Queue.Capacity, (uint32_t)QUIC_EVENT_QUEUE_INITIAL_CAPACITY);
+}
+
+TEST_F(EventQueueTest, ReceiveBuffers)
+{
+    uint8_t Data[4] = { 1, 2, 3, 4 };
+    QUIC_QUEUED_EVENT Event;
+    CxPlatZeroMemory(&Event, sizeof(Event));
+    Event.Type = QUIC_QUEUED_EVENT_TYPE_STREAM;
+    Event.STREAM.Type = QUIC_STREAM_EVENT_RECEIVE;
+    Event.STREAM.RECEIVE.BufferCount = 1;
+    Event.STREAM.RECEIVE.TotalBufferLength = sizeof(Data);
+    Event.ReceiveBuffers[0].Buffer = Data;
+    Event.ReceiveBuffers[0].Length = sizeof(Data);
+    ASSERT_TRUE(QuicEventQueuePost(&Queue, &Event));
+
+    //
+    // The dequeued event points at its own copy of the buffers.
+    //
+    QUIC_QUEUED_EVENT Dequeued;
+    ASSERT_EQ(1u, QuicEventQueueDequeue(&Queue, &Dequeued, 1, UINT32_MAX));
+    ASSERT_EQ(Dequeued.ReceiveBuffers, Dequeued.STREAM.RECEIVE.Buffers);
+    ASSERT_EQ(Data, Dequeued.STREAM.RECEIVE.Buffers[0].Buffer);
+    ASSERT_EQ(sizeof(Data), Dequeued.STREAM.RECEIVE.Buffers[0].Length);
+}
@@ -1247,3 +1247,36 @@ TEST_P(ConnectionCloseFrameDecodeTest, DecodeConnectionCloseFrameFail) {
 }
 
 INSTANTIATE_TEST_SUITE_P(FrameTest, ConnectionCloseFrameDecodeTest, ::testing::ValuesIn(ConnectionCloseFrameParams::GenerateDecodeFailParams()));
+
+TEST(FrameTest, ImmediateAckFrameEncode)
+{
+    uint8_t Buffer[3];
+    uint16_t Offset = 1;
+
+    CxPlatZeroMemory(Buffer, sizeof(Buffer));
+    ASSERT_FALSE(QuicImmediateAckFrameEncode(&Offset, 2, Buffer));
+    ASSERT_EQ(Offset, 1);
+    ASSERT_TRUE(QuicImmediateAckFrameEncode(&Offset, (uint16_t)sizeof(Buffer), Buffer));
+    ASSERT_EQ(Offset, 3);
+
+    QUIC_VAR_INT FrameType;
+    Offset = 1;
+    ASSERT_TRUE(QuicVarIntDecode(sizeof(Buffer), Buffer, &Offset, &FrameType));
+    ASSERT_EQ(FrameType, (QUIC_VAR_INT)QUIC_FRAME_IMMEDIATE_ACK);
+}
+
+TEST(FrameTest, PaddingFrameSkip)
+{
+    uint8_t Buffer[64];
+    for (uint16_t PaddingLength = 0; PaddingLength <= sizeof(Buffer); ++PaddingLength) {
+        for (uint16_t Start = 0; Start <= PaddingLength; Start += 3) {
+            CxPlatZeroMemory(Buffer, sizeof(Buffer));
+            if (PaddingLength < sizeof(Buffer)) {
+                Buffer[PaddingLength] = (uint8_t)QUIC_FRAME_PING;
+            }
+            uint16_t Offset = Start;
+            QuicPaddingFrameSkip(sizeof(Buffer), Buffer, &Offset);
+            ASSERT_EQ(Offset, PaddingLength);
+        }
+    }
+}
@@ -0,0 +1,51 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test for the log-linear latency histogram.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "LatencyHistogramTest.cpp.clog.h"
+#endif
+
+TEST(LatencyHistogramTest, BucketBounds)
+{
+    //
+    // Every bucket's lower bound maps back to it, and the value just below
+    // maps to the previous bucket.
+    //
+    for (uint32_t i = 0; i < QUIC_LATENCY_HISTOGRAM_BUCKET_COUNT; ++i) {
+        const uint64_t Low = QUIC_LATENCY_HISTOGRAM_BUCKET_LOW(i);
+        ASSERT_LE(Low, (uint64_t)UINT32_MAX);
+        ASSERT_EQ(i, QuicLatencyHistogramBucket((uint32_t)Low));
+        if (i != 0) {
+            ASSERT_EQ(i - 1, QuicLatencyHistogramBucket((uint32_t)(Low - 1)));
+        }
+    }
+    ASSERT_EQ(
+        QUIC_LATENCY_HISTOGRAM_BUCKET_COUNT - 1,
+        QuicLatencyHistogramBucket(UINT32_MAX));
+}
+
+TEST(LatencyHistogramTest, Record)
+{
+    QUIC_LATENCY_HISTOGRAM Histogram;
+    CxPlatZeroMemory(&Histogram, sizeof(Histogram));
+
+    QuicLatencyHistogramRecord(&Histogram, 0);
+    QuicLatencyHistogramRecord(&Histogram, 1000);
+    QuicLatencyHistogramRecord(&Histogram, 1010);
+    QuicLatencyHistogramRecord(&Histogram, UINT64_MAX / 2); // Clamped to the last bucket.
+
+    ASSERT_EQ(4ull, Histogram.Count);
+    ASSERT_EQ(UINT64_MAX / 2, Histogram.Max);
+    ASSERT_EQ(1u, Histogram.Buckets[0]);
+    ASSERT_EQ(2u, Histogram.Buckets[QuicLatencyHistogramBucket(1000)]); // [896, 1024)
+    ASSERT_EQ(1u, Histogram.Buckets[QUIC_LATENCY_HISTOGRAM_BUCKET_COUNT - 1]);
+}
@@ -0,0 +1,186 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test for the network emulator's link model.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "NetEmuTest.cpp.clog.h"
+#endif
+
+static
+QUIC_NET_EMU_LINK
+NewLink(
+    const QUIC_NETWORK_EMULATION_LINK& Config,
+    uint64_t Seed = 1
+    )
+{
+    QUIC_NET_EMU_LINK Link;
+    QuicNetEmuLinkInitialize(&Link, &Config, Seed);
+    return Link;
+}
+
+TEST(NetEmuTest, Unimpaired)
+{
+    QUIC_NETWORK_EMULATION_LINK Config = {};
+    auto Link = NewLink(Config);
+    for (uint64_t i = 0; i < 100; ++i) {
+        ASSERT_EQ(1000 + i, QuicNetEmuLinkSchedule(&Link, 1000 + i, 1200));
+    }
+}
+
+TEST(NetEmuTest, Delay)
+{
+    QUIC_NETWORK_EMULATION_LINK Config = {};
+    Config.DelayUs = 25000;
+    auto Link = NewLink(Config);
+    ASSERT_EQ(1000u + 25000u, QuicNetEmuLinkSchedule(&Link, 1000, 1200));
+}
+
+TEST(NetEmuTest, Bandwidth)
+{
+    //
+    // 1200 bytes at 9600 kbps take 1 ms to serialize, so back to back
+    // datagrams leave 1 ms apart.
+    //
+    QUIC_NETWORK_EMULATION_LINK Config = {};
+    Config.BandwidthKbps = 9600;
+    Config.DelayUs = 10000;
+    auto Link = NewLink(Config);
+    for (uint64_t i = 0; i < 10; ++i) {
+        ASSERT_EQ(1000 * (i + 1) + 10000, QuicNetEmuLinkSchedule(&Link, 0, 1200));
+    }
+
+    //
+    // Once the link drains, a new datagram doesn't wait.
+    //
+    ASSERT_EQ(100000u + 1000u + 10000u, QuicNetEmuLinkSchedule(&Link, 100000, 1200));
+}
+
+TEST(NetEmuTest, QueueDrop)
+{
+    QUIC_NETWORK_EMULATION_LINK Config = {};
+    Config.BandwidthKbps = 9600;
+    Config.QueueBytes = 3600;
+    auto Link = NewLink(Config);
+
+    //
+    // The first datagram is on the wire; three more fit in the buffer.
+    //
+    uint32_t Accepted = 0;
+    for (uint32_t i = 0; i < 10; ++i) {
+        if (QuicNetEmuLinkSchedule(&Link, 0, 1200) != UINT64_MAX) {
+            ++Accepted;
+        }
+    }
+    ASSERT_EQ(4u, Accepted);
+
+    //
+    // After one datagram's worth of time, there is room for one more.
+    //
+    ASSERT_NE(UINT64_MAX, QuicNetEmuLinkSchedule(&Link, 1000, 1200));
+    ASSERT_EQ(UINT64_MAX, QuicNetEmuLinkSchedule(&Link, 1000, 1200));
+}
+
+TEST(NetEmuTest, Jitter)
+{
+    QUIC_NETWORK_EMULATION_LINK Config = {};
+    Config.DelayUs = 10000;
+    Config.JitterUs = 2000;
+    auto Link = NewLink(Config);
+    uint64_t Min = UINT64_MAX, Max = 0;
+    for (uint32_t i = 0; i < 10000; ++i) {
+        uint64_t Delivery = QuicNetEmuLinkSchedule(&Link, 0, 1200);
+        Min = CXPLAT_MIN(Min, Delivery);
+        Max = CXPLAT_MAX(Max, Delivery);
+    }
+    ASSERT_GE(Min, 10000u);
+    ASSERT_LE(Max, 12000u);
+    ASSERT_LT(Min, 10100u);
+    ASSERT_GT(Max, 11900u);
+}
+
+TEST(NetEmuTest, RandomLoss)
+{
+    QUIC_NETWORK_EMULATION_LINK Config = {};
+    Config.LossRate = 10000; // 1%
+    auto Link = NewLink(Config);
+    uint32_t Lost = 0;
+    for (uint32_t i = 0; i < 100000; ++i) {
+        if (QuicNetEmuLinkSchedule(&Link, 0, 1200) == UINT64_MAX) {
+            ++Lost;
+        }
+    }
+    ASSERT_GT(Lost, 800u);
+    ASSERT_LT(Lost, 1200u);
+}
+
+TEST(NetEmuTest, BurstLoss)
+{
+    QUIC_NETWORK_EMULATION_LINK Config = {};
+    Config.LossRate = 20000; // 2%
+    Config.LossBurstLength = 4;
+    auto Link = NewLink(Config);
+    uint32_t Lost = 0, Bursts = 0;
+    bool PreviousLost = false;
+    for (uint32_t i = 0; i < 200000; ++i) {
+        bool IsLost = QuicNetEmuLinkSchedule(&Link, 0, 1200) == UINT64_MAX;
+        if (IsLost) {
+            ++Lost;
+            if (!PreviousLost) {
+                ++Bursts;
+            }
+        }
+        PreviousLost = IsLost;
+    }
+    ASSERT_GT(Lost, 3200u);
+    ASSERT_LT(Lost, 4800u);
+    double AverageBurst = (double)Lost / Bursts;
+    ASSERT_GT(AverageBurst, 3.0);
+    ASSERT_LT(AverageBurst, 5.0);
+}
+
+TEST(NetEmuTest, Reorder)
+{
+    QUIC_NETWORK_EMULATION_LINK Config = {};
+    Config.DelayUs = 10000;
+    Config.ReorderRate = 50000; // 5%
+    auto Link = NewLink(Config);
+    uint32_t Reordered = 0;
+    for (uint32_t i = 0; i < 100000; ++i) {
+        uint64_t Delivery = QuicNetEmuLinkSchedule(&Link, 0, 1200);
+        if (Delivery == 0) {
+            ++Reordered;
+        } else {
+            ASSERT_EQ(10000u, Delivery);
+        }
+    }
+    ASSERT_GT(Reordered, 4000u);
+    ASSERT_LT(Reordered, 6000u);
+}
+
+TEST(NetEmuTest, SameSeedSameDecisions)
+{
+    QUIC_NETWORK_EMULATION_LINK Config = {};
+    Config.DelayUs = 10000;
+    Config.JitterUs = 5000;
+    Config.LossRate = 50000;
+    Config.LossBurstLength = 3;
+    Config.ReorderRate = 10000;
+    auto Link1 = NewLink(Config, 42);
+    auto Link2 = NewLink(Config, 42);
+    auto Link3 = NewLink(Config, 43);
+    bool Differs = false;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        uint64_t Delivery = QuicNetEmuLinkSchedule(&Link1, i * 100, 1200);
+        ASSERT_EQ(Delivery, QuicNetEmuLinkSchedule(&Link2, i * 100, 1200));
+        Differs |= Delivery != QuicNetEmuLinkSchedule(&Link3, i * 100, 1200);
+    }
+    ASSERT_TRUE(Differs);
+}
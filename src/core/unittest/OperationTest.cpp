@@ -0,0 +1,167 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test for the connection operation queue.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "OperationTest.cpp.clog.h"
+#endif
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+struct OperationQueueTest : public ::testing::Test
+{
+    QUIC_OPERATION_QUEUE OperQ;
+
+    //
+    // Enqueuing and dequeuing update the perf counters, which live in the
+    // library's per-processor state.
+    //
+    QUIC_LIBRARY_PP PerProc;
+    QUIC_LIBRARY_PP* OldPerProc {nullptr};
+    uint16_t OldProcessorCount {0};
+
+    void SetUp() override {
+        CxPlatZeroMemory(&PerProc, sizeof(PerProc));
+        OldPerProc = MsQuicLib.PerProc;
+        OldProcessorCount = MsQuicLib.ProcessorCount;
+        MsQuicLib.PerProc = &PerProc;
+        MsQuicLib.ProcessorCount = 1;
+        QuicOperationQueueInitialize(&OperQ);
+    }
+
+    void TearDown() override {
+        QuicOperationQueueUninitialize(&OperQ);
+        MsQuicLib.PerProc = OldPerProc;
+        MsQuicLib.ProcessorCount = OldProcessorCount;
+    }
+
+    static void InitOper(QUIC_OPERATION* Oper) {
+        CxPlatZeroMemory(Oper, sizeof(*Oper));
+        Oper->Type = QUIC_OPER_TYPE_TIMER_EXPIRED;
+    }
+};
+
+TEST_F(OperationQueueTest, Fifo)
+{
+    QUIC_OPERATION Opers[3];
+    for (auto& Oper : Opers) {
+        InitOper(&Oper);
+    }
+
+    ASSERT_TRUE(QuicOperationEnqueue(&OperQ, &Opers[0]));
+    ASSERT_FALSE(QuicOperationEnqueue(&OperQ, &Opers[1]));
+    ASSERT_FALSE(QuicOperationHasPriority(&OperQ));
+
+    ASSERT_EQ(&Opers[0], QuicOperationDequeue(&OperQ));
+
+    //
+    // While the queue is being drained, enqueuing never needs to schedule it.
+    //
+    ASSERT_FALSE(QuicOperationEnqueue(&OperQ, &Opers[2]));
+
+    ASSERT_EQ(&Opers[1], QuicOperationDequeue(&OperQ));
+    ASSERT_EQ(&Opers[2], QuicOperationDequeue(&OperQ));
+    ASSERT_EQ(nullptr, QuicOperationDequeue(&OperQ));
+
+    //
+    // Once drained, the next enqueue must schedule it again.
+    //
+    ASSERT_TRUE(QuicOperationEnqueue(&OperQ, &Opers[0]));
+    ASSERT_EQ(&Opers[0], QuicOperationDequeue(&OperQ));
+    ASSERT_EQ(nullptr, QuicOperationDequeue(&OperQ));
+}
+
+TEST_F(OperationQueueTest, PriorityAndFront)
+{
+    QUIC_OPERATION Normal1, Normal2, Priority1, Priority2, Front1, Front2;
+    for (auto Oper : {&Normal1, &Normal2, &Priority1, &Priority2, &Front1, &Front2}) {
+        InitOper(Oper);
+    }
+
+    ASSERT_TRUE(QuicOperationEnqueue(&OperQ, &Normal1));
+    ASSERT_TRUE(QuicOperationEnqueuePriority(&OperQ, &Priority1));
+    ASSERT_TRUE(QuicOperationEnqueueFront(&OperQ, &Front1));
+    ASSERT_FALSE(QuicOperationEnqueuePriority(&OperQ, &Priority2));
+    ASSERT_FALSE(QuicOperationEnqueueFront(&OperQ, &Front2));
+    ASSERT_TRUE(QuicOperationHasPriority(&OperQ));
+
+    ASSERT_EQ(&Front2, QuicOperationDequeue(&OperQ));
+    ASSERT_EQ(&Front1, QuicOperationDequeue(&OperQ));
+
+    //
+    // Enqueued while draining, behind the existing priority operations but
+    // ahead of the normal ones.
+    //
+    ASSERT_FALSE(QuicOperationEnqueue(&OperQ, &Normal2));
+    ASSERT_FALSE(QuicOperationEnqueuePriority(&OperQ, &Front1));
+
+    ASSERT_EQ(&Priority1, QuicOperationDequeue(&OperQ));
+    ASSERT_EQ(&Priority2, QuicOperationDequeue(&OperQ));
+    ASSERT_EQ(&Front1, QuicOperationDequeue(&OperQ));
+    ASSERT_FALSE(QuicOperationHasPriority(&OperQ));
+    ASSERT_EQ(&Normal1, QuicOperationDequeue(&OperQ));
+    ASSERT_EQ(&Normal2, QuicOperationDequeue(&OperQ));
+    ASSERT_EQ(nullptr, QuicOperationDequeue(&OperQ));
+}
+
+TEST_F(OperationQueueTest, ConcurrentProducers)
+{
+    const uint32_t ProducerCount = 4;
+    const uint32_t OpersPerProducer = 10000;
+
+    std::vector<QUIC_OPERATION> Opers(ProducerCount * OpersPerProducer);
+    for (auto& Oper : Opers) {
+        InitOper(&Oper);
+    }
+
+    //
+    // Every operation must come out exactly once and, per producer, in order.
+    // The queue must also never be left with operations in it, but not being
+    // drained and not scheduled to be.
+    //
+    std::atomic<uint32_t> ScheduleCount {0};
+    std::vector<std::thread> Producers;
+    for (uint32_t i = 0; i < ProducerCount; ++i) {
+        Producers.emplace_back([&, i]() {
+            for (uint32_t j = 0; j < OpersPerProducer; ++j) {
+                if (QuicOperationEnqueue(&OperQ, &Opers[i * OpersPerProducer + j])) {
+                    ++ScheduleCount;
+                }
+            }
+        });
+    }
+
+    std::vector<uint32_t> NextIndex(ProducerCount, 0);
+    uint32_t Dequeued = 0;
+    uint32_t Drains = 0;
+    while (Dequeued < Opers.size()) {
+        if (Drains == ScheduleCount.load()) {
+            std::this_thread::yield();
+            continue;
+        }
+        ++Drains;
+        QUIC_OPERATION* Oper;
+        while ((Oper = QuicOperationDequeue(&OperQ)) != nullptr) {
+            const uint32_t Index = (uint32_t)(Oper - Opers.data());
+            const uint32_t Producer = Index / OpersPerProducer;
+            EXPECT_EQ(NextIndex[Producer], Index % OpersPerProducer);
+            ++NextIndex[Producer];
+            ++Dequeued;
+        }
+    }
+
+    for (auto& Producer : Producers) {
+        Producer.join();
+    }
+    ASSERT_EQ(nullptr, QuicOperationDequeue(&OperQ));
+}
@@ -0,0 +1,120 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test for the path metrics cache.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "PathMetricsCacheTest.cpp.clog.h"
+#endif
+
+struct PathMetricsCacheTest : public ::testing::Test
+{
+    QUIC_PATH_METRICS_CACHE* Cache {nullptr};
+
+    void SetUp() override {
+        Cache = new(std::nothrow) QUIC_PATH_METRICS_CACHE;
+        ASSERT_NE(nullptr, Cache);
+        QuicPathMetricsCacheInitialize(Cache);
+    }
+
+    void TearDown() override {
+        if (Cache != nullptr) {
+            QuicPathMetricsCacheUninitialize(Cache);
+            delete Cache;
+        }
+    }
+
+    static QUIC_ADDR Address(const char* Ip, uint16_t Port = 443) {
+        QUIC_ADDR Addr;
+        EXPECT_TRUE(QuicAddrFromString(Ip, Port, &Addr));
+        return Addr;
+    }
+
+    static QUIC_ADDR Address(uint32_t Index) {
+        char Ip[16];
+        (void)sprintf_s(Ip, sizeof(Ip), "10.%u.%u.%u", (Index >> 16) & 0xFF, (Index >> 8) & 0xFF, Index & 0xFF);
+        return Address(Ip);
+    }
+};
+
+TEST_F(PathMetricsCacheTest, Miss)
+{
+    QUIC_ADDR Addr = Address("192.168.1.1");
+    QUIC_PATH_METRICS Metrics;
+    ASSERT_FALSE(QuicPathMetricsCacheLookup(Cache, &Addr, &Metrics));
+}
+
+TEST_F(PathMetricsCacheTest, UpdateAndLookup)
+{
+    QUIC_ADDR Addr = Address("192.168.1.1");
+    QUIC_PATH_METRICS Metrics = { 25000, 20000, 100000, 1450 };
+    QuicPathMetricsCacheUpdate(Cache, &Addr, &Metrics);
+
+    //
+    // The port isn't part of the key.
+    //
+    QUIC_ADDR OtherPort = Address("192.168.1.1", 4433);
+    QUIC_PATH_METRICS Cached;
+    ASSERT_TRUE(QuicPathMetricsCacheLookup(Cache, &OtherPort, &Cached));
+    ASSERT_EQ(25000u, Cached.SmoothedRtt);
+    ASSERT_EQ(20000u, Cached.MinRtt);
+    ASSERT_EQ(100000u, Cached.CongestionWindow);
+    ASSERT_EQ(1450, Cached.Mtu);
+
+    QUIC_ADDR OtherIp = Address("192.168.1.2");
+    ASSERT_FALSE(QuicPathMetricsCacheLookup(Cache, &OtherIp, &Cached));
+    QUIC_ADDR OtherFamily = Address("::ffff:192.168.1.1");
+    ASSERT_FALSE(QuicPathMetricsCacheLookup(Cache, &OtherFamily, &Cached));
+}
+
+TEST_F(PathMetricsCacheTest, PartialUpdate)
+{
+    QUIC_ADDR Addr = Address("fe80::1");
+    QUIC_PATH_METRICS Metrics = { 0, 0, 0, 1500 };
+    QuicPathMetricsCacheUpdate(Cache, &Addr, &Metrics);
+
+    Metrics = { 30000, 10000, 50000, 0 };
+    QuicPathMetricsCacheUpdate(Cache, &Addr, &Metrics);
+
+    QUIC_PATH_METRICS Cached;
+    ASSERT_TRUE(QuicPathMetricsCacheLookup(Cache, &Addr, &Cached));
+    ASSERT_EQ(30000u, Cached.SmoothedRtt);
+    ASSERT_EQ(10000u, Cached.MinRtt);
+    ASSERT_EQ(50000u, Cached.CongestionWindow);
+    ASSERT_EQ(1500, Cached.Mtu);
+}
+
+TEST_F(PathMetricsCacheTest, Bounded)
+{
+    //
+    // Many more addresses than the cache can hold. The most recently updated
+    // one is always kept, while older ones are eventually replaced.
+    //
+    const uint32_t Count = 16 * QUIC_PATH_METRICS_CACHE_SETS * QUIC_PATH_METRICS_CACHE_WAYS;
+    uint32_t Hits = 0;
+    for (uint32_t i = 0; i < Count; ++i) {
+        QUIC_ADDR Addr = Address(i);
+        QUIC_PATH_METRICS Metrics = { i + 1, i + 1, i + 1, 1280 };
+        QuicPathMetricsCacheUpdate(Cache, &Addr, &Metrics);
+
+        QUIC_PATH_METRICS Cached;
+        ASSERT_TRUE(QuicPathMetricsCacheLookup(Cache, &Addr, &Cached));
+        ASSERT_EQ(i + 1, Cached.SmoothedRtt);
+    }
+    for (uint32_t i = 0; i < Count; ++i) {
+        QUIC_ADDR Addr = Address(i);
+        QUIC_PATH_METRICS Cached;
+        if (QuicPathMetricsCacheLookup(Cache, &Addr, &Cached)) {
+            ASSERT_EQ(i + 1, Cached.SmoothedRtt);
+            ++Hits;
+        }
+    }
+    ASSERT_LE(Hits, (uint32_t)(QUIC_PATH_METRICS_CACHE_SETS * QUIC_PATH_METRICS_CACHE_WAYS));
+}
@@ -0,0 +1,111 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test for the worker qlog buffer.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "QlogTest.cpp.clog.h"
+#endif
+
+#include <string>
+
+static
+void
+QUIC_API
+QlogTestHandler(
+    _In_opt_ void* Context,
+    _In_reads_bytes_(Length) const char* Data,
+    _In_ uint32_t Length
+    )
+{
+    ((std::string*)Context)->append(Data, Length);
+}
+
+static
+size_t
+CountRecords(
+    const std::string& Output
+    )
+{
+    size_t Count = 0;
+    for (char c : Output) {
+        Count += c == '\x1e';
+    }
+    return Count;
+}
+
+struct QlogTest : public ::testing::Test
+{
+    QUIC_QLOG_BUFFER Buffer;
+    QUIC_QLOG_HANDLER OriginalHandler;
+    std::string Output;
+
+    void SetUp() override {
+        CxPlatZeroMemory(&Buffer, sizeof(Buffer));
+        OriginalHandler = MsQuicLib.QlogHandler;
+        MsQuicLib.QlogHandler.Handler = QlogTestHandler;
+        MsQuicLib.QlogHandler.Context = &Output;
+    }
+
+    void TearDown() override {
+        QuicQlogBufferUninitialize(&Buffer);
+        MsQuicLib.QlogHandler = OriginalHandler;
+    }
+};
+
+TEST_F(QlogTest, Format)
+{
+    const void* Connection = (const void*)(size_t)0x1234;
+    QuicQlogWrite(
+        &Buffer, Connection, QUIC_QLOG_EVENT_PACKET_SENT,
+        QUIC_TRACE_PACKET_ONE_RTT, 7, 1200, 0);
+    QuicQlogWrite(
+        &Buffer, Connection, QUIC_QLOG_EVENT_PACKET_LOST,
+        QUIC_TRACE_PACKET_INITIAL, 3, QUIC_TRACE_PACKET_LOSS_PROBE, 0);
+    QuicQlogWrite(
+        &Buffer, Connection, QUIC_QLOG_EVENT_METRICS_UPDATED,
+        0, 25042, 30000, 1500);
+    ASSERT_TRUE(Output.empty());
+
+    QuicQlogFlush(&Buffer);
+    ASSERT_EQ(0u, Buffer.Count);
+    ASSERT_EQ(3u, CountRecords(Output));
+    ASSERT_NE(std::string::npos, Output.find("\"name\":\"transport:packet_sent\""));
+    ASSERT_NE(std::string::npos, Output.find("\"group_id\":\"0x0000000000001234\""));
+    ASSERT_NE(std::string::npos, Output.find("{\"packet_type\":\"1RTT\",\"packet_number\":7},\"raw\":{\"length\":1200}"));
+    ASSERT_NE(std::string::npos, Output.find("{\"packet_type\":\"initial\",\"packet_number\":3},\"trigger\":\"pto_expired\""));
+    ASSERT_NE(std::string::npos, Output.find("\"latest_rtt\":25.042,\"smoothed_rtt\":30.000,\"rtt_variance\":1.500"));
+    ASSERT_EQ('\n', Output.back());
+}
+
+TEST_F(QlogTest, FlushWhenFull)
+{
+    for (uint32_t i = 0; i < QUIC_QLOG_BUFFER_RECORD_COUNT + 1; ++i) {
+        QuicQlogWrite(
+            &Buffer, nullptr, QUIC_QLOG_EVENT_PACKET_RECEIVED,
+            QUIC_TRACE_PACKET_HANDSHAKE, i, 100, 0);
+    }
+    ASSERT_EQ((size_t)QUIC_QLOG_BUFFER_RECORD_COUNT, CountRecords(Output));
+    ASSERT_EQ(1u, Buffer.Count);
+
+    QuicQlogFlush(&Buffer);
+    ASSERT_EQ((size_t)QUIC_QLOG_BUFFER_RECORD_COUNT + 1, CountRecords(Output));
+}
+
+TEST_F(QlogTest, NoHandler)
+{
+    MsQuicLib.QlogHandler.Handler = nullptr;
+    QuicQlogWrite(
+        &Buffer, nullptr, QUIC_QLOG_EVENT_PACKET_SENT,
+        QUIC_TRACE_PACKET_ONE_RTT, 0, 100, 0);
+    QuicQlogFlush(&Buffer);
+    ASSERT_EQ(0u, Buffer.Count);
+    ASSERT_TRUE(Output.empty());
+}
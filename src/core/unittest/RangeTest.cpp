@@ -50,6 +50,12 @@ struct SmartRange {
         Dump();
     #endif
     }
+    void SetMin(uint64_t low) {
+        QuicRangeSetMin(&range, low);
+    #ifndef LOG_ONLY_FAILURES
+        Dump();
+    #endif
+    }
     int Find(uint64_t value) {
         QUIC_RANGE_SEARCH_KEY Key = { value, value };
         return QuicRangeSearch(&range, &Key);
@@ -478,6 +484,120 @@ TEST(RangeTest, HitMax)
     ASSERT_EQ(range.Max(), MaxCount*2);
 }
 
+TEST(RangeTest, HitMaxWrapAround)
+{
+    //
+    // Keep aging out the smallest subranges so the underlying array wraps
+    // around many times.
+    //
+    const uint32_t MaxCount = 16;
+    SmartRange range(MaxCount * sizeof(QUIC_SUBRANGE));
+    for (uint32_t i = 0; i < MaxCount * 10; i++) {
+        range.Add(i*2);
+        ASSERT_EQ(range.ValidCount(), CXPLAT_MIN(i + 1, MaxCount));
+        ASSERT_EQ(range.Max(), i*2ull);
+    }
+    ASSERT_EQ(range.Min(), (MaxCount * 9) * 2ull);
+    range.Remove((MaxCount * 9 + 1) * 2, 1);
+    ASSERT_EQ(range.ValidCount(), MaxCount - 1);
+    range.Add((MaxCount * 9 + 1) * 2);
+    ASSERT_EQ(range.ValidCount(), MaxCount);
+    ASSERT_EQ(range.Min(), (MaxCount * 9) * 2ull);
+    range.Add(MaxCount * 10 * 2);
+    ASSERT_EQ(range.ValidCount(), MaxCount);
+    ASSERT_EQ(range.Min(), (MaxCount * 9 + 1) * 2ull);
+    for (uint32_t i = 1; i < QuicRangeSize(&range.range); i++) {
+        ASSERT_GT(
+            QuicRangeGet(&range.range, i)->Low,
+            QuicRangeGetHigh(QuicRangeGet(&range.range, i - 1)) + 1);
+    }
+}
+
+TEST(RangeTest, SetMin)
+{
+    SmartRange range;
+    for (uint32_t i = 0; i < 100; i++) {
+        range.Add(i*4, 2);
+    }
+    range.SetMin(9);
+    ASSERT_EQ(range.ValidCount(), 98u);
+    ASSERT_EQ(range.Min(), 9ull);
+    range.SetMin(10);
+    ASSERT_EQ(range.ValidCount(), 97u);
+    ASSERT_EQ(range.Min(), 12ull);
+    range.SetMin(200);
+    ASSERT_EQ(range.ValidCount(), 50u);
+    ASSERT_EQ(range.Min(), 200ull);
+    range.Add(0, 300);
+    ASSERT_EQ(range.ValidCount(), 25u); // Merged with [300, 301] too.
+    ASSERT_EQ(range.Min(), 0ull);
+    range.SetMin(1000);
+    ASSERT_EQ(range.ValidCount(), 0u);
+}
+
+TEST(RangeTest, RandomOpsMatchBitmap)
+{
+    //
+    // Applies a random mix of operations, biased toward the largest values like
+    // received packet numbers, and validates the range against a simple bitmap.
+    //
+    const uint32_t MaxValue = 2048;
+    const uint32_t IterationCount = 5000;
+    std::vector<bool> Bitmap(MaxValue, false);
+    uint32_t MinValue = 0;
+    uint32_t Seed = 0x12345678;
+    auto Next = [&Seed]() {
+        Seed = Seed * 1103515245 + 12345;
+        return (Seed >> 8) & 0xFFFF;
+    };
+    SmartRange range;
+    for (uint32_t Iteration = 0; Iteration < IterationCount; Iteration++) {
+        const uint32_t Op = Next() % 100;
+        const uint32_t Count = 1 + Next() % 4;
+        const uint32_t Top = 64 + (Iteration * (MaxValue - 64)) / IterationCount;
+        uint32_t Low =
+            Op < 70 ? // Mostly near the largest values.
+                Top - 1 - Next() % 64 :
+                Next() % Top;
+        Low = CXPLAT_MIN(Low, MaxValue - Count);
+        if (Op < 85) {
+            range.Add(Low, Count);
+            for (uint32_t i = Low; i < Low + Count; i++) {
+                Bitmap[i] = true;
+            }
+        } else if (Op < 95) {
+            range.Remove(Low, Count);
+            for (uint32_t i = Low; i < Low + Count; i++) {
+                Bitmap[i] = false;
+            }
+        } else if (Low > MinValue) {
+            range.SetMin(Low);
+            for (uint32_t i = 0; i < Low; i++) {
+                Bitmap[i] = false;
+            }
+            MinValue = Low;
+        }
+
+        uint64_t Expected = 0;
+        for (uint32_t i = 0; i < QuicRangeSize(&range.range); i++) {
+            QUIC_SUBRANGE* Sub = QuicRangeGet(&range.range, i);
+            ASSERT_NE(Sub->Count, 0ull);
+            if (i != 0) {
+                ASSERT_GT(Sub->Low, QuicRangeGetHigh(QuicRangeGet(&range.range, i - 1)) + 1);
+            }
+            for (; Expected < Sub->Low; Expected++) {
+                ASSERT_FALSE(Bitmap[(size_t)Expected]);
+            }
+            for (; Expected <= QuicRangeGetHigh(Sub); Expected++) {
+                ASSERT_TRUE(Bitmap[(size_t)Expected]);
+            }
+        }
+        for (; Expected < MaxValue; Expected++) {
+            ASSERT_FALSE(Bitmap[(size_t)Expected]);
+        }
+    }
+}
+
 TEST(RangeTest, SearchZero)
 {
     SmartRange range;
@@ -20,18 +20,33 @@ Abstract:
 struct RecvBuffer {
     QUIC_RECV_BUFFER RecvBuf {0};
     QUIC_RECV_CHUNK* PreallocChunk {nullptr};
+    QUIC_RECV_CHUNK_POOL* ChunkPool {nullptr};
+    std::vector<uint8_t*> AppBuffers;
     ~RecvBuffer() {
         QuicRecvBufferUninitialize(&RecvBuf);
+        if (ChunkPool) {
+            QuicRecvChunkPoolUninitialize(ChunkPool);
+            delete ChunkPool;
+        }
         if (PreallocChunk) {
             CXPLAT_FREE(PreallocChunk, QUIC_POOL_TEST);
         }
+        for (auto Buffer : AppBuffers) {
+            delete [] Buffer;
+        }
     }
     QUIC_STATUS Initialize(
         _In_ QUIC_RECV_BUF_MODE RecvMode = QUIC_RECV_BUF_MODE_SINGLE,
         _In_ bool PreallocatedChunk = false,
         _In_ uint32_t AllocBufferLength = DEF_TEST_BUFFER_LENGTH,
-        _In_ uint32_t VirtualBufferLength = DEF_TEST_BUFFER_LENGTH
+        _In_ uint32_t VirtualBufferLength = DEF_TEST_BUFFER_LENGTH,
+        _In_ bool UseChunkPool = false
         ) {
+        if (UseChunkPool) {
+            ChunkPool = new (std::nothrow) QUIC_RECV_CHUNK_POOL;
+            CXPLAT_FRE_ASSERT(ChunkPool);
+            QuicRecvChunkPoolInitialize(ChunkPool);
+        }
         if (PreallocatedChunk) {
             PreallocChunk =
                 (QUIC_RECV_CHUNK*)CXPLAT_ALLOC_NONPAGED(
@@ -39,10 +54,51 @@ struct RecvBuffer {
                     QUIC_POOL_TEST);
         }
         printf("Initializing: [mode=%u,vlen=%u,alen=%u]\n", RecvMode, VirtualBufferLength, AllocBufferLength);
-        auto Result = QuicRecvBufferInitialize(&RecvBuf, AllocBufferLength, VirtualBufferLength, RecvMode, PreallocChunk);
+        auto Result = QuicRecvBufferInitialize(&RecvBuf, AllocBufferLength, VirtualBufferLength, RecvMode, PreallocChunk, ChunkPool);
         Dump();
         return Result;
     }
+    void InitializeDeferred(
+        _In_ QUIC_RECV_BUF_MODE RecvMode = QUIC_RECV_BUF_MODE_SINGLE,
+        _In_ uint32_t AllocBufferLength = DEF_TEST_BUFFER_LENGTH,
+        _In_ uint32_t VirtualBufferLength = DEF_TEST_BUFFER_LENGTH
+        ) {
+        printf("Initializing (deferred): [mode=%u,vlen=%u,alen=%u]\n", RecvMode, VirtualBufferLength, AllocBufferLength);
+        QuicRecvBufferInitializeDeferred(&RecvBuf, AllocBufferLength, VirtualBufferLength, RecvMode, nullptr);
+        Dump();
+    }
+    QUIC_STATUS ProvideChunks(
+        _In_ uint32_t ChunkCount,
+        _In_ uint32_t ChunkLength
+        ) {
+        CXPLAT_LIST_ENTRY Chunks;
+        CxPlatListInitializeHead(&Chunks);
+        for (uint32_t i = 0; i < ChunkCount; ++i) {
+            auto Chunk =
+                (QUIC_RECV_CHUNK*)CXPLAT_ALLOC_NONPAGED(
+                    sizeof(QUIC_RECV_CHUNK),
+                    QUIC_POOL_RECVBUF);
+            CXPLAT_FRE_ASSERT(Chunk);
+            auto Buffer = new (std::nothrow) uint8_t[ChunkLength];
+            CXPLAT_FRE_ASSERT(Buffer);
+            memset(Buffer, 0, ChunkLength);
+            AppBuffers.push_back(Buffer);
+            Chunk->AllocLength = ChunkLength;
+            Chunk->ExternalReference = FALSE;
+            Chunk->Buffer = Buffer;
+            CxPlatListInsertTail(&Chunks, &Chunk->Link);
+        }
+        printf("ProvideChunks: Count=%u, Length=%u\n", ChunkCount, ChunkLength);
+        auto Status = QuicRecvBufferProvideChunks(&RecvBuf, &Chunks);
+        while (!CxPlatListIsEmpty(&Chunks)) {
+            CXPLAT_FREE(
+                CXPLAT_CONTAINING_RECORD(
+                    CxPlatListRemoveHead(&Chunks), QUIC_RECV_CHUNK, Link),
+                QUIC_POOL_RECVBUF);
+        }
+        Dump();
+        return Status;
+    }
     uint64_t GetTotalLength() {
         return QuicRecvBufferGetTotalLength(&RecvBuf);
     }
@@ -70,6 +126,16 @@ struct RecvBuffer {
         Dump();
         return Status;
     }
+    QUIC_STATUS WriteExternal(
+        _In_ uint64_t WriteOffset,
+        _In_ uint16_t WriteLength,
+        _Inout_ uint64_t* WriteLimit
+        ) {
+        printf("WriteExternal: Offset=%llu, Length=%u\n", (unsigned long long)WriteOffset, WriteLength);
+        auto Status = QuicRecvBufferWriteExternal(&RecvBuf, WriteOffset, WriteLength, WriteLimit);
+        Dump();
+        return Status;
+    }
     void Read(
         _Out_ uint64_t* BufferOffset,
         _Inout_ uint32_t* BufferCount,
@@ -212,6 +278,74 @@ TEST_P(WithMode, AllocWithChunk)
     ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Initialize(GetParam(), true));
 }
 
+TEST_P(WithMode, AllocDeferred)
+{
+    RecvBuffer RecvBuf;
+    RecvBuf.InitializeDeferred(GetParam());
+    ASSERT_TRUE(CxPlatListIsEmpty(&RecvBuf.RecvBuf.Chunks));
+    ASSERT_EQ(0ull, RecvBuf.GetTotalLength());
+    ASSERT_FALSE(RecvBuf.HasUnreadData());
+
+    //
+    // The first write allocates the chunk.
+    //
+    uint64_t InOutWriteLength = DEF_TEST_BUFFER_LENGTH;
+    BOOLEAN NewDataReady = FALSE;
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Write(0, 30, &InOutWriteLength, &NewDataReady));
+    ASSERT_TRUE(NewDataReady);
+    ASSERT_FALSE(CxPlatListIsEmpty(&RecvBuf.RecvBuf.Chunks));
+    QUIC_RECV_CHUNK* Chunk =
+        CXPLAT_CONTAINING_RECORD(RecvBuf.RecvBuf.Chunks.Flink, QUIC_RECV_CHUNK, Link);
+    ASSERT_EQ((uint32_t)DEF_TEST_BUFFER_LENGTH, Chunk->AllocLength);
+
+    uint64_t ReadOffset;
+    QUIC_BUFFER ReadBuffers[3];
+    uint32_t BufferCount = ARRAYSIZE(ReadBuffers);
+    RecvBuf.Read(&ReadOffset, &BufferCount, ReadBuffers);
+    ASSERT_EQ(0ull, ReadOffset);
+    ASSERT_EQ(1ul, BufferCount);
+    ASSERT_EQ(30u, ReadBuffers[0].Length);
+    ASSERT_TRUE(RecvBuf.Drain(30));
+}
+
+TEST_P(WithMode, Compact)
+{
+    RecvBuffer RecvBuf;
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Initialize(GetParam()));
+    uint64_t InOutWriteLength = DEF_TEST_BUFFER_LENGTH;
+    BOOLEAN NewDataReady = FALSE;
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Write(0, 30, &InOutWriteLength, &NewDataReady));
+
+    //
+    // Can't compact while data is buffered or being read.
+    //
+    ASSERT_FALSE(QuicRecvBufferCompact(&RecvBuf.RecvBuf));
+    uint64_t ReadOffset;
+    QUIC_BUFFER ReadBuffers[3];
+    uint32_t BufferCount = ARRAYSIZE(ReadBuffers);
+    RecvBuf.Read(&ReadOffset, &BufferCount, ReadBuffers);
+    ASSERT_FALSE(QuicRecvBufferCompact(&RecvBuf.RecvBuf));
+    ASSERT_TRUE(RecvBuf.Drain(30));
+
+    ASSERT_TRUE(QuicRecvBufferCompact(&RecvBuf.RecvBuf));
+    ASSERT_TRUE(CxPlatListIsEmpty(&RecvBuf.RecvBuf.Chunks));
+    ASSERT_FALSE(QuicRecvBufferCompact(&RecvBuf.RecvBuf));
+    ASSERT_EQ(30ull, RecvBuf.GetTotalLength());
+
+    //
+    // The next write picks up where the data left off.
+    //
+    InOutWriteLength = DEF_TEST_BUFFER_LENGTH;
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Write(30, 20, &InOutWriteLength, &NewDataReady));
+    ASSERT_TRUE(NewDataReady);
+    BufferCount = ARRAYSIZE(ReadBuffers);
+    RecvBuf.Read(&ReadOffset, &BufferCount, ReadBuffers);
+    ASSERT_EQ(30ull, ReadOffset);
+    ASSERT_EQ(1ul, BufferCount);
+    ASSERT_EQ(20u, ReadBuffers[0].Length);
+    ASSERT_TRUE(RecvBuf.Drain(20));
+}
+
 void TestSingleWriteRead(QUIC_RECV_BUF_MODE Mode, uint16_t WriteLength, uint64_t WriteOffset, uint64_t DrainLength)
 {
     RecvBuffer RecvBuf;
@@ -515,8 +649,18 @@ TEST_P(WithMode, MultiWriteLarge)
     RecvBuf.Read(&ReadOffset, &BufferCount, ReadBuffers);
     ASSERT_FALSE(RecvBuf.HasUnreadData());
     ASSERT_EQ(0ull, ReadOffset);
-    ASSERT_EQ(1u, BufferCount);
-    ASSERT_EQ(256u, ReadBuffers[0].Length);
+    if (Mode == QUIC_RECV_BUF_MODE_MULTIPLE) {
+        //
+        // Multiple mode chains new chunks instead of copying on growth.
+        //
+        ASSERT_EQ(3u, BufferCount);
+        ASSERT_EQ(64u, ReadBuffers[0].Length);
+        ASSERT_EQ(128u, ReadBuffers[1].Length);
+        ASSERT_EQ(64u, ReadBuffers[2].Length);
+    } else {
+        ASSERT_EQ(1u, BufferCount);
+        ASSERT_EQ(256u, ReadBuffers[0].Length);
+    }
     ASSERT_TRUE(RecvBuf.Drain(256));
     ASSERT_FALSE(RecvBuf.HasUnreadData());
 }
@@ -837,12 +981,12 @@ TEST(MultiRecvTest, GapCycleEdge)
     RecvBuf.Drain(12);
 }
 
-// Validate if resized and copying content to bigger chunk
+// Validate if grown by chaining a bigger chunk after the partially drained one
 // |0, 1, 2, 3, x, x, x, x] ReadStart:0, ReadLengt:4, Ext:0
 // |R, R, R, R, x, x, x, x] ReadStart:0, ReadLengt:4, Ext:1
 // |R, R, R, R, 4, 5, 6, 7] ReadStart:0, ReadLengt:8, Ext:1
 // |D, D, D, D, 4, 5, 6, 7] ReadStart:4, ReadLengt:4, Ext:0
-// [4, 5, 6, 7, 8, 9,10,11,12,13,14,15, ...] ReadStart:0, ReadLengt:12, Ext:0
+// |8, 9,10,11, 4, 5, 6, 7] [12,13,14,15, x, ...] ReadStart:4, ReadLength:8, Ext:0
 TEST(MultiRecvTest, PartialDrainGrow)
 {
     RecvBuffer RecvBuf;
@@ -859,24 +1003,27 @@ TEST(MultiRecvTest, PartialDrainGrow)
     RecvBuf.WriteAndCheck(4, 4, 0, 8, 1, ExternalReferences);
     // |D, D, D, D, 4, 5, 6, 7] ReadStart:4, ReadLengt:4, Ext:0
     RecvBuf.Drain(4);
-    // [4, 5, 6, 7, 8, 9,10,11,12,13,14,15, ...] ReadStart:0, ReadLengt:12, Ext:0
+    // |8, 9,10,11, 4, 5, 6, 7] [12,13,14,15, x, ...] ReadStart:4, ReadLength:8, Ext:0
     ExternalReferences[0] = FALSE;
-    RecvBuf.WriteAndCheck(8, 8, 0, 12, 1, ExternalReferences);
+    RecvBuf.WriteAndCheck(8, 8, 4, 8, 2, ExternalReferences);
 
-    LengthList[0] = 12;
+    LengthList[0] = 4;
+    LengthList[1] = 4;
+    LengthList[2] = 4;
     ExternalReferences[0] = TRUE;
-    RecvBuf.ReadAndCheck(1, LengthList, 0, 12, 1, ExternalReferences);
+    ExternalReferences[1] = TRUE;
+    RecvBuf.ReadAndCheck(3, LengthList, 4, 8, 2, ExternalReferences);
     RecvBuf.Drain(12);
 }
 
-// Validate if resized and copying content to bigger chunk
+// Validate if grown by chaining a bigger chunk after the partially drained one
 // [0, 1, 2, 3, x, x, x, x] ReadStart:0, ReadLengt:4, Ext:0
 // |R, R, R, R, x, x, x, x| ReadStart:0, ReadLength:4, Ext:1
 // [R, R, R, R, 4, 5, 6, 7] ReadStart:0, ReadLengt:8, Ext:1
 // [D, D, D, D, 4, 5, 6, 7] ReadStart:4, ReadLengt:4, Ext:0
 // [8, G, G,11, 4, 5, 6, 7] ReadStart:4, ReadLengt:5, Ext:0
-// [4, 5, 6, 7, 8, G, G,11,12,13,14,15, ...] ReadStart:0, ReadLengt:5, Ext:0
-// [4, 5, 6, 7, 8, 9,10,11,12,13,14,15, ...] ReadStart:0, ReadLengt:12, Ext:0
+// |8, G, G,11, 4, 5, 6, 7] [12,13,14,15, x, ...] ReadStart:4, ReadLength:5, Ext:0
+// |8, 9,10,11, 4, 5, 6, 7] [12,13,14,15, x, ...] ReadStart:4, ReadLength:8, Ext:0
 TEST(MultiRecvTest, PartialDrainGapGrow)
 {
     RecvBuffer RecvBuf;
@@ -897,25 +1044,28 @@ TEST(MultiRecvTest, PartialDrainGapGrow)
     // [8, G, G,11, 4, 5, 6, 7] ReadStart:4, ReadLengt:5, Ext:0
     RecvBuf.WriteAndCheck(8, 1, 4, 5, 1, ExternalReferences);
     RecvBuf.WriteAndCheck(11, 1, 4, 5, 1, ExternalReferences);
-    // [4, 5, 6, 7, 8, G, G,11,12,13,14,15, ...] ReadStart:0, ReadLengt:5, Ext:0
-    RecvBuf.WriteAndCheck(12, 4, 0, 5, 1, ExternalReferences);
-    // [4, 5, 6, 7, 8, 9,10,11,12,13,14,15, ...] ReadStart:0, ReadLengt:12, Ext:0
-    RecvBuf.WriteAndCheck(9, 2, 0, 12, 1, ExternalReferences);
+    // |8, G, G,11, 4, 5, 6, 7] [12,13,14,15, x, ...] ReadStart:4, ReadLength:5, Ext:0
+    RecvBuf.WriteAndCheck(12, 4, 4, 5, 2, ExternalReferences);
+    // |8, 9,10,11, 4, 5, 6, 7] [12,13,14,15, x, ...] ReadStart:4, ReadLength:8, Ext:0
+    RecvBuf.WriteAndCheck(9, 2, 4, 8, 2, ExternalReferences);
 
-    LengthList[0] = 12;
+    LengthList[0] = 4;
+    LengthList[1] = 4;
+    LengthList[2] = 4;
     ExternalReferences[0] = TRUE;
-    RecvBuf.ReadAndCheck(1, LengthList, 0, 12, 1, ExternalReferences);
+    ExternalReferences[1] = TRUE;
+    RecvBuf.ReadAndCheck(3, LengthList, 4, 8, 2, ExternalReferences);
     RecvBuf.Drain(12);
 }
 
-// Validate if resized and copying content to bigger chunk
+// Validate if grown by chaining a bigger chunk after the partially drained one
 // |0, 1, 2, 3, x, x, x, x| ReadStart:0, ReadLength:4, Ext:1
 // |R, R, R, R, x, x, x, x| ReadStart:0, ReadLength:4, Ext:1
 // |R, R, R, R, 4, 5, 6, x| ReadStart:0, ReadLength:7, Ext:1
 // |D, D, D, D, 4, 5, 6, x] ReadStart:4, ReadLength:3, Ext:0
 // |G, 9,10,11, 4, 5, 6, G] ReadStart:4, ReadLength:3, Ext:0
-// [4, 5, 6, G, G, 9,10,11,12,13,14,15, ...] ReadStart:0, ReadLength:3,  Ext:0
-// [4, 5, 6, 7, 8, 9,10,11,12,13,14,15, ...] ReadStart:0, ReadLength:12, Ext:0
+// |G, 9,10,11, 4, 5, 6, G] [12,13,14,15, x, ...] ReadStart:4, ReadLength:3, Ext:0
+// |8, 9,10,11, 4, 5, 6, 7] [12,13,14,15, x, ...] ReadStart:4, ReadLength:8, Ext:0
 TEST(MultiRecvTest, PartialDrainGapEdgeGrow)
 {
     RecvBuffer RecvBuf;
@@ -935,24 +1085,27 @@ TEST(MultiRecvTest, PartialDrainGapEdgeGrow)
     ExternalReferences[0] = FALSE;
     // |G, 9,10,11, 4, 5, 6, G] ReadStart:4, ReadLength:3, Ext:0
     RecvBuf.WriteAndCheck(9, 3, 4, 3, 1, ExternalReferences);
-    // [4, 5, 6, G, G, 9,10,11,12,13,14,15, ...] ReadStart:0, ReadLength:3,  Ext:0
-    RecvBuf.WriteAndCheck(12, 4, 0, 3, 1, ExternalReferences);
-    // [4, 5, 6, 7, 8, 9,10,11,12,13,14,15, ...] ReadStart:0, ReadLength:12, Ext:0
-    RecvBuf.WriteAndCheck(7, 2, 0, 12, 1, ExternalReferences);
+    // |G, 9,10,11, 4, 5, 6, G] [12,13,14,15, x, ...] ReadStart:4, ReadLength:3, Ext:0
+    RecvBuf.WriteAndCheck(12, 4, 4, 3, 2, ExternalReferences);
+    // |8, 9,10,11, 4, 5, 6, 7] [12,13,14,15, x, ...] ReadStart:4, ReadLength:8, Ext:0
+    RecvBuf.WriteAndCheck(7, 2, 4, 8, 2, ExternalReferences);
 
-    LengthList[0] = 12;
+    LengthList[0] = 4;
+    LengthList[1] = 4;
+    LengthList[2] = 4;
     ExternalReferences[0] = TRUE;
-    RecvBuf.ReadAndCheck(1, LengthList, 0, 12, 1, ExternalReferences);
+    ExternalReferences[1] = TRUE;
+    RecvBuf.ReadAndCheck(3, LengthList, 4, 8, 2, ExternalReferences);
     RecvBuf.Drain(12);
 }
 
-// Validate if resized and copying content to bigger chunk
+// Validate if grown by chaining a bigger chunk after the partially drained one
 // |0, 1, 2, 3, x, x, x, x| ReadStart:0, ReadLength:4, Ext:0
 // |R, R, R, R, 4, 5, 6, 7| ReadStart:0, ReadLength:8, Ext:1
 // |D, D, D, D, 4, 5, 6, 7] ReadStart:4, ReadLength:4, Ext:0
 // |8, 9,10, D, 4, 5, 6, 7] ReadStart:4, ReadLength:7, Ext:0
-// [4, 5, 6, 7, 8, 9,10, G, G,13,14,15, ...] ReadStart:0, ReadLength:7,  Ext:0
-// [4, 5, 6, 7, 8, 9,10,11,12,13,14,15, ...] ReadStart:0, ReadLength:12, Ext:0
+// |8, 9,10, G, 4, 5, 6, 7] [G,13,14,15, x, ...] ReadStart:4, ReadLength:7, Ext:0
+// |8, 9,10,11, 4, 5, 6, 7] [12,13,14,15, x, ...] ReadStart:4, ReadLength:8, Ext:0
 TEST(MultiRecvTest, PartialDrainGapCycleEdgeGrow)
 {
     RecvBuffer RecvBuf;
@@ -972,14 +1125,17 @@ TEST(MultiRecvTest, PartialDrainGapCycleEdgeGrow)
     ExternalReferences[0] = FALSE;
     // |8, 9,10, D, 4, 5, 6, 7] ReadStart:4, ReadLength:7, Ext:0
     RecvBuf.WriteAndCheck(8, 3, 4, 7, 1, ExternalReferences);
-    // [4, 5, 6, 7, 8, 9,10, G, G,13,14,15, ...] ReadStart:0, ReadLength:7,  Ext:0
-    RecvBuf.WriteAndCheck(13, 3, 0, 7, 1, ExternalReferences);
-    // [4, 5, 6, 7, 8, 9,10,11,12,13,14,15, ...] ReadStart:0, ReadLength:12, Ext:0
-    RecvBuf.WriteAndCheck(11, 2, 0, 12, 1, ExternalReferences);
+    // |8, 9,10, G, 4, 5, 6, 7] [G,13,14,15, x, ...] ReadStart:4, ReadLength:7, Ext:0
+    RecvBuf.WriteAndCheck(13, 3, 4, 7, 2, ExternalReferences);
+    // |8, 9,10,11, 4, 5, 6, 7] [12,13,14,15, x, ...] ReadStart:4, ReadLength:8, Ext:0
+    RecvBuf.WriteAndCheck(11, 2, 4, 8, 2, ExternalReferences);
 
-    LengthList[0] = 12;
+    LengthList[0] = 4;
+    LengthList[1] = 4;
+    LengthList[2] = 4;
     ExternalReferences[0] = TRUE;
-    RecvBuf.ReadAndCheck(1, LengthList, 0, 12, 1, ExternalReferences);
+    ExternalReferences[1] = TRUE;
+    RecvBuf.ReadAndCheck(3, LengthList, 4, 8, 2, ExternalReferences);
     RecvBuf.Drain(12);
 }
 
@@ -1379,33 +1535,45 @@ TEST(MultiRecvTest, Grow1stChunk)
 {
     RecvBuffer RecvBuf;
     ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Initialize(QUIC_RECV_BUF_MODE_MULTIPLE, false, 8, LARGE_TEST_BUFFER_LENGTH));
-    BOOLEAN ExternalReferences[] = {FALSE, FALSE};
-    uint32_t LengthList[] = {160, 0, 0};
+    BOOLEAN ExternalReferences[] = {FALSE, FALSE, FALSE, FALSE, FALSE};
+    uint32_t LengthList[] = {8, 16, 32};
     RecvBuf.WriteAndCheck(0, 4, 0, 4, 1, ExternalReferences);
-    RecvBuf.WriteAndCheck(4, 8, 0, 12, 1, ExternalReferences); // grow -> 16
-    RecvBuf.WriteAndCheck(12, 16, 0, 28, 1, ExternalReferences); // grow -> 32
-    RecvBuf.WriteAndCheck(28, 32, 0, 60, 1, ExternalReferences); // grow -> 64
-    RecvBuf.WriteAndCheck(60, 100, 0, 160, 1, ExternalReferences); // grow -> 256
+    RecvBuf.WriteAndCheck(4, 8, 0, 8, 2, ExternalReferences); // chain 16
+    RecvBuf.WriteAndCheck(12, 16, 0, 8, 3, ExternalReferences); // chain 32
+    RecvBuf.WriteAndCheck(28, 32, 0, 8, 4, ExternalReferences); // chain 64
+    RecvBuf.WriteAndCheck(60, 100, 0, 8, 5, ExternalReferences); // chain 256
+    ExternalReferences[0] = TRUE;
+    ExternalReferences[1] = TRUE;
+    ExternalReferences[2] = TRUE;
+    RecvBuf.ReadAndCheck(3, LengthList, 0, 8, 5, ExternalReferences);
+    RecvBuf.Drain(56);
     ExternalReferences[0] = TRUE;
-    RecvBuf.ReadAndCheck(1, LengthList, 0, 160, 1, ExternalReferences);
-    RecvBuf.Drain(160);
+    ExternalReferences[1] = TRUE;
+    LengthList[0] = 64;
+    LengthList[1] = 40;
+    RecvBuf.ReadAndCheck(2, LengthList, 0, 64, 2, ExternalReferences);
+    RecvBuf.Drain(104);
 }
 
 TEST(MultiRecvTest, Grow2ndChunk)
 {
     RecvBuffer RecvBuf;
     ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Initialize(QUIC_RECV_BUF_MODE_MULTIPLE, false, 8, LARGE_TEST_BUFFER_LENGTH));
-    BOOLEAN ExternalReferences[] = {FALSE, FALSE};
+    BOOLEAN ExternalReferences[] = {FALSE, FALSE, FALSE, FALSE};
     uint32_t LengthList[] = {8, 0, 0};
     RecvBuf.WriteAndCheck(0, 8, 0, 8, 1, ExternalReferences);
     ExternalReferences[0] = TRUE;
     RecvBuf.ReadAndCheck(1, LengthList, 0, 8, 1, ExternalReferences);
-    RecvBuf.WriteAndCheck(8, 8, 0, 8, 2, ExternalReferences); // append -> 16
-    RecvBuf.WriteAndCheck(16, 16, 0, 8, 2, ExternalReferences); // grow -> 32
-    RecvBuf.WriteAndCheck(32, 64, 0, 8, 2, ExternalReferences); // grow -> 128
+    RecvBuf.WriteAndCheck(8, 8, 0, 8, 2, ExternalReferences); // chain 16
+    RecvBuf.WriteAndCheck(16, 16, 0, 8, 3, ExternalReferences); // chain 32
+    RecvBuf.WriteAndCheck(32, 64, 0, 8, 4, ExternalReferences); // chain 128
     ExternalReferences[1] = TRUE;
-    LengthList[0] = 88;
-    RecvBuf.ReadAndCheck(1, LengthList, 0, 8, 2, ExternalReferences);
+    ExternalReferences[2] = TRUE;
+    ExternalReferences[3] = TRUE;
+    LengthList[0] = 16;
+    LengthList[1] = 32;
+    LengthList[2] = 40;
+    RecvBuf.ReadAndCheck(3, LengthList, 0, 8, 4, ExternalReferences);
     RecvBuf.Drain(96);
 }
 
@@ -1413,20 +1581,22 @@ TEST(MultiRecvTest, Grow3rdChunk)
 {
     RecvBuffer RecvBuf;
     ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Initialize(QUIC_RECV_BUF_MODE_MULTIPLE, false, 8, LARGE_TEST_BUFFER_LENGTH));
-    BOOLEAN ExternalReferences[] = {FALSE, FALSE, FALSE};
+    BOOLEAN ExternalReferences[] = {FALSE, FALSE, FALSE, FALSE};
     uint32_t LengthList[] = {8, 0, 0};
     RecvBuf.WriteAndCheck(0, 8, 0, 8, 1, ExternalReferences);
     ExternalReferences[0] = TRUE;
     RecvBuf.ReadAndCheck(1, LengthList, 0, 8, 1, ExternalReferences);
-    RecvBuf.WriteAndCheck(8, 32, 0, 8, 2, ExternalReferences); // append -> 32
+    RecvBuf.WriteAndCheck(8, 32, 0, 8, 2, ExternalReferences); // chain 32
     LengthList[0] = 32;
     ExternalReferences[1] = TRUE;
     RecvBuf.ReadAndCheck(1, LengthList, 0, 8, 2, ExternalReferences);
-    RecvBuf.WriteAndCheck(40, 64, 0, 8, 3, ExternalReferences); // append -> 64
-    RecvBuf.WriteAndCheck(104, 20, 0, 8, 3, ExternalReferences); // grow -> 128
+    RecvBuf.WriteAndCheck(40, 64, 0, 8, 3, ExternalReferences); // chain 64
+    RecvBuf.WriteAndCheck(104, 20, 0, 8, 4, ExternalReferences); // chain 128
     ExternalReferences[2] = TRUE;
-    LengthList[0] = 84;
-    RecvBuf.ReadAndCheck(1, LengthList, 0, 8, 3, ExternalReferences);
+    ExternalReferences[3] = TRUE;
+    LengthList[0] = 64;
+    LengthList[1] = 20;
+    RecvBuf.ReadAndCheck(2, LengthList, 0, 8, 4, ExternalReferences);
     RecvBuf.Drain(124);
 }
 
@@ -1451,6 +1621,204 @@ TEST(MultiRecvTest, ReadPendingOver2Chunk)
     RecvBuf.Drain(8);
 }
 
+TEST(MultiRecvTest, PooledChunksChain)
+{
+    RecvBuffer RecvBuf;
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Initialize(QUIC_RECV_BUF_MODE_MULTIPLE, false, 0x1000, 0x20000, true));
+    BOOLEAN ExternalReferences[] = {FALSE, FALSE, FALSE, FALSE};
+    uint32_t LengthList[] = {0x1000, 0x2000, 0x4000};
+    for (uint32_t i = 0; i < 8; ++i) {
+        uint64_t InOutWriteLength = 0x20000;
+        BOOLEAN NewDataReady = FALSE;
+        ASSERT_EQ(
+            QUIC_STATUS_SUCCESS,
+            RecvBuf.Write(i * 0x1000, 0x1000, &InOutWriteLength, &NewDataReady));
+        uint32_t NumChunks = i == 0 ? 1 : (i < 3 ? 2 : (i < 7 ? 3 : 4));
+        RecvBuf.Check(0, 0x1000, NumChunks, ExternalReferences);
+    }
+    ExternalReferences[0] = TRUE;
+    ExternalReferences[1] = TRUE;
+    ExternalReferences[2] = TRUE;
+    RecvBuf.ReadAndCheck(3, LengthList, 0, 0x1000, 4, ExternalReferences);
+    ASSERT_TRUE(RecvBuf.Drain(0x7000));
+    ExternalReferences[0] = TRUE;
+    LengthList[0] = 0x1000;
+    RecvBuf.ReadAndCheck(1, LengthList, 0, 0x1000, 1, ExternalReferences);
+    ASSERT_TRUE(RecvBuf.Drain(0x1000));
+    QUIC_RECV_CHUNK* Chunk =
+        CXPLAT_CONTAINING_RECORD(RecvBuf.RecvBuf.Chunks.Flink, QUIC_RECV_CHUNK, Link);
+    ASSERT_EQ(0x8000u, Chunk->AllocLength);
+}
+
+TEST(AppOwnedRecvTest, WriteWithoutChunks)
+{
+    RecvBuffer RecvBuf;
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Initialize(QUIC_RECV_BUF_MODE_APP_OWNED, false, 0, DEF_TEST_BUFFER_LENGTH));
+    uint64_t InOutWriteLength = DEF_TEST_BUFFER_LENGTH;
+    BOOLEAN NewDataReady = FALSE;
+    ASSERT_EQ(
+        QUIC_STATUS_OUT_OF_MEMORY,
+        RecvBuf.Write(0, 8, &InOutWriteLength, &NewDataReady));
+    ASSERT_FALSE(RecvBuf.HasUnreadData());
+    ASSERT_EQ(0ull, RecvBuf.GetTotalLength());
+}
+
+TEST(AppOwnedRecvTest, WriteBeyondChunks)
+{
+    RecvBuffer RecvBuf;
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Initialize(QUIC_RECV_BUF_MODE_APP_OWNED, false, 0, DEF_TEST_BUFFER_LENGTH));
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.ProvideChunks(2, 8));
+    uint64_t InOutWriteLength = DEF_TEST_BUFFER_LENGTH;
+    BOOLEAN NewDataReady = FALSE;
+    ASSERT_EQ(
+        QUIC_STATUS_OUT_OF_MEMORY,
+        RecvBuf.Write(10, 8, &InOutWriteLength, &NewDataReady));
+    ASSERT_EQ(0ull, RecvBuf.GetTotalLength());
+    InOutWriteLength = DEF_TEST_BUFFER_LENGTH;
+    ASSERT_EQ(
+        QUIC_STATUS_SUCCESS,
+        RecvBuf.Write(8, 8, &InOutWriteLength, &NewDataReady));
+    ASSERT_EQ(16ull, RecvBuf.GetTotalLength());
+    ASSERT_FALSE(NewDataReady);
+}
+
+TEST(AppOwnedRecvTest, WriteAcrossChunks)
+{
+    RecvBuffer RecvBuf;
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Initialize(QUIC_RECV_BUF_MODE_APP_OWNED, false, 0, DEF_TEST_BUFFER_LENGTH));
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.ProvideChunks(3, 8));
+    BOOLEAN ExternalReferences[] = {FALSE, FALSE, FALSE};
+    uint32_t LengthList[] = {8, 8, 4};
+    RecvBuf.WriteAndCheck(0, 20, 0, 0, 3, ExternalReferences);
+    ExternalReferences[0] = ExternalReferences[1] = ExternalReferences[2] = TRUE;
+    RecvBuf.ReadAndCheck(3, LengthList, 0, 0, 3, ExternalReferences);
+    ASSERT_FALSE(RecvBuf.HasUnreadData());
+
+    //
+    // Draining releases fully consumed chunks back to the app.
+    //
+    ASSERT_TRUE(RecvBuf.Drain(12));
+    ExternalReferences[0] = TRUE;
+    RecvBuf.Check(4, 0, 2, ExternalReferences);
+    ASSERT_EQ(12ull, RecvBuf.RecvBuf.BaseOffset);
+    ASSERT_EQ(12u, RecvBuf.RecvBuf.Capacity);
+    ASSERT_TRUE(RecvBuf.Drain(8));
+    ExternalReferences[0] = FALSE;
+    RecvBuf.Check(4, 0, 1, ExternalReferences);
+    ASSERT_EQ(4u, RecvBuf.RecvBuf.Capacity);
+}
+
+TEST(AppOwnedRecvTest, ReadLimitedByBufferCount)
+{
+    RecvBuffer RecvBuf;
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Initialize(QUIC_RECV_BUF_MODE_APP_OWNED, false, 0, DEF_TEST_BUFFER_LENGTH));
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.ProvideChunks(4, 4));
+    BOOLEAN ExternalReferences[] = {FALSE, FALSE, FALSE, FALSE};
+    RecvBuf.WriteAndCheck(0, 16, 0, 0, 4, ExternalReferences);
+
+    uint64_t ReadOffset;
+    QUIC_BUFFER ReadBuffers[3];
+    uint32_t BufferCount = ARRAYSIZE(ReadBuffers);
+    RecvBuf.Read(&ReadOffset, &BufferCount, ReadBuffers);
+    ASSERT_EQ(0ull, ReadOffset);
+    ASSERT_EQ(3u, BufferCount);
+    ASSERT_TRUE(RecvBuf.HasUnreadData());
+
+    BufferCount = ARRAYSIZE(ReadBuffers);
+    RecvBuf.Read(&ReadOffset, &BufferCount, ReadBuffers);
+    ASSERT_EQ(12ull, ReadOffset);
+    ASSERT_EQ(1u, BufferCount);
+    ASSERT_EQ(4u, ReadBuffers[0].Length);
+    ASSERT_FALSE(RecvBuf.HasUnreadData());
+    ASSERT_TRUE(RecvBuf.Drain(16));
+}
+
+TEST(AppOwnedRecvTest, ProvideGrowsVirtualLength)
+{
+    RecvBuffer RecvBuf;
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Initialize(QUIC_RECV_BUF_MODE_APP_OWNED, false, 0, 16));
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.ProvideChunks(1, 8));
+    ASSERT_EQ(16u, RecvBuf.RecvBuf.VirtualBufferLength);
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.ProvideChunks(2, 8));
+    ASSERT_EQ(24u, RecvBuf.RecvBuf.VirtualBufferLength);
+
+    BOOLEAN ExternalReferences[] = {FALSE, FALSE, FALSE};
+    uint32_t LengthList[] = {8, 0, 0};
+    RecvBuf.WriteAndCheck(0, 8, 0, 0, 3, ExternalReferences);
+    ExternalReferences[0] = TRUE;
+    RecvBuf.ReadAndCheck(1, LengthList, 0, 0, 3, ExternalReferences);
+    ASSERT_TRUE(RecvBuf.Drain(8));
+
+    //
+    // The drained space is returned to the app and is no longer part of the
+    // window, so the limit on the absolute offset doesn't move.
+    //
+    ASSERT_EQ(16u, RecvBuf.RecvBuf.VirtualBufferLength);
+    ASSERT_EQ(24ull, RecvBuf.RecvBuf.BaseOffset + RecvBuf.RecvBuf.VirtualBufferLength);
+}
+
+void TestZeroCopyWrite(QUIC_RECV_BUF_MODE Mode)
+{
+    RecvBuffer RecvBuf;
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Initialize(Mode));
+
+    //
+    // Bytes written externally are immediately considered drained.
+    //
+    uint64_t InOutWriteLength = LARGE_TEST_BUFFER_LENGTH;
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.WriteExternal(0, 20, &InOutWriteLength));
+    ASSERT_EQ(20ull, InOutWriteLength);
+    ASSERT_EQ(20ull, RecvBuf.GetTotalLength());
+    ASSERT_EQ(20ull, RecvBuf.RecvBuf.BaseOffset);
+    ASSERT_FALSE(RecvBuf.HasUnreadData());
+
+    //
+    // Regular writes continue right after the external data.
+    //
+    BOOLEAN NewDataReady = FALSE;
+    InOutWriteLength = LARGE_TEST_BUFFER_LENGTH;
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Write(20, 10, &InOutWriteLength, &NewDataReady));
+    ASSERT_TRUE(NewDataReady);
+    ASSERT_EQ(10ull, InOutWriteLength);
+    uint64_t ReadOffset;
+    QUIC_BUFFER ReadBuffers[3];
+    uint32_t BufferCount = ARRAYSIZE(ReadBuffers);
+    RecvBuf.Read(&ReadOffset, &BufferCount, ReadBuffers);
+    ASSERT_EQ(20ull, ReadOffset);
+    ASSERT_EQ(1u, BufferCount);
+    ASSERT_EQ(10u, ReadBuffers[0].Length);
+    ASSERT_TRUE(RecvBuf.Drain(10));
+
+    //
+    // Once drained, external writes can resume.
+    //
+    InOutWriteLength = LARGE_TEST_BUFFER_LENGTH;
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.WriteExternal(30, 30, &InOutWriteLength));
+    ASSERT_EQ(60ull, RecvBuf.RecvBuf.BaseOffset);
+    ASSERT_FALSE(RecvBuf.HasUnreadData());
+
+    //
+    // Flow control limits still apply.
+    //
+    InOutWriteLength = 10;
+    ASSERT_EQ(QUIC_STATUS_BUFFER_TOO_SMALL, RecvBuf.WriteExternal(60, 20, &InOutWriteLength));
+    InOutWriteLength = LARGE_TEST_BUFFER_LENGTH;
+    ASSERT_EQ(
+        QUIC_STATUS_BUFFER_TOO_SMALL,
+        RecvBuf.WriteExternal(60, DEF_TEST_BUFFER_LENGTH + 1, &InOutWriteLength));
+    ASSERT_EQ(60ull, RecvBuf.GetTotalLength());
+}
+
+TEST(ZeroCopyRecvTest, WriteExternalSingle)
+{
+    TestZeroCopyWrite(QUIC_RECV_BUF_MODE_SINGLE);
+}
+
+TEST(ZeroCopyRecvTest, WriteExternalCircular)
+{
+    TestZeroCopyWrite(QUIC_RECV_BUF_MODE_CIRCULAR);
+}
+
 INSTANTIATE_TEST_SUITE_P(
     RecvBufferTest,
     WithMode,
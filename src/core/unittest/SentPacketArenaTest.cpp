@@ -0,0 +1,123 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test for the sent packet metadata arena.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "SentPacketArenaTest.cpp.clog.h"
+#endif
+
+#include <deque>
+
+struct SentPacketArenaTest : public ::testing::Test
+{
+    QUIC_SENT_PACKET_ARENA Arena;
+
+    void SetUp() override {
+        QuicSentPacketArenaInitialize(&Arena);
+    }
+
+    void TearDown() override {
+        QuicSentPacketArenaUninitialize(&Arena);
+    }
+
+    QUIC_SENT_PACKET_METADATA* Alloc(uint8_t FrameCount, uint64_t PacketNumber) {
+        QUIC_SENT_PACKET_METADATA* Metadata =
+            QuicSentPacketArenaGetPacketMetadata(&Arena, FrameCount);
+        if (Metadata != nullptr) {
+            Metadata->PacketNumber = PacketNumber;
+            Metadata->FrameCount = FrameCount;
+        }
+        return Metadata;
+    }
+};
+
+TEST_F(SentPacketArenaTest, InOrder)
+{
+    ASSERT_EQ(nullptr, Arena.Buffer);
+    auto First = Alloc(1, 0);
+    auto Second = Alloc(QUIC_MAX_FRAMES_PER_PACKET, 1);
+    ASSERT_NE(nullptr, First);
+    ASSERT_NE(nullptr, Second);
+    ASSERT_NE(nullptr, Arena.Buffer);
+    ASSERT_EQ(0ull, First->PacketNumber);
+    ASSERT_EQ(1ull, Second->PacketNumber);
+
+    QuicSentPacketArenaReturnPacketMetadata(&Arena, First);
+    ASSERT_NE(0u, Arena.Used);
+    QuicSentPacketArenaReturnPacketMetadata(&Arena, Second);
+    ASSERT_EQ(0u, Arena.Used);
+
+    ASSERT_TRUE(QuicSentPacketArenaTrim(&Arena));
+    ASSERT_EQ(nullptr, Arena.Buffer);
+    ASSERT_FALSE(QuicSentPacketArenaTrim(&Arena));
+}
+
+TEST_F(SentPacketArenaTest, OutOfOrder)
+{
+    auto First = Alloc(2, 0);
+    auto Second = Alloc(2, 1);
+    auto Third = Alloc(2, 2);
+    const uint32_t Used = Arena.Used;
+
+    //
+    // Nothing is reclaimed until the oldest packet is freed.
+    //
+    QuicSentPacketArenaReturnPacketMetadata(&Arena, Third);
+    QuicSentPacketArenaReturnPacketMetadata(&Arena, Second);
+    ASSERT_EQ(Used, Arena.Used);
+    ASSERT_FALSE(QuicSentPacketArenaTrim(&Arena));
+
+    QuicSentPacketArenaReturnPacketMetadata(&Arena, First);
+    ASSERT_EQ(0u, Arena.Used);
+}
+
+TEST_F(SentPacketArenaTest, FullAndWrap)
+{
+    //
+    // Fill the arena completely.
+    //
+    std::deque<QUIC_SENT_PACKET_METADATA*> Packets;
+    uint64_t PacketNumber = 0;
+    QUIC_SENT_PACKET_METADATA* Metadata;
+    while ((Metadata = Alloc(3, PacketNumber)) != nullptr) {
+        Packets.push_back(Metadata);
+        PacketNumber++;
+    }
+    ASSERT_GT(Packets.size(), 1u);
+
+    //
+    // Keep freeing the oldest packet and sending a (differently sized) new one
+    // so that the arena wraps around several times.
+    //
+    for (uint32_t i = 0; i < 4 * Packets.size(); ++i) {
+        QuicSentPacketArenaReturnPacketMetadata(&Arena, Packets.front());
+        Packets.pop_front();
+        while ((Metadata = Alloc(1 + (PacketNumber % 4), PacketNumber)) != nullptr) {
+            Packets.push_back(Metadata);
+            PacketNumber++;
+        }
+    }
+
+    //
+    // All the packets are still intact.
+    //
+    uint64_t Expected = Packets.front()->PacketNumber;
+    for (auto Packet : Packets) {
+        ASSERT_EQ(Expected++, Packet->PacketNumber);
+        ASSERT_EQ(1 + (Packet->PacketNumber % 4), Packet->FrameCount);
+    }
+
+    while (!Packets.empty()) {
+        QuicSentPacketArenaReturnPacketMetadata(&Arena, Packets.front());
+        Packets.pop_front();
+    }
+    ASSERT_EQ(0u, Arena.Used);
+}
@@ -125,6 +125,13 @@ TEST(SettingsTest, TestAllSettingsFieldsSet)
     SETTINGS_FEATURE_SET_TEST(OneWayDelayEnabled, QuicSettingsSettingsToInternal);
     SETTINGS_FEATURE_SET_TEST(NetStatsEventEnabled, QuicSettingsSettingsToInternal);
     SETTINGS_FEATURE_SET_TEST(StreamMultiReceiveEnabled, QuicSettingsSettingsToInternal);
+    SETTINGS_FEATURE_SET_TEST(CarefulResumeEnabled, QuicSettingsSettingsToInternal);
+    SETTINGS_FEATURE_SET_TEST(NetStatsEventThreshold, QuicSettingsSettingsToInternal);
+    SETTINGS_FEATURE_SET_TEST(HibernateTimeoutMs, QuicSettingsSettingsToInternal);
+    SETTINGS_FEATURE_SET_TEST(ReleaseHandshakeStateEnabled, QuicSettingsSettingsToInternal);
+    SETTINGS_FEATURE_SET_TEST(ResumptionTicketCacheEnabled, QuicSettingsSettingsToInternal);
+    SETTINGS_FEATURE_SET_TEST(EarlyCreditWindow, QuicSettingsSettingsToInternal);
+    SETTINGS_FEATURE_SET_TEST(AdaptiveAckDelayEnabled, QuicSettingsSettingsToInternal);
 
     Settings.IsSetFlags = 0;
     Settings.IsSet.RESERVED = ~Settings.IsSet.RESERVED;
@@ -140,6 +147,7 @@ TEST(SettingsTest, TestAllGlobalSettingsFieldsSet)
     SETTINGS_FEATURE_SET_TEST(RetryMemoryLimit, QuicSettingsGlobalSettingsToInternal);
     SETTINGS_FEATURE_SET_TEST(LoadBalancingMode, QuicSettingsGlobalSettingsToInternal);
     SETTINGS_FEATURE_SET_TEST(FixedServerID, QuicSettingsGlobalSettingsToInternal);
+    SETTINGS_FEATURE_SET_TEST(ConnectionPoolPrewarmCount, QuicSettingsGlobalSettingsToInternal);
 
     Settings.IsSetFlags = 0;
     Settings.IsSet.RESERVED = ~Settings.IsSet.RESERVED;
@@ -211,6 +219,13 @@ TEST(SettingsTest, TestAllSettingsFieldsGet)
     SETTINGS_FEATURE_GET_TEST(OneWayDelayEnabled, QuicSettingsGetSettings);
     SETTINGS_FEATURE_GET_TEST(NetStatsEventEnabled, QuicSettingsGetSettings);
     SETTINGS_FEATURE_GET_TEST(StreamMultiReceiveEnabled, QuicSettingsGetSettings);
+    SETTINGS_FEATURE_GET_TEST(CarefulResumeEnabled, QuicSettingsGetSettings);
+    SETTINGS_FEATURE_GET_TEST(NetStatsEventThreshold, QuicSettingsGetSettings);
+    SETTINGS_FEATURE_GET_TEST(HibernateTimeoutMs, QuicSettingsGetSettings);
+    SETTINGS_FEATURE_GET_TEST(ReleaseHandshakeStateEnabled, QuicSettingsGetSettings);
+    SETTINGS_FEATURE_GET_TEST(ResumptionTicketCacheEnabled, QuicSettingsGetSettings);
+    SETTINGS_FEATURE_GET_TEST(EarlyCreditWindow, QuicSettingsGetSettings);
+    SETTINGS_FEATURE_GET_TEST(AdaptiveAckDelayEnabled, QuicSettingsGetSettings);
 
     Settings.IsSetFlags = 0;
     Settings.IsSet.RESERVED = ~Settings.IsSet.RESERVED;
@@ -227,6 +242,7 @@ TEST(SettingsTest, TestAllGlobalSettingsFieldsGet)
     SETTINGS_FEATURE_GET_TEST(RetryMemoryLimit, QuicSettingsGetGlobalSettings);
     SETTINGS_FEATURE_GET_TEST(LoadBalancingMode, QuicSettingsGetGlobalSettings);
     SETTINGS_FEATURE_GET_TEST(FixedServerID, QuicSettingsGetGlobalSettings);
+    SETTINGS_FEATURE_GET_TEST(ConnectionPoolPrewarmCount, QuicSettingsGetGlobalSettings);
 
     Settings.IsSetFlags = 0;
     Settings.IsSet.RESERVED = ~Settings.IsSet.RESERVED;
@@ -310,6 +326,73 @@ TEST(SettingsTest, StreamRecvWindowDefaultGetsOverridenByIndividualLimits)
     ASSERT_EQ(Destination.StreamRecvWindowUnidiDefault, Source.StreamRecvWindowUnidiDefault);
 }
 
+TEST(SettingsTest, NetStatsEventThresholdIsPercent)
+{
+    QUIC_SETTINGS_INTERNAL Source;
+    QUIC_SETTINGS_INTERNAL Destination;
+    CxPlatZeroMemory(&Source, sizeof(Source));
+    CxPlatZeroMemory(&Destination, sizeof(Destination));
+
+    Source.IsSet.NetStatsEventThreshold = 1;
+    Source.NetStatsEventThreshold = 101;
+    ASSERT_FALSE(QuicSettingApply(&Destination, TRUE, TRUE, &Source));
+    ASSERT_FALSE(Destination.IsSet.NetStatsEventThreshold);
+
+    Source.NetStatsEventThreshold = 10;
+    ASSERT_TRUE(QuicSettingApply(&Destination, TRUE, TRUE, &Source));
+    ASSERT_TRUE(Destination.IsSet.NetStatsEventThreshold);
+    ASSERT_EQ(Destination.NetStatsEventThreshold, 10);
+}
+
+TEST(SettingsTest, VersionSettingsSharedByCopies)
+{
+    const uint32_t Versions[] = { // External (little-endian) format
+        CxPlatByteSwapUint32(QUIC_VERSION_1),
+        CxPlatByteSwapUint32(QUIC_VERSION_2)
+    };
+    QUIC_VERSION_SETTINGS VersionSettings;
+    VersionSettings.AcceptableVersions = Versions;
+    VersionSettings.AcceptableVersionsLength = ARRAYSIZE(Versions);
+    VersionSettings.OfferedVersions = Versions;
+    VersionSettings.OfferedVersionsLength = ARRAYSIZE(Versions);
+    VersionSettings.FullyDeployedVersions = Versions;
+    VersionSettings.FullyDeployedVersionsLength = ARRAYSIZE(Versions);
+
+    QUIC_SETTINGS_INTERNAL Source;
+    CxPlatZeroMemory(&Source, sizeof(Source));
+    ASSERT_EQ(
+        QUIC_STATUS_SUCCESS,
+        QuicSettingsVersionSettingsToInternal(
+            sizeof(VersionSettings), &VersionSettings, &Source));
+    ASSERT_NE(nullptr, Source.VersionSettings);
+
+    QUIC_SETTINGS_INTERNAL Applied;
+    CxPlatZeroMemory(&Applied, sizeof(Applied));
+    ASSERT_TRUE(QuicSettingApply(&Applied, FALSE, TRUE, &Source));
+    ASSERT_EQ(Source.VersionSettings, Applied.VersionSettings);
+
+    QUIC_SETTINGS_INTERNAL Copied;
+    CxPlatZeroMemory(&Copied, sizeof(Copied));
+    QuicSettingsCopy(&Copied, &Source);
+    ASSERT_EQ(Source.VersionSettings, Copied.VersionSettings);
+
+    QUIC_SETTINGS_INTERNAL Inherited;
+    QuicSettingsInherit(&Inherited, &Source);
+    ASSERT_EQ(Source.VersionSettings, Inherited.VersionSettings);
+    ASSERT_EQ(0ull, Inherited.IsSetFlags);
+
+    //
+    // Each holds its own reference, so they can be cleaned up in any order.
+    //
+    QuicSettingsCleanup(&Source);
+    ASSERT_EQ(ARRAYSIZE(Versions), Applied.VersionSettings->OfferedVersionsLength);
+    ASSERT_EQ((uint32_t)QUIC_VERSION_2, Applied.VersionSettings->OfferedVersions[1]);
+    QuicSettingsCleanup(&Applied);
+    QuicSettingsCleanup(&Inherited);
+    ASSERT_EQ((uint32_t)QUIC_VERSION_1, Copied.VersionSettings->FullyDeployedVersions[0]);
+    QuicSettingsCleanup(&Copied);
+}
+
 // TEST(SettingsTest, TestAllVersionSettingsFieldsGet)
 // {
 //     QUIC_VERSION_SETTINGS Settings;
@@ -554,6 +637,107 @@ TEST(SettingsTest, GlobalLoadBalancingServerIDSet)
             &OldMode));
 }
 
+TEST(SettingsTest, GlobalLoadBalancingQuicLb)
+{
+    uint16_t Mode = QUIC_LOAD_BALANCING_SERVER_ID_QUIC_LB;
+    uint16_t OldMode = MsQuicLib.Settings.LoadBalancingMode;
+    CxPlatDispatchLockInitialize(&MsQuicLib.LoadBalancingLock);
+
+    QUIC_LOAD_BALANCING_CONFIG Config = {0};
+    Config.ConfigId = 2;
+    Config.ServerIdLength = 3;
+    Config.NonceLength = 4;
+    Config.EncodeLength = TRUE;
+    Config.ServerId[0] = 0xA1;
+    Config.ServerId[1] = 0xB2;
+    Config.ServerId[2] = 0xC3;
+
+    ASSERT_EQ(
+        QUIC_STATUS_SUCCESS,
+        QuicLibrarySetGlobalParam(
+            QUIC_PARAM_GLOBAL_LOAD_BALANCING_CONFIG,
+            sizeof(Config),
+            &Config));
+    ASSERT_EQ(
+        QUIC_STATUS_SUCCESS,
+        QuicLibrarySetGlobalParam(
+            QUIC_PARAM_GLOBAL_LOAD_BALACING_MODE,
+            sizeof(Mode),
+            &Mode));
+    ASSERT_EQ(1 + 3 + 4, MsQuicLib.CidServerIdLength);
+    ASSERT_EQ(QUIC_CID_PID_LENGTH + QUIC_CID_PAYLOAD_LENGTH + 1 + 3 + 4, MsQuicLib.CidTotalLength);
+
+    //
+    // Plaintext: config rotation bits and length, then the server ID.
+    //
+    uint8_t Cid[QUIC_MAX_CID_SID_LENGTH];
+    QuicLibraryEncodeLoadBalancingCid(Cid);
+    ASSERT_EQ((2 << 5) | (MsQuicLib.CidTotalLength - 1), Cid[0]);
+    ASSERT_EQ(0, memcmp(Cid + 1, Config.ServerId, 3));
+
+    //
+    // Encrypted: the rotation bits stay in the clear, and the random nonce
+    // changes the whole ciphertext.
+    //
+    Config.Encrypt = TRUE;
+    for (uint8_t i = 0; i < sizeof(Config.Key); ++i) {
+        Config.Key[i] = i;
+    }
+    ASSERT_EQ(
+        QUIC_STATUS_SUCCESS,
+        QuicLibrarySetGlobalParam(
+            QUIC_PARAM_GLOBAL_LOAD_BALANCING_CONFIG,
+            sizeof(Config),
+            &Config));
+    ASSERT_NE(nullptr, MsQuicLib.LoadBalancingKey);
+    uint8_t Cid2[QUIC_MAX_CID_SID_LENGTH];
+    QuicLibraryEncodeLoadBalancingCid(Cid);
+    QuicLibraryEncodeLoadBalancingCid(Cid2);
+    ASSERT_EQ(Cid[0], Cid2[0]);
+    ASSERT_EQ(2, Cid[0] >> 5);
+    ASSERT_NE(0, memcmp(Cid + 1, Cid2 + 1, 3 + 4));
+
+    //
+    // Invalid configs.
+    //
+    QUIC_LOAD_BALANCING_CONFIG Invalid = Config;
+    Invalid.ConfigId = 7;
+    ASSERT_EQ(
+        QUIC_STATUS_INVALID_PARAMETER,
+        QuicLibrarySetGlobalParam(
+            QUIC_PARAM_GLOBAL_LOAD_BALANCING_CONFIG,
+            sizeof(Invalid),
+            &Invalid));
+    Invalid = Config;
+    Invalid.NonceLength = QUIC_LOAD_BALANCING_MIN_NONCE_LENGTH - 1;
+    ASSERT_EQ(
+        QUIC_STATUS_INVALID_PARAMETER,
+        QuicLibrarySetGlobalParam(
+            QUIC_PARAM_GLOBAL_LOAD_BALANCING_CONFIG,
+            sizeof(Invalid),
+            &Invalid));
+    Invalid = Config;
+    Invalid.ServerIdLength = QUIC_MAX_CID_SID_LENGTH - QUIC_LOAD_BALANCING_MIN_NONCE_LENGTH;
+    ASSERT_EQ(
+        QUIC_STATUS_INVALID_PARAMETER,
+        QuicLibrarySetGlobalParam(
+            QUIC_PARAM_GLOBAL_LOAD_BALANCING_CONFIG,
+            sizeof(Invalid),
+            &Invalid));
+
+    // Revert
+    ASSERT_EQ(
+        QUIC_STATUS_SUCCESS,
+        QuicLibrarySetGlobalParam(
+            QUIC_PARAM_GLOBAL_LOAD_BALACING_MODE,
+            sizeof(OldMode),
+            &OldMode));
+    CxPlatHpKeyFree(MsQuicLib.LoadBalancingKey);
+    MsQuicLib.LoadBalancingKey = NULL;
+    MsQuicLib.LoadBalancingConfigSet = FALSE;
+    CxPlatDispatchLockUninitialize(&MsQuicLib.LoadBalancingLock);
+}
+
 #ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
 TEST(SettingsTest, GlobalExecutionConfigSetAndGet)
 {
@@ -0,0 +1,213 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test for the block framing of compressed streams.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "StreamCompressTest.cpp.clog.h"
+#endif
+
+#include <vector>
+
+//
+// A run-length codec, as a stand-in for the app's.
+//
+static
+QUIC_STATUS
+QUIC_API
+RleCompress(
+    _In_opt_ void* /* Context */,
+    _In_reads_bytes_(InputLength) const uint8_t* Input,
+    _In_ uint32_t InputLength,
+    _Out_writes_bytes_to_(*OutputLength, *OutputLength) uint8_t* Output,
+    _Inout_ uint32_t* OutputLength
+    )
+{
+    uint32_t Out = 0;
+    for (uint32_t i = 0; i < InputLength;) {
+        uint32_t Run = 1;
+        while (i + Run < InputLength && Run < 255 && Input[i + Run] == Input[i]) {
+            ++Run;
+        }
+        if (Out + 2 > *OutputLength) {
+            return QUIC_STATUS_BUFFER_TOO_SMALL;
+        }
+        Output[Out++] = (uint8_t)Run;
+        Output[Out++] = Input[i];
+        i += Run;
+    }
+    *OutputLength = Out;
+    return QUIC_STATUS_SUCCESS;
+}
+
+static
+QUIC_STATUS
+QUIC_API
+RleDecompress(
+    _In_opt_ void* /* Context */,
+    _In_reads_bytes_(InputLength) const uint8_t* Input,
+    _In_ uint32_t InputLength,
+    _Out_writes_bytes_(OutputLength) uint8_t* Output,
+    _In_ uint32_t OutputLength
+    )
+{
+    uint32_t Out = 0;
+    for (uint32_t i = 0; i + 1 < InputLength; i += 2) {
+        if (Out + Input[i] > OutputLength) {
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
+        memset(Output + Out, Input[i + 1], Input[i]);
+        Out += Input[i];
+    }
+    return
+        (InputLength % 2 == 0 && Out == OutputLength) ?
+            QUIC_STATUS_SUCCESS : QUIC_STATUS_INVALID_PARAMETER;
+}
+
+struct StreamCompressTest : public ::testing::Test
+{
+    QUIC_STREAM_COMPRESSION_CONFIG Config { 1, nullptr, RleCompress, RleDecompress };
+
+    static std::vector<uint8_t> MakeText(uint32_t Length) {
+        std::vector<uint8_t> Text(Length);
+        for (uint32_t i = 0; i < Length; ++i) {
+            Text[i] = (uint8_t)('a' + (i / 100) % 26); // Long runs.
+        }
+        return Text;
+    }
+
+    static std::vector<uint8_t> MakeNoise(uint32_t Length) {
+        std::vector<uint8_t> Noise(Length);
+        for (uint32_t i = 0; i < Length; ++i) {
+            Noise[i] = (uint8_t)(i * 7 + i / 3);
+        }
+        return Noise;
+    }
+
+    std::vector<uint8_t> Compress(const std::vector<QUIC_BUFFER>& Buffers) {
+        uint64_t TotalLength = 0;
+        for (auto& Buffer : Buffers) {
+            TotalLength += Buffer.Length;
+        }
+        std::vector<uint8_t> Encoded((size_t)QuicStreamCompressBound(TotalLength));
+        uint64_t EncodedLength = 0;
+        EXPECT_EQ(
+            QUIC_STATUS_SUCCESS,
+            QuicStreamCompress(
+                &Config,
+                Buffers.data(),
+                (uint32_t)Buffers.size(),
+                TotalLength,
+                Encoded.data(),
+                &EncodedLength));
+        EXPECT_LE(EncodedLength, Encoded.size());
+        Encoded.resize((size_t)EncodedLength);
+        return Encoded;
+    }
+
+    //
+    // Decodes all the blocks, with each one split over two buffers at Split
+    // (if it is in range), like the unread data of a circular receive buffer.
+    //
+    std::vector<uint8_t> Decompress(const std::vector<uint8_t>& Encoded, uint32_t Split = 0) {
+        std::vector<uint8_t> Decoded;
+        std::vector<uint8_t> Block(QUIC_STREAM_COMPRESSION_MAX_BLOCK);
+        size_t Offset = 0;
+        while (Offset < Encoded.size()) {
+            uint32_t Length = (uint32_t)(Encoded.size() - Offset);
+            uint32_t First = (Split != 0 && Split < Length) ? Split : Length;
+            QUIC_BUFFER Buffers[2] = {
+                { First, (uint8_t*)Encoded.data() + Offset },
+                { Length - First, (uint8_t*)Encoded.data() + Offset + First } };
+            uint32_t DecodedLength = 0, EncodedLength = 0;
+            EXPECT_EQ(
+                QUIC_STATUS_SUCCESS,
+                QuicStreamDecompress(
+                    &Config, Buffers, 2, Block.data(), &DecodedLength, &EncodedLength));
+            if (EncodedLength == 0) {
+                break;
+            }
+            Decoded.insert(Decoded.end(), Block.begin(), Block.begin() + DecodedLength);
+            Offset += EncodedLength;
+        }
+        return Decoded;
+    }
+};
+
+TEST_F(StreamCompressTest, RoundTrip)
+{
+    auto Text = MakeText(3 * QUIC_STREAM_COMPRESSION_MAX_BLOCK + 100);
+    QUIC_BUFFER Buffer = { (uint32_t)Text.size(), Text.data() };
+    auto Encoded = Compress({ Buffer });
+    ASSERT_LT(Encoded.size(), Text.size() / 10);
+    ASSERT_EQ(Text, Decompress(Encoded));
+    ASSERT_EQ(Text, Decompress(Encoded, 1));
+    ASSERT_EQ(Text, Decompress(Encoded, 77));
+}
+
+TEST_F(StreamCompressTest, BlocksSpanBuffers)
+{
+    auto Text = MakeText(2 * QUIC_STREAM_COMPRESSION_MAX_BLOCK);
+    std::vector<QUIC_BUFFER> Buffers;
+    const uint32_t Lengths[] = { 0, 10, QUIC_STREAM_COMPRESSION_MAX_BLOCK, 0, 1000 };
+    uint32_t Offset = 0;
+    for (uint32_t Length : Lengths) {
+        Buffers.push_back({ Length, Text.data() + Offset });
+        Offset += Length;
+    }
+    Buffers.push_back({ (uint32_t)Text.size() - Offset, Text.data() + Offset });
+    ASSERT_EQ(Text, Decompress(Compress(Buffers)));
+}
+
+TEST_F(StreamCompressTest, IncompressibleStored)
+{
+    auto Noise = MakeNoise(QUIC_STREAM_COMPRESSION_MAX_BLOCK + 1);
+    QUIC_BUFFER Buffer = { (uint32_t)Noise.size(), Noise.data() };
+    auto Encoded = Compress({ Buffer });
+    ASSERT_EQ((size_t)QuicStreamCompressBound(Noise.size()), Encoded.size());
+    ASSERT_EQ(Noise, Decompress(Encoded, 5));
+}
+
+TEST_F(StreamCompressTest, Incomplete)
+{
+    auto Text = MakeText(1000);
+    QUIC_BUFFER Buffer = { (uint32_t)Text.size(), Text.data() };
+    auto Encoded = Compress({ Buffer });
+
+    std::vector<uint8_t> Block(QUIC_STREAM_COMPRESSION_MAX_BLOCK);
+    for (uint32_t Length = 0; Length < Encoded.size(); ++Length) {
+        QUIC_BUFFER Partial = { Length, Encoded.data() };
+        uint32_t DecodedLength, EncodedLength;
+        ASSERT_EQ(
+            QUIC_STATUS_PENDING,
+            QuicStreamDecompress(
+                &Config, &Partial, 1, Block.data(), &DecodedLength, &EncodedLength));
+    }
+}
+
+TEST_F(StreamCompressTest, Malformed)
+{
+    std::vector<uint8_t> Block(QUIC_STREAM_COMPRESSION_MAX_BLOCK);
+    const std::vector<std::vector<uint8_t>> Cases = {
+        { 0x00, 0x01, 0x00 },               // Empty block
+        { 0x05, 0x00 },                     // Empty payload
+        { 0x02, 0x03, 0x00, 0x00, 0x00 },   // Payload longer than the block
+        { 0x80, 0x00, 0x40, 0x00, 0x01 },   // Block too large
+        { 0x04, 0x02, 0x03, 0x61 },         // Decompresses to the wrong length
+    };
+    for (auto& Case : Cases) {
+        QUIC_BUFFER Buffer = { (uint32_t)Case.size(), (uint8_t*)Case.data() };
+        uint32_t DecodedLength, EncodedLength;
+        ASSERT_EQ(
+            QUIC_STATUS_PROTOCOL_ERROR,
+            QuicStreamDecompress(
+                &Config, &Buffer, 1, Block.data(), &DecodedLength, &EncodedLength));
+    }
+}
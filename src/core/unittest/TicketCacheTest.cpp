@@ -0,0 +1,125 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test for the client resumption ticket cache.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "TicketCacheTest.cpp.clog.h"
+#endif
+
+struct TicketCacheTest : public ::testing::Test
+{
+    QUIC_TICKET_CACHE* Cache {nullptr};
+
+    //
+    // The cache only compares configuration pointers, so these never need to
+    // be dereferenced.
+    //
+    const QUIC_CONFIGURATION* Config1 {(const QUIC_CONFIGURATION*)(uintptr_t)0x1000};
+    const QUIC_CONFIGURATION* Config2 {(const QUIC_CONFIGURATION*)(uintptr_t)0x2000};
+
+    const uint8_t Ticket[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+
+    void SetUp() override {
+        Cache = new(std::nothrow) QUIC_TICKET_CACHE;
+        ASSERT_NE(nullptr, Cache);
+        QuicTicketCacheInitialize(Cache);
+    }
+
+    void TearDown() override {
+        if (Cache != nullptr) {
+            QuicTicketCacheUninitialize(Cache);
+            delete Cache;
+        }
+    }
+
+    bool Take(const QUIC_CONFIGURATION* Config, const char* ServerName, uint16_t* Length = nullptr) {
+        uint8_t* Buffer;
+        uint16_t BufferLength;
+        if (!QuicTicketCacheTake(Cache, Config, ServerName, &Buffer, &BufferLength)) {
+            return false;
+        }
+        EXPECT_EQ(0, memcmp(Buffer, Ticket, BufferLength));
+        if (Length != nullptr) {
+            *Length = BufferLength;
+        }
+        QuicTicketCacheFreeTicket(Buffer);
+        return true;
+    }
+};
+
+TEST_F(TicketCacheTest, Miss)
+{
+    ASSERT_FALSE(Take(Config1, "example.com"));
+}
+
+TEST_F(TicketCacheTest, InsertAndTake)
+{
+    QuicTicketCacheInsert(Cache, Config1, "example.com", sizeof(Ticket), Ticket);
+    uint16_t Length = 0;
+    ASSERT_TRUE(Take(Config1, "example.com", &Length));
+    ASSERT_EQ(sizeof(Ticket), Length);
+
+    //
+    // Tickets are single use.
+    //
+    ASSERT_FALSE(Take(Config1, "example.com"));
+}
+
+TEST_F(TicketCacheTest, KeyedByServerNameAndConfiguration)
+{
+    QuicTicketCacheInsert(Cache, Config1, "example.com", sizeof(Ticket), Ticket);
+    ASSERT_FALSE(Take(Config2, "example.com"));
+    ASSERT_FALSE(Take(Config1, "example.org"));
+    ASSERT_FALSE(Take(Config1, "example.co"));
+    ASSERT_TRUE(Take(Config1, "example.com"));
+}
+
+TEST_F(TicketCacheTest, Replace)
+{
+    QuicTicketCacheInsert(Cache, Config1, "example.com", 4, Ticket);
+    QuicTicketCacheInsert(Cache, Config1, "example.com", sizeof(Ticket), Ticket);
+    uint16_t Length = 0;
+    ASSERT_TRUE(Take(Config1, "example.com", &Length));
+    ASSERT_EQ(sizeof(Ticket), Length);
+    ASSERT_FALSE(Take(Config1, "example.com"));
+}
+
+TEST_F(TicketCacheTest, Purge)
+{
+    QuicTicketCacheInsert(Cache, Config1, "example.com", sizeof(Ticket), Ticket);
+    QuicTicketCacheInsert(Cache, Config2, "example.com", sizeof(Ticket), Ticket);
+    QuicTicketCachePurge(Cache, Config1);
+    ASSERT_FALSE(Take(Config1, "example.com"));
+    ASSERT_TRUE(Take(Config2, "example.com"));
+}
+
+TEST_F(TicketCacheTest, Eviction)
+{
+    //
+    // Insert many more tickets than the cache can hold. Every lookup either
+    // misses or returns the right ticket.
+    //
+    const uint32_t Count = QUIC_TICKET_CACHE_SETS * QUIC_TICKET_CACHE_WAYS * 4;
+    char ServerName[32];
+    for (uint32_t i = 0; i < Count; ++i) {
+        (void)sprintf_s(ServerName, sizeof(ServerName), "server%u.example.com", i);
+        QuicTicketCacheInsert(Cache, Config1, ServerName, sizeof(Ticket), Ticket);
+    }
+    uint32_t Hits = 0;
+    for (uint32_t i = 0; i < Count; ++i) {
+        (void)sprintf_s(ServerName, sizeof(ServerName), "server%u.example.com", i);
+        if (Take(Config1, ServerName)) {
+            ++Hits;
+        }
+    }
+    ASSERT_GT(Hits, 0u);
+    ASSERT_LE(Hits, (uint32_t)(QUIC_TICKET_CACHE_SETS * QUIC_TICKET_CACHE_WAYS));
+}
@@ -467,6 +467,8 @@ TEST(ResumptionTicketTest, ServerEncDec)
     QUIC_TRANSPORT_PARAMETERS DecodedTP;
     const uint8_t* DecodedAppData = nullptr;
     uint32_t DecodedAppDataLength = 0;
+    QUIC_CONGESTION_CONTROL_SAVED_STATE SavedState = {25000, 1000000};
+    QUIC_CONGESTION_CONTROL_SAVED_STATE DecodedSavedState;
 
     QUIC_CONNECTION Connection;
     CxPlatZeroMemory(&Connection, sizeof(Connection));
@@ -493,6 +495,7 @@ TEST(ResumptionTicketTest, ServerEncDec)
             &ServerTP,
             NegotiatedAlpn[0],
             NegotiatedAlpn + 1,
+            &SavedState,
             &EncodedServerTicket,
             &EncodedServerTicketLength));
 
@@ -508,12 +511,15 @@ TEST(ResumptionTicketTest, ServerEncDec)
             sizeof(NegotiatedAlpn),
             &DecodedTP,
             &DecodedAppData,
-            &DecodedAppDataLength));
+            &DecodedAppDataLength,
+            &DecodedSavedState));
 
     ASSERT_EQ(DecodedAppDataLength, sizeof(AppData));
     ASSERT_NE(DecodedAppData, nullptr);
     ASSERT_TRUE(memcmp(AppData, DecodedAppData, sizeof(AppData)) == 0);
     CompareTransportParameters(&ServerTP, &DecodedTP);
+    ASSERT_EQ(SavedState.Rtt, DecodedSavedState.Rtt);
+    ASSERT_EQ(SavedState.CongestionWindow, DecodedSavedState.CongestionWindow);
 
     CXPLAT_FREE(EncodedServerTicket, QUIC_POOL_SERVER_CRYPTO_TICKET);
 }
@@ -528,6 +534,7 @@ TEST(ResumptionTicketTest, ServerEncDecNoAppData)
     QUIC_TRANSPORT_PARAMETERS DecodedServerTP;
     const uint8_t* DecodedAppData = nullptr;
     uint32_t DecodedAppDataLength = 0;
+    QUIC_CONGESTION_CONTROL_SAVED_STATE DecodedSavedState;
 
     QUIC_CONNECTION Connection;
     CxPlatZeroMemory(&Connection, sizeof(Connection));
@@ -554,6 +561,7 @@ TEST(ResumptionTicketTest, ServerEncDecNoAppData)
             &ServerTP,
             NegotiatedAlpn[0],
             NegotiatedAlpn + 1,
+            nullptr,
             &EncodedServerTicket,
             &EncodedServerTicketLength));
 
@@ -569,11 +577,14 @@ TEST(ResumptionTicketTest, ServerEncDecNoAppData)
             sizeof(NegotiatedAlpn),
             &DecodedServerTP,
             &DecodedAppData,
-            &DecodedAppDataLength));
+            &DecodedAppDataLength,
+            &DecodedSavedState));
 
     ASSERT_EQ((uint16_t)DecodedAppDataLength, 0);
     ASSERT_EQ(DecodedAppData, nullptr);
     CompareTransportParameters(&ServerTP, &DecodedServerTP);
+    ASSERT_EQ(DecodedSavedState.Rtt, 0u);
+    ASSERT_EQ(DecodedSavedState.CongestionWindow, 0u);
 
     CXPLAT_FREE(EncodedServerTicket, QUIC_POOL_SERVER_CRYPTO_TICKET);
 }
@@ -601,7 +612,7 @@ TEST(ResumptionTicketTest, ServerDecFail)
     CxPlatZeroMemory(&Connection, sizeof(Connection));
     Connection.Stats.QuicVersion = QUIC_VERSION_1;
 
-    uint8_t InputTicketBuffer[8 + TransportParametersLength + sizeof(Alpn) + sizeof(AppData)] = {
+    uint8_t InputTicketBuffer[8 + TransportParametersLength + sizeof(Alpn) + sizeof(AppData) + 2] = {
         CXPLAT_TLS_RESUMPTION_TICKET_VERSION,
         0,0,0,1,                    // QUIC version
         4,                          // ALPN length
@@ -649,6 +660,7 @@ TEST(ResumptionTicketTest, ServerDecFail)
         &InputTicketBuffer[8 + sizeof(Alpn) + (EncodedTPLength - CxPlatTlsTPHeaderSize)],
         AppData,
         sizeof(AppData));
+    // Saved RTT and congestion window are left as zero (none saved).
 
     //
     // Validate that the hand-crafted ticket is correct
@@ -656,13 +668,14 @@ TEST(ResumptionTicketTest, ServerDecFail)
     TEST_QUIC_SUCCEEDED(
         QuicCryptoDecodeServerTicket(
             &Connection,
-            8 + (uint16_t)sizeof(Alpn) + (uint16_t)(EncodedTPLength - CxPlatTlsTPHeaderSize) + (uint16_t)sizeof(AppData),
+            8 + (uint16_t)sizeof(Alpn) + (uint16_t)(EncodedTPLength - CxPlatTlsTPHeaderSize) + (uint16_t)sizeof(AppData) + 2,
             InputTicketBuffer,
             AlpnList,
             sizeof(AlpnList),
             &DecodedTP,
             &DecodedAppData,
-            &DecodedAppDataLength));
+            &DecodedAppDataLength,
+            nullptr));
     ASSERT_EQ(DecodedAppDataLength, sizeof(AppData));
     CompareTransportParameters(&HandshakeTP, &DecodedTP);
 
@@ -681,7 +694,8 @@ TEST(ResumptionTicketTest, ServerDecFail)
             sizeof(AlpnList),
             &DecodedTP,
             &DecodedAppData,
-            &DecodedAppDataLength));
+            &DecodedAppDataLength,
+            nullptr));
 
     // Not enough room for QUIC version
     ASSERT_EQ(
@@ -694,7 +708,8 @@ TEST(ResumptionTicketTest, ServerDecFail)
             sizeof(AlpnList),
             &DecodedTP,
             &DecodedAppData,
-            &DecodedAppDataLength));
+            &DecodedAppDataLength,
+            nullptr));
 
     // Not enough room for negotiated ALPN length
     ASSERT_EQ(
@@ -707,7 +722,8 @@ TEST(ResumptionTicketTest, ServerDecFail)
             sizeof(AlpnList),
             &DecodedTP,
             &DecodedAppData,
-            &DecodedAppDataLength));
+            &DecodedAppDataLength,
+            nullptr));
 
     // Not enough room for TP length
     ASSERT_EQ(
@@ -720,7 +736,8 @@ TEST(ResumptionTicketTest, ServerDecFail)
             sizeof(AlpnList),
             &DecodedTP,
             &DecodedAppData,
-            &DecodedAppDataLength));
+            &DecodedAppDataLength,
+            nullptr));
 
     // Not enough room for App Data length
     ASSERT_EQ(
@@ -733,7 +750,8 @@ TEST(ResumptionTicketTest, ServerDecFail)
             sizeof(AlpnList),
             &DecodedTP,
             &DecodedAppData,
-            &DecodedAppDataLength));
+            &DecodedAppDataLength,
+            nullptr));
 
     // Not enough room for negotiated ALPN length
     ASSERT_EQ(
@@ -746,7 +764,8 @@ TEST(ResumptionTicketTest, ServerDecFail)
             sizeof(AlpnList),
             &DecodedTP,
             &DecodedAppData,
-            &DecodedAppDataLength));
+            &DecodedAppDataLength,
+            nullptr));
     ASSERT_EQ(
         QUIC_STATUS_INVALID_PARAMETER,
         QuicCryptoDecodeServerTicket(
@@ -757,7 +776,8 @@ TEST(ResumptionTicketTest, ServerDecFail)
             sizeof(AlpnList),
             &DecodedTP,
             &DecodedAppData,
-            &DecodedAppDataLength));
+            &DecodedAppDataLength,
+            nullptr));
 
     // Not enough room for handshake TP
     ASSERT_EQ(
@@ -770,7 +790,8 @@ TEST(ResumptionTicketTest, ServerDecFail)
             sizeof(AlpnList),
             &DecodedTP,
             &DecodedAppData,
-            &DecodedAppDataLength));
+            &DecodedAppDataLength,
+            nullptr));
     ASSERT_EQ(
         QUIC_STATUS_INVALID_PARAMETER,
         QuicCryptoDecodeServerTicket(
@@ -781,7 +802,8 @@ TEST(ResumptionTicketTest, ServerDecFail)
             sizeof(AlpnList),
             &DecodedTP,
             &DecodedAppData,
-            &DecodedAppDataLength));
+            &DecodedAppDataLength,
+            nullptr));
     ASSERT_EQ(
         QUIC_STATUS_INVALID_PARAMETER,
         QuicCryptoDecodeServerTicket(
@@ -792,7 +814,8 @@ TEST(ResumptionTicketTest, ServerDecFail)
             sizeof(AlpnList),
             &DecodedTP,
             &DecodedAppData,
-            &DecodedAppDataLength));
+            &DecodedAppDataLength,
+            nullptr));
 
     // Not enough room for App Data
     ASSERT_EQ(
@@ -805,7 +828,8 @@ TEST(ResumptionTicketTest, ServerDecFail)
             sizeof(AlpnList),
             &DecodedTP,
             &DecodedAppData,
-            &DecodedAppDataLength));
+            &DecodedAppDataLength,
+            nullptr));
     ASSERT_EQ(
         QUIC_STATUS_INVALID_PARAMETER,
         QuicCryptoDecodeServerTicket(
@@ -816,7 +840,24 @@ TEST(ResumptionTicketTest, ServerDecFail)
             sizeof(AlpnList),
             &DecodedTP,
             &DecodedAppData,
-            &DecodedAppDataLength));
+            &DecodedAppDataLength,
+            nullptr));
+
+    // Not enough room for saved RTT and congestion window
+    for (uint16_t s = 0; s < 2; ++s) {
+        ASSERT_EQ(
+            QUIC_STATUS_INVALID_PARAMETER,
+            QuicCryptoDecodeServerTicket(
+                &Connection,
+                8 + (uint16_t)sizeof(Alpn) + (uint16_t)(EncodedTPLength - CxPlatTlsTPHeaderSize) + (uint16_t)sizeof(AppData) + s,
+                InputTicketBuffer,
+                AlpnList,
+                sizeof(AlpnList),
+                &DecodedTP,
+                &DecodedAppData,
+                &DecodedAppDataLength,
+                nullptr));
+    }
 
     //
     // Invalidate some of the fields of the ticket to ensure
@@ -824,7 +865,7 @@ TEST(ResumptionTicketTest, ServerDecFail)
     //
 
     const uint16_t ActualEncodedTicketLength =
-        8 + (uint16_t)sizeof(Alpn) + (uint16_t)(EncodedTPLength - CxPlatTlsTPHeaderSize) + (uint16_t)sizeof(AppData);
+        8 + (uint16_t)sizeof(Alpn) + (uint16_t)(EncodedTPLength - CxPlatTlsTPHeaderSize) + (uint16_t)sizeof(AppData) + 2;
 
     // Incorrect ticket version
     InputTicketBuffer[0] = CXPLAT_TLS_RESUMPTION_TICKET_VERSION + 1;
@@ -838,7 +879,8 @@ TEST(ResumptionTicketTest, ServerDecFail)
             sizeof(AlpnList),
             &DecodedTP,
             &DecodedAppData,
-            &DecodedAppDataLength));
+            &DecodedAppDataLength,
+            nullptr));
     InputTicketBuffer[0] = CXPLAT_TLS_RESUMPTION_CLIENT_TICKET_VERSION;
 
     // Unsupported QUIC version
@@ -856,7 +898,8 @@ TEST(ResumptionTicketTest, ServerDecFail)
             sizeof(AlpnList),
             &DecodedTP,
             &DecodedAppData,
-            &DecodedAppDataLength));
+            &DecodedAppDataLength,
+            nullptr));
 
     // Unsupported QUIC version on connection
     Connection.Settings.VersionSettings = &VersionSettings;
@@ -871,7 +914,8 @@ TEST(ResumptionTicketTest, ServerDecFail)
             sizeof(AlpnList),
             &DecodedTP,
             &DecodedAppData,
-            &DecodedAppDataLength));
+            &DecodedAppDataLength,
+            nullptr));
     InputTicketBuffer[1] = 0;
     InputTicketBuffer[2] = 0;
     InputTicketBuffer[3] = 0;
@@ -898,7 +942,8 @@ TEST(ResumptionTicketTest, ServerDecFail)
                 sizeof(AlpnList),
                 &DecodedTP,
                 &DecodedAppData,
-                &DecodedAppDataLength));
+                &DecodedAppDataLength,
+                nullptr));
     }
 
     // Negotiated ALPN length longer than actual
@@ -913,7 +958,8 @@ TEST(ResumptionTicketTest, ServerDecFail)
             sizeof(AlpnList),
             &DecodedTP,
             &DecodedAppData,
-            &DecodedAppDataLength));
+            &DecodedAppDataLength,
+            nullptr));
 
     // Negotiated ALPN length improperly encoded QUIC_VAR_INT
     for (uint8_t i = 1; i < 4; ++i) {
@@ -935,7 +981,8 @@ TEST(ResumptionTicketTest, ServerDecFail)
                 sizeof(AlpnList),
                 &DecodedTP,
                 &DecodedAppData,
-                &DecodedAppDataLength));
+                &DecodedAppDataLength,
+                nullptr));
     }
     InputTicketBuffer[5] = (uint8_t)sizeof(Alpn);
 
@@ -958,7 +1005,8 @@ TEST(ResumptionTicketTest, ServerDecFail)
                 sizeof(AlpnList),
                 &DecodedTP,
                 &DecodedAppData,
-                &DecodedAppDataLength));
+                &DecodedAppDataLength,
+                nullptr));
     }
 
     // Handshake TP length longer than actual
@@ -973,7 +1021,8 @@ TEST(ResumptionTicketTest, ServerDecFail)
             sizeof(AlpnList),
             &DecodedTP,
             &DecodedAppData,
-            &DecodedAppDataLength));
+            &DecodedAppDataLength,
+            nullptr));
 
     // Handshake TP length improperly encoded QUIC_VAR_INT
     for (uint8_t i = 1; i < 4; ++i) {
@@ -994,7 +1043,8 @@ TEST(ResumptionTicketTest, ServerDecFail)
                 sizeof(AlpnList),
                 &DecodedTP,
                 &DecodedAppData,
-                &DecodedAppDataLength));
+                &DecodedAppDataLength,
+                nullptr));
     }
     InputTicketBuffer[6] = (uint8_t)(EncodedTPLength - CxPlatTlsTPHeaderSize);
 
@@ -1017,7 +1067,8 @@ TEST(ResumptionTicketTest, ServerDecFail)
                 sizeof(AlpnList),
                 &DecodedTP,
                 &DecodedAppData,
-                &DecodedAppDataLength));
+                &DecodedAppDataLength,
+                nullptr));
     }
 
     // App Data length longer than actual
@@ -1032,7 +1083,8 @@ TEST(ResumptionTicketTest, ServerDecFail)
                 sizeof(AlpnList),
                 &DecodedTP,
                 &DecodedAppData,
-                &DecodedAppDataLength));
+                &DecodedAppDataLength,
+                nullptr));
 
     // App Data length improperly encoded QUIC_VAR_INT
     for (uint8_t i = 1; i < 4; ++i) {
@@ -1053,7 +1105,8 @@ TEST(ResumptionTicketTest, ServerDecFail)
                 sizeof(AlpnList),
                 &DecodedTP,
                 &DecodedAppData,
-                &DecodedAppDataLength));
+                &DecodedAppDataLength,
+                nullptr));
     }
 }
 
@@ -1103,6 +1156,7 @@ TEST(ResumptionTicketTest, ClientServerEndToEnd)
             &ServerTP,
             NegotiatedAlpn[0],
             NegotiatedAlpn + 1,
+            nullptr,
             &EncodedServerTicket,
             &EncodedServerTicketLength));
 
@@ -1147,7 +1201,8 @@ TEST(ResumptionTicketTest, ClientServerEndToEnd)
             sizeof(NegotiatedAlpn),
             &DecodedServerTP,
             &DecodedAppData,
-            &DecodedAppDataLength));
+            &DecodedAppDataLength,
+            nullptr));
 
     ASSERT_EQ(DecodedAppDataLength, sizeof(AppData));
     ASSERT_NE(DecodedAppData, nullptr);
@@ -0,0 +1,162 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test for the timer wheel.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "TimerWheelTest.cpp.clog.h"
+#endif
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+struct TimerWheelTest : public ::testing::Test
+{
+    QUIC_TIMER_WHEEL TimerWheel;
+
+    //
+    // The timer wheel only uses the connections' expiration time, timer link
+    // and reference counts. An extra reference is held on each so the timer
+    // wheel never frees them.
+    //
+    std::vector<std::unique_ptr<QUIC_CONNECTION>> Connections;
+
+    void SetUp() override {
+        ASSERT_EQ(QUIC_STATUS_SUCCESS, QuicTimerWheelInitialize(&TimerWheel));
+    }
+
+    void TearDown() override {
+        for (auto& Connection : Connections) {
+            QuicTimerWheelRemoveConnection(&TimerWheel, Connection.get());
+        }
+        QuicTimerWheelUninitialize(&TimerWheel);
+    }
+
+    QUIC_CONNECTION* NewConnection() {
+        Connections.emplace_back(new QUIC_CONNECTION);
+        QUIC_CONNECTION* Connection = Connections.back().get();
+        CxPlatZeroMemory(Connection, sizeof(*Connection));
+        Connection->EarliestExpirationTime = UINT64_MAX;
+        QuicConnAddRef(Connection, QUIC_CONN_REF_HANDLE_OWNER);
+        return Connection;
+    }
+
+    void SetExpiration(QUIC_CONNECTION* Connection, uint64_t ExpirationTime) {
+        Connection->EarliestExpirationTime = ExpirationTime;
+        QuicTimerWheelUpdateConnection(&TimerWheel, Connection);
+    }
+
+    uint64_t TrueNextExpiration() {
+        uint64_t Next = UINT64_MAX;
+        for (auto& Connection : Connections) {
+            if (Connection->TimerLink.Flink != NULL) {
+                Next = CXPLAT_MIN(Next, Connection->EarliestExpirationTime);
+            }
+        }
+        return Next;
+    }
+
+    //
+    // Expires everything due by TimeNow, validating it is exactly the
+    // connections expected to be.
+    //
+    void Expire(uint64_t TimeNow) {
+        std::vector<QUIC_CONNECTION*> Expected;
+        for (auto& Connection : Connections) {
+            if (Connection->TimerLink.Flink != NULL &&
+                Connection->EarliestExpirationTime <= TimeNow) {
+                Expected.push_back(Connection.get());
+            }
+        }
+
+        CXPLAT_LIST_ENTRY Expired;
+        CxPlatListInitializeHead(&Expired);
+        QuicTimerWheelGetExpired(&TimerWheel, TimeNow, &Expired);
+
+        std::vector<QUIC_CONNECTION*> Actual;
+        while (!CxPlatListIsEmpty(&Expired)) {
+            QUIC_CONNECTION* Connection =
+                CXPLAT_CONTAINING_RECORD(
+                    CxPlatListRemoveHead(&Expired), QUIC_CONNECTION, TimerLink);
+            Connection->TimerLink.Flink = NULL;
+            Connection->EarliestExpirationTime = UINT64_MAX;
+            QuicConnRelease(Connection, QUIC_CONN_REF_WORKER);
+            Actual.push_back(Connection);
+        }
+
+        std::sort(Expected.begin(), Expected.end());
+        std::sort(Actual.begin(), Actual.end());
+        ASSERT_EQ(Expected, Actual);
+        ASSERT_EQ(TrueNextExpiration(), TimerWheel.NextExpirationTime);
+    }
+};
+
+TEST_F(TimerWheelTest, Basic)
+{
+    const uint64_t TimeNow = CxPlatTimeUs64();
+    QUIC_CONNECTION* Connection1 = NewConnection();
+    QUIC_CONNECTION* Connection2 = NewConnection();
+
+    SetExpiration(Connection1, TimeNow + 5000);
+    SetExpiration(Connection2, TimeNow + 3000);
+    ASSERT_EQ(2u, TimerWheel.ConnectionCount);
+    ASSERT_EQ(TimeNow + 3000, TimerWheel.NextExpirationTime);
+    ASSERT_EQ(Connection2, TimerWheel.NextConnection);
+
+    SetExpiration(Connection2, TimeNow + 10000);
+    ASSERT_EQ(TimeNow + 5000, TimerWheel.NextExpirationTime);
+    ASSERT_EQ(Connection1, TimerWheel.NextConnection);
+
+    Expire(TimeNow + 4999);
+    ASSERT_EQ(2u, TimerWheel.ConnectionCount);
+    Expire(TimeNow + 5000);
+    ASSERT_EQ(1u, TimerWheel.ConnectionCount);
+
+    SetExpiration(Connection2, UINT64_MAX);
+    ASSERT_EQ(0u, TimerWheel.ConnectionCount);
+    ASSERT_EQ(UINT64_MAX, TimerWheel.NextExpirationTime);
+    ASSERT_EQ(nullptr, TimerWheel.NextConnection);
+}
+
+TEST_F(TimerWheelTest, Random)
+{
+    const uint32_t ConnectionCount = 200;
+    const uint64_t Ranges[] = { 50 * 1000, 5 * 1000 * 1000, 600 * 1000 * 1000 };
+
+    std::mt19937_64 Random(42);
+    uint64_t TimeNow = CxPlatTimeUs64();
+    for (uint32_t i = 0; i < ConnectionCount; ++i) {
+        NewConnection();
+    }
+
+    for (uint32_t Round = 0; Round < 500; ++Round) {
+        //
+        // Randomly update some connections' expirations, across all the levels
+        // of the timer wheel (and a few already in the past), then advance
+        // time by a random amount.
+        //
+        for (uint32_t i = 0; i < 20; ++i) {
+            QUIC_CONNECTION* Connection = Connections[Random() % ConnectionCount].get();
+            const uint64_t Range = Ranges[Random() % ARRAYSIZE(Ranges)];
+            const uint64_t Value = Random() % Range;
+            if (Value % 17 == 0) {
+                SetExpiration(Connection, UINT64_MAX);
+            } else {
+                SetExpiration(Connection, TimeNow + Value - 1000);
+            }
+            ASSERT_EQ(TrueNextExpiration(), TimerWheel.NextExpirationTime);
+        }
+
+        TimeNow += Random() % Ranges[Random() % ARRAYSIZE(Ranges)] / 10;
+        Expire(TimeNow);
+    }
+}
@@ -42,6 +42,17 @@ void CompareTransportParams(
             memcmp(A->VersionInfo, B->VersionInfo, (size_t)A->VersionInfoLength),
             0);
     }
+    if (A->Flags & QUIC_TP_FLAG_PREFERRED_ADDRESS) {
+        ASSERT_TRUE(QuicAddrCompare(&A->PreferredAddressIpv4, &B->PreferredAddressIpv4));
+        ASSERT_TRUE(QuicAddrCompare(&A->PreferredAddressIpv6, &B->PreferredAddressIpv6));
+        ASSERT_EQ(A->PreferredAddressCidLength, B->PreferredAddressCidLength);
+        ASSERT_EQ(
+            memcmp(A->PreferredAddressCid, B->PreferredAddressCid, A->PreferredAddressCidLength),
+            0);
+        ASSERT_EQ(
+            memcmp(A->PreferredAddressResetToken, B->PreferredAddressResetToken, QUIC_STATELESS_RESET_TOKEN_LENGTH),
+            0);
+    }
     //COMPARE_TP_FIELD(InitialSourceConnectionID);
     //COMPARE_TP_FIELD(InitialSourceConnectionIDLength);
     if (IsServer) { // TODO
@@ -270,3 +281,87 @@ TEST(TransportParamTest, ReliableResetEnabled)
     EncodeDecodeAndCompare(&OriginalTP);
     EncodeDecodeAndCompare(&OriginalTP, true);
 }
+
+TEST(TransportParamTest, PreferredAddress)
+{
+    QUIC_TRANSPORT_PARAMETERS OriginalTP;
+    CxPlatZeroMemory(&OriginalTP, sizeof(OriginalTP));
+    OriginalTP.Flags = QUIC_TP_FLAG_PREFERRED_ADDRESS;
+    ASSERT_TRUE(QuicAddrFromString("192.168.1.11", 4433, &OriginalTP.PreferredAddressIpv4));
+    ASSERT_TRUE(QuicAddrFromString("fd00::11", 4434, &OriginalTP.PreferredAddressIpv6));
+    OriginalTP.PreferredAddressCidLength = QUIC_MAX_CONNECTION_ID_LENGTH_V1;
+    CxPlatRandom(sizeof(OriginalTP.PreferredAddressCid), OriginalTP.PreferredAddressCid);
+    CxPlatRandom(sizeof(OriginalTP.PreferredAddressResetToken), OriginalTP.PreferredAddressResetToken);
+    EncodeDecodeAndCompare(&OriginalTP, true);
+    DecodeTwice(&OriginalTP, true);
+}
+
+TEST(TransportParamTest, PreferredAddressIpv4Only)
+{
+    QUIC_TRANSPORT_PARAMETERS OriginalTP;
+    CxPlatZeroMemory(&OriginalTP, sizeof(OriginalTP));
+    OriginalTP.Flags = QUIC_TP_FLAG_PREFERRED_ADDRESS;
+    ASSERT_TRUE(QuicAddrFromString("192.168.1.11", 4433, &OriginalTP.PreferredAddressIpv4));
+    OriginalTP.PreferredAddressCidLength = 8;
+    CxPlatRandom(OriginalTP.PreferredAddressCidLength, OriginalTP.PreferredAddressCid);
+    EncodeDecodeAndCompare(&OriginalTP, true);
+}
+
+TEST(TransportParamTest, ServerCachedEncoding)
+{
+    QUIC_TP_CACHE Cache;
+    QuicTpCacheInitialize(&Cache);
+
+    QUIC_TRANSPORT_PARAMETERS OriginalTP;
+    CxPlatZeroMemory(&OriginalTP, sizeof(OriginalTP));
+    OriginalTP.Flags =
+        QUIC_TP_FLAG_INITIAL_MAX_DATA |
+        QUIC_TP_FLAG_IDLE_TIMEOUT |
+        QUIC_TP_FLAG_INITIAL_SOURCE_CONNECTION_ID |
+        QUIC_TP_FLAG_ORIGINAL_DESTINATION_CONNECTION_ID |
+        QUIC_TP_FLAG_STATELESS_RESET_TOKEN;
+    OriginalTP.InitialMaxData = 0x100000;
+    OriginalTP.IdleTimeout = 30000;
+    OriginalTP.InitialSourceConnectionIDLength = 8;
+    OriginalTP.OriginalDestinationConnectionIDLength = 8;
+
+    const uint8_t* CachedBuffer = nullptr;
+    for (uint32_t i = 0; i < 3; ++i) {
+        if (i == 2) {
+            OriginalTP.IdleTimeout = 60000; // Changing a shared TP replaces the entry.
+        }
+        CxPlatRandom(8, OriginalTP.InitialSourceConnectionID);
+        CxPlatRandom(8, OriginalTP.OriginalDestinationConnectionID);
+        CxPlatRandom(sizeof(OriginalTP.StatelessResetToken), OriginalTP.StatelessResetToken);
+
+        uint32_t BufferLength;
+        auto Buffer =
+            QuicCryptoTlsEncodeServerTransportParametersCached(
+                &JunkConnection, &Cache, &OriginalTP, &BufferLength);
+        ASSERT_NE(nullptr, Buffer);
+        if (i == 1) {
+            ASSERT_EQ(CachedBuffer, Cache.Buffer);
+        } else {
+            ASSERT_NE(CachedBuffer, Cache.Buffer);
+        }
+        CachedBuffer = Cache.Buffer;
+
+        QUIC_TRANSPORT_PARAMETERS Decoded = {0};
+        TransportParametersScope TPScope(&Decoded);
+        BOOLEAN DecodedSuccessfully =
+            QuicCryptoTlsDecodeTransportParameters(
+                &JunkConnection,
+                TRUE,
+                Buffer + CxPlatTlsTPHeaderSize,
+                (uint16_t)(BufferLength - CxPlatTlsTPHeaderSize),
+                &Decoded);
+        CXPLAT_FREE(Buffer, QUIC_POOL_TLS_TRANSPARAMS);
+        ASSERT_TRUE(DecodedSuccessfully);
+        CompareTransportParams(&OriginalTP, &Decoded, true);
+        ASSERT_EQ(0, memcmp(OriginalTP.InitialSourceConnectionID, Decoded.InitialSourceConnectionID, 8));
+        ASSERT_EQ(0, memcmp(OriginalTP.OriginalDestinationConnectionID, Decoded.OriginalDestinationConnectionID, 8));
+        ASSERT_EQ(0, memcmp(OriginalTP.StatelessResetToken, Decoded.StatelessResetToken, sizeof(Decoded.StatelessResetToken)));
+    }
+
+    QuicTpCacheUninitialize(&Cache);
+}
@@ -73,3 +73,25 @@ TEST(VarIntTest, RandomEncodeDecode)
         ASSERT_EQ(Value, Decoded);
     }
 }
+
+TEST(VarIntTest, TruncatedDecode)
+{
+    const uint8_t Buffer[8] = { 0xC0, 0, 0, 0, 0, 0, 0, 0x01 };
+    const uint8_t Prefixes[] = { 0x40, 0x80, 0xC0 };
+    for (uint8_t Prefix : Prefixes) {
+        uint8_t Encoded[8];
+        CxPlatCopyMemory(Encoded, Buffer, sizeof(Encoded));
+        Encoded[0] = Prefix;
+        const uint16_t Length = (uint16_t)(1 << (Prefix >> 6));
+        for (uint16_t i = 0; i < Length; ++i) {
+            uint16_t Offset = 0;
+            QUIC_VAR_INT Value;
+            ASSERT_FALSE(QuicVarIntDecode(i, Encoded, &Offset, &Value));
+            ASSERT_EQ(Offset, 0);
+        }
+        uint16_t Offset = 0;
+        QUIC_VAR_INT Value;
+        ASSERT_TRUE(QuicVarIntDecode(Length, Encoded, &Offset, &Value));
+        ASSERT_EQ(Offset, Length);
+    }
+}
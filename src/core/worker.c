@@ -35,6 +35,38 @@ QuicWorkerLoop(
 //
 CXPLAT_THREAD_CALLBACK(QuicWorkerThread, Context);
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicWorkerLoopCleanup(
+    _In_ QUIC_WORKER* Worker
+    );
+
+#ifndef _KERNEL_MODE
+static
+BOOLEAN
+QuicWorkerAddExecutionContext(
+    _In_ QUIC_WORKER* Worker
+    )
+{
+    CxPlatDispatchLockAcquire(&Worker->Lock);
+    if (!Worker->ExecutionContextAdded) {
+        Worker->ExecutionContextAdded =
+            CxPlatAddExecutionContext(
+                &MsQuicLib.WorkerPool, &Worker->ExecutionContext, Worker->PartitionIndex);
+        if (!Worker->ExecutionContextAdded) {
+            QuicTraceEvent(
+                WorkerErrorStatus,
+                "[wrkr][%p] ERROR, %u, %s.",
+                Worker,
+                QUIC_STATUS_OUT_OF_MEMORY,
+                "CxPlatAddExecutionContext");
+        }
+    }
+    CxPlatDispatchLockRelease(&Worker->Lock);
+    return Worker->ExecutionContextAdded;
+}
+#endif // _KERNEL_MODE
+
 void
 QuicWorkerThreadWake(
     _In_ QUIC_WORKER* Worker
@@ -42,7 +74,15 @@ QuicWorkerThreadWake(
 {
     Worker->ExecutionContext.Ready = TRUE; // Run the execution context
     if (Worker->IsExternal) {
-        CxPlatWakeExecutionContext(&Worker->ExecutionContext);
+#ifndef _KERNEL_MODE
+        //
+        // If the platform thread couldn't be started, the queued work waits
+        // for the next wake to try again.
+        //
+        if (Worker->ExecutionContextAdded || QuicWorkerAddExecutionContext(Worker)) {
+            CxPlatWakeExecutionContext(&Worker->ExecutionContext);
+        }
+#endif
     } else {
         CxPlatEventSet(Worker->Ready);
     }
@@ -72,6 +112,9 @@ QuicWorkerInitialize(
 
     Worker->Enabled = TRUE;
     Worker->PartitionIndex = PartitionIndex;
+    Worker->NumaNode = CxPlatProcNumaNode(QuicLibraryGetPartitionProcessor(PartitionIndex));
+    Worker->RebalancePartition = UINT16_MAX;
+    Worker->CreationTime = CxPlatTimeUs64();
     CxPlatDispatchLockInitialize(&Worker->Lock);
     CxPlatEventInitialize(&Worker->Done, TRUE, FALSE);
     CxPlatEventInitialize(&Worker->Ready, FALSE, FALSE);
@@ -79,8 +122,8 @@ QuicWorkerInitialize(
     Worker->PriorityConnectionsTail = &Worker->Connections.Flink;
     CxPlatListInitializeHead(&Worker->Operations);
     CxPlatPoolInitialize(FALSE, sizeof(QUIC_STREAM), QUIC_POOL_STREAM, &Worker->StreamPool);
-    CxPlatPoolInitialize(FALSE, sizeof(QUIC_RECV_CHUNK)+QUIC_DEFAULT_STREAM_RECV_BUFFER_SIZE, QUIC_POOL_SBUF, &Worker->DefaultReceiveBufferPool);
     CxPlatPoolInitialize(FALSE, sizeof(QUIC_SEND_REQUEST), QUIC_POOL_SEND_REQUEST, &Worker->SendRequestPool);
+    CxPlatPoolInitialize(FALSE, sizeof(QUIC_DATAGRAM_RELAY_SEND), QUIC_POOL_DATAGRAM_RELAY_SEND, &Worker->DatagramRelaySendPool);
     QuicSentPacketPoolInitialize(&Worker->SentPacketPool);
     CxPlatPoolInitialize(FALSE, sizeof(QUIC_API_CONTEXT), QUIC_POOL_API_CTX, &Worker->ApiContextPool);
     CxPlatPoolInitialize(FALSE, sizeof(QUIC_STATELESS_CONTEXT), QUIC_POOL_STATELESS_CTX, &Worker->StatelessContextPool);
@@ -90,6 +133,8 @@ QuicWorkerInitialize(
     if (QUIC_FAILED(Status)) {
         goto Error;
     }
+    QuicPacingWheelInitialize(&Worker->PacingWheel);
+    Worker->CoalescedSend.SendData = NULL;
 
     Worker->ExecutionContext.Context = Worker;
     Worker->ExecutionContext.Callback = QuicWorkerLoop;
@@ -97,9 +142,15 @@ QuicWorkerInitialize(
     Worker->ExecutionContext.Ready = TRUE;
 
 #ifndef _KERNEL_MODE // Not supported on kernel mode
-    if (ExecProfile != QUIC_EXECUTION_PROFILE_TYPE_MAX_THROUGHPUT) {
+    if (ExecProfile != QUIC_EXECUTION_PROFILE_TYPE_MAX_THROUGHPUT ||
+        MsQuicLib.WorkerPool.External) {
         Worker->IsExternal = TRUE;
-        CxPlatAddExecutionContext(&MsQuicLib.WorkerPool, &Worker->ExecutionContext, PartitionIndex);
+        if ((MsQuicLib.ExecutionConfig &&
+             MsQuicLib.ExecutionConfig->Flags & QUIC_EXECUTION_CONFIG_FLAG_PREWARM) &&
+            !QuicWorkerAddExecutionContext(Worker)) {
+            Status = QUIC_STATUS_OUT_OF_MEMORY;
+            goto Error;
+        }
     } else
 #endif // _KERNEL_MODE
     {
@@ -167,7 +218,13 @@ QuicWorkerUninitialize(
     // Clean up the worker execution context.
     //
     Worker->Enabled = FALSE;
-    if (Worker->ExecutionContext.Context) {
+    if (Worker->IsExternal && !Worker->ExecutionContextAdded) {
+        //
+        // The worker never had work for the platform to run, so there's no
+        // need to start the platform's thread just to clean up.
+        //
+        QuicWorkerLoopCleanup(Worker);
+    } else if (Worker->ExecutionContext.Context) {
         QuicWorkerThreadWake(Worker);
         CxPlatEventWaitForever(Worker->Done);
     }
@@ -189,14 +246,17 @@ QuicWorkerUninitialize(
     CXPLAT_TEL_ASSERT(CxPlatListIsEmpty(&Worker->Operations));
 
     CxPlatPoolUninitialize(&Worker->StreamPool);
-    CxPlatPoolUninitialize(&Worker->DefaultReceiveBufferPool);
     CxPlatPoolUninitialize(&Worker->SendRequestPool);
+    CxPlatPoolUninitialize(&Worker->DatagramRelaySendPool);
     QuicSentPacketPoolUninitialize(&Worker->SentPacketPool);
+    QuicQlogBufferUninitialize(&Worker->QlogBuffer);
+    QuicCaptureBufferUninitialize(&Worker->CaptureBuffer);
     CxPlatPoolUninitialize(&Worker->ApiContextPool);
     CxPlatPoolUninitialize(&Worker->StatelessContextPool);
     CxPlatPoolUninitialize(&Worker->OperPool);
     CxPlatDispatchLockUninitialize(&Worker->Lock);
     QuicTimerWheelUninitialize(&Worker->TimerWheel);
+    QuicPacingWheelUninitialize(&Worker->PacingWheel);
 
     QuicTraceEvent(
         WorkerDestroyed,
@@ -211,7 +271,15 @@ QuicWorkerAssignConnection(
     _In_ QUIC_CONNECTION* Connection
     )
 {
-    CXPLAT_DBG_ASSERT(Connection->Worker != Worker);
+    //
+    // N.B. With elastic workers, a connection moving off a folded worker can
+    // land back on it, if the worker was activated again in the meantime.
+    //
+    CXPLAT_DBG_ASSERT(Connection->Worker != Worker || (Worker->WorkerPool != NULL && Worker->WorkerPool->Elastic));
+    if (Connection->Worker != NULL) {
+        InterlockedDecrement(&Connection->Worker->ConnectionCount);
+    }
+    InterlockedIncrement(&Worker->ConnectionCount);
     Connection->Worker = Worker;
     QuicTraceEvent(
         ConnAssignWorker,
@@ -384,6 +452,101 @@ QuicWorkerQueueOperation(
     }
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicWorkerFlushCoalescedSend(
+    _In_ QUIC_WORKER* Worker
+    )
+{
+    QUIC_COALESCED_SEND* Send = &Worker->CoalescedSend;
+    CXPLAT_DBG_ASSERT(Send->SendData != NULL);
+    CXPLAT_DBG_ASSERT(!Send->InUse);
+
+    if (Send->TotalCountDatagrams != 0) {
+        QuicBindingSend(
+            Send->Binding,
+            &Send->Route,
+            Send->SendData,
+            Send->TotalDatagramsLength,
+            Send->TotalCountDatagrams);
+    } else {
+        CxPlatSendDataFree(Send->SendData);
+    }
+
+    Send->SendData = NULL;
+    QuicLibraryReleaseBinding(Send->Binding);
+    Send->Binding = NULL;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+_Success_(return != NULL)
+CXPLAT_SEND_DATA*
+QuicWorkerAllocCoalescedSend(
+    _In_ QUIC_WORKER* Worker,
+    _In_ QUIC_BINDING* Binding,
+    _In_ CXPLAT_SEND_CONFIG* Config
+    )
+{
+    QUIC_COALESCED_SEND* Send = &Worker->CoalescedSend;
+    CXPLAT_DBG_ASSERT(Send->SendData == NULL || !Send->InUse);
+
+    if (Send->SendData != NULL) {
+        if (Send->Binding == Binding &&
+            Send->MaxPacketSize == Config->MaxPacketSize &&
+            Send->ECN == Config->ECN &&
+            Send->Flags == Config->Flags &&
+            QuicAddrCompare(&Send->Route.RemoteAddress, &Config->Route->RemoteAddress) &&
+            QuicAddrCompare(&Send->Route.LocalAddress, &Config->Route->LocalAddress)) {
+            Send->InUse = TRUE;
+            return Send->SendData;
+        }
+        QuicWorkerFlushCoalescedSend(Worker);
+    }
+
+    if (!QuicLibraryTryAddRefBinding(Binding)) {
+        return NULL;
+    }
+
+    Send->SendData = CxPlatSendDataAlloc(Binding->Socket, Config);
+    if (Send->SendData == NULL) {
+        QuicLibraryReleaseBinding(Binding);
+        return NULL;
+    }
+
+    Send->Binding = Binding;
+    Send->Route = *Config->Route;
+    Send->MaxPacketSize = Config->MaxPacketSize;
+    Send->ECN = Config->ECN;
+    Send->Flags = Config->Flags;
+    Send->InUse = TRUE;
+    Send->HoldCount = 0;
+    Send->TotalDatagramsLength = 0;
+    Send->TotalCountDatagrams = 0;
+
+    return Send->SendData;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicWorkerReleaseCoalescedSend(
+    _In_ QUIC_WORKER* Worker,
+    _In_ uint32_t DatagramsLength,
+    _In_ uint32_t CountDatagrams
+    )
+{
+    QUIC_COALESCED_SEND* Send = &Worker->CoalescedSend;
+    CXPLAT_DBG_ASSERT(Send->SendData != NULL);
+    CXPLAT_DBG_ASSERT(Send->InUse);
+
+    Send->InUse = FALSE;
+    Send->TotalDatagramsLength += DatagramsLength;
+    Send->TotalCountDatagrams += CountDatagrams;
+
+    if (CxPlatSendDataIsFull(Send->SendData)) {
+        QuicWorkerFlushCoalescedSend(Worker);
+    }
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicWorkerUpdateQueueDelay(
@@ -392,11 +555,47 @@ QuicWorkerUpdateQueueDelay(
     )
 {
     Worker->AverageQueueDelay = (7 * Worker->AverageQueueDelay + TimeInQueueUs) / 8;
+
+    uint32_t Bucket = 0;
+    for (uint32_t Limit = 10;
+         Bucket < QUIC_WORKER_QUEUE_DELAY_BUCKET_COUNT - 1 && TimeInQueueUs >= Limit;
+         Limit *= 10) {
+        Bucket++;
+    }
+    Worker->QueueDelayHistogram[Bucket]++;
+
     QuicTraceEvent(
         WorkerQueueDelayUpdated,
         "[wrkr][%p] QueueDelay = %u",
         Worker,
         Worker->AverageQueueDelay);
+
+    //
+    // With elastic workers, connections queuing up on an active worker means
+    // the active workers can't keep up, so spread the partitions out over one
+    // more worker.
+    //
+    QUIC_WORKER_POOL* WorkerPool = Worker->WorkerPool;
+    if (WorkerPool != NULL && WorkerPool->Elastic &&
+        Worker->AverageQueueDelay > QUIC_WORKER_ELASTIC_SCALE_UP_QUEUE_DELAY_US &&
+        !QuicWorkerIsFolded(Worker)) {
+        const uint16_t ActiveWorkerCount = WorkerPool->ActiveWorkerCount;
+        const uint64_t TimeNow = CxPlatTimeUs64();
+        if (ActiveWorkerCount < WorkerPool->WorkerCount &&
+            CxPlatTimeDiff64(WorkerPool->LastScaleTime, TimeNow) >= QUIC_WORKER_ELASTIC_SCALE_UP_INTERVAL_US &&
+            InterlockedCompareExchange16(
+                (volatile short*)&WorkerPool->ActiveWorkerCount,
+                (short)(ActiveWorkerCount + 1),
+                (short)ActiveWorkerCount) == (short)ActiveWorkerCount) {
+            WorkerPool->LastScaleTime = TimeNow;
+            QuicTraceLogInfo(
+                WorkerPoolScaleUp,
+                "[wrkr][%p] QueueDelay = %u, active workers = %hu",
+                Worker,
+                Worker->AverageQueueDelay,
+                (uint16_t)(ActiveWorkerCount + 1));
+        }
+    }
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -413,19 +612,54 @@ QuicWorkerResetQueueDelay(
         Worker->AverageQueueDelay);
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicWorkerGetStatistics(
+    _In_ const QUIC_WORKER* Worker,
+    _Out_ QUIC_WORKER_STATISTICS* Stats
+    )
+{
+    //
+    // N.B. The counters are read without synchronizing with the worker's
+    // thread, so the snapshot is only approximately consistent.
+    //
+    const uint64_t LifetimeUs = CxPlatTimeDiff64(Worker->CreationTime, CxPlatTimeUs64());
+    const uint64_t BusyTimeUs = Worker->TotalBusyTimeUs;
+
+    Stats->Registration = NULL;
+    Stats->PartitionIndex = Worker->PartitionIndex;
+    Stats->IdealProcessor = QuicLibraryGetPartitionProcessor(Worker->PartitionIndex);
+    Stats->ConnectionCount = (uint32_t)Worker->ConnectionCount;
+    Stats->TimerWheelConnectionCount = Worker->TimerWheel.ConnectionCount;
+    Stats->BusyTimeUs = BusyTimeUs;
+    Stats->IdleTimeUs = LifetimeUs > BusyTimeUs ? LifetimeUs - BusyTimeUs : 0;
+    Stats->OperationsProcessed = Worker->OperationsProcessed;
+    Stats->SendFlushesCutShort = Worker->SendFlushesCutShort;
+    Stats->AverageQueueDelayUs = Worker->AverageQueueDelay;
+    for (uint32_t i = 0; i < QUIC_WORKER_QUEUE_DELAY_BUCKET_COUNT; ++i) {
+        Stats->QueueDelayHistogram[i] = Worker->QueueDelayHistogram[i];
+    }
+}
+
+//
+// Dequeues up to MaxCount connections, in order, under a single acquisition of
+// the worker lock, and prefetches the state processing them touches first.
+//
 _IRQL_requires_max_(PASSIVE_LEVEL)
-QUIC_CONNECTION*
-QuicWorkerGetNextConnection(
-    _In_ QUIC_WORKER* Worker
+uint32_t
+QuicWorkerGetNextConnections(
+    _In_ QUIC_WORKER* Worker,
+    _Out_writes_to_(MaxCount, return) QUIC_CONNECTION** Connections,
+    _In_ uint32_t MaxCount
     )
 {
-    QUIC_CONNECTION* Connection = NULL;
+    uint32_t Count = 0;
 
     if (Worker->Enabled &&
         !CxPlatListIsEmptyNoFence(&Worker->Connections)) {
         CxPlatDispatchLockAcquire(&Worker->Lock);
-        if (!CxPlatListIsEmpty(&Worker->Connections)) {
-            Connection =
+        while (Count < MaxCount && !CxPlatListIsEmpty(&Worker->Connections)) {
+            QUIC_CONNECTION* Connection =
                 CXPLAT_CONTAINING_RECORD(
                     CxPlatListRemoveHead(&Worker->Connections), QUIC_CONNECTION, WorkerLink);
             if (Worker->PriorityConnectionsTail == &Connection->WorkerLink.Flink) {
@@ -437,11 +671,18 @@ QuicWorkerGetNextConnection(
             Connection->HasPriorityWork = FALSE;
             Connection->WorkerProcessing = TRUE;
             QuicPerfCounterDecrement(QUIC_PERF_COUNTER_CONN_QUEUE_DEPTH);
+            Connections[Count++] = Connection;
         }
         CxPlatDispatchLockRelease(&Worker->Lock);
+
+        for (uint32_t i = 0; i < Count; ++i) {
+            CxPlatPrefetch(&Connections[i]->State);
+            CxPlatPrefetch(&Connections[i]->OperQ);
+            CxPlatPrefetch(&Connections[i]->Send);
+        }
     }
 
-    return Connection;
+    return Count;
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -502,6 +743,63 @@ QuicWorkerProcessTimers(
     }
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicWorkerProcessPacing(
+    _In_ QUIC_WORKER* Worker,
+    _In_ CXPLAT_THREAD_ID ThreadID,
+    _In_ uint64_t TimeNow
+    )
+{
+    //
+    // Get the list of all connections with paced sends due from the pacing
+    // wheel, and send for all of them back to back.
+    //
+    CXPLAT_LIST_ENTRY ExpiredPacing;
+    CxPlatListInitializeHead(&ExpiredPacing);
+    QuicPacingWheelGetExpired(&Worker->PacingWheel, TimeNow, &ExpiredPacing);
+
+    while (!CxPlatListIsEmpty(&ExpiredPacing)) {
+        CXPLAT_LIST_ENTRY* Entry = CxPlatListRemoveHead(&ExpiredPacing);
+        Entry->Flink = NULL;
+
+        QUIC_CONNECTION* Connection =
+            CXPLAT_CONTAINING_RECORD(Entry, QUIC_CONNECTION, PacingLink);
+
+        Connection->WorkerThreadID = ThreadID;
+        QuicConfigurationAttachSilo(Connection->Configuration);
+        QuicConnPacingTimerExpired(Connection);
+        QuicConfigurationDetachSilo();
+        Connection->WorkerThreadID = 0;
+        QuicConnRelease(Connection, QUIC_CONN_REF_WORKER);
+    }
+}
+
+//
+// With elastic workers, returns TRUE if the connection needs to move to a
+// different worker, either because its worker was folded away, or because it
+// was folded onto its worker, and its own partition's worker is active again.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+QuicWorkerIsMisplaced(
+    _In_ const QUIC_WORKER* Worker,
+    _In_ const QUIC_CONNECTION* Connection
+    )
+{
+    const QUIC_WORKER_POOL* WorkerPool = Worker->WorkerPool;
+    if (WorkerPool == NULL || !WorkerPool->Elastic ||
+        Connection->Registration == NULL ||
+        Connection->Registration->NoPartitioning ||
+        Connection->State.UpdateWorker) {
+        return FALSE;
+    }
+    return
+        QuicWorkerIsFolded(Worker) ||
+        (Connection->FoldedWorker &&
+         QuicPartitionIdGetIndex(Connection->PartitionID) < WorkerPool->ActiveWorkerCount);
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicWorkerProcessConnection(
@@ -533,6 +831,11 @@ QuicWorkerProcessConnection(
         }
 
         QuicWorkerUpdateQueueDelay(Worker, Delay);
+        QuicPerfHistogramRecord(QUIC_PERF_HISTOGRAM_QUEUE_DELAY, Delay);
+        if (Connection->LatencyHistograms != NULL) {
+            QuicLatencyHistogramRecord(
+                &Connection->LatencyHistograms->QueueDelay, Delay);
+        }
     }
 
     //
@@ -548,6 +851,7 @@ QuicWorkerProcessConnection(
         //
         Connection->State.UpdateWorker = FALSE;
         QuicTimerWheelUpdateConnection(&Worker->TimerWheel, Connection);
+        QuicPacingWheelUpdateConnection(&Worker->PacingWheel, Connection, *TimeNow);
 
         //
         // When the worker changes the app layer needs to be informed so that
@@ -567,11 +871,74 @@ QuicWorkerProcessConnection(
     }
 
     //
-    // Process some operations.
+    // An idle sibling worker may have asked for this connection while it sat
+    // in the queue. If so, don't process it here. Hand it (and its timers)
+    // off instead, so that its queued work runs on the idle worker's thread.
     //
+    QUIC_WORKER* StealingWorker = Connection->StealingWorker;
+    if (StealingWorker != NULL) {
+        Connection->StealingWorker = NULL;
+        StealingWorker->StealPending = FALSE;
+        if (!StealingWorker->Enabled || Connection->State.UpdateWorker) {
+            StealingWorker = NULL;
+        }
+    }
+
     BOOLEAN StillHasPriorityWork = FALSE;
-    BOOLEAN StillHasWorkToDo =
-        QuicConnDrainOperations(Connection, &StillHasPriorityWork) | Connection->State.UpdateWorker;
+    BOOLEAN StillHasWorkToDo;
+    if (StealingWorker != NULL) {
+        QuicTraceLogConnInfo(
+            WorkerStolen,
+            Connection,
+            "Handing off to idle worker %p",
+            StealingWorker);
+        Connection->State.UpdateWorker = TRUE;
+        StillHasWorkToDo = TRUE;
+    } else if (QuicWorkerIsMisplaced(Worker, Connection)) {
+        QuicTraceLogConnInfo(
+            WorkerElasticMove,
+            Connection,
+            "Moving off worker %p, as active workers changed",
+            Worker);
+        Connection->State.UpdateWorker = TRUE;
+        StillHasWorkToDo = TRUE;
+    } else {
+        //
+        // Process some operations.
+        //
+        StillHasWorkToDo =
+            QuicConnDrainOperations(Connection, &StillHasPriorityWork) | Connection->State.UpdateWorker;
+
+        //
+        // Account the time spent to both the worker and the connection, and
+        // move the connection off if the worker is looking to shed one of its
+        // size.
+        //
+        const uint64_t DrainEndTime = CxPlatTimeUs64();
+        const uint32_t BusyTimeUs =
+            (uint32_t)CXPLAT_MIN(UINT32_MAX, CxPlatTimeDiff64(*TimeNow, DrainEndTime));
+        *TimeNow = DrainEndTime;
+
+        if (Connection->LoadIntervalStart != Worker->LoadIntervalStart) {
+            Connection->LastBusyTimeUs =
+                Connection->LoadIntervalStart == Worker->LastLoadIntervalStart ?
+                    Connection->BusyTimeUs : 0;
+            Connection->BusyTimeUs = 0;
+            Connection->LoadIntervalStart = Worker->LoadIntervalStart;
+        }
+        Connection->BusyTimeUs =
+            (uint32_t)CXPLAT_MIN(UINT32_MAX, (uint64_t)Connection->BusyTimeUs + BusyTimeUs);
+        Worker->BusyTimeUs += BusyTimeUs;
+        Worker->TotalBusyTimeUs += BusyTimeUs;
+
+        if (Worker->RebalancePartition != UINT16_MAX &&
+            Connection->LastBusyTimeUs >= Worker->RebalanceMinBusyTimeUs &&
+            Connection->LastBusyTimeUs <= Worker->RebalanceMaxBusyTimeUs &&
+            QuicConnTryRebalance(Connection, Worker->RebalancePartition)) {
+            Worker->RebalancePartition = UINT16_MAX;
+            StillHasWorkToDo = TRUE;
+        }
+    }
     Connection->WorkerThreadID = 0;
 
     //
@@ -614,14 +981,20 @@ QuicWorkerProcessConnection(
         if (Connection->State.UpdateWorker) {
             //
             // Now that we know we want to process this connection, assign it
-            // to the correct registration. Remove it from the current worker's
-            // timer wheel, and it will be added to the new one, when first
-            // processed on the other worker.
+            // to the correct registration (or the worker stealing it). Remove
+            // it from the current worker's timer wheel, and it will be added
+            // to the new one, when first processed on the other worker.
             //
             QuicTimerWheelRemoveConnection(&Worker->TimerWheel, Connection);
-            CXPLAT_FRE_ASSERT(Connection->Registration != NULL);
-            QuicRegistrationQueueNewConnection(Connection->Registration, Connection);
-            CXPLAT_DBG_ASSERT(Worker != Connection->Worker);
+            QuicPacingWheelRemoveConnection(&Worker->PacingWheel, Connection);
+            if (StealingWorker != NULL) {
+                Connection->FoldedWorker = FALSE;
+                QuicWorkerAssignConnection(StealingWorker, Connection);
+            } else {
+                CXPLAT_FRE_ASSERT(Connection->Registration != NULL);
+                QuicRegistrationQueueNewConnection(Connection->Registration, Connection);
+            }
+            CXPLAT_DBG_ASSERT(Worker != Connection->Worker || (Worker->WorkerPool != NULL && Worker->WorkerPool->Elastic));
             QuicWorkerMoveConnection(Connection->Worker, Connection, StillHasPriorityWork);
         }
 
@@ -682,6 +1055,275 @@ QuicWorkerLoopCleanup(
         --Dequeue;
     }
     QuicPerfCounterAdd(QUIC_PERF_COUNTER_WORK_OPER_QUEUE_DEPTH, Dequeue);
+
+    if (Worker->CoalescedSend.SendData != NULL) {
+        QuicWorkerFlushCoalescedSend(Worker);
+    }
+
+    QuicQlogFlush(&Worker->QlogBuffer);
+    QuicCaptureFlush(&Worker->CaptureBuffer);
+}
+
+//
+// With elastic workers, folds the last active worker's partitions onto the
+// other active workers, if they could take on its load and still have plenty
+// of headroom left. Its connections move off as they are next processed.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicWorkerPoolTryScaleDown(
+    _In_ QUIC_WORKER_POOL* WorkerPool,
+    _In_ uint64_t TimeNow
+    )
+{
+    const uint16_t ActiveWorkerCount = WorkerPool->ActiveWorkerCount;
+    if (ActiveWorkerCount < 2 ||
+        CxPlatTimeDiff64(WorkerPool->LastScaleTime, TimeNow) < QUIC_WORKER_ELASTIC_SCALE_DOWN_INTERVAL_US) {
+        return;
+    }
+
+    uint32_t TotalBusyPercent = 0;
+    for (uint16_t i = 0; i < ActiveWorkerCount; ++i) {
+        const QUIC_WORKER* Worker = &WorkerPool->Workers[i];
+        if (Worker->AverageQueueDelay > QUIC_WORKER_ELASTIC_SCALE_UP_QUEUE_DELAY_US / 4) {
+            return;
+        }
+        if (Worker->LoadIntervalStart + 2 * QUIC_WORKER_LOAD_INTERVAL_US >= TimeNow) {
+            TotalBusyPercent += Worker->BusyPercent;
+        }
+    }
+
+    if (TotalBusyPercent >= (uint32_t)(ActiveWorkerCount - 1) * QUIC_WORKER_ELASTIC_SCALE_DOWN_BUSY_PERCENT) {
+        return;
+    }
+
+    if (InterlockedCompareExchange16(
+            (volatile short*)&WorkerPool->ActiveWorkerCount,
+            (short)(ActiveWorkerCount - 1),
+            (short)ActiveWorkerCount) == (short)ActiveWorkerCount) {
+        WorkerPool->LastScaleTime = TimeNow;
+        QuicTraceLogInfo(
+            WorkerPoolScaleDown,
+            "[wrkr][%p] Busy %u%% total, active workers = %hu",
+            WorkerPool,
+            TotalBusyPercent,
+            (uint16_t)(ActiveWorkerCount - 1));
+    }
+}
+
+//
+// Called at the end of each load interval to compute how busy the worker was
+// over it. If the worker has been much busier than its least loaded sibling
+// for long enough, it starts looking for a connection to move to the sibling's
+// partition.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicWorkerUpdateLoad(
+    _In_ QUIC_WORKER* Worker,
+    _In_ uint64_t TimeNow
+    )
+{
+    const uint64_t IntervalUs = CxPlatTimeDiff64(Worker->LoadIntervalStart, TimeNow);
+    Worker->BusyPercent = (uint8_t)CXPLAT_MIN(100, Worker->BusyTimeUs * 100 / IntervalUs);
+    Worker->BusyTimeUs = 0;
+    Worker->PollTimeUs = 0;
+    Worker->LastLoadIntervalStart = Worker->LoadIntervalStart;
+    Worker->LoadIntervalStart = TimeNow;
+    Worker->RebalancePartition = UINT16_MAX;
+
+    QUIC_WORKER_POOL* WorkerPool = Worker->WorkerPool;
+    if (WorkerPool == NULL || WorkerPool->WorkerCount < 2 || QuicWorkerIsFolded(Worker)) {
+        return;
+    }
+
+    if (WorkerPool->Elastic) {
+        QuicWorkerPoolTryScaleDown(WorkerPool, TimeNow);
+    }
+
+    //
+    // Find the least loaded sibling. A sibling that hasn't finished a load
+    // interval in a while has been idle for all that time. Siblings on other
+    // NUMA nodes are only picked for a larger imbalance.
+    //
+    const QUIC_WORKER* MinSibling = NULL;
+    uint8_t MinBusyPercent = UINT8_MAX;
+    for (uint16_t i = 0; i < WorkerPool->WorkerCount; ++i) {
+        const QUIC_WORKER* Sibling = &WorkerPool->Workers[i];
+        if (Sibling == Worker || !Sibling->Enabled || QuicWorkerIsFolded(Sibling)) {
+            continue;
+        }
+        uint8_t BusyPercent =
+            Sibling->LoadIntervalStart + 2 * QUIC_WORKER_LOAD_INTERVAL_US < TimeNow ?
+                0 : Sibling->BusyPercent;
+        if (Sibling->NumaNode != Worker->NumaNode) {
+            BusyPercent += QUIC_WORKER_REMOTE_NODE_LOAD_PENALTY;
+        }
+        if (BusyPercent < MinBusyPercent) {
+            MinSibling = Sibling;
+            MinBusyPercent = BusyPercent;
+        }
+    }
+
+    if (MinSibling == NULL ||
+        Worker->BusyPercent < MinBusyPercent + QUIC_WORKER_REBALANCE_MIN_LOAD_GAP) {
+        Worker->ImbalancedIntervals = 0;
+        return;
+    }
+
+    if (++Worker->ImbalancedIntervals < QUIC_WORKER_REBALANCE_INTERVAL_COUNT) {
+        return;
+    }
+    Worker->ImbalancedIntervals = 0;
+
+    //
+    // Move a connection that accounts for a good part of the difference, but
+    // for no more than half of it, so that the two workers don't just end up
+    // trading places.
+    //
+    const uint64_t GapUs = (uint64_t)(Worker->BusyPercent - MinBusyPercent) * IntervalUs / 100;
+    Worker->RebalanceMaxBusyTimeUs = (uint32_t)CXPLAT_MIN(UINT32_MAX, GapUs / 2);
+    Worker->RebalanceMinBusyTimeUs = Worker->RebalanceMaxBusyTimeUs / 4;
+    Worker->RebalancePartition = MinSibling->PartitionIndex;
+    QuicTraceLogInfo(
+        WorkerRebalance,
+        "[wrkr][%p] Busy %hhu%% vs %hhu%%, rebalancing to partition %hu",
+        Worker,
+        Worker->BusyPercent,
+        MinBusyPercent,
+        Worker->RebalancePartition);
+}
+
+//
+// Called when the worker has run out of work, to take some from a sibling
+// worker whose queue is backed up. The connection isn't taken directly, since
+// its timers still live on the sibling's timer and pacing wheels, which only
+// the sibling's thread touches. Instead, a queued connection is marked and the
+// sibling hands it off, without processing it, when it next dequeues it. So a
+// connection is still only ever processed by a single thread at a time.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicWorkerTrySteal(
+    _In_ QUIC_WORKER* Worker
+    )
+{
+    QUIC_WORKER_POOL* WorkerPool = Worker->WorkerPool;
+    if (WorkerPool == NULL || WorkerPool->WorkerCount < 2 ||
+        Worker->StealPending || !Worker->Enabled || QuicWorkerIsFolded(Worker)) {
+        return;
+    }
+
+    //
+    // Siblings on the same NUMA node are tried first, so the connection's
+    // memory stays local to the node, if possible.
+    //
+    for (uint32_t i = 0; i < 2u * WorkerPool->WorkerCount; ++i) {
+        QUIC_WORKER* Sibling = &WorkerPool->Workers[i % WorkerPool->WorkerCount];
+        const BOOLEAN SameNode = i < WorkerPool->WorkerCount;
+        if (Sibling == Worker ||
+            (Sibling->NumaNode == Worker->NumaNode) != SameNode ||
+            !Sibling->Enabled ||
+            Sibling->AverageQueueDelay < QUIC_WORKER_STEAL_MIN_QUEUE_DELAY_US ||
+            CxPlatListIsEmptyNoFence(&Sibling->Connections)) {
+            continue;
+        }
+
+        CxPlatDispatchLockAcquire(&Sibling->Lock);
+
+        //
+        // Priority connections are left where they are. Of the rest, the
+        // first is skipped too, as the sibling gets to it soonest anyway.
+        //
+        CXPLAT_LIST_ENTRY* Entry = *Sibling->PriorityConnectionsTail;
+        if (Entry != &Sibling->Connections) {
+            Entry = Entry->Flink;
+        }
+        for (uint32_t Scanned = 0;
+             Entry != &Sibling->Connections && Scanned < QUIC_WORKER_STEAL_MAX_SCAN;
+             Entry = Entry->Flink, ++Scanned) {
+            QUIC_CONNECTION* Connection =
+                CXPLAT_CONTAINING_RECORD(Entry, QUIC_CONNECTION, WorkerLink);
+            if (Connection->StealingWorker == NULL &&
+                Connection->State.Connected &&
+                !Connection->State.UpdateWorker) {
+                Connection->StealingWorker = Worker;
+                Worker->StealPending = TRUE;
+                QuicTraceLogConnVerbose(
+                    WorkerStealRequested,
+                    Connection,
+                    "Idle worker %p requested hand off",
+                    Worker);
+                break;
+            }
+        }
+
+        CxPlatDispatchLockRelease(&Sibling->Lock);
+
+        if (Worker->StealPending) {
+            break;
+        }
+    }
+}
+
+//
+// Called when new work arrives after the worker ran out of work, to learn how
+// long the worker typically stays idle.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicWorkerUpdateIdleGap(
+    _In_ QUIC_WORKER* Worker,
+    _In_ uint64_t TimeNow
+    )
+{
+    const uint64_t IdleGapUs = CxPlatTimeDiff64(Worker->IdleStartTime, TimeNow);
+    Worker->AverageIdleGapUs = (7 * Worker->AverageIdleGapUs + IdleGapUs) / 8;
+    if (Worker->Polling) {
+        Worker->PollTimeUs += IdleGapUs;
+        Worker->Polling = FALSE;
+    }
+    Worker->IdleStartTime = 0;
+}
+
+//
+// Decides whether a worker that just ran out of work should keep polling for
+// more, instead of going to sleep.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+QuicWorkerShouldPoll(
+    _In_ QUIC_WORKER* Worker,
+    _In_ const CXPLAT_EXECUTION_STATE* State
+    )
+{
+    const uint64_t PollWindowUs = MsQuicLib.ExecutionConfig->PollingIdleTimeoutUs;
+    if (!(MsQuicLib.ExecutionConfig->Flags & QUIC_EXECUTION_CONFIG_FLAG_ADAPTIVE_POLL)) {
+        return PollWindowUs > CxPlatTimeDiff64(State->LastWorkTime, State->TimeNow);
+    }
+
+    if (Worker->IdleStartTime == 0) {
+        Worker->IdleStartTime = State->TimeNow;
+    }
+    const uint64_t IdleTimeUs = CxPlatTimeDiff64(Worker->IdleStartTime, State->TimeNow);
+
+    //
+    // Only poll while new work usually shows up within the polling window, and
+    // while the worker hasn't used up its polling budget for this interval.
+    //
+    if (IdleTimeUs < PollWindowUs &&
+        Worker->AverageIdleGapUs < PollWindowUs &&
+        Worker->PollTimeUs + IdleTimeUs <
+            QUIC_WORKER_LOAD_INTERVAL_US * QUIC_WORKER_ADAPTIVE_POLL_BUDGET_PERCENT / 100) {
+        Worker->Polling = TRUE;
+        return TRUE;
+    }
+
+    if (Worker->Polling) {
+        Worker->PollTimeUs += IdleTimeUs;
+        Worker->Polling = FALSE;
+    }
+    return FALSE;
 }
 
 //
@@ -716,12 +1358,18 @@ QuicWorkerLoop(
     // validation.
     //
     QuicPerfCounterTrySnapShot(State->TimeNow);
+    QuicPerfExportTryUpdate(State->TimeNow);
+
+    if (CxPlatTimeDiff64(Worker->LoadIntervalStart, State->TimeNow) >= QUIC_WORKER_LOAD_INTERVAL_US) {
+        QuicWorkerUpdateLoad(Worker, State->TimeNow);
+    }
 
     //
     // For every loop of the worker thread, in an attempt to balance things,
-    // first the timer wheel is checked and any expired timers are processed.
-    // Then, a single connection will be processed (if available), followed by a
-    // single stateless operation (if available).
+    // first the timer and pacing wheels are checked and any expired timers and
+    // paced sends are processed. Then, a small batch of connections will be
+    // processed (if available), followed by a single stateless operation (if
+    // available).
     //
 
     if (Worker->TimerWheel.NextExpirationTime != UINT64_MAX &&
@@ -730,9 +1378,19 @@ QuicWorkerLoop(
         State->NoWorkCount = 0;
     }
 
-    QUIC_CONNECTION* Connection = QuicWorkerGetNextConnection(Worker);
-    if (Connection != NULL) {
-        QuicWorkerProcessConnection(Worker, Connection, State->ThreadID, &State->TimeNow);
+    if (Worker->PacingWheel.NextExpirationTime != UINT64_MAX &&
+        Worker->PacingWheel.NextExpirationTime <= State->TimeNow) {
+        QuicWorkerProcessPacing(Worker, State->ThreadID, State->TimeNow);
+        State->NoWorkCount = 0;
+    }
+
+    QUIC_CONNECTION* Connections[QUIC_WORKER_CONNECTION_BATCH_SIZE];
+    const uint32_t ConnectionCount =
+        QuicWorkerGetNextConnections(Worker, Connections, ARRAYSIZE(Connections));
+    for (uint32_t i = 0; i < ConnectionCount; ++i) {
+        QuicWorkerProcessConnection(Worker, Connections[i], State->ThreadID, &State->TimeNow);
+    }
+    if (ConnectionCount != 0) {
         Worker->ExecutionContext.Ready = TRUE;
         State->NoWorkCount = 0;
     }
@@ -748,6 +1406,30 @@ QuicWorkerLoop(
         State->NoWorkCount = 0;
     }
 
+    if (Worker->IdleStartTime != 0 && (ConnectionCount != 0 || Operation != NULL)) {
+        QuicWorkerUpdateIdleGap(Worker, State->TimeNow);
+    }
+
+    //
+    // A send batch shared by connections is held across a few iterations, so
+    // that other connections to the same remote can append to it, but it is
+    // always sent before the worker goes idle.
+    //
+    if (Worker->CoalescedSend.SendData != NULL &&
+        (!Worker->ExecutionContext.Ready ||
+         ++Worker->CoalescedSend.HoldCount >= QUIC_MAX_COALESCED_SEND_HOLD_COUNT)) {
+        QuicWorkerFlushCoalescedSend(Worker);
+    }
+
+    //
+    // Like the send batch, qlog records and captured datagrams are handed to
+    // the app before the worker goes idle.
+    //
+    if (!Worker->ExecutionContext.Ready) {
+        QuicQlogFlush(&Worker->QlogBuffer);
+        QuicCaptureFlush(&Worker->CaptureBuffer);
+    }
+
     if (Worker->ExecutionContext.Ready) {
         //
         // There is more work to be done.
@@ -755,9 +1437,12 @@ QuicWorkerLoop(
         return TRUE;
     }
 
-    if (MsQuicLib.ExecutionConfig &&
-        (uint64_t)MsQuicLib.ExecutionConfig->PollingIdleTimeoutUs >
-            CxPlatTimeDiff64(State->LastWorkTime, State->TimeNow)) {
+    //
+    // Before going idle, check if a sibling worker could use the help.
+    //
+    QuicWorkerTrySteal(Worker);
+
+    if (MsQuicLib.ExecutionConfig && QuicWorkerShouldPoll(Worker, State)) {
         //
         // Busy loop for a while to keep the thread hot in case new work comes
         // in.
@@ -771,13 +1456,16 @@ QuicWorkerLoop(
     // or any timer to expire.
     //
     Worker->IsActive = FALSE;
-    Worker->ExecutionContext.NextTimeUs = Worker->TimerWheel.NextExpirationTime;
+    Worker->ExecutionContext.NextTimeUs =
+        CXPLAT_MIN(
+            Worker->TimerWheel.NextExpirationTime,
+            Worker->PacingWheel.NextExpirationTime);
     QuicTraceEvent(
         WorkerActivityStateUpdated,
         "[wrkr][%p] IsActive = %hhu, Arg = %u",
         Worker,
         Worker->IsActive,
-        (uint32_t)Worker->TimerWheel.NextExpirationTime);
+        (uint32_t)Worker->ExecutionContext.NextTimeUs);
     QuicWorkerResetQueueDelay(Worker);
     return TRUE;
 }
@@ -854,6 +1542,12 @@ QuicWorkerPoolInitialize(
 
     CxPlatZeroMemory(WorkerPool, WorkerPoolSize);
     WorkerPool->WorkerCount = WorkerCount;
+    WorkerPool->Elastic =
+        WorkerCount > 1 &&
+        MsQuicLib.ExecutionConfig &&
+        MsQuicLib.ExecutionConfig->Flags & QUIC_EXECUTION_CONFIG_FLAG_ELASTIC_WORKERS;
+    WorkerPool->ActiveWorkerCount = WorkerPool->Elastic ? 1 : WorkerCount;
+    WorkerPool->LastScaleTime = CxPlatTimeUs64();
 
     //
     // Create the set of worker threads and soft affinitize them in order to
@@ -862,6 +1556,7 @@ QuicWorkerPoolInitialize(
 
     QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
     for (uint16_t i = 0; i < WorkerCount; i++) {
+        WorkerPool->Workers[i].WorkerPool = WorkerPool;
         Status = QuicWorkerInitialize(Registration, ExecProfile, i, &WorkerPool->Workers[i]);
         if (QUIC_FAILED(Status)) {
             for (uint16_t j = 0; j < i; j++) {
@@ -912,23 +1607,31 @@ QuicWorkerPoolIsOverloaded(
 _IRQL_requires_max_(DISPATCH_LEVEL)
 uint16_t
 QuicWorkerPoolGetLeastLoadedWorker(
-    _In_ QUIC_WORKER_POOL* WorkerPool
+    _In_ QUIC_WORKER_POOL* WorkerPool,
+    _In_ uint16_t NumaNode
     )
 {
     //
     // In order to prevent bursts of calls to this function always returning
     // the same worker (because the worker's queue delay doesn't actually
     // increase until the connection is processed), we test all other workers
-    // first to see if an equal or less loaded worker is available.
+    // first to see if an equal or less loaded worker is available. Workers on
+    // other NUMA nodes are treated as more loaded than they are.
     //
 
     uint16_t Worker = (WorkerPool->LastWorker + 1) % WorkerPool->WorkerCount;
     uint64_t MinQueueDelay = WorkerPool->Workers[Worker].AverageQueueDelay;
+    if (WorkerPool->Workers[Worker].NumaNode != NumaNode) {
+        MinQueueDelay += QUIC_WORKER_REMOTE_NODE_QUEUE_DELAY_US;
+    }
     uint16_t MinQueueDelayWorker = Worker;
 
     while ((Worker != WorkerPool->LastWorker) && (MinQueueDelay > 0)) {
         Worker = (Worker + 1) % WorkerPool->WorkerCount;
         uint64_t QueueDelayTime = WorkerPool->Workers[Worker].AverageQueueDelay;
+        if (WorkerPool->Workers[Worker].NumaNode != NumaNode) {
+            QueueDelayTime += QUIC_WORKER_REMOTE_NODE_QUEUE_DELAY_US;
+        }
         if (QueueDelayTime < MinQueueDelay) {
             MinQueueDelay = QueueDelayTime;
             MinQueueDelayWorker = Worker;
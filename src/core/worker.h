@@ -5,6 +5,49 @@
 
 --*/
 
+//
+// A send batch that connections sharing a binding and remote address append
+// their datagrams to, so that they go out in a single (segmented) send.
+//
+typedef struct QUIC_COALESCED_SEND {
+
+    //
+    // The held send data, or NULL if nothing is held.
+    //
+    CXPLAT_SEND_DATA* SendData;
+
+    //
+    // The binding (referenced while held) and route the batch is sent on.
+    //
+    QUIC_BINDING* Binding;
+    CXPLAT_ROUTE Route;
+
+    //
+    // The send config the batch was allocated with. Only sends with the same
+    // config can be appended.
+    //
+    uint16_t MaxPacketSize;
+    uint8_t ECN;
+    uint8_t Flags;
+
+    //
+    // TRUE while a packet builder is writing datagrams into the batch.
+    //
+    BOOLEAN InUse;
+
+    //
+    // The number of worker loop iterations the batch has been held for.
+    //
+    uint8_t HoldCount;
+
+    //
+    // The datagrams written into the batch so far.
+    //
+    uint32_t TotalDatagramsLength;
+    uint32_t TotalCountDatagrams;
+
+} QUIC_COALESCED_SEND;
+
 //
 // A worker thread for draining queued operations on a connection.
 //
@@ -26,6 +69,13 @@ typedef struct QUIC_CACHEALIGN QUIC_WORKER {
     //
     BOOLEAN IsExternal;
 
+    //
+    // Set once ExecutionContext is added to the platform worker. That happens
+    // on the first wake, so the partition's platform thread only starts once
+    // the partition has work (unless QUIC_EXECUTION_CONFIG_FLAG_PREWARM).
+    //
+    BOOLEAN ExecutionContextAdded;
+
     //
     // TRUE if the worker is currently running.
     //
@@ -36,26 +86,107 @@ typedef struct QUIC_CACHEALIGN QUIC_WORKER {
     //
     BOOLEAN IsActive;
 
+    //
+    // TRUE while a connection queued on a sibling worker is waiting to be
+    // handed off to this worker.
+    //
+    BOOLEAN StealPending;
+
     //
     // The index into the partition array (of processors).
     //
     uint16_t PartitionIndex;
 
+    //
+    // The NUMA node of the partition's processor.
+    //
+    uint16_t NumaNode;
+
     //
     // The average queue delay connections experience, in microseconds.
     //
     uint32_t AverageQueueDelay;
 
+    //
+    // The time spent processing work in the current load interval, and the
+    // percentage of the last interval that was spent doing so.
+    //
+    uint64_t LoadIntervalStart;
+    uint64_t LastLoadIntervalStart;
+    uint64_t BusyTimeUs;
+    uint8_t BusyPercent;
+
+    //
+    // The number of consecutive load intervals the worker has been much busier
+    // than its least loaded sibling.
+    //
+    uint8_t ImbalancedIntervals;
+
+    //
+    // The partition to move one of the worker's connections to, or UINT16_MAX
+    // if none, along with the range of time (per load interval) the moved
+    // connection must have kept the worker busy for.
+    //
+    uint16_t RebalancePartition;
+    uint32_t RebalanceMinBusyTimeUs;
+    uint32_t RebalanceMaxBusyTimeUs;
+
+    //
+    // With adaptive polling, the time the worker last ran out of work (zero
+    // while it has work), the average time (in us) until new work arrived, and
+    // the time spent polling in the current load interval.
+    //
+    uint64_t IdleStartTime;
+    uint64_t AverageIdleGapUs;
+    uint64_t PollTimeUs;
+    BOOLEAN Polling;
+
+    //
+    // Lifetime statistics, reported via QUIC_PARAM_GLOBAL_WORKER_STATISTICS.
+    // Except for ConnectionCount, only updated on the worker's thread.
+    //
+    uint64_t CreationTime;
+    uint64_t TotalBusyTimeUs;
+    uint64_t OperationsProcessed;
+    uint64_t SendFlushesCutShort;
+    uint64_t QueueDelayHistogram[QUIC_WORKER_QUEUE_DELAY_BUCKET_COUNT];
+    volatile long ConnectionCount;
+
     //
     // Timers for the worker's connections.
     //
     QUIC_TIMER_WHEEL TimerWheel;
 
+    //
+    // Paced sends for the worker's connections.
+    //
+    QUIC_PACING_WHEEL PacingWheel;
+
+    //
+    // Send batch shared by the worker's connections on a shared binding.
+    //
+    QUIC_COALESCED_SEND CoalescedSend;
+
+    //
+    // qlog records from the worker's connections, not yet flushed.
+    //
+    QUIC_QLOG_BUFFER QlogBuffer;
+
+    //
+    // Captured datagrams from the worker's connections, not yet flushed.
+    //
+    QUIC_CAPTURE_BUFFER CaptureBuffer;
+
     //
     // An event to kick the thread.
     //
     CXPLAT_EVENT Ready;
 
+    //
+    // The pool this worker is a part of.
+    //
+    QUIC_WORKER_POOL* WorkerPool;
+
     //
     // A thread for draining operations from queued connections.
     //
@@ -80,8 +211,8 @@ typedef struct QUIC_CACHEALIGN QUIC_WORKER {
     uint64_t DroppedOperationCount;
 
     CXPLAT_POOL StreamPool; // QUIC_STREAM
-    CXPLAT_POOL DefaultReceiveBufferPool; // QUIC_DEFAULT_STREAM_RECV_BUFFER_SIZE
     CXPLAT_POOL SendRequestPool; // QUIC_SEND_REQUEST
+    CXPLAT_POOL DatagramRelaySendPool; // QUIC_DATAGRAM_RELAY_SEND
     QUIC_SENT_PACKET_POOL SentPacketPool; // QUIC_SENT_PACKET_METADATA
     CXPLAT_POOL ApiContextPool; // QUIC_API_CONTEXT
     CXPLAT_POOL StatelessContextPool; // QUIC_STATELESS_CONTEXT
@@ -104,6 +235,23 @@ typedef struct QUIC_WORKER_POOL {
     //
     uint16_t LastWorker;
 
+    //
+    // TRUE if the number of active workers scales with the load. Otherwise,
+    // all workers are always active.
+    //
+    BOOLEAN Elastic;
+
+    //
+    // The number of workers (the first ones) currently active. The partitions
+    // of the other workers are folded onto the active ones.
+    //
+    volatile uint16_t ActiveWorkerCount;
+
+    //
+    // The last time (in us) a worker was activated or folded away.
+    //
+    uint64_t LastScaleTime;
+
     //
     // All the workers.
     //
@@ -112,6 +260,40 @@ typedef struct QUIC_WORKER_POOL {
 
 } QUIC_WORKER_POOL;
 
+//
+// Returns the active worker that processes the connections of the partition.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+inline
+QUIC_WORKER*
+QuicWorkerPoolGetPartitionWorker(
+    _In_ QUIC_WORKER_POOL* WorkerPool,
+    _In_ uint16_t PartitionIndex
+    )
+{
+    const uint16_t ActiveWorkerCount = WorkerPool->ActiveWorkerCount;
+    return
+        &WorkerPool->Workers[
+            PartitionIndex < ActiveWorkerCount ?
+                PartitionIndex : PartitionIndex % ActiveWorkerCount];
+}
+
+//
+// Returns TRUE if the worker has been folded away by the elastic worker pool,
+// and its partitions are processed by the active workers instead.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+inline
+BOOLEAN
+QuicWorkerIsFolded(
+    _In_ const QUIC_WORKER* Worker
+    )
+{
+    return
+        Worker->WorkerPool != NULL &&
+        Worker->PartitionIndex >= Worker->WorkerPool->ActiveWorkerCount;
+}
+
 //
 // Returns TRUE if the worker is currently overloaded and shouldn't take on more
 // work, if at all possible.
@@ -156,12 +338,14 @@ QuicWorkerPoolIsOverloaded(
     );
 
 //
-// Gets the worker index with the smallest current load.
+// Gets the worker index with the smallest current load, preferring workers on
+// the given NUMA node.
 //
 _IRQL_requires_max_(DISPATCH_LEVEL)
 uint16_t
 QuicWorkerPoolGetLeastLoadedWorker(
-    _In_ QUIC_WORKER_POOL* WorkerPool
+    _In_ QUIC_WORKER_POOL* WorkerPool,
+    _In_ uint16_t NumaNode
     );
 
 //
@@ -205,4 +389,42 @@ void
 QuicWorkerQueueOperation(
     _In_ QUIC_WORKER* Worker,
     _In_ QUIC_OPERATION* Operation
-    );
\ No newline at end of file
+    );
+
+//
+// Gets a send data for a packet builder to write datagrams into. If the worker
+// holds a batch with the same binding, route and send config, that batch is
+// returned so that the datagrams are appended to it. Otherwise, any held batch
+// is sent and a new one is allocated. The caller must give it back with
+// QuicWorkerReleaseCoalescedSend.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+_Success_(return != NULL)
+CXPLAT_SEND_DATA*
+QuicWorkerAllocCoalescedSend(
+    _In_ QUIC_WORKER* Worker,
+    _In_ QUIC_BINDING* Binding,
+    _In_ CXPLAT_SEND_CONFIG* Config
+    );
+
+//
+// Gives back the send data from QuicWorkerAllocCoalescedSend, along with the
+// datagrams written into it. The batch is held for other connections to
+// append to, unless it is full.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicWorkerReleaseCoalescedSend(
+    _In_ QUIC_WORKER* Worker,
+    _In_ uint32_t DatagramsLength,
+    _In_ uint32_t CountDatagrams
+    );
+//
+// Snapshots the worker's runtime statistics.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicWorkerGetStatistics(
+    _In_ const QUIC_WORKER* Worker,
+    _Out_ QUIC_WORKER_STATISTICS* Stats
+    );
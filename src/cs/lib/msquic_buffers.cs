@@ -0,0 +1,260 @@
+#pragma warning disable IDE0073
+//
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+//
+#pragma warning restore IDE0073
+
+using System;
+using System.Buffers;
+using System.Collections.Generic;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+
+namespace Microsoft.Quic
+{
+    internal unsafe partial struct QUIC_BUFFER
+    {
+        public ReadOnlySpan<byte> ReadOnlySpan => new(Buffer, (int)Length);
+    }
+
+    internal static unsafe class MsQuicBufferExtensions
+    {
+        /// <summary>
+        /// The buffers of a receive event. They stay valid until the callback
+        /// returns, or until StreamReceiveComplete if the callback returns
+        /// QUIC_STATUS_PENDING.
+        /// </summary>
+        public static ReadOnlySpan<QUIC_BUFFER> GetBuffers(this ref QUIC_STREAM_EVENT._Anonymous_e__Union._RECEIVE_e__Struct Receive)
+        {
+            return new(Receive.Buffers, (int)Receive.BufferCount);
+        }
+
+        /// <summary>
+        /// Gathers up to Destination.Length bytes of a receive event without
+        /// allocating, returning the number of bytes copied.
+        /// </summary>
+        public static int CopyTo(this ref QUIC_STREAM_EVENT._Anonymous_e__Union._RECEIVE_e__Struct Receive, Span<byte> Destination)
+        {
+            int Copied = 0;
+            for (uint i = 0; i < Receive.BufferCount && Copied < Destination.Length; ++i)
+            {
+                ReadOnlySpan<byte> Source = Receive.Buffers[i].ReadOnlySpan;
+                if (Source.Length > Destination.Length - Copied)
+                {
+                    Source = Source.Slice(0, Destination.Length - Copied);
+                }
+                Source.CopyTo(Destination.Slice(Copied));
+                Copied += Source.Length;
+            }
+            return Copied;
+        }
+
+        /// <summary>
+        /// Queues a QuicSendBuffer on a stream. Ownership passes to MsQuic until
+        /// the matching QUIC_STREAM_EVENT_TYPE_SEND_COMPLETE, where the buffer is
+        /// recovered with QuicSendBuffer.FromSendComplete.
+        /// </summary>
+        public static int StreamSend(this ref QUIC_API_TABLE Table, QUIC_HANDLE* Stream, QuicSendBuffer Buffer, QUIC_SEND_FLAGS Flags)
+        {
+            void* Context = Buffer.Acquire();
+            int Status = Table.StreamSend(Stream, Buffer.Descriptor, 1, Flags, Context);
+            if (MsQuic.StatusFailed(Status))
+            {
+                QuicSendBuffer.FromSendContext(Context).Dispose();
+            }
+            return Status;
+        }
+    }
+
+    /// <summary>
+    /// A send buffer whose memory stays pinned, along with its QUIC_BUFFER
+    /// descriptor, until the send completes. Data is either written into the
+    /// buffer's own pinned storage (Span) or borrowed from caller memory
+    /// (SetMemory), which is pinned through a MemoryHandle. Buffers rented from
+    /// a QuicSendBufferPool go back to the pool on Dispose, so steady state
+    /// sends allocate nothing on the GC heap.
+    /// </summary>
+    internal sealed unsafe class QuicSendBuffer : IDisposable
+    {
+        // The QUIC_BUFFER descriptor lives at the front of the pinned array so
+        // no native memory needs to be managed.
+        private static readonly int DescriptorSize = (sizeof(QUIC_BUFFER) + 7) & ~7;
+
+        private readonly QuicSendBufferPool? Pool;
+        private readonly byte[] Storage;
+        private readonly byte* StoragePointer;
+#if !NET5_0_OR_GREATER
+        private GCHandle StoragePin;
+#endif
+        private MemoryHandle MemoryPin;
+        private GCHandle Self;
+        internal bool Pooled;
+
+        public QuicSendBuffer(int Capacity) : this(Capacity, null)
+        {
+        }
+
+        internal QuicSendBuffer(int Capacity, QuicSendBufferPool? Pool)
+        {
+            if (Capacity < 0)
+            {
+                throw new ArgumentOutOfRangeException(nameof(Capacity));
+            }
+            this.Pool = Pool;
+#if NET5_0_OR_GREATER
+            Storage = GC.AllocateUninitializedArray<byte>(DescriptorSize + Capacity, pinned: true);
+            StoragePointer = (byte*)Unsafe.AsPointer(ref MemoryMarshal.GetArrayDataReference(Storage));
+#else
+            Storage = new byte[DescriptorSize + Capacity];
+            StoragePin = GCHandle.Alloc(Storage, GCHandleType.Pinned);
+            StoragePointer = (byte*)StoragePin.AddrOfPinnedObject();
+#endif
+            Reset();
+        }
+
+#if !NET5_0_OR_GREATER
+        ~QuicSendBuffer()
+        {
+            StoragePin.Free();
+        }
+#endif
+
+        internal QUIC_BUFFER* Descriptor => (QUIC_BUFFER*)StoragePointer;
+
+        public int Capacity => Storage.Length - DescriptorSize;
+
+        /// <summary>The number of bytes that will be sent.</summary>
+        public int Length
+        {
+            get => (int)Descriptor->Length;
+            set
+            {
+                if ((uint)value > (uint)Capacity || Descriptor->Buffer != StoragePointer + DescriptorSize)
+                {
+                    throw new ArgumentOutOfRangeException(nameof(value));
+                }
+                Descriptor->Length = (uint)value;
+            }
+        }
+
+        /// <summary>The whole writable storage; set Length after filling it.</summary>
+        public Span<byte> Span => new(StoragePointer + DescriptorSize, Capacity);
+
+        /// <summary>
+        /// Sends caller memory instead of the internal storage. The memory is
+        /// pinned until the send completes and the buffer is disposed.
+        /// </summary>
+        public void SetMemory(ReadOnlyMemory<byte> Memory)
+        {
+            MemoryPin.Dispose();
+            MemoryPin = Memory.Pin();
+            Descriptor->Buffer = (byte*)MemoryPin.Pointer;
+            Descriptor->Length = (uint)Memory.Length;
+        }
+
+        internal void* Acquire()
+        {
+            if (Self.IsAllocated)
+            {
+                throw new InvalidOperationException("Send already pending");
+            }
+            Self = GCHandle.Alloc(this);
+            return (void*)GCHandle.ToIntPtr(Self);
+        }
+
+        /// <summary>Recovers the buffer passed to StreamSend from its completion.</summary>
+        public static QuicSendBuffer FromSendComplete(ref QUIC_STREAM_EVENT._Anonymous_e__Union._SEND_COMPLETE_e__Struct SendComplete)
+        {
+            return FromSendContext(SendComplete.ClientContext);
+        }
+
+        internal static QuicSendBuffer FromSendContext(void* Context)
+        {
+            GCHandle Handle = GCHandle.FromIntPtr((IntPtr)Context);
+            QuicSendBuffer Buffer = (QuicSendBuffer)Handle.Target!;
+            Handle.Free();
+            Buffer.Self = default;
+            return Buffer;
+        }
+
+        private void Reset()
+        {
+            MemoryPin.Dispose();
+            MemoryPin = default;
+            Descriptor->Buffer = StoragePointer + DescriptorSize;
+            Descriptor->Length = 0;
+        }
+
+        /// <summary>Releases any pinned caller memory and returns the buffer to its pool.</summary>
+        public void Dispose()
+        {
+            if (Self.IsAllocated)
+            {
+                throw new InvalidOperationException("Send still pending");
+            }
+            Reset();
+            if (Pool != null && !Pooled)
+            {
+                Pooled = true;
+                Pool.Return(this);
+            }
+        }
+    }
+
+    /// <summary>
+    /// A pool of fixed capacity QuicSendBuffers backed by the pinned object
+    /// heap (or pinned handles before .NET 5). The pool grows on demand.
+    /// </summary>
+    internal sealed class QuicSendBufferPool
+    {
+        private readonly Stack<QuicSendBuffer> Free;
+        private readonly int BufferCapacity;
+
+        public QuicSendBufferPool(int BufferCapacity, int InitialCount = 0)
+        {
+            this.BufferCapacity = BufferCapacity;
+            Free = new Stack<QuicSendBuffer>(InitialCount);
+            for (int i = 0; i < InitialCount; ++i)
+            {
+                Free.Push(new QuicSendBuffer(BufferCapacity, this) { Pooled = true });
+            }
+        }
+
+        public int BufferSize => BufferCapacity;
+
+        /// <summary>The number of buffers that can be rented without allocating.</summary>
+        public int Available
+        {
+            get
+            {
+                lock (Free)
+                {
+                    return Free.Count;
+                }
+            }
+        }
+
+        public QuicSendBuffer Rent()
+        {
+            lock (Free)
+            {
+                if (Free.Count != 0)
+                {
+                    QuicSendBuffer Buffer = Free.Pop();
+                    Buffer.Pooled = false;
+                    return Buffer;
+                }
+            }
+            return new QuicSendBuffer(BufferCapacity, this);
+        }
+
+        internal void Return(QuicSendBuffer Buffer)
+        {
+            lock (Free)
+            {
+                Free.Push(Buffer);
+            }
+        }
+    }
+}
@@ -41,6 +41,7 @@ namespace Microsoft.Quic
         DISABLED,
         SERVER_ID_IP,
         SERVER_ID_FIXED,
+        SERVER_ID_QUIC_LB,
         COUNT,
     }
 
@@ -99,6 +100,8 @@ namespace Microsoft.Quic
         REVOCATION_CHECK_CACHE_ONLY = 0x00040000,
         INPROC_PEER_CERTIFICATE = 0x00080000,
         SET_CA_CERTIFICATE_FILE = 0x00100000,
+        ASYNC_PRIVATE_KEY = 0x00200000,
+        ENABLE_CERTIFICATE_COMPRESSION = 0x00400000,
     }
 
     [System.Flags]
@@ -142,9 +145,17 @@ namespace Microsoft.Quic
     {
         FIFO = 0x0000,
         ROUND_ROBIN = 0x0001,
+        WEIGHTED_FAIR = 0x0002,
+        EXTENSIBLE_PRIORITY = 0x0003,
         COUNT,
     }
 
+    internal enum QUIC_STREAM_GROUP_SCHEME
+    {
+        QUIC_STREAM_GROUP_SCHEME_SEQUENTIAL = 0,
+        QUIC_STREAM_GROUP_SCHEME_INTERLEAVED = 1,
+    }
+
     [System.Flags]
     internal enum QUIC_STREAM_OPEN_FLAGS
     {
@@ -152,6 +163,9 @@ namespace Microsoft.Quic
         UNIDIRECTIONAL = 0x0001,
         ZERO_RTT = 0x0002,
         DELAY_ID_FC_UPDATES = 0x0004,
+        APP_OWNED_BUFFERS = 0x0008,
+        ZERO_COPY_RECEIVE = 0x0010,
+        COMPRESSED = 0x0020,
     }
 
     [System.Flags]
@@ -218,6 +232,17 @@ namespace Microsoft.Quic
         XDP = 0x0004,
         NO_IDEAL_PROC = 0x0008,
         HIGH_PRIORITY = 0x0010,
+        IO_URING = 0x0020,
+        ZERO_COPY_SEND = 0x0040,
+        PACING_OFFLOAD = 0x0080,
+        BUSY_POLL = 0x0100,
+        ELASTIC_WORKERS = 0x0200,
+        EXTERNAL = 0x0400,
+        ADAPTIVE_POLL = 0x0800,
+        HUGE_PAGES = 0x1000,
+        PARTITION_SOCKETS = 0x2000,
+        CID_FLOW_STEERING = 0x4000,
+        PREWARM = 0x8000,
     }
 
     internal unsafe partial struct QUIC_EXECUTION_CONFIG
@@ -480,6 +505,9 @@ namespace Microsoft.Quic
     {
         CUBIC,
         BBR,
+        BBR3,
+        PRAGUE,
+        COPA,
         MAX,
     }
 
@@ -785,17 +813,31 @@ namespace Microsoft.Quic
             }
         }
 
-        [NativeTypeName("uint32_t : 25")]
+        [NativeTypeName("uint32_t : 1")]
+        internal uint L4sEnabled
+        {
+            get
+            {
+                return (_bitfield >> 7) & 0x1u;
+            }
+
+            set
+            {
+                _bitfield = (_bitfield & ~(0x1u << 7)) | ((value & 0x1u) << 7);
+            }
+        }
+
+        [NativeTypeName("uint32_t : 24")]
         internal uint RESERVED
         {
             get
             {
-                return (_bitfield >> 7) & 0x1FFFFFFu;
+                return (_bitfield >> 8) & 0xFFFFFFu;
             }
 
             set
             {
-                _bitfield = (_bitfield & ~(0x1FFFFFFu << 7)) | ((value & 0x1FFFFFFu) << 7);
+                _bitfield = (_bitfield & ~(0xFFFFFFu << 8)) | ((value & 0xFFFFFFu) << 8);
             }
         }
 
@@ -888,6 +930,84 @@ namespace Microsoft.Quic
 
         [NativeTypeName("uint32_t")]
         internal uint SendEcnCongestionCount;
+
+        [NativeTypeName("uint32_t")]
+        internal uint SendL4sAlpha;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong SendCeMarkedPackets;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong SendSchedulingLimitedTimeUs;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong SendPacingLimitedTimeUs;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong SendCongestionLimitedTimeUs;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong SendAmplificationLimitedTimeUs;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong SendConnFlowControlLimitedTimeUs;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong SendStreamFlowControlLimitedTimeUs;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong SendAppLimitedTimeUs;
+    }
+
+    internal unsafe partial struct QUIC_LATENCY_HISTOGRAM
+    {
+        [NativeTypeName("uint64_t")]
+        internal ulong Count;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong Sum;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong Max;
+
+        [NativeTypeName("uint32_t [124]")]
+        internal fixed uint Buckets[124];
+    }
+
+    internal partial struct QUIC_CONNECTION_LATENCY_HISTOGRAMS
+    {
+        internal QUIC_LATENCY_HISTOGRAM Rtt;
+
+        internal QUIC_LATENCY_HISTOGRAM SendToAck;
+
+        internal QUIC_LATENCY_HISTOGRAM QueueDelay;
+    }
+
+    internal enum QUIC_FLIGHT_RECORDER_EVENT_TYPE
+    {
+        QUIC_FLIGHT_RECORDER_EVENT_CONNECTED,
+        QUIC_FLIGHT_RECORDER_EVENT_HANDSHAKE_CONFIRMED,
+        QUIC_FLIGHT_RECORDER_EVENT_CLOSED_LOCALLY,
+        QUIC_FLIGHT_RECORDER_EVENT_CLOSED_REMOTELY,
+        QUIC_FLIGHT_RECORDER_EVENT_PACKET_LOST,
+        QUIC_FLIGHT_RECORDER_EVENT_PROBE_TIMEOUT,
+        QUIC_FLIGHT_RECORDER_EVENT_CONGESTION_WINDOW,
+        QUIC_FLIGHT_RECORDER_EVENT_API_CALL,
+    }
+
+    internal partial struct QUIC_FLIGHT_RECORDER_EVENT
+    {
+        [NativeTypeName("uint64_t")]
+        internal ulong TimeUs;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong Value;
+
+        [NativeTypeName("uint32_t")]
+        internal uint Type;
+
+        [NativeTypeName("uint32_t")]
+        internal uint Detail;
     }
 
     internal partial struct QUIC_LISTENER_STATISTICS
@@ -902,6 +1022,233 @@ namespace Microsoft.Quic
         internal ulong BindingRecvDroppedPackets;
     }
 
+    internal partial struct QUIC_PREFERRED_ADDRESS
+    {
+        [NativeTypeName("QUIC_ADDR")]
+        internal QuicAddr Ipv4Address;
+
+        [NativeTypeName("QUIC_ADDR")]
+        internal QuicAddr Ipv6Address;
+    }
+
+    internal unsafe partial struct QUIC_LISTENER_SNI_CONFIGURATION
+    {
+        [NativeTypeName("const char *")]
+        internal sbyte* ServerName;
+
+        [NativeTypeName("HQUIC")]
+        internal QUIC_HANDLE* Configuration;
+    }
+
+    internal unsafe partial struct QUIC_WORKER_STATISTICS
+    {
+        [NativeTypeName("HQUIC")]
+        internal QUIC_HANDLE* Registration;
+
+        [NativeTypeName("uint16_t")]
+        internal ushort PartitionIndex;
+
+        [NativeTypeName("uint16_t")]
+        internal ushort IdealProcessor;
+
+        [NativeTypeName("uint32_t")]
+        internal uint ConnectionCount;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong TimerWheelConnectionCount;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong BusyTimeUs;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong IdleTimeUs;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong OperationsProcessed;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong SendFlushesCutShort;
+
+        [NativeTypeName("uint32_t")]
+        internal uint AverageQueueDelayUs;
+
+        [NativeTypeName("uint64_t [6]")]
+        internal fixed ulong QueueDelayHistogram[6];
+    }
+
+    internal partial struct QUIC_DATAPATH_QUEUE_STATISTICS
+    {
+        [NativeTypeName("uint32_t")]
+        internal uint InterfaceIndex;
+
+        [NativeTypeName("uint32_t")]
+        internal uint QueueId;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong RxPackets;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong TxPackets;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong RxDropped;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong RxRingFull;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong RxFillRingEmpty;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong RxFillStarved;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong TxRingFull;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong TxBufferExhausted;
+
+        [NativeTypeName("uint32_t")]
+        internal uint RxRingUsed;
+
+        [NativeTypeName("uint32_t")]
+        internal uint RxFillRingUsed;
+
+        [NativeTypeName("uint32_t")]
+        internal uint TxRingUsed;
+
+        [NativeTypeName("uint32_t")]
+        internal uint TxCompletionRingUsed;
+
+        [NativeTypeName("uint32_t")]
+        internal uint RxRingSize;
+
+        [NativeTypeName("uint32_t")]
+        internal uint TxRingSize;
+    }
+
+    internal partial struct QUIC_MEMORY_USAGE
+    {
+        [NativeTypeName("uint64_t")]
+        internal ulong ConnectionBytes;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong StreamBytes;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong SendBufferBytes;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong RecvBufferBytes;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong SentPacketMetadataBytes;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong TlsBytes;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong PathBytes;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong PacketSpaceBytes;
+    }
+
+    internal partial struct QUIC_REGISTRATION_QOS
+    {
+        [NativeTypeName("uint32_t")]
+        internal uint SchedulingWeight;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong MaxEgressRate;
+    }
+
+    internal enum QUIC_MEMORY_PRESSURE_LEVEL
+    {
+        QUIC_MEMORY_PRESSURE_NONE,
+        QUIC_MEMORY_PRESSURE_ELEVATED,
+        QUIC_MEMORY_PRESSURE_HIGH,
+        QUIC_MEMORY_PRESSURE_CRITICAL,
+    }
+
+    internal unsafe partial struct QUIC_MEMORY_BUDGET
+    {
+        [NativeTypeName("uint64_t")]
+        internal ulong Limit;
+
+        [NativeTypeName("QUIC_MEMORY_PRESSURE_CALLBACK_HANDLER")]
+        internal delegate* unmanaged[Cdecl]<void*, QUIC_MEMORY_PRESSURE_LEVEL, void> Handler;
+
+        internal void* Context;
+    }
+
+    internal unsafe partial struct QUIC_LOAD_BALANCING_CONFIG
+    {
+        [NativeTypeName("uint8_t")]
+        internal byte ConfigId;
+
+        [NativeTypeName("uint8_t")]
+        internal byte ServerIdLength;
+
+        [NativeTypeName("uint8_t")]
+        internal byte NonceLength;
+
+        [NativeTypeName("BOOLEAN")]
+        internal byte EncodeLength;
+
+        [NativeTypeName("BOOLEAN")]
+        internal byte Encrypt;
+
+        [NativeTypeName("uint8_t [15]")]
+        internal fixed byte ServerId[15];
+
+        [NativeTypeName("uint8_t [16]")]
+        internal fixed byte Key[16];
+    }
+
+    internal partial struct QUIC_SOURCE_RATE_LIMIT
+    {
+        [NativeTypeName("uint32_t")]
+        internal uint RetryRate;
+
+        [NativeTypeName("uint32_t")]
+        internal uint DropRate;
+
+        [NativeTypeName("uint8_t")]
+        internal byte Ipv4PrefixLength;
+
+        [NativeTypeName("uint8_t")]
+        internal byte Ipv6PrefixLength;
+    }
+
+    internal partial struct QUIC_ZERO_RTT_ANTI_REPLAY
+    {
+        [NativeTypeName("uint32_t")]
+        internal uint WindowMs;
+
+        [NativeTypeName("uint32_t")]
+        internal uint MaxEntries;
+    }
+
+    internal unsafe partial struct QUIC_QLOG_HANDLER
+    {
+        [NativeTypeName("QUIC_QLOG_CALLBACK_HANDLER")]
+        internal delegate* unmanaged[Cdecl]<void*, sbyte*, uint, void> Handler;
+
+        internal void* Context;
+    }
+
+    internal unsafe partial struct QUIC_PACKET_CAPTURE_CONFIG
+    {
+        [NativeTypeName("QUIC_PACKET_CAPTURE_CALLBACK_HANDLER")]
+        internal delegate* unmanaged[Cdecl]<void*, byte*, uint, void> Handler;
+
+        internal void* Context;
+
+        [NativeTypeName("uint32_t")]
+        internal uint SampleRate;
+    }
+
     internal enum QUIC_PERFORMANCE_COUNTERS
     {
         CONN_CREATED,
@@ -939,6 +1286,92 @@ namespace Microsoft.Quic
         MAX,
     }
 
+    internal enum QUIC_PERF_HISTOGRAMS
+    {
+        QUIC_PERF_HISTOGRAM_HANDSHAKE_TIME,
+        QUIC_PERF_HISTOGRAM_QUEUE_DELAY,
+        QUIC_PERF_HISTOGRAM_RTT,
+        QUIC_PERF_HISTOGRAM_MAX,
+    }
+
+    internal partial struct QUIC_PERF_EXPORT_HEADER
+    {
+        [NativeTypeName("uint32_t")]
+        internal uint Version;
+
+        [NativeTypeName("uint32_t")]
+        internal uint ProcessorCount;
+
+        [NativeTypeName("uint32_t")]
+        internal uint CounterCount;
+
+        [NativeTypeName("uint32_t")]
+        internal uint HistogramCount;
+
+        [NativeTypeName("volatile int64_t")]
+        internal long Sequence;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong UpdateTimeUs;
+    }
+
+    internal unsafe partial struct QUIC_PERF_EXPORT_PROCESSOR
+    {
+        [NativeTypeName("int64_t [32]")]
+        internal fixed long Counters[32];
+
+        [NativeTypeName("QUIC_LATENCY_HISTOGRAM [3]")]
+        internal _Histograms_e__FixedBuffer Histograms;
+
+        internal partial struct _Histograms_e__FixedBuffer
+        {
+            internal QUIC_LATENCY_HISTOGRAM e0;
+            internal QUIC_LATENCY_HISTOGRAM e1;
+            internal QUIC_LATENCY_HISTOGRAM e2;
+
+            internal ref QUIC_LATENCY_HISTOGRAM this[int index]
+            {
+                get
+                {
+                    return ref MemoryMarshal.CreateSpan(ref e0, 3)[index];
+                }
+            }
+        }
+    }
+
+    internal unsafe partial struct QUIC_PERF_EXPORT
+    {
+        internal void* Buffer;
+
+        [NativeTypeName("uint32_t")]
+        internal uint BufferLength;
+
+        [NativeTypeName("uint32_t")]
+        internal uint IntervalUs;
+    }
+
+    internal enum QUIC_PERF_STAGES
+    {
+        QUIC_PERF_STAGE_RECEIVE,
+        QUIC_PERF_STAGE_DELIVER,
+        QUIC_PERF_STAGE_DECRYPT,
+        QUIC_PERF_STAGE_FRAMES,
+        QUIC_PERF_STAGE_STREAM_DELIVERY,
+        QUIC_PERF_STAGE_SEND,
+        QUIC_PERF_STAGE_ENCRYPT,
+        QUIC_PERF_STAGE_DATAPATH_SEND,
+        QUIC_PERF_STAGE_MAX,
+    }
+
+    internal partial struct QUIC_PERF_STAGE_CYCLES
+    {
+        [NativeTypeName("uint64_t")]
+        internal ulong Cycles;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong Calls;
+    }
+
     internal unsafe partial struct QUIC_VERSION_SETTINGS
     {
         [NativeTypeName("const uint32_t *")]
@@ -974,6 +1407,9 @@ namespace Microsoft.Quic
         [NativeTypeName("uint32_t")]
         internal uint FixedServerID;
 
+        [NativeTypeName("uint32_t")]
+        internal uint ConnectionPoolPrewarmCount;
+
         internal ref ulong IsSetFlags
         {
             get
@@ -1047,25 +1483,39 @@ namespace Microsoft.Quic
                     }
                 }
 
-                [NativeTypeName("uint64_t : 61")]
-                internal ulong RESERVED
+                [NativeTypeName("uint64_t : 1")]
+                internal ulong ConnectionPoolPrewarmCount
                 {
                     get
                     {
-                        return (_bitfield >> 3) & 0x1FFFFFFFUL;
+                        return (_bitfield >> 3) & 0x1UL;
                     }
 
                     set
                     {
-                        _bitfield = (_bitfield & ~(0x1FFFFFFFUL << 3)) | ((value & 0x1FFFFFFFUL) << 3);
+                        _bitfield = (_bitfield & ~(0x1UL << 3)) | ((value & 0x1UL) << 3);
                     }
                 }
-            }
-        }
-    }
 
-    internal partial struct QUIC_SETTINGS
-    {
+                [NativeTypeName("uint64_t : 60")]
+                internal ulong RESERVED
+                {
+                    get
+                    {
+                        return (_bitfield >> 4) & 0xFFFFFFFUL;
+                    }
+
+                    set
+                    {
+                        _bitfield = (_bitfield & ~(0xFFFFFFFUL << 4)) | ((value & 0xFFFFFFFUL) << 4);
+                    }
+                }
+            }
+        }
+    }
+
+    internal partial struct QUIC_SETTINGS
+    {
         [NativeTypeName("QUIC_SETTINGS::(anonymous union)")]
         internal _Anonymous1_e__Union Anonymous1;
 
@@ -1262,6 +1712,15 @@ namespace Microsoft.Quic
         [NativeTypeName("uint32_t")]
         internal uint StreamRecvWindowUnidiDefault;
 
+        [NativeTypeName("uint8_t")]
+        internal byte NetStatsEventThreshold;
+
+        [NativeTypeName("uint32_t")]
+        internal uint HibernateTimeoutMs;
+
+        [NativeTypeName("uint32_t")]
+        internal uint EarlyCreditWindow;
+
         internal ref ulong IsSetFlags
         {
             get
@@ -1364,6 +1823,58 @@ namespace Microsoft.Quic
             }
         }
 
+        internal ulong CarefulResumeEnabled
+        {
+            get
+            {
+                return Anonymous2.Anonymous.CarefulResumeEnabled;
+            }
+
+            set
+            {
+                Anonymous2.Anonymous.CarefulResumeEnabled = value;
+            }
+        }
+
+        internal ulong ReleaseHandshakeStateEnabled
+        {
+            get
+            {
+                return Anonymous2.Anonymous.ReleaseHandshakeStateEnabled;
+            }
+
+            set
+            {
+                Anonymous2.Anonymous.ReleaseHandshakeStateEnabled = value;
+            }
+        }
+
+        internal ulong ResumptionTicketCacheEnabled
+        {
+            get
+            {
+                return Anonymous2.Anonymous.ResumptionTicketCacheEnabled;
+            }
+
+            set
+            {
+                Anonymous2.Anonymous.ResumptionTicketCacheEnabled = value;
+            }
+        }
+
+        internal ulong AdaptiveAckDelayEnabled
+        {
+            get
+            {
+                return Anonymous2.Anonymous.AdaptiveAckDelayEnabled;
+            }
+
+            set
+            {
+                Anonymous2.Anonymous.AdaptiveAckDelayEnabled = value;
+            }
+        }
+
         internal ulong ReservedFlags
         {
             get
@@ -1994,17 +2505,115 @@ namespace Microsoft.Quic
                     }
                 }
 
-                [NativeTypeName("uint64_t : 21")]
+                [NativeTypeName("uint64_t : 1")]
+                internal ulong CarefulResumeEnabled
+                {
+                    get
+                    {
+                        return (_bitfield >> 43) & 0x1UL;
+                    }
+
+                    set
+                    {
+                        _bitfield = (_bitfield & ~(0x1UL << 43)) | ((value & 0x1UL) << 43);
+                    }
+                }
+
+                [NativeTypeName("uint64_t : 1")]
+                internal ulong NetStatsEventThreshold
+                {
+                    get
+                    {
+                        return (_bitfield >> 44) & 0x1UL;
+                    }
+
+                    set
+                    {
+                        _bitfield = (_bitfield & ~(0x1UL << 44)) | ((value & 0x1UL) << 44);
+                    }
+                }
+
+                [NativeTypeName("uint64_t : 1")]
+                internal ulong HibernateTimeoutMs
+                {
+                    get
+                    {
+                        return (_bitfield >> 45) & 0x1UL;
+                    }
+
+                    set
+                    {
+                        _bitfield = (_bitfield & ~(0x1UL << 45)) | ((value & 0x1UL) << 45);
+                    }
+                }
+
+                [NativeTypeName("uint64_t : 1")]
+                internal ulong ReleaseHandshakeStateEnabled
+                {
+                    get
+                    {
+                        return (_bitfield >> 46) & 0x1UL;
+                    }
+
+                    set
+                    {
+                        _bitfield = (_bitfield & ~(0x1UL << 46)) | ((value & 0x1UL) << 46);
+                    }
+                }
+
+                [NativeTypeName("uint64_t : 1")]
+                internal ulong ResumptionTicketCacheEnabled
+                {
+                    get
+                    {
+                        return (_bitfield >> 47) & 0x1UL;
+                    }
+
+                    set
+                    {
+                        _bitfield = (_bitfield & ~(0x1UL << 47)) | ((value & 0x1UL) << 47);
+                    }
+                }
+
+                [NativeTypeName("uint64_t : 1")]
+                internal ulong EarlyCreditWindow
+                {
+                    get
+                    {
+                        return (_bitfield >> 48) & 0x1UL;
+                    }
+
+                    set
+                    {
+                        _bitfield = (_bitfield & ~(0x1UL << 48)) | ((value & 0x1UL) << 48);
+                    }
+                }
+
+                [NativeTypeName("uint64_t : 1")]
+                internal ulong AdaptiveAckDelayEnabled
+                {
+                    get
+                    {
+                        return (_bitfield >> 49) & 0x1UL;
+                    }
+
+                    set
+                    {
+                        _bitfield = (_bitfield & ~(0x1UL << 49)) | ((value & 0x1UL) << 49);
+                    }
+                }
+
+                [NativeTypeName("uint64_t : 14")]
                 internal ulong RESERVED
                 {
                     get
                     {
-                        return (_bitfield >> 43) & 0x1FFFFFUL;
+                        return (_bitfield >> 50) & 0x3FFFUL;
                     }
 
                     set
                     {
-                        _bitfield = (_bitfield & ~(0x1FFFFFUL << 43)) | ((value & 0x1FFFFFUL) << 43);
+                        _bitfield = (_bitfield & ~(0x3FFFUL << 50)) | ((value & 0x3FFFUL) << 50);
                     }
                 }
             }
@@ -2109,17 +2718,73 @@ namespace Microsoft.Quic
                     }
                 }
 
-                [NativeTypeName("uint64_t : 58")]
+                [NativeTypeName("uint64_t : 1")]
+                internal ulong CarefulResumeEnabled
+                {
+                    get
+                    {
+                        return (_bitfield >> 6) & 0x1UL;
+                    }
+
+                    set
+                    {
+                        _bitfield = (_bitfield & ~(0x1UL << 6)) | ((value & 0x1UL) << 6);
+                    }
+                }
+
+                [NativeTypeName("uint64_t : 1")]
+                internal ulong ReleaseHandshakeStateEnabled
+                {
+                    get
+                    {
+                        return (_bitfield >> 7) & 0x1UL;
+                    }
+
+                    set
+                    {
+                        _bitfield = (_bitfield & ~(0x1UL << 7)) | ((value & 0x1UL) << 7);
+                    }
+                }
+
+                [NativeTypeName("uint64_t : 1")]
+                internal ulong ResumptionTicketCacheEnabled
+                {
+                    get
+                    {
+                        return (_bitfield >> 8) & 0x1UL;
+                    }
+
+                    set
+                    {
+                        _bitfield = (_bitfield & ~(0x1UL << 8)) | ((value & 0x1UL) << 8);
+                    }
+                }
+
+                [NativeTypeName("uint64_t : 1")]
+                internal ulong AdaptiveAckDelayEnabled
+                {
+                    get
+                    {
+                        return (_bitfield >> 9) & 0x1UL;
+                    }
+
+                    set
+                    {
+                        _bitfield = (_bitfield & ~(0x1UL << 9)) | ((value & 0x1UL) << 9);
+                    }
+                }
+
+                [NativeTypeName("uint64_t : 54")]
                 internal ulong ReservedFlags
                 {
                     get
                     {
-                        return (_bitfield >> 6) & 0x3FFFFFFUL;
+                        return (_bitfield >> 10) & 0x3FFFFFFFFFFFFFUL;
                     }
 
                     set
                     {
-                        _bitfield = (_bitfield & ~(0x3FFFFFFUL << 6)) | ((value & 0x3FFFFFFUL) << 6);
+                        _bitfield = (_bitfield & ~(0x3FFFFFFFFFFFFFUL << 10)) | ((value & 0x3FFFFFFFFFFFFFUL) << 10);
                     }
                 }
             }
@@ -2198,75 +2863,263 @@ namespace Microsoft.Quic
                 }
             }
 
-            [NativeTypeName("uint8_t : 1")]
-            internal byte ServerHandshakeTrafficSecret
-            {
-                get
-                {
-                    return (byte)((_bitfield >> 3) & 0x1u);
-                }
+            [NativeTypeName("uint8_t : 1")]
+            internal byte ServerHandshakeTrafficSecret
+            {
+                get
+                {
+                    return (byte)((_bitfield >> 3) & 0x1u);
+                }
+
+                set
+                {
+                    _bitfield = (byte)((_bitfield & ~(0x1u << 3)) | ((value & 0x1u) << 3));
+                }
+            }
+
+            [NativeTypeName("uint8_t : 1")]
+            internal byte ClientTrafficSecret0
+            {
+                get
+                {
+                    return (byte)((_bitfield >> 4) & 0x1u);
+                }
+
+                set
+                {
+                    _bitfield = (byte)((_bitfield & ~(0x1u << 4)) | ((value & 0x1u) << 4));
+                }
+            }
+
+            [NativeTypeName("uint8_t : 1")]
+            internal byte ServerTrafficSecret0
+            {
+                get
+                {
+                    return (byte)((_bitfield >> 5) & 0x1u);
+                }
+
+                set
+                {
+                    _bitfield = (byte)((_bitfield & ~(0x1u << 5)) | ((value & 0x1u) << 5));
+                }
+            }
+        }
+    }
+
+    internal partial struct QUIC_STREAM_STATISTICS
+    {
+        [NativeTypeName("uint64_t")]
+        internal ulong ConnBlockedBySchedulingUs;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong ConnBlockedByPacingUs;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong ConnBlockedByAmplificationProtUs;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong ConnBlockedByCongestionControlUs;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong ConnBlockedByFlowControlUs;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong StreamBlockedByIdFlowControlUs;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong StreamBlockedByFlowControlUs;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong StreamBlockedByAppUs;
+    }
+
+    internal partial struct QUIC_STREAM_PRIORITY_PARAMETERS
+    {
+        [NativeTypeName("uint8_t")]
+        internal byte Urgency;
+
+        [NativeTypeName("BOOLEAN")]
+        internal byte Incremental;
+    }
+
+    internal partial struct QUIC_STREAM_GROUP_PARAMETERS
+    {
+        [NativeTypeName("uint16_t")]
+        internal ushort GroupId;
+
+        [NativeTypeName("uint16_t")]
+        internal ushort Priority;
+
+        [NativeTypeName("uint8_t")]
+        internal byte Weight;
+
+        [NativeTypeName("uint8_t")]
+        internal byte Urgency;
+
+        internal QUIC_STREAM_GROUP_SCHEME Scheme;
+    }
+
+    internal partial struct QUIC_DATAGRAM_UDP_RELAY
+    {
+        [NativeTypeName("uint64_t")]
+        internal ulong QuarterStreamId;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong ContextId;
+
+        [NativeTypeName("QUIC_ADDR")]
+        internal QuicAddr RemoteAddress;
+    }
+
+    internal partial struct QUIC_DATAGRAM_FEC_CONFIG
+    {
+        [NativeTypeName("uint8_t")]
+        internal byte MinBlockSize;
+
+        [NativeTypeName("uint8_t")]
+        internal byte MaxBlockSize;
+    }
+
+    internal partial struct QUIC_DATAGRAM_SEND_POLICY
+    {
+        [NativeTypeName("uint32_t")]
+        internal uint MaxQueueDelayUs;
+
+        [NativeTypeName("uint32_t")]
+        internal uint PriorityMaxQueueDelayUs;
+    }
 
-                set
-                {
-                    _bitfield = (byte)((_bitfield & ~(0x1u << 3)) | ((value & 0x1u) << 3));
-                }
-            }
+    internal partial struct QUIC_STANDBY_PATHS
+    {
+        [NativeTypeName("uint32_t")]
+        internal uint ProbeIntervalMs;
 
-            [NativeTypeName("uint8_t : 1")]
-            internal byte ClientTrafficSecret0
-            {
-                get
-                {
-                    return (byte)((_bitfield >> 4) & 0x1u);
-                }
+        [NativeTypeName("uint32_t")]
+        internal uint LocalAddressCount;
 
-                set
-                {
-                    _bitfield = (byte)((_bitfield & ~(0x1u << 4)) | ((value & 0x1u) << 4));
-                }
-            }
+        [NativeTypeName("QUIC_ADDR[2]")]
+        internal _LocalAddresses_e__FixedBuffer LocalAddresses;
 
-            [NativeTypeName("uint8_t : 1")]
-            internal byte ServerTrafficSecret0
+        internal partial struct _LocalAddresses_e__FixedBuffer
+        {
+            internal QuicAddr e0;
+            internal QuicAddr e1;
+
+            internal ref QuicAddr this[int index]
             {
                 get
                 {
-                    return (byte)((_bitfield >> 5) & 0x1u);
-                }
-
-                set
-                {
-                    _bitfield = (byte)((_bitfield & ~(0x1u << 5)) | ((value & 0x1u) << 5));
+                    return ref MemoryMarshal.CreateSpan(ref e0, 2)[index];
                 }
             }
         }
     }
 
-    internal partial struct QUIC_STREAM_STATISTICS
+    internal unsafe partial struct QUIC_STREAM_COMPRESSION_CONFIG
+    {
+        [NativeTypeName("uint32_t")]
+        internal uint CodecId;
+
+        internal void* Context;
+
+        [NativeTypeName("QUIC_STREAM_COMPRESS_FN")]
+        internal delegate* unmanaged[Cdecl]<void*, byte*, uint, byte*, uint*, int> Compress;
+
+        [NativeTypeName("QUIC_STREAM_DECOMPRESS_FN")]
+        internal delegate* unmanaged[Cdecl]<void*, byte*, uint, byte*, uint, int> Decompress;
+    }
+
+    internal partial struct QUIC_CUSTOM_CC_ACK_EVENT
     {
         [NativeTypeName("uint64_t")]
-        internal ulong ConnBlockedBySchedulingUs;
+        internal ulong TimeNow;
 
         [NativeTypeName("uint64_t")]
-        internal ulong ConnBlockedByPacingUs;
+        internal ulong LargestAck;
 
         [NativeTypeName("uint64_t")]
-        internal ulong ConnBlockedByAmplificationProtUs;
+        internal ulong LargestSentPacketNumber;
 
         [NativeTypeName("uint64_t")]
-        internal ulong ConnBlockedByCongestionControlUs;
+        internal ulong SmoothedRtt;
 
         [NativeTypeName("uint64_t")]
-        internal ulong ConnBlockedByFlowControlUs;
+        internal ulong MinRtt;
+
+        [NativeTypeName("uint32_t")]
+        internal uint NumRetransmittableBytes;
+
+        [NativeTypeName("uint32_t")]
+        internal uint BytesInFlight;
+
+        [NativeTypeName("BOOLEAN")]
+        internal byte IsImplicit;
+
+        [NativeTypeName("BOOLEAN")]
+        internal byte HasLoss;
+
+        [NativeTypeName("BOOLEAN")]
+        internal byte IsLargestAckedPacketAppLimited;
 
+        [NativeTypeName("BOOLEAN")]
+        internal byte MinRttValid;
+    }
+
+    internal partial struct QUIC_CUSTOM_CC_LOSS_EVENT
+    {
         [NativeTypeName("uint64_t")]
-        internal ulong StreamBlockedByIdFlowControlUs;
+        internal ulong LargestPacketNumberLost;
 
         [NativeTypeName("uint64_t")]
-        internal ulong StreamBlockedByFlowControlUs;
+        internal ulong LargestSentPacketNumber;
+
+        [NativeTypeName("uint32_t")]
+        internal uint NumRetransmittableBytes;
+
+        [NativeTypeName("uint32_t")]
+        internal uint BytesInFlight;
+
+        [NativeTypeName("BOOLEAN")]
+        internal byte PersistentCongestion;
+    }
+
+    internal partial struct QUIC_CUSTOM_CC_ECN_EVENT
+    {
+        [NativeTypeName("uint64_t")]
+        internal ulong LargestPacketNumberAcked;
 
         [NativeTypeName("uint64_t")]
-        internal ulong StreamBlockedByAppUs;
+        internal ulong LargestSentPacketNumber;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong NewCeCount;
+    }
+
+    internal unsafe partial struct QUIC_CUSTOM_CONGESTION_CONTROL
+    {
+        [NativeTypeName("const char *")]
+        internal sbyte* Name;
+
+        internal void* Context;
+
+        [NativeTypeName("QUIC_CUSTOM_CC_RESET_FN")]
+        internal delegate* unmanaged[Cdecl]<void*, byte, ushort, uint> Reset;
+
+        [NativeTypeName("QUIC_CUSTOM_CC_ON_DATA_SENT_FN")]
+        internal delegate* unmanaged[Cdecl]<void*, uint, uint, void> OnDataSent;
+
+        [NativeTypeName("QUIC_CUSTOM_CC_ON_DATA_ACKNOWLEDGED_FN")]
+        internal delegate* unmanaged[Cdecl]<void*, QUIC_CUSTOM_CC_ACK_EVENT*, uint> OnDataAcknowledged;
+
+        [NativeTypeName("QUIC_CUSTOM_CC_ON_DATA_LOST_FN")]
+        internal delegate* unmanaged[Cdecl]<void*, QUIC_CUSTOM_CC_LOSS_EVENT*, uint> OnDataLost;
+
+        [NativeTypeName("QUIC_CUSTOM_CC_ON_ECN_FN")]
+        internal delegate* unmanaged[Cdecl]<void*, QUIC_CUSTOM_CC_ECN_EVENT*, uint> OnEcn;
+
+        [NativeTypeName("QUIC_CUSTOM_CC_GET_SEND_ALLOWANCE_FN")]
+        internal delegate* unmanaged[Cdecl]<void*, ulong, byte, uint, uint> GetSendAllowance;
     }
 
     internal unsafe partial struct QUIC_SCHANNEL_CREDENTIAL_ATTRIBUTE_W
@@ -2383,6 +3236,31 @@ namespace Microsoft.Quic
         }
     }
 
+    internal unsafe partial struct QUIC_STREAM_RECEIVE_BATCH_ENTRY
+    {
+        [NativeTypeName("HQUIC")]
+        internal QUIC_HANDLE* Stream;
+
+        internal void* StreamContext;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong AbsoluteOffset;
+
+        [NativeTypeName("uint64_t")]
+        internal ulong TotalBufferLength;
+
+        [NativeTypeName("const QUIC_BUFFER *")]
+        internal QUIC_BUFFER* Buffers;
+
+        [NativeTypeName("uint32_t")]
+        internal uint BufferCount;
+
+        internal QUIC_RECEIVE_FLAGS Flags;
+
+        [NativeTypeName("QUIC_STATUS")]
+        internal int Status;
+    }
+
     internal enum QUIC_CONNECTION_EVENT_TYPE
     {
         CONNECTED = 0,
@@ -2404,6 +3282,8 @@ namespace Microsoft.Quic
         RELIABLE_RESET_NEGOTIATED = 16,
         ONE_WAY_DELAY_NEGOTIATED = 17,
         NETWORK_STATISTICS = 18,
+        DATAGRAM_BATCH_RECEIVED = 19,
+        STREAM_BATCH_RECEIVED = 20,
     }
 
     internal partial struct QUIC_CONNECTION_EVENT
@@ -2565,6 +3445,22 @@ namespace Microsoft.Quic
             }
         }
 
+        internal ref _Anonymous_e__Union._DATAGRAM_BATCH_RECEIVED_e__Struct DATAGRAM_BATCH_RECEIVED
+        {
+            get
+            {
+                return ref MemoryMarshal.GetReference(MemoryMarshal.CreateSpan(ref Anonymous.DATAGRAM_BATCH_RECEIVED, 1));
+            }
+        }
+
+        internal ref _Anonymous_e__Union._STREAM_BATCH_RECEIVED_e__Struct STREAM_BATCH_RECEIVED
+        {
+            get
+            {
+                return ref MemoryMarshal.GetReference(MemoryMarshal.CreateSpan(ref Anonymous.STREAM_BATCH_RECEIVED, 1));
+            }
+        }
+
         [StructLayout(LayoutKind.Explicit)]
         internal partial struct _Anonymous_e__Union
         {
@@ -2644,6 +3540,14 @@ namespace Microsoft.Quic
             [NativeTypeName("struct (anonymous struct)")]
             internal _NETWORK_STATISTICS_e__Struct NETWORK_STATISTICS;
 
+            [FieldOffset(0)]
+            [NativeTypeName("struct (anonymous struct)")]
+            internal _DATAGRAM_BATCH_RECEIVED_e__Struct DATAGRAM_BATCH_RECEIVED;
+
+            [FieldOffset(0)]
+            [NativeTypeName("struct (anonymous struct)")]
+            internal _STREAM_BATCH_RECEIVED_e__Struct STREAM_BATCH_RECEIVED;
+
             internal unsafe partial struct _CONNECTED_e__Struct
             {
                 [NativeTypeName("BOOLEAN")]
@@ -2793,6 +3697,9 @@ namespace Microsoft.Quic
 
                 [NativeTypeName("const uint8_t *")]
                 internal byte* ResumptionState;
+
+                [NativeTypeName("const uint8_t *")]
+                internal byte* ClientRandom;
             }
 
             internal unsafe partial struct _RESUMPTION_TICKET_RECEIVED_e__Struct
@@ -2854,6 +3761,26 @@ namespace Microsoft.Quic
                 [NativeTypeName("uint64_t")]
                 internal ulong Bandwidth;
             }
+
+            internal unsafe partial struct _DATAGRAM_BATCH_RECEIVED_e__Struct
+            {
+                [NativeTypeName("uint32_t")]
+                internal uint DatagramCount;
+
+                [NativeTypeName("const QUIC_BUFFER *")]
+                internal QUIC_BUFFER* Datagrams;
+
+                [NativeTypeName("const QUIC_RECEIVE_FLAGS *")]
+                internal QUIC_RECEIVE_FLAGS* Flags;
+            }
+
+            internal unsafe partial struct _STREAM_BATCH_RECEIVED_e__Struct
+            {
+                [NativeTypeName("uint32_t")]
+                internal uint StreamCount;
+
+                internal QUIC_STREAM_RECEIVE_BATCH_ENTRY* Streams;
+            }
         }
     }
 
@@ -3156,6 +4083,103 @@ namespace Microsoft.Quic
         }
     }
 
+    internal unsafe partial struct QUIC_STREAM_OPEN_SEND_REQUEST
+    {
+        internal QUIC_STREAM_OPEN_FLAGS OpenFlags;
+
+        internal QUIC_STREAM_START_FLAGS StartFlags;
+
+        [NativeTypeName("QUIC_STREAM_CALLBACK_HANDLER")]
+        internal delegate* unmanaged[Cdecl]<QUIC_HANDLE*, void*, QUIC_STREAM_EVENT*, int> Handler;
+
+        internal void* Context;
+
+        [NativeTypeName("const QUIC_BUFFER *")]
+        internal QUIC_BUFFER* Buffers;
+
+        [NativeTypeName("uint32_t")]
+        internal uint BufferCount;
+
+        internal QUIC_SEND_FLAGS SendFlags;
+
+        internal void* ClientSendContext;
+
+        [NativeTypeName("HQUIC")]
+        internal QUIC_HANDLE* Stream;
+    }
+
+    internal unsafe partial struct QUIC_STREAM_SEND_BATCH_REQUEST
+    {
+        [NativeTypeName("const QUIC_BUFFER *")]
+        internal QUIC_BUFFER* Buffers;
+
+        [NativeTypeName("uint32_t")]
+        internal uint BufferCount;
+    }
+
+    internal enum QUIC_QUEUED_EVENT_TYPE
+    {
+        QUIC_QUEUED_EVENT_TYPE_CONNECTION = 0,
+        QUIC_QUEUED_EVENT_TYPE_STREAM = 1,
+    }
+
+    internal unsafe partial struct QUIC_QUEUED_EVENT
+    {
+        internal QUIC_QUEUED_EVENT_TYPE Type;
+
+        [NativeTypeName("HQUIC")]
+        internal QUIC_HANDLE* Handle;
+
+        internal void* Context;
+
+        [NativeTypeName("QUIC_QUEUED_EVENT::(anonymous union)")]
+        internal _Anonymous_e__Union Anonymous;
+
+        [NativeTypeName("QUIC_BUFFER[3]")]
+        internal _ReceiveBuffers_e__FixedBuffer ReceiveBuffers;
+
+        internal ref QUIC_CONNECTION_EVENT CONNECTION
+        {
+            get
+            {
+                return ref MemoryMarshal.GetReference(MemoryMarshal.CreateSpan(ref Anonymous.CONNECTION, 1));
+            }
+        }
+
+        internal ref QUIC_STREAM_EVENT STREAM
+        {
+            get
+            {
+                return ref MemoryMarshal.GetReference(MemoryMarshal.CreateSpan(ref Anonymous.STREAM, 1));
+            }
+        }
+
+        [StructLayout(LayoutKind.Explicit)]
+        internal partial struct _Anonymous_e__Union
+        {
+            [FieldOffset(0)]
+            internal QUIC_CONNECTION_EVENT CONNECTION;
+
+            [FieldOffset(0)]
+            internal QUIC_STREAM_EVENT STREAM;
+        }
+
+        internal partial struct _ReceiveBuffers_e__FixedBuffer
+        {
+            internal QUIC_BUFFER e0;
+            internal QUIC_BUFFER e1;
+            internal QUIC_BUFFER e2;
+
+            internal ref QUIC_BUFFER this[int index]
+            {
+                get
+                {
+                    return ref MemoryMarshal.CreateSpan(ref e0, 3)[index];
+                }
+            }
+        }
+    }
+
     internal unsafe partial struct QUIC_API_TABLE
     {
         [NativeTypeName("QUIC_SET_CONTEXT_FN")]
@@ -3250,6 +4274,27 @@ namespace Microsoft.Quic
 
         [NativeTypeName("QUIC_CONNECTION_COMP_CERT_FN")]
         internal delegate* unmanaged[Cdecl]<QUIC_HANDLE*, byte, QUIC_TLS_ALERT_CODES, int> ConnectionCertificateValidationComplete;
+
+        [NativeTypeName("QUIC_STREAM_PROVIDE_RECEIVE_BUFFERS_FN")]
+        internal delegate* unmanaged[Cdecl]<QUIC_HANDLE*, uint, QUIC_BUFFER*, int> StreamProvideReceiveBuffers;
+
+        [NativeTypeName("QUIC_DATAGRAM_SEND_BATCH_FN")]
+        internal delegate* unmanaged[Cdecl]<QUIC_HANDLE*, QUIC_BUFFER*, uint, QUIC_SEND_FLAGS, void**, int> DatagramSendBatch;
+
+        [NativeTypeName("QUIC_STREAM_OPEN_AND_SEND_FN")]
+        internal delegate* unmanaged[Cdecl]<QUIC_HANDLE*, QUIC_STREAM_OPEN_SEND_REQUEST*, uint, int> StreamOpenAndSend;
+
+        [NativeTypeName("QUIC_STREAM_RECEIVE_COMPLETE_BATCH_FN")]
+        internal delegate* unmanaged[Cdecl]<QUIC_HANDLE*, QUIC_HANDLE**, ulong*, uint, void> StreamReceiveCompleteBatch;
+
+        [NativeTypeName("QUIC_STREAM_RECEIVE_FN")]
+        internal delegate* unmanaged[Cdecl]<QUIC_HANDLE*, QUIC_BUFFER*, uint, ulong*, QUIC_RECEIVE_FLAGS*, int> StreamReceive;
+
+        [NativeTypeName("QUIC_REGISTRATION_POLL_EVENTS_FN")]
+        internal delegate* unmanaged[Cdecl]<QUIC_HANDLE*, QUIC_QUEUED_EVENT*, uint, uint, uint> RegistrationPollEvents;
+
+        [NativeTypeName("QUIC_STREAM_SEND_BATCH_FN")]
+        internal delegate* unmanaged[Cdecl]<QUIC_HANDLE*, QUIC_STREAM_SEND_BATCH_REQUEST*, uint, QUIC_SEND_FLAGS, void*, int> StreamSendBatch;
     }
 
     internal static unsafe partial class MsQuic
@@ -3273,15 +4318,63 @@ namespace Microsoft.Quic
         [NativeTypeName("#define QUIC_STATELESS_RESET_KEY_LENGTH 32")]
         internal const uint QUIC_STATELESS_RESET_KEY_LENGTH = 32;
 
+        [NativeTypeName("#define QUIC_LOAD_BALANCING_MAX_SERVER_ID_LENGTH 15")]
+        internal const uint QUIC_LOAD_BALANCING_MAX_SERVER_ID_LENGTH = 15;
+
+        [NativeTypeName("#define QUIC_LOAD_BALANCING_MIN_NONCE_LENGTH 4")]
+        internal const uint QUIC_LOAD_BALANCING_MIN_NONCE_LENGTH = 4;
+
+        [NativeTypeName("#define QUIC_LOAD_BALANCING_KEY_LENGTH 16")]
+        internal const uint QUIC_LOAD_BALANCING_KEY_LENGTH = 16;
+
+        [NativeTypeName("#define QUIC_REGISTRATION_QOS_MAX_WEIGHT 64")]
+        internal const uint QUIC_REGISTRATION_QOS_MAX_WEIGHT = 64;
+
+        [NativeTypeName("#define QUIC_SOURCE_RATE_LIMIT_MAX_RATE 1000000")]
+        internal const uint QUIC_SOURCE_RATE_LIMIT_MAX_RATE = 1000000;
+
+        [NativeTypeName("#define QUIC_ZERO_RTT_ANTI_REPLAY_MAX_ENTRIES 16777216")]
+        internal const uint QUIC_ZERO_RTT_ANTI_REPLAY_MAX_ENTRIES = 16777216;
+
+        [NativeTypeName("#define QUIC_DATAGRAM_FEC_MAX_BLOCK_SIZE 32")]
+        internal const uint QUIC_DATAGRAM_FEC_MAX_BLOCK_SIZE = 32;
+
+        [NativeTypeName("#define QUIC_MAX_STANDBY_PATHS 2")]
+        internal const uint QUIC_MAX_STANDBY_PATHS = 2;
+
+        [NativeTypeName("#define QUIC_STREAM_COMPRESSION_MAX_BLOCK 16383")]
+        internal const uint QUIC_STREAM_COMPRESSION_MAX_BLOCK = 16383;
+
         [NativeTypeName("#define QUIC_EXECUTION_CONFIG_MIN_SIZE (uint32_t)FIELD_OFFSET(QUIC_EXECUTION_CONFIG, ProcessorList)")]
         internal static readonly uint QUIC_EXECUTION_CONFIG_MIN_SIZE = unchecked((uint)((int)(Marshal.OffsetOf<QUIC_EXECUTION_CONFIG>("ProcessorList"))));
 
         [NativeTypeName("#define QUIC_MAX_TICKET_KEY_COUNT 16")]
         internal const uint QUIC_MAX_TICKET_KEY_COUNT = 16;
 
+        [NativeTypeName("#define QUIC_WORKER_QUEUE_DELAY_BUCKET_COUNT 6")]
+        internal const uint QUIC_WORKER_QUEUE_DELAY_BUCKET_COUNT = 6;
+
         [NativeTypeName("#define QUIC_TLS_SECRETS_MAX_SECRET_LEN 64")]
         internal const uint QUIC_TLS_SECRETS_MAX_SECRET_LEN = 64;
 
+        [NativeTypeName("#define QUIC_STREAM_PRIORITY_URGENCY_MAX 7")]
+        internal const uint QUIC_STREAM_PRIORITY_URGENCY_MAX = 7;
+
+        [NativeTypeName("#define QUIC_STREAM_PRIORITY_URGENCY_DEFAULT 3")]
+        internal const uint QUIC_STREAM_PRIORITY_URGENCY_DEFAULT = 3;
+
+        [NativeTypeName("#define QUIC_LATENCY_HISTOGRAM_BUCKET_COUNT 124")]
+        internal const uint QUIC_LATENCY_HISTOGRAM_BUCKET_COUNT = 124;
+
+        [NativeTypeName("#define QUIC_PERF_EXPORT_VERSION 1")]
+        internal const uint QUIC_PERF_EXPORT_VERSION = 1;
+
+        [NativeTypeName("#define QUIC_PERF_EXPORT_MIN_INTERVAL_US 1000")]
+        internal const uint QUIC_PERF_EXPORT_MIN_INTERVAL_US = 1000;
+
+        [NativeTypeName("#define QUIC_STREAM_GROUP_MAX 64")]
+        internal const uint QUIC_STREAM_GROUP_MAX = 64;
+
         [NativeTypeName("#define QUIC_PARAM_PREFIX_GLOBAL 0x01000000")]
         internal const uint QUIC_PARAM_PREFIX_GLOBAL = 0x01000000;
 
@@ -3345,6 +4438,60 @@ namespace Microsoft.Quic
         [NativeTypeName("#define QUIC_PARAM_GLOBAL_STATELESS_RESET_KEY 0x0100000B")]
         internal const uint QUIC_PARAM_GLOBAL_STATELESS_RESET_KEY = 0x0100000B;
 
+        [NativeTypeName("#define QUIC_PARAM_GLOBAL_SEND_BUFFER_LIMIT 0x0100000C")]
+        internal const uint QUIC_PARAM_GLOBAL_SEND_BUFFER_LIMIT = 0x0100000C;
+
+        [NativeTypeName("#define QUIC_PARAM_GLOBAL_MTU_PROBE_SIZES 0x0100000D")]
+        internal const uint QUIC_PARAM_GLOBAL_MTU_PROBE_SIZES = 0x0100000D;
+
+        [NativeTypeName("#define QUIC_PARAM_GLOBAL_WORKER_STATISTICS 0x0100000E")]
+        internal const uint QUIC_PARAM_GLOBAL_WORKER_STATISTICS = 0x0100000E;
+
+        [NativeTypeName("#define QUIC_PARAM_GLOBAL_MEMORY_BUDGET 0x0100000F")]
+        internal const uint QUIC_PARAM_GLOBAL_MEMORY_BUDGET = 0x0100000F;
+
+        [NativeTypeName("#define QUIC_PARAM_GLOBAL_MEMORY_PRESSURE 0x01000010")]
+        internal const uint QUIC_PARAM_GLOBAL_MEMORY_PRESSURE = 0x01000010;
+
+        [NativeTypeName("#define QUIC_PARAM_GLOBAL_LOAD_BALANCING_CONFIG 0x01000011")]
+        internal const uint QUIC_PARAM_GLOBAL_LOAD_BALANCING_CONFIG = 0x01000011;
+
+        [NativeTypeName("#define QUIC_PARAM_GLOBAL_SOURCE_RATE_LIMIT 0x01000012")]
+        internal const uint QUIC_PARAM_GLOBAL_SOURCE_RATE_LIMIT = 0x01000012;
+
+        [NativeTypeName("#define QUIC_PARAM_GLOBAL_QLOG_HANDLER 0x01000013")]
+        internal const uint QUIC_PARAM_GLOBAL_QLOG_HANDLER = 0x01000013;
+
+        [NativeTypeName("#define QUIC_PARAM_GLOBAL_PERF_EXPORT 0x01000014")]
+        internal const uint QUIC_PARAM_GLOBAL_PERF_EXPORT = 0x01000014;
+
+        [NativeTypeName("#define QUIC_PARAM_GLOBAL_PERF_STAGE_CYCLES 0x01000015")]
+        internal const uint QUIC_PARAM_GLOBAL_PERF_STAGE_CYCLES = 0x01000015;
+
+        [NativeTypeName("#define QUIC_PARAM_GLOBAL_PACKET_CAPTURE 0x01000016")]
+        internal const uint QUIC_PARAM_GLOBAL_PACKET_CAPTURE = 0x01000016;
+
+        [NativeTypeName("#define QUIC_PARAM_GLOBAL_DATAPATH_STATISTICS 0x01000017")]
+        internal const uint QUIC_PARAM_GLOBAL_DATAPATH_STATISTICS = 0x01000017;
+
+        [NativeTypeName("#define QUIC_PARAM_GLOBAL_ZERO_RTT_ANTI_REPLAY 0x01000018")]
+        internal const uint QUIC_PARAM_GLOBAL_ZERO_RTT_ANTI_REPLAY = 0x01000018;
+
+        [NativeTypeName("#define QUIC_PARAM_GLOBAL_TIMER_SLACK 0x01000019")]
+        internal const uint QUIC_PARAM_GLOBAL_TIMER_SLACK = 0x01000019;
+
+        [NativeTypeName("#define QUIC_PARAM_REGISTRATION_SEND_BUFFER_USAGE 0x02000000")]
+        internal const uint QUIC_PARAM_REGISTRATION_SEND_BUFFER_USAGE = 0x02000000;
+
+        [NativeTypeName("#define QUIC_PARAM_REGISTRATION_MEMORY_USAGE 0x02000001")]
+        internal const uint QUIC_PARAM_REGISTRATION_MEMORY_USAGE = 0x02000001;
+
+        [NativeTypeName("#define QUIC_PARAM_REGISTRATION_EVENT_QUEUE_ENABLED 0x02000002")]
+        internal const uint QUIC_PARAM_REGISTRATION_EVENT_QUEUE_ENABLED = 0x02000002;
+
+        [NativeTypeName("#define QUIC_PARAM_REGISTRATION_QOS 0x02000003")]
+        internal const uint QUIC_PARAM_REGISTRATION_QOS = 0x02000003;
+
         [NativeTypeName("#define QUIC_PARAM_CONFIGURATION_SETTINGS 0x03000000")]
         internal const uint QUIC_PARAM_CONFIGURATION_SETTINGS = 0x03000000;
 
@@ -3366,6 +4513,18 @@ namespace Microsoft.Quic
         [NativeTypeName("#define QUIC_PARAM_LISTENER_CIBIR_ID 0x04000002")]
         internal const uint QUIC_PARAM_LISTENER_CIBIR_ID = 0x04000002;
 
+        [NativeTypeName("#define QUIC_PARAM_LISTENER_PREFERRED_ADDRESS 0x04000003")]
+        internal const uint QUIC_PARAM_LISTENER_PREFERRED_ADDRESS = 0x04000003;
+
+        [NativeTypeName("#define QUIC_PARAM_LISTENER_DRAIN 0x04000004")]
+        internal const uint QUIC_PARAM_LISTENER_DRAIN = 0x04000004;
+
+        [NativeTypeName("#define QUIC_PARAM_LISTENER_PARTITIONED 0x04000005")]
+        internal const uint QUIC_PARAM_LISTENER_PARTITIONED = 0x04000005;
+
+        [NativeTypeName("#define QUIC_PARAM_LISTENER_SNI_CONFIGURATIONS 0x04000006")]
+        internal const uint QUIC_PARAM_LISTENER_SNI_CONFIGURATIONS = 0x04000006;
+
         [NativeTypeName("#define QUIC_PARAM_CONN_QUIC_VERSION 0x05000000")]
         internal const uint QUIC_PARAM_CONN_QUIC_VERSION = 0x05000000;
 
@@ -3441,6 +4600,63 @@ namespace Microsoft.Quic
         [NativeTypeName("#define QUIC_PARAM_CONN_ORIG_DEST_CID 0x05000018")]
         internal const uint QUIC_PARAM_CONN_ORIG_DEST_CID = 0x05000018;
 
+        [NativeTypeName("#define QUIC_PARAM_CONN_SEND_MEMORY_REGION 0x05000019")]
+        internal const uint QUIC_PARAM_CONN_SEND_MEMORY_REGION = 0x05000019;
+
+        [NativeTypeName("#define QUIC_PARAM_CONN_DATAGRAM_BATCH_RECEIVE_ENABLED 0x0500001A")]
+        internal const uint QUIC_PARAM_CONN_DATAGRAM_BATCH_RECEIVE_ENABLED = 0x0500001A;
+
+        [NativeTypeName("#define QUIC_PARAM_CONN_SEND_FLUSH_BUDGET 0x0500001B")]
+        internal const uint QUIC_PARAM_CONN_SEND_FLUSH_BUDGET = 0x0500001B;
+
+        [NativeTypeName("#define QUIC_PARAM_CONN_CUSTOM_CONGESTION_CONTROL 0x0500001C")]
+        internal const uint QUIC_PARAM_CONN_CUSTOM_CONGESTION_CONTROL = 0x0500001C;
+
+        [NativeTypeName("#define QUIC_PARAM_CONN_MEMORY_USAGE 0x0500001D")]
+        internal const uint QUIC_PARAM_CONN_MEMORY_USAGE = 0x0500001D;
+
+        [NativeTypeName("#define QUIC_PARAM_CONN_SEND_COALESCING_DELAY 0x0500001E")]
+        internal const uint QUIC_PARAM_CONN_SEND_COALESCING_DELAY = 0x0500001E;
+
+        [NativeTypeName("#define QUIC_PARAM_CONN_STREAM_BATCH_RECEIVE_ENABLED 0x0500001F")]
+        internal const uint QUIC_PARAM_CONN_STREAM_BATCH_RECEIVE_ENABLED = 0x0500001F;
+
+        [NativeTypeName("#define QUIC_PARAM_CONN_STREAM_GROUP 0x05000020")]
+        internal const uint QUIC_PARAM_CONN_STREAM_GROUP = 0x05000020;
+
+        [NativeTypeName("#define QUIC_PARAM_CONN_LATENCY_HISTOGRAMS_ENABLED 0x05000021")]
+        internal const uint QUIC_PARAM_CONN_LATENCY_HISTOGRAMS_ENABLED = 0x05000021;
+
+        [NativeTypeName("#define QUIC_PARAM_CONN_LATENCY_HISTOGRAMS 0x05000022")]
+        internal const uint QUIC_PARAM_CONN_LATENCY_HISTOGRAMS = 0x05000022;
+
+        [NativeTypeName("#define QUIC_PARAM_CONN_QLOG_ENABLED 0x05000023")]
+        internal const uint QUIC_PARAM_CONN_QLOG_ENABLED = 0x05000023;
+
+        [NativeTypeName("#define QUIC_PARAM_CONN_FLIGHT_RECORDER 0x05000024")]
+        internal const uint QUIC_PARAM_CONN_FLIGHT_RECORDER = 0x05000024;
+
+        [NativeTypeName("#define QUIC_PARAM_CONN_PACKET_CAPTURE_ENABLED 0x05000025")]
+        internal const uint QUIC_PARAM_CONN_PACKET_CAPTURE_ENABLED = 0x05000025;
+
+        [NativeTypeName("#define QUIC_PARAM_CONN_DATAGRAM_UDP_RELAY 0x05000026")]
+        internal const uint QUIC_PARAM_CONN_DATAGRAM_UDP_RELAY = 0x05000026;
+
+        [NativeTypeName("#define QUIC_PARAM_CONN_ADDRESS_RACE_DELAY 0x05000027")]
+        internal const uint QUIC_PARAM_CONN_ADDRESS_RACE_DELAY = 0x05000027;
+
+        [NativeTypeName("#define QUIC_PARAM_CONN_DATAGRAM_FEC 0x05000028")]
+        internal const uint QUIC_PARAM_CONN_DATAGRAM_FEC = 0x05000028;
+
+        [NativeTypeName("#define QUIC_PARAM_CONN_STANDBY_PATHS 0x05000029")]
+        internal const uint QUIC_PARAM_CONN_STANDBY_PATHS = 0x05000029;
+
+        [NativeTypeName("#define QUIC_PARAM_CONN_STREAM_COMPRESSION 0x0500002A")]
+        internal const uint QUIC_PARAM_CONN_STREAM_COMPRESSION = 0x0500002A;
+
+        [NativeTypeName("#define QUIC_PARAM_CONN_DATAGRAM_SEND_POLICY 0x0500002B")]
+        internal const uint QUIC_PARAM_CONN_DATAGRAM_SEND_POLICY = 0x0500002B;
+
         [NativeTypeName("#define QUIC_PARAM_TLS_HANDSHAKE_INFO 0x06000000")]
         internal const uint QUIC_PARAM_TLS_HANDSHAKE_INFO = 0x06000000;
 
@@ -3474,6 +4690,12 @@ namespace Microsoft.Quic
         [NativeTypeName("#define QUIC_PARAM_STREAM_RELIABLE_OFFSET 0x08000005")]
         internal const uint QUIC_PARAM_STREAM_RELIABLE_OFFSET = 0x08000005;
 
+        [NativeTypeName("#define QUIC_PARAM_STREAM_PRIORITY_PARAMETERS 0x08000006")]
+        internal const uint QUIC_PARAM_STREAM_PRIORITY_PARAMETERS = 0x08000006;
+
+        [NativeTypeName("#define QUIC_PARAM_STREAM_GROUP 0x08000007")]
+        internal const uint QUIC_PARAM_STREAM_GROUP = 0x08000007;
+
         [NativeTypeName("#define QUIC_API_VERSION_2 2")]
         internal const uint QUIC_API_VERSION_2 = 2;
     }
@@ -52,8 +52,8 @@ tracepoint(CLOG_BINDING_C, BindingListenerAlreadyRegistered , arg2, arg3);\
 // Decoder Ring for PacketTxVersionNegotiation
 // [S][TX][-] VN
 // QuicTraceLogVerbose(
-            PacketTxVersionNegotiation,
-            "[S][TX][-] VN");
+        PacketTxVersionNegotiation,
+        "[S][TX][-] VN");
 ----------------------------------------------------------*/
 #ifndef _clog_2_ARGS_TRACE_PacketTxVersionNegotiation
 #define _clog_2_ARGS_TRACE_PacketTxVersionNegotiation(uniqueId, encoded_arg_string)\
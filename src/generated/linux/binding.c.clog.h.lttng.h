@@ -27,8 +27,8 @@ TRACEPOINT_EVENT(CLOG_BINDING_C, BindingListenerAlreadyRegistered,
 // Decoder Ring for PacketTxVersionNegotiation
 // [S][TX][-] VN
 // QuicTraceLogVerbose(
-            PacketTxVersionNegotiation,
-            "[S][TX][-] VN");
+        PacketTxVersionNegotiation,
+        "[S][TX][-] VN");
 ----------------------------------------------------------*/
 TRACEPOINT_EVENT(CLOG_BINDING_C, PacketTxVersionNegotiation,
     TP_ARGS(
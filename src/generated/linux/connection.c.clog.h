@@ -357,6 +357,32 @@ tracepoint(CLOG_CONNECTION_C, NonActivePathCidRetired , arg1);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for FlightRecorderEvent
+// [conn][%p] Flight recorder: Time=%llu Type=%u Value=%llu Detail=%u
+// QuicTraceLogConnWarning(
+            FlightRecorderEvent,
+            Connection,
+            "Flight recorder: Time=%llu Type=%u Value=%llu Detail=%u",
+            Event->TimeUs,
+            Event->Type,
+            Event->Value,
+            Event->Detail);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Event->TimeUs = arg3
+// arg4 = arg4 = Event->Type = arg4
+// arg5 = arg5 = Event->Value = arg5
+// arg6 = arg6 = Event->Detail = arg6
+----------------------------------------------------------*/
+#ifndef _clog_7_ARGS_TRACE_FlightRecorderEvent
+#define _clog_7_ARGS_TRACE_FlightRecorderEvent(uniqueId, arg1, encoded_arg_string, arg3, arg4, arg5, arg6)\
+tracepoint(CLOG_CONNECTION_C, FlightRecorderEvent , arg1, arg3, arg4, arg5, arg6);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for IgnoreUnreachable
 // [conn][%p] Ignoring received unreachable event (inline)
@@ -452,6 +478,70 @@ tracepoint(CLOG_CONNECTION_C, UnreachableInvalid , arg1);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for ApplySettings
+// [conn][%p] Applying new settings
+// QuicTraceLogConnInfo(
+        ApplySettings,
+        Connection,
+        "Applying new settings");
+// arg1 = arg1 = Connection = arg1
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_ApplySettings
+#define _clog_3_ARGS_TRACE_ApplySettings(uniqueId, arg1, encoded_arg_string)\
+tracepoint(CLOG_CONNECTION_C, ApplySettings , arg1);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for ConnRebalance
+// [conn][%p] Rebalancing to partition %hu
+// QuicTraceLogConnInfo(
+        ConnRebalance,
+        Connection,
+        "Rebalancing to partition %hu",
+        PartitionIndex);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = PartitionIndex = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_ConnRebalance
+#define _clog_4_ARGS_TRACE_ConnRebalance(uniqueId, arg1, encoded_arg_string, arg3)\
+tracepoint(CLOG_CONNECTION_C, ConnRebalance , arg1, arg3);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for PathMetricsSeeded
+// [conn][%p] Seeded path metrics: srtt=%u us, min_rtt=%u us, cwnd=%u, mtu=%hu
+// QuicTraceLogConnInfo(
+        PathMetricsSeeded,
+        Connection,
+        "Seeded path metrics: srtt=%u us, min_rtt=%u us, cwnd=%u, mtu=%hu",
+        Metrics.SmoothedRtt,
+        Metrics.MinRtt,
+        Metrics.CongestionWindow,
+        Metrics.Mtu);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Metrics.SmoothedRtt = arg3
+// arg4 = arg4 = Metrics.MinRtt = arg4
+// arg5 = arg5 = Metrics.CongestionWindow = arg5
+// arg6 = arg6 = Metrics.Mtu = arg6
+----------------------------------------------------------*/
+#ifndef _clog_7_ARGS_TRACE_PathMetricsSeeded
+#define _clog_7_ARGS_TRACE_PathMetricsSeeded(uniqueId, arg1, encoded_arg_string, arg3, arg4, arg5, arg6)\
+tracepoint(CLOG_CONNECTION_C, PathMetricsSeeded , arg1, arg3, arg4, arg5, arg6);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for CloseComplete
 // [conn][%p] Connection close complete
@@ -471,19 +561,21 @@ tracepoint(CLOG_CONNECTION_C, CloseComplete , arg1);\
 
 
 /*----------------------------------------------------------
-// Decoder Ring for Restart
-// [conn][%p] Restart (CompleteReset=%hhu)
+// Decoder Ring for AddressRaceStarted
+// [conn][%p] Racing %!ADDR! against %!ADDR!
 // QuicTraceLogConnInfo(
-        Restart,
-        Connection,
-        "Restart (CompleteReset=%hhu)",
-        CompleteReset);
+            AddressRaceStarted,
+            Connection,
+            "Racing %!ADDR! against %!ADDR!",
+            CASTED_CLOG_BYTEARRAY(sizeof(*RemoteAddress), RemoteAddress),
+            CASTED_CLOG_BYTEARRAY(sizeof(Ipv4Address), &Ipv4Address));
 // arg1 = arg1 = Connection = arg1
-// arg3 = arg3 = CompleteReset = arg3
+// arg3 = arg3 = CASTED_CLOG_BYTEARRAY(sizeof(*RemoteAddress), RemoteAddress) = arg3
+// arg4 = arg4 = CASTED_CLOG_BYTEARRAY(sizeof(Ipv4Address), &Ipv4Address) = arg4
 ----------------------------------------------------------*/
-#ifndef _clog_4_ARGS_TRACE_Restart
-#define _clog_4_ARGS_TRACE_Restart(uniqueId, arg1, encoded_arg_string, arg3)\
-tracepoint(CLOG_CONNECTION_C, Restart , arg1, arg3);\
+#ifndef _clog_7_ARGS_TRACE_AddressRaceStarted
+#define _clog_7_ARGS_TRACE_AddressRaceStarted(uniqueId, arg1, encoded_arg_string, arg3, arg3_len, arg4, arg4_len)\
+tracepoint(CLOG_CONNECTION_C, AddressRaceStarted , arg1, arg3_len, arg3, arg4_len, arg4);\
 
 #endif
 
@@ -491,17 +583,19 @@ tracepoint(CLOG_CONNECTION_C, Restart , arg1, arg3);\
 
 
 /*----------------------------------------------------------
-// Decoder Ring for CryptoStateDiscard
-// [conn][%p] TLS state no longer needed
+// Decoder Ring for Restart
+// [conn][%p] Restart (CompleteReset=%hhu)
 // QuicTraceLogConnInfo(
-            CryptoStateDiscard,
-            Connection,
-            "TLS state no longer needed");
+        Restart,
+        Connection,
+        "Restart (CompleteReset=%hhu)",
+        CompleteReset);
 // arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = CompleteReset = arg3
 ----------------------------------------------------------*/
-#ifndef _clog_3_ARGS_TRACE_CryptoStateDiscard
-#define _clog_3_ARGS_TRACE_CryptoStateDiscard(uniqueId, arg1, encoded_arg_string)\
-tracepoint(CLOG_CONNECTION_C, CryptoStateDiscard , arg1);\
+#ifndef _clog_4_ARGS_TRACE_Restart
+#define _clog_4_ARGS_TRACE_Restart(uniqueId, arg1, encoded_arg_string, arg3)\
+tracepoint(CLOG_CONNECTION_C, Restart , arg1, arg3);\
 
 #endif
 
@@ -528,6 +622,24 @@ tracepoint(CLOG_CONNECTION_C, SetConfiguration , arg1, arg3);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for CachedResumptionTicketUsed
+// [conn][%p] Using cached resumption ticket
+// QuicTraceLogConnInfo(
+                        CachedResumptionTicketUsed,
+                        Connection,
+                        "Using cached resumption ticket");
+// arg1 = arg1 = Connection = arg1
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_CachedResumptionTicketUsed
+#define _clog_3_ARGS_TRACE_CachedResumptionTicketUsed(uniqueId, arg1, encoded_arg_string)\
+tracepoint(CLOG_CONNECTION_C, CachedResumptionTicketUsed , arg1);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for PeerTPSet
 // [conn][%p] Peer Transport Parameters Set
@@ -548,18 +660,20 @@ tracepoint(CLOG_CONNECTION_C, PeerTPSet , arg1);\
 
 /*----------------------------------------------------------
 // Decoder Ring for PeerPreferredAddress
-// [conn][%p] Peer configured preferred address %!ADDR!
+// [conn][%p] Peer configured preferred address %!ADDR! %!ADDR!
 // QuicTraceLogConnInfo(
                 PeerPreferredAddress,
                 Connection,
-                "Peer configured preferred address %!ADDR!",
-                CASTED_CLOG_BYTEARRAY(sizeof(Connection->PeerTransportParams.PreferredAddress), &Connection->PeerTransportParams.PreferredAddress));
+                "Peer configured preferred address %!ADDR! %!ADDR!",
+                CASTED_CLOG_BYTEARRAY(sizeof(Connection->PeerTransportParams.PreferredAddressIpv4), &Connection->PeerTransportParams.PreferredAddressIpv4),
+                CASTED_CLOG_BYTEARRAY(sizeof(Connection->PeerTransportParams.PreferredAddressIpv6), &Connection->PeerTransportParams.PreferredAddressIpv6));
 // arg1 = arg1 = Connection = arg1
-// arg3 = arg3 = CASTED_CLOG_BYTEARRAY(sizeof(Connection->PeerTransportParams.PreferredAddress), &Connection->PeerTransportParams.PreferredAddress) = arg3
+// arg3 = arg3 = CASTED_CLOG_BYTEARRAY(sizeof(Connection->PeerTransportParams.PreferredAddressIpv4), &Connection->PeerTransportParams.PreferredAddressIpv4) = arg3
+// arg4 = arg4 = CASTED_CLOG_BYTEARRAY(sizeof(Connection->PeerTransportParams.PreferredAddressIpv6), &Connection->PeerTransportParams.PreferredAddressIpv6) = arg4
 ----------------------------------------------------------*/
-#ifndef _clog_5_ARGS_TRACE_PeerPreferredAddress
-#define _clog_5_ARGS_TRACE_PeerPreferredAddress(uniqueId, arg1, encoded_arg_string, arg3, arg3_len)\
-tracepoint(CLOG_CONNECTION_C, PeerPreferredAddress , arg1, arg3_len, arg3);\
+#ifndef _clog_7_ARGS_TRACE_PeerPreferredAddress
+#define _clog_7_ARGS_TRACE_PeerPreferredAddress(uniqueId, arg1, encoded_arg_string, arg3, arg3_len, arg4, arg4_len)\
+tracepoint(CLOG_CONNECTION_C, PeerPreferredAddress , arg1, arg3_len, arg3, arg4_len, arg4);\
 
 #endif
 
@@ -678,6 +792,26 @@ tracepoint(CLOG_CONNECTION_C, FirstCidUsage , arg1, arg3);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for PreferredAddressMigration
+// [conn][%p] Migrated to preferred address %!ADDR!
+// QuicTraceLogConnInfo(
+        PreferredAddressMigration,
+        Connection,
+        "Migrated to preferred address %!ADDR!",
+        CASTED_CLOG_BYTEARRAY(sizeof(Path->Route.RemoteAddress), &Path->Route.RemoteAddress));
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = CASTED_CLOG_BYTEARRAY(sizeof(Path->Route.RemoteAddress), &Path->Route.RemoteAddress) = arg3
+----------------------------------------------------------*/
+#ifndef _clog_5_ARGS_TRACE_PreferredAddressMigration
+#define _clog_5_ARGS_TRACE_PreferredAddressMigration(uniqueId, arg1, encoded_arg_string, arg3, arg3_len)\
+tracepoint(CLOG_CONNECTION_C, PreferredAddressMigration , arg1, arg3_len, arg3);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for PathDiscarded
 // [conn][%p] Removing invalid path[%hhu]
@@ -839,17 +973,39 @@ tracepoint(CLOG_CONNECTION_C, CibirIdSet , arg1, arg3, arg4);\
 
 
 /*----------------------------------------------------------
-// Decoder Ring for ApplySettings
-// [conn][%p] Applying new settings
+// Decoder Ring for CustomCongestionControlSet
+// [conn][%p] Using app congestion control %s
 // QuicTraceLogConnInfo(
-        ApplySettings,
+            CustomCongestionControlSet,
+            Connection,
+            "Using app congestion control %s",
+            Connection->CongestionControl.Name);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Connection->CongestionControl.Name = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_CustomCongestionControlSet
+#define _clog_4_ARGS_TRACE_CustomCongestionControlSet(uniqueId, arg1, encoded_arg_string, arg3)\
+tracepoint(CLOG_CONNECTION_C, CustomCongestionControlSet , arg1, arg3);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for AddressRaceSwitch
+// [conn][%p] Switched to racing address %!ADDR!
+// QuicTraceLogConnInfo(
+        AddressRaceSwitch,
         Connection,
-        "Applying new settings");
+        "Switched to racing address %!ADDR!",
+        CASTED_CLOG_BYTEARRAY(sizeof(Path->Route.RemoteAddress), &Path->Route.RemoteAddress));
 // arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = CASTED_CLOG_BYTEARRAY(sizeof(Path->Route.RemoteAddress), &Path->Route.RemoteAddress) = arg3
 ----------------------------------------------------------*/
-#ifndef _clog_3_ARGS_TRACE_ApplySettings
-#define _clog_3_ARGS_TRACE_ApplySettings(uniqueId, arg1, encoded_arg_string)\
-tracepoint(CLOG_CONNECTION_C, ApplySettings , arg1);\
+#ifndef _clog_5_ARGS_TRACE_AddressRaceSwitch
+#define _clog_5_ARGS_TRACE_AddressRaceSwitch(uniqueId, arg1, encoded_arg_string, arg3, arg3_len)\
+tracepoint(CLOG_CONNECTION_C, AddressRaceSwitch , arg1, arg3_len, arg3);\
 
 #endif
 
@@ -1418,6 +1574,26 @@ tracepoint(CLOG_CONNECTION_C, UdpRecvDeferred , arg1, arg3);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for Hibernate
+// [conn][%p] Hibernating, freed %u receive buffers
+// QuicTraceLogConnVerbose(
+        Hibernate,
+        Connection,
+        "Hibernating, freed %u receive buffers",
+        FreedCount);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = FreedCount = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_Hibernate
+#define _clog_4_ARGS_TRACE_Hibernate(uniqueId, arg1, encoded_arg_string, arg3)\
+tracepoint(CLOG_CONNECTION_C, Hibernate , arg1, arg3);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for DatagramReceiveEnableUpdated
 // [conn][%p] Updated datagram receive enabled to %hhu
@@ -1458,6 +1634,152 @@ tracepoint(CLOG_CONNECTION_C, Disable1RttEncrytionUpdated , arg1, arg3);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for SendFlushBudgetUpdated
+// [conn][%p] Updated send flush budget = %u us
+// QuicTraceLogConnVerbose(
+            SendFlushBudgetUpdated,
+            Connection,
+            "Updated send flush budget = %u us",
+            Connection->Send.FlushBudgetUs);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Connection->Send.FlushBudgetUs = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_SendFlushBudgetUpdated
+#define _clog_4_ARGS_TRACE_SendFlushBudgetUpdated(uniqueId, arg1, encoded_arg_string, arg3)\
+tracepoint(CLOG_CONNECTION_C, SendFlushBudgetUpdated , arg1, arg3);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SendCoalescingDelayUpdated
+// [conn][%p] Updated send coalescing delay = %u us
+// QuicTraceLogConnVerbose(
+            SendCoalescingDelayUpdated,
+            Connection,
+            "Updated send coalescing delay = %u us",
+            Connection->Send.CoalescingDelayUs);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Connection->Send.CoalescingDelayUs = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_SendCoalescingDelayUpdated
+#define _clog_4_ARGS_TRACE_SendCoalescingDelayUpdated(uniqueId, arg1, encoded_arg_string, arg3)\
+tracepoint(CLOG_CONNECTION_C, SendCoalescingDelayUpdated , arg1, arg3);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for AddressRaceDelayUpdated
+// [conn][%p] Updated address race delay = %u ms
+// QuicTraceLogConnVerbose(
+            AddressRaceDelayUpdated,
+            Connection,
+            "Updated address race delay = %u ms",
+            Connection->AddressRaceDelayMs);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Connection->AddressRaceDelayMs = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_AddressRaceDelayUpdated
+#define _clog_4_ARGS_TRACE_AddressRaceDelayUpdated(uniqueId, arg1, encoded_arg_string, arg3)\
+tracepoint(CLOG_CONNECTION_C, AddressRaceDelayUpdated , arg1, arg3);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for DatagramFecConfigUpdated
+// [conn][%p] Updated datagram FEC block size = %hhu to %hhu
+// QuicTraceLogConnVerbose(
+            DatagramFecConfigUpdated,
+            Connection,
+            "Updated datagram FEC block size = %hhu to %hhu",
+            Config->MinBlockSize,
+            Config->MaxBlockSize);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Config->MinBlockSize = arg3
+// arg4 = arg4 = Config->MaxBlockSize = arg4
+----------------------------------------------------------*/
+#ifndef _clog_5_ARGS_TRACE_DatagramFecConfigUpdated
+#define _clog_5_ARGS_TRACE_DatagramFecConfigUpdated(uniqueId, arg1, encoded_arg_string, arg3, arg4)\
+tracepoint(CLOG_CONNECTION_C, DatagramFecConfigUpdated , arg1, arg3, arg4);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for StandbyPathsUpdated
+// [conn][%p] Updated standby paths, count = %u, probe interval = %u ms
+// QuicTraceLogConnVerbose(
+            StandbyPathsUpdated,
+            Connection,
+            "Updated standby paths, count = %u, probe interval = %u ms",
+            Config->LocalAddressCount,
+            Config->ProbeIntervalMs);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Config->LocalAddressCount = arg3
+// arg4 = arg4 = Config->ProbeIntervalMs = arg4
+----------------------------------------------------------*/
+#ifndef _clog_5_ARGS_TRACE_StandbyPathsUpdated
+#define _clog_5_ARGS_TRACE_StandbyPathsUpdated(uniqueId, arg1, encoded_arg_string, arg3, arg4)\
+tracepoint(CLOG_CONNECTION_C, StandbyPathsUpdated , arg1, arg3, arg4);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for StreamCompressionUpdated
+// [conn][%p] Updated stream compression codec = %u
+// QuicTraceLogConnVerbose(
+            StreamCompressionUpdated,
+            Connection,
+            "Updated stream compression codec = %u",
+            Config->CodecId);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Config->CodecId = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_StreamCompressionUpdated
+#define _clog_4_ARGS_TRACE_StreamCompressionUpdated(uniqueId, arg1, encoded_arg_string, arg3)\
+tracepoint(CLOG_CONNECTION_C, StreamCompressionUpdated , arg1, arg3);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for DatagramSendPolicyUpdated
+// [conn][%p] Updated datagram max queue delay = %u us (priority %u us)
+// QuicTraceLogConnVerbose(
+            DatagramSendPolicyUpdated,
+            Connection,
+            "Updated datagram max queue delay = %u us (priority %u us)",
+            Policy->MaxQueueDelayUs,
+            Policy->PriorityMaxQueueDelayUs);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Policy->MaxQueueDelayUs = arg3
+// arg4 = arg4 = Policy->PriorityMaxQueueDelayUs = arg4
+----------------------------------------------------------*/
+#ifndef _clog_5_ARGS_TRACE_DatagramSendPolicyUpdated
+#define _clog_5_ARGS_TRACE_DatagramSendPolicyUpdated(uniqueId, arg1, encoded_arg_string, arg3, arg4)\
+tracepoint(CLOG_CONNECTION_C, DatagramSendPolicyUpdated , arg1, arg3, arg4);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for ForceKeyUpdate
 // [conn][%p] Forcing key update
@@ -1904,12 +2226,12 @@ tracepoint(CLOG_CONNECTION_C, ConnSetTimer , arg2, arg3, arg4);\
 // Decoder Ring for ConnExpiredTimer
 // [conn][%p] %hhu expired
 // QuicTraceEvent(
-                ConnExpiredTimer,
-                "[conn][%p] %hhu expired",
-                Connection,
-                (uint8_t)Type);
+        ConnExpiredTimer,
+        "[conn][%p] %hhu expired",
+        Connection,
+        (uint8_t)QUIC_CONN_TIMER_PACING);
 // arg2 = arg2 = Connection = arg2
-// arg3 = arg3 = (uint8_t)Type = arg3
+// arg3 = arg3 = (uint8_t)QUIC_CONN_TIMER_PACING = arg3
 ----------------------------------------------------------*/
 #ifndef _clog_4_ARGS_TRACE_ConnExpiredTimer
 #define _clog_4_ARGS_TRACE_ConnExpiredTimer(uniqueId, encoded_arg_string, arg2, arg3)\
@@ -1924,12 +2246,12 @@ tracepoint(CLOG_CONNECTION_C, ConnExpiredTimer , arg2, arg3);\
 // Decoder Ring for ConnExecTimerOper
 // [conn][%p] Execute: %u
 // QuicTraceEvent(
-                    ConnExecTimerOper,
-                    "[conn][%p] Execute: %u",
-                    Connection,
-                    QUIC_CONN_TIMER_ACK_DELAY);
+        ConnExecTimerOper,
+        "[conn][%p] Execute: %u",
+        Connection,
+        QUIC_CONN_TIMER_PACING);
 // arg2 = arg2 = Connection = arg2
-// arg3 = arg3 = QUIC_CONN_TIMER_ACK_DELAY = arg3
+// arg3 = arg3 = QUIC_CONN_TIMER_PACING = arg3
 ----------------------------------------------------------*/
 #ifndef _clog_4_ARGS_TRACE_ConnExecTimerOper
 #define _clog_4_ARGS_TRACE_ConnExecTimerOper(uniqueId, encoded_arg_string, arg2, arg3)\
@@ -361,6 +361,41 @@ TRACEPOINT_EVENT(CLOG_CONNECTION_C, NonActivePathCidRetired,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for FlightRecorderEvent
+// [conn][%p] Flight recorder: Time=%llu Type=%u Value=%llu Detail=%u
+// QuicTraceLogConnWarning(
+            FlightRecorderEvent,
+            Connection,
+            "Flight recorder: Time=%llu Type=%u Value=%llu Detail=%u",
+            Event->TimeUs,
+            Event->Type,
+            Event->Value,
+            Event->Detail);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Event->TimeUs = arg3
+// arg4 = arg4 = Event->Type = arg4
+// arg5 = arg5 = Event->Value = arg5
+// arg6 = arg6 = Event->Detail = arg6
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_CONNECTION_C, FlightRecorderEvent,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned long long, arg3,
+        unsigned int, arg4,
+        unsigned long long, arg5,
+        unsigned int, arg6), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer(uint64_t, arg3, arg3)
+        ctf_integer(unsigned int, arg4, arg4)
+        ctf_integer(uint64_t, arg5, arg5)
+        ctf_integer(unsigned int, arg6, arg6)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for IgnoreUnreachable
 // [conn][%p] Ignoring received unreachable event (inline)
@@ -465,6 +500,83 @@ TRACEPOINT_EVENT(CLOG_CONNECTION_C, UnreachableInvalid,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for ApplySettings
+// [conn][%p] Applying new settings
+// QuicTraceLogConnInfo(
+        ApplySettings,
+        Connection,
+        "Applying new settings");
+// arg1 = arg1 = Connection = arg1
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_CONNECTION_C, ApplySettings,
+    TP_ARGS(
+        const void *, arg1), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for ConnRebalance
+// [conn][%p] Rebalancing to partition %hu
+// QuicTraceLogConnInfo(
+        ConnRebalance,
+        Connection,
+        "Rebalancing to partition %hu",
+        PartitionIndex);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = PartitionIndex = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_CONNECTION_C, ConnRebalance,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned short, arg3), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer(unsigned short, arg3, arg3)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for PathMetricsSeeded
+// [conn][%p] Seeded path metrics: srtt=%u us, min_rtt=%u us, cwnd=%u, mtu=%hu
+// QuicTraceLogConnInfo(
+        PathMetricsSeeded,
+        Connection,
+        "Seeded path metrics: srtt=%u us, min_rtt=%u us, cwnd=%u, mtu=%hu",
+        Metrics.SmoothedRtt,
+        Metrics.MinRtt,
+        Metrics.CongestionWindow,
+        Metrics.Mtu);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Metrics.SmoothedRtt = arg3
+// arg4 = arg4 = Metrics.MinRtt = arg4
+// arg5 = arg5 = Metrics.CongestionWindow = arg5
+// arg6 = arg6 = Metrics.Mtu = arg6
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_CONNECTION_C, PathMetricsSeeded,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned int, arg3,
+        unsigned int, arg4,
+        unsigned int, arg5,
+        unsigned short, arg6), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer(unsigned int, arg3, arg3)
+        ctf_integer(unsigned int, arg4, arg4)
+        ctf_integer(unsigned int, arg5, arg5)
+        ctf_integer(unsigned short, arg6, arg6)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for CloseComplete
 // [conn][%p] Connection close complete
@@ -485,42 +597,54 @@ TRACEPOINT_EVENT(CLOG_CONNECTION_C, CloseComplete,
 
 
 /*----------------------------------------------------------
-// Decoder Ring for Restart
-// [conn][%p] Restart (CompleteReset=%hhu)
+// Decoder Ring for AddressRaceStarted
+// [conn][%p] Racing %!ADDR! against %!ADDR!
 // QuicTraceLogConnInfo(
-        Restart,
-        Connection,
-        "Restart (CompleteReset=%hhu)",
-        CompleteReset);
+            AddressRaceStarted,
+            Connection,
+            "Racing %!ADDR! against %!ADDR!",
+            CASTED_CLOG_BYTEARRAY(sizeof(*RemoteAddress), RemoteAddress),
+            CASTED_CLOG_BYTEARRAY(sizeof(Ipv4Address), &Ipv4Address));
 // arg1 = arg1 = Connection = arg1
-// arg3 = arg3 = CompleteReset = arg3
+// arg3 = arg3 = CASTED_CLOG_BYTEARRAY(sizeof(*RemoteAddress), RemoteAddress) = arg3
+// arg4 = arg4 = CASTED_CLOG_BYTEARRAY(sizeof(Ipv4Address), &Ipv4Address) = arg4
 ----------------------------------------------------------*/
-TRACEPOINT_EVENT(CLOG_CONNECTION_C, Restart,
+TRACEPOINT_EVENT(CLOG_CONNECTION_C, AddressRaceStarted,
     TP_ARGS(
         const void *, arg1,
-        unsigned char, arg3), 
+        unsigned int, arg3_len,
+        const void *, arg3,
+        unsigned int, arg4_len,
+        const void *, arg4), 
     TP_FIELDS(
         ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
-        ctf_integer(unsigned char, arg3, arg3)
+        ctf_integer(unsigned int, arg3_len, arg3_len)
+        ctf_sequence(char, arg3, arg3, unsigned int, arg3_len)
+        ctf_integer(unsigned int, arg4_len, arg4_len)
+        ctf_sequence(char, arg4, arg4, unsigned int, arg4_len)
     )
 )
 
 
 
 /*----------------------------------------------------------
-// Decoder Ring for CryptoStateDiscard
-// [conn][%p] TLS state no longer needed
+// Decoder Ring for Restart
+// [conn][%p] Restart (CompleteReset=%hhu)
 // QuicTraceLogConnInfo(
-            CryptoStateDiscard,
-            Connection,
-            "TLS state no longer needed");
+        Restart,
+        Connection,
+        "Restart (CompleteReset=%hhu)",
+        CompleteReset);
 // arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = CompleteReset = arg3
 ----------------------------------------------------------*/
-TRACEPOINT_EVENT(CLOG_CONNECTION_C, CryptoStateDiscard,
+TRACEPOINT_EVENT(CLOG_CONNECTION_C, Restart,
     TP_ARGS(
-        const void *, arg1), 
+        const void *, arg1,
+        unsigned char, arg3), 
     TP_FIELDS(
         ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer(unsigned char, arg3, arg3)
     )
 )
 
@@ -549,6 +673,25 @@ TRACEPOINT_EVENT(CLOG_CONNECTION_C, SetConfiguration,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for CachedResumptionTicketUsed
+// [conn][%p] Using cached resumption ticket
+// QuicTraceLogConnInfo(
+                        CachedResumptionTicketUsed,
+                        Connection,
+                        "Using cached resumption ticket");
+// arg1 = arg1 = Connection = arg1
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_CONNECTION_C, CachedResumptionTicketUsed,
+    TP_ARGS(
+        const void *, arg1), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for PeerTPSet
 // [conn][%p] Peer Transport Parameters Set
@@ -570,24 +713,30 @@ TRACEPOINT_EVENT(CLOG_CONNECTION_C, PeerTPSet,
 
 /*----------------------------------------------------------
 // Decoder Ring for PeerPreferredAddress
-// [conn][%p] Peer configured preferred address %!ADDR!
+// [conn][%p] Peer configured preferred address %!ADDR! %!ADDR!
 // QuicTraceLogConnInfo(
                 PeerPreferredAddress,
                 Connection,
-                "Peer configured preferred address %!ADDR!",
-                CASTED_CLOG_BYTEARRAY(sizeof(Connection->PeerTransportParams.PreferredAddress), &Connection->PeerTransportParams.PreferredAddress));
+                "Peer configured preferred address %!ADDR! %!ADDR!",
+                CASTED_CLOG_BYTEARRAY(sizeof(Connection->PeerTransportParams.PreferredAddressIpv4), &Connection->PeerTransportParams.PreferredAddressIpv4),
+                CASTED_CLOG_BYTEARRAY(sizeof(Connection->PeerTransportParams.PreferredAddressIpv6), &Connection->PeerTransportParams.PreferredAddressIpv6));
 // arg1 = arg1 = Connection = arg1
-// arg3 = arg3 = CASTED_CLOG_BYTEARRAY(sizeof(Connection->PeerTransportParams.PreferredAddress), &Connection->PeerTransportParams.PreferredAddress) = arg3
+// arg3 = arg3 = CASTED_CLOG_BYTEARRAY(sizeof(Connection->PeerTransportParams.PreferredAddressIpv4), &Connection->PeerTransportParams.PreferredAddressIpv4) = arg3
+// arg4 = arg4 = CASTED_CLOG_BYTEARRAY(sizeof(Connection->PeerTransportParams.PreferredAddressIpv6), &Connection->PeerTransportParams.PreferredAddressIpv6) = arg4
 ----------------------------------------------------------*/
 TRACEPOINT_EVENT(CLOG_CONNECTION_C, PeerPreferredAddress,
     TP_ARGS(
         const void *, arg1,
         unsigned int, arg3_len,
-        const void *, arg3), 
+        const void *, arg3,
+        unsigned int, arg4_len,
+        const void *, arg4), 
     TP_FIELDS(
         ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
         ctf_integer(unsigned int, arg3_len, arg3_len)
         ctf_sequence(char, arg3, arg3, unsigned int, arg3_len)
+        ctf_integer(unsigned int, arg4_len, arg4_len)
+        ctf_sequence(char, arg4, arg4, unsigned int, arg4_len)
     )
 )
 
@@ -715,6 +864,31 @@ TRACEPOINT_EVENT(CLOG_CONNECTION_C, FirstCidUsage,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for PreferredAddressMigration
+// [conn][%p] Migrated to preferred address %!ADDR!
+// QuicTraceLogConnInfo(
+        PreferredAddressMigration,
+        Connection,
+        "Migrated to preferred address %!ADDR!",
+        CASTED_CLOG_BYTEARRAY(sizeof(Path->Route.RemoteAddress), &Path->Route.RemoteAddress));
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = CASTED_CLOG_BYTEARRAY(sizeof(Path->Route.RemoteAddress), &Path->Route.RemoteAddress) = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_CONNECTION_C, PreferredAddressMigration,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned int, arg3_len,
+        const void *, arg3), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer(unsigned int, arg3_len, arg3_len)
+        ctf_sequence(char, arg3, arg3, unsigned int, arg3_len)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for PathDiscarded
 // [conn][%p] Removing invalid path[%hhu]
@@ -900,19 +1074,48 @@ TRACEPOINT_EVENT(CLOG_CONNECTION_C, CibirIdSet,
 
 
 /*----------------------------------------------------------
-// Decoder Ring for ApplySettings
-// [conn][%p] Applying new settings
+// Decoder Ring for CustomCongestionControlSet
+// [conn][%p] Using app congestion control %s
 // QuicTraceLogConnInfo(
-        ApplySettings,
+            CustomCongestionControlSet,
+            Connection,
+            "Using app congestion control %s",
+            Connection->CongestionControl.Name);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Connection->CongestionControl.Name = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_CONNECTION_C, CustomCongestionControlSet,
+    TP_ARGS(
+        const void *, arg1,
+        const char *, arg3), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_string(arg3, arg3)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for AddressRaceSwitch
+// [conn][%p] Switched to racing address %!ADDR!
+// QuicTraceLogConnInfo(
+        AddressRaceSwitch,
         Connection,
-        "Applying new settings");
+        "Switched to racing address %!ADDR!",
+        CASTED_CLOG_BYTEARRAY(sizeof(Path->Route.RemoteAddress), &Path->Route.RemoteAddress));
 // arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = CASTED_CLOG_BYTEARRAY(sizeof(Path->Route.RemoteAddress), &Path->Route.RemoteAddress) = arg3
 ----------------------------------------------------------*/
-TRACEPOINT_EVENT(CLOG_CONNECTION_C, ApplySettings,
+TRACEPOINT_EVENT(CLOG_CONNECTION_C, AddressRaceSwitch,
     TP_ARGS(
-        const void *, arg1), 
+        const void *, arg1,
+        unsigned int, arg3_len,
+        const void *, arg3), 
     TP_FIELDS(
         ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer(unsigned int, arg3_len, arg3_len)
+        ctf_sequence(char, arg3, arg3, unsigned int, arg3_len)
     )
 )
 
@@ -1568,6 +1771,29 @@ TRACEPOINT_EVENT(CLOG_CONNECTION_C, UdpRecvDeferred,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for Hibernate
+// [conn][%p] Hibernating, freed %u receive buffers
+// QuicTraceLogConnVerbose(
+        Hibernate,
+        Connection,
+        "Hibernating, freed %u receive buffers",
+        FreedCount);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = FreedCount = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_CONNECTION_C, Hibernate,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned int, arg3), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer(unsigned int, arg3, arg3)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for DatagramReceiveEnableUpdated
 // [conn][%p] Updated datagram receive enabled to %hhu
@@ -1614,6 +1840,179 @@ TRACEPOINT_EVENT(CLOG_CONNECTION_C, Disable1RttEncrytionUpdated,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for SendFlushBudgetUpdated
+// [conn][%p] Updated send flush budget = %u us
+// QuicTraceLogConnVerbose(
+            SendFlushBudgetUpdated,
+            Connection,
+            "Updated send flush budget = %u us",
+            Connection->Send.FlushBudgetUs);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Connection->Send.FlushBudgetUs = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_CONNECTION_C, SendFlushBudgetUpdated,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned int, arg3), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer(unsigned int, arg3, arg3)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SendCoalescingDelayUpdated
+// [conn][%p] Updated send coalescing delay = %u us
+// QuicTraceLogConnVerbose(
+            SendCoalescingDelayUpdated,
+            Connection,
+            "Updated send coalescing delay = %u us",
+            Connection->Send.CoalescingDelayUs);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Connection->Send.CoalescingDelayUs = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_CONNECTION_C, SendCoalescingDelayUpdated,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned int, arg3), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer(unsigned int, arg3, arg3)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for AddressRaceDelayUpdated
+// [conn][%p] Updated address race delay = %u ms
+// QuicTraceLogConnVerbose(
+            AddressRaceDelayUpdated,
+            Connection,
+            "Updated address race delay = %u ms",
+            Connection->AddressRaceDelayMs);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Connection->AddressRaceDelayMs = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_CONNECTION_C, AddressRaceDelayUpdated,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned int, arg3), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer(unsigned int, arg3, arg3)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for DatagramFecConfigUpdated
+// [conn][%p] Updated datagram FEC block size = %hhu to %hhu
+// QuicTraceLogConnVerbose(
+            DatagramFecConfigUpdated,
+            Connection,
+            "Updated datagram FEC block size = %hhu to %hhu",
+            Config->MinBlockSize,
+            Config->MaxBlockSize);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Config->MinBlockSize = arg3
+// arg4 = arg4 = Config->MaxBlockSize = arg4
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_CONNECTION_C, DatagramFecConfigUpdated,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned char, arg3,
+        unsigned char, arg4), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer(unsigned char, arg3, arg3)
+        ctf_integer(unsigned char, arg4, arg4)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for StandbyPathsUpdated
+// [conn][%p] Updated standby paths, count = %u, probe interval = %u ms
+// QuicTraceLogConnVerbose(
+            StandbyPathsUpdated,
+            Connection,
+            "Updated standby paths, count = %u, probe interval = %u ms",
+            Config->LocalAddressCount,
+            Config->ProbeIntervalMs);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Config->LocalAddressCount = arg3
+// arg4 = arg4 = Config->ProbeIntervalMs = arg4
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_CONNECTION_C, StandbyPathsUpdated,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned int, arg3,
+        unsigned int, arg4), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer(unsigned int, arg3, arg3)
+        ctf_integer(unsigned int, arg4, arg4)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for StreamCompressionUpdated
+// [conn][%p] Updated stream compression codec = %u
+// QuicTraceLogConnVerbose(
+            StreamCompressionUpdated,
+            Connection,
+            "Updated stream compression codec = %u",
+            Config->CodecId);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Config->CodecId = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_CONNECTION_C, StreamCompressionUpdated,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned int, arg3), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer(unsigned int, arg3, arg3)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for DatagramSendPolicyUpdated
+// [conn][%p] Updated datagram max queue delay = %u us (priority %u us)
+// QuicTraceLogConnVerbose(
+            DatagramSendPolicyUpdated,
+            Connection,
+            "Updated datagram max queue delay = %u us (priority %u us)",
+            Policy->MaxQueueDelayUs,
+            Policy->PriorityMaxQueueDelayUs);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Policy->MaxQueueDelayUs = arg3
+// arg4 = arg4 = Policy->PriorityMaxQueueDelayUs = arg4
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_CONNECTION_C, DatagramSendPolicyUpdated,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned int, arg3,
+        unsigned int, arg4), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer(unsigned int, arg3, arg3)
+        ctf_integer(unsigned int, arg4, arg4)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for ForceKeyUpdate
 // [conn][%p] Forcing key update
@@ -2138,12 +2537,12 @@ TRACEPOINT_EVENT(CLOG_CONNECTION_C, ConnSetTimer,
 // Decoder Ring for ConnExpiredTimer
 // [conn][%p] %hhu expired
 // QuicTraceEvent(
-                ConnExpiredTimer,
-                "[conn][%p] %hhu expired",
-                Connection,
-                (uint8_t)Type);
+        ConnExpiredTimer,
+        "[conn][%p] %hhu expired",
+        Connection,
+        (uint8_t)QUIC_CONN_TIMER_PACING);
 // arg2 = arg2 = Connection = arg2
-// arg3 = arg3 = (uint8_t)Type = arg3
+// arg3 = arg3 = (uint8_t)QUIC_CONN_TIMER_PACING = arg3
 ----------------------------------------------------------*/
 TRACEPOINT_EVENT(CLOG_CONNECTION_C, ConnExpiredTimer,
     TP_ARGS(
@@ -2161,12 +2560,12 @@ TRACEPOINT_EVENT(CLOG_CONNECTION_C, ConnExpiredTimer,
 // Decoder Ring for ConnExecTimerOper
 // [conn][%p] Execute: %u
 // QuicTraceEvent(
-                    ConnExecTimerOper,
-                    "[conn][%p] Execute: %u",
-                    Connection,
-                    QUIC_CONN_TIMER_ACK_DELAY);
+        ConnExecTimerOper,
+        "[conn][%p] Execute: %u",
+        Connection,
+        QUIC_CONN_TIMER_PACING);
 // arg2 = arg2 = Connection = arg2
-// arg3 = arg3 = QUIC_CONN_TIMER_ACK_DELAY = arg3
+// arg3 = arg3 = QUIC_CONN_TIMER_PACING = arg3
 ----------------------------------------------------------*/
 TRACEPOINT_EVENT(CLOG_CONNECTION_C, ConnExecTimerOper,
     TP_ARGS(
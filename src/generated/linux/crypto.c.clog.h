@@ -51,6 +51,24 @@ tracepoint(CLOG_CRYPTO_C, IgnoreCryptoFrame , arg1);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for CryptoStateDiscard
+// [conn][%p] TLS state no longer needed
+// QuicTraceLogConnInfo(
+        CryptoStateDiscard,
+        QuicCryptoGetConnection(Crypto),
+        "TLS state no longer needed");
+// arg1 = arg1 = QuicCryptoGetConnection(Crypto) = arg1
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_CryptoStateDiscard
+#define _clog_3_ARGS_TRACE_CryptoStateDiscard(uniqueId, arg1, encoded_arg_string)\
+tracepoint(CLOG_CRYPTO_C, CryptoStateDiscard , arg1);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for DiscardKeyType
 // [conn][%p] Discarding key type = %hhu
@@ -125,6 +143,42 @@ tracepoint(CLOG_CRYPTO_C, HandshakeConfirmedServer , arg1);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for TlsProcessPending
+// [conn][%p] TLS processing pending async key operation
+// QuicTraceLogConnInfo(
+            TlsProcessPending,
+            Connection,
+            "TLS processing pending async key operation");
+// arg1 = arg1 = Connection = arg1
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_TlsProcessPending
+#define _clog_3_ARGS_TRACE_TlsProcessPending(uniqueId, arg1, encoded_arg_string)\
+tracepoint(CLOG_CRYPTO_C, TlsProcessPending , arg1);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for TlsProcessResumed
+// [conn][%p] Resuming TLS processing after async key operation
+// QuicTraceLogConnInfo(
+        TlsProcessResumed,
+        QuicCryptoGetConnection(Crypto),
+        "Resuming TLS processing after async key operation");
+// arg1 = arg1 = QuicCryptoGetConnection(Crypto) = arg1
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_TlsProcessResumed
+#define _clog_3_ARGS_TRACE_TlsProcessResumed(uniqueId, arg1, encoded_arg_string)\
+tracepoint(CLOG_CRYPTO_C, TlsProcessResumed , arg1);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for CustomCertValidationSuccess
 // [conn][%p] Custom cert validation succeeded
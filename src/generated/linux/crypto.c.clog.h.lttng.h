@@ -20,6 +20,25 @@ TRACEPOINT_EVENT(CLOG_CRYPTO_C, IgnoreCryptoFrame,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for CryptoStateDiscard
+// [conn][%p] TLS state no longer needed
+// QuicTraceLogConnInfo(
+        CryptoStateDiscard,
+        QuicCryptoGetConnection(Crypto),
+        "TLS state no longer needed");
+// arg1 = arg1 = QuicCryptoGetConnection(Crypto) = arg1
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_CRYPTO_C, CryptoStateDiscard,
+    TP_ARGS(
+        const void *, arg1), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for DiscardKeyType
 // [conn][%p] Discarding key type = %hhu
@@ -100,6 +119,44 @@ TRACEPOINT_EVENT(CLOG_CRYPTO_C, HandshakeConfirmedServer,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for TlsProcessPending
+// [conn][%p] TLS processing pending async key operation
+// QuicTraceLogConnInfo(
+            TlsProcessPending,
+            Connection,
+            "TLS processing pending async key operation");
+// arg1 = arg1 = Connection = arg1
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_CRYPTO_C, TlsProcessPending,
+    TP_ARGS(
+        const void *, arg1), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for TlsProcessResumed
+// [conn][%p] Resuming TLS processing after async key operation
+// QuicTraceLogConnInfo(
+        TlsProcessResumed,
+        QuicCryptoGetConnection(Crypto),
+        "Resuming TLS processing after async key operation");
+// arg1 = arg1 = QuicCryptoGetConnection(Crypto) = arg1
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_CRYPTO_C, TlsProcessResumed,
+    TP_ARGS(
+        const void *, arg1), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for CustomCertValidationSuccess
 // [conn][%p] Custom cert validation succeeded
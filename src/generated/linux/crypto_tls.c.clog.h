@@ -619,6 +619,44 @@ tracepoint(CLOG_CRYPTO_TLS_C, EncodeTPTimestamp , arg1, arg3);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for EncodeTPDatagramFec
+// [conn][%p] TP: Datagram FEC
+// QuicTraceLogConnVerbose(
+            EncodeTPDatagramFec,
+            Connection,
+            "TP: Datagram FEC");
+// arg1 = arg1 = Connection = arg1
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_EncodeTPDatagramFec
+#define _clog_3_ARGS_TRACE_EncodeTPDatagramFec(uniqueId, arg1, encoded_arg_string)\
+tracepoint(CLOG_CRYPTO_TLS_C, EncodeTPDatagramFec , arg1);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for EncodeTPStreamCompression
+// [conn][%p] TP: Stream Compression (codec %llu)
+// QuicTraceLogConnVerbose(
+            EncodeTPStreamCompression,
+            Connection,
+            "TP: Stream Compression (codec %llu)",
+            TransportParams->StreamCompressionCodecId);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = TransportParams->StreamCompressionCodecId = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_EncodeTPStreamCompression
+#define _clog_4_ARGS_TRACE_EncodeTPStreamCompression(uniqueId, arg1, encoded_arg_string, arg3)\
+tracepoint(CLOG_CRYPTO_TLS_C, EncodeTPStreamCompression , arg1, arg3);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for EncodeTPTest
 // [conn][%p] TP: TEST TP (Type %hu, Length %hu)
@@ -1171,6 +1209,44 @@ tracepoint(CLOG_CRYPTO_TLS_C, DecodeTPReliableReset , arg1);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for DecodeTPDatagramFec
+// [conn][%p] TP: Datagram FEC
+// QuicTraceLogConnVerbose(
+                DecodeTPDatagramFec,
+                Connection,
+                "TP: Datagram FEC");
+// arg1 = arg1 = Connection = arg1
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_DecodeTPDatagramFec
+#define _clog_3_ARGS_TRACE_DecodeTPDatagramFec(uniqueId, arg1, encoded_arg_string)\
+tracepoint(CLOG_CRYPTO_TLS_C, DecodeTPDatagramFec , arg1);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for DecodeTPStreamCompression
+// [conn][%p] TP: Stream Compression (codec %llu)
+// QuicTraceLogConnVerbose(
+                DecodeTPStreamCompression,
+                Connection,
+                "TP: Stream Compression (codec %llu)",
+                TransportParams->StreamCompressionCodecId);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = TransportParams->StreamCompressionCodecId = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_DecodeTPStreamCompression
+#define _clog_4_ARGS_TRACE_DecodeTPStreamCompression(uniqueId, arg1, encoded_arg_string, arg3)\
+tracepoint(CLOG_CRYPTO_TLS_C, DecodeTPStreamCompression , arg1, arg3);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for ConnError
 // [conn][%p] ERROR, %s.
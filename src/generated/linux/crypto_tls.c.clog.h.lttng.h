@@ -672,6 +672,48 @@ TRACEPOINT_EVENT(CLOG_CRYPTO_TLS_C, EncodeTPTimestamp,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for EncodeTPDatagramFec
+// [conn][%p] TP: Datagram FEC
+// QuicTraceLogConnVerbose(
+            EncodeTPDatagramFec,
+            Connection,
+            "TP: Datagram FEC");
+// arg1 = arg1 = Connection = arg1
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_CRYPTO_TLS_C, EncodeTPDatagramFec,
+    TP_ARGS(
+        const void *, arg1), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for EncodeTPStreamCompression
+// [conn][%p] TP: Stream Compression (codec %llu)
+// QuicTraceLogConnVerbose(
+            EncodeTPStreamCompression,
+            Connection,
+            "TP: Stream Compression (codec %llu)",
+            TransportParams->StreamCompressionCodecId);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = TransportParams->StreamCompressionCodecId = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_CRYPTO_TLS_C, EncodeTPStreamCompression,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned long long, arg3), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer(uint64_t, arg3, arg3)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for EncodeTPTest
 // [conn][%p] TP: TEST TP (Type %hu, Length %hu)
@@ -1301,6 +1343,48 @@ TRACEPOINT_EVENT(CLOG_CRYPTO_TLS_C, DecodeTPReliableReset,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for DecodeTPDatagramFec
+// [conn][%p] TP: Datagram FEC
+// QuicTraceLogConnVerbose(
+                DecodeTPDatagramFec,
+                Connection,
+                "TP: Datagram FEC");
+// arg1 = arg1 = Connection = arg1
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_CRYPTO_TLS_C, DecodeTPDatagramFec,
+    TP_ARGS(
+        const void *, arg1), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for DecodeTPStreamCompression
+// [conn][%p] TP: Stream Compression (codec %llu)
+// QuicTraceLogConnVerbose(
+                DecodeTPStreamCompression,
+                Connection,
+                "TP: Stream Compression (codec %llu)",
+                TransportParams->StreamCompressionCodecId);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = TransportParams->StreamCompressionCodecId = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_CRYPTO_TLS_C, DecodeTPStreamCompression,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned long long, arg3), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer(uint64_t, arg3, arg3)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for ConnError
 // [conn][%p] ERROR, %s.
@@ -14,9 +14,9 @@
 #include "cubic.c.clog.h.lttng.h"
 #endif
 #include <lttng/tracepoint-event.h>
-#ifndef _clog_MACRO_QuicTraceLogConnVerbose
-#define _clog_MACRO_QuicTraceLogConnVerbose  1
-#define QuicTraceLogConnVerbose(a, ...) _clog_CAT(_clog_ARGN_SELECTOR(__VA_ARGS__), _clog_CAT(_,a(#a, __VA_ARGS__)))
+#ifndef _clog_MACRO_QuicTraceLogConnInfo
+#define _clog_MACRO_QuicTraceLogConnInfo  1
+#define QuicTraceLogConnInfo(a, ...) _clog_CAT(_clog_ARGN_SELECTOR(__VA_ARGS__), _clog_CAT(_,a(#a, __VA_ARGS__)))
 #endif
 #ifndef _clog_MACRO_QuicTraceEvent
 #define _clog_MACRO_QuicTraceEvent  1
@@ -26,29 +26,23 @@
 extern "C" {
 #endif
 /*----------------------------------------------------------
-// Decoder Ring for IndicateDataAcked
-// [conn][%p] Indicating QUIC_CONNECTION_EVENT_NETWORK_STATISTICS [BytesInFlight=%u,PostedBytes=%llu,IdealBytes=%llu,SmoothedRTT=%llu,CongestionWindow=%u,Bandwidth=%llu]
-// QuicTraceLogConnVerbose(
-           IndicateDataAcked,
-           Connection,
-           "Indicating QUIC_CONNECTION_EVENT_NETWORK_STATISTICS [BytesInFlight=%u,PostedBytes=%llu,IdealBytes=%llu,SmoothedRTT=%llu,CongestionWindow=%u,Bandwidth=%llu]",
-           Event.NETWORK_STATISTICS.BytesInFlight,
-           Event.NETWORK_STATISTICS.PostedBytes,
-           Event.NETWORK_STATISTICS.IdealBytes,
-           Event.NETWORK_STATISTICS.SmoothedRTT,
-           Event.NETWORK_STATISTICS.CongestionWindow,
-           Event.NETWORK_STATISTICS.Bandwidth);
-// arg1 = arg1 = Connection = arg1
-// arg3 = arg3 = Event.NETWORK_STATISTICS.BytesInFlight = arg3
-// arg4 = arg4 = Event.NETWORK_STATISTICS.PostedBytes = arg4
-// arg5 = arg5 = Event.NETWORK_STATISTICS.IdealBytes = arg5
-// arg6 = arg6 = Event.NETWORK_STATISTICS.SmoothedRTT = arg6
-// arg7 = arg7 = Event.NETWORK_STATISTICS.CongestionWindow = arg7
-// arg8 = arg8 = Event.NETWORK_STATISTICS.Bandwidth = arg8
+// Decoder Ring for CubicCarefulResumeStateChange
+// [conn][%p] Careful Resume: State=%u CongestionWindow=%u PipeSize=%u
+// QuicTraceLogConnInfo(
+            CubicCarefulResumeStateChange,
+            QuicCongestionControlGetConnection(Cc),
+            "Careful Resume: State=%u CongestionWindow=%u PipeSize=%u",
+            NewState,
+            Cubic->CongestionWindow,
+            Cubic->CarefulResumePipeSize);
+// arg1 = arg1 = QuicCongestionControlGetConnection(Cc) = arg1
+// arg3 = arg3 = NewState = arg3
+// arg4 = arg4 = Cubic->CongestionWindow = arg4
+// arg5 = arg5 = Cubic->CarefulResumePipeSize = arg5
 ----------------------------------------------------------*/
-#ifndef _clog_9_ARGS_TRACE_IndicateDataAcked
-#define _clog_9_ARGS_TRACE_IndicateDataAcked(uniqueId, arg1, encoded_arg_string, arg3, arg4, arg5, arg6, arg7, arg8)\
-tracepoint(CLOG_CUBIC_C, IndicateDataAcked , arg1, arg3, arg4, arg5, arg6, arg7, arg8);\
+#ifndef _clog_6_ARGS_TRACE_CubicCarefulResumeStateChange
+#define _clog_6_ARGS_TRACE_CubicCarefulResumeStateChange(uniqueId, arg1, encoded_arg_string, arg3, arg4, arg5)\
+tracepoint(CLOG_CUBIC_C, CubicCarefulResumeStateChange , arg1, arg3, arg4, arg5);\
 
 #endif
 
@@ -2,43 +2,31 @@
 
 
 /*----------------------------------------------------------
-// Decoder Ring for IndicateDataAcked
-// [conn][%p] Indicating QUIC_CONNECTION_EVENT_NETWORK_STATISTICS [BytesInFlight=%u,PostedBytes=%llu,IdealBytes=%llu,SmoothedRTT=%llu,CongestionWindow=%u,Bandwidth=%llu]
-// QuicTraceLogConnVerbose(
-           IndicateDataAcked,
-           Connection,
-           "Indicating QUIC_CONNECTION_EVENT_NETWORK_STATISTICS [BytesInFlight=%u,PostedBytes=%llu,IdealBytes=%llu,SmoothedRTT=%llu,CongestionWindow=%u,Bandwidth=%llu]",
-           Event.NETWORK_STATISTICS.BytesInFlight,
-           Event.NETWORK_STATISTICS.PostedBytes,
-           Event.NETWORK_STATISTICS.IdealBytes,
-           Event.NETWORK_STATISTICS.SmoothedRTT,
-           Event.NETWORK_STATISTICS.CongestionWindow,
-           Event.NETWORK_STATISTICS.Bandwidth);
-// arg1 = arg1 = Connection = arg1
-// arg3 = arg3 = Event.NETWORK_STATISTICS.BytesInFlight = arg3
-// arg4 = arg4 = Event.NETWORK_STATISTICS.PostedBytes = arg4
-// arg5 = arg5 = Event.NETWORK_STATISTICS.IdealBytes = arg5
-// arg6 = arg6 = Event.NETWORK_STATISTICS.SmoothedRTT = arg6
-// arg7 = arg7 = Event.NETWORK_STATISTICS.CongestionWindow = arg7
-// arg8 = arg8 = Event.NETWORK_STATISTICS.Bandwidth = arg8
+// Decoder Ring for CubicCarefulResumeStateChange
+// [conn][%p] Careful Resume: State=%u CongestionWindow=%u PipeSize=%u
+// QuicTraceLogConnInfo(
+            CubicCarefulResumeStateChange,
+            QuicCongestionControlGetConnection(Cc),
+            "Careful Resume: State=%u CongestionWindow=%u PipeSize=%u",
+            NewState,
+            Cubic->CongestionWindow,
+            Cubic->CarefulResumePipeSize);
+// arg1 = arg1 = QuicCongestionControlGetConnection(Cc) = arg1
+// arg3 = arg3 = NewState = arg3
+// arg4 = arg4 = Cubic->CongestionWindow = arg4
+// arg5 = arg5 = Cubic->CarefulResumePipeSize = arg5
 ----------------------------------------------------------*/
-TRACEPOINT_EVENT(CLOG_CUBIC_C, IndicateDataAcked,
+TRACEPOINT_EVENT(CLOG_CUBIC_C, CubicCarefulResumeStateChange,
     TP_ARGS(
         const void *, arg1,
         unsigned int, arg3,
-        unsigned long long, arg4,
-        unsigned long long, arg5,
-        unsigned long long, arg6,
-        unsigned int, arg7,
-        unsigned long long, arg8), 
+        unsigned int, arg4,
+        unsigned int, arg5), 
     TP_FIELDS(
         ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
         ctf_integer(unsigned int, arg3, arg3)
-        ctf_integer(uint64_t, arg4, arg4)
-        ctf_integer(uint64_t, arg5, arg5)
-        ctf_integer(uint64_t, arg6, arg6)
-        ctf_integer(unsigned int, arg7, arg7)
-        ctf_integer(uint64_t, arg8, arg8)
+        ctf_integer(unsigned int, arg4, arg4)
+        ctf_integer(unsigned int, arg5, arg5)
     )
 )
 
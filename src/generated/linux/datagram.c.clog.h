@@ -14,6 +14,10 @@
 #include "datagram.c.clog.h.lttng.h"
 #endif
 #include <lttng/tracepoint-event.h>
+#ifndef _clog_MACRO_QuicTraceLogConnInfo
+#define _clog_MACRO_QuicTraceLogConnInfo  1
+#define QuicTraceLogConnInfo(a, ...) _clog_CAT(_clog_ARGN_SELECTOR(__VA_ARGS__), _clog_CAT(_,a(#a, __VA_ARGS__)))
+#endif
 #ifndef _clog_MACRO_QuicTraceLogConnVerbose
 #define _clog_MACRO_QuicTraceLogConnVerbose  1
 #define QuicTraceLogConnVerbose(a, ...) _clog_CAT(_clog_ARGN_SELECTOR(__VA_ARGS__), _clog_CAT(_,a(#a, __VA_ARGS__)))
@@ -25,6 +29,72 @@
 #ifdef __cplusplus
 extern "C" {
 #endif
+/*----------------------------------------------------------
+// Decoder Ring for DatagramRelayRemoved
+// [conn][%p] Datagram relay removed [qsid=%llu] [ctx=%llu]
+// QuicTraceLogConnInfo(
+        DatagramRelayRemoved,
+        Relay->Connection,
+        "Datagram relay removed [qsid=%llu] [ctx=%llu]",
+        Relay->QuarterStreamId,
+        Relay->ContextId);
+// arg1 = arg1 = Relay->Connection = arg1
+// arg3 = arg3 = Relay->QuarterStreamId = arg3
+// arg4 = arg4 = Relay->ContextId = arg4
+----------------------------------------------------------*/
+#ifndef _clog_5_ARGS_TRACE_DatagramRelayRemoved
+#define _clog_5_ARGS_TRACE_DatagramRelayRemoved(uniqueId, arg1, encoded_arg_string, arg3, arg4)\
+tracepoint(CLOG_DATAGRAM_C, DatagramRelayRemoved , arg1, arg3, arg4);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for DatagramFecNegotiated
+// [conn][%p] Datagram FEC negotiated, block size %hhu to %hhu
+// QuicTraceLogConnInfo(
+            DatagramFecNegotiated,
+            Connection,
+            "Datagram FEC negotiated, block size %hhu to %hhu",
+            Datagram->FecConfig.MinBlockSize,
+            Datagram->FecConfig.MaxBlockSize);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Datagram->FecConfig.MinBlockSize = arg3
+// arg4 = arg4 = Datagram->FecConfig.MaxBlockSize = arg4
+----------------------------------------------------------*/
+#ifndef _clog_5_ARGS_TRACE_DatagramFecNegotiated
+#define _clog_5_ARGS_TRACE_DatagramFecNegotiated(uniqueId, arg1, encoded_arg_string, arg3, arg4)\
+tracepoint(CLOG_DATAGRAM_C, DatagramFecNegotiated , arg1, arg3, arg4);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for DatagramRelayAdded
+// [conn][%p] Datagram relay added [qsid=%llu] [ctx=%llu]
+// QuicTraceLogConnInfo(
+        DatagramRelayAdded,
+        Connection,
+        "Datagram relay added [qsid=%llu] [ctx=%llu]",
+        Relay->QuarterStreamId,
+        Relay->ContextId);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Relay->QuarterStreamId = arg3
+// arg4 = arg4 = Relay->ContextId = arg4
+----------------------------------------------------------*/
+#ifndef _clog_5_ARGS_TRACE_DatagramRelayAdded
+#define _clog_5_ARGS_TRACE_DatagramRelayAdded(uniqueId, arg1, encoded_arg_string, arg3, arg4)\
+tracepoint(CLOG_DATAGRAM_C, DatagramRelayAdded , arg1, arg3, arg4);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for DatagramSendStateChanged
 // [conn][%p] Indicating DATAGRAM_SEND_STATE_CHANGED to %u
@@ -109,6 +179,46 @@ tracepoint(CLOG_DATAGRAM_C, DatagramSendQueued , arg1, arg3, arg4, arg5);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for DatagramSendExpired
+// [conn][%p] Datagram [%p] expired in the send queue
+// QuicTraceLogConnVerbose(
+                    DatagramSendExpired,
+                    Connection,
+                    "Datagram [%p] expired in the send queue",
+                    SendRequest);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = SendRequest = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_DatagramSendExpired
+#define _clog_4_ARGS_TRACE_DatagramSendExpired(uniqueId, arg1, encoded_arg_string, arg3)\
+tracepoint(CLOG_DATAGRAM_C, DatagramSendExpired , arg1, arg3);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for IndicateDatagramBatchReceived
+// [conn][%p] Indicating DATAGRAM_BATCH_RECEIVED [count=%u]
+// QuicTraceLogConnVerbose(
+        IndicateDatagramBatchReceived,
+        Connection,
+        "Indicating DATAGRAM_BATCH_RECEIVED [count=%u]",
+        Batch->Count);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Batch->Count = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_IndicateDatagramBatchReceived
+#define _clog_4_ARGS_TRACE_IndicateDatagramBatchReceived(uniqueId, arg1, encoded_arg_string, arg3)\
+tracepoint(CLOG_DATAGRAM_C, IndicateDatagramBatchReceived , arg1, arg3);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for IndicateDatagramReceived
 // [conn][%p] Indicating DATAGRAM_RECEIVED [len=%hu]
@@ -116,9 +226,9 @@ tracepoint(CLOG_DATAGRAM_C, DatagramSendQueued , arg1, arg3, arg4, arg5);\
         IndicateDatagramReceived,
         Connection,
         "Indicating DATAGRAM_RECEIVED [len=%hu]",
-        (uint16_t)Frame.Length);
+        Length);
 // arg1 = arg1 = Connection = arg1
-// arg3 = arg3 = (uint16_t)Frame.Length = arg3
+// arg3 = arg3 = Length = arg3
 ----------------------------------------------------------*/
 #ifndef _clog_4_ARGS_TRACE_IndicateDatagramReceived
 #define _clog_4_ARGS_TRACE_IndicateDatagramReceived(uniqueId, arg1, encoded_arg_string, arg3)\
@@ -129,6 +239,46 @@ tracepoint(CLOG_DATAGRAM_C, IndicateDatagramReceived , arg1, arg3);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for DatagramFecRecovered
+// [conn][%p] Datagram recovered by FEC [len=%u]
+// QuicTraceLogConnVerbose(
+            DatagramFecRecovered,
+            Connection,
+            "Datagram recovered by FEC [len=%u]",
+            Recovered.Length);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Recovered.Length = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_DatagramFecRecovered
+#define _clog_4_ARGS_TRACE_DatagramFecRecovered(uniqueId, arg1, encoded_arg_string, arg3)\
+tracepoint(CLOG_DATAGRAM_C, DatagramFecRecovered , arg1, arg3);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for AllocFailure
+// Allocation of '%s' failed. (%llu bytes)
+// QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "datagram FEC",
+                sizeof(QUIC_DATAGRAM_FEC));
+// arg2 = arg2 = "datagram FEC" = arg2
+// arg3 = arg3 = sizeof(QUIC_DATAGRAM_FEC) = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_AllocFailure
+#define _clog_4_ARGS_TRACE_AllocFailure(uniqueId, encoded_arg_string, arg2, arg3)\
+tracepoint(CLOG_DATAGRAM_C, AllocFailure , arg2, arg3);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for ConnError
 // [conn][%p] ERROR, %s.
@@ -150,19 +300,21 @@ tracepoint(CLOG_DATAGRAM_C, ConnError , arg2, arg3);\
 
 
 /*----------------------------------------------------------
-// Decoder Ring for AllocFailure
-// Allocation of '%s' failed. (%llu bytes)
+// Decoder Ring for ConnErrorStatus
+// [conn][%p] ERROR, %u, %s.
 // QuicTraceEvent(
-                AllocFailure,
-                "Allocation of '%s' failed. (%llu bytes)",
-                "DATAGRAM_SEND operation",
-                0);
-// arg2 = arg2 = "DATAGRAM_SEND operation" = arg2
-// arg3 = arg3 = 0 = arg3
+            ConnErrorStatus,
+            "[conn][%p] ERROR, %u, %s.",
+            Connection,
+            Status,
+            "Create datagram relay socket");
+// arg2 = arg2 = Connection = arg2
+// arg3 = arg3 = Status = arg3
+// arg4 = arg4 = "Create datagram relay socket" = arg4
 ----------------------------------------------------------*/
-#ifndef _clog_4_ARGS_TRACE_AllocFailure
-#define _clog_4_ARGS_TRACE_AllocFailure(uniqueId, encoded_arg_string, arg2, arg3)\
-tracepoint(CLOG_DATAGRAM_C, AllocFailure , arg2, arg3);\
+#ifndef _clog_5_ARGS_TRACE_ConnErrorStatus
+#define _clog_5_ARGS_TRACE_ConnErrorStatus(uniqueId, encoded_arg_string, arg2, arg3, arg4)\
+tracepoint(CLOG_DATAGRAM_C, ConnErrorStatus , arg2, arg3, arg4);\
 
 #endif
 
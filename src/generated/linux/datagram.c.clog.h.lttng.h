@@ -1,6 +1,87 @@
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for DatagramRelayRemoved
+// [conn][%p] Datagram relay removed [qsid=%llu] [ctx=%llu]
+// QuicTraceLogConnInfo(
+        DatagramRelayRemoved,
+        Relay->Connection,
+        "Datagram relay removed [qsid=%llu] [ctx=%llu]",
+        Relay->QuarterStreamId,
+        Relay->ContextId);
+// arg1 = arg1 = Relay->Connection = arg1
+// arg3 = arg3 = Relay->QuarterStreamId = arg3
+// arg4 = arg4 = Relay->ContextId = arg4
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_DATAGRAM_C, DatagramRelayRemoved,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned long long, arg3,
+        unsigned long long, arg4), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer(uint64_t, arg3, arg3)
+        ctf_integer(uint64_t, arg4, arg4)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for DatagramFecNegotiated
+// [conn][%p] Datagram FEC negotiated, block size %hhu to %hhu
+// QuicTraceLogConnInfo(
+            DatagramFecNegotiated,
+            Connection,
+            "Datagram FEC negotiated, block size %hhu to %hhu",
+            Datagram->FecConfig.MinBlockSize,
+            Datagram->FecConfig.MaxBlockSize);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Datagram->FecConfig.MinBlockSize = arg3
+// arg4 = arg4 = Datagram->FecConfig.MaxBlockSize = arg4
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_DATAGRAM_C, DatagramFecNegotiated,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned char, arg3,
+        unsigned char, arg4), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer(unsigned char, arg3, arg3)
+        ctf_integer(unsigned char, arg4, arg4)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for DatagramRelayAdded
+// [conn][%p] Datagram relay added [qsid=%llu] [ctx=%llu]
+// QuicTraceLogConnInfo(
+        DatagramRelayAdded,
+        Connection,
+        "Datagram relay added [qsid=%llu] [ctx=%llu]",
+        Relay->QuarterStreamId,
+        Relay->ContextId);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Relay->QuarterStreamId = arg3
+// arg4 = arg4 = Relay->ContextId = arg4
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_DATAGRAM_C, DatagramRelayAdded,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned long long, arg3,
+        unsigned long long, arg4), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer(uint64_t, arg3, arg3)
+        ctf_integer(uint64_t, arg4, arg4)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for DatagramSendStateChanged
 // [conn][%p] Indicating DATAGRAM_SEND_STATE_CHANGED to %u
@@ -101,6 +182,52 @@ TRACEPOINT_EVENT(CLOG_DATAGRAM_C, DatagramSendQueued,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for DatagramSendExpired
+// [conn][%p] Datagram [%p] expired in the send queue
+// QuicTraceLogConnVerbose(
+                    DatagramSendExpired,
+                    Connection,
+                    "Datagram [%p] expired in the send queue",
+                    SendRequest);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = SendRequest = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_DATAGRAM_C, DatagramSendExpired,
+    TP_ARGS(
+        const void *, arg1,
+        const void *, arg3), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer_hex(uint64_t, arg3, (uint64_t)arg3)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for IndicateDatagramBatchReceived
+// [conn][%p] Indicating DATAGRAM_BATCH_RECEIVED [count=%u]
+// QuicTraceLogConnVerbose(
+        IndicateDatagramBatchReceived,
+        Connection,
+        "Indicating DATAGRAM_BATCH_RECEIVED [count=%u]",
+        Batch->Count);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Batch->Count = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_DATAGRAM_C, IndicateDatagramBatchReceived,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned int, arg3), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer(unsigned int, arg3, arg3)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for IndicateDatagramReceived
 // [conn][%p] Indicating DATAGRAM_RECEIVED [len=%hu]
@@ -108,9 +235,9 @@ TRACEPOINT_EVENT(CLOG_DATAGRAM_C, DatagramSendQueued,
         IndicateDatagramReceived,
         Connection,
         "Indicating DATAGRAM_RECEIVED [len=%hu]",
-        (uint16_t)Frame.Length);
+        Length);
 // arg1 = arg1 = Connection = arg1
-// arg3 = arg3 = (uint16_t)Frame.Length = arg3
+// arg3 = arg3 = Length = arg3
 ----------------------------------------------------------*/
 TRACEPOINT_EVENT(CLOG_DATAGRAM_C, IndicateDatagramReceived,
     TP_ARGS(
@@ -124,6 +251,52 @@ TRACEPOINT_EVENT(CLOG_DATAGRAM_C, IndicateDatagramReceived,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for DatagramFecRecovered
+// [conn][%p] Datagram recovered by FEC [len=%u]
+// QuicTraceLogConnVerbose(
+            DatagramFecRecovered,
+            Connection,
+            "Datagram recovered by FEC [len=%u]",
+            Recovered.Length);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Recovered.Length = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_DATAGRAM_C, DatagramFecRecovered,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned int, arg3), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer(unsigned int, arg3, arg3)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for AllocFailure
+// Allocation of '%s' failed. (%llu bytes)
+// QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "datagram FEC",
+                sizeof(QUIC_DATAGRAM_FEC));
+// arg2 = arg2 = "datagram FEC" = arg2
+// arg3 = arg3 = sizeof(QUIC_DATAGRAM_FEC) = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_DATAGRAM_C, AllocFailure,
+    TP_ARGS(
+        const char *, arg2,
+        unsigned long long, arg3), 
+    TP_FIELDS(
+        ctf_string(arg2, arg2)
+        ctf_integer(uint64_t, arg3, arg3)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for ConnError
 // [conn][%p] ERROR, %s.
@@ -148,22 +321,26 @@ TRACEPOINT_EVENT(CLOG_DATAGRAM_C, ConnError,
 
 
 /*----------------------------------------------------------
-// Decoder Ring for AllocFailure
-// Allocation of '%s' failed. (%llu bytes)
+// Decoder Ring for ConnErrorStatus
+// [conn][%p] ERROR, %u, %s.
 // QuicTraceEvent(
-                AllocFailure,
-                "Allocation of '%s' failed. (%llu bytes)",
-                "DATAGRAM_SEND operation",
-                0);
-// arg2 = arg2 = "DATAGRAM_SEND operation" = arg2
-// arg3 = arg3 = 0 = arg3
+            ConnErrorStatus,
+            "[conn][%p] ERROR, %u, %s.",
+            Connection,
+            Status,
+            "Create datagram relay socket");
+// arg2 = arg2 = Connection = arg2
+// arg3 = arg3 = Status = arg3
+// arg4 = arg4 = "Create datagram relay socket" = arg4
 ----------------------------------------------------------*/
-TRACEPOINT_EVENT(CLOG_DATAGRAM_C, AllocFailure,
+TRACEPOINT_EVENT(CLOG_DATAGRAM_C, ConnErrorStatus,
     TP_ARGS(
-        const char *, arg2,
-        unsigned long long, arg3), 
+        const void *, arg2,
+        unsigned int, arg3,
+        const char *, arg4), 
     TP_FIELDS(
-        ctf_string(arg2, arg2)
-        ctf_integer(uint64_t, arg3, arg3)
+        ctf_integer_hex(uint64_t, arg2, (uint64_t)arg2)
+        ctf_integer(unsigned int, arg3, arg3)
+        ctf_string(arg4, arg4)
     )
 )
@@ -67,13 +67,13 @@ tracepoint(CLOG_DATAPATH_KQUEUE_C, DatapathErrorStatus , arg2, arg3, arg4);\
 // Decoder Ring for DatapathRecv
 // [data][%p] Recv %u bytes (segment=%hu) Src=%!ADDR! Dst=%!ADDR!
 // QuicTraceEvent(
-        DatapathRecv,
-        "[data][%p] Recv %u bytes (segment=%hu) Src=%!ADDR! Dst=%!ADDR!",
-        SocketContext->Binding,
-        (uint32_t)BytesTransferred,
-        (uint32_t)BytesTransferred,
-        CASTED_CLOG_BYTEARRAY(sizeof(*LocalAddr), LocalAddr),
-        CASTED_CLOG_BYTEARRAY(sizeof(*RemoteAddr), RemoteAddr));
+            DatapathRecv,
+            "[data][%p] Recv %u bytes (segment=%hu) Src=%!ADDR! Dst=%!ADDR!",
+            SocketContext->Binding,
+            (uint32_t)BytesTransferred,
+            (uint32_t)BytesTransferred,
+            CASTED_CLOG_BYTEARRAY(sizeof(*LocalAddr), LocalAddr),
+            CASTED_CLOG_BYTEARRAY(sizeof(*RemoteAddr), RemoteAddr));
 // arg2 = arg2 = SocketContext->Binding = arg2
 // arg3 = arg3 = (uint32_t)BytesTransferred = arg3
 // arg4 = arg4 = (uint32_t)BytesTransferred = arg4
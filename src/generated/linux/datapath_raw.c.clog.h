@@ -45,18 +45,18 @@ tracepoint(CLOG_DATAPATH_RAW_C, AllocFailure , arg2, arg3);\
 // Decoder Ring for DatapathRecv
 // [data][%p] Recv %u bytes (segment=%hu) Src=%!ADDR! Dst=%!ADDR!
 // QuicTraceEvent(
-                        DatapathRecv,
-                        "[data][%p] Recv %u bytes (segment=%hu) Src=%!ADDR! Dst=%!ADDR!",
-                        Socket,
-                        Packets[i]->BufferLength,
-                        Packets[i]->BufferLength,
-                        CASTED_CLOG_BYTEARRAY(sizeof(Packets[i]->Route->LocalAddress), &Packets[i]->Route->LocalAddress),
-                        CASTED_CLOG_BYTEARRAY(sizeof(Packets[i]->Route->RemoteAddress), &Packets[i]->Route->RemoteAddress));
+            DatapathRecv,
+            "[data][%p] Recv %u bytes (segment=%hu) Src=%!ADDR! Dst=%!ADDR!",
+            Socket,
+            FlowHead->BufferLength,
+            FlowHead->BufferLength,
+            CASTED_CLOG_BYTEARRAY(sizeof(FlowHead->Route->LocalAddress), &FlowHead->Route->LocalAddress),
+            CASTED_CLOG_BYTEARRAY(sizeof(FlowHead->Route->RemoteAddress), &FlowHead->Route->RemoteAddress));
 // arg2 = arg2 = Socket = arg2
-// arg3 = arg3 = Packets[i]->BufferLength = arg3
-// arg4 = arg4 = Packets[i]->BufferLength = arg4
-// arg5 = arg5 = CASTED_CLOG_BYTEARRAY(sizeof(Packets[i]->Route->LocalAddress), &Packets[i]->Route->LocalAddress) = arg5
-// arg6 = arg6 = CASTED_CLOG_BYTEARRAY(sizeof(Packets[i]->Route->RemoteAddress), &Packets[i]->Route->RemoteAddress) = arg6
+// arg3 = arg3 = FlowHead->BufferLength = arg3
+// arg4 = arg4 = FlowHead->BufferLength = arg4
+// arg5 = arg5 = CASTED_CLOG_BYTEARRAY(sizeof(FlowHead->Route->LocalAddress), &FlowHead->Route->LocalAddress) = arg5
+// arg6 = arg6 = CASTED_CLOG_BYTEARRAY(sizeof(FlowHead->Route->RemoteAddress), &FlowHead->Route->RemoteAddress) = arg6
 ----------------------------------------------------------*/
 #ifndef _clog_9_ARGS_TRACE_DatapathRecv
 #define _clog_9_ARGS_TRACE_DatapathRecv(uniqueId, encoded_arg_string, arg2, arg3, arg4, arg5, arg5_len, arg6, arg6_len)\
@@ -14,6 +14,14 @@
 #include "datapath_raw_xdp_linux.c.clog.h.lttng.h"
 #endif
 #include <lttng/tracepoint-event.h>
+#ifndef _clog_MACRO_QuicTraceLogWarning
+#define _clog_MACRO_QuicTraceLogWarning  1
+#define QuicTraceLogWarning(a, ...) _clog_CAT(_clog_ARGN_SELECTOR(__VA_ARGS__), _clog_CAT(_,a(#a, __VA_ARGS__)))
+#endif
+#ifndef _clog_MACRO_QuicTraceLogInfo
+#define _clog_MACRO_QuicTraceLogInfo  1
+#define QuicTraceLogInfo(a, ...) _clog_CAT(_clog_ARGN_SELECTOR(__VA_ARGS__), _clog_CAT(_,a(#a, __VA_ARGS__)))
+#endif
 #ifndef _clog_MACRO_QuicTraceLogVerbose
 #define _clog_MACRO_QuicTraceLogVerbose  1
 #define QuicTraceLogVerbose(a, ...) _clog_CAT(_clog_ARGN_SELECTOR(__VA_ARGS__), _clog_CAT(_,a(#a, __VA_ARGS__)))
@@ -25,6 +33,68 @@
 #ifdef __cplusplus
 extern "C" {
 #endif
+/*----------------------------------------------------------
+// Decoder Ring for XdpCidSteeringInUse
+// [ xdp] CID steering already used for port %hu on %s
+// QuicTraceLogWarning(
+            XdpCidSteeringInUse,
+            "[ xdp] CID steering already used for port %hu on %s",
+            ntohs(Interface->FlowSteeringPort),
+            Interface->IfName);
+// arg2 = arg2 = ntohs(Interface->FlowSteeringPort) = arg2
+// arg3 = arg3 = Interface->IfName = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_XdpCidSteeringInUse
+#define _clog_4_ARGS_TRACE_XdpCidSteeringInUse(uniqueId, encoded_arg_string, arg2, arg3)\
+tracepoint(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpCidSteeringInUse , arg2, arg3);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for XdpCidSteeringFailed
+// [ xdp] Failed to add CID steering rule on %s, errno = %d
+// QuicTraceLogWarning(
+                    XdpCidSteeringFailed,
+                    "[ xdp] Failed to add CID steering rule on %s, errno = %d",
+                    Interface->IfName,
+                    errno);
+// arg2 = arg2 = Interface->IfName = arg2
+// arg3 = arg3 = errno = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_XdpCidSteeringFailed
+#define _clog_4_ARGS_TRACE_XdpCidSteeringFailed(uniqueId, encoded_arg_string, arg2, arg3)\
+tracepoint(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpCidSteeringFailed , arg2, arg3);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for XdpCidSteeringAdded
+// [ xdp] Added %hu CID steering rules for port %hu on %s
+// QuicTraceLogInfo(
+        XdpCidSteeringAdded,
+        "[ xdp] Added %hu CID steering rules for port %hu on %s",
+        Interface->FlowRuleCount,
+        ntohs(Port),
+        Interface->IfName);
+// arg2 = arg2 = Interface->FlowRuleCount = arg2
+// arg3 = arg3 = ntohs(Port) = arg3
+// arg4 = arg4 = Interface->IfName = arg4
+----------------------------------------------------------*/
+#ifndef _clog_5_ARGS_TRACE_XdpCidSteeringAdded
+#define _clog_5_ARGS_TRACE_XdpCidSteeringAdded(uniqueId, encoded_arg_string, arg2, arg3, arg4)\
+tracepoint(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpCidSteeringAdded , arg2, arg3, arg4);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for XdpFailGettingRssQueueCount
 // [ xdp] Failed to get RSS queue count for %s
@@ -43,6 +113,24 @@ tracepoint(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpFailGettingRssQueueCount , arg2);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for XdpQeoProviderLoaded
+// [ xdp] Loaded QEO provider %s
+// QuicTraceLogVerbose(
+        XdpQeoProviderLoaded,
+        "[ xdp] Loaded QEO provider %s",
+        FilePath);
+// arg2 = arg2 = FilePath = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_XdpQeoProviderLoaded
+#define _clog_3_ARGS_TRACE_XdpQeoProviderLoaded(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpQeoProviderLoaded , arg2);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for XdpUmemDeleteFails
 // [ xdp] Failed to delete Umem
@@ -241,12 +329,34 @@ tracepoint(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpNoXsksMap );\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for XdpSharedUmemFails
+// [ xdp] Failed to share Umem on %s queue %u. error:%s
+// QuicTraceLogVerbose(
+                    XdpSharedUmemFails,
+                    "[ xdp] Failed to share Umem on %s queue %u. error:%s",
+                    Interface->IfName,
+                    i,
+                    strerror(-Ret));
+// arg2 = arg2 = Interface->IfName = arg2
+// arg3 = arg3 = i = arg3
+// arg4 = arg4 = strerror(-Ret) = arg4
+----------------------------------------------------------*/
+#ifndef _clog_5_ARGS_TRACE_XdpSharedUmemFails
+#define _clog_5_ARGS_TRACE_XdpSharedUmemFails(uniqueId, encoded_arg_string, arg2, arg3, arg4)\
+tracepoint(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpSharedUmemFails , arg2, arg3, arg4);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for XdpConfigureUmem
 // [ xdp] Failed to configure Umem
 // QuicTraceLogVerbose(
-                XdpConfigureUmem,
-                "[ xdp] Failed to configure Umem");
+                    XdpConfigureUmem,
+                    "[ xdp] Failed to configure Umem");
 ----------------------------------------------------------*/
 #ifndef _clog_2_ARGS_TRACE_XdpConfigureUmem
 #define _clog_2_ARGS_TRACE_XdpConfigureUmem(uniqueId, encoded_arg_string)\
@@ -275,22 +385,6 @@ tracepoint(CLOG_DATAPATH_RAW_XDP_LINUX_C, FailXskSocketCreate , arg2, arg3);\
 
 
 
-/*----------------------------------------------------------
-// Decoder Ring for FailRxAlloc
-// [ xdp][rx  ] OOM for Rx
-// QuicTraceLogVerbose(
-                    FailRxAlloc,
-                    "[ xdp][rx  ] OOM for Rx");
-----------------------------------------------------------*/
-#ifndef _clog_2_ARGS_TRACE_FailRxAlloc
-#define _clog_2_ARGS_TRACE_FailRxAlloc(uniqueId, encoded_arg_string)\
-tracepoint(CLOG_DATAPATH_RAW_XDP_LINUX_C, FailRxAlloc );\
-
-#endif
-
-
-
-
 /*----------------------------------------------------------
 // Decoder Ring for XdpInitialize
 // [ xdp][%p] XDP initialized, %u procs
@@ -421,6 +515,24 @@ tracepoint(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpDeletePortFails , arg2, arg3);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for XdpSetFilterFails
+// [ xdp] Failed to set filter on port %d on %s
+// QuicTraceLogVerbose(
+                        XdpSetFilterFails,
+                        "[ xdp] Failed to set filter on port %d on %s", port, Interface->IfName);
+// arg2 = arg2 = port = arg2
+// arg3 = arg3 = Interface->IfName = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_XdpSetFilterFails
+#define _clog_4_ARGS_TRACE_XdpSetFilterFails(uniqueId, encoded_arg_string, arg2, arg3)\
+tracepoint(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpSetFilterFails , arg2, arg3);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for XdpSetIpFails
 // [ xdp] Failed to set ipv4 %s on %s
@@ -542,6 +654,22 @@ tracepoint(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpPartitionShutdown , arg2);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for FailRxAlloc
+// [ xdp][rx  ] OOM for Rx
+// QuicTraceLogVerbose(
+            FailRxAlloc,
+            "[ xdp][rx  ] OOM for Rx");
+----------------------------------------------------------*/
+#ifndef _clog_2_ARGS_TRACE_FailRxAlloc
+#define _clog_2_ARGS_TRACE_FailRxAlloc(uniqueId, encoded_arg_string)\
+tracepoint(CLOG_DATAPATH_RAW_XDP_LINUX_C, FailRxAlloc );\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for XdpPartitionShutdownComplete
 // [ xdp][%p] XDP partition shutdown complete
@@ -598,6 +726,24 @@ tracepoint(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpEpollErrorStatus , arg2, arg3);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for LibraryError
+// [ lib] ERROR, %s.
+// QuicTraceEvent(
+            LibraryError,
+            "[ lib] ERROR, %s.",
+            "QEO provider is missing " XDP_QEO_SET_FN_NAME);
+// arg2 = arg2 = "QEO provider is missing " XDP_QEO_SET_FN_NAME = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_LibraryError
+#define _clog_3_ARGS_TRACE_LibraryError(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_DATAPATH_RAW_XDP_LINUX_C, LibraryError , arg2);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for LibraryErrorStatus
 // [ lib] ERROR, %u, %s.
@@ -638,24 +784,6 @@ tracepoint(CLOG_DATAPATH_RAW_XDP_LINUX_C, AllocFailure , arg2, arg3);\
 
 
 
-/*----------------------------------------------------------
-// Decoder Ring for LibraryError
-// [ lib] ERROR, %s.
-// QuicTraceEvent(
-            LibraryError,
-            "[ lib] ERROR, %s.",
-            "no XDP capable interface");
-// arg2 = arg2 = "no XDP capable interface" = arg2
-----------------------------------------------------------*/
-#ifndef _clog_3_ARGS_TRACE_LibraryError
-#define _clog_3_ARGS_TRACE_LibraryError(uniqueId, encoded_arg_string, arg2)\
-tracepoint(CLOG_DATAPATH_RAW_XDP_LINUX_C, LibraryError , arg2);\
-
-#endif
-
-
-
-
 /*----------------------------------------------------------
 // Decoder Ring for RxConstructPacket
 // [ xdp][rx  ] Constructing Packet from Rx, local=%!ADDR!, remote=%!ADDR!
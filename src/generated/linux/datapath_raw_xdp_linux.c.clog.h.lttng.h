@@ -1,6 +1,79 @@
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for XdpCidSteeringInUse
+// [ xdp] CID steering already used for port %hu on %s
+// QuicTraceLogWarning(
+            XdpCidSteeringInUse,
+            "[ xdp] CID steering already used for port %hu on %s",
+            ntohs(Interface->FlowSteeringPort),
+            Interface->IfName);
+// arg2 = arg2 = ntohs(Interface->FlowSteeringPort) = arg2
+// arg3 = arg3 = Interface->IfName = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpCidSteeringInUse,
+    TP_ARGS(
+        unsigned short, arg2,
+        const char *, arg3), 
+    TP_FIELDS(
+        ctf_integer(unsigned short, arg2, arg2)
+        ctf_string(arg3, arg3)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for XdpCidSteeringFailed
+// [ xdp] Failed to add CID steering rule on %s, errno = %d
+// QuicTraceLogWarning(
+                    XdpCidSteeringFailed,
+                    "[ xdp] Failed to add CID steering rule on %s, errno = %d",
+                    Interface->IfName,
+                    errno);
+// arg2 = arg2 = Interface->IfName = arg2
+// arg3 = arg3 = errno = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpCidSteeringFailed,
+    TP_ARGS(
+        const char *, arg2,
+        int, arg3), 
+    TP_FIELDS(
+        ctf_string(arg2, arg2)
+        ctf_integer(int, arg3, arg3)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for XdpCidSteeringAdded
+// [ xdp] Added %hu CID steering rules for port %hu on %s
+// QuicTraceLogInfo(
+        XdpCidSteeringAdded,
+        "[ xdp] Added %hu CID steering rules for port %hu on %s",
+        Interface->FlowRuleCount,
+        ntohs(Port),
+        Interface->IfName);
+// arg2 = arg2 = Interface->FlowRuleCount = arg2
+// arg3 = arg3 = ntohs(Port) = arg3
+// arg4 = arg4 = Interface->IfName = arg4
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpCidSteeringAdded,
+    TP_ARGS(
+        unsigned short, arg2,
+        unsigned short, arg3,
+        const char *, arg4), 
+    TP_FIELDS(
+        ctf_integer(unsigned short, arg2, arg2)
+        ctf_integer(unsigned short, arg3, arg3)
+        ctf_string(arg4, arg4)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for XdpFailGettingRssQueueCount
 // [ xdp] Failed to get RSS queue count for %s
@@ -20,6 +93,25 @@ TRACEPOINT_EVENT(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpFailGettingRssQueueCount,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for XdpQeoProviderLoaded
+// [ xdp] Loaded QEO provider %s
+// QuicTraceLogVerbose(
+        XdpQeoProviderLoaded,
+        "[ xdp] Loaded QEO provider %s",
+        FilePath);
+// arg2 = arg2 = FilePath = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpQeoProviderLoaded,
+    TP_ARGS(
+        const char *, arg2), 
+    TP_FIELDS(
+        ctf_string(arg2, arg2)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for XdpUmemDeleteFails
 // [ xdp] Failed to delete Umem
@@ -237,12 +329,39 @@ TRACEPOINT_EVENT(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpNoXsksMap,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for XdpSharedUmemFails
+// [ xdp] Failed to share Umem on %s queue %u. error:%s
+// QuicTraceLogVerbose(
+                    XdpSharedUmemFails,
+                    "[ xdp] Failed to share Umem on %s queue %u. error:%s",
+                    Interface->IfName,
+                    i,
+                    strerror(-Ret));
+// arg2 = arg2 = Interface->IfName = arg2
+// arg3 = arg3 = i = arg3
+// arg4 = arg4 = strerror(-Ret) = arg4
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpSharedUmemFails,
+    TP_ARGS(
+        const char *, arg2,
+        unsigned int, arg3,
+        const char *, arg4), 
+    TP_FIELDS(
+        ctf_string(arg2, arg2)
+        ctf_integer(unsigned int, arg3, arg3)
+        ctf_string(arg4, arg4)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for XdpConfigureUmem
 // [ xdp] Failed to configure Umem
 // QuicTraceLogVerbose(
-                XdpConfigureUmem,
-                "[ xdp] Failed to configure Umem");
+                    XdpConfigureUmem,
+                    "[ xdp] Failed to configure Umem");
 ----------------------------------------------------------*/
 TRACEPOINT_EVENT(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpConfigureUmem,
     TP_ARGS(
@@ -274,22 +393,6 @@ TRACEPOINT_EVENT(CLOG_DATAPATH_RAW_XDP_LINUX_C, FailXskSocketCreate,
 
 
 
-/*----------------------------------------------------------
-// Decoder Ring for FailRxAlloc
-// [ xdp][rx  ] OOM for Rx
-// QuicTraceLogVerbose(
-                    FailRxAlloc,
-                    "[ xdp][rx  ] OOM for Rx");
-----------------------------------------------------------*/
-TRACEPOINT_EVENT(CLOG_DATAPATH_RAW_XDP_LINUX_C, FailRxAlloc,
-    TP_ARGS(
-), 
-    TP_FIELDS(
-    )
-)
-
-
-
 /*----------------------------------------------------------
 // Decoder Ring for XdpInitialize
 // [ xdp][%p] XDP initialized, %u procs
@@ -435,6 +538,27 @@ TRACEPOINT_EVENT(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpDeletePortFails,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for XdpSetFilterFails
+// [ xdp] Failed to set filter on port %d on %s
+// QuicTraceLogVerbose(
+                        XdpSetFilterFails,
+                        "[ xdp] Failed to set filter on port %d on %s", port, Interface->IfName);
+// arg2 = arg2 = port = arg2
+// arg3 = arg3 = Interface->IfName = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpSetFilterFails,
+    TP_ARGS(
+        int, arg2,
+        const char *, arg3), 
+    TP_FIELDS(
+        ctf_integer(int, arg2, arg2)
+        ctf_string(arg3, arg3)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for XdpSetIpFails
 // [ xdp] Failed to set ipv4 %s on %s
@@ -564,6 +688,22 @@ TRACEPOINT_EVENT(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpPartitionShutdown,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for FailRxAlloc
+// [ xdp][rx  ] OOM for Rx
+// QuicTraceLogVerbose(
+            FailRxAlloc,
+            "[ xdp][rx  ] OOM for Rx");
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_DATAPATH_RAW_XDP_LINUX_C, FailRxAlloc,
+    TP_ARGS(
+), 
+    TP_FIELDS(
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for XdpPartitionShutdownComplete
 // [ xdp][%p] XDP partition shutdown complete
@@ -625,6 +765,25 @@ TRACEPOINT_EVENT(CLOG_DATAPATH_RAW_XDP_LINUX_C, XdpEpollErrorStatus,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for LibraryError
+// [ lib] ERROR, %s.
+// QuicTraceEvent(
+            LibraryError,
+            "[ lib] ERROR, %s.",
+            "QEO provider is missing " XDP_QEO_SET_FN_NAME);
+// arg2 = arg2 = "QEO provider is missing " XDP_QEO_SET_FN_NAME = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_DATAPATH_RAW_XDP_LINUX_C, LibraryError,
+    TP_ARGS(
+        const char *, arg2), 
+    TP_FIELDS(
+        ctf_string(arg2, arg2)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for LibraryErrorStatus
 // [ lib] ERROR, %u, %s.
@@ -671,25 +830,6 @@ TRACEPOINT_EVENT(CLOG_DATAPATH_RAW_XDP_LINUX_C, AllocFailure,
 
 
 
-/*----------------------------------------------------------
-// Decoder Ring for LibraryError
-// [ lib] ERROR, %s.
-// QuicTraceEvent(
-            LibraryError,
-            "[ lib] ERROR, %s.",
-            "no XDP capable interface");
-// arg2 = arg2 = "no XDP capable interface" = arg2
-----------------------------------------------------------*/
-TRACEPOINT_EVENT(CLOG_DATAPATH_RAW_XDP_LINUX_C, LibraryError,
-    TP_ARGS(
-        const char *, arg2), 
-    TP_FIELDS(
-        ctf_string(arg2, arg2)
-    )
-)
-
-
-
 /*----------------------------------------------------------
 // Decoder Ring for RxConstructPacket
 // [ xdp][rx  ] Constructing Packet from Rx, local=%!ADDR!, remote=%!ADDR!
@@ -0,0 +1,23 @@
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for AllocFailure
+// Allocation of '%s' failed. (%llu bytes)
+// QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "event queue",
+            (size_t)NewCapacity * sizeof(QUIC_QUEUED_EVENT));
+// arg2 = arg2 = "event queue" = arg2
+// arg3 = arg3 = (size_t)NewCapacity * sizeof(QUIC_QUEUED_EVENT) = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_EVENT_QUEUE_C, AllocFailure,
+    TP_ARGS(
+        const char *, arg2,
+        unsigned long long, arg3), 
+    TP_FIELDS(
+        ctf_string(arg2, arg2)
+        ctf_integer(uint64_t, arg3, arg3)
+    )
+)
@@ -25,12 +25,12 @@ extern "C" {
 // Decoder Ring for AllocFailure
 // Allocation of '%s' failed. (%llu bytes)
 // QuicTraceEvent(
-                AllocFailure,
-                "Allocation of '%s' failed. (%llu bytes)",
-                "CXPLAT_HASHTABLE",
-                sizeof(CXPLAT_HASHTABLE));
-// arg2 = arg2 = "CXPLAT_HASHTABLE" = arg2
-// arg3 = arg3 = sizeof(CXPLAT_HASHTABLE) = arg3
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "hashtable groups",
+            GroupCount * sizeof(CXPLAT_HASHTABLE_GROUP));
+// arg2 = arg2 = "hashtable groups" = arg2
+// arg3 = arg3 = GroupCount * sizeof(CXPLAT_HASHTABLE_GROUP) = arg3
 ----------------------------------------------------------*/
 #ifndef _clog_4_ARGS_TRACE_AllocFailure
 #define _clog_4_ARGS_TRACE_AllocFailure(uniqueId, encoded_arg_string, arg2, arg3)\
@@ -5,12 +5,12 @@
 // Decoder Ring for AllocFailure
 // Allocation of '%s' failed. (%llu bytes)
 // QuicTraceEvent(
-                AllocFailure,
-                "Allocation of '%s' failed. (%llu bytes)",
-                "CXPLAT_HASHTABLE",
-                sizeof(CXPLAT_HASHTABLE));
-// arg2 = arg2 = "CXPLAT_HASHTABLE" = arg2
-// arg3 = arg3 = sizeof(CXPLAT_HASHTABLE) = arg3
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "hashtable groups",
+            GroupCount * sizeof(CXPLAT_HASHTABLE_GROUP));
+// arg2 = arg2 = "hashtable groups" = arg2
+// arg3 = arg3 = GroupCount * sizeof(CXPLAT_HASHTABLE_GROUP) = arg3
 ----------------------------------------------------------*/
 TRACEPOINT_EVENT(CLOG_HASHTABLE_C, AllocFailure,
     TP_ARGS(
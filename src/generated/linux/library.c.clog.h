@@ -71,6 +71,22 @@ tracepoint(CLOG_LIBRARY_C, LibraryTestDatapathHooksSet );\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for LibraryExecutionConfigSet
+// [ lib] Setting execution config
+// QuicTraceLogInfo(
+        LibraryExecutionConfigSet,
+        "[ lib] Setting execution config");
+----------------------------------------------------------*/
+#ifndef _clog_2_ARGS_TRACE_LibraryExecutionConfigSet
+#define _clog_2_ARGS_TRACE_LibraryExecutionConfigSet(uniqueId, encoded_arg_string)\
+tracepoint(CLOG_LIBRARY_C, LibraryExecutionConfigSet );\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for LibrarySettingsUpdated
 // [ lib] Settings %p Updated
@@ -192,15 +208,113 @@ tracepoint(CLOG_LIBRARY_C, LibrarySetSettings );\
 
 
 /*----------------------------------------------------------
-// Decoder Ring for LibraryExecutionConfigSet
-// [ lib] Setting execution config
+// Decoder Ring for LibrarySourceRateLimitSet
+// [ lib] Setting source rate limit, retry=%u/s drop=%u/s
 // QuicTraceLogInfo(
-            LibraryExecutionConfigSet,
-            "[ lib] Setting execution config");
+            LibrarySourceRateLimitSet,
+            "[ lib] Setting source rate limit, retry=%u/s drop=%u/s",
+            Limit->RetryRate,
+            Limit->DropRate);
+// arg2 = arg2 = Limit->RetryRate = arg2
+// arg3 = arg3 = Limit->DropRate = arg3
 ----------------------------------------------------------*/
-#ifndef _clog_2_ARGS_TRACE_LibraryExecutionConfigSet
-#define _clog_2_ARGS_TRACE_LibraryExecutionConfigSet(uniqueId, encoded_arg_string)\
-tracepoint(CLOG_LIBRARY_C, LibraryExecutionConfigSet );\
+#ifndef _clog_4_ARGS_TRACE_LibrarySourceRateLimitSet
+#define _clog_4_ARGS_TRACE_LibrarySourceRateLimitSet(uniqueId, encoded_arg_string, arg2, arg3)\
+tracepoint(CLOG_LIBRARY_C, LibrarySourceRateLimitSet , arg2, arg3);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for LibraryTimerSlackSet
+// [ lib] Setting timer slack, %u ms
+// QuicTraceLogInfo(
+            LibraryTimerSlackSet,
+            "[ lib] Setting timer slack, %u ms",
+            *(uint32_t*)Buffer);
+// arg2 = arg2 = *(uint32_t*)Buffer = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_LibraryTimerSlackSet
+#define _clog_3_ARGS_TRACE_LibraryTimerSlackSet(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_LIBRARY_C, LibraryTimerSlackSet , arg2);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for LibraryPerfExportSet
+// [ lib] Setting perf export, %u entries every %u us
+// QuicTraceLogInfo(
+            LibraryPerfExportSet,
+            "[ lib] Setting perf export, %u entries every %u us",
+            MsQuicLib.PerfExportEntryCount,
+            Export->IntervalUs);
+// arg2 = arg2 = MsQuicLib.PerfExportEntryCount = arg2
+// arg3 = arg3 = Export->IntervalUs = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_LibraryPerfExportSet
+#define _clog_4_ARGS_TRACE_LibraryPerfExportSet(uniqueId, encoded_arg_string, arg2, arg3)\
+tracepoint(CLOG_LIBRARY_C, LibraryPerfExportSet , arg2, arg3);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for LibraryQlogHandlerSet
+// [ lib] Setting qlog handler, %p
+// QuicTraceLogInfo(
+            LibraryQlogHandlerSet,
+            "[ lib] Setting qlog handler, %p",
+            (void*)MsQuicLib.QlogHandler.Handler);
+// arg2 = arg2 = (void*)MsQuicLib.QlogHandler.Handler = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_LibraryQlogHandlerSet
+#define _clog_3_ARGS_TRACE_LibraryQlogHandlerSet(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_LIBRARY_C, LibraryQlogHandlerSet , arg2);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for LibraryPacketCaptureSet
+// [ lib] Setting packet capture handler, %p, sample rate %u
+// QuicTraceLogInfo(
+            LibraryPacketCaptureSet,
+            "[ lib] Setting packet capture handler, %p, sample rate %u",
+            (void*)MsQuicLib.PacketCapture.Handler,
+            MsQuicLib.PacketCapture.SampleRate);
+// arg2 = arg2 = (void*)MsQuicLib.PacketCapture.Handler = arg2
+// arg3 = arg3 = MsQuicLib.PacketCapture.SampleRate = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_LibraryPacketCaptureSet
+#define _clog_4_ARGS_TRACE_LibraryPacketCaptureSet(uniqueId, encoded_arg_string, arg2, arg3)\
+tracepoint(CLOG_LIBRARY_C, LibraryPacketCaptureSet , arg2, arg3);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for LibraryLoadBalancingConfigSet
+// [ lib] Updated QUIC-LB config = %hhu
+// QuicTraceLogInfo(
+            LibraryLoadBalancingConfigSet,
+            "[ lib] Updated QUIC-LB config = %hhu",
+            Config->ConfigId);
+// arg2 = arg2 = Config->ConfigId = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_LibraryLoadBalancingConfigSet
+#define _clog_3_ARGS_TRACE_LibraryLoadBalancingConfigSet(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_LIBRARY_C, LibraryLoadBalancingConfigSet , arg2);\
 
 #endif
 
@@ -211,8 +325,8 @@ tracepoint(CLOG_LIBRARY_C, LibraryExecutionConfigSet );\
 // Decoder Ring for LibraryInUse
 // [ lib] Now in use.
 // QuicTraceLogInfo(
-                LibraryInUse,
-                "[ lib] Now in use.");
+            LibraryInUse,
+            "[ lib] Now in use.");
 ----------------------------------------------------------*/
 #ifndef _clog_2_ARGS_TRACE_LibraryInUse
 #define _clog_2_ARGS_TRACE_LibraryInUse(uniqueId, encoded_arg_string)\
@@ -239,6 +353,24 @@ tracepoint(CLOG_LIBRARY_C, LibraryNotInUse );\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for LibraryMemoryPressureUpdated
+// [ lib] New memory pressure level, %u
+// QuicTraceLogInfo(
+        LibraryMemoryPressureUpdated,
+        "[ lib] New memory pressure level, %u",
+        (uint32_t)NewLevel);
+// arg2 = arg2 = (uint32_t)NewLevel = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_LibraryMemoryPressureUpdated
+#define _clog_3_ARGS_TRACE_LibraryMemoryPressureUpdated(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_LIBRARY_C, LibraryMemoryPressureUpdated , arg2);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for LibraryMsQuicOpenVersionNull
 // [ api] MsQuicOpenVersion, NULL
@@ -321,16 +453,32 @@ tracepoint(CLOG_LIBRARY_C, LibraryLoadBalancingModeSetAfterInUse );\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for LibraryLoadBalancingConfigLengthChanged
+// [ lib] Tried to change QUIC-LB CID length after library in use!
+// QuicTraceLogError(
+                LibraryLoadBalancingConfigLengthChanged,
+                "[ lib] Tried to change QUIC-LB CID length after library in use!");
+----------------------------------------------------------*/
+#ifndef _clog_2_ARGS_TRACE_LibraryLoadBalancingConfigLengthChanged
+#define _clog_2_ARGS_TRACE_LibraryLoadBalancingConfigLengthChanged(uniqueId, encoded_arg_string)\
+tracepoint(CLOG_LIBRARY_C, LibraryLoadBalancingConfigLengthChanged );\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for AllocFailure
 // Allocation of '%s' failed. (%llu bytes)
 // QuicTraceEvent(
-            AllocFailure,
-            "Allocation of '%s' failed. (%llu bytes)",
-            "connection pools",
-            PerProcSize);
-// arg2 = arg2 = "connection pools" = arg2
-// arg3 = arg3 = PerProcSize = arg3
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "reserve object",
+                Reserve->Size);
+// arg2 = arg2 = "reserve object" = arg2
+// arg3 = arg3 = Reserve->Size = arg3
 ----------------------------------------------------------*/
 #ifndef _clog_4_ARGS_TRACE_AllocFailure
 #define _clog_4_ARGS_TRACE_AllocFailure(uniqueId, encoded_arg_string, arg2, arg3)\
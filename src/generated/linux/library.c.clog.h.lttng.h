@@ -36,6 +36,22 @@ TRACEPOINT_EVENT(CLOG_LIBRARY_C, LibraryTestDatapathHooksSet,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for LibraryExecutionConfigSet
+// [ lib] Setting execution config
+// QuicTraceLogInfo(
+        LibraryExecutionConfigSet,
+        "[ lib] Setting execution config");
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_LIBRARY_C, LibraryExecutionConfigSet,
+    TP_ARGS(
+), 
+    TP_FIELDS(
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for LibrarySettingsUpdated
 // [ lib] Settings %p Updated
@@ -161,16 +177,126 @@ TRACEPOINT_EVENT(CLOG_LIBRARY_C, LibrarySetSettings,
 
 
 /*----------------------------------------------------------
-// Decoder Ring for LibraryExecutionConfigSet
-// [ lib] Setting execution config
+// Decoder Ring for LibrarySourceRateLimitSet
+// [ lib] Setting source rate limit, retry=%u/s drop=%u/s
 // QuicTraceLogInfo(
-            LibraryExecutionConfigSet,
-            "[ lib] Setting execution config");
+            LibrarySourceRateLimitSet,
+            "[ lib] Setting source rate limit, retry=%u/s drop=%u/s",
+            Limit->RetryRate,
+            Limit->DropRate);
+// arg2 = arg2 = Limit->RetryRate = arg2
+// arg3 = arg3 = Limit->DropRate = arg3
 ----------------------------------------------------------*/
-TRACEPOINT_EVENT(CLOG_LIBRARY_C, LibraryExecutionConfigSet,
+TRACEPOINT_EVENT(CLOG_LIBRARY_C, LibrarySourceRateLimitSet,
     TP_ARGS(
-), 
+        unsigned int, arg2,
+        unsigned int, arg3), 
+    TP_FIELDS(
+        ctf_integer(unsigned int, arg2, arg2)
+        ctf_integer(unsigned int, arg3, arg3)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for LibraryTimerSlackSet
+// [ lib] Setting timer slack, %u ms
+// QuicTraceLogInfo(
+            LibraryTimerSlackSet,
+            "[ lib] Setting timer slack, %u ms",
+            *(uint32_t*)Buffer);
+// arg2 = arg2 = *(uint32_t*)Buffer = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_LIBRARY_C, LibraryTimerSlackSet,
+    TP_ARGS(
+        unsigned int, arg2), 
+    TP_FIELDS(
+        ctf_integer(unsigned int, arg2, arg2)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for LibraryPerfExportSet
+// [ lib] Setting perf export, %u entries every %u us
+// QuicTraceLogInfo(
+            LibraryPerfExportSet,
+            "[ lib] Setting perf export, %u entries every %u us",
+            MsQuicLib.PerfExportEntryCount,
+            Export->IntervalUs);
+// arg2 = arg2 = MsQuicLib.PerfExportEntryCount = arg2
+// arg3 = arg3 = Export->IntervalUs = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_LIBRARY_C, LibraryPerfExportSet,
+    TP_ARGS(
+        unsigned int, arg2,
+        unsigned int, arg3), 
+    TP_FIELDS(
+        ctf_integer(unsigned int, arg2, arg2)
+        ctf_integer(unsigned int, arg3, arg3)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for LibraryQlogHandlerSet
+// [ lib] Setting qlog handler, %p
+// QuicTraceLogInfo(
+            LibraryQlogHandlerSet,
+            "[ lib] Setting qlog handler, %p",
+            (void*)MsQuicLib.QlogHandler.Handler);
+// arg2 = arg2 = (void*)MsQuicLib.QlogHandler.Handler = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_LIBRARY_C, LibraryQlogHandlerSet,
+    TP_ARGS(
+        const void *, arg2), 
     TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg2, (uint64_t)arg2)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for LibraryPacketCaptureSet
+// [ lib] Setting packet capture handler, %p, sample rate %u
+// QuicTraceLogInfo(
+            LibraryPacketCaptureSet,
+            "[ lib] Setting packet capture handler, %p, sample rate %u",
+            (void*)MsQuicLib.PacketCapture.Handler,
+            MsQuicLib.PacketCapture.SampleRate);
+// arg2 = arg2 = (void*)MsQuicLib.PacketCapture.Handler = arg2
+// arg3 = arg3 = MsQuicLib.PacketCapture.SampleRate = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_LIBRARY_C, LibraryPacketCaptureSet,
+    TP_ARGS(
+        const void *, arg2,
+        unsigned int, arg3), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg2, (uint64_t)arg2)
+        ctf_integer(unsigned int, arg3, arg3)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for LibraryLoadBalancingConfigSet
+// [ lib] Updated QUIC-LB config = %hhu
+// QuicTraceLogInfo(
+            LibraryLoadBalancingConfigSet,
+            "[ lib] Updated QUIC-LB config = %hhu",
+            Config->ConfigId);
+// arg2 = arg2 = Config->ConfigId = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_LIBRARY_C, LibraryLoadBalancingConfigSet,
+    TP_ARGS(
+        unsigned char, arg2), 
+    TP_FIELDS(
+        ctf_integer(unsigned char, arg2, arg2)
     )
 )
 
@@ -180,8 +306,8 @@ TRACEPOINT_EVENT(CLOG_LIBRARY_C, LibraryExecutionConfigSet,
 // Decoder Ring for LibraryInUse
 // [ lib] Now in use.
 // QuicTraceLogInfo(
-                LibraryInUse,
-                "[ lib] Now in use.");
+            LibraryInUse,
+            "[ lib] Now in use.");
 ----------------------------------------------------------*/
 TRACEPOINT_EVENT(CLOG_LIBRARY_C, LibraryInUse,
     TP_ARGS(
@@ -208,6 +334,25 @@ TRACEPOINT_EVENT(CLOG_LIBRARY_C, LibraryNotInUse,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for LibraryMemoryPressureUpdated
+// [ lib] New memory pressure level, %u
+// QuicTraceLogInfo(
+        LibraryMemoryPressureUpdated,
+        "[ lib] New memory pressure level, %u",
+        (uint32_t)NewLevel);
+// arg2 = arg2 = (uint32_t)NewLevel = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_LIBRARY_C, LibraryMemoryPressureUpdated,
+    TP_ARGS(
+        unsigned int, arg2), 
+    TP_FIELDS(
+        ctf_integer(unsigned int, arg2, arg2)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for LibraryMsQuicOpenVersionNull
 // [ api] MsQuicOpenVersion, NULL
@@ -291,16 +436,32 @@ TRACEPOINT_EVENT(CLOG_LIBRARY_C, LibraryLoadBalancingModeSetAfterInUse,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for LibraryLoadBalancingConfigLengthChanged
+// [ lib] Tried to change QUIC-LB CID length after library in use!
+// QuicTraceLogError(
+                LibraryLoadBalancingConfigLengthChanged,
+                "[ lib] Tried to change QUIC-LB CID length after library in use!");
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_LIBRARY_C, LibraryLoadBalancingConfigLengthChanged,
+    TP_ARGS(
+), 
+    TP_FIELDS(
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for AllocFailure
 // Allocation of '%s' failed. (%llu bytes)
 // QuicTraceEvent(
-            AllocFailure,
-            "Allocation of '%s' failed. (%llu bytes)",
-            "connection pools",
-            PerProcSize);
-// arg2 = arg2 = "connection pools" = arg2
-// arg3 = arg3 = PerProcSize = arg3
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "reserve object",
+                Reserve->Size);
+// arg2 = arg2 = "reserve object" = arg2
+// arg3 = arg3 = Reserve->Size = arg3
 ----------------------------------------------------------*/
 TRACEPOINT_EVENT(CLOG_LIBRARY_C, AllocFailure,
     TP_ARGS(
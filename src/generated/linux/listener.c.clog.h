@@ -89,6 +89,66 @@ tracepoint(CLOG_LISTENER_C, ListenerCibirIdSet , arg2, arg3, arg4);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for ListenerDrainSet
+// [list][%p] Draining set to %hhu
+// QuicTraceLogVerbose(
+            ListenerDrainSet,
+            "[list][%p] Draining set to %hhu",
+            Listener,
+            Listener->Draining);
+// arg2 = arg2 = Listener = arg2
+// arg3 = arg3 = Listener->Draining = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_ListenerDrainSet
+#define _clog_4_ARGS_TRACE_ListenerDrainSet(uniqueId, encoded_arg_string, arg2, arg3)\
+tracepoint(CLOG_LISTENER_C, ListenerDrainSet , arg2, arg3);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for ListenerPartitionedSet
+// [list][%p] Partitioned set to %hhu
+// QuicTraceLogVerbose(
+            ListenerPartitionedSet,
+            "[list][%p] Partitioned set to %hhu",
+            Listener,
+            Partitioned);
+// arg2 = arg2 = Listener = arg2
+// arg3 = arg3 = Partitioned = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_ListenerPartitionedSet
+#define _clog_4_ARGS_TRACE_ListenerPartitionedSet(uniqueId, encoded_arg_string, arg2, arg3)\
+tracepoint(CLOG_LISTENER_C, ListenerPartitionedSet , arg2, arg3);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for ListenerSniConfigurationsSet
+// [list][%p] SNI configurations set (%u)
+// QuicTraceLogVerbose(
+            ListenerSniConfigurationsSet,
+            "[list][%p] SNI configurations set (%u)",
+            Listener,
+            Count);
+// arg2 = arg2 = Listener = arg2
+// arg3 = arg3 = Count = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_ListenerSniConfigurationsSet
+#define _clog_4_ARGS_TRACE_ListenerSniConfigurationsSet(uniqueId, encoded_arg_string, arg2, arg3)\
+tracepoint(CLOG_LISTENER_C, ListenerSniConfigurationsSet , arg2, arg3);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for CibirIdSet
 // [conn][%p] CIBIR ID set (len %hhu, offset %hhu)
@@ -314,9 +374,9 @@ tracepoint(CLOG_LISTENER_C, ListenerRundown , arg2, arg3);\
             ConnError,
             "[conn][%p] ERROR, %s.",
             Connection,
-            "Connection rejected by registration (overloaded)");
+            "Connection rejected by listener (draining)");
 // arg2 = arg2 = Connection = arg2
-// arg3 = arg3 = "Connection rejected by registration (overloaded)" = arg3
+// arg3 = arg3 = "Connection rejected by listener (draining)" = arg3
 ----------------------------------------------------------*/
 #ifndef _clog_4_ARGS_TRACE_ConnError
 #define _clog_4_ARGS_TRACE_ConnError(uniqueId, encoded_arg_string, arg2, arg3)\
@@ -70,6 +70,75 @@ TRACEPOINT_EVENT(CLOG_LISTENER_C, ListenerCibirIdSet,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for ListenerDrainSet
+// [list][%p] Draining set to %hhu
+// QuicTraceLogVerbose(
+            ListenerDrainSet,
+            "[list][%p] Draining set to %hhu",
+            Listener,
+            Listener->Draining);
+// arg2 = arg2 = Listener = arg2
+// arg3 = arg3 = Listener->Draining = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_LISTENER_C, ListenerDrainSet,
+    TP_ARGS(
+        const void *, arg2,
+        unsigned char, arg3), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg2, (uint64_t)arg2)
+        ctf_integer(unsigned char, arg3, arg3)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for ListenerPartitionedSet
+// [list][%p] Partitioned set to %hhu
+// QuicTraceLogVerbose(
+            ListenerPartitionedSet,
+            "[list][%p] Partitioned set to %hhu",
+            Listener,
+            Partitioned);
+// arg2 = arg2 = Listener = arg2
+// arg3 = arg3 = Partitioned = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_LISTENER_C, ListenerPartitionedSet,
+    TP_ARGS(
+        const void *, arg2,
+        unsigned char, arg3), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg2, (uint64_t)arg2)
+        ctf_integer(unsigned char, arg3, arg3)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for ListenerSniConfigurationsSet
+// [list][%p] SNI configurations set (%u)
+// QuicTraceLogVerbose(
+            ListenerSniConfigurationsSet,
+            "[list][%p] SNI configurations set (%u)",
+            Listener,
+            Count);
+// arg2 = arg2 = Listener = arg2
+// arg3 = arg3 = Count = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_LISTENER_C, ListenerSniConfigurationsSet,
+    TP_ARGS(
+        const void *, arg2,
+        unsigned int, arg3), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg2, (uint64_t)arg2)
+        ctf_integer(unsigned int, arg3, arg3)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for CibirIdSet
 // [conn][%p] CIBIR ID set (len %hhu, offset %hhu)
@@ -331,9 +400,9 @@ TRACEPOINT_EVENT(CLOG_LISTENER_C, ListenerRundown,
             ConnError,
             "[conn][%p] ERROR, %s.",
             Connection,
-            "Connection rejected by registration (overloaded)");
+            "Connection rejected by listener (draining)");
 // arg2 = arg2 = Connection = arg2
-// arg3 = arg3 = "Connection rejected by registration (overloaded)" = arg3
+// arg3 = arg3 = "Connection rejected by listener (draining)" = arg3
 ----------------------------------------------------------*/
 TRACEPOINT_EVENT(CLOG_LISTENER_C, ConnError,
     TP_ARGS(
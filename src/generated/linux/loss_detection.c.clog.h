@@ -319,6 +319,26 @@ tracepoint(CLOG_LOSS_DETECTION_C, ScheduleProbe , arg1, arg3);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for ProbeOnPathChange
+// [conn][%p] Probing new active path (ProbeCount=%hu)
+// QuicTraceLogConnInfo(
+        ProbeOnPathChange,
+        Connection,
+        "Probing new active path (ProbeCount=%hu)",
+        LossDetection->ProbeCount);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = LossDetection->ProbeCount = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_ProbeOnPathChange
+#define _clog_4_ARGS_TRACE_ProbeOnPathChange(uniqueId, arg1, encoded_arg_string, arg3)\
+tracepoint(CLOG_LOSS_DETECTION_C, ProbeOnPathChange , arg1, arg3);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for KeyChangeConfirmed
 // [conn][%p] Key change confirmed by peer
@@ -337,6 +357,26 @@ tracepoint(CLOG_LOSS_DETECTION_C, KeyChangeConfirmed , arg1);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for AllocFailure
+// Allocation of '%s' failed. (%llu bytes)
+// QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "Sent packet index",
+            NewSize * sizeof(QUIC_SENT_PACKET_METADATA*));
+// arg2 = arg2 = "Sent packet index" = arg2
+// arg3 = arg3 = NewSize * sizeof(QUIC_SENT_PACKET_METADATA*) = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_AllocFailure
+#define _clog_4_ARGS_TRACE_AllocFailure(uniqueId, encoded_arg_string, arg2, arg3)\
+tracepoint(CLOG_LOSS_DETECTION_C, AllocFailure , arg2, arg3);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for ConnLossDetectionTimerSet
 // [conn][%p] Setting loss detection %hhu timer for %u us. (ProbeCount=%hu)
@@ -361,26 +401,6 @@ tracepoint(CLOG_LOSS_DETECTION_C, ConnLossDetectionTimerSet , arg2, arg3, arg4,
 
 
 
-/*----------------------------------------------------------
-// Decoder Ring for AllocFailure
-// Allocation of '%s' failed. (%llu bytes)
-// QuicTraceEvent(
-            AllocFailure,
-            "Allocation of '%s' failed. (%llu bytes)",
-            "Sent packet metadata",
-            SIZEOF_QUIC_SENT_PACKET_METADATA(TempSentPacket->FrameCount));
-// arg2 = arg2 = "Sent packet metadata" = arg2
-// arg3 = arg3 = SIZEOF_QUIC_SENT_PACKET_METADATA(TempSentPacket->FrameCount) = arg3
-----------------------------------------------------------*/
-#ifndef _clog_4_ARGS_TRACE_AllocFailure
-#define _clog_4_ARGS_TRACE_AllocFailure(uniqueId, encoded_arg_string, arg2, arg3)\
-tracepoint(CLOG_LOSS_DETECTION_C, AllocFailure , arg2, arg3);\
-
-#endif
-
-
-
-
 /*----------------------------------------------------------
 // Decoder Ring for ConnPacketLost
 // [conn][%p][TX][%llu] %hhu Lost: %hhu
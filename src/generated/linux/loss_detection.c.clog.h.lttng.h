@@ -335,6 +335,29 @@ TRACEPOINT_EVENT(CLOG_LOSS_DETECTION_C, ScheduleProbe,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for ProbeOnPathChange
+// [conn][%p] Probing new active path (ProbeCount=%hu)
+// QuicTraceLogConnInfo(
+        ProbeOnPathChange,
+        Connection,
+        "Probing new active path (ProbeCount=%hu)",
+        LossDetection->ProbeCount);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = LossDetection->ProbeCount = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_LOSS_DETECTION_C, ProbeOnPathChange,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned short, arg3), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer(unsigned short, arg3, arg3)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for KeyChangeConfirmed
 // [conn][%p] Key change confirmed by peer
@@ -354,6 +377,29 @@ TRACEPOINT_EVENT(CLOG_LOSS_DETECTION_C, KeyChangeConfirmed,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for AllocFailure
+// Allocation of '%s' failed. (%llu bytes)
+// QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "Sent packet index",
+            NewSize * sizeof(QUIC_SENT_PACKET_METADATA*));
+// arg2 = arg2 = "Sent packet index" = arg2
+// arg3 = arg3 = NewSize * sizeof(QUIC_SENT_PACKET_METADATA*) = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_LOSS_DETECTION_C, AllocFailure,
+    TP_ARGS(
+        const char *, arg2,
+        unsigned long long, arg3), 
+    TP_FIELDS(
+        ctf_string(arg2, arg2)
+        ctf_integer(uint64_t, arg3, arg3)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for ConnLossDetectionTimerSet
 // [conn][%p] Setting loss detection %hhu timer for %u us. (ProbeCount=%hu)
@@ -385,29 +431,6 @@ TRACEPOINT_EVENT(CLOG_LOSS_DETECTION_C, ConnLossDetectionTimerSet,
 
 
 
-/*----------------------------------------------------------
-// Decoder Ring for AllocFailure
-// Allocation of '%s' failed. (%llu bytes)
-// QuicTraceEvent(
-            AllocFailure,
-            "Allocation of '%s' failed. (%llu bytes)",
-            "Sent packet metadata",
-            SIZEOF_QUIC_SENT_PACKET_METADATA(TempSentPacket->FrameCount));
-// arg2 = arg2 = "Sent packet metadata" = arg2
-// arg3 = arg3 = SIZEOF_QUIC_SENT_PACKET_METADATA(TempSentPacket->FrameCount) = arg3
-----------------------------------------------------------*/
-TRACEPOINT_EVENT(CLOG_LOSS_DETECTION_C, AllocFailure,
-    TP_ARGS(
-        const char *, arg2,
-        unsigned long long, arg3), 
-    TP_FIELDS(
-        ctf_string(arg2, arg2)
-        ctf_integer(uint64_t, arg3, arg3)
-    )
-)
-
-
-
 /*----------------------------------------------------------
 // Decoder Ring for ConnPacketLost
 // [conn][%p][TX][%llu] %hhu Lost: %hhu
@@ -0,0 +1,53 @@
+#ifndef CLOG_DO_NOT_INCLUDE_HEADER
+#include <clog.h>
+#endif
+#undef TRACEPOINT_PROVIDER
+#define TRACEPOINT_PROVIDER CLOG_NET_EMU_C
+#undef TRACEPOINT_PROBE_DYNAMIC_LINKAGE
+#define  TRACEPOINT_PROBE_DYNAMIC_LINKAGE
+#undef TRACEPOINT_INCLUDE
+#define TRACEPOINT_INCLUDE "net_emu.c.clog.h.lttng.h"
+#if !defined(DEF_CLOG_NET_EMU_C) || defined(TRACEPOINT_HEADER_MULTI_READ)
+#define DEF_CLOG_NET_EMU_C
+#include <lttng/tracepoint.h>
+#define __int64 __int64_t
+#include "net_emu.c.clog.h.lttng.h"
+#endif
+#include <lttng/tracepoint-event.h>
+#ifndef _clog_MACRO_QuicTraceLogInfo
+#define _clog_MACRO_QuicTraceLogInfo  1
+#define QuicTraceLogInfo(a, ...) _clog_CAT(_clog_ARGN_SELECTOR(__VA_ARGS__), _clog_CAT(_,a(#a, __VA_ARGS__)))
+#endif
+#ifdef __cplusplus
+extern "C" {
+#endif
+/*----------------------------------------------------------
+// Decoder Ring for NetEmuSettingsSet
+// [ lib] Network emulation enabled, %u kbps/%u us up, %u kbps/%u us down
+// QuicTraceLogInfo(
+        NetEmuSettingsSet,
+        "[ lib] Network emulation enabled, %u kbps/%u us up, %u kbps/%u us down",
+        Settings->ClientToServer.BandwidthKbps,
+        Settings->ClientToServer.DelayUs,
+        Settings->ServerToClient.BandwidthKbps,
+        Settings->ServerToClient.DelayUs);
+// arg2 = arg2 = Settings->ClientToServer.BandwidthKbps = arg2
+// arg3 = arg3 = Settings->ClientToServer.DelayUs = arg3
+// arg4 = arg4 = Settings->ServerToClient.BandwidthKbps = arg4
+// arg5 = arg5 = Settings->ServerToClient.DelayUs = arg5
+----------------------------------------------------------*/
+#ifndef _clog_6_ARGS_TRACE_NetEmuSettingsSet
+#define _clog_6_ARGS_TRACE_NetEmuSettingsSet(uniqueId, encoded_arg_string, arg2, arg3, arg4, arg5)\
+tracepoint(CLOG_NET_EMU_C, NetEmuSettingsSet , arg2, arg3, arg4, arg5);\
+
+#endif
+
+
+
+
+#ifdef __cplusplus
+}
+#endif
+#ifdef CLOG_INLINE_IMPLEMENTATION
+#include "quic.clog_net_emu.c.clog.h.c"
+#endif
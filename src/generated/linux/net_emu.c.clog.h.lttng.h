@@ -0,0 +1,31 @@
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for NetEmuSettingsSet
+// [ lib] Network emulation enabled, %u kbps/%u us up, %u kbps/%u us down
+// QuicTraceLogInfo(
+        NetEmuSettingsSet,
+        "[ lib] Network emulation enabled, %u kbps/%u us up, %u kbps/%u us down",
+        Settings->ClientToServer.BandwidthKbps,
+        Settings->ClientToServer.DelayUs,
+        Settings->ServerToClient.BandwidthKbps,
+        Settings->ServerToClient.DelayUs);
+// arg2 = arg2 = Settings->ClientToServer.BandwidthKbps = arg2
+// arg3 = arg3 = Settings->ClientToServer.DelayUs = arg3
+// arg4 = arg4 = Settings->ServerToClient.BandwidthKbps = arg4
+// arg5 = arg5 = Settings->ServerToClient.DelayUs = arg5
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_NET_EMU_C, NetEmuSettingsSet,
+    TP_ARGS(
+        unsigned int, arg2,
+        unsigned int, arg3,
+        unsigned int, arg4,
+        unsigned int, arg5), 
+    TP_FIELDS(
+        ctf_integer(unsigned int, arg2, arg2)
+        ctf_integer(unsigned int, arg3, arg3)
+        ctf_integer(unsigned int, arg4, arg4)
+        ctf_integer(unsigned int, arg5, arg5)
+    )
+)
@@ -169,9 +169,9 @@ tracepoint(CLOG_PACKET_BUILDER_C, PacketEncrypt , arg2);\
 // Decoder Ring for PacketFinalize
 // [pack][%llu] Finalizing
 // QuicTraceEvent(
-            PacketFinalize,
-            "[pack][%llu] Finalizing",
-            Builder->Metadata->PacketId);
+                PacketFinalize,
+                "[pack][%llu] Finalizing",
+                Builder->Metadata->PacketId);
 // arg2 = arg2 = Builder->Metadata->PacketId = arg2
 ----------------------------------------------------------*/
 #ifndef _clog_3_ARGS_TRACE_PacketFinalize
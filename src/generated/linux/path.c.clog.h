@@ -14,13 +14,39 @@
 #include "path.c.clog.h.lttng.h"
 #endif
 #include <lttng/tracepoint-event.h>
+#ifndef _clog_MACRO_QuicTraceLogConnWarning
+#define _clog_MACRO_QuicTraceLogConnWarning  1
+#define QuicTraceLogConnWarning(a, ...) _clog_CAT(_clog_ARGN_SELECTOR(__VA_ARGS__), _clog_CAT(_,a(#a, __VA_ARGS__)))
+#endif
 #ifndef _clog_MACRO_QuicTraceLogConnInfo
 #define _clog_MACRO_QuicTraceLogConnInfo  1
 #define QuicTraceLogConnInfo(a, ...) _clog_CAT(_clog_ARGN_SELECTOR(__VA_ARGS__), _clog_CAT(_,a(#a, __VA_ARGS__)))
 #endif
+#ifndef _clog_MACRO_QuicTraceEvent
+#define _clog_MACRO_QuicTraceEvent  1
+#define QuicTraceEvent(a, ...) _clog_CAT(_clog_ARGN_SELECTOR(__VA_ARGS__), _clog_CAT(_,a(#a, __VA_ARGS__)))
+#endif
 #ifdef __cplusplus
 extern "C" {
 #endif
+/*----------------------------------------------------------
+// Decoder Ring for NoCidForStandbyPath
+// [conn][%p] No unused CID for standby path
+// QuicTraceLogConnWarning(
+                NoCidForStandbyPath,
+                Connection,
+                "No unused CID for standby path");
+// arg1 = arg1 = Connection = arg1
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_NoCidForStandbyPath
+#define _clog_3_ARGS_TRACE_NoCidForStandbyPath(uniqueId, arg1, encoded_arg_string)\
+tracepoint(CLOG_PATH_C, NoCidForStandbyPath , arg1);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for PathInitialized
 // [conn][%p] Path[%hhu] Initialized
@@ -105,6 +131,50 @@ tracepoint(CLOG_PATH_C, PathActive , arg1, arg3, arg4);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for StandbyPathAdded
+// [conn][%p] Path[%hhu] Standby from %!ADDR!
+// QuicTraceLogConnInfo(
+        StandbyPathAdded,
+        Connection,
+        "Path[%hhu] Standby from %!ADDR!",
+        Path->ID,
+        CASTED_CLOG_BYTEARRAY(sizeof(Path->Route.LocalAddress), &Path->Route.LocalAddress));
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Path->ID = arg3
+// arg4 = arg4 = CASTED_CLOG_BYTEARRAY(sizeof(Path->Route.LocalAddress), &Path->Route.LocalAddress) = arg4
+----------------------------------------------------------*/
+#ifndef _clog_6_ARGS_TRACE_StandbyPathAdded
+#define _clog_6_ARGS_TRACE_StandbyPathAdded(uniqueId, arg1, encoded_arg_string, arg3, arg4, arg4_len)\
+tracepoint(CLOG_PATH_C, StandbyPathAdded , arg1, arg3, arg4_len, arg4);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for StandbyPathFailover
+// [conn][%p] Failed over from Path[%hhu] to standby Path[%hhu]
+// QuicTraceLogConnInfo(
+        StandbyPathFailover,
+        Connection,
+        "Failed over from Path[%hhu] to standby Path[%hhu]",
+        OldPathId,
+        NewPathId);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = OldPathId = arg3
+// arg4 = arg4 = NewPathId = arg4
+----------------------------------------------------------*/
+#ifndef _clog_5_ARGS_TRACE_StandbyPathFailover
+#define _clog_5_ARGS_TRACE_StandbyPathFailover(uniqueId, arg1, encoded_arg_string, arg3, arg4)\
+tracepoint(CLOG_PATH_C, StandbyPathFailover , arg1, arg3, arg4);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for PathQeoEnabled
 // [conn][%p] Path[%hhu] QEO enabled
@@ -129,10 +199,10 @@ tracepoint(CLOG_PATH_C, PathQeoEnabled , arg1, arg3);\
 // Decoder Ring for PathQeoDisabled
 // [conn][%p] Path[%hhu] QEO disabled
 // QuicTraceLogConnInfo(
-            PathQeoDisabled,
-            Connection,
-            "Path[%hhu] QEO disabled",
-            Path->ID);
+                PathQeoDisabled,
+                Connection,
+                "Path[%hhu] QEO disabled",
+                Path->ID);
 // arg1 = arg1 = Connection = arg1
 // arg3 = arg3 = Path->ID = arg3
 ----------------------------------------------------------*/
@@ -145,6 +215,48 @@ tracepoint(CLOG_PATH_C, PathQeoDisabled , arg1, arg3);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for ConnErrorStatus
+// [conn][%p] ERROR, %u, %s.
+// QuicTraceEvent(
+            ConnErrorStatus,
+            "[conn][%p] ERROR, %u, %s.",
+            Connection,
+            Status,
+            "Get binding for standby path");
+// arg2 = arg2 = Connection = arg2
+// arg3 = arg3 = Status = arg3
+// arg4 = arg4 = "Get binding for standby path" = arg4
+----------------------------------------------------------*/
+#ifndef _clog_5_ARGS_TRACE_ConnErrorStatus
+#define _clog_5_ARGS_TRACE_ConnErrorStatus(uniqueId, encoded_arg_string, arg2, arg3, arg4)\
+tracepoint(CLOG_PATH_C, ConnErrorStatus , arg2, arg3, arg4);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for ConnError
+// [conn][%p] ERROR, %s.
+// QuicTraceEvent(
+            ConnError,
+            "[conn][%p] ERROR, %s.",
+            Connection,
+            "Standby path binding already in use");
+// arg2 = arg2 = Connection = arg2
+// arg3 = arg3 = "Standby path binding already in use" = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_ConnError
+#define _clog_4_ARGS_TRACE_ConnError(uniqueId, encoded_arg_string, arg2, arg3)\
+tracepoint(CLOG_PATH_C, ConnError , arg2, arg3);\
+
+#endif
+
+
+
+
 #ifdef __cplusplus
 }
 #endif
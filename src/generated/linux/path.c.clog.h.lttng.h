@@ -1,6 +1,25 @@
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for NoCidForStandbyPath
+// [conn][%p] No unused CID for standby path
+// QuicTraceLogConnWarning(
+                NoCidForStandbyPath,
+                Connection,
+                "No unused CID for standby path");
+// arg1 = arg1 = Connection = arg1
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_PATH_C, NoCidForStandbyPath,
+    TP_ARGS(
+        const void *, arg1), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for PathInitialized
 // [conn][%p] Path[%hhu] Initialized
@@ -101,6 +120,62 @@ TRACEPOINT_EVENT(CLOG_PATH_C, PathActive,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for StandbyPathAdded
+// [conn][%p] Path[%hhu] Standby from %!ADDR!
+// QuicTraceLogConnInfo(
+        StandbyPathAdded,
+        Connection,
+        "Path[%hhu] Standby from %!ADDR!",
+        Path->ID,
+        CASTED_CLOG_BYTEARRAY(sizeof(Path->Route.LocalAddress), &Path->Route.LocalAddress));
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Path->ID = arg3
+// arg4 = arg4 = CASTED_CLOG_BYTEARRAY(sizeof(Path->Route.LocalAddress), &Path->Route.LocalAddress) = arg4
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_PATH_C, StandbyPathAdded,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned char, arg3,
+        unsigned int, arg4_len,
+        const void *, arg4), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer(unsigned char, arg3, arg3)
+        ctf_integer(unsigned int, arg4_len, arg4_len)
+        ctf_sequence(char, arg4, arg4, unsigned int, arg4_len)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for StandbyPathFailover
+// [conn][%p] Failed over from Path[%hhu] to standby Path[%hhu]
+// QuicTraceLogConnInfo(
+        StandbyPathFailover,
+        Connection,
+        "Failed over from Path[%hhu] to standby Path[%hhu]",
+        OldPathId,
+        NewPathId);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = OldPathId = arg3
+// arg4 = arg4 = NewPathId = arg4
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_PATH_C, StandbyPathFailover,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned char, arg3,
+        unsigned char, arg4), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer(unsigned char, arg3, arg3)
+        ctf_integer(unsigned char, arg4, arg4)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for PathQeoEnabled
 // [conn][%p] Path[%hhu] QEO enabled
@@ -128,10 +203,10 @@ TRACEPOINT_EVENT(CLOG_PATH_C, PathQeoEnabled,
 // Decoder Ring for PathQeoDisabled
 // [conn][%p] Path[%hhu] QEO disabled
 // QuicTraceLogConnInfo(
-            PathQeoDisabled,
-            Connection,
-            "Path[%hhu] QEO disabled",
-            Path->ID);
+                PathQeoDisabled,
+                Connection,
+                "Path[%hhu] QEO disabled",
+                Path->ID);
 // arg1 = arg1 = Connection = arg1
 // arg3 = arg3 = Path->ID = arg3
 ----------------------------------------------------------*/
@@ -144,3 +219,53 @@ TRACEPOINT_EVENT(CLOG_PATH_C, PathQeoDisabled,
         ctf_integer(unsigned char, arg3, arg3)
     )
 )
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for ConnErrorStatus
+// [conn][%p] ERROR, %u, %s.
+// QuicTraceEvent(
+            ConnErrorStatus,
+            "[conn][%p] ERROR, %u, %s.",
+            Connection,
+            Status,
+            "Get binding for standby path");
+// arg2 = arg2 = Connection = arg2
+// arg3 = arg3 = Status = arg3
+// arg4 = arg4 = "Get binding for standby path" = arg4
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_PATH_C, ConnErrorStatus,
+    TP_ARGS(
+        const void *, arg2,
+        unsigned int, arg3,
+        const char *, arg4), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg2, (uint64_t)arg2)
+        ctf_integer(unsigned int, arg3, arg3)
+        ctf_string(arg4, arg4)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for ConnError
+// [conn][%p] ERROR, %s.
+// QuicTraceEvent(
+            ConnError,
+            "[conn][%p] ERROR, %s.",
+            Connection,
+            "Standby path binding already in use");
+// arg2 = arg2 = Connection = arg2
+// arg3 = arg3 = "Standby path binding already in use" = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_PATH_C, ConnError,
+    TP_ARGS(
+        const void *, arg2,
+        const char *, arg3), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg2, (uint64_t)arg2)
+        ctf_string(arg3, arg3)
+    )
+)
@@ -25,12 +25,12 @@ extern "C" {
 // Decoder Ring for AllocFailure
 // Allocation of '%s' failed. (%llu bytes)
 // QuicTraceEvent(
-                AllocFailure,
-                "Allocation of '%s' failed. (%llu bytes)",
-                "recv_buffer",
-                sizeof(QUIC_RECV_CHUNK) + AllocBufferLength);
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "recv_buffer",
+            sizeof(QUIC_RECV_CHUNK) + AllocLength);
 // arg2 = arg2 = "recv_buffer" = arg2
-// arg3 = arg3 = sizeof(QUIC_RECV_CHUNK) + AllocBufferLength = arg3
+// arg3 = arg3 = sizeof(QUIC_RECV_CHUNK) + AllocLength = arg3
 ----------------------------------------------------------*/
 #ifndef _clog_4_ARGS_TRACE_AllocFailure
 #define _clog_4_ARGS_TRACE_AllocFailure(uniqueId, encoded_arg_string, arg2, arg3)\
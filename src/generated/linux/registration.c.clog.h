@@ -18,6 +18,10 @@
 #define _clog_MACRO_QuicTraceLogInfo  1
 #define QuicTraceLogInfo(a, ...) _clog_CAT(_clog_ARGN_SELECTOR(__VA_ARGS__), _clog_CAT(_,a(#a, __VA_ARGS__)))
 #endif
+#ifndef _clog_MACRO_QuicTraceLogVerbose
+#define _clog_MACRO_QuicTraceLogVerbose  1
+#define QuicTraceLogVerbose(a, ...) _clog_CAT(_clog_ARGN_SELECTOR(__VA_ARGS__), _clog_CAT(_,a(#a, __VA_ARGS__)))
+#endif
 #ifndef _clog_MACRO_QuicTraceEvent
 #define _clog_MACRO_QuicTraceEvent  1
 #define QuicTraceEvent(a, ...) _clog_CAT(_clog_ARGN_SELECTOR(__VA_ARGS__), _clog_CAT(_,a(#a, __VA_ARGS__)))
@@ -43,6 +47,28 @@ tracepoint(CLOG_REGISTRATION_C, RegistrationVerifierEnabled , arg2);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for RegistrationQosSet
+// [ reg][%p] QoS set, Weight=%u, MaxEgressRate=%llu
+// QuicTraceLogVerbose(
+            RegistrationQosSet,
+            "[ reg][%p] QoS set, Weight=%u, MaxEgressRate=%llu",
+            Registration,
+            Qos->SchedulingWeight,
+            Qos->MaxEgressRate);
+// arg2 = arg2 = Registration = arg2
+// arg3 = arg3 = Qos->SchedulingWeight = arg3
+// arg4 = arg4 = Qos->MaxEgressRate = arg4
+----------------------------------------------------------*/
+#ifndef _clog_5_ARGS_TRACE_RegistrationQosSet
+#define _clog_5_ARGS_TRACE_RegistrationQosSet(uniqueId, encoded_arg_string, arg2, arg3, arg4)\
+tracepoint(CLOG_REGISTRATION_C, RegistrationQosSet , arg2, arg3, arg4);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for ApiEnter
 // [ api] Enter %u (%p).
@@ -20,6 +20,33 @@ TRACEPOINT_EVENT(CLOG_REGISTRATION_C, RegistrationVerifierEnabled,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for RegistrationQosSet
+// [ reg][%p] QoS set, Weight=%u, MaxEgressRate=%llu
+// QuicTraceLogVerbose(
+            RegistrationQosSet,
+            "[ reg][%p] QoS set, Weight=%u, MaxEgressRate=%llu",
+            Registration,
+            Qos->SchedulingWeight,
+            Qos->MaxEgressRate);
+// arg2 = arg2 = Registration = arg2
+// arg3 = arg3 = Qos->SchedulingWeight = arg3
+// arg4 = arg4 = Qos->MaxEgressRate = arg4
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_REGISTRATION_C, RegistrationQosSet,
+    TP_ARGS(
+        const void *, arg2,
+        unsigned int, arg3,
+        unsigned long long, arg4), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg2, (uint64_t)arg2)
+        ctf_integer(unsigned int, arg3, arg3)
+        ctf_integer(uint64_t, arg4, arg4)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for ApiEnter
 // [ api] Enter %u (%p).
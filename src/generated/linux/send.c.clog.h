@@ -193,6 +193,26 @@ tracepoint(CLOG_SEND_C, StartAckDelayTimer , arg1, arg3);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for ShortenAckDelay
+// [conn][%p] Shortened ACK delay to %u us
+// QuicTraceLogConnVerbose(
+            ShortenAckDelay,
+            Connection,
+            "Shortened ACK delay to %u us",
+            AckDelayUs);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = AckDelayUs = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_ShortenAckDelay
+#define _clog_4_ARGS_TRACE_ShortenAckDelay(uniqueId, arg1, encoded_arg_string, arg3)\
+tracepoint(CLOG_SEND_C, ShortenAckDelay , arg1, arg3);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for ConnQueueSendFlush
 // [conn][%p] Queueing send flush, reason=%u
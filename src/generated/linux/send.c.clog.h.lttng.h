@@ -185,6 +185,29 @@ TRACEPOINT_EVENT(CLOG_SEND_C, StartAckDelayTimer,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for ShortenAckDelay
+// [conn][%p] Shortened ACK delay to %u us
+// QuicTraceLogConnVerbose(
+            ShortenAckDelay,
+            Connection,
+            "Shortened ACK delay to %u us",
+            AckDelayUs);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = AckDelayUs = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_SEND_C, ShortenAckDelay,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned int, arg3), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer(unsigned int, arg3, arg3)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for ConnQueueSendFlush
 // [conn][%p] Queueing send flush, reason=%u
@@ -149,6 +149,21 @@ tracepoint(CLOG_SETTINGS_C, SettingDumpFixedServerID , arg2);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for SettingDumpConnPoolPrewarmCount
+// [sett] ConnPoolPrewarmCount   = %u
+// QuicTraceLogVerbose(SettingDumpConnPoolPrewarmCount,    "[sett] ConnPoolPrewarmCount   = %u", Settings->ConnectionPoolPrewarmCount);
+// arg2 = arg2 = Settings->ConnectionPoolPrewarmCount = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_SettingDumpConnPoolPrewarmCount
+#define _clog_3_ARGS_TRACE_SettingDumpConnPoolPrewarmCount(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_SETTINGS_C, SettingDumpConnPoolPrewarmCount , arg2);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for SettingDumpMaxStatelessOperations
 // [sett] MaxStatelessOperations = %u
@@ -797,6 +812,111 @@ tracepoint(CLOG_SETTINGS_C, SettingsStreamMultiReceiveEnabled , arg2);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for SettingCarefulResumeEnabled
+// [sett] CarefulResumeEnabled   = %hhu
+// QuicTraceLogVerbose(SettingCarefulResumeEnabled,        "[sett] CarefulResumeEnabled   = %hhu", Settings->CarefulResumeEnabled);
+// arg2 = arg2 = Settings->CarefulResumeEnabled = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_SettingCarefulResumeEnabled
+#define _clog_3_ARGS_TRACE_SettingCarefulResumeEnabled(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_SETTINGS_C, SettingCarefulResumeEnabled , arg2);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingReleaseHandshakeStateEnabled
+// [sett] ReleaseHandshakeState  = %hhu
+// QuicTraceLogVerbose(SettingReleaseHandshakeStateEnabled, "[sett] ReleaseHandshakeState  = %hhu", Settings->ReleaseHandshakeStateEnabled);
+// arg2 = arg2 = Settings->ReleaseHandshakeStateEnabled = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_SettingReleaseHandshakeStateEnabled
+#define _clog_3_ARGS_TRACE_SettingReleaseHandshakeStateEnabled(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_SETTINGS_C, SettingReleaseHandshakeStateEnabled , arg2);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingResumptionTicketCacheEnabled
+// [sett] ResumptionTicketCache  = %hhu
+// QuicTraceLogVerbose(SettingResumptionTicketCacheEnabled, "[sett] ResumptionTicketCache  = %hhu", Settings->ResumptionTicketCacheEnabled);
+// arg2 = arg2 = Settings->ResumptionTicketCacheEnabled = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_SettingResumptionTicketCacheEnabled
+#define _clog_3_ARGS_TRACE_SettingResumptionTicketCacheEnabled(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_SETTINGS_C, SettingResumptionTicketCacheEnabled , arg2);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingAdaptiveAckDelayEnabled
+// [sett] AdaptiveAckDelay       = %hhu
+// QuicTraceLogVerbose(SettingAdaptiveAckDelayEnabled,     "[sett] AdaptiveAckDelay       = %hhu", Settings->AdaptiveAckDelayEnabled);
+// arg2 = arg2 = Settings->AdaptiveAckDelayEnabled = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_SettingAdaptiveAckDelayEnabled
+#define _clog_3_ARGS_TRACE_SettingAdaptiveAckDelayEnabled(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_SETTINGS_C, SettingAdaptiveAckDelayEnabled , arg2);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingNetStatsEventThreshold
+// [sett] NetStatsEventThreshold = %hhu
+// QuicTraceLogVerbose(SettingNetStatsEventThreshold,      "[sett] NetStatsEventThreshold = %hhu", Settings->NetStatsEventThreshold);
+// arg2 = arg2 = Settings->NetStatsEventThreshold = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_SettingNetStatsEventThreshold
+#define _clog_3_ARGS_TRACE_SettingNetStatsEventThreshold(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_SETTINGS_C, SettingNetStatsEventThreshold , arg2);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingHibernateTimeoutMs
+// [sett] HibernateTimeoutMs     = %u
+// QuicTraceLogVerbose(SettingHibernateTimeoutMs,          "[sett] HibernateTimeoutMs     = %u", Settings->HibernateTimeoutMs);
+// arg2 = arg2 = Settings->HibernateTimeoutMs = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_SettingHibernateTimeoutMs
+#define _clog_3_ARGS_TRACE_SettingHibernateTimeoutMs(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_SETTINGS_C, SettingHibernateTimeoutMs , arg2);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingEarlyCreditWindow
+// [sett] EarlyCreditWindow      = %u
+// QuicTraceLogVerbose(SettingEarlyCreditWindow,           "[sett] EarlyCreditWindow      = %u", Settings->EarlyCreditWindow);
+// arg2 = arg2 = Settings->EarlyCreditWindow = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_SettingEarlyCreditWindow
+#define _clog_3_ARGS_TRACE_SettingEarlyCreditWindow(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_SETTINGS_C, SettingEarlyCreditWindow , arg2);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for SettingDumpLFixedServerID
 // [sett] FixedServerID          = %u
@@ -812,6 +932,21 @@ tracepoint(CLOG_SETTINGS_C, SettingDumpLFixedServerID , arg2);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for SettingDumpLConnPoolPrewarmCount
+// [sett] ConnPoolPrewarmCount   = %u
+// QuicTraceLogVerbose(SettingDumpLConnPoolPrewarmCount,       "[sett] ConnPoolPrewarmCount   = %u", Settings->ConnectionPoolPrewarmCount);
+// arg2 = arg2 = Settings->ConnectionPoolPrewarmCount = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_SettingDumpLConnPoolPrewarmCount
+#define _clog_3_ARGS_TRACE_SettingDumpLConnPoolPrewarmCount(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_SETTINGS_C, SettingDumpLConnPoolPrewarmCount , arg2);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for SettingDumpStreamRecvBufferDefault
 // [sett] StreamRecvBufferDefault= %u
@@ -842,6 +977,111 @@ tracepoint(CLOG_SETTINGS_C, SettingStreamMultiReceiveEnabled , arg2);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for SettingDumpCarefulResumeEnabled
+// [sett] CarefulResumeEnabled       = %hhu
+// QuicTraceLogVerbose(SettingDumpCarefulResumeEnabled,        "[sett] CarefulResumeEnabled       = %hhu", Settings->CarefulResumeEnabled);
+// arg2 = arg2 = Settings->CarefulResumeEnabled = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_SettingDumpCarefulResumeEnabled
+#define _clog_3_ARGS_TRACE_SettingDumpCarefulResumeEnabled(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_SETTINGS_C, SettingDumpCarefulResumeEnabled , arg2);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingDumpReleaseHandshakeStateEnabled
+// [sett] ReleaseHandshakeState      = %hhu
+// QuicTraceLogVerbose(SettingDumpReleaseHandshakeStateEnabled, "[sett] ReleaseHandshakeState      = %hhu", Settings->ReleaseHandshakeStateEnabled);
+// arg2 = arg2 = Settings->ReleaseHandshakeStateEnabled = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_SettingDumpReleaseHandshakeStateEnabled
+#define _clog_3_ARGS_TRACE_SettingDumpReleaseHandshakeStateEnabled(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_SETTINGS_C, SettingDumpReleaseHandshakeStateEnabled , arg2);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingDumpResumptionTicketCacheEnabled
+// [sett] ResumptionTicketCache      = %hhu
+// QuicTraceLogVerbose(SettingDumpResumptionTicketCacheEnabled, "[sett] ResumptionTicketCache      = %hhu", Settings->ResumptionTicketCacheEnabled);
+// arg2 = arg2 = Settings->ResumptionTicketCacheEnabled = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_SettingDumpResumptionTicketCacheEnabled
+#define _clog_3_ARGS_TRACE_SettingDumpResumptionTicketCacheEnabled(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_SETTINGS_C, SettingDumpResumptionTicketCacheEnabled , arg2);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingDumpAdaptiveAckDelayEnabled
+// [sett] AdaptiveAckDelay           = %hhu
+// QuicTraceLogVerbose(SettingDumpAdaptiveAckDelayEnabled,     "[sett] AdaptiveAckDelay           = %hhu", Settings->AdaptiveAckDelayEnabled);
+// arg2 = arg2 = Settings->AdaptiveAckDelayEnabled = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_SettingDumpAdaptiveAckDelayEnabled
+#define _clog_3_ARGS_TRACE_SettingDumpAdaptiveAckDelayEnabled(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_SETTINGS_C, SettingDumpAdaptiveAckDelayEnabled , arg2);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingDumpNetStatsEventThreshold
+// [sett] NetStatsEventThreshold     = %hhu
+// QuicTraceLogVerbose(SettingDumpNetStatsEventThreshold,      "[sett] NetStatsEventThreshold     = %hhu", Settings->NetStatsEventThreshold);
+// arg2 = arg2 = Settings->NetStatsEventThreshold = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_SettingDumpNetStatsEventThreshold
+#define _clog_3_ARGS_TRACE_SettingDumpNetStatsEventThreshold(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_SETTINGS_C, SettingDumpNetStatsEventThreshold , arg2);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingDumpHibernateTimeoutMs
+// [sett] HibernateTimeoutMs         = %u
+// QuicTraceLogVerbose(SettingDumpHibernateTimeoutMs,          "[sett] HibernateTimeoutMs         = %u", Settings->HibernateTimeoutMs);
+// arg2 = arg2 = Settings->HibernateTimeoutMs = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_SettingDumpHibernateTimeoutMs
+#define _clog_3_ARGS_TRACE_SettingDumpHibernateTimeoutMs(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_SETTINGS_C, SettingDumpHibernateTimeoutMs , arg2);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingDumpEarlyCreditWindow
+// [sett] EarlyCreditWindow          = %u
+// QuicTraceLogVerbose(SettingDumpEarlyCreditWindow,           "[sett] EarlyCreditWindow          = %u", Settings->EarlyCreditWindow);
+// arg2 = arg2 = Settings->EarlyCreditWindow = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_SettingDumpEarlyCreditWindow
+#define _clog_3_ARGS_TRACE_SettingDumpEarlyCreditWindow(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_SETTINGS_C, SettingDumpEarlyCreditWindow , arg2);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for SettingsLoadInvalidAcceptableVersion
 // Invalid AcceptableVersion loaded from storage! 0x%x at position %d
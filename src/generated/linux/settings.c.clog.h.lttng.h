@@ -129,6 +129,22 @@ TRACEPOINT_EVENT(CLOG_SETTINGS_C, SettingDumpFixedServerID,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for SettingDumpConnPoolPrewarmCount
+// [sett] ConnPoolPrewarmCount   = %u
+// QuicTraceLogVerbose(SettingDumpConnPoolPrewarmCount,    "[sett] ConnPoolPrewarmCount   = %u", Settings->ConnectionPoolPrewarmCount);
+// arg2 = arg2 = Settings->ConnectionPoolPrewarmCount = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_SETTINGS_C, SettingDumpConnPoolPrewarmCount,
+    TP_ARGS(
+        unsigned int, arg2), 
+    TP_FIELDS(
+        ctf_integer(unsigned int, arg2, arg2)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for SettingDumpMaxStatelessOperations
 // [sett] MaxStatelessOperations = %u
@@ -826,6 +842,118 @@ TRACEPOINT_EVENT(CLOG_SETTINGS_C, SettingsStreamMultiReceiveEnabled,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for SettingCarefulResumeEnabled
+// [sett] CarefulResumeEnabled   = %hhu
+// QuicTraceLogVerbose(SettingCarefulResumeEnabled,        "[sett] CarefulResumeEnabled   = %hhu", Settings->CarefulResumeEnabled);
+// arg2 = arg2 = Settings->CarefulResumeEnabled = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_SETTINGS_C, SettingCarefulResumeEnabled,
+    TP_ARGS(
+        unsigned char, arg2), 
+    TP_FIELDS(
+        ctf_integer(unsigned char, arg2, arg2)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingReleaseHandshakeStateEnabled
+// [sett] ReleaseHandshakeState  = %hhu
+// QuicTraceLogVerbose(SettingReleaseHandshakeStateEnabled, "[sett] ReleaseHandshakeState  = %hhu", Settings->ReleaseHandshakeStateEnabled);
+// arg2 = arg2 = Settings->ReleaseHandshakeStateEnabled = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_SETTINGS_C, SettingReleaseHandshakeStateEnabled,
+    TP_ARGS(
+        unsigned char, arg2), 
+    TP_FIELDS(
+        ctf_integer(unsigned char, arg2, arg2)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingResumptionTicketCacheEnabled
+// [sett] ResumptionTicketCache  = %hhu
+// QuicTraceLogVerbose(SettingResumptionTicketCacheEnabled, "[sett] ResumptionTicketCache  = %hhu", Settings->ResumptionTicketCacheEnabled);
+// arg2 = arg2 = Settings->ResumptionTicketCacheEnabled = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_SETTINGS_C, SettingResumptionTicketCacheEnabled,
+    TP_ARGS(
+        unsigned char, arg2), 
+    TP_FIELDS(
+        ctf_integer(unsigned char, arg2, arg2)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingAdaptiveAckDelayEnabled
+// [sett] AdaptiveAckDelay       = %hhu
+// QuicTraceLogVerbose(SettingAdaptiveAckDelayEnabled,     "[sett] AdaptiveAckDelay       = %hhu", Settings->AdaptiveAckDelayEnabled);
+// arg2 = arg2 = Settings->AdaptiveAckDelayEnabled = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_SETTINGS_C, SettingAdaptiveAckDelayEnabled,
+    TP_ARGS(
+        unsigned char, arg2), 
+    TP_FIELDS(
+        ctf_integer(unsigned char, arg2, arg2)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingNetStatsEventThreshold
+// [sett] NetStatsEventThreshold = %hhu
+// QuicTraceLogVerbose(SettingNetStatsEventThreshold,      "[sett] NetStatsEventThreshold = %hhu", Settings->NetStatsEventThreshold);
+// arg2 = arg2 = Settings->NetStatsEventThreshold = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_SETTINGS_C, SettingNetStatsEventThreshold,
+    TP_ARGS(
+        unsigned char, arg2), 
+    TP_FIELDS(
+        ctf_integer(unsigned char, arg2, arg2)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingHibernateTimeoutMs
+// [sett] HibernateTimeoutMs     = %u
+// QuicTraceLogVerbose(SettingHibernateTimeoutMs,          "[sett] HibernateTimeoutMs     = %u", Settings->HibernateTimeoutMs);
+// arg2 = arg2 = Settings->HibernateTimeoutMs = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_SETTINGS_C, SettingHibernateTimeoutMs,
+    TP_ARGS(
+        unsigned int, arg2), 
+    TP_FIELDS(
+        ctf_integer(unsigned int, arg2, arg2)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingEarlyCreditWindow
+// [sett] EarlyCreditWindow      = %u
+// QuicTraceLogVerbose(SettingEarlyCreditWindow,           "[sett] EarlyCreditWindow      = %u", Settings->EarlyCreditWindow);
+// arg2 = arg2 = Settings->EarlyCreditWindow = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_SETTINGS_C, SettingEarlyCreditWindow,
+    TP_ARGS(
+        unsigned int, arg2), 
+    TP_FIELDS(
+        ctf_integer(unsigned int, arg2, arg2)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for SettingDumpLFixedServerID
 // [sett] FixedServerID          = %u
@@ -842,6 +970,22 @@ TRACEPOINT_EVENT(CLOG_SETTINGS_C, SettingDumpLFixedServerID,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for SettingDumpLConnPoolPrewarmCount
+// [sett] ConnPoolPrewarmCount   = %u
+// QuicTraceLogVerbose(SettingDumpLConnPoolPrewarmCount,       "[sett] ConnPoolPrewarmCount   = %u", Settings->ConnectionPoolPrewarmCount);
+// arg2 = arg2 = Settings->ConnectionPoolPrewarmCount = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_SETTINGS_C, SettingDumpLConnPoolPrewarmCount,
+    TP_ARGS(
+        unsigned int, arg2), 
+    TP_FIELDS(
+        ctf_integer(unsigned int, arg2, arg2)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for SettingDumpStreamRecvBufferDefault
 // [sett] StreamRecvBufferDefault= %u
@@ -874,6 +1018,118 @@ TRACEPOINT_EVENT(CLOG_SETTINGS_C, SettingStreamMultiReceiveEnabled,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for SettingDumpCarefulResumeEnabled
+// [sett] CarefulResumeEnabled       = %hhu
+// QuicTraceLogVerbose(SettingDumpCarefulResumeEnabled,        "[sett] CarefulResumeEnabled       = %hhu", Settings->CarefulResumeEnabled);
+// arg2 = arg2 = Settings->CarefulResumeEnabled = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_SETTINGS_C, SettingDumpCarefulResumeEnabled,
+    TP_ARGS(
+        unsigned char, arg2), 
+    TP_FIELDS(
+        ctf_integer(unsigned char, arg2, arg2)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingDumpReleaseHandshakeStateEnabled
+// [sett] ReleaseHandshakeState      = %hhu
+// QuicTraceLogVerbose(SettingDumpReleaseHandshakeStateEnabled, "[sett] ReleaseHandshakeState      = %hhu", Settings->ReleaseHandshakeStateEnabled);
+// arg2 = arg2 = Settings->ReleaseHandshakeStateEnabled = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_SETTINGS_C, SettingDumpReleaseHandshakeStateEnabled,
+    TP_ARGS(
+        unsigned char, arg2), 
+    TP_FIELDS(
+        ctf_integer(unsigned char, arg2, arg2)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingDumpResumptionTicketCacheEnabled
+// [sett] ResumptionTicketCache      = %hhu
+// QuicTraceLogVerbose(SettingDumpResumptionTicketCacheEnabled, "[sett] ResumptionTicketCache      = %hhu", Settings->ResumptionTicketCacheEnabled);
+// arg2 = arg2 = Settings->ResumptionTicketCacheEnabled = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_SETTINGS_C, SettingDumpResumptionTicketCacheEnabled,
+    TP_ARGS(
+        unsigned char, arg2), 
+    TP_FIELDS(
+        ctf_integer(unsigned char, arg2, arg2)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingDumpAdaptiveAckDelayEnabled
+// [sett] AdaptiveAckDelay           = %hhu
+// QuicTraceLogVerbose(SettingDumpAdaptiveAckDelayEnabled,     "[sett] AdaptiveAckDelay           = %hhu", Settings->AdaptiveAckDelayEnabled);
+// arg2 = arg2 = Settings->AdaptiveAckDelayEnabled = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_SETTINGS_C, SettingDumpAdaptiveAckDelayEnabled,
+    TP_ARGS(
+        unsigned char, arg2), 
+    TP_FIELDS(
+        ctf_integer(unsigned char, arg2, arg2)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingDumpNetStatsEventThreshold
+// [sett] NetStatsEventThreshold     = %hhu
+// QuicTraceLogVerbose(SettingDumpNetStatsEventThreshold,      "[sett] NetStatsEventThreshold     = %hhu", Settings->NetStatsEventThreshold);
+// arg2 = arg2 = Settings->NetStatsEventThreshold = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_SETTINGS_C, SettingDumpNetStatsEventThreshold,
+    TP_ARGS(
+        unsigned char, arg2), 
+    TP_FIELDS(
+        ctf_integer(unsigned char, arg2, arg2)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingDumpHibernateTimeoutMs
+// [sett] HibernateTimeoutMs         = %u
+// QuicTraceLogVerbose(SettingDumpHibernateTimeoutMs,          "[sett] HibernateTimeoutMs         = %u", Settings->HibernateTimeoutMs);
+// arg2 = arg2 = Settings->HibernateTimeoutMs = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_SETTINGS_C, SettingDumpHibernateTimeoutMs,
+    TP_ARGS(
+        unsigned int, arg2), 
+    TP_FIELDS(
+        ctf_integer(unsigned int, arg2, arg2)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingDumpEarlyCreditWindow
+// [sett] EarlyCreditWindow          = %u
+// QuicTraceLogVerbose(SettingDumpEarlyCreditWindow,           "[sett] EarlyCreditWindow          = %u", Settings->EarlyCreditWindow);
+// arg2 = arg2 = Settings->EarlyCreditWindow = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_SETTINGS_C, SettingDumpEarlyCreditWindow,
+    TP_ARGS(
+        unsigned int, arg2), 
+    TP_FIELDS(
+        ctf_integer(unsigned int, arg2, arg2)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for SettingsLoadInvalidAcceptableVersion
 // Invalid AcceptableVersion loaded from storage! 0x%x at position %d
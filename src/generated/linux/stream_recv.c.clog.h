@@ -357,16 +357,16 @@ tracepoint(CLOG_STREAM_RECV_C, RemoteBlocked , arg1, arg3);\
 // Decoder Ring for IncreaseRxBuffer
 // [strm][%p] Increasing max RX buffer size to %u (MinRtt=%llu; TimeNow=%llu; LastUpdate=%llu)
 // QuicTraceLogStreamVerbose(
-                    IncreaseRxBuffer,
-                    Stream,
-                    "Increasing max RX buffer size to %u (MinRtt=%llu; TimeNow=%llu; LastUpdate=%llu)",
-                    Stream->RecvBuffer.VirtualBufferLength * 2,
-                    Stream->Connection->Paths[0].MinRtt,
-                    TimeNow,
-                    Stream->RecvWindowLastUpdate);
+            IncreaseRxBuffer,
+            Stream,
+            "Increasing max RX buffer size to %u (MinRtt=%llu; TimeNow=%llu; LastUpdate=%llu)",
+            NewWindow,
+            Connection->Paths[0].MinRtt,
+            TimeNow,
+            Stream->RecvWindowLastUpdate);
 // arg1 = arg1 = Stream = arg1
-// arg3 = arg3 = Stream->RecvBuffer.VirtualBufferLength * 2 = arg3
-// arg4 = arg4 = Stream->Connection->Paths[0].MinRtt = arg4
+// arg3 = arg3 = NewWindow = arg3
+// arg4 = arg4 = Connection->Paths[0].MinRtt = arg4
 // arg5 = arg5 = TimeNow = arg5
 // arg6 = arg6 = Stream->RecvWindowLastUpdate = arg6
 ----------------------------------------------------------*/
@@ -379,6 +379,26 @@ tracepoint(CLOG_STREAM_RECV_C, IncreaseRxBuffer , arg1, arg3, arg4, arg5, arg6);
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for DecreaseRxBuffer
+// [strm][%p] Decreasing max RX buffer size to %u
+// QuicTraceLogStreamVerbose(
+                DecreaseRxBuffer,
+                Stream,
+                "Decreasing max RX buffer size to %u",
+                NewWindow);
+// arg1 = arg1 = Stream = arg1
+// arg3 = arg3 = NewWindow = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_DecreaseRxBuffer
+#define _clog_4_ARGS_TRACE_DecreaseRxBuffer(uniqueId, arg1, encoded_arg_string, arg3)\
+tracepoint(CLOG_STREAM_RECV_C, DecreaseRxBuffer , arg1, arg3);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for UpdateFlowControl
 // [strm][%p] Updating flow control window
@@ -415,6 +435,26 @@ tracepoint(CLOG_STREAM_RECV_C, IgnoreRecvFlush , arg1);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for AppReceiveInto
+// [strm][%p] App pulled %llu bytes
+// QuicTraceLogStreamVerbose(
+        AppReceiveInto,
+        Stream,
+        "App pulled %llu bytes",
+        *BytesReceived);
+// arg1 = arg1 = Stream = arg1
+// arg3 = arg3 = *BytesReceived = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_AppReceiveInto
+#define _clog_4_ARGS_TRACE_AppReceiveInto(uniqueId, arg1, encoded_arg_string, arg3)\
+tracepoint(CLOG_STREAM_RECV_C, AppReceiveInto , arg1, arg3);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for IndicatePeerSendShutdown
 // [strm][%p] Indicating QUIC_STREAM_EVENT_PEER_SEND_SHUTDOWN
@@ -356,16 +356,16 @@ TRACEPOINT_EVENT(CLOG_STREAM_RECV_C, RemoteBlocked,
 // Decoder Ring for IncreaseRxBuffer
 // [strm][%p] Increasing max RX buffer size to %u (MinRtt=%llu; TimeNow=%llu; LastUpdate=%llu)
 // QuicTraceLogStreamVerbose(
-                    IncreaseRxBuffer,
-                    Stream,
-                    "Increasing max RX buffer size to %u (MinRtt=%llu; TimeNow=%llu; LastUpdate=%llu)",
-                    Stream->RecvBuffer.VirtualBufferLength * 2,
-                    Stream->Connection->Paths[0].MinRtt,
-                    TimeNow,
-                    Stream->RecvWindowLastUpdate);
+            IncreaseRxBuffer,
+            Stream,
+            "Increasing max RX buffer size to %u (MinRtt=%llu; TimeNow=%llu; LastUpdate=%llu)",
+            NewWindow,
+            Connection->Paths[0].MinRtt,
+            TimeNow,
+            Stream->RecvWindowLastUpdate);
 // arg1 = arg1 = Stream = arg1
-// arg3 = arg3 = Stream->RecvBuffer.VirtualBufferLength * 2 = arg3
-// arg4 = arg4 = Stream->Connection->Paths[0].MinRtt = arg4
+// arg3 = arg3 = NewWindow = arg3
+// arg4 = arg4 = Connection->Paths[0].MinRtt = arg4
 // arg5 = arg5 = TimeNow = arg5
 // arg6 = arg6 = Stream->RecvWindowLastUpdate = arg6
 ----------------------------------------------------------*/
@@ -387,6 +387,29 @@ TRACEPOINT_EVENT(CLOG_STREAM_RECV_C, IncreaseRxBuffer,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for DecreaseRxBuffer
+// [strm][%p] Decreasing max RX buffer size to %u
+// QuicTraceLogStreamVerbose(
+                DecreaseRxBuffer,
+                Stream,
+                "Decreasing max RX buffer size to %u",
+                NewWindow);
+// arg1 = arg1 = Stream = arg1
+// arg3 = arg3 = NewWindow = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_STREAM_RECV_C, DecreaseRxBuffer,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned int, arg3), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer(unsigned int, arg3, arg3)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for UpdateFlowControl
 // [strm][%p] Updating flow control window
@@ -425,6 +448,29 @@ TRACEPOINT_EVENT(CLOG_STREAM_RECV_C, IgnoreRecvFlush,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for AppReceiveInto
+// [strm][%p] App pulled %llu bytes
+// QuicTraceLogStreamVerbose(
+        AppReceiveInto,
+        Stream,
+        "App pulled %llu bytes",
+        *BytesReceived);
+// arg1 = arg1 = Stream = arg1
+// arg3 = arg3 = *BytesReceived = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_STREAM_RECV_C, AppReceiveInto,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned long long, arg3), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer(uint64_t, arg3, arg3)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for IndicatePeerSendShutdown
 // [strm][%p] Indicating QUIC_STREAM_EVENT_PEER_SEND_SHUTDOWN
@@ -47,10 +47,10 @@ tracepoint(CLOG_STREAM_SEND_C, IndicateSendShutdownComplete , arg1);\
 // Decoder Ring for IndicateSendCanceled
 // [strm][%p] Indicating QUIC_STREAM_EVENT_SEND_COMPLETE [%p] (Canceled)
 // QuicTraceLogStreamVerbose(
-                IndicateSendCanceled,
-                Stream,
-                "Indicating QUIC_STREAM_EVENT_SEND_COMPLETE [%p] (Canceled)",
-                SendRequest);
+                    IndicateSendCanceled,
+                    Stream,
+                    "Indicating QUIC_STREAM_EVENT_SEND_COMPLETE [%p] (Canceled)",
+                    SendRequest);
 // arg1 = arg1 = Stream = arg1
 // arg3 = arg3 = SendRequest = arg3
 ----------------------------------------------------------*/
@@ -67,10 +67,10 @@ tracepoint(CLOG_STREAM_SEND_C, IndicateSendCanceled , arg1, arg3);\
 // Decoder Ring for IndicateSendComplete
 // [strm][%p] Indicating QUIC_STREAM_EVENT_SEND_COMPLETE [%p]
 // QuicTraceLogStreamVerbose(
-                IndicateSendComplete,
-                Stream,
-                "Indicating QUIC_STREAM_EVENT_SEND_COMPLETE [%p]",
-                SendRequest);
+                    IndicateSendComplete,
+                    Stream,
+                    "Indicating QUIC_STREAM_EVENT_SEND_COMPLETE [%p]",
+                    SendRequest);
 // arg1 = arg1 = Stream = arg1
 // arg3 = arg3 = SendRequest = arg3
 ----------------------------------------------------------*/
@@ -109,6 +109,30 @@ tracepoint(CLOG_STREAM_SEND_C, SendQueued , arg1, arg3, arg4, arg5, arg6);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for SendRequestCompressed
+// [strm][%p] Compressed send request [%p] from %llu to %llu bytes
+// QuicTraceLogStreamVerbose(
+        SendRequestCompressed,
+        Stream,
+        "Compressed send request [%p] from %llu to %llu bytes",
+        Req,
+        Req->TotalLength,
+        EncodedLength);
+// arg1 = arg1 = Stream = arg1
+// arg3 = arg3 = Req = arg3
+// arg4 = arg4 = Req->TotalLength = arg4
+// arg5 = arg5 = EncodedLength = arg5
+----------------------------------------------------------*/
+#ifndef _clog_6_ARGS_TRACE_SendRequestCompressed
+#define _clog_6_ARGS_TRACE_SendRequestCompressed(uniqueId, arg1, encoded_arg_string, arg3, arg4, arg5)\
+tracepoint(CLOG_STREAM_SEND_C, SendRequestCompressed , arg1, arg3, arg4, arg5);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for NoMoreRoom
 // [strm][%p] Can't squeeze in a frame (no room for header)
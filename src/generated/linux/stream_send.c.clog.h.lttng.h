@@ -24,10 +24,10 @@ TRACEPOINT_EVENT(CLOG_STREAM_SEND_C, IndicateSendShutdownComplete,
 // Decoder Ring for IndicateSendCanceled
 // [strm][%p] Indicating QUIC_STREAM_EVENT_SEND_COMPLETE [%p] (Canceled)
 // QuicTraceLogStreamVerbose(
-                IndicateSendCanceled,
-                Stream,
-                "Indicating QUIC_STREAM_EVENT_SEND_COMPLETE [%p] (Canceled)",
-                SendRequest);
+                    IndicateSendCanceled,
+                    Stream,
+                    "Indicating QUIC_STREAM_EVENT_SEND_COMPLETE [%p] (Canceled)",
+                    SendRequest);
 // arg1 = arg1 = Stream = arg1
 // arg3 = arg3 = SendRequest = arg3
 ----------------------------------------------------------*/
@@ -47,10 +47,10 @@ TRACEPOINT_EVENT(CLOG_STREAM_SEND_C, IndicateSendCanceled,
 // Decoder Ring for IndicateSendComplete
 // [strm][%p] Indicating QUIC_STREAM_EVENT_SEND_COMPLETE [%p]
 // QuicTraceLogStreamVerbose(
-                IndicateSendComplete,
-                Stream,
-                "Indicating QUIC_STREAM_EVENT_SEND_COMPLETE [%p]",
-                SendRequest);
+                    IndicateSendComplete,
+                    Stream,
+                    "Indicating QUIC_STREAM_EVENT_SEND_COMPLETE [%p]",
+                    SendRequest);
 // arg1 = arg1 = Stream = arg1
 // arg3 = arg3 = SendRequest = arg3
 ----------------------------------------------------------*/
@@ -101,6 +101,37 @@ TRACEPOINT_EVENT(CLOG_STREAM_SEND_C, SendQueued,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for SendRequestCompressed
+// [strm][%p] Compressed send request [%p] from %llu to %llu bytes
+// QuicTraceLogStreamVerbose(
+        SendRequestCompressed,
+        Stream,
+        "Compressed send request [%p] from %llu to %llu bytes",
+        Req,
+        Req->TotalLength,
+        EncodedLength);
+// arg1 = arg1 = Stream = arg1
+// arg3 = arg3 = Req = arg3
+// arg4 = arg4 = Req->TotalLength = arg4
+// arg5 = arg5 = EncodedLength = arg5
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_STREAM_SEND_C, SendRequestCompressed,
+    TP_ARGS(
+        const void *, arg1,
+        const void *, arg3,
+        unsigned long long, arg4,
+        unsigned long long, arg5), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer_hex(uint64_t, arg3, (uint64_t)arg3)
+        ctf_integer(uint64_t, arg4, arg4)
+        ctf_integer(uint64_t, arg5, arg5)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for NoMoreRoom
 // [strm][%p] Can't squeeze in a frame (no room for header)
@@ -181,16 +181,36 @@ tracepoint(CLOG_STREAM_SET_C, IndicatePeerStreamStarted , arg1, arg3, arg4);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for IndicateStreamBatchReceived
+// [conn][%p] Indicating STREAM_BATCH_RECEIVED [count=%u]
+// QuicTraceLogConnVerbose(
+            IndicateStreamBatchReceived,
+            Connection,
+            "Indicating STREAM_BATCH_RECEIVED [count=%u]",
+            EntryCount);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = EntryCount = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_IndicateStreamBatchReceived
+#define _clog_4_ARGS_TRACE_IndicateStreamBatchReceived(uniqueId, arg1, encoded_arg_string, arg3)\
+tracepoint(CLOG_STREAM_SET_C, IndicateStreamBatchReceived , arg1, arg3);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for AllocFailure
 // Allocation of '%s' failed. (%llu bytes)
 // QuicTraceEvent(
-                AllocFailure,
-                "Allocation of '%s' failed. (%llu bytes)",
-                "streamset hash table",
-                0);
-// arg2 = arg2 = "streamset hash table" = arg2
-// arg3 = arg3 = 0 = arg3
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "stream index",
+            NewSize * sizeof(QUIC_STREAM*));
+// arg2 = arg2 = "stream index" = arg2
+// arg3 = arg3 = NewSize * sizeof(QUIC_STREAM*) = arg3
 ----------------------------------------------------------*/
 #ifndef _clog_4_ARGS_TRACE_AllocFailure
 #define _clog_4_ARGS_TRACE_AllocFailure(uniqueId, encoded_arg_string, arg2, arg3)\
@@ -221,6 +241,30 @@ tracepoint(CLOG_STREAM_SET_C, ConnError , arg2, arg3);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for StreamAppReceive
+// [strm][%p] Indicating QUIC_STREAM_EVENT_RECEIVE [%llu bytes, %u buffers, 0x%x flags]
+// QuicTraceEvent(
+                StreamAppReceive,
+                "[strm][%p] Indicating QUIC_STREAM_EVENT_RECEIVE [%llu bytes, %u buffers, 0x%x flags]",
+                Stream,
+                Event.RECEIVE.TotalBufferLength,
+                Event.RECEIVE.BufferCount,
+                Event.RECEIVE.Flags);
+// arg2 = arg2 = Stream = arg2
+// arg3 = arg3 = Event.RECEIVE.TotalBufferLength = arg3
+// arg4 = arg4 = Event.RECEIVE.BufferCount = arg4
+// arg5 = arg5 = Event.RECEIVE.Flags = arg5
+----------------------------------------------------------*/
+#ifndef _clog_6_ARGS_TRACE_StreamAppReceive
+#define _clog_6_ARGS_TRACE_StreamAppReceive(uniqueId, encoded_arg_string, arg2, arg3, arg4, arg5)\
+tracepoint(CLOG_STREAM_SET_C, StreamAppReceive , arg2, arg3, arg4, arg5);\
+
+#endif
+
+
+
+
 #ifdef __cplusplus
 }
 #endif
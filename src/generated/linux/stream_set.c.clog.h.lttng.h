@@ -170,16 +170,39 @@ TRACEPOINT_EVENT(CLOG_STREAM_SET_C, IndicatePeerStreamStarted,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for IndicateStreamBatchReceived
+// [conn][%p] Indicating STREAM_BATCH_RECEIVED [count=%u]
+// QuicTraceLogConnVerbose(
+            IndicateStreamBatchReceived,
+            Connection,
+            "Indicating STREAM_BATCH_RECEIVED [count=%u]",
+            EntryCount);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = EntryCount = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_STREAM_SET_C, IndicateStreamBatchReceived,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned int, arg3), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer(unsigned int, arg3, arg3)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for AllocFailure
 // Allocation of '%s' failed. (%llu bytes)
 // QuicTraceEvent(
-                AllocFailure,
-                "Allocation of '%s' failed. (%llu bytes)",
-                "streamset hash table",
-                0);
-// arg2 = arg2 = "streamset hash table" = arg2
-// arg3 = arg3 = 0 = arg3
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "stream index",
+            NewSize * sizeof(QUIC_STREAM*));
+// arg2 = arg2 = "stream index" = arg2
+// arg3 = arg3 = NewSize * sizeof(QUIC_STREAM*) = arg3
 ----------------------------------------------------------*/
 TRACEPOINT_EVENT(CLOG_STREAM_SET_C, AllocFailure,
     TP_ARGS(
@@ -213,3 +236,34 @@ TRACEPOINT_EVENT(CLOG_STREAM_SET_C, ConnError,
         ctf_string(arg3, arg3)
     )
 )
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for StreamAppReceive
+// [strm][%p] Indicating QUIC_STREAM_EVENT_RECEIVE [%llu bytes, %u buffers, 0x%x flags]
+// QuicTraceEvent(
+                StreamAppReceive,
+                "[strm][%p] Indicating QUIC_STREAM_EVENT_RECEIVE [%llu bytes, %u buffers, 0x%x flags]",
+                Stream,
+                Event.RECEIVE.TotalBufferLength,
+                Event.RECEIVE.BufferCount,
+                Event.RECEIVE.Flags);
+// arg2 = arg2 = Stream = arg2
+// arg3 = arg3 = Event.RECEIVE.TotalBufferLength = arg3
+// arg4 = arg4 = Event.RECEIVE.BufferCount = arg4
+// arg5 = arg5 = Event.RECEIVE.Flags = arg5
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_STREAM_SET_C, StreamAppReceive,
+    TP_ARGS(
+        const void *, arg2,
+        unsigned long long, arg3,
+        unsigned int, arg4,
+        unsigned int, arg5), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg2, (uint64_t)arg2)
+        ctf_integer(uint64_t, arg3, arg3)
+        ctf_integer(unsigned int, arg4, arg4)
+        ctf_integer(unsigned int, arg5, arg5)
+    )
+)
@@ -0,0 +1,23 @@
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for AllocFailure
+// Allocation of '%s' failed. (%llu bytes)
+// QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "cached resumption ticket",
+            TicketLength + ServerNameLength + 1);
+// arg2 = arg2 = "cached resumption ticket" = arg2
+// arg3 = arg3 = TicketLength + ServerNameLength + 1 = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_TICKET_CACHE_C, AllocFailure,
+    TP_ARGS(
+        const char *, arg2,
+        unsigned long long, arg3), 
+    TP_FIELDS(
+        ctf_string(arg2, arg2)
+        ctf_integer(uint64_t, arg3, arg3)
+    )
+)
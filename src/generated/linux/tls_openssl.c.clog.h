@@ -465,6 +465,24 @@ tracepoint(CLOG_TLS_OPENSSL_C, OpenSslProcessData , arg1, arg3);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for OpenSslAsyncPending
+// [conn][%p] Handshake suspended for async private key operation
+// QuicTraceLogConnVerbose(
+                    OpenSslAsyncPending,
+                    TlsContext->Connection,
+                    "Handshake suspended for async private key operation");
+// arg1 = arg1 = TlsContext->Connection = arg1
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_OpenSslAsyncPending
+#define _clog_3_ARGS_TRACE_OpenSslAsyncPending(uniqueId, arg1, encoded_arg_string)\
+tracepoint(CLOG_TLS_OPENSSL_C, OpenSslAsyncPending , arg1);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for TlsError
 // [ tls][%p] ERROR, %s.
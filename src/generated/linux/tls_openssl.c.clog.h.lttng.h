@@ -491,6 +491,25 @@ TRACEPOINT_EVENT(CLOG_TLS_OPENSSL_C, OpenSslProcessData,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for OpenSslAsyncPending
+// [conn][%p] Handshake suspended for async private key operation
+// QuicTraceLogConnVerbose(
+                    OpenSslAsyncPending,
+                    TlsContext->Connection,
+                    "Handshake suspended for async private key operation");
+// arg1 = arg1 = TlsContext->Connection = arg1
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_TLS_OPENSSL_C, OpenSslAsyncPending,
+    TP_ARGS(
+        const void *, arg1), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for TlsError
 // [ tls][%p] ERROR, %s.
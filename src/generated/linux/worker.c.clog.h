@@ -14,6 +14,14 @@
 #include "worker.c.clog.h.lttng.h"
 #endif
 #include <lttng/tracepoint-event.h>
+#ifndef _clog_MACRO_QuicTraceLogInfo
+#define _clog_MACRO_QuicTraceLogInfo  1
+#define QuicTraceLogInfo(a, ...) _clog_CAT(_clog_ARGN_SELECTOR(__VA_ARGS__), _clog_CAT(_,a(#a, __VA_ARGS__)))
+#endif
+#ifndef _clog_MACRO_QuicTraceLogConnInfo
+#define _clog_MACRO_QuicTraceLogConnInfo  1
+#define QuicTraceLogConnInfo(a, ...) _clog_CAT(_clog_ARGN_SELECTOR(__VA_ARGS__), _clog_CAT(_,a(#a, __VA_ARGS__)))
+#endif
 #ifndef _clog_MACRO_QuicTraceLogConnVerbose
 #define _clog_MACRO_QuicTraceLogConnVerbose  1
 #define QuicTraceLogConnVerbose(a, ...) _clog_CAT(_clog_ARGN_SELECTOR(__VA_ARGS__), _clog_CAT(_,a(#a, __VA_ARGS__)))
@@ -25,6 +33,114 @@
 #ifdef __cplusplus
 extern "C" {
 #endif
+/*----------------------------------------------------------
+// Decoder Ring for WorkerPoolScaleUp
+// [wrkr][%p] QueueDelay = %u, active workers = %hu
+// QuicTraceLogInfo(
+                WorkerPoolScaleUp,
+                "[wrkr][%p] QueueDelay = %u, active workers = %hu",
+                Worker,
+                Worker->AverageQueueDelay,
+                (uint16_t)(ActiveWorkerCount + 1));
+// arg2 = arg2 = Worker = arg2
+// arg3 = arg3 = Worker->AverageQueueDelay = arg3
+// arg4 = arg4 = (uint16_t)(ActiveWorkerCount + 1) = arg4
+----------------------------------------------------------*/
+#ifndef _clog_5_ARGS_TRACE_WorkerPoolScaleUp
+#define _clog_5_ARGS_TRACE_WorkerPoolScaleUp(uniqueId, encoded_arg_string, arg2, arg3, arg4)\
+tracepoint(CLOG_WORKER_C, WorkerPoolScaleUp , arg2, arg3, arg4);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for WorkerPoolScaleDown
+// [wrkr][%p] Busy %u%% total, active workers = %hu
+// QuicTraceLogInfo(
+            WorkerPoolScaleDown,
+            "[wrkr][%p] Busy %u%% total, active workers = %hu",
+            WorkerPool,
+            TotalBusyPercent,
+            (uint16_t)(ActiveWorkerCount - 1));
+// arg2 = arg2 = WorkerPool = arg2
+// arg3 = arg3 = TotalBusyPercent = arg3
+// arg4 = arg4 = (uint16_t)(ActiveWorkerCount - 1) = arg4
+----------------------------------------------------------*/
+#ifndef _clog_5_ARGS_TRACE_WorkerPoolScaleDown
+#define _clog_5_ARGS_TRACE_WorkerPoolScaleDown(uniqueId, encoded_arg_string, arg2, arg3, arg4)\
+tracepoint(CLOG_WORKER_C, WorkerPoolScaleDown , arg2, arg3, arg4);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for WorkerRebalance
+// [wrkr][%p] Busy %hhu%% vs %hhu%%, rebalancing to partition %hu
+// QuicTraceLogInfo(
+        WorkerRebalance,
+        "[wrkr][%p] Busy %hhu%% vs %hhu%%, rebalancing to partition %hu",
+        Worker,
+        Worker->BusyPercent,
+        MinBusyPercent,
+        Worker->RebalancePartition);
+// arg2 = arg2 = Worker = arg2
+// arg3 = arg3 = Worker->BusyPercent = arg3
+// arg4 = arg4 = MinBusyPercent = arg4
+// arg5 = arg5 = Worker->RebalancePartition = arg5
+----------------------------------------------------------*/
+#ifndef _clog_6_ARGS_TRACE_WorkerRebalance
+#define _clog_6_ARGS_TRACE_WorkerRebalance(uniqueId, encoded_arg_string, arg2, arg3, arg4, arg5)\
+tracepoint(CLOG_WORKER_C, WorkerRebalance , arg2, arg3, arg4, arg5);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for WorkerStolen
+// [conn][%p] Handing off to idle worker %p
+// QuicTraceLogConnInfo(
+            WorkerStolen,
+            Connection,
+            "Handing off to idle worker %p",
+            StealingWorker);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = StealingWorker = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_WorkerStolen
+#define _clog_4_ARGS_TRACE_WorkerStolen(uniqueId, arg1, encoded_arg_string, arg3)\
+tracepoint(CLOG_WORKER_C, WorkerStolen , arg1, arg3);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for WorkerElasticMove
+// [conn][%p] Moving off worker %p, as active workers changed
+// QuicTraceLogConnInfo(
+            WorkerElasticMove,
+            Connection,
+            "Moving off worker %p, as active workers changed",
+            Worker);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Worker = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_WorkerElasticMove
+#define _clog_4_ARGS_TRACE_WorkerElasticMove(uniqueId, arg1, encoded_arg_string, arg3)\
+tracepoint(CLOG_WORKER_C, WorkerElasticMove , arg1, arg3);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for IndicateIdealProcChanged
 // [conn][%p] Indicating QUIC_CONNECTION_EVENT_IDEAL_PROCESSOR_CHANGED (Proc=%hu,Indx=%hu)
@@ -66,21 +182,19 @@ tracepoint(CLOG_WORKER_C, AbandonOnLibShutdown , arg1);\
 
 
 /*----------------------------------------------------------
-// Decoder Ring for WorkerCreated
-// [wrkr][%p] Created, IdealProc=%hu Owner=%p
-// QuicTraceEvent(
-        WorkerCreated,
-        "[wrkr][%p] Created, IdealProc=%hu Owner=%p",
-        Worker,
-        QuicLibraryGetPartitionProcessor(PartitionIndex),
-        Registration);
-// arg2 = arg2 = Worker = arg2
-// arg3 = arg3 = QuicLibraryGetPartitionProcessor(PartitionIndex) = arg3
-// arg4 = arg4 = Registration = arg4
+// Decoder Ring for WorkerStealRequested
+// [conn][%p] Idle worker %p requested hand off
+// QuicTraceLogConnVerbose(
+                    WorkerStealRequested,
+                    Connection,
+                    "Idle worker %p requested hand off",
+                    Worker);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Worker = arg3
 ----------------------------------------------------------*/
-#ifndef _clog_5_ARGS_TRACE_WorkerCreated
-#define _clog_5_ARGS_TRACE_WorkerCreated(uniqueId, encoded_arg_string, arg2, arg3, arg4)\
-tracepoint(CLOG_WORKER_C, WorkerCreated , arg2, arg3, arg4);\
+#ifndef _clog_4_ARGS_TRACE_WorkerStealRequested
+#define _clog_4_ARGS_TRACE_WorkerStealRequested(uniqueId, arg1, encoded_arg_string, arg3)\
+tracepoint(CLOG_WORKER_C, WorkerStealRequested , arg1, arg3);\
 
 #endif
 
@@ -94,11 +208,11 @@ tracepoint(CLOG_WORKER_C, WorkerCreated , arg2, arg3, arg4);\
                 WorkerErrorStatus,
                 "[wrkr][%p] ERROR, %u, %s.",
                 Worker,
-                Status,
-                "CxPlatThreadCreate");
+                QUIC_STATUS_OUT_OF_MEMORY,
+                "CxPlatAddExecutionContext");
 // arg2 = arg2 = Worker = arg2
-// arg3 = arg3 = Status = arg3
-// arg4 = arg4 = "CxPlatThreadCreate" = arg4
+// arg3 = arg3 = QUIC_STATUS_OUT_OF_MEMORY = arg3
+// arg4 = arg4 = "CxPlatAddExecutionContext" = arg4
 ----------------------------------------------------------*/
 #ifndef _clog_5_ARGS_TRACE_WorkerErrorStatus
 #define _clog_5_ARGS_TRACE_WorkerErrorStatus(uniqueId, encoded_arg_string, arg2, arg3, arg4)\
@@ -109,6 +223,28 @@ tracepoint(CLOG_WORKER_C, WorkerErrorStatus , arg2, arg3, arg4);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for WorkerCreated
+// [wrkr][%p] Created, IdealProc=%hu Owner=%p
+// QuicTraceEvent(
+        WorkerCreated,
+        "[wrkr][%p] Created, IdealProc=%hu Owner=%p",
+        Worker,
+        QuicLibraryGetPartitionProcessor(PartitionIndex),
+        Registration);
+// arg2 = arg2 = Worker = arg2
+// arg3 = arg3 = QuicLibraryGetPartitionProcessor(PartitionIndex) = arg3
+// arg4 = arg4 = Registration = arg4
+----------------------------------------------------------*/
+#ifndef _clog_5_ARGS_TRACE_WorkerCreated
+#define _clog_5_ARGS_TRACE_WorkerCreated(uniqueId, encoded_arg_string, arg2, arg3, arg4)\
+tracepoint(CLOG_WORKER_C, WorkerCreated , arg2, arg3, arg4);\
+
+#endif
+
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for WorkerCleanup
 // [wrkr][%p] Cleaning up
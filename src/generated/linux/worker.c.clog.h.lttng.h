@@ -1,6 +1,137 @@
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for WorkerPoolScaleUp
+// [wrkr][%p] QueueDelay = %u, active workers = %hu
+// QuicTraceLogInfo(
+                WorkerPoolScaleUp,
+                "[wrkr][%p] QueueDelay = %u, active workers = %hu",
+                Worker,
+                Worker->AverageQueueDelay,
+                (uint16_t)(ActiveWorkerCount + 1));
+// arg2 = arg2 = Worker = arg2
+// arg3 = arg3 = Worker->AverageQueueDelay = arg3
+// arg4 = arg4 = (uint16_t)(ActiveWorkerCount + 1) = arg4
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_WORKER_C, WorkerPoolScaleUp,
+    TP_ARGS(
+        const void *, arg2,
+        unsigned int, arg3,
+        unsigned short, arg4), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg2, (uint64_t)arg2)
+        ctf_integer(unsigned int, arg3, arg3)
+        ctf_integer(unsigned short, arg4, arg4)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for WorkerPoolScaleDown
+// [wrkr][%p] Busy %u%% total, active workers = %hu
+// QuicTraceLogInfo(
+            WorkerPoolScaleDown,
+            "[wrkr][%p] Busy %u%% total, active workers = %hu",
+            WorkerPool,
+            TotalBusyPercent,
+            (uint16_t)(ActiveWorkerCount - 1));
+// arg2 = arg2 = WorkerPool = arg2
+// arg3 = arg3 = TotalBusyPercent = arg3
+// arg4 = arg4 = (uint16_t)(ActiveWorkerCount - 1) = arg4
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_WORKER_C, WorkerPoolScaleDown,
+    TP_ARGS(
+        const void *, arg2,
+        unsigned int, arg3,
+        unsigned short, arg4), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg2, (uint64_t)arg2)
+        ctf_integer(unsigned int, arg3, arg3)
+        ctf_integer(unsigned short, arg4, arg4)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for WorkerRebalance
+// [wrkr][%p] Busy %hhu%% vs %hhu%%, rebalancing to partition %hu
+// QuicTraceLogInfo(
+        WorkerRebalance,
+        "[wrkr][%p] Busy %hhu%% vs %hhu%%, rebalancing to partition %hu",
+        Worker,
+        Worker->BusyPercent,
+        MinBusyPercent,
+        Worker->RebalancePartition);
+// arg2 = arg2 = Worker = arg2
+// arg3 = arg3 = Worker->BusyPercent = arg3
+// arg4 = arg4 = MinBusyPercent = arg4
+// arg5 = arg5 = Worker->RebalancePartition = arg5
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_WORKER_C, WorkerRebalance,
+    TP_ARGS(
+        const void *, arg2,
+        unsigned char, arg3,
+        unsigned char, arg4,
+        unsigned short, arg5), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg2, (uint64_t)arg2)
+        ctf_integer(unsigned char, arg3, arg3)
+        ctf_integer(unsigned char, arg4, arg4)
+        ctf_integer(unsigned short, arg5, arg5)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for WorkerStolen
+// [conn][%p] Handing off to idle worker %p
+// QuicTraceLogConnInfo(
+            WorkerStolen,
+            Connection,
+            "Handing off to idle worker %p",
+            StealingWorker);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = StealingWorker = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_WORKER_C, WorkerStolen,
+    TP_ARGS(
+        const void *, arg1,
+        const void *, arg3), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer_hex(uint64_t, arg3, (uint64_t)arg3)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for WorkerElasticMove
+// [conn][%p] Moving off worker %p, as active workers changed
+// QuicTraceLogConnInfo(
+            WorkerElasticMove,
+            Connection,
+            "Moving off worker %p, as active workers changed",
+            Worker);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Worker = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_WORKER_C, WorkerElasticMove,
+    TP_ARGS(
+        const void *, arg1,
+        const void *, arg3), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer_hex(uint64_t, arg3, (uint64_t)arg3)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for IndicateIdealProcChanged
 // [conn][%p] Indicating QUIC_CONNECTION_EVENT_IDEAL_PROCESSOR_CHANGED (Proc=%hu,Indx=%hu)
@@ -48,27 +179,23 @@ TRACEPOINT_EVENT(CLOG_WORKER_C, AbandonOnLibShutdown,
 
 
 /*----------------------------------------------------------
-// Decoder Ring for WorkerCreated
-// [wrkr][%p] Created, IdealProc=%hu Owner=%p
-// QuicTraceEvent(
-        WorkerCreated,
-        "[wrkr][%p] Created, IdealProc=%hu Owner=%p",
-        Worker,
-        QuicLibraryGetPartitionProcessor(PartitionIndex),
-        Registration);
-// arg2 = arg2 = Worker = arg2
-// arg3 = arg3 = QuicLibraryGetPartitionProcessor(PartitionIndex) = arg3
-// arg4 = arg4 = Registration = arg4
+// Decoder Ring for WorkerStealRequested
+// [conn][%p] Idle worker %p requested hand off
+// QuicTraceLogConnVerbose(
+                    WorkerStealRequested,
+                    Connection,
+                    "Idle worker %p requested hand off",
+                    Worker);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Worker = arg3
 ----------------------------------------------------------*/
-TRACEPOINT_EVENT(CLOG_WORKER_C, WorkerCreated,
+TRACEPOINT_EVENT(CLOG_WORKER_C, WorkerStealRequested,
     TP_ARGS(
-        const void *, arg2,
-        unsigned short, arg3,
-        const void *, arg4), 
+        const void *, arg1,
+        const void *, arg3), 
     TP_FIELDS(
-        ctf_integer_hex(uint64_t, arg2, (uint64_t)arg2)
-        ctf_integer(unsigned short, arg3, arg3)
-        ctf_integer_hex(uint64_t, arg4, (uint64_t)arg4)
+        ctf_integer_hex(uint64_t, arg1, (uint64_t)arg1)
+        ctf_integer_hex(uint64_t, arg3, (uint64_t)arg3)
     )
 )
 
@@ -81,11 +208,11 @@ TRACEPOINT_EVENT(CLOG_WORKER_C, WorkerCreated,
                 WorkerErrorStatus,
                 "[wrkr][%p] ERROR, %u, %s.",
                 Worker,
-                Status,
-                "CxPlatThreadCreate");
+                QUIC_STATUS_OUT_OF_MEMORY,
+                "CxPlatAddExecutionContext");
 // arg2 = arg2 = Worker = arg2
-// arg3 = arg3 = Status = arg3
-// arg4 = arg4 = "CxPlatThreadCreate" = arg4
+// arg3 = arg3 = QUIC_STATUS_OUT_OF_MEMORY = arg3
+// arg4 = arg4 = "CxPlatAddExecutionContext" = arg4
 ----------------------------------------------------------*/
 TRACEPOINT_EVENT(CLOG_WORKER_C, WorkerErrorStatus,
     TP_ARGS(
@@ -101,6 +228,33 @@ TRACEPOINT_EVENT(CLOG_WORKER_C, WorkerErrorStatus,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for WorkerCreated
+// [wrkr][%p] Created, IdealProc=%hu Owner=%p
+// QuicTraceEvent(
+        WorkerCreated,
+        "[wrkr][%p] Created, IdealProc=%hu Owner=%p",
+        Worker,
+        QuicLibraryGetPartitionProcessor(PartitionIndex),
+        Registration);
+// arg2 = arg2 = Worker = arg2
+// arg3 = arg3 = QuicLibraryGetPartitionProcessor(PartitionIndex) = arg3
+// arg4 = arg4 = Registration = arg4
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_WORKER_C, WorkerCreated,
+    TP_ARGS(
+        const void *, arg2,
+        unsigned short, arg3,
+        const void *, arg4), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg2, (uint64_t)arg2)
+        ctf_integer(unsigned short, arg3, arg3)
+        ctf_integer_hex(uint64_t, arg4, (uint64_t)arg4)
+    )
+)
+
+
+
 /*----------------------------------------------------------
 // Decoder Ring for WorkerCleanup
 // [wrkr][%p] Cleaning up
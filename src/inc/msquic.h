@@ -91,6 +91,7 @@ typedef enum QUIC_LOAD_BALANCING_MODE {
     QUIC_LOAD_BALANCING_DISABLED,               // Default
     QUIC_LOAD_BALANCING_SERVER_ID_IP,           // Encodes IP address in Server ID
     QUIC_LOAD_BALANCING_SERVER_ID_FIXED,        // Encodes a fixed 4-byte value in Server ID
+    QUIC_LOAD_BALANCING_SERVER_ID_QUIC_LB,      // QUIC-LB routable CID (QUIC_PARAM_GLOBAL_LOAD_BALANCING_CONFIG)
     QUIC_LOAD_BALANCING_COUNT,                  // The number of supported load balancing modes
                                                 // MUST BE LAST
 } QUIC_LOAD_BALANCING_MODE;
@@ -146,6 +147,8 @@ typedef enum QUIC_CREDENTIAL_FLAGS {
     QUIC_CREDENTIAL_FLAG_REVOCATION_CHECK_CACHE_ONLY            = 0x00040000, // Windows only currently
     QUIC_CREDENTIAL_FLAG_INPROC_PEER_CERTIFICATE                = 0x00080000, // Schannel only
     QUIC_CREDENTIAL_FLAG_SET_CA_CERTIFICATE_FILE                = 0x00100000, // OpenSSL only currently
+    QUIC_CREDENTIAL_FLAG_ASYNC_PRIVATE_KEY                      = 0x00200000, // OpenSSL 3 only currently
+    QUIC_CREDENTIAL_FLAG_ENABLE_CERTIFICATE_COMPRESSION         = 0x00400000, // OpenSSL 3.2+ only currently
 } QUIC_CREDENTIAL_FLAGS;
 
 DEFINE_ENUM_FLAG_OPERATORS(QUIC_CREDENTIAL_FLAGS)
@@ -189,6 +192,8 @@ DEFINE_ENUM_FLAG_OPERATORS(QUIC_SEND_RESUMPTION_FLAGS)
 typedef enum QUIC_STREAM_SCHEDULING_SCHEME {
     QUIC_STREAM_SCHEDULING_SCHEME_FIFO          = 0x0000,   // Sends stream data first come, first served. (Default)
     QUIC_STREAM_SCHEDULING_SCHEME_ROUND_ROBIN   = 0x0001,   // Sends stream data evenly multiplexed.
+    QUIC_STREAM_SCHEDULING_SCHEME_WEIGHTED_FAIR = 0x0002,   // Sends stream data multiplexed in proportion to stream priority.
+    QUIC_STREAM_SCHEDULING_SCHEME_EXTENSIBLE_PRIORITY = 0x0003, // Sends stream data by RFC 9218 urgency and incremental parameters.
     QUIC_STREAM_SCHEDULING_SCHEME_COUNT,                    // The number of stream scheduling schemes.
 } QUIC_STREAM_SCHEDULING_SCHEME;
 
@@ -198,6 +203,12 @@ typedef enum QUIC_STREAM_OPEN_FLAGS {
     QUIC_STREAM_OPEN_FLAG_0_RTT             = 0x0002,   // The stream was opened via a 0-RTT packet.
     QUIC_STREAM_OPEN_FLAG_DELAY_ID_FC_UPDATES = 0x0004, // Indicates stream ID flow control limit updates for the
                                                         // connection should be delayed to StreamClose.
+    QUIC_STREAM_OPEN_FLAG_APP_OWNED_BUFFERS = 0x0008,   // Data is only received into buffers provided by the app
+                                                        // via StreamProvideReceiveBuffers.
+    QUIC_STREAM_OPEN_FLAG_ZERO_COPY_RECEIVE = 0x0010,   // In-order data may be indicated straight from the
+                                                        // received packets instead of being copied first.
+    QUIC_STREAM_OPEN_FLAG_COMPRESSED        = 0x0020,   // Data is compressed with the connection's negotiated
+                                                        // QUIC_PARAM_CONN_STREAM_COMPRESSION codec.
 } QUIC_STREAM_OPEN_FLAGS;
 
 DEFINE_ENUM_FLAG_OPERATORS(QUIC_STREAM_OPEN_FLAGS)
@@ -272,6 +283,17 @@ typedef enum QUIC_EXECUTION_CONFIG_FLAGS {
     QUIC_EXECUTION_CONFIG_FLAG_XDP              = 0x0004,
     QUIC_EXECUTION_CONFIG_FLAG_NO_IDEAL_PROC    = 0x0008,
     QUIC_EXECUTION_CONFIG_FLAG_HIGH_PRIORITY    = 0x0010,
+    QUIC_EXECUTION_CONFIG_FLAG_IO_URING         = 0x0020,
+    QUIC_EXECUTION_CONFIG_FLAG_ZERO_COPY_SEND   = 0x0040,
+    QUIC_EXECUTION_CONFIG_FLAG_PACING_OFFLOAD   = 0x0080,
+    QUIC_EXECUTION_CONFIG_FLAG_BUSY_POLL        = 0x0100,
+    QUIC_EXECUTION_CONFIG_FLAG_ELASTIC_WORKERS  = 0x0200,
+    QUIC_EXECUTION_CONFIG_FLAG_EXTERNAL         = 0x0400,
+    QUIC_EXECUTION_CONFIG_FLAG_ADAPTIVE_POLL    = 0x0800,
+    QUIC_EXECUTION_CONFIG_FLAG_HUGE_PAGES       = 0x1000,
+    QUIC_EXECUTION_CONFIG_FLAG_PARTITION_SOCKETS = 0x2000,
+    QUIC_EXECUTION_CONFIG_FLAG_CID_FLOW_STEERING = 0x4000,
+    QUIC_EXECUTION_CONFIG_FLAG_PREWARM          = 0x8000,
 #endif
 } QUIC_EXECUTION_CONFIG_FLAGS;
 
@@ -434,6 +456,9 @@ typedef enum QUIC_CONGESTION_CONTROL_ALGORITHM {
     QUIC_CONGESTION_CONTROL_ALGORITHM_CUBIC,
 #ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
     QUIC_CONGESTION_CONTROL_ALGORITHM_BBR,
+    QUIC_CONGESTION_CONTROL_ALGORITHM_BBR3,
+    QUIC_CONGESTION_CONTROL_ALGORITHM_PRAGUE,   // L4S; requires ECN to be enabled.
+    QUIC_CONGESTION_CONTROL_ALGORITHM_COPA,     // Delay-based; for real-time flows.
 #endif
     QUIC_CONGESTION_CONTROL_ALGORITHM_MAX,
 } QUIC_CONGESTION_CONTROL_ALGORITHM;
@@ -515,7 +540,8 @@ typedef struct QUIC_STATISTICS_V2 {
     uint32_t GreaseBitNegotiated    : 1;    // Set if we negotiated the GREASE bit.
     uint32_t EcnCapable             : 1;
     uint32_t EncryptionOffloaded    : 1;    // At least one path successfully offloaded encryption
-    uint32_t RESERVED               : 25;
+    uint32_t L4sEnabled             : 1;    // Sending with ECT(1) and a scalable (L4S) congestion control.
+    uint32_t RESERVED               : 24;
     uint32_t Rtt;                           // In microseconds
     uint32_t MinRtt;                        // In microseconds
     uint32_t MaxRtt;                        // In microseconds
@@ -555,16 +581,74 @@ typedef struct QUIC_STATISTICS_V2 {
 
     uint32_t SendEcnCongestionCount;        // Number of congestion events caused by ECN.
 
+    uint32_t SendL4sAlpha;                  // Smoothed fraction of CE marked packets, in 1/1024ths. 0 without L4S.
+    uint64_t SendCeMarkedPackets;           // Number of sent packets reported as CE marked by the peer.
+
+    //
+    // Time spent unable to send, by the reason sending was stopped. The
+    // reasons can overlap, so these don't sum up to the connection lifetime.
+    //
+    uint64_t SendSchedulingLimitedTimeUs;   // Out of the worker's send budget.
+    uint64_t SendPacingLimitedTimeUs;
+    uint64_t SendCongestionLimitedTimeUs;   // The congestion window was full.
+    uint64_t SendAmplificationLimitedTimeUs;// Waiting for the peer's address to be validated.
+    uint64_t SendConnFlowControlLimitedTimeUs;
+    uint64_t SendStreamFlowControlLimitedTimeUs; // Only stream flow control blocked data was left.
+    uint64_t SendAppLimitedTimeUs;          // The app had nothing queued to send.
+
     // N.B. New fields must be appended to end
 
 } QUIC_STATISTICS_V2;
 
+//
+// A log-linear histogram of latencies, in microseconds. Bucket i counts the
+// values from QUIC_LATENCY_HISTOGRAM_BUCKET_LOW(i) up to (but excluding)
+// QUIC_LATENCY_HISTOGRAM_BUCKET_LOW(i + 1): values below 4 get their own
+// bucket and each power of two above that is split into 4 buckets.
+//
+#define QUIC_LATENCY_HISTOGRAM_BUCKET_COUNT 124
+#define QUIC_LATENCY_HISTOGRAM_BUCKET_LOW(i) \
+    ((i) < 4 ? (uint64_t)(i) : ((uint64_t)(4 + ((i) & 3)) << (((i) >> 2) - 1)))
+
+typedef struct QUIC_LATENCY_HISTOGRAM {
+    uint64_t Count;
+    uint64_t Sum;                       // Of all the values, for the mean.
+    uint64_t Max;
+    uint32_t Buckets[QUIC_LATENCY_HISTOGRAM_BUCKET_COUNT];
+} QUIC_LATENCY_HISTOGRAM;
+
+typedef struct QUIC_CONNECTION_LATENCY_HISTOGRAMS {
+    QUIC_LATENCY_HISTOGRAM Rtt;         // Every RTT sample.
+    QUIC_LATENCY_HISTOGRAM SendToAck;   // From StreamSend to the send being acknowledged.
+    QUIC_LATENCY_HISTOGRAM QueueDelay;  // The time the connection waited to be processed by its worker.
+} QUIC_CONNECTION_LATENCY_HISTOGRAMS;
+
+typedef enum QUIC_FLIGHT_RECORDER_EVENT_TYPE {
+    QUIC_FLIGHT_RECORDER_EVENT_CONNECTED,           // The handshake completed.
+    QUIC_FLIGHT_RECORDER_EVENT_HANDSHAKE_CONFIRMED,
+    QUIC_FLIGHT_RECORDER_EVENT_CLOSED_LOCALLY,      // Value: Error code (or QUIC_STATUS), Detail: 1 if closed by the app
+    QUIC_FLIGHT_RECORDER_EVENT_CLOSED_REMOTELY,     // Value: Error code, Detail: 1 if closed by the peer's app
+    QUIC_FLIGHT_RECORDER_EVENT_PACKET_LOST,         // Value: Packet number, Detail: QUIC_TRACE_PACKET_LOSS_REASON
+    QUIC_FLIGHT_RECORDER_EVENT_PROBE_TIMEOUT,       // Value: Probe count
+    QUIC_FLIGHT_RECORDER_EVENT_CONGESTION_WINDOW,   // Value: Congestion window after a congestion event, Detail: Packets in flight
+    QUIC_FLIGHT_RECORDER_EVENT_API_CALL,            // Value: QUIC_TRACE_API_TYPE
+} QUIC_FLIGHT_RECORDER_EVENT_TYPE;
+
+typedef struct QUIC_FLIGHT_RECORDER_EVENT {
+    uint64_t TimeUs;
+    uint64_t Value;
+    uint32_t Type;                      // QUIC_FLIGHT_RECORDER_EVENT_TYPE
+    uint32_t Detail;
+} QUIC_FLIGHT_RECORDER_EVENT;
+
 #define QUIC_STRUCT_SIZE_THRU_FIELD(Struct, Field) \
     (FIELD_OFFSET(Struct, Field) + sizeof(((Struct*)0)->Field))
 
 #define QUIC_STATISTICS_V2_SIZE_1   QUIC_STRUCT_SIZE_THRU_FIELD(QUIC_STATISTICS_V2, KeyUpdateCount)         // v2.0 final size
 #define QUIC_STATISTICS_V2_SIZE_2   QUIC_STRUCT_SIZE_THRU_FIELD(QUIC_STATISTICS_V2, DestCidUpdateCount)     // v2.1 final size
 #define QUIC_STATISTICS_V2_SIZE_3   QUIC_STRUCT_SIZE_THRU_FIELD(QUIC_STATISTICS_V2, SendEcnCongestionCount) // v2.2 final size
+#define QUIC_STATISTICS_V2_SIZE_4   QUIC_STRUCT_SIZE_THRU_FIELD(QUIC_STATISTICS_V2, SendCeMarkedPackets)    // v2.3 final size
+#define QUIC_STATISTICS_V2_SIZE_5   QUIC_STRUCT_SIZE_THRU_FIELD(QUIC_STATISTICS_V2, SendAppLimitedTimeUs)   // v2.4 final size
 
 typedef struct QUIC_LISTENER_STATISTICS {
 
@@ -575,6 +659,195 @@ typedef struct QUIC_LISTENER_STATISTICS {
 
 } QUIC_LISTENER_STATISTICS;
 
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+//
+// The server addresses a listener advertises to clients in the preferred
+// address transport parameter. Leave the family unspecified (0) for any
+// address that isn't used.
+//
+typedef struct QUIC_PREFERRED_ADDRESS {
+
+    QUIC_ADDR Ipv4Address;
+    QUIC_ADDR Ipv6Address;
+
+} QUIC_PREFERRED_ADDRESS;
+
+//
+// Maps a server name (SNI) to the configuration given to a listener's new
+// connections for it. A ServerName of "*.example.com" matches a single label
+// in its place, and a NULL ServerName is used when nothing else matches.
+//
+typedef struct QUIC_LISTENER_SNI_CONFIGURATION {
+
+    const char* ServerName;
+    HQUIC Configuration;
+
+} QUIC_LISTENER_SNI_CONFIGURATION;
+#endif
+
+//
+// Queue delay histogram buckets: <10us, <100us, <1ms, <10ms, <100ms, >=100ms.
+//
+#define QUIC_WORKER_QUEUE_DELAY_BUCKET_COUNT 6
+
+typedef struct QUIC_WORKER_STATISTICS {
+
+    HQUIC Registration;                 // The registration that owns the worker.
+    uint16_t PartitionIndex;
+    uint16_t IdealProcessor;
+    uint32_t ConnectionCount;           // Connections currently owned by the worker.
+    uint64_t TimerWheelConnectionCount; // Connections with a timer armed.
+    uint64_t BusyTimeUs;                // Time spent processing connections.
+    uint64_t IdleTimeUs;                // Remaining time since the worker was created.
+    uint64_t OperationsProcessed;       // Connection operations processed.
+    uint64_t SendFlushesCutShort;       // Send flushes stopped by the scheduling budget.
+    uint32_t AverageQueueDelayUs;
+    uint64_t QueueDelayHistogram[QUIC_WORKER_QUEUE_DELAY_BUCKET_COUNT];
+
+} QUIC_WORKER_STATISTICS;
+
+//
+// Statistics of a raw (XDP or DPDK) datapath queue, for sizing its rings and
+// buffers. Counters a datapath can't provide are zero.
+//
+typedef struct QUIC_DATAPATH_QUEUE_STATISTICS {
+
+    uint32_t InterfaceIndex;
+    uint32_t QueueId;                   // The queue's index on the interface.
+    uint64_t RxPackets;                 // Frames taken off the RX ring.
+    uint64_t TxPackets;                 // Frames posted to the TX ring.
+    uint64_t RxDropped;                 // Frames the kernel or driver dropped.
+    uint64_t RxRingFull;                // Frames dropped because the RX ring was full.
+    uint64_t RxFillRingEmpty;           // Times the kernel found no buffer in the fill ring.
+    uint64_t RxFillStarved;             // Times the fill ring couldn't be refilled for lack of free buffers.
+    uint64_t TxRingFull;                // Times the TX ring was full when there were frames to send.
+    uint64_t TxBufferExhausted;         // Send buffer allocations that failed for lack of a free buffer.
+    uint32_t RxRingUsed;                // The rings' current occupancy, in descriptors.
+    uint32_t RxFillRingUsed;
+    uint32_t TxRingUsed;
+    uint32_t TxCompletionRingUsed;
+    uint32_t RxRingSize;
+    uint32_t TxRingSize;
+
+} QUIC_DATAPATH_QUEUE_STATISTICS;
+
+typedef struct QUIC_MEMORY_USAGE {
+
+    uint64_t ConnectionBytes;           // Connection objects, excluding their paths.
+    uint64_t StreamBytes;               // Stream objects.
+    uint64_t SendBufferBytes;           // Stream data copied into send buffers.
+    uint64_t RecvBufferBytes;           // Stream receive buffers.
+    uint64_t SentPacketMetadataBytes;   // Tracking for packets in flight.
+    uint64_t TlsBytes;                  // Buffered handshake (TLS) data.
+    uint64_t PathBytes;                 // Path state, embedded in the connection objects.
+    uint64_t PacketSpaceBytes;          // Per encryption level packet number spaces.
+
+} QUIC_MEMORY_USAGE;
+
+#define QUIC_REGISTRATION_QOS_MAX_WEIGHT            64
+
+typedef struct QUIC_REGISTRATION_QOS {
+    uint32_t SchedulingWeight;                      // Relative share of shared worker time. 1 (default) - 64.
+    uint64_t MaxEgressRate;                         // Bytes per second sent by all connections. Zero disables.
+} QUIC_REGISTRATION_QOS;
+
+typedef enum QUIC_MEMORY_PRESSURE_LEVEL {
+    QUIC_MEMORY_PRESSURE_NONE,              // Below half of the memory budget.
+    QUIC_MEMORY_PRESSURE_ELEVATED,          // Stream flow control windows stop growing.
+    QUIC_MEMORY_PRESSURE_HIGH,              // Receive buffers stop growing and new connections must Retry.
+    QUIC_MEMORY_PRESSURE_CRITICAL,          // Budget exhausted. Peers get no new stream credit.
+} QUIC_MEMORY_PRESSURE_LEVEL;
+
+typedef
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Function_class_(QUIC_MEMORY_PRESSURE_CALLBACK)
+void
+(QUIC_API QUIC_MEMORY_PRESSURE_CALLBACK)(
+    _In_opt_ void* Context,
+    _In_ QUIC_MEMORY_PRESSURE_LEVEL Level
+    );
+
+typedef QUIC_MEMORY_PRESSURE_CALLBACK *QUIC_MEMORY_PRESSURE_CALLBACK_HANDLER;
+
+typedef struct QUIC_MEMORY_BUDGET {
+    uint64_t Limit;                                 // Bytes. Zero means no limit.
+    QUIC_MEMORY_PRESSURE_CALLBACK_HANDLER Handler;  // Optional. Called when the level changes.
+    void* Context;
+} QUIC_MEMORY_BUDGET;
+
+#define QUIC_LOAD_BALANCING_MAX_SERVER_ID_LENGTH    15
+#define QUIC_LOAD_BALANCING_MIN_NONCE_LENGTH        4
+#define QUIC_LOAD_BALANCING_KEY_LENGTH              16
+
+typedef struct QUIC_LOAD_BALANCING_CONFIG {
+    uint8_t ConfigId;                               // Config rotation bits. 0 - 6.
+    uint8_t ServerIdLength;                         // Bytes of ServerId to encode.
+    uint8_t NonceLength;                            // Random bytes following the server ID. At least 4.
+    BOOLEAN EncodeLength;                           // Self-encode the CID length in the first octet.
+    BOOLEAN Encrypt;                                // Encrypt server ID and nonce with Key (AES-128).
+    uint8_t ServerId[QUIC_LOAD_BALANCING_MAX_SERVER_ID_LENGTH];
+    uint8_t Key[QUIC_LOAD_BALANCING_KEY_LENGTH];
+} QUIC_LOAD_BALANCING_CONFIG;
+
+#define QUIC_SOURCE_RATE_LIMIT_MAX_RATE             1000000
+
+typedef struct QUIC_SOURCE_RATE_LIMIT {
+    uint32_t RetryRate;                             // New connections per second per source prefix before Retry. Zero disables.
+    uint32_t DropRate;                              // Initial packets per second per source prefix before dropping. Zero disables.
+    uint8_t Ipv4PrefixLength;                       // Bits of IPv4 source address identifying a source. 1 - 32.
+    uint8_t Ipv6PrefixLength;                       // Bits of IPv6 source address identifying a source. 1 - 128.
+} QUIC_SOURCE_RATE_LIMIT;
+
+#define QUIC_ZERO_RTT_ANTI_REPLAY_MAX_ENTRIES       16777216
+
+typedef struct QUIC_ZERO_RTT_ANTI_REPLAY {
+    uint32_t WindowMs;                              // How long ClientHellos are remembered. Zero disables.
+    uint32_t MaxEntries;                            // Expected resumed handshakes per window. 1 - 16M.
+} QUIC_ZERO_RTT_ANTI_REPLAY;
+
+//
+// Receives qlog (JSON text sequence) output. Called on MsQuic worker threads,
+// possibly in parallel, and each call contains only whole records.
+//
+typedef
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Function_class_(QUIC_QLOG_CALLBACK)
+void
+(QUIC_API QUIC_QLOG_CALLBACK)(
+    _In_opt_ void* Context,
+    _In_reads_bytes_(Length) const char* Data,
+    _In_ uint32_t Length
+    );
+
+typedef QUIC_QLOG_CALLBACK *QUIC_QLOG_CALLBACK_HANDLER;
+
+typedef struct QUIC_QLOG_HANDLER {
+    QUIC_QLOG_CALLBACK_HANDLER Handler;             // NULL stops qlog output.
+    void* Context;
+} QUIC_QLOG_HANDLER;
+
+//
+// Receives packet capture (pcapng) output. Called on MsQuic worker threads,
+// possibly in parallel, and each call contains only whole blocks.
+//
+typedef
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Function_class_(QUIC_PACKET_CAPTURE_CALLBACK)
+void
+(QUIC_API QUIC_PACKET_CAPTURE_CALLBACK)(
+    _In_opt_ void* Context,
+    _In_reads_bytes_(Length) const uint8_t* Data,
+    _In_ uint32_t Length
+    );
+
+typedef QUIC_PACKET_CAPTURE_CALLBACK *QUIC_PACKET_CAPTURE_CALLBACK_HANDLER;
+
+typedef struct QUIC_PACKET_CAPTURE_CONFIG {
+    QUIC_PACKET_CAPTURE_CALLBACK_HANDLER Handler;   // NULL stops capturing.
+    void* Context;
+    uint32_t SampleRate;                            // Capture 1 in SampleRate packets of all connections. 0 captures only connections with QUIC_PARAM_CONN_PACKET_CAPTURE_ENABLED.
+} QUIC_PACKET_CAPTURE_CONFIG;
+
 typedef enum QUIC_PERFORMANCE_COUNTERS {
     QUIC_PERF_COUNTER_CONN_CREATED,         // Total connections ever allocated.
     QUIC_PERF_COUNTER_CONN_HANDSHAKE_FAIL,  // Total connections that failed during handshake.
@@ -611,6 +884,66 @@ typedef enum QUIC_PERFORMANCE_COUNTERS {
     QUIC_PERF_COUNTER_MAX,
 } QUIC_PERFORMANCE_COUNTERS;
 
+typedef enum QUIC_PERF_HISTOGRAMS {
+    QUIC_PERF_HISTOGRAM_HANDSHAKE_TIME,     // From connection start until the handshake completes.
+    QUIC_PERF_HISTOGRAM_QUEUE_DELAY,        // Time connections waited to be processed by their worker.
+    QUIC_PERF_HISTOGRAM_RTT,                // Every RTT sample.
+    QUIC_PERF_HISTOGRAM_MAX,
+} QUIC_PERF_HISTOGRAMS;
+
+//
+// Layout of the buffer given to QUIC_PARAM_GLOBAL_PERF_EXPORT: a header
+// followed by ProcessorCount entries. MsQuic increments Sequence before and
+// after each update, so readers retry while it is odd or if it changed while
+// they were copying the entries.
+//
+#define QUIC_PERF_EXPORT_VERSION            1
+#define QUIC_PERF_EXPORT_MIN_INTERVAL_US    1000
+
+typedef struct QUIC_PERF_EXPORT_HEADER {
+    uint32_t Version;                               // QUIC_PERF_EXPORT_VERSION
+    uint32_t ProcessorCount;                        // Number of QUIC_PERF_EXPORT_PROCESSOR entries.
+    uint32_t CounterCount;                          // QUIC_PERF_COUNTER_MAX
+    uint32_t HistogramCount;                        // QUIC_PERF_HISTOGRAM_MAX
+    volatile int64_t Sequence;                      // Odd while an update is in progress.
+    uint64_t UpdateTimeUs;                          // Monotonic time of the last update.
+} QUIC_PERF_EXPORT_HEADER;
+
+typedef struct QUIC_PERF_EXPORT_PROCESSOR {
+    int64_t Counters[QUIC_PERF_COUNTER_MAX];        // Sum over all entries for the totals.
+    QUIC_LATENCY_HISTOGRAM Histograms[QUIC_PERF_HISTOGRAM_MAX];
+} QUIC_PERF_EXPORT_PROCESSOR;
+
+#define QUIC_PERF_EXPORT_SIZE(ProcessorCount) \
+    (sizeof(QUIC_PERF_EXPORT_HEADER) + (ProcessorCount) * sizeof(QUIC_PERF_EXPORT_PROCESSOR))
+
+typedef struct QUIC_PERF_EXPORT {
+    void* Buffer;                                   // 8 byte aligned. NULL stops the export.
+    uint32_t BufferLength;                          // At least QUIC_PERF_EXPORT_SIZE(1).
+    uint32_t IntervalUs;                            // At least QUIC_PERF_EXPORT_MIN_INTERVAL_US.
+} QUIC_PERF_EXPORT;
+
+//
+// Pipeline stages timed by builds with QUIC_STAGE_CYCLES defined. The stages
+// are measured inclusively, so some nest in others.
+//
+typedef enum QUIC_PERF_STAGES {
+    QUIC_PERF_STAGE_RECEIVE,                // The datapath's receive upcall, including DELIVER. Calls are datagrams.
+    QUIC_PERF_STAGE_DELIVER,                // Routing received datagrams to their connection. Calls are datagrams.
+    QUIC_PERF_STAGE_DECRYPT,                // Header protection removal and decryption. Calls are packets.
+    QUIC_PERF_STAGE_FRAMES,                 // Processing a decrypted packet's frames. Calls are packets.
+    QUIC_PERF_STAGE_STREAM_DELIVERY,        // Indicating received stream data to the app.
+    QUIC_PERF_STAGE_SEND,                   // Building and sending packets, including ENCRYPT and DATAPATH_SEND.
+    QUIC_PERF_STAGE_ENCRYPT,                // Encryption and header protection. Calls are packets.
+    QUIC_PERF_STAGE_DATAPATH_SEND,          // Handing datagrams to the datapath. Calls are datagrams.
+    QUIC_PERF_STAGE_MAX,
+} QUIC_PERF_STAGES;
+
+typedef struct QUIC_PERF_STAGE_CYCLES {
+    uint64_t Cycles;                        // CPU cycles (timer ticks on ARM64) spent in the stage.
+    uint64_t Calls;
+} QUIC_PERF_STAGE_CYCLES;
+
 #ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
 typedef struct QUIC_VERSION_SETTINGS {
 
@@ -631,12 +964,14 @@ typedef struct QUIC_GLOBAL_SETTINGS {
             uint64_t RetryMemoryLimit                       : 1;
             uint64_t LoadBalancingMode                      : 1;
             uint64_t FixedServerID                          : 1;
-            uint64_t RESERVED                               : 61;
+            uint64_t ConnectionPoolPrewarmCount             : 1;
+            uint64_t RESERVED                               : 60;
         } IsSet;
     };
     uint16_t RetryMemoryLimit;
     uint16_t LoadBalancingMode;
     uint32_t FixedServerID;
+    uint32_t ConnectionPoolPrewarmCount;
 } QUIC_GLOBAL_SETTINGS;
 
 typedef struct QUIC_SETTINGS {
@@ -688,7 +1023,14 @@ typedef struct QUIC_SETTINGS {
             uint64_t OneWayDelayEnabled                     : 1;
             uint64_t NetStatsEventEnabled                   : 1;
             uint64_t StreamMultiReceiveEnabled              : 1;
-            uint64_t RESERVED                               : 21;
+            uint64_t CarefulResumeEnabled                   : 1;
+            uint64_t NetStatsEventThreshold                 : 1;
+            uint64_t HibernateTimeoutMs                     : 1;
+            uint64_t ReleaseHandshakeStateEnabled           : 1;
+            uint64_t ResumptionTicketCacheEnabled           : 1;
+            uint64_t EarlyCreditWindow                      : 1;
+            uint64_t AdaptiveAckDelayEnabled                : 1;
+            uint64_t RESERVED                               : 14;
 #else
             uint64_t RESERVED                               : 26;
 #endif
@@ -739,7 +1081,11 @@ typedef struct QUIC_SETTINGS {
             uint64_t OneWayDelayEnabled        : 1;
             uint64_t NetStatsEventEnabled      : 1;
             uint64_t StreamMultiReceiveEnabled : 1;
-            uint64_t ReservedFlags             : 58;
+            uint64_t CarefulResumeEnabled      : 1;
+            uint64_t ReleaseHandshakeStateEnabled : 1;
+            uint64_t ResumptionTicketCacheEnabled : 1;
+            uint64_t AdaptiveAckDelayEnabled   : 1;
+            uint64_t ReservedFlags             : 54;
 #else
             uint64_t ReservedFlags             : 63;
 #endif
@@ -748,6 +1094,11 @@ typedef struct QUIC_SETTINGS {
     uint32_t StreamRecvWindowBidiLocalDefault;
     uint32_t StreamRecvWindowBidiRemoteDefault;
     uint32_t StreamRecvWindowUnidiDefault;
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+    uint8_t NetStatsEventThreshold;         // Percent. 0 indicates the event on every ACK.
+    uint32_t HibernateTimeoutMs;            // 0 disables hibernation.
+    uint32_t EarlyCreditWindow;             // Bytes. Server only. 0 disables.
+#endif
 
 } QUIC_SETTINGS;
 
@@ -786,6 +1137,254 @@ typedef struct QUIC_STREAM_STATISTICS {
     uint64_t StreamBlockedByAppUs;
 } QUIC_STREAM_STATISTICS;
 
+#define QUIC_STREAM_PRIORITY_URGENCY_MAX        7
+#define QUIC_STREAM_PRIORITY_URGENCY_DEFAULT    3
+
+typedef struct QUIC_STREAM_PRIORITY_PARAMETERS {
+    uint8_t Urgency;        // 0 (highest) to 7 (lowest) - 3 (default)
+    BOOLEAN Incremental;    // Interleave data with other incremental streams of the same urgency.
+} QUIC_STREAM_PRIORITY_PARAMETERS;
+
+#define QUIC_STREAM_GROUP_MAX                   64
+
+typedef enum QUIC_STREAM_GROUP_SCHEME {
+    QUIC_STREAM_GROUP_SCHEME_SEQUENTIAL     = 0,    // Member streams are sent to completion one at a time. (Default)
+    QUIC_STREAM_GROUP_SCHEME_INTERLEAVED    = 1,    // Member streams take turns.
+} QUIC_STREAM_GROUP_SCHEME;
+
+//
+// The scheduling parameters of a group of streams, set via
+// QUIC_PARAM_CONN_STREAM_GROUP. Streams join a group via QUIC_PARAM_STREAM_GROUP
+// and then inherit these in place of their own.
+//
+typedef struct QUIC_STREAM_GROUP_PARAMETERS {
+    uint16_t GroupId;                   // 1 to QUIC_STREAM_GROUP_MAX
+    uint16_t Priority;                  // As QUIC_PARAM_STREAM_PRIORITY
+    uint8_t Weight;                     // Weighted fair share, 0 (lowest) to 255
+    uint8_t Urgency;                    // As QUIC_STREAM_PRIORITY_PARAMETERS
+    QUIC_STREAM_GROUP_SCHEME Scheme;
+} QUIC_STREAM_GROUP_PARAMETERS;
+
+//
+// Binds a datagram context to a UDP target, set via
+// QUIC_PARAM_CONN_DATAGRAM_UDP_RELAY. Received datagrams that start with the
+// given Quarter Stream ID and Context ID (RFC 9297 and RFC 9298) have them
+// stripped and are sent to the target, and UDP payloads from the target are
+// sent back with them prefixed, all without indicating them to the app. An
+// unspecified RemoteAddress removes the binding.
+//
+typedef struct QUIC_DATAGRAM_UDP_RELAY {
+    uint64_t QuarterStreamId;
+    uint64_t ContextId;                 // Zero for plain UDP payloads
+    QUIC_ADDR RemoteAddress;
+} QUIC_DATAGRAM_UDP_RELAY;
+
+//
+// Forward error correction for datagrams, set via QUIC_PARAM_CONN_DATAGRAM_FEC
+// before the connection starts, and only used if the peer enables it too.
+// After every block of sent datagrams, a repair datagram (the XOR of the
+// block) is sent, from which the peer can recover any one datagram of the
+// block that was lost. The block size adapts to the measured loss rate,
+// between MinBlockSize (the most redundancy) and MaxBlockSize. Zero for both
+// disables FEC.
+//
+#define QUIC_DATAGRAM_FEC_MAX_BLOCK_SIZE    32
+
+typedef struct QUIC_DATAGRAM_FEC_CONFIG {
+    uint8_t MinBlockSize;               // 2 to MaxBlockSize
+    uint8_t MaxBlockSize;               // MinBlockSize to QUIC_DATAGRAM_FEC_MAX_BLOCK_SIZE
+} QUIC_DATAGRAM_FEC_CONFIG;
+
+//
+// Limits how long datagrams may wait in the send queue, set via
+// QUIC_PARAM_CONN_DATAGRAM_SEND_POLICY. The limit is counted from the
+// DatagramSend call. A datagram still queued when its limit has passed is
+// dropped before it is framed and indicated as QUIC_DATAGRAM_SEND_CANCELED.
+// Zero means no limit.
+//
+typedef struct QUIC_DATAGRAM_SEND_POLICY {
+    uint32_t MaxQueueDelayUs;           // Datagrams sent without QUIC_SEND_FLAG_DGRAM_PRIORITY
+    uint32_t PriorityMaxQueueDelayUs;   // Datagrams sent with QUIC_SEND_FLAG_DGRAM_PRIORITY
+} QUIC_DATAGRAM_SEND_POLICY;
+
+//
+// Standby paths for client failover, set via QUIC_PARAM_CONN_STANDBY_PATHS.
+// Once the handshake is confirmed, the client validates a path from each of
+// the local addresses (e.g. a cellular interface's, while on Wi-Fi) and keeps
+// probing it while the connection is in use. If the active path then goes
+// quiet, the connection moves to the best standby path straight away.
+//
+#define QUIC_MAX_STANDBY_PATHS              2
+
+typedef struct QUIC_STANDBY_PATHS {
+    uint32_t ProbeIntervalMs;           // 0 uses the default (1000 ms)
+    uint32_t LocalAddressCount;         // 0 removes all standby paths
+    QUIC_ADDR LocalAddresses[QUIC_MAX_STANDBY_PATHS];
+} QUIC_STANDBY_PATHS;
+
+//
+// Stream data compression, set via QUIC_PARAM_CONN_STREAM_COMPRESSION before
+// the connection starts, and only used if the peer sets the same CodecId.
+// The data sent on streams opened (or accepted) with
+// QUIC_STREAM_OPEN_FLAG_COMPRESSED is then split into blocks of up to
+// QUIC_STREAM_COMPRESSION_MAX_BLOCK bytes, each compressed by the app's codec
+// (e.g. zstd with a dictionary both apps share, identified by CodecId), and
+// decompressed again before being indicated to the peer app.
+//
+// The callbacks are invoked inline on the connection's worker thread, possibly
+// at DISPATCH_LEVEL, and must not block or call any MsQuic API.
+//
+#define QUIC_STREAM_COMPRESSION_MAX_BLOCK   16383
+
+//
+// Compresses InputLength bytes into Output, which has room for *OutputLength
+// bytes, and updates *OutputLength. On failure (e.g. the data doesn't fit) the
+// block is sent uncompressed.
+//
+typedef
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+(QUIC_API * QUIC_STREAM_COMPRESS_FN)(
+    _In_opt_ void* Context,
+    _In_reads_bytes_(InputLength) const uint8_t* Input,
+    _In_ uint32_t InputLength,
+    _Out_writes_bytes_to_(*OutputLength, *OutputLength) uint8_t* Output,
+    _Inout_ uint32_t* OutputLength
+    );
+
+//
+// Decompresses InputLength bytes into exactly OutputLength bytes of Output.
+// Fails on corrupt input, which closes the connection.
+//
+typedef
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+(QUIC_API * QUIC_STREAM_DECOMPRESS_FN)(
+    _In_opt_ void* Context,
+    _In_reads_bytes_(InputLength) const uint8_t* Input,
+    _In_ uint32_t InputLength,
+    _Out_writes_bytes_(OutputLength) uint8_t* Output,
+    _In_ uint32_t OutputLength
+    );
+
+typedef struct QUIC_STREAM_COMPRESSION_CONFIG {
+    uint32_t CodecId;                   // Must match the peer's. 0 disables compression.
+    void* Context;
+    QUIC_STREAM_COMPRESS_FN Compress;
+    QUIC_STREAM_DECOMPRESS_FN Decompress;
+} QUIC_STREAM_COMPRESSION_CONFIG;
+
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+//
+// Application provided congestion control, set on a connection before start
+// via QUIC_PARAM_CONN_CUSTOM_CONGESTION_CONTROL.
+//
+// The callbacks are invoked inline on the connection's worker thread, possibly
+// at DISPATCH_LEVEL, and must not block or call any MsQuic API. MsQuic keeps
+// track of the bytes in flight; the callbacks that may change the congestion
+// window return its new value, in bytes.
+//
+
+typedef struct QUIC_CUSTOM_CC_ACK_EVENT {
+    uint64_t TimeNow;                   // Microseconds
+    uint64_t LargestAck;                // Packet number
+    uint64_t LargestSentPacketNumber;
+    uint64_t SmoothedRtt;               // Microseconds
+    uint64_t MinRtt;                    // Microseconds. Only valid if MinRttValid.
+    uint32_t NumRetransmittableBytes;   // Newly acknowledged
+    uint32_t BytesInFlight;             // After this acknowledgement
+    BOOLEAN IsImplicit;
+    BOOLEAN HasLoss;
+    BOOLEAN IsLargestAckedPacketAppLimited;
+    BOOLEAN MinRttValid;
+} QUIC_CUSTOM_CC_ACK_EVENT;
+
+typedef struct QUIC_CUSTOM_CC_LOSS_EVENT {
+    uint64_t LargestPacketNumberLost;
+    uint64_t LargestSentPacketNumber;
+    uint32_t NumRetransmittableBytes;   // Newly lost
+    uint32_t BytesInFlight;             // After this loss
+    BOOLEAN PersistentCongestion;
+} QUIC_CUSTOM_CC_LOSS_EVENT;
+
+typedef struct QUIC_CUSTOM_CC_ECN_EVENT {
+    uint64_t LargestPacketNumberAcked;
+    uint64_t LargestSentPacketNumber;
+    uint64_t NewCeCount;                // Packets newly reported as CE marked
+} QUIC_CUSTOM_CC_ECN_EVENT;
+
+//
+// Called when the connection is initialized and whenever the congestion state
+// must start over (e.g. on a new path). Returns the initial congestion window.
+//
+typedef
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+(QUIC_API * QUIC_CUSTOM_CC_RESET_FN)(
+    _In_opt_ void* Context,
+    _In_ BOOLEAN FullReset,
+    _In_ uint16_t DatagramPayloadLength
+    );
+
+typedef
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+(QUIC_API * QUIC_CUSTOM_CC_ON_DATA_SENT_FN)(
+    _In_opt_ void* Context,
+    _In_ uint32_t NumRetransmittableBytes,
+    _In_ uint32_t BytesInFlight
+    );
+
+typedef
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+(QUIC_API * QUIC_CUSTOM_CC_ON_DATA_ACKNOWLEDGED_FN)(
+    _In_opt_ void* Context,
+    _In_ const QUIC_CUSTOM_CC_ACK_EVENT* AckEvent
+    );
+
+typedef
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+(QUIC_API * QUIC_CUSTOM_CC_ON_DATA_LOST_FN)(
+    _In_opt_ void* Context,
+    _In_ const QUIC_CUSTOM_CC_LOSS_EVENT* LossEvent
+    );
+
+typedef
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+(QUIC_API * QUIC_CUSTOM_CC_ON_ECN_FN)(
+    _In_opt_ void* Context,
+    _In_ const QUIC_CUSTOM_CC_ECN_EVENT* EcnEvent
+    );
+
+//
+// Returns the number of bytes that may be sent now. Only called when the
+// congestion window isn't full; the result is capped to the free window.
+//
+typedef
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+(QUIC_API * QUIC_CUSTOM_CC_GET_SEND_ALLOWANCE_FN)(
+    _In_opt_ void* Context,
+    _In_ uint64_t TimeSinceLastSendUs,
+    _In_ BOOLEAN TimeSinceLastSendValid,
+    _In_ uint32_t BytesInFlight
+    );
+
+typedef struct QUIC_CUSTOM_CONGESTION_CONTROL {
+    const char* Name;                                       // Optional. Used for logging.
+    void* Context;
+    QUIC_CUSTOM_CC_RESET_FN Reset;
+    QUIC_CUSTOM_CC_ON_DATA_SENT_FN OnDataSent;              // Optional
+    QUIC_CUSTOM_CC_ON_DATA_ACKNOWLEDGED_FN OnDataAcknowledged;
+    QUIC_CUSTOM_CC_ON_DATA_LOST_FN OnDataLost;
+    QUIC_CUSTOM_CC_ON_ECN_FN OnEcn;                         // Optional. CE marks are ignored if NULL.
+    QUIC_CUSTOM_CC_GET_SEND_ALLOWANCE_FN GetSendAllowance;  // Optional. No pacing if NULL.
+} QUIC_CUSTOM_CONGESTION_CONTROL;
+#endif
+
 //
 // Functions for associating application contexts with QUIC handles. MsQuic
 // provides no explicit synchronization between parallel calls to these
@@ -857,9 +1456,27 @@ void
 #endif
 #define QUIC_PARAM_GLOBAL_TLS_PROVIDER                  0x0100000A  // QUIC_TLS_PROVIDER
 #define QUIC_PARAM_GLOBAL_STATELESS_RESET_KEY           0x0100000B  // uint8_t[] - Array size is QUIC_STATELESS_RESET_KEY_LENGTH
+#define QUIC_PARAM_GLOBAL_SEND_BUFFER_LIMIT             0x0100000C  // uint64_t - bytes - 0 (no limit, default)
+#define QUIC_PARAM_GLOBAL_MTU_PROBE_SIZES               0x0100000D  // uint16_t[] - Up to 8, in increasing order
+#define QUIC_PARAM_GLOBAL_WORKER_STATISTICS             0x0100000E  // QUIC_WORKER_STATISTICS[]
+#define QUIC_PARAM_GLOBAL_MEMORY_BUDGET                 0x0100000F  // QUIC_MEMORY_BUDGET
+#define QUIC_PARAM_GLOBAL_MEMORY_PRESSURE               0x01000010  // QUIC_MEMORY_PRESSURE_LEVEL
+#define QUIC_PARAM_GLOBAL_LOAD_BALANCING_CONFIG         0x01000011  // QUIC_LOAD_BALANCING_CONFIG
+#define QUIC_PARAM_GLOBAL_SOURCE_RATE_LIMIT             0x01000012  // QUIC_SOURCE_RATE_LIMIT
+#define QUIC_PARAM_GLOBAL_QLOG_HANDLER                  0x01000013  // QUIC_QLOG_HANDLER
+#define QUIC_PARAM_GLOBAL_PERF_EXPORT                   0x01000014  // QUIC_PERF_EXPORT
+#define QUIC_PARAM_GLOBAL_PERF_STAGE_CYCLES             0x01000015  // QUIC_PERF_STAGE_CYCLES[QUIC_PERF_STAGE_MAX]
+#define QUIC_PARAM_GLOBAL_PACKET_CAPTURE                0x01000016  // QUIC_PACKET_CAPTURE_CONFIG
+#define QUIC_PARAM_GLOBAL_DATAPATH_STATISTICS           0x01000017  // QUIC_DATAPATH_QUEUE_STATISTICS[]
+#define QUIC_PARAM_GLOBAL_ZERO_RTT_ANTI_REPLAY          0x01000018  // QUIC_ZERO_RTT_ANTI_REPLAY
+#define QUIC_PARAM_GLOBAL_TIMER_SLACK                   0x01000019  // uint32_t - milliseconds
 //
 // Parameters for Registration.
 //
+#define QUIC_PARAM_REGISTRATION_SEND_BUFFER_USAGE       0x02000000  // uint64_t - bytes
+#define QUIC_PARAM_REGISTRATION_MEMORY_USAGE            0x02000001  // QUIC_MEMORY_USAGE
+#define QUIC_PARAM_REGISTRATION_EVENT_QUEUE_ENABLED     0x02000002  // uint8_t (BOOLEAN)
+#define QUIC_PARAM_REGISTRATION_QOS                     0x02000003  // QUIC_REGISTRATION_QOS
 
 //
 // Parameters for Configuration.
@@ -884,6 +1501,10 @@ typedef struct QUIC_SCHANNEL_CREDENTIAL_ATTRIBUTE_W {
 #define QUIC_PARAM_LISTENER_STATS                       0x04000001  // QUIC_LISTENER_STATISTICS
 #ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
 #define QUIC_PARAM_LISTENER_CIBIR_ID                    0x04000002  // uint8_t[] {offset, id[]}
+#define QUIC_PARAM_LISTENER_PREFERRED_ADDRESS           0x04000003  // QUIC_PREFERRED_ADDRESS
+#define QUIC_PARAM_LISTENER_DRAIN                       0x04000004  // uint8_t (BOOLEAN)
+#define QUIC_PARAM_LISTENER_PARTITIONED                 0x04000005  // uint8_t (BOOLEAN)
+#define QUIC_PARAM_LISTENER_SNI_CONFIGURATIONS          0x04000006  // QUIC_LISTENER_SNI_CONFIGURATION[]
 #endif
 
 //
@@ -918,6 +1539,27 @@ typedef struct QUIC_SCHANNEL_CREDENTIAL_ATTRIBUTE_W {
 #define QUIC_PARAM_CONN_STATISTICS_V2                   0x05000016  // QUIC_STATISTICS_V2
 #define QUIC_PARAM_CONN_STATISTICS_V2_PLAT              0x05000017  // QUIC_STATISTICS_V2
 #define QUIC_PARAM_CONN_ORIG_DEST_CID                   0x05000018  // uint8_t[]
+#define QUIC_PARAM_CONN_SEND_MEMORY_REGION              0x05000019  // QUIC_BUFFER
+#define QUIC_PARAM_CONN_DATAGRAM_BATCH_RECEIVE_ENABLED  0x0500001A  // uint8_t (BOOLEAN)
+#define QUIC_PARAM_CONN_SEND_FLUSH_BUDGET               0x0500001B  // uint32_t - microseconds
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+#define QUIC_PARAM_CONN_CUSTOM_CONGESTION_CONTROL       0x0500001C  // QUIC_CUSTOM_CONGESTION_CONTROL
+#endif
+#define QUIC_PARAM_CONN_MEMORY_USAGE                    0x0500001D  // QUIC_MEMORY_USAGE
+#define QUIC_PARAM_CONN_SEND_COALESCING_DELAY           0x0500001E  // uint32_t - microseconds
+#define QUIC_PARAM_CONN_STREAM_BATCH_RECEIVE_ENABLED    0x0500001F  // uint8_t (BOOLEAN)
+#define QUIC_PARAM_CONN_STREAM_GROUP                    0x05000020  // QUIC_STREAM_GROUP_PARAMETERS
+#define QUIC_PARAM_CONN_LATENCY_HISTOGRAMS_ENABLED      0x05000021  // uint8_t (BOOLEAN)
+#define QUIC_PARAM_CONN_LATENCY_HISTOGRAMS              0x05000022  // QUIC_CONNECTION_LATENCY_HISTOGRAMS
+#define QUIC_PARAM_CONN_QLOG_ENABLED                    0x05000023  // uint8_t (BOOLEAN)
+#define QUIC_PARAM_CONN_FLIGHT_RECORDER                 0x05000024  // QUIC_FLIGHT_RECORDER_EVENT[]
+#define QUIC_PARAM_CONN_PACKET_CAPTURE_ENABLED          0x05000025  // uint8_t (BOOLEAN)
+#define QUIC_PARAM_CONN_DATAGRAM_UDP_RELAY              0x05000026  // QUIC_DATAGRAM_UDP_RELAY (set only)
+#define QUIC_PARAM_CONN_ADDRESS_RACE_DELAY              0x05000027  // uint32_t - milliseconds
+#define QUIC_PARAM_CONN_DATAGRAM_FEC                    0x05000028  // QUIC_DATAGRAM_FEC_CONFIG
+#define QUIC_PARAM_CONN_STANDBY_PATHS                   0x05000029  // QUIC_STANDBY_PATHS
+#define QUIC_PARAM_CONN_STREAM_COMPRESSION              0x0500002A  // QUIC_STREAM_COMPRESSION_CONFIG
+#define QUIC_PARAM_CONN_DATAGRAM_SEND_POLICY            0x0500002B  // QUIC_DATAGRAM_SEND_POLICY
 
 //
 // Parameters for TLS.
@@ -951,6 +1593,8 @@ typedef struct QUIC_SCHANNEL_CONTEXT_ATTRIBUTE_EX_W {
 #ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
 #define QUIC_PARAM_STREAM_RELIABLE_OFFSET               0x08000005  // uint64_t
 #endif
+#define QUIC_PARAM_STREAM_PRIORITY_PARAMETERS           0x08000006  // QUIC_STREAM_PRIORITY_PARAMETERS
+#define QUIC_PARAM_STREAM_GROUP                         0x08000007  // uint16_t - 0 (none) or group ID
 
 typedef
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -1154,6 +1798,24 @@ void
 // Connections
 //
 
+//
+// A single stream's receive indication within a
+// QUIC_CONNECTION_EVENT_STREAM_BATCH_RECEIVED event. The fields match those of
+// QUIC_STREAM_EVENT_RECEIVE, with Status taking the place of the callback's
+// return value.
+//
+typedef struct QUIC_STREAM_RECEIVE_BATCH_ENTRY {
+    /* in */    HQUIC Stream;
+    /* in */    void* StreamContext;
+    /* in */    uint64_t AbsoluteOffset;
+    /* inout */ uint64_t TotalBufferLength;
+    _Field_size_(BufferCount)
+    /* in */    const QUIC_BUFFER* Buffers;
+    /* in */    uint32_t BufferCount;
+    /* in */    QUIC_RECEIVE_FLAGS Flags;
+    /* out */   QUIC_STATUS Status;         // Defaults to QUIC_STATUS_SUCCESS.
+} QUIC_STREAM_RECEIVE_BATCH_ENTRY;
+
 typedef enum QUIC_CONNECTION_EVENT_TYPE {
     QUIC_CONNECTION_EVENT_CONNECTED                         = 0,
     QUIC_CONNECTION_EVENT_SHUTDOWN_INITIATED_BY_TRANSPORT   = 1,    // The transport started the shutdown process.
@@ -1176,6 +1838,8 @@ typedef enum QUIC_CONNECTION_EVENT_TYPE {
     QUIC_CONNECTION_EVENT_ONE_WAY_DELAY_NEGOTIATED          = 17,   // Only indicated if QUIC_SETTINGS.OneWayDelayEnabled is TRUE.
     QUIC_CONNECTION_EVENT_NETWORK_STATISTICS                = 18,   // Only indicated if QUIC_SETTINGS.EnableNetStatsEvent is TRUE.
 #endif
+    QUIC_CONNECTION_EVENT_DATAGRAM_BATCH_RECEIVED           = 19,   // Only indicated if QUIC_PARAM_CONN_DATAGRAM_BATCH_RECEIVE_ENABLED is TRUE.
+    QUIC_CONNECTION_EVENT_STREAM_BATCH_RECEIVED             = 20,   // Only indicated if QUIC_PARAM_CONN_STREAM_BATCH_RECEIVE_ENABLED is TRUE.
 } QUIC_CONNECTION_EVENT_TYPE;
 
 typedef struct QUIC_CONNECTION_EVENT {
@@ -1236,6 +1900,7 @@ typedef struct QUIC_CONNECTION_EVENT {
         struct {
             uint16_t ResumptionStateLength;
             const uint8_t* ResumptionState;
+            const uint8_t* ClientRandom;    // 32 bytes. For 0-RTT replay checks shared across servers.
         } RESUMED;
         struct {
             _Field_range_(>, 0)
@@ -1266,6 +1931,20 @@ typedef struct QUIC_CONNECTION_EVENT {
            uint64_t Bandwidth;                  // Estimated bandwidth
         } NETWORK_STATISTICS;
 #endif
+        struct {
+            _Field_range_(>, 0)
+            uint32_t DatagramCount;
+            _Field_size_(DatagramCount)
+            const QUIC_BUFFER* Datagrams;
+            _Field_size_(DatagramCount)
+            const QUIC_RECEIVE_FLAGS* Flags;
+        } DATAGRAM_BATCH_RECEIVED;
+        struct {
+            _Field_range_(>, 0)
+            uint32_t StreamCount;
+            _Field_size_(StreamCount)
+            QUIC_STREAM_RECEIVE_BATCH_ENTRY* Streams;
+        } STREAM_BATCH_RECEIVED;
     };
 } QUIC_CONNECTION_EVENT;
 
@@ -1547,6 +2226,39 @@ void
     _In_ uint64_t BufferLength
     );
 
+//
+// Completes previously pended receives on multiple streams of the same
+// connection with a single call.
+//
+typedef
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+(QUIC_API * QUIC_STREAM_RECEIVE_COMPLETE_BATCH_FN)(
+    _In_ _Pre_defensive_ HQUIC Connection,
+    _In_reads_(StreamCount) _Pre_defensive_
+        const HQUIC* Streams,
+    _In_reads_(StreamCount)
+        const uint64_t* BufferLengths,
+    _In_ uint32_t StreamCount
+    );
+
+//
+// Copies the stream's available data (up to the size of the buffers) directly
+// into the app's buffers, instead of indicating it in a receive event. Only
+// allowed while receive callbacks are disabled, in the default receive mode.
+//
+typedef
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+(QUIC_API * QUIC_STREAM_RECEIVE_FN)(
+    _In_ _Pre_defensive_ HQUIC Stream,
+    _In_reads_(BufferCount) _Pre_defensive_
+        const QUIC_BUFFER* Buffers,
+    _In_ uint32_t BufferCount,
+    _Out_ _Pre_defensive_ uint64_t* BytesReceived,
+    _Out_opt_ QUIC_RECEIVE_FLAGS* Flags
+    );
+
 //
 // Enables or disables stream receive callbacks.
 //
@@ -1558,6 +2270,22 @@ QUIC_STATUS
     _In_ BOOLEAN IsEnabled
     );
 
+//
+// Provides buffers for receiving stream data. Only valid for streams opened
+// or accepted with QUIC_STREAM_OPEN_FLAG_APP_OWNED_BUFFERS. The buffers are
+// filled in order and indicated back in QUIC_STREAM_EVENT_RECEIVE. The app
+// must keep them valid until all their data has been received and completed.
+//
+typedef
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+(QUIC_API * QUIC_STREAM_PROVIDE_RECEIVE_BUFFERS_FN)(
+    _In_ _Pre_defensive_ HQUIC Stream,
+    _In_ uint32_t BufferCount,
+    _In_reads_(BufferCount) _Pre_defensive_
+        const QUIC_BUFFER* Buffers
+    );
+
 //
 // Datagrams
 //
@@ -1578,6 +2306,153 @@ QUIC_STATUS
     _In_opt_ void* ClientSendContext
     );
 
+//
+// Sends multiple unreliable datagrams on the connection, one per buffer, with
+// a single call. Each buffer must fit in a single QUIC packet. Each datagram
+// gets its own send state change events, with the matching client context.
+//
+typedef
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+(QUIC_API * QUIC_DATAGRAM_SEND_BATCH_FN)(
+    _In_ _Pre_defensive_ HQUIC Connection,
+    _In_reads_(DatagramCount) _Pre_defensive_
+        const QUIC_BUFFER* const Datagrams,
+    _In_ uint32_t DatagramCount,
+    _In_ QUIC_SEND_FLAGS Flags,
+    _In_reads_opt_(DatagramCount)
+        void* const* ClientSendContexts
+    );
+
+//
+// A single stream to open, start and send initial data on as part of a
+// StreamOpenAndSend call.
+//
+typedef struct QUIC_STREAM_OPEN_SEND_REQUEST {
+    QUIC_STREAM_OPEN_FLAGS OpenFlags;
+    QUIC_STREAM_START_FLAGS StartFlags;
+    QUIC_STREAM_CALLBACK_HANDLER Handler;
+    void* Context;
+    _Field_size_(BufferCount)
+    const QUIC_BUFFER* Buffers;
+    uint32_t BufferCount;
+    QUIC_SEND_FLAGS SendFlags;          // QUIC_SEND_FLAG_START is ignored.
+    void* ClientSendContext;
+    HQUIC Stream;                       // Output. Closed by the app as usual.
+} QUIC_STREAM_OPEN_SEND_REQUEST;
+
+//
+// Opens, starts and queues the initial send (usually with FIN) for multiple
+// streams on the connection, with a single call and a single worker
+// operation. Either all the streams are opened, or none are.
+//
+typedef
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+(QUIC_API * QUIC_STREAM_OPEN_AND_SEND_FN)(
+    _In_ _Pre_defensive_ HQUIC Connection,
+    _Inout_updates_(RequestCount) _Pre_defensive_
+        QUIC_STREAM_OPEN_SEND_REQUEST* Requests,
+    _In_ uint32_t RequestCount
+    );
+
+typedef enum QUIC_QUEUED_EVENT_TYPE {
+    QUIC_QUEUED_EVENT_TYPE_CONNECTION   = 0,
+    QUIC_QUEUED_EVENT_TYPE_STREAM       = 1,
+} QUIC_QUEUED_EVENT_TYPE;
+
+//
+// A connection or stream event dequeued from a registration's event queue,
+// along with the handle and context it would have been indicated to.
+//
+typedef struct QUIC_QUEUED_EVENT {
+    QUIC_QUEUED_EVENT_TYPE Type;
+    HQUIC Handle;
+    void* Context;
+    union {
+        QUIC_CONNECTION_EVENT CONNECTION;
+        QUIC_STREAM_EVENT STREAM;
+    };
+    QUIC_BUFFER ReceiveBuffers[3];      // Backs STREAM.RECEIVE.Buffers.
+} QUIC_QUEUED_EVENT;
+
+//
+// Dequeues up to EventCount events from the registration's event queue (see
+// QUIC_PARAM_REGISTRATION_EVENT_QUEUE_ENABLED), waiting up to TimeoutMs for
+// at least one (zero to just poll, UINT32_MAX to wait forever). Returns the
+// number of events dequeued.
+//
+typedef
+_IRQL_requires_max_(PASSIVE_LEVEL)
+uint32_t
+(QUIC_API * QUIC_REGISTRATION_POLL_EVENTS_FN)(
+    _In_ _Pre_defensive_ HQUIC Registration,
+    _Out_writes_to_(EventCount, return) _Pre_defensive_
+        QUIC_QUEUED_EVENT* Events,
+    _In_ uint32_t EventCount,
+    _In_ uint32_t TimeoutMs
+    );
+
+typedef struct QUIC_STREAM_SEND_BATCH_REQUEST {
+    _Field_size_(BufferCount)
+    const QUIC_BUFFER* Buffers;         // Must stay valid until the send completes.
+    uint32_t BufferCount;
+} QUIC_STREAM_SEND_BATCH_REQUEST;
+
+//
+// Queues multiple send requests on a stream with a single call. The requests
+// are sent in order and complete together, with a single
+// QUIC_STREAM_EVENT_SEND_COMPLETE for ClientSendContext. QUIC_SEND_FLAG_START
+// applies to the first request and QUIC_SEND_FLAG_FIN to the last one. The
+// Requests array itself may be freed once the call returns.
+//
+typedef
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+(QUIC_API * QUIC_STREAM_SEND_BATCH_FN)(
+    _In_ _Pre_defensive_ HQUIC Stream,
+    _In_reads_(RequestCount) _Pre_defensive_
+        const QUIC_STREAM_SEND_BATCH_REQUEST* Requests,
+    _In_ uint32_t RequestCount,
+    _In_ QUIC_SEND_FLAGS Flags,
+    _In_opt_ void* ClientSendContext
+    );
+
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+//
+// With QUIC_EXECUTION_CONFIG_FLAG_EXTERNAL, MsQuic doesn't create any threads
+// for its execution contexts (one per processor in the execution config).
+// Instead, the app drives each of them from its own threads, and all MsQuic
+// callbacks for it run inline on that thread.
+//
+
+//
+// Gets the OS event queue of the execution context, for the app to wait on in
+// its own event loop. ExecutionPoll must be called when it is signaled.
+//
+typedef
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+(QUIC_API * QUIC_EXECUTION_GET_EVENTQ_FN)(
+    _In_ uint16_t Index, // Into the execution config processor array
+    _Out_ QUIC_EVENTQ* EventQ
+    );
+
+//
+// Processes the execution context's pending events, waiting up to WaitTimeMs
+// for some, and runs all its due work and timers. Returns the time (in ms)
+// until it must be called again, even without any new events, or UINT32_MAX
+// if only on new events.
+//
+typedef
+_IRQL_requires_max_(PASSIVE_LEVEL)
+uint32_t
+(QUIC_API * QUIC_EXECUTION_POLL_FN)(
+    _In_ uint16_t Index, // Into the execution config processor array
+    _In_ uint32_t WaitTimeMs
+    );
+#endif
+
 //
 // Version 2 API Function Table. Returned from MsQuicOpenVersion when Version
 // is 2. Also returned from MsQuicOpen2.
@@ -1626,6 +2501,22 @@ typedef struct QUIC_API_TABLE {
     QUIC_CONNECTION_COMP_RESUMPTION_FN  ConnectionResumptionTicketValidationComplete; // Available from v2.2
     QUIC_CONNECTION_COMP_CERT_FN        ConnectionCertificateValidationComplete;      // Available from v2.2
 
+    QUIC_STREAM_PROVIDE_RECEIVE_BUFFERS_FN
+                                        StreamProvideReceiveBuffers;                  // Available from v2.5
+
+    QUIC_DATAGRAM_SEND_BATCH_FN         DatagramSendBatch;                            // Available from v2.5
+    QUIC_STREAM_OPEN_AND_SEND_FN        StreamOpenAndSend;                            // Available from v2.5
+    QUIC_STREAM_RECEIVE_COMPLETE_BATCH_FN
+                                        StreamReceiveCompleteBatch;                   // Available from v2.5
+    QUIC_STREAM_RECEIVE_FN              StreamReceive;                                // Available from v2.5
+    QUIC_REGISTRATION_POLL_EVENTS_FN    RegistrationPollEvents;                       // Available from v2.5
+    QUIC_STREAM_SEND_BATCH_FN           StreamSendBatch;                              // Available from v2.5
+
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+    QUIC_EXECUTION_GET_EVENTQ_FN        ExecutionGetEventQ;                           // Available from v2.5
+    QUIC_EXECUTION_POLL_FN              ExecutionPoll;                                // Available from v2.5
+#endif
+
 } QUIC_API_TABLE;
 
 #define QUIC_API_VERSION_1      1 // Not supported any more
@@ -41,6 +41,16 @@ Supported Platforms:
 #define CXPLAT_DBG_ASSERT(X) // no-op if not already defined
 #endif
 
+//
+// C++20 coroutine support (see MsQuicTask). Not available in kernel mode.
+//
+#if !defined(_KERNEL_MODE) && defined(__cpp_impl_coroutine) && !defined(QUIC_CPP_NO_COROUTINES)
+#define QUIC_CPP_COROUTINES 1
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#endif
+
 #ifdef CX_PLATFORM_TYPE
 
 //
@@ -550,6 +560,7 @@ public:
     MsQuicGlobalSettings& SetRetryMemoryLimit(uint16_t Value) { RetryMemoryLimit = Value; IsSet.RetryMemoryLimit = TRUE; return *this; }
     MsQuicGlobalSettings& SetLoadBalancingMode(uint16_t Value) { LoadBalancingMode = Value; IsSet.LoadBalancingMode = TRUE; return *this; }
     MsQuicGlobalSettings& SetFixedServerID(uint32_t Value) { FixedServerID = Value; IsSet.FixedServerID = TRUE; return *this; }
+    MsQuicGlobalSettings& SetConnectionPoolPrewarmCount(uint32_t Value) { ConnectionPoolPrewarmCount = Value; IsSet.ConnectionPoolPrewarmCount = TRUE; return *this; }
 
     QUIC_STATUS Set() const noexcept {
         const QUIC_GLOBAL_SETTINGS* Settings = this;
@@ -606,6 +617,13 @@ public:
     MsQuicSettings& SetOneWayDelayEnabled(bool value) { OneWayDelayEnabled = value; IsSet.OneWayDelayEnabled = TRUE; return *this; }
     MsQuicSettings& SetNetStatsEventEnabled(bool value) { NetStatsEventEnabled = value; IsSet.NetStatsEventEnabled = TRUE; return *this; }
     MsQuicSettings& SetStreamMultiReceiveEnabled(bool value) { StreamMultiReceiveEnabled = value; IsSet.StreamMultiReceiveEnabled = TRUE; return *this; }
+    MsQuicSettings& SetCarefulResumeEnabled(bool value) { CarefulResumeEnabled = value; IsSet.CarefulResumeEnabled = TRUE; return *this; }
+    MsQuicSettings& SetNetStatsEventThreshold(uint8_t Percent) { NetStatsEventThreshold = Percent; IsSet.NetStatsEventThreshold = TRUE; return *this; }
+    MsQuicSettings& SetHibernateTimeoutMs(uint32_t Value) { HibernateTimeoutMs = Value; IsSet.HibernateTimeoutMs = TRUE; return *this; }
+    MsQuicSettings& SetReleaseHandshakeStateEnabled(bool value) { ReleaseHandshakeStateEnabled = value; IsSet.ReleaseHandshakeStateEnabled = TRUE; return *this; }
+    MsQuicSettings& SetResumptionTicketCacheEnabled(bool value) { ResumptionTicketCacheEnabled = value; IsSet.ResumptionTicketCacheEnabled = TRUE; return *this; }
+    MsQuicSettings& SetAdaptiveAckDelayEnabled(bool value) { AdaptiveAckDelayEnabled = value; IsSet.AdaptiveAckDelayEnabled = TRUE; return *this; }
+    MsQuicSettings& SetEarlyCreditWindow(uint32_t Value) { EarlyCreditWindow = Value; IsSet.EarlyCreditWindow = TRUE; return *this; }
 #endif
 
     QUIC_STATUS
@@ -972,6 +990,110 @@ private:
     }
 };
 
+#ifdef QUIC_CPP_COROUTINES
+
+//
+// Fire-and-forget coroutine type for code awaiting MsQuic operations through
+// the awaitables of MsQuicConnection and MsQuicStream, for instance:
+//
+//   MsQuicTask Echo(MsQuicStream* Stream) {
+//       auto Recv = co_await Stream->ReceiveAsync();
+//       ...
+//   }
+//
+// The awaitables keep their state in the MsQuicConnection or MsQuicStream
+// (or in the awaiting frame itself), so awaiting never allocates, and frames
+// up to QUIC_CPP_TASK_FRAME_SIZE bytes are allocated from a pool. Awaiting
+// coroutines are resumed inline from the MsQuic callbacks, on the MsQuic
+// worker threads, so they must not block.
+//
+#ifndef QUIC_CPP_TASK_FRAME_SIZE
+#define QUIC_CPP_TASK_FRAME_SIZE 512
+#endif
+
+struct MsQuicTask {
+    bool Started {false};
+    bool IsValid() const noexcept { return Started; } // False if the frame allocation failed.
+
+    struct promise_type {
+        MsQuicTask get_return_object() noexcept { return MsQuicTask{true}; }
+        static MsQuicTask get_return_object_on_allocation_failure() noexcept { return MsQuicTask{false}; }
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        std::suspend_never final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept { }
+        void unhandled_exception() const noexcept { std::terminate(); }
+
+#ifdef CX_PLATFORM_TYPE
+        struct Frame {
+            alignas(16) uint8_t Buffer[QUIC_CPP_TASK_FRAME_SIZE];
+            Frame() noexcept { } // Not zeroed.
+        };
+        static CxPlatPoolT<Frame>& FramePool() noexcept {
+            static CxPlatPoolT<Frame> Pool;
+            return Pool;
+        }
+        static void* operator new(size_t Size) noexcept {
+            return Size <= sizeof(Frame) ? (void*)FramePool().Alloc() : ::operator new(Size, std::nothrow);
+        }
+        static void operator delete(void* Ptr, size_t Size) noexcept {
+            if (Size <= sizeof(Frame)) {
+                FramePool().Free((Frame*)Ptr);
+            } else {
+                ::operator delete(Ptr);
+            }
+        }
+#else
+        static void* operator new(size_t Size) noexcept { return ::operator new(Size, std::nothrow); }
+        static void operator delete(void* Ptr) noexcept { ::operator delete(Ptr); }
+#endif // CX_PLATFORM_TYPE
+    };
+};
+
+//
+// A signal, set from the MsQuic callbacks, that a single coroutine can wait
+// on. Once signaled, waits complete immediately until it's reset.
+//
+struct MsQuicAwaitSlot {
+    std::atomic<void*> State {nullptr}; // Null, signaled or the waiting coroutine.
+
+    static void* SignaledState() noexcept { return (void*)(uintptr_t)1; }
+
+    bool IsSignaled() const noexcept {
+        return State.load(std::memory_order_acquire) == SignaledState();
+    }
+
+    //
+    // Returns false, without waiting, if already signaled.
+    //
+    bool Wait(_In_ std::coroutine_handle<> Waiter) noexcept {
+        void* Expected = nullptr;
+        return State.compare_exchange_strong(Expected, Waiter.address(), std::memory_order_acq_rel);
+    }
+
+    void Signal() noexcept {
+        void* Waiter = State.exchange(SignaledState(), std::memory_order_acq_rel);
+        if (Waiter != nullptr && Waiter != SignaledState()) {
+            std::coroutine_handle<>::from_address(Waiter).resume();
+        }
+    }
+
+    void Reset() noexcept { State.store(nullptr, std::memory_order_release); }
+};
+
+//
+// The result of awaiting MsQuicStream::ReceiveAsync. On success, the app must
+// call ReceiveComplete once done with the data (which may be empty, at FIN).
+//
+struct MsQuicReceiveResult {
+    QUIC_STATUS Status;
+    uint64_t TotalBufferLength;
+    uint32_t BufferCount;
+    QUIC_BUFFER Buffers[3]; // Enough for MsQuic owned receive buffers.
+    QUIC_RECEIVE_FLAGS Flags;
+};
+
+#endif // QUIC_CPP_COROUTINES
+
 typedef QUIC_STATUS MsQuicConnectionCallback(
     _In_ struct MsQuicConnection* Connection,
     _In_opt_ void* Context,
@@ -995,6 +1117,10 @@ struct MsQuicConnection {
     CxPlatEvent HandshakeCompleteEvent;
     CxPlatEvent ResumptionTicketReceivedEvent;
 #endif // CX_PLATFORM_TYPE
+#ifdef QUIC_CPP_COROUTINES
+    MsQuicAwaitSlot ConnectSlot;            // Signaled on connect or shutdown complete.
+    MsQuicAwaitSlot ShutdownCompleteSlot;
+#endif // QUIC_CPP_COROUTINES
 
     MsQuicConnection(
         _In_ const MsQuicRegistration& Registration,
@@ -1075,6 +1201,87 @@ struct MsQuicConnection {
         return MsQuic->ConnectionStart(Handle, Config, Family, ServerName, ServerPort);
     }
 
+#ifdef QUIC_CPP_COROUTINES
+    struct ConnectAwaiter {
+        MsQuicConnection* Connection;
+        const MsQuicConfiguration* Config;
+        QUIC_ADDRESS_FAMILY Family;
+        const char* ServerName;
+        uint16_t ServerPort;
+        QUIC_STATUS StartStatus {QUIC_STATUS_SUCCESS};
+
+        bool await_ready() const noexcept { return false; }
+        bool await_suspend(_In_ std::coroutine_handle<> Waiter) noexcept {
+            if (!Connection->ConnectSlot.Wait(Waiter)) {
+                return false;
+            }
+            auto Conn = Connection; // The frame may be resumed (and freed) before Start returns.
+            QUIC_STATUS Status = Conn->Start(*Config, Family, ServerName, ServerPort);
+            if (QUIC_FAILED(Status)) {
+                Conn->ConnectSlot.Reset();
+                StartStatus = Status;
+                return false;
+            }
+            return true;
+        }
+        QUIC_STATUS await_resume() const noexcept {
+            if (QUIC_FAILED(StartStatus)) {
+                return StartStatus;
+            }
+            if (Connection->HandshakeComplete) {
+                return QUIC_STATUS_SUCCESS;
+            }
+            return
+                QUIC_FAILED(Connection->TransportShutdownStatus) ?
+                    Connection->TransportShutdownStatus : QUIC_STATUS_ABORTED;
+        }
+    };
+
+    //
+    // Starts the connection and completes once it's connected, returning
+    // success, or once it's shut down, returning why it failed.
+    //
+    ConnectAwaiter
+    ConnectAsync(
+        _In_ const MsQuicConfiguration& Config,
+        _In_reads_or_z_opt_(QUIC_MAX_SNI_LENGTH)
+            const char* ServerName,
+        _In_ uint16_t ServerPort, // Host byte order
+        _In_ QUIC_ADDRESS_FAMILY Family = QUIC_ADDRESS_FAMILY_UNSPEC
+        ) noexcept {
+        return ConnectAwaiter{this, &Config, Family, ServerName, ServerPort};
+    }
+
+    struct ShutdownAwaiter {
+        MsQuicConnection* Connection;
+        QUIC_UINT62 ErrorCode;
+        QUIC_CONNECTION_SHUTDOWN_FLAGS Flags;
+
+        bool await_ready() const noexcept { return Connection->ShutdownCompleteSlot.IsSignaled(); }
+        bool await_suspend(_In_ std::coroutine_handle<> Waiter) noexcept {
+            if (!Connection->ShutdownCompleteSlot.Wait(Waiter)) {
+                return false;
+            }
+            MsQuic->ConnectionShutdown(Connection->Handle, Flags, ErrorCode);
+            return true;
+        }
+        void await_resume() const noexcept { }
+    };
+
+    //
+    // Shuts down the connection and completes once the shutdown is complete.
+    // With CleanUpAutoDelete, the connection is deleted once the awaiting
+    // coroutine next suspends (or finishes).
+    //
+    ShutdownAwaiter
+    ShutdownAsync(
+        _In_ _Pre_defensive_ QUIC_UINT62 ErrorCode, // Application defined error code
+        _In_ QUIC_CONNECTION_SHUTDOWN_FLAGS Flags = QUIC_CONNECTION_SHUTDOWN_FLAG_NONE
+        ) noexcept {
+        return ShutdownAwaiter{this, ErrorCode, Flags};
+    }
+#endif // QUIC_CPP_COROUTINES
+
     QUIC_STATUS
     SetConfiguration(
         _In_ const MsQuicConfiguration& Config
@@ -1335,6 +1542,14 @@ private:
             Event->Type == QUIC_CONNECTION_EVENT_SHUTDOWN_COMPLETE &&
             pThis->CleanUpMode == CleanUpAutoDelete;
         auto Status = pThis->Callback(pThis, pThis->Context, Event);
+#ifdef QUIC_CPP_COROUTINES
+        if (Event->Type == QUIC_CONNECTION_EVENT_CONNECTED) {
+            pThis->ConnectSlot.Signal();
+        } else if (Event->Type == QUIC_CONNECTION_EVENT_SHUTDOWN_COMPLETE) {
+            pThis->ConnectSlot.Signal();
+            pThis->ShutdownCompleteSlot.Signal();
+        }
+#endif // QUIC_CPP_COROUTINES
         if (DeleteOnExit) {
             delete pThis;
         }
@@ -1423,6 +1638,15 @@ struct MsQuicStream {
     MsQuicStreamCallback* Callback;
     void* Context;
     QUIC_STATUS InitStatus;
+#ifdef QUIC_CPP_COROUTINES
+    MsQuicAwaitSlot ReceiveSlot;            // Signaled with data or at the end of the receive direction.
+    MsQuicAwaitSlot ShutdownCompleteSlot;
+    std::atomic<bool> ReceiveAwaited {false};
+    std::atomic<bool> ReceiveEnded {false};
+    bool ReceiveHasData {false};
+    QUIC_STATUS ReceiveEndStatus {QUIC_STATUS_SUCCESS};
+    MsQuicReceiveResult ReceiveResult {};
+#endif // QUIC_CPP_COROUTINES
 
     MsQuicStream(
         _In_ const MsQuicConnection& Connection,
@@ -1509,6 +1733,132 @@ struct MsQuicStream {
         return MsQuic->StreamSend(Handle, Buffers, BufferCount, Flags, ClientSendContext);
     }
 
+#ifdef QUIC_CPP_COROUTINES
+    struct SendAwaiter {
+        MsQuicStream* Stream;
+        const QUIC_BUFFER* Buffers;
+        uint32_t BufferCount;
+        QUIC_SEND_FLAGS Flags;
+        std::coroutine_handle<> Waiter {};
+        QUIC_STATUS Status {QUIC_STATUS_SUCCESS};
+        bool Canceled {false};
+
+        bool await_ready() const noexcept { return false; }
+        bool await_suspend(_In_ std::coroutine_handle<> Handle) noexcept {
+            Waiter = Handle;
+            //
+            // The awaiter is the send context, tagged in its low bit to tell it
+            // apart from the app's own contexts.
+            //
+            QUIC_STATUS SendStatus =
+                MsQuic->StreamSend(
+                    Stream->Handle, Buffers, BufferCount, Flags, (void*)((uintptr_t)this | 1));
+            if (QUIC_FAILED(SendStatus)) {
+                Status = SendStatus;
+                return false;
+            }
+            return true;
+        }
+        QUIC_STATUS await_resume() const noexcept {
+            return QUIC_FAILED(Status) ? Status : (Canceled ? QUIC_STATUS_ABORTED : QUIC_STATUS_SUCCESS);
+        }
+    };
+
+    //
+    // Queues the send and completes once MsQuic is done with the buffers,
+    // returning QUIC_STATUS_ABORTED if the send was canceled. The app's own
+    // send contexts must have their low bit clear.
+    //
+    SendAwaiter
+    SendAsync(
+        _In_reads_(BufferCount) _Pre_defensive_
+            const QUIC_BUFFER* const Buffers,
+        _In_ uint32_t BufferCount = 1,
+        _In_ QUIC_SEND_FLAGS Flags = QUIC_SEND_FLAG_NONE
+        ) noexcept {
+        return SendAwaiter{this, Buffers, BufferCount, Flags};
+    }
+
+    struct ReceiveAwaiter {
+        MsQuicStream* Stream;
+
+        bool await_ready() const noexcept {
+            Stream->ReceiveAwaited.store(true, std::memory_order_release);
+            return Stream->ReceiveSlot.IsSignaled() || Stream->ReceiveEnded.load(std::memory_order_acquire);
+        }
+        bool await_suspend(_In_ std::coroutine_handle<> Waiter) noexcept {
+            return Stream->ReceiveSlot.Wait(Waiter);
+        }
+        MsQuicReceiveResult await_resume() const noexcept {
+            MsQuicReceiveResult Result;
+            if (Stream->ReceiveHasData) {
+                Result = Stream->ReceiveResult;
+                Stream->ReceiveHasData = false;
+                Stream->ReceiveSlot.Reset();
+            } else {
+                //
+                // The receive direction ended. The slot stays signaled so any
+                // further receives complete right away.
+                //
+                Result = {};
+                Result.Status = Stream->ReceiveEndStatus;
+                Result.Flags =
+                    QUIC_SUCCEEDED(Result.Status) ? QUIC_RECEIVE_FLAG_FIN : QUIC_RECEIVE_FLAG_NONE;
+            }
+            return Result;
+        }
+    };
+
+    //
+    // Completes with the next received data. Once awaited, all received data
+    // is held for ReceiveAsync instead of being indicated to the callback, and
+    // the stream's receives stay paused until ReceiveComplete is called. Once
+    // the peer's FIN is reached, it returns success with no data and the FIN
+    // flag; if the receive direction is aborted, it returns a failure.
+    //
+    ReceiveAwaiter
+    ReceiveAsync(
+        ) noexcept {
+        return ReceiveAwaiter{this};
+    }
+
+    struct ShutdownAwaiter {
+        MsQuicStream* Stream;
+        QUIC_UINT62 ErrorCode;
+        QUIC_STREAM_SHUTDOWN_FLAGS Flags;
+        QUIC_STATUS Status {QUIC_STATUS_SUCCESS};
+
+        bool await_ready() const noexcept { return Stream->ShutdownCompleteSlot.IsSignaled(); }
+        bool await_suspend(_In_ std::coroutine_handle<> Waiter) noexcept {
+            if (!Stream->ShutdownCompleteSlot.Wait(Waiter)) {
+                return false;
+            }
+            auto Strm = Stream; // The frame may be resumed (and freed) before the call returns.
+            QUIC_STATUS ShutdownStatus = MsQuic->StreamShutdown(Strm->Handle, Flags, ErrorCode);
+            if (QUIC_FAILED(ShutdownStatus)) {
+                Strm->ShutdownCompleteSlot.Reset();
+                Status = ShutdownStatus;
+                return false;
+            }
+            return true;
+        }
+        QUIC_STATUS await_resume() const noexcept { return Status; }
+    };
+
+    //
+    // Shuts down the stream and completes once the shutdown is complete.
+    // With CleanUpAutoDelete, the stream is deleted once the awaiting
+    // coroutine next suspends (or finishes).
+    //
+    ShutdownAwaiter
+    ShutdownAsync(
+        _In_ _Pre_defensive_ QUIC_UINT62 ErrorCode, // Application defined error code
+        _In_ QUIC_STREAM_SHUTDOWN_FLAGS Flags = QUIC_STREAM_SHUTDOWN_FLAG_GRACEFUL
+        ) noexcept {
+        return ShutdownAwaiter{this, ErrorCode, Flags};
+    }
+#endif // QUIC_CPP_COROUTINES
+
     _IRQL_requires_max_(DISPATCH_LEVEL)
     void
     ReceiveComplete(
@@ -1649,10 +1999,52 @@ private:
         _Inout_ QUIC_STREAM_EVENT* Event
         ) noexcept {
         CXPLAT_DBG_ASSERT(pThis);
+#ifdef QUIC_CPP_COROUTINES
+        if (Event->Type == QUIC_STREAM_EVENT_SEND_COMPLETE &&
+            ((uintptr_t)Event->SEND_COMPLETE.ClientContext & 1)) {
+            auto Awaiter = (SendAwaiter*)((uintptr_t)Event->SEND_COMPLETE.ClientContext & ~(uintptr_t)1);
+            Awaiter->Canceled = Event->SEND_COMPLETE.Canceled;
+            Awaiter->Waiter.resume();
+            return QUIC_STATUS_SUCCESS;
+        }
+        if (Event->Type == QUIC_STREAM_EVENT_RECEIVE &&
+            pThis->ReceiveAwaited.load(std::memory_order_acquire)) {
+            auto& Result = pThis->ReceiveResult;
+            const uint32_t MaxBufferCount = sizeof(Result.Buffers) / sizeof(Result.Buffers[0]);
+            CXPLAT_DBG_ASSERT(Event->RECEIVE.BufferCount <= MaxBufferCount);
+            Result.Status = QUIC_STATUS_SUCCESS;
+            Result.TotalBufferLength = 0;
+            Result.BufferCount = 0;
+            for (uint32_t i = 0; i < Event->RECEIVE.BufferCount && i < MaxBufferCount; ++i) {
+                Result.Buffers[Result.BufferCount++] = Event->RECEIVE.Buffers[i];
+                Result.TotalBufferLength += Event->RECEIVE.Buffers[i].Length;
+            }
+            Result.Flags = Event->RECEIVE.Flags;
+            pThis->ReceiveHasData = true;
+            pThis->ReceiveSlot.Signal();
+            return QUIC_STATUS_PENDING; // Completed by the app with ReceiveComplete.
+        }
+#endif // QUIC_CPP_COROUTINES
         auto DeleteOnExit =
             Event->Type == QUIC_STREAM_EVENT_SHUTDOWN_COMPLETE &&
             pThis->CleanUpMode == CleanUpAutoDelete;
         auto Status = pThis->Callback(pThis, pThis->Context, Event);
+#ifdef QUIC_CPP_COROUTINES
+        if (Event->Type == QUIC_STREAM_EVENT_PEER_SEND_SHUTDOWN ||
+            Event->Type == QUIC_STREAM_EVENT_PEER_SEND_ABORTED ||
+            Event->Type == QUIC_STREAM_EVENT_SHUTDOWN_COMPLETE) {
+            if (!pThis->ReceiveEnded.load(std::memory_order_relaxed)) {
+                pThis->ReceiveEndStatus =
+                    Event->Type == QUIC_STREAM_EVENT_PEER_SEND_SHUTDOWN ?
+                        QUIC_STATUS_SUCCESS : QUIC_STATUS_ABORTED;
+                pThis->ReceiveEnded.store(true, std::memory_order_release);
+            }
+            pThis->ReceiveSlot.Signal();
+        }
+        if (Event->Type == QUIC_STREAM_EVENT_SHUTDOWN_COMPLETE) {
+            pThis->ShutdownCompleteSlot.Signal();
+        }
+#endif // QUIC_CPP_COROUTINES
         if (DeleteOnExit) {
             delete pThis;
         }
@@ -1660,6 +2052,412 @@ private:
     }
 };
 
+#ifdef CX_PLATFORM_TYPE
+
+//
+// A pool of client connections, shared by everything in the process that
+// talks to the same servers. OpenStream hands out a started stream on an
+// existing connection to the same server name, port and configuration when
+// one can take it, and only opens a new connection (up to
+// MaxConnectionsPerTarget) when:
+//
+//  - the peer's stream credits (QUIC_CONNECTION_EVENT_STREAMS_AVAILABLE) are
+//    used up on all of them,
+//  - or they were blocked by connection flow control since their last stream
+//    completed,
+//  - or their smoothed RTT is over MaxRttUs (if set).
+//
+// Once at the limit, streams go on the least busy connection and wait there
+// for credits. Connections without streams for IdleTimeoutMs are shut down;
+// this is checked on each OpenStream and by EvictIdle, so apps that want a
+// tighter bound can call EvictIdle from a timer.
+//
+// The handed out streams are normal MsQuicStreams, except that their Context
+// field belongs to the pool (the callback still gets the app's context). Peer
+// initiated streams on pooled connections are refused. The pool must outlive
+// its streams, and none of its methods may be called from a pooled
+// connection's callbacks while the pool is being destroyed.
+//
+struct MsQuicConnectionPool {
+    const MsQuicRegistration& Registration;
+    uint32_t MaxConnectionsPerTarget;
+    uint32_t IdleTimeoutMs;                 // Zero keeps idle connections.
+    uint32_t MaxRttUs;                      // Zero doesn't check the RTT.
+
+    MsQuicConnectionPool(
+        _In_ const MsQuicRegistration& Registration,
+        _In_ uint32_t MaxConnectionsPerTarget = 4,
+        _In_ uint32_t IdleTimeoutMs = 30000,
+        _In_ uint32_t MaxRttUs = 0
+        ) noexcept :
+        Registration(Registration),
+        MaxConnectionsPerTarget(MaxConnectionsPerTarget == 0 ? 1 : MaxConnectionsPerTarget),
+        IdleTimeoutMs(IdleTimeoutMs),
+        MaxRttUs(MaxRttUs) {
+        CxPlatListInitializeHead(&Connections);
+    }
+
+    ~MsQuicConnectionPool() noexcept {
+        Lock.Acquire();
+        Closing = true;
+        bool Empty = ConnectionCount == 0;
+        for (CXPLAT_LIST_ENTRY* Link = Connections.Flink; Link != &Connections; Link = Link->Flink) {
+            auto Entry = CXPLAT_CONTAINING_RECORD(Link, PooledConnection, Link);
+            Entry->ShuttingDown = true;
+            Entry->Connection->Shutdown(0); // Queued, so safe under the lock.
+        }
+        Lock.Release();
+        if (!Empty) {
+            AllClosed.WaitForever();
+        }
+    }
+
+    //
+    // Opens and starts a stream to the server, on a pooled connection.
+    //
+    QUIC_STATUS
+    OpenStream(
+        _In_ const MsQuicConfiguration& Config,
+        _In_z_ const char* ServerName,
+        _In_ uint16_t ServerPort, // Host byte order
+        _In_ QUIC_STREAM_OPEN_FLAGS OpenFlags,
+        _In_ QUIC_STREAM_START_FLAGS StartFlags,
+        _In_ MsQuicCleanUpMode CleanUpMode,
+        _In_ MsQuicStreamCallback* Callback,
+        _In_opt_ void* Context,
+        _Outptr_ MsQuicStream** Stream
+        ) noexcept {
+        *Stream = nullptr;
+        const bool Unidirectional = (OpenFlags & QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL) != 0;
+        auto StreamContext = new(std::nothrow) PooledStream;
+        if (StreamContext == nullptr) {
+            return QUIC_STATUS_OUT_OF_MEMORY;
+        }
+        StreamContext->Callback = Callback;
+        StreamContext->Context = Context;
+
+        Lock.Acquire();
+        EvictIdleLocked();
+
+        PooledConnection* Entry = FindConnectionLocked(Config, ServerName, ServerPort, Unidirectional);
+        if (Entry == nullptr) {
+            Entry = OpenConnectionLocked(Config, ServerName, ServerPort);
+            if (Entry == nullptr) {
+                Lock.Release();
+                delete StreamContext;
+                return QUIC_STATUS_OUT_OF_MEMORY;
+            }
+        }
+
+        uint16_t& Credits = Unidirectional ? Entry->AvailableUnidiStreams : Entry->AvailableBidiStreams;
+        if (Credits != 0) {
+            Credits--;
+        }
+        Entry->ActiveStreams++;
+        StreamContext->Owner = Entry;
+
+        //
+        // The stream holds a reference on the connection, so it can be started
+        // after the lock is released, even if the connection shuts down.
+        //
+        auto NewStream =
+            new(std::nothrow) MsQuicStream(
+                *Entry->Connection, OpenFlags, CleanUpMode, PooledStreamCallback, StreamContext);
+        if (NewStream == nullptr || !NewStream->IsValid()) {
+            ReleaseStreamLocked(Entry);
+            Lock.Release();
+            QUIC_STATUS Status = NewStream ? NewStream->GetInitStatus() : QUIC_STATUS_OUT_OF_MEMORY;
+            delete NewStream;
+            delete StreamContext;
+            return Status;
+        }
+        Lock.Release();
+
+        QUIC_STATUS Status = NewStream->Start(StartFlags);
+        if (QUIC_FAILED(Status)) {
+            NewStream->CleanUpMode = CleanUpManual;
+            NewStream->Callback = MsQuicStream::NoOpCallback;
+            delete NewStream;
+            Lock.Acquire();
+            ReleaseStreamLocked(Entry);
+            Lock.Release();
+            delete StreamContext;
+            return Status;
+        }
+
+        *Stream = NewStream;
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    //
+    // Shuts down the connections that have had no streams for IdleTimeoutMs.
+    //
+    void
+    EvictIdle(
+        ) noexcept {
+        Lock.Acquire();
+        EvictIdleLocked();
+        Lock.Release();
+    }
+
+    //
+    // The number of connections (including ones shutting down) in the pool.
+    //
+    uint32_t
+    GetConnectionCount(
+        ) noexcept {
+        Lock.Acquire();
+        uint32_t Count = ConnectionCount;
+        Lock.Release();
+        return Count;
+    }
+
+    MsQuicConnectionPool(const MsQuicConnectionPool& Other) = delete;
+    MsQuicConnectionPool& operator=(const MsQuicConnectionPool& Other) = delete;
+
+private:
+
+    struct PooledConnection {
+        CXPLAT_LIST_ENTRY Link;
+        MsQuicConnectionPool* Pool;
+        MsQuicConnection* Connection;
+        char* ServerName;
+        uint16_t ServerPort;
+        HQUIC Configuration;
+        uint32_t ActiveStreams {0};
+        uint16_t AvailableBidiStreams {0};  // Unknown (zero) until the peer's transport parameters.
+        uint16_t AvailableUnidiStreams {0};
+        uint64_t IdleSinceUs;
+        uint64_t ConnFlowControlLimitedUs {0};
+        bool Connected {false};
+        bool ShuttingDown {false};
+        bool Saturated {false};             // Flow control blocked or over MaxRttUs.
+        ~PooledConnection() noexcept { delete[] ServerName; }
+    };
+
+    struct PooledStream {
+        PooledConnection* Owner;
+        MsQuicStreamCallback* Callback;
+        void* Context;
+    };
+
+    CxPlatLock Lock;
+    CXPLAT_LIST_ENTRY Connections;
+    uint32_t ConnectionCount {0};
+    bool Closing {false};
+    CxPlatEvent AllClosed {true};
+
+    //
+    // Returns the oldest connection to the target that can take the stream
+    // right away. Falls back to the least busy one once the target has as many
+    // connections as allowed, and returns null if a new one should be opened.
+    //
+    PooledConnection*
+    FindConnectionLocked(
+        _In_ const MsQuicConfiguration& Config,
+        _In_z_ const char* ServerName,
+        _In_ uint16_t ServerPort,
+        _In_ bool Unidirectional
+        ) noexcept {
+        PooledConnection* LeastBusy = nullptr;
+        uint32_t Count = 0;
+        for (CXPLAT_LIST_ENTRY* Link = Connections.Flink; Link != &Connections; Link = Link->Flink) {
+            auto Entry = CXPLAT_CONTAINING_RECORD(Link, PooledConnection, Link);
+            if (Entry->ShuttingDown ||
+                Entry->Configuration != (HQUIC)Config ||
+                Entry->ServerPort != ServerPort ||
+                strcmp(Entry->ServerName, ServerName) != 0) {
+                continue;
+            }
+            Count++;
+            if (LeastBusy == nullptr || Entry->ActiveStreams < LeastBusy->ActiveStreams) {
+                LeastBusy = Entry;
+            }
+            if (Entry->Saturated) {
+                continue;
+            }
+            const uint16_t Credits =
+                Unidirectional ? Entry->AvailableUnidiStreams : Entry->AvailableBidiStreams;
+            if (Credits != 0 || (!Entry->Connected && Entry->ActiveStreams == 0)) {
+                //
+                // A connection still in its handshake doesn't know its credits
+                // yet, so it only takes the stream it was opened for.
+                //
+                return Entry;
+            }
+        }
+        return Count < MaxConnectionsPerTarget ? nullptr : LeastBusy;
+    }
+
+    PooledConnection*
+    OpenConnectionLocked(
+        _In_ const MsQuicConfiguration& Config,
+        _In_z_ const char* ServerName,
+        _In_ uint16_t ServerPort
+        ) noexcept {
+        auto Entry = new(std::nothrow) PooledConnection;
+        if (Entry == nullptr) {
+            return nullptr;
+        }
+        const size_t ServerNameLength = strlen(ServerName);
+        Entry->Pool = this;
+        Entry->ServerName = new(std::nothrow) char[ServerNameLength + 1];
+        Entry->ServerPort = ServerPort;
+        Entry->Configuration = Config;
+        Entry->IdleSinceUs = CxPlatTimeUs64();
+        Entry->Connection = nullptr;
+        if (Entry->ServerName == nullptr) {
+            delete Entry;
+            return nullptr;
+        }
+        memcpy(Entry->ServerName, ServerName, ServerNameLength + 1);
+
+        Entry->Connection =
+            new(std::nothrow) MsQuicConnection(
+                Registration, CleanUpAutoDelete, PooledConnectionCallback, Entry);
+        if (Entry->Connection == nullptr ||
+            !Entry->Connection->IsValid() ||
+            QUIC_FAILED(Entry->Connection->Start(Config, ServerName, ServerPort))) {
+            if (Entry->Connection != nullptr) {
+                //
+                // Closing it may still indicate shutdown complete, which
+                // mustn't reach the pool or delete the connection.
+                //
+                Entry->Connection->CleanUpMode = CleanUpManual;
+                Entry->Connection->Callback = MsQuicConnection::NoOpCallback;
+                delete Entry->Connection;
+            }
+            delete Entry;
+            return nullptr;
+        }
+        CxPlatListInsertTail(&Connections, &Entry->Link);
+        ConnectionCount++;
+        return Entry;
+    }
+
+    void
+    ReleaseStreamLocked(
+        _In_ PooledConnection* Entry
+        ) noexcept {
+        if (--Entry->ActiveStreams == 0) {
+            Entry->IdleSinceUs = CxPlatTimeUs64();
+        }
+    }
+
+    void
+    EvictIdleLocked(
+        ) noexcept {
+        if (IdleTimeoutMs == 0) {
+            return;
+        }
+        const uint64_t TimeNow = CxPlatTimeUs64();
+        for (CXPLAT_LIST_ENTRY* Link = Connections.Flink; Link != &Connections; Link = Link->Flink) {
+            auto Entry = CXPLAT_CONTAINING_RECORD(Link, PooledConnection, Link);
+            if (!Entry->ShuttingDown &&
+                Entry->ActiveStreams == 0 &&
+                CxPlatTimeDiff64(Entry->IdleSinceUs, TimeNow) >= (uint64_t)IdleTimeoutMs * 1000) {
+                Entry->ShuttingDown = true;
+                Entry->Connection->Shutdown(0);
+            }
+        }
+    }
+
+    static
+    QUIC_STATUS
+    QUIC_API
+    PooledConnectionCallback(
+        _In_ MsQuicConnection* /* Connection */,
+        _In_opt_ void* Context,
+        _Inout_ QUIC_CONNECTION_EVENT* Event
+        ) noexcept {
+        auto Entry = (PooledConnection*)Context;
+        auto Pool = Entry->Pool;
+        switch (Event->Type) {
+        case QUIC_CONNECTION_EVENT_CONNECTED:
+            Pool->Lock.Acquire();
+            Entry->Connected = true;
+            Pool->Lock.Release();
+            break;
+        case QUIC_CONNECTION_EVENT_STREAMS_AVAILABLE:
+            Pool->Lock.Acquire();
+            Entry->AvailableBidiStreams = Event->STREAMS_AVAILABLE.BidirectionalCount;
+            Entry->AvailableUnidiStreams = Event->STREAMS_AVAILABLE.UnidirectionalCount;
+            Pool->Lock.Release();
+            break;
+        case QUIC_CONNECTION_EVENT_SHUTDOWN_INITIATED_BY_TRANSPORT:
+        case QUIC_CONNECTION_EVENT_SHUTDOWN_INITIATED_BY_PEER:
+            Pool->Lock.Acquire();
+            Entry->ShuttingDown = true;
+            Pool->Lock.Release();
+            break;
+        case QUIC_CONNECTION_EVENT_SHUTDOWN_COMPLETE: {
+            //
+            // The MsQuicConnection deletes itself once this returns.
+            //
+            Pool->Lock.Acquire();
+            CxPlatListEntryRemove(&Entry->Link);
+            const bool Signal = --Pool->ConnectionCount == 0 && Pool->Closing;
+            Pool->Lock.Release();
+            delete Entry;
+            if (Signal) {
+                Pool->AllClosed.Set();
+            }
+            break;
+        }
+        case QUIC_CONNECTION_EVENT_PEER_STREAM_STARTED:
+            MsQuic->StreamClose(Event->PEER_STREAM_STARTED.Stream);
+            break;
+        default:
+            break;
+        }
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    static
+    QUIC_STATUS
+    QUIC_API
+    PooledStreamCallback(
+        _In_ MsQuicStream* Stream,
+        _In_opt_ void* Context,
+        _Inout_ QUIC_STREAM_EVENT* Event
+        ) noexcept {
+        auto StreamContext = (PooledStream*)Context;
+        if (Event->Type != QUIC_STREAM_EVENT_SHUTDOWN_COMPLETE) {
+            return StreamContext->Callback(Stream, StreamContext->Context, Event);
+        }
+
+        //
+        // Streams complete before their connection, on its worker thread, so
+        // the statistics are read inline and the connection is still pooled.
+        //
+        auto Entry = StreamContext->Owner;
+        auto Pool = Entry->Pool;
+        QUIC_STATISTICS_V2 Stats;
+        uint32_t StatsLength = sizeof(Stats);
+        const bool HaveStats =
+            QUIC_SUCCEEDED(
+                MsQuic->GetParam(
+                    *Entry->Connection, QUIC_PARAM_CONN_STATISTICS_V2, &StatsLength, &Stats));
+
+        Pool->Lock.Acquire();
+        if (HaveStats) {
+            Entry->Saturated =
+                Stats.SendConnFlowControlLimitedTimeUs > Entry->ConnFlowControlLimitedUs ||
+                (Pool->MaxRttUs != 0 && Stats.Rtt > Pool->MaxRttUs);
+            Entry->ConnFlowControlLimitedUs = Stats.SendConnFlowControlLimitedTimeUs;
+        }
+        Pool->ReleaseStreamLocked(Entry);
+        Pool->Lock.Release();
+
+        auto Callback = StreamContext->Callback;
+        auto AppContext = StreamContext->Context;
+        delete StreamContext;
+        return Callback(Stream, AppContext, Event);
+    }
+};
+
+#endif // CX_PLATFORM_TYPE
+
 struct ConnectionScope {
     HQUIC Handle;
     ConnectionScope() noexcept : Handle(nullptr) { }
@@ -152,6 +152,12 @@ typedef struct in6_addr IN6_ADDR;
 typedef struct addrinfo ADDRINFO;
 typedef sa_family_t QUIC_ADDRESS_FAMILY;
 
+//
+// The OS event queue of an externally driven execution context (the epoll,
+// kqueue or io_uring file descriptor).
+//
+typedef int QUIC_EVENTQ;
+
 #define QUIC_ADDRESS_FAMILY_UNSPEC AF_UNSPEC
 #define QUIC_ADDRESS_FAMILY_INET AF_INET
 #define QUIC_ADDRESS_FAMILY_INET6 AF_INET6
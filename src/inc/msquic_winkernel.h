@@ -142,6 +142,11 @@ typedef UINT64 uint64_t;
 typedef ADDRESS_FAMILY QUIC_ADDRESS_FAMILY;
 typedef SOCKADDR_INET QUIC_ADDR;
 
+//
+// Externally driven execution isn't supported in kernel mode.
+//
+typedef HANDLE QUIC_EVENTQ;
+
 #define QUIC_ADDR_V4_PORT_OFFSET        FIELD_OFFSET(SOCKADDR_IN, sin_port)
 #define QUIC_ADDR_V4_IP_OFFSET          FIELD_OFFSET(SOCKADDR_IN, sin_addr)
 
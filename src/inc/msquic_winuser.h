@@ -147,6 +147,12 @@ Environment:
 typedef ADDRESS_FAMILY QUIC_ADDRESS_FAMILY;
 typedef SOCKADDR_INET QUIC_ADDR;
 
+//
+// The OS event queue of an externally driven execution context (the I/O
+// completion port).
+//
+typedef HANDLE QUIC_EVENTQ;
+
 #define QUIC_ADDR_V4_PORT_OFFSET        FIELD_OFFSET(SOCKADDR_IN, sin_port)
 #define QUIC_ADDR_V4_IP_OFFSET          FIELD_OFFSET(SOCKADDR_IN, sin_addr)
 
@@ -95,6 +95,55 @@ typedef struct QUIC_TEST_DATAPATH_HOOKS {
 #define QUIC_TEST_DISABLE_VNE_TP_GENERATION 1
 #endif
 
+//
+// One direction of the emulated network link. The link is a bottleneck of
+// BandwidthKbps with a tail drop buffer of QueueBytes, followed by DelayUs of
+// propagation delay. Zero disables the corresponding impairment.
+//
+typedef struct QUIC_NETWORK_EMULATION_LINK {
+    uint32_t BandwidthKbps;
+    uint32_t QueueBytes;
+    uint32_t DelayUs;
+    uint32_t JitterUs;          // Extra delay, uniformly random from 0 to JitterUs
+    uint32_t LossRate;          // Lost packets per million
+    uint32_t LossBurstLength;   // Average length of loss bursts (0 or 1 for independent losses)
+    uint32_t ReorderRate;       // Packets per million delivered without the delay
+} QUIC_NETWORK_EMULATION_LINK;
+
+//
+// Emulates a network link between the clients and servers in this process.
+// The same seed makes the same loss, jitter and reordering decisions.
+//
+typedef struct QUIC_NETWORK_EMULATION_SETTINGS {
+    QUIC_NETWORK_EMULATION_LINK ClientToServer;
+    QUIC_NETWORK_EMULATION_LINK ServerToClient;
+    uint32_t RandomSeed;
+} QUIC_NETWORK_EMULATION_SETTINGS;
+
+//
+// How long each internal phase of the library's startup took, in
+// microseconds. Phases that haven't run yet (the worker pool and datapath are
+// created with the first registration) are zero.
+//
+typedef struct QUIC_STARTUP_TIMINGS {
+    uint64_t PlatformInitUs;    // CxPlatInitialize, including CryptoInitUs
+    uint64_t CryptoInitUs;      // The crypto/TLS provider
+    uint64_t LibraryInitUs;     // All of MsQuicLibraryInitialize
+    uint64_t WorkerPoolStartUs; // CxPlatWorkerPoolLazyStart
+    uint64_t DatapathInitUs;    // CxPlatDataPathInitialize, including WorkerPoolStartUs
+} QUIC_STARTUP_TIMINGS;
+
+//
+// The virtual clock of a QUIC_SIMULATION build. Time only moves when the app
+// sets QUIC_PARAM_GLOBAL_SIMULATION_TIME, which also delivers the emulated
+// network's datagrams that are due by then. It never moves backwards, and
+// can't be set to UINT64_MAX.
+//
+typedef struct QUIC_SIMULATION_STATE {
+    uint64_t TimeUs;            // The current virtual time
+    uint64_t NextDeliveryUs;    // When the next emulated datagram is due, or UINT64_MAX
+} QUIC_SIMULATION_STATE;
+
 typedef struct QUIC_PRIVATE_TRANSPORT_PARAMETER {
     uint32_t Type;
     uint16_t Length;
@@ -117,6 +166,10 @@ typedef struct QUIC_PRIVATE_TRANSPORT_PARAMETER {
 #define QUIC_PARAM_GLOBAL_IN_USE                        0x81000004  // BOOLEAN
 #define QUIC_PARAM_GLOBAL_DATAPATH_FEATURES             0x81000005  // uint32_t
 #define QUIC_PARAM_GLOBAL_PLATFORM_WORKER_POOL          0x81000006  // CXPLAT_WORKER_POOL*
+#define QUIC_PARAM_GLOBAL_NETWORK_EMULATION             0x81000007  // QUIC_NETWORK_EMULATION_SETTINGS (empty to disable)
+#define QUIC_PARAM_GLOBAL_STARTUP_TIMINGS               0x81000008  // QUIC_STARTUP_TIMINGS
+#define QUIC_PARAM_GLOBAL_SIMULATION_TIME               0x81000009  // QUIC_SIMULATION_STATE (get), uint64_t (set)
+#define QUIC_PARAM_GLOBAL_SIMULATION_SEED               0x8100000A  // uint64_t (set only)
 
 //
 // The different private parameters for Configuration.
@@ -189,6 +189,38 @@ QuicPacketKeyCreateInitial(
     _Out_opt_ QUIC_PACKET_KEY** WriteKey
     );
 
+//
+// Derives the client and server Initial secrets from the static version
+// specific salt and the connection ID.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+CxPlatTlsDeriveInitialSecrets(
+    _In_reads_(CXPLAT_VERSION_SALT_LENGTH)
+        const uint8_t* const Salt,
+    _In_reads_(CIDLength)
+        const uint8_t* const CID,
+    _In_ uint8_t CIDLength,
+    _Out_ CXPLAT_SECRET *ClientInitial,
+    _Out_ CXPLAT_SECRET *ServerInitial
+    );
+
+//
+// Creates the Initial packet keys from previously derived Initial secrets.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_When_(ReadKey != NULL, _At_(*ReadKey, __drv_allocatesMem(Mem)))
+_When_(WriteKey != NULL, _At_(*WriteKey, __drv_allocatesMem(Mem)))
+QUIC_STATUS
+QuicPacketKeyCreateInitialFromSecrets(
+    _In_ BOOLEAN IsServer,
+    _In_ const QUIC_HKDF_LABELS* HkdfLabels,
+    _In_ const CXPLAT_SECRET* ClientInitial,
+    _In_ const CXPLAT_SECRET* ServerInitial,
+    _Out_opt_ QUIC_PACKET_KEY** ReadKey,
+    _Out_opt_ QUIC_PACKET_KEY** WriteKey
+    );
+
 //
 // Frees the packet key.
 //
@@ -322,6 +354,45 @@ CxPlatDecrypt(
         uint8_t* Buffer
     );
 
+//
+// A single packet in a batched encrypt or decrypt operation. The fields have
+// the same meaning as the corresponding parameters to CxPlatEncrypt and
+// CxPlatDecrypt.
+//
+typedef struct CXPLAT_CRYPT_BATCH_ENTRY {
+    const uint8_t* AuthData;
+    uint8_t* Buffer;
+    uint16_t AuthDataLength;
+    uint16_t BufferLength;
+    uint8_t Iv[CXPLAT_IV_LENGTH];
+} CXPLAT_CRYPT_BATCH_ENTRY;
+
+//
+// Encrypts a batch of packets with the same key. Allows the crypto provider
+// to pipeline the AEAD operations across packets. Stops on the first failure.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+CxPlatEncryptBatch(
+    _In_ CXPLAT_KEY* Key,
+    _In_ uint8_t BatchSize,
+    _Inout_updates_(BatchSize)
+        CXPLAT_CRYPT_BATCH_ENTRY* Entries
+    );
+
+//
+// Decrypts a batch of packets with the same key. Allows the crypto provider
+// to pipeline the AEAD operations across packets. Stops on the first failure.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+CxPlatDecryptBatch(
+    _In_ CXPLAT_KEY* Key,
+    _In_ uint8_t BatchSize,
+    _Inout_updates_(BatchSize)
+        CXPLAT_CRYPT_BATCH_ENTRY* Entries
+    );
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 QUIC_STATUS
 CxPlatHpKeyCreate(
@@ -142,6 +142,11 @@ typedef struct CXPLAT_SEND_DATA CXPLAT_SEND_DATA;
 //
 typedef struct QUIC_BUFFER QUIC_BUFFER;
 
+//
+// Statistics of a raw datapath queue.
+//
+typedef struct QUIC_DATAPATH_QUEUE_STATISTICS QUIC_DATAPATH_QUEUE_STATISTICS;
+
 typedef enum CXPLAT_ROUTE_STATE {
     RouteUnresolved,
     RouteResolving,
@@ -158,6 +163,16 @@ typedef struct CXPLAT_RAW_TCP_STATE {
     uint32_t SequenceNumber;
 } CXPLAT_RAW_TCP_STATE;
 
+//
+// The datapath a route sends on. An unknown route goes on the raw datapath
+// (if there is one) once resolved.
+//
+typedef enum CXPLAT_DATAPATH_TYPE {
+    CXPLAT_DATAPATH_TYPE_UNKNOWN = 0,
+    CXPLAT_DATAPATH_TYPE_USER,
+    CXPLAT_DATAPATH_TYPE_RAW, // currently raw == xdp
+} CXPLAT_DATAPATH_TYPE;
+
 //
 // Structure to represent a network route.
 //
@@ -438,6 +453,7 @@ CxPlatDataPathUpdateConfig(
 #define CXPLAT_DATAPATH_FEATURE_PORT_RESERVATIONS     0x0010
 #define CXPLAT_DATAPATH_FEATURE_TCP                   0x0020
 #define CXPLAT_DATAPATH_FEATURE_RAW                   0x0040
+#define CXPLAT_DATAPATH_FEATURE_SEND_TXTIME           0x0080
 
 //
 // Queries the currently supported features of the datapath.
@@ -448,6 +464,29 @@ CxPlatDataPathGetSupportedFeatures(
     _In_ CXPLAT_DATAPATH* Datapath
     );
 
+//
+// Queries the maximum number of datagrams a single send (one segmented send
+// with CXPLAT_DATAPATH_FEATURE_SEND_SEGMENTATION, otherwise one batch) can
+// carry. The send buffer size may limit it further for large datagrams.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint16_t
+CxPlatDataPathGetMaxSendSegments(
+    _In_ CXPLAT_DATAPATH* Datapath
+    );
+
+//
+// Writes the statistics of up to Capacity of the datapath's raw (XDP or DPDK)
+// queues and returns how many queues there are.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+uint32_t
+CxPlatDataPathGetQueueStatistics(
+    _In_ CXPLAT_DATAPATH* Datapath,
+    _Out_writes_opt_(Capacity) QUIC_DATAPATH_QUEUE_STATISTICS* Statistics,
+    _In_ uint32_t Capacity
+    );
+
 //
 // Gets whether the datapath prefers UDP datagrams padded to path MTU.
 //
@@ -544,6 +583,17 @@ typedef struct CXPLAT_UDP_CONFIG {
     uint8_t CibirIdOffsetSrc;           // CIBIR ID offset in source CID
     uint8_t CibirIdOffsetDst;           // CIBIR ID offset in destination CID
     uint8_t CibirId[6];                 // CIBIR ID data
+
+    // used for CID based receive steering (server-only)
+    uint8_t CidPartitionIdOffset;       // Offset of the partition ID in server CIDs
+    uint16_t CidPartitionMask;          // Mask applied to the partition ID
+    uint16_t CidPartitionCount;         // Value of 0 indicates CID steering isn't used
+
+    // used for early packet filtering by the RAW datapath (server-only)
+    uint8_t FilterCidLength;            // Length of server CIDs. Value of 0 indicates no filtering
+    uint8_t FilterServerIdOffset;       // Offset of the server ID in server CIDs
+    uint8_t FilterServerIdLength;       // Value of 0 indicates the server ID isn't matched
+    uint8_t FilterServerId[15];         // Server ID data
 } CXPLAT_UDP_CONFIG;
 
 //
@@ -662,6 +712,7 @@ CxPlatRecvDataReturn(
 typedef enum CXPLAT_SEND_FLAGS {
     CXPLAT_SEND_FLAGS_NONE = 0,
     CXPLAT_SEND_FLAGS_MAX_THROUGHPUT = 1,
+    CXPLAT_SEND_FLAGS_DEFERRED = 2, // May be held and batched with other sends on the socket.
 } CXPLAT_SEND_FLAGS;
 
 typedef struct CXPLAT_SEND_CONFIG {
@@ -669,6 +720,10 @@ typedef struct CXPLAT_SEND_CONFIG {
     uint16_t MaxPacketSize;
     uint8_t ECN; // CXPLAT_ECN_TYPE
     uint8_t Flags; // CXPLAT_SEND_FLAGS
+    uint64_t TxTime; // Earliest departure time (CxPlatTimeUs64), or 0 for now.
+                     // Only used with CXPLAT_DATAPATH_FEATURE_SEND_TXTIME.
+    uint16_t MaxSegments; // Most datagrams the send may hold, or 0 for the
+                          // datapath's limit (CxPlatDataPathGetMaxSendSegments).
 } CXPLAT_SEND_CONFIG;
 
 //
@@ -773,6 +828,53 @@ CxPlatSocketGetTcpStatistics(
     _Out_ CXPLAT_TCP_STATISTICS* Statistics
     );
 
+//
+// Hands the TLS 1.3 record protection of one direction of a connected TCP
+// socket to the kernel (kTLS). From then on that direction carries plaintext
+// through the socket API, framed into TLS records starting at sequence number
+// zero. Key is the raw AEAD key and Iv the 12 byte static IV. Not supported
+// for sockets using io_uring, whose receives are posted ahead of time.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+CxPlatSocketSetTcpTls(
+    _In_ CXPLAT_SOCKET* Socket,
+    _In_ BOOLEAN Send,
+    _In_ CXPLAT_QEO_CIPHER_TYPE CipherType,
+    _In_reads_(32) const uint8_t* Key,
+    _In_reads_(12) const uint8_t* Iv
+    );
+
+typedef struct CXPLAT_UDP_RECV_STATISTICS {
+    uint64_t RecvWakeups;   // Receive readiness notifications processed.
+    uint64_t RecvCalls;     // Receive system calls made.
+    uint64_t RecvMessages;  // Messages (possibly coalesced) received.
+    uint64_t RecvMisdirected; // Short header messages received outside their CID's partition.
+    uint32_t RecvBatchSize; // Current receive batch size, summed over queues.
+} CXPLAT_UDP_RECV_STATISTICS;
+
+//
+// Queries the receive batching statistics of a UDP socket.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+CxPlatSocketGetUdpRecvStatistics(
+    _In_ CXPLAT_SOCKET* Socket,
+    _Out_ CXPLAT_UDP_RECV_STATISTICS* Statistics
+    );
+
+//
+// Queries the receive statistics of the socket(s) serving one partition of a
+// UDP socket.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+CxPlatSocketGetUdpPartitionRecvStatistics(
+    _In_ CXPLAT_SOCKET* Socket,
+    _In_ uint16_t PartitionIndex,
+    _Out_ CXPLAT_UDP_RECV_STATISTICS* Statistics
+    );
+
 //
 // Function pointer type for datapath route resolution callbacks.
 //
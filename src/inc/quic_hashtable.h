@@ -11,6 +11,12 @@ Abstract:
     enumeration means enumeration that requires exclusive access to the table
     during the entire enumeration.
 
+    By default, entries are chained in buckets. A table initialized with
+    CxPlatHashtableInitializeOpen instead keeps pointers to its entries in
+    open addressed slots, next to a small tag of each one's hash, so a lookup
+    usually only touches the entries that match. Insertion into such a table
+    can fail (when it is full and can't grow); into a chained table it can't.
+
 Usage examples:
 
     void
@@ -85,6 +91,7 @@ extern "C" {
 #pragma warning(disable:4201)  // nonstandard extension used: nameless struct/union
 
 #define CXPLAT_HASH_ALLOCATED_HEADER 0x00000001
+#define CXPLAT_HASH_OPEN_ADDRESSING  0x00000002
 
 #define CXPLAT_HASH_MIN_SIZE 128
 
@@ -111,8 +118,21 @@ typedef struct CXPLAT_HASHTABLE_LOOKUP_CONTEXT {
     // 3. Signature is used primarily as a safety check in insertion. This field
     //    must match the Signature of the entry being inserted.
     //
-    CXPLAT_LIST_ENTRY* ChainHead;
-    CXPLAT_LIST_ENTRY* PrevLinkage;
+    // For open addressed tables, Open holds the position in the probe
+    // sequence instead.
+    //
+    union {
+        struct {
+            CXPLAT_LIST_ENTRY* ChainHead;
+            CXPLAT_LIST_ENTRY* PrevLinkage;
+        };
+        struct {
+            uint32_t GroupIndex;
+            uint32_t Probe;
+            uint32_t Matches;
+            BOOLEAN InOldGroups;
+        } Open;
+    };
     uint64_t Signature;
 } CXPLAT_HASHTABLE_LOOKUP_CONTEXT;
 
@@ -145,8 +165,16 @@ typedef struct CXPLAT_HASHTABLE {
         void* Directory;
         CXPLAT_LIST_ENTRY* SecondLevelDir; // When TableSize <= HT_SECOND_LEVEL_DIR_MIN_SIZE
         CXPLAT_LIST_ENTRY** FirstLevelDir; // When TableSize > HT_SECOND_LEVEL_DIR_MIN_SIZE
+        struct CXPLAT_HASHTABLE_GROUP* Groups; // CXPLAT_HASH_OPEN_ADDRESSING
     };
 
+    // Open addressing only. While the table is resized, the slots are moved
+    // from OldGroups a group at a time.
+    uint32_t UsedSlots; // Full or deleted slots in Groups
+    uint32_t OldTableSize;
+    uint32_t MigrateIndex;
+    struct CXPLAT_HASHTABLE_GROUP* OldGroups;
+
 } CXPLAT_HASHTABLE;
 
 _Must_inspect_result_
@@ -170,6 +198,30 @@ CxPlatHashtableInitializeEx(
     return CxPlatHashtableInitialize(&HashTable, InitialSize);
 }
 
+//
+// Creates an open addressed table. InitialSize is the number of slots.
+//
+_Must_inspect_result_
+_Success_(return != FALSE)
+BOOLEAN
+CxPlatHashtableInitializeOpen(
+    _Inout_ _When_(NULL == *HashTable, _At_(*HashTable, __drv_allocatesMem(Mem) _Post_notnull_))
+        CXPLAT_HASHTABLE** HashTable,
+    _In_ uint32_t InitialSize
+    );
+
+inline
+_Must_inspect_result_
+_Success_(return != FALSE)
+BOOLEAN
+CxPlatHashtableInitializeOpenEx(
+    _Inout_ CXPLAT_HASHTABLE* HashTable,
+    _In_ uint32_t InitialSize
+    )
+{
+    return CxPlatHashtableInitializeOpen(&HashTable, InitialSize);
+}
+
 void
 CxPlatHashtableUninitialize(
     _In_
@@ -178,7 +230,10 @@ CxPlatHashtableUninitialize(
         CXPLAT_HASHTABLE* HashTable
     );
 
-void
+//
+// Returns FALSE only if an open addressed table is full and couldn't grow.
+//
+BOOLEAN
 CxPlatHashtableInsert(
     _In_ CXPLAT_HASHTABLE* HashTable,
     _In_ __drv_aliasesMem CXPLAT_HASHTABLE_ENTRY* Entry,
@@ -148,6 +148,34 @@ typedef struct CXPLAT_SLIST_ENTRY {
 #define QUIC_POOL_ROUTE_RESOLUTION_WORKER   'A4cQ' // Qc4A - QUIC route resolution worker
 #define QUIC_POOL_ROUTE_RESOLUTION_OPER     'B4cQ' // Qc4B - QUIC route resolution operation
 #define QUIC_POOL_EXECUTION_CONFIG          'C4cQ' // Qc4C - QUIC execution config
+#define QUIC_POOL_SENT_PACKET_INDEX         'D4cQ' // Qc4D - QUIC sent packet index
+#define QUIC_POOL_SEND_MEMORY_REGIONS       'E4cQ' // Qc4E - QUIC registered send memory regions
+#define QUIC_POOL_DATAGRAM_RECV_BATCH       'F4cQ' // Qc4F - QUIC datagram receive batch
+#define QUIC_POOL_SENT_PACKET_ARENA         '05cQ' // Qc50 - QUIC sent packet metadata arena
+#define QUIC_POOL_TICKET_CACHE              '15cQ' // Qc51 - QUIC client resumption ticket cache
+#define QUIC_POOL_SOURCE_RATE               '25cQ' // Qc52 - QUIC per-source rate limit table
+#define QUIC_POOL_LISTENER_PARTITION        '35cQ' // Qc53 - QUIC per-partition listener state
+#define QUIC_POOL_LISTENER_LOCK             '45cQ' // Qc54 - QUIC per-partition binding listener locks
+#define QUIC_POOL_VER_NEG_TEMPLATE          '55cQ' // Qc55 - QUIC binding version negotiation template
+#define QUIC_POOL_STREAM_OPEN_BATCH         '65cQ' // Qc56 - QUIC stream open and send batch
+#define QUIC_POOL_STREAM_INDEX              '75cQ' // Qc57 - QUIC stream set direct index
+#define QUIC_POOL_STREAM_RECV_BATCH         '85cQ' // Qc58 - QUIC stream receive batch
+#define QUIC_POOL_STREAM_RECV_COMPLETE_BATCH '95cQ' // Qc59 - QUIC stream receive complete batch
+#define QUIC_POOL_EVENT_QUEUE               'A5cQ' // Qc5A - QUIC registration event queue
+#define QUIC_POOL_STREAM_GROUP              'B5cQ' // Qc5B - QUIC stream groups
+#define QUIC_POOL_LATENCY_HISTOGRAMS        'C5cQ' // Qc5C - QUIC connection latency histograms
+#define QUIC_POOL_QLOG                      'D5cQ' // Qc5D - QUIC worker qlog buffer
+#define QUIC_POOL_CAPTURE                   'E5cQ' // Qc5E - QUIC worker packet capture buffer
+#define QUIC_POOL_CAPTURE_SECRETS           'F5cQ' // Qc5F - QUIC connection packet capture secrets
+#define QUIC_POOL_NET_EMU                   '06cQ' // Qc60 - QUIC network emulation packet
+#define QUIC_POOL_LISTENER_SNI              '16cQ' // Qc61 - QUIC listener SNI configuration table
+#define QUIC_POOL_ROUTE_CACHE               '26cQ' // Qc62 - QUIC raw datapath route and neighbor cache
+#define QUIC_POOL_DATAGRAM_RELAY            '36cQ' // Qc63 - QUIC datagram UDP relay
+#define QUIC_POOL_DATAGRAM_RELAY_SEND       '46cQ' // Qc64 - QUIC datagram UDP relay send
+#define QUIC_POOL_ANTI_REPLAY               '56cQ' // Qc65 - QUIC 0-RTT anti-replay filter
+#define QUIC_POOL_DATAGRAM_FEC              '66cQ' // Qc66 - QUIC datagram FEC state
+#define QUIC_POOL_STANDBY_PATHS             '76cQ' // Qc76 - QUIC standby paths
+#define QUIC_POOL_STREAM_COMPRESS           '86cQ' // Qc68 - QUIC stream compression scratch
 
 typedef enum CXPLAT_THREAD_FLAGS {
     CXPLAT_THREAD_FLAG_NONE               = 0x0000,
@@ -433,12 +461,16 @@ typedef struct CXPLAT_WORKER_POOL {
     CXPLAT_LOCK WorkerLock;
     CXPLAT_RUNDOWN_REF Rundown;
     uint32_t WorkerCount;
+    BOOLEAN External; // Driven by the app's threads, instead of its own.
+    uint64_t StartTimeUs; // How long CxPlatWorkerPoolLazyStart took.
 
 } CXPLAT_WORKER_POOL;
 
 #ifdef _KERNEL_MODE // Not supported on kernel mode
 #define CxPlatWorkerPoolInit(WorkerPool) UNREFERENCED_PARAMETER(WorkerPool)
 #define CxPlatWorkerPoolUninit(WorkerPool) UNREFERENCED_PARAMETER(WorkerPool)
+#define CxPlatWorkerPoolGetEventQHandle(WorkerPool, Index, EventQ) QUIC_STATUS_NOT_SUPPORTED
+#define CxPlatWorkerPoolPoll(WorkerPool, Index, WaitTimeMs) UINT32_MAX
 #else
 void
 CxPlatWorkerPoolInit(
@@ -449,6 +481,27 @@ void
 CxPlatWorkerPoolUninit(
     _In_ CXPLAT_WORKER_POOL* WorkerPool
     );
+
+//
+// Gets the OS event queue of a worker of an externally driven worker pool.
+//
+QUIC_STATUS
+CxPlatWorkerPoolGetEventQHandle(
+    _In_ CXPLAT_WORKER_POOL* WorkerPool,
+    _In_ uint16_t Index, // Into the execution config processor array
+    _Out_ QUIC_EVENTQ* EventQ
+    );
+
+//
+// Runs one iteration of a worker of an externally driven worker pool, on the
+// calling thread. Returns the time (in ms) until it must be run again.
+//
+uint32_t
+CxPlatWorkerPoolPoll(
+    _In_ CXPLAT_WORKER_POOL* WorkerPool,
+    _In_ uint16_t Index, // Into the execution config processor array
+    _In_ uint32_t WaitTimeMs
+    );
 #endif
 
 //
@@ -528,7 +581,11 @@ typedef struct CXPLAT_EXECUTION_CONTEXT {
 #define CxPlatAddExecutionContext(WorkerPool, Context, IdealProcessor) CXPLAT_FRE_ASSERT(FALSE)
 #define CxPlatWakeExecutionContext(Context) CXPLAT_FRE_ASSERT(FALSE)
 #else
-void
+//
+// Starts the worker's thread if it isn't running yet. Returns FALSE if the
+// thread couldn't be created.
+//
+BOOLEAN
 CxPlatAddExecutionContext(
     _In_ CXPLAT_WORKER_POOL* WorkerPool,
     _Inout_ CXPLAT_EXECUTION_CONTEXT* Context,
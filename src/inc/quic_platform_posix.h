@@ -80,6 +80,8 @@ extern "C" {
 
 #define UNREFERENCED_PARAMETER(P) (void)(P)
 
+#define CxPlatPrefetch(Address) __builtin_prefetch((Address))
+
 #define QuicNetByteSwapShort(x) htons((x))
 
 #define SIZEOF_STRUCT_MEMBER(StructType, StructMember) sizeof(((StructType *)0)->StructMember)
@@ -196,6 +198,11 @@ InterlockedFetchAndSetBoolean(
     return __sync_fetch_and_or(Target, 1);
 }
 
+//
+// Full barrier: no load or store moves across it, in either direction.
+//
+#define CxPlatMemoryBarrier() __sync_synchronize()
+
 inline
 void*
 InterlockedExchangePointer(
@@ -206,6 +213,17 @@ InterlockedExchangePointer(
     return __sync_lock_test_and_set(Target, Value);
 }
 
+inline
+void*
+InterlockedCompareExchangePointer(
+    _Inout_ _Interlocked_operand_ void* volatile *Destination,
+    _In_opt_ void* ExChange,
+    _In_opt_ void* Comperand
+    )
+{
+    return __sync_val_compare_and_swap(Destination, Comperand, ExChange);
+}
+
 inline
 void*
 InterlockedFetchAndClearPointer(
@@ -252,6 +270,7 @@ InterlockedDecrement64(
 }
 
 #define QuicReadPtrNoFence(p) ((void*)(*p)) // TODO
+#define QuicReadPtrAcquire(p) ((void*)__atomic_load_n(p, __ATOMIC_ACQUIRE))
 
 //
 // Assertion interfaces.
@@ -316,6 +335,11 @@ CxPlatLogAssert(
 
 extern uint64_t CxPlatTotalMemory;
 
+//
+// How long the crypto/TLS provider took to initialize in CxPlatInitialize.
+//
+extern uint64_t CxPlatCryptInitTimeUs;
+
 _Ret_maybenull_
 void*
 CxPlatAlloc(
@@ -665,6 +689,34 @@ CxPlatTimeUs64(
     void
     );
 
+#ifdef QUIC_SIMULATION
+
+//
+// In simulation builds, CxPlatTimeUs64 reads a virtual clock that only moves
+// forward when CxPlatSimulationSetTime is called, and CxPlatRandom is seeded
+// from CxPlatSimulationSetSeed instead of the OS.
+//
+#define CXPLAT_SIMULATION_START_TIME_US (1000 * 1000 * 1000)
+
+//
+// Moves the virtual clock forward to TimeUs. Earlier times are ignored.
+// Returns the resulting time.
+//
+uint64_t
+CxPlatSimulationSetTime(
+    _In_ uint64_t TimeUs
+    );
+
+//
+// Reseeds every thread's random number generator from Seed.
+//
+void
+CxPlatSimulationSetSeed(
+    _In_ uint64_t Seed
+    );
+
+#endif
+
 void
 CxPlatGetAbsoluteTime(
     _In_ unsigned long DeltaMs,
@@ -676,6 +728,28 @@ CxPlatGetAbsoluteTime(
 #define CxPlatTimeMs32() (uint32_t)CxPlatTimeMs64()
 #define CxPlatTimeUs64ToPlat(x) (x)
 
+//
+// A cheap, monotonically increasing cycle count for timing short intervals.
+// ARM64 uses the virtual timer count instead, and other architectures fall
+// back to the microsecond clock.
+//
+#if defined(__x86_64__) || defined(__i386__)
+#define CxPlatCycleCount() __builtin_ia32_rdtsc()
+#elif defined(__aarch64__)
+inline
+uint64_t
+CxPlatCycleCount(
+    void
+    )
+{
+    uint64_t Count;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(Count));
+    return Count;
+}
+#else
+#define CxPlatCycleCount() CxPlatTimeUs64()
+#endif
+
 inline
 int64_t
 CxPlatTimeEpochMs64(
@@ -1055,6 +1129,41 @@ CxPlatEventQInitialize(
     return (*queue = epoll_create1(EPOLL_CLOEXEC)) != -1;
 }
 
+#include <sys/ioctl.h>
+#ifndef EPIOCSPARAMS
+//
+// Per epoll instance busy poll parameters (Linux 6.9+), for older headers.
+//
+struct epoll_params {
+    uint32_t busy_poll_usecs;
+    uint16_t busy_poll_budget;
+    uint8_t prefer_busy_poll;
+    uint8_t __pad;
+};
+#define EPIOCSPARAMS _IOW(0x8A, 0x01, struct epoll_params)
+#endif
+
+#define CXPLAT_EVENTQ_BUSY_POLL 1
+
+//
+// Configures waits on the queue to busy poll the NIC queues of the sockets
+// added to it, instead of sleeping until an interrupt arrives.
+//
+inline
+BOOLEAN
+CxPlatEventQSetBusyPoll(
+    _In_ CXPLAT_EVENTQ* queue,
+    _In_ uint32_t busy_poll_us,
+    _In_ uint16_t budget
+    )
+{
+    struct epoll_params params = {0};
+    params.busy_poll_usecs = busy_poll_us;
+    params.busy_poll_budget = budget;
+    params.prefer_busy_poll = 1;
+    return ioctl(*queue, EPIOCSPARAMS, &params) == 0;
+}
+
 inline
 void
 CxPlatEventQCleanup(
@@ -1337,11 +1446,29 @@ CxPlatCurThreadID(
 extern uint32_t CxPlatProcessorCount;
 #define CxPlatProcCount() CxPlatProcessorCount
 
+//
+// The processors the process may currently use (affinity mask and cgroup
+// cpuset, trimmed to the cgroup CPU quota), as indexes below
+// CxPlatProcCount(). Refreshed by each CxPlatInitialize.
+//
+extern uint32_t CxPlatProcessorAvailableCount;
+extern uint16_t* CxPlatProcessorAvailableList;
+#define CxPlatProcAvailableCount() CxPlatProcessorAvailableCount
+#define CxPlatProcAvailableIndex(i) CxPlatProcessorAvailableList[i]
+
 uint32_t
 CxPlatProcCurrentNumber(
     void
     );
 
+//
+// Returns the NUMA node of the processor, or zero if unknown.
+//
+uint16_t
+CxPlatProcNumaNode(
+    _In_ uint32_t Index
+    );
+
 //
 // Rundown Protection Interfaces.
 //
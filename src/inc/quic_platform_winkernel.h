@@ -97,6 +97,8 @@ ZwQueryInformationThread (
 
 #define QUIC_CACHEALIGN DECLSPEC_CACHEALIGN
 
+#define CxPlatPrefetch(Address) PreFetchCacheLine(PF_TEMPORAL_LEVEL_1, (Address))
+
 #define INIT_NO_SAL(X) // No-op since Windows supports SAL
 
 //
@@ -130,6 +132,11 @@ InterlockedFetchAndSetBoolean(
     return (BOOLEAN)InterlockedOr8((char*)Target, 1);
 }
 
+//
+// Full barrier: no load or store moves across it, in either direction.
+//
+#define CxPlatMemoryBarrier() KeMemoryBarrier()
+
 //
 // Static Analysis Interfaces
 //
@@ -250,6 +257,11 @@ CxPlatLogAssert(
 
 extern uint64_t CxPlatTotalMemory;
 
+//
+// How long the crypto/TLS provider took to initialize in CxPlatInitialize.
+//
+extern uint64_t CxPlatCryptInitTimeUs;
+
 #define CXPLAT_ALLOC_PAGED(Size, Tag) ExAllocatePool2(POOL_FLAG_PAGED | POOL_FLAG_UNINITIALIZED, Size, Tag)
 #define CXPLAT_ALLOC_NONPAGED(Size, Tag) ExAllocatePool2(POOL_FLAG_NON_PAGED | POOL_FLAG_UNINITIALIZED, Size, Tag)
 #define CXPLAT_FREE(Mem, Tag) ExFreePoolWithTag((void*)Mem, Tag)
@@ -352,6 +364,7 @@ typedef struct CXPLAT_DISPATCH_RW_LOCK {
 #define QuicReadLongPtrNoFence ReadNoFence
 #endif
 #define QuicReadPtrNoFence ReadPointerNoFence
+#define QuicReadPtrAcquire ReadPointerAcquire
 
 typedef LONG_PTR CXPLAT_REF_COUNT;
 
@@ -623,6 +636,16 @@ CxPlatTimeUs64ToPlat(
 #define CxPlatTimeMs64() US_TO_MS(CxPlatTimeUs64())
 #define CxPlatTimeMs32() (uint32_t)CxPlatTimeMs64()
 
+//
+// A cheap, monotonically increasing cycle count for timing short intervals.
+// Falls back to the performance counter where there's no cycle counter.
+//
+#ifdef _M_X64
+#define CxPlatCycleCount() __rdtsc()
+#else
+#define CxPlatCycleCount() QuicTimePlat()
+#endif
+
 #define UNIX_EPOCH_AS_FILE_TIME 0x19db1ded53e8000ll
 
 inline
@@ -888,8 +911,34 @@ typedef ULONG_PTR CXPLAT_THREAD_ID;
 
 extern uint32_t CxPlatProcessorCount;
 #define CxPlatProcCount() CxPlatProcessorCount
+#define CxPlatProcAvailableCount() CxPlatProcessorCount
+#define CxPlatProcAvailableIndex(i) ((uint16_t)(i))
 #define CxPlatProcCurrentNumber() (KeGetCurrentProcessorIndex() % CxPlatProcessorCount)
 
+//
+// Returns the NUMA node of the processor, or zero if unknown.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+inline
+uint16_t
+CxPlatProcNumaNode(
+    _In_ uint32_t Index
+    ) {
+    PROCESSOR_NUMBER Processor;
+    SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX Info;
+    ULONG InfoLength = sizeof(Info);
+    if (!NT_SUCCESS(KeGetProcessorNumberFromIndex(Index, &Processor)) ||
+        !NT_SUCCESS(
+            KeQueryLogicalProcessorRelationship(
+                &Processor,
+                RelationNumaNode,
+                &Info,
+                &InfoLength))) {
+        return 0;
+    }
+    return (uint16_t)Info.NumaNode.NodeNumber;
+}
+
 //
 // Rundown Protection Interfaces
 //
@@ -72,6 +72,8 @@ extern "C" {
 
 #define QUIC_CACHEALIGN DECLSPEC_CACHEALIGN
 
+#define CxPlatPrefetch(Address) PreFetchCacheLine(PF_TEMPORAL_LEVEL_1, (Address))
+
 #define ALIGN_DOWN(length, type) \
     ((ULONG)(length) & ~(sizeof(type) - 1))
 
@@ -253,6 +255,11 @@ InterlockedFetchAndSetBoolean(
     return (BOOLEAN)InterlockedOr8((char*)Target, 1);
 }
 
+//
+// Full barrier: no load or store moves across it, in either direction.
+//
+#define CxPlatMemoryBarrier() MemoryBarrier()
+
 //
 // CloseHandle has an incorrect SAL annotation, so call through a wrapper.
 //
@@ -269,6 +276,11 @@ CxPlatCloseHandle(_Pre_notnull_ HANDLE Handle) {
 
 extern uint64_t CxPlatTotalMemory;
 
+//
+// How long the crypto/TLS provider took to initialize in CxPlatInitialize.
+//
+extern uint64_t CxPlatCryptInitTimeUs;
+
 _Ret_maybenull_
 _Post_writable_byte_size_(ByteCount)
 DECLSPEC_ALLOCATOR
@@ -566,8 +578,10 @@ typedef SRWLOCK CXPLAT_DISPATCH_RW_LOCK;
 
 #ifdef QUIC_RESTRICTED_BUILD
 #define QuicReadPtrNoFence(p) ((void*)(*p))
+#define QuicReadPtrAcquire(p) ((void*)(*(void* volatile*)(p)))
 #else
 #define QuicReadPtrNoFence ReadPointerNoFence
+#define QuicReadPtrAcquire ReadPointerAcquire
 #endif
 
 typedef LONG_PTR CXPLAT_REF_COUNT;
@@ -918,6 +932,16 @@ CxPlatTimeUs64ToPlat(
 #define CxPlatTimeMs64() US_TO_MS(CxPlatTimeUs64())
 #define CxPlatTimeMs32() (uint32_t)CxPlatTimeMs64()
 
+//
+// A cheap, monotonically increasing cycle count for timing short intervals.
+// Falls back to the performance counter where there's no cycle counter.
+//
+#ifdef _M_X64
+#define CxPlatCycleCount() __rdtsc()
+#else
+#define CxPlatCycleCount() QuicTimePlat()
+#endif
+
 #define UNIX_EPOCH_AS_FILE_TIME 0x19db1ded53e8000ll
 
 inline
@@ -1019,6 +1043,8 @@ extern CXPLAT_PROCESSOR_GROUP_INFO* CxPlatProcessorGroupInfo;
 
 extern uint32_t CxPlatProcessorCount;
 #define CxPlatProcCount() CxPlatProcessorCount
+#define CxPlatProcAvailableCount() CxPlatProcessorCount
+#define CxPlatProcAvailableIndex(i) ((uint16_t)(i))
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
 inline
@@ -1032,6 +1058,26 @@ CxPlatProcCurrentNumber(
     return Group->Offset + (ProcNumber.Number % Group->Count);
 }
 
+//
+// Returns the NUMA node of the processor, or zero if unknown.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+inline
+uint16_t
+CxPlatProcNumaNode(
+    _In_ uint32_t Index
+    ) {
+    PROCESSOR_NUMBER ProcNumber;
+    ProcNumber.Group = CxPlatProcessorInfo[Index].Group;
+    ProcNumber.Number = CxPlatProcessorInfo[Index].Index;
+    ProcNumber.Reserved = 0;
+    USHORT NodeNumber;
+    if (!GetNumaProcessorNodeEx(&ProcNumber, &NodeNumber) || NodeNumber == MAXUSHORT) {
+        return 0;
+    }
+    return (uint16_t)NodeNumber;
+}
+
 
 //
 // Create Thread Interfaces
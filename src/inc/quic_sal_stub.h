@@ -131,6 +131,10 @@
 #define _Out_writes_bytes_to_opt_(...)
 #endif
 
+#ifndef _Out_writes_bytes_to_
+#define _Out_writes_bytes_to_(...)
+#endif
+
 #ifndef _Deref_pre_opt_count_
 #define _Deref_pre_opt_count_(...)
 #endif
@@ -235,6 +239,10 @@
 #define _Out_writes_(...)
 #endif
 
+#ifndef _Out_writes_opt_
+#define _Out_writes_opt_(...)
+#endif
+
 #ifndef _Field_z_
 #define _Field_z_
 #endif
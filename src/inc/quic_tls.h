@@ -136,6 +136,13 @@ typedef struct CXPLAT_TLS_CALLBACKS {
     //
     CXPLAT_TLS_PEER_CERTIFICATE_RECEIVED_CALLBACK_HANDLER CertificateReceived;
 
+    //
+    // Invoked, possibly on another thread, when processing that returned
+    // CXPLAT_TLS_RESULT_PENDING can be resumed by calling CxPlatTlsProcessData
+    // again with no new data.
+    //
+    CXPLAT_TLS_PROCESS_COMPLETE_CALLBACK_HANDLER ProcessComplete;
+
 } CXPLAT_TLS_CALLBACKS;
 
 //
@@ -212,6 +219,7 @@ typedef enum CXPLAT_TLS_RESULT_FLAGS {
     CXPLAT_TLS_RESULT_EARLY_DATA_ACCEPT   = 0x0010, // The server accepted the early (0-RTT) data.
     CXPLAT_TLS_RESULT_EARLY_DATA_REJECT   = 0x0020, // The server rejected the early (0-RTT) data.
     CXPLAT_TLS_RESULT_HANDSHAKE_COMPLETE  = 0x0040, // Handshake complete.
+    CXPLAT_TLS_RESULT_PENDING             = 0x0080, // Processing is suspended until ProcessComplete is invoked.
     CXPLAT_TLS_RESULT_ERROR               = 0x8000  // An error occured.
 
 } CXPLAT_TLS_RESULT_FLAGS;
@@ -43,6 +43,14 @@ extern "C" {
 //
 #define CXPLAT_TOEPLITZ_LOOKUP_TABLE_COUNT    (CXPLAT_TOEPLITZ_INPUT_SIZE * NIBBLES_PER_BYTE)
 
+//
+// On x64 the hash can be computed eight bytes at a time with carry-less
+// multiplication (PCLMULQDQ), if the processor supports it.
+//
+#if (defined(_M_X64) || defined(__x86_64__)) && !defined(_KERNEL_MODE)
+#define CXPLAT_TOEPLITZ_CLMUL 1
+#endif
+
 typedef struct CXPLAT_TOEPLITZ_LOOKUP_TABLE {
     uint32_t Table[CXPLAT_TOEPLITZ_LOOKUP_TABLE_SIZE];
 } CXPLAT_TOEPLITZ_LOOKUP_TABLE;
@@ -50,6 +58,9 @@ typedef struct CXPLAT_TOEPLITZ_LOOKUP_TABLE {
 typedef struct CXPLAT_TOEPLITZ_HASH {
     CXPLAT_TOEPLITZ_LOOKUP_TABLE LookupTableArray[CXPLAT_TOEPLITZ_LOOKUP_TABLE_COUNT];
     uint8_t HashKey[CXPLAT_TOEPLITZ_KEY_SIZE];
+#ifdef CXPLAT_TOEPLITZ_CLMUL
+    BOOLEAN UseClmul; // Set by CxPlatToeplitzHashInitialize
+#endif
 } CXPLAT_TOEPLITZ_HASH;
 
 //
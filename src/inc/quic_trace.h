@@ -29,6 +29,9 @@ Abstract:
 
     QUIC_CLOG                   Bypasses these mechanisms and uses CLOG to generate logging
 
+    Independently of these, QUIC_USDT adds Linux USDT (SystemTap SDT) probes at
+    a few hot path points, for eBPF tools such as bpftrace.
+
  --*/
 
 #pragma once
@@ -103,6 +106,13 @@ typedef enum QUIC_TRACE_API_TYPE {
     QUIC_TRACE_API_DATAGRAM_SEND,
     QUIC_TRACE_API_CONNECTION_COMPLETE_RESUMPTION_TICKET_VALIDATION,
     QUIC_TRACE_API_CONNECTION_COMPLETE_CERTIFICATE_VALIDATION,
+    QUIC_TRACE_API_STREAM_PROVIDE_RECEIVE_BUFFERS,
+    QUIC_TRACE_API_DATAGRAM_SEND_BATCH,
+    QUIC_TRACE_API_STREAM_OPEN_AND_SEND,
+    QUIC_TRACE_API_STREAM_RECEIVE_COMPLETE_BATCH,
+    QUIC_TRACE_API_STREAM_RECEIVE,
+    QUIC_TRACE_API_REGISTRATION_POLL_EVENTS,
+    QUIC_TRACE_API_STREAM_SEND_BATCH,
     QUIC_TRACE_API_COUNT // Must be last
 } QUIC_TRACE_API_TYPE;
 
@@ -369,3 +379,48 @@ QuicEtwCallback(
 #endif // QUIC_LOGS_MANIFEST_ETW
 
 #endif // QUIC_CLOG
+
+//
+// USDT probes. Each probe has a semaphore that the kernel increments while a
+// tracer is attached to it, so when nothing is attached a probe costs a single
+// predictable branch, and its arguments aren't even evaluated.
+//
+#ifdef QUIC_USDT
+
+#define SDT_USE_VARIADIC 1
+#define _SDT_HAS_SEMAPHORES 1
+#include <sys/sdt.h>
+
+#define QUIC_USDT_SEMAPHORE(Name) msquic_##Name##_semaphore
+
+#define QUIC_USDT_DECLARE(Name) \
+    extern volatile unsigned short QUIC_USDT_SEMAPHORE(Name)
+
+#define QUIC_USDT_DEFINE(Name) \
+    volatile unsigned short QUIC_USDT_SEMAPHORE(Name) __attribute__((section(".probes"))) = 0
+
+#define QuicUsdtProbe(Name, ...)                                               \
+    do {                                                                       \
+        if (__builtin_expect(QUIC_USDT_SEMAPHORE(Name) != 0, 0)) {             \
+            STAP_PROBEV(msquic, Name, ##__VA_ARGS__);                          \
+        }                                                                      \
+    } while (0)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+QUIC_USDT_DECLARE(packet_sent);         // Connection, PacketNumber, QUIC_TRACE_PACKET_TYPE, Length
+QUIC_USDT_DECLARE(packet_recv);         // Connection, PacketNumber, QUIC_TRACE_PACKET_TYPE, Length
+QUIC_USDT_DECLARE(packet_lost);         // Connection, PacketNumber, QUIC_TRACE_PACKET_TYPE, QUIC_TRACE_PACKET_LOSS_REASON
+QUIC_USDT_DECLARE(congestion_window);   // Connection, CongestionWindow, BytesInFlightMax
+QUIC_USDT_DECLARE(oper_queue);          // Connection, QUIC_OPERATION_TYPE
+QUIC_USDT_DECLARE(oper_dequeue);        // Connection, QUIC_OPERATION_TYPE
+#ifdef __cplusplus
+}
+#endif
+
+#else
+
+#define QuicUsdtProbe(Name, ...)
+
+#endif // QUIC_USDT
@@ -118,35 +118,41 @@ QuicVarIntDecode(
     if (BufferLength < sizeof(uint8_t) + *Offset) {
         return FALSE;
     }
-    if (Buffer[*Offset] < 0x40) {
-        *Value = Buffer[*Offset];
+    const uint8_t* Start = Buffer + *Offset;
+    if (Start[0] < 0x40) {
+        //
+        // Single byte encodings (frame types, small IDs and lengths) are by far
+        // the most common, so handle them first without any further work.
+        //
+        *Value = Start[0];
         CXPLAT_ANALYSIS_ASSERT(*Value < 0x100ULL);
         *Offset += sizeof(uint8_t);
-    } else if (Buffer[*Offset] < 0x80) {
-        if (BufferLength < sizeof(uint16_t) + *Offset) {
-            return FALSE;
-        }
-        *Value = ((uint64_t)(Buffer[*Offset] & 0x3fUL)) << 8;
-        *Value |= Buffer[*Offset + 1];
+        return TRUE;
+    }
+
+    //
+    // The top two bits encode the log2 of the length, so a single bounds check
+    // covers all the multi-byte encodings.
+    //
+    const uint16_t Length = (uint16_t)(1 << (Start[0] >> 6));
+    if (BufferLength < Length + *Offset) {
+        return FALSE;
+    }
+    if (Length == sizeof(uint16_t)) {
+        uint16_t v;
+        memcpy(&v, Start, sizeof(uint16_t));
+        *Value = CxPlatByteSwapUint16(v) & 0x3fffU;
         CXPLAT_ANALYSIS_ASSERT(*Value < 0x10000ULL);
-        *Offset += sizeof(uint16_t);
-    } else if (Buffer[*Offset] < 0xc0) {
-        if (BufferLength < sizeof(uint32_t) + *Offset) {
-            return FALSE;
-        }
+    } else if (Length == sizeof(uint32_t)) {
         uint32_t v;
-        memcpy(&v, Buffer + *Offset, sizeof(uint32_t));
+        memcpy(&v, Start, sizeof(uint32_t));
         *Value = CxPlatByteSwapUint32(v) & 0x3fffffffUL;
         CXPLAT_ANALYSIS_ASSERT(*Value < 0x100000000ULL);
-        *Offset += sizeof(uint32_t);
     } else {
-        if (BufferLength < sizeof(uint64_t) + *Offset) {
-            return FALSE;
-        }
         uint64_t v;
-        memcpy(&v, Buffer + *Offset, sizeof(uint64_t));
+        memcpy(&v, Start, sizeof(uint64_t));
         *Value = CxPlatByteSwapUint64(v) & 0x3fffffffffffffffULL;
-        *Offset += sizeof(uint64_t);
     }
+    *Offset += Length;
     return TRUE;
 }
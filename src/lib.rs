@@ -13,6 +13,8 @@ use std::convert::TryInto;
 use std::fmt;
 use std::option::Option;
 use std::ptr;
+use std::slice;
+use std::sync::{Arc, Mutex, Weak};
 #[macro_use]
 extern crate bitfield;
 
@@ -100,6 +102,13 @@ impl Addr {
     }
 }
 
+/// Status codes returned from event callbacks.
+pub const STATUS_SUCCESS: u32 = 0;
+#[cfg(target_os = "windows")]
+pub const STATUS_PENDING: u32 = 0x703e5;
+#[cfg(not(target_os = "windows"))]
+pub const STATUS_PENDING: u32 = -2i32 as u32;
+
 /// Helper for processing MsQuic return statuses.
 pub struct Status {}
 
@@ -225,7 +234,9 @@ pub const SEND_RESUMPTION_FLAG_FINAL: SendResumptionFlags = 1;
 pub type StreamSchedulingScheme = u32;
 pub const STREAM_SCHEDULING_SCHEME_FIFO: StreamSchedulingScheme = 0;
 pub const STREAM_SCHEDULING_SCHEME_ROUND_ROBIN: StreamSchedulingScheme = 1;
-pub const STREAM_SCHEDULING_SCHEME_COUNT: StreamSchedulingScheme = 2;
+pub const STREAM_SCHEDULING_SCHEME_WEIGHTED_FAIR: StreamSchedulingScheme = 2;
+pub const STREAM_SCHEDULING_SCHEME_EXTENSIBLE_PRIORITY: StreamSchedulingScheme = 3;
+pub const STREAM_SCHEDULING_SCHEME_COUNT: StreamSchedulingScheme = 4;
 
 pub type StreamOpenFlags = u32;
 pub const STREAM_OPEN_FLAG_NONE: StreamOpenFlags = 0;
@@ -1193,6 +1204,31 @@ impl From<Buffer> for Vec<u8> {
     }
 }
 
+impl Buffer {
+    /// Borrows the buffer's contents without copying.
+    ///
+    /// # Safety
+    /// The memory must stay valid and unmodified for the lifetime `'a`.
+    pub unsafe fn as_slice<'a>(&self) -> &'a [u8] {
+        if self.length == 0 {
+            &[]
+        } else {
+            slice::from_raw_parts(self.buffer, self.length as usize)
+        }
+    }
+}
+
+impl StreamEventReceive {
+    /// The received buffers, valid for as long as the event is borrowed.
+    pub fn buffers(&self) -> &[Buffer] {
+        if self.buffer_count == 0 {
+            &[]
+        } else {
+            unsafe { slice::from_raw_parts(self.buffer, self.buffer_count as usize) }
+        }
+    }
+}
+
 impl QuicPerformance {
     pub fn counter(&self, counter: PerformanceCounter) -> i64 {
         self.counters[counter as usize]
@@ -1702,6 +1738,24 @@ impl Stream {
         }
     }
 
+    /// Sends an owned buffer without copying it. The buffer is returned in
+    /// STREAM_EVENT_SEND_COMPLETE via `SendBuffer::from_send_complete`.
+    pub fn send_owned(&self, buffer: SendBuffer, flags: SendFlags) {
+        let (buffer, client_send_context) = buffer.into_raw();
+        let status = unsafe {
+            ((*self.table).stream_send)(self.handle, buffer, 1, flags, client_send_context)
+        };
+        if Status::failed(status) {
+            drop(unsafe {
+                SendBuffer::from_send_complete(&StreamEventSendComplete {
+                    canceled: true,
+                    client_context: client_send_context,
+                })
+            });
+            panic!("StreamSend failure 0x{:x}", status);
+        }
+    }
+
     pub fn set_callback_handler(&self, handler: StreamEventHandler, context: *const c_void) {
         unsafe {
             ((*self.table).set_callback_handler)(self.handle, handler as *const c_void, context)
@@ -1715,6 +1769,222 @@ impl Drop for Stream {
     }
 }
 
+/// Zero-copy view of the data in a STREAM_EVENT_RECEIVE.
+///
+/// The slices borrow MsQuic's receive buffers directly. When the guard is
+/// dropped it reports the consumed length via StreamReceiveComplete, so the
+/// stream callback must return `STATUS_PENDING` after creating one. Any
+/// unconsumed data is indicated again in a later receive event.
+pub struct ReceiveGuard<'a> {
+    table: *const ApiTable,
+    handle: Handle,
+    receive: &'a StreamEventReceive,
+    consumed: u64,
+}
+
+impl<'a> ReceiveGuard<'a> {
+    /// Creates a guard for the receive event passed to a stream callback.
+    /// By default all the received data is considered consumed.
+    pub fn new(api: &Api, stream: Handle, event: &'a StreamEvent) -> ReceiveGuard<'a> {
+        if event.event_type != STREAM_EVENT_RECEIVE {
+            panic!("ReceiveGuard requires a receive event, not {}", event.event_type);
+        }
+        let receive = unsafe { &event.payload.receive };
+        ReceiveGuard {
+            table: api.table,
+            handle: stream,
+            receive,
+            consumed: receive.total_buffer_length,
+        }
+    }
+
+    /// The stream offset of the first received byte.
+    pub fn offset(&self) -> u64 {
+        self.receive.absolute_offset
+    }
+
+    pub fn flags(&self) -> ReceiveFlags {
+        self.receive.flags
+    }
+
+    pub fn len(&self) -> u64 {
+        self.receive.total_buffer_length
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.receive.total_buffer_length == 0
+    }
+
+    /// Iterates over the received data without copying it.
+    pub fn slices(&self) -> impl Iterator<Item = &'a [u8]> + 'a {
+        let receive: &'a StreamEventReceive = self.receive;
+        receive.buffers().iter().map(|buffer| unsafe { buffer.as_slice() })
+    }
+
+    /// Sets how many bytes (from the start) have been consumed.
+    pub fn consume(&mut self, length: u64) {
+        if length > self.receive.total_buffer_length {
+            panic!(
+                "Consumed {} bytes of a {} byte receive",
+                length, self.receive.total_buffer_length
+            );
+        }
+        self.consumed = length;
+    }
+}
+
+impl Drop for ReceiveGuard<'_> {
+    fn drop(&mut self) {
+        unsafe { ((*self.table).stream_receive_complete)(self.handle, self.consumed) };
+    }
+}
+
+struct SendBufferInner {
+    buffer: Buffer,
+    data: Vec<u8>,
+    pool: Weak<Mutex<Vec<Box<SendBufferInner>>>>,
+}
+
+type SendBufferFreeList = Arc<Mutex<Vec<Box<SendBufferInner>>>>;
+
+/// An owned buffer that is handed to MsQuic by `Stream::send_owned` and
+/// handed back in STREAM_EVENT_SEND_COMPLETE. The `Buffer` descriptor and
+/// data live in one heap allocation whose address does not change while the
+/// send is in flight. Pooled buffers return to their pool when dropped.
+pub struct SendBuffer {
+    inner: Option<Box<SendBufferInner>>,
+}
+
+impl SendBuffer {
+    pub fn new(capacity: usize) -> SendBuffer {
+        SendBuffer {
+            inner: Some(SendBuffer::alloc(capacity, Weak::new())),
+        }
+    }
+
+    fn alloc(
+        capacity: usize,
+        pool: Weak<Mutex<Vec<Box<SendBufferInner>>>>,
+    ) -> Box<SendBufferInner> {
+        let mut inner = Box::new(SendBufferInner {
+            buffer: Buffer {
+                length: 0,
+                buffer: ptr::null_mut(),
+            },
+            data: vec![0; capacity],
+            pool,
+        });
+        inner.buffer.buffer = inner.data.as_mut_ptr();
+        inner
+    }
+
+    fn inner(&self) -> &SendBufferInner {
+        self.inner.as_ref().unwrap()
+    }
+
+    fn inner_mut(&mut self) -> &mut SendBufferInner {
+        self.inner.as_mut().unwrap()
+    }
+
+    pub fn capacity(&self) -> usize {
+        self.inner().data.len()
+    }
+
+    /// The number of bytes that will be sent.
+    pub fn len(&self) -> usize {
+        self.inner().buffer.length as usize
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.len() == 0
+    }
+
+    pub fn set_len(&mut self, length: usize) {
+        if length > self.capacity() {
+            panic!("SendBuffer length {} exceeds capacity {}", length, self.capacity());
+        }
+        self.inner_mut().buffer.length = length as u32;
+    }
+
+    /// The whole writable capacity; call `set_len` after filling it.
+    pub fn as_mut_slice(&mut self) -> &mut [u8] {
+        &mut self.inner_mut().data
+    }
+
+    pub fn as_slice(&self) -> &[u8] {
+        &self.inner().data[..self.len()]
+    }
+
+    /// Copies `data` into the buffer, replacing its contents.
+    pub fn fill(&mut self, data: &[u8]) {
+        self.set_len(data.len());
+        self.inner_mut().data[..data.len()].copy_from_slice(data);
+    }
+
+    /// Reclaims the buffer passed to `Stream::send_owned` once MsQuic is done
+    /// with it.
+    ///
+    /// # Safety
+    /// The send's client context must have come from `Stream::send_owned`,
+    /// and each completion may only be reclaimed once.
+    pub unsafe fn from_send_complete(event: &StreamEventSendComplete) -> SendBuffer {
+        SendBuffer {
+            inner: Some(Box::from_raw(event.client_context as *mut SendBufferInner)),
+        }
+    }
+
+    /// Hands ownership to MsQuic, returning the descriptor to send and the
+    /// matching client send context.
+    fn into_raw(mut self) -> (*const Buffer, *const c_void) {
+        let inner = Box::into_raw(self.inner.take().unwrap());
+        (unsafe { &(*inner).buffer as *const Buffer }, inner as *const c_void)
+    }
+}
+
+impl Drop for SendBuffer {
+    fn drop(&mut self) {
+        if let Some(mut inner) = self.inner.take() {
+            if let Some(pool) = inner.pool.upgrade() {
+                inner.buffer.length = 0;
+                pool.lock().unwrap().push(inner);
+            }
+        }
+    }
+}
+
+/// A pool of fixed size `SendBuffer`s. Buffers are recycled when dropped, so
+/// steady state sends do not allocate data buffers. The pool grows on demand.
+#[derive(Clone)]
+pub struct SendBufferPool {
+    free: SendBufferFreeList,
+    buffer_size: usize,
+}
+
+impl SendBufferPool {
+    pub fn new(buffer_size: usize, initial_count: usize) -> SendBufferPool {
+        let free: SendBufferFreeList = Arc::new(Mutex::new(Vec::with_capacity(initial_count)));
+        for _ in 0..initial_count {
+            let inner = SendBuffer::alloc(buffer_size, Arc::downgrade(&free));
+            free.lock().unwrap().push(inner);
+        }
+        SendBufferPool { free, buffer_size }
+    }
+
+    pub fn acquire(&self) -> SendBuffer {
+        let inner = self.free.lock().unwrap().pop();
+        SendBuffer {
+            inner: Some(inner.unwrap_or_else(|| {
+                SendBuffer::alloc(self.buffer_size, Arc::downgrade(&self.free))
+            })),
+        }
+    }
+
+    /// The number of buffers currently available without allocating.
+    pub fn available(&self) -> usize {
+        self.free.lock().unwrap().len()
+    }
+}
+
 //
 // The following defines some simple test code.
 //
@@ -1807,3 +2077,25 @@ fn test_module() {
     let duration = std::time::Duration::from_millis(1000);
     std::thread::sleep(duration);
 }
+
+#[test]
+fn test_send_buffer_pool() {
+    let pool = SendBufferPool::new(16, 2);
+    let mut buffer = pool.acquire();
+    assert_eq!(pool.available(), 1);
+    buffer.fill(b"hello");
+    assert_eq!(buffer.as_slice(), b"hello");
+
+    let (descriptor, client_context) = buffer.into_raw();
+    assert_eq!(unsafe { (*descriptor).length }, 5);
+    let buffer = unsafe {
+        SendBuffer::from_send_complete(&StreamEventSendComplete {
+            canceled: false,
+            client_context,
+        })
+    };
+    assert_eq!(buffer.as_slice(), b"hello");
+    drop(buffer);
+    assert_eq!(pool.available(), 2);
+    assert!(pool.acquire().is_empty());
+}
@@ -11,6 +11,7 @@ Abstract:
 
 #include "SecNetPerf.h"
 #include "LatencyHelpers.h"
+#include "coordinator.h"
 #include "histogram/hdr_histogram.h"
 
 #ifdef _WIN32
@@ -304,7 +305,12 @@ main(
     const char* FileName = nullptr;
     TryGetValue(argc, argv, "extraOutputFile", &FileName);
 
-    if (!TryGetTarget(argc, argv)) { // Only create certificate on server
+    const char* Agents = nullptr;
+    uint8_t AgentMode = FALSE;
+    TryGetValue(argc, argv, "agents", &Agents);
+    TryGetValue(argc, argv, "agent", &AgentMode);
+
+    if (!TryGetTarget(argc, argv) && !AgentMode) { // Only create certificate on server
         SelfSignedCredConfig =
             CxPlatGetSelfSignedCert(CXPLAT_SELF_SIGN_CERT_USER, FALSE, NULL);
         if (!SelfSignedCredConfig) {
@@ -319,7 +325,11 @@ main(
         SelfSignedCredConfig->AllowedCipherSuites = (QUIC_ALLOWED_CIPHER_SUITE_FLAGS)CipherSuite;
     }
 
-    if (DriverName != nullptr) {
+    if (Agents != nullptr) {
+        Status = QuicCoordinatorMain(argc, argv, Agents, FileName);
+    } else if (AgentMode) {
+        Status = QuicAgentMain(argc, argv);
+    } else if (DriverName != nullptr) {
 #if defined(_WIN32) && !defined(QUIC_RESTRICTED_BUILD)
         printf("Entering kernel mode main\n");
         Status = QuicKernelMain(argc, argv, SelfSignedCredConfig, PrivateTestLibrary, DriverName, FileName);
@@ -0,0 +1,484 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Distributed secnetperf runs. The control connections are plain TCP, so they
+    don't need (or change) any MsQuic state, and an agent can run each client
+    with its own execution config.
+
+    The coordinator only starts the agents once every one of them has set up
+    its client, and then sends all the start messages back to back, so the
+    clients start within a control round trip of each other.
+
+--*/
+
+#include "SecNetPerf.h"
+#include "coordinator.h"
+
+#include <vector>
+#include <string>
+
+#ifdef _WIN32
+#include <ws2tcpip.h>
+#else
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <netdb.h>
+#include <unistd.h>
+#define closesocket close
+#endif
+
+static
+bool
+SendAll(
+    _In_ SOCKET Socket,
+    _In_reads_bytes_(Length) const uint8_t* Data,
+    _In_ size_t Length
+    )
+{
+    while (Length != 0) {
+        const int Chunk = (int)CXPLAT_MIN(Length, (size_t)0x40000000);
+        const int Sent = (int)send(Socket, (const char*)Data, Chunk, 0);
+        if (Sent <= 0) {
+            return false;
+        }
+        Data += Sent;
+        Length -= (size_t)Sent;
+    }
+    return true;
+}
+
+static
+bool
+RecvAll(
+    _In_ SOCKET Socket,
+    _Out_writes_bytes_(Length) uint8_t* Data,
+    _In_ size_t Length
+    )
+{
+    while (Length != 0) {
+        const int Chunk = (int)CXPLAT_MIN(Length, (size_t)0x40000000);
+        const int Received = (int)recv(Socket, (char*)Data, Chunk, 0);
+        if (Received <= 0) {
+            return false;
+        }
+        Data += Received;
+        Length -= (size_t)Received;
+    }
+    return true;
+}
+
+static
+bool
+SendControl(
+    _In_ SOCKET Socket,
+    _In_ PERF_CONTROL_TYPE Type,
+    _In_reads_bytes_opt_(Length) const void* Data,
+    _In_ uint32_t Length
+    )
+{
+    const PERF_CONTROL_HEADER Header = { (uint32_t)Type, Length };
+    return
+        SendAll(Socket, (const uint8_t*)&Header, sizeof(Header)) &&
+        (Length == 0 || SendAll(Socket, (const uint8_t*)Data, Length));
+}
+
+static
+bool
+RecvControl(
+    _In_ SOCKET Socket,
+    _In_ PERF_CONTROL_TYPE Type,
+    _Out_ std::vector<uint8_t>& Data
+    )
+{
+    PERF_CONTROL_HEADER Header;
+    if (!RecvAll(Socket, (uint8_t*)&Header, sizeof(Header)) || Header.Type != (uint32_t)Type) {
+        return false;
+    }
+    Data.resize(Header.Length);
+    return Header.Length == 0 || RecvAll(Socket, Data.data(), Header.Length);
+}
+
+static
+void
+SetNoDelay(
+    _In_ SOCKET Socket
+    )
+{
+    int Option = 1;
+    (void)setsockopt(Socket, IPPROTO_TCP, TCP_NODELAY, (const char*)&Option, sizeof(Option));
+}
+
+//
+// Runs a single client for a coordinator: sets it up, reports whether that
+// worked, waits for the start message and sends back the results.
+//
+static
+void
+RunAgentClient(
+    _In_ SOCKET Control
+    )
+{
+    std::vector<uint8_t> Setup;
+    if (!RecvControl(Control, PERF_CONTROL_SETUP, Setup) ||
+        Setup.empty() || Setup.back() != '\0') {
+        printf("Invalid setup message\n");
+        return;
+    }
+
+    std::vector<char*> Args;
+    Args.push_back((char*)"secnetperf");
+    for (size_t i = 0; i < Setup.size(); i += strlen((char*)&Setup[i]) + 1) {
+        Args.push_back((char*)&Setup[i]);
+    }
+    printf("Running client:");
+    for (size_t i = 1; i < Args.size(); ++i) {
+        printf(" %s", Args[i]);
+    }
+    printf("\n");
+    fflush(stdout);
+
+    QUIC_STATUS Status = QUIC_STATUS_INVALID_PARAMETER;
+    if (TryGetTarget((int)Args.size(), Args.data())) { // Agents only run clients
+        Status = QuicMainInit((int)Args.size(), Args.data(), nullptr);
+    }
+    if (!SendControl(Control, PERF_CONTROL_READY, &Status, sizeof(Status)) ||
+        QUIC_FAILED(Status)) {
+        QuicMainFree();
+        return;
+    }
+
+    std::vector<uint8_t> Start;
+    if (!RecvControl(Control, PERF_CONTROL_START, Start)) {
+        QuicMainFree();
+        return;
+    }
+
+    CxPlatEvent StopEvent {true};
+    if (QUIC_SUCCEEDED(Status = QuicMainRun(&StopEvent.Handle))) {
+        Status = QuicMainWaitForCompletion();
+    }
+
+    //
+    // The results are the status, the totals and then just the latencies out
+    // of the client's extra data (which starts with its run time and count).
+    //
+    std::vector<uint8_t> Results(sizeof(Status) + sizeof(PERF_CLIENT_RESULTS));
+    PERF_CLIENT_RESULTS Totals;
+    CxPlatZeroMemory(&Totals, sizeof(Totals));
+    (void)QuicMainGetClientResults(&Totals);
+    CxPlatCopyMemory(Results.data(), &Status, sizeof(Status));
+    CxPlatCopyMemory(Results.data() + sizeof(Status), &Totals, sizeof(Totals));
+
+    const uint32_t ExtraDataLength = QUIC_SUCCEEDED(Status) ? QuicMainGetExtraDataLength() : 0;
+    if (ExtraDataLength > 2 * sizeof(uint64_t)) {
+        std::vector<uint8_t> ExtraData(ExtraDataLength);
+        QuicMainGetExtraData(ExtraData.data(), ExtraDataLength);
+        Results.insert(Results.end(), ExtraData.begin() + 2 * sizeof(uint64_t), ExtraData.end());
+    }
+    QuicMainFree();
+
+    (void)SendControl(Control, PERF_CONTROL_RESULTS, Results.data(), (uint32_t)Results.size());
+    printf("Client finished, 0x%x\n", Status);
+    fflush(stdout);
+}
+
+QUIC_STATUS
+QuicAgentMain(
+    _In_ int argc,
+    _In_reads_(argc) _Null_terminated_ char* argv[]
+    )
+{
+    uint16_t Port = PERF_DEFAULT_AGENT_PORT;
+    TryGetValue(argc, argv, "agentport", &Port);
+
+#ifdef _WIN32
+    WSADATA WsaData;
+    if (WSAStartup(MAKEWORD(2, 2), &WsaData) != 0) {
+        printf("WSAStartup failed.\n");
+        return QUIC_STATUS_INTERNAL_ERROR;
+    }
+#endif
+
+    QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
+    SOCKET ListenSocket = socket(AF_INET6, SOCK_STREAM, IPPROTO_TCP);
+    if (ListenSocket == INVALID_SOCKET) {
+        printf("Failed to create the agent socket\n");
+        Status = QUIC_STATUS_INTERNAL_ERROR;
+        goto Exit;
+    }
+
+    {
+        int Option = 0;
+        (void)setsockopt(ListenSocket, IPPROTO_IPV6, IPV6_V6ONLY, (const char*)&Option, sizeof(Option));
+        Option = 1;
+        (void)setsockopt(ListenSocket, SOL_SOCKET, SO_REUSEADDR, (const char*)&Option, sizeof(Option));
+
+        QuicAddr Address(QUIC_ADDRESS_FAMILY_INET6, Port);
+        if (bind(ListenSocket, (const sockaddr*)&Address.SockAddr, sizeof(Address.SockAddr.Ipv6)) == SOCKET_ERROR ||
+            listen(ListenSocket, 1) == SOCKET_ERROR) {
+            printf("Failed to listen on TCP port %hu\n", Port);
+            Status = QUIC_STATUS_ADDRESS_IN_USE;
+            goto Exit;
+        }
+    }
+
+    printf("Agent listening on TCP port %hu\n", Port);
+    fflush(stdout);
+
+    for (;;) {
+        SOCKET Control = accept(ListenSocket, nullptr, nullptr);
+        if (Control == INVALID_SOCKET) {
+            break;
+        }
+        SetNoDelay(Control);
+        RunAgentClient(Control);
+        closesocket(Control);
+    }
+
+Exit:
+    if (ListenSocket != INVALID_SOCKET) {
+        closesocket(ListenSocket);
+    }
+#ifdef _WIN32
+    WSACleanup();
+#endif
+    return Status;
+}
+
+struct PerfAgent {
+    std::string Name;
+    SOCKET Socket {INVALID_SOCKET};
+    QUIC_STATUS Status {QUIC_STATUS_SUCCESS};
+    PERF_CLIENT_RESULTS Results {};
+    std::vector<uint8_t> Latencies;
+};
+
+static
+SOCKET
+ConnectAgent(
+    _In_z_ const char* Name,
+    _In_ uint16_t Port
+    )
+{
+    char PortString[8];
+    snprintf(PortString, sizeof(PortString), "%hu", Port);
+
+    addrinfo Hints;
+    CxPlatZeroMemory(&Hints, sizeof(Hints));
+    Hints.ai_family = AF_UNSPEC;
+    Hints.ai_socktype = SOCK_STREAM;
+    Hints.ai_protocol = IPPROTO_TCP;
+
+    addrinfo* Addresses = nullptr;
+    if (getaddrinfo(Name, PortString, &Hints, &Addresses) != 0) {
+        return INVALID_SOCKET;
+    }
+
+    SOCKET Socket = INVALID_SOCKET;
+    for (addrinfo* Address = Addresses; Address != nullptr; Address = Address->ai_next) {
+        Socket = socket(Address->ai_family, Address->ai_socktype, Address->ai_protocol);
+        if (Socket == INVALID_SOCKET) {
+            continue;
+        }
+        if (connect(Socket, Address->ai_addr, (int)Address->ai_addrlen) != SOCKET_ERROR) {
+            SetNoDelay(Socket);
+            break;
+        }
+        closesocket(Socket);
+        Socket = INVALID_SOCKET;
+    }
+    freeaddrinfo(Addresses);
+    return Socket;
+}
+
+static
+void
+PrintAgentResults(
+    _In_z_ const char* Name,
+    _In_ const PERF_CLIENT_RESULTS& Results
+    )
+{
+    const uint64_t RunTime = Results.RunTimeUs ? Results.RunTimeUs : 1;
+    printf(
+        "Result: %s: %llu HPS, %llu RPS, %llu kbps up, %llu kbps down, %llu%% CPU\n",
+        Name,
+        (unsigned long long)(Results.ConnectionsConnected * 1000 * 1000 / RunTime),
+        (unsigned long long)(Results.StreamsCompleted * 1000 * 1000 / RunTime),
+        (unsigned long long)(Results.BytesSent * 8 * 1000 / RunTime),
+        (unsigned long long)(Results.BytesReceived * 8 * 1000 / RunTime),
+        (unsigned long long)(Results.CpuTimeUs * 100 / RunTime));
+}
+
+QUIC_STATUS
+QuicCoordinatorMain(
+    _In_ int argc,
+    _In_reads_(argc) _Null_terminated_ char* argv[],
+    _In_z_ const char* Agents,
+    _In_opt_z_ const char* FileName
+    )
+{
+    if (!TryGetTarget(argc, argv)) {
+        printf("The coordinator needs a -target for the agents' clients!\n");
+        return QUIC_STATUS_INVALID_PARAMETER;
+    }
+
+    uint16_t Port = PERF_DEFAULT_AGENT_PORT;
+    TryGetValue(argc, argv, "agentport", &Port);
+
+    //
+    // Forward all the client options, minus the coordinator's own.
+    //
+    std::vector<uint8_t> Setup;
+    for (int i = 1; i < argc; ++i) {
+        if (IsArg(argv[i], "agents:") || IsArg(argv[i], "agentport:") ||
+            IsArg(argv[i], "extraOutputFile:")) {
+            continue;
+        }
+        Setup.insert(Setup.end(), argv[i], argv[i] + strlen(argv[i]) + 1);
+    }
+
+    std::vector<PerfAgent> AgentList;
+    for (const char* Name = Agents; *Name != '\0';) {
+        const char* End = strchr(Name, ',');
+        const size_t Length = End ? (size_t)(End - Name) : strlen(Name);
+        if (Length != 0) {
+            AgentList.emplace_back();
+            AgentList.back().Name.assign(Name, Length);
+        }
+        Name += Length + (End ? 1 : 0);
+    }
+    if (AgentList.empty()) {
+        printf("No agents in the -agents list!\n");
+        return QUIC_STATUS_INVALID_PARAMETER;
+    }
+
+#ifdef _WIN32
+    WSADATA WsaData;
+    if (WSAStartup(MAKEWORD(2, 2), &WsaData) != 0) {
+        printf("WSAStartup failed.\n");
+        return QUIC_STATUS_INTERNAL_ERROR;
+    }
+#endif
+
+    QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
+    std::vector<uint8_t> Message;
+    PERF_CLIENT_RESULTS Total {};
+    uint64_t LatencyCount = 0;
+
+    //
+    // Set up the clients on all the agents, and only start them once they are
+    // all ready.
+    //
+    for (auto& Agent : AgentList) {
+        Agent.Socket = ConnectAgent(Agent.Name.c_str(), Port);
+        if (Agent.Socket == INVALID_SOCKET) {
+            printf("Failed to connect to agent %s on TCP port %hu\n", Agent.Name.c_str(), Port);
+            Status = QUIC_STATUS_CONNECTION_REFUSED;
+            goto Exit;
+        }
+        if (!SendControl(Agent.Socket, PERF_CONTROL_SETUP, Setup.data(), (uint32_t)Setup.size())) {
+            printf("Failed to send the setup to agent %s\n", Agent.Name.c_str());
+            Status = QUIC_STATUS_ABORTED;
+            goto Exit;
+        }
+    }
+
+    for (auto& Agent : AgentList) {
+        if (!RecvControl(Agent.Socket, PERF_CONTROL_READY, Message) ||
+            Message.size() < sizeof(QUIC_STATUS)) {
+            printf("Agent %s didn't get ready\n", Agent.Name.c_str());
+            Status = QUIC_STATUS_ABORTED;
+            goto Exit;
+        }
+        CxPlatCopyMemory(&Agent.Status, Message.data(), sizeof(QUIC_STATUS));
+        if (QUIC_FAILED(Agent.Status)) {
+            printf("Agent %s failed to set up the client, 0x%x\n", Agent.Name.c_str(), Agent.Status);
+            Status = Agent.Status;
+            goto Exit;
+        }
+    }
+
+    for (auto& Agent : AgentList) {
+        if (!SendControl(Agent.Socket, PERF_CONTROL_START, nullptr, 0)) {
+            printf("Failed to start agent %s\n", Agent.Name.c_str());
+            Status = QUIC_STATUS_ABORTED;
+            goto Exit;
+        }
+    }
+
+    printf("Started %u agents!\n\n", (uint32_t)AgentList.size());
+    fflush(stdout);
+
+    for (auto& Agent : AgentList) {
+        if (!RecvControl(Agent.Socket, PERF_CONTROL_RESULTS, Message) ||
+            Message.size() < sizeof(QUIC_STATUS) + sizeof(PERF_CLIENT_RESULTS)) {
+            printf("Agent %s didn't send its results\n", Agent.Name.c_str());
+            Status = QUIC_STATUS_ABORTED;
+            goto Exit;
+        }
+        CxPlatCopyMemory(&Agent.Status, Message.data(), sizeof(QUIC_STATUS));
+        CxPlatCopyMemory(&Agent.Results, Message.data() + sizeof(QUIC_STATUS), sizeof(PERF_CLIENT_RESULTS));
+        Agent.Latencies.assign(
+            Message.begin() + sizeof(QUIC_STATUS) + sizeof(PERF_CLIENT_RESULTS), Message.end());
+        LatencyCount += Agent.Latencies.size() / sizeof(uint32_t);
+    }
+
+    //
+    // Rates are summed over the agents, each over its own run time, while the
+    // latencies of every agent are merged into one set of percentiles.
+    //
+    for (auto& Agent : AgentList) {
+        if (QUIC_FAILED(Agent.Status)) {
+            printf("Agent %s client failed, 0x%x\n", Agent.Name.c_str(), Agent.Status);
+            Status = Agent.Status;
+            continue;
+        }
+        PrintAgentResults(Agent.Name.c_str(), Agent.Results);
+        const uint64_t RunTime = Agent.Results.RunTimeUs ? Agent.Results.RunTimeUs : 1;
+        Total.RunTimeUs = CXPLAT_MAX(Total.RunTimeUs, Agent.Results.RunTimeUs);
+        Total.ConnectionsConnected += Agent.Results.ConnectionsConnected * 1000 * 1000 / RunTime;
+        Total.StreamsCompleted += Agent.Results.StreamsCompleted * 1000 * 1000 / RunTime;
+        Total.BytesSent += Agent.Results.BytesSent * 1000 * 1000 / RunTime;
+        Total.BytesReceived += Agent.Results.BytesReceived * 1000 * 1000 / RunTime;
+        Total.CpuTimeUs += Agent.Results.CpuTimeUs * 1000 * 1000 / RunTime;
+    }
+    {
+        PERF_CLIENT_RESULTS PerSecond = Total;
+        PerSecond.RunTimeUs = 1000 * 1000; // The totals above are already per second
+        PrintAgentResults("Total", PerSecond);
+    }
+
+    if (LatencyCount != 0) {
+        const uint64_t MaxCount = (UINT32_MAX - 2 * sizeof(uint64_t)) / sizeof(uint32_t);
+        if (LatencyCount > MaxCount) {
+            printf("Warning! Limiting the combined latencies to %llu requests\n", (unsigned long long)MaxCount);
+            LatencyCount = MaxCount;
+        }
+        std::vector<uint8_t> ExtraData;
+        ExtraData.reserve((size_t)(2 * sizeof(uint64_t) + LatencyCount * sizeof(uint32_t)));
+        ExtraData.insert(ExtraData.end(), (uint8_t*)&Total.RunTimeUs, (uint8_t*)(&Total.RunTimeUs + 1));
+        ExtraData.insert(ExtraData.end(), (uint8_t*)&LatencyCount, (uint8_t*)(&LatencyCount + 1));
+        for (auto& Agent : AgentList) {
+            const size_t Room = ExtraData.capacity() - ExtraData.size();
+            const size_t Length = CXPLAT_MIN(Agent.Latencies.size(), Room);
+            ExtraData.insert(ExtraData.end(), Agent.Latencies.begin(), Agent.Latencies.begin() + Length);
+        }
+        QuicHandleExtraData(ExtraData.data(), (uint32_t)ExtraData.size(), FileName);
+    }
+
+Exit:
+    for (auto& Agent : AgentList) {
+        if (Agent.Socket != INVALID_SOCKET) {
+            closesocket(Agent.Socket);
+        }
+    }
+#ifdef _WIN32
+    WSACleanup();
+#endif
+    return Status;
+}
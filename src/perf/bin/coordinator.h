@@ -0,0 +1,65 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Distributed secnetperf runs. A coordinator sends the same client options to
+    a set of agents (secnetperf -agent:1 on other machines) over TCP control
+    connections, starts them all at once and merges their results into one
+    report.
+
+--*/
+
+#pragma once
+
+#define PERF_DEFAULT_AGENT_PORT 4434
+
+//
+// Every control message starts with this header, followed by Length bytes.
+//
+typedef struct PERF_CONTROL_HEADER {
+    uint32_t Type;
+    uint32_t Length;
+} PERF_CONTROL_HEADER;
+
+typedef enum PERF_CONTROL_TYPE {
+    PERF_CONTROL_SETUP = 1,   // Coordinator -> agent: NUL separated client arguments
+    PERF_CONTROL_READY = 2,   // Agent -> coordinator: QUIC_STATUS of the client setup
+    PERF_CONTROL_START = 3,   // Coordinator -> agent: no payload
+    PERF_CONTROL_RESULTS = 4, // Agent -> coordinator: QUIC_STATUS, PERF_CLIENT_RESULTS, then uint32_t latencies
+} PERF_CONTROL_TYPE;
+
+//
+// Handles the extra data of a single client run: prints the RPS and latency
+// percentiles and writes the histogram file, if one was asked for.
+//
+void
+QuicHandleExtraData(
+    _In_reads_(Length) uint8_t* ExtraData,
+    _In_ uint32_t Length,
+    _In_opt_z_ const char* FileName
+    );
+
+//
+// Accepts control connections, one at a time, and runs the client each one
+// asks for.
+//
+QUIC_STATUS
+QuicAgentMain(
+    _In_ int argc,
+    _In_reads_(argc) _Null_terminated_ char* argv[]
+    );
+
+//
+// Runs the client options on every agent in the -agents list and prints the
+// combined results.
+//
+QUIC_STATUS
+QuicCoordinatorMain(
+    _In_ int argc,
+    _In_reads_(argc) _Null_terminated_ char* argv[],
+    _In_z_ const char* Agents,
+    _In_opt_z_ const char* FileName
+    );
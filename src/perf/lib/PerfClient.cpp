@@ -10,6 +10,7 @@ Abstract:
 --*/
 
 #include "PerfClient.h"
+#include "PerfCpu.h"
 
 #ifdef QUIC_CLOG
 #include "PerfClient.cpp.clog.h"
@@ -22,6 +23,15 @@ const uint64_t SizeMult[] = { 1000 * 1000 * 1000, 1000 * 1000, 1000, 1 };
 const char* CountUnits[] = { "cpu" };
 uint64_t CountMult[] = { 1 };
 
+#ifndef _KERNEL_MODE
+//
+// Forward declaration because of include issues with math.h
+//
+extern "C" {
+    double log(double value);
+}
+#endif
+
 _Success_(return != false)
 template <typename T>
 bool
@@ -181,6 +191,7 @@ PerfClient::Init(
     //
 
     TryGetValue(argc, argv, "tcp", &UseTCP);
+    TryGetValue(argc, argv, "ktls", &UseKernelTls);
     TryGetValue(argc, argv, "encrypt", &UseEncryption);
     TryGetValue(argc, argv, "pacing", &UsePacing);
     TryGetValue(argc, argv, "sendbuf", &UseSendBuffering);
@@ -191,6 +202,7 @@ PerfClient::Init(
     TryGetValue(argc, argv, "pstream", &PrintStreams);
     TryGetValue(argc, argv, "platency", &PrintLatency);
     TryGetValue(argc, argv, "plat", &PrintLatency);
+    TryGetValue(argc, argv, "pstages", &PrintStages);
 
     //
     // Scenario options
@@ -223,6 +235,44 @@ PerfClient::Init(
     TryGetValue(argc, argv, "rc", &RepeatConnections);
     TryGetValue(argc, argv, "rstream", &RepeatStreams);
     TryGetValue(argc, argv, "rs", &RepeatStreams);
+    TryGetValue(argc, argv, "handshake", &HandshakeMode);
+    TryGetValue(argc, argv, "hs", &HandshakeMode);
+    TryGetValue(argc, argv, "resume", &ResumePercent);
+    TryGetValue(argc, argv, "rate", &RequestRate);
+
+    const char* Arrival = GetValue(argc, argv, "arrival");
+    if (Arrival != nullptr) {
+        if (IsValue(Arrival, "poisson")) {
+#ifdef _KERNEL_MODE
+            WriteOutput("'poisson' arrival isn't supported in kernel mode!\n");
+            return QUIC_STATUS_NOT_SUPPORTED;
+#else
+            PoissonArrival = TRUE;
+#endif
+        } else if (!IsValue(Arrival, "constant")) {
+            WriteOutput("'arrival' must be 'poisson' or 'constant'!\n");
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
+    }
+
+    if (HandshakeMode) {
+        //
+        // The handshake scenario repeatedly creates connections and closes
+        // them right after the handshake, tracking the handshake latencies.
+        //
+        RepeatConnections = TRUE;
+        PrintLatency = TRUE;
+    }
+
+    if (ResumePercent > 100) {
+        WriteOutput("'resume' must be a percentage!\n");
+        return QUIC_STATUS_INVALID_PARAMETER;
+    }
+
+    if (ResumePercent && (!HandshakeMode || UseTCP)) {
+        WriteOutput("'resume' is only supported for the QUIC 'handshake' scenario!\n");
+        return QUIC_STATUS_INVALID_PARAMETER;
+    }
 
     if ((RepeatConnections || RepeatStreams) && !RunTime) {
         WriteOutput("Must specify a 'runtime' if using a repeat parameter!\n");
@@ -238,6 +288,9 @@ PerfClient::Init(
             WriteOutput("TCP mode doesn't support CIBIR!\n");
             return QUIC_STATUS_INVALID_PARAMETER;
         }
+    } else if (UseKernelTls) {
+        WriteOutput("'ktls' is only supported in TCP mode!\n");
+        return QUIC_STATUS_INVALID_PARAMETER;
     }
 
     if ((Upload || Download) && !StreamCount) {
@@ -249,6 +302,29 @@ PerfClient::Init(
         return QUIC_STATUS_INVALID_PARAMETER;
     }
 
+    if (HandshakeMode && StreamCount) {
+        WriteOutput("The 'handshake' scenario doesn't use streams!\n");
+        return QUIC_STATUS_INVALID_PARAMETER;
+    }
+
+    if (RequestRate) {
+        //
+        // The open loop scenario sends requests at a fixed rate, regardless of
+        // how quickly earlier ones complete, and measures each request's latency
+        // from when it was supposed to be sent. A slow server therefore shows up
+        // as queuing delay instead of just a lower request rate.
+        //
+        if (!RunTime) {
+            WriteOutput("Must specify a 'runtime' if using 'rate'!\n");
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
+        if (UseTCP || HandshakeMode || RepeatStreams) {
+            WriteOutput("'rate' isn't supported with 'tcp', 'handshake' or 'rstream'!\n");
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
+        PrintLatency = TRUE;
+    }
+
     //
     // Initialization
     //
@@ -289,7 +365,9 @@ PerfClient::Init(
     RequestBuffer.Init(IoSize, Timed ? UINT64_MAX : Download);
     if (PrintLatency) {
         if (RunTime) {
-            MaxLatencyIndex = ((uint64_t)RunTime / (1000 * 1000)) * PERF_MAX_REQUESTS_PER_SECOND;
+            MaxLatencyIndex =
+                ((uint64_t)RunTime / (1000 * 1000)) *
+                CXPLAT_MAX(RequestRate, PERF_MAX_REQUESTS_PER_SECOND);
             if (MaxLatencyIndex > (UINT32_MAX / sizeof(uint32_t))) {
                 MaxLatencyIndex = UINT32_MAX / sizeof(uint32_t);
                 WriteOutput("Warning! Limiting request latency tracking to %llu requests\n",
@@ -304,11 +382,64 @@ PerfClient::Init(
             return QUIC_STATUS_OUT_OF_MEMORY;
         }
         CxPlatZeroMemory(LatencyValues.get(), (size_t)(sizeof(uint32_t) * MaxLatencyIndex));
+
+        if (HandshakeMode) {
+            LatencyResumed = UniquePtr<uint8_t[]>(new(std::nothrow) uint8_t[(size_t)MaxLatencyIndex]);
+            if (LatencyResumed == nullptr) {
+                return QUIC_STATUS_OUT_OF_MEMORY;
+            }
+            CxPlatZeroMemory(LatencyResumed.get(), (size_t)MaxLatencyIndex);
+        }
     }
 
     return QUIC_STATUS_SUCCESS;
 }
 
+#ifndef _KERNEL_MODE
+static int CompareLatency(const void* Left, const void* Right) {
+    const uint32_t L = *(const uint32_t*)Left;
+    const uint32_t R = *(const uint32_t*)Right;
+    return L < R ? -1 : (L > R ? 1 : 0);
+}
+
+static void PrintHandshakeLatency(const char* Type, _Inout_updates_(Count) uint32_t* Values, uint64_t Count) {
+    if (Count == 0) {
+        return;
+    }
+    qsort(Values, (size_t)Count, sizeof(uint32_t), CompareLatency);
+    WriteOutput(
+        "Result: %s handshake latency,us 50th: %u, 99th: %u, 99.9th: %u, Max: %u\n",
+        Type,
+        Values[(size_t)(Count * 0.5)],
+        Values[(size_t)(Count * 0.99)],
+        Values[(size_t)(Count * 0.999)],
+        Values[(size_t)(Count - 1)]);
+}
+#endif // _KERNEL_MODE
+
+static bool GetStageCycles(
+    _Out_writes_(QUIC_PERF_STAGE_MAX) QUIC_PERF_STAGE_CYCLES* StageCycles,
+    _Out_writes_(QUIC_PERF_COUNTER_MAX) int64_t* PerfCounters
+    ) {
+    uint32_t Length = sizeof(QUIC_PERF_STAGE_CYCLES) * QUIC_PERF_STAGE_MAX;
+    if (QUIC_FAILED(
+        MsQuic->GetParam(
+            nullptr,
+            QUIC_PARAM_GLOBAL_PERF_STAGE_CYCLES,
+            &Length,
+            StageCycles))) {
+        return false;
+    }
+    Length = sizeof(int64_t) * QUIC_PERF_COUNTER_MAX;
+    return
+        QUIC_SUCCEEDED(
+        MsQuic->GetParam(
+            nullptr,
+            QUIC_PARAM_GLOBAL_PERF_COUNTERS,
+            &Length,
+            PerfCounters));
+}
+
 static void AppendIntToString(char* String, uint8_t Value) {
     const char* Hex = "0123456789ABCDEF";
     String[0] = Hex[(Value >> 4) & 0xF];
@@ -321,6 +452,16 @@ PerfClient::Start(
     _In_ CXPLAT_EVENT* StopEvent
     ) {
     CompletionEvent = StopEvent;
+    RunStartTime = CxPlatTimeUs64();
+#ifndef _KERNEL_MODE
+    StartCpuTime = PerfGetProcessCpuTimeUs();
+#endif
+    if (CpuMonitor) {
+        CpuMonitor->Start();
+    }
+    if (PrintStages) {
+        (void)GetStageCycles(StartStageCycles, StartPerfCounters);
+    }
 
     //
     // Configure and start all the workers.
@@ -340,6 +481,7 @@ PerfClient::Start(
         nullptr
     };
     const size_t TargetLen = strlen(Target.get());
+    uint64_t ConnectionsAssigned = 0;
     for (uint32_t i = 0; i < WorkerCount; ++i) {
         auto Worker = &Workers[i];
         Worker->Processor = (uint16_t)i;
@@ -352,6 +494,12 @@ PerfClient::Start(
             Worker->ConnectionsQueued++;
         }
 
+        // Split the open loop rate by connection, so the shares add up exactly.
+        Worker->RequestRate =
+            (RequestRate * (ConnectionsAssigned + Worker->ConnectionsQueued)) / ConnectionCount -
+            (RequestRate * ConnectionsAssigned) / ConnectionCount;
+        ConnectionsAssigned += Worker->ConnectionsQueued;
+
         // Build up target hostname.
         Worker->Target.reset(new(std::nothrow) char[TargetLen + 10]);
         CxPlatCopyMemory(Worker->Target.get(), Target.get(), TargetLen);
@@ -396,6 +544,14 @@ PerfClient::Wait(
         Workers[i].Uninitialize();
     }
 
+    RunEndTime = CxPlatTimeUs64();
+#ifndef _KERNEL_MODE
+    RunCpuTime = PerfGetProcessCpuTimeUs() - StartCpuTime;
+#endif
+    if (CpuMonitor) {
+        CpuMonitor->Stop();
+    }
+
     if (GetConnectedConnections() == 0) {
         WriteOutput("Error: No Successful Connections!\n");
         return QUIC_STATUS_CONNECTION_REFUSED;
@@ -404,7 +560,16 @@ PerfClient::Wait(
     unsigned long long CompletedConnections = GetConnectionsCompleted();
     unsigned long long CompletedStreams = GetStreamsCompleted();
 
-    if (PrintIoRate) {
+    if (HandshakeMode) {
+        PrintHandshakeResults();
+    } else if (RequestRate) {
+        WriteOutput(
+            "Result: %u RPS target (%s arrival), %llu requests sent, %llu completed\n",
+            RequestRate,
+            PoissonArrival ? "poisson" : "constant",
+            (unsigned long long)GetStreamsStarted(),
+            CompletedStreams);
+    } else if (PrintIoRate) {
         if (CompletedConnections) {
             unsigned long long HPS = CompletedConnections * 1000 * 1000 / RunTime;
             WriteOutput("Result: %llu HPS\n", HPS);
@@ -427,9 +592,96 @@ PerfClient::Wait(
         }
     }
 
+    if (PrintStages) {
+        PrintStageCycles();
+    }
+
+    if (CpuMonitor) {
+        CpuMonitor->Print("client");
+    }
+
     return QUIC_STATUS_SUCCESS;
 }
 
+void
+PerfClient::PrintStageCycles(
+    )
+{
+    static const char* const StageNames[QUIC_PERF_STAGE_MAX] = {
+        "receive", "deliver", "decrypt", "frames", "stream delivery",
+        "send", "encrypt", "datapath send"
+    };
+
+    QUIC_PERF_STAGE_CYCLES StageCycles[QUIC_PERF_STAGE_MAX];
+    int64_t PerfCounters[QUIC_PERF_COUNTER_MAX];
+    if (!GetStageCycles(StageCycles, PerfCounters)) {
+        WriteOutput("Stage cycles not available (build with QUIC_ENABLE_STAGE_CYCLES)\n");
+        return;
+    }
+
+    //
+    // Receive side stages are per received datagram, and send side stages per
+    // sent datagram.
+    //
+    const uint64_t RecvPackets =
+        (uint64_t)(PerfCounters[QUIC_PERF_COUNTER_UDP_RECV] - StartPerfCounters[QUIC_PERF_COUNTER_UDP_RECV]);
+    const uint64_t SendPackets =
+        (uint64_t)(PerfCounters[QUIC_PERF_COUNTER_UDP_SEND] - StartPerfCounters[QUIC_PERF_COUNTER_UDP_SEND]);
+
+    for (uint32_t i = 0; i < QUIC_PERF_STAGE_MAX; ++i) {
+        const uint64_t Cycles = StageCycles[i].Cycles - StartStageCycles[i].Cycles;
+        const uint64_t Calls = StageCycles[i].Calls - StartStageCycles[i].Calls;
+        const uint64_t Packets = i < QUIC_PERF_STAGE_SEND ? RecvPackets : SendPackets;
+        WriteOutput(
+            "Result: %s stage %llu cycles/packet, %llu cycles/call (%llu calls)\n",
+            StageNames[i],
+            (unsigned long long)(Packets ? Cycles / Packets : 0),
+            (unsigned long long)(Calls ? Cycles / Calls : 0),
+            (unsigned long long)Calls);
+    }
+}
+
+void
+PerfClient::PrintHandshakeResults(
+    )
+{
+    const uint64_t Handshakes = GetConnectedConnections();
+    const uint64_t Resumed = GetHandshakesResumed();
+    WriteOutput(
+        "Result: %llu HPS (%llu full, %llu resumed)\n",
+        (unsigned long long)(Handshakes * 1000 * 1000 / RunTime),
+        (unsigned long long)(Handshakes - Resumed),
+        (unsigned long long)Resumed);
+
+#ifndef _KERNEL_MODE
+    const uint64_t CpuTime = PerfGetProcessCpuTimeUs() - StartCpuTime;
+    WriteOutput(
+        "Result: %llu CPU us per handshake (client process)\n",
+        (unsigned long long)(CpuTime / Handshakes));
+
+    //
+    // Split the latencies by handshake type. The combined set is still handed
+    // out as extra data, for the overall percentiles and histogram.
+    //
+    const uint64_t Count = CXPLAT_MIN(LatencyCount, MaxLatencyIndex);
+    auto Full = UniquePtr<uint32_t[]>(new(std::nothrow) uint32_t[(size_t)Count + 1]);
+    auto Resumption = UniquePtr<uint32_t[]>(new(std::nothrow) uint32_t[(size_t)Count + 1]);
+    if (Full == nullptr || Resumption == nullptr) {
+        return;
+    }
+    uint64_t FullCount = 0, ResumptionCount = 0;
+    for (uint64_t i = 0; i < Count; ++i) {
+        if (LatencyResumed[(size_t)i]) {
+            Resumption[(size_t)ResumptionCount++] = LatencyValues[(size_t)i];
+        } else {
+            Full[(size_t)FullCount++] = LatencyValues[(size_t)i];
+        }
+    }
+    PrintHandshakeLatency("Full", Full.get(), FullCount);
+    PrintHandshakeLatency("Resumed", Resumption.get(), ResumptionCount);
+#endif
+}
+
 uint32_t
 PerfClient::GetExtraDataLength(
     )
@@ -460,6 +712,20 @@ PerfClient::GetExtraData(
     CxPlatCopyMemory(Data, LatencyValues.get(), (size_t)(Count * sizeof(uint32_t)));
 }
 
+void
+PerfClient::GetResults(
+    _Out_ PERF_CLIENT_RESULTS* Results
+    )
+{
+    Results->RunTimeUs = CxPlatTimeDiff64(RunStartTime, RunEndTime);
+    Results->CpuTimeUs = RunCpuTime;
+    Results->ConnectionsConnected = GetConnectedConnections();
+    Results->ConnectionsCompleted = GetConnectionsCompleted();
+    Results->StreamsCompleted = GetStreamsCompleted();
+    Results->BytesSent = GetBytesSent();
+    Results->BytesReceived = GetBytesReceived();
+}
+
 void
 PerfClientWorker::WorkerThread() {
 #ifdef QUIC_COMPARTMENT_ID
@@ -476,8 +742,57 @@ PerfClientWorker::WorkerThread() {
         while (Client->Running && ConnectionsCreated < ConnectionsQueued) {
             StartNewConnection();
         }
-        WakeEvent.WaitForever();
+        const uint32_t WaitMs = RequestRate ? StartScheduledRequests() : UINT32_MAX;
+        if (WaitMs == UINT32_MAX) {
+            WakeEvent.WaitForever();
+        } else if (WaitMs != 0) {
+            WakeEvent.WaitTimeout(WaitMs);
+        }
+    }
+}
+
+//
+// Starts every open loop request whose intended send time has passed, each on
+// the next connected connection in turn, and returns how long to wait for the
+// next one (in ms). Requests less than a millisecond out are polled for.
+//
+uint32_t
+PerfClientWorker::StartScheduledRequests() {
+    const uint64_t Now = CxPlatTimeUs64();
+    Lock.Acquire();
+    if (CxPlatListIsEmpty(&RequestConnections)) {
+        Lock.Release();
+        return UINT32_MAX; // Woken up once a connection is connected
+    }
+    if (RequestBaseTime == 0) {
+        RequestBaseTime = NextRequestTime = Now; // The schedule starts with the first connection
     }
+    while (Client->Running && NextRequestTime <= Now) {
+        CXPLAT_LIST_ENTRY* Entry = CxPlatListRemoveHead(&RequestConnections);
+        CxPlatListInsertTail(&RequestConnections, Entry);
+        CXPLAT_CONTAINING_RECORD(Entry, PerfClientConnection::RequestEntry, Link)->Owner->StartNewStream(NextRequestTime);
+        ScheduleNextRequest();
+    }
+    Lock.Release();
+    return NextRequestTime > Now ? (uint32_t)US_TO_MS(NextRequestTime - Now) : 0;
+}
+
+void
+PerfClientWorker::ScheduleNextRequest() {
+    RequestsScheduled++;
+#ifndef _KERNEL_MODE
+    if (Client->PoissonArrival) {
+        //
+        // Exponentially distributed gaps, with U in (0,1].
+        //
+        uint32_t Random;
+        CxPlatRandom(sizeof(Random), &Random);
+        const double U = ((double)Random + 1) / 4294967296.0;
+        NextRequestTime += (uint64_t)(-log(U) * 1000 * 1000 / (double)RequestRate + 0.5);
+        return;
+    }
+#endif
+    NextRequestTime = RequestBaseTime + (RequestsScheduled * 1000 * 1000) / RequestRate;
 }
 
 void
@@ -513,12 +828,13 @@ PerfClientConnection::Initialize() {
     if (Client.UseTCP) {
         auto CredConfig = MsQuicCredentialConfig(QUIC_CREDENTIAL_FLAG_CLIENT | QUIC_CREDENTIAL_FLAG_NO_CERTIFICATE_VALIDATION);
         TcpConn = // TODO: replace new/delete with pool alloc/free
-            new (std::nothrow) TcpConnection(Client.Engine.get(), &CredConfig, this);
+            new (std::nothrow) TcpConnection(Client.Engine.get(), &CredConfig, this, Client.UseKernelTls != FALSE);
         if (!TcpConn->IsInitialized()) {
             Worker.ConnectionPool.Free(this);
             return;
         }
 
+        StartTime = CxPlatTimeUs64();
         if (!TcpConn->Start(
                 Client.TargetFamily,
                 Worker.Target.get(),
@@ -557,6 +873,24 @@ PerfClientConnection::Initialize() {
             }
         }
 
+        if (Client.UseSendBuffering == 2) {
+            //
+            // The request buffer is never modified after initialization, so
+            // buffered sends can reference it directly.
+            //
+            Status =
+                MsQuic->SetParam(
+                    Handle,
+                    QUIC_PARAM_CONN_SEND_MEMORY_REGION,
+                    sizeof(QUIC_BUFFER),
+                    (QUIC_BUFFER*)Client.RequestBuffer);
+            if (QUIC_FAILED(Status)) {
+                WriteOutput("SetSendMemoryRegion failed, 0x%x\n", Status);
+                Worker.ConnectionPool.Free(this);
+                return;
+            }
+        }
+
         if (Client.CibirIdLength) {
             Status =
                 MsQuic->SetParam(
@@ -612,6 +946,28 @@ PerfClientConnection::Initialize() {
             return;
         }
 
+        if (Client.ResumePercent) {
+            Status = QUIC_STATUS_SUCCESS;
+            Worker.Lock.Acquire();
+            if (Worker.ResumptionTicketLength == 0) {
+                WaitingForTicket = true; // Keep the connection until it gets one
+            } else if (Worker.ConnectionsCreated % 100 < Client.ResumePercent) {
+                Status =
+                    MsQuic->SetParam(
+                        Handle,
+                        QUIC_PARAM_CONN_RESUMPTION_TICKET,
+                        Worker.ResumptionTicketLength,
+                        Worker.ResumptionTicket.get());
+            }
+            Worker.Lock.Release();
+            if (QUIC_FAILED(Status)) {
+                WriteOutput("SetResumptionTicket failed, 0x%x\n", Status);
+                Worker.ConnectionPool.Free(this);
+                return;
+            }
+        }
+
+        StartTime = CxPlatTimeUs64();
         Status =
             MsQuic->ConnectionStart(
                 Handle,
@@ -642,9 +998,33 @@ PerfClientConnection::Initialize() {
 }
 
 void
-PerfClientConnection::OnHandshakeComplete() {
+PerfClientConnection::OnHandshakeComplete(bool SessionResumed) {
     InterlockedIncrement64((int64_t*)&Worker.ConnectionsConnected);
-    if (!Client.StreamCount) {
+    Connected = true;
+    if (Client.HandshakeMode) {
+        if (SessionResumed) {
+            InterlockedIncrement64((int64_t*)&Worker.HandshakesResumed);
+        }
+        if (Client.Running) {
+            const auto Index = (uint64_t)InterlockedIncrement64((int64_t*)&Client.CurLatencyIndex) - 1;
+            if (Index < Client.MaxLatencyIndex) {
+                const auto Latency = CxPlatTimeDiff64(StartTime, CxPlatTimeUs64());
+                Client.LatencyValues[(size_t)Index] = Latency > UINT32_MAX ? UINT32_MAX : (uint32_t)Latency;
+                Client.LatencyResumed[(size_t)Index] = SessionResumed ? 1 : 0;
+                InterlockedIncrement64((int64_t*)&Client.LatencyCount);
+            }
+        }
+        if (WaitingForTicket) {
+            return; // Shut down once the ticket arrives
+        }
+    }
+    if (Client.RequestRate) {
+        Worker.Lock.Acquire();
+        CxPlatListInsertTail(&Worker.RequestConnections, &RequestLink.Link);
+        InRequestList = true;
+        Worker.Lock.Release();
+        Worker.WakeEvent.Set();
+    } else if (!Client.StreamCount) {
         Shutdown();
         WorkerConnComplete = true;
         Worker.OnConnectionComplete();
@@ -655,6 +1035,34 @@ PerfClientConnection::OnHandshakeComplete() {
     }
 }
 
+void
+PerfClientConnection::OnResumptionTicket(
+    _In_reads_(Length) const uint8_t* Ticket,
+    uint32_t Length
+    ) {
+    if (!Client.ResumePercent) {
+        return;
+    }
+
+    auto NewTicket = UniquePtr<uint8_t[]>(new(std::nothrow) uint8_t[Length]);
+    if (NewTicket != nullptr) {
+        CxPlatCopyMemory(NewTicket.get(), Ticket, Length);
+        Worker.Lock.Acquire();
+        Worker.ResumptionTicket.reset(NewTicket.release());
+        Worker.ResumptionTicketLength = Length;
+        Worker.Lock.Release();
+    }
+
+    if (WaitingForTicket) {
+        WaitingForTicket = false;
+        if (Connected) {
+            Shutdown();
+            WorkerConnComplete = true;
+            Worker.OnConnectionComplete();
+        }
+    }
+}
+
 void
 PerfClientConnection::OnShutdownComplete() {
     if (Client.UseTCP) {
@@ -672,6 +1080,13 @@ PerfClientConnection::OnShutdownComplete() {
         StreamTable.EnumEnd(&Enum);
     }
 
+    if (InRequestList) {
+        Worker.Lock.Acquire();
+        CxPlatListEntryRemove(&RequestLink.Link);
+        InRequestList = false;
+        Worker.Lock.Release();
+    }
+
     if (!WorkerConnComplete) {
         Worker.OnConnectionComplete();
     }
@@ -679,10 +1094,17 @@ PerfClientConnection::OnShutdownComplete() {
 }
 
 void
-PerfClientConnection::StartNewStream() {
-    StreamsCreated++;
-    StreamsActive++;
+PerfClientConnection::StartNewStream(uint64_t IntendedStartTime) {
+    //
+    // Open loop requests are started by the worker thread, concurrently with
+    // other requests' completions.
+    //
+    InterlockedIncrement64((int64_t*)&StreamsCreated);
+    InterlockedIncrement64((int64_t*)&StreamsActive);
     auto Stream = Worker.StreamPool.Alloc(*this);
+    if (IntendedStartTime) {
+        Stream->StartTime = IntendedStartTime; // Include any time spent behind schedule
+    }
     if (Client.UseTCP) {
         Stream->Entry.Signature = (uint32_t)Worker.StreamsStarted;
         StreamTable.Insert(&Stream->Entry);
@@ -717,11 +1139,13 @@ PerfClientConnection::GetTcpStream(uint32_t ID) {
 
 void
 PerfClientConnection::OnStreamShutdown() {
-    StreamsActive--;
+    const auto Active = InterlockedDecrement64((int64_t*)&StreamsActive);
     if (!Client.Running) {
-        if (!StreamsActive) {
+        if (!Active) {
             Shutdown();
         }
+    } else if (Client.RequestRate) {
+        // The worker thread starts the requests.
     } else if (Client.RepeatStreams) {
         while (StreamsActive < Client.StreamCount) {
             StartNewStream();
@@ -753,7 +1177,12 @@ PerfClientConnection::ConnectionCallback(
     ) {
     switch (Event->Type) {
     case QUIC_CONNECTION_EVENT_CONNECTED:
-        OnHandshakeComplete();
+        OnHandshakeComplete(Event->CONNECTED.SessionResumed != FALSE);
+        break;
+    case QUIC_CONNECTION_EVENT_RESUMPTION_TICKET_RECEIVED:
+        OnResumptionTicket(
+            Event->RESUMPTION_TICKET_RECEIVED.ResumptionTicket,
+            Event->RESUMPTION_TICKET_RECEIVED.ResumptionTicketLength);
         break;
     case QUIC_CONNECTION_EVENT_SHUTDOWN_COMPLETE:
         if (Client.PrintConnections) {
@@ -1029,6 +1458,9 @@ PerfClientStream::OnShutdown() {
         InterlockedIncrement64((int64_t*)&Connection.Worker.StreamsCompleted);
     }
 
+    InterlockedExchangeAdd64((int64_t*)&Connection.Worker.BytesSent, (int64_t)BytesAcked);
+    InterlockedExchangeAdd64((int64_t*)&Connection.Worker.BytesReceived, (int64_t)BytesReceived);
+
     auto& Conn = Connection;
     if (Connection.Client.UseTCP) {
         Connection.StreamTable.Remove(&Entry);
@@ -22,14 +22,23 @@ struct PerfClientConnection {
     TcpConnection* TcpConn;
     };
     CxPlatHashTable StreamTable;
+    struct RequestEntry { // Standard layout, unlike the connection itself
+        CXPLAT_LIST_ENTRY Link;
+        PerfClientConnection* Owner;
+    } RequestLink {{}, this}; // To Worker.RequestConnections (open loop only)
     uint64_t StreamsCreated {0};
     uint64_t StreamsActive {0};
+    uint64_t StartTime {0};
+    bool Connected {false};
+    bool WaitingForTicket {false}; // Handshake mode waits for a ticket to cache
     bool WorkerConnComplete {false}; // Indicated completion to worker
+    bool InRequestList {false}; // Open loop only
     PerfClientConnection(_In_ PerfClient& Client, _In_ PerfClientWorker& Worker) : Client(Client), Worker(Worker) { }
     ~PerfClientConnection();
     void Initialize();
-    void StartNewStream();
-    void OnHandshakeComplete();
+    void StartNewStream(uint64_t IntendedStartTime = 0);
+    void OnHandshakeComplete(bool SessionResumed = false);
+    void OnResumptionTicket(_In_reads_(Length) const uint8_t* Ticket, uint32_t Length);
     void OnShutdownComplete();
     void OnStreamShutdown();
     void Shutdown();
@@ -95,6 +104,16 @@ struct QUIC_CACHEALIGN PerfClientWorker {
     uint64_t ConnectionsCompleted {0};
     uint64_t StreamsStarted {0};
     uint64_t StreamsCompleted {0};
+    uint64_t HandshakesResumed {0};
+    uint64_t BytesSent {0};
+    uint64_t BytesReceived {0};
+    UniquePtr<uint8_t[]> ResumptionTicket; // Protected by Lock
+    uint32_t ResumptionTicketLength {0};
+    CXPLAT_LIST_ENTRY RequestConnections; // Protected by Lock
+    uint64_t RequestRate {0}; // This worker's share of the open loop rate
+    uint64_t RequestsScheduled {0};
+    uint64_t RequestBaseTime {0};
+    uint64_t NextRequestTime {0};
     UniquePtr<char[]> Target;
     QuicAddr LocalAddr;
     QuicAddr RemoteAddr;
@@ -102,7 +121,7 @@ struct QUIC_CACHEALIGN PerfClientWorker {
     CxPlatPoolT<PerfClientStream> StreamPool;
     CxPlatPoolT<TcpConnection> TcpConnectionPool;
     CxPlatPoolT<TcpSendData> TcpSendDataPool;
-    PerfClientWorker() { }
+    PerfClientWorker() { CxPlatListInitializeHead(&RequestConnections); }
     ~PerfClientWorker() { WaitForThread(); }
     void Uninitialize() { WaitForThread(); }
     void QueueNewConnection() {
@@ -124,6 +143,8 @@ private:
         }
     }
     void StartNewConnection();
+    uint32_t StartScheduledRequests();
+    void ScheduleNextRequest();
     void WorkerThread();
 };
 
@@ -140,8 +161,11 @@ struct PerfClient {
         _In_z_ const char* target);
     QUIC_STATUS Start(_In_ CXPLAT_EVENT* StopEvent);
     QUIC_STATUS Wait(_In_ int Timeout);
+    void PrintHandshakeResults();
+    void PrintStageCycles();
     uint32_t GetExtraDataLength();
     void GetExtraData(_Out_writes_bytes_(Length) uint8_t* Data, _In_ uint32_t Length);
+    void GetResults(_Out_ PERF_CLIENT_RESULTS* Results);
 
     bool Running {true};
     CXPLAT_EVENT* CompletionEvent {nullptr};
@@ -149,6 +173,13 @@ struct PerfClient {
     uint64_t CurLatencyIndex {0};
     uint64_t LatencyCount {0};
     UniquePtr<uint32_t[]> LatencyValues {nullptr}; // TODO - Move to Worker
+    UniquePtr<uint8_t[]> LatencyResumed {nullptr}; // Handshake mode only
+    uint64_t StartCpuTime {0};
+    uint64_t RunCpuTime {0};
+    uint64_t RunStartTime {0};
+    uint64_t RunEndTime {0};
+    QUIC_PERF_STAGE_CYCLES StartStageCycles[QUIC_PERF_STAGE_MAX] {};
+    int64_t StartPerfCounters[QUIC_PERF_COUNTER_MAX] {};
     PerfClientWorker Workers[PERF_MAX_THREAD_COUNT];
 
     UniquePtr<TcpEngine> Engine;
@@ -186,6 +217,7 @@ struct PerfClient {
 #endif
     // General parameters
     uint8_t UseTCP {FALSE};
+    uint8_t UseKernelTls {FALSE};
     uint8_t UseEncryption {TRUE};
     uint8_t UsePacing {TRUE};
     uint8_t UseSendBuffering {FALSE};
@@ -194,6 +226,7 @@ struct PerfClient {
     uint8_t PrintConnections {FALSE};
     uint8_t PrintStreams {FALSE};
     uint8_t PrintLatency {FALSE};
+    uint8_t PrintStages {FALSE};
     // Scenario parameters
     uint32_t ConnectionCount {1};
     uint32_t StreamCount {0};
@@ -205,6 +238,10 @@ struct PerfClient {
     uint8_t RepeatConnections {FALSE};
     uint8_t RepeatStreams {FALSE};
     uint64_t RunTime {0};
+    uint8_t HandshakeMode {FALSE};
+    uint8_t ResumePercent {0};
+    uint32_t RequestRate {0}; // Open loop requests per second, across all connections
+    uint8_t PoissonArrival {FALSE};
 
     struct PerfIoBuffer {
         QUIC_BUFFER* Buffer {nullptr};
@@ -242,6 +279,13 @@ struct PerfClient {
         }
         return ConnectionsCompleted;
     }
+    uint64_t GetHandshakesResumed() const {
+        uint64_t HandshakesResumed = 0;
+        for (uint32_t i = 0; i < WorkerCount; ++i) {
+            HandshakesResumed += Workers[i].HandshakesResumed;
+        }
+        return HandshakesResumed;
+    }
     uint64_t GetStreamsStarted() const {
         uint64_t StreamsStarted = 0;
         for (uint32_t i = 0; i < WorkerCount; ++i) {
@@ -249,6 +293,20 @@ struct PerfClient {
         }
         return StreamsStarted;
     }
+    uint64_t GetBytesSent() const {
+        uint64_t BytesSent = 0;
+        for (uint32_t i = 0; i < WorkerCount; ++i) {
+            BytesSent += Workers[i].BytesSent;
+        }
+        return BytesSent;
+    }
+    uint64_t GetBytesReceived() const {
+        uint64_t BytesReceived = 0;
+        for (uint32_t i = 0; i < WorkerCount; ++i) {
+            BytesReceived += Workers[i].BytesReceived;
+        }
+        return BytesReceived;
+    }
     uint64_t GetStreamsCompleted() const {
         uint64_t StreamsCompleted = 0;
         for (uint32_t i = 0; i < WorkerCount; ++i) {
@@ -0,0 +1,231 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    CPU efficiency accounting for secnetperf.
+
+--*/
+
+#include "PerfCpu.h"
+
+#if !defined(_KERNEL_MODE) && !defined(_WIN32)
+#include <sys/resource.h>
+#endif
+#if !defined(_KERNEL_MODE) && defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#ifdef QUIC_CLOG
+#include "PerfCpu.cpp.clog.h"
+#endif
+
+PerfCpuMonitor* CpuMonitor;
+
+uint64_t
+PerfGetProcessCpuTimeUs(
+    ) {
+#if defined(_KERNEL_MODE)
+    return 0;
+#elif defined(_WIN32)
+    FILETIME CreationTime, ExitTime, KernelTime, UserTime;
+    if (!GetProcessTimes(GetCurrentProcess(), &CreationTime, &ExitTime, &KernelTime, &UserTime)) {
+        return 0;
+    }
+    const uint64_t Kernel = ((uint64_t)KernelTime.dwHighDateTime << 32) | KernelTime.dwLowDateTime;
+    const uint64_t User = ((uint64_t)UserTime.dwHighDateTime << 32) | UserTime.dwLowDateTime;
+    return NS100_TO_US(Kernel + User);
+#else
+    struct rusage Usage;
+    if (getrusage(RUSAGE_SELF, &Usage) != 0) {
+        return 0;
+    }
+    return
+        S_TO_US((uint64_t)Usage.ru_utime.tv_sec) + (uint64_t)Usage.ru_utime.tv_usec +
+        S_TO_US((uint64_t)Usage.ru_stime.tv_sec) + (uint64_t)Usage.ru_stime.tv_usec;
+#endif
+}
+
+PerfCpuMonitor::PerfCpuMonitor(
+    ) {
+#if !defined(_KERNEL_MODE) && defined(__linux__)
+    //
+    // An inherited counter on this thread also counts every thread created
+    // after it, and reading it sums them all. This fails if perf events are
+    // restricted (perf_event_paranoid), in which case only CPU time is shown.
+    //
+    struct perf_event_attr Attr;
+    CxPlatZeroMemory(&Attr, sizeof(Attr));
+    Attr.type = PERF_TYPE_HARDWARE;
+    Attr.size = sizeof(Attr);
+    Attr.config = PERF_COUNT_HW_CPU_CYCLES;
+    Attr.inherit = 1;
+    Attr.exclude_hv = 1;
+    CycleCounter = (int)syscall(__NR_perf_event_open, &Attr, 0, -1, -1, 0);
+#endif
+}
+
+PerfCpuMonitor::~PerfCpuMonitor(
+    ) {
+#if !defined(_KERNEL_MODE) && defined(__linux__)
+    if (CycleCounter != -1) {
+        close(CycleCounter);
+    }
+#endif
+}
+
+bool
+PerfCpuMonitor::GetProcessCycles(
+    _Out_ uint64_t* Cycles
+    ) {
+    *Cycles = 0;
+#if defined(_KERNEL_MODE)
+    return false;
+#elif defined(_WIN32)
+    ULONG64 ProcessCycles;
+    if (!QueryProcessCycleTime(GetCurrentProcess(), &ProcessCycles)) {
+        return false;
+    }
+    *Cycles = ProcessCycles;
+    return true;
+#elif defined(__linux__)
+    return
+        CycleCounter != -1 &&
+        read(CycleCounter, Cycles, sizeof(*Cycles)) == sizeof(*Cycles);
+#else
+    return false;
+#endif
+}
+
+void
+PerfCpuMonitor::TakeSample(
+    _Out_ Sample* Sample
+    ) {
+    Sample->TimeUs = CxPlatTimeUs64();
+    Sample->CpuTimeUs = PerfGetProcessCpuTimeUs();
+    if (!GetProcessCycles(&Sample->Cycles)) {
+        Sample->Cycles = UINT64_MAX;
+    }
+
+    uint32_t Length = sizeof(Sample->Counters);
+    if (QUIC_FAILED(
+        MsQuic->GetParam(
+            nullptr,
+            QUIC_PARAM_GLOBAL_PERF_COUNTERS,
+            &Length,
+            Sample->Counters))) {
+        CxPlatZeroMemory(Sample->Counters, sizeof(Sample->Counters));
+    }
+
+    Sample->Workers.reset(nullptr);
+    Sample->WorkerCount = 0;
+    Length = 0;
+    if (MsQuic->GetParam(
+            nullptr,
+            QUIC_PARAM_GLOBAL_WORKER_STATISTICS,
+            &Length,
+            nullptr) != QUIC_STATUS_BUFFER_TOO_SMALL) {
+        return;
+    }
+    uint32_t Count = Length / sizeof(QUIC_WORKER_STATISTICS);
+    Sample->Workers.reset(new(std::nothrow) QUIC_WORKER_STATISTICS[Count]);
+    if (Sample->Workers == nullptr) {
+        return;
+    }
+    Length = Count * sizeof(QUIC_WORKER_STATISTICS);
+    if (QUIC_SUCCEEDED(
+        MsQuic->GetParam(
+            nullptr,
+            QUIC_PARAM_GLOBAL_WORKER_STATISTICS,
+            &Length,
+            Sample->Workers.get()))) {
+        Sample->WorkerCount = Length / sizeof(QUIC_WORKER_STATISTICS);
+    }
+}
+
+void
+PerfCpuMonitor::Start(
+    ) {
+    TakeSample(&StartSample);
+}
+
+void
+PerfCpuMonitor::Stop(
+    ) {
+    TakeSample(&EndSample);
+}
+
+void
+PerfCpuMonitor::Print(
+    _In_z_ const char* Side
+    ) {
+#ifdef _KERNEL_MODE
+    UNREFERENCED_PARAMETER(Side);
+    WriteOutput("CPU efficiency isn't available in kernel mode\n");
+#else
+    const uint64_t Elapsed = EndSample.TimeUs - StartSample.TimeUs;
+    const uint64_t CpuTime = EndSample.CpuTimeUs - StartSample.CpuTimeUs;
+    const uint64_t Bytes =
+        (uint64_t)(
+        (EndSample.Counters[QUIC_PERF_COUNTER_APP_SEND_BYTES] - StartSample.Counters[QUIC_PERF_COUNTER_APP_SEND_BYTES]) +
+        (EndSample.Counters[QUIC_PERF_COUNTER_APP_RECV_BYTES] - StartSample.Counters[QUIC_PERF_COUNTER_APP_RECV_BYTES]));
+    const uint64_t Packets =
+        (uint64_t)(
+        (EndSample.Counters[QUIC_PERF_COUNTER_UDP_SEND] - StartSample.Counters[QUIC_PERF_COUNTER_UDP_SEND]) +
+        (EndSample.Counters[QUIC_PERF_COUNTER_UDP_RECV] - StartSample.Counters[QUIC_PERF_COUNTER_UDP_RECV]));
+
+    WriteOutput(
+        "Result: %s CPU %llu us in %llu us (%llu%% of one core), %llu bytes, %llu packets\n",
+        Side,
+        (unsigned long long)CpuTime,
+        (unsigned long long)Elapsed,
+        (unsigned long long)(Elapsed ? CpuTime * 100 / Elapsed : 0),
+        (unsigned long long)Bytes,
+        (unsigned long long)Packets);
+
+    if (EndSample.Cycles != UINT64_MAX && StartSample.Cycles != UINT64_MAX) {
+        const uint64_t Cycles = EndSample.Cycles - StartSample.Cycles;
+        WriteOutput(
+            "Result: %s %.2f cycles/byte, %llu cycles/packet\n",
+            Side,
+            Bytes ? (double)Cycles / Bytes : 0.0,
+            (unsigned long long)(Packets ? Cycles / Packets : 0));
+    } else {
+        WriteOutput(
+            "Result: %s %.2f CPU ns/byte, %llu CPU ns/packet (cycle counter not available)\n",
+            Side,
+            Bytes ? (double)CpuTime * 1000 / Bytes : 0.0,
+            (unsigned long long)(Packets ? CpuTime * 1000 / Packets : 0));
+    }
+
+    for (uint32_t i = 0; i < EndSample.WorkerCount; ++i) {
+        const QUIC_WORKER_STATISTICS* End = &EndSample.Workers[i];
+        const QUIC_WORKER_STATISTICS* Begin = nullptr;
+        for (uint32_t j = 0; j < StartSample.WorkerCount; ++j) {
+            if (StartSample.Workers[j].Registration == End->Registration &&
+                StartSample.Workers[j].PartitionIndex == End->PartitionIndex) {
+                Begin = &StartSample.Workers[j];
+                break;
+            }
+        }
+        const uint64_t Busy = End->BusyTimeUs - (Begin ? Begin->BusyTimeUs : 0);
+        const uint64_t Operations =
+            End->OperationsProcessed - (Begin ? Begin->OperationsProcessed : 0);
+        if (Operations == 0) {
+            continue; // Didn't take part in the run.
+        }
+        WriteOutput(
+            "Result: %s worker %u (proc %u) %llu%% busy (%llu us), %llu operations\n",
+            Side,
+            i,
+            End->IdealProcessor,
+            (unsigned long long)(Elapsed ? Busy * 100 / Elapsed : 0),
+            (unsigned long long)Busy,
+            (unsigned long long)Operations);
+    }
+#endif // _KERNEL_MODE
+}
@@ -0,0 +1,66 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    CPU efficiency accounting for secnetperf. Samples the process's CPU time
+    and cycles, each MsQuic worker's busy time and the library's traffic
+    counters at the start and end of the measured interval, and reports the
+    cost per byte and per packet.
+
+--*/
+
+#pragma once
+
+#include "SecNetPerf.h"
+
+//
+// Returns the total (user and kernel) CPU time used by the process so far.
+// Always zero in kernel mode.
+//
+uint64_t
+PerfGetProcessCpuTimeUs(
+    );
+
+class PerfCpuMonitor {
+public:
+    //
+    // Must be created before MsQuic and the datapath create their threads, so
+    // that the cycle counter (Linux) follows them.
+    //
+    PerfCpuMonitor();
+    ~PerfCpuMonitor();
+
+    void Start();
+    void Stop();
+
+    //
+    // Prints the efficiency of the interval between Start and Stop. Side is
+    // "client" or "server".
+    //
+    void Print(_In_z_ const char* Side);
+
+private:
+    struct Sample {
+        uint64_t TimeUs {0};
+        uint64_t CpuTimeUs {0};
+        uint64_t Cycles {0};
+        int64_t Counters[QUIC_PERF_COUNTER_MAX] {0};
+        UniquePtr<QUIC_WORKER_STATISTICS[]> Workers;
+        uint32_t WorkerCount {0};
+    };
+
+    void TakeSample(_Out_ Sample* Sample);
+    bool GetProcessCycles(_Out_ uint64_t* Cycles);
+
+    Sample StartSample;
+    Sample EndSample;
+    int CycleCounter {-1}; // perf_event file descriptor on Linux
+};
+
+//
+// Set when CPU efficiency reporting (-pcpu) is enabled.
+//
+extern PerfCpuMonitor* CpuMonitor;
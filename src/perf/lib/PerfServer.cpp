@@ -10,6 +10,7 @@ Abstract:
 --*/
 
 #include "PerfServer.h"
+#include "PerfCpu.h"
 
 #ifdef QUIC_CLOG
 #include "PerfServer.cpp.clog.h"
@@ -96,6 +97,9 @@ PerfServer::Start(
     _In_ CXPLAT_EVENT* _StopEvent
     ) {
     StopEvent = _StopEvent;
+    if (CpuMonitor) {
+        CpuMonitor->Start();
+    }
     if (!Server.Start(&LocalAddr)) {
         WriteOutput("Warning: TCP Server failed to start!\n");
     }
@@ -111,6 +115,10 @@ PerfServer::Wait(
     } else {
         CxPlatEventWaitForever(*StopEvent);
     }
+    if (CpuMonitor) {
+        CpuMonitor->Stop();
+        CpuMonitor->Print("server");
+    }
     Registration.Shutdown(QUIC_CONNECTION_SHUTDOWN_FLAG_NONE, 0);
     return QUIC_STATUS_SUCCESS;
 }
@@ -56,6 +56,42 @@ extern uint8_t PerfDefaultHighPriority;
 
 extern CXPLAT_DATAPATH* Datapath;
 
+//
+// The totals of a finished client run.
+//
+typedef struct PERF_CLIENT_RESULTS {
+    uint64_t RunTimeUs;     // Measured from Start to the end of the run
+    uint64_t CpuTimeUs;     // Whole process, user and kernel (zero in kernel mode)
+    uint64_t ConnectionsConnected;
+    uint64_t ConnectionsCompleted;
+    uint64_t StreamsCompleted;
+    uint64_t BytesSent;     // Acknowledged stream payload
+    uint64_t BytesReceived; // Received stream payload
+} PERF_CLIENT_RESULTS;
+
+//
+// Parses the arguments and sets up the client or server, without starting it.
+//
+extern
+QUIC_STATUS
+QuicMainInit(
+    _In_ int argc,
+    _In_reads_(argc) _Null_terminated_ char* argv[],
+    _In_opt_ const QUIC_CREDENTIAL_CONFIG* SelfSignedCredConfig
+    );
+
+//
+// Starts the client or server set up by QuicMainInit.
+//
+extern
+QUIC_STATUS
+QuicMainRun(
+    _In_ CXPLAT_EVENT* StopEvent
+    );
+
+//
+// QuicMainInit followed by QuicMainRun.
+//
 extern
 QUIC_STATUS
 QuicMainStart(
@@ -87,6 +123,12 @@ QuicMainGetExtraData(
     _In_ uint32_t Length
     );
 
+extern
+bool
+QuicMainGetClientResults(
+    _Out_ PERF_CLIENT_RESULTS* Results
+    );
+
 inline
 const char*
 TryGetTarget(
@@ -174,11 +216,15 @@ QuicPrintConnectionStatistics(
         "  SendSpuriousLostPackets   %llu\n"
         "  SendCongestionCount       %u\n"
         "  SendEcnCongestionCount    %u\n"
+        "  SendCeMarkedPackets       %llu\n"
+        "  L4sEnabled                %u\n"
+        "  L4sAlpha                  %u/1024\n"
         "  RecvTotalPackets          %llu\n"
         "  RecvReorderedPackets      %llu\n"
         "  RecvDroppedPackets        %llu\n"
         "  RecvDuplicatePackets      %llu\n"
-        "  RecvDecryptionFailures    %llu\n",
+        "  RecvDecryptionFailures    %llu\n"
+        "  SendLimited (us)          cc %llu, pacing %llu, amplification %llu, conn fc %llu, stream fc %llu, app %llu, scheduling %llu\n",
         Stats.Rtt,
         Stats.MinRtt,
         Stats.EcnCapable,
@@ -187,11 +233,21 @@ QuicPrintConnectionStatistics(
         (unsigned long long)Stats.SendSpuriousLostPackets,
         Stats.SendCongestionCount,
         Stats.SendEcnCongestionCount,
+        (unsigned long long)Stats.SendCeMarkedPackets,
+        Stats.L4sEnabled,
+        Stats.SendL4sAlpha,
         (unsigned long long)Stats.RecvTotalPackets,
         (unsigned long long)Stats.RecvReorderedPackets,
         (unsigned long long)Stats.RecvDroppedPackets,
         (unsigned long long)Stats.RecvDuplicatePackets,
-        (unsigned long long)Stats.RecvDecryptionFailures);
+        (unsigned long long)Stats.RecvDecryptionFailures,
+        (unsigned long long)Stats.SendCongestionLimitedTimeUs,
+        (unsigned long long)Stats.SendPacingLimitedTimeUs,
+        (unsigned long long)Stats.SendAmplificationLimitedTimeUs,
+        (unsigned long long)Stats.SendConnFlowControlLimitedTimeUs,
+        (unsigned long long)Stats.SendStreamFlowControlLimitedTimeUs,
+        (unsigned long long)Stats.SendAppLimitedTimeUs,
+        (unsigned long long)Stats.SendSchedulingLimitedTimeUs);
 }
 
 inline
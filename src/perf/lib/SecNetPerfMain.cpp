@@ -13,6 +13,8 @@ Abstract:
 #include "PerfServer.h"
 #include "PerfClient.h"
 #include "Tcp.h"
+#include "PerfCpu.h"
+#include "msquicp.h"
 
 const MsQuicApi* MsQuic;
 CXPLAT_WORKER_POOL WorkerPool;
@@ -34,6 +36,51 @@ volatile int BufferCurrent;
 char Buffer[BufferLength];
 #endif
 
+#ifndef _KERNEL_MODE
+//
+// Parses a network emulation link spec of comma separated <name>=<value>
+// pairs, for example "bw=10000,delay=20000,loss=1000".
+//
+static
+bool
+ParseEmulationLink(
+    _In_z_ const char* Spec,
+    _Inout_ QUIC_NETWORK_EMULATION_LINK* Link
+    ) {
+    while (*Spec) {
+        const char* Equals = strchr(Spec, '=');
+        if (Equals == nullptr) {
+            return false;
+        }
+        size_t NameLength = (size_t)(Equals - Spec);
+        char* End;
+        uint32_t Value = (uint32_t)strtoul(Equals + 1, &End, 10);
+        if (End == Equals + 1 || (*End != ',' && *End != '\0')) {
+            return false;
+        }
+        if (NameLength == 2 && !strncmp(Spec, "bw", 2)) {
+            Link->BandwidthKbps = Value;
+        } else if (NameLength == 5 && !strncmp(Spec, "queue", 5)) {
+            Link->QueueBytes = Value;
+        } else if (NameLength == 5 && !strncmp(Spec, "delay", 5)) {
+            Link->DelayUs = Value;
+        } else if (NameLength == 6 && !strncmp(Spec, "jitter", 6)) {
+            Link->JitterUs = Value;
+        } else if (NameLength == 4 && !strncmp(Spec, "loss", 4)) {
+            Link->LossRate = Value;
+        } else if (NameLength == 5 && !strncmp(Spec, "burst", 5)) {
+            Link->LossBurstLength = Value;
+        } else if (NameLength == 7 && !strncmp(Spec, "reorder", 7)) {
+            Link->ReorderRate = Value;
+        } else {
+            return false;
+        }
+        Spec = *End == ',' ? End + 1 : End;
+    }
+    return true;
+}
+#endif // _KERNEL_MODE
+
 static
 void
 PrintHelp(
@@ -68,9 +115,11 @@ PrintHelp(
         "\n"
         "  Config options:\n"
         "  -tcp:<0/1>               Disables/enables TCP usage (instead of QUIC). (def:0)\n"
+        "  -ktls:<0/1>              Disables/enables kernel TLS offload in TCP mode, Linux only. (def:0)\n"
         "  -encrypt:<0/1>           Disables/enables encryption. (def:1)\n"
         "  -pacing:<0/1>            Disables/enables send pacing. (def:1)\n"
-        "  -sendbuf:<0/1>           Disables/enables send buffering. (def:0)\n"
+        "  -sendbuf:<0/1/2>         Disables/enables send buffering. 2 also registers the send\n"
+        "                           data so buffering doesn't copy it. (def:0)\n"
         "  -ptput:<0/1>             Print throughput information. (def:0)\n"
         "  -pconn:<0/1>             Print connection statistics. (def:0)\n"
         "  -pstream:<0/1>           Print stream statistics. (def:0)\n"
@@ -86,21 +135,41 @@ PrintHelp(
         "  -rconn:<0/1>             Repeat the scenario at the connection level. (def:0)\n"
         "  -rstream:<0/1>           Repeat the scenario at the stream level. (def:0)\n"
         "  -runtime:<####>[unit]    The total runtime, with an optional unit (def unit is us). Only relevant for repeat scenarios. (def:0)\n"
+        "  -handshake:<0/1>         Repeat handshakes only and print the handshake rate, CPU and latency. Requires a runtime. (def:0)\n"
+        "  -resume:<0-100>          The percentage of handshakes that use resumption, in the handshake scenario. (def:0)\n"
+        "  -rate:<####>             Send requests open loop at this total rate per second, measuring latency from each request's scheduled time. Requires a runtime. (def:0)\n"
+        "  -arrival:<type>          The open loop arrival process. (def:constant)\n"
+        "                            - {constant, poisson}.\n"
         "\n"
         "Both (client & server) options:\n"
         "  -exec:<profile>          Execution profile to use.\n"
         "                            - {lowlat, maxtput, scavenger, realtime}.\n"
         "  -cc:<algo>               Congestion control algorithm to use.\n"
-        "                            - {cubic, bbr}.\n"
+        "                            - {cubic, bbr, bbr3, prague, copa}.\n"
         "  -pollidle:<time_us>      Amount of time to poll while idle before sleeping (default: 0).\n"
         "  -ecn:<0/1>               Enables/disables sender-side ECN support. (def:0)\n"
         "  -qeo:<0/1>               Allows/disallowes QUIC encryption offload. (def:0)\n"
+        "  -pcpu:<0/1>              Print CPU time, cycles/byte, cycles/packet and worker busy time for the run. (def:0)\n"
 #ifndef _KERNEL_MODE
         "  -io:<mode>               Configures a requested network IO model to be used.\n"
-        "                            - {iocp, rio, xdp, qtip, wsk, epoll, kqueue}\n"
+        "                            - {iocp, rio, xdp, qtip, wsk, epoll, iouring, kqueue}\n"
         "  -cpu:<cpu_index>         Specify the processor(s) to use.\n"
         "  -cipher:<value>          Decimal value of 1 or more QUIC_ALLOWED_CIPHER_SUITE_FLAGS.\n"
         "  -highpri:<0/1>           Configures MsQuic to run threads at high priority. (def:0)\n"
+        "  -busypoll:<0/1>          Busy polls the NIC queues while idle (Linux epoll). (def:0)\n"
+        "  -emu:<spec>              Emulates a network link on the receive path of this process.\n"
+        "                            - Comma separated bw=<kbps>,queue=<bytes>,delay=<us>,jitter=<us>,\n"
+        "                              loss=<ppm>,burst=<packets>,reorder=<ppm>.\n"
+        "  -emu_up:<spec>           Overrides -emu for the client to server direction.\n"
+        "  -emu_down:<spec>         Overrides -emu for the server to client direction.\n"
+        "  -emu_seed:<####>         Seeds the emulated loss, jitter and reordering. (def:random)\n"
+        "\n"
+        "Distributed client:\n"
+        "\n"
+        "  Agent: secnetperf -agent:1 [-agentport:<####>]\n"
+        "  Coordinator: secnetperf -agents:<host>[,<host>...] -target:<hostname/ip> [client options]\n"
+        "\n"
+        "  -agentport:<####>        The TCP port agents listen on for the coordinator. (def:4434)\n"
 #endif // _KERNEL_MODE
         "\n",
         PERF_DEFAULT_PORT,
@@ -109,10 +178,9 @@ PrintHelp(
 }
 
 QUIC_STATUS
-QuicMainStart(
+QuicMainInit(
     _In_ int argc,
     _In_reads_(argc) _Null_terminated_ char* argv[],
-    _In_ CXPLAT_EVENT* StopEvent,
     _In_opt_ const QUIC_CREDENTIAL_CONFIG* SelfSignedCredConfig
     ) {
     argc--; argv++; // Skip app name
@@ -130,6 +198,15 @@ QuicMainStart(
 
     TryGetValue(argc, argv, "maxruntime", &MaxRuntime);
 
+    //
+    // Created before anything else, so its cycle counter covers every thread.
+    //
+    uint8_t PrintCpu = false;
+    TryGetValue(argc, argv, "pcpu", &PrintCpu);
+    if (PrintCpu) {
+        CpuMonitor = new(std::nothrow) PerfCpuMonitor;
+    }
+
     QUIC_STATUS Status = QUIC_STATUS_OUT_OF_MEMORY;
     MsQuic = new(std::nothrow) MsQuicApi;
     if (!MsQuic || QUIC_FAILED(Status = MsQuic->GetInitStatus())) {
@@ -160,6 +237,11 @@ QuicMainStart(
         SetConfig = true;
     }
 
+    if (IoMode && IsValue(IoMode, "iouring")) {
+        Config->Flags |= QUIC_EXECUTION_CONFIG_FLAG_IO_URING;
+        SetConfig = true;
+    }
+
     const char* CpuStr;
     if ((CpuStr = GetValue(argc, argv, "cpu")) != nullptr) {
         SetConfig = true;
@@ -181,6 +263,13 @@ QuicMainStart(
         Config->Flags |= QUIC_EXECUTION_CONFIG_FLAG_HIGH_PRIORITY;
         SetConfig = true;
     }
+
+    uint8_t BusyPoll = false;
+    TryGetValue(argc, argv, "busypoll", &BusyPoll);
+    if (BusyPoll) {
+        Config->Flags |= QUIC_EXECUTION_CONFIG_FLAG_BUSY_POLL;
+        SetConfig = true;
+    }
 #endif // _KERNEL_MODE
 
     if (TryGetValue(argc, argv, "pollidle", &Config->PollingIdleTimeoutUs)) {
@@ -199,6 +288,33 @@ QuicMainStart(
         return Status;
     }
 
+#ifndef _KERNEL_MODE
+    const char* EmuAll = GetValue(argc, argv, "emu");
+    const char* EmuUp = GetValue(argc, argv, "emu_up");
+    const char* EmuDown = GetValue(argc, argv, "emu_down");
+    if (EmuAll || EmuUp || EmuDown) {
+        QUIC_NETWORK_EMULATION_SETTINGS Emulation{};
+        if ((EmuAll && !ParseEmulationLink(EmuAll, &Emulation.ClientToServer)) ||
+            (EmuAll && !ParseEmulationLink(EmuAll, &Emulation.ServerToClient)) ||
+            (EmuUp && !ParseEmulationLink(EmuUp, &Emulation.ClientToServer)) ||
+            (EmuDown && !ParseEmulationLink(EmuDown, &Emulation.ServerToClient))) {
+            WriteOutput("Failed to parse network emulation settings\n");
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
+        TryGetValue(argc, argv, "emu_seed", &Emulation.RandomSeed);
+        if (QUIC_FAILED(
+            Status =
+            MsQuic->SetParam(
+                nullptr,
+                QUIC_PARAM_GLOBAL_NETWORK_EMULATION,
+                sizeof(Emulation),
+                &Emulation))) {
+            WriteOutput("Failed to set network emulation %d\n", Status);
+            return Status;
+        }
+    }
+#endif // _KERNEL_MODE
+
     const char* ExecStr = GetValue(argc, argv, "exec");
     if (ExecStr != nullptr) {
         if (IsValue(ExecStr, "lowlat")) {
@@ -220,6 +336,12 @@ QuicMainStart(
     if (CcName != nullptr) {
         if (IsValue(CcName, "cubic")) {
             PerfDefaultCongestionControl = QUIC_CONGESTION_CONTROL_ALGORITHM_CUBIC;
+        } else if (IsValue(CcName, "copa")) {
+            PerfDefaultCongestionControl = QUIC_CONGESTION_CONTROL_ALGORITHM_COPA;
+        } else if (IsValue(CcName, "prague")) {
+            PerfDefaultCongestionControl = QUIC_CONGESTION_CONTROL_ALGORITHM_PRAGUE;
+        } else if (IsValue(CcName, "bbr3")) {
+            PerfDefaultCongestionControl = QUIC_CONGESTION_CONTROL_ALGORITHM_BBR3;
         } else if (IsValue(CcName, "bbr")) {
             PerfDefaultCongestionControl = QUIC_CONGESTION_CONTROL_ALGORITHM_BBR;
         } else {
@@ -250,15 +372,13 @@ QuicMainStart(
 
     if (Target) {
         Client = new(std::nothrow) PerfClient;
-        if ((QUIC_SUCCEEDED(Status = Client->Init(argc, argv, Target)) &&
-             QUIC_SUCCEEDED(Status = Client->Start(StopEvent)))) {
+        if (QUIC_SUCCEEDED(Status = Client->Init(argc, argv, Target))) {
             return QUIC_STATUS_SUCCESS;
         }
     } else {
         CXPLAT_FRE_ASSERT(SelfSignedCredConfig);
         Server = new(std::nothrow) PerfServer(SelfSignedCredConfig);
-        if ((QUIC_SUCCEEDED(Status = Server->Init(argc, argv)) &&
-             QUIC_SUCCEEDED(Status = Server->Start(StopEvent)))) {
+        if (QUIC_SUCCEEDED(Status = Server->Init(argc, argv))) {
             return QUIC_STATUS_SUCCESS;
         }
     }
@@ -268,6 +388,27 @@ QuicMainStart(
     return Status; // QuicMainFree is called on failure
 }
 
+QUIC_STATUS
+QuicMainRun(
+    _In_ CXPLAT_EVENT* StopEvent
+    ) {
+    return Client ? Client->Start(StopEvent) : Server->Start(StopEvent);
+}
+
+QUIC_STATUS
+QuicMainStart(
+    _In_ int argc,
+    _In_reads_(argc) _Null_terminated_ char* argv[],
+    _In_ CXPLAT_EVENT* StopEvent,
+    _In_opt_ const QUIC_CREDENTIAL_CONFIG* SelfSignedCredConfig
+    ) {
+    QUIC_STATUS Status = QuicMainInit(argc, argv, SelfSignedCredConfig);
+    if (QUIC_SUCCEEDED(Status) && QUIC_FAILED(Status = QuicMainRun(StopEvent))) {
+        WriteOutput("\nPlease run 'secnetperf -help' for command line options.\n");
+    }
+    return Status; // QuicMainFree is called on failure
+}
+
 QUIC_STATUS
 QuicMainWaitForCompletion(
     ) {
@@ -293,6 +434,20 @@ QuicMainFree(
 
     delete Watchdog;
     Watchdog = nullptr;
+
+    delete CpuMonitor;
+    CpuMonitor = nullptr;
+
+    //
+    // Restore the option defaults, for agents that run more than one client.
+    //
+    MaxRuntime = 0;
+    PerfDefaultExecutionProfile = QUIC_EXECUTION_PROFILE_LOW_LATENCY;
+    TcpDefaultExecutionProfile = TCP_EXECUTION_PROFILE_LOW_LATENCY;
+    PerfDefaultCongestionControl = QUIC_CONGESTION_CONTROL_ALGORITHM_CUBIC;
+    PerfDefaultEcnEnabled = false;
+    PerfDefaultQeoAllowed = false;
+    PerfDefaultHighPriority = false;
 }
 
 uint32_t QuicMainGetExtraDataLength() {
@@ -308,3 +463,15 @@ QuicMainGetExtraData(
     CXPLAT_FRE_ASSERT(Client);
     Client->GetExtraData(Data, Length);
 }
+
+bool
+QuicMainGetClientResults(
+    _Out_ PERF_CLIENT_RESULTS* Results
+    )
+{
+    if (!Client) {
+        return false;
+    }
+    Client->GetResults(Results);
+    return true;
+}
@@ -22,6 +22,7 @@ extern CXPLAT_WORKER_POOL WorkerPool;
 
 #define FRAME_TYPE_CRYPTO   0
 #define FRAME_TYPE_STREAM   1
+#define FRAME_TYPE_KTLS_READY 2 // Server switched to kTLS; no payload
 
 #pragma pack(push)
 #pragma pack(1)
@@ -204,7 +205,10 @@ bool TcpWorker::Initialize(TcpEngine* _Engine, uint16_t PartitionIndex)
 
     #ifndef _KERNEL_MODE // Not supported on kernel mode
     if (Engine->TcpExecutionProfile == TCP_EXECUTION_PROFILE_LOW_LATENCY) {
-        CxPlatAddExecutionContext(&WorkerPool, &ExecutionContext, PartitionIndex);
+        if (!CxPlatAddExecutionContext(&WorkerPool, &ExecutionContext, PartitionIndex)) {
+            WriteOutput("CxPlatAddExecutionContext FAILED\n");
+            return false;
+        }
         Initialized = true;
         IsExternal = true;
         return true;
@@ -385,8 +389,9 @@ TcpServer::AcceptCallback(
 TcpConnection::TcpConnection(
     TcpEngine* Engine,
     const QUIC_CREDENTIAL_CONFIG* CredConfig,
-    void* Context) :
-    IsServer(false), Engine(Engine), Context(Context)
+    void* Context,
+    bool KernelTls) :
+    IsServer(false), KernelTls(KernelTls), Engine(Engine), Context(Context)
 {
     CxPlatRefInitialize(&Ref);
     CxPlatEventInitialize(&CloseComplete, TRUE, FALSE);
@@ -604,12 +609,20 @@ TcpConnection::SendCompleteCallback(
 _IRQL_requires_max_(PASSIVE_LEVEL)
 BOOLEAN
 TcpConnection::TlsReceiveTpCallback(
-    _In_ QUIC_CONNECTION* /* Context */,
+    _In_ QUIC_CONNECTION* Context,
     _In_ uint16_t TPLength,
-    _In_reads_(TPLength) const uint8_t* /* TPBuffer */
+    _In_reads_(TPLength) const uint8_t* TPBuffer
     )
 {
-    UNREFERENCED_PARAMETER(TPLength);
+    //
+    // The only transport parameter is the kTLS byte: the client's request, or
+    // the server's support for it.
+    //
+    auto This = (TcpConnection*)(void*)Context;
+    This->PeerKernelTls = TPLength != 0 && TPBuffer[0] == 1;
+    if (This->IsServer) {
+        This->KernelTls = This->PeerKernelTls;
+    }
     return TRUE;
 }
 
@@ -665,7 +678,8 @@ void TcpConnection::Process()
         Engine->ConnectHandler(this, true);
         WorkerThreadID = 0;
     }
-    if (TlsState.WriteKey >= QUIC_PACKET_KEY_1_RTT && SendData && !Shutdown) {
+    if (TlsState.WriteKey >= QUIC_PACKET_KEY_1_RTT &&
+        (!KernelTls || KernelTlsSend) && SendData && !Shutdown) {
         if (!ProcessSend()) {
             Shutdown = true;
         }
@@ -710,7 +724,12 @@ bool TcpConnection::InitializeTls()
 {
     const uint32_t LocalTPLength = 2;
     uint8_t* LocalTP = (uint8_t*)CXPLAT_ALLOC_NONPAGED(CxPlatTlsTPHeaderSize + LocalTPLength, QUIC_POOL_TLS_TRANSPARAMS);
-    CxPlatZeroMemory(LocalTP, LocalTPLength);
+    CxPlatZeroMemory(LocalTP, CxPlatTlsTPHeaderSize + LocalTPLength);
+#if defined(__linux__) && !defined(_KERNEL_MODE)
+    LocalTP[CxPlatTlsTPHeaderSize] = IsServer || KernelTls ? 1 : 0;
+#else
+    LocalTP[CxPlatTlsTPHeaderSize] = !IsServer && KernelTls ? 1 : 0;
+#endif
 
     CXPLAT_TLS_CONFIG Config;
     CxPlatZeroMemory(&Config, sizeof(Config));
@@ -763,7 +782,11 @@ bool TcpConnection::ProcessTls(const uint8_t* Buffer, uint32_t BufferLength)
     CXPLAT_DBG_ASSERT(BaseOffset + TlsState.BufferLength == TlsState.BufferTotalLength);
 
     if (Results & CXPLAT_TLS_RESULT_HANDSHAKE_COMPLETE) {
-        IndicateConnect = true;
+        if (!KernelTls) {
+            IndicateConnect = true;
+        } else if (!StartKernelTls()) {
+            return false;
+        }
     }
 
     while (!Shutdown && BaseOffset < TlsState.BufferTotalLength) {
@@ -819,7 +842,7 @@ bool TcpConnection::SendTlsData(const uint8_t* Buffer, uint16_t BufferLength, ui
         return false;
     }
 
-    SendBuffer->Length = sizeof(TcpFrame) + Frame->Length + CXPLAT_ENCRYPTION_OVERHEAD;
+    SendBuffer->Length = sizeof(TcpFrame) + Frame->Length + SendOverhead();
     FinalizeSendBuffer(SendBuffer);
 
     return true;
@@ -864,7 +887,7 @@ bool TcpConnection::ProcessReceiveData(const uint8_t* Buffer, uint32_t BufferLen
         }
 
         auto Frame = (TcpFrame*)BufferedData;
-        auto FrameLength = (uint32_t)sizeof(TcpFrame) + Frame->Length + CXPLAT_ENCRYPTION_OVERHEAD;
+        auto FrameLength = (uint32_t)sizeof(TcpFrame) + Frame->Length + RecvOverhead();
         auto BytesNeeded = FrameLength - BufferedDataLength;
         if (BufferLength < BytesNeeded) {
             goto BufferData;
@@ -885,16 +908,21 @@ bool TcpConnection::ProcessReceiveData(const uint8_t* Buffer, uint32_t BufferLen
     while (BufferLength) {
         auto Frame = (TcpFrame*)Buffer;
         if (BufferLength < sizeof(TcpFrame) ||
-            BufferLength < sizeof(TcpFrame) + Frame->Length + CXPLAT_ENCRYPTION_OVERHEAD) {
+            BufferLength < sizeof(TcpFrame) + Frame->Length + RecvOverhead()) {
             goto BufferData;
         }
 
+        //
+        // Processing the frame can switch receive to kTLS, so its length must
+        // be computed before.
+        //
+        auto FrameLength = (uint32_t)sizeof(TcpFrame) + Frame->Length + RecvOverhead();
         if (!ProcessReceiveFrame(Frame)) {
             return false;
         }
 
-        Buffer += sizeof(TcpFrame) + Frame->Length + CXPLAT_ENCRYPTION_OVERHEAD;
-        BufferLength -= sizeof(TcpFrame) + Frame->Length + CXPLAT_ENCRYPTION_OVERHEAD;
+        Buffer += FrameLength;
+        BufferLength -= FrameLength;
     }
 
     return true;
@@ -909,11 +937,11 @@ BufferData:
 
 bool TcpConnection::ProcessReceiveFrame(TcpFrame* Frame)
 {
-    if (Frame->KeyType != QUIC_PACKET_KEY_INITIAL) {
-        if (Frame->KeyType > TlsState.ReadKey) {
-            WriteOutput("Invalid Key Type\n");
-            return false; // Shouldn't be possible
-        }
+    if (Frame->KeyType > TlsState.ReadKey) {
+        WriteOutput("Invalid Key Type\n");
+        return false; // Shouldn't be possible
+    }
+    if (Frame->KeyType != QUIC_PACKET_KEY_INITIAL && !KernelTlsRecv) {
         CXPLAT_DBG_ASSERT(TlsState.ReadKeys[Frame->KeyType]->PacketKey);
         if (QUIC_FAILED(
             CxPlatDecrypt(
@@ -958,6 +986,12 @@ bool TcpConnection::ProcessReceiveFrame(TcpFrame* Frame)
         }
         break;
     }
+    case FRAME_TYPE_KTLS_READY:
+        if (IsServer || !KernelTlsRecv || KernelTlsSend || !EnableKernelTls(true)) {
+            return false;
+        }
+        IndicateConnect = true;
+        break;
     default:
         return false;
     }
@@ -988,7 +1022,7 @@ bool TcpConnection::ProcessSend()
                 return false;
             }
 
-            uint32_t StreamLength = TLS_BLOCK_SIZE - sizeof(TcpFrame) - sizeof(TcpStreamFrame) - CXPLAT_ENCRYPTION_OVERHEAD;
+            uint32_t StreamLength = TLS_BLOCK_SIZE - sizeof(TcpFrame) - sizeof(TcpStreamFrame) - SendOverhead();
             if (NextSendData->Length - Offset < StreamLength) {
                 StreamLength = NextSendData->Length - Offset;
             }
@@ -1021,7 +1055,7 @@ bool TcpConnection::ProcessSend()
                 return false;
             }
 
-            SendBuffer->Length = sizeof(TcpFrame) + Frame->Length + CXPLAT_ENCRYPTION_OVERHEAD;
+            SendBuffer->Length = sizeof(TcpFrame) + Frame->Length + SendOverhead();
             FinalizeSendBuffer(SendBuffer);
 
         } while (!Shutdown && NextSendData->Length > Offset);
@@ -1072,6 +1106,7 @@ bool TcpConnection::EncryptFrame(TcpFrame* Frame)
 {
     return
         Frame->KeyType == QUIC_PACKET_KEY_INITIAL ||
+        KernelTlsSend ||
         QUIC_SUCCEEDED(
         CxPlatEncrypt(
             TlsState.WriteKeys[Frame->KeyType]->PacketKey,
@@ -1082,6 +1117,103 @@ bool TcpConnection::EncryptFrame(TcpFrame* Frame)
             Frame->Data));
 }
 
+//
+// kTLS takes over the 1-RTT record protection once the handshake completes.
+// Each side must switch exactly between two frames in each byte stream: the
+// client switches receive before sending its Finished, and the server switches
+// both directions when it receives that Finished, then sends a KTLS_READY
+// frame. Only on receiving that does the client switch send and start sending
+// app data. So neither side ever has data in flight across its peer's switch.
+//
+bool TcpConnection::StartKernelTls()
+{
+    if (!IsServer) {
+        if (!PeerKernelTls) {
+            WriteOutput("Server doesn't support kTLS\n");
+            return false;
+        }
+        return EnableKernelTls(false);
+    }
+    if (!EnableKernelTls(true) || !EnableKernelTls(false)) {
+        return false;
+    }
+    IndicateConnect = true;
+    return SendKernelTlsReady();
+}
+
+bool TcpConnection::EnableKernelTls(bool Send)
+{
+    const QUIC_PACKET_KEY* Key =
+        Send ?
+            TlsState.WriteKeys[QUIC_PACKET_KEY_1_RTT] :
+            TlsState.ReadKeys[QUIC_PACKET_KEY_1_RTT];
+    CXPLAT_DBG_ASSERT(Key != nullptr);
+
+    CXPLAT_QEO_CIPHER_TYPE CipherType;
+    switch (Key->TrafficSecret[0].Aead) {
+    case CXPLAT_AEAD_AES_128_GCM:
+        CipherType = CXPLAT_QEO_CIPHER_TYPE_AEAD_AES_128_GCM;
+        break;
+    case CXPLAT_AEAD_AES_256_GCM:
+        CipherType = CXPLAT_QEO_CIPHER_TYPE_AEAD_AES_256_GCM;
+        break;
+    case CXPLAT_AEAD_CHACHA20_POLY1305:
+        CipherType = CXPLAT_QEO_CIPHER_TYPE_AEAD_CHACHA20_POLY1305;
+        break;
+    default:
+        WriteOutput("Cipher not supported by kTLS\n");
+        return false;
+    }
+
+    CXPLAT_QEO_CONNECTION Offload;
+    CxPlatZeroMemory(&Offload, sizeof(Offload));
+    QUIC_STATUS Status =
+        QuicPacketKeyDeriveOffload(
+            &TcpHkdfLabels,
+            Key,
+            Send ? "ktls tx" : "ktls rx",
+            &Offload);
+    if (QUIC_SUCCEEDED(Status)) {
+        Status =
+            CxPlatSocketSetTcpTls(
+                Socket,
+                Send ? TRUE : FALSE,
+                CipherType,
+                Offload.PayloadKey,
+                Offload.PayloadIv);
+    }
+    CxPlatSecureZeroMemory(&Offload, sizeof(Offload));
+    if (QUIC_FAILED(Status)) {
+        WriteOutput("Enabling kTLS %s FAILED, 0x%x\n", Send ? "send" : "receive", Status);
+        return false;
+    }
+
+    if (Send) {
+        KernelTlsSend = true;
+    } else {
+        KernelTlsRecv = true;
+    }
+    return true;
+}
+
+bool TcpConnection::SendKernelTlsReady()
+{
+    auto SendBuffer = NewSendBuffer();
+    if (!SendBuffer) {
+        return false;
+    }
+
+    auto Frame = (TcpFrame*)SendBuffer->Buffer;
+    Frame->FrameType = FRAME_TYPE_KTLS_READY;
+    Frame->Length = 0;
+    Frame->KeyType = QUIC_PACKET_KEY_1_RTT;
+
+    SendBuffer->Length = sizeof(TcpFrame) + SendOverhead();
+    FinalizeSendBuffer(SendBuffer);
+
+    return true;
+}
+
 QUIC_BUFFER* TcpConnection::NewSendBuffer()
 {
     if (Shutdown || !Socket) { // Queue (from Engine shutdown) happened before socket creation finished
@@ -187,6 +187,10 @@ class TcpConnection {
     bool IndicateConnect{false};
     bool IndicateSendComplete{false};
     bool HasRundownRef{false};
+    bool KernelTls{false};      // Client: requested. Server: requested by the client.
+    bool PeerKernelTls{false};  // The peer's transport parameter allowed kTLS.
+    bool KernelTlsSend{false};  // Send record protection is done by the kernel.
+    bool KernelTlsRecv{false};  // Receive record protection is done by the kernel.
     TcpConnection* Next{nullptr};
     TcpEngine* Engine;
     TcpWorker* Worker{nullptr};
@@ -266,6 +270,11 @@ class TcpConnection {
     bool ProcessSend();
     void ProcessSendComplete();
     bool EncryptFrame(TcpFrame* Frame);
+    bool StartKernelTls();
+    bool EnableKernelTls(bool Send);
+    bool SendKernelTlsReady();
+    uint32_t SendOverhead() const { return KernelTlsSend ? 0 : CXPLAT_ENCRYPTION_OVERHEAD; }
+    uint32_t RecvOverhead() const { return KernelTlsRecv ? 0 : CXPLAT_ENCRYPTION_OVERHEAD; }
     QUIC_BUFFER* NewSendBuffer();
     void FreeSendBuffer(QUIC_BUFFER* SendBuffer);
     void FinalizeSendBuffer(QUIC_BUFFER* SendBuffer);
@@ -276,7 +285,8 @@ public:
     TcpConnection(
         _In_ TcpEngine* Engine,
         _In_ const QUIC_CREDENTIAL_CONFIG* CredConfig,
-        _In_ void* Context = nullptr);
+        _In_ void* Context = nullptr,
+        _In_ bool KernelTls = false);
     bool IsInitialized() const { return Initialized; }
     void Close();
     bool Start(
@@ -7,7 +7,7 @@
 
 Abstract:
 
-    Read the memory limit for the current process
+    Read the memory and CPU limits for the current process
 
 Environment:
 
@@ -45,6 +45,9 @@ Environment:
 #define PROC_CGROUP_FILENAME "/proc/self/cgroup"
 #define CGROUP1_MEMORY_LIMIT_FILENAME "/memory.limit_in_bytes"
 #define CGROUP2_MEMORY_LIMIT_FILENAME "/memory.max"
+#define CGROUP1_CFS_QUOTA_FILENAME "/cpu.cfs_quota_us"
+#define CGROUP1_CFS_PERIOD_FILENAME "/cpu.cfs_period_us"
+#define CGROUP2_CPU_MAX_FILENAME "/cpu.max"
 
 static int CGroupVersion = 0;
 static char* CGroupMemoryPath = NULL;
@@ -128,6 +131,16 @@ IsCGroup1MemorySubsystem(
     return strcmp("memory", strTok) == 0;
 }
 
+static
+_Success_(return != FALSE)
+BOOLEAN
+IsCGroup1CpuSubsystem(
+    _In_z_ const char *strTok
+    )
+{
+    return strcmp("cpu", strTok) == 0;
+}
+
 static
 _Success_(return == 1 || return == 2)
 int
@@ -571,3 +584,97 @@ Done:
 
     return PhysicalMemoryLimit;
 }
+
+//
+// Reads a signed number from the start of a file. "max" (cgroup v2's
+// unlimited) reads as -1.
+//
+static
+_Success_(return != FALSE)
+BOOLEAN
+ReadCpuValueFromFile(
+    _In_z_ const char* Path,
+    _In_z_ const char* Filename,
+    _Out_ int64_t* Value,
+    _Out_opt_ int64_t* SecondValue
+    )
+{
+    BOOLEAN Result = FALSE;
+    char* FullFilename = NULL;
+    char First[32];
+    long long Second = 0;
+
+    if (asprintf(&FullFilename, "%s%s", Path, Filename) < 0) {
+        return FALSE;
+    }
+
+    FILE* File = fopen(FullFilename, "r");
+    free(FullFilename);
+    if (File == NULL) {
+        return FALSE;
+    }
+
+    int Count = fscanf(File, "%31s %lld", First, &Second);
+    if (Count < (SecondValue == NULL ? 1 : 2)) {
+        goto Done;
+    }
+
+    if (strcmp(First, "max") == 0) {
+        *Value = -1;
+    } else {
+        char* EndPtr = NULL;
+        errno = 0;
+        *Value = strtoll(First, &EndPtr, 10);
+        if (errno != 0 || *EndPtr != '\0') {
+            goto Done;
+        }
+    }
+    if (SecondValue != NULL) {
+        *SecondValue = Second;
+    }
+    Result = TRUE;
+
+Done:
+
+    fclose(File);
+    return Result;
+}
+
+//
+// Returns the number of whole processors the cgroup CPU quota (CFS bandwidth)
+// allows, rounded up, or zero if there is no quota. Read fresh on each call so
+// that a quota updated at runtime (e.g. a resized Kubernetes pod) is seen the
+// next time the library initializes.
+//
+uint32_t
+CGroupGetCpuLimit()
+{
+    int64_t Quota = -1, Period = 0;
+    BOOLEAN Found = FALSE;
+
+    CGroupVersion = FindCGroupVersion();
+    char* CpuPath = FindCGroupPath(CGroupVersion == 1 ? &IsCGroup1CpuSubsystem : NULL);
+    if (CpuPath == NULL) {
+        return 0;
+    }
+
+    if (CGroupVersion == 1) {
+        Found =
+            ReadCpuValueFromFile(CpuPath, CGROUP1_CFS_QUOTA_FILENAME, &Quota, NULL) &&
+            ReadCpuValueFromFile(CpuPath, CGROUP1_CFS_PERIOD_FILENAME, &Period, NULL);
+    } else if (CGroupVersion == 2) {
+        //
+        // Format is "$MAX $PERIOD", where $MAX may be "max".
+        //
+        Found = ReadCpuValueFromFile(CpuPath, CGROUP2_CPU_MAX_FILENAME, &Quota, &Period);
+    }
+
+    free(CpuPath);
+
+    if (!Found || Quota <= 0 || Period <= 0) {
+        return 0;
+    }
+
+    int64_t Limit = (Quota + Period - 1) / Period;
+    return Limit > UINT16_MAX ? UINT16_MAX : (uint32_t)Limit;
+}
@@ -402,7 +402,6 @@ QuicPacketKeyCreateInitial(
 {
     QUIC_STATUS Status;
     CXPLAT_SECRET ClientInitial, ServerInitial;
-    QUIC_PACKET_KEY* ReadKey = NULL, *WriteKey = NULL;
 
     Status =
         CxPlatTlsDeriveInitialSecrets(
@@ -415,12 +414,45 @@ QuicPacketKeyCreateInitial(
         goto Error;
     }
 
+    Status =
+        QuicPacketKeyCreateInitialFromSecrets(
+            IsServer,
+            HkdfLabels,
+            &ClientInitial,
+            &ServerInitial,
+            NewReadKey,
+            NewWriteKey);
+
+Error:
+
+    CxPlatSecureZeroMemory(ClientInitial.Secret, sizeof(ClientInitial.Secret));
+    CxPlatSecureZeroMemory(ServerInitial.Secret, sizeof(ServerInitial.Secret));
+
+    return Status;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_When_(NewReadKey != NULL, _At_(*NewReadKey, __drv_allocatesMem(Mem)))
+_When_(NewWriteKey != NULL, _At_(*NewWriteKey, __drv_allocatesMem(Mem)))
+QUIC_STATUS
+QuicPacketKeyCreateInitialFromSecrets(
+    _In_ BOOLEAN IsServer,
+    _In_ const QUIC_HKDF_LABELS* HkdfLabels,
+    _In_ const CXPLAT_SECRET* ClientInitial,
+    _In_ const CXPLAT_SECRET* ServerInitial,
+    _Out_opt_ QUIC_PACKET_KEY** NewReadKey,
+    _Out_opt_ QUIC_PACKET_KEY** NewWriteKey
+    )
+{
+    QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
+    QUIC_PACKET_KEY* ReadKey = NULL, *WriteKey = NULL;
+
     if (NewWriteKey != NULL) {
         Status =
             QuicPacketKeyDerive(
                 QUIC_PACKET_KEY_INITIAL,
                 HkdfLabels,
-                IsServer ? &ServerInitial : &ClientInitial,
+                IsServer ? ServerInitial : ClientInitial,
                 IsServer ? "srv secret" : "cli secret",
                 TRUE,
                 &WriteKey);
@@ -434,7 +466,7 @@ QuicPacketKeyCreateInitial(
             QuicPacketKeyDerive(
                 QUIC_PACKET_KEY_INITIAL,
                 HkdfLabels,
-                IsServer ? &ClientInitial : &ServerInitial,
+                IsServer ? ClientInitial : ServerInitial,
                 IsServer ? "cli secret" : "srv secret",
                 TRUE,
                 &ReadKey);
@@ -458,9 +490,6 @@ Error:
     QuicPacketKeyFree(ReadKey);
     QuicPacketKeyFree(WriteKey);
 
-    CxPlatSecureZeroMemory(ClientInitial.Secret, sizeof(ClientInitial.Secret));
-    CxPlatSecureZeroMemory(ServerInitial.Secret, sizeof(ServerInitial.Secret));
-
     return Status;
 }
 
@@ -539,3 +568,63 @@ Error:
 
     return Status;
 }
+
+//
+// None of the current crypto providers expose a multi-buffer AEAD primitive,
+// so the batch is processed serially on the same key context. This still
+// keeps the key schedule and cipher context hot across the packets of a send
+// or receive batch, and gives providers a single place to plug in a pipelined
+// implementation.
+//
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+CxPlatEncryptBatch(
+    _In_ CXPLAT_KEY* Key,
+    _In_ uint8_t BatchSize,
+    _Inout_updates_(BatchSize)
+        CXPLAT_CRYPT_BATCH_ENTRY* Entries
+    )
+{
+    QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
+    for (uint8_t i = 0; i < BatchSize; ++i) {
+        Status =
+            CxPlatEncrypt(
+                Key,
+                Entries[i].Iv,
+                Entries[i].AuthDataLength,
+                Entries[i].AuthData,
+                Entries[i].BufferLength,
+                Entries[i].Buffer);
+        if (QUIC_FAILED(Status)) {
+            break;
+        }
+    }
+    return Status;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+CxPlatDecryptBatch(
+    _In_ CXPLAT_KEY* Key,
+    _In_ uint8_t BatchSize,
+    _Inout_updates_(BatchSize)
+        CXPLAT_CRYPT_BATCH_ENTRY* Entries
+    )
+{
+    QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
+    for (uint8_t i = 0; i < BatchSize; ++i) {
+        Status =
+            CxPlatDecrypt(
+                Key,
+                Entries[i].Iv,
+                Entries[i].AuthDataLength,
+                Entries[i].AuthData,
+                Entries[i].BufferLength,
+                Entries[i].Buffer);
+        if (QUIC_FAILED(Status)) {
+            break;
+        }
+    }
+    return Status;
+}
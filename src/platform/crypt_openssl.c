@@ -57,6 +57,17 @@ EVP_MAC_CTX *CXPLAT_HMAC_SHA256_CTX_HANDLE;
 EVP_MAC_CTX *CXPLAT_HMAC_SHA384_CTX_HANDLE;
 EVP_MAC_CTX *CXPLAT_HMAC_SHA512_CTX_HANDLE;
 
+//
+// Cipher contexts initialized with everything but the key. New packet and
+// header protection keys copy one of these instead of setting up a context
+// from scratch.
+//
+EVP_CIPHER_CTX *CXPLAT_AES_128_GCM_CTX_HANDLE;
+EVP_CIPHER_CTX *CXPLAT_AES_256_GCM_CTX_HANDLE;
+EVP_CIPHER_CTX *CXPLAT_CHACHA20_POLY1305_CTX_HANDLE;
+EVP_CIPHER_CTX *CXPLAT_AES_128_ECB_CTX_HANDLE;
+EVP_CIPHER_CTX *CXPLAT_AES_256_ECB_CTX_HANDLE;
+
 _Success_(return != 0)
 int
 CxPlatLoadCipher(
@@ -128,13 +139,188 @@ CxPlatLoadHMACCTX(
     *ctx = c;
     return 1;
 }
+
+_Success_(return != 0)
+int
+CxPlatLoadCipherCTX(
+    _In_ EVP_CIPHER *cipher,
+    _In_ BOOLEAN IsAead,
+    _Outptr_ EVP_CIPHER_CTX **ctx
+    )
+{
+    EVP_CIPHER_CTX *c;
+    size_t IvLength = CXPLAT_IV_LENGTH;
+    OSSL_PARAM AlgParam[2];
+
+    c = EVP_CIPHER_CTX_new();
+    if (c == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "EVP_CIPHER_CTX_new",
+            0);
+        return 0;
+    }
+    AlgParam[0] = OSSL_PARAM_construct_size_t("ivlen", &IvLength);
+    AlgParam[1] = OSSL_PARAM_construct_end();
+    if (EVP_CipherInit_ex2(c, cipher, NULL, NULL, 1, IsAead ? AlgParam : NULL) != 1) {
+        QuicTraceEvent(
+            LibraryError,
+            "[ lib] ERROR, %s.",
+            "EVP_CipherInit_ex2 (template) failed");
+        EVP_CIPHER_CTX_free(c);
+        return 0;
+    }
+    *ctx = c;
+    return 1;
+}
+
+_Success_(return != 0)
+int
+CxPlatCopyCipherCTX(
+    _In_ const EVP_CIPHER_CTX *Template,
+    _In_ const uint8_t* const RawKey,
+    _Outptr_ EVP_CIPHER_CTX **ctx
+    )
+{
+    EVP_CIPHER_CTX *c = EVP_CIPHER_CTX_new();
+    if (c == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "EVP_CIPHER_CTX_new",
+            0);
+        return 0;
+    }
+    if (EVP_CIPHER_CTX_copy(c, Template) != 1 ||
+        EVP_CipherInit_ex2(c, NULL, RawKey, NULL, 1, NULL) != 1) {
+        QuicTraceEvent(
+            LibraryError,
+            "[ lib] ERROR, %s.",
+            "EVP_CipherInit_ex2 (copy) failed");
+        EVP_CIPHER_CTX_free(c);
+        return 0;
+    }
+    *ctx = c;
+    return 1;
+}
 #endif
 
 typedef struct CXPLAT_HP_KEY {
-    EVP_CIPHER_CTX* CipherCtx;
+    EVP_CIPHER_CTX* CipherCtx; // Unused for ChaCha20.
     CXPLAT_AEAD_TYPE Aead;
+    uint32_t ChaChaKey[8];
 } CXPLAT_HP_KEY;
 
+//
+// ChaCha20 header protection only needs the first 5 bytes of a single
+// keystream block per packet, with a different counter and nonce (the sample)
+// each time. Going through EVP means a full cipher re-init per packet, so the
+// block function is computed directly instead. Up to CXPLAT_CHACHA_HP_LANES
+// samples are processed together, with each state word holding all the lanes.
+// With GCC and Clang that is a vector type, so the rounds compile to NEON on
+// ARM64 and SSE on x64.
+//
+#define CXPLAT_CHACHA_HP_LANES 4
+
+#if defined(__GNUC__) || defined(__clang__)
+typedef uint32_t CXPLAT_CHACHA_WORD
+    __attribute__((vector_size(sizeof(uint32_t) * CXPLAT_CHACHA_HP_LANES)));
+#define CXPLAT_CHACHA_STEP(x, a, b, d, n) \
+    x[a] += x[b]; x[d] ^= x[a]; x[d] = (x[d] << n) | (x[d] >> (32 - n));
+#else
+typedef uint32_t CXPLAT_CHACHA_WORD[CXPLAT_CHACHA_HP_LANES];
+#define CXPLAT_CHACHA_STEP(x, a, b, d, n) \
+    for (uint32_t l = 0; l < CXPLAT_CHACHA_HP_LANES; ++l) { \
+        x[a][l] += x[b][l]; x[d][l] ^= x[a][l]; \
+        x[d][l] = (x[d][l] << n) | (x[d][l] >> (32 - n)); \
+    }
+#endif
+
+#define CXPLAT_CHACHA_QUARTER_ROUND(x, a, b, c, d) \
+    CXPLAT_CHACHA_STEP(x, a, b, d, 16) \
+    CXPLAT_CHACHA_STEP(x, c, d, b, 12) \
+    CXPLAT_CHACHA_STEP(x, a, b, d, 8) \
+    CXPLAT_CHACHA_STEP(x, c, d, b, 7)
+
+static
+uint32_t
+CxPlatChaChaLoad32(
+    _In_reads_bytes_(4) const uint8_t* Buffer
+    )
+{
+    return
+        (uint32_t)Buffer[0] |
+        ((uint32_t)Buffer[1] << 8) |
+        ((uint32_t)Buffer[2] << 16) |
+        ((uint32_t)Buffer[3] << 24);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+static
+void
+CxPlatChaChaHpComputeMask(
+    _In_reads_(8) const uint32_t* Key,
+    _In_range_(1, CXPLAT_CHACHA_HP_LANES) uint8_t Count,
+    _In_reads_bytes_(CXPLAT_HP_SAMPLE_LENGTH * Count)
+        const uint8_t* Sample,
+    _Out_writes_bytes_(CXPLAT_HP_SAMPLE_LENGTH * Count)
+        uint8_t* Mask
+    )
+{
+    CXPLAT_CHACHA_WORD State[16];
+    CXPLAT_CHACHA_WORD x[16];
+
+    for (uint32_t l = 0; l < CXPLAT_CHACHA_HP_LANES; ++l) {
+        //
+        // Unused lanes just repeat the last sample.
+        //
+        const uint8_t* LaneSample =
+            Sample + CXPLAT_HP_SAMPLE_LENGTH * (l < Count ? l : Count - 1u);
+        State[0][l] = 0x61707865;
+        State[1][l] = 0x3320646e;
+        State[2][l] = 0x79622d32;
+        State[3][l] = 0x6b206574;
+        for (uint32_t i = 0; i < 8; ++i) {
+            State[4 + i][l] = Key[i];
+        }
+        //
+        // The first 4 bytes of the sample are the block counter and the
+        // remaining 12 the nonce.
+        //
+        for (uint32_t i = 0; i < 4; ++i) {
+            State[12 + i][l] = CxPlatChaChaLoad32(LaneSample + 4 * i);
+        }
+    }
+
+    CxPlatCopyMemory(x, State, sizeof(x));
+    for (uint32_t i = 0; i < 10; ++i) {
+        CXPLAT_CHACHA_QUARTER_ROUND(x, 0, 4, 8, 12)
+        CXPLAT_CHACHA_QUARTER_ROUND(x, 1, 5, 9, 13)
+        CXPLAT_CHACHA_QUARTER_ROUND(x, 2, 6, 10, 14)
+        CXPLAT_CHACHA_QUARTER_ROUND(x, 3, 7, 11, 15)
+        CXPLAT_CHACHA_QUARTER_ROUND(x, 0, 5, 10, 15)
+        CXPLAT_CHACHA_QUARTER_ROUND(x, 1, 6, 11, 12)
+        CXPLAT_CHACHA_QUARTER_ROUND(x, 2, 7, 8, 13)
+        CXPLAT_CHACHA_QUARTER_ROUND(x, 3, 4, 9, 14)
+    }
+
+    //
+    // Only the first 5 bytes of the keystream (ChaCha20 applied to 5 zero
+    // bytes) make up the mask.
+    //
+    for (uint32_t l = 0; l < Count; ++l) {
+        const uint32_t Word0 = x[0][l] + State[0][l];
+        const uint32_t Word1 = x[1][l] + State[1][l];
+        uint8_t* LaneMask = Mask + CXPLAT_HP_SAMPLE_LENGTH * l;
+        LaneMask[0] = (uint8_t)Word0;
+        LaneMask[1] = (uint8_t)(Word0 >> 8);
+        LaneMask[2] = (uint8_t)(Word0 >> 16);
+        LaneMask[3] = (uint8_t)(Word0 >> 24);
+        LaneMask[4] = (uint8_t)Word1;
+    }
+}
+
 #if defined CXPLAT_SYSTEM_CRYPTO && !defined IS_OPENSSL_3 && !defined _WIN32
 // This is to fulfill link dependency in ssl_init.
 // If system OpenSSL has chacha support, we will redirect it to loaded handle.
@@ -180,6 +366,20 @@ CxPlatCryptInitialize(
     CxPlatLoadCipher("ChaCha20", &CXPLAT_CHACHA20_ALG_HANDLE);
     CxPlatLoadCipher("ChaCha20-Poly1305", &CXPLAT_CHACHA20_POLY1305_ALG_HANDLE);
 
+    //
+    // Preload the key context templates.
+    //
+    if (!CxPlatLoadCipherCTX(CXPLAT_AES_128_GCM_ALG_HANDLE, TRUE, &CXPLAT_AES_128_GCM_CTX_HANDLE) ||
+        !CxPlatLoadCipherCTX(CXPLAT_AES_256_GCM_ALG_HANDLE, TRUE, &CXPLAT_AES_256_GCM_CTX_HANDLE) ||
+        !CxPlatLoadCipherCTX(CXPLAT_AES_128_ECB_ALG_HANDLE, FALSE, &CXPLAT_AES_128_ECB_CTX_HANDLE) ||
+        !CxPlatLoadCipherCTX(CXPLAT_AES_256_ECB_ALG_HANDLE, FALSE, &CXPLAT_AES_256_ECB_CTX_HANDLE)) {
+        goto Error;
+    }
+    if (CXPLAT_CHACHA20_POLY1305_ALG_HANDLE != NULL &&
+        !CxPlatLoadCipherCTX(CXPLAT_CHACHA20_POLY1305_ALG_HANDLE, TRUE, &CXPLAT_CHACHA20_POLY1305_CTX_HANDLE)) {
+        goto Error;
+    }
+
     //
     // Preload HMAC
     //
@@ -263,8 +463,21 @@ CxPlatCryptUninitialize(
     )
 {
 #ifdef IS_OPENSSL_3
+    EVP_CIPHER_CTX_free(CXPLAT_AES_128_GCM_CTX_HANDLE);
+    CXPLAT_AES_128_GCM_CTX_HANDLE = NULL;
+    EVP_CIPHER_CTX_free(CXPLAT_AES_256_GCM_CTX_HANDLE);
+    CXPLAT_AES_256_GCM_CTX_HANDLE = NULL;
+    EVP_CIPHER_CTX_free(CXPLAT_CHACHA20_POLY1305_CTX_HANDLE);
+    CXPLAT_CHACHA20_POLY1305_CTX_HANDLE = NULL;
+    EVP_CIPHER_CTX_free(CXPLAT_AES_128_ECB_CTX_HANDLE);
+    CXPLAT_AES_128_ECB_CTX_HANDLE = NULL;
+    EVP_CIPHER_CTX_free(CXPLAT_AES_256_ECB_CTX_HANDLE);
+    CXPLAT_AES_256_ECB_CTX_HANDLE = NULL;
+
     EVP_CIPHER_free(CXPLAT_AES_128_GCM_ALG_HANDLE);
     CXPLAT_AES_128_GCM_ALG_HANDLE = NULL;
+    EVP_CIPHER_free(CXPLAT_AES_256_GCM_ALG_HANDLE);
+    CXPLAT_AES_256_GCM_ALG_HANDLE = NULL;
     EVP_CIPHER_free(CXPLAT_AES_256_CBC_ALG_HANDLE);
     CXPLAT_AES_256_CBC_ALG_HANDLE = NULL;
     EVP_CIPHER_free(CXPLAT_AES_128_ECB_ALG_HANDLE);
@@ -301,11 +514,35 @@ CxPlatKeyCreate(
     )
 {
     QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
-    const EVP_CIPHER *Aead;
 #ifdef IS_OPENSSL_3
-    OSSL_PARAM AlgParam[2];
-    size_t TagLength;
-#endif
+    const EVP_CIPHER_CTX *Template;
+    EVP_CIPHER_CTX* CipherCtx = NULL;
+
+    switch (AeadType) {
+    case CXPLAT_AEAD_AES_128_GCM:
+        Template = CXPLAT_AES_128_GCM_CTX_HANDLE;
+        break;
+    case CXPLAT_AEAD_AES_256_GCM:
+        Template = CXPLAT_AES_256_GCM_CTX_HANDLE;
+        break;
+    case CXPLAT_AEAD_CHACHA20_POLY1305:
+        if (CXPLAT_CHACHA20_POLY1305_CTX_HANDLE == NULL) {
+            Status = QUIC_STATUS_NOT_SUPPORTED;
+            goto Exit;
+        }
+        Template = CXPLAT_CHACHA20_POLY1305_CTX_HANDLE;
+        break;
+    default:
+        Status = QUIC_STATUS_NOT_SUPPORTED;
+        goto Exit;
+    }
+
+    if (!CxPlatCopyCipherCTX(Template, RawKey, &CipherCtx)) {
+        Status = QUIC_STATUS_TLS_ERROR;
+        goto Exit;
+    }
+#else
+    const EVP_CIPHER *Aead;
 
     EVP_CIPHER_CTX* CipherCtx = EVP_CIPHER_CTX_new();
     if (CipherCtx == NULL) {
@@ -337,20 +574,6 @@ CxPlatKeyCreate(
         goto Exit;
     }
 
-#ifdef IS_OPENSSL_3
-    TagLength = CXPLAT_IV_LENGTH;
-    AlgParam[0] = OSSL_PARAM_construct_size_t("ivlen", &TagLength);
-    AlgParam[1] = OSSL_PARAM_construct_end();
-
-    if (EVP_CipherInit_ex2(CipherCtx, Aead, RawKey, NULL, 1, AlgParam) != 1) {
-        QuicTraceEvent(
-            LibraryError,
-            "[ lib] ERROR, %s.",
-            "EVP_CipherInit_ex2 failed");
-        Status = QUIC_STATUS_TLS_ERROR;
-        goto Exit;
-    }
-#else
     if (EVP_CipherInit_ex(CipherCtx, Aead, NULL, RawKey, NULL, 1) != 1) {
         QuicTraceEvent(
             LibraryError,
@@ -572,7 +795,6 @@ CxPlatHpKeyCreate(
     )
 {
     QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
-    const EVP_CIPHER *Aead;
     CXPLAT_HP_KEY* Key = CXPLAT_ALLOC_NONPAGED(sizeof(CXPLAT_HP_KEY), QUIC_POOL_TLS_HP_KEY);
     if (Key == NULL) {
         QuicTraceEvent(
@@ -584,6 +806,41 @@ CxPlatHpKeyCreate(
     }
 
     Key->Aead = AeadType;
+    Key->CipherCtx = NULL;
+
+    if (AeadType == CXPLAT_AEAD_CHACHA20_POLY1305) {
+        if (CXPLAT_CHACHA20_ALG_HANDLE == NULL) {
+            Status = QUIC_STATUS_NOT_SUPPORTED;
+            goto Exit;
+        }
+        for (uint32_t i = 0; i < ARRAYSIZE(Key->ChaChaKey); ++i) {
+            Key->ChaChaKey[i] = CxPlatChaChaLoad32(RawKey + 4 * i);
+        }
+        *NewKey = Key;
+        return QUIC_STATUS_SUCCESS;
+    }
+
+#ifdef IS_OPENSSL_3
+    const EVP_CIPHER_CTX *Template;
+
+    switch (AeadType) {
+    case CXPLAT_AEAD_AES_128_GCM:
+        Template = CXPLAT_AES_128_ECB_CTX_HANDLE;
+        break;
+    case CXPLAT_AEAD_AES_256_GCM:
+        Template = CXPLAT_AES_256_ECB_CTX_HANDLE;
+        break;
+    default:
+        Status = QUIC_STATUS_NOT_SUPPORTED;
+        goto Exit;
+    }
+
+    if (!CxPlatCopyCipherCTX(Template, RawKey, &Key->CipherCtx)) {
+        Status = QUIC_STATUS_TLS_ERROR;
+        goto Exit;
+    }
+#else
+    const EVP_CIPHER *Aead;
 
     Key->CipherCtx = EVP_CIPHER_CTX_new();
     if (Key->CipherCtx == NULL) {
@@ -603,13 +860,6 @@ CxPlatHpKeyCreate(
     case CXPLAT_AEAD_AES_256_GCM:
         Aead = CXPLAT_AES_256_ECB_ALG_HANDLE;
         break;
-    case CXPLAT_AEAD_CHACHA20_POLY1305:
-        if (CXPLAT_CHACHA20_ALG_HANDLE == NULL) {
-            Status = QUIC_STATUS_NOT_SUPPORTED;
-            goto Exit;
-        }
-        Aead = CXPLAT_CHACHA20_ALG_HANDLE;
-        break;
     default:
         Status = QUIC_STATUS_NOT_SUPPORTED;
         goto Exit;
@@ -623,6 +873,7 @@ CxPlatHpKeyCreate(
         Status = QUIC_STATUS_TLS_ERROR;
         goto Exit;
     }
+#endif
 
     *NewKey = Key;
     Key = NULL;
@@ -642,6 +893,7 @@ CxPlatHpKeyFree(
 {
     if (Key != NULL) {
         EVP_CIPHER_CTX_free(Key->CipherCtx);
+        CxPlatSecureZeroMemory(Key->ChaChaKey, sizeof(Key->ChaChaKey));
         CXPLAT_FREE(Key, QUIC_POOL_TLS_HP_KEY);
     }
 }
@@ -659,22 +911,14 @@ CxPlatHpComputeMask(
 {
     int OutLen = 0;
     if (Key->Aead == CXPLAT_AEAD_CHACHA20_POLY1305) {
-        static const uint8_t Zero[] = { 0, 0, 0, 0, 0 };
-        for (uint32_t i = 0, Offset = 0; i < BatchSize; ++i, Offset += CXPLAT_HP_SAMPLE_LENGTH) {
-            if (EVP_EncryptInit_ex(Key->CipherCtx, NULL, NULL, NULL, Cipher + Offset) != 1) {
-                QuicTraceEvent(
-                    LibraryError,
-                    "[ lib] ERROR, %s.",
-                    "EVP_EncryptInit_ex (hp) failed");
-                return QUIC_STATUS_TLS_ERROR;
-            }
-            if (EVP_EncryptUpdate(Key->CipherCtx, Mask + Offset, &OutLen, Zero, sizeof(Zero)) != 1) {
-                QuicTraceEvent(
-                    LibraryError,
-                    "[ lib] ERROR, %s.",
-                    "EVP_EncryptUpdate (hp) failed");
-                return QUIC_STATUS_TLS_ERROR;
-            }
+        for (uint32_t i = 0; i < BatchSize; i += CXPLAT_CHACHA_HP_LANES) {
+            const uint8_t Count =
+                (uint8_t)CXPLAT_MIN(CXPLAT_CHACHA_HP_LANES, BatchSize - i);
+            CxPlatChaChaHpComputeMask(
+                Key->ChaChaKey,
+                Count,
+                Cipher + CXPLAT_HP_SAMPLE_LENGTH * i,
+                Mask + CXPLAT_HP_SAMPLE_LENGTH * i);
         }
     } else {
         if (EVP_EncryptUpdate(Key->CipherCtx, Mask, &OutLen, Cipher, CXPLAT_HP_SAMPLE_LENGTH * BatchSize) != 1) {
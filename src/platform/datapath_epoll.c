@@ -18,6 +18,67 @@ Environment:
 #include <linux/filter.h>
 #include <linux/in6.h>
 #include <netinet/udp.h>
+#include <sys/mman.h>
+#if defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#endif
+#endif
+
+//
+// The io_uring IO path requires multishot receive and provided buffer ring
+// support from the kernel headers. It drives the ring through the raw system
+// calls, so there is no dependency on liburing.
+//
+#if defined(IORING_RECV_MULTISHOT) && !CXPLAT_USE_IO_URING
+#define CXPLAT_DATAPATH_IO_URING 1
+#include <sys/syscall.h>
+#endif
+
+//
+// Zerocopy sends are only used for large segmented (GSO) sends, where the
+// cost of pinning the pages and harvesting the completions from the socket
+// error queue is less than the cost of copying the payload.
+//
+#include <linux/errqueue.h>
+#if defined(UDP_SEGMENT) && defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY) && \
+    defined(SO_EE_ORIGIN_ZEROCOPY)
+#define CXPLAT_DATAPATH_ZEROCOPY 1
+#endif
+
+//
+// Kernel pacing offload stamps each send with its earliest departure time,
+// which the fq (or etf) qdisc then holds the packets until.
+//
+#include <linux/net_tstamp.h>
+#if defined(SO_TXTIME) && defined(SCM_TXTIME) && !defined(QUIC_SIMULATION)
+#define CXPLAT_DATAPATH_TXTIME 1
+
+//
+// The clock the sockets' departure times are in. The fq qdisc requires
+// CLOCK_MONOTONIC.
+//
+#define CXPLAT_DATAPATH_TXTIME_CLOCK CLOCK_MONOTONIC
+#endif
+
+//
+// Kernel TLS for TCP sockets, used by the TCP comparison mode of the perf tool.
+//
+#if defined(__has_include)
+#if __has_include(<linux/tls.h>)
+#include <linux/tls.h>
+#include <netinet/tcp.h>
+#ifndef SOL_TLS
+#define SOL_TLS 282
+#endif
+#ifndef TCP_ULP
+#define TCP_ULP 31
+#endif
+#if defined(TLS_1_3_VERSION) && defined(TLS_CIPHER_CHACHA20_POLY1305)
+#define CXPLAT_DATAPATH_KTLS 1
+#endif
+#endif
+#endif
 
 #ifdef QUIC_CLOG
 #include "datapath_epoll.c.clog.h"
@@ -37,6 +98,18 @@ CXPLAT_STATIC_ASSERT((SIZEOF_STRUCT_MEMBER(QUIC_BUFFER, Buffer) == sizeof(void*)
 //
 #define CXPLAT_LARGE_IO_BUFFER_SIZE         0xFFE3
 
+//
+// The maximum number of segments the kernel accepts in a single GSO send
+// (UDP_MAX_SEGMENTS).
+//
+#define CXPLAT_MAX_GSO_SEGMENTS             64
+
+//
+// The minimum send size for which MSG_ZEROCOPY is used. Below this, the
+// page pinning and completion notification overhead outweighs the copy.
+//
+#define CXPLAT_ZEROCOPY_MIN_SEND_SIZE       0x4000
+
 //
 // The maximum batch size of IOs in that can use a single coalesced IO buffer.
 // This is calculated base on the number of the smallest possible single
@@ -45,6 +118,18 @@ CXPLAT_STATIC_ASSERT((SIZEOF_STRUCT_MEMBER(QUIC_BUFFER, Buffer) == sizeof(void*)
 const uint16_t CXPLAT_MAX_IO_BATCH_SIZE =
     (CXPLAT_LARGE_IO_BUFFER_SIZE / (1280 - CXPLAT_MIN_IPV6_HEADER_SIZE - CXPLAT_UDP_HEADER_SIZE));
 
+//
+// The maximum number of coalesced (GRO) receive buffers read per call.
+//
+#define CXPLAT_MAX_COALESCED_RECV_BATCH_SIZE 8
+
+//
+// The size of the huge page slab backing each of a partition's block pools
+// with QUIC_EXECUTION_CONFIG_FLAG_HUGE_PAGES. It is a multiple of the 2 MB huge
+// page size, so it is also one page if the system default is 1 GB pages.
+//
+#define CXPLAT_HUGE_PAGE_POOL_SIZE          (8 * 1024 * 1024)
+
 //
 // Contains all the info for a single RX IO operation. Multiple RX packets may
 // come from a single IO operation.
@@ -53,7 +138,7 @@ typedef struct DATAPATH_RX_IO_BLOCK {
     //
     // The pool owning this recv block.
     //
-    CXPLAT_POOL* OwningPool;
+    CXPLAT_BLOCK_POOL* OwningPool;
 
     //
     // Represents the network route.
@@ -107,6 +192,28 @@ typedef struct CXPLAT_SEND_DATA {
     //
     CXPLAT_LIST_ENTRY TxEntry;
 
+    //
+    // Entry in the socket's list of sends still referenced by the kernel.
+    //
+    CXPLAT_LIST_ENTRY ZeroCopyEntry;
+
+    //
+    // The references held (by the sender and the kernel) while a zerocopy
+    // send is outstanding. Zero for sends that were copied.
+    //
+    long ZeroCopyRefCount;
+
+    //
+    // The kernel's identifier for the zerocopy send.
+    //
+    uint32_t ZeroCopyId;
+
+    //
+    // The earliest departure time (CxPlatTimeUs64) of the send, or zero to
+    // send immediately.
+    //
+    uint64_t TxTime;
+
     //
     // The local address to bind to.
     //
@@ -137,6 +244,11 @@ typedef struct CXPLAT_SEND_DATA {
     //
     uint16_t BufferCount;
 
+    //
+    // The maximum number of packet buffers the send may hold.
+    //
+    uint16_t MaxSegments;
+
     //
     // The number of iovecs that have been sent out. Only relavent if not doing
     // GSO.
@@ -173,6 +285,9 @@ typedef struct CXPLAT_SEND_DATA {
         CMSG_SPACE(sizeof(struct in6_pktinfo))  // IP_PKTINFO || IPV6_PKTINFO
     #ifdef UDP_SEGMENT
         + CMSG_SPACE(sizeof(uint16_t))          // UDP_SEGMENT
+    #endif
+    #ifdef CXPLAT_DATAPATH_TXTIME
+        + CMSG_SPACE(sizeof(uint64_t))          // SCM_TXTIME
     #endif
         ];
     CXPLAT_STATIC_ASSERT(
@@ -203,6 +318,121 @@ typedef struct CXPLAT_RECV_MSG_CONTROL_BUFFER {
               2 * CMSG_SPACE(sizeof(int))];
 } CXPLAT_RECV_MSG_CONTROL_BUFFER;
 
+#ifdef CXPLAT_DATAPATH_IO_URING
+
+//
+// The number of submission and completion queue entries for each io_uring.
+//
+#define CXPLAT_URING_SQ_ENTRIES             256
+#define CXPLAT_URING_CQ_ENTRIES             4096
+
+//
+// The number of receive buffers in each partition's provided buffer ring.
+// Must be a power of two. Fewer buffers are used when the buffers are large
+// enough to hold coalesced (GRO) receives.
+//
+#define CXPLAT_URING_RECV_BUFFER_COUNT      256
+#define CXPLAT_URING_RECV_BUFFER_COUNT_GRO  32
+
+//
+// The buffer group ID used for the provided receive buffer ring.
+//
+#define CXPLAT_URING_RECV_BUFFER_GROUP      0
+
+//
+// Multishot receives place a io_uring_recvmsg_out header, the source address
+// and the ancillary control data in front of the datagram payload in each
+// provided buffer.
+//
+#define CXPLAT_URING_RECV_NAME_LENGTH       CMSG_ALIGN(sizeof(QUIC_ADDR))
+#define CXPLAT_URING_RECV_PREFIX_LENGTH \
+    (sizeof(struct io_uring_recvmsg_out) + \
+     CXPLAT_URING_RECV_NAME_LENGTH + \
+     sizeof(CXPLAT_RECV_MSG_CONTROL_BUFFER))
+
+//
+// The low bits of each SQE's user data indicate the type of operation.
+//
+#define CXPLAT_URING_OP_RECV                0
+#define CXPLAT_URING_OP_SEND                1
+#define CXPLAT_URING_OP_CANCEL              2
+#define CXPLAT_URING_OP_MASK                3
+
+//
+// A minimal io_uring instance shared by all UDP sockets on a partition. The
+// ring's file descriptor is registered with the partition's epoll event queue
+// so that completions are processed by the same worker thread that processes
+// everything else for the partition.
+//
+typedef struct CXPLAT_URING {
+
+    //
+    // Registered with the partition's event queue for completion readiness.
+    //
+    DATAPATH_SQE Sqe;
+
+    //
+    // The io_uring file descriptor.
+    //
+    int Fd;
+
+    //
+    // Serializes the production of submission queue entries, as sockets may
+    // be created (and start receiving) on any thread.
+    //
+    CXPLAT_LOCK SqLock;
+
+    //
+    // Submission queue state.
+    //
+    uint32_t* SqHead;
+    uint32_t* SqTail;
+    uint32_t* SqFlags;
+    uint32_t SqMask;
+    uint32_t SqEntries;
+    uint32_t SqLocalTail;
+    struct io_uring_sqe* Sqes;
+
+    //
+    // Completion queue state.
+    //
+    uint32_t* CqHead;
+    uint32_t* CqTail;
+    uint32_t CqMask;
+    struct io_uring_cqe* Cqes;
+
+    //
+    // The memory mappings of the rings.
+    //
+    void* SqRing;
+    size_t SqRingSize;
+    void* CqRing;
+    size_t CqRingSize;
+    size_t SqesSize;
+
+    //
+    // The provided buffer ring used by multishot receives. Each buffer lives
+    // in a DATAPATH_RX_IO_BLOCK from the partition's receive pool. When a
+    // receive completes, the block is indicated up and a new one takes its
+    // place in the ring.
+    //
+    struct io_uring_buf_ring* BufRing;
+    size_t BufRingSize;
+    DATAPATH_RX_IO_BLOCK** BufBlocks;
+    uint32_t BufOffset;
+    uint32_t BufLength;
+    uint16_t BufCount;
+    uint16_t BufTail;
+
+    //
+    // The message header describing the layout of each multishot receive.
+    //
+    struct msghdr RecvMsgHdr;
+
+} CXPLAT_URING;
+
+#endif // CXPLAT_DATAPATH_IO_URING
+
 #ifdef DEBUG
 #define CXPLAT_DBG_ASSERT_CMSG(CMsg, type) \
     if (CMsg->cmsg_len < CMSG_LEN(sizeof(type))) { \
@@ -215,6 +445,51 @@ typedef struct CXPLAT_RECV_MSG_CONTROL_BUFFER {
 #define CXPLAT_DBG_ASSERT_CMSG(CMsg, type)
 #endif
 
+#ifdef CXPLAT_DATAPATH_TXTIME
+//
+// The sockets require the SO_TXTIME option to be set to accept SCM_TXTIME, so
+// make sure the kernel supports it before advertising pacing offload.
+//
+BOOLEAN
+CxPlatDataPathIsTxTimeSupported(
+    void
+    )
+{
+    int Socket = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, IPPROTO_UDP);
+    if (Socket == INVALID_SOCKET) {
+        return FALSE;
+    }
+    struct sock_txtime TxTime = { CXPLAT_DATAPATH_TXTIME_CLOCK, 0 };
+    BOOLEAN Supported =
+        setsockopt(Socket, SOL_SOCKET, SO_TXTIME, &TxTime, sizeof(TxTime)) != SOCKET_ERROR;
+    close(Socket);
+    return Supported;
+}
+
+//
+// Converts a departure time from CxPlatTimeUs64 to nanoseconds on the
+// sockets' SO_TXTIME clock. CxPlatTimeUs64 follows CLOCK_MONOTONIC, but may be
+// computed from the TSC, so convert relative to the current time of both
+// clocks instead of assuming they share the same base.
+//
+static
+uint64_t
+CxPlatDataPathTxTimeToNs(
+    _In_ uint64_t TxTime
+    )
+{
+    struct timespec Now = {0};
+    int ErrorCode = clock_gettime(CXPLAT_DATAPATH_TXTIME_CLOCK, &Now);
+    CXPLAT_DBG_ASSERT(ErrorCode == 0);
+    UNREFERENCED_PARAMETER(ErrorCode);
+    const uint64_t NowNs = S_TO_NS((uint64_t)Now.tv_sec) + (uint64_t)Now.tv_nsec;
+    const uint64_t TimeNow = CxPlatTimeUs64();
+    return
+        CxPlatTimeAtOrBefore64(TxTime, TimeNow) ?
+            NowNs : NowNs + US_TO_NS(CxPlatTimeDiff64(TimeNow, TxTime));
+}
+#endif
+
 void
 CxPlatDataPathCalculateFeatureSupport(
     _Inout_ CXPLAT_DATAPATH* Datapath,
@@ -343,163 +618,780 @@ Error:
             Datapath->RecvBlockBufferOffset + CXPLAT_SMALL_IO_BUFFER_SIZE;
     }
 
+#ifdef CXPLAT_DATAPATH_IO_URING
+    if (Datapath->UseIoUring) {
+        //
+        // Each send message header must stay valid until the io_uring send
+        // completes, so they are stored after the iovecs in the send data.
+        //
+        Datapath->SendDataSize += Datapath->SendIoVecCount * sizeof(struct msghdr);
+
+        //
+        // Leave room in front of the payload for the data multishot receives
+        // place there, so that the payload still ends up at the buffer offset.
+        //
+        const uint32_t BufferLength =
+            Datapath->RecvBlockSize - Datapath->RecvBlockBufferOffset;
+        Datapath->RecvBlockBufferOffset = (uint32_t)
+            (ALIGN_UP(Datapath->RecvBlockBufferOffset, uint64_t) +
+             CXPLAT_URING_RECV_PREFIX_LENGTH);
+        Datapath->RecvBlockSize = Datapath->RecvBlockBufferOffset + BufferLength;
+    }
+#endif
+
     Datapath->Features |= CXPLAT_DATAPATH_FEATURE_TCP;
 }
 
+static
 void
-CxPlatProcessorContextInitialize(
-    _In_ CXPLAT_DATAPATH* Datapath,
-    _In_ uint16_t PartitionIndex,
-    _Out_ CXPLAT_DATAPATH_PARTITION* DatapathPartition
-    )
-{
-    CXPLAT_DBG_ASSERT(Datapath != NULL);
-    DatapathPartition->Datapath = Datapath;
-    DatapathPartition->PartitionIndex = PartitionIndex;
-    DatapathPartition->EventQ = CxPlatWorkerPoolGetEventQ(Datapath->WorkerPool, PartitionIndex);
-    CxPlatRefInitialize(&DatapathPartition->RefCount);
-    CxPlatPoolInitialize(TRUE, Datapath->RecvBlockSize, QUIC_POOL_DATA, &DatapathPartition->RecvBlockPool);
-    CxPlatPoolInitialize(TRUE, Datapath->SendDataSize, QUIC_POOL_DATA, &DatapathPartition->SendBlockPool);
-}
-
-QUIC_STATUS
-DataPathInitialize(
-    _In_ uint32_t ClientRecvDataLength,
-    _In_opt_ const CXPLAT_UDP_DATAPATH_CALLBACKS* UdpCallbacks,
-    _In_opt_ const CXPLAT_TCP_DATAPATH_CALLBACKS* TcpCallbacks,
-    _In_ CXPLAT_WORKER_POOL* WorkerPool,
-    _In_opt_ QUIC_EXECUTION_CONFIG* Config,
-    _Out_ CXPLAT_DATAPATH** NewDatapath
+CxPlatBlockPoolInitialize(
+    _In_ uint32_t Size,
+    _In_ BOOLEAN UseHugePages,
+    _Out_ CXPLAT_BLOCK_POOL* BlockPool
     )
 {
-    UNREFERENCED_PARAMETER(TcpCallbacks);
-    if (NewDatapath == NULL) {
-        return QUIC_STATUS_INVALID_PARAMETER;
-    }
-    if (UdpCallbacks != NULL) {
-        if (UdpCallbacks->Receive == NULL || UdpCallbacks->Unreachable == NULL) {
-            return QUIC_STATUS_INVALID_PARAMETER;
-        }
-    }
-    if (TcpCallbacks != NULL) {
-        if (TcpCallbacks->Accept == NULL ||
-            TcpCallbacks->Connect == NULL ||
-            TcpCallbacks->Receive == NULL ||
-            TcpCallbacks->SendComplete == NULL) {
-            return QUIC_STATUS_INVALID_PARAMETER;
-        }
-    }
-    if (WorkerPool == NULL) {
-        return QUIC_STATUS_INVALID_PARAMETER;
-    }
-
-    if (!CxPlatWorkerPoolLazyStart(WorkerPool, Config)) {
-        return QUIC_STATUS_OUT_OF_MEMORY;
-    }
-
-    const uint32_t PartitionCount = (Config && Config->ProcessorCount)
-        ? Config->ProcessorCount : CxPlatProcCount();
-
-    const size_t DatapathLength =
-        sizeof(CXPLAT_DATAPATH) + PartitionCount * sizeof(CXPLAT_DATAPATH_PARTITION);
+    CxPlatPoolInitialize(TRUE, Size, QUIC_POOL_DATA, &BlockPool->Pool);
+    BlockPool->Slab = NULL;
+    BlockPool->SlabSize = 0;
+    CxPlatZeroMemory(&BlockPool->SlabFreeList, sizeof(BlockPool->SlabFreeList));
 
-    CXPLAT_DATAPATH* Datapath =
-        (CXPLAT_DATAPATH*)CXPLAT_ALLOC_PAGED(DatapathLength, QUIC_POOL_DATAPATH);
-    if (Datapath == NULL) {
-        QuicTraceEvent(
-            AllocFailure,
-            "Allocation of '%s' failed. (%llu bytes)",
-            "CXPLAT_DATAPATH",
-            DatapathLength);
-        return QUIC_STATUS_OUT_OF_MEMORY;
-    }
-
-    CxPlatZeroMemory(Datapath, DatapathLength);
-    if (UdpCallbacks) {
-        Datapath->UdpHandlers = *UdpCallbacks;
-    }
-    if (TcpCallbacks) {
-        Datapath->TcpHandlers = *TcpCallbacks;
+    if (!UseHugePages) {
+        return;
     }
-    Datapath->WorkerPool = WorkerPool;
-
-    Datapath->PartitionCount = PartitionCount;
-    Datapath->Features = CXPLAT_DATAPATH_FEATURE_LOCAL_PORT_SHARING;
-    CxPlatRefInitializeEx(&Datapath->RefCount, Datapath->PartitionCount);
-    CxPlatDataPathCalculateFeatureSupport(Datapath, ClientRecvDataLength);
 
     //
-    // Initialize the per processor contexts.
+    // Huge pages must be reserved by the administrator (vm.nr_hugepages), so
+    // failing to get them just leaves the regular pool to do all the work.
     //
-    for (uint32_t i = 0; i < Datapath->PartitionCount; i++) {
-        CxPlatProcessorContextInitialize(
-            Datapath, i, &Datapath->Partitions[i]);
+    void* Slab =
+        mmap(
+            NULL,
+            CXPLAT_HUGE_PAGE_POOL_SIZE,
+            PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+            -1,
+            0);
+    if (Slab == MAP_FAILED) {
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            errno,
+            "mmap(MAP_HUGETLB) failed, falling back to regular pages");
+        return;
     }
 
-    CXPLAT_FRE_ASSERT(CxPlatRundownAcquire(&WorkerPool->Rundown));
-    *NewDatapath = Datapath;
+    BlockPool->Slab = (uint8_t*)Slab;
+    BlockPool->SlabSize = CXPLAT_HUGE_PAGE_POOL_SIZE;
 
-    return QUIC_STATUS_SUCCESS;
+    const size_t Stride = ALIGN_UP(Size, uint64_t);
+    for (size_t Offset = 0; Offset + Stride <= BlockPool->SlabSize; Offset += Stride) {
+        CxPlatListPushEntry(
+            &BlockPool->SlabFreeList,
+            (CXPLAT_SLIST_ENTRY*)(BlockPool->Slab + Offset));
+    }
 }
 
-_IRQL_requires_max_(PASSIVE_LEVEL)
+static
 void
-CxPlatDataPathRelease(
-    _In_ CXPLAT_DATAPATH* Datapath
+CxPlatBlockPoolUninitialize(
+    _Inout_ CXPLAT_BLOCK_POOL* BlockPool
     )
 {
-    if (CxPlatRefDecrement(&Datapath->RefCount)) {
-#if DEBUG
-        CXPLAT_DBG_ASSERT(!Datapath->Freed);
-        CXPLAT_DBG_ASSERT(Datapath->Uninitialized);
-        Datapath->Freed = TRUE;
-#endif
-        CxPlatRundownRelease(&Datapath->WorkerPool->Rundown);
-        CXPLAT_FREE(Datapath, QUIC_POOL_DATAPATH);
+    CxPlatPoolUninitialize(&BlockPool->Pool);
+    if (BlockPool->Slab != NULL) {
+        munmap(BlockPool->Slab, BlockPool->SlabSize);
+        BlockPool->Slab = NULL;
     }
 }
 
-_IRQL_requires_max_(PASSIVE_LEVEL)
-void
-CxPlatProcessorContextRelease(
-    _In_ CXPLAT_DATAPATH_PARTITION* DatapathPartition
+static
+void*
+CxPlatBlockPoolAlloc(
+    _Inout_ CXPLAT_BLOCK_POOL* BlockPool
     )
 {
-    if (CxPlatRefDecrement(&DatapathPartition->RefCount)) {
-#if DEBUG
-        CXPLAT_DBG_ASSERT(!DatapathPartition->Uninitialized);
-        DatapathPartition->Uninitialized = TRUE;
-#endif
-        CxPlatPoolUninitialize(&DatapathPartition->SendBlockPool);
-        CxPlatPoolUninitialize(&DatapathPartition->RecvBlockPool);
-        CxPlatDataPathRelease(DatapathPartition->Datapath);
+    if (BlockPool->Slab != NULL) {
+        CxPlatLockAcquire(&BlockPool->Pool.Lock);
+        void* Entry = CxPlatListPopEntry(&BlockPool->SlabFreeList);
+        CxPlatLockRelease(&BlockPool->Pool.Lock);
+        if (Entry != NULL) {
+            return Entry;
+        }
     }
+    return CxPlatPoolAlloc(&BlockPool->Pool);
 }
 
+static
 void
-DataPathUninitialize(
-    _In_ CXPLAT_DATAPATH* Datapath
+CxPlatBlockPoolFree(
+    _Inout_ CXPLAT_BLOCK_POOL* BlockPool,
+    _In_ void* Entry
     )
 {
-    if (Datapath != NULL) {
-#if DEBUG
-        CXPLAT_DBG_ASSERT(!Datapath->Uninitialized);
-        Datapath->Uninitialized = TRUE;
-#endif
-        const uint16_t PartitionCount = Datapath->PartitionCount;
-        for (uint32_t i = 0; i < PartitionCount; i++) {
-            CxPlatProcessorContextRelease(&Datapath->Partitions[i]);
-        }
+    if ((uint8_t*)Entry >= BlockPool->Slab &&
+        (uint8_t*)Entry < BlockPool->Slab + BlockPool->SlabSize) {
+        CxPlatLockAcquire(&BlockPool->Pool.Lock);
+        CxPlatListPushEntry(&BlockPool->SlabFreeList, (CXPLAT_SLIST_ENTRY*)Entry);
+        CxPlatLockRelease(&BlockPool->Pool.Lock);
+    } else {
+        CxPlatPoolFree(&BlockPool->Pool, Entry);
     }
 }
 
-_IRQL_requires_max_(PASSIVE_LEVEL)
-void
-DataPathUpdateConfig(
-    _In_ CXPLAT_DATAPATH* Datapath,
-    _In_ QUIC_EXECUTION_CONFIG* Config
-    )
-{
+#ifdef CXPLAT_DATAPATH_IO_URING
+
+static
+int
+CxPlatUringSetup(
+    _In_ uint32_t Entries,
+    _Inout_ struct io_uring_params* Params
+    )
+{
+    return (int)syscall(__NR_io_uring_setup, Entries, Params);
+}
+
+static
+int
+CxPlatUringEnter(
+    _In_ int Fd,
+    _In_ uint32_t ToSubmit,
+    _In_ uint32_t MinComplete,
+    _In_ uint32_t Flags
+    )
+{
+    return (int)syscall(__NR_io_uring_enter, Fd, ToSubmit, MinComplete, Flags, NULL, 0);
+}
+
+static
+int
+CxPlatUringRegister(
+    _In_ int Fd,
+    _In_ uint32_t Opcode,
+    _In_opt_ void* Arg,
+    _In_ uint32_t ArgCount
+    )
+{
+    return (int)syscall(__NR_io_uring_register, Fd, Opcode, Arg, ArgCount);
+}
+
+//
+// Returns the next free submission queue entry, submitting any queued entries
+// first if the submission queue is full. Must be called with SqLock held.
+//
+static
+struct io_uring_sqe*
+CxPlatUringGetSqe(
+    _In_ CXPLAT_URING* Uring
+    );
+
+//
+// Submits all queued submission queue entries to the kernel. Must be called
+// with SqLock held.
+//
+static
+void
+CxPlatUringSubmit(
+    _In_ CXPLAT_URING* Uring
+    )
+{
+    const uint32_t ToSubmit =
+        Uring->SqLocalTail - __atomic_load_n(Uring->SqHead, __ATOMIC_ACQUIRE);
+    if (ToSubmit == 0) {
+        return;
+    }
+
+    __atomic_store_n(Uring->SqTail, Uring->SqLocalTail, __ATOMIC_RELEASE);
+
+    int Ret;
+    do {
+        Ret = CxPlatUringEnter(Uring->Fd, ToSubmit, 0, 0);
+    } while (Ret < 0 && errno == EINTR);
+    if (Ret < 0) {
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            errno,
+            "io_uring_enter failed");
+    }
+}
+
+static
+struct io_uring_sqe*
+CxPlatUringGetSqe(
+    _In_ CXPLAT_URING* Uring
+    )
+{
+    if (Uring->SqLocalTail - __atomic_load_n(Uring->SqHead, __ATOMIC_ACQUIRE) >= Uring->SqEntries) {
+        CxPlatUringSubmit(Uring);
+        if (Uring->SqLocalTail - __atomic_load_n(Uring->SqHead, __ATOMIC_ACQUIRE) >= Uring->SqEntries) {
+            return NULL;
+        }
+    }
+
+    struct io_uring_sqe* Sqe = &Uring->Sqes[Uring->SqLocalTail & Uring->SqMask];
+    Uring->SqLocalTail++;
+    CxPlatZeroMemory(Sqe, sizeof(*Sqe));
+    return Sqe;
+}
+
+//
+// Adds the receive block's buffer back to the provided buffer ring. Only
+// called on the partition's worker thread (or before the ring is in use).
+//
+static
+void
+CxPlatUringProvideBuffer(
+    _In_ CXPLAT_URING* Uring,
+    _In_ uint16_t BufferId
+    )
+{
+    struct io_uring_buf* Buf =
+        &Uring->BufRing->bufs[Uring->BufTail & (Uring->BufCount - 1)];
+    Buf->addr = (uint64_t)(uintptr_t)((uint8_t*)Uring->BufBlocks[BufferId] + Uring->BufOffset);
+    Buf->len = Uring->BufLength;
+    Buf->bid = BufferId;
+    Uring->BufTail++;
+    __atomic_store_n(&Uring->BufRing->tail, Uring->BufTail, __ATOMIC_RELEASE);
+}
+
+static
+DATAPATH_RX_IO_BLOCK*
+CxPlatUringAllocRecvBlock(
+    _In_ CXPLAT_DATAPATH_PARTITION* DatapathPartition
+    )
+{
+    DATAPATH_RX_IO_BLOCK* IoBlock = CxPlatBlockPoolAlloc(&DatapathPartition->RecvBlockPool);
+    if (IoBlock == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "DATAPATH_RX_IO_BLOCK",
+            0);
+        return NULL;
+    }
+    IoBlock->OwningPool = &DatapathPartition->RecvBlockPool;
+    IoBlock->Route.State = RouteResolved;
+    return IoBlock;
+}
+
+static
+void
+CxPlatUringUninitialize(
+    _In_ CXPLAT_DATAPATH_PARTITION* DatapathPartition,
+    _In_ CXPLAT_URING* Uring
+    )
+{
+    if (Uring->Fd != INVALID_SOCKET) {
+        epoll_ctl(*DatapathPartition->EventQ, EPOLL_CTL_DEL, Uring->Fd, NULL);
+        close(Uring->Fd);
+    }
+    if (Uring->BufBlocks != NULL) {
+        for (uint16_t i = 0; i < Uring->BufCount; ++i) {
+            if (Uring->BufBlocks[i] != NULL) {
+                CxPlatBlockPoolFree(&DatapathPartition->RecvBlockPool, Uring->BufBlocks[i]);
+            }
+        }
+        CXPLAT_FREE(Uring->BufBlocks, QUIC_POOL_DATAPATH);
+    }
+    if (Uring->BufRing != NULL) {
+        munmap(Uring->BufRing, Uring->BufRingSize);
+    }
+    if (Uring->Sqes != NULL) {
+        munmap(Uring->Sqes, Uring->SqesSize);
+    }
+    if (Uring->CqRing != NULL && Uring->CqRing != Uring->SqRing) {
+        munmap(Uring->CqRing, Uring->CqRingSize);
+    }
+    if (Uring->SqRing != NULL) {
+        munmap(Uring->SqRing, Uring->SqRingSize);
+    }
+    CxPlatLockUninitialize(&Uring->SqLock);
+    CXPLAT_FREE(Uring, QUIC_POOL_DATAPATH);
+}
+
+static
+void*
+CxPlatUringMap(
+    _In_ int Fd,
+    _In_ size_t Length,
+    _In_ uint64_t Offset
+    )
+{
+    void* Mapping =
+        mmap(NULL, Length, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, Fd, (off_t)Offset);
+    return Mapping == MAP_FAILED ? NULL : Mapping;
+}
+
+//
+// Creates the partition's io_uring and fills its provided buffer ring. On
+// failure, the partition's sockets fall back to epoll based IO.
+//
+static
+QUIC_STATUS
+CxPlatUringInitialize(
+    _Inout_ CXPLAT_DATAPATH_PARTITION* DatapathPartition
+    )
+{
+    QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
+    CXPLAT_DATAPATH* Datapath = DatapathPartition->Datapath;
+    const BOOLEAN Coalesced =
+        !!(Datapath->Features & CXPLAT_DATAPATH_FEATURE_RECV_COALESCING);
+    struct io_uring_params Params;
+    struct io_uring_sync_cancel_reg CancelReg;
+    struct io_uring_buf_reg BufReg;
+
+    CXPLAT_URING* Uring = CXPLAT_ALLOC_NONPAGED(sizeof(CXPLAT_URING), QUIC_POOL_DATAPATH);
+    if (Uring == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "CXPLAT_URING",
+            sizeof(CXPLAT_URING));
+        return QUIC_STATUS_OUT_OF_MEMORY;
+    }
+
+    CxPlatZeroMemory(Uring, sizeof(*Uring));
+    Uring->Sqe.CqeType = CXPLAT_CQE_TYPE_SOCKET_URING;
+    Uring->Fd = INVALID_SOCKET;
+    CxPlatLockInitialize(&Uring->SqLock);
+
+    CxPlatZeroMemory(&Params, sizeof(Params));
+    Params.flags = IORING_SETUP_CQSIZE | IORING_SETUP_CLAMP;
+    Params.cq_entries = CXPLAT_URING_CQ_ENTRIES;
+    Uring->Fd = CxPlatUringSetup(CXPLAT_URING_SQ_ENTRIES, &Params);
+    if (Uring->Fd < 0) {
+        Uring->Fd = INVALID_SOCKET;
+        Status = errno;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "io_uring_setup failed");
+        goto Exit;
+    }
+
+    if (!(Params.features & IORING_FEAT_NODROP) ||
+        !(Params.features & IORING_FEAT_SUBMIT_STABLE)) {
+        Status = QUIC_STATUS_NOT_SUPPORTED;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "io_uring missing required features");
+        goto Exit;
+    }
+
+    //
+    // Multishot receive requires at least a 6.0 kernel. Synchronous cancel
+    // registration arrived in the same release, so probe for it by trying to
+    // cancel a request that doesn't exist, which only fails with ENOENT if
+    // it's supported.
+    //
+    CxPlatZeroMemory(&CancelReg, sizeof(CancelReg));
+    CancelReg.addr = UINT64_MAX;
+    CancelReg.fd = -1;
+    CancelReg.timeout.tv_sec = -1;
+    CancelReg.timeout.tv_nsec = -1;
+    if (CxPlatUringRegister(Uring->Fd, IORING_REGISTER_SYNC_CANCEL, &CancelReg, 1) == 0 ||
+        errno != ENOENT) {
+        Status = QUIC_STATUS_NOT_SUPPORTED;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "io_uring multishot receive not supported");
+        goto Exit;
+    }
+
+    Uring->SqRingSize = Params.sq_off.array + Params.sq_entries * sizeof(uint32_t);
+    Uring->CqRingSize = Params.cq_off.cqes + Params.cq_entries * sizeof(struct io_uring_cqe);
+    if (Params.features & IORING_FEAT_SINGLE_MMAP) {
+        Uring->SqRingSize = CXPLAT_MAX(Uring->SqRingSize, Uring->CqRingSize);
+        Uring->CqRingSize = Uring->SqRingSize;
+    }
+
+    Uring->SqRing = CxPlatUringMap(Uring->Fd, Uring->SqRingSize, IORING_OFF_SQ_RING);
+    if (Uring->SqRing == NULL) {
+        Status = errno;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "mmap(IORING_OFF_SQ_RING) failed");
+        goto Exit;
+    }
+
+    if (Params.features & IORING_FEAT_SINGLE_MMAP) {
+        Uring->CqRing = Uring->SqRing;
+    } else {
+        Uring->CqRing = CxPlatUringMap(Uring->Fd, Uring->CqRingSize, IORING_OFF_CQ_RING);
+        if (Uring->CqRing == NULL) {
+            Status = errno;
+            QuicTraceEvent(
+                LibraryErrorStatus,
+                "[ lib] ERROR, %u, %s.",
+                Status,
+                "mmap(IORING_OFF_CQ_RING) failed");
+            goto Exit;
+        }
+    }
+
+    Uring->SqesSize = Params.sq_entries * sizeof(struct io_uring_sqe);
+    Uring->Sqes = CxPlatUringMap(Uring->Fd, Uring->SqesSize, IORING_OFF_SQES);
+    if (Uring->Sqes == NULL) {
+        Status = errno;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "mmap(IORING_OFF_SQES) failed");
+        goto Exit;
+    }
+
+    uint8_t* SqRing = (uint8_t*)Uring->SqRing;
+    Uring->SqHead = (uint32_t*)(SqRing + Params.sq_off.head);
+    Uring->SqTail = (uint32_t*)(SqRing + Params.sq_off.tail);
+    Uring->SqFlags = (uint32_t*)(SqRing + Params.sq_off.flags);
+    Uring->SqMask = *(uint32_t*)(SqRing + Params.sq_off.ring_mask);
+    Uring->SqEntries = *(uint32_t*)(SqRing + Params.sq_off.ring_entries);
+    Uring->SqLocalTail = *Uring->SqTail;
+
+    //
+    // SQEs are always consumed in order, so the index array is an identity
+    // mapping that never changes.
+    //
+    uint32_t* SqArray = (uint32_t*)(SqRing + Params.sq_off.array);
+    for (uint32_t i = 0; i < Uring->SqEntries; ++i) {
+        SqArray[i] = i;
+    }
+
+    uint8_t* CqRing = (uint8_t*)Uring->CqRing;
+    Uring->CqHead = (uint32_t*)(CqRing + Params.cq_off.head);
+    Uring->CqTail = (uint32_t*)(CqRing + Params.cq_off.tail);
+    Uring->CqMask = *(uint32_t*)(CqRing + Params.cq_off.ring_mask);
+    Uring->Cqes = (struct io_uring_cqe*)(CqRing + Params.cq_off.cqes);
+
+    //
+    // Set up the provided buffer ring and fill it with receive blocks.
+    //
+    Uring->BufCount =
+        Coalesced ? CXPLAT_URING_RECV_BUFFER_COUNT_GRO : CXPLAT_URING_RECV_BUFFER_COUNT;
+    Uring->BufOffset =
+        Datapath->RecvBlockBufferOffset - (uint32_t)CXPLAT_URING_RECV_PREFIX_LENGTH;
+    Uring->BufLength =
+        Datapath->RecvBlockSize - Uring->BufOffset;
+
+    const size_t PageSize = (size_t)sysconf(_SC_PAGESIZE);
+    Uring->BufRingSize =
+        (Uring->BufCount * sizeof(struct io_uring_buf) + PageSize - 1) & ~(PageSize - 1);
+    Uring->BufRing =
+        mmap(NULL, Uring->BufRingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (Uring->BufRing == MAP_FAILED) {
+        Uring->BufRing = NULL;
+        Status = errno;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "mmap(buffer ring) failed");
+        goto Exit;
+    }
+
+    Uring->BufBlocks =
+        CXPLAT_ALLOC_NONPAGED(Uring->BufCount * sizeof(DATAPATH_RX_IO_BLOCK*), QUIC_POOL_DATAPATH);
+    if (Uring->BufBlocks == NULL) {
+        Status = QUIC_STATUS_OUT_OF_MEMORY;
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "CXPLAT_URING buffers",
+            Uring->BufCount * sizeof(DATAPATH_RX_IO_BLOCK*));
+        goto Exit;
+    }
+    CxPlatZeroMemory(Uring->BufBlocks, Uring->BufCount * sizeof(DATAPATH_RX_IO_BLOCK*));
+
+    for (uint16_t i = 0; i < Uring->BufCount; ++i) {
+        Uring->BufBlocks[i] = CxPlatUringAllocRecvBlock(DatapathPartition);
+        if (Uring->BufBlocks[i] == NULL) {
+            Status = QUIC_STATUS_OUT_OF_MEMORY;
+            goto Exit;
+        }
+        CxPlatUringProvideBuffer(Uring, i);
+    }
+
+    CxPlatZeroMemory(&BufReg, sizeof(BufReg));
+    BufReg.ring_addr = (uint64_t)(uintptr_t)Uring->BufRing;
+    BufReg.ring_entries = Uring->BufCount;
+    BufReg.bgid = CXPLAT_URING_RECV_BUFFER_GROUP;
+    if (CxPlatUringRegister(Uring->Fd, IORING_REGISTER_PBUF_RING, &BufReg, 1) != 0) {
+        Status = errno;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "io_uring_register(IORING_REGISTER_PBUF_RING) failed");
+        goto Exit;
+    }
+
+    Uring->RecvMsgHdr.msg_namelen = CXPLAT_URING_RECV_NAME_LENGTH;
+    Uring->RecvMsgHdr.msg_controllen = sizeof(CXPLAT_RECV_MSG_CONTROL_BUFFER);
+
+    struct epoll_event EpEvt = {
+        .events = EPOLLIN, .data = { .ptr = &Uring->Sqe, } };
+    if (epoll_ctl(*DatapathPartition->EventQ, EPOLL_CTL_ADD, Uring->Fd, &EpEvt) != 0) {
+        Status = errno;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "epoll_ctl(io_uring) failed");
+        goto Exit;
+    }
+
+    DatapathPartition->Uring = Uring;
+    Uring = NULL;
+
+Exit:
+
+    if (Uring != NULL) {
+        CxPlatUringUninitialize(DatapathPartition, Uring);
+    }
+
+    return Status;
+}
+
+//
+// Posts the socket's multishot receive. It remains armed (generating a
+// completion per datagram) until it's cancelled or fails.
+//
+static
+void
+CxPlatSocketContextUringStartRecv(
+    _In_ CXPLAT_SOCKET_CONTEXT* SocketContext
+    )
+{
+    CXPLAT_URING* Uring = SocketContext->DatapathPartition->Uring;
+
+    CxPlatLockAcquire(&Uring->SqLock);
+    struct io_uring_sqe* Sqe = CxPlatUringGetSqe(Uring);
+    if (Sqe != NULL) {
+        Sqe->opcode = IORING_OP_RECVMSG;
+        Sqe->fd = SocketContext->SocketFd;
+        Sqe->addr = (uint64_t)(uintptr_t)&Uring->RecvMsgHdr;
+        Sqe->len = 1;
+        Sqe->ioprio = IORING_RECV_MULTISHOT;
+        Sqe->flags = IOSQE_BUFFER_SELECT;
+        Sqe->buf_group = CXPLAT_URING_RECV_BUFFER_GROUP;
+        Sqe->user_data = (uint64_t)(uintptr_t)SocketContext | CXPLAT_URING_OP_RECV;
+        InterlockedIncrement(&SocketContext->UringRefCount);
+        CxPlatUringSubmit(Uring);
+    } else {
+        QuicTraceEvent(
+            DatapathErrorStatus,
+            "[data][%p] ERROR, %u, %s.",
+            SocketContext->Binding,
+            QUIC_STATUS_OUT_OF_MEMORY,
+            "io_uring submission queue full");
+    }
+    CxPlatLockRelease(&Uring->SqLock);
+}
+
+#endif // CXPLAT_DATAPATH_IO_URING
+
+void
+CxPlatProcessorContextInitialize(
+    _In_ CXPLAT_DATAPATH* Datapath,
+    _In_ uint16_t PartitionIndex,
+    _Out_ CXPLAT_DATAPATH_PARTITION* DatapathPartition
+    )
+{
+    CXPLAT_DBG_ASSERT(Datapath != NULL);
+    DatapathPartition->Datapath = Datapath;
+    DatapathPartition->PartitionIndex = PartitionIndex;
+    DatapathPartition->EventQ = CxPlatWorkerPoolGetEventQ(Datapath->WorkerPool, PartitionIndex);
+    CxPlatRefInitialize(&DatapathPartition->RefCount);
+    CxPlatBlockPoolInitialize(
+        Datapath->RecvBlockSize, Datapath->UseHugePages, &DatapathPartition->RecvBlockPool);
+    CxPlatBlockPoolInitialize(
+        Datapath->SendDataSize, Datapath->UseHugePages, &DatapathPartition->SendBlockPool);
+#ifdef CXPLAT_DATAPATH_IO_URING
+    if (Datapath->UseIoUring) {
+        //
+        // Failure is not fatal, as the partition's sockets just fall back to
+        // using epoll.
+        //
+        (void)CxPlatUringInitialize(DatapathPartition);
+    }
+#endif
+}
+
+QUIC_STATUS
+DataPathInitialize(
+    _In_ uint32_t ClientRecvDataLength,
+    _In_opt_ const CXPLAT_UDP_DATAPATH_CALLBACKS* UdpCallbacks,
+    _In_opt_ const CXPLAT_TCP_DATAPATH_CALLBACKS* TcpCallbacks,
+    _In_ CXPLAT_WORKER_POOL* WorkerPool,
+    _In_opt_ QUIC_EXECUTION_CONFIG* Config,
+    _Out_ CXPLAT_DATAPATH** NewDatapath
+    )
+{
+    UNREFERENCED_PARAMETER(TcpCallbacks);
+    if (NewDatapath == NULL) {
+        return QUIC_STATUS_INVALID_PARAMETER;
+    }
+    if (UdpCallbacks != NULL) {
+        if (UdpCallbacks->Receive == NULL || UdpCallbacks->Unreachable == NULL) {
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
+    }
+    if (TcpCallbacks != NULL) {
+        if (TcpCallbacks->Accept == NULL ||
+            TcpCallbacks->Connect == NULL ||
+            TcpCallbacks->Receive == NULL ||
+            TcpCallbacks->SendComplete == NULL) {
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
+    }
+    if (WorkerPool == NULL) {
+        return QUIC_STATUS_INVALID_PARAMETER;
+    }
+
+    if (!CxPlatWorkerPoolLazyStart(WorkerPool, Config)) {
+        return QUIC_STATUS_OUT_OF_MEMORY;
+    }
+
+    const uint32_t PartitionCount = (Config && Config->ProcessorCount)
+        ? Config->ProcessorCount : CxPlatProcCount();
+
+    const size_t DatapathLength =
+        sizeof(CXPLAT_DATAPATH) + PartitionCount * sizeof(CXPLAT_DATAPATH_PARTITION);
+
+    CXPLAT_DATAPATH* Datapath =
+        (CXPLAT_DATAPATH*)CXPLAT_ALLOC_PAGED(DatapathLength, QUIC_POOL_DATAPATH);
+    if (Datapath == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "CXPLAT_DATAPATH",
+            DatapathLength);
+        return QUIC_STATUS_OUT_OF_MEMORY;
+    }
+
+    CxPlatZeroMemory(Datapath, DatapathLength);
+    if (UdpCallbacks) {
+        Datapath->UdpHandlers = *UdpCallbacks;
+    }
+    if (TcpCallbacks) {
+        Datapath->TcpHandlers = *TcpCallbacks;
+    }
+    Datapath->WorkerPool = WorkerPool;
+
+    Datapath->PartitionCount = PartitionCount;
+    Datapath->Features = CXPLAT_DATAPATH_FEATURE_LOCAL_PORT_SHARING;
+#ifdef CXPLAT_DATAPATH_IO_URING
+    Datapath->UseIoUring =
+        Config && !!(Config->Flags & QUIC_EXECUTION_CONFIG_FLAG_IO_URING);
+#endif
+#ifdef CXPLAT_DATAPATH_ZEROCOPY
+    Datapath->UseZeroCopySend =
+        Config && !!(Config->Flags & QUIC_EXECUTION_CONFIG_FLAG_ZERO_COPY_SEND);
+#endif
+    Datapath->UseHugePages =
+        Config && !!(Config->Flags & QUIC_EXECUTION_CONFIG_FLAG_HUGE_PAGES);
+    Datapath->UsePartitionSockets =
+        Config && !!(Config->Flags & QUIC_EXECUTION_CONFIG_FLAG_PARTITION_SOCKETS);
+    if (Config && (Config->Flags & QUIC_EXECUTION_CONFIG_FLAG_BUSY_POLL)) {
+        Datapath->BusyPollUs =
+            Config->PollingIdleTimeoutUs != 0 ?
+                Config->PollingIdleTimeoutUs : CXPLAT_BUSY_POLL_DEFAULT_US;
+    }
+#ifdef CXPLAT_DATAPATH_TXTIME
+    if (Config && (Config->Flags & QUIC_EXECUTION_CONFIG_FLAG_PACING_OFFLOAD) &&
+        CxPlatDataPathIsTxTimeSupported()) {
+        Datapath->Features |= CXPLAT_DATAPATH_FEATURE_SEND_TXTIME;
+    }
+#endif
+    CxPlatRefInitializeEx(&Datapath->RefCount, Datapath->PartitionCount);
+    CxPlatDataPathCalculateFeatureSupport(Datapath, ClientRecvDataLength);
+
+    //
+    // Initialize the per processor contexts.
+    //
+    for (uint32_t i = 0; i < Datapath->PartitionCount; i++) {
+        CxPlatProcessorContextInitialize(
+            Datapath, i, &Datapath->Partitions[i]);
+    }
+
+    CXPLAT_FRE_ASSERT(CxPlatRundownAcquire(&WorkerPool->Rundown));
+    *NewDatapath = Datapath;
+
+    return QUIC_STATUS_SUCCESS;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CxPlatDataPathRelease(
+    _In_ CXPLAT_DATAPATH* Datapath
+    )
+{
+    if (CxPlatRefDecrement(&Datapath->RefCount)) {
+#if DEBUG
+        CXPLAT_DBG_ASSERT(!Datapath->Freed);
+        CXPLAT_DBG_ASSERT(Datapath->Uninitialized);
+        Datapath->Freed = TRUE;
+#endif
+        CxPlatRundownRelease(&Datapath->WorkerPool->Rundown);
+        CXPLAT_FREE(Datapath, QUIC_POOL_DATAPATH);
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CxPlatProcessorContextRelease(
+    _In_ CXPLAT_DATAPATH_PARTITION* DatapathPartition
+    )
+{
+    if (CxPlatRefDecrement(&DatapathPartition->RefCount)) {
+#if DEBUG
+        CXPLAT_DBG_ASSERT(!DatapathPartition->Uninitialized);
+        DatapathPartition->Uninitialized = TRUE;
+#endif
+#ifdef CXPLAT_DATAPATH_IO_URING
+        if (DatapathPartition->Uring != NULL) {
+            CxPlatUringUninitialize(DatapathPartition, DatapathPartition->Uring);
+            DatapathPartition->Uring = NULL;
+        }
+#endif
+        CxPlatBlockPoolUninitialize(&DatapathPartition->SendBlockPool);
+        CxPlatBlockPoolUninitialize(&DatapathPartition->RecvBlockPool);
+        CxPlatDataPathRelease(DatapathPartition->Datapath);
+    }
+}
+
+void
+DataPathUninitialize(
+    _In_ CXPLAT_DATAPATH* Datapath
+    )
+{
+    if (Datapath != NULL) {
+#if DEBUG
+        CXPLAT_DBG_ASSERT(!Datapath->Uninitialized);
+        Datapath->Uninitialized = TRUE;
+#endif
+        const uint16_t PartitionCount = Datapath->PartitionCount;
+        for (uint32_t i = 0; i < PartitionCount; i++) {
+            CxPlatProcessorContextRelease(&Datapath->Partitions[i]);
+        }
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+DataPathUpdateConfig(
+    _In_ CXPLAT_DATAPATH* Datapath,
+    _In_ QUIC_EXECUTION_CONFIG* Config
+    )
+{
     UNREFERENCED_PARAMETER(Datapath);
     UNREFERENCED_PARAMETER(Config);
 }
@@ -513,6 +1405,17 @@ DataPathGetSupportedFeatures(
     return Datapath->Features;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint16_t
+DataPathGetMaxSendSegments(
+    _In_ CXPLAT_DATAPATH* Datapath
+    )
+{
+    return
+        (Datapath->Features & CXPLAT_DATAPATH_FEATURE_SEND_SEGMENTATION) ?
+            CXPLAT_MAX_GSO_SEGMENTS : (uint16_t)Datapath->SendIoVecCount;
+}
+
 BOOLEAN
 DataPathIsPaddingPreferred(
     _In_ CXPLAT_DATAPATH* Datapath
@@ -521,9 +1424,18 @@ DataPathIsPaddingPreferred(
     return !!(Datapath->Features & CXPLAT_DATAPATH_FEATURE_SEND_SEGMENTATION);
 }
 
+//
+// Steers received packets across the SO_REUSEPORT group. By default, packets
+// go to the socket for the CPU they were received on. When the core supplies
+// its CID layout, short header packets instead go to the socket owning the
+// partition encoded in their destination CID, so that they never need to be
+// handed off to another partition. Long header packets, which mostly carry
+// client chosen CIDs, still follow the CPU.
+//
 QUIC_STATUS
 CxPlatSocketConfigureRss(
     _In_ CXPLAT_SOCKET_CONTEXT* SocketContext,
+    _In_ const CXPLAT_UDP_CONFIG* Config,
     _In_ uint32_t SocketCount
     )
 {
@@ -531,15 +1443,46 @@ CxPlatSocketConfigureRss(
     QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
     int Result = 0;
 
-    struct sock_filter BpfCode[] = {
+    struct sock_filter CpuBpfCode[] = {
+        {BPF_LD | BPF_W | BPF_ABS, 0, 0, SKF_AD_OFF | SKF_AD_CPU},
+        {BPF_ALU | BPF_MOD, 0, 0, SocketCount},
+        {BPF_RET | BPF_A, 0, 0, 0}
+    };
+
+    //
+    // The (UDP payload) offset of the partition ID is after the first byte
+    // of the short header. The partition ID is written in host byte order.
+    //
+    const uint32_t PidOffset = 1 + Config->CidPartitionIdOffset;
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    const uint32_t PidLowOffset = PidOffset, PidHighOffset = PidOffset + 1;
+#else
+    const uint32_t PidLowOffset = PidOffset + 1, PidHighOffset = PidOffset;
+#endif
+    struct sock_filter CidBpfCode[] = {
+        {BPF_LD | BPF_B | BPF_ABS, 0, 0, 0},
+        {BPF_JMP | BPF_JSET | BPF_K, 8, 0, 0x80}, // Long header -> 10
+        {BPF_LD | BPF_B | BPF_ABS, 0, 0, PidHighOffset},
+        {BPF_ALU | BPF_LSH | BPF_K, 0, 0, 8},
+        {BPF_MISC | BPF_TAX, 0, 0, 0},
+        {BPF_LD | BPF_B | BPF_ABS, 0, 0, PidLowOffset},
+        {BPF_ALU | BPF_OR | BPF_X, 0, 0, 0},
+        {BPF_ALU | BPF_AND | BPF_K, 0, 0, Config->CidPartitionMask},
+        {BPF_ALU | BPF_MOD | BPF_K, 0, 0, Config->CidPartitionCount},
+        {BPF_RET | BPF_A, 0, 0, 0},
         {BPF_LD | BPF_W | BPF_ABS, 0, 0, SKF_AD_OFF | SKF_AD_CPU},
         {BPF_ALU | BPF_MOD, 0, 0, SocketCount},
         {BPF_RET | BPF_A, 0, 0, 0}
     };
 
     struct sock_fprog BpfConfig = {0};
-	BpfConfig.len = ARRAYSIZE(BpfCode);
-    BpfConfig.filter = BpfCode;
+    if (Config->CidPartitionCount != 0) {
+        BpfConfig.len = ARRAYSIZE(CidBpfCode);
+        BpfConfig.filter = CidBpfCode;
+    } else {
+        BpfConfig.len = ARRAYSIZE(CpuBpfCode);
+        BpfConfig.filter = CpuBpfCode;
+    }
 
     Result =
         setsockopt(
@@ -561,6 +1504,7 @@ CxPlatSocketConfigureRss(
     return Status;
 #else
     UNREFERENCED_PARAMETER(SocketContext);
+    UNREFERENCED_PARAMETER(Config);
     UNREFERENCED_PARAMETER(SocketCount);
     return QUIC_STATUS_NOT_SUPPORTED;
 #endif
@@ -645,6 +1589,46 @@ Exit:
     return Status;
 }
 
+//
+// Has reads on the socket busy poll the NIC queue, and prefers busy polling
+// over interrupts for it. This is best effort, as raising the busy poll time
+// or budget above the system defaults requires CAP_NET_ADMIN.
+//
+void
+CxPlatSocketContextSetBusyPoll(
+    _In_ CXPLAT_SOCKET_CONTEXT* SocketContext,
+    _In_ uint32_t BusyPollUs
+    )
+{
+    struct {
+        int Name;
+        int Value;
+        const char* Error;
+    } Options[] = {
+        { SO_BUSY_POLL, (int)BusyPollUs, "setsockopt(SO_BUSY_POLL) failed" },
+#ifdef SO_PREFER_BUSY_POLL
+        { SO_PREFER_BUSY_POLL, TRUE, "setsockopt(SO_PREFER_BUSY_POLL) failed" },
+        { SO_BUSY_POLL_BUDGET, CXPLAT_BUSY_POLL_BUDGET, "setsockopt(SO_BUSY_POLL_BUDGET) failed" },
+#endif
+    };
+
+    for (uint32_t i = 0; i < ARRAYSIZE(Options); ++i) {
+        if (setsockopt(
+                SocketContext->SocketFd,
+                SOL_SOCKET,
+                Options[i].Name,
+                (const void*)&Options[i].Value,
+                sizeof(Options[i].Value)) == SOCKET_ERROR) {
+            QuicTraceEvent(
+                DatapathErrorStatus,
+                "[data][%p] ERROR, %u, %s.",
+                SocketContext->Binding,
+                errno,
+                Options[i].Error);
+        }
+    }
+}
+
 //
 // Socket context interface. It abstracts a (generally per-processor) UDP socket
 // and the corresponding logic/functionality like send and receive processing.
@@ -669,6 +1653,15 @@ CxPlatSocketContextInitialize(
     CXPLAT_DBG_ASSERT(PartitionIndex < Datapath->PartitionCount);
     SocketContext->DatapathPartition = &Datapath->Partitions[PartitionIndex];
     CxPlatRefIncrement(&SocketContext->DatapathPartition->RefCount);
+    SocketContext->UseIoUring =
+        SocketType == CXPLAT_SOCKET_UDP && SocketContext->DatapathPartition->Uring != NULL;
+    SocketContext->UringRefCount = 1;
+    SocketContext->RecvBatchSize = 1;
+
+    if (!CxPlatWorkerPoolStartWorker(Datapath->WorkerPool, PartitionIndex)) {
+        Status = QUIC_STATUS_OUT_OF_MEMORY;
+        goto Exit;
+    }
 
     if (QUIC_FAILED(CxPlatSocketContextSqeInitialize(SocketContext)) ||
         SocketType == CXPLAT_SOCKET_TCP_SERVER) {
@@ -899,6 +1892,65 @@ CxPlatSocketContextInitialize(
             goto Exit;
         }
 
+        if (Datapath->BusyPollUs != 0) {
+            CxPlatSocketContextSetBusyPoll(SocketContext, Datapath->BusyPollUs);
+        }
+
+#ifdef CXPLAT_DATAPATH_TXTIME
+        if (Datapath->Features & CXPLAT_DATAPATH_FEATURE_SEND_TXTIME) {
+            //
+            // Departure times are converted to this clock when the send is
+            // built. See CxPlatDataPathTxTimeToNs.
+            //
+            struct sock_txtime TxTime = { CXPLAT_DATAPATH_TXTIME_CLOCK, 0 };
+            Result =
+                setsockopt(
+                    SocketContext->SocketFd,
+                    SOL_SOCKET,
+                    SO_TXTIME,
+                    (const void*)&TxTime,
+                    sizeof(TxTime));
+            if (Result == SOCKET_ERROR) {
+                Status = errno;
+                QuicTraceEvent(
+                    DatapathErrorStatus,
+                    "[data][%p] ERROR, %u, %s.",
+                    Binding,
+                    Status,
+                    "setsockopt(SO_TXTIME) failed");
+                goto Exit;
+            }
+        }
+#endif
+
+#ifdef CXPLAT_DATAPATH_ZEROCOPY
+        if (Datapath->UseZeroCopySend && !SocketContext->UseIoUring) {
+            //
+            // Zerocopy is best effort. If the kernel doesn't support it, sends
+            // are just copied as usual.
+            //
+            Option = TRUE;
+            Result =
+                setsockopt(
+                    SocketContext->SocketFd,
+                    SOL_SOCKET,
+                    SO_ZEROCOPY,
+                    (const void*)&Option,
+                    sizeof(Option));
+            if (Result == SOCKET_ERROR) {
+                QuicTraceEvent(
+                    DatapathErrorStatus,
+                    "[data][%p] ERROR, %u, %s.",
+                    Binding,
+                    errno,
+                    "setsockopt(SO_ZEROCOPY) failed");
+            } else {
+                SocketContext->ZeroCopyConfigured = TRUE;
+                SocketContext->ZeroCopyEnabled = TRUE;
+            }
+        }
+#endif
+
         //
         // Only set SO_REUSEPORT on a server socket, otherwise the client could be
         // assigned a server port (unless it's forcing sharing).
@@ -1112,6 +2164,18 @@ CxPlatSocketContextUninitializeComplete(
         close(SocketContext->SocketFd);
     }
 
+    //
+    // No more zerocopy completions will be harvested once the socket is
+    // closed, so drop the kernel's references to any outstanding sends.
+    //
+    while (!CxPlatListIsEmpty(&SocketContext->ZeroCopyQueue)) {
+        CxPlatSendDataFree(
+            CXPLAT_CONTAINING_RECORD(
+                CxPlatListRemoveHead(&SocketContext->ZeroCopyQueue),
+                CXPLAT_SEND_DATA,
+                ZeroCopyEntry));
+    }
+
     if (SocketContext->SqeInitialized) {
         CxPlatSqeCleanup(SocketContext->DatapathPartition->EventQ, &SocketContext->ShutdownSqe.Sqe);
         CxPlatSqeCleanup(SocketContext->DatapathPartition->EventQ, &SocketContext->IoSqe.Sqe);
@@ -1119,6 +2183,7 @@ CxPlatSocketContextUninitializeComplete(
     }
 
     CxPlatLockUninitialize(&SocketContext->TxQueueLock);
+    CxPlatLockUninitialize(&SocketContext->ZeroCopyLock);
     CxPlatRundownUninitialize(&SocketContext->UpcallRundown);
 
     if (SocketContext->DatapathPartition) {
@@ -1214,7 +2279,14 @@ SocketCreateUdp(
     QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
     const BOOLEAN IsServerSocket = Config->RemoteAddress == NULL;
     const BOOLEAN NumPerProcessorSockets = IsServerSocket && Datapath->PartitionCount > 1;
-    const uint16_t SocketCount = NumPerProcessorSockets ? (uint16_t)CxPlatProcCount() : 1;
+    //
+    // In partition socket mode, each partition owns exactly one socket in the
+    // SO_REUSEPORT group, so the group index of a socket is its partition.
+    //
+    const uint16_t SocketCount =
+        !NumPerProcessorSockets ? 1 :
+        Datapath->UsePartitionSockets ?
+            (uint16_t)Datapath->PartitionCount : (uint16_t)CxPlatProcCount();
 
     CXPLAT_DBG_ASSERT(Datapath->UdpHandlers.Receive != NULL || Config->Flags & CXPLAT_SOCKET_FLAG_PCP);
 
@@ -1244,6 +2316,12 @@ SocketCreateUdp(
     Binding->Datapath = Datapath;
     Binding->ClientContext = Config->CallbackContext;
     Binding->NumPerProcessorSockets = NumPerProcessorSockets;
+    Binding->SocketCount = SocketCount;
+    if (NumPerProcessorSockets && Datapath->UsePartitionSockets) {
+        Binding->CidPartitionIdOffset = Config->CidPartitionIdOffset;
+        Binding->CidPartitionMask = Config->CidPartitionMask;
+        Binding->CidPartitionCount = Config->CidPartitionCount;
+    }
     Binding->HasFixedRemoteAddress = (Config->RemoteAddress != NULL);
     Binding->Mtu = CXPLAT_MAX_MTU;
     Binding->Type = CXPLAT_SOCKET_UDP;
@@ -1262,6 +2340,8 @@ SocketCreateUdp(
         Binding->SocketContexts[i].SocketFd = INVALID_SOCKET;
         CxPlatListInitializeHead(&Binding->SocketContexts[i].TxQueue);
         CxPlatLockInitialize(&Binding->SocketContexts[i].TxQueueLock);
+        CxPlatListInitializeHead(&Binding->SocketContexts[i].ZeroCopyQueue);
+        CxPlatLockInitialize(&Binding->SocketContexts[i].ZeroCopyLock);
         CxPlatRundownInitialize(&Binding->SocketContexts[i].UpcallRundown);
     }
 
@@ -1284,7 +2364,7 @@ SocketCreateUdp(
         // round robin, but each flow will be sent to the same socket, just not
         // based on RSS.
         //
-        (void)CxPlatSocketConfigureRss(&Binding->SocketContexts[0], SocketCount);
+        (void)CxPlatSocketConfigureRss(&Binding->SocketContexts[0], Config, SocketCount);
     }
 
     CxPlatConvertFromMappedV6(&Binding->LocalAddress, &Binding->LocalAddress);
@@ -1303,7 +2383,14 @@ SocketCreateUdp(
     *NewBinding = Binding;
 
     for (uint32_t i = 0; i < SocketCount; i++) {
-        CxPlatSocketContextSetEvents(&Binding->SocketContexts[i], EPOLL_CTL_ADD, EPOLLIN);
+#ifdef CXPLAT_DATAPATH_IO_URING
+        if (Binding->SocketContexts[i].UseIoUring) {
+            CxPlatSocketContextUringStartRecv(&Binding->SocketContexts[i]);
+        } else
+#endif
+        {
+            CxPlatSocketContextSetEvents(&Binding->SocketContexts[i], EPOLL_CTL_ADD, EPOLLIN);
+        }
         Binding->SocketContexts[i].IoStarted = TRUE;
     }
 
@@ -1373,6 +2460,7 @@ CxPlatSocketCreateTcpInternal(
     PartitionIndex =
         RemoteAddress ?
             ((uint16_t)(CxPlatProcCurrentNumber() % Datapath->PartitionCount)) : 0;
+    Binding->SocketCount = 1;
     CxPlatRefInitializeEx(&Binding->RefCount, 1);
 
     SocketContext = &Binding->SocketContexts[0];
@@ -1380,6 +2468,8 @@ CxPlatSocketCreateTcpInternal(
     SocketContext->SocketFd = INVALID_SOCKET;
     CxPlatListInitializeHead(&SocketContext->TxQueue);
     CxPlatLockInitialize(&SocketContext->TxQueueLock);
+    CxPlatListInitializeHead(&SocketContext->ZeroCopyQueue);
+    CxPlatLockInitialize(&SocketContext->ZeroCopyLock);
     CxPlatRundownInitialize(&SocketContext->UpcallRundown);
 
     CXPLAT_UDP_CONFIG Config = {
@@ -1501,6 +2591,7 @@ SocketCreateTcpListener(
     } else {
         Binding->LocalAddress.Ip.sa_family = QUIC_ADDRESS_FAMILY_INET6;
     }
+    Binding->SocketCount = 1;
     CxPlatRefInitializeEx(&Binding->RefCount, 1);
 
     SocketContext = &Binding->SocketContexts[0];
@@ -1508,6 +2599,8 @@ SocketCreateTcpListener(
     SocketContext->SocketFd = INVALID_SOCKET;
     CxPlatListInitializeHead(&SocketContext->TxQueue);
     CxPlatLockInitialize(&SocketContext->TxQueueLock);
+    CxPlatListInitializeHead(&SocketContext->ZeroCopyQueue);
+    CxPlatLockInitialize(&SocketContext->ZeroCopyLock);
     CxPlatRundownInitialize(&SocketContext->UpcallRundown);
 
     CXPLAT_UDP_CONFIG Config = {
@@ -1691,10 +2784,7 @@ SocketDelete(
     Socket->Uninitialized = TRUE;
 #endif
 
-    const uint16_t SocketCount =
-        Socket->NumPerProcessorSockets ? (uint16_t)CxPlatProcCount() : 1;
-
-    for (uint32_t i = 0; i < SocketCount; ++i) {
+    for (uint32_t i = 0; i < Socket->SocketCount; ++i) {
         CxPlatSocketContextUninitialize(&Socket->SocketContexts[i]);
     }
 }
@@ -1703,11 +2793,103 @@ SocketDelete(
 // Receive Path
 //
 
+#ifdef CXPLAT_DATAPATH_ZEROCOPY
+void
+CxPlatSocketContextCompleteZeroCopy(
+    _In_ CXPLAT_SOCKET_CONTEXT* SocketContext,
+    _In_ uint32_t Low,
+    _In_ uint32_t High
+    )
+{
+    CXPLAT_LIST_ENTRY Completed;
+    CxPlatListInitializeHead(&Completed);
+
+    CxPlatLockAcquire(&SocketContext->ZeroCopyLock);
+    CXPLAT_LIST_ENTRY* Entry = SocketContext->ZeroCopyQueue.Flink;
+    while (Entry != &SocketContext->ZeroCopyQueue) {
+        CXPLAT_SEND_DATA* SendData =
+            CXPLAT_CONTAINING_RECORD(Entry, CXPLAT_SEND_DATA, ZeroCopyEntry);
+        Entry = Entry->Flink;
+        if ((int32_t)(SendData->ZeroCopyId - High) > 0) {
+            break; // The queue is in send order, so nothing after this completed.
+        }
+        if (SendData->ZeroCopyId - Low <= High - Low) {
+            CxPlatListEntryRemove(&SendData->ZeroCopyEntry);
+            CxPlatListInsertTail(&Completed, &SendData->ZeroCopyEntry);
+        }
+    }
+    CxPlatLockRelease(&SocketContext->ZeroCopyLock);
+
+    while (!CxPlatListIsEmpty(&Completed)) {
+        CxPlatSendDataFree(
+            CXPLAT_CONTAINING_RECORD(
+                CxPlatListRemoveHead(&Completed),
+                CXPLAT_SEND_DATA,
+                ZeroCopyEntry));
+    }
+}
+
+//
+// Drains the MSG_ZEROCOPY completion notifications from the socket error
+// queue. Each one indicates a (inclusive) range of sends the kernel no longer
+// references.
+//
+void
+CxPlatSocketContextHarvestZeroCopy(
+    _In_ CXPLAT_SOCKET_CONTEXT* SocketContext
+    )
+{
+    alignas(8) char ControlBuffer[
+        CMSG_SPACE(sizeof(struct sock_extended_err) + sizeof(struct sockaddr_in6))];
+
+    while (TRUE) {
+        struct msghdr Msg = {0};
+        Msg.msg_control = ControlBuffer;
+        Msg.msg_controllen = sizeof(ControlBuffer);
+        if (recvmsg(SocketContext->SocketFd, &Msg, MSG_ERRQUEUE) < 0) {
+            break; // Nothing left in the error queue.
+        }
+
+        for (struct cmsghdr* CMsg = CMSG_FIRSTHDR(&Msg);
+             CMsg != NULL;
+             CMsg = CMSG_NXTHDR(&Msg, CMsg)) {
+            if (!(CMsg->cmsg_level == IPPROTO_IP && CMsg->cmsg_type == IP_RECVERR) &&
+                !(CMsg->cmsg_level == IPPROTO_IPV6 && CMsg->cmsg_type == IPV6_RECVERR)) {
+                continue;
+            }
+
+            const struct sock_extended_err* Err =
+                (const struct sock_extended_err*)CMSG_DATA(CMsg);
+            if (Err->ee_origin != SO_EE_ORIGIN_ZEROCOPY || Err->ee_errno != 0) {
+                continue;
+            }
+
+            if (Err->ee_code & SO_EE_CODE_ZEROCOPY_COPIED) {
+                //
+                // The kernel had to copy the data anyways (e.g. loopback or
+                // no scatter-gather support on the device), so stop paying
+                // for the page pinning and notifications.
+                //
+                SocketContext->ZeroCopyEnabled = FALSE;
+            }
+
+            CxPlatSocketContextCompleteZeroCopy(SocketContext, Err->ee_info, Err->ee_data);
+        }
+    }
+}
+#endif // CXPLAT_DATAPATH_ZEROCOPY
+
 void
 CxPlatSocketHandleErrors(
     _In_ CXPLAT_SOCKET_CONTEXT* SocketContext
     )
 {
+#ifdef CXPLAT_DATAPATH_ZEROCOPY
+    if (SocketContext->ZeroCopyConfigured) {
+        CxPlatSocketContextHarvestZeroCopy(SocketContext);
+    }
+#endif
+
     int ErrNum = 0;
     socklen_t OptLen = sizeof(ErrNum);
     ssize_t Ret =
@@ -1724,6 +2906,10 @@ CxPlatSocketHandleErrors(
             SocketContext->Binding,
             errno,
             "getsockopt(SO_ERROR) failed");
+    } else if (ErrNum == 0 && SocketContext->ZeroCopyConfigured) {
+        //
+        // Only zerocopy completions were queued on the socket.
+        //
     } else {
         QuicTraceEvent(
             DatapathErrorStatus,
@@ -1852,6 +3038,26 @@ CxPlatSocketContextRecvComplete(
             (uint8_t*)IoBlock + SocketContext->DatapathPartition->Datapath->RecvBlockBufferOffset;
         IoBlock->RefCount = 0;
 
+        const CXPLAT_SOCKET* Binding = SocketContext->Binding;
+        if (Binding->CidPartitionCount != 0 &&
+            !(RecvBuffer[0] & 0x80) && // Short header
+            RecvMsgHdr[CurrentMessage].msg_len >=
+                1u + Binding->CidPartitionIdOffset + sizeof(uint16_t)) {
+            //
+            // Count short header packets that the steering program failed to
+            // deliver to the partition owning their CID.
+            //
+            uint16_t PartitionId;
+            CxPlatCopyMemory(
+                &PartitionId,
+                RecvBuffer + 1 + Binding->CidPartitionIdOffset,
+                sizeof(PartitionId));
+            if ((PartitionId & Binding->CidPartitionMask) % Binding->CidPartitionCount !=
+                SocketContext->DatapathPartition->PartitionIndex) {
+                SocketContext->RecvMisdirected++;
+            }
+        }
+
         //
         // Build up the chain of receive packets to indicate up to the app.
         //
@@ -1908,74 +3114,42 @@ CxPlatSocketContextRecvComplete(
     }
 }
 
+//
+// Updates the socket context's receive batch size after a wakeup. The batch
+// doubles whenever a read fills it, and otherwise decays towards the average
+// number of messages read per wakeup, so mostly idle sockets don't tie up
+// receive blocks they won't use.
+//
 void
-CxPlatSocketReceiveCoalesced(
-    _In_ CXPLAT_SOCKET_CONTEXT* SocketContext
+CxPlatSocketContextUpdateRecvBatchSize(
+    _In_ CXPLAT_SOCKET_CONTEXT* SocketContext,
+    _In_ uint32_t MessageCount,
+    _In_ BOOLEAN BatchFilled,
+    _In_ uint16_t MaxBatchSize
     )
 {
-    CXPLAT_DATAPATH_PARTITION* DatapathPartition = SocketContext->DatapathPartition;
-    DATAPATH_RX_IO_BLOCK* IoBlock = NULL;
-    struct mmsghdr RecvMsgHdr;
-    CXPLAT_RECV_MSG_CONTROL_BUFFER RecvMsgControl;
-    struct iovec RecvIov;
-
-    do {
-        uint32_t RetryCount = 0;
-        do {
-            IoBlock = CxPlatPoolAlloc(&DatapathPartition->RecvBlockPool);
-        } while (IoBlock == NULL && ++RetryCount < 10);
-        if (IoBlock == NULL) {
-            QuicTraceEvent(
-                AllocFailure,
-                "Allocation of '%s' failed. (%llu bytes)",
-                "DATAPATH_RX_IO_BLOCK",
-                0);
-            goto Exit;
-        }
-
-        IoBlock->OwningPool = &DatapathPartition->RecvBlockPool;
-        IoBlock->Route.State = RouteResolved;
-
-        struct msghdr* MsgHdr = &RecvMsgHdr.msg_hdr;
-        MsgHdr->msg_name = &IoBlock->Route.RemoteAddress;
-        MsgHdr->msg_namelen = sizeof(IoBlock->Route.RemoteAddress);
-        MsgHdr->msg_iov = &RecvIov;
-        MsgHdr->msg_iovlen = 1;
-        MsgHdr->msg_control = &RecvMsgControl.Data;
-        MsgHdr->msg_controllen = sizeof(RecvMsgControl.Data);
-        MsgHdr->msg_flags = 0;
-        RecvIov.iov_base = (char*)IoBlock + DatapathPartition->Datapath->RecvBlockBufferOffset;
-        RecvIov.iov_len = CXPLAT_LARGE_IO_BUFFER_SIZE;
-
-        int Ret =
-            recvmmsg(
-                SocketContext->SocketFd,
-                &RecvMsgHdr,
-                1,
-                0,
-                NULL);
-        if (Ret < 0) {
-            if (errno != EAGAIN && errno != EWOULDBLOCK) {
-                QuicTraceEvent(
-                    DatapathErrorStatus,
-                    "[data][%p] ERROR, %u, %s.",
-                    SocketContext->Binding,
-                    errno,
-                    "recvmmsg failed");
-            }
-            break;
-        }
+    SocketContext->RecvWakeups++;
+    SocketContext->RecvMessages += MessageCount;
 
-        CXPLAT_DBG_ASSERT(Ret == 1);
-        CxPlatSocketContextRecvComplete(SocketContext, &IoBlock, &RecvMsgHdr, Ret);
-
-    } while (TRUE);
-
-Exit:
+    //
+    // Exponentially weighted moving average (1/8 gain) in 1/16th units.
+    //
+    uint32_t Average = SocketContext->RecvMessagesPerWakeup;
+    Average = (Average * 7 + CXPLAT_MIN(MessageCount, MaxBatchSize) * 16) / 8;
+    SocketContext->RecvMessagesPerWakeup = (uint16_t)Average;
 
-    if (IoBlock) {
-        CxPlatPoolFree(&DatapathPartition->RecvBlockPool, IoBlock);
+    uint32_t BatchSize;
+    if (BatchFilled) {
+        BatchSize = (uint32_t)SocketContext->RecvBatchSize * 2;
+    } else {
+        BatchSize = (Average + 15) / 16;
     }
+    if (BatchSize > MaxBatchSize) {
+        BatchSize = MaxBatchSize;
+    } else if (BatchSize == 0) {
+        BatchSize = 1;
+    }
+    SocketContext->RecvBatchSize = (uint16_t)BatchSize;
 }
 
 void
@@ -1990,27 +3164,45 @@ CxPlatSocketReceiveMessages(
     struct iovec RecvIov[CXPLAT_MAX_IO_BATCH_SIZE];
     CxPlatZeroMemory(IoBlocks, sizeof(IoBlocks));
 
+    //
+    // With receive coalescing each message may hold a full GRO batch, so
+    // fewer (but much larger) buffers are read at a time.
+    //
+    const BOOLEAN Coalesced =
+        !!(DatapathPartition->Datapath->Features & CXPLAT_DATAPATH_FEATURE_RECV_COALESCING);
+    const uint16_t MaxBatchSize =
+        Coalesced ? CXPLAT_MAX_COALESCED_RECV_BATCH_SIZE : CXPLAT_MAX_IO_BATCH_SIZE;
+    const size_t BufferLength =
+        Coalesced ? CXPLAT_LARGE_IO_BUFFER_SIZE : CXPLAT_SMALL_IO_BUFFER_SIZE;
+    uint32_t MessageCount = 0;
+    BOOLEAN BatchFilled = FALSE;
+
     do {
+        const uint16_t BatchSize = SocketContext->RecvBatchSize;
+        CXPLAT_DBG_ASSERT(BatchSize > 0 && BatchSize <= MaxBatchSize);
+
         uint32_t RetryCount = 0;
-        for (uint32_t i = 0; i < CXPLAT_MAX_IO_BATCH_SIZE && IoBlocks[i] == NULL; ++i) {
+        for (uint32_t i = 0; i < BatchSize; ++i) {
+
+            DATAPATH_RX_IO_BLOCK* IoBlock = IoBlocks[i];
+            if (IoBlock == NULL) { // Otherwise, still unused from the last read.
+                do {
+                    IoBlock = CxPlatBlockPoolAlloc(&DatapathPartition->RecvBlockPool);
+                } while (IoBlock == NULL && ++RetryCount < 10);
+                if (IoBlock == NULL) {
+                    QuicTraceEvent(
+                        AllocFailure,
+                        "Allocation of '%s' failed. (%llu bytes)",
+                        "DATAPATH_RX_IO_BLOCK",
+                        0);
+                    goto Exit;
+                }
 
-            DATAPATH_RX_IO_BLOCK* IoBlock;
-            do {
-                IoBlock = CxPlatPoolAlloc(&DatapathPartition->RecvBlockPool);
-            } while (IoBlock == NULL && ++RetryCount < 10);
-            if (IoBlock == NULL) {
-                QuicTraceEvent(
-                    AllocFailure,
-                    "Allocation of '%s' failed. (%llu bytes)",
-                    "DATAPATH_RX_IO_BLOCK",
-                    0);
-                goto Exit;
+                IoBlocks[i] = IoBlock;
+                IoBlock->OwningPool = &DatapathPartition->RecvBlockPool;
+                IoBlock->Route.State = RouteResolved;
             }
 
-            IoBlocks[i] = IoBlock;
-            IoBlock->OwningPool = &DatapathPartition->RecvBlockPool;
-            IoBlock->Route.State = RouteResolved;
-
             struct msghdr* MsgHdr = &RecvMsgHdr[i].msg_hdr;
             MsgHdr->msg_name = &IoBlock->Route.RemoteAddress;
             MsgHdr->msg_namelen = sizeof(IoBlock->Route.RemoteAddress);
@@ -2020,14 +3212,15 @@ CxPlatSocketReceiveMessages(
             MsgHdr->msg_controllen = sizeof(RecvMsgControl[i].Data);
             MsgHdr->msg_flags = 0;
             RecvIov[i].iov_base = (char*)IoBlock + DatapathPartition->Datapath->RecvBlockBufferOffset;
-            RecvIov[i].iov_len = CXPLAT_SMALL_IO_BUFFER_SIZE;
+            RecvIov[i].iov_len = BufferLength;
         }
 
+        SocketContext->RecvCalls++;
         int Ret =
             recvmmsg(
                 SocketContext->SocketFd,
                 RecvMsgHdr,
-                (int)CXPLAT_MAX_IO_BATCH_SIZE,
+                (int)BatchSize,
                 0,
                 NULL);
         if (Ret < 0) {
@@ -2042,16 +3235,29 @@ CxPlatSocketReceiveMessages(
             break;
         }
 
-        CXPLAT_DBG_ASSERT(Ret <= CXPLAT_MAX_IO_BATCH_SIZE);
+        CXPLAT_DBG_ASSERT(Ret <= BatchSize);
         CxPlatSocketContextRecvComplete(SocketContext, IoBlocks, RecvMsgHdr, Ret);
+        MessageCount += (uint32_t)Ret;
+
+        if (Ret == BatchSize) {
+            //
+            // There's probably more to read, so grow the batch right away.
+            //
+            BatchFilled = TRUE;
+            SocketContext->RecvBatchSize =
+                (uint16_t)CXPLAT_MIN((uint32_t)BatchSize * 2, MaxBatchSize);
+        }
 
     } while (TRUE);
 
 Exit:
 
+    CxPlatSocketContextUpdateRecvBatchSize(
+        SocketContext, MessageCount, BatchFilled, MaxBatchSize);
+
     for (uint32_t i = 0; i < CXPLAT_MAX_IO_BATCH_SIZE; ++i) {
         if (IoBlocks[i]) {
-            CxPlatPoolFree(&DatapathPartition->RecvBlockPool, IoBlocks[i]);
+            CxPlatBlockPoolFree(&DatapathPartition->RecvBlockPool, IoBlocks[i]);
         }
     }
 }
@@ -2071,7 +3277,7 @@ CxPlatSocketReceiveTcpData(
     do {
         uint32_t RetryCount = 0;
         do {
-            IoBlock = CxPlatPoolAlloc(&DatapathPartition->RecvBlockPool);
+            IoBlock = CxPlatBlockPoolAlloc(&DatapathPartition->RecvBlockPool);
         } while (IoBlock == NULL && ++RetryCount < 10);
         if (IoBlock == NULL) {
             QuicTraceEvent(
@@ -2135,7 +3341,7 @@ CxPlatSocketReceiveTcpData(
 
 Exit:
     if (IoBlock) {
-        CxPlatPoolFree(&DatapathPartition->RecvBlockPool, IoBlock);
+        CxPlatBlockPoolFree(&DatapathPartition->RecvBlockPool, IoBlock);
     }
 }
 
@@ -2145,11 +3351,7 @@ CxPlatSocketReceive(
     )
 {
     if (SocketContext->Binding->Type == CXPLAT_SOCKET_UDP) {
-        if (SocketContext->DatapathPartition->Datapath->Features & CXPLAT_DATAPATH_FEATURE_RECV_COALESCING) {
-            CxPlatSocketReceiveCoalesced(SocketContext);
-        } else {
-            CxPlatSocketReceiveMessages(SocketContext);
-        }
+        CxPlatSocketReceiveMessages(SocketContext);
     } else {
         CxPlatSocketReceiveTcpData(SocketContext);
     }
@@ -2166,7 +3368,7 @@ RecvDataReturn(
         DATAPATH_RX_PACKET* Packet =
             CXPLAT_CONTAINING_RECORD(Datagram, DATAPATH_RX_PACKET, Data);
         if (InterlockedDecrement(&Packet->IoBlock->RefCount) == 0) {
-            CxPlatPoolFree(Packet->IoBlock->OwningPool, Packet->IoBlock);
+            CxPlatBlockPoolFree(Packet->IoBlock->OwningPool, Packet->IoBlock);
         }
     }
 }
@@ -2192,7 +3394,7 @@ SendDataAlloc(
     CXPLAT_SOCKET_CONTEXT* SocketContext = Config->Route->Queue;
     CXPLAT_DBG_ASSERT(SocketContext->Binding == Socket);
     CXPLAT_DBG_ASSERT(SocketContext->Binding->Datapath == SocketContext->DatapathPartition->Datapath);
-    CXPLAT_SEND_DATA* SendData = CxPlatPoolAlloc(&SocketContext->DatapathPartition->SendBlockPool);
+    CXPLAT_SEND_DATA* SendData = CxPlatBlockPoolAlloc(&SocketContext->DatapathPartition->SendBlockPool);
     if (SendData != NULL) {
         SendData->SocketContext = SocketContext;
         SendData->ClientBuffer.Buffer = SendData->Buffer;
@@ -2204,7 +3406,15 @@ SendDataAlloc(
              Socket->Datapath->Features & CXPLAT_DATAPATH_FEATURE_SEND_SEGMENTATION)
                 ? Config->MaxPacketSize : 0;
         SendData->BufferCount = 0;
+        SendData->MaxSegments = DataPathGetMaxSendSegments(Socket->Datapath);
+        if (Config->MaxSegments != 0 && Config->MaxSegments < SendData->MaxSegments) {
+            SendData->MaxSegments = Config->MaxSegments;
+        }
         SendData->AlreadySentCount = 0;
+        SendData->ZeroCopyRefCount = 0;
+        SendData->TxTime =
+            (Socket->Datapath->Features & CXPLAT_DATAPATH_FEATURE_SEND_TXTIME) ?
+                Config->TxTime : 0;
         SendData->ControlBufferLength = 0;
         SendData->ECN = Config->ECN;
         SendData->Flags = Config->Flags;
@@ -2225,7 +3435,15 @@ SendDataFree(
     _In_ CXPLAT_SEND_DATA* SendData
     )
 {
-    CxPlatPoolFree(&SendData->SocketContext->DatapathPartition->SendBlockPool, SendData);
+    //
+    // Zerocopy sends can't be returned to the pool until both the sender and
+    // the kernel are done with the buffers.
+    //
+    if (SendData->ZeroCopyRefCount != 0 &&
+        InterlockedDecrement(&SendData->ZeroCopyRefCount) != 0) {
+        return;
+    }
+    CxPlatBlockPoolFree(&SendData->SocketContext->DatapathPartition->SendBlockPool, SendData);
 }
 
 static
@@ -2247,7 +3465,8 @@ CxPlatSendDataFinalizeSendBuffer(
         SendData->Iovs[0].iov_len += SendData->ClientBuffer.Length;
         if (SendData->SegmentSize == 0 ||
             SendData->ClientBuffer.Length < SendData->SegmentSize ||
-            SendData->TotalSize + SendData->SegmentSize > sizeof(SendData->Buffer)) {
+            SendData->TotalSize + SendData->SegmentSize > sizeof(SendData->Buffer) ||
+            SendData->BufferCount == SendData->MaxSegments) {
             SendData->ClientBuffer.Buffer = NULL;
         } else {
             SendData->ClientBuffer.Buffer += SendData->SegmentSize;
@@ -2257,7 +3476,7 @@ CxPlatSendDataFinalizeSendBuffer(
         IoVec->iov_base = SendData->ClientBuffer.Buffer;
         IoVec->iov_len = SendData->ClientBuffer.Length;
         if (SendData->TotalSize + SendData->SegmentSize > sizeof(SendData->Buffer) ||
-            SendData->BufferCount == SendData->SocketContext->DatapathPartition->Datapath->SendIoVecCount) {
+            SendData->BufferCount == SendData->MaxSegments) {
             SendData->ClientBuffer.Buffer = NULL;
         } else {
             SendData->ClientBuffer.Buffer += SendData->ClientBuffer.Length;
@@ -2356,6 +3575,8 @@ SocketSend(
     CXPLAT_SOCKET_CONTEXT* SocketContext = SendData->SocketContext;
     CxPlatLockAcquire(&SocketContext->TxQueueLock);
     if (/*SendData->Flags & CXPLAT_SEND_FLAGS_MAX_THROUGHPUT ||*/
+        SocketContext->UseIoUring || // Always batched up on the worker thread.
+        (Socket->Type == CXPLAT_SOCKET_UDP && (SendData->Flags & CXPLAT_SEND_FLAGS_DEFERRED)) ||
         !CxPlatListIsEmpty(&SocketContext->TxQueue)) {
         FlushTxQueue = CxPlatListIsEmpty(&SocketContext->TxQueue);
         CxPlatListInsertTail(&SocketContext->TxQueue, &SendData->TxEntry);
@@ -2457,6 +3678,17 @@ CxPlatSendDataPopulateAncillaryData(
     }
 #endif
 
+#ifdef CXPLAT_DATAPATH_TXTIME
+    if (SendData->TxTime != 0) {
+        Mhdr->msg_controllen += CMSG_SPACE(sizeof(uint64_t));
+        CMsg = CXPLAT_CMSG_NXTHDR(CMsg);
+        CMsg->cmsg_level = SOL_SOCKET;
+        CMsg->cmsg_type = SCM_TXTIME;
+        CMsg->cmsg_len = CMSG_LEN(sizeof(uint64_t));
+        *((uint64_t*)CMSG_DATA(CMsg)) = CxPlatDataPathTxTimeToNs(SendData->TxTime);
+    }
+#endif
+
     CXPLAT_DBG_ASSERT(Mhdr->msg_controllen <= sizeof(SendData->ControlBuffer));
     SendData->ControlBufferLength = (uint8_t)Mhdr->msg_controllen;
 }
@@ -2480,6 +3712,41 @@ CxPlatSendDataSendSegmented(
         msghdr.msg_controllen = SendData->ControlBufferLength;
     }
 
+#ifdef CXPLAT_DATAPATH_ZEROCOPY
+    CXPLAT_SOCKET_CONTEXT* SocketContext = SendData->SocketContext;
+    if (SocketContext->ZeroCopyEnabled &&
+        SendData->TotalSize >= CXPLAT_ZEROCOPY_MIN_SEND_SIZE) {
+        //
+        // The kernel numbers each successful zerocopy send on the socket, so
+        // the sends are serialized to keep our numbering in sync with it.
+        //
+        CxPlatLockAcquire(&SocketContext->ZeroCopyLock);
+        ssize_t Result = sendmsg(SocketContext->SocketFd, &msghdr, MSG_ZEROCOPY);
+        int Error = Result < 0 ? errno : 0;
+        if (Result >= 0) {
+            //
+            // One reference for the caller and one for the kernel, released
+            // once the completion is harvested from the error queue.
+            //
+            SendData->ZeroCopyRefCount = 2;
+            SendData->ZeroCopyId = SocketContext->ZeroCopyNextId++;
+            CxPlatListInsertTail(&SocketContext->ZeroCopyQueue, &SendData->ZeroCopyEntry);
+        }
+        CxPlatLockRelease(&SocketContext->ZeroCopyLock);
+        if (Result >= 0) {
+            return TRUE;
+        }
+        if (Error != ENOBUFS) {
+            errno = Error;
+            return FALSE;
+        }
+        //
+        // Pinning the pages exceeded the socket's optmem limit. Fall back to
+        // a regular copied send.
+        //
+    }
+#endif
+
     if (sendmsg(SendData->SocketContext->SocketFd, &msghdr, 0) < 0) {
         return FALSE;
     }
@@ -2576,6 +3843,43 @@ CxPlatSendDataSendTcp(
     return TRUE;
 }
 
+void
+CxPlatSocketContextProcessSendError(
+    _In_ CXPLAT_SOCKET_CONTEXT* SocketContext,
+    _In_ QUIC_STATUS Status
+    )
+{
+    if (Status == EIO &&
+        SocketContext->Binding->Datapath->Features & CXPLAT_DATAPATH_FEATURE_SEND_SEGMENTATION) {
+        //
+        // EIO generally indicates the GSO isn't supported by the NIC,
+        // so disable segmentation on the datapath globally.
+        //
+        QuicTraceEvent(
+            LibraryError,
+            "[ lib] ERROR, %s.",
+            "Disabling segmentation support globally");
+        SocketContext->Binding->Datapath->Features &=
+            ~CXPLAT_DATAPATH_FEATURE_SEND_SEGMENTATION;
+    }
+
+    //
+    // Unreachable events can sometimes come synchronously.
+    // Send unreachable notification to MsQuic if any related
+    // errors were received.
+    //
+    if (Status == ECONNREFUSED ||
+        Status == EHOSTUNREACH ||
+        Status == ENETUNREACH) {
+        if (!SocketContext->Binding->PcpBinding) {
+            SocketContext->Binding->Datapath->UdpHandlers.Unreachable(
+                SocketContext->Binding,
+                SocketContext->Binding->ClientContext,
+                &SocketContext->Binding->RemoteAddress);
+        }
+    }
+}
+
 QUIC_STATUS
 CxPlatSendDataSend(
     _In_ CXPLAT_SEND_DATA* SendData
@@ -2631,39 +3935,155 @@ CxPlatSendDataSend(
                     "send failed");
             }
 
-            if (Status == EIO &&
-                SocketContext->Binding->Datapath->Features & CXPLAT_DATAPATH_FEATURE_SEND_SEGMENTATION) {
+            CxPlatSocketContextProcessSendError(SocketContext, Status);
+        }
+    }
+
+    return Status;
+}
+
+//
+// Sends the queued UDP send data, across all the connections that queued
+// them, with as few sendmmsg calls as possible. Returns QUIC_STATUS_PENDING
+// if the socket can't take any more right now.
+//
+QUIC_STATUS
+CxPlatSocketContextFlushUdpTxQueue(
+    _In_ CXPLAT_SOCKET_CONTEXT* SocketContext
+    )
+{
+    CXPLAT_SEND_DATA* SendDatas[CXPLAT_MAX_IO_BATCH_SIZE];
+    struct mmsghdr Mhdrs[CXPLAT_MAX_IO_BATCH_SIZE];
+
+    while (TRUE) {
+        //
+        // Grab as many send data from the front of the queue as fit in one
+        // sendmmsg call. New sends are only ever added to the tail.
+        //
+        uint32_t SendDataCount = 0;
+        uint32_t MessageCount = 0;
+        CXPLAT_SEND_DATA* SingleSendData = NULL;
+        CxPlatLockAcquire(&SocketContext->TxQueueLock);
+        for (CXPLAT_LIST_ENTRY* Entry = SocketContext->TxQueue.Flink;
+             Entry != &SocketContext->TxQueue && SendDataCount < ARRAYSIZE(SendDatas);
+             Entry = Entry->Flink) {
+            CXPLAT_SEND_DATA* SendData =
+                CXPLAT_CONTAINING_RECORD(Entry, CXPLAT_SEND_DATA, TxEntry);
+#ifdef CXPLAT_DATAPATH_ZEROCOPY
+            if (SocketContext->ZeroCopyEnabled &&
+                SendData->SegmentationSupported &&
+                SendData->TotalSize >= CXPLAT_ZEROCOPY_MIN_SEND_SIZE) {
                 //
-                // EIO generally indicates the GSO isn't supported by the NIC,
-                // so disable segmentation on the datapath globally.
+                // Zerocopy sends must be made one at a time.
                 //
-                QuicTraceEvent(
-                    LibraryError,
-                    "[ lib] ERROR, %s.",
-                    "Disabling segmentation support globally");
-                SocketContext->Binding->Datapath->Features &=
-                    ~CXPLAT_DATAPATH_FEATURE_SEND_SEGMENTATION;
+                if (SendDataCount == 0) {
+                    SingleSendData = SendData;
+                }
+                break;
+            }
+#endif
+            const uint32_t SendDataMessages =
+                SendData->SegmentationSupported ?
+                    1 : (uint32_t)(SendData->BufferCount - SendData->AlreadySentCount);
+            if (MessageCount + SendDataMessages > ARRAYSIZE(Mhdrs)) {
+                break;
             }
+            SendDatas[SendDataCount++] = SendData;
+            MessageCount += SendDataMessages;
+        }
+        CxPlatLockRelease(&SocketContext->TxQueueLock);
 
-            //
-            // Unreachable events can sometimes come synchronously.
-            // Send unreachable notification to MsQuic if any related
-            // errors were received.
-            //
-            if (Status == ECONNREFUSED ||
-                Status == EHOSTUNREACH ||
-                Status == ENETUNREACH) {
-                if (!SocketContext->Binding->PcpBinding) {
-                    SocketContext->Binding->Datapath->UdpHandlers.Unreachable(
-                        SocketContext->Binding,
-                        SocketContext->Binding->ClientContext,
-                        &SocketContext->Binding->RemoteAddress);
+        uint32_t CompletedCount = 0;
+        if (SingleSendData != NULL) {
+            if (CxPlatSendDataSend(SingleSendData) == QUIC_STATUS_PENDING) {
+                return QUIC_STATUS_PENDING;
+            }
+            SendDatas[0] = SingleSendData;
+            CompletedCount = 1;
+
+        } else if (SendDataCount == 0) {
+            return QUIC_STATUS_SUCCESS;
+
+        } else {
+            uint32_t MessageIndex = 0;
+            for (uint32_t i = 0; i < SendDataCount; ++i) {
+                CXPLAT_SEND_DATA* SendData = SendDatas[i];
+                const uint16_t FirstIov =
+                    SendData->SegmentationSupported ? 0 : SendData->AlreadySentCount;
+                const uint16_t LastIov =
+                    SendData->SegmentationSupported ? 1 : SendData->BufferCount;
+                for (uint16_t j = FirstIov; j < LastIov; ++j) {
+                    struct msghdr* Mhdr = &Mhdrs[MessageIndex++].msg_hdr;
+                    Mhdr->msg_name = (void*)&SendData->RemoteAddress;
+                    Mhdr->msg_namelen = sizeof(SendData->RemoteAddress);
+                    Mhdr->msg_iov = SendData->Iovs + j;
+                    Mhdr->msg_iovlen = 1;
+                    Mhdr->msg_flags = 0;
+                    Mhdr->msg_control = SendData->ControlBuffer;
+                    if (SendData->ControlBufferLength == 0) {
+                        CxPlatSendDataPopulateAncillaryData(SendData, Mhdr);
+                    } else {
+                        Mhdr->msg_controllen = SendData->ControlBufferLength;
+                    }
+                }
+            }
+            CXPLAT_DBG_ASSERT(MessageIndex == MessageCount);
+
+            int SentCount =
+                cxplat_sendmmsg(
+                    SocketContext->SocketFd,
+                    Mhdrs,
+                    (unsigned int)MessageCount,
+                    0);
+            if (SentCount < 0) {
+                if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                    return QUIC_STATUS_PENDING;
+                }
+
+                //
+                // The failure is for the first message, so drop the send data
+                // it belongs to and keep going with the rest.
+                //
+                QUIC_STATUS Status = errno;
+                QuicTraceEvent(
+                    DatapathErrorStatus,
+                    "[data][%p] ERROR, %u, %s.",
+                    SocketContext->Binding,
+                    Status,
+                    "sendmmsg failed");
+                CxPlatSocketContextProcessSendError(SocketContext, Status);
+                CompletedCount = 1;
+
+            } else {
+                //
+                // Messages are sent in order, so complete the send data that
+                // were entirely sent and track the progress on the next one.
+                //
+                uint32_t Remaining = (uint32_t)SentCount;
+                for (; CompletedCount < SendDataCount; ++CompletedCount) {
+                    CXPLAT_SEND_DATA* SendData = SendDatas[CompletedCount];
+                    const uint32_t SendDataMessages =
+                        SendData->SegmentationSupported ?
+                            1 : (uint32_t)(SendData->BufferCount - SendData->AlreadySentCount);
+                    if (Remaining < SendDataMessages) {
+                        SendData->AlreadySentCount += (uint16_t)Remaining;
+                        break;
+                    }
+                    Remaining -= SendDataMessages;
                 }
             }
         }
-    }
 
-    return Status;
+        CxPlatLockAcquire(&SocketContext->TxQueueLock);
+        for (uint32_t i = 0; i < CompletedCount; ++i) {
+            CXPLAT_DBG_ASSERT(SocketContext->TxQueue.Flink == &SendDatas[i]->TxEntry);
+            CxPlatListRemoveHead(&SocketContext->TxQueue);
+        }
+        CxPlatLockRelease(&SocketContext->TxQueueLock);
+        for (uint32_t i = 0; i < CompletedCount; ++i) {
+            CxPlatSendDataFree(SendDatas[i]);
+        }
+    }
 }
 
 //
@@ -2676,6 +4096,17 @@ CxPlatSocketContextFlushTxQueue(
     _In_ BOOLEAN SendAlreadyPending
     )
 {
+    if (SocketContext->Binding->Type == CXPLAT_SOCKET_UDP &&
+        CxPlatSocketContextFlushUdpTxQueue(SocketContext) == QUIC_STATUS_PENDING) {
+        if (!SendAlreadyPending) {
+            //
+            // Add the EPOLLOUT event since we have more pending sends.
+            //
+            CxPlatSocketContextSetEvents(SocketContext, EPOLL_CTL_MOD, EPOLLIN | EPOLLOUT);
+        }
+        return;
+    }
+
     CXPLAT_SEND_DATA* SendData = NULL;
     CxPlatLockAcquire(&SocketContext->TxQueueLock);
     if (!CxPlatListIsEmpty(&SocketContext->TxQueue)) {
@@ -2729,6 +4160,360 @@ CxPlatSocketContextFlushTxQueue(
     }
 }
 
+#ifdef CXPLAT_DATAPATH_IO_URING
+
+//
+// Releases a reference on the socket context for a completed io_uring
+// operation. The final release (only possible after shutdown has started)
+// queues the shutdown SQE to finish the clean up outside of completion
+// processing.
+//
+static
+void
+CxPlatSocketContextUringRelease(
+    _In_ CXPLAT_SOCKET_CONTEXT* SocketContext
+    )
+{
+    if (InterlockedDecrement(&SocketContext->UringRefCount) == 0) {
+        CXPLAT_DBG_ASSERT(SocketContext->UringShutdown);
+        CXPLAT_FRE_ASSERT(
+            CxPlatEventQEnqueue(
+                SocketContext->DatapathPartition->EventQ,
+                &SocketContext->ShutdownSqe.Sqe,
+                &SocketContext->ShutdownSqe));
+    }
+}
+
+//
+// Starts (or finishes) the shutdown of a socket context using io_uring.
+// Returns TRUE if there are no more outstanding operations and the clean up
+// can be completed.
+//
+static
+BOOLEAN
+CxPlatSocketContextUringShutdown(
+    _In_ CXPLAT_SOCKET_CONTEXT* SocketContext
+    )
+{
+    if (SocketContext->UringShutdown) {
+        CXPLAT_DBG_ASSERT(SocketContext->UringRefCount == 0);
+        return TRUE;
+    }
+
+    SocketContext->UringShutdown = TRUE;
+
+    CXPLAT_URING* Uring = SocketContext->DatapathPartition->Uring;
+    CxPlatLockAcquire(&Uring->SqLock);
+    struct io_uring_sqe* Sqe = CxPlatUringGetSqe(Uring);
+    if (Sqe != NULL) {
+        Sqe->opcode = IORING_OP_ASYNC_CANCEL;
+        Sqe->fd = -1;
+        Sqe->addr = (uint64_t)(uintptr_t)SocketContext | CXPLAT_URING_OP_RECV;
+        Sqe->user_data = (uint64_t)(uintptr_t)SocketContext | CXPLAT_URING_OP_CANCEL;
+        InterlockedIncrement(&SocketContext->UringRefCount);
+        CxPlatUringSubmit(Uring);
+    }
+    CxPlatLockRelease(&Uring->SqLock);
+
+    if (Sqe == NULL) {
+        //
+        // The submission queue is still full after trying to submit it, so
+        // the cancel can't be queued. Cancel the receive synchronously
+        // instead (support was verified when the ring was created); its final
+        // completion still releases the receive's reference as usual.
+        //
+        struct io_uring_sync_cancel_reg CancelReg;
+        CxPlatZeroMemory(&CancelReg, sizeof(CancelReg));
+        CancelReg.addr = (uint64_t)(uintptr_t)SocketContext | CXPLAT_URING_OP_RECV;
+        CancelReg.fd = -1;
+        CancelReg.timeout.tv_sec = -1;
+        CancelReg.timeout.tv_nsec = -1;
+        int Ret;
+        do {
+            Ret = CxPlatUringRegister(Uring->Fd, IORING_REGISTER_SYNC_CANCEL, &CancelReg, 1);
+        } while (Ret < 0 && errno == EINTR);
+        if (Ret < 0 && errno != ENOENT) {
+            QuicTraceEvent(
+                LibraryErrorStatus,
+                "[ lib] ERROR, %u, %s.",
+                errno,
+                "io_uring synchronous cancel failed");
+        }
+    }
+
+    //
+    // Release the socket's own reference. Any outstanding sends complete on
+    // their own, while the receive completes due to the cancellation.
+    //
+    return InterlockedDecrement(&SocketContext->UringRefCount) == 0;
+}
+
+static
+struct msghdr*
+CxPlatSendDataUringMsgHdrs(
+    _In_ CXPLAT_SEND_DATA* SendData
+    )
+{
+    return (struct msghdr*)
+        (SendData->Iovs + SendData->SocketContext->DatapathPartition->Datapath->SendIoVecCount);
+}
+
+//
+// Submits all queued sends on the socket context in a single batch.
+//
+static
+void
+CxPlatSocketContextUringFlushTxQueue(
+    _In_ CXPLAT_SOCKET_CONTEXT* SocketContext
+    )
+{
+    CXPLAT_URING* Uring = SocketContext->DatapathPartition->Uring;
+    CXPLAT_LIST_ENTRY TxQueue;
+    CxPlatListInitializeHead(&TxQueue);
+
+    CxPlatLockAcquire(&SocketContext->TxQueueLock);
+    CxPlatListMoveItems(&SocketContext->TxQueue, &TxQueue);
+    CxPlatLockRelease(&SocketContext->TxQueueLock);
+
+    CxPlatLockAcquire(&Uring->SqLock);
+    while (!CxPlatListIsEmpty(&TxQueue)) {
+        CXPLAT_SEND_DATA* SendData =
+            CXPLAT_CONTAINING_RECORD(
+                CxPlatListRemoveHead(&TxQueue),
+                CXPLAT_SEND_DATA,
+                TxEntry);
+
+        //
+        // With segmentation, the whole send is a single message. Without it,
+        // each buffer is sent as its own message (much like sendmmsg).
+        //
+        const uint16_t MessageCount =
+            SendData->SegmentationSupported ? 1 : SendData->BufferCount;
+        struct msghdr* MsgHdrs = CxPlatSendDataUringMsgHdrs(SendData);
+        SendData->AlreadySentCount = MessageCount;
+
+        for (uint16_t i = 0; i < MessageCount; ++i) {
+            struct msghdr* MsgHdr = &MsgHdrs[i];
+            MsgHdr->msg_name = (void*)&SendData->RemoteAddress;
+            MsgHdr->msg_namelen = sizeof(SendData->RemoteAddress);
+            MsgHdr->msg_iov = SendData->Iovs + i;
+            MsgHdr->msg_iovlen = 1;
+            MsgHdr->msg_flags = 0;
+            MsgHdr->msg_control = SendData->ControlBuffer;
+            if (SendData->ControlBufferLength == 0) {
+                CxPlatSendDataPopulateAncillaryData(SendData, MsgHdr);
+            } else {
+                MsgHdr->msg_controllen = SendData->ControlBufferLength;
+            }
+
+            struct io_uring_sqe* Sqe = CxPlatUringGetSqe(Uring);
+            if (Sqe == NULL) {
+                QuicTraceEvent(
+                    DatapathErrorStatus,
+                    "[data][%p] ERROR, %u, %s.",
+                    SocketContext->Binding,
+                    QUIC_STATUS_OUT_OF_MEMORY,
+                    "io_uring submission queue full");
+                SendData->AlreadySentCount -= MessageCount - i;
+                break;
+            }
+
+            Sqe->opcode = IORING_OP_SENDMSG;
+            Sqe->fd = SocketContext->SocketFd;
+            Sqe->addr = (uint64_t)(uintptr_t)MsgHdr;
+            Sqe->len = 1;
+            Sqe->user_data = (uint64_t)(uintptr_t)SendData | CXPLAT_URING_OP_SEND;
+            InterlockedIncrement(&SocketContext->UringRefCount);
+        }
+
+        //
+        // AlreadySentCount tracks the number of outstanding messages; the send
+        // data is freed when the last one completes.
+        //
+        if (SendData->AlreadySentCount == 0) {
+            CxPlatSendDataFree(SendData);
+        }
+    }
+    CxPlatUringSubmit(Uring);
+    CxPlatLockRelease(&Uring->SqLock);
+}
+
+static
+void
+CxPlatSendDataUringComplete(
+    _In_ CXPLAT_SEND_DATA* SendData,
+    _In_ int Result
+    )
+{
+    CXPLAT_SOCKET_CONTEXT* SocketContext = SendData->SocketContext;
+
+    if (Result < 0) {
+        QUIC_STATUS Status = (QUIC_STATUS)-Result;
+        QuicTraceEvent(
+            DatapathErrorStatus,
+            "[data][%p] ERROR, %u, %s.",
+            SocketContext->Binding,
+            Status,
+            "io_uring sendmsg failed");
+        if (CxPlatRundownAcquire(&SocketContext->UpcallRundown)) {
+            CxPlatSocketContextProcessSendError(SocketContext, Status);
+            CxPlatRundownRelease(&SocketContext->UpcallRundown);
+        }
+    }
+
+    CXPLAT_DBG_ASSERT(SendData->AlreadySentCount > 0);
+    if (--SendData->AlreadySentCount == 0) {
+        CxPlatSendDataFree(SendData);
+    }
+
+    CxPlatSocketContextUringRelease(SocketContext);
+}
+
+static
+void
+CxPlatSocketContextUringRecvComplete(
+    _In_ CXPLAT_SOCKET_CONTEXT* SocketContext,
+    _In_ const struct io_uring_cqe* Cqe
+    )
+{
+    CXPLAT_DATAPATH_PARTITION* DatapathPartition = SocketContext->DatapathPartition;
+    CXPLAT_URING* Uring = DatapathPartition->Uring;
+
+    if (Cqe->flags & IORING_CQE_F_BUFFER) {
+        const uint16_t BufferId = (uint16_t)(Cqe->flags >> IORING_CQE_BUFFER_SHIFT);
+        CXPLAT_DBG_ASSERT(BufferId < Uring->BufCount);
+        DATAPATH_RX_IO_BLOCK* IoBlock = Uring->BufBlocks[BufferId];
+        const struct io_uring_recvmsg_out* RecvOut =
+            (struct io_uring_recvmsg_out*)((uint8_t*)IoBlock + Uring->BufOffset);
+
+        if (Cqe->res >= 0 &&
+            RecvOut->payloadlen != 0 &&
+            !(RecvOut->flags & MSG_TRUNC) &&
+            !SocketContext->UringShutdown &&
+            CxPlatRundownAcquire(&SocketContext->UpcallRundown)) {
+
+            //
+            // The block is indicated up to the app, who may hold onto it for
+            // some time, so put a new one in its place in the ring. If that's
+            // not possible, the datagram is dropped and the buffer reused.
+            //
+            DATAPATH_RX_IO_BLOCK* NewIoBlock = CxPlatUringAllocRecvBlock(DatapathPartition);
+            if (NewIoBlock != NULL) {
+                Uring->BufBlocks[BufferId] = NewIoBlock;
+
+                const uint8_t* Name = (const uint8_t*)(RecvOut + 1);
+                CxPlatCopyMemory(
+                    &IoBlock->Route.RemoteAddress,
+                    Name,
+                    CXPLAT_MIN(RecvOut->namelen, sizeof(IoBlock->Route.RemoteAddress)));
+
+                struct mmsghdr RecvMsgHdr;
+                CxPlatZeroMemory(&RecvMsgHdr, sizeof(RecvMsgHdr));
+                RecvMsgHdr.msg_len = RecvOut->payloadlen;
+                RecvMsgHdr.msg_hdr.msg_control = (void*)(Name + CXPLAT_URING_RECV_NAME_LENGTH);
+                RecvMsgHdr.msg_hdr.msg_controllen = RecvOut->controllen;
+                CxPlatSocketContextRecvComplete(SocketContext, &IoBlock, &RecvMsgHdr, 1);
+            }
+
+            CxPlatRundownRelease(&SocketContext->UpcallRundown);
+        }
+
+        CxPlatUringProvideBuffer(Uring, BufferId);
+
+    } else if (Cqe->res < 0 &&
+               Cqe->res != -ENOBUFS &&
+               Cqe->res != -ECANCELED &&
+               !SocketContext->UringShutdown) {
+        const int ErrNum = -Cqe->res;
+        QuicTraceEvent(
+            DatapathErrorStatus,
+            "[data][%p] ERROR, %u, %s.",
+            SocketContext->Binding,
+            ErrNum,
+            "io_uring recvmsg failed");
+
+        //
+        // Send unreachable notification to MsQuic if any related
+        // errors were received.
+        //
+        if ((ErrNum == ECONNREFUSED ||
+             ErrNum == EHOSTUNREACH ||
+             ErrNum == ENETUNREACH) &&
+            !SocketContext->Binding->PcpBinding &&
+            CxPlatRundownAcquire(&SocketContext->UpcallRundown)) {
+            SocketContext->Binding->Datapath->UdpHandlers.Unreachable(
+                SocketContext->Binding,
+                SocketContext->Binding->ClientContext,
+                &SocketContext->Binding->RemoteAddress);
+            CxPlatRundownRelease(&SocketContext->UpcallRundown);
+        }
+    }
+
+    if (!(Cqe->flags & IORING_CQE_F_MORE)) {
+        //
+        // The multishot receive terminated (e.g. due to an error, or running
+        // out of buffers) so it needs to be posted again.
+        //
+        if (!SocketContext->UringShutdown) {
+            CxPlatSocketContextUringStartRecv(SocketContext);
+        }
+        CxPlatSocketContextUringRelease(SocketContext);
+    }
+}
+
+//
+// Processes all the completions in the partition's io_uring.
+//
+void
+CxPlatDataPathUringProcessCompletions(
+    _In_ CXPLAT_URING* Uring
+    )
+{
+    uint32_t Head = *Uring->CqHead;
+    BOOLEAN FlushedOverflow = FALSE;
+
+    do {
+        const uint32_t Tail = __atomic_load_n(Uring->CqTail, __ATOMIC_ACQUIRE);
+        if (Head == Tail) {
+            //
+            // The kernel keeps completions that didn't fit in the CQ on an
+            // overflow list until they are explicitly flushed.
+            //
+            if (FlushedOverflow ||
+                !(__atomic_load_n(Uring->SqFlags, __ATOMIC_RELAXED) & IORING_SQ_CQ_OVERFLOW)) {
+                break;
+            }
+            (void)CxPlatUringEnter(Uring->Fd, 0, 0, IORING_ENTER_GETEVENTS);
+            FlushedOverflow = TRUE;
+            continue;
+        }
+
+        while (Head != Tail) {
+            //
+            // Copy out the completion and free up its slot before processing
+            // it, since processing may generate more completions.
+            //
+            const struct io_uring_cqe Cqe = Uring->Cqes[Head & Uring->CqMask];
+            __atomic_store_n(Uring->CqHead, ++Head, __ATOMIC_RELEASE);
+
+            void* Context = (void*)(uintptr_t)(Cqe.user_data & ~(uint64_t)CXPLAT_URING_OP_MASK);
+            switch (Cqe.user_data & CXPLAT_URING_OP_MASK) {
+            case CXPLAT_URING_OP_RECV:
+                CxPlatSocketContextUringRecvComplete((CXPLAT_SOCKET_CONTEXT*)Context, &Cqe);
+                break;
+            case CXPLAT_URING_OP_SEND:
+                CxPlatSendDataUringComplete((CXPLAT_SEND_DATA*)Context, Cqe.res);
+                break;
+            case CXPLAT_URING_OP_CANCEL:
+                CxPlatSocketContextUringRelease((CXPLAT_SOCKET_CONTEXT*)Context);
+                break;
+            }
+        }
+    } while (TRUE);
+}
+
+#endif // CXPLAT_DATAPATH_IO_URING
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 QUIC_STATUS
 CxPlatSocketGetTcpStatistics(
@@ -2741,6 +4526,170 @@ CxPlatSocketGetTcpStatistics(
     return QUIC_STATUS_NOT_SUPPORTED;
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+CxPlatSocketSetTcpTls(
+    _In_ CXPLAT_SOCKET* Socket,
+    _In_ BOOLEAN Send,
+    _In_ CXPLAT_QEO_CIPHER_TYPE CipherType,
+    _In_reads_(32) const uint8_t* Key,
+    _In_reads_(12) const uint8_t* Iv
+    )
+{
+#ifdef CXPLAT_DATAPATH_KTLS
+    if ((Socket->Type != CXPLAT_SOCKET_TCP && Socket->Type != CXPLAT_SOCKET_TCP_SERVER) ||
+        !Socket->Connected) {
+        return QUIC_STATUS_INVALID_STATE;
+    }
+
+    CXPLAT_SOCKET_CONTEXT* SocketContext = &Socket->SocketContexts[0];
+    if (SocketContext->UseIoUring) {
+        return QUIC_STATUS_NOT_SUPPORTED;
+    }
+
+    //
+    // The ULP can only be attached once, so the second direction finds it
+    // already there.
+    //
+    if (setsockopt(SocketContext->SocketFd, SOL_TCP, TCP_ULP, "tls", sizeof("tls")) != 0 &&
+        errno != EEXIST) {
+        int Error = errno;
+        QuicTraceEvent(
+            DatapathErrorStatus,
+            "[data][%p] ERROR, %u, %s.",
+            Socket,
+            Error,
+            "setsockopt(TCP_ULP) failed");
+        return (QUIC_STATUS)Error;
+    }
+
+    union {
+        struct tls12_crypto_info_aes_gcm_128 Aes128;
+        struct tls12_crypto_info_aes_gcm_256 Aes256;
+        struct tls12_crypto_info_chacha20_poly1305 ChaCha20;
+    } Info;
+    socklen_t InfoLength;
+    CxPlatZeroMemory(&Info, sizeof(Info));
+
+    //
+    // AES-GCM takes the IV as a 4 byte salt and the 8 bytes it's XORed with
+    // the record sequence number; ChaCha20-Poly1305 takes all 12 as the IV.
+    //
+    switch (CipherType) {
+    case CXPLAT_QEO_CIPHER_TYPE_AEAD_AES_128_GCM:
+        Info.Aes128.info.version = TLS_1_3_VERSION;
+        Info.Aes128.info.cipher_type = TLS_CIPHER_AES_GCM_128;
+        CxPlatCopyMemory(Info.Aes128.key, Key, sizeof(Info.Aes128.key));
+        CxPlatCopyMemory(Info.Aes128.salt, Iv, sizeof(Info.Aes128.salt));
+        CxPlatCopyMemory(Info.Aes128.iv, Iv + sizeof(Info.Aes128.salt), sizeof(Info.Aes128.iv));
+        InfoLength = sizeof(Info.Aes128);
+        break;
+    case CXPLAT_QEO_CIPHER_TYPE_AEAD_AES_256_GCM:
+        Info.Aes256.info.version = TLS_1_3_VERSION;
+        Info.Aes256.info.cipher_type = TLS_CIPHER_AES_GCM_256;
+        CxPlatCopyMemory(Info.Aes256.key, Key, sizeof(Info.Aes256.key));
+        CxPlatCopyMemory(Info.Aes256.salt, Iv, sizeof(Info.Aes256.salt));
+        CxPlatCopyMemory(Info.Aes256.iv, Iv + sizeof(Info.Aes256.salt), sizeof(Info.Aes256.iv));
+        InfoLength = sizeof(Info.Aes256);
+        break;
+    case CXPLAT_QEO_CIPHER_TYPE_AEAD_CHACHA20_POLY1305:
+        Info.ChaCha20.info.version = TLS_1_3_VERSION;
+        Info.ChaCha20.info.cipher_type = TLS_CIPHER_CHACHA20_POLY1305;
+        CxPlatCopyMemory(Info.ChaCha20.key, Key, sizeof(Info.ChaCha20.key));
+        CxPlatCopyMemory(Info.ChaCha20.iv, Iv, sizeof(Info.ChaCha20.iv));
+        InfoLength = sizeof(Info.ChaCha20);
+        break;
+    default:
+        return QUIC_STATUS_NOT_SUPPORTED;
+    }
+
+    int Result =
+        setsockopt(
+            SocketContext->SocketFd,
+            SOL_TLS,
+            Send ? TLS_TX : TLS_RX,
+            &Info,
+            InfoLength);
+    int Error = errno;
+    CxPlatSecureZeroMemory(&Info, sizeof(Info));
+    if (Result != 0) {
+        QuicTraceEvent(
+            DatapathErrorStatus,
+            "[data][%p] ERROR, %u, %s.",
+            Socket,
+            Error,
+            "setsockopt(TLS_TX/TLS_RX) failed");
+        return (QUIC_STATUS)Error;
+    }
+
+    return QUIC_STATUS_SUCCESS;
+#else
+    UNREFERENCED_PARAMETER(Socket);
+    UNREFERENCED_PARAMETER(Send);
+    UNREFERENCED_PARAMETER(CipherType);
+    UNREFERENCED_PARAMETER(Key);
+    UNREFERENCED_PARAMETER(Iv);
+    return QUIC_STATUS_NOT_SUPPORTED;
+#endif
+}
+
+static
+void
+CxPlatSocketContextAddRecvStatistics(
+    _In_ const CXPLAT_SOCKET_CONTEXT* SocketContext,
+    _Inout_ CXPLAT_UDP_RECV_STATISTICS* Statistics
+    )
+{
+    Statistics->RecvWakeups += SocketContext->RecvWakeups;
+    Statistics->RecvCalls += SocketContext->RecvCalls;
+    Statistics->RecvMessages += SocketContext->RecvMessages;
+    Statistics->RecvMisdirected += SocketContext->RecvMisdirected;
+    Statistics->RecvBatchSize += SocketContext->RecvBatchSize;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+CxPlatSocketGetUdpRecvStatistics(
+    _In_ CXPLAT_SOCKET* Socket,
+    _Out_ CXPLAT_UDP_RECV_STATISTICS* Statistics
+    )
+{
+    if (Socket->Type != CXPLAT_SOCKET_UDP) {
+        return QUIC_STATUS_INVALID_PARAMETER;
+    }
+
+    CxPlatZeroMemory(Statistics, sizeof(*Statistics));
+    for (uint32_t i = 0; i < Socket->SocketCount; ++i) {
+        CxPlatSocketContextAddRecvStatistics(&Socket->SocketContexts[i], Statistics);
+    }
+
+    return QUIC_STATUS_SUCCESS;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+CxPlatSocketGetUdpPartitionRecvStatistics(
+    _In_ CXPLAT_SOCKET* Socket,
+    _In_ uint16_t PartitionIndex,
+    _Out_ CXPLAT_UDP_RECV_STATISTICS* Statistics
+    )
+{
+    if (Socket->Type != CXPLAT_SOCKET_UDP ||
+        PartitionIndex >= Socket->Datapath->PartitionCount) {
+        return QUIC_STATUS_INVALID_PARAMETER;
+    }
+
+    CxPlatZeroMemory(Statistics, sizeof(*Statistics));
+    for (uint32_t i = 0; i < Socket->SocketCount; ++i) {
+        const CXPLAT_SOCKET_CONTEXT* SocketContext = &Socket->SocketContexts[i];
+        if (SocketContext->DatapathPartition->PartitionIndex == PartitionIndex) {
+            CxPlatSocketContextAddRecvStatistics(SocketContext, Statistics);
+        }
+    }
+
+    return QUIC_STATUS_SUCCESS;
+}
+
 void
 CxPlatDataPathSocketProcessIoCompletion(
     _In_ CXPLAT_SOCKET_CONTEXT* SocketContext,
@@ -2779,6 +4728,11 @@ DataPathProcessCqe(
     case CXPLAT_CQE_TYPE_SOCKET_SHUTDOWN: {
         CXPLAT_SOCKET_CONTEXT* SocketContext =
             CXPLAT_CONTAINING_RECORD(CxPlatCqeUserData(Cqe), CXPLAT_SOCKET_CONTEXT, ShutdownSqe);
+#ifdef CXPLAT_DATAPATH_IO_URING
+        if (SocketContext->UseIoUring && !CxPlatSocketContextUringShutdown(SocketContext)) {
+            break; // Completed once all outstanding io_uring operations are done.
+        }
+#endif
         CxPlatSocketContextUninitializeComplete(SocketContext);
         break;
     }
@@ -2791,8 +4745,22 @@ DataPathProcessCqe(
     case CXPLAT_CQE_TYPE_SOCKET_FLUSH_TX: {
         CXPLAT_SOCKET_CONTEXT* SocketContext =
             CXPLAT_CONTAINING_RECORD(CxPlatCqeUserData(Cqe), CXPLAT_SOCKET_CONTEXT, FlushTxSqe);
+#ifdef CXPLAT_DATAPATH_IO_URING
+        if (SocketContext->UseIoUring) {
+            CxPlatSocketContextUringFlushTxQueue(SocketContext);
+            break;
+        }
+#endif
         CxPlatSocketContextFlushTxQueue(SocketContext, FALSE);
         break;
     }
+#ifdef CXPLAT_DATAPATH_IO_URING
+    case CXPLAT_CQE_TYPE_SOCKET_URING: {
+        CXPLAT_URING* Uring =
+            CXPLAT_CONTAINING_RECORD(CxPlatCqeUserData(Cqe), CXPLAT_URING, Sqe);
+        CxPlatDataPathUringProcessCompletions(Uring);
+        break;
+    }
+#endif
     }
 }
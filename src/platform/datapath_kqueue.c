@@ -43,9 +43,46 @@ CXPLAT_STATIC_ASSERT((SIZEOF_STRUCT_MEMBER(QUIC_BUFFER, Length) <= sizeof(size_t
 CXPLAT_STATIC_ASSERT((SIZEOF_STRUCT_MEMBER(QUIC_BUFFER, Buffer) == sizeof(void*)), "(sizeof(QUIC_BUFFER.Buffer) == sizeof(void*) must be TRUE.");
 
 //
-// TODO: Support batching.
+// The maximum number of UDP datagrams that can be sent or received with one
+// batched call.
 //
-#define CXPLAT_MAX_BATCH_SEND 1
+#define CXPLAT_MAX_BATCH_SEND 16
+#define CXPLAT_MAX_BATCH_RECEIVE 16
+
+#if defined(__APPLE__)
+//
+// Darwin supports batched datagram IO via sendmsg_x/recvmsg_x. These are
+// exported by libsystem_kernel but not declared in the public SDK headers.
+// The leading fields match struct msghdr.
+//
+struct msghdr_x {
+    void* msg_name;
+    socklen_t msg_namelen;
+    struct iovec* msg_iov;
+    int msg_iovlen;
+    void* msg_control;
+    socklen_t msg_controllen;
+    int msg_flags;
+    size_t msg_datalen;
+};
+ssize_t recvmsg_x(int s, const struct msghdr_x* msgp, u_int cnt, int flags);
+ssize_t sendmsg_x(int s, const struct msghdr_x* msgp, u_int cnt, int flags);
+
+typedef struct msghdr_x CXPLAT_MMSGHDR;
+#define CXPLAT_MMSGHDR_MSG(Hdr) ((struct msghdr*)(Hdr))
+#define CXPLAT_MMSGHDR_LEN(Hdr) ((Hdr)->msg_datalen)
+#elif defined(__FreeBSD__)
+typedef struct mmsghdr CXPLAT_MMSGHDR;
+#define CXPLAT_MMSGHDR_MSG(Hdr) (&(Hdr)->msg_hdr)
+#define CXPLAT_MMSGHDR_LEN(Hdr) ((Hdr)->msg_len)
+#else
+typedef struct CXPLAT_MMSGHDR {
+    struct msghdr msg_hdr;
+    size_t msg_len;
+} CXPLAT_MMSGHDR;
+#define CXPLAT_MMSGHDR_MSG(Hdr) (&(Hdr)->msg_hdr)
+#define CXPLAT_MMSGHDR_LEN(Hdr) ((Hdr)->msg_len)
+#endif
 
 //
 // The maximum single buffer size for sending coalesced payloads.
@@ -123,6 +160,11 @@ typedef struct CXPLAT_SEND_DATA {
     //
     uint32_t BufferCount;
 
+    //
+    // The maximum number of Buffers the send may use.
+    //
+    uint32_t MaxBufferCount;
+
     //
     // The current index of the Buffers to be sent.
     //
@@ -183,26 +225,27 @@ typedef struct QUIC_CACHEALIGN CXPLAT_SOCKET_CONTEXT {
     uint32_t IoCqeType;
 
     //
-    // The I/O vector for receive datagrams.
+    // The I/O vectors for receive datagrams.
     //
-    struct iovec RecvIov;
+    struct iovec RecvIov[CXPLAT_MAX_BATCH_RECEIVE];
 
     //
-    // The control buffer used in RecvMsgHdr.
+    // The control buffers used in RecvMsgHdr.
     //
-    char RecvMsgControl[CMSG_SPACE(sizeof(struct in6_pktinfo)) +
+    char RecvMsgControl[CXPLAT_MAX_BATCH_RECEIVE]
+                       [CMSG_SPACE(sizeof(struct in6_pktinfo)) +
                         CMSG_SPACE(sizeof(struct in_pktinfo)) +
                         2 * CMSG_SPACE(sizeof(int))];
 
     //
-    // The buffer used to receive msg headers on socket.
+    // The buffers used to receive msg headers on socket.
     //
-    struct msghdr RecvMsgHdr;
+    CXPLAT_MMSGHDR RecvMsgHdr[CXPLAT_MAX_BATCH_RECEIVE];
 
     //
-    // The receive block currently being used for receives on this socket.
+    // The receive blocks currently being used for receives on this socket.
     //
-    DATAPATH_RX_IO_BLOCK* CurrentRecvBlock;
+    DATAPATH_RX_IO_BLOCK* CurrentRecvBlocks[CXPLAT_MAX_BATCH_RECEIVE];
 
     //
     // The head of list containg all pending sends on this socket.
@@ -580,6 +623,30 @@ CxPlatDataPathGetSupportedFeatures(
     return Datapath->Features;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint16_t
+CxPlatDataPathGetMaxSendSegments(
+    _In_ CXPLAT_DATAPATH* Datapath
+    )
+{
+    UNREFERENCED_PARAMETER(Datapath);
+    return CXPLAT_MAX_BATCH_SEND;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+uint32_t
+CxPlatDataPathGetQueueStatistics(
+    _In_ CXPLAT_DATAPATH* Datapath,
+    _Out_writes_opt_(Capacity) QUIC_DATAPATH_QUEUE_STATISTICS* Statistics,
+    _In_ uint32_t Capacity
+    )
+{
+    UNREFERENCED_PARAMETER(Datapath);
+    UNREFERENCED_PARAMETER(Statistics);
+    UNREFERENCED_PARAMETER(Capacity);
+    return 0;
+}
+
 BOOLEAN
 CxPlatDataPathIsPaddingPreferred(
     _In_ CXPLAT_DATAPATH* Datapath,
@@ -969,8 +1036,10 @@ CxPlatSocketContextUninitializeComplete(
     SocketContext->Freed = TRUE;
 #endif
 
-    if (SocketContext->CurrentRecvBlock != NULL) {
-        CxPlatRecvDataReturn(&SocketContext->CurrentRecvBlock->RecvPacket);
+    for (uint32_t i = 0; i < CXPLAT_MAX_BATCH_RECEIVE; ++i) {
+        if (SocketContext->CurrentRecvBlocks[i] != NULL) {
+            CxPlatRecvDataReturn(&SocketContext->CurrentRecvBlocks[i]->RecvPacket);
+        }
     }
 
     while (!CxPlatListIsEmpty(&SocketContext->PendingSendDataHead)) {
@@ -1026,39 +1095,95 @@ CxPlatSocketContextUninitialize(
     }
 }
 
-QUIC_STATUS
-CxPlatSocketContextPrepareReceive(
-    _In_ CXPLAT_SOCKET_CONTEXT* SocketContext
+//
+// Receives up to Count datagrams with a single call where supported. Returns
+// the number of datagrams received, or -1 (with errno set) on failure.
+//
+int
+CxPlatSocketReceiveMessages(
+    _In_ int SocketFd,
+    _Inout_updates_(Count) CXPLAT_MMSGHDR* MsgHdrs,
+    _In_ uint32_t Count
     )
 {
-    if (SocketContext->CurrentRecvBlock == NULL) {
-        SocketContext->CurrentRecvBlock =
-            CxPlatDataPathAllocRxIoBlock(SocketContext->DatapathPartition);
-        if (SocketContext->CurrentRecvBlock == NULL) {
-            QuicTraceEvent(
-                AllocFailure,
-                "Allocation of '%s' failed. (%llu bytes)",
-                "DATAPATH_RX_IO_BLOCK",
-                0);
-            return QUIC_STATUS_OUT_OF_MEMORY;
-        }
+#if defined(__APPLE__)
+    return (int)recvmsg_x(SocketFd, MsgHdrs, Count, 0);
+#elif defined(__FreeBSD__)
+    return (int)recvmmsg(SocketFd, MsgHdrs, Count, 0, NULL);
+#else
+    UNREFERENCED_PARAMETER(Count);
+    ssize_t Ret = recvmsg(SocketFd, &MsgHdrs[0].msg_hdr, 0);
+    if (Ret < 0) {
+        return -1;
     }
+    MsgHdrs[0].msg_len = (size_t)Ret;
+    return 1;
+#endif
+}
 
-    SocketContext->RecvIov.iov_base = SocketContext->CurrentRecvBlock->RecvPacket.Buffer;
-    SocketContext->CurrentRecvBlock->RecvPacket.Next = NULL;
-    SocketContext->CurrentRecvBlock->RecvPacket.BufferLength = SocketContext->RecvIov.iov_len;
-    SocketContext->CurrentRecvBlock->RecvPacket.Route = &SocketContext->CurrentRecvBlock->Route;
+//
+// Sends up to Count datagrams with a single call where supported. Returns
+// the number of datagrams sent, or -1 (with errno set) if none could be sent.
+//
+int
+CxPlatSocketSendMessages(
+    _In_ int SocketFd,
+    _In_reads_(Count) CXPLAT_MMSGHDR* MsgHdrs,
+    _In_ uint32_t Count
+    )
+{
+#if defined(__APPLE__)
+    return (int)sendmsg_x(SocketFd, MsgHdrs, Count, 0);
+#elif defined(__FreeBSD__)
+    return (int)sendmmsg(SocketFd, MsgHdrs, Count, 0);
+#else
+    uint32_t i = 0;
+    for (; i < Count; ++i) {
+        if (sendmsg(SocketFd, &MsgHdrs[i].msg_hdr, 0) < 0) {
+            break;
+        }
+    }
+    return i == 0 ? -1 : (int)i;
+#endif
+}
 
+QUIC_STATUS
+CxPlatSocketContextPrepareReceive(
+    _In_ CXPLAT_SOCKET_CONTEXT* SocketContext
+    )
+{
     CxPlatZeroMemory(&SocketContext->RecvMsgHdr, sizeof(SocketContext->RecvMsgHdr));
     CxPlatZeroMemory(&SocketContext->RecvMsgControl, sizeof(SocketContext->RecvMsgControl));
 
-    SocketContext->RecvMsgHdr.msg_name = &SocketContext->CurrentRecvBlock->RecvPacket.Route->RemoteAddress;
-    SocketContext->RecvMsgHdr.msg_namelen = sizeof(SocketContext->CurrentRecvBlock->RecvPacket.Route->RemoteAddress);
-    SocketContext->RecvMsgHdr.msg_iov = &SocketContext->RecvIov;
-    SocketContext->RecvMsgHdr.msg_iovlen = 1;
-    SocketContext->RecvMsgHdr.msg_control = SocketContext->RecvMsgControl;
-    SocketContext->RecvMsgHdr.msg_controllen = sizeof(SocketContext->RecvMsgControl);
-    SocketContext->RecvMsgHdr.msg_flags = 0;
+    for (uint32_t i = 0; i < CXPLAT_MAX_BATCH_RECEIVE; ++i) {
+        if (SocketContext->CurrentRecvBlocks[i] == NULL) {
+            SocketContext->CurrentRecvBlocks[i] =
+                CxPlatDataPathAllocRxIoBlock(SocketContext->DatapathPartition);
+            if (SocketContext->CurrentRecvBlocks[i] == NULL) {
+                QuicTraceEvent(
+                    AllocFailure,
+                    "Allocation of '%s' failed. (%llu bytes)",
+                    "DATAPATH_RX_IO_BLOCK",
+                    0);
+                return QUIC_STATUS_OUT_OF_MEMORY;
+            }
+        }
+
+        DATAPATH_RX_IO_BLOCK* IoBlock = SocketContext->CurrentRecvBlocks[i];
+        SocketContext->RecvIov[i].iov_base = IoBlock->RecvPacket.Buffer;
+        IoBlock->RecvPacket.Next = NULL;
+        IoBlock->RecvPacket.BufferLength = SocketContext->RecvIov[i].iov_len;
+        IoBlock->RecvPacket.Route = &IoBlock->Route;
+
+        struct msghdr* MsgHdr = CXPLAT_MMSGHDR_MSG(&SocketContext->RecvMsgHdr[i]);
+        MsgHdr->msg_name = &IoBlock->RecvPacket.Route->RemoteAddress;
+        MsgHdr->msg_namelen = sizeof(IoBlock->RecvPacket.Route->RemoteAddress);
+        MsgHdr->msg_iov = &SocketContext->RecvIov[i];
+        MsgHdr->msg_iovlen = 1;
+        MsgHdr->msg_control = SocketContext->RecvMsgControl[i];
+        MsgHdr->msg_controllen = sizeof(SocketContext->RecvMsgControl[i]);
+        MsgHdr->msg_flags = 0;
+    }
 
     return QUIC_STATUS_SUCCESS;
 }
@@ -1103,116 +1228,128 @@ Error:
 void
 CxPlatSocketContextRecvComplete(
     _In_ CXPLAT_SOCKET_CONTEXT* SocketContext,
-    _In_ ssize_t BytesTransferred
+    _In_ uint32_t MessageCount
     )
 {
     QUIC_STATUS Status = QUIC_STATUS_SUCCESS; // cppcheck-suppress unreadVariable
+    CXPLAT_RECV_DATA* RecvDataChain = NULL;
+    CXPLAT_RECV_DATA** RecvDataChainTail = &RecvDataChain;
+
+    CXPLAT_DBG_ASSERT(MessageCount <= CXPLAT_MAX_BATCH_RECEIVE);
+    for (uint32_t i = 0; i < MessageCount; ++i) {
+        CXPLAT_DBG_ASSERT(SocketContext->CurrentRecvBlocks[i] != NULL);
+        CXPLAT_RECV_DATA* RecvPacket = &SocketContext->CurrentRecvBlocks[i]->RecvPacket;
+        SocketContext->CurrentRecvBlocks[i] = NULL;
+        struct msghdr* MsgHdr = CXPLAT_MMSGHDR_MSG(&SocketContext->RecvMsgHdr[i]);
+        const size_t BytesTransferred = CXPLAT_MMSGHDR_LEN(&SocketContext->RecvMsgHdr[i]);
+
+        BOOLEAN FoundLocalAddr = FALSE; // cppcheck-suppress unreadVariable
+        BOOLEAN FoundTOS = FALSE; // cppcheck-suppress unreadVariable
+        BOOLEAN FoundIfIdx = FALSE; // cppcheck-suppress unreadVariable
+        QUIC_ADDR* LocalAddr = &RecvPacket->Route->LocalAddress;
+        if (LocalAddr->Ipv6.sin6_family == AF_INET6) {
+            LocalAddr->Ipv6.sin6_family = QUIC_ADDRESS_FAMILY_INET6;
+        }
+        QUIC_ADDR* RemoteAddr = &RecvPacket->Route->RemoteAddress;
+        if (RemoteAddr->Ipv6.sin6_family == AF_INET6) {
+            RemoteAddr->Ipv6.sin6_family = QUIC_ADDRESS_FAMILY_INET6;
+            CxPlatConvertFromMappedV6(RemoteAddr, RemoteAddr);
+        }
 
-    CXPLAT_DBG_ASSERT(SocketContext->CurrentRecvBlock != NULL);
-    CXPLAT_RECV_DATA* RecvPacket = &SocketContext->CurrentRecvBlock->RecvPacket;
-    SocketContext->CurrentRecvBlock = NULL;
-
-    BOOLEAN FoundLocalAddr = FALSE; // cppcheck-suppress unreadVariable
-    BOOLEAN FoundTOS = FALSE; // cppcheck-suppress unreadVariable
-    BOOLEAN FoundIfIdx = FALSE; // cppcheck-suppress unreadVariable
-    QUIC_ADDR* LocalAddr = &RecvPacket->Route->LocalAddress;
-    if (LocalAddr->Ipv6.sin6_family == AF_INET6) {
-        LocalAddr->Ipv6.sin6_family = QUIC_ADDRESS_FAMILY_INET6;
-    }
-    QUIC_ADDR* RemoteAddr = &RecvPacket->Route->RemoteAddress;
-    if (RemoteAddr->Ipv6.sin6_family == AF_INET6) {
-        RemoteAddr->Ipv6.sin6_family = QUIC_ADDRESS_FAMILY_INET6;
-        CxPlatConvertFromMappedV6(RemoteAddr, RemoteAddr);
-    }
-
-    RecvPacket->Route->Queue = SocketContext;
-    RecvPacket->TypeOfService = 0;
-
-    struct cmsghdr *CMsg;
-    for (CMsg = CMSG_FIRSTHDR(&SocketContext->RecvMsgHdr);
-         CMsg != NULL;
-         CMsg = CMSG_NXTHDR(&SocketContext->RecvMsgHdr, CMsg)) {
-
-        if (CMsg->cmsg_level == IPPROTO_IPV6) {
-            if (CMsg->cmsg_type == IPV6_PKTINFO) {
-                struct in6_pktinfo* PktInfo6 = (struct in6_pktinfo*) CMSG_DATA(CMsg);
-                LocalAddr->Ip.sa_family = QUIC_ADDRESS_FAMILY_INET6;
-                LocalAddr->Ipv6.sin6_addr = PktInfo6->ipi6_addr;
-                LocalAddr->Ipv6.sin6_port = SocketContext->Binding->LocalAddress.Ipv6.sin6_port;
-                CxPlatConvertFromMappedV6(LocalAddr, LocalAddr);
-
-                LocalAddr->Ipv6.sin6_scope_id = PktInfo6->ipi6_ifindex;
-                FoundLocalAddr = TRUE; // cppcheck-suppress unreadVariable
-                FoundIfIdx = TRUE; // cppcheck-suppress unreadVariable
-            } else if (CMsg->cmsg_type == IPV6_TCLASS) {
-                RecvPacket->TypeOfService = *(uint8_t *)CMSG_DATA(CMsg);
-                FoundTOS = TRUE; // cppcheck-suppress unreadVariable
-            }
-        } else if (CMsg->cmsg_level == IPPROTO_IP) {
+        RecvPacket->Route->Queue = SocketContext;
+        RecvPacket->TypeOfService = 0;
+
+        struct cmsghdr *CMsg;
+        for (CMsg = CMSG_FIRSTHDR(MsgHdr);
+             CMsg != NULL;
+             CMsg = CMSG_NXTHDR(MsgHdr, CMsg)) {
+
+            if (CMsg->cmsg_level == IPPROTO_IPV6) {
+                if (CMsg->cmsg_type == IPV6_PKTINFO) {
+                    struct in6_pktinfo* PktInfo6 = (struct in6_pktinfo*) CMSG_DATA(CMsg);
+                    LocalAddr->Ip.sa_family = QUIC_ADDRESS_FAMILY_INET6;
+                    LocalAddr->Ipv6.sin6_addr = PktInfo6->ipi6_addr;
+                    LocalAddr->Ipv6.sin6_port = SocketContext->Binding->LocalAddress.Ipv6.sin6_port;
+                    CxPlatConvertFromMappedV6(LocalAddr, LocalAddr);
+
+                    LocalAddr->Ipv6.sin6_scope_id = PktInfo6->ipi6_ifindex;
+                    FoundLocalAddr = TRUE; // cppcheck-suppress unreadVariable
+                    FoundIfIdx = TRUE; // cppcheck-suppress unreadVariable
+                } else if (CMsg->cmsg_type == IPV6_TCLASS) {
+                    RecvPacket->TypeOfService = *(uint8_t *)CMSG_DATA(CMsg);
+                    FoundTOS = TRUE; // cppcheck-suppress unreadVariable
+                }
+            } else if (CMsg->cmsg_level == IPPROTO_IP) {
 #if defined(IP_PKTINFO)
-            if (CMsg->cmsg_type == IP_PKTINFO) {
-                struct in_pktinfo* PktInfo = (struct in_pktinfo*)CMSG_DATA(CMsg);
-                LocalAddr->Ip.sa_family = QUIC_ADDRESS_FAMILY_INET;
-                LocalAddr->Ipv4.sin_addr = PktInfo->ipi_addr;
-                LocalAddr->Ipv4.sin_port = SocketContext->Binding->LocalAddress.Ipv6.sin6_port;
-                LocalAddr->Ipv6.sin6_scope_id = PktInfo->ipi_ifindex;
-                FoundLocalAddr = TRUE;
-                FoundIfIdx = TRUE;
-            }
+                if (CMsg->cmsg_type == IP_PKTINFO) {
+                    struct in_pktinfo* PktInfo = (struct in_pktinfo*)CMSG_DATA(CMsg);
+                    LocalAddr->Ip.sa_family = QUIC_ADDRESS_FAMILY_INET;
+                    LocalAddr->Ipv4.sin_addr = PktInfo->ipi_addr;
+                    LocalAddr->Ipv4.sin_port = SocketContext->Binding->LocalAddress.Ipv6.sin6_port;
+                    LocalAddr->Ipv6.sin6_scope_id = PktInfo->ipi_ifindex;
+                    FoundLocalAddr = TRUE;
+                    FoundIfIdx = TRUE;
+                }
 #elif defined(IP_RECVDSTADDR)
-            if (CMsg->cmsg_type == IP_RECVDSTADDR) {
-                struct in_addr *Info = (struct in_addr *)CMSG_DATA(CMsg);
-                LocalAddr->Ip.sa_family = QUIC_ADDRESS_FAMILY_INET;
-                LocalAddr->Ipv4.sin_addr = *Info;
-                LocalAddr->Ipv4.sin_port = SocketContext->Binding->LocalAddress.Ipv6.sin6_port;
-                FoundLocalAddr = TRUE;
-            }
+                if (CMsg->cmsg_type == IP_RECVDSTADDR) {
+                    struct in_addr *Info = (struct in_addr *)CMSG_DATA(CMsg);
+                    LocalAddr->Ip.sa_family = QUIC_ADDRESS_FAMILY_INET;
+                    LocalAddr->Ipv4.sin_addr = *Info;
+                    LocalAddr->Ipv4.sin_port = SocketContext->Binding->LocalAddress.Ipv6.sin6_port;
+                    FoundLocalAddr = TRUE;
+                }
 #else
 #error "No socket option specified"
 #endif
 #if defined(IP_RECVDSTADDR) && defined(IP_RECVIF)
-            else if (CMsg->cmsg_type == IP_RECVIF) {
-                struct sockaddr_dl *Info = (struct sockaddr_dl *)CMSG_DATA(CMsg);
-                LocalAddr->Ipv6.sin6_scope_id = Info->sdl_index;
-                FoundIfIdx = TRUE;
-            }
+                else if (CMsg->cmsg_type == IP_RECVIF) {
+                    struct sockaddr_dl *Info = (struct sockaddr_dl *)CMSG_DATA(CMsg);
+                    LocalAddr->Ipv6.sin6_scope_id = Info->sdl_index;
+                    FoundIfIdx = TRUE;
+                }
 #endif
-            else if (CMsg->cmsg_type == IP_TOS || CMsg->cmsg_type == IP_RECVTOS) {
-                RecvPacket->TypeOfService = *(uint8_t *)CMSG_DATA(CMsg);
-                FoundTOS = TRUE; // cppcheck-suppress unreadVariable
+                else if (CMsg->cmsg_type == IP_TOS || CMsg->cmsg_type == IP_RECVTOS) {
+                    RecvPacket->TypeOfService = *(uint8_t *)CMSG_DATA(CMsg);
+                    FoundTOS = TRUE; // cppcheck-suppress unreadVariable
+                }
             }
         }
-    }
 
-    CXPLAT_FRE_ASSERT(FoundLocalAddr);
-    CXPLAT_FRE_ASSERT(FoundTOS);
-    CXPLAT_FRE_ASSERT(FoundIfIdx);
+        CXPLAT_FRE_ASSERT(FoundLocalAddr);
+        CXPLAT_FRE_ASSERT(FoundTOS);
+        CXPLAT_FRE_ASSERT(FoundIfIdx);
 
-    QuicTraceEvent(
-        DatapathRecv,
-        "[data][%p] Recv %u bytes (segment=%hu) Src=%!ADDR! Dst=%!ADDR!",
-        SocketContext->Binding,
-        (uint32_t)BytesTransferred,
-        (uint32_t)BytesTransferred,
-        CASTED_CLOG_BYTEARRAY(sizeof(*LocalAddr), LocalAddr),
-        CASTED_CLOG_BYTEARRAY(sizeof(*RemoteAddr), RemoteAddr));
-
-    CXPLAT_DBG_ASSERT(BytesTransferred <= RecvPacket->BufferLength);
-    RecvPacket->BufferLength = BytesTransferred;
-
-    RecvPacket->PartitionIndex = SocketContext->DatapathPartition->PartitionIndex;
-
-    if (!SocketContext->Binding->PcpBinding) {
-        CXPLAT_DBG_ASSERT(SocketContext->Binding->Datapath->UdpHandlers.Receive);
-        SocketContext->Binding->Datapath->UdpHandlers.Receive(
-            SocketContext->Binding,
-            SocketContext->Binding->ClientContext,
-            RecvPacket);
-    } else {
-        CxPlatPcpRecvCallback(
+        QuicTraceEvent(
+            DatapathRecv,
+            "[data][%p] Recv %u bytes (segment=%hu) Src=%!ADDR! Dst=%!ADDR!",
             SocketContext->Binding,
-            SocketContext->Binding->ClientContext,
-            RecvPacket);
+            (uint32_t)BytesTransferred,
+            (uint32_t)BytesTransferred,
+            CASTED_CLOG_BYTEARRAY(sizeof(*LocalAddr), LocalAddr),
+            CASTED_CLOG_BYTEARRAY(sizeof(*RemoteAddr), RemoteAddr));
+
+        CXPLAT_DBG_ASSERT(BytesTransferred <= RecvPacket->BufferLength);
+        RecvPacket->BufferLength = (uint16_t)BytesTransferred;
+
+        RecvPacket->PartitionIndex = SocketContext->DatapathPartition->PartitionIndex;
+
+        *RecvDataChainTail = RecvPacket;
+        RecvDataChainTail = &RecvPacket->Next;
+    }
+
+    if (RecvDataChain != NULL) {
+        if (!SocketContext->Binding->PcpBinding) {
+            CXPLAT_DBG_ASSERT(SocketContext->Binding->Datapath->UdpHandlers.Receive);
+            SocketContext->Binding->Datapath->UdpHandlers.Receive(
+                SocketContext->Binding,
+                SocketContext->Binding->ClientContext,
+                RecvDataChain);
+        } else {
+            CxPlatPcpRecvCallback(
+                SocketContext->Binding,
+                SocketContext->Binding->ClientContext,
+                RecvDataChain);
+        }
     }
 
     int32_t RetryCount = 0;
@@ -1329,16 +1466,14 @@ CxPlatDataPathSocketProcessIoCompletion(
 
     if (Cqe->filter == EVFILT_READ) {
         //
-        // Read up to 4 receives before moving to another event.
+        // Read up to 4 batches of receives before moving to another event.
         //
         for (int i = 0; i < 4; i++) {
-            CXPLAT_DBG_ASSERT(SocketContext->CurrentRecvBlock != NULL);
-
-            ssize_t Ret =
-                recvmsg(
+            int Ret =
+                CxPlatSocketReceiveMessages(
                     SocketContext->SocketFd,
-                    &SocketContext->RecvMsgHdr,
-                    0);
+                    SocketContext->RecvMsgHdr,
+                    CXPLAT_MAX_BATCH_RECEIVE);
             if (Ret < 0) {
                 int ErrNum = errno;
                 if (ErrNum != EAGAIN && ErrNum != EWOULDBLOCK) {
@@ -1347,7 +1482,7 @@ CxPlatDataPathSocketProcessIoCompletion(
                         "[data][%p] ERROR, %u, %s.",
                         SocketContext->Binding,
                         errno,
-                        "recvmsg failed");
+                        "recvmmsg failed");
 
                     //
                     // The read can also return unreachable events. There is no
@@ -1368,7 +1503,10 @@ CxPlatDataPathSocketProcessIoCompletion(
                 }
                 break;
             }
-            CxPlatSocketContextRecvComplete(SocketContext, Ret);
+            CxPlatSocketContextRecvComplete(SocketContext, (uint32_t)Ret);
+            if (Ret < CXPLAT_MAX_BATCH_RECEIVE) {
+                break; // No more datagrams queued on the socket.
+            }
         }
     }
 
@@ -1436,8 +1574,10 @@ CxPlatSocketCreateUdp(
         Binding->SocketContexts[i].SocketFd = INVALID_SOCKET;
         Binding->SocketContexts[i].ShutdownSqe.CqeType = CXPLAT_CQE_TYPE_SOCKET_SHUTDOWN;
         Binding->SocketContexts[i].IoCqeType = CXPLAT_CQE_TYPE_SOCKET_IO;
-        Binding->SocketContexts[i].RecvIov.iov_len =
-            Binding->Mtu - CXPLAT_MIN_IPV4_HEADER_SIZE - CXPLAT_UDP_HEADER_SIZE;
+        for (uint32_t j = 0; j < CXPLAT_MAX_BATCH_RECEIVE; ++j) {
+            Binding->SocketContexts[i].RecvIov[j].iov_len =
+                Binding->Mtu - CXPLAT_MIN_IPV4_HEADER_SIZE - CXPLAT_UDP_HEADER_SIZE;
+        }
         Binding->SocketContexts[i].DatapathPartition =
             IsServerSocket ?
                 &Datapath->Partitions[i % Datapath->PartitionCount] :
@@ -1453,6 +1593,12 @@ CxPlatSocketCreateUdp(
     }
 
     for (uint32_t i = 0; i < SocketCount; i++) {
+        if (!CxPlatWorkerPoolStartWorker(
+                Datapath->WorkerPool,
+                Binding->SocketContexts[i].DatapathPartition->PartitionIndex)) {
+            Status = QUIC_STATUS_OUT_OF_MEMORY;
+            goto Exit;
+        }
         Status =
             CxPlatSocketContextInitialize(
                 &Binding->SocketContexts[i],
@@ -1637,6 +1783,9 @@ CxPlatSendDataAlloc(
         SendData->SegmentSize =
             (Socket->Datapath->Features & CXPLAT_DATAPATH_FEATURE_SEND_SEGMENTATION)
                 ? Config->MaxPacketSize : 0;
+        SendData->MaxBufferCount =
+            (Config->MaxSegments != 0 && Config->MaxSegments < CXPLAT_MAX_BATCH_SEND) ?
+                Config->MaxSegments : CXPLAT_MAX_BATCH_SEND;
     }
 
     return SendData;
@@ -1690,7 +1839,7 @@ CxPlatSendDataCanAllocSend(
     )
 {
     return
-        (SendData->BufferCount < CXPLAT_MAX_BATCH_SEND) ||
+        (SendData->BufferCount < SendData->MaxBufferCount) ||
         ((SendData->SegmentSize > 0) &&
             CxPlatSendDataCanAllocSendSegment(SendData, MaxBufferLength));
 }
@@ -1917,8 +2066,9 @@ CxPlatSocketSendInternal(
     )
 {
     QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
-    ssize_t SentByteCount = 0;
+    int SentCount = 0;
     QUIC_ADDR MappedRemoteAddress = {0};
+    CXPLAT_MMSGHDR MsgHdrs[CXPLAT_MAX_BATCH_SEND];
     struct cmsghdr *CMsg = NULL;
     struct in_pktinfo *PktInfo = NULL;
     struct in6_pktinfo *PktInfo6 = NULL;
@@ -1975,11 +2125,15 @@ CxPlatSocketSendInternal(
         MappedRemoteAddress.Ipv6.sin6_family = AF_INET6;
     }
 
+    //
+    // All the datagrams share the same addresses and ancillary data, so build
+    // it once and send each buffer as its own datagram.
+    //
     struct msghdr Mhdr = {
         .msg_name = NULL,
         .msg_namelen = 0,
-        .msg_iov = SendData->Iovs,
-        .msg_iovlen = SendData->BufferCount,
+        .msg_iov = NULL,
+        .msg_iovlen = 0,
         .msg_control = ControlBuffer,
         .msg_controllen = CMSG_SPACE(sizeof(int)),
         .msg_flags = 0
@@ -2024,10 +2178,35 @@ CxPlatSocketSendInternal(
         }
     }
 
-    SentByteCount = sendmsg(SocketContext->SocketFd, &Mhdr, 0);
+    CXPLAT_DBG_ASSERT(SendData->CurrentIndex < SendData->BufferCount);
+    const uint32_t MessageCount = SendData->BufferCount - SendData->CurrentIndex;
+    CxPlatZeroMemory(MsgHdrs, MessageCount * sizeof(CXPLAT_MMSGHDR));
+    for (uint32_t i = 0; i < MessageCount; ++i) {
+        struct msghdr* MsgHdr = CXPLAT_MMSGHDR_MSG(&MsgHdrs[i]);
+        *MsgHdr = Mhdr;
+        MsgHdr->msg_iov = &SendData->Iovs[SendData->CurrentIndex + i];
+        MsgHdr->msg_iovlen = 1;
+#if defined(__APPLE__)
+        MsgHdrs[i].msg_datalen = MsgHdr->msg_iov->iov_len;
+#endif
+    }
+
+    SentCount = CxPlatSocketSendMessages(SocketContext->SocketFd, MsgHdrs, MessageCount);
 
-    if (SentByteCount < 0) {
-        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+    BOOLEAN WouldBlock = FALSE;
+    if (SentCount >= 0 && (uint32_t)SentCount < MessageCount) {
+        //
+        // Only some of the datagrams were sent. Track the progress and wait
+        // for the socket to be writable to send the rest.
+        //
+        SendData->CurrentIndex += (uint32_t)SentCount;
+        WouldBlock = TRUE;
+    } else if (SentCount < 0) {
+        WouldBlock = errno == EAGAIN || errno == EWOULDBLOCK;
+    }
+
+    if (SentCount < 0 || WouldBlock) {
+        if (WouldBlock) {
             if (!IsPendedSend) {
                 CxPlatLockAcquire(&SocketContext->PendingSendDataLock);
                 CxPlatSocketContextPendSend(
@@ -2048,7 +2227,7 @@ CxPlatSocketSendInternal(
                     NULL,
                     0,
                     NULL);
-            if (Ret < 1) {
+            if (Ret < 0) {
                 Status = errno;
                 QuicTraceEvent(
                     DatapathErrorStatus,
@@ -2067,7 +2246,7 @@ CxPlatSocketSendInternal(
                 "[data][%p] ERROR, %u, %s.",
                 SocketContext->Binding,
                 Status,
-                "sendmsg failed");
+                "sendmmsg failed");
 
             //
             // Unreachable events can sometimes come synchronously.
@@ -2138,6 +2317,50 @@ CxPlatSocketGetTcpStatistics(
     return QUIC_STATUS_NOT_SUPPORTED;
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+CxPlatSocketSetTcpTls(
+    _In_ CXPLAT_SOCKET* Socket,
+    _In_ BOOLEAN Send,
+    _In_ CXPLAT_QEO_CIPHER_TYPE CipherType,
+    _In_reads_(32) const uint8_t* Key,
+    _In_reads_(12) const uint8_t* Iv
+    )
+{
+    UNREFERENCED_PARAMETER(Socket);
+    UNREFERENCED_PARAMETER(Send);
+    UNREFERENCED_PARAMETER(CipherType);
+    UNREFERENCED_PARAMETER(Key);
+    UNREFERENCED_PARAMETER(Iv);
+    return QUIC_STATUS_NOT_SUPPORTED;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+CxPlatSocketGetUdpRecvStatistics(
+    _In_ CXPLAT_SOCKET* Socket,
+    _Out_ CXPLAT_UDP_RECV_STATISTICS* Statistics
+    )
+{
+    UNREFERENCED_PARAMETER(Socket);
+    UNREFERENCED_PARAMETER(Statistics);
+    return QUIC_STATUS_NOT_SUPPORTED;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+CxPlatSocketGetUdpPartitionRecvStatistics(
+    _In_ CXPLAT_SOCKET* Socket,
+    _In_ uint16_t PartitionIndex,
+    _Out_ CXPLAT_UDP_RECV_STATISTICS* Statistics
+    )
+{
+    UNREFERENCED_PARAMETER(Socket);
+    UNREFERENCED_PARAMETER(PartitionIndex);
+    UNREFERENCED_PARAMETER(Statistics);
+    return QUIC_STATUS_NOT_SUPPORTED;
+}
+
 void
 CxPlatDataPathProcessCqe(
     _In_ CXPLAT_CQE* Cqe
@@ -15,6 +15,7 @@ Abstract:
 #include "datapath_linux.c.clog.h"
 #endif
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
 QUIC_STATUS
 CxPlatSocketUpdateQeo(
     _In_ CXPLAT_SOCKET* Socket,
@@ -23,9 +24,10 @@ CxPlatSocketUpdateQeo(
     _In_ uint32_t OffloadCount
     )
 {
-    UNREFERENCED_PARAMETER(Socket);
-    UNREFERENCED_PARAMETER(Offloads);
-    UNREFERENCED_PARAMETER(OffloadCount);
+    if (Socket->UseTcp || (Socket->RawSocketAvailable &&
+        !IS_LOOPBACK(Offloads[0].Address))) {
+        return RawSocketUpdateQeo(CxPlatSocketToRaw(Socket), Offloads, OffloadCount);
+    }
     return QUIC_STATUS_NOT_SUPPORTED;
 }
 
@@ -34,7 +36,8 @@ CxPlatDataPathProcessCqe(
     _In_ CXPLAT_CQE* Cqe
     )
 {
-    if (CXPLAT_CQE_TYPE_XDP_SHUTDOWN <= CxPlatCqeType(Cqe)) {
+    if (CXPLAT_CQE_TYPE_XDP_SHUTDOWN <= CxPlatCqeType(Cqe) &&
+        CxPlatCqeType(Cqe) <= CXPLAT_CQE_TYPE_XDP_FLUSH_TX) {
         RawDataPathProcessCqe(Cqe);
     } else {
         DataPathProcessCqe(Cqe);
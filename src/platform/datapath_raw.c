@@ -59,6 +59,8 @@ RawDataPathInitialize(
         DataPath->UseTcp = TRUE;
     }
 
+    CxPlatFramingChecksumInitialize();
+
     if (!CxPlatSockPoolInitialize(&DataPath->SocketPool)) {
         Status = QUIC_STATUS_OUT_OF_MEMORY;
         goto Error;
@@ -153,6 +155,17 @@ RawDataPathGetSupportedFeatures(
     return CXPLAT_DATAPATH_FEATURE_RAW;
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+uint32_t
+RawDataPathGetQueueStatistics(
+    _In_ CXPLAT_DATAPATH_RAW* Datapath,
+    _Out_writes_opt_(Capacity) QUIC_DATAPATH_QUEUE_STATISTICS* Statistics,
+    _In_ uint32_t Capacity
+    )
+{
+    return CxPlatDpRawGetQueueStatistics(Datapath, Statistics, Capacity);
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 BOOLEAN
 RawDataPathIsPaddingPreferred(
@@ -210,11 +223,86 @@ RawSocketGetLocalMtu(
 
 }
 
+//
+// Chains all of Socket's data packets in the batch, starting with the first,
+// onto the first packet. Packets of the same 4-tuple are kept together and in
+// order, and the chained packets are removed (set to NULL) from the batch.
+// Gathering stops at the first of the socket's control packets (e.g. TCP FIN)
+// so they stay ordered after the data before them.
+//
+static
+void
+CxPlatDpRawRxCoalesce(
+    _In_ CXPLAT_SOCKET_RAW* Socket,
+    _Inout_updates_(PacketCount)
+        CXPLAT_RECV_DATA** Packets,
+    _In_ uint16_t PacketCount
+    )
+{
+    const uint8_t SocketType = Socket->UseTcp ? L4_TYPE_TCP : L4_TYPE_UDP;
+    CXPLAT_RECV_DATA** Tail = &Packets[0]->Next;
+    CXPLAT_RECV_DATA* FlowHead = Packets[0];
+    Packets[0] = NULL;
+
+    while (FlowHead != NULL) {
+        CXPLAT_RECV_DATA* NextFlowHead = NULL;
+        uint16_t NextFlowHeadIndex = 0;
+
+        QuicTraceEvent(
+            DatapathRecv,
+            "[data][%p] Recv %u bytes (segment=%hu) Src=%!ADDR! Dst=%!ADDR!",
+            Socket,
+            FlowHead->BufferLength,
+            FlowHead->BufferLength,
+            CASTED_CLOG_BYTEARRAY(sizeof(FlowHead->Route->LocalAddress), &FlowHead->Route->LocalAddress),
+            CASTED_CLOG_BYTEARRAY(sizeof(FlowHead->Route->RemoteAddress), &FlowHead->Route->RemoteAddress));
+
+        for (uint16_t i = 1; i < PacketCount; i++) {
+            CXPLAT_RECV_DATA* Packet = Packets[i];
+            if (Packet == NULL ||
+                Packet->Reserved < L4_TYPE_UDP ||
+                Packet->Route->LocalAddress.Ipv4.sin_port != Socket->LocalAddress.Ipv4.sin_port ||
+                !CxPlatSocketCompare(Socket, &Packet->Route->LocalAddress, &Packet->Route->RemoteAddress)) {
+                continue; // Not for this socket.
+            }
+            if (Packet->Reserved != SocketType) {
+                break;
+            }
+            CXPLAT_DBG_ASSERT(Packet->Next == NULL);
+
+            if (QuicAddrCompare(&Packet->Route->RemoteAddress, &FlowHead->Route->RemoteAddress) &&
+                QuicAddrCompareIp(&Packet->Route->LocalAddress, &FlowHead->Route->LocalAddress)) {
+                QuicTraceEvent(
+                    DatapathRecv,
+                    "[data][%p] Recv %u bytes (segment=%hu) Src=%!ADDR! Dst=%!ADDR!",
+                    Socket,
+                    Packet->BufferLength,
+                    Packet->BufferLength,
+                    CASTED_CLOG_BYTEARRAY(sizeof(Packet->Route->LocalAddress), &Packet->Route->LocalAddress),
+                    CASTED_CLOG_BYTEARRAY(sizeof(Packet->Route->RemoteAddress), &Packet->Route->RemoteAddress));
+                *Tail = Packet;
+                Tail = &Packet->Next;
+                Packets[i] = NULL;
+            } else if (NextFlowHead == NULL) {
+                NextFlowHead = Packet; // Only possible for a wildcard socket.
+                NextFlowHeadIndex = i;
+            }
+        }
+
+        if (NextFlowHead != NULL) {
+            *Tail = NextFlowHead;
+            Tail = &NextFlowHead->Next;
+            Packets[NextFlowHeadIndex] = NULL;
+        }
+        FlowHead = NextFlowHead;
+    }
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 void
 CxPlatDpRawRxEthernet(
     _In_ const CXPLAT_DATAPATH_RAW* Datapath,
-    _In_reads_(PacketCount)
+    _Inout_updates_(PacketCount)
         CXPLAT_RECV_DATA** Packets,
     _In_ uint16_t PacketCount
     )
@@ -222,6 +310,9 @@ CxPlatDpRawRxEthernet(
     for (uint16_t i = 0; i < PacketCount; i++) {
         CXPLAT_SOCKET_RAW* Socket = NULL;
         CXPLAT_RECV_DATA* PacketChain = Packets[i];
+        if (PacketChain == NULL) {
+            continue; // Already delivered in an earlier packet's chain.
+        }
         CXPLAT_DBG_ASSERT(PacketChain->Next == NULL);
 
         if (PacketChain->Reserved >= L4_TYPE_UDP) {
@@ -234,30 +325,13 @@ CxPlatDpRawRxEthernet(
 
         if (Socket) {
             if (PacketChain->Reserved == L4_TYPE_UDP || PacketChain->Reserved == L4_TYPE_TCP) {
-                uint8_t SocketType = Socket->UseTcp ? L4_TYPE_TCP : L4_TYPE_UDP;
-
                 //
-                // Found a match. Chain and deliver contiguous packets with the same 4-tuple.
+                // Found a match. Chain and deliver the socket's packets from
+                // the rest of the batch too, even with other sockets' packets
+                // between them, grouped by 4-tuple so the core looks up each
+                // flow once per batch instead of once per packet.
                 //
-                while (i < PacketCount) {
-                    QuicTraceEvent(
-                        DatapathRecv,
-                        "[data][%p] Recv %u bytes (segment=%hu) Src=%!ADDR! Dst=%!ADDR!",
-                        Socket,
-                        Packets[i]->BufferLength,
-                        Packets[i]->BufferLength,
-                        CASTED_CLOG_BYTEARRAY(sizeof(Packets[i]->Route->LocalAddress), &Packets[i]->Route->LocalAddress),
-                        CASTED_CLOG_BYTEARRAY(sizeof(Packets[i]->Route->RemoteAddress), &Packets[i]->Route->RemoteAddress));
-                    if (i == PacketCount - 1 ||
-                        Packets[i+1]->Reserved != SocketType ||
-                        Packets[i+1]->Route->LocalAddress.Ipv4.sin_port != Socket->LocalAddress.Ipv4.sin_port ||
-                        !CxPlatSocketCompare(Socket, &Packets[i+1]->Route->LocalAddress, &Packets[i+1]->Route->RemoteAddress)) {
-                        break;
-                    }
-                    Packets[i]->Next = Packets[i+1];
-                    CXPLAT_DBG_ASSERT(Packets[i+1]->Next == NULL);
-                    i++;
-                }
+                CxPlatDpRawRxCoalesce(Socket, Packets + i, PacketCount - i);
                 Datapath->ParentDataPath->UdpHandlers.Receive(CxPlatRawToSocket(Socket), Socket->ClientContext, PacketChain);
             } else if (PacketChain->Reserved == L4_TYPE_TCP_SYN || PacketChain->Reserved == L4_TYPE_TCP_SYNACK) {
                 CxPlatDpRawSocketAckSyn(Socket, PacketChain);
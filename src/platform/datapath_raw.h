@@ -42,6 +42,13 @@ typedef struct QUIC_CACHEALIGN CXPLAT_ROUTE_RESOLUTION_WORKER {
     //
     CXPLAT_DISPATCH_LOCK Lock;
     CXPLAT_LIST_ENTRY Operations;
+
+    //
+    // The routing and neighbor tables shared by all the datapath's route
+    // resolutions, kept up to date by the worker (Linux only, and NULL if it
+    // couldn't be created).
+    //
+    struct CXPLAT_ROUTE_CACHE* Cache;
 } CXPLAT_ROUTE_RESOLUTION_WORKER;
 
 typedef struct CXPLAT_DATAPATH_RAW {
@@ -144,6 +151,18 @@ CxPlatDpRawUpdateConfig(
     _In_ QUIC_EXECUTION_CONFIG* Config
     );
 
+//
+// Writes the statistics of up to Capacity of the datapath's queues and returns
+// how many queues there are.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+uint32_t
+CxPlatDpRawGetQueueStatistics(
+    _In_ CXPLAT_DATAPATH_RAW* Datapath,
+    _Out_writes_opt_(Capacity) QUIC_DATAPATH_QUEUE_STATISTICS* Statistics,
+    _In_ uint32_t Capacity
+    );
+
 //
 // Called on creation and deletion of a socket. It indicates to the raw datapath
 // that it should update any filtering rules as necessary.
@@ -211,7 +230,7 @@ _IRQL_requires_max_(DISPATCH_LEVEL)
 void
 CxPlatDpRawRxEthernet(
     _In_ const CXPLAT_DATAPATH_RAW* Datapath,
-    _In_reads_(PacketCount)
+    _Inout_updates_(PacketCount)
         CXPLAT_RECV_DATA** Packets,
     _In_ uint16_t PacketCount
     );
@@ -269,6 +288,13 @@ typedef struct CXPLAT_SOCKET_RAW {
     uint8_t CibirIdOffsetSrc;        // CIBIR ID offset in source CID
     uint8_t CibirIdOffsetDst;        // CIBIR ID offset in destination CID
     uint8_t CibirId[6];              // CIBIR ID data
+    uint8_t FilterCidLength;         // Server CID length. Value of 0 indicates no filtering
+    uint8_t FilterServerIdOffset;    // Server ID offset in server CIDs
+    uint8_t FilterServerIdLength;    // Value of 0 indicates the server ID isn't matched
+    uint8_t FilterServerId[15];      // Server ID data
+    uint8_t SteeringPidOffset;       // Offset of the partition ID in server CIDs
+    uint16_t SteeringPidMask;        // Mask applied to the partition ID
+    uint16_t SteeringPartitionCount; // Value of 0 indicates CID steering isn't used
 
     CXPLAT_SEND_DATA* PausedTcpSend; // Paused TCP send data *before* framing
     CXPLAT_SEND_DATA* CachedRstSend; // Cached TCP RST send data *after* framing
@@ -370,6 +396,20 @@ CxPlatDpRawSocketAckFin(
     _In_ CXPLAT_RECV_DATA* Packet
     );
 
+//
+// Picks the fastest checksum implementation the processor supports.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CxPlatFramingChecksumInitialize(
+    void
+    );
+
+//
+// Writes the Ethernet, IP and transport headers in front of Buffer. When the
+// transport checksum is skipped (offloaded), its field is left holding the
+// pseudo header checksum, as the NIC expects.
+//
 _IRQL_requires_max_(DISPATCH_LEVEL)
 void
 CxPlatFramingWriteHeaders(
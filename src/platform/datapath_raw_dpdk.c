@@ -27,12 +27,35 @@ Abstract:
 #include <rte_debug.h>
 #include <rte_ethdev.h>
 #include <rte_mbuf_core.h>
+#include <rte_flow.h>
 
 #define NUM_MBUFS 8191
 #define MBUF_CACHE_SIZE 250
 #define RX_BURST_SIZE 16
 #define TX_BURST_SIZE 16
 #define TX_RING_SIZE 1024
+#define MAX_QUEUE_COUNT 64
+#define MAX_FLOW_RULE_COUNT 32
+
+typedef struct DPDK_INTERFACE DPDK_INTERFACE;
+
+//
+// An RX/TX queue pair, polled by a single lcore.
+//
+typedef struct DPDK_QUEUE {
+    DPDK_INTERFACE* Interface;
+    uint16_t Id;
+    struct rte_ring* TxRingBuffer;
+} DPDK_QUEUE;
+
+//
+// An rte_flow rule steering a local UDP port across all the queues.
+//
+typedef struct DPDK_FLOW_RULE {
+    uint16_t Port; // Network byte order
+    uint16_t RefCount;
+    struct rte_flow* Flow;
+} DPDK_FLOW_RULE;
 
 typedef struct DPDK_INTERFACE {
 
@@ -41,7 +64,13 @@ typedef struct DPDK_INTERFACE {
     uint16_t Port;
     CXPLAT_LOCK TxLock;
     struct rte_mempool* MemoryPool;
-    struct rte_ring* TxRingBuffer;
+
+    uint16_t QueueCount;
+    uint64_t RssHashFunctions;
+    DPDK_QUEUE Queues[MAX_QUEUE_COUNT];
+
+    CXPLAT_LOCK FlowLock;
+    DPDK_FLOW_RULE FlowRules[MAX_FLOW_RULE_COUNT];
 
     // Constants
     char DeviceName[32];
@@ -52,11 +81,17 @@ typedef struct DPDK_DATAPATH {
     CXPLAT_DATAPATH;
 
     BOOLEAN Running;
+    uint16_t CpuCount;
+    uint16_t Cpus[MAX_QUEUE_COUNT];
     CXPLAT_THREAD DpdkThread;
     QUIC_STATUS StartStatus;
     CXPLAT_EVENT StartComplete;
 
-    CXPLAT_POOL AdditionalInfoPool;
+    //
+    // Each mbuf's private area holds its DPDK_RX_PACKET or DPDK_TX_PACKET (and
+    // the client's receive context), so no metadata is allocated per packet.
+    //
+    uint16_t MbufPrivSize;
 
     DPDK_INTERFACE Interface; // TODO: support multiple NIC interfaces.
 
@@ -66,19 +101,18 @@ typedef struct DPDK_RX_PACKET {
     CXPLAT_RECV_DATA;
     CXPLAT_ROUTE RouteStorage;
     struct rte_mbuf* Mbuf;
-    CXPLAT_POOL* OwnerPool;
 } DPDK_RX_PACKET;
 
 typedef struct DPDK_TX_PACKET {
     CXPLAT_SEND_DATA;
     struct rte_mbuf* Mbuf;
     DPDK_DATAPATH* Dpdk;
-    DPDK_INTERFACE* Interface;
+    DPDK_QUEUE* Queue;
 } DPDK_TX_PACKET;
 
 CXPLAT_STATIC_ASSERT(
     sizeof(DPDK_TX_PACKET) <= sizeof(DPDK_RX_PACKET),
-    "Code assumes memory allocated for RX is enough for TX");
+    "Code assumes the mbuf private area sized for RX is enough for TX");
 
 CXPLAT_THREAD_CALLBACK(CxPlatDpdkMainThread, Context);
 static int CxPlatDpdkWorkerThread(_In_ void* Context);
@@ -90,13 +124,20 @@ CxPlatDpdkReadConfig(
     _In_opt_ CXPLAT_DATAPATH_CONFIG* Config
     )
 {
-    Dpdk->Cpu = (uint16_t)(CxPlatProcCount() - 1);
+    Dpdk->CpuCount = 1;
+    Dpdk->Cpus[0] = (uint16_t)(CxPlatProcCount() - 1);
 
     //
-    // Read user-specified global config.
+    // Read user-specified global config. Each processor gets its own lcore
+    // and RX/TX queue pair, so that each partition's traffic is polled on
+    // the partition's own processor.
     //
     if (Config != NULL && Config->DataPathProcList != NULL) {
-        Dpdk->Cpu = Config->DataPathProcList[0];
+        Dpdk->CpuCount =
+            (uint16_t)CXPLAT_MIN(Config->DataPathProcListLength, MAX_QUEUE_COUNT);
+        for (uint16_t i = 0; i < Dpdk->CpuCount; ++i) {
+            Dpdk->Cpus[i] = Config->DataPathProcList[i];
+        }
     }
 
     FILE *File = fopen("dpdk.ini", "r");
@@ -147,15 +188,19 @@ CxPlatDpRawInitialize(
     CXPLAT_THREAD_CONFIG Config = {
         0, 0, "DpdkMain", CxPlatDpdkMainThread, Dpdk
     };
-    const uint32_t AdditionalBufferSize =
-        sizeof(DPDK_RX_PACKET) + ClientRecvContextLength;
+    const uint32_t MbufPrivSize =
+        RTE_ALIGN_CEIL(sizeof(DPDK_RX_PACKET) + ClientRecvContextLength, RTE_MBUF_PRIV_ALIGN);
+    if (MbufPrivSize > UINT16_MAX) {
+        return QUIC_STATUS_INVALID_PARAMETER;
+    }
+    Dpdk->MbufPrivSize = (uint16_t)MbufPrivSize;
 
     CxPlatDpdkReadConfig(Dpdk, Config);
 
     BOOLEAN CleanUpThread = FALSE;
     CxPlatEventInitialize(&Dpdk->StartComplete, TRUE, FALSE);
-    CxPlatPoolInitialize(FALSE, AdditionalBufferSize, QUIC_POOL_DATAPATH, &Dpdk->AdditionalInfoPool);
     CxPlatLockInitialize(&Dpdk->Interface.TxLock);
+    CxPlatLockInitialize(&Dpdk->Interface.FlowLock);
     CxPlatListInitializeHead(&Dpdk->Interfaces);
     CxPlatListInsertTail(&Dpdk->Interfaces, &Dpdk->Interface.Link);
 
@@ -185,7 +230,7 @@ Error:
     if (QUIC_FAILED(Status)) {
         if (CleanUpThread) {
             CxPlatLockUninitialize(&Dpdk->Interface.TxLock);
-            CxPlatPoolUninitialize(&Dpdk->AdditionalInfoPool);
+            CxPlatLockUninitialize(&Dpdk->Interface.FlowLock);
             CxPlatThreadWait(&Dpdk->DpdkThread);
             CxPlatThreadDelete(&Dpdk->DpdkThread);
         }
@@ -204,7 +249,7 @@ CxPlatDpRawUninitialize(
     DPDK_DATAPATH* Dpdk = (DPDK_DATAPATH*)Datapath;
     Dpdk->Running = FALSE;
     CxPlatLockUninitialize(&Dpdk->Interface.TxLock);
-    CxPlatPoolUninitialize(&Dpdk->AdditionalInfoPool);
+    CxPlatLockUninitialize(&Dpdk->Interface.FlowLock);
     CxPlatThreadWait(&Dpdk->DpdkThread);
     CxPlatThreadDelete(&Dpdk->DpdkThread);
     CxPlatEventUninitialize(Dpdk->StartComplete);
@@ -221,6 +266,55 @@ CxPlatDpRawUpdateConfig(
     UNREFERENCED_PARAMETER(Config);
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+uint32_t
+CxPlatDpRawGetQueueStatistics(
+    _In_ CXPLAT_DATAPATH* Datapath,
+    _Out_writes_opt_(Capacity) QUIC_DATAPATH_QUEUE_STATISTICS* Statistics,
+    _In_ uint32_t Capacity
+    )
+{
+    DPDK_DATAPATH* Dpdk = (DPDK_DATAPATH*)Datapath;
+    DPDK_INTERFACE* Interface = &Dpdk->Interface;
+    if (Statistics == NULL) {
+        return Interface->QueueCount;
+    }
+
+    //
+    // The device only keeps per-queue counters for its first
+    // RTE_ETHDEV_QUEUE_STAT_CNTRS queues.
+    //
+    struct rte_eth_stats EthStats;
+    const BOOLEAN HaveEthStats = rte_eth_stats_get(Interface->Port, &EthStats) == 0;
+
+    for (uint16_t i = 0; i < Interface->QueueCount && i < Capacity; i++) {
+        const DPDK_QUEUE* Queue = &Interface->Queues[i];
+        QUIC_DATAPATH_QUEUE_STATISTICS* Stats = &Statistics[i];
+        CxPlatZeroMemory(Stats, sizeof(*Stats));
+        Stats->InterfaceIndex = Interface->IfIndex;
+        Stats->QueueId = Queue->Id;
+        if (HaveEthStats && Queue->Id < RTE_ETHDEV_QUEUE_STAT_CNTRS) {
+            Stats->RxPackets = EthStats.q_ipackets[Queue->Id];
+            Stats->TxPackets = EthStats.q_opackets[Queue->Id];
+            Stats->RxDropped = EthStats.q_errors[Queue->Id];
+        }
+        const int RxUsed = rte_eth_rx_queue_count(Interface->Port, Queue->Id);
+        if (RxUsed > 0) {
+            Stats->RxRingUsed = (uint32_t)RxUsed;
+        }
+        struct rte_eth_rxq_info RxQueueInfo;
+        if (rte_eth_rx_queue_info_get(Interface->Port, Queue->Id, &RxQueueInfo) == 0) {
+            Stats->RxRingSize = RxQueueInfo.nb_desc;
+        }
+        if (Queue->TxRingBuffer != NULL) {
+            Stats->TxRingUsed = rte_ring_count(Queue->TxRingBuffer);
+            Stats->TxRingSize = rte_ring_get_capacity(Queue->TxRingBuffer);
+        }
+    }
+
+    return Interface->QueueCount;
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 QUIC_STATUS
 CxPlatSocketUpdateQeo(
@@ -240,8 +334,12 @@ CXPLAT_THREAD_CALLBACK(CxPlatDpdkMainThread, Context)
 {
     DPDK_DATAPATH* Dpdk = (DPDK_DATAPATH*)Context;
 
-    char DpdpCpuStr[16];
-    sprintf(DpdpCpuStr, "%hu", Dpdk->Cpu);
+    char DpdpCpuStr[MAX_QUEUE_COUNT * 6];
+    size_t DpdpCpuStrLength = 0;
+    for (uint16_t i = 0; i < Dpdk->CpuCount; ++i) {
+        DpdpCpuStrLength +=
+            sprintf(DpdpCpuStr + DpdpCpuStrLength, i == 0 ? "%hu" : ",%hu", Dpdk->Cpus[i]);
+    }
 
     const char* argv[] = {
         "msquic",
@@ -263,7 +361,7 @@ CXPLAT_THREAD_CALLBACK(CxPlatDpdkMainThread, Context)
     };
     uint16_t nb_rxd = 1024;
     uint16_t nb_txd = 1024;
-    const uint16_t rx_rings = 1, tx_rings = 1;
+    uint16_t rx_rings, tx_rings;
     struct rte_eth_dev_info DeviceInfo;
     struct rte_eth_rxconf rxconf;
     struct rte_eth_txconf txconf;
@@ -303,7 +401,7 @@ CXPLAT_THREAD_CALLBACK(CxPlatDpdkMainThread, Context)
     Dpdk->Interface.Port = Port;
     Dpdk->Interface.MemoryPool =
         rte_pktmbuf_pool_create(
-            "MBUF_POOL", NUM_MBUFS, MBUF_CACHE_SIZE, 0,
+            "MBUF_POOL", NUM_MBUFS, MBUF_CACHE_SIZE, Dpdk->MbufPrivSize,
             RTE_MBUF_DEFAULT_BUF_SIZE, rte_eth_dev_socket_id(Port));
     if (Dpdk->Interface.MemoryPool == NULL) {
         QuicTraceEvent(
@@ -315,20 +413,6 @@ CXPLAT_THREAD_CALLBACK(CxPlatDpdkMainThread, Context)
         goto Error;
     }
 
-    Dpdk->Interface.TxRingBuffer =
-        rte_ring_create(
-            "TxRing", TX_RING_SIZE, rte_eth_dev_socket_id(Port),
-            RING_F_MP_HTS_ENQ | RING_F_SC_DEQ);
-    if (Dpdk->Interface.TxRingBuffer == NULL) {
-        QuicTraceEvent(
-            LibraryErrorStatus,
-            "[ lib] ERROR, %u, %s.",
-            ret,
-            "rte_ring_create");
-        Status = QUIC_STATUS_INTERNAL_ERROR;
-        goto Error;
-    }
-
     ret = rte_eth_dev_info_get(Port, &DeviceInfo);
     if (ret < 0) {
         QuicTraceEvent(
@@ -342,6 +426,53 @@ CXPLAT_THREAD_CALLBACK(CxPlatDpdkMainThread, Context)
 
     Dpdk->Interface.IfIndex = DeviceInfo.if_index;
 
+    //
+    // One queue pair per lcore, limited by what the device supports.
+    //
+    Dpdk->Interface.QueueCount = (uint16_t)rte_lcore_count();
+    if (Dpdk->Interface.QueueCount > DeviceInfo.max_rx_queues) {
+        Dpdk->Interface.QueueCount = DeviceInfo.max_rx_queues;
+    }
+    if (Dpdk->Interface.QueueCount > DeviceInfo.max_tx_queues) {
+        Dpdk->Interface.QueueCount = DeviceInfo.max_tx_queues;
+    }
+    if (Dpdk->Interface.QueueCount > MAX_QUEUE_COUNT) {
+        Dpdk->Interface.QueueCount = MAX_QUEUE_COUNT;
+    }
+    rx_rings = tx_rings = Dpdk->Interface.QueueCount;
+
+    for (uint16_t q = 0; q < Dpdk->Interface.QueueCount; q++) {
+        char RingName[RTE_RING_NAMESIZE];
+        sprintf(RingName, "TxRing%hu", q);
+        DPDK_QUEUE* Queue = &Dpdk->Interface.Queues[q];
+        Queue->Interface = &Dpdk->Interface;
+        Queue->Id = q;
+        Queue->TxRingBuffer =
+            rte_ring_create(
+                RingName, TX_RING_SIZE, rte_eth_dev_socket_id(Port),
+                RING_F_MP_HTS_ENQ | RING_F_SC_DEQ);
+        if (Queue->TxRingBuffer == NULL) {
+            QuicTraceEvent(
+                LibraryErrorStatus,
+                "[ lib] ERROR, %u, %s.",
+                q,
+                "rte_ring_create");
+            Status = QUIC_STATUS_INTERNAL_ERROR;
+            goto Error;
+        }
+    }
+
+    if (Dpdk->Interface.QueueCount > 1) {
+        //
+        // Spread the flows across the queues with RSS.
+        //
+        Dpdk->Interface.RssHashFunctions =
+            (ETH_RSS_IP | ETH_RSS_UDP) & DeviceInfo.flow_type_rss_offloads;
+        PortConfig.rxmode.mq_mode = ETH_MQ_RX_RSS;
+        PortConfig.rx_adv_conf.rss_conf.rss_key = NULL;
+        PortConfig.rx_adv_conf.rss_conf.rss_hf = Dpdk->Interface.RssHashFunctions;
+    }
+
     if (DeviceInfo.tx_offload_capa & DEV_TX_OFFLOAD_IPV4_CKSUM) {
         printf("TX IPv4 Checksum Offload Enabled\n");
         PortConfig.txmode.offloads |= DEV_TX_OFFLOAD_IPV4_CKSUM;
@@ -496,8 +627,10 @@ Error:
         CxPlatEventSet(Dpdk->StartComplete);
     }
 
-    if (Dpdk->Interface.TxRingBuffer) {
-        rte_ring_free(Dpdk->Interface.TxRingBuffer);
+    for (uint16_t q = 0; q < Dpdk->Interface.QueueCount; q++) {
+        if (Dpdk->Interface.Queues[q].TxRingBuffer) {
+            rte_ring_free(Dpdk->Interface.Queues[q].TxRingBuffer);
+        }
     }
 
     if (Dpdk->Interface.MemoryPool) {
@@ -518,9 +651,82 @@ CxPlatDpRawPlumbRulesOnSocket(
     _In_ BOOLEAN IsCreated
     )
 {
-    UNREFERENCED_PARAMETER(Socket);
-    UNREFERENCED_PARAMETER(IsCreated);
-    // no-op currently since DPDK simply steals all traffic
+    //
+    // DPDK still receives all the traffic on the port, but an rte_flow rule
+    // per local UDP port makes the NIC spread the QUIC flows over all the
+    // queues, even on devices whose default RSS doesn't cover UDP ports.
+    //
+    DPDK_DATAPATH* Dpdk = (DPDK_DATAPATH*)Socket->Datapath;
+    DPDK_INTERFACE* Interface = &Dpdk->Interface;
+    const uint16_t LocalPort = Socket->LocalAddress.Ipv4.sin_port;
+    if (Interface->QueueCount <= 1) {
+        return;
+    }
+
+    CxPlatLockAcquire(&Interface->FlowLock);
+    DPDK_FLOW_RULE* Rule = NULL;
+    DPDK_FLOW_RULE* FreeRule = NULL;
+    for (uint32_t i = 0; i < MAX_FLOW_RULE_COUNT; ++i) {
+        if (Interface->FlowRules[i].RefCount == 0) {
+            if (FreeRule == NULL) {
+                FreeRule = &Interface->FlowRules[i];
+            }
+        } else if (Interface->FlowRules[i].Port == LocalPort) {
+            Rule = &Interface->FlowRules[i];
+            break;
+        }
+    }
+
+    struct rte_flow_error FlowError;
+    if (IsCreated) {
+        if (Rule != NULL) {
+            Rule->RefCount++;
+        } else if (FreeRule != NULL) {
+            uint16_t QueueIds[MAX_QUEUE_COUNT];
+            for (uint16_t q = 0; q < Interface->QueueCount; q++) {
+                QueueIds[q] = q;
+            }
+            const struct rte_flow_attr Attr = { .ingress = 1 };
+            const struct rte_flow_item_udp UdpSpec = { .hdr.dst_port = LocalPort };
+            const struct rte_flow_item_udp UdpMask = { .hdr.dst_port = 0xFFFF };
+            const struct rte_flow_item Pattern[] = {
+                { .type = RTE_FLOW_ITEM_TYPE_ETH },
+                { .type = Socket->LocalAddress.Ip.sa_family == QUIC_ADDRESS_FAMILY_INET ?
+                    RTE_FLOW_ITEM_TYPE_IPV4 : RTE_FLOW_ITEM_TYPE_IPV6 },
+                { .type = RTE_FLOW_ITEM_TYPE_UDP, .spec = &UdpSpec, .mask = &UdpMask },
+                { .type = RTE_FLOW_ITEM_TYPE_END },
+            };
+            const struct rte_flow_action_rss Rss = {
+                .func = RTE_ETH_HASH_FUNCTION_DEFAULT,
+                .level = 0,
+                .types = Interface->RssHashFunctions,
+                .key_len = 0,
+                .queue_num = Interface->QueueCount,
+                .key = NULL,
+                .queue = QueueIds,
+            };
+            const struct rte_flow_action Actions[] = {
+                { .type = RTE_FLOW_ACTION_TYPE_RSS, .conf = &Rss },
+                { .type = RTE_FLOW_ACTION_TYPE_END },
+            };
+            FreeRule->Flow =
+                rte_flow_create(Interface->Port, &Attr, Pattern, Actions, &FlowError);
+            if (FreeRule->Flow != NULL) {
+                FreeRule->Port = LocalPort;
+                FreeRule->RefCount = 1;
+            } else {
+                QuicTraceEvent(
+                    LibraryErrorStatus,
+                    "[ lib] ERROR, %u, %s.",
+                    FlowError.type,
+                    "rte_flow_create");
+            }
+        }
+    } else if (Rule != NULL && --Rule->RefCount == 0) {
+        (void)rte_flow_destroy(Interface->Port, Rule->Flow, &FlowError);
+        Rule->Flow = NULL;
+    }
+    CxPlatLockRelease(&Interface->FlowLock);
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -530,7 +736,16 @@ CxPlatDpRawAssignQueue(
     _Inout_ CXPLAT_ROUTE* Route
     )
 {
-    Route->Queue = Interface;
+    //
+    // Send on the queue polled by the current processor's lcore, if any.
+    //
+    const DPDK_INTERFACE* DpdkInterface = (const DPDK_INTERFACE*)Interface;
+    const int LcoreIndex = rte_lcore_index((int)rte_lcore_id());
+    const uint16_t QueueIndex =
+        LcoreIndex >= 0 ?
+            (uint16_t)(LcoreIndex % DpdkInterface->QueueCount) :
+            (uint16_t)(CxPlatProcCurrentNumber() % DpdkInterface->QueueCount);
+    Route->Queue = (void*)&DpdkInterface->Queues[QueueIndex];
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -539,7 +754,7 @@ CxPlatDpRawGetInterfaceFromQueue(
     _In_ const void* Queue
     )
 {
-    return (const CXPLAT_INTERFACE*)Queue;
+    return (const CXPLAT_INTERFACE*)((const DPDK_QUEUE*)Queue)->Interface;
 }
 
 static
@@ -547,29 +762,29 @@ void
 CxPlatDpdkRx(
     _In_ DPDK_DATAPATH* Dpdk,
     _In_ const uint16_t Core,
-    _In_ DPDK_INTERFACE* Interface
+    _In_ DPDK_QUEUE* Queue
     )
 {
+    DPDK_INTERFACE* Interface = Queue->Interface;
     void* Buffers[RX_BURST_SIZE];
     const uint16_t BuffersCount =
-        rte_eth_rx_burst(Interface->Port, 0, (struct rte_mbuf**)Buffers, RX_BURST_SIZE);
+        rte_eth_rx_burst(Interface->Port, Queue->Id, (struct rte_mbuf**)Buffers, RX_BURST_SIZE);
     if (unlikely(BuffersCount == 0)) {
         return;
     }
 
-    DPDK_RX_PACKET Packet; // Working space
-    CxPlatZeroMemory(&Packet, sizeof(DPDK_RX_PACKET));
-    Packet.Route = &Packet.RouteStorage;
-    Packet.Route->Queue = Interface;
-
     uint16_t PacketCount = 0;
     for (uint16_t i = 0; i < BuffersCount; i++) {
         struct rte_mbuf* Buffer = (struct rte_mbuf*)Buffers[i];
-        Packet.Buffer = NULL;
+        DPDK_RX_PACKET* Packet = (DPDK_RX_PACKET*)rte_mbuf_to_priv(Buffer);
+        CxPlatZeroMemory(Packet, sizeof(DPDK_RX_PACKET));
+        Packet->Route = &Packet->RouteStorage;
+        Packet->Route->Queue = Queue;
+        Packet->Mbuf = Buffer;
         if ((Buffer->ol_flags & (PKT_RX_IP_CKSUM_BAD | PKT_RX_L4_CKSUM_BAD)) == 0) {
             CxPlatDpRawParseEthernet(
                 (CXPLAT_DATAPATH*)Dpdk,
-                (CXPLAT_RECV_DATA*)&Packet,
+                (CXPLAT_RECV_DATA*)Packet,
                 ((uint8_t*)Buffer->buf_addr) + Buffer->data_off,
                 Buffer->pkt_len);
             //
@@ -577,7 +792,7 @@ CxPlatDpdkRx(
             // mark it resolved. This allows stateless sends to be issued without performing
             // a route lookup.
             //
-            Packet.Route->State = RouteResolved;
+            Packet->Route->State = RouteResolved;
         } else {
             QuicTraceEvent(
                 LibraryErrorStatus,
@@ -589,14 +804,9 @@ CxPlatDpdkRx(
                 Interface->OffloadStatus.Receive.TransportLayerXsum != 0);
         }
 
-        DPDK_RX_PACKET* NewPacket;
-        if (likely(Packet.Buffer && (NewPacket = CxPlatPoolAlloc(&Dpdk->AdditionalInfoPool)) != NULL)) {
-            CxPlatCopyMemory(NewPacket, &Packet, sizeof(DPDK_RX_PACKET));
-            NewPacket->Allocated = TRUE;
-            NewPacket->Mbuf = Buffer;
-            NewPacket->OwnerPool = &Dpdk->AdditionalInfoPool;
-            NewPacket->Route = &NewPacket->RouteStorage;
-            Buffers[PacketCount++] = NewPacket;
+        if (likely(Packet->Buffer != NULL)) {
+            Packet->Allocated = TRUE;
+            Buffers[PacketCount++] = Packet;
         } else {
             rte_pktmbuf_free(Buffer);
         }
@@ -616,8 +826,7 @@ CxPlatDpRawRxFree(
     while (PacketChain) {
         const DPDK_RX_PACKET* Packet = (DPDK_RX_PACKET*)PacketChain;
         PacketChain = PacketChain->Next;
-        rte_pktmbuf_free(Packet->Mbuf);
-        CxPlatPoolFree(Packet->OwnerPool, (void*)Packet);
+        rte_pktmbuf_free(Packet->Mbuf); // Also frees the packet, in its private area.
     }
 }
 
@@ -629,26 +838,28 @@ CxPlatDpRawTxAlloc(
     )
 {
     DPDK_DATAPATH* Dpdk = (DPDK_DATAPATH*)Datapath;
-    DPDK_TX_PACKET* Packet = CxPlatPoolAlloc(&Dpdk->AdditionalInfoPool);
     QUIC_ADDRESS_FAMILY Family = QuicAddrGetFamily(&Config->Route->RemoteAddress);
-    DPDK_INTERFACE* Interface = (DPDK_INTERFACE*)Config->Route->Queue;
-
-    if (likely(Packet)) {
-        Packet->Interface = Interface;
-        Packet->Mbuf = rte_pktmbuf_alloc(Interface->MemoryPool);
-        if (likely(Packet->Mbuf)) {
-            HEADER_BACKFILL HeaderFill = CxPlatDpRawCalculateHeaderBackFill(Family);
-            Packet->Dpdk = Dpdk;
-            Packet->Buffer.Length = Config->MaxPacketSize;
-            Packet->Mbuf->data_off = 0;
-            Packet->Buffer.Buffer = ((uint8_t*)Packet->Mbuf->buf_addr) + HeaderFill.AllLayer;
-            Packet->Mbuf->l2_len = HeaderFill.LinkLayer;
-            Packet->Mbuf->l3_len = HeaderFill.NetworkLayer;
-        } else {
-            CxPlatPoolFree(&Dpdk->AdditionalInfoPool, Packet);
-            Packet = NULL;
-        }
+    DPDK_QUEUE* Queue = (DPDK_QUEUE*)Config->Route->Queue;
+
+    struct rte_mbuf* Mbuf = rte_pktmbuf_alloc(Queue->Interface->MemoryPool);
+    if (unlikely(Mbuf == NULL)) {
+        return NULL;
     }
+
+    //
+    // The packet is written straight into the mbuf's data room, and its
+    // metadata lives in the mbuf's private area.
+    //
+    DPDK_TX_PACKET* Packet = (DPDK_TX_PACKET*)rte_mbuf_to_priv(Mbuf);
+    HEADER_BACKFILL HeaderFill = CxPlatDpRawCalculateHeaderBackFill(Family);
+    Packet->Mbuf = Mbuf;
+    Packet->Queue = Queue;
+    Packet->Dpdk = Dpdk;
+    Packet->Buffer.Length = Config->MaxPacketSize;
+    Mbuf->data_off = 0;
+    Packet->Buffer.Buffer = ((uint8_t*)Mbuf->buf_addr) + HeaderFill.AllLayer;
+    Mbuf->l2_len = HeaderFill.LinkLayer;
+    Mbuf->l3_len = HeaderFill.NetworkLayer;
     return (CXPLAT_SEND_DATA*)Packet;
 }
 
@@ -660,7 +871,6 @@ CxPlatDpRawTxFree(
 {
     DPDK_TX_PACKET* Packet = (DPDK_TX_PACKET*)SendData;
     rte_pktmbuf_free(Packet->Mbuf);
-    CxPlatPoolFree(&Packet->Dpdk->AdditionalInfoPool, SendData);
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -670,38 +880,59 @@ CxPlatDpRawTxEnqueue(
     )
 {
     DPDK_TX_PACKET* Packet = (DPDK_TX_PACKET*)SendData;
-    DPDK_INTERFACE* Interface = Packet->Interface;
-    Packet->Mbuf->data_len = (uint16_t)Packet->Buffer.Length;
-    Packet->Mbuf->ol_flags = PKT_TX_IPV4 | PKT_TX_IP_CKSUM | PKT_TX_UDP_CKSUM;
-
+    DPDK_QUEUE* Queue = Packet->Queue;
     DPDK_DATAPATH* Dpdk = Packet->Dpdk;
-    if (unlikely(rte_ring_mp_enqueue(Interface->TxRingBuffer, Packet->Mbuf) != 0)) {
-        rte_pktmbuf_free(Packet->Mbuf);
+    struct rte_mbuf* Mbuf = Packet->Mbuf;
+    Mbuf->data_len = (uint16_t)Packet->Buffer.Length;
+    Mbuf->pkt_len = Mbuf->data_len;
+
+    //
+    // Only request the checksums the port was configured to offload; the
+    // headers carry software checksums otherwise.
+    //
+    uint64_t OffloadFlags;
+    if (Mbuf->l3_len == sizeof(IPV4_HEADER)) {
+        OffloadFlags = PKT_TX_IPV4;
+        if (Dpdk->Interface.OffloadStatus.Transmit.NetworkLayerXsum) {
+            OffloadFlags |= PKT_TX_IP_CKSUM;
+        }
+    } else {
+        OffloadFlags = PKT_TX_IPV6;
+    }
+    if (Dpdk->Interface.OffloadStatus.Transmit.TransportLayerXsum) {
+        OffloadFlags |= PKT_TX_UDP_CKSUM;
+    }
+    Mbuf->ol_flags = OffloadFlags;
+
+    //
+    // The packet is in the mbuf's private area, so it must not be touched
+    // once the mbuf is handed off.
+    //
+    if (unlikely(rte_ring_mp_enqueue(Queue->TxRingBuffer, Mbuf) != 0)) {
+        rte_pktmbuf_free(Mbuf);
         QuicTraceEvent(
             LibraryError,
             "[ lib] ERROR, %s.",
             "No room in DPDK TX ring buffer");
     }
-
-    CxPlatPoolFree(&Dpdk->AdditionalInfoPool, Packet);
 }
 
 static
 void
 CxPlatDpdkTx(
     _In_ DPDK_DATAPATH* Dpdk,
-    _In_ DPDK_INTERFACE* Interface
+    _In_ DPDK_QUEUE* Queue
     )
 {
     struct rte_mbuf* Buffers[TX_BURST_SIZE];
     const uint16_t BufferCount =
         (uint16_t)rte_ring_sc_dequeue_burst(
-            Interface->TxRingBuffer, (void**)Buffers, TX_BURST_SIZE, NULL);
+            Queue->TxRingBuffer, (void**)Buffers, TX_BURST_SIZE, NULL);
     if (unlikely(BufferCount == 0)) {
         return;
     }
 
-    const uint16_t TxCount = rte_eth_tx_burst(Interface->Port, 0, Buffers, BufferCount);
+    const uint16_t TxCount = rte_eth_tx_burst(Queue->Interface->Port, Queue->Id, Buffers, BufferCount);
     if (unlikely(TxCount < BufferCount)) {
         for (uint16_t buf = TxCount; buf < BufferCount; buf++) {
             rte_pktmbuf_free(Buffers[buf]);
@@ -717,6 +948,7 @@ CxPlatDpdkWorkerThread(
 {
     DPDK_DATAPATH* Dpdk = (DPDK_DATAPATH*)Context;
     const uint16_t Core = (uint16_t)rte_lcore_id();
+    const int LcoreIndex = rte_lcore_index((int)Core);
     CXPLAT_LIST_ENTRY* Entry;
 
     printf("Core %u worker running...\n", Core);
@@ -732,8 +964,15 @@ CxPlatDpdkWorkerThread(
     while (likely(Dpdk->Running)) {
         for (Entry = Dpdk->Interfaces.Flink; Entry != &Dpdk->Interfaces; Entry = Entry->Flink) {
             DPDK_INTERFACE* Interface = CONTAINING_RECORD(Entry, DPDK_INTERFACE, Link);
-            CxPlatDpdkRx(Dpdk, Core, Interface);
-            CxPlatDpdkTx(Dpdk, Interface);
+            if (LcoreIndex < 0 || LcoreIndex >= Interface->QueueCount) {
+                continue; // More lcores than queues.
+            }
+            //
+            // Each lcore exclusively polls its own queue pair.
+            //
+            DPDK_QUEUE* Queue = &Interface->Queues[LcoreIndex];
+            CxPlatDpdkRx(Dpdk, Core, Queue);
+            CxPlatDpdkTx(Dpdk, Queue);
         }
     }
 
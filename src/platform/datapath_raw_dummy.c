@@ -98,6 +98,20 @@ RawDataPathGetSupportedFeatures(
     return 0;
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+uint32_t
+RawDataPathGetQueueStatistics(
+    _In_ CXPLAT_DATAPATH_RAW* Datapath,
+    _Out_writes_opt_(Capacity) QUIC_DATAPATH_QUEUE_STATISTICS* Statistics,
+    _In_ uint32_t Capacity
+    )
+{
+    UNREFERENCED_PARAMETER(Datapath);
+    UNREFERENCED_PARAMETER(Statistics);
+    UNREFERENCED_PARAMETER(Capacity);
+    return 0;
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 BOOLEAN
 RawDataPathIsPaddingPreferred(
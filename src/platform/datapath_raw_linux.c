@@ -36,6 +36,10 @@ CxPlatDataPathRouteWorkerUninitialize(
         CxPlatThreadDelete(&Worker->Thread);
     }
 
+    if (Worker->Cache != NULL) {
+        CxPlatRouteCacheDelete(Worker->Cache);
+    }
+
     CxPlatEventUninitialize(Worker->Ready);
     CxPlatDispatchLockUninitialize(&Worker->Lock);
     CxPlatPoolUninitialize(&Worker->OperationPool);
@@ -62,6 +66,13 @@ CxPlatDataPathRouteWorkerInitialize(
         goto Error;
     }
 
+    //
+    // Route resolution still works without the cache (e.g. if netlink
+    // notifications aren't available), dumping the tables for each lookup.
+    //
+    Worker->Cache = NULL;
+    (void)CxPlatRouteCacheCreate(&Worker->Cache);
+
     Worker->Enabled = TRUE;
     CxPlatEventInitialize(&Worker->Ready, FALSE, FALSE);
     CxPlatDispatchLockInitialize(&Worker->Lock);
@@ -122,6 +133,17 @@ RawSocketCreateUdp(
     if (Config->CibirIdLength) {
         memcpy(NewSocket->CibirId, Config->CibirId, Config->CibirIdLength);
     }
+    if (!Config->RemoteAddress) {
+        NewSocket->FilterCidLength = Config->FilterCidLength;
+        NewSocket->FilterServerIdOffset = Config->FilterServerIdOffset;
+        NewSocket->FilterServerIdLength = Config->FilterServerIdLength;
+        if (Config->FilterServerIdLength) {
+            memcpy(NewSocket->FilterServerId, Config->FilterServerId, Config->FilterServerIdLength);
+        }
+        NewSocket->SteeringPidOffset = Config->CidPartitionIdOffset;
+        NewSocket->SteeringPidMask = Config->CidPartitionMask;
+        NewSocket->SteeringPartitionCount = Config->CidPartitionCount;
+    }
 
     if (Config->RemoteAddress) {
         CXPLAT_FRE_ASSERT(!QuicAddrIsWildCard(Config->RemoteAddress));  // No wildcard remote addresses allowed.
@@ -153,7 +175,12 @@ RawSocketCreateUdp(
         } else {
             int oif = -1;
             NewSocket->LocalAddress.Ip.sa_family = NewSocket->RemoteAddress.Ip.sa_family;
-            ResolveBestL3Route(&NewSocket->RemoteAddress, &NewSocket->LocalAddress, NULL, &oif);
+            ResolveBestL3Route(
+                Raw->RouteResolutionWorker->Cache,
+                &NewSocket->RemoteAddress,
+                &NewSocket->LocalAddress,
+                NULL,
+                &oif);
         }
     }
 
@@ -178,8 +205,103 @@ Error:
     return Status;
 }
 
+//
+// Completes the operations whose neighbor entries have become usable, or
+// fails them once they've waited too long. Returns TRUE if any are left.
+//
+static
+BOOLEAN
+CxPlatRouteResolutionWorkerProcess(
+    _In_ CXPLAT_ROUTE_RESOLUTION_WORKER* Worker,
+    _Inout_ CXPLAT_LIST_ENTRY* Pending
+    )
+{
+    const uint64_t Now = CxPlatTimeUs64();
+    CXPLAT_LIST_ENTRY* Entry = Pending->Flink;
+    while (Entry != Pending) {
+        CXPLAT_ROUTE_RESOLUTION_OPERATION* Operation =
+            CXPLAT_CONTAINING_RECORD(Entry, CXPLAT_ROUTE_RESOLUTION_OPERATION, WorkerLink);
+        Entry = Entry->Flink;
+
+        if (!Operation->Probed) {
+            CxPlatRouteCacheProbeNeighbor(&Operation->NextHop, Operation->IfIndex);
+            Operation->Probed = TRUE;
+            continue; // Give the kernel a chance to resolve it first.
+        }
+
+        uint8_t PhysicalAddress[6];
+        QUIC_STATUS Status =
+            ResolveRemotePhysicalAddress(Worker->Cache, &Operation->NextHop, PhysicalAddress);
+        if (QUIC_SUCCEEDED(Status)) {
+            Operation->Callback(
+                Operation->Context, PhysicalAddress, Operation->PathId, TRUE);
+        } else if (Status != QUIC_STATUS_NOT_FOUND ||
+                   CxPlatTimeDiff64(Operation->StartTimeUs, Now) >= CXPLAT_ROUTE_NEIGHBOR_TIMEOUT_US) {
+            QuicTraceEvent(
+                DatapathErrorStatus,
+                "[data][%p] ERROR, %u, %s.",
+                Operation,
+                Status,
+                "ResolveRemotePhysicalAddress");
+            Operation->Callback(
+                Operation->Context, NULL, Operation->PathId, FALSE);
+        } else {
+            continue; // Still resolving.
+        }
+
+        CxPlatListEntryRemove(&Operation->WorkerLink);
+        CxPlatPoolFree(&Worker->OperationPool, Operation);
+    }
+
+    return !CxPlatListIsEmpty(Pending);
+}
+
 CXPLAT_THREAD_CALLBACK(CxPlatRouteResolutionWorkerThread, Context)
 {
-    UNREFERENCED_PARAMETER(Context);
+    CXPLAT_ROUTE_RESOLUTION_WORKER* Worker = (CXPLAT_ROUTE_RESOLUTION_WORKER*)Context;
+    CXPLAT_LIST_ENTRY Pending;
+    CxPlatListInitializeHead(&Pending);
+    BOOLEAN HasPending = FALSE;
+
+    while (Worker->Enabled) {
+        //
+        // Keep the cache current even while idle, so the kernel's
+        // notifications don't pile up, but poll often while operations wait
+        // on neighbors.
+        //
+        CxPlatEventWaitWithTimeout(
+            Worker->Ready,
+            HasPending ? CXPLAT_ROUTE_NEIGHBOR_POLL_MS : CXPLAT_ROUTE_CACHE_REFRESH_MS);
+
+        CxPlatDispatchLockAcquire(&Worker->Lock);
+        if (!CxPlatListIsEmpty(&Worker->Operations)) {
+            CxPlatListMoveItems(&Worker->Operations, &Pending);
+        }
+        CxPlatDispatchLockRelease(&Worker->Lock);
+
+        if (Worker->Cache != NULL) {
+            CxPlatRouteCacheRefresh(Worker->Cache);
+        }
+
+        HasPending = CxPlatRouteResolutionWorkerProcess(Worker, &Pending);
+    }
+
+    //
+    // Clean up leftover work.
+    //
+    CxPlatDispatchLockAcquire(&Worker->Lock);
+    if (!CxPlatListIsEmpty(&Worker->Operations)) {
+        CxPlatListMoveItems(&Worker->Operations, &Pending);
+    }
+    CxPlatDispatchLockRelease(&Worker->Lock);
+
+    while (!CxPlatListIsEmpty(&Pending)) {
+        CXPLAT_ROUTE_RESOLUTION_OPERATION* Operation =
+            CXPLAT_CONTAINING_RECORD(
+                CxPlatListRemoveHead(&Pending), CXPLAT_ROUTE_RESOLUTION_OPERATION, WorkerLink);
+        Operation->Callback(Operation->Context, NULL, Operation->PathId, FALSE);
+        CxPlatPoolFree(&Worker->OperationPool, Operation);
+    }
+
     return 0;
 }
@@ -30,15 +30,90 @@
 #include <netlink/socket.h>
 #include <netlink/route/link.h>
 #include <netlink/route/neighbour.h>
+#include <netlink/cache.h>
+#include <linux/neighbour.h>
+
+//
+// How long a route resolution waits for the next hop's neighbor entry.
+//
+#define CXPLAT_ROUTE_NEIGHBOR_TIMEOUT_US    (3 * CXPLAT_MICROSEC_PER_SEC)
+
+//
+// How often the route worker polls for the neighbor entries it's waiting on,
+// and how often it applies table changes otherwise.
+//
+#define CXPLAT_ROUTE_NEIGHBOR_POLL_MS       10
+#define CXPLAT_ROUTE_CACHE_REFRESH_MS       1000
+
+//
+// User mode copies of the kernel's routing and neighbor tables, kept current
+// by a libnl cache manager from the kernel's netlink notifications. This
+// makes route resolution a memory lookup instead of a netlink dump of both
+// tables per connection.
+//
+typedef struct CXPLAT_ROUTE_CACHE {
+    //
+    // Serializes the lookups and the updates of the caches.
+    //
+    CXPLAT_LOCK Lock;
+
+    struct nl_cache_mngr* Manager;
+    struct nl_cache* Routes;
+    struct nl_cache* Neighbors;
+
+    //
+    // Used to reload the caches if notifications were lost.
+    //
+    struct nl_sock* SyncSocket;
+} CXPLAT_ROUTE_CACHE;
+
+QUIC_STATUS
+CxPlatRouteCacheCreate(
+    _Out_ CXPLAT_ROUTE_CACHE** NewCache
+    );
+
+void
+CxPlatRouteCacheDelete(
+    _In_ CXPLAT_ROUTE_CACHE* Cache
+    );
+
+//
+// Applies the table changes the kernel has notified since the last refresh.
+//
+void
+CxPlatRouteCacheRefresh(
+    _In_ CXPLAT_ROUTE_CACHE* Cache
+    );
+
+//
+// Starts the kernel's resolution (ARP/ND) of a neighbor.
+//
+void
+CxPlatRouteCacheProbeNeighbor(
+    _In_ const QUIC_ADDR* Address,
+    _In_ int IfIndex
+    );
 
 QUIC_STATUS
 ResolveBestL3Route(
+    _In_opt_ CXPLAT_ROUTE_CACHE* Cache,
     QUIC_ADDR* RemoteAddress,
     QUIC_ADDR* SourceAddress,
     QUIC_ADDR* GatewayAddress,
     int* oif
     );
 
+//
+// Looks up the link-layer address of a neighbor with a usable entry, failing
+// with QUIC_STATUS_NOT_FOUND if there isn't one (yet).
+//
+QUIC_STATUS
+ResolveRemotePhysicalAddress(
+    _In_opt_ CXPLAT_ROUTE_CACHE* Cache,
+    QUIC_ADDR* RemoteAddr,
+    uint8_t NextHopLinkLayerAddress[6]
+    );
+
 typedef struct CXPLAT_ROUTE_RESOLUTION_OPERATION {
     //
     // Link in the worker's operation queue.
@@ -46,7 +121,13 @@ typedef struct CXPLAT_ROUTE_RESOLUTION_OPERATION {
     //
     CXPLAT_LIST_ENTRY WorkerLink;
 
-    // TODO: MIB_IPNET_ROW2 IpnetRow;
+    //
+    // The next hop whose neighbor entry is being waited for.
+    //
+    QUIC_ADDR NextHop;
+    int IfIndex;
+    uint64_t StartTimeUs;
+    BOOLEAN Probed;
 
     void* Context;
     uint8_t PathId;
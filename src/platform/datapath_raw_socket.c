@@ -464,66 +464,234 @@ CxPlatDpRawCalculateHeaderBackFill(
     return HeaderBackFill;
 }
 
-_IRQL_requires_max_(DISPATCH_LEVEL)
-uint16_t
-CxPlatFramingChecksum(
-    _In_reads_(Length) uint8_t* Data,
-    _In_ uint32_t Length,
-    _In_ uint64_t InitialChecksum
+//
+// Checksums are accumulated as a 64-bit one's complement sum, which folds
+// down to the 16-bit Internet checksum (2^64 - 1 is a multiple of 2^16 - 1).
+// Longer buffers are summed with SIMD where the processor has it: AVX2 on x64
+// (checked at runtime) and NEON on ARM64 (always present).
+//
+#if (defined(_M_X64) || defined(__x86_64__)) && !defined(_KERNEL_MODE)
+#define CXPLAT_FRAMING_CHECKSUM_AVX2
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#include <immintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define CXPLAT_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define CXPLAT_TARGET_AVX2
+#endif
+#elif (defined(_M_ARM64) || defined(__aarch64__)) && !defined(_KERNEL_MODE)
+#define CXPLAT_FRAMING_CHECKSUM_NEON
+#ifdef _MSC_VER
+#include <arm64_neon.h>
+#else
+#include <arm_neon.h>
+#endif
+#endif
+
+//
+// Shorter buffers (most notably headers) aren't worth the SIMD setup.
+//
+#define CXPLAT_FRAMING_CHECKSUM_SIMD_MIN 128
+
+#ifdef CXPLAT_FRAMING_CHECKSUM_AVX2
+static BOOLEAN CxPlatFramingUseAvx2;
+#endif
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CxPlatFramingChecksumInitialize(
+    void
     )
 {
-    //
-    // Add up all bytes in 3 steps:
-    // 1. Add the odd byte to the checksum if the length is odd.
-    // 2. If the length is divisible by 2 but not 4, add the last 2 bytes.
-    // 3. Sum up the rest as 32-bit words.
-    //
+#ifdef CXPLAT_FRAMING_CHECKSUM_AVX2
+#ifdef _MSC_VER
+    int CpuInfo[4];
+    __cpuid(CpuInfo, 1);
+    if ((CpuInfo[2] & (1 << 27)) == 0 || // OSXSAVE
+        (_xgetbv(0) & 0x6) != 0x6) {     // OS saves the YMM registers
+        CxPlatFramingUseAvx2 = FALSE;
+        return;
+    }
+    __cpuidex(CpuInfo, 7, 0);
+    CxPlatFramingUseAvx2 = (CpuInfo[1] & (1 << 5)) != 0;
+#else
+    CxPlatFramingUseAvx2 = __builtin_cpu_supports("avx2") != 0;
+#endif
+#endif
+}
 
-    if ((Length & 1) != 0) {
-        --Length;
-        InitialChecksum += Data[Length];
+static
+uint64_t
+CxPlatFramingAddWithCarry(
+    _In_ uint64_t Sum,
+    _In_ uint64_t Value
+    )
+{
+    Sum += Value;
+    return Sum + (Sum < Value); // End-around carry
+}
+
+#ifdef CXPLAT_FRAMING_CHECKSUM_AVX2
+//
+// Sums all the whole 32-byte blocks of Data into Sum and returns the number
+// of bytes consumed. Each 32-bit word is widened into a 64-bit lane, so the
+// lanes can't overflow for any buffer shorter than 2^34 bytes.
+//
+CXPLAT_TARGET_AVX2
+static
+uint32_t
+CxPlatFramingChecksumAvx2(
+    _In_reads_(Length) const uint8_t* Data,
+    _In_ uint32_t Length,
+    _Inout_ uint64_t* Sum
+    )
+{
+    const __m256i Zero = _mm256_setzero_si256();
+    __m256i Acc0 = _mm256_setzero_si256();
+    __m256i Acc1 = _mm256_setzero_si256();
+    uint32_t Offset = 0;
+    for (; Offset + 32 <= Length; Offset += 32) {
+        const __m256i Block = _mm256_loadu_si256((const __m256i*)(Data + Offset));
+        Acc0 = _mm256_add_epi64(Acc0, _mm256_unpacklo_epi32(Block, Zero));
+        Acc1 = _mm256_add_epi64(Acc1, _mm256_unpackhi_epi32(Block, Zero));
     }
 
-    if ((Length & 2) != 0) {
-        Length -= 2;
-        InitialChecksum += *((uint16_t*)(&Data[Length]));
+    uint64_t Lanes[4];
+    _mm256_storeu_si256((__m256i*)Lanes, _mm256_add_epi64(Acc0, Acc1));
+    for (uint32_t i = 0; i < ARRAYSIZE(Lanes); ++i) {
+        *Sum = CxPlatFramingAddWithCarry(*Sum, Lanes[i]);
     }
+    return Offset;
+}
+#endif // CXPLAT_FRAMING_CHECKSUM_AVX2
+
+#ifdef CXPLAT_FRAMING_CHECKSUM_NEON
+//
+// Sums all the whole 32-byte blocks of Data into Sum and returns the number
+// of bytes consumed. Pairs of 32-bit words are added into 64-bit lanes, so the
+// lanes can't overflow for any buffer shorter than 2^35 bytes.
+//
+static
+uint32_t
+CxPlatFramingChecksumNeon(
+    _In_reads_(Length) const uint8_t* Data,
+    _In_ uint32_t Length,
+    _Inout_ uint64_t* Sum
+    )
+{
+    uint64x2_t Acc0 = vdupq_n_u64(0);
+    uint64x2_t Acc1 = vdupq_n_u64(0);
+    uint32_t Offset = 0;
+    for (; Offset + 32 <= Length; Offset += 32) {
+        Acc0 = vpadalq_u32(Acc0, vld1q_u32((const uint32_t*)(Data + Offset)));
+        Acc1 = vpadalq_u32(Acc1, vld1q_u32((const uint32_t*)(Data + Offset + 16)));
+    }
+
+    const uint64x2_t Acc = vaddq_u64(Acc0, Acc1);
+    *Sum = CxPlatFramingAddWithCarry(*Sum, vgetq_lane_u64(Acc, 0));
+    *Sum = CxPlatFramingAddWithCarry(*Sum, vgetq_lane_u64(Acc, 1));
+    return Offset;
+}
+#endif // CXPLAT_FRAMING_CHECKSUM_NEON
+
+//
+// Adds Data to the unfolded checksum Sum. Data must start at an even offset
+// from the start of the checksummed region.
+//
+static
+uint64_t
+CxPlatFramingChecksumPartial(
+    _In_reads_(Length) const uint8_t* Data,
+    _In_ uint32_t Length,
+    _In_ uint64_t Sum
+    )
+{
+    uint32_t Offset = 0;
 
-    for (uint32_t i = 0; i < Length; i += 4) {
-        InitialChecksum += *((uint32_t*)(&Data[i]));
+#if defined(CXPLAT_FRAMING_CHECKSUM_AVX2)
+    if (CxPlatFramingUseAvx2 && Length >= CXPLAT_FRAMING_CHECKSUM_SIMD_MIN) {
+        Offset = CxPlatFramingChecksumAvx2(Data, Length, &Sum);
     }
+#elif defined(CXPLAT_FRAMING_CHECKSUM_NEON)
+    if (Length >= CXPLAT_FRAMING_CHECKSUM_SIMD_MIN) {
+        Offset = CxPlatFramingChecksumNeon(Data, Length, &Sum);
+    }
+#endif
 
     //
-    // Fold all carries into the final checksum.
+    // Sum up the rest as 64-bit words, then whatever 32-bit word, 16-bit word
+    // and odd byte are left.
     //
-    while (InitialChecksum >> 16) {
-        InitialChecksum = (InitialChecksum & 0xffff) + (InitialChecksum >> 16);
+    for (; Offset + 8 <= Length; Offset += 8) {
+        Sum = CxPlatFramingAddWithCarry(Sum, *((uint64_t*)(&Data[Offset])));
+    }
+
+    if (Offset + 4 <= Length) {
+        Sum = CxPlatFramingAddWithCarry(Sum, *((uint32_t*)(&Data[Offset])));
+        Offset += 4;
+    }
+
+    if (Offset + 2 <= Length) {
+        Sum = CxPlatFramingAddWithCarry(Sum, *((uint16_t*)(&Data[Offset])));
+        Offset += 2;
+    }
+
+    if (Offset < Length) {
+        Sum = CxPlatFramingAddWithCarry(Sum, Data[Offset]);
     }
 
-    return (uint16_t)InitialChecksum;
+    return Sum;
+}
+
+//
+// Folds all carries of the unfolded checksum Sum into 16 bits.
+//
+static
+uint16_t
+CxPlatFramingChecksumFold(
+    _In_ uint64_t Sum
+    )
+{
+    Sum = (Sum & 0xffffffff) + (Sum >> 32);
+    while (Sum >> 16) {
+        Sum = (Sum & 0xffff) + (Sum >> 16);
+    }
+    return (uint16_t)Sum;
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
 uint16_t
-CxPlatFramingTransportChecksum(
-    _In_reads_(AddrLength) uint8_t* SrcAddr,
-    _In_reads_(AddrLength) uint8_t* DstAddr,
+CxPlatFramingChecksum(
+    _In_reads_(Length) uint8_t* Data,
+    _In_ uint32_t Length,
+    _In_ uint64_t InitialChecksum
+    )
+{
+    return
+        CxPlatFramingChecksumFold(
+            CxPlatFramingChecksumPartial(Data, Length, InitialChecksum));
+}
+
+//
+// Returns the unfolded checksum of the transport pseudo header.
+//
+static
+uint64_t
+CxPlatFramingPseudoHeaderChecksum(
+    _In_reads_(AddrLength) const uint8_t* SrcAddr,
+    _In_reads_(AddrLength) const uint8_t* DstAddr,
     _In_ uint32_t AddrLength,
     _In_ uint16_t NextHeader,
-    _In_reads_(IPPayloadLength) uint8_t* IPPayload,
     _In_ uint32_t IPPayloadLength
     )
 {
     uint64_t Checksum =
-        CxPlatFramingChecksum(SrcAddr, AddrLength, 0) +
-        CxPlatFramingChecksum(DstAddr, AddrLength, 0);
-    Checksum += CxPlatByteSwapUint16(NextHeader);
-    Checksum += CxPlatByteSwapUint16((uint16_t)IPPayloadLength);
-
-    //
-    // Pseudoheader is always in 32-bit words. So, cross 16-bit boundary adjustment isn't needed.
-    //
-    return ~CxPlatFramingChecksum(IPPayload, IPPayloadLength, Checksum);
+        CxPlatFramingChecksumPartial(
+            DstAddr, AddrLength, CxPlatFramingChecksumPartial(SrcAddr, AddrLength, 0));
+    Checksum = CxPlatFramingAddWithCarry(Checksum, CxPlatByteSwapUint16(NextHeader));
+    return CxPlatFramingAddWithCarry(Checksum, CxPlatByteSwapUint16((uint16_t)IPPayloadLength));
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -705,6 +873,8 @@ CxPlatFramingWriteHeaders(
     ETHERNET_HEADER* Ethernet;
     uint16_t EthType;
     uint16_t IpHeaderLen;
+    uint64_t PseudoHeaderChecksum;
+    uint16_t TransportChecksum;
     QUIC_ADDRESS_FAMILY Family = QuicAddrGetFamily(&Route->RemoteAddress);
 
     CXPLAT_DBG_ASSERT(
@@ -763,23 +933,12 @@ CxPlatFramingWriteHeaders(
         EthType = ETHERNET_TYPE_IPV4;
         Ethernet = (ETHERNET_HEADER*)(((uint8_t*)IPv4) - sizeof(ETHERNET_HEADER));
         IpHeaderLen = sizeof(IPV4_HEADER);
-        if (!SkipTransportLayerXsum) {
-            if (Socket->UseTcp) {
-                TCP->Checksum =
-                    CxPlatFramingTransportChecksum(
-                        IPv4->Source, IPv4->Destination,
-                        sizeof(Route->LocalAddress.Ipv4.sin_addr),
-                        IPPROTO_TCP,
-                        (uint8_t*)TCP, sizeof(TCP_HEADER) + Buffer->Length);
-            } else {
-                UDP->Checksum =
-                    CxPlatFramingTransportChecksum(
-                        IPv4->Source, IPv4->Destination,
-                        sizeof(Route->LocalAddress.Ipv4.sin_addr),
-                        IPPROTO_UDP,
-                        (uint8_t*)UDP, sizeof(UDP_HEADER) + Buffer->Length);
-            }
-        }
+        PseudoHeaderChecksum =
+            CxPlatFramingPseudoHeaderChecksum(
+                IPv4->Source, IPv4->Destination,
+                sizeof(Route->LocalAddress.Ipv4.sin_addr),
+                TransportProtocol,
+                TransportLength + Buffer->Length);
     } else {
         IPV6_HEADER* IPv6 = (IPV6_HEADER*)(Transport - sizeof(IPV6_HEADER));
         //
@@ -810,25 +969,33 @@ CxPlatFramingWriteHeaders(
         EthType = ETHERNET_TYPE_IPV6;
         Ethernet = (ETHERNET_HEADER*)(((uint8_t*)IPv6) - sizeof(ETHERNET_HEADER));
         IpHeaderLen = sizeof(IPV6_HEADER);
-        if (!SkipTransportLayerXsum) {
-            if (Socket->UseTcp) {
-                TCP->Checksum =
-                    CxPlatFramingTransportChecksum(
-                        IPv6->Source, IPv6->Destination,
-                        sizeof(Route->LocalAddress.Ipv6.sin6_addr),
-                        IPPROTO_TCP,
-                        (uint8_t*)TCP, sizeof(TCP_HEADER) + Buffer->Length);
-            } else {
-                UDP->Checksum =
-                    CxPlatFramingTransportChecksum(
-                        IPv6->Source, IPv6->Destination,
-                        sizeof(Route->LocalAddress.Ipv6.sin6_addr),
-                        IPPROTO_UDP,
-                        (uint8_t*)UDP, sizeof(UDP_HEADER) + Buffer->Length);
-                UDP->Checksum = UDP->Checksum != 0 ? UDP->Checksum : ~0;
-            }
+        PseudoHeaderChecksum =
+            CxPlatFramingPseudoHeaderChecksum(
+                IPv6->Source, IPv6->Destination,
+                sizeof(Route->LocalAddress.Ipv6.sin6_addr),
+                TransportProtocol,
+                TransportLength + Buffer->Length);
+    }
+
+    if (SkipTransportLayerXsum) {
+        //
+        // The NIC computes the checksum, starting from the (not inverted)
+        // pseudo header checksum in the checksum field.
+        //
+        TransportChecksum = CxPlatFramingChecksumFold(PseudoHeaderChecksum);
+    } else {
+        TransportChecksum =
+            ~CxPlatFramingChecksum(
+                Transport, TransportLength + Buffer->Length, PseudoHeaderChecksum);
+        if (TransportChecksum == 0 && !Socket->UseTcp) {
+            TransportChecksum = 0xFFFF; // Zero means no checksum for UDP.
         }
     }
+    if (Socket->UseTcp) {
+        TCP->Checksum = TransportChecksum;
+    } else {
+        UDP->Checksum = TransportChecksum;
+    }
 
     //
     // Fill Ethernet header.
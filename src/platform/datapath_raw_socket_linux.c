@@ -42,6 +42,110 @@ CxPlatSockPoolUninitialize(
     CxPlatHashtableUninitialize(&Pool->Sockets);
 }
 
+//
+// Route and neighbor cache
+//
+
+QUIC_STATUS
+CxPlatRouteCacheCreate(
+    _Out_ CXPLAT_ROUTE_CACHE** NewCache
+    )
+{
+    CXPLAT_ROUTE_CACHE* Cache =
+        CXPLAT_ALLOC_NONPAGED(sizeof(CXPLAT_ROUTE_CACHE), QUIC_POOL_ROUTE_CACHE);
+    if (Cache == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "CXPLAT_ROUTE_CACHE",
+            sizeof(CXPLAT_ROUTE_CACHE));
+        return QUIC_STATUS_OUT_OF_MEMORY;
+    }
+    CxPlatZeroMemory(Cache, sizeof(CXPLAT_ROUTE_CACHE));
+    CxPlatLockInitialize(&Cache->Lock);
+
+    int Error;
+    Cache->SyncSocket = nl_socket_alloc();
+    if (Cache->SyncSocket == NULL) {
+        Error = -NLE_NOMEM;
+    } else if ((Error = nl_connect(Cache->SyncSocket, NETLINK_ROUTE)) >= 0 &&
+        (Error = nl_cache_mngr_alloc(NULL, NETLINK_ROUTE, NL_AUTO_PROVIDE, &Cache->Manager)) >= 0 &&
+        (Error = nl_cache_mngr_add(Cache->Manager, "route/route", NULL, NULL, &Cache->Routes)) >= 0) {
+        Error = nl_cache_mngr_add(Cache->Manager, "route/neigh", NULL, NULL, &Cache->Neighbors);
+    }
+
+    if (Error < 0) {
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            (uint32_t)-Error,
+            "Creating the netlink route cache");
+        CxPlatRouteCacheDelete(Cache);
+        return QUIC_STATUS_INTERNAL_ERROR;
+    }
+
+    *NewCache = Cache;
+    return QUIC_STATUS_SUCCESS;
+}
+
+void
+CxPlatRouteCacheDelete(
+    _In_ CXPLAT_ROUTE_CACHE* Cache
+    )
+{
+    if (Cache->Manager != NULL) {
+        nl_cache_mngr_free(Cache->Manager); // Also frees the caches.
+    }
+    if (Cache->SyncSocket != NULL) {
+        nl_socket_free(Cache->SyncSocket);
+    }
+    CxPlatLockUninitialize(&Cache->Lock);
+    CXPLAT_FREE(Cache, QUIC_POOL_ROUTE_CACHE);
+}
+
+void
+CxPlatRouteCacheRefresh(
+    _In_ CXPLAT_ROUTE_CACHE* Cache
+    )
+{
+    CxPlatLockAcquire(&Cache->Lock);
+    if (nl_cache_mngr_data_ready(Cache->Manager) < 0) {
+        //
+        // Notifications were lost (most likely the socket's buffer overflowed),
+        // so the caches can't be trusted anymore. Reload them.
+        //
+        (void)nl_cache_refill(Cache->SyncSocket, Cache->Routes);
+        (void)nl_cache_refill(Cache->SyncSocket, Cache->Neighbors);
+    }
+    CxPlatLockRelease(&Cache->Lock);
+}
+
+void
+CxPlatRouteCacheProbeNeighbor(
+    _In_ const QUIC_ADDR* Address,
+    _In_ int IfIndex
+    )
+{
+    //
+    // Sending anything to the neighbor through the kernel's stack makes the
+    // kernel resolve it. An empty datagram to the discard port will do.
+    //
+    QUIC_ADDR Target = *Address;
+    QuicAddrSetPort(&Target, 9);
+    if (Target.Ip.sa_family == AF_INET6 && IN6_IS_ADDR_LINKLOCAL(&Target.Ipv6.sin6_addr)) {
+        Target.Ipv6.sin6_scope_id = (uint32_t)IfIndex;
+    }
+
+    int Socket = socket(Target.Ip.sa_family, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, IPPROTO_UDP);
+    if (Socket < 0) {
+        return;
+    }
+    (void)sendto(
+        Socket, NULL, 0, 0, &Target.Ip,
+        Target.Ip.sa_family == AF_INET ? sizeof(Target.Ipv4) : sizeof(Target.Ipv6));
+    close(Socket);
+}
+
 struct BestMacthL3 {
     struct nl_addr *dst;
     struct rtnl_route *BestMatch;
@@ -52,7 +156,8 @@ void FindBestMatchL3(struct nl_object *obj, void *arg) {
     struct rtnl_route *route = (struct rtnl_route *) obj;
     struct BestMacthL3 *data = (struct BestMacthL3 *)arg;
     struct nl_addr *dst_addr = rtnl_route_get_dst(route);
-    if (nl_addr_cmp_prefix(data->dst, dst_addr) == 0) {
+    if (nl_addr_get_family(dst_addr) == nl_addr_get_family(data->dst) &&
+        nl_addr_cmp_prefix(data->dst, dst_addr) == 0) {
         int prefixLen = nl_addr_get_prefixlen(dst_addr);
         if (prefixLen > data->BestPrefixLen) {
             data->BestPrefixLen = prefixLen;
@@ -61,8 +166,10 @@ void FindBestMatchL3(struct nl_object *obj, void *arg) {
     }
 }
 
+static
 QUIC_STATUS
-ResolveBestL3Route(
+FindBestL3Route(
+    struct nl_cache* cache,
     QUIC_ADDR* RemoteAddress,
     QUIC_ADDR* SourceAddress,
     QUIC_ADDR* GatewayAddress,
@@ -70,35 +177,13 @@ ResolveBestL3Route(
     )
 {
     QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
-    struct nl_sock *sock = NULL;
-    struct nl_cache *cache = NULL;
     struct nl_addr *dst = NULL;
 
-    sock = nl_socket_alloc();
-    if (!sock) {
-        return QUIC_STATUS_INTERNAL_ERROR;
-    }
-
-    if (nl_connect(sock, NETLINK_ROUTE) < 0) {
-        nl_socket_free(sock);
-        return QUIC_STATUS_INTERNAL_ERROR;
-    }
-
-    // Allocate the route cache
-    if (rtnl_route_alloc_cache(sock, RemoteAddress->Ip.sa_family, 0, &cache) < 0) {
-        nl_close(sock);
-        nl_socket_free(sock);
-        return QUIC_STATUS_INTERNAL_ERROR;
-    }
-
     // Create destination address from input
     dst = nl_addr_build(RemoteAddress->Ip.sa_family,
                         RemoteAddress->Ip.sa_family == AF_INET ? (void*)&RemoteAddress->Ipv4.sin_addr : (void*)&RemoteAddress->Ipv6.sin6_addr,
                         RemoteAddress->Ip.sa_family == AF_INET ? sizeof(struct in_addr) : sizeof(struct in6_addr));
     if (!dst) {
-        nl_cache_free(cache);
-        nl_close(sock);
-        nl_socket_free(sock);
         return QUIC_STATUS_INTERNAL_ERROR;
     }
 
@@ -153,9 +238,56 @@ ResolveBestL3Route(
     }
 
 Error:
-    // Clean up
     nl_addr_put(dst);
-    nl_cache_free(cache); // TODO: reuse cache
+    return Status;
+}
+
+QUIC_STATUS
+ResolveBestL3Route(
+    _In_opt_ CXPLAT_ROUTE_CACHE* Cache,
+    QUIC_ADDR* RemoteAddress,
+    QUIC_ADDR* SourceAddress,
+    QUIC_ADDR* GatewayAddress,
+    int* oif
+    )
+{
+    QUIC_STATUS Status;
+
+    if (Cache != NULL) {
+        CxPlatRouteCacheRefresh(Cache);
+        CxPlatLockAcquire(&Cache->Lock);
+        Status = FindBestL3Route(Cache->Routes, RemoteAddress, SourceAddress, GatewayAddress, oif);
+        CxPlatLockRelease(&Cache->Lock);
+        return Status;
+    }
+
+    //
+    // Without a cache, dump the routing table for this lookup.
+    //
+    struct nl_sock *sock = NULL;
+    struct nl_cache *cache = NULL;
+
+    sock = nl_socket_alloc();
+    if (!sock) {
+        return QUIC_STATUS_INTERNAL_ERROR;
+    }
+
+    if (nl_connect(sock, NETLINK_ROUTE) < 0) {
+        nl_socket_free(sock);
+        return QUIC_STATUS_INTERNAL_ERROR;
+    }
+
+    // Allocate the route cache
+    if (rtnl_route_alloc_cache(sock, RemoteAddress->Ip.sa_family, 0, &cache) < 0) {
+        nl_close(sock);
+        nl_socket_free(sock);
+        return QUIC_STATUS_INTERNAL_ERROR;
+    }
+
+    Status = FindBestL3Route(cache, RemoteAddress, SourceAddress, GatewayAddress, oif);
+
+    // Clean up
+    nl_cache_free(cache);
     nl_close(sock);
     nl_socket_free(sock);
 
@@ -165,49 +297,40 @@ Error:
 struct BestMacthL2 {
     struct nl_addr* NlRemoteAddr;
     uint8_t* NextHopLinkLayerAddress;
+    BOOLEAN Found;
 } BestMacthL2;
 
+//
+// Neighbor entry states with a usable link-layer address.
+//
+#define NEIGH_STATE_VALID \
+    (NUD_REACHABLE | NUD_STALE | NUD_DELAY | NUD_PROBE | NUD_PERMANENT | NUD_NOARP)
+
 void FindBestMacthL2(struct nl_object *obj, void *arg) {
     struct BestMacthL2* data = (struct BestMacthL2*)arg;
     struct rtnl_neigh* neigh = (struct rtnl_neigh*) obj;
     struct nl_addr* neigh_addr = rtnl_neigh_get_dst(neigh);
 
-    if (nl_addr_cmp(neigh_addr, data->NlRemoteAddr) == 0) {
+    if (!data->Found &&
+        nl_addr_cmp(neigh_addr, data->NlRemoteAddr) == 0 &&
+        (rtnl_neigh_get_state(neigh) & NEIGH_STATE_VALID) != 0) {
         struct nl_addr* lladdr = rtnl_neigh_get_lladdr(neigh);
-        int* Address = nl_addr_get_binary_addr(lladdr);
-        if (Address != NULL) {
-            memcpy(data->NextHopLinkLayerAddress, Address, 6);
+        if (lladdr != NULL && nl_addr_get_len(lladdr) == 6) {
+            memcpy(data->NextHopLinkLayerAddress, nl_addr_get_binary_addr(lladdr), 6);
+            data->Found = TRUE;
         }
     }
 }
 
 QUIC_STATUS
 ResolveRemotePhysicalAddress(
+    _In_opt_ CXPLAT_ROUTE_CACHE* Cache,
     QUIC_ADDR* RemoteAddr,
     uint8_t NextHopLinkLayerAddress[6])
 {
-    QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
-    struct nl_sock *sock;
+    struct nl_sock *sock = NULL;
     struct nl_cache *cache;
 
-    sock = nl_socket_alloc();
-    if (sock == NULL) {
-        return QUIC_STATUS_INTERNAL_ERROR;
-    }
-
-    // Connect the socket
-    if (nl_connect(sock, NETLINK_ROUTE)) {
-        nl_socket_free(sock);
-        return QUIC_STATUS_INTERNAL_ERROR;
-    }
-
-    // Allocate the cache
-    if (rtnl_neigh_alloc_cache(sock, &cache)) {
-        nl_socket_free(sock);
-        return QUIC_STATUS_INTERNAL_ERROR;
-    }
-
-    // Loop over the cache entries
     struct nl_addr *NlRemoteAddr = NULL;
     if (RemoteAddr->Ip.sa_family == AF_INET) {
         NlRemoteAddr = nl_addr_build(AF_INET, &RemoteAddr->Ipv4.sin_addr, sizeof(struct in_addr));
@@ -216,16 +339,53 @@ ResolveRemotePhysicalAddress(
     } else {
         CXPLAT_FRE_ASSERT(FALSE);
     }
+    if (NlRemoteAddr == NULL) {
+        return QUIC_STATUS_OUT_OF_MEMORY;
+    }
+
     struct BestMacthL2 data;
     data.NlRemoteAddr = NlRemoteAddr;
     data.NextHopLinkLayerAddress = NextHopLinkLayerAddress;
-    nl_cache_foreach(cache, FindBestMacthL2, &data);
+    data.Found = FALSE;
 
-    // Free up memory
-    nl_cache_free(cache); // TODO: reuse cache
-    nl_socket_free(sock);
+    if (Cache != NULL) {
+        CxPlatLockAcquire(&Cache->Lock);
+        nl_cache_foreach(Cache->Neighbors, FindBestMacthL2, &data);
+        CxPlatLockRelease(&Cache->Lock);
 
-    return Status;
+    } else {
+        //
+        // Without a cache, dump the neighbor table for this lookup.
+        //
+        sock = nl_socket_alloc();
+        if (sock == NULL) {
+            nl_addr_put(NlRemoteAddr);
+            return QUIC_STATUS_INTERNAL_ERROR;
+        }
+
+        // Connect the socket
+        if (nl_connect(sock, NETLINK_ROUTE)) {
+            nl_socket_free(sock);
+            nl_addr_put(NlRemoteAddr);
+            return QUIC_STATUS_INTERNAL_ERROR;
+        }
+
+        // Allocate the cache
+        if (rtnl_neigh_alloc_cache(sock, &cache)) {
+            nl_socket_free(sock);
+            nl_addr_put(NlRemoteAddr);
+            return QUIC_STATUS_INTERNAL_ERROR;
+        }
+
+        nl_cache_foreach(cache, FindBestMacthL2, &data);
+
+        // Free up memory
+        nl_cache_free(cache);
+        nl_socket_free(sock);
+    }
+
+    nl_addr_put(NlRemoteAddr);
+    return data.Found ? QUIC_STATUS_SUCCESS : QUIC_STATUS_NOT_FOUND;
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -238,8 +398,9 @@ RawResolveRoute(
     _In_ CXPLAT_ROUTE_RESOLUTION_CALLBACK_HANDLER Callback
     )
 {
-    UNREFERENCED_PARAMETER(Callback);
     QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
+    CXPLAT_ROUTE_RESOLUTION_WORKER* Worker = Socket->RawDatapath->RouteResolutionWorker;
+    CXPLAT_ROUTE_STATE State = Route->State;
 
     CXPLAT_DBG_ASSERT(!QuicAddrIsWildCard(&Route->RemoteAddress));
 
@@ -255,7 +416,7 @@ RawResolveRoute(
     QUIC_ADDR NextHop = {0};
     int oif = -1;
     // get best next hop
-    Status = ResolveBestL3Route(&Route->RemoteAddress, &Route->LocalAddress, &NextHop, &oif);
+    Status = ResolveBestL3Route(Worker->Cache, &Route->RemoteAddress, &Route->LocalAddress, &NextHop, &oif);
     if (QUIC_FAILED(Status)) {
         QuicTraceEvent(
             DatapathErrorStatus,
@@ -263,7 +424,7 @@ RawResolveRoute(
             Socket,
             Status,
             "ResolveBestL3Route");
-        return Status;
+        goto Done;
     }
 
     // get local IP and mac
@@ -278,17 +439,6 @@ RawResolveRoute(
         }
     }
 
-    // get remote mac
-    Status = ResolveRemotePhysicalAddress(&NextHop, Route->NextHopLinkLayerAddress);
-    if (QUIC_FAILED(Status)) {
-        QuicTraceEvent(
-            DatapathErrorStatus,
-            "[data][%p] ERROR, %u, %s.",
-            Socket,
-            Status,
-            "ResolveRemotePhysicalAddress");
-        return Status;
-    }
     QuicTraceEvent(
         DatapathResoveShow,
         "[data][%p] Route resolution completed, local=%!ADDR!, remote=%!ADDR!, nexthop=%!ADDR!, iface=%d",
@@ -298,8 +448,60 @@ RawResolveRoute(
         CASTED_CLOG_BYTEARRAY(sizeof(NextHop), &NextHop),
         oif);
 
-    CxPlatResolveRouteComplete(Context, Route, Route->NextHopLinkLayerAddress, PathId);
+    //
+    // Use the next hop's neighbor entry if it's usable, unless it's the one a
+    // suspected route already has. Otherwise, the route worker has the kernel
+    // (re)resolve the neighbor and completes the route once it has, so the
+    // connection's worker doesn't wait for it.
+    //
+    uint8_t NextHopLinkLayerAddress[6];
+    Status = ResolveRemotePhysicalAddress(Worker->Cache, &NextHop, NextHopLinkLayerAddress);
+    if (Status == QUIC_STATUS_NOT_FOUND ||
+        (QUIC_SUCCEEDED(Status) &&
+         State == RouteSuspected &&
+         memcmp(
+             Route->NextHopLinkLayerAddress,
+             NextHopLinkLayerAddress,
+             sizeof(Route->NextHopLinkLayerAddress)) == 0)) {
+        CXPLAT_ROUTE_RESOLUTION_OPERATION* Operation = CxPlatPoolAlloc(&Worker->OperationPool);
+        if (Operation == NULL) {
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "CXPLAT_DATAPATH",
+                sizeof(CXPLAT_ROUTE_RESOLUTION_OPERATION));
+            Status = QUIC_STATUS_OUT_OF_MEMORY;
+            goto Done;
+        }
+        Operation->NextHop = NextHop;
+        Operation->IfIndex = oif;
+        Operation->StartTimeUs = CxPlatTimeUs64();
+        Operation->Probed = FALSE;
+        Operation->Context = Context;
+        Operation->Callback = Callback;
+        Operation->PathId = PathId;
+        CxPlatDispatchLockAcquire(&Worker->Lock);
+        CxPlatListInsertTail(&Worker->Operations, &Operation->WorkerLink);
+        CxPlatDispatchLockRelease(&Worker->Lock);
+        CxPlatEventSet(Worker->Ready);
+        Status = QUIC_STATUS_PENDING;
+
+    } else if (QUIC_SUCCEEDED(Status)) {
+        CxPlatResolveRouteComplete(Context, Route, NextHopLinkLayerAddress, PathId);
+
+    } else {
+        QuicTraceEvent(
+            DatapathErrorStatus,
+            "[data][%p] ERROR, %u, %s.",
+            Socket,
+            Status,
+            "ResolveRemotePhysicalAddress");
+    }
+
+Done:
+    if (QUIC_FAILED(Status)) {
+        Callback(Context, NULL, PathId, FALSE);
+    }
 
     return Status;
 }
-
@@ -41,6 +41,18 @@ typedef struct XDP_INTERFACE_COMMON {
     const struct XDP_DATAPATH* Xdp;
 } XDP_INTERFACE_COMMON;
 
+//
+// Counters kept by the datapath itself, as opposed to the ones the kernel keeps
+// for the socket. Readers take an unsynchronized snapshot.
+//
+typedef struct XDP_QUEUE_STATISTICS {
+    uint64_t RxPackets;
+    uint64_t TxPackets;
+    uint64_t RxFillStarved;
+    uint64_t TxRingFull;
+    uint64_t TxBufferExhausted;
+} XDP_QUEUE_STATISTICS;
+
 typedef struct XDP_QUEUE_COMMON {
     const XDP_INTERFACE* Interface;
     XDP_PARTITION* Partition;
@@ -48,6 +60,7 @@ typedef struct XDP_QUEUE_COMMON {
     BOOLEAN RxQueued;
     BOOLEAN TxQueued;
     BOOLEAN Error;
+    XDP_QUEUE_STATISTICS Stats;
 } XDP_QUEUE_COMMON;
 
 typedef struct QUIC_CACHEALIGN XDP_PARTITION {
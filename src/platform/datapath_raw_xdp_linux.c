@@ -14,14 +14,17 @@ Abstract:
 #include "bpf.h"
 #include "datapath_raw_linux.h"
 #include "datapath_raw_xdp.h"
+#include "quic_versions.h"
 #include "libbpf.h"
 #include "libxdp.h"
 #include "xsk.h"
 #include <dirent.h>
+#include <dlfcn.h>
 #include <libgen.h>
 #include <linux/ethtool.h>
 #include <linux/sockios.h>
 #include <netpacket/packet.h>
+#include <sys/mman.h>
 
 #ifdef QUIC_CLOG
 #include "datapath_raw_xdp_linux.c.clog.h"
@@ -33,25 +36,60 @@ Abstract:
 #define PROD_NUM_DESCS     NUM_FRAMES / 2
 #define FRAME_SIZE         XSK_UMEM__DEFAULT_FRAME_SIZE // TODO: 2K mode
 #define INVALID_UMEM_FRAME UINT64_MAX
+#define UMEM_HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
+//
+// There is no common kernel interface for inline QUIC crypto on Linux, so QUIC
+// encryption offload (QEO) goes through an optional, NIC specific provider
+// library. The provider exports XDP_QEO_SET_FN_NAME, which adds or removes the
+// given connection offloads on an interface and returns 0 or a negative errno.
+//
+#define XDP_QEO_PROVIDER_NAME "libmsquic_qeo.so"
+#define XDP_QEO_SET_FN_NAME   "MsQuicQeoSet"
+
+typedef
+int
+XDP_QEO_SET_FN(
+    _In_ uint32_t IfIndex,
+    _In_reads_(OffloadCount)
+        const CXPLAT_QEO_CONNECTION* Offloads,
+    _In_ uint32_t OffloadCount
+    );
 
 struct XskSocketInfo {
     struct xsk_ring_cons Rx;
     struct xsk_ring_prod Tx;
+    struct xsk_ring_prod Fq;
+    struct xsk_ring_cons Cq;
     struct XskUmemInfo *UmemInfo;
     struct xsk_socket *Xsk;
 
-    CXPLAT_LOCK UmemLock;
-    uint64_t UmemFrameAddr[NUM_FRAMES];
-    uint32_t UmemFrameFree;
+    //
+    // The number of frames the socket keeps posted to its fill ring: its share
+    // of the UMEM. The rest of the frames float between the sockets sharing
+    // the UMEM as they're received into, sent from and completed.
+    //
+    uint32_t FillTarget;
 };
 
+//
+// A UMEM is shared (XDP_SHARED_UMEM) by the queues of one interface that are
+// polled by the same partition, so that they draw from one pool of frames
+// instead of each pinning a UMEM sized for the worst case.
+//
 struct XskUmemInfo {
-    struct xsk_ring_prod Fq;
-    struct xsk_ring_cons Cq;
     struct xsk_umem *Umem;
     void *Buffer;
+    uint64_t BufferSize;
     uint32_t RxHeadRoom;
     uint32_t TxHeadRoom;
+    BOOLEAN HugePages; // Buffer was mmap'ed from huge pages.
+    uint32_t SocketCount; // Sockets expected to share the UMEM.
+    uint32_t RefCount;    // Queues currently using the UMEM.
+
+    CXPLAT_LOCK Lock;
+    uint64_t FrameAddr[NUM_FRAMES];
+    uint32_t FrameFree;
 };
 
 // TODO: remove this exception when finalizing members
@@ -69,6 +107,10 @@ typedef struct XDP_DATAPATH { // NOLINT(clang-analyzer-optin.performance.Padding
     BOOLEAN TxAlwaysPoke;
     BOOLEAN SkipXsum;
     BOOLEAN Running;        // Signal to stop workers.
+    BOOLEAN CidFlowSteering; // Steer listener packets to queues by CID partition.
+
+    void* QeoProvider;
+    XDP_QEO_SET_FN* XdpQeoSet;
 
     CXPLAT_RUNDOWN_REF Rundown;
     XDP_PARTITION Partitions[0];
@@ -83,6 +125,14 @@ typedef struct XDP_INTERFACE {
     struct in_addr Ipv4Address;
     struct in6_addr Ipv6Address;
     char IfName[IFNAMSIZ];
+
+    //
+    // The ntuple rules steering a listener port's packets to the queue of the
+    // partition in their CID. Only one port per interface is steered.
+    //
+    uint16_t FlowSteeringPort; // Network byte order. Zero if not steering.
+    uint16_t FlowRuleCount;
+    uint32_t* FlowRuleLocations;
 } XDP_INTERFACE;
 
 typedef struct XDP_QUEUE {
@@ -204,6 +254,63 @@ CxPlatXdpReadConfig(
     Xdp->TxAlwaysPoke = FALSE;
 }
 
+//
+// Loads the QEO provider, if one is installed. MSQUIC_XDP_QEO_PROVIDER_PATH
+// overrides the default library search.
+//
+void
+CxPlatXdpLoadQeoProvider(
+    _Inout_ XDP_DATAPATH* Xdp
+    )
+{
+    const char* EnvPath = getenv("MSQUIC_XDP_QEO_PROVIDER_PATH");
+    const char* FilePath = EnvPath != NULL ? EnvPath : XDP_QEO_PROVIDER_NAME;
+
+    Xdp->XdpQeoSet = NULL;
+    Xdp->QeoProvider = dlopen(FilePath, RTLD_NOW | RTLD_LOCAL);
+    if (Xdp->QeoProvider == NULL) {
+        return; // No provider means QEO is simply not supported.
+    }
+
+    Xdp->XdpQeoSet = (XDP_QEO_SET_FN*)dlsym(Xdp->QeoProvider, XDP_QEO_SET_FN_NAME);
+    if (Xdp->XdpQeoSet == NULL) {
+        QuicTraceEvent(
+            LibraryError,
+            "[ lib] ERROR, %s.",
+            "QEO provider is missing " XDP_QEO_SET_FN_NAME);
+        dlclose(Xdp->QeoProvider);
+        Xdp->QeoProvider = NULL;
+        return;
+    }
+
+    QuicTraceLogVerbose(
+        XdpQeoProviderLoaded,
+        "[ xdp] Loaded QEO provider %s",
+        FilePath);
+}
+
+void
+CxPlatXdpUnloadQeoProvider(
+    _Inout_ XDP_DATAPATH* Xdp
+    )
+{
+    if (Xdp->QeoProvider != NULL) {
+        dlclose(Xdp->QeoProvider);
+        Xdp->QeoProvider = NULL;
+        Xdp->XdpQeoSet = NULL;
+    }
+}
+
+static void FreeUmemBuffer(struct XskUmemInfo* UmemInfo)
+{
+    if (UmemInfo->HugePages) {
+        munmap(UmemInfo->Buffer, UmemInfo->BufferSize);
+    } else {
+        free(UmemInfo->Buffer);
+    }
+    UmemInfo->Buffer = NULL;
+}
+
 void UninitializeUmem(struct XskUmemInfo* UmemInfo)
 {
     if (xsk_umem__delete(UmemInfo->Umem) != 0) {
@@ -211,7 +318,8 @@ void UninitializeUmem(struct XskUmemInfo* UmemInfo)
             XdpUmemDeleteFails,
             "[ xdp] Failed to delete Umem");
     }
-    free(UmemInfo->Buffer);
+    FreeUmemBuffer(UmemInfo);
+    CxPlatLockUninitialize(&UmemInfo->Lock);
     free(UmemInfo);
 }
 
@@ -262,10 +370,9 @@ CxPlatDpRawInterfaceUninitialize(
                 }
                 xsk_socket__delete(Queue->XskInfo->Xsk);
             }
-            if (Queue->XskInfo->UmemInfo) {
+            if (Queue->XskInfo->UmemInfo && --Queue->XskInfo->UmemInfo->RefCount == 0) {
                 UninitializeUmem(Queue->XskInfo->UmemInfo);
             }
-            CxPlatLockUninitialize(&Queue->XskInfo->UmemLock);
             free(Queue->XskInfo);
         }
 
@@ -279,6 +386,10 @@ CxPlatDpRawInterfaceUninitialize(
         CxPlatFree(Interface->Queues, QUEUE_TAG);
     }
 
+    if (Interface->FlowRuleLocations != NULL) {
+        CxPlatFree(Interface->FlowRuleLocations, RULE_TAG);
+    }
+
     DetachXdpProgram(Interface, false);
 
     if (Interface->XdpProg) {
@@ -290,15 +401,46 @@ CxPlatDpRawInterfaceUninitialize(
     }
 }
 
-static QUIC_STATUS InitializeUmem(uint32_t FrameSize, uint32_t NumFrames, uint32_t RxHeadRoom, uint32_t TxHeadRoom, struct XskUmemInfo* UmemInfo)
+//
+// Creates the UMEM along with the fill and completion rings of the first socket
+// to use it.
+//
+static QUIC_STATUS InitializeUmem(uint32_t FrameSize, uint32_t NumFrames, uint32_t RxHeadRoom, uint32_t TxHeadRoom, struct XskUmemInfo* UmemInfo, struct XskSocketInfo* XskInfo)
 {
     void *Buffer = NULL;
-    if (posix_memalign(&Buffer, getpagesize(), (size_t)(FrameSize) * NumFrames)) {
+    const uint64_t BufferSize = (uint64_t)(FrameSize) * NumFrames;
+
+    //
+    // Prefer backing the UMEM with huge pages, which saves the NIC (and the
+    // kernel when pinning) from walking thousands of 4K pages. This requires
+    // huge pages to be reserved on the system, so fall back to regular pages.
+    //
+    UmemInfo->HugePages = FALSE;
+    if (BufferSize % UMEM_HUGE_PAGE_SIZE == 0) {
+        Buffer =
+            mmap(
+                NULL,
+                BufferSize,
+                PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+                -1,
+                0);
+        if (Buffer != MAP_FAILED) {
+            UmemInfo->HugePages = TRUE;
+        } else {
+            Buffer = NULL;
+        }
+    }
+
+    if (Buffer == NULL &&
+        posix_memalign(&Buffer, getpagesize(), BufferSize)) {
         QuicTraceLogVerbose(
             XdpAllocUmem,
             "[ xdp] Failed to allocate umem");
         return QUIC_STATUS_OUT_OF_MEMORY;
     }
+    UmemInfo->Buffer = Buffer;
+    UmemInfo->BufferSize = BufferSize;
 
     struct xsk_umem_config UmemConfig = {
         .fill_size = PROD_NUM_DESCS,
@@ -308,42 +450,81 @@ static QUIC_STATUS InitializeUmem(uint32_t FrameSize, uint32_t NumFrames, uint32
         .flags = 0
     };
 
-    int Ret = xsk_umem__create(&UmemInfo->Umem, Buffer, (uint64_t)(FrameSize) * NumFrames, &UmemInfo->Fq, &UmemInfo->Cq, &UmemConfig);
+    int Ret = xsk_umem__create(&UmemInfo->Umem, Buffer, BufferSize, &XskInfo->Fq, &XskInfo->Cq, &UmemConfig);
     if (Ret) {
         errno = -Ret;
-        free(Buffer);
+        FreeUmemBuffer(UmemInfo);
         return QUIC_STATUS_INTERNAL_ERROR;
     }
 
-    UmemInfo->Buffer = Buffer;
     UmemInfo->RxHeadRoom = RxHeadRoom;
     UmemInfo->TxHeadRoom = TxHeadRoom;
+    CxPlatLockInitialize(&UmemInfo->Lock);
+    for (uint32_t i = 0; i < NumFrames; i++) {
+        UmemInfo->FrameAddr[i] = (uint64_t)i * FrameSize;
+    }
+    UmemInfo->FrameFree = NumFrames;
     return QUIC_STATUS_SUCCESS;
 }
 
-static uint64_t XskUmemFreeFrames(struct XskSocketInfo *Xsk)
+static uint64_t XskUmemFreeFrames(struct XskUmemInfo *UmemInfo)
 {
-    return Xsk->UmemFrameFree;
+    return UmemInfo->FrameFree;
 }
 
-static uint64_t XskUmemFrameAlloc(struct XskSocketInfo *Xsk)
+static uint64_t XskUmemFrameAlloc(struct XskUmemInfo *UmemInfo)
 {
     uint64_t Frame;
-    if (Xsk->UmemFrameFree == 0) {
+    if (UmemInfo->FrameFree == 0) {
         QuicTraceLogVerbose(
             XdpUmemAllocFails,
             "[ xdp][umem] Out of UMEM frame, OOM");
         return INVALID_UMEM_FRAME;
     }
-    Frame = Xsk->UmemFrameAddr[--Xsk->UmemFrameFree];
-    Xsk->UmemFrameAddr[Xsk->UmemFrameFree] = INVALID_UMEM_FRAME;
+    Frame = UmemInfo->FrameAddr[--UmemInfo->FrameFree];
+    UmemInfo->FrameAddr[UmemInfo->FrameFree] = INVALID_UMEM_FRAME;
     return Frame;
 }
 
-static void XskUmemFrameFree(struct XskSocketInfo *Xsk, uint64_t Frame)
+static void XskUmemFrameFree(struct XskUmemInfo *UmemInfo, uint64_t Frame)
 {
-    assert(Xsk->UmemFrameFree < NUM_FRAMES);
-    Xsk->UmemFrameAddr[Xsk->UmemFrameFree++] = Frame;
+    assert(UmemInfo->FrameFree < NUM_FRAMES);
+    UmemInfo->FrameAddr[UmemInfo->FrameFree++] = Frame;
+}
+
+//
+// Creates the queue's AF_XDP socket on the UMEM in XskInfo->UmemInfo, binding it
+// with XDP_SHARED_UMEM if another socket already uses the UMEM.
+//
+static
+int
+XskSocketCreate(
+    _In_ XDP_INTERFACE* Interface,
+    _In_ uint16_t QueueId,
+    _Inout_ struct XskSocketInfo* XskInfo,
+    _In_ BOOLEAN Shared
+    )
+{
+    struct xsk_socket_config *XskCfg = Interface->XskCfg;
+    int RetryCount = 10;
+    int Ret = 0;
+    do {
+        Ret = xsk_socket__create_shared(&XskInfo->Xsk, Interface->IfName,
+                    QueueId, XskInfo->UmemInfo->Umem, &XskInfo->Rx,
+                    &XskInfo->Tx, &XskInfo->Fq, &XskInfo->Cq, XskCfg);
+        if (Ret == -EBUSY) {
+            CxPlatSleep(100);
+        } else if (Ret < 0 && !Shared && (XskCfg->bind_flags & XDP_ZEROCOPY)) {
+            //
+            // The driver doesn't support zero-copy for this interface. Sockets
+            // sharing a UMEM inherit the mode of its first socket.
+            //
+            XskCfg->bind_flags &= ~XDP_ZEROCOPY;
+            XskCfg->bind_flags |= XDP_COPY;
+            Ret = -EBUSY;
+        }
+    } while (Ret == -EBUSY && RetryCount-- > 0);
+    return Ret;
 }
 
 QUIC_STATUS
@@ -473,11 +654,12 @@ CxPlatDpRawInterfaceInitialize(
     XskCfg->rx_size = CONS_NUM_DESCS;
     XskCfg->tx_size = PROD_NUM_DESCS;
     XskCfg->libbpf_flags = XSK_LIBBPF_FLAGS__INHIBIT_PROG_LOAD;
-    // TODO: check ZEROCOPY feature, change Tx/Rx behavior based on feature
-    //       refer xdp-tools/xdp-loader/xdp-loader features <ifname>
-    XskCfg->bind_flags &= ~XDP_ZEROCOPY;
-    XskCfg->bind_flags |= XDP_COPY;
-    XskCfg->bind_flags |= XDP_USE_NEED_WAKEUP;
+    //
+    // Start out trying zero-copy mode. If the driver doesn't support it, the
+    // first bind fails and the interface falls back to copy mode for all its
+    // queues.
+    //
+    XskCfg->bind_flags = XDP_ZEROCOPY | XDP_USE_NEED_WAKEUP;
     Interface->XskCfg = XskCfg;
 
     DetachXdpProgram(Interface, true);
@@ -536,46 +718,62 @@ CxPlatDpRawInterfaceInitialize(
         CxPlatLockInitialize(&Queue->FqLock);
         CxPlatLockInitialize(&Queue->CqLock);
 
-        // Initialize shared packet_buffer for umem usage
-        struct XskUmemInfo *UmemInfo = calloc(1, sizeof(struct XskUmemInfo));
-        if (!UmemInfo) {
-            Status = QUIC_STATUS_OUT_OF_MEMORY;
-            goto Error;
-        }
-
-        Status = InitializeUmem(FRAME_SIZE, NUM_FRAMES, RxHeadroom, TxHeadroom, UmemInfo);
-        if (QUIC_FAILED(Status)) {
-            QuicTraceLogVerbose(
-                XdpConfigureUmem,
-                "[ xdp] Failed to configure Umem");
-            free(UmemInfo);
-            goto Error;
-        }
-
-        //
-        // Create AF_XDP socket.
-        //
         struct XskSocketInfo *XskInfo = calloc(1, sizeof(*XskInfo));
         if (!XskInfo) {
             Status = QUIC_STATUS_OUT_OF_MEMORY;
-            free(UmemInfo->Buffer);
-            free(UmemInfo);
             goto Error;
         }
-        CxPlatLockInitialize(&XskInfo->UmemLock);
         Queue->XskInfo = XskInfo;
-        XskInfo->UmemInfo = UmemInfo;
 
-        int RetryCount = 10;
+        //
+        // Queues are assigned to partitions round robin below, so this queue
+        // shares the UMEM of the partition's first queue on the interface.
+        //
         int Ret = 0;
-        do {
-            Ret = xsk_socket__create(&XskInfo->Xsk, Interface->IfName,
-                        i, UmemInfo->Umem, &XskInfo->Rx,
-                        &XskInfo->Tx, XskCfg);
-            if (Ret == -EBUSY) {
-                CxPlatSleep(100);
+        if (i >= Xdp->PartitionCount) {
+            XskInfo->UmemInfo = Interface->Queues[i % Xdp->PartitionCount].XskInfo->UmemInfo;
+            XskInfo->UmemInfo->RefCount++;
+            Ret = XskSocketCreate(Interface, i, XskInfo, TRUE);
+            if (Ret < 0) {
+                //
+                // Sharing a UMEM across queues needs Linux 5.10 or later, so
+                // fall back to a UMEM of the queue's own.
+                //
+                QuicTraceLogVerbose(
+                    XdpSharedUmemFails,
+                    "[ xdp] Failed to share Umem on %s queue %u. error:%s",
+                    Interface->IfName,
+                    i,
+                    strerror(-Ret));
+                XskInfo->UmemInfo->RefCount--;
+                XskInfo->UmemInfo = NULL;
+                CxPlatZeroMemory(XskInfo, sizeof(*XskInfo));
             }
-        } while (Ret == -EBUSY && RetryCount-- > 0);
+        }
+
+        if (XskInfo->UmemInfo == NULL) {
+            struct XskUmemInfo *UmemInfo = calloc(1, sizeof(struct XskUmemInfo));
+            if (!UmemInfo) {
+                Status = QUIC_STATUS_OUT_OF_MEMORY;
+                goto Error;
+            }
+
+            Status = InitializeUmem(FrameSize, NUM_FRAMES, RxHeadroom, TxHeadroom, UmemInfo, XskInfo);
+            if (QUIC_FAILED(Status)) {
+                QuicTraceLogVerbose(
+                    XdpConfigureUmem,
+                    "[ xdp] Failed to configure Umem");
+                free(UmemInfo);
+                goto Error;
+            }
+            UmemInfo->SocketCount =
+                i < Xdp->PartitionCount ?
+                    (Interface->QueueCount - 1 - i) / Xdp->PartitionCount + 1 : 1;
+            UmemInfo->RefCount = 1;
+            XskInfo->UmemInfo = UmemInfo;
+
+            Ret = XskSocketCreate(Interface, i, XskInfo, FALSE);
+        }
         if (Ret < 0) {
             QuicTraceLogVerbose(
                 FailXskSocketCreate,
@@ -591,29 +789,34 @@ CxPlatDpRawInterfaceInitialize(
             goto Error;
         }
 
-        for (int i = 0; i < NUM_FRAMES; i++) {
-            XskInfo->UmemFrameAddr[i] = i * FrameSize;
+        //
+        // Half of the UMEM's frames are split evenly between the fill rings of
+        // the sockets sharing it. The other half is left for sending and for
+        // the received packets still held by MsQuic.
+        //
+        XskInfo->FillTarget = PROD_NUM_DESCS / XskInfo->UmemInfo->SocketCount;
+        if (XskInfo->FillTarget < RX_BATCH_SIZE) {
+            XskInfo->FillTarget = RX_BATCH_SIZE;
         }
-        XskInfo->UmemFrameFree = NUM_FRAMES;
 
         // Setup fill queue for Rx
         uint32_t FqIdx = 0;
-        Ret = xsk_ring_prod__reserve(&XskInfo->UmemInfo->Fq, PROD_NUM_DESCS, &FqIdx);
-        if (Ret != PROD_NUM_DESCS) {
-            return QUIC_STATUS_OUT_OF_MEMORY;
+        CxPlatLockAcquire(&XskInfo->UmemInfo->Lock);
+        uint32_t FillCount = XskInfo->FillTarget;
+        if (FillCount > XskUmemFreeFrames(XskInfo->UmemInfo)) {
+            FillCount = (uint32_t)XskUmemFreeFrames(XskInfo->UmemInfo);
         }
-        for (uint32_t i = 0; i < PROD_NUM_DESCS; i ++) {
-            uint64_t Addr = XskUmemFrameAlloc(XskInfo);
-            if (Addr == INVALID_UMEM_FRAME) {
-                QuicTraceLogVerbose(
-                    FailRxAlloc,
-                    "[ xdp][rx  ] OOM for Rx");
-                break;
-            }
-            *xsk_ring_prod__fill_addr(&XskInfo->UmemInfo->Fq, FqIdx++) = Addr;
+        if (xsk_ring_prod__reserve(&XskInfo->Fq, FillCount, &FqIdx) != FillCount) {
+            CxPlatLockRelease(&XskInfo->UmemInfo->Lock);
+            Status = QUIC_STATUS_OUT_OF_MEMORY;
+            goto Error;
+        }
+        for (uint32_t j = 0; j < FillCount; j++) {
+            *xsk_ring_prod__fill_addr(&XskInfo->Fq, FqIdx++) = XskUmemFrameAlloc(XskInfo->UmemInfo);
         }
+        CxPlatLockRelease(&XskInfo->UmemInfo->Lock);
 
-        xsk_ring_prod__submit(&XskInfo->UmemInfo->Fq, PROD_NUM_DESCS);
+        xsk_ring_prod__submit(&XskInfo->Fq, FillCount);
     }
 
     //
@@ -684,8 +887,11 @@ CxPlatDpRawInitialize(
     }
 
     CxPlatXdpReadConfig(Xdp);
+    CxPlatXdpLoadQeoProvider(Xdp);
     CxPlatListInitializeHead(&Xdp->Interfaces);
     Xdp->PollingIdleTimeoutUs = Config ? Config->PollingIdleTimeoutUs : 0;
+    Xdp->CidFlowSteering =
+        Config && !!(Config->Flags & QUIC_EXECUTION_CONFIG_FLAG_CID_FLOW_STEERING);
 
     if (Config && Config->ProcessorCount) {
         Xdp->PartitionCount = Config->ProcessorCount;
@@ -709,6 +915,7 @@ CxPlatDpRawInitialize(
     int family;
 
     if (getifaddrs(&ifaddr) == -1) {
+        CxPlatXdpUnloadQeoProvider(Xdp);
         return QUIC_STATUS_INTERNAL_ERROR;
     }
 
@@ -855,6 +1062,7 @@ Error:
             CxPlatDpRawInterfaceUninitialize(Interface);
             CxPlatFree(Interface, IF_TAG);
         }
+        CxPlatXdpUnloadQeoProvider(Xdp);
     }
 
     return Status;
@@ -884,6 +1092,7 @@ CxPlatDpRawRelease(
             }
             CxPlatFree(Interface, IF_TAG);
         }
+        CxPlatXdpUnloadQeoProvider(Xdp);
         CxPlatDataPathUninitializeComplete((CXPLAT_DATAPATH_RAW*)Xdp);
     }
     CxPlatRundownRelease(&Xdp->Rundown);
@@ -920,6 +1129,76 @@ CxPlatDpRawUpdateConfig(
     Xdp->PollingIdleTimeoutUs = Config->PollingIdleTimeoutUs;
 }
 
+//
+// The number of descriptors between a ring's consumer and producer, read
+// without synchronizing with either side.
+//
+static
+uint32_t
+XskRingUsed(
+    _In_ const uint32_t* Producer,
+    _In_ const uint32_t* Consumer
+    )
+{
+    return *(const volatile uint32_t*)Producer - *(const volatile uint32_t*)Consumer;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+uint32_t
+CxPlatDpRawGetQueueStatistics(
+    _In_ CXPLAT_DATAPATH_RAW* Datapath,
+    _Out_writes_opt_(Capacity) QUIC_DATAPATH_QUEUE_STATISTICS* Statistics,
+    _In_ uint32_t Capacity
+    )
+{
+    XDP_DATAPATH* Xdp = (XDP_DATAPATH*)Datapath;
+    uint32_t Count = 0;
+
+    for (CXPLAT_LIST_ENTRY* Entry = Xdp->Interfaces.Flink; Entry != &Xdp->Interfaces; Entry = Entry->Flink) {
+        XDP_INTERFACE* Interface = CXPLAT_CONTAINING_RECORD(Entry, XDP_INTERFACE, Link);
+        for (uint16_t i = 0; i < Interface->QueueCount; i++, Count++) {
+            if (Statistics == NULL || Count >= Capacity) {
+                continue;
+            }
+            const XDP_QUEUE* Queue = &Interface->Queues[i];
+            const struct XskSocketInfo* XskInfo = Queue->XskInfo;
+            QUIC_DATAPATH_QUEUE_STATISTICS* Stats = &Statistics[Count];
+            CxPlatZeroMemory(Stats, sizeof(*Stats));
+            Stats->InterfaceIndex = Interface->IfIndex;
+            Stats->QueueId = i;
+            Stats->RxPackets = Queue->Stats.RxPackets;
+            Stats->TxPackets = Queue->Stats.TxPackets;
+            Stats->RxFillStarved = Queue->Stats.RxFillStarved;
+            Stats->TxRingFull = Queue->Stats.TxRingFull;
+            Stats->TxBufferExhausted = Queue->Stats.TxBufferExhausted;
+            if (XskInfo == NULL || XskInfo->Xsk == NULL) {
+                continue;
+            }
+
+            struct xdp_statistics KernelStats;
+            socklen_t OptLen = sizeof(KernelStats);
+            if (getsockopt(
+                    xsk_socket__fd(XskInfo->Xsk), SOL_XDP, XDP_STATISTICS,
+                    &KernelStats, &OptLen) == 0) {
+                Stats->RxDropped = KernelStats.rx_dropped + KernelStats.rx_invalid_descs;
+                Stats->RxRingFull = KernelStats.rx_ring_full;
+                Stats->RxFillRingEmpty = KernelStats.rx_fill_ring_empty_descs;
+            }
+
+            Stats->RxRingUsed = XskRingUsed(XskInfo->Rx.producer, XskInfo->Rx.consumer);
+            Stats->RxFillRingUsed =
+                XskRingUsed(XskInfo->Fq.producer, XskInfo->Fq.consumer);
+            Stats->TxRingUsed = XskRingUsed(XskInfo->Tx.producer, XskInfo->Tx.consumer);
+            Stats->TxCompletionRingUsed =
+                XskRingUsed(XskInfo->Cq.producer, XskInfo->Cq.consumer);
+            Stats->RxRingSize = XskInfo->Rx.size;
+            Stats->TxRingSize = XskInfo->Tx.size;
+        }
+    }
+
+    return Count;
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 QUIC_STATUS
 RawSocketUpdateQeo(
@@ -929,10 +1208,220 @@ RawSocketUpdateQeo(
     _In_ uint32_t OffloadCount
     )
 {
-    UNREFERENCED_PARAMETER(Socket);
-    UNREFERENCED_PARAMETER(Offloads);
-    UNREFERENCED_PARAMETER(OffloadCount);
-    return QUIC_STATUS_NOT_SUPPORTED;
+    XDP_DATAPATH* Xdp = (XDP_DATAPATH*)Socket->RawDatapath;
+
+    if (Xdp->XdpQeoSet == NULL) {
+        return QUIC_STATUS_NOT_SUPPORTED;
+    }
+
+    //
+    // The following logic just tries all interfaces and if it's able to offload
+    // to any of them, it considers it a success. Long term though, this should
+    // only offload to the interface that the socket is bound to.
+    //
+
+    BOOLEAN AtLeastOneSucceeded = FALSE;
+    for (CXPLAT_LIST_ENTRY* Entry = Xdp->Interfaces.Flink; Entry != &Xdp->Interfaces; Entry = Entry->Flink) {
+        XDP_INTERFACE* Interface = CXPLAT_CONTAINING_RECORD(Entry, XDP_INTERFACE, Link);
+        int Ret = Xdp->XdpQeoSet(Interface->IfIndex, Offloads, OffloadCount);
+        if (Ret < 0) {
+            QuicTraceEvent(
+                LibraryErrorStatus,
+                "[ lib] ERROR, %u, %s.",
+                (QUIC_STATUS)-Ret,
+                XDP_QEO_SET_FN_NAME);
+        } else {
+            AtLeastOneSucceeded = TRUE;
+        }
+    }
+
+    return AtLeastOneSucceeded ? QUIC_STATUS_SUCCESS : QUIC_STATUS_NOT_SUPPORTED;
+}
+
+//
+// Validation rules for the packets to a listener port, enforced by the XDP
+// program before they are redirected to user space. Must match the
+// struct quic_filter in datapath_raw_xdp_linux_kern.c
+//
+#define QUIC_FILTER_MAX_VERSIONS 4
+
+struct quic_filter {
+    __u32 versions[QUIC_FILTER_MAX_VERSIONS];
+    __u8 initial_types[QUIC_FILTER_MAX_VERSIONS];
+    __u8 version_count;
+    __u8 cid_length;
+    __u8 server_id_offset;
+    __u8 server_id_length;
+    __u8 server_id[16];
+};
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+void
+CxPlatXdpInitializeFilter(
+    _In_ const CXPLAT_SOCKET_RAW* Socket,
+    _Out_ struct quic_filter* Filter
+    )
+{
+    static const uint32_t Versions[] = {
+        QUIC_VERSION_1, QUIC_VERSION_DRAFT_29, QUIC_VERSION_MS_1, QUIC_VERSION_2
+    };
+    static const uint8_t InitialTypes[] = { 0, 0, 0, 1 };
+    CXPLAT_STATIC_ASSERT(ARRAYSIZE(Versions) <= QUIC_FILTER_MAX_VERSIONS, "Too many versions");
+
+    CxPlatZeroMemory(Filter, sizeof(*Filter));
+    for (uint8_t i = 0; i < ARRAYSIZE(Versions); ++i) {
+        Filter->versions[i] = Versions[i];
+        Filter->initial_types[i] = InitialTypes[i];
+    }
+    Filter->version_count = ARRAYSIZE(Versions);
+    Filter->cid_length = Socket->FilterCidLength;
+    Filter->server_id_offset = Socket->FilterServerIdOffset;
+    Filter->server_id_length = Socket->FilterServerIdLength;
+    CxPlatCopyMemory(Filter->server_id, Socket->FilterServerId, Socket->FilterServerIdLength);
+}
+
+//
+// Issues an ethtool ntuple rule command on the interface.
+//
+static
+BOOLEAN
+CxPlatXdpFlowRuleIoctl(
+    _In_ int Fd,
+    _In_ const XDP_INTERFACE* Interface,
+    _Inout_ struct ethtool_rxnfc* Nfc
+    )
+{
+    struct ifreq Ifr;
+    CxPlatZeroMemory(&Ifr, sizeof(Ifr));
+    strncpy(Ifr.ifr_name, Interface->IfName, sizeof(Ifr.ifr_name) - 1);
+    Ifr.ifr_data = (char*)Nfc;
+    return ioctl(Fd, SIOCETHTOOL, &Ifr) == 0;
+}
+
+static
+void
+CxPlatXdpRemoveCidFlowRules(
+    _Inout_ XDP_INTERFACE* Interface
+    )
+{
+    int Fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (Fd >= 0) {
+        for (uint16_t i = 0; i < Interface->FlowRuleCount; ++i) {
+            struct ethtool_rxnfc Nfc;
+            CxPlatZeroMemory(&Nfc, sizeof(Nfc));
+            Nfc.cmd = ETHTOOL_SRXCLSRLDEL;
+            Nfc.fs.location = Interface->FlowRuleLocations[i];
+            (void)CxPlatXdpFlowRuleIoctl(Fd, Interface, &Nfc);
+        }
+        close(Fd);
+    }
+
+    if (Interface->FlowRuleLocations != NULL) {
+        CxPlatFree(Interface->FlowRuleLocations, RULE_TAG);
+        Interface->FlowRuleLocations = NULL;
+    }
+    Interface->FlowRuleCount = 0;
+    Interface->FlowSteeringPort = 0;
+}
+
+//
+// Installs ntuple rules that steer the socket's short header packets to the
+// receive queue of the partition encoded in their destination CID, so that a
+// connection's packets stay on its partition even when its 4-tuple changes.
+// Queue i is owned by partition i, so a rule is added per (IPv4 and IPv6)
+// partition that has a queue. The partition ID follows the first byte and the
+// CID's server ID, and is matched with the driver's user defined data: the
+// payload offset in the upper and the matched word in the lower 16 bits.
+//
+static
+void
+CxPlatXdpInstallCidFlowRules(
+    _Inout_ XDP_INTERFACE* Interface,
+    _In_ const CXPLAT_SOCKET_RAW* Socket
+    )
+{
+    static const uint32_t FlowTypes[] = { UDP_V4_FLOW, UDP_V6_FLOW };
+    const uint16_t Port = Socket->LocalAddress.Ipv4.sin_port;
+
+    if (Interface->FlowSteeringPort != 0) {
+        QuicTraceLogWarning(
+            XdpCidSteeringInUse,
+            "[ xdp] CID steering already used for port %hu on %s",
+            ntohs(Interface->FlowSteeringPort),
+            Interface->IfName);
+        return;
+    }
+
+    const uint16_t PartitionCount =
+        CXPLAT_MIN(Interface->QueueCount, Socket->SteeringPartitionCount);
+    Interface->FlowRuleLocations =
+        CxPlatAlloc(
+            ARRAYSIZE(FlowTypes) * PartitionCount * sizeof(uint32_t),
+            RULE_TAG);
+    if (Interface->FlowRuleLocations == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "XDP flow rule locations",
+            ARRAYSIZE(FlowTypes) * PartitionCount * sizeof(uint32_t));
+        return;
+    }
+    Interface->FlowSteeringPort = Port;
+
+    int Fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (Fd < 0) {
+        CxPlatXdpRemoveCidFlowRules(Interface);
+        return;
+    }
+
+    //
+    // The partition ID is written to the CID in host byte order, so the word
+    // the NIC reads from the wire is the byte swapped (network order) value.
+    //
+    const uint32_t Offset = 1u + Socket->SteeringPidOffset;
+    const uint16_t Mask = htons(Socket->SteeringPidMask);
+
+    for (uint16_t i = 0; i < PartitionCount; ++i) {
+        for (uint32_t j = 0; j < ARRAYSIZE(FlowTypes); ++j) {
+            struct ethtool_rxnfc Nfc;
+            CxPlatZeroMemory(&Nfc, sizeof(Nfc));
+            Nfc.cmd = ETHTOOL_SRXCLSRLINS;
+            Nfc.fs.flow_type = FlowTypes[j] | FLOW_EXT;
+            if (FlowTypes[j] == UDP_V4_FLOW) {
+                Nfc.fs.h_u.udp_ip4_spec.pdst = Port;
+                Nfc.fs.m_u.udp_ip4_spec.pdst = 0xFFFF;
+            } else {
+                Nfc.fs.h_u.udp_ip6_spec.pdst = Port;
+                Nfc.fs.m_u.udp_ip6_spec.pdst = 0xFFFF;
+            }
+            Nfc.fs.h_ext.data[1] = htonl((Offset << 16) | htons(i));
+            Nfc.fs.m_ext.data[1] = htonl(0xFFFF0000u | Mask);
+            Nfc.fs.ring_cookie = i;
+            Nfc.fs.location = RX_CLS_LOC_ANY;
+
+            if (!CxPlatXdpFlowRuleIoctl(Fd, Interface, &Nfc)) {
+                QuicTraceLogWarning(
+                    XdpCidSteeringFailed,
+                    "[ xdp] Failed to add CID steering rule on %s, errno = %d",
+                    Interface->IfName,
+                    errno);
+                close(Fd);
+                CxPlatXdpRemoveCidFlowRules(Interface);
+                return;
+            }
+            Interface->FlowRuleLocations[Interface->FlowRuleCount++] = Nfc.fs.location;
+        }
+    }
+
+    close(Fd);
+
+    QuicTraceLogInfo(
+        XdpCidSteeringAdded,
+        "[ xdp] Added %hu CID steering rules for port %hu on %s",
+        Interface->FlowRuleCount,
+        ntohs(Port),
+        Interface->IfName);
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -964,6 +1453,31 @@ CxPlatDpRawPlumbRulesOnSocket(
             }
         }
 
+        struct bpf_map *filter_map = bpf_object__find_map_by_name(xdp_program__bpf_obj(Interface->XdpProg), "filter_map");
+        if (filter_map && Socket->FilterCidLength != 0) {
+            uint16_t port = Socket->LocalAddress.Ipv4.sin_port;
+            if (IsCreated) {
+                struct quic_filter Filter;
+                CxPlatXdpInitializeFilter(Socket, &Filter);
+                if (bpf_map_update_elem(bpf_map__fd(filter_map), &port, &Filter, BPF_ANY)) {
+                    QuicTraceLogVerbose(
+                        XdpSetFilterFails,
+                        "[ xdp] Failed to set filter on port %d on %s", port, Interface->IfName);
+                }
+            } else {
+                bpf_map_delete_elem(bpf_map__fd(filter_map), &port);
+            }
+        }
+
+        if (((XDP_DATAPATH*)Socket->RawDatapath)->CidFlowSteering &&
+            Socket->SteeringPartitionCount != 0) {
+            if (IsCreated) {
+                CxPlatXdpInstallCidFlowRules(Interface, Socket);
+            } else if (Interface->FlowSteeringPort == Socket->LocalAddress.Ipv4.sin_port) {
+                CxPlatXdpRemoveCidFlowRules(Interface);
+            }
+        }
+
         struct bpf_map *ip_map = bpf_object__find_map_by_name(xdp_program__bpf_obj(Interface->XdpProg), "ip_map");
         static const int IPv4Key = 0;
         static const int IPv6Key = 1;
@@ -1017,25 +1531,23 @@ CxPlatDpRawRxFree(
     _In_opt_ const CXPLAT_RECV_DATA* PacketChain
     )
 {
-    uint32_t Count = 0;
-    struct XskSocketInfo *XskInfo = NULL;
-    if (PacketChain) {
+    struct XskUmemInfo *UmemInfo = NULL;
+    while (PacketChain) {
         const XDP_RX_PACKET* Packet =
             CXPLAT_CONTAINING_RECORD(PacketChain, XDP_RX_PACKET, RecvData);
-        XskInfo = Packet->Queue->XskInfo;
-
-        CxPlatLockAcquire(&XskInfo->UmemLock);
-        while (PacketChain) {
-            Packet =
-                CXPLAT_CONTAINING_RECORD(PacketChain, XDP_RX_PACKET, RecvData);
-            PacketChain = PacketChain->Next;
-            XskUmemFrameFree(Packet->Queue->XskInfo, Packet->Addr);
-            Count++;
+        PacketChain = PacketChain->Next;
+        if (UmemInfo != Packet->Queue->XskInfo->UmemInfo) {
+            if (UmemInfo != NULL) {
+                CxPlatLockRelease(&UmemInfo->Lock);
+            }
+            UmemInfo = Packet->Queue->XskInfo->UmemInfo;
+            CxPlatLockAcquire(&UmemInfo->Lock);
         }
+        XskUmemFrameFree(UmemInfo, Packet->Addr);
     }
 
-    if (Count > 0) {
-        CxPlatLockRelease(&XskInfo->UmemLock);
+    if (UmemInfo != NULL) {
+        CxPlatLockRelease(&UmemInfo->Lock);
     }
 }
 
@@ -1052,9 +1564,12 @@ CxPlatDpRawTxAlloc(
     XDP_TX_PACKET* Packet = NULL;
     XDP_QUEUE* Queue = Config->Route->Queue;
     struct XskSocketInfo* XskInfo = Queue->XskInfo;
-    CxPlatLockAcquire(&XskInfo->UmemLock);
-    uint64_t BaseAddr = XskUmemFrameAlloc(XskInfo);
-    CxPlatLockRelease(&XskInfo->UmemLock);
+    CxPlatLockAcquire(&XskInfo->UmemInfo->Lock);
+    uint64_t BaseAddr = XskUmemFrameAlloc(XskInfo->UmemInfo);
+    if (BaseAddr == INVALID_UMEM_FRAME) {
+        Queue->Stats.TxBufferExhausted++;
+    }
+    CxPlatLockRelease(&XskInfo->UmemInfo->Lock);
     if (BaseAddr == INVALID_UMEM_FRAME) {
         QuicTraceLogVerbose(
             FailTxAlloc,
@@ -1094,7 +1609,12 @@ KickTx(
     )
 {
     struct XskSocketInfo* XskInfo = Queue->XskInfo;
-    if (sendto(xsk_socket__fd(XskInfo->Xsk), NULL, 0, MSG_DONTWAIT, NULL, 0) < 0) {
+    //
+    // With XDP_USE_NEED_WAKEUP, the kernel only needs the syscall when it
+    // isn't already processing the Tx ring (always the case in copy mode).
+    //
+    if (xsk_ring_prod__needs_wakeup(&XskInfo->Tx) &&
+        sendto(xsk_socket__fd(XskInfo->Xsk), NULL, 0, MSG_DONTWAIT, NULL, 0) < 0) {
         if (errno == EAGAIN || errno == EWOULDBLOCK) {
             if (!SendAlreadyPending) {
                 XdpSocketContextSetEvents(Queue, EPOLL_CTL_MOD, EPOLLIN | EPOLLOUT);
@@ -1113,16 +1633,16 @@ KickTx(
     uint32_t Completed;
     uint32_t CqIdx;
     CxPlatLockAcquire(&Queue->CqLock);
-    Completed = xsk_ring_cons__peek(&XskInfo->UmemInfo->Cq, CONS_NUM_DESCS, &CqIdx);
+    Completed = xsk_ring_cons__peek(&XskInfo->Cq, CONS_NUM_DESCS, &CqIdx);
     if (Completed > 0) {
-        CxPlatLockAcquire(&XskInfo->UmemLock);
+        CxPlatLockAcquire(&XskInfo->UmemInfo->Lock);
         for (uint32_t i = 0; i < Completed; i++) {
-            uint64_t addr = *xsk_ring_cons__comp_addr(&XskInfo->UmemInfo->Cq, CqIdx++) - XskInfo->UmemInfo->TxHeadRoom;
-            XskUmemFrameFree(XskInfo, addr);
+            uint64_t addr = *xsk_ring_cons__comp_addr(&XskInfo->Cq, CqIdx++) - XskInfo->UmemInfo->TxHeadRoom;
+            XskUmemFrameFree(XskInfo->UmemInfo, addr);
         }
-        CxPlatLockRelease(&XskInfo->UmemLock);
+        CxPlatLockRelease(&XskInfo->UmemInfo->Lock);
 
-        xsk_ring_cons__release(&XskInfo->UmemInfo->Cq, Completed);
+        xsk_ring_cons__release(&XskInfo->Cq, Completed);
         QuicTraceLogVerbose(
             ReleaseCons,
             "[ xdp][cq  ] Release %d from completion queue", Completed);
@@ -1144,9 +1664,11 @@ CxPlatDpRawTxEnqueue(
     uint32_t TxIdx = 0;
     CxPlatLockAcquire(&Queue->TxLock);
     if (xsk_ring_prod__reserve(&XskInfo->Tx, 1, &TxIdx) != 1) {
-        CxPlatLockAcquire(&XskInfo->UmemLock);
-        XskUmemFrameFree(XskInfo, Packet->UmemRelativeAddr);
-        CxPlatLockRelease(&XskInfo->UmemLock);
+        Queue->Stats.TxRingFull++;
+        CxPlatLockRelease(&Queue->TxLock);
+        CxPlatLockAcquire(&XskInfo->UmemInfo->Lock);
+        XskUmemFrameFree(XskInfo->UmemInfo, Packet->UmemRelativeAddr);
+        CxPlatLockRelease(&XskInfo->UmemInfo->Lock);
         QuicTraceLogVerbose(
             FailTxReserve,
             "[ xdp][tx  ] Failed to reserve");
@@ -1158,6 +1680,7 @@ CxPlatDpRawTxEnqueue(
     tx_desc->addr = Packet->UmemRelativeAddr + XskInfo->UmemInfo->TxHeadRoom;
     tx_desc->len = SendData->Buffer.Length;
     xsk_ring_prod__submit(&XskInfo->Tx, 1);
+    Queue->Stats.TxPackets++;
     CxPlatLockRelease(&Queue->TxLock);
 
     KickTx(Packet->Queue, FALSE);
@@ -1287,42 +1810,56 @@ CxPlatXdpRx(
             Packet->RecvData.Allocated = TRUE;
             Buffers[PacketCount++] = &Packet->RecvData;
         } else {
-            XskUmemFrameFree(XskInfo, Addr - (XDP_PACKET_HEADROOM + XskInfo->UmemInfo->RxHeadRoom));
+            CxPlatLockAcquire(&XskInfo->UmemInfo->Lock);
+            XskUmemFrameFree(XskInfo->UmemInfo, Addr - (XDP_PACKET_HEADROOM + XskInfo->UmemInfo->RxHeadRoom));
+            CxPlatLockRelease(&XskInfo->UmemInfo->Lock);
         }
     }
 
     if (Rcvd) {
         xsk_ring_cons__release(&XskInfo->Rx, Rcvd);
+        Queue->Stats.RxPackets += Rcvd;
     }
     CxPlatLockRelease(&Queue->RxLock);
 
-    CxPlatLockAcquire(&XskInfo->UmemLock);
+    CxPlatLockAcquire(&XskInfo->UmemInfo->Lock);
     CxPlatLockAcquire(&Queue->FqLock);
-    // Stuff the ring with as much frames as possible
-    Available = xsk_prod_nb_free(&XskInfo->UmemInfo->Fq, XskUmemFreeFrames(XskInfo));
+    //
+    // Top the fill ring back up to the socket's share of the UMEM, as far as
+    // the frames the sockets sharing it have left over allow.
+    //
+    i = 0;
+    const uint32_t FillUsed = XskInfo->Fq.size - xsk_prod_nb_free(&XskInfo->Fq, XskInfo->Fq.size);
+    const uint32_t Wanted = FillUsed < XskInfo->FillTarget ? XskInfo->FillTarget - FillUsed : 0;
+    Available = Wanted;
+    if (Available > XskUmemFreeFrames(XskInfo->UmemInfo)) {
+        Available = (uint32_t)XskUmemFreeFrames(XskInfo->UmemInfo);
+        Queue->Stats.RxFillStarved++;
+        QuicTraceLogVerbose(
+            FailRxAlloc,
+            "[ xdp][rx  ] OOM for Rx");
+    }
     if (Available > 0) {
-        ret = xsk_ring_prod__reserve(&XskInfo->UmemInfo->Fq, Available, &FqIdx);
+        ret = xsk_ring_prod__reserve(&XskInfo->Fq, Available, &FqIdx);
 
         // This should not happen, but just in case
         while (ret != Available) {
-            ret = xsk_ring_prod__reserve(&XskInfo->UmemInfo->Fq, Rcvd, &FqIdx);
+            ret = xsk_ring_prod__reserve(&XskInfo->Fq, Available, &FqIdx);
         }
         for (i = 0; i < Available; i++) {
-            uint64_t addr = XskUmemFrameAlloc(XskInfo);
-            if (addr == INVALID_UMEM_FRAME) {
-                QuicTraceLogVerbose(
-                    FailRxAlloc,
-                    "[ xdp][rx  ] OOM for Rx");
-                break;
-            }
-            *xsk_ring_prod__fill_addr(&XskInfo->UmemInfo->Fq, FqIdx++) = addr;
-        }
-        if (i > 0) {
-            xsk_ring_prod__submit(&XskInfo->UmemInfo->Fq, i);
+            *xsk_ring_prod__fill_addr(&XskInfo->Fq, FqIdx++) = XskUmemFrameAlloc(XskInfo->UmemInfo);
         }
+        xsk_ring_prod__submit(&XskInfo->Fq, i);
+    }
+    if (xsk_ring_prod__needs_wakeup(&XskInfo->Fq)) {
+        //
+        // The driver ran out of fill descriptors and stopped; kick it so it
+        // picks up the newly filled frames.
+        //
+        recvfrom(xsk_socket__fd(XskInfo->Xsk), NULL, 0, MSG_DONTWAIT, NULL, NULL);
     }
     CxPlatLockRelease(&Queue->FqLock);
-    CxPlatLockRelease(&XskInfo->UmemLock);
+    CxPlatLockRelease(&XskInfo->UmemInfo->Lock);
 
     if (PacketCount) {
         CxPlatDpRawRxEthernet(
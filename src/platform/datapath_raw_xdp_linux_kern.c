@@ -54,6 +54,30 @@ struct {
 static const __u32 ipv4_key = 0;
 static const __u32 ipv6_key = 1;
 
+#define QUIC_FILTER_MAX_VERSIONS 4
+#define QUIC_MAX_CID_LENGTH 20
+#define QUIC_MIN_INITIAL_CID_LENGTH 8
+#define QUIC_MIN_INITIAL_LENGTH 1200
+
+// Validation rules for the packets to a listener port. Must match the
+// struct quic_filter in datapath_raw_xdp_linux.c
+struct quic_filter {
+    __u32 versions[QUIC_FILTER_MAX_VERSIONS];       // Supported versions (network byte order)
+    __u8 initial_types[QUIC_FILTER_MAX_VERSIONS];   // Long header type of Initial packets
+    __u8 version_count;
+    __u8 cid_length;                                // Length of our CIDs in short headers
+    __u8 server_id_offset;                          // Offset of the server ID in our CIDs
+    __u8 server_id_length;                          // 0 if the server ID isn't matched
+    __u8 server_id[16];
+};
+
+struct {
+    __uint(type, BPF_MAP_TYPE_HASH);
+    __type(key, __u16);
+    __type(value, struct quic_filter);
+    __uint(max_entries, 64);
+} filter_map SEC(".maps");
+
 #ifdef DEBUG
 
 // NOTE: divisible by 4
@@ -185,9 +209,79 @@ static __always_inline void dump(struct xdp_md *ctx, void *data, void *data_end)
 
 #endif
 
+// Validates the QUIC packet to a listener port the same way user space would,
+// so that garbage never needs to be copied up to it.
+// return false if the packet would be dropped by user space
+static __always_inline bool valid_quic_packet(struct quic_filter *filter, unsigned char *payload, void *data_end) {
+    if ((void*)(payload + 1) > data_end) {
+        return false;
+    }
+    __u32 length = (__u32)(data_end - (void*)payload);
+
+    if (payload[0] & 0x80) {
+        // Long header: flags, version, DCID length, DCID, SCID length, SCID
+        if ((void*)(payload + 6) > data_end) {
+            return false;
+        }
+        __u32 version = *(__u32*)(payload + 1);
+        if (version == 0) {
+            return false; // Clients never send version negotiation packets
+        }
+
+        bool supported = false;
+        __u8 initial_type = 0;
+        for (int i = 0; i < QUIC_FILTER_MAX_VERSIONS; i++) {
+            if (i < filter->version_count && filter->versions[i] == version) {
+                supported = true;
+                initial_type = filter->initial_types[i];
+            }
+        }
+        if (!supported) {
+            // Large enough packets still get a version negotiation response
+            return length >= QUIC_MIN_INITIAL_LENGTH;
+        }
+
+        __u8 dcid_length = payload[5];
+        if (dcid_length < QUIC_MIN_INITIAL_CID_LENGTH || dcid_length > QUIC_MAX_CID_LENGTH) {
+            return false;
+        }
+        unsigned char *scid = payload + 6 + dcid_length;
+        if ((void*)(scid + 1) > data_end) {
+            return false;
+        }
+        __u8 scid_length = scid[0];
+        if (scid_length > QUIC_MAX_CID_LENGTH ||
+            (void*)(scid + 1 + scid_length) > data_end) {
+            return false;
+        }
+
+        if (((payload[0] & 0x30) >> 4) == initial_type &&
+            length < QUIC_MIN_INITIAL_LENGTH) {
+            return false;
+        }
+        return true;
+    }
+
+    // Short header: flags, DCID (ours)
+    if (length < 1 + (__u32)filter->cid_length) {
+        return false;
+    }
+    for (int i = 0; i < sizeof(filter->server_id); i++) {
+        if (i >= filter->server_id_length) {
+            break;
+        }
+        unsigned char *cid_byte = payload + 1 + (filter->server_id_offset & 0x0f) + i;
+        if ((void*)(cid_byte + 1) > data_end || *cid_byte != filter->server_id[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
 // Validates packet whether it is really to user space quic service
-// return true if valid Ethernet, IPv4/6, UDP header and destination port
-static __always_inline bool to_quic_service(struct xdp_md *ctx, void *data, void *data_end) {
+// return true if valid Ethernet, IPv4/6, UDP header and destination port,
+// and sets drop if it is to a listener but would just be dropped there
+static __always_inline bool to_quic_service(struct xdp_md *ctx, void *data, void *data_end, bool *drop) {
     struct ethhdr *eth = data;
     // boundary check
     if ((void *)(eth + 1) > data_end) {
@@ -245,6 +339,10 @@ static __always_inline bool to_quic_service(struct xdp_md *ctx, void *data, void
     // check if the destination port matches
     bool *exist = bpf_map_lookup_elem(&port_map, (__u16*)&udph->dest); // slow?
     if (exist && *exist) {
+        struct quic_filter *filter = bpf_map_lookup_elem(&filter_map, (__u16*)&udph->dest);
+        if (filter && !valid_quic_packet(filter, (unsigned char*)(udph + 1), data_end)) {
+            *drop = true;
+        }
         return true;
     }
     return false;
@@ -259,7 +357,11 @@ int xdp_main(struct xdp_md *ctx)
 #ifdef DEBUG
     dump(ctx, data, data_end);
 #endif
-    if (to_quic_service(ctx, data, data_end)) {
+    bool drop = false;
+    if (to_quic_service(ctx, data, data_end, &drop)) {
+        if (drop) {
+            return XDP_DROP;
+        }
         if (bpf_map_lookup_elem(&xsks_map, &index)) {
             return bpf_redirect_map(&xsks_map, index, 0);
         }
@@ -1227,6 +1227,67 @@ CxPlatDpRawUpdateConfig(
     Xdp->PollingIdleTimeoutUs = Config->PollingIdleTimeoutUs;
 }
 
+static
+uint32_t
+XskRingUsed(
+    _In_ const XSK_RING* Ring
+    )
+{
+    return *(volatile uint32_t*)Ring->SharedProducer - *(volatile uint32_t*)Ring->SharedConsumer;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+uint32_t
+CxPlatDpRawGetQueueStatistics(
+    _In_ CXPLAT_DATAPATH_RAW* Datapath,
+    _Out_writes_opt_(Capacity) QUIC_DATAPATH_QUEUE_STATISTICS* Statistics,
+    _In_ uint32_t Capacity
+    )
+{
+    XDP_DATAPATH* Xdp = (XDP_DATAPATH*)Datapath;
+    uint32_t Count = 0;
+
+    for (CXPLAT_LIST_ENTRY* Entry = Xdp->Interfaces.Flink; Entry != &Xdp->Interfaces; Entry = Entry->Flink) {
+        XDP_INTERFACE* Interface = CONTAINING_RECORD(Entry, XDP_INTERFACE, Link);
+        for (uint16_t i = 0; i < Interface->QueueCount; i++, Count++) {
+            if (Statistics == NULL || Count >= Capacity) {
+                continue;
+            }
+            const XDP_QUEUE* Queue = &Interface->Queues[i];
+            QUIC_DATAPATH_QUEUE_STATISTICS* Stats = &Statistics[Count];
+            CxPlatZeroMemory(Stats, sizeof(*Stats));
+            Stats->InterfaceIndex = Interface->IfIndex;
+            Stats->QueueId = i;
+            Stats->RxPackets = Queue->Stats.RxPackets;
+            Stats->TxPackets = Queue->Stats.TxPackets;
+            Stats->RxFillStarved = Queue->Stats.RxFillStarved;
+            Stats->TxRingFull = Queue->Stats.TxRingFull;
+            Stats->TxBufferExhausted = Queue->Stats.TxBufferExhausted;
+
+            if (Queue->RxXsk != NULL) {
+                XSK_STATISTICS XskStats;
+                uint32_t XskStatsSize = sizeof(XskStats);
+                if (SUCCEEDED(
+                        Xdp->XdpApi->XskGetSockopt(
+                            Queue->RxXsk, XSK_SOCKOPT_STATISTICS, &XskStats, &XskStatsSize))) {
+                    Stats->RxDropped =
+                        XskStats.RxDropped + XskStats.RxTruncated + XskStats.RxInvalidDescriptors;
+                }
+                Stats->RxRingUsed = XskRingUsed(&Queue->RxRing);
+                Stats->RxFillRingUsed = XskRingUsed(&Queue->RxFillRing);
+                Stats->RxRingSize = Queue->RxRing.Size;
+            }
+            if (Queue->TxXsk != NULL) {
+                Stats->TxRingUsed = XskRingUsed(&Queue->TxRing);
+                Stats->TxCompletionRingUsed = XskRingUsed(&Queue->TxCompletionRing);
+                Stats->TxRingSize = Queue->TxRing.Size;
+            }
+        }
+    }
+
+    return Count;
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 QUIC_STATUS
 RawSocketUpdateQeo(
@@ -1513,6 +1574,7 @@ CxPlatXdpRx(
 
     if (BuffersCount > 0) {
         XskRingConsumerRelease(&Queue->RxRing, BuffersCount);
+        Queue->Stats.RxPackets += BuffersCount;
     }
 
     uint32_t FillAvailable = XskRingProducerReserve(&Queue->RxFillRing, MAXUINT32, &FillIndex);
@@ -1523,6 +1585,7 @@ CxPlatXdpRx(
 
         XDP_RX_PACKET* Packet = (XDP_RX_PACKET*)CxPlatListPopEntry(&Queue->PartitionRxPool);
         if (Packet == NULL) {
+            Queue->Stats.RxFillStarved++;
             break;
         }
 
@@ -1615,6 +1678,8 @@ CxPlatDpRawTxAlloc(
         Packet->Buffer.Buffer = &Packet->FrameBuffer[HeaderBackfill.AllLayer];
         Packet->ECN = Config->ECN;
         Packet->DatapathType = Config->Route->DatapathType = CXPLAT_DATAPATH_TYPE_RAW;
+    } else {
+        InterlockedIncrement64((LONG64*)&Queue->Stats.TxBufferExhausted);
     }
 
     return (CXPLAT_SEND_DATA*)Packet;
@@ -1696,6 +1761,10 @@ CxPlatXdpTx(
         Buffer->Length = Packet->Buffer.Length;
         ProdCount++;
     }
+    Queue->Stats.TxPackets += ProdCount;
+    if (!CxPlatListIsEmpty(&Queue->PartitionTxQueue)) {
+        Queue->Stats.TxRingFull++;
+    }
 
     if ((ProdCount > 0 && (XskRingProducerSubmit(&Queue->TxRing, ProdCount), TRUE)) ||
         (CompCount > 0 && XskRingProducerReserve(&Queue->TxRing, MAXUINT32, &TxIndex) != Queue->TxRing.Size)) {
@@ -68,6 +68,12 @@ typedef enum {
 //
 #define CXPLAT_LARGE_SEND_BUFFER_SIZE         0xF000
 
+//
+// The maximum number of segments in a single USO send. The stack doesn't
+// report a limit of its own, so this matches Linux's UDP_MAX_SEGMENTS.
+//
+#define CXPLAT_MAX_USO_SEGMENTS               64
+
 //
 // The maximum number of pages that memory allocated for our UDP payload
 // buffers might span.
@@ -80,9 +86,11 @@ typedef enum {
 #define MDL_SIZE                            (sizeof(MDL) + (sizeof(PFN_NUMBER) * MAX_BUFFER_PAGE_USAGE))
 
 //
-// The maximum number of UDP datagrams that can be sent with one call.
+// The maximum number of UDP datagrams that can be sent with one call, when
+// USO isn't available. WskSendMessages sends each WSK_BUF_LIST entry as its
+// own datagram, so a batch costs a single IRP and pass through the stack.
 //
-#define CXPLAT_MAX_BATCH_SEND                 1
+#define CXPLAT_MAX_BATCH_SEND                 16
 
 //
 // The maximum number of UDP datagrams to preallocate for URO.
@@ -244,6 +252,11 @@ typedef struct CXPLAT_SEND_DATA {
     //
     UINT16 SegmentSize;
 
+    //
+    // The maximum number of segments in each segmented buffer.
+    //
+    UINT16 MaxSegments;
+
     //
     // The QUIC_BUFFER returned to the client for segmented sends.
     //
@@ -1050,6 +1063,31 @@ CxPlatDataPathGetSupportedFeatures(
     return Datapath->Features;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint16_t
+CxPlatDataPathGetMaxSendSegments(
+    _In_ CXPLAT_DATAPATH* Datapath
+    )
+{
+    return
+        (Datapath->Features & CXPLAT_DATAPATH_FEATURE_SEND_SEGMENTATION) ?
+            CXPLAT_MAX_USO_SEGMENTS : CXPLAT_MAX_BATCH_SEND;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+uint32_t
+CxPlatDataPathGetQueueStatistics(
+    _In_ CXPLAT_DATAPATH* Datapath,
+    _Out_writes_opt_(Capacity) QUIC_DATAPATH_QUEUE_STATISTICS* Statistics,
+    _In_ uint32_t Capacity
+    )
+{
+    UNREFERENCED_PARAMETER(Datapath);
+    UNREFERENCED_PARAMETER(Statistics);
+    UNREFERENCED_PARAMETER(Capacity);
+    return 0;
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 BOOLEAN
 CxPlatDataPathIsPaddingPreferred(
@@ -2612,6 +2650,10 @@ CxPlatSendDataAlloc(
         SendData->SegmentSize =
             (Binding->Datapath->Features & CXPLAT_DATAPATH_FEATURE_SEND_SEGMENTATION)
                 ? Config->MaxPacketSize : 0;
+        SendData->MaxSegments = CxPlatDataPathGetMaxSendSegments(Binding->Datapath);
+        if (Config->MaxSegments != 0 && Config->MaxSegments < SendData->MaxSegments) {
+            SendData->MaxSegments = Config->MaxSegments;
+        }
         SendData->ClientBuffer.Length = 0;
         SendData->ClientBuffer.Buffer = NULL;
     }
@@ -2660,12 +2702,14 @@ CxPlatSendDataCanAllocSendSegment(
     CXPLAT_DBG_ASSERT(SendData->SegmentSize > 0);
     CXPLAT_DBG_ASSERT(SendData->WskBufferCount > 0);
 
-    ULONG BytesAvailable =
-        CXPLAT_LARGE_SEND_BUFFER_SIZE -
-        (ULONG)SendData->TailBuf->Link.Buffer.Length -
+    const ULONG BytesUsed =
+        (ULONG)SendData->TailBuf->Link.Buffer.Length +
         SendData->ClientBuffer.Length;
+    if (BytesUsed / SendData->SegmentSize >= SendData->MaxSegments) {
+        return FALSE;
+    }
 
-    return MaxBufferLength <= BytesAvailable;
+    return MaxBufferLength <= CXPLAT_LARGE_SEND_BUFFER_SIZE - BytesUsed;
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -2676,10 +2720,15 @@ CxPlatSendDataCanAllocSend(
     _In_ UINT16 MaxBufferLength
     )
 {
-    return
-        (SendData->WskBufferCount < CXPLAT_MAX_BATCH_SEND) ||
-        ((SendData->SegmentSize > 0) &&
-            CxPlatSendDataCanAllocSendSegment(SendData, MaxBufferLength));
+    if (SendData->SegmentSize > 0) {
+        //
+        // All the segments go in one large buffer.
+        //
+        return
+            SendData->WskBufferCount == 0 ||
+            CxPlatSendDataCanAllocSendSegment(SendData, MaxBufferLength);
+    }
+    return SendData->WskBufferCount < SendData->MaxSegments;
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -3136,6 +3185,50 @@ CxPlatSocketGetTcpStatistics(
     return QUIC_STATUS_NOT_SUPPORTED;
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+CxPlatSocketSetTcpTls(
+    _In_ CXPLAT_SOCKET* Socket,
+    _In_ BOOLEAN Send,
+    _In_ CXPLAT_QEO_CIPHER_TYPE CipherType,
+    _In_reads_(32) const uint8_t* Key,
+    _In_reads_(12) const uint8_t* Iv
+    )
+{
+    UNREFERENCED_PARAMETER(Socket);
+    UNREFERENCED_PARAMETER(Send);
+    UNREFERENCED_PARAMETER(CipherType);
+    UNREFERENCED_PARAMETER(Key);
+    UNREFERENCED_PARAMETER(Iv);
+    return QUIC_STATUS_NOT_SUPPORTED;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+CxPlatSocketGetUdpRecvStatistics(
+    _In_ CXPLAT_SOCKET* Socket,
+    _Out_ CXPLAT_UDP_RECV_STATISTICS* Statistics
+    )
+{
+    UNREFERENCED_PARAMETER(Socket);
+    UNREFERENCED_PARAMETER(Statistics);
+    return QUIC_STATUS_NOT_SUPPORTED;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+CxPlatSocketGetUdpPartitionRecvStatistics(
+    _In_ CXPLAT_SOCKET* Socket,
+    _In_ uint16_t PartitionIndex,
+    _Out_ CXPLAT_UDP_RECV_STATISTICS* Statistics
+    )
+{
+    UNREFERENCED_PARAMETER(Socket);
+    UNREFERENCED_PARAMETER(PartitionIndex);
+    UNREFERENCED_PARAMETER(Statistics);
+    return QUIC_STATUS_NOT_SUPPORTED;
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicCopyRouteInfo(
@@ -58,6 +58,12 @@ Abstract:
 //
 #define CXPLAT_LARGE_SEND_BUFFER_SIZE         0xFFFF
 
+//
+// The maximum number of segments in a single USO send. The stack doesn't
+// report a limit of its own, so this matches Linux's UDP_MAX_SEGMENTS.
+//
+#define CXPLAT_MAX_USO_SEGMENTS               64
+
 //
 // The maximum number of UDP datagrams to preallocate for URO.
 //
@@ -181,21 +187,46 @@ typedef struct DECLSPEC_ALIGN(MEMORY_ALLOCATION_ALIGNMENT) CXPLAT_RIO_SEND_BUFFE
     DATAPATH_IO_TYPE IoType;
 
     //
-    // The RIO buffer ID.
+    // The RIO buffer ID of the slab holding this buffer, and the buffer's
+    // offset in it.
     //
     RIO_BUFFERID RioBufferId;
+    ULONG RioOffset;
 
     //
     // This send buffer's datapath.
     //
     CXPLAT_DATAPATH* Datapath;
 
-    //
-    // This send buffer's send data.
-    //
-    CXPLAT_SEND_DATA* SendData;
+    union {
+        //
+        // This send buffer's send data.
+        //
+        CXPLAT_SEND_DATA* SendData;
+
+        //
+        // The next buffer in CXPLAT_RIO_SEND_SLABS.FreeBuffers.
+        //
+        struct CXPLAT_RIO_SEND_BUFFER_HEADER* NextFree;
+    };
 } CXPLAT_RIO_SEND_BUFFER_HEADER;
 
+//
+// The target size of each slab of RIO send buffers. Large send buffers get at
+// least one per slab.
+//
+#define RIO_SEND_SLAB_SIZE (1024 * 1024)
+
+//
+// A chunk of memory registered with RIO once, which send buffers (each
+// prefixed with a CXPLAT_RIO_SEND_BUFFER_HEADER) are carved out of.
+//
+typedef struct DECLSPEC_ALIGN(MEMORY_ALLOCATION_ALIGNMENT) CXPLAT_RIO_SEND_SLAB {
+    CXPLAT_LIST_ENTRY Link;
+    RIO_BUFFERID RioBufferId;
+    uint32_t Size;
+} CXPLAT_RIO_SEND_SLAB;
+
 //
 // Send context.
 //
@@ -236,6 +267,11 @@ typedef struct CXPLAT_SEND_DATA {
     //
     uint16_t SegmentSize;
 
+    //
+    // The maximum number of segments in each segmented buffer.
+    //
+    uint16_t MaxSegments;
+
     //
     // Set of flags set to configure the send behavior.
     //
@@ -484,6 +520,19 @@ RioSendBufferFree(
     _Inout_ CXPLAT_POOL* Pool
     );
 
+void
+RioSendLargeBufferFree(
+    _In_ void* Entry,
+    _In_ uint32_t Tag,
+    _Inout_ CXPLAT_POOL* Pool
+    );
+
+void
+RioSendSlabsUninitialize(
+    _In_ CXPLAT_DATAPATH* Datapath,
+    _Inout_ CXPLAT_RIO_SEND_SLABS* Slabs
+    );
+
 void
 CxPlatDataPathStartRioSends(
     _In_ CXPLAT_SOCKET_PROC* SocketProc
@@ -955,9 +1004,14 @@ DataPathInitialize(
             QUIC_POOL_DATA,
             RIO_MAX_SEND_POOL_SIZE,
             RioSendLargeBufferAllocate,
-            RioSendBufferFree,
+            RioSendLargeBufferFree,
             &Datapath->Partitions[i].RioLargeSendBufferPool);
 
+        CxPlatLockInitialize(&Datapath->Partitions[i].RioSendSlabs.Lock);
+        CxPlatListInitializeHead(&Datapath->Partitions[i].RioSendSlabs.Slabs);
+        CxPlatLockInitialize(&Datapath->Partitions[i].RioLargeSendSlabs.Lock);
+        CxPlatListInitializeHead(&Datapath->Partitions[i].RioLargeSendSlabs.Slabs);
+
         CxPlatPoolInitialize(
             FALSE,
             RecvDatagramLength,
@@ -1029,6 +1083,8 @@ CxPlatProcessorContextRelease(
         CxPlatPoolUninitialize(&DatapathProc->LargeSendBufferPool);
         CxPlatPoolUninitialize(&DatapathProc->RioSendBufferPool);
         CxPlatPoolUninitialize(&DatapathProc->RioLargeSendBufferPool);
+        RioSendSlabsUninitialize(DatapathProc->Datapath, &DatapathProc->RioSendSlabs);
+        RioSendSlabsUninitialize(DatapathProc->Datapath, &DatapathProc->RioLargeSendSlabs);
         CxPlatRemoveDynamicPoolAllocator(&DatapathProc->RecvDatagramPool);
         CxPlatPoolUninitialize(&DatapathProc->RecvDatagramPool.Base);
         CxPlatPoolUninitialize(&DatapathProc->RioRecvPool);
@@ -1072,6 +1128,17 @@ DataPathGetSupportedFeatures(
     return Datapath->Features;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint16_t
+DataPathGetMaxSendSegments(
+    _In_ CXPLAT_DATAPATH* Datapath
+    )
+{
+    return
+        (Datapath->Features & CXPLAT_DATAPATH_FEATURE_SEND_SEGMENTATION) ?
+            CXPLAT_MAX_USO_SEGMENTS : Datapath->MaxSendBatchSize;
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 BOOLEAN
 DataPathIsPaddingPreferred(
@@ -1122,6 +1189,26 @@ CxPlatSocketEnqueueSqe(
     return QUIC_STATUS_SUCCESS;
 }
 
+//
+// Starts the partition's worker thread, if this is its first socket, and
+// associates the socket with the partition's completion port. Sets the last
+// error on failure.
+//
+static
+BOOLEAN
+CxPlatDataPathAssociateSocket(
+    _In_ CXPLAT_DATAPATH_PARTITION* DatapathProc,
+    _In_ SOCKET Socket
+    )
+{
+    if (!CxPlatWorkerPoolStartWorker(
+            DatapathProc->Datapath->WorkerPool, DatapathProc->PartitionIndex)) {
+        SetLastError(ERROR_NOT_ENOUGH_MEMORY);
+        return FALSE;
+    }
+    return CxPlatEventQAssociateHandle(DatapathProc->EventQ, (HANDLE)Socket);
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 QUIC_STATUS
 SocketCreateUdp(
@@ -1472,9 +1559,9 @@ SocketCreateUdp(
         SocketProc->DatapathProc = &Datapath->Partitions[PartitionIndex];
         CxPlatRefIncrement(&SocketProc->DatapathProc->RefCount);
 
-        if (!CxPlatEventQAssociateHandle(
-                SocketProc->DatapathProc->EventQ,
-                (HANDLE)SocketProc->Socket)) {
+        if (!CxPlatDataPathAssociateSocket(
+                SocketProc->DatapathProc,
+                SocketProc->Socket)) {
             DWORD LastError = GetLastError();
             QuicTraceEvent(
                 DatapathErrorStatus,
@@ -1877,9 +1964,9 @@ CxPlatSocketCreateTcpInternal(
             &Datapath->Partitions[PartitionIndex];
         CxPlatRefIncrement(&SocketProc->DatapathProc->RefCount);
 
-        if (!CxPlatEventQAssociateHandle(
-                SocketProc->DatapathProc->EventQ,
-                (HANDLE)SocketProc->Socket)) {
+        if (!CxPlatDataPathAssociateSocket(
+                SocketProc->DatapathProc,
+                SocketProc->Socket)) {
             DWORD LastError = GetLastError();
             QuicTraceEvent(
                 DatapathErrorStatus,
@@ -2146,9 +2233,9 @@ SocketCreateTcpListener(
     SocketProc->DatapathProc = &Datapath->Partitions[0]; // TODO - Something better?
     CxPlatRefIncrement(&SocketProc->DatapathProc->RefCount);
 
-    if (!CxPlatEventQAssociateHandle(
-            SocketProc->DatapathProc->EventQ,
-            (HANDLE)SocketProc->Socket)) {
+    if (!CxPlatDataPathAssociateSocket(
+            SocketProc->DatapathProc,
+            SocketProc->Socket)) {
         DWORD LastError = GetLastError();
         QuicTraceEvent(
             DatapathErrorStatus,
@@ -2665,9 +2752,9 @@ CxPlatDataPathSocketProcessAcceptCompletion(
             &Datapath->Partitions[PartitionIndex]; // TODO - Something better?
         CxPlatRefIncrement(&AcceptSocketProc->DatapathProc->RefCount);
 
-        if (!CxPlatEventQAssociateHandle(
-                AcceptSocketProc->DatapathProc->EventQ,
-                (HANDLE)AcceptSocketProc->Socket)) {
+        if (!CxPlatDataPathAssociateSocket(
+                AcceptSocketProc->DatapathProc,
+                AcceptSocketProc->Socket)) {
             DWORD LastError = GetLastError();
             QuicTraceEvent(
                 DatapathErrorStatus,
@@ -3678,6 +3765,10 @@ SendDataAlloc(
             (Socket->Type != CXPLAT_SOCKET_UDP ||
              Socket->Datapath->Features & CXPLAT_DATAPATH_FEATURE_SEND_SEGMENTATION)
                 ? Config->MaxPacketSize : 0;
+        SendData->MaxSegments = DataPathGetMaxSendSegments(Socket->Datapath);
+        if (Config->MaxSegments != 0 && Config->MaxSegments < SendData->MaxSegments) {
+            SendData->MaxSegments = Config->MaxSegments;
+        }
         SendData->TotalSize = 0;
         SendData->WsaBufferCount = 0;
         SendData->ClientBuffer.len = 0;
@@ -3726,30 +3817,63 @@ RioSendBufferHeaderFromBuffer(
 
 void*
 RioSendBufferAllocateInternal(
-    CXPLAT_DATAPATH* Datapath,
+    _In_ CXPLAT_DATAPATH* Datapath,
+    _Inout_ CXPLAT_RIO_SEND_SLABS* Slabs,
     _In_ uint32_t Size,
     _In_ uint32_t Tag
     )
 {
-    CXPLAT_RIO_SEND_BUFFER_HEADER* RioHeader;
-    void* Buffer = NULL;
+    CXPLAT_RIO_SEND_BUFFER_HEADER* RioHeader = NULL;
+    const uint32_t Stride =
+        ((uint32_t)sizeof(CXPLAT_RIO_SEND_BUFFER_HEADER) + Size + MEMORY_ALLOCATION_ALIGNMENT - 1) &
+        ~((uint32_t)MEMORY_ALLOCATION_ALIGNMENT - 1);
+
+    CxPlatLockAcquire(&Slabs->Lock);
 
-    CXPLAT_DBG_ASSERT(Size + (uint32_t)sizeof(*RioHeader) > Size);
-    RioHeader = CxPlatLargeAlloc(Size + sizeof(*RioHeader), Tag);
+    if (Slabs->FreeBuffers != NULL) {
+        RioHeader = Slabs->FreeBuffers;
+        Slabs->FreeBuffers = RioHeader->NextFree;
+        goto Exit;
+    }
 
-    if (RioHeader != NULL) {
-        Buffer = RioHeader + 1;
+    if (Slabs->RemainingBuffers == 0) {
+        const uint32_t BufferCount =
+            Stride >= RIO_SEND_SLAB_SIZE ? 1 : RIO_SEND_SLAB_SIZE / Stride;
+        const uint32_t SlabSize = sizeof(CXPLAT_RIO_SEND_SLAB) + BufferCount * Stride;
+        CXPLAT_RIO_SEND_SLAB* Slab = CxPlatLargeAlloc(SlabSize, Tag);
+        if (Slab == NULL) {
+            goto Exit;
+        }
 
-        RioHeader->Datapath = Datapath;
-        RioHeader->RioBufferId = Datapath->RioDispatch.RIORegisterBuffer(Buffer, Size);
-        if (RioHeader->RioBufferId == RIO_INVALID_BUFFERID) {
-            CxPlatLargeFree(RioHeader, Tag);
-            RioHeader = NULL;
-            Buffer = NULL;
+        //
+        // Registering pins the memory and is a system call, so it's done once
+        // for the whole slab. Buffers are then addressed by their offset.
+        //
+        Slab->RioBufferId = Datapath->RioDispatch.RIORegisterBuffer((char*)Slab, SlabSize);
+        if (Slab->RioBufferId == RIO_INVALID_BUFFERID) {
+            CxPlatLargeFree(Slab, Tag);
+            goto Exit;
         }
+        Slab->Size = SlabSize;
+        CxPlatListInsertTail(&Slabs->Slabs, &Slab->Link);
+        Slabs->NextBuffer = (uint8_t*)(Slab + 1);
+        Slabs->RemainingBuffers = BufferCount;
     }
 
-    return Buffer;
+    CXPLAT_RIO_SEND_SLAB* Slab =
+        CXPLAT_CONTAINING_RECORD(Slabs->Slabs.Blink, CXPLAT_RIO_SEND_SLAB, Link);
+    RioHeader = (CXPLAT_RIO_SEND_BUFFER_HEADER*)Slabs->NextBuffer;
+    RioHeader->Datapath = Datapath;
+    RioHeader->RioBufferId = Slab->RioBufferId;
+    RioHeader->RioOffset = (ULONG)((uint8_t*)(RioHeader + 1) - (uint8_t*)Slab);
+    Slabs->NextBuffer += Stride;
+    Slabs->RemainingBuffers--;
+
+Exit:
+
+    CxPlatLockRelease(&Slabs->Lock);
+
+    return RioHeader != NULL ? RioHeader + 1 : NULL;
 }
 
 void*
@@ -3763,7 +3887,7 @@ RioSendBufferAllocate(
         CXPLAT_CONTAINING_RECORD(Pool, CXPLAT_DATAPATH_PARTITION, RioSendBufferPool);
     CXPLAT_DATAPATH* Datapath = DatapathProc->Datapath;
 
-    return RioSendBufferAllocateInternal(Datapath, Size, Tag);
+    return RioSendBufferAllocateInternal(Datapath, &DatapathProc->RioSendSlabs, Size, Tag);
 }
 
 void*
@@ -3777,7 +3901,26 @@ RioSendLargeBufferAllocate(
         CXPLAT_CONTAINING_RECORD(Pool, CXPLAT_DATAPATH_PARTITION, RioLargeSendBufferPool);
     CXPLAT_DATAPATH* Datapath = DatapathProc->Datapath;
 
-    return RioSendBufferAllocateInternal(Datapath, Size, Tag);
+    return RioSendBufferAllocateInternal(Datapath, &DatapathProc->RioLargeSendSlabs, Size, Tag);
+}
+
+//
+// Buffers can't be freed on their own, so ones the pool doesn't keep go back
+// to their slabs for reuse. The slabs are only freed with the partition.
+//
+void
+RioSendBufferFreeInternal(
+    _Inout_ CXPLAT_RIO_SEND_SLABS* Slabs,
+    _In_ void* Entry
+    )
+{
+    CXPLAT_RIO_SEND_BUFFER_HEADER* RioHeader = RioSendBufferHeaderFromBuffer(Entry);
+    CXPLAT_DBG_ASSERT(RioHeader->RioBufferId != RIO_INVALID_BUFFERID);
+
+    CxPlatLockAcquire(&Slabs->Lock);
+    RioHeader->NextFree = Slabs->FreeBuffers;
+    Slabs->FreeBuffers = RioHeader;
+    CxPlatLockRelease(&Slabs->Lock);
 }
 
 void
@@ -3787,14 +3930,44 @@ RioSendBufferFree(
     _Inout_ CXPLAT_POOL* Pool
     )
 {
-    CXPLAT_RIO_SEND_BUFFER_HEADER* RioHeader = RioSendBufferHeaderFromBuffer(Entry);
-    CXPLAT_DATAPATH* Datapath = RioHeader->Datapath;
+    CXPLAT_DATAPATH_PARTITION* DatapathProc =
+        CXPLAT_CONTAINING_RECORD(Pool, CXPLAT_DATAPATH_PARTITION, RioSendBufferPool);
+    UNREFERENCED_PARAMETER(Tag);
 
-    UNREFERENCED_PARAMETER(Pool);
+    RioSendBufferFreeInternal(&DatapathProc->RioSendSlabs, Entry);
+}
 
-    CXPLAT_DBG_ASSERT(RioHeader->RioBufferId != RIO_INVALID_BUFFERID);
-    Datapath->RioDispatch.RIODeregisterBuffer(RioHeader->RioBufferId);
-    CxPlatLargeFree(RioHeader, Tag);
+void
+RioSendLargeBufferFree(
+    _In_ void* Entry,
+    _In_ uint32_t Tag,
+    _Inout_ CXPLAT_POOL* Pool
+    )
+{
+    CXPLAT_DATAPATH_PARTITION* DatapathProc =
+        CXPLAT_CONTAINING_RECORD(Pool, CXPLAT_DATAPATH_PARTITION, RioLargeSendBufferPool);
+    UNREFERENCED_PARAMETER(Tag);
+
+    RioSendBufferFreeInternal(&DatapathProc->RioLargeSendSlabs, Entry);
+}
+
+void
+RioSendSlabsUninitialize(
+    _In_ CXPLAT_DATAPATH* Datapath,
+    _Inout_ CXPLAT_RIO_SEND_SLABS* Slabs
+    )
+{
+    while (!CxPlatListIsEmpty(&Slabs->Slabs)) {
+        CXPLAT_RIO_SEND_SLAB* Slab =
+            CXPLAT_CONTAINING_RECORD(
+                CxPlatListRemoveHead(&Slabs->Slabs), CXPLAT_RIO_SEND_SLAB, Link);
+        Datapath->RioDispatch.RIODeregisterBuffer(Slab->RioBufferId);
+        CxPlatLargeFree(Slab, QUIC_POOL_DATA);
+    }
+    Slabs->FreeBuffers = NULL;
+    Slabs->NextBuffer = NULL;
+    Slabs->RemainingBuffers = 0;
+    CxPlatLockUninitialize(&Slabs->Lock);
 }
 
 static
@@ -3811,12 +3984,14 @@ CxPlatSendDataCanAllocSendSegment(
     CXPLAT_DBG_ASSERT(SendData->SegmentSize > 0);
     CXPLAT_DBG_ASSERT(SendData->WsaBufferCount > 0);
 
-    ULONG BytesAvailable =
-        CXPLAT_LARGE_SEND_BUFFER_SIZE -
-            SendData->WsaBuffers[SendData->WsaBufferCount - 1].len -
-            SendData->ClientBuffer.len;
+    const ULONG BytesUsed =
+        SendData->WsaBuffers[SendData->WsaBufferCount - 1].len +
+        SendData->ClientBuffer.len;
+    if (BytesUsed / SendData->SegmentSize >= SendData->MaxSegments) {
+        return FALSE;
+    }
 
-    return MaxBufferLength <= BytesAvailable;
+    return MaxBufferLength <= CXPLAT_LARGE_SEND_BUFFER_SIZE - BytesUsed;
 }
 
 static
@@ -4076,6 +4251,7 @@ CxPlatSocketSendWithRio(
             RioSendBufferHeaderFromBuffer(SendData->WsaBuffers[i].buf);
 
         Data.BufferId = SendHeader->RioBufferId;
+        Data.Offset = SendHeader->RioOffset;
         Data.Length = SendData->WsaBuffers[i].len;
         SendHeader->IoType = DATAPATH_IO_RIO_SEND;
         SendHeader->SendData = SendData;
@@ -4403,6 +4579,50 @@ CxPlatSocketGetTcpStatistics(
 #endif
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+CxPlatSocketSetTcpTls(
+    _In_ CXPLAT_SOCKET* Socket,
+    _In_ BOOLEAN Send,
+    _In_ CXPLAT_QEO_CIPHER_TYPE CipherType,
+    _In_reads_(32) const uint8_t* Key,
+    _In_reads_(12) const uint8_t* Iv
+    )
+{
+    UNREFERENCED_PARAMETER(Socket);
+    UNREFERENCED_PARAMETER(Send);
+    UNREFERENCED_PARAMETER(CipherType);
+    UNREFERENCED_PARAMETER(Key);
+    UNREFERENCED_PARAMETER(Iv);
+    return QUIC_STATUS_NOT_SUPPORTED;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+CxPlatSocketGetUdpRecvStatistics(
+    _In_ CXPLAT_SOCKET* Socket,
+    _Out_ CXPLAT_UDP_RECV_STATISTICS* Statistics
+    )
+{
+    UNREFERENCED_PARAMETER(Socket);
+    UNREFERENCED_PARAMETER(Statistics);
+    return QUIC_STATUS_NOT_SUPPORTED;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+CxPlatSocketGetUdpPartitionRecvStatistics(
+    _In_ CXPLAT_SOCKET* Socket,
+    _In_ uint16_t PartitionIndex,
+    _Out_ CXPLAT_UDP_RECV_STATISTICS* Statistics
+    )
+{
+    UNREFERENCED_PARAMETER(Socket);
+    UNREFERENCED_PARAMETER(PartitionIndex);
+    UNREFERENCED_PARAMETER(Statistics);
+    return QUIC_STATUS_NOT_SUPPORTED;
+}
+
 void
 DataPathProcessCqe(
     _In_ CXPLAT_CQE* Cqe
@@ -108,6 +108,33 @@ CxPlatDataPathGetSupportedFeatures(
     return DataPathGetSupportedFeatures(Datapath);
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint16_t
+CxPlatDataPathGetMaxSendSegments(
+    _In_ CXPLAT_DATAPATH* Datapath
+    )
+{
+    //
+    // Raw sends go out one packet at a time, so only the socket datapath
+    // batches.
+    //
+    return DataPathGetMaxSendSegments(Datapath);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+uint32_t
+CxPlatDataPathGetQueueStatistics(
+    _In_ CXPLAT_DATAPATH* Datapath,
+    _Out_writes_opt_(Capacity) QUIC_DATAPATH_QUEUE_STATISTICS* Statistics,
+    _In_ uint32_t Capacity
+    )
+{
+    if (Datapath->RawDataPath) {
+        return RawDataPathGetQueueStatistics(Datapath->RawDataPath, Statistics, Capacity);
+    }
+    return 0;
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 BOOLEAN
 CxPlatDataPathIsPaddingPreferred(
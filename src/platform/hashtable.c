@@ -40,6 +40,10 @@ Notes:
     hash table now has information about the location, and does not have to
     traverse the hash table chains again.
 
+    Tables created with CxPlatHashtableInitializeOpen use open addressing
+    instead of chains (see CxPlatOpenHash* below), so lookups don't chase
+    pointers through entries on other cache lines.
+
 --*/
 
 #include "platform_internal.h"
@@ -464,6 +468,528 @@ Return Value:
     Context->Signature = Signature;
 }
 
+//
+// Open addressing (CXPLAT_HASH_OPEN_ADDRESSING).
+//
+// The slots are arranged in groups of CXPLAT_HASH_GROUP_SIZE. Each slot has a
+// control byte that is either EMPTY, DELETED or a 7-bit tag taken from the
+// hash of the entry's signature. A lookup compares the tag against all the
+// control bytes of a group at once (with SSE2, where available) and only
+// follows the entry pointers that match, probing further groups until it
+// reaches one with an empty slot. Entries never move within a table, so
+// removing the current entry during an enumeration is safe.
+//
+// Like linear hashing, resizing never rehashes the whole table at once. The
+// new slots are allocated, and each later insert or remove then moves one
+// group of the old slots over. Lookups search both until the move completes.
+// Moves are paused while an enumeration is in progress.
+//
+
+#if defined(_M_X64) || defined(__x86_64__)
+#include <emmintrin.h>
+#define CXPLAT_HASH_SSE2 1
+#endif
+
+#define CXPLAT_HASH_GROUP_SIZE      16
+#define CXPLAT_HASH_CONTROL_EMPTY   0x80
+#define CXPLAT_HASH_CONTROL_DELETED 0xFE
+
+//
+// The table is resized once more than 7/8 of the slots are full or deleted.
+//
+#define CXPLAT_HASH_MAX_USED_SLOTS(TableSize) ((TableSize) / 8 * 7)
+
+#define CXPLAT_HASH_MAX_OPEN_TABLE_SIZE (1u << 30)
+
+typedef struct CXPLAT_HASHTABLE_GROUP {
+    uint8_t Control[CXPLAT_HASH_GROUP_SIZE];
+    CXPLAT_HASHTABLE_ENTRY* Entries[CXPLAT_HASH_GROUP_SIZE];
+} CXPLAT_HASHTABLE_GROUP;
+
+static
+QUIC_NO_SANITIZE("unsigned-integer-overflow")
+uint64_t
+CxPlatOpenHashMix(
+    _In_ uint64_t Signature
+    )
+{
+    //
+    // Fibonacci hashing. Signatures are often small or sequential (stream
+    // IDs), so the group index and tag are taken from the well mixed high
+    // bits of the product.
+    //
+    return Signature * 0x9E3779B97F4A7C15ull;
+}
+
+#define CxPlatOpenHashTag(Hash) ((uint8_t)((Hash) >> 57))
+#define CxPlatOpenHashGroup(Hash, GroupMask) ((uint32_t)((Hash) >> 25) & (GroupMask))
+
+static
+uint32_t
+CxPlatOpenHashFirstBit(
+    _In_ uint32_t Mask
+    )
+{
+    CXPLAT_DBG_ASSERT(Mask != 0);
+#ifdef _MSC_VER
+    unsigned long Index;
+    _BitScanForward(&Index, (unsigned long)Mask);
+    return (uint32_t)Index;
+#else
+    return (uint32_t)__builtin_ctz(Mask);
+#endif
+}
+
+//
+// Returns a bit mask of the slots in the group whose control byte is Value.
+//
+static
+uint32_t
+CxPlatOpenHashMatch(
+    _In_ const CXPLAT_HASHTABLE_GROUP* Group,
+    _In_ uint8_t Value
+    )
+{
+#ifdef CXPLAT_HASH_SSE2
+    return
+        (uint32_t)_mm_movemask_epi8(
+            _mm_cmpeq_epi8(
+                _mm_loadu_si128((const __m128i*)Group->Control),
+                _mm_set1_epi8((char)Value)));
+#else
+    uint32_t Mask = 0;
+    for (uint32_t i = 0; i < CXPLAT_HASH_GROUP_SIZE; ++i) {
+        Mask |= (uint32_t)(Group->Control[i] == Value) << i;
+    }
+    return Mask;
+#endif
+}
+
+//
+// Returns a bit mask of the empty or deleted slots in the group (the only
+// control bytes with the high bit set).
+//
+static
+uint32_t
+CxPlatOpenHashMatchFree(
+    _In_ const CXPLAT_HASHTABLE_GROUP* Group
+    )
+{
+#ifdef CXPLAT_HASH_SSE2
+    return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)Group->Control));
+#else
+    uint32_t Mask = 0;
+    for (uint32_t i = 0; i < CXPLAT_HASH_GROUP_SIZE; ++i) {
+        Mask |= (uint32_t)(Group->Control[i] >> 7) << i;
+    }
+    return Mask;
+#endif
+}
+
+static
+CXPLAT_HASHTABLE_GROUP*
+CxPlatOpenHashAllocateGroups(
+    _In_ uint32_t TableSize
+    )
+{
+    const uint32_t GroupCount = TableSize / CXPLAT_HASH_GROUP_SIZE;
+    CXPLAT_HASHTABLE_GROUP* Groups =
+        CXPLAT_ALLOC_NONPAGED(
+            GroupCount * sizeof(CXPLAT_HASHTABLE_GROUP),
+            QUIC_POOL_HASHTABLE_MEMBER);
+    if (Groups == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "hashtable groups",
+            GroupCount * sizeof(CXPLAT_HASHTABLE_GROUP));
+        return NULL;
+    }
+    for (uint32_t i = 0; i < GroupCount; ++i) {
+        for (uint32_t j = 0; j < CXPLAT_HASH_GROUP_SIZE; ++j) {
+            Groups[i].Control[j] = CXPLAT_HASH_CONTROL_EMPTY;
+        }
+    }
+    return Groups;
+}
+
+//
+// Puts the entry in the first free slot of its probe sequence in Groups. The
+// caller makes sure there is one.
+//
+static
+void
+CxPlatOpenHashPlace(
+    _Inout_ CXPLAT_HASHTABLE* HashTable,
+    _In_ CXPLAT_HASHTABLE_ENTRY* Entry
+    )
+{
+    const uint64_t Hash = CxPlatOpenHashMix(Entry->Signature);
+    const uint32_t GroupMask = HashTable->TableSize / CXPLAT_HASH_GROUP_SIZE - 1;
+    uint32_t GroupIndex = CxPlatOpenHashGroup(Hash, GroupMask);
+
+    for (uint32_t Probe = 1; ; ++Probe) {
+        CXPLAT_HASHTABLE_GROUP* Group = &HashTable->Groups[GroupIndex];
+        const uint32_t Free = CxPlatOpenHashMatchFree(Group);
+        if (Free != 0) {
+            const uint32_t Slot = CxPlatOpenHashFirstBit(Free);
+            if (Group->Control[Slot] == CXPLAT_HASH_CONTROL_EMPTY) {
+                HashTable->UsedSlots++;
+            }
+            Group->Control[Slot] = CxPlatOpenHashTag(Hash);
+            Group->Entries[Slot] = Entry;
+            return;
+        }
+        CXPLAT_FRE_ASSERT(Probe <= GroupMask);
+        //
+        // Triangular probing visits every group when the count is a power of
+        // two.
+        //
+        GroupIndex = (GroupIndex + Probe) & GroupMask;
+    }
+}
+
+//
+// Finds the slot holding the entry, in Groups or else in OldGroups.
+//
+static
+void
+CxPlatOpenHashFindEntry(
+    _In_ const CXPLAT_HASHTABLE* HashTable,
+    _In_ const CXPLAT_HASHTABLE_ENTRY* Entry,
+    _Out_ CXPLAT_HASHTABLE_GROUP** FoundGroup,
+    _Out_ uint32_t* FoundSlot,
+    _Out_ BOOLEAN* InOldGroups
+    )
+{
+    const uint64_t Hash = CxPlatOpenHashMix(Entry->Signature);
+    const uint8_t Tag = CxPlatOpenHashTag(Hash);
+
+    for (uint32_t Old = 0; Old < 2; ++Old) {
+        CXPLAT_HASHTABLE_GROUP* Groups = Old ? HashTable->OldGroups : HashTable->Groups;
+        if (Groups == NULL) {
+            break;
+        }
+        const uint32_t GroupMask =
+            (Old ? HashTable->OldTableSize : HashTable->TableSize) / CXPLAT_HASH_GROUP_SIZE - 1;
+        uint32_t GroupIndex = CxPlatOpenHashGroup(Hash, GroupMask);
+        for (uint32_t Probe = 1; ; ++Probe) {
+            CXPLAT_HASHTABLE_GROUP* Group = &Groups[GroupIndex];
+            uint32_t Matches = CxPlatOpenHashMatch(Group, Tag);
+            while (Matches != 0) {
+                const uint32_t Slot = CxPlatOpenHashFirstBit(Matches);
+                if (Group->Entries[Slot] == Entry) {
+                    *FoundGroup = Group;
+                    *FoundSlot = Slot;
+                    *InOldGroups = (BOOLEAN)Old;
+                    return;
+                }
+                Matches &= Matches - 1;
+            }
+            if (CxPlatOpenHashMatch(Group, CXPLAT_HASH_CONTROL_EMPTY) != 0 ||
+                Probe > GroupMask) {
+                break;
+            }
+            GroupIndex = (GroupIndex + Probe) & GroupMask;
+        }
+    }
+
+    CXPLAT_FRE_ASSERTMSG(FALSE, "Entry isn't in the hash table");
+    *FoundGroup = NULL;
+    *FoundSlot = 0;
+    *InOldGroups = FALSE;
+}
+
+//
+// Moves the next group of OldGroups into Groups, and frees OldGroups once
+// they're all moved.
+//
+static
+void
+CxPlatOpenHashMigrateGroup(
+    _Inout_ CXPLAT_HASHTABLE* HashTable
+    )
+{
+    CXPLAT_DBG_ASSERT(HashTable->OldGroups != NULL);
+    CXPLAT_DBG_ASSERT(HashTable->NumEnumerators == 0);
+
+    CXPLAT_HASHTABLE_GROUP* Group = &HashTable->OldGroups[HashTable->MigrateIndex];
+    uint32_t Full = ~CxPlatOpenHashMatchFree(Group) & ((1u << CXPLAT_HASH_GROUP_SIZE) - 1);
+    while (Full != 0) {
+        const uint32_t Slot = CxPlatOpenHashFirstBit(Full);
+        //
+        // Leave a tombstone, so lookups in the old slots that probed past
+        // this one still find the entries after it.
+        //
+        Group->Control[Slot] = CXPLAT_HASH_CONTROL_DELETED;
+        CxPlatOpenHashPlace(HashTable, Group->Entries[Slot]);
+        Full &= Full - 1;
+    }
+
+    if (++HashTable->MigrateIndex == HashTable->OldTableSize / CXPLAT_HASH_GROUP_SIZE) {
+        CXPLAT_FREE(HashTable->OldGroups, QUIC_POOL_HASHTABLE_MEMBER);
+        HashTable->OldGroups = NULL;
+        HashTable->OldTableSize = 0;
+        HashTable->MigrateIndex = 0;
+    }
+}
+
+//
+// Starts moving the entries to new slots: twice as many if more than half of
+// the current ones hold entries, otherwise the same number (to clear out the
+// tombstones). Failure to allocate isn't fatal; it is retried on the next
+// insert.
+//
+static
+void
+CxPlatOpenHashStartResize(
+    _Inout_ CXPLAT_HASHTABLE* HashTable
+    )
+{
+    CXPLAT_DBG_ASSERT(HashTable->OldGroups == NULL);
+
+    uint32_t NewSize = HashTable->TableSize;
+    if (HashTable->NumEntries >= HashTable->TableSize / 2 &&
+        NewSize < CXPLAT_HASH_MAX_OPEN_TABLE_SIZE) {
+        NewSize *= 2;
+    }
+
+    CXPLAT_HASHTABLE_GROUP* NewGroups = CxPlatOpenHashAllocateGroups(NewSize);
+    if (NewGroups == NULL) {
+        return;
+    }
+
+    HashTable->OldGroups = HashTable->Groups;
+    HashTable->OldTableSize = HashTable->TableSize;
+    HashTable->MigrateIndex = 0;
+    HashTable->Groups = NewGroups;
+    HashTable->TableSize = NewSize;
+    HashTable->DivisorMask = NewSize / CXPLAT_HASH_GROUP_SIZE - 1;
+    HashTable->UsedSlots = 0;
+}
+
+static
+BOOLEAN
+CxPlatOpenHashInsert(
+    _Inout_ CXPLAT_HASHTABLE* HashTable,
+    _In_ CXPLAT_HASHTABLE_ENTRY* Entry,
+    _In_ uint64_t Signature
+    )
+{
+    if (HashTable->OldGroups != NULL && HashTable->NumEnumerators == 0) {
+        CxPlatOpenHashMigrateGroup(HashTable);
+    }
+
+    if (HashTable->UsedSlots >= CXPLAT_HASH_MAX_USED_SLOTS(HashTable->TableSize)) {
+        if (HashTable->NumEnumerators == 0) {
+            //
+            // The new slots filled up before the last resize finished, which
+            // only happens after enumerations held it up.
+            //
+            while (HashTable->OldGroups != NULL) {
+                CxPlatOpenHashMigrateGroup(HashTable);
+            }
+        }
+        if (HashTable->OldGroups == NULL) {
+            //
+            // During an enumeration, this only puts the current slots behind
+            // the new ones, which doesn't change their enumeration order.
+            //
+            CxPlatOpenHashStartResize(HashTable);
+        }
+    }
+
+    //
+    // There must be room in Groups for every entry, including those yet to
+    // move from OldGroups.
+    //
+    if (HashTable->NumEntries >= HashTable->TableSize) {
+        return FALSE;
+    }
+
+    Entry->Signature = Signature;
+    CxPlatOpenHashPlace(HashTable, Entry);
+    HashTable->NumEntries++;
+    return TRUE;
+}
+
+static
+void
+CxPlatOpenHashRemove(
+    _Inout_ CXPLAT_HASHTABLE* HashTable,
+    _In_ CXPLAT_HASHTABLE_ENTRY* Entry
+    )
+{
+    CXPLAT_HASHTABLE_GROUP* Group;
+    uint32_t Slot;
+    BOOLEAN InOldGroups;
+    CxPlatOpenHashFindEntry(HashTable, Entry, &Group, &Slot, &InOldGroups);
+
+    //
+    // A slot can only be made empty again if its group already has an empty
+    // slot, as then no probe sequence ever went past the group.
+    //
+    if (!InOldGroups &&
+        CxPlatOpenHashMatch(Group, CXPLAT_HASH_CONTROL_EMPTY) != 0) {
+        Group->Control[Slot] = CXPLAT_HASH_CONTROL_EMPTY;
+        HashTable->UsedSlots--;
+    } else {
+        Group->Control[Slot] = CXPLAT_HASH_CONTROL_DELETED;
+    }
+
+    CXPLAT_DBG_ASSERT(HashTable->NumEntries > 0);
+    HashTable->NumEntries--;
+
+    if (HashTable->OldGroups != NULL && HashTable->NumEnumerators == 0) {
+        CxPlatOpenHashMigrateGroup(HashTable);
+    }
+}
+
+//
+// Continues a lookup from the position in the context, and returns the next
+// entry with the context's signature.
+//
+static
+CXPLAT_HASHTABLE_ENTRY*
+CxPlatOpenHashLookupNext(
+    _In_ const CXPLAT_HASHTABLE* HashTable,
+    _Inout_ CXPLAT_HASHTABLE_LOOKUP_CONTEXT* Context
+    )
+{
+    const uint64_t Hash = CxPlatOpenHashMix(Context->Signature);
+    const uint8_t Tag = CxPlatOpenHashTag(Hash);
+
+    for (;;) {
+        const CXPLAT_HASHTABLE_GROUP* Groups;
+        uint32_t GroupMask;
+        if (Context->Open.InOldGroups) {
+            Groups = HashTable->OldGroups;
+            GroupMask = HashTable->OldTableSize / CXPLAT_HASH_GROUP_SIZE - 1;
+        } else {
+            Groups = HashTable->Groups;
+            GroupMask = HashTable->TableSize / CXPLAT_HASH_GROUP_SIZE - 1;
+        }
+
+        const CXPLAT_HASHTABLE_GROUP* Group = &Groups[Context->Open.GroupIndex];
+        while (Context->Open.Matches != 0) {
+            const uint32_t Slot = CxPlatOpenHashFirstBit(Context->Open.Matches);
+            Context->Open.Matches &= Context->Open.Matches - 1;
+            if (Group->Entries[Slot]->Signature == Context->Signature) {
+                return Group->Entries[Slot];
+            }
+        }
+
+        if (CxPlatOpenHashMatch(Group, CXPLAT_HASH_CONTROL_EMPTY) == 0 &&
+            Context->Open.Probe <= GroupMask) {
+            Context->Open.GroupIndex =
+                (Context->Open.GroupIndex + Context->Open.Probe) & GroupMask;
+            Context->Open.Probe++;
+            Group = &Groups[Context->Open.GroupIndex];
+
+        } else if (!Context->Open.InOldGroups && HashTable->OldGroups != NULL) {
+            //
+            // The end of the probe sequence in the new slots. Continue in the
+            // old ones.
+            //
+            Context->Open.InOldGroups = TRUE;
+            Context->Open.GroupIndex =
+                CxPlatOpenHashGroup(Hash, HashTable->OldTableSize / CXPLAT_HASH_GROUP_SIZE - 1);
+            Context->Open.Probe = 1;
+            Group = &HashTable->OldGroups[Context->Open.GroupIndex];
+
+        } else {
+            return NULL;
+        }
+
+        Context->Open.Matches = CxPlatOpenHashMatch(Group, Tag);
+    }
+}
+
+static
+CXPLAT_HASHTABLE_ENTRY*
+CxPlatOpenHashLookup(
+    _In_ const CXPLAT_HASHTABLE* HashTable,
+    _In_ uint64_t Signature,
+    _Out_ CXPLAT_HASHTABLE_LOOKUP_CONTEXT* Context
+    )
+{
+    const uint64_t Hash = CxPlatOpenHashMix(Signature);
+    Context->Signature = Signature;
+    Context->Open.GroupIndex = CxPlatOpenHashGroup(Hash, HashTable->DivisorMask);
+    Context->Open.Probe = 1;
+    Context->Open.InOldGroups = FALSE;
+    Context->Open.Matches =
+        CxPlatOpenHashMatch(
+            &HashTable->Groups[Context->Open.GroupIndex], CxPlatOpenHashTag(Hash));
+    return CxPlatOpenHashLookupNext(HashTable, Context);
+}
+
+//
+// Enumerates the old slots (if any), then the new ones. BucketIndex is the
+// index of the next slot to look at, across both.
+//
+static
+CXPLAT_HASHTABLE_ENTRY*
+CxPlatOpenHashEnumerateNext(
+    _In_ const CXPLAT_HASHTABLE* HashTable,
+    _Inout_ CXPLAT_HASHTABLE_ENUMERATOR* Enumerator
+    )
+{
+    const uint32_t OldTableSize = HashTable->OldGroups != NULL ? HashTable->OldTableSize : 0;
+    while (Enumerator->BucketIndex < OldTableSize + HashTable->TableSize) {
+        const uint32_t Index = Enumerator->BucketIndex;
+        const CXPLAT_HASHTABLE_GROUP* Group =
+            Index < OldTableSize ?
+                &HashTable->OldGroups[Index / CXPLAT_HASH_GROUP_SIZE] :
+                &HashTable->Groups[(Index - OldTableSize) / CXPLAT_HASH_GROUP_SIZE];
+        const uint32_t Slot = Index % CXPLAT_HASH_GROUP_SIZE;
+
+        const uint32_t Full =
+            ~CxPlatOpenHashMatchFree(Group) &
+            ((1u << CXPLAT_HASH_GROUP_SIZE) - 1) & ~((1u << Slot) - 1);
+        if (Full == 0) {
+            Enumerator->BucketIndex = Index - Slot + CXPLAT_HASH_GROUP_SIZE;
+            continue;
+        }
+
+        const uint32_t Next = CxPlatOpenHashFirstBit(Full);
+        Enumerator->BucketIndex = Index - Slot + Next + 1;
+        return Group->Entries[Next];
+    }
+
+    return NULL;
+}
+
+static
+CXPLAT_HASHTABLE*
+CxPlatHashtableInitializeHeader(
+    _Inout_ CXPLAT_HASHTABLE** HashTable
+    )
+{
+    uint32_t LocalFlags = 0;
+    CXPLAT_HASHTABLE* Table;
+    if (*HashTable == NULL) {
+        Table = CXPLAT_ALLOC_NONPAGED(sizeof(CXPLAT_HASHTABLE), QUIC_POOL_HASHTABLE);
+        if (Table == NULL) {
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "CXPLAT_HASHTABLE",
+                sizeof(CXPLAT_HASHTABLE));
+            return NULL;
+        }
+
+        LocalFlags = CXPLAT_HASH_ALLOCATED_HEADER;
+
+    } else {
+        Table = *HashTable;
+    }
+
+    CxPlatZeroMemory(Table, sizeof(CXPLAT_HASHTABLE));
+    Table->Flags = LocalFlags;
+    return Table;
+}
+
 _Must_inspect_result_
 _Success_(return != FALSE)
 BOOLEAN
@@ -511,27 +1037,11 @@ Return Value:
     //
     // First allocate the hash Table header.
     //
-    uint32_t LocalFlags = 0;
-    CXPLAT_HASHTABLE* Table;
-    if (*HashTable == NULL) {
-        Table = CXPLAT_ALLOC_NONPAGED(sizeof(CXPLAT_HASHTABLE), QUIC_POOL_HASHTABLE);
-        if (Table == NULL) {
-            QuicTraceEvent(
-                AllocFailure,
-                "Allocation of '%s' failed. (%llu bytes)",
-                "CXPLAT_HASHTABLE",
-                sizeof(CXPLAT_HASHTABLE));
-            return FALSE;
-        }
-
-        LocalFlags = CXPLAT_HASH_ALLOCATED_HEADER;
-
-    } else {
-        Table = *HashTable;
+    CXPLAT_HASHTABLE* Table = CxPlatHashtableInitializeHeader(HashTable);
+    if (Table == NULL) {
+        return FALSE;
     }
 
-    CxPlatZeroMemory(Table, sizeof(CXPLAT_HASHTABLE));
-    Table->Flags = LocalFlags;
     Table->TableSize = InitialSize;
     Table->DivisorMask = Table->TableSize - 1;
     Table->Pivot = 0;
@@ -614,6 +1124,57 @@ Return Value:
     return TRUE;
 }
 
+_Must_inspect_result_
+_Success_(return != FALSE)
+BOOLEAN
+CxPlatHashtableInitializeOpen(
+    _Inout_ _When_(NULL == *HashTable, _At_(*HashTable, __drv_allocatesMem(Mem) _Post_notnull_))
+        CXPLAT_HASHTABLE* *HashTable,
+    _In_ uint32_t InitialSize
+    )
+/*++
+
+Routine Description:
+
+    Creates an open addressed hash table. See CxPlatHashtableInitialize.
+
+Arguments:
+
+    HashTable - Pointer to a pointer to a hash Table to be initialized.
+
+    InitialSize - The initial number of slots in the hash table.
+
+Return Value:
+
+    TRUE if creation and initialization succeeded, FALSE otherwise.
+
+--*/
+{
+    if (!IS_POWER_OF_TWO(InitialSize) ||
+        (InitialSize > CXPLAT_HASH_MAX_OPEN_TABLE_SIZE) ||
+        (InitialSize < CXPLAT_HASH_GROUP_SIZE)) {
+        return FALSE;
+    }
+
+    CXPLAT_HASHTABLE* Table = CxPlatHashtableInitializeHeader(HashTable);
+    if (Table == NULL) {
+        return FALSE;
+    }
+
+    Table->Flags |= CXPLAT_HASH_OPEN_ADDRESSING;
+    Table->TableSize = InitialSize;
+    Table->DivisorMask = InitialSize / CXPLAT_HASH_GROUP_SIZE - 1;
+    Table->Groups = CxPlatOpenHashAllocateGroups(InitialSize);
+    if (Table->Groups == NULL) {
+        CxPlatHashtableUninitialize(Table);
+        return FALSE;
+    }
+
+    *HashTable = Table;
+
+    return TRUE;
+}
+
 void
 CxPlatHashtableUninitialize(
     _In_
@@ -645,7 +1206,18 @@ Arguments:
     CXPLAT_DBG_ASSERT(HashTable->NumEnumerators == 0);
     CXPLAT_DBG_ASSERT(HashTable->NumEntries == 0);
 
-    if (HashTable->TableSize <= HT_SECOND_LEVEL_DIR_MIN_SIZE) {
+    if (HashTable->Flags & CXPLAT_HASH_OPEN_ADDRESSING) {
+
+        if (HashTable->Groups != NULL) {
+            CXPLAT_FREE(HashTable->Groups, QUIC_POOL_HASHTABLE_MEMBER);
+            HashTable->Groups = NULL;
+        }
+        if (HashTable->OldGroups != NULL) {
+            CXPLAT_FREE(HashTable->OldGroups, QUIC_POOL_HASHTABLE_MEMBER);
+            HashTable->OldGroups = NULL;
+        }
+
+    } else if (HashTable->TableSize <= HT_SECOND_LEVEL_DIR_MIN_SIZE) {
 
         if (HashTable->SecondLevelDir != NULL) {
             CXPLAT_FREE(HashTable->SecondLevelDir, QUIC_POOL_HASHTABLE_MEMBER);
@@ -705,7 +1277,7 @@ Arguments:
     }
 }
 
-void
+BOOLEAN
 CxPlatHashtableInsert(
     _In_ CXPLAT_HASHTABLE* HashTable,
     _In_ __drv_aliasesMem CXPLAT_HASHTABLE_ENTRY* Entry,
@@ -736,7 +1308,13 @@ Arguments:
 
     Signature - Signature of the entry to be inserted.
 
-    Context - Pointer to optional context that can be passed in.
+    Context - Pointer to optional context that can be passed in. Ignored for
+        open addressed tables.
+
+Return Value:
+
+    FALSE if the table is open addressed, full and couldn't be grown; TRUE
+    otherwise.
 
 --*/
 {
@@ -747,6 +1325,10 @@ Arguments:
         Signature = CXPLAT_HASH_ALT_SIGNATURE;
     }
 
+    if (HashTable->Flags & CXPLAT_HASH_OPEN_ADDRESSING) {
+        return CxPlatOpenHashInsert(HashTable, Entry, Signature);
+    }
+
     Entry->Signature = Signature;
 
     HashTable->NumEntries++;
@@ -789,6 +1371,8 @@ Arguments:
         } while ((RestructAttempts > 0) &&
                  (HashTable->NumEntries > CXPLAT_HASHTABLE_MAX_CHAIN_LENGTH * HashTable->NonEmptyBuckets));
     }
+
+    return TRUE;
 }
 
 void
@@ -828,6 +1412,14 @@ Arguments:
 {
     uint64_t Signature = Entry->Signature;
 
+    if (HashTable->Flags & CXPLAT_HASH_OPEN_ADDRESSING) {
+        CxPlatOpenHashRemove(HashTable, Entry);
+        if (Context != NULL) {
+            Context->Signature = Signature;
+        }
+        return;
+    }
+
     CXPLAT_DBG_ASSERT(HashTable->NumEntries > 0);
     HashTable->NumEntries--;
 
@@ -918,6 +1510,10 @@ Return Value:
     CXPLAT_HASHTABLE_LOOKUP_CONTEXT* ContextPtr =
         (Context != NULL) ? Context : &LocalContext; // cppcheck-suppress uninitvar
 
+    if (HashTable->Flags & CXPLAT_HASH_OPEN_ADDRESSING) {
+        return CxPlatOpenHashLookup(HashTable, Signature, ContextPtr);
+    }
+
     CxPlatPopulateContext(HashTable, ContextPtr, Signature);
 
     CXPLAT_LIST_ENTRY* CurEntry = ContextPtr->PrevLinkage->Flink;
@@ -974,6 +1570,10 @@ Return Value:
 --*/
 {
     CXPLAT_DBG_ASSERT(NULL != Context);
+    if (HashTable->Flags & CXPLAT_HASH_OPEN_ADDRESSING) {
+        return CxPlatOpenHashLookupNext(HashTable, Context);
+    }
+
     CXPLAT_DBG_ASSERT(NULL != Context->ChainHead);
     CXPLAT_DBG_ASSERT(Context->PrevLinkage->Flink != Context->ChainHead);
 
@@ -1062,6 +1662,13 @@ Arguments:
 {
     CXPLAT_DBG_ASSERT(Enumerator != NULL);
 
+    if (HashTable->Flags & CXPLAT_HASH_OPEN_ADDRESSING) {
+        HashTable->NumEnumerators++;
+        Enumerator->BucketIndex = 0;
+        Enumerator->ChainHead = NULL;
+        return;
+    }
+
     CXPLAT_HASHTABLE_LOOKUP_CONTEXT LocalContext;
     CxPlatPopulateContext(HashTable, &LocalContext, 0);
     HashTable->NumEnumerators++;
@@ -1116,6 +1723,10 @@ Return Value:
 --*/
 {
     CXPLAT_DBG_ASSERT(Enumerator != NULL);
+    if (HashTable->Flags & CXPLAT_HASH_OPEN_ADDRESSING) {
+        return CxPlatOpenHashEnumerateNext(HashTable, Enumerator);
+    }
+
     CXPLAT_DBG_ASSERT(Enumerator->ChainHead != NULL);
     CXPLAT_DBG_ASSERT(CXPLAT_HASH_RESERVED_SIGNATURE == Enumerator->HashEntry.Signature);
 
@@ -1202,6 +1813,10 @@ Arguments:
     CXPLAT_DBG_ASSERT(HashTable->NumEnumerators > 0);
     HashTable->NumEnumerators--;
 
+    if (HashTable->Flags & CXPLAT_HASH_OPEN_ADDRESSING) {
+        return;
+    }
+
     if (!CxPlatListIsEmpty(&(Enumerator->HashEntry.Linkage))) {
         CXPLAT_DBG_ASSERT(Enumerator->ChainHead != NULL);
 
@@ -171,6 +171,13 @@ InterlockedExchangePointer(
     _In_opt_ void* Value
     );
 
+void*
+InterlockedCompareExchangePointer(
+    _Inout_ _Interlocked_operand_ void* volatile *Destination,
+    _In_opt_ void* ExChange,
+    _In_opt_ void* Comperand
+    );
+
 void*
 InterlockedFetchAndClearPointer(
     _Inout_ _Interlocked_operand_ void* volatile *Target
@@ -209,6 +216,14 @@ CxPlatHashtableInitializeEx(
     _In_ uint32_t InitialSize
     );
 
+_Must_inspect_result_
+_Success_(return != 0)
+BOOLEAN
+CxPlatHashtableInitializeOpenEx(
+    _Inout_ CXPLAT_HASHTABLE* HashTable,
+    _In_ uint32_t InitialSize
+    );
+
 uint32_t
 CxPlatHashSimple(
     _In_ uint16_t Length,
@@ -411,6 +426,15 @@ CxPlatEventQCleanup(
     _In_ CXPLAT_EVENTQ* queue
     );
 
+#ifdef CXPLAT_EVENTQ_BUSY_POLL
+BOOLEAN
+CxPlatEventQSetBusyPoll(
+    _In_ CXPLAT_EVENTQ* queue,
+    _In_ uint32_t busy_poll_us,
+    _In_ uint16_t budget
+    );
+#endif
+
 #ifdef CXPLAT_SQE
 BOOLEAN
 CxPlatEventQEnqueue(
@@ -460,6 +484,13 @@ CxPlatCqeUserData(
     _In_ const CXPLAT_CQE* cqe
     );
 
+#if !defined(_WIN32) && defined(__aarch64__)
+uint64_t
+CxPlatCycleCount(
+    void
+    );
+#endif
+
 struct clog_param;
 
 char *
@@ -84,12 +84,6 @@ typedef struct CXPLAT_SEND_DATA_COMMON {
     uint8_t ECN; // CXPLAT_ECN_TYPE
 } CXPLAT_SEND_DATA_COMMON;
 
-typedef enum CXPLAT_DATAPATH_TYPE {
-    CXPLAT_DATAPATH_TYPE_UNKNOWN = 0,
-    CXPLAT_DATAPATH_TYPE_USER,
-    CXPLAT_DATAPATH_TYPE_RAW, // currently raw == xdp
-} CXPLAT_DATAPATH_TYPE;
-
 //
 // Type of IO.
 //
@@ -198,6 +192,32 @@ typedef struct CX_PLATFORM {
 
 } CX_PLATFORM;
 
+//
+// Hands out RIO send buffers carved from large slabs, each registered with RIO
+// once, instead of registering every buffer on its own.
+//
+typedef struct CXPLAT_RIO_SEND_SLABS {
+
+    CXPLAT_LOCK Lock;
+
+    //
+    // List of CXPLAT_RIO_SEND_SLAB, all freed with the partition.
+    //
+    CXPLAT_LIST_ENTRY Slabs;
+
+    //
+    // Buffers given back by the pool, linked through their headers.
+    //
+    struct CXPLAT_RIO_SEND_BUFFER_HEADER* FreeBuffers;
+
+    //
+    // The newest slab's next unused buffer, and how many are left.
+    //
+    uint8_t* NextBuffer;
+    uint32_t RemainingBuffers;
+
+} CXPLAT_RIO_SEND_SLABS;
+
 //
 // Represents a single IO completion port and thread for processing work that is
 // completed on a single processor.
@@ -261,6 +281,12 @@ typedef struct QUIC_CACHEALIGN CXPLAT_DATAPATH_PROC {
     //
     CXPLAT_POOL RioLargeSendBufferPool;
 
+    //
+    // The registered memory backing the two RIO send buffer pools.
+    //
+    CXPLAT_RIO_SEND_SLABS RioSendSlabs;
+    CXPLAT_RIO_SEND_SLABS RioLargeSendSlabs;
+
     //
     // Pool of receive datagram contexts and buffers to be shared by all sockets
     // on this core.
@@ -656,6 +682,16 @@ CxPlatWorkerPoolLazyStart(
     _In_opt_ QUIC_EXECUTION_CONFIG* Config
     );
 
+//
+// Starts a worker's thread before the datapath hands it a socket. Returns
+// FALSE if the thread couldn't be created.
+//
+BOOLEAN
+CxPlatWorkerPoolStartWorker(
+    _In_ CXPLAT_WORKER_POOL* WorkerPool,
+    _In_ uint16_t Index
+    );
+
 CXPLAT_EVENTQ*
 CxPlatWorkerPoolGetEventQ(
     _In_ const CXPLAT_WORKER_POOL* WorkerPool,
@@ -691,10 +727,23 @@ CxPlatDpRawGetDatapathSize(
 #define CXPLAT_CQE_TYPE_XDP_SHUTDOWN        CXPLAT_CQE_TYPE_QUIC_BASE + 6
 #define CXPLAT_CQE_TYPE_XDP_IO              CXPLAT_CQE_TYPE_QUIC_BASE + 7
 #define CXPLAT_CQE_TYPE_XDP_FLUSH_TX        CXPLAT_CQE_TYPE_QUIC_BASE + 8
+#define CXPLAT_CQE_TYPE_SOCKET_URING        CXPLAT_CQE_TYPE_QUIC_BASE + 9
+
+//
+// The default time, in microseconds, to busy poll the NIC queues for when
+// QUIC_EXECUTION_CONFIG_FLAG_BUSY_POLL is set without a polling idle timeout.
+//
+#define CXPLAT_BUSY_POLL_DEFAULT_US         50
+
+//
+// The maximum number of packets processed per busy poll iteration.
+//
+#define CXPLAT_BUSY_POLL_BUDGET             64
 
 #if defined(CX_PLATFORM_LINUX)
 
 typedef struct CXPLAT_DATAPATH_PARTITION CXPLAT_DATAPATH_PARTITION;
+typedef struct CXPLAT_URING CXPLAT_URING;
 
 //
 // Socket context.
@@ -741,6 +790,41 @@ typedef struct QUIC_CACHEALIGN CXPLAT_SOCKET_CONTEXT {
     //
     CXPLAT_LOCK TxQueueLock;
 
+    //
+    // The head of list containing all MSG_ZEROCOPY sends still referenced by
+    // the kernel, in the order they were sent.
+    //
+    CXPLAT_LIST_ENTRY ZeroCopyQueue;
+
+    //
+    // Lock around the ZeroCopyQueue list and zerocopy send numbering.
+    //
+    CXPLAT_LOCK ZeroCopyLock;
+
+    //
+    // The kernel's identifier for the next successful zerocopy send.
+    //
+    uint32_t ZeroCopyNextId;
+
+    //
+    // The number of messages currently read per receive call, adapted to the
+    // observed number of messages per wakeup.
+    //
+    uint16_t RecvBatchSize;
+
+    //
+    // Moving average, in 1/16ths, of the messages received per wakeup.
+    //
+    uint16_t RecvMessagesPerWakeup;
+
+    //
+    // Receive statistics.
+    //
+    uint64_t RecvWakeups;
+    uint64_t RecvCalls;
+    uint64_t RecvMessages;
+    uint64_t RecvMisdirected;
+
     //
     // Rundown for synchronizing clean up with upcalls.
     //
@@ -756,11 +840,39 @@ typedef struct QUIC_CACHEALIGN CXPLAT_SOCKET_CONTEXT {
     //
     BOOLEAN IoStarted : 1;
 
+    //
+    // Indicates the socket's IO is driven by the partition's io_uring instead
+    // of epoll readiness notifications.
+    //
+    BOOLEAN UseIoUring : 1;
+
+    //
+    // Indicates the io_uring shutdown (cancellation) has been started.
+    //
+    BOOLEAN UringShutdown : 1;
+
+    //
+    // Indicates SO_ZEROCOPY was successfully enabled on the socket.
+    //
+    BOOLEAN ZeroCopyConfigured : 1;
+
+    //
+    // Indicates large sends should use MSG_ZEROCOPY. Cleared if the kernel
+    // reports it had to copy the data anyways.
+    //
+    BOOLEAN ZeroCopyEnabled : 1;
+
 #if DEBUG
     uint8_t Uninitialized : 1;
     uint8_t Freed : 1;
 #endif
 
+    //
+    // The number of outstanding io_uring operations (plus one for the socket
+    // itself) that reference this socket context.
+    //
+    long UringRefCount;
+
     CXPLAT_SOCKET* AcceptSocket;
 
 } CXPLAT_SOCKET_CONTEXT;
@@ -796,6 +908,19 @@ typedef struct CXPLAT_SOCKET {
     //
     uint32_t RecvBufLen;
 
+    //
+    // The number of socket contexts.
+    //
+    uint16_t SocketCount;
+
+    //
+    // The CID layout used to steer short header packets to their partition,
+    // or a CidPartitionCount of zero if not steering.
+    //
+    uint8_t CidPartitionIdOffset;
+    uint16_t CidPartitionMask;
+    uint16_t CidPartitionCount;
+
     //
     // Indicates the binding connected to a remote IP address.
     //
@@ -808,7 +933,7 @@ typedef struct CXPLAT_SOCKET {
 
     //
     // Flag indicates the socket has more than one socket, affinitized to all
-    // the processors.
+    // the processors (or partitions).
     //
     uint8_t NumPerProcessorSockets : 1;
 
@@ -843,6 +968,28 @@ typedef struct CXPLAT_SOCKET {
 
 } CXPLAT_SOCKET;
 
+//
+// A pool of fixed size IO blocks, optionally backed by a slab of huge pages.
+// Blocks are handed out from the slab first and the regular pool only once the
+// slab is exhausted.
+//
+typedef struct CXPLAT_BLOCK_POOL {
+
+    CXPLAT_POOL Pool;
+
+    //
+    // The huge page slab, or NULL if huge pages aren't used (or available).
+    //
+    uint8_t* Slab;
+    size_t SlabSize;
+
+    //
+    // The free blocks of the slab. Protected by the pool's lock.
+    //
+    CXPLAT_SLIST_ENTRY SlabFreeList;
+
+} CXPLAT_BLOCK_POOL;
+
 //
 // A per processor datapath context.
 //
@@ -876,13 +1023,19 @@ typedef struct QUIC_CACHEALIGN CXPLAT_DATAPATH_PARTITION {
     // Pool of receive packet contexts and buffers to be shared by all sockets
     // on this core.
     //
-    CXPLAT_POOL RecvBlockPool;
+    CXPLAT_BLOCK_POOL RecvBlockPool;
 
     //
     // Pool of send packet contexts and buffers to be shared by all sockets
     // on this core.
     //
-    CXPLAT_POOL SendBlockPool;
+    CXPLAT_BLOCK_POOL SendBlockPool;
+
+    //
+    // The io_uring instance (and its provided receive buffer ring) shared by
+    // all UDP sockets on this partition. NULL if io_uring isn't being used.
+    //
+    CXPLAT_URING* Uring;
 
 } CXPLAT_DATAPATH_PARTITION;
 
@@ -946,6 +1099,33 @@ typedef struct CXPLAT_DATAPATH {
 
     uint8_t UseTcp : 1;
 
+    //
+    // Indicates UDP IO should be driven by per-partition io_uring instances.
+    //
+    uint8_t UseIoUring : 1;
+
+    //
+    // Indicates large segmented UDP sends should use MSG_ZEROCOPY.
+    //
+    uint8_t UseZeroCopySend : 1;
+
+    //
+    // Indicates the per-partition send and receive block pools should be
+    // backed by huge pages.
+    //
+    uint8_t UseHugePages : 1;
+
+    //
+    // Indicates server sockets should create one SO_REUSEPORT socket per
+    // partition, instead of one per processor.
+    //
+    uint8_t UsePartitionSockets : 1;
+
+    //
+    // The time, in microseconds, sockets busy poll for, or zero if disabled.
+    //
+    uint32_t BusyPollUs;
+
     CXPLAT_DATAPATH_RAW* RawDataPath;
 
     //
@@ -1024,6 +1204,12 @@ DataPathGetSupportedFeatures(
     _In_ CXPLAT_DATAPATH* Datapath
     );
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint16_t
+DataPathGetMaxSendSegments(
+    _In_ CXPLAT_DATAPATH* Datapath
+    );
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 BOOLEAN
 DataPathIsPaddingPreferred(
@@ -1140,6 +1326,14 @@ RawDataPathGetSupportedFeatures(
     _In_ CXPLAT_DATAPATH_RAW* Datapath
     );
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+uint32_t
+RawDataPathGetQueueStatistics(
+    _In_ CXPLAT_DATAPATH_RAW* Datapath,
+    _Out_writes_opt_(Capacity) QUIC_DATAPATH_QUEUE_STATISTICS* Statistics,
+    _In_ uint32_t Capacity
+    );
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 BOOLEAN
 RawDataPathIsPaddingPreferred(
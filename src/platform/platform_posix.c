@@ -32,6 +32,11 @@ Environment:
 #include "platform_posix.c.clog.h"
 #endif
 
+#if defined(CX_PLATFORM_LINUX) && defined(__x86_64__) && !defined(QUIC_SIMULATION)
+#define CXPLAT_USE_TSC_CLOCK 1
+#include <cpuid.h>
+#endif
+
 #ifdef CXPLAT_NUMA_AWARE
 #include <numa.h>               // If missing: `apt-get install -y libnuma-dev`
 uint32_t CxPlatNumaNodeCount;
@@ -41,7 +46,14 @@ cpu_set_t* CxPlatNumaNodeMasks;
 #define CXPLAT_MAX_LOG_MSG_LEN        1024 // Bytes
 
 CX_PLATFORM CxPlatform = { NULL };
-int RandomFd = -1; // Used for reading random numbers.
+int RandomFd = -1; // Used for seeding random numbers.
+static long volatile CxPlatRandomGeneration = 1; // See CXPLAT_RANDOM_STATE
+#ifdef QUIC_SIMULATION
+static uint64_t CxPlatSimulationTimeUs = CXPLAT_SIMULATION_START_TIME_US;
+static uint64_t CxPlatSimulationSeed;
+static uint64_t CxPlatSimulationStreams; // Threads seeded since the seed was set
+#endif
+static void CxPlatRandomOnFork(void);
 QUIC_TRACE_RUNDOWN_CALLBACK* QuicTraceRundownCallback;
 
 #define STR_HELPER(x) #x
@@ -52,13 +64,47 @@ QUIC_TRACE_RUNDOWN_CALLBACK* QuicTraceRundownCallback;
 static const char TpLibName[] = "libmsquic.lttng.so." LIBRARY_VERSION;
 
 uint32_t CxPlatProcessorCount;
+uint32_t CxPlatProcessorAvailableCount;
+uint16_t* CxPlatProcessorAvailableList;
 
 uint64_t CxPlatTotalMemory;
+uint64_t CxPlatCryptInitTimeUs;
 
 #if __APPLE__ || __FreeBSD__
 uintptr_t CxPlatCurrentSqe = 0x80000000;
 #endif
 
+#ifdef CXPLAT_USE_TSC_CLOCK
+//
+// Reading CLOCK_MONOTONIC goes through the vDSO, but still costs several times
+// more than reading the TSC, and the time is read many times per packet. When
+// the TSC is invariant and the kernel itself uses it as its clocksource, the
+// time is instead computed from the TSC, at a rate measured against
+// CLOCK_MONOTONIC. Until CXPLAT_TSC_CALIBRATION_US have passed, to get an
+// accurate rate, CLOCK_MONOTONIC is used directly. Afterwards, the clock is
+// re-anchored to CLOCK_MONOTONIC every CXPLAT_TSC_RESYNC_US, so it never
+// drifts from it by more than a few microseconds. It never goes backwards: if
+// it ran ahead, it holds its value and runs slightly slower until caught up.
+//
+#define CXPLAT_TSC_CALIBRATION_US   20000
+#define CXPLAT_TSC_RESYNC_US        250000
+
+typedef struct CXPLAT_TSC_CLOCK {
+    uint32_t Sequence;      // Odd while being updated.
+    BOOLEAN Supported;
+    BOOLEAN Calibrated;
+    uint64_t StartTsc;      // The first anchor, to measure the rate over
+    uint64_t StartUs;       // the longest possible interval.
+    uint64_t BaseTsc;       // The current anchor.
+    uint64_t BaseUs;
+    uint64_t UsPerTsc;      // 32.32 fixed point.
+    uint64_t ResyncTicks;
+} CXPLAT_TSC_CLOCK;
+
+static CXPLAT_TSC_CLOCK CxPlatTscClock;
+static void CxPlatTscClockInitialize(void);
+#endif // CXPLAT_USE_TSC_CLOCK
+
 #ifdef __clang__
 __attribute__((noinline, noreturn, optnone))
 #else
@@ -98,6 +144,11 @@ CxPlatSystemLoad(
     void
     )
 {
+    //
+    // A forked child must not continue the parent's random streams.
+    //
+    pthread_atfork(NULL, NULL, CxPlatRandomOnFork);
+
 #if defined(CX_PLATFORM_DARWIN)
     //
     // arm64 macOS has no way to get the current proc, so treat as single core.
@@ -108,6 +159,10 @@ CxPlatSystemLoad(
     CxPlatProcessorCount = (uint32_t)sysconf(_SC_NPROCESSORS_ONLN);
 #endif
 
+#ifdef CXPLAT_USE_TSC_CLOCK
+    CxPlatTscClockInitialize();
+#endif
+
 #ifdef CXPLAT_NUMA_AWARE
     if (numa_available() >= 0) {
         CxPlatNumaNodeCount = (uint32_t)numa_num_configured_nodes();
@@ -219,6 +274,58 @@ CxPlatSystemUnload(
 }
 
 uint64_t CGroupGetMemoryLimit();
+uint32_t CGroupGetCpuLimit();
+
+//
+// Builds the list of processors this process should spread its work over: the
+// ones in its affinity mask (which is how a cgroup cpuset shows up), trimmed
+// to the cgroup CPU quota. Both can change while the process runs, so this is
+// redone on every initialization rather than at load.
+//
+static
+QUIC_STATUS
+CxPlatProcessorsAvailableInitialize(
+    void
+    )
+{
+    const size_t ListSize = sizeof(uint16_t) * CxPlatProcessorCount;
+    uint16_t* List = CXPLAT_ALLOC_NONPAGED(ListSize, QUIC_POOL_PLATFORM_PROC);
+    if (List == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "available processor list",
+            ListSize);
+        return QUIC_STATUS_OUT_OF_MEMORY;
+    }
+
+    uint32_t Count = 0;
+#if defined(CX_PLATFORM_LINUX)
+    cpu_set_t Mask;
+    CPU_ZERO(&Mask);
+    if (sched_getaffinity(0, sizeof(Mask), &Mask) == 0) {
+        for (uint32_t i = 0; i < CxPlatProcessorCount && i < CPU_SETSIZE; ++i) {
+            if (CPU_ISSET(i, &Mask)) {
+                List[Count++] = (uint16_t)i;
+            }
+        }
+    }
+#endif
+    if (Count == 0) {
+        for (; Count < CxPlatProcessorCount; ++Count) {
+            List[Count] = (uint16_t)Count;
+        }
+    }
+
+    const uint32_t CpuLimit = CGroupGetCpuLimit();
+    if (CpuLimit != 0 && CpuLimit < Count) {
+        Count = CpuLimit;
+    }
+
+    CxPlatProcessorAvailableList = List;
+    CxPlatProcessorAvailableCount = Count;
+    return QUIC_STATUS_SUCCESS;
+}
 
 QUIC_STATUS
 CxPlatInitialize(
@@ -236,8 +343,11 @@ CxPlatInitialize(
             "open(/dev/urandom, O_RDONLY|O_CLOEXEC) failed");
         return (QUIC_STATUS)errno;
     }
+    InterlockedIncrement(&CxPlatRandomGeneration); // Reseed every thread.
 
+    const uint64_t CryptInitStart = CxPlatTimeUs64();
     Status = CxPlatCryptInitialize();
+    CxPlatCryptInitTimeUs = CxPlatTimeDiff64(CryptInitStart, CxPlatTimeUs64());
     if (QUIC_FAILED(Status)) {
         if (RandomFd != -1) {
             close(RandomFd);
@@ -247,6 +357,13 @@ CxPlatInitialize(
 
     CxPlatTotalMemory = CGroupGetMemoryLimit();
 
+    Status = CxPlatProcessorsAvailableInitialize();
+    if (QUIC_FAILED(Status)) {
+        CxPlatCryptUninitialize();
+        close(RandomFd);
+        return Status;
+    }
+
     QuicTraceLogInfo(
         PosixInitialized,
         "[ dso] Initialized (AvailMem = %llu bytes)",
@@ -260,6 +377,9 @@ CxPlatUninitialize(
     void
     )
 {
+    CXPLAT_FREE(CxPlatProcessorAvailableList, QUIC_POOL_PLATFORM_PROC);
+    CxPlatProcessorAvailableList = NULL;
+    CxPlatProcessorAvailableCount = 0;
     CxPlatCryptUninitialize();
     close(RandomFd);
     QuicTraceLogInfo(
@@ -453,8 +573,10 @@ CxPlatGetTimerResolution(
     return CxPlatTimespecToUs(&Res);
 }
 
+#ifndef QUIC_SIMULATION
+static
 uint64_t
-CxPlatTimeUs64(
+CxPlatMonotonicTimeUs(
     void
     )
 {
@@ -464,6 +586,193 @@ CxPlatTimeUs64(
     UNREFERENCED_PARAMETER(ErrorCode);
     return CxPlatTimespecToUs(&CurrTime);
 }
+#endif
+
+#ifdef CXPLAT_USE_TSC_CLOCK
+
+static
+void
+CxPlatTscClockInitialize(
+    void
+    )
+{
+    //
+    // CPUID.80000007H:EDX[8] is the invariant TSC bit.
+    //
+    unsigned int Eax, Ebx, Ecx, Edx;
+    if (!__get_cpuid(0x80000007, &Eax, &Ebx, &Ecx, &Edx) || !(Edx & (1u << 8))) {
+        return;
+    }
+
+    //
+    // The kernel falls back to another clocksource if it finds the TSC isn't
+    // synchronized across processors (or a hypervisor makes it unstable).
+    //
+    char Clocksource[8] = {0};
+    int Fd = open("/sys/devices/system/clocksource/clocksource0/current_clocksource", O_RDONLY|O_CLOEXEC);
+    if (Fd == -1) {
+        return;
+    }
+    ssize_t Length = read(Fd, Clocksource, sizeof(Clocksource) - 1);
+    close(Fd);
+    if (Length < 3 || strncmp(Clocksource, "tsc", 3) != 0 ||
+        (Length > 3 && Clocksource[3] != '\n')) {
+        return;
+    }
+
+    CxPlatTscClock.StartUs = CxPlatMonotonicTimeUs();
+    CxPlatTscClock.StartTsc = __builtin_ia32_rdtsc();
+    CxPlatTscClock.Supported = TRUE;
+}
+
+static
+inline
+uint64_t
+CxPlatTscToUs(
+    _In_ uint64_t Ticks,
+    _In_ uint64_t UsPerTsc
+    )
+{
+    return (uint64_t)(((unsigned __int128)Ticks * UsPerTsc) >> 32);
+}
+
+//
+// Calibrates or re-anchors the clock, and returns the current time.
+//
+static
+uint64_t
+CxPlatTscClockResync(
+    void
+    )
+{
+    CXPLAT_TSC_CLOCK* Clock = &CxPlatTscClock;
+
+    uint32_t Sequence;
+    for (;;) {
+        Sequence = __atomic_load_n(&Clock->Sequence, __ATOMIC_RELAXED);
+        if (!(Sequence & 1) &&
+            __atomic_compare_exchange_n(
+                &Clock->Sequence, &Sequence, Sequence + 1, FALSE,
+                __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            break;
+        }
+        __builtin_ia32_pause(); // Another thread is already at it.
+    }
+
+    const uint64_t NowUs = CxPlatMonotonicTimeUs();
+    const uint64_t Tsc = __builtin_ia32_rdtsc();
+    uint64_t TimeUs = NowUs;
+
+    if (Clock->Calibrated && Tsc - Clock->BaseTsc < Clock->ResyncTicks) {
+        //
+        // Another thread resynced while this one waited.
+        //
+        TimeUs = Clock->BaseUs + CxPlatTscToUs(Tsc - Clock->BaseTsc, Clock->UsPerTsc);
+
+    } else if (Tsc <= Clock->StartTsc || NowUs <= Clock->StartUs) {
+        __atomic_store_n(&Clock->Supported, FALSE, __ATOMIC_RELAXED); // Shouldn't happen with an invariant TSC.
+
+    } else if (Clock->Calibrated || NowUs - Clock->StartUs >= CXPLAT_TSC_CALIBRATION_US) {
+        const uint64_t Rate =
+            (uint64_t)(((unsigned __int128)(NowUs - Clock->StartUs) << 32) /
+                (Tsc - Clock->StartTsc));
+        uint64_t UsPerTsc = Rate;
+        if (Clock->Calibrated) {
+            const uint64_t PredictedUs =
+                Clock->BaseUs + CxPlatTscToUs(Tsc - Clock->BaseTsc, Clock->UsPerTsc);
+            if (PredictedUs > NowUs) {
+                //
+                // Ahead of CLOCK_MONOTONIC. Hold and slow down a little, to be
+                // back on it by the next resync.
+                //
+                const uint64_t AheadUs = CXPLAT_MIN(PredictedUs - NowUs, CXPLAT_TSC_RESYNC_US / 2);
+                UsPerTsc = Rate - (Rate * AheadUs) / CXPLAT_TSC_RESYNC_US;
+                TimeUs = PredictedUs;
+            }
+        }
+        if (Rate != 0) {
+            Clock->BaseTsc = Tsc;
+            Clock->BaseUs = TimeUs;
+            Clock->UsPerTsc = UsPerTsc;
+            Clock->ResyncTicks = ((uint64_t)CXPLAT_TSC_RESYNC_US << 32) / Rate;
+            Clock->Calibrated = TRUE;
+        }
+    }
+
+    __atomic_store_n(&Clock->Sequence, Sequence + 2, __ATOMIC_RELEASE);
+    return TimeUs;
+}
+
+#endif // CXPLAT_USE_TSC_CLOCK
+
+#ifdef QUIC_SIMULATION
+
+uint64_t
+CxPlatSimulationSetTime(
+    _In_ uint64_t TimeUs
+    )
+{
+    uint64_t Current = __atomic_load_n(&CxPlatSimulationTimeUs, __ATOMIC_RELAXED);
+    while (TimeUs > Current) {
+        if (__atomic_compare_exchange_n(
+                &CxPlatSimulationTimeUs, &Current, TimeUs,
+                FALSE, __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+            return TimeUs;
+        }
+    }
+    return Current;
+}
+
+void
+CxPlatSimulationSetSeed(
+    _In_ uint64_t Seed
+    )
+{
+    __atomic_store_n(&CxPlatSimulationSeed, Seed, __ATOMIC_RELAXED);
+    __atomic_store_n(&CxPlatSimulationStreams, 0, __ATOMIC_RELAXED);
+    InterlockedIncrement(&CxPlatRandomGeneration); // Reseed every thread.
+}
+
+#endif // QUIC_SIMULATION
+
+uint64_t
+CxPlatTimeUs64(
+    void
+    )
+{
+#ifdef QUIC_SIMULATION
+    return __atomic_load_n(&CxPlatSimulationTimeUs, __ATOMIC_ACQUIRE);
+#else
+#ifdef CXPLAT_USE_TSC_CLOCK
+    const CXPLAT_TSC_CLOCK* Clock = &CxPlatTscClock;
+    if (__atomic_load_n(&Clock->Supported, __ATOMIC_RELAXED)) {
+        const uint32_t Sequence = __atomic_load_n(&Clock->Sequence, __ATOMIC_ACQUIRE);
+        const BOOLEAN Calibrated = __atomic_load_n(&Clock->Calibrated, __ATOMIC_RELAXED);
+        const uint64_t BaseTsc = __atomic_load_n(&Clock->BaseTsc, __ATOMIC_RELAXED);
+        const uint64_t BaseUs = __atomic_load_n(&Clock->BaseUs, __ATOMIC_RELAXED);
+        const uint64_t UsPerTsc = __atomic_load_n(&Clock->UsPerTsc, __ATOMIC_RELAXED);
+        const uint64_t ResyncTicks = __atomic_load_n(&Clock->ResyncTicks, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (!(Sequence & 1) &&
+            Sequence == __atomic_load_n(&Clock->Sequence, __ATOMIC_RELAXED)) {
+            if (Calibrated) {
+                const uint64_t Ticks = __builtin_ia32_rdtsc() - BaseTsc;
+                if (Ticks < ResyncTicks) {
+                    return BaseUs + CxPlatTscToUs(Ticks, UsPerTsc);
+                }
+                return CxPlatTscClockResync();
+            }
+            const uint64_t NowUs = CxPlatMonotonicTimeUs();
+            if (NowUs - Clock->StartUs < CXPLAT_TSC_CALIBRATION_US) {
+                return NowUs;
+            }
+        }
+        return CxPlatTscClockResync();
+    }
+#endif
+    return CxPlatMonotonicTimeUs();
+#endif
+}
 
 void
 CxPlatGetAbsoluteTime(
@@ -534,14 +843,193 @@ CxPlatProcCurrentNumber(
 #endif // CX_PLATFORM_DARWIN
 }
 
+uint16_t
+CxPlatProcNumaNode(
+    _In_ uint32_t Index
+    )
+{
+#ifdef CXPLAT_NUMA_AWARE
+    if (CxPlatNumaNodeCount != 0) {
+        const int Node = numa_node_of_cpu((int)Index);
+        if (Node >= 0) {
+            return (uint16_t)Node;
+        }
+    }
+#else
+    UNREFERENCED_PARAMETER(Index);
+#endif // CXPLAT_NUMA_AWARE
+    return 0;
+}
+
+#define CHACHA20_ROTL(v, n) (((v) << (n)) | ((v) >> (32 - (n))))
+#define CHACHA20_QR(a, b, c, d) \
+    a += b; d ^= a; d = CHACHA20_ROTL(d, 16); \
+    c += d; b ^= c; b = CHACHA20_ROTL(b, 12); \
+    a += b; d ^= a; d = CHACHA20_ROTL(d, 8); \
+    c += d; b ^= c; b = CHACHA20_ROTL(b, 7)
+
+//
+// Writes the ChaCha20 (RFC 8439) keystream block for Counter, with a zero
+// nonce.
+//
+static
+void
+CxPlatChaCha20Block(
+    _In_reads_(8) const uint32_t* Key,
+    _In_ uint32_t Counter,
+    _Out_writes_bytes_(64) uint8_t* Output
+    )
+{
+    const uint32_t Input[16] = {
+        0x61707865, 0x3320646e, 0x79622d32, 0x6b206574,
+        Key[0], Key[1], Key[2], Key[3], Key[4], Key[5], Key[6], Key[7],
+        Counter, 0, 0, 0
+    };
+    uint32_t X[16];
+    CxPlatCopyMemory(X, Input, sizeof(X));
+    for (uint32_t i = 0; i < 10; ++i) {
+        CHACHA20_QR(X[0], X[4], X[8], X[12]);
+        CHACHA20_QR(X[1], X[5], X[9], X[13]);
+        CHACHA20_QR(X[2], X[6], X[10], X[14]);
+        CHACHA20_QR(X[3], X[7], X[11], X[15]);
+        CHACHA20_QR(X[0], X[5], X[10], X[15]);
+        CHACHA20_QR(X[1], X[6], X[11], X[12]);
+        CHACHA20_QR(X[2], X[7], X[8], X[13]);
+        CHACHA20_QR(X[3], X[4], X[9], X[14]);
+    }
+    for (uint32_t i = 0; i < 16; ++i) {
+        const uint32_t Word = X[i] + Input[i];
+        Output[i * 4] = (uint8_t)Word;
+        Output[i * 4 + 1] = (uint8_t)(Word >> 8);
+        Output[i * 4 + 2] = (uint8_t)(Word >> 16);
+        Output[i * 4 + 3] = (uint8_t)(Word >> 24);
+    }
+}
+
+//
+// CxPlatRandom is called for every new CID, stateless reset token and retry
+// token, so rather than reading /dev/urandom on each call, each thread runs
+// its own ChaCha20 DRBG seeded from it. Each refill's first 32 bytes become
+// the next key and output is wiped from the buffer as it is handed out ("fast
+// key erasure"), so the thread's state never reveals earlier output. A thread
+// reseeds after CXPLAT_RANDOM_RESEED_BYTES of output, and when
+// CxPlatRandomGeneration changes: after a fork, so parent and child don't
+// share a stream, and when the platform is re-initialized.
+//
+#define CXPLAT_RANDOM_BLOCKS        8
+#define CXPLAT_RANDOM_RESEED_BYTES  (1024 * 1024)
+
+typedef struct CXPLAT_RANDOM_STATE {
+    uint32_t Key[8];
+    long Generation;            // CxPlatRandomGeneration when last seeded
+    uint32_t Available;         // Unused bytes at the end of Buffer
+    uint64_t BytesSinceReseed;
+    uint8_t Buffer[CXPLAT_RANDOM_BLOCKS * 64];
+} CXPLAT_RANDOM_STATE;
+
+static __thread CXPLAT_RANDOM_STATE CxPlatRandomState; // Generation zero until seeded
+
+static
+void
+CxPlatRandomOnFork(
+    void
+    )
+{
+    InterlockedIncrement(&CxPlatRandomGeneration);
+}
+
+static
+QUIC_STATUS
+CxPlatRandomReseed(
+    _Inout_ CXPLAT_RANDOM_STATE* State,
+    _In_ long Generation
+    )
+{
+    uint32_t Seed[8];
+#ifdef QUIC_SIMULATION
+    //
+    // The key is replaced with one derived only from the simulation seed and
+    // the order threads are seeded in (SplitMix64), so every single threaded
+    // run with the same seed sees the same output.
+    //
+    uint64_t Mix =
+        __atomic_load_n(&CxPlatSimulationSeed, __ATOMIC_RELAXED) ^
+        (__atomic_fetch_add(&CxPlatSimulationStreams, 1, __ATOMIC_RELAXED) << 32);
+    for (uint32_t i = 0; i < ARRAYSIZE(Seed); ++i) {
+        Mix += 0x9E3779B97F4A7C15ull;
+        uint64_t Z = Mix;
+        Z = (Z ^ (Z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        Z = (Z ^ (Z >> 27)) * 0x94D049BB133111EBull;
+        Seed[i] = (uint32_t)(Z ^ (Z >> 31));
+        State->Key[i] = 0;
+    }
+#else
+    if (read(RandomFd, Seed, sizeof(Seed)) != (ssize_t)sizeof(Seed)) {
+        return errno != 0 ? (QUIC_STATUS)errno : QUIC_STATUS_INTERNAL_ERROR;
+    }
+#endif
+    //
+    // Mixed in rather than replaced, so the key never has less entropy than
+    // it had before.
+    //
+    for (uint32_t i = 0; i < ARRAYSIZE(Seed); ++i) {
+        State->Key[i] ^= Seed[i];
+    }
+    CxPlatSecureZeroMemory(Seed, sizeof(Seed));
+    CxPlatSecureZeroMemory(State->Buffer, sizeof(State->Buffer));
+    State->Available = 0;
+    State->BytesSinceReseed = 0;
+    State->Generation = Generation;
+    return QUIC_STATUS_SUCCESS;
+}
+
+static
+void
+CxPlatRandomRefill(
+    _Inout_ CXPLAT_RANDOM_STATE* State
+    )
+{
+    for (uint32_t i = 0; i < CXPLAT_RANDOM_BLOCKS; ++i) {
+        CxPlatChaCha20Block(State->Key, i, State->Buffer + i * 64);
+    }
+    CxPlatCopyMemory(State->Key, State->Buffer, sizeof(State->Key));
+    CxPlatSecureZeroMemory(State->Buffer, sizeof(State->Key));
+    State->Available = sizeof(State->Buffer) - sizeof(State->Key);
+}
+
 QUIC_STATUS
 CxPlatRandom(
     _In_ uint32_t BufferLen,
     _Out_writes_bytes_(BufferLen) void* Buffer
     )
 {
-    if (read(RandomFd, Buffer, BufferLen) == -1) {
-        return (QUIC_STATUS)errno;
+    CXPLAT_RANDOM_STATE* State = &CxPlatRandomState;
+    const long Generation = CxPlatRandomGeneration;
+#ifdef QUIC_SIMULATION
+    if (State->Generation != Generation) { // Reseeding by volume would repeat output.
+#else
+    if (State->Generation != Generation ||
+        State->BytesSinceReseed >= CXPLAT_RANDOM_RESEED_BYTES) {
+#endif
+        QUIC_STATUS Status = CxPlatRandomReseed(State, Generation);
+        if (QUIC_FAILED(Status)) {
+            return Status;
+        }
+    }
+
+    uint8_t* Output = (uint8_t*)Buffer;
+    State->BytesSinceReseed += BufferLen;
+    while (BufferLen != 0) {
+        if (State->Available == 0) {
+            CxPlatRandomRefill(State);
+        }
+        uint8_t* Source = State->Buffer + sizeof(State->Buffer) - State->Available;
+        const uint32_t Length = CXPLAT_MIN(BufferLen, State->Available);
+        CxPlatCopyMemory(Output, Source, Length);
+        CxPlatSecureZeroMemory(Source, Length);
+        State->Available -= Length;
+        Output += Length;
+        BufferLen -= Length;
     }
     return QUIC_STATUS_SUCCESS;
 }
@@ -58,6 +58,7 @@ typedef struct _SYSTEM_BASIC_INFORMATION {
 
 uint64_t CxPlatPerfFreq;
 uint64_t CxPlatTotalMemory;
+uint64_t CxPlatCryptInitTimeUs;
 uint32_t CxPlatProcessorCount;
 CX_PLATFORM CxPlatform = { NULL };
 QUIC_TRACE_RUNDOWN_CALLBACK* QuicTraceRundownCallback;
@@ -148,7 +149,9 @@ CxPlatInitialize(
         goto Error;
     }
 
+    const uint64_t CryptInitStart = CxPlatTimeUs64();
     Status = CxPlatCryptInitialize();
+    CxPlatCryptInitTimeUs = CxPlatTimeDiff64(CryptInitStart, CxPlatTimeUs64());
     if (QUIC_FAILED(Status)) {
         QuicTraceEvent(
             LibraryErrorStatus,
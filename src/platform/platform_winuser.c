@@ -21,6 +21,7 @@ Environment:
 
 uint64_t CxPlatPerfFreq;
 uint64_t CxPlatTotalMemory;
+uint64_t CxPlatCryptInitTimeUs;
 CX_PLATFORM CxPlatform = { NULL };
 CXPLAT_PROCESSOR_INFO* CxPlatProcessorInfo;
 CXPLAT_PROCESSOR_GROUP_INFO* CxPlatProcessorGroupInfo;
@@ -289,7 +290,9 @@ CxPlatInitialize(
 #endif // QUIC_HIGH_RES_TIMERS
 #endif // TIMERR_NOERROR
 
+    const uint64_t CryptInitStart = CxPlatTimeUs64();
     Status = CxPlatCryptInitialize();
+    CxPlatCryptInitTimeUs = CxPlatTimeDiff64(CryptInitStart, CxPlatTimeUs64());
     if (QUIC_FAILED(Status)) {
         goto Error;
     }
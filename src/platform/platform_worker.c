@@ -75,9 +75,16 @@ typedef struct QUIC_CACHEALIGN CXPLAT_WORKER {
 #endif
 
     //
-    // The ideal processor for the worker thread.
+    // The execution state carried between calls to CxPlatWorkerPoolPoll, when
+    // the worker pool is driven by the app.
+    //
+    CXPLAT_EXECUTION_STATE ExternalState;
+
+    //
+    // The ideal processor and flags for the worker thread.
     //
     uint16_t IdealProcessor;
+    uint16_t ThreadFlags;
 
     //
     // Flags to indicate what has been initialized.
@@ -102,10 +109,56 @@ typedef struct QUIC_CACHEALIGN CXPLAT_WORKER {
     //
     BOOLEAN Running;
 
+    //
+    // Set once the thread is created (or, when the app drives the worker, from
+    // the start). Must not be bitfield.
+    //
+    BOOLEAN Started;
+
 } CXPLAT_WORKER;
 
 CXPLAT_THREAD_CALLBACK(CxPlatWorkerThread, Context);
 
+//
+// Creates the worker's thread, if it doesn't have one yet. Unless the pool is
+// created with QUIC_EXECUTION_CONFIG_FLAG_PREWARM, this only happens the first
+// time an execution context or socket is assigned to the worker, so processes
+// that only use a few partitions don't pay for a thread on every processor.
+//
+static
+BOOLEAN
+CxPlatWorkerStart(
+    _In_ CXPLAT_WORKER* Worker
+    )
+{
+    if (Worker->Started) {
+        return TRUE;
+    }
+
+    CxPlatLockAcquire(&Worker->ECLock);
+    if (!Worker->Started) {
+        CXPLAT_THREAD_CONFIG ThreadConfig = {
+            Worker->ThreadFlags,
+            Worker->IdealProcessor,
+            "cxplat_worker",
+            CxPlatWorkerThread,
+            Worker
+        };
+        if (QUIC_SUCCEEDED(CxPlatThreadCreate(&ThreadConfig, &Worker->Thread))) {
+            Worker->InitializedThread = TRUE;
+            Worker->Started = TRUE;
+        } else {
+            QuicTraceEvent(
+                LibraryError,
+                "[ lib] ERROR, %s.",
+                "CxPlatThreadCreate(worker)");
+        }
+    }
+    CxPlatLockRelease(&Worker->ECLock);
+
+    return Worker->Started;
+}
+
 void
 CxPlatWorkerPoolInit(
     _In_ CXPLAT_WORKER_POOL* WorkerPool
@@ -132,6 +185,8 @@ CxPlatWorkerPoolLazyStart(
         return TRUE;
     }
 
+    const uint64_t StartTime = CxPlatTimeUs64();
+
     const uint16_t* ProcessorList;
     if (Config && Config->ProcessorCount) {
         WorkerPool->WorkerCount = Config->ProcessorCount;
@@ -154,6 +209,9 @@ CxPlatWorkerPoolLazyStart(
         goto Error;
     }
 
+    WorkerPool->External = Config && (Config->Flags & QUIC_EXECUTION_CONFIG_FLAG_EXTERNAL);
+
+    const BOOLEAN Prewarm = Config && (Config->Flags & QUIC_EXECUTION_CONFIG_FLAG_PREWARM);
     uint16_t ThreadFlags = CXPLAT_THREAD_FLAG_SET_IDEAL_PROC;
     if (Config) {
         if (Config->Flags & QUIC_EXECUTION_CONFIG_FLAG_NO_IDEAL_PROC) {
@@ -164,14 +222,6 @@ CxPlatWorkerPoolLazyStart(
         }
     }
 
-    CXPLAT_THREAD_CONFIG ThreadConfig = {
-        ThreadFlags,
-        0,
-        "cxplat_worker",
-        CxPlatWorkerThread,
-        NULL
-    };
-
     CxPlatZeroMemory(WorkerPool->Workers, WorkersSize);
     for (uint32_t i = 0; i < WorkerPool->WorkerCount; ++i) {
         CxPlatLockInitialize(&WorkerPool->Workers[i].ECLock);
@@ -179,8 +229,7 @@ CxPlatWorkerPoolLazyStart(
         WorkerPool->Workers[i].InitializedECLock = TRUE;
         WorkerPool->Workers[i].IdealProcessor = ProcessorList ? ProcessorList[i] : (uint16_t)i;
         CXPLAT_DBG_ASSERT(WorkerPool->Workers[i].IdealProcessor < CxPlatProcCount());
-        ThreadConfig.IdealProcessor = WorkerPool->Workers[i].IdealProcessor;
-        ThreadConfig.Context = &WorkerPool->Workers[i];
+        WorkerPool->Workers[i].ThreadFlags = ThreadFlags;
         if (!CxPlatEventQInitialize(&WorkerPool->Workers[i].EventQ)) {
             QuicTraceEvent(
                 LibraryError,
@@ -189,6 +238,22 @@ CxPlatWorkerPoolLazyStart(
             goto Error;
         }
         WorkerPool->Workers[i].InitializedEventQ = TRUE;
+#ifdef CXPLAT_EVENTQ_BUSY_POLL
+        if (Config && (Config->Flags & QUIC_EXECUTION_CONFIG_FLAG_BUSY_POLL) &&
+            !CxPlatEventQSetBusyPoll(
+                &WorkerPool->Workers[i].EventQ,
+                Config->PollingIdleTimeoutUs != 0 ?
+                    Config->PollingIdleTimeoutUs : CXPLAT_BUSY_POLL_DEFAULT_US,
+                CXPLAT_BUSY_POLL_BUDGET)) {
+            //
+            // Not fatal. The worker just waits for interrupts as usual.
+            //
+            QuicTraceEvent(
+                LibraryError,
+                "[ lib] ERROR, %s.",
+                "CxPlatEventQSetBusyPoll");
+        }
+#endif
 #ifdef CXPLAT_SQE_INIT
         WorkerPool->Workers[i].ShutdownSqe = (CXPLAT_SQE)WorkerPool->Workers[i].EventQ;
         if (!CxPlatSqeInitialize(&WorkerPool->Workers[i].EventQ, &WorkerPool->Workers[i].ShutdownSqe, NULL)) {
@@ -218,14 +283,22 @@ CxPlatWorkerPoolLazyStart(
         }
         WorkerPool->Workers[i].InitializedUpdatePollSqe = TRUE;
 #endif
-        if (QUIC_FAILED(
-            CxPlatThreadCreate(&ThreadConfig, &WorkerPool->Workers[i].Thread))) {
+        if (WorkerPool->External) {
+            //
+            // The app drives the worker from its own thread instead.
+            //
+            WorkerPool->Workers[i].ExternalState.WaitTime = UINT32_MAX;
+            WorkerPool->Workers[i].Running = TRUE;
+            WorkerPool->Workers[i].Started = TRUE;
+            continue;
+        }
+        if (Prewarm && !CxPlatWorkerStart(&WorkerPool->Workers[i])) {
             goto Error;
         }
-        WorkerPool->Workers[i].InitializedThread = TRUE;
     }
 
     CxPlatRundownInitialize(&WorkerPool->Rundown);
+    WorkerPool->StartTimeUs = CxPlatTimeDiff64(StartTime, CxPlatTimeUs64());
 
     CxPlatLockRelease(&WorkerPool->WorkerLock);
 
@@ -288,17 +361,19 @@ CxPlatWorkerPoolUninit(
 
         for (uint32_t i = 0; i < WorkerPool->WorkerCount; ++i) {
             WorkerPool->Workers[i].StoppingThread = TRUE;
-            CxPlatEventQEnqueue(
-                &WorkerPool->Workers[i].EventQ,
-                &WorkerPool->Workers[i].ShutdownSqe,
-                NULL);
-            CxPlatThreadWait(&WorkerPool->Workers[i].Thread);
-            CxPlatThreadDelete(&WorkerPool->Workers[i].Thread);
+            if (WorkerPool->Workers[i].InitializedThread) {
+                CxPlatEventQEnqueue(
+                    &WorkerPool->Workers[i].EventQ,
+                    &WorkerPool->Workers[i].ShutdownSqe,
+                    NULL);
+                CxPlatThreadWait(&WorkerPool->Workers[i].Thread);
+                CxPlatThreadDelete(&WorkerPool->Workers[i].Thread);
 #if DEBUG
-            CXPLAT_DBG_ASSERT(WorkerPool->Workers[i].ThreadStarted);
-            CXPLAT_DBG_ASSERT(WorkerPool->Workers[i].ThreadFinished);
+                CXPLAT_DBG_ASSERT(WorkerPool->Workers[i].ThreadStarted);
+                CXPLAT_DBG_ASSERT(WorkerPool->Workers[i].ThreadFinished);
 #endif
-            WorkerPool->Workers[i].DestroyedThread = TRUE;
+                WorkerPool->Workers[i].DestroyedThread = TRUE;
+            }
 #ifdef CXPLAT_SQE_INIT
             CxPlatSqeCleanup(&WorkerPool->Workers[i].EventQ, &WorkerPool->Workers[i].UpdatePollSqe);
             CxPlatSqeCleanup(&WorkerPool->Workers[i].EventQ, &WorkerPool->Workers[i].WakeSqe);
@@ -391,7 +466,18 @@ CxPlatWorkerPoolGetEventQ(
     return &WorkerPool->Workers[Index].EventQ;
 }
 
-void
+BOOLEAN
+CxPlatWorkerPoolStartWorker(
+    _In_ CXPLAT_WORKER_POOL* WorkerPool,
+    _In_ uint16_t Index
+    )
+{
+    CXPLAT_DBG_ASSERT(WorkerPool);
+    CXPLAT_FRE_ASSERT(Index < WorkerPool->WorkerCount);
+    return CxPlatWorkerStart(&WorkerPool->Workers[Index]);
+}
+
+BOOLEAN
 CxPlatAddExecutionContext(
     _In_ CXPLAT_WORKER_POOL* WorkerPool,
     _Inout_ CXPLAT_EXECUTION_CONTEXT* Context,
@@ -401,6 +487,9 @@ CxPlatAddExecutionContext(
     CXPLAT_DBG_ASSERT(WorkerPool);
     CXPLAT_FRE_ASSERT(Index < WorkerPool->WorkerCount);
     CXPLAT_WORKER* Worker = &WorkerPool->Workers[Index];
+    if (!CxPlatWorkerStart(Worker)) {
+        return FALSE;
+    }
 
     Context->CxPlatContext = Worker;
     CxPlatLockAcquire(&Worker->ECLock);
@@ -415,14 +504,30 @@ CxPlatAddExecutionContext(
             &Worker->UpdatePollSqe,
             (void*)&WorkerUpdatePollEventPayload);
     }
+
+    return TRUE;
 }
 
+//
+// Running is only cleared by the worker right before it may block on its event
+// queue, and it always runs its execution contexts once more after clearing
+// it. So while it's set, the worker is guaranteed to see the context's Ready
+// flag without being signaled: waking a busy or polling worker costs a
+// barrier and a read of a (shared, mostly unmodified) cache line, not an
+// interlocked operation or a syscall. The barrier orders the caller's write
+// of Ready before the read of Running, pairing with the interlocked clear of
+// Running on the worker.
+//
 void
 CxPlatWakeExecutionContext(
     _In_ CXPLAT_EXECUTION_CONTEXT* Context
     )
 {
     CXPLAT_WORKER* Worker = (CXPLAT_WORKER*)Context->CxPlatContext;
+    CxPlatMemoryBarrier();
+    if (*(volatile BOOLEAN*)&Worker->Running) {
+        return;
+    }
     if (!InterlockedFetchAndSetBoolean(&Worker->Running)) {
         CxPlatEventQEnqueue(&Worker->EventQ, &Worker->WakeSqe, (void*)&WorkerWakeEventPayload);
     }
@@ -469,7 +574,13 @@ CxPlatRunExecutionContexts(
     do {
         CXPLAT_EXECUTION_CONTEXT* Context =
             CXPLAT_CONTAINING_RECORD(*EC, CXPLAT_EXECUTION_CONTEXT, Entry);
-        BOOLEAN Ready = InterlockedFetchAndClearBoolean(&Context->Ready);
+        //
+        // Only write the flag when it's set, to leave its cache line shared
+        // with the threads that set it.
+        //
+        BOOLEAN Ready =
+            *(volatile BOOLEAN*)&Context->Ready &&
+            InterlockedFetchAndClearBoolean(&Context->Ready);
         if (Ready || Context->NextTimeUs <= State->TimeNow) {
 #if DEBUG // Debug statistics
             ++Worker->EcRunCount;
@@ -514,7 +625,9 @@ CxPlatProcessEvents(
 {
     CXPLAT_CQE Cqes[16];
     uint32_t CqeCount = CxPlatEventQDequeue(&Worker->EventQ, Cqes, ARRAYSIZE(Cqes), State->WaitTime);
-    InterlockedFetchAndSetBoolean(&Worker->Running);
+    if (!*(volatile BOOLEAN*)&Worker->Running) {
+        InterlockedFetchAndSetBoolean(&Worker->Running);
+    }
     if (CqeCount != 0) {
 #if DEBUG // Debug statistics
         Worker->CqeCount += CqeCount;
@@ -577,6 +690,13 @@ CXPLAT_THREAD_CALLBACK(CxPlatWorkerThread, Context)
         if (State.WaitTime && InterlockedFetchAndClearBoolean(&Worker->Running)) {
             State.TimeNow = CxPlatTimeUs64();
             CxPlatRunExecutionContexts(Worker, &State); // Run once more to handle race conditions
+            if (State.WaitTime == 0) {
+                //
+                // More work showed up, so the worker isn't going to block.
+                // Don't make wakers signal the event queue meanwhile.
+                //
+                InterlockedFetchAndSetBoolean(&Worker->Running);
+            }
         }
 
         if (CxPlatProcessEvents(Worker, &State)) {
@@ -611,3 +731,83 @@ Shutdown:
 
     CXPLAT_THREAD_RETURN(0);
 }
+
+QUIC_STATUS
+CxPlatWorkerPoolGetEventQHandle(
+    _In_ CXPLAT_WORKER_POOL* WorkerPool,
+    _In_ uint16_t Index,
+    _Out_ QUIC_EVENTQ* EventQ
+    )
+{
+    CXPLAT_DBG_ASSERT(WorkerPool);
+    if (WorkerPool->Workers == NULL || !WorkerPool->External) {
+        return QUIC_STATUS_INVALID_STATE;
+    }
+    if (Index >= WorkerPool->WorkerCount) {
+        return QUIC_STATUS_INVALID_PARAMETER;
+    }
+#if CXPLAT_USE_IO_URING
+    *EventQ = WorkerPool->Workers[Index].EventQ.ring_fd;
+#else
+    *EventQ = WorkerPool->Workers[Index].EventQ;
+#endif
+    return QUIC_STATUS_SUCCESS;
+}
+
+uint32_t
+CxPlatWorkerPoolPoll(
+    _In_ CXPLAT_WORKER_POOL* WorkerPool,
+    _In_ uint16_t Index,
+    _In_ uint32_t WaitTimeMs
+    )
+{
+    CXPLAT_DBG_ASSERT(WorkerPool);
+    if (WorkerPool->Workers == NULL || !WorkerPool->External ||
+        Index >= WorkerPool->WorkerCount) {
+        return UINT32_MAX;
+    }
+
+    //
+    // The same as an iteration of CxPlatWorkerThread, except the wait for
+    // events is bounded by the app, and the next wait time is returned, for
+    // the app to wait for the event queue (or the time) itself.
+    //
+    CXPLAT_WORKER* Worker = &WorkerPool->Workers[Index];
+    CXPLAT_EXECUTION_STATE* State = &Worker->ExternalState;
+    State->ThreadID = CxPlatCurThreadID();
+    if (!*(volatile BOOLEAN*)&Worker->Running) {
+        InterlockedFetchAndSetBoolean(&Worker->Running);
+    }
+
+    ++State->NoWorkCount;
+#if DEBUG // Debug statistics
+    ++Worker->LoopCount;
+#endif
+    State->TimeNow = CxPlatTimeUs64();
+    CxPlatRunExecutionContexts(Worker, State);
+
+    State->WaitTime = CXPLAT_MIN(State->WaitTime, WaitTimeMs);
+    (void)CxPlatProcessEvents(Worker, State);
+
+    State->TimeNow = CxPlatTimeUs64();
+    CxPlatRunExecutionContexts(Worker, State);
+    if (State->WaitTime && InterlockedFetchAndClearBoolean(&Worker->Running)) {
+        //
+        // Run once more to handle race conditions, since any wake from here on
+        // signals the event queue.
+        //
+        State->TimeNow = CxPlatTimeUs64();
+        CxPlatRunExecutionContexts(Worker, State);
+    }
+
+    if (State->NoWorkCount == 0) {
+        State->LastWorkTime = State->TimeNow;
+    }
+
+    if (State->TimeNow - State->LastPoolProcessTime > DYNAMIC_POOL_PROCESSING_PERIOD) {
+        CxPlatProcessDynamicPoolAllocators(Worker);
+        State->LastPoolProcessTime = State->TimeNow;
+    }
+
+    return State->WaitTime;
+}
@@ -15,6 +15,9 @@ Abstract:
 #if OPENSSL_VERSION_MAJOR >= 3
 #define IS_OPENSSL_3
 #endif
+#if OPENSSL_VERSION_NUMBER >= 0x30200000L && !defined(OPENSSL_NO_COMP_ALG)
+#define CXPLAT_TLS_CERT_COMPRESSION
+#endif
 
 #ifdef _WIN32
 #pragma warning(push)
@@ -165,6 +168,13 @@ typedef struct CXPLAT_TLS {
 #define CXPLAT_TLS_AES_256_GCM_SHA384       "TLS_AES_256_GCM_SHA384"
 #define CXPLAT_TLS_CHACHA20_POLY1305_SHA256 "TLS_CHACHA20_POLY1305_SHA256"
 
+//
+// Key exchange groups a server accepts key shares for. Only elliptic curve
+// groups with fast key generation are allowed, so a client can't make the
+// server generate an expensive (e.g. FFDHE) ephemeral key per handshake.
+//
+#define CXPLAT_TLS_SERVER_GROUPS    "X25519:P-256:P-384:P-521"
+
 //
 // Default cert verify depth.
 //
@@ -221,6 +231,27 @@ CxPlatTlsAlpnSelectCallback(
     return SSL_TLSEXT_ERR_OK;
 }
 
+#ifdef IS_OPENSSL_3
+static
+int
+CxPlatTlsAsyncCallback(
+    _In_ SSL *Ssl,
+    _In_ void *Arg
+    )
+{
+    UNREFERENCED_PARAMETER(Arg);
+
+    //
+    // Called by the engine or provider, possibly on another thread, when an
+    // async private key operation completes.
+    //
+    CXPLAT_TLS* TlsContext = SSL_get_app_data(Ssl);
+    TlsContext->SecConfig->Callbacks.ProcessComplete(TlsContext->Connection);
+
+    return 1;
+}
+#endif
+
 static
 int
 CxPlatTlsCertificateVerifyCallback(
@@ -965,6 +996,18 @@ CxPlatTlsSecConfigCreate(
         return QUIC_STATUS_NOT_SUPPORTED; // Not supported by this TLS implementation
     }
 
+#ifndef IS_OPENSSL_3
+    if (CredConfigFlags & QUIC_CREDENTIAL_FLAG_ASYNC_PRIVATE_KEY) {
+        return QUIC_STATUS_NOT_SUPPORTED; // Needs the OpenSSL 3 async callback
+    }
+#endif
+
+#ifndef CXPLAT_TLS_CERT_COMPRESSION
+    if (CredConfigFlags & QUIC_CREDENTIAL_FLAG_ENABLE_CERTIFICATE_COMPRESSION) {
+        return QUIC_STATUS_NOT_SUPPORTED; // Needs OpenSSL 3.2 built with a compression library
+    }
+#endif
+
 #ifdef CX_PLATFORM_USES_TLS_BUILTIN_CERTIFICATE
     CredConfigFlags |= QUIC_CREDENTIAL_FLAG_USE_TLS_BUILTIN_CERTIFICATE_VALIDATION;
 #endif
@@ -1126,6 +1169,18 @@ CxPlatTlsSecConfigCreate(
         goto Exit;
     }
 
+#ifdef IS_OPENSSL_3
+    if (CredConfigFlags & QUIC_CREDENTIAL_FLAG_ASYNC_PRIVATE_KEY) {
+        //
+        // Run the handshake in an async job, so that a private key operation
+        // can pause it. The engine or provider invokes the async callback when
+        // the operation completes.
+        //
+        SSL_CTX_set_mode(SecurityConfig->SSLCtx, SSL_MODE_ASYNC);
+        SSL_CTX_set_async_callback(SecurityConfig->SSLCtx, CxPlatTlsAsyncCallback);
+    }
+#endif
+
     char* CipherSuites = CXPLAT_TLS_DEFAULT_SSL_CIPHERS;
     if (CredConfigFlags & QUIC_CREDENTIAL_FLAG_SET_ALLOWED_CIPHER_SUITES) {
         //
@@ -1484,6 +1539,26 @@ CxPlatTlsSecConfigCreate(
         }
     }
 
+#ifdef CXPLAT_TLS_CERT_COMPRESSION
+    if (CredConfigFlags & QUIC_CREDENTIAL_FLAG_ENABLE_CERTIFICATE_COMPRESSION) {
+        if (CredConfig->Type != QUIC_CREDENTIAL_TYPE_NONE &&
+            SSL_CTX_compress_certs(SecurityConfig->SSLCtx, 0) != 1) {
+            //
+            // Not fatal, the chain is then compressed for each handshake.
+            //
+            QuicTraceEvent(
+                LibraryErrorStatus,
+                "[ lib] ERROR, %u, %s.",
+                ERR_get_error(),
+                "SSL_CTX_compress_certs failed");
+        }
+    } else {
+        SSL_CTX_set_options(
+            SecurityConfig->SSLCtx,
+            SSL_OP_NO_TX_CERTIFICATE_COMPRESSION | SSL_OP_NO_RX_CERTIFICATE_COMPRESSION);
+    }
+#endif
+
     if (CredConfigFlags & QUIC_CREDENTIAL_FLAG_SET_CA_CERTIFICATE_FILE &&
         CredConfig->CaCertificateFile) {
         Ret =
@@ -1524,6 +1599,17 @@ CxPlatTlsSecConfigCreate(
         SSL_CTX_clear_options(SecurityConfig->SSLCtx, SSL_OP_ENABLE_MIDDLEBOX_COMPAT);
         SSL_CTX_set_mode(SecurityConfig->SSLCtx, SSL_MODE_RELEASE_BUFFERS);
 
+        Ret = SSL_CTX_set1_groups_list(SecurityConfig->SSLCtx, CXPLAT_TLS_SERVER_GROUPS);
+        if (Ret != 1) {
+            QuicTraceEvent(
+                LibraryErrorStatus,
+                "[ lib] ERROR, %u, %s.",
+                ERR_get_error(),
+                "SSL_CTX_set1_groups_list failed");
+            Status = QUIC_STATUS_TLS_ERROR;
+            goto Exit;
+        }
+
         if (CredConfigFlags & QUIC_CREDENTIAL_FLAG_INDICATE_CERTIFICATE_RECEIVED ||
             CredConfigFlags & QUIC_CREDENTIAL_FLAG_REQUIRE_CLIENT_AUTHENTICATION) {
             SSL_CTX_set_cert_verify_callback(
@@ -1995,6 +2081,20 @@ CxPlatTlsProcessData(
                 }
                 goto Exit;
 
+#ifdef IS_OPENSSL_3
+            case SSL_ERROR_WANT_ASYNC:
+                //
+                // A private key operation is outstanding. CxPlatTlsAsyncCallback
+                // indicates when the handshake can continue.
+                //
+                QuicTraceLogConnVerbose(
+                    OpenSslAsyncPending,
+                    TlsContext->Connection,
+                    "Handshake suspended for async private key operation");
+                TlsContext->ResultFlags |= CXPLAT_TLS_RESULT_PENDING;
+                goto Exit;
+#endif
+
             case SSL_ERROR_SSL: {
                 char buf[256];
                 const char* file;
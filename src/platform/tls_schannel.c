@@ -1004,7 +1004,9 @@ CxPlatTlsSecConfigCreate(
         return QUIC_STATUS_INVALID_PARAMETER;
     }
 
-    if (CredConfig->Flags & QUIC_CREDENTIAL_FLAG_SET_CA_CERTIFICATE_FILE) {
+    if (CredConfig->Flags & QUIC_CREDENTIAL_FLAG_SET_CA_CERTIFICATE_FILE ||
+        CredConfig->Flags & QUIC_CREDENTIAL_FLAG_ASYNC_PRIVATE_KEY ||
+        CredConfig->Flags & QUIC_CREDENTIAL_FLAG_ENABLE_CERTIFICATE_COMPRESSION) {
         return QUIC_STATUS_NOT_SUPPORTED;
     }
 
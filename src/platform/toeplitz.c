@@ -38,6 +38,13 @@ Notes:
     at a time. This requires us to maintain a lookup table of 16 32-bit entries
     for each nibble of the hash input.
 
+    Where the processor has a carry-less multiply instruction, eight bytes of
+    input are processed at once instead. With the input bits reversed within
+    each byte (so the leftmost input bit is the least significant), the XOR of
+    the shifted keys is exactly the carry-less product of the key and the
+    input, and the result is a 32-bit window of that product. The nibble
+    tables are still used for inputs shorter than eight bytes.
+
     This implementation assumes that the output of the hash is always 32-bit.
     It also assumes that the caller will pass in a array of bytes to hash, and
     the number of bits in the hash input will always be a multiple of 8 -- that
@@ -51,6 +58,124 @@ Notes:
 #include "toeplitz.c.clog.h"
 #endif
 
+#ifdef CXPLAT_TOEPLITZ_CLMUL
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#include <wmmintrin.h>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define CXPLAT_TARGET_CLMUL __attribute__((target("sse2,pclmul")))
+#else
+#define CXPLAT_TARGET_CLMUL
+#endif
+
+static
+BOOLEAN
+CxPlatToeplitzClmulSupported(
+    void
+    )
+{
+#ifdef _MSC_VER
+    int CpuInfo[4];
+    __cpuid(CpuInfo, 1);
+    return (CpuInfo[2] & (1 << 1)) != 0;
+#else
+    unsigned int Eax, Ebx, Ecx, Edx;
+    return __get_cpuid(1, &Eax, &Ebx, &Ecx, &Edx) && (Ecx & bit_PCLMUL) != 0;
+#endif
+}
+
+//
+// Reverses the order of the bits in each byte.
+//
+static
+uint64_t
+CxPlatToeplitzReverseBits(
+    _In_ uint64_t Value
+    )
+{
+    Value = ((Value >> 1) & 0x5555555555555555ull) | ((Value & 0x5555555555555555ull) << 1);
+    Value = ((Value >> 2) & 0x3333333333333333ull) | ((Value & 0x3333333333333333ull) << 2);
+    Value = ((Value >> 4) & 0x0F0F0F0F0F0F0F0Full) | ((Value & 0x0F0F0F0F0F0F0F0Full) << 4);
+    return Value;
+}
+
+//
+// Returns the hash of eight bytes of input (bit reversed by the caller) at
+// KeyOffset. The 96 bits of key they use are split into the leading 32 bits,
+// KeyHigh, and the 64 after them, KeyLow. The result is bits 64 to 95 of the
+// carry-less product of the key and the input, which is the low half of
+// KeyHigh * Input XORed with the high half of KeyLow * Input.
+//
+CXPLAT_TARGET_CLMUL
+static
+uint32_t
+CxPlatToeplitzHashClmulBlock(
+    _In_ const CXPLAT_TOEPLITZ_HASH* Toeplitz,
+    _In_ uint64_t Input,
+    _In_ uint32_t KeyOffset
+    )
+{
+    uint32_t KeyHigh;
+    uint64_t KeyLow;
+    CxPlatCopyMemory(&KeyHigh, Toeplitz->HashKey + KeyOffset, sizeof(KeyHigh));
+    CxPlatCopyMemory(&KeyLow, Toeplitz->HashKey + KeyOffset + sizeof(KeyHigh), sizeof(KeyLow));
+
+    __m128i Key =
+        _mm_set_epi64x(
+            (long long)CxPlatByteSwapUint32(KeyHigh),
+            (long long)CxPlatByteSwapUint64(KeyLow));
+    __m128i Data = _mm_cvtsi64_si128((long long)Input);
+    __m128i Low = _mm_clmulepi64_si128(Key, Data, 0x00);
+    __m128i High = _mm_clmulepi64_si128(Key, Data, 0x01);
+
+    return
+        (uint32_t)_mm_cvtsi128_si32(_mm_srli_si128(Low, 8)) ^
+        (uint32_t)_mm_cvtsi128_si32(High);
+}
+
+static
+uint32_t
+CxPlatToeplitzHashComputeClmul(
+    _In_ const CXPLAT_TOEPLITZ_HASH* Toeplitz,
+    _In_reads_(HashInputLength)
+        const uint8_t* HashInput,
+    _In_ uint32_t HashInputLength,
+    _In_ uint32_t HashInputOffset
+    )
+{
+    CXPLAT_DBG_ASSERT(HashInputLength >= sizeof(uint64_t));
+    uint32_t Result = 0;
+    uint64_t Input;
+
+    uint32_t i = 0;
+    for (; i + sizeof(Input) <= HashInputLength; i += sizeof(Input)) {
+        CxPlatCopyMemory(&Input, HashInput + i, sizeof(Input));
+        Result ^=
+            CxPlatToeplitzHashClmulBlock(
+                Toeplitz, CxPlatToeplitzReverseBits(Input), HashInputOffset + i);
+    }
+
+    if (i < HashInputLength) {
+        //
+        // Hash the last eight bytes again, with the ones already hashed
+        // masked off. This keeps the key window within the key.
+        //
+        const uint32_t Overlap = i - (HashInputLength - (uint32_t)sizeof(Input));
+        CxPlatCopyMemory(&Input, HashInput + HashInputLength - sizeof(Input), sizeof(Input));
+        Input = CxPlatToeplitzReverseBits(Input) & (~0ull << (Overlap * 8));
+        Result ^=
+            CxPlatToeplitzHashClmulBlock(
+                Toeplitz, Input, HashInputOffset + HashInputLength - sizeof(Input));
+    }
+
+    return Result;
+}
+#endif // CXPLAT_TOEPLITZ_CLMUL
+
 //
 // Initializes the state required for a Toeplitz hash computation. We
 // maintain per-nibble lookup tables, and we initialize them here.
@@ -129,6 +254,10 @@ CxPlatToeplitzHashInitialize(
             }
         }
     }
+
+#ifdef CXPLAT_TOEPLITZ_CLMUL
+    Toeplitz->UseClmul = CxPlatToeplitzClmulSupported();
+#endif
 }
 
 //
@@ -154,6 +283,14 @@ CxPlatToeplitzHashCompute(
     CXPLAT_DBG_ASSERT(
         (BaseOffset + HashInputLength * NIBBLES_PER_BYTE) <= CXPLAT_TOEPLITZ_LOOKUP_TABLE_COUNT);
 
+#ifdef CXPLAT_TOEPLITZ_CLMUL
+    if (Toeplitz->UseClmul && HashInputLength >= sizeof(uint64_t)) {
+        return
+            CxPlatToeplitzHashComputeClmul(
+                Toeplitz, HashInput, HashInputLength, HashInputOffset);
+    }
+#endif
+
     for (uint32_t i = 0; i < HashInputLength; i++) {
         Result ^= Toeplitz->LookupTableArray[BaseOffset].Table[(HashInput[i] >> 4) & 0xf];
         BaseOffset++;
@@ -434,6 +434,36 @@ TEST_F(CryptTest, HpMaskChaCha20)
 
     CxPlatHpKeyFree(HpKey);
 }
+
+TEST_F(CryptTest, HpMaskChaCha20Batch)
+{
+    const uint8_t BatchSize = 7;
+    uint8_t RawKey[32];
+    uint8_t Samples[CXPLAT_HP_SAMPLE_LENGTH * BatchSize];
+    uint8_t BatchMask[CXPLAT_HP_SAMPLE_LENGTH * BatchSize] = {0};
+    CxPlatRandom(sizeof(RawKey), RawKey);
+    CxPlatRandom(sizeof(Samples), Samples);
+
+    CXPLAT_HP_KEY* HpKey = nullptr;
+    VERIFY_QUIC_SUCCESS(CxPlatHpKeyCreate(CXPLAT_AEAD_CHACHA20_POLY1305, RawKey, &HpKey));
+    VERIFY_QUIC_SUCCESS(CxPlatHpComputeMask(HpKey, BatchSize, Samples, BatchMask));
+
+    //
+    // Each mask in the batch must match the mask computed on its own.
+    //
+    for (uint8_t i = 0; i < BatchSize; ++i) {
+        uint8_t Mask[CXPLAT_HP_SAMPLE_LENGTH] = {0};
+        VERIFY_QUIC_SUCCESS(
+            CxPlatHpComputeMask(HpKey, 1, Samples + CXPLAT_HP_SAMPLE_LENGTH * i, Mask));
+        if (memcmp(Mask, BatchMask + CXPLAT_HP_SAMPLE_LENGTH * i, 5) != 0) {
+            LogTestBuffer("Expected Mask:     ", Mask, 5);
+            LogTestBuffer("Calculated Mask:   ", BatchMask + CXPLAT_HP_SAMPLE_LENGTH * i, 5);
+            FAIL();
+        }
+    }
+
+    CxPlatHpKeyFree(HpKey);
+}
 #endif // QUIC_DISABLE_CHACHA20_TESTS
 
 TEST_F(CryptTest, HpMaskAes256)
@@ -540,6 +570,58 @@ TEST_P(CryptTest, Encryption)
     ASSERT_FALSE(Key.Decrypt(Iv, sizeof(AuthData), AuthData, sizeof(Buffer), Buffer));
 }
 
+TEST_P(CryptTest, EncryptionBatch)
+{
+    const uint8_t BatchSize = 4;
+    int AEAD = GetParam();
+
+    uint8_t RawKey[32] = {0};
+    uint8_t AuthData[BatchSize][12];
+    uint8_t Buffer[BatchSize][128];
+    uint8_t Expected[BatchSize][128];
+    CXPLAT_CRYPT_BATCH_ENTRY Entries[BatchSize];
+
+    QuicKey Key((CXPLAT_AEAD_TYPE)AEAD, RawKey);
+    if (Key.Ptr == NULL) return;
+
+    for (uint8_t i = 0; i < BatchSize; ++i) {
+        CxPlatZeroMemory(&Entries[i], sizeof(Entries[i]));
+        Entries[i].Iv[CXPLAT_IV_LENGTH - 1] = i;
+        memset(AuthData[i], i, sizeof(AuthData[i]));
+        Entries[i].AuthData = AuthData[i];
+        Entries[i].AuthDataLength = sizeof(AuthData[i]);
+        memset(Buffer[i], 0x80 | i, sizeof(Buffer[i]));
+        Entries[i].Buffer = Buffer[i];
+        Entries[i].BufferLength = (uint16_t)(sizeof(Buffer[i]) - i);
+
+        CxPlatCopyMemory(Expected[i], Buffer[i], sizeof(Buffer[i]));
+        ASSERT_TRUE(
+            Key.Encrypt(
+                Entries[i].Iv,
+                Entries[i].AuthDataLength,
+                AuthData[i],
+                Entries[i].BufferLength,
+                Expected[i]));
+    }
+
+    //
+    // The batched result must match encrypting each packet individually.
+    //
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, CxPlatEncryptBatch(Key.Ptr, BatchSize, Entries));
+    for (uint8_t i = 0; i < BatchSize; ++i) {
+        ASSERT_EQ(0, memcmp(Expected[i], Buffer[i], sizeof(Buffer[i])));
+    }
+
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, CxPlatDecryptBatch(Key.Ptr, BatchSize, Entries));
+
+    //
+    // A corrupted packet in the batch must fail authentication.
+    //
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, CxPlatEncryptBatch(Key.Ptr, BatchSize, Entries));
+    Buffer[BatchSize - 1][0] ^= 1;
+    ASSERT_NE(QUIC_STATUS_SUCCESS, CxPlatDecryptBatch(Key.Ptr, BatchSize, Entries));
+}
+
 TEST_P(CryptTest, HashWellKnown)
 {
     int HASH = GetParam();
@@ -51,6 +51,207 @@ TEST(PlatformTest, QuicAddrParsing)
     }
 }
 
+TEST(PlatformTest, Random)
+{
+    //
+    // Consecutive calls, and calls that span buffer refills and reseeds,
+    // never repeat output.
+    //
+    uint8_t First[32], Second[32];
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, CxPlatRandom(sizeof(First), First));
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, CxPlatRandom(sizeof(Second), Second));
+    ASSERT_NE(0, memcmp(First, Second, sizeof(First)));
+
+    const uint32_t Length = 2 * 1024 * 1024;
+    uint8_t* Large = (uint8_t*)CXPLAT_ALLOC_NONPAGED(Length, QUIC_POOL_TEST);
+    ASSERT_NE(nullptr, Large);
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, CxPlatRandom(Length, Large));
+    uint32_t Counts[256] = {0};
+    for (uint32_t i = 0; i < Length; ++i) {
+        ++Counts[Large[i]];
+    }
+    for (uint32_t i = 0; i < 256; ++i) {
+        ASSERT_GT(Counts[i], Length / 256 * 9 / 10);
+        ASSERT_LT(Counts[i], Length / 256 * 11 / 10);
+    }
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, CxPlatRandom(sizeof(First), First));
+    ASSERT_NE(0, memcmp(First, Second, sizeof(First)));
+    CXPLAT_FREE(Large, QUIC_POOL_TEST);
+}
+
+TEST(PlatformTest, TimeMonotonic)
+{
+    //
+    // Long enough to cross the TSC clock's calibration and a resync on Linux.
+    //
+    const uint64_t Start = CxPlatTimeUs64();
+    uint64_t Previous = Start;
+    uint64_t Now;
+    do {
+        Now = CxPlatTimeUs64();
+        ASSERT_GE(Now, Previous);
+        Previous = Now;
+    } while (CxPlatTimeDiff64(Start, Now) < 300 * 1000);
+
+    const uint64_t BeforeSleep = CxPlatTimeUs64();
+    CxPlatSleep(50);
+    const uint64_t Slept = CxPlatTimeDiff64(BeforeSleep, CxPlatTimeUs64());
+    ASSERT_GE(Slept, 45 * 1000u);
+    ASSERT_LT(Slept, 5 * 1000 * 1000u);
+}
+
+struct HashtableTestEntry {
+    CXPLAT_HASHTABLE_ENTRY Entry;
+    uint32_t Key;
+    bool InTable;
+};
+
+//
+// Many keys share each signature, so lookups have to walk past other entries.
+//
+static uint64_t HashtableTestSignature(uint32_t Key) { return Key % 251 + 1; }
+
+static
+bool
+HashtableTestContains(
+    _In_ const CXPLAT_HASHTABLE* Table,
+    _In_ uint32_t Key
+    )
+{
+    CXPLAT_HASHTABLE_LOOKUP_CONTEXT Context;
+    CXPLAT_HASHTABLE_ENTRY* Entry =
+        CxPlatHashtableLookup(Table, HashtableTestSignature(Key), &Context);
+    while (Entry != NULL) {
+        if (CXPLAT_CONTAINING_RECORD(Entry, HashtableTestEntry, Entry)->Key == Key) {
+            return true;
+        }
+        Entry = CxPlatHashtableLookupNext(Table, &Context);
+    }
+    return false;
+}
+
+TEST(PlatformTest, HashtableOpenAddressing)
+{
+    //
+    // Random inserts and removes from the smallest size, so the table is
+    // resized (and lookups span the old and new slots) many times.
+    //
+    const uint32_t Count = 4096;
+    HashtableTestEntry* Entries =
+        (HashtableTestEntry*)CXPLAT_ALLOC_NONPAGED(Count * sizeof(HashtableTestEntry), QUIC_POOL_TEST);
+    ASSERT_NE(nullptr, Entries);
+    for (uint32_t i = 0; i < Count; ++i) {
+        Entries[i].Key = i;
+        Entries[i].InTable = false;
+    }
+
+    CXPLAT_HASHTABLE* Table = NULL;
+    ASSERT_TRUE(CxPlatHashtableInitializeOpen(&Table, 16));
+    for (uint32_t Round = 0; Round < 64; ++Round) {
+        for (uint32_t i = 0; i < Count; ++i) {
+            uint32_t Index;
+            CxPlatRandom(sizeof(Index), &Index);
+            HashtableTestEntry* Entry = &Entries[Index % Count];
+            if (Entry->InTable) {
+                CxPlatHashtableRemove(Table, &Entry->Entry, NULL);
+            } else {
+                ASSERT_TRUE(CxPlatHashtableInsert(Table, &Entry->Entry, HashtableTestSignature(Entry->Key), NULL));
+            }
+            Entry->InTable = !Entry->InTable;
+        }
+        for (uint32_t i = 0; i < Count; ++i) {
+            ASSERT_EQ(Entries[i].InTable, HashtableTestContains(Table, i));
+        }
+
+        //
+        // Enumeration visits every entry once, even as it removes some.
+        //
+        uint32_t Expected = 0, Visited = 0;
+        for (uint32_t i = 0; i < Count; ++i) {
+            Expected += Entries[i].InTable ? 1 : 0;
+        }
+        CXPLAT_HASHTABLE_ENUMERATOR Enumerator;
+        CxPlatHashtableEnumerateBegin(Table, &Enumerator);
+        CXPLAT_HASHTABLE_ENTRY* Entry;
+        while ((Entry = CxPlatHashtableEnumerateNext(Table, &Enumerator)) != NULL) {
+            HashtableTestEntry* TestEntry = CXPLAT_CONTAINING_RECORD(Entry, HashtableTestEntry, Entry);
+            ASSERT_TRUE(TestEntry->InTable);
+            ++Visited;
+            if (TestEntry->Key % 4 == 0) {
+                CxPlatHashtableRemove(Table, Entry, NULL);
+                TestEntry->InTable = false;
+            }
+        }
+        CxPlatHashtableEnumerateEnd(Table, &Enumerator);
+        ASSERT_EQ(Expected, Visited);
+    }
+
+    for (uint32_t i = 0; i < Count; ++i) {
+        if (Entries[i].InTable) {
+            CxPlatHashtableRemove(Table, &Entries[i].Entry, NULL);
+        }
+    }
+    CxPlatHashtableUninitialize(Table);
+    CXPLAT_FREE(Entries, QUIC_POOL_TEST);
+}
+
+//
+// Computes the hash one input bit at a time, as the algorithm is defined.
+//
+static
+uint32_t
+ToeplitzHashReference(
+    _In_ const uint8_t* Key,
+    _In_reads_(Length) const uint8_t* Input,
+    _In_ uint32_t Length,
+    _In_ uint32_t Offset
+    )
+{
+    uint32_t Result = 0;
+    for (uint32_t i = 0; i < Length * 8; ++i) {
+        if (Input[i / 8] & (0x80 >> (i % 8))) {
+            uint32_t Window = 0;
+            for (uint32_t j = Offset * 8 + i; j < Offset * 8 + i + 32; ++j) {
+                Window = (Window << 1) | ((Key[j / 8] >> (7 - j % 8)) & 1);
+            }
+            Result ^= Window;
+        }
+    }
+    return Result;
+}
+
+TEST(PlatformTest, Toeplitz)
+{
+    //
+    // Every input length and offset, with each implementation available.
+    //
+    CXPLAT_TOEPLITZ_HASH* Toeplitz =
+        (CXPLAT_TOEPLITZ_HASH*)CXPLAT_ALLOC_NONPAGED(sizeof(CXPLAT_TOEPLITZ_HASH), QUIC_POOL_TEST);
+    ASSERT_NE(nullptr, Toeplitz);
+    uint8_t Input[CXPLAT_TOEPLITZ_INPUT_SIZE];
+    for (uint32_t Run = 0; Run < 16; ++Run) {
+        ASSERT_EQ(QUIC_STATUS_SUCCESS, CxPlatRandom(sizeof(Toeplitz->HashKey), Toeplitz->HashKey));
+        ASSERT_EQ(QUIC_STATUS_SUCCESS, CxPlatRandom(sizeof(Input), Input));
+        CxPlatToeplitzHashInitialize(Toeplitz);
+#ifdef CXPLAT_TOEPLITZ_CLMUL
+        const BOOLEAN UseClmul = Toeplitz->UseClmul;
+#endif
+        for (uint32_t Offset = 0; Offset <= CXPLAT_TOEPLITZ_INPUT_SIZE; ++Offset) {
+            for (uint32_t Length = 0; Offset + Length <= CXPLAT_TOEPLITZ_INPUT_SIZE; ++Length) {
+                const uint32_t Expected =
+                    ToeplitzHashReference(Toeplitz->HashKey, Input, Length, Offset);
+                ASSERT_EQ(Expected, CxPlatToeplitzHashCompute(Toeplitz, Input, Length, Offset));
+#ifdef CXPLAT_TOEPLITZ_CLMUL
+                Toeplitz->UseClmul = FALSE;
+                ASSERT_EQ(Expected, CxPlatToeplitzHashCompute(Toeplitz, Input, Length, Offset));
+                Toeplitz->UseClmul = UseClmul;
+#endif
+            }
+        }
+    }
+    CXPLAT_FREE(Toeplitz, QUIC_POOL_TEST);
+}
+
 TEST(PlatformTest, EventQueue)
 {
     uint32_t user_data1 = 0x1234, user_data2 = 0x5678, user_data3 = 0x90;
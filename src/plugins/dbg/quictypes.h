@@ -186,12 +186,6 @@ typedef union QUIC_CONNECTION_STATE {
         //
         BOOLEAN TestTransportParameterSet : 1;
 
-        //
-        // Indicates the connection is using the round robin stream scheduling
-        // scheme.
-        //
-        BOOLEAN UseRoundRobinStreamScheduling : 1;
-
         //
         // Indicates that this connection has resumption enabled and needs to
         // keep the TLS state and transport parameters until it is done sending
@@ -999,6 +993,10 @@ typedef enum QUIC_API_TYPE {
     QUIC_API_TYPE_DATAGRAM_SEND,
     QUIC_API_TYPE_CONN_COMPLETE_RESUMPTION_TICKET_VALIDATION,
     QUIC_API_TYPE_CONN_COMPLETE_CERTIFICATE_VALIDATION,
+    QUIC_API_TYPE_STRM_PROVIDE_RECV_BUFFERS,
+    QUIC_API_TYPE_STRM_OPEN_AND_SEND,
+    QUIC_API_TYPE_STRM_RECV_COMPLETE_BATCH,
+    QUIC_API_TYPE_STRM_RECEIVE,
 
 } QUIC_API_TYPE;
 
@@ -1044,6 +1042,14 @@ struct ApiCall : Struct {
             return "API_TYPE_CONN_COMPLETE_RESUMPTION_TICKET_VALIDATION";
         case QUIC_API_TYPE_CONN_COMPLETE_CERTIFICATE_VALIDATION:
             return "API_TYPE_CONN_COMPLETE_CERTIFICATE_VALIDATION";
+        case QUIC_API_TYPE_STRM_PROVIDE_RECV_BUFFERS:
+            return "API_TYPE_STRM_PROVIDE_RECV_BUFFERS";
+        case QUIC_API_TYPE_STRM_OPEN_AND_SEND:
+            return "API_TYPE_STRM_OPEN_AND_SEND";
+        case QUIC_API_TYPE_STRM_RECV_COMPLETE_BATCH:
+            return "API_TYPE_STRM_RECV_COMPLETE_BATCH";
+        case QUIC_API_TYPE_STRM_RECEIVE:
+            return "API_TYPE_STRM_RECEIVE";
         default:
             return "INVALID API";
         }
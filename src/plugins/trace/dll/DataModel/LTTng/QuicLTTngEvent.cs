@@ -116,6 +116,8 @@ namespace QuicTrace.DataModel.LTTng
                     return new QuicConnectionCongestionEvent(timestamp, processor, processId, threadId, pointerSize, data.ReadPointer());
                 case nameof(QuicEventId.ConnCongestionV2):
                     return new QuicConnectionCongestionV2Event(timestamp, processor, processId, threadId, pointerSize, data.ReadPointer(), data.ReadByte());
+                case nameof(QuicEventId.ConnPacketLost):
+                    return new QuicConnectionPacketLostEvent(timestamp, processor, processId, threadId, pointerSize, data.ReadPointer(), data.ReadULong(), data.ReadByte(), data.ReadByte());
                 case nameof(QuicEventId.ConnSourceCidAdded):
                     return new QuicConnectionSourceCidAddedEvent(timestamp, processor, processId, threadId, pointerSize, data.ReadPointer(), data.ReadULong(), data.ReadBytes());
                 case nameof(QuicEventId.ConnDestCidAdded):
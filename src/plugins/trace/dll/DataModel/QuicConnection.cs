@@ -51,6 +51,12 @@ namespace QuicTrace.DataModel
 
         public ulong BytesReceived { get; private set; }
 
+        public ulong PacketsLost { get; private set; }
+
+        public ulong[] PacketsLostByReason { get; } = new ulong[(int)QuicPacketLossReason.Max];
+
+        public uint CongestionEvents { get; private set; }
+
         public QuicWorker? Worker { get; private set; }
 
         public QuicConnection? Peer { get; set; }
@@ -457,6 +463,19 @@ namespace QuicTrace.DataModel
                         TrySetWorker(evt, state);
                         break;
                     }
+                case QuicEventId.ConnPacketLost:
+                    {
+                        var _evt = evt as QuicConnectionPacketLostEvent;
+                        PacketsLost++;
+                        if (_evt!.Reason < QuicPacketLossReason.Max)
+                        {
+                            PacketsLostByReason[(int)_evt.Reason]++;
+                        }
+                        break;
+                    }
+                case QuicEventId.ConnCongestion:
+                    CongestionEvents++;
+                    break;
                 case QuicEventId.ConnSourceCidAdded:
                     SourceCIDs.Add((evt as QuicConnectionSourceCidAddedEvent)!.CID);
                     break;
@@ -41,7 +41,14 @@ namespace QuicTrace.DataModel
         StreamReceiveSetEnabled,
         StreamDatagramSend,
         ConnectionCompleteResumptionTicketValidation,
-        ConnectionCompleteCertificateValidation
+        ConnectionCompleteCertificateValidation,
+        StreamProvideReceiveBuffers,
+        DatagramSendBatch,
+        StreamOpenAndSend,
+        StreamReceiveCompleteBatch,
+        StreamReceive,
+        RegistrationPollEvents,
+        StreamSendBatch
     }
 
     public enum QuicConnectionState
@@ -135,7 +142,8 @@ namespace QuicTrace.DataModel
         TimerLossDetection,
         TimerKeepAlive,
         TimerIdle,
-        TimerShutdown
+        TimerShutdown,
+        TimerHibernate
     }
 
     [Flags]
@@ -152,6 +160,14 @@ namespace QuicTrace.DataModel
         App = 0x80
     }
 
+    public enum QuicPacketLossReason
+    {
+        TimeThreshold,      // RACK
+        PacketThreshold,    // FACK
+        ProbeTimeout,
+        Max
+    }
+
     public enum QuicScheduleState
     {
         Idle,
@@ -855,6 +871,25 @@ namespace QuicTrace.DataModel
         }
     }
 
+    public class QuicConnectionPacketLostEvent : QuicEvent
+    {
+        public ulong PacketNumber { get; }
+
+        public byte PacketType { get; }
+
+        public QuicPacketLossReason Reason { get; }
+
+        public override string PayloadString => string.Format("[TX][{0}] {1} Lost: {2}", PacketNumber, PacketType, Reason);
+
+        internal QuicConnectionPacketLostEvent(Timestamp timestamp, ushort processor, uint processId, uint threadId, int pointerSize, ulong objectPointer, ulong packetNumber, byte packetType, byte reason) :
+            base(QuicEventId.ConnPacketLost, QuicObjectType.Connection, timestamp, processor, processId, threadId, pointerSize, objectPointer)
+        {
+            PacketNumber = packetNumber;
+            PacketType = packetType;
+            Reason = (QuicPacketLossReason)reason;
+        }
+    }
+
     public class QuicConnectionSourceCidAddedEvent : QuicEvent
     {
         public ulong SequenceNumber { get; }
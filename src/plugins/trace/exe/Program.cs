@@ -35,7 +35,12 @@ namespace QuicTrace
                 "Commands:\n" +
                 "  -p, --print           Prints events as text\n" +
                 "  -r, --report          Prints out an analysis of possible problems in the trace\n" +
-                "  -s, --rps             Prints out an analysis RPS-related events in the trace\n"
+                "  -s, --rps             Prints out an analysis RPS-related events in the trace\n" +
+                "  -w, --worker          Prints each worker's utilization and queue delay\n" +
+                "  -o, --conn_tput [--id <num>] [--reso <ms>]\n" +
+                "                        Prints a connection's throughput timeline (def: the busiest one, 100 ms)\n" +
+                "  -l, --loss [--top <num>]\n" +
+                "                        Prints a summary of lost packets, and the connections with the most losses\n"
                 );
         }
 
@@ -180,6 +185,161 @@ namespace QuicTrace
             // TODO - Dump Connection info
             //
         }
+        static string? GetCommandValue(string[] args, string name)
+        {
+            for (var i = 1; i + 1 < args.Length; ++i)
+            {
+                if (args[i] == name)
+                {
+                    return args[i + 1];
+                }
+            }
+            return null;
+        }
+
+        static void RunWorkerReport(QuicState quicState)
+        {
+            var workers = quicState.Workers;
+            Console.WriteLine("\nWORKERS ({0})\n", workers.Count);
+            Console.WriteLine(
+                "{0,6} {1,10} {2,8} {3,12} {4,15} {5,15}",
+                "ID", "Processor", "Active%", "Connections", "QueueDelay(us)", "Processing(ms)");
+            foreach (var worker in workers.OrderBy(w => w.Id))
+            {
+                Console.WriteLine(
+                    "{0,6} {1,10} {2,8} {3,12} {4,15} {5,15}",
+                    worker.Id,
+                    worker.IdealProcessor,
+                    worker.ActivePercent,
+                    worker.TotalConnections,
+                    worker.AverageQueueDelayUs,
+                    worker.TotalProcessingTimeUs / 1000);
+            }
+        }
+
+        static void RunConnTputReport(QuicState quicState, string[] args)
+        {
+            var resoMs = ulong.Parse(GetCommandValue(args, "--reso") ?? "100");
+            var id = GetCommandValue(args, "--id");
+            var conn = id != null ?
+                quicState.Connections.FirstOrDefault(c => c.Id == ulong.Parse(id)) :
+                quicState.Connections.OrderByDescending(c => c.BytesSent + c.BytesReceived).FirstOrDefault();
+            if (conn == null || conn.Events.Count == 0 || resoMs == 0)
+            {
+                Console.WriteLine("No matching connection found.");
+                return;
+            }
+
+            Console.WriteLine(
+                "\nConnection {0} ({1}), {2} ms resolution\n",
+                conn.Id, conn.IsServer == true ? "server" : "client", resoMs);
+            Console.WriteLine(
+                "{0,10} {1,10} {2,10} {3,10} {4,10} {5,10} {6,6}",
+                "Time(ms)", "Tx(Mbps)", "Rx(Mbps)", "RTT(us)", "CWnd", "InFlight", "Lost");
+
+            //
+            // Rates are from the change in the cumulative byte counts over each
+            // interval, the other columns are the last value seen in it.
+            //
+            ulong interval = 0, bytesSent = 0, bytesRecv = 0, lastSent = 0, lastRecv = 0;
+            ulong rtt = 0, cwnd = 0, inFlight = 0, lost = 0;
+            void PrintInterval()
+            {
+                Console.WriteLine(
+                    "{0,10} {1,10:F1} {2,10:F1} {3,10} {4,10} {5,10} {6,6}",
+                    interval * resoMs,
+                    (bytesSent - lastSent) * 8.0 / (resoMs * 1000),
+                    (bytesRecv - lastRecv) * 8.0 / (resoMs * 1000),
+                    rtt, cwnd, inFlight, lost);
+                lastSent = bytesSent;
+                lastRecv = bytesRecv;
+                lost = 0;
+                interval++;
+            }
+
+            var t0 = conn.Events[0].TimeStamp;
+            foreach (var evt in conn.Events)
+            {
+                var eventInterval = (ulong)(evt.TimeStamp - t0).ToNanoseconds / (resoMs * 1000 * 1000);
+                while (interval < eventInterval)
+                {
+                    PrintInterval();
+                }
+
+                switch (evt)
+                {
+                    case QuicConnectionOutFlowStatsEvent _evt:
+                        bytesSent = _evt.BytesSent;
+                        rtt = _evt.SmoothedRtt;
+                        cwnd = _evt.CongestionWindow;
+                        inFlight = _evt.BytesInFlight;
+                        break;
+                    case QuicConnectionOutFlowStatsV2Event _evt:
+                        bytesSent = _evt.BytesSent;
+                        rtt = _evt.SmoothedRtt;
+                        cwnd = _evt.CongestionWindow;
+                        inFlight = _evt.BytesInFlight;
+                        break;
+                    case QuicConnectionInFlowStatsEvent _evt:
+                        bytesRecv = _evt.BytesRecv;
+                        break;
+                    case QuicConnectionPacketLostEvent _:
+                        lost++;
+                        break;
+                }
+            }
+            PrintInterval();
+        }
+
+        static void RunLossReport(QuicState quicState, string[] args)
+        {
+            var top = int.Parse(GetCommandValue(args, "--top") ?? "10");
+            var conns = quicState.Connections;
+
+            ulong lost = 0;
+            ulong congestionEvents = 0;
+            var lostByReason = new ulong[(int)QuicPacketLossReason.Max];
+            foreach (var conn in conns)
+            {
+                lost += conn.PacketsLost;
+                congestionEvents += conn.CongestionEvents;
+                for (var i = 0; i < lostByReason.Length; ++i)
+                {
+                    lostByReason[i] += conn.PacketsLostByReason[i];
+                }
+            }
+
+            Console.WriteLine("\nPACKET LOSS\n");
+            Console.WriteLine(
+                "  {0} packets lost in {1} of {2} connections, with {3} congestion events.",
+                lost, conns.Count(c => c.PacketsLost != 0), conns.Count, congestionEvents);
+            Console.WriteLine(
+                "  {0} detected by time threshold, {1} by packet threshold and {2} by probe timeout.",
+                lostByReason[(int)QuicPacketLossReason.TimeThreshold],
+                lostByReason[(int)QuicPacketLossReason.PacketThreshold],
+                lostByReason[(int)QuicPacketLossReason.ProbeTimeout]);
+            if (lost == 0)
+            {
+                return;
+            }
+
+            Console.WriteLine(
+                "\n{0,6} {1,8} {2,8} {3,8} {4,8} {5,11} {6,14}",
+                "ID", "Lost", "Time", "Packet", "Probe", "Congestion", "BytesSent");
+            foreach (var conn in conns.Where(c => c.PacketsLost != 0).OrderByDescending(c => c.PacketsLost).Take(top))
+            {
+                Console.WriteLine(
+                    "{0,6} {1,8} {2,8} {3,8} {4,8} {5,11} {6,14}",
+                    conn.Id,
+                    conn.PacketsLost,
+                    conn.PacketsLostByReason[(int)QuicPacketLossReason.TimeThreshold],
+                    conn.PacketsLostByReason[(int)QuicPacketLossReason.PacketThreshold],
+                    conn.PacketsLostByReason[(int)QuicPacketLossReason.ProbeTimeout],
+                    conn.CongestionEvents,
+                    conn.BytesSent);
+            }
+        }
+
         public sealed class SequentialByteComparer : IEqualityComparer<byte[]>
         {
 #pragma warning disable CS8767 // Nullability of reference types in type of parameter doesn't match implicitly implemented member (possibly because of nullability attributes).
@@ -427,6 +587,18 @@ namespace QuicTrace
             {
                 RunRpsAnalysis(quicStates);
             }
+            else if (args[0] == "--worker" || args[0] == "-w")
+            {
+                RunWorkerReport(quicStates[0]);
+            }
+            else if (args[0] == "--conn_tput" || args[0] == "-o")
+            {
+                RunConnTputReport(quicStates[0], args);
+            }
+            else if (args[0] == "--loss" || args[0] == "-l")
+            {
+                RunLossReport(quicStates[0], args);
+            }
             else if (args[0] == "--help" || args[0] == "-h" || args[0] == "-?")
             {
                 PrintCommands();
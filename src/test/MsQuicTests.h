@@ -118,6 +118,11 @@ QuicTestLocalPathChanges(
     _In_ int Family
     );
 
+void
+QuicTestLocalAddressMigration(
+    _In_ int Family
+    );
+
 //
 // Handshake Tests
 //
@@ -423,6 +428,11 @@ QuicTestConnectAndIdleForDestCidChange(
     void
     );
 
+void
+QuicTestConnectionPool(
+    _In_ int Family
+    );
+
 void
 QuicTestServerDisconnect(
     void
@@ -1330,4 +1340,12 @@ typedef struct {
     QUIC_CTL_CODE(125, METHOD_BUFFERED, FILE_WRITE_DATA)
     // BOOLEAN - EnableResumption
 
-#define QUIC_MAX_IOCTL_FUNC_CODE 125
+#define IOCTL_QUIC_RUN_CLIENT_LOCAL_ADDRESS_MIGRATION \
+    QUIC_CTL_CODE(126, METHOD_BUFFERED, FILE_WRITE_DATA)
+    // int - Family
+
+#define IOCTL_QUIC_RUN_CONNECTION_POOL \
+    QUIC_CTL_CODE(127, METHOD_BUFFERED, FILE_WRITE_DATA)
+    // int - Family
+
+#define QUIC_MAX_IOCTL_FUNC_CODE 127
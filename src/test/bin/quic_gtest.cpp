@@ -607,6 +607,15 @@ TEST_P(WithFamilyArgs, Ecn) {
     }
 }
 
+TEST_P(WithFamilyArgs, LocalAddressMigration) {
+    TestLoggerT<ParamType> Logger("QuicTestLocalAddressMigration", GetParam());
+    if (TestingKernelMode) {
+        ASSERT_TRUE(DriverClient.Run(IOCTL_QUIC_RUN_CLIENT_LOCAL_ADDRESS_MIGRATION, GetParam().Family));
+    } else {
+        QuicTestLocalAddressMigration(GetParam().Family);
+    }
+}
+
 TEST_P(WithFamilyArgs, LocalPathChanges) {
     TestLoggerT<ParamType> Logger("QuicTestLocalPathChanges", GetParam());
     if (TestingKernelMode) {
@@ -1934,6 +1943,15 @@ TEST_P(WithBool, IdleTimeout) {
     }
 }
 
+TEST_P(WithFamilyArgs, ConnectionPool) {
+    TestLoggerT<ParamType> Logger("QuicTestConnectionPool", GetParam());
+    if (TestingKernelMode) {
+        ASSERT_TRUE(DriverClient.Run(IOCTL_QUIC_RUN_CONNECTION_POOL, GetParam().Family));
+    } else {
+        QuicTestConnectionPool(GetParam().Family);
+    }
+}
+
 TEST(Misc, IdleDestCidChange) {
     TestLogger Logger("QuicTestConnectAndIdleDestCidChange");
     if (TestingKernelMode) {
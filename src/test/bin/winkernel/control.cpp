@@ -524,6 +524,8 @@ size_t QUIC_IOCTL_BUFFER_SIZES[] =
     0,
     0,
     sizeof(BOOLEAN),
+    sizeof(INT32),
+    sizeof(INT32),
 };
 
 CXPLAT_STATIC_ASSERT(
@@ -1202,6 +1204,11 @@ QuicTestCtlEvtIoDeviceControl(
         QuicTestCtlRun(QuicTestLocalPathChanges(Params->Family));
         break;
 
+    case IOCTL_QUIC_RUN_CLIENT_LOCAL_ADDRESS_MIGRATION:
+        CXPLAT_FRE_ASSERT(Params != nullptr);
+        QuicTestCtlRun(QuicTestLocalAddressMigration(Params->Family));
+        break;
+
     case IOCTL_QUIC_RUN_STREAM_DIFFERENT_ABORT_ERRORS:
         QuicTestCtlRun(QuicTestStreamDifferentAbortErrors());
         break;
@@ -1347,6 +1354,11 @@ QuicTestCtlEvtIoDeviceControl(
         QuicTestCtlRun(QuicTestConnectAndIdleForDestCidChange());
         break;
 
+    case IOCTL_QUIC_RUN_CONNECTION_POOL:
+        CXPLAT_FRE_ASSERT(Params != nullptr);
+        QuicTestCtlRun(QuicTestConnectionPool(Params->Family));
+        break;
+
     case IOCTL_QUIC_RUN_CHANGE_ALPN:
         QuicTestCtlRun(QuicTestChangeAlpn());
         break;
@@ -1745,6 +1745,125 @@ void QuicTestValidateStream(bool Connect)
                         QUIC_TEST_NO_ERROR));
             }
 
+            //
+            // Batched open, start and send.
+            //
+            {
+                TestScopeLogger logScope("Open and send batch");
+                StreamScope Streams[3];
+                QUIC_STREAM_OPEN_SEND_REQUEST Requests[ARRAYSIZE(Streams)] = {};
+                for (uint32_t i = 0; i < ARRAYSIZE(Requests); ++i) {
+                    Requests[i].OpenFlags = QUIC_STREAM_OPEN_FLAG_NONE;
+                    Requests[i].StartFlags = QUIC_STREAM_START_FLAG_NONE;
+                    Requests[i].Handler = AllowSendCompleteStreamCallback;
+                    Requests[i].Buffers = Buffers;
+                    Requests[i].BufferCount = ARRAYSIZE(Buffers);
+                    Requests[i].SendFlags = QUIC_SEND_FLAG_FIN;
+                }
+
+                TEST_QUIC_STATUS(
+                    QUIC_STATUS_INVALID_PARAMETER,
+                    MsQuic->StreamOpenAndSend(
+                        nullptr,
+                        Requests,
+                        ARRAYSIZE(Requests)));
+
+                TEST_QUIC_STATUS(
+                    QUIC_STATUS_INVALID_PARAMETER,
+                    MsQuic->StreamOpenAndSend(
+                        Client.GetConnection(),
+                        Requests,
+                        0));
+
+                //
+                // A single bad request fails the whole batch.
+                //
+                Requests[1].Handler = nullptr;
+                TEST_QUIC_STATUS(
+                    QUIC_STATUS_INVALID_PARAMETER,
+                    MsQuic->StreamOpenAndSend(
+                        Client.GetConnection(),
+                        Requests,
+                        ARRAYSIZE(Requests)));
+                TEST_EQUAL(nullptr, Requests[0].Stream);
+                Requests[1].Handler = AllowSendCompleteStreamCallback;
+
+                TEST_QUIC_SUCCEEDED(
+                    MsQuic->StreamOpenAndSend(
+                        Client.GetConnection(),
+                        Requests,
+                        ARRAYSIZE(Requests)));
+                for (uint32_t i = 0; i < ARRAYSIZE(Requests); ++i) {
+                    TEST_NOT_EQUAL(nullptr, Requests[i].Stream);
+                    Streams[i].Handle = Requests[i].Stream;
+                }
+            }
+
+            //
+            // Pulled receive.
+            //
+            {
+                TestScopeLogger logScope("Pull receive");
+                StreamScope Stream;
+                TEST_QUIC_SUCCEEDED(
+                    MsQuic->StreamOpen(
+                        Client.GetConnection(),
+                        QUIC_STREAM_OPEN_FLAG_NONE,
+                        AllowSendCompleteStreamCallback,
+                        nullptr,
+                        &Stream.Handle));
+
+                uint8_t RecvData[64];
+                QUIC_BUFFER RecvBuffer = { sizeof(RecvData), RecvData };
+                uint64_t BytesReceived = 0;
+                QUIC_RECEIVE_FLAGS RecvFlags = QUIC_RECEIVE_FLAG_NONE;
+
+                TEST_QUIC_STATUS(
+                    QUIC_STATUS_INVALID_PARAMETER,
+                    MsQuic->StreamReceive(
+                        nullptr,
+                        &RecvBuffer,
+                        1,
+                        &BytesReceived,
+                        &RecvFlags));
+
+                TEST_QUIC_STATUS(
+                    QUIC_STATUS_INVALID_PARAMETER,
+                    MsQuic->StreamReceive(
+                        Stream.Handle,
+                        &RecvBuffer,
+                        1,
+                        nullptr,
+                        &RecvFlags));
+
+                //
+                // Receive callbacks must be disabled first.
+                //
+                TEST_QUIC_STATUS(
+                    QUIC_STATUS_INVALID_STATE,
+                    MsQuic->StreamReceive(
+                        Stream.Handle,
+                        &RecvBuffer,
+                        1,
+                        &BytesReceived,
+                        &RecvFlags));
+
+                TEST_QUIC_SUCCEEDED(
+                    MsQuic->StreamReceiveSetEnabled(
+                        Stream.Handle,
+                        FALSE));
+
+                TEST_QUIC_SUCCEEDED(
+                    MsQuic->StreamReceive(
+                        Stream.Handle,
+                        &RecvBuffer,
+                        1,
+                        &BytesReceived,
+                        &RecvFlags));
+                TEST_EQUAL(0u, BytesReceived);
+                TEST_EQUAL(QUIC_RECEIVE_FLAG_NONE, RecvFlags);
+            }
+
             //
             // Close nullptr.
             //
@@ -1837,6 +1956,33 @@ void QuicTestValidateStream(bool Connect)
                             QUIC_SEND_FLAG_START,
                             nullptr));
                 }
+
+                //
+                // Batch Send After Connection Shutdown
+                //
+                {
+                    TestScopeLogger logScope("Batch Send After Connection Shutdown");
+                    QUIC_STREAM_SEND_BATCH_REQUEST Requests[] = {
+                        { Buffers, ARRAYSIZE(Buffers) },
+                        { Buffers, ARRAYSIZE(Buffers) }
+                    };
+                    TEST_QUIC_STATUS(
+                        QUIC_STATUS_INVALID_PARAMETER,
+                        MsQuic->StreamSendBatch(
+                            PrevOpenAndStartedStream.Handle,
+                            Requests,
+                            0,
+                            QUIC_SEND_FLAG_NONE,
+                            nullptr));
+                    TEST_QUIC_STATUS(
+                        QUIC_STATUS_ABORTED,
+                        MsQuic->StreamSendBatch(
+                            PrevOpenAndStartedStream.Handle,
+                            Requests,
+                            ARRAYSIZE(Requests),
+                            QUIC_SEND_FLAG_NONE,
+                            nullptr));
+                }
             }
         }
     }
@@ -2152,6 +2298,32 @@ void QuicTestStatefulGlobalSetParam()
     }
 }
 
+static
+void
+QUIC_API
+QlogTestHandler(
+    _In_opt_ void* Context,
+    _In_reads_bytes_(Length) const char* Data,
+    _In_ uint32_t Length
+    )
+{
+    UNREFERENCED_PARAMETER(Data);
+    *(uint32_t*)Context += Length;
+}
+
+static
+void
+QUIC_API
+PacketCaptureTestHandler(
+    _In_opt_ void* Context,
+    _In_reads_bytes_(Length) const uint8_t* Data,
+    _In_ uint32_t Length
+    )
+{
+    UNREFERENCED_PARAMETER(Data);
+    *(uint32_t*)Context += Length;
+}
+
 void QuicTestGlobalParam()
 {
     //
@@ -2483,6 +2655,134 @@ void QuicTestGlobalParam()
         }
     }
 
+    //
+    // QUIC_PARAM_GLOBAL_STARTUP_TIMINGS
+    //
+    {
+        TestScopeLogger LogScope0("QUIC_PARAM_GLOBAL_STARTUP_TIMINGS");
+        {
+            TestScopeLogger LogScope1("SetParam is not allowed");
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_INVALID_PARAMETER,
+                MsQuic->SetParam(
+                    nullptr,
+                    QUIC_PARAM_GLOBAL_STARTUP_TIMINGS,
+                    0,
+                    nullptr));
+        }
+
+        {
+            TestScopeLogger LogScope1("GetParam");
+            uint32_t Length = 0;
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_BUFFER_TOO_SMALL,
+                MsQuic->GetParam(
+                    nullptr,
+                    QUIC_PARAM_GLOBAL_STARTUP_TIMINGS,
+                    &Length,
+                    nullptr));
+            TEST_EQUAL(Length, sizeof(QUIC_STARTUP_TIMINGS));
+
+            QUIC_STARTUP_TIMINGS Timings;
+            TEST_QUIC_SUCCEEDED(
+                MsQuic->GetParam(
+                    nullptr,
+                    QUIC_PARAM_GLOBAL_STARTUP_TIMINGS,
+                    &Length,
+                    &Timings));
+            TEST_TRUE(Timings.PlatformInitUs >= Timings.CryptoInitUs);
+            TEST_TRUE(Timings.LibraryInitUs >= Timings.PlatformInitUs);
+            TEST_TRUE(Timings.DatapathInitUs >= Timings.WorkerPoolStartUs);
+        }
+    }
+
+    //
+    // QUIC_PARAM_GLOBAL_SIMULATION_TIME
+    //
+    {
+        TestScopeLogger LogScope0("QUIC_PARAM_GLOBAL_SIMULATION_TIME");
+#ifdef QUIC_SIMULATION
+        QUIC_SIMULATION_STATE State;
+        uint32_t Length = sizeof(State);
+        TEST_QUIC_SUCCEEDED(
+            MsQuic->GetParam(
+                nullptr,
+                QUIC_PARAM_GLOBAL_SIMULATION_TIME,
+                &Length,
+                &State));
+        TEST_EQUAL(Length, sizeof(QUIC_SIMULATION_STATE));
+
+        {
+            TestScopeLogger LogScope1("Time only moves when set");
+            QUIC_SIMULATION_STATE Later;
+            TEST_QUIC_SUCCEEDED(
+                MsQuic->GetParam(
+                    nullptr,
+                    QUIC_PARAM_GLOBAL_SIMULATION_TIME,
+                    &Length,
+                    &Later));
+            TEST_EQUAL(Later.TimeUs, State.TimeUs);
+        }
+
+        const uint64_t Next = State.TimeUs + 1000;
+        {
+            TestScopeLogger LogScope1("Advance");
+            TEST_QUIC_SUCCEEDED(
+                MsQuic->SetParam(
+                    nullptr,
+                    QUIC_PARAM_GLOBAL_SIMULATION_TIME,
+                    sizeof(Next),
+                    &Next));
+            TEST_QUIC_SUCCEEDED(
+                MsQuic->GetParam(
+                    nullptr,
+                    QUIC_PARAM_GLOBAL_SIMULATION_TIME,
+                    &Length,
+                    &State));
+            TEST_EQUAL(State.TimeUs, Next);
+        }
+
+        {
+            TestScopeLogger LogScope1("Never moves backwards");
+            const uint64_t Earlier = Next - 500;
+            TEST_QUIC_SUCCEEDED(
+                MsQuic->SetParam(
+                    nullptr,
+                    QUIC_PARAM_GLOBAL_SIMULATION_TIME,
+                    sizeof(Earlier),
+                    &Earlier));
+            TEST_QUIC_SUCCEEDED(
+                MsQuic->GetParam(
+                    nullptr,
+                    QUIC_PARAM_GLOBAL_SIMULATION_TIME,
+                    &Length,
+                    &State));
+            TEST_EQUAL(State.TimeUs, Next);
+        }
+
+        {
+            TestScopeLogger LogScope1("UINT64_MAX is not allowed");
+            const uint64_t Max = UINT64_MAX;
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_INVALID_PARAMETER,
+                MsQuic->SetParam(
+                    nullptr,
+                    QUIC_PARAM_GLOBAL_SIMULATION_TIME,
+                    sizeof(Max),
+                    &Max));
+        }
+#else
+        const uint64_t Next = 0;
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_NOT_SUPPORTED,
+            MsQuic->SetParam(
+                nullptr,
+                QUIC_PARAM_GLOBAL_SIMULATION_TIME,
+                sizeof(Next),
+                &Next));
+#endif
+    }
+
 #ifndef _KERNEL_MODE
     //
     // QUIC_PARAM_GLOBAL_DATAPATH_FEATURES
@@ -2681,1818 +2981,3787 @@ void QuicTestGlobalParam()
         }
     }
 
-#if DEBUG
     //
-    // QUIC_PARAM_GLOBAL_PLATFORM_WORKER_POOL
+    // QUIC_PARAM_GLOBAL_SEND_BUFFER_LIMIT
     //
     {
-        TestScopeLogger LogScope0("QUIC_PARAM_GLOBAL_PLATFORM_WORKER_POOL");
+        TestScopeLogger LogScope0("QUIC_PARAM_GLOBAL_SEND_BUFFER_LIMIT");
+        GlobalSettingScope ParamScope(QUIC_PARAM_GLOBAL_SEND_BUFFER_LIMIT);
+        uint64_t Limit = 64 * 1024 * 1024;
         {
             TestScopeLogger LogScope1("SetParam");
-            //
-            // Invalid features
-            //
             {
-                TestScopeLogger LogScope2("SetParam is not allowed");
+                TestScopeLogger LogScope2("Invalid length");
+                uint32_t SmallLimit = 0;
                 TEST_QUIC_STATUS(
                     QUIC_STATUS_INVALID_PARAMETER,
                     MsQuic->SetParam(
                         nullptr,
-                        QUIC_PARAM_GLOBAL_PLATFORM_WORKER_POOL,
-                        0,
-                        nullptr));
+                        QUIC_PARAM_GLOBAL_SEND_BUFFER_LIMIT,
+                        sizeof(SmallLimit),
+                        &SmallLimit));
             }
+            TEST_QUIC_SUCCEEDED(
+                MsQuic->SetParam(
+                    nullptr,
+                    QUIC_PARAM_GLOBAL_SEND_BUFFER_LIMIT,
+                    sizeof(Limit),
+                    &Limit));
         }
 
         {
-            TestScopeLogger LogScope2("GetParam. Failed by missing MsQuicLib.WorkerPool");
+            TestScopeLogger LogScope1("GetParam");
+            SimpleGetParamTest(nullptr, QUIC_PARAM_GLOBAL_SEND_BUFFER_LIMIT, sizeof(Limit), &Limit);
+        }
+    }
+
+    //
+    // QUIC_PARAM_GLOBAL_MTU_PROBE_SIZES
+    //
+    {
+        TestScopeLogger LogScope0("QUIC_PARAM_GLOBAL_MTU_PROBE_SIZES");
+        GlobalSettingScope ParamScope(QUIC_PARAM_GLOBAL_MTU_PROBE_SIZES);
+        uint16_t ProbeSizes[] = { 1300, 1420, 1500 };
+        {
+            TestScopeLogger LogScope1("SetParam");
+            {
+                TestScopeLogger LogScope2("Not increasing");
+                uint16_t BadSizes[] = { 1400, 1300 };
+                TEST_QUIC_STATUS(
+                    QUIC_STATUS_INVALID_PARAMETER,
+                    MsQuic->SetParam(
+                        nullptr,
+                        QUIC_PARAM_GLOBAL_MTU_PROBE_SIZES,
+                        sizeof(BadSizes),
+                        BadSizes));
+            }
+            {
+                TestScopeLogger LogScope2("Out of range");
+                uint16_t BadSizes[] = { 1300, 9000 };
+                TEST_QUIC_STATUS(
+                    QUIC_STATUS_INVALID_PARAMETER,
+                    MsQuic->SetParam(
+                        nullptr,
+                        QUIC_PARAM_GLOBAL_MTU_PROBE_SIZES,
+                        sizeof(BadSizes),
+                        BadSizes));
+            }
+            {
+                TestScopeLogger LogScope2("Too many");
+                uint16_t BadSizes[] = { 1280, 1290, 1300, 1310, 1320, 1330, 1340, 1350, 1360 };
+                TEST_QUIC_STATUS(
+                    QUIC_STATUS_INVALID_PARAMETER,
+                    MsQuic->SetParam(
+                        nullptr,
+                        QUIC_PARAM_GLOBAL_MTU_PROBE_SIZES,
+                        sizeof(BadSizes),
+                        BadSizes));
+            }
+            TEST_QUIC_SUCCEEDED(
+                MsQuic->SetParam(
+                    nullptr,
+                    QUIC_PARAM_GLOBAL_MTU_PROBE_SIZES,
+                    sizeof(ProbeSizes),
+                    ProbeSizes));
+        }
+
+        {
+            TestScopeLogger LogScope1("GetParam");
+            SimpleGetParamTest(nullptr, QUIC_PARAM_GLOBAL_MTU_PROBE_SIZES, sizeof(ProbeSizes), ProbeSizes);
+        }
+    }
+
+    //
+    // QUIC_PARAM_GLOBAL_WORKER_STATISTICS
+    //
+    {
+        TestScopeLogger LogScope0("QUIC_PARAM_GLOBAL_WORKER_STATISTICS");
+        {
+            TestScopeLogger LogScope1("SetParam is not allowed");
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_INVALID_PARAMETER,
+                MsQuic->SetParam(
+                    nullptr,
+                    QUIC_PARAM_GLOBAL_WORKER_STATISTICS,
+                    0,
+                    nullptr));
+        }
+
+        {
+            TestScopeLogger LogScope1("GetParam");
+            MsQuicRegistration Registration;
+            TEST_TRUE(Registration.IsValid());
+
             uint32_t Length = 0;
             TEST_QUIC_STATUS(
                 QUIC_STATUS_BUFFER_TOO_SMALL,
                 MsQuic->GetParam(
                     nullptr,
-                    QUIC_PARAM_GLOBAL_PLATFORM_WORKER_POOL,
+                    QUIC_PARAM_GLOBAL_WORKER_STATISTICS,
                     &Length,
                     nullptr));
-            TEST_EQUAL(Length, sizeof(CXPLAT_WORKER_POOL*));
+            TEST_NOT_EQUAL(0u, Length);
+            TEST_EQUAL(0u, Length % sizeof(QUIC_WORKER_STATISTICS));
 
-            CXPLAT_WORKER_POOL* WorkerPool = 0;
+            const uint32_t Count = Length / sizeof(QUIC_WORKER_STATISTICS);
+            UniquePtrArray<QUIC_WORKER_STATISTICS> Stats(new(std::nothrow) QUIC_WORKER_STATISTICS[Count]);
+            TEST_TRUE(Stats);
             TEST_QUIC_SUCCEEDED(
                 MsQuic->GetParam(
                     nullptr,
-                    QUIC_PARAM_GLOBAL_PLATFORM_WORKER_POOL,
+                    QUIC_PARAM_GLOBAL_WORKER_STATISTICS,
                     &Length,
-                    &WorkerPool));
+                    Stats.get()));
+            TEST_EQUAL(Count * sizeof(QUIC_WORKER_STATISTICS), Length);
+
+            bool FoundRegistration = false;
+            for (uint32_t i = 0; i < Count; ++i) {
+                TEST_NOT_EQUAL(nullptr, Stats.get()[i].Registration);
+                if (Stats.get()[i].Registration == Registration.Handle) {
+                    FoundRegistration = true;
+                }
+            }
+            TEST_TRUE(FoundRegistration);
         }
     }
-#endif
 
     //
-    // Invalid parameter
+    // QUIC_PARAM_GLOBAL_DATAPATH_STATISTICS
     //
     {
-        TestScopeLogger LogScope("Invalid parameter for Global SetParam");
-        TEST_QUIC_STATUS(
-            QUIC_STATUS_INVALID_PARAMETER,
-            MsQuic->SetParam(
-                nullptr,
-                QUIC_PARAM_PREFIX_GLOBAL | 0x00234567,
-                0,
-                nullptr));
-    }
-
-    QuicTestStatefulGlobalSetParam();
-}
-
-void QuicTestCommonParam()
-{
-    //
-    // Null hundle
-    //
-    {
-        TestScopeLogger LogScope("Null handle with non-global param");
-        TEST_QUIC_STATUS(
-            QUIC_STATUS_INVALID_PARAMETER,
-            MsQuic->SetParam(
-                nullptr,
-                0, // Any param other than GLOBAL
-                0,
-                nullptr));
-
-        TEST_QUIC_STATUS(
-            QUIC_STATUS_INVALID_PARAMETER,
-            MsQuic->GetParam(
-                nullptr,
-                0,
-                nullptr,
-                nullptr));
-    }
-
-    MsQuicRegistration Registration;
-    TEST_TRUE(Registration.IsValid());
-
-    //
-    // Global param with handle
-    //
-    {
-        TestScopeLogger LogScope("Global param with handle");
-        TEST_QUIC_STATUS(
-            QUIC_STATUS_INVALID_PARAMETER,
-            MsQuic->SetParam(
-                Registration.Handle,
-                QUIC_PARAM_PREFIX_GLOBAL,
-                0,
-                nullptr));
-
-        TEST_QUIC_STATUS(
-            QUIC_STATUS_INVALID_PARAMETER,
-            MsQuic->GetParam(
-                Registration.Handle,
-                QUIC_PARAM_PREFIX_GLOBAL,
-                nullptr,
-                nullptr));
-    }
-
-    //
-    // Invalid handle type
-    //
-    {
-        TestScopeLogger LogScope("Invalid handle type");
-        MsQuicConnection Connection(Registration);
-        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
-        auto OriginalType = ((uint8_t*)Connection.Handle)[0];
-        ((uint8_t*)Connection.Handle)[0] = 128; // Invalid
-
-        TEST_QUIC_STATUS(
-            QUIC_STATUS_INVALID_PARAMETER,
-            MsQuic->SetParam(
-                Connection.Handle,
-                0,
-                0,
-                nullptr));
-
-        uint32_t DummyLength = 0;
-        TEST_QUIC_STATUS(
-            QUIC_STATUS_INVALID_PARAMETER,
-            MsQuic->GetParam(
-                Connection.Handle,
-                0,
-                &DummyLength,
-                nullptr));
-
-        ((uint8_t*)Connection.Handle)[0] = OriginalType;
-    }
-}
-
-void QuicTestRegistrationParam()
-{
-    MsQuicRegistration Registration;
-    TEST_TRUE(Registration.IsValid());
-    //
-    // No parameter for Registration
-    //
-    {
-        uint32_t Dummy = 0;
-        TEST_QUIC_STATUS(
-            QUIC_STATUS_INVALID_PARAMETER,
-            MsQuic->SetParam(
-                Registration.Handle,
-                QUIC_PARAM_PREFIX_REGISTRATION,
-                sizeof(Dummy),
-                &Dummy));
-    }
+        TestScopeLogger LogScope0("QUIC_PARAM_GLOBAL_DATAPATH_STATISTICS");
+        {
+            TestScopeLogger LogScope1("SetParam is not allowed");
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_INVALID_PARAMETER,
+                MsQuic->SetParam(
+                    nullptr,
+                    QUIC_PARAM_GLOBAL_DATAPATH_STATISTICS,
+                    0,
+                    nullptr));
+        }
 
-    {
-        uint32_t Length = 65535;
-        uint32_t Buffer = 65535;
-        TEST_QUIC_STATUS(
-            QUIC_STATUS_INVALID_PARAMETER,
-            MsQuic->GetParam(
-                Registration.Handle,
-                QUIC_PARAM_PREFIX_REGISTRATION,
-                &Length,
-                &Buffer));
-        TEST_EQUAL(Length, 65535);
-        TEST_EQUAL(Buffer, 65535);
+        {
+            //
+            // Only the raw datapath has queues, and the datapath may not have
+            // been created yet.
+            //
+            TestScopeLogger LogScope1("GetParam");
+            uint32_t Length = 0;
+            QUIC_STATUS Status =
+                MsQuic->GetParam(
+                    nullptr,
+                    QUIC_PARAM_GLOBAL_DATAPATH_STATISTICS,
+                    &Length,
+                    nullptr);
+            if (Status == QUIC_STATUS_SUCCESS) {
+                TEST_EQUAL(0u, Length);
+            } else if (Status == QUIC_STATUS_BUFFER_TOO_SMALL) {
+                TEST_NOT_EQUAL(0u, Length);
+                TEST_EQUAL(0u, Length % sizeof(QUIC_DATAPATH_QUEUE_STATISTICS));
+
+                const uint32_t Count = Length / sizeof(QUIC_DATAPATH_QUEUE_STATISTICS);
+                UniquePtrArray<QUIC_DATAPATH_QUEUE_STATISTICS> Stats(
+                    new(std::nothrow) QUIC_DATAPATH_QUEUE_STATISTICS[Count]);
+                TEST_TRUE(Stats);
+                TEST_QUIC_SUCCEEDED(
+                    MsQuic->GetParam(
+                        nullptr,
+                        QUIC_PARAM_GLOBAL_DATAPATH_STATISTICS,
+                        &Length,
+                        Stats.get()));
+                TEST_EQUAL(Count * sizeof(QUIC_DATAPATH_QUEUE_STATISTICS), Length);
+            } else {
+                TEST_QUIC_STATUS(QUIC_STATUS_INVALID_STATE, Status);
+            }
+        }
     }
-}
-
-#define SETTINGS_SIZE_THRU_FIELD(SettingsType, Field) \
-    (FIELD_OFFSET(SettingsType, Field) + sizeof(((SettingsType*)0)->Field))
-
-void QuicTestConfigurationParam()
-{
-    MsQuicRegistration Registration;
-    TEST_TRUE(Registration.IsValid());
-    MsQuicAlpn Alpn("MsQuicTest");
 
     //
-    // QUIC_PARAM_CONFIGURATION_SETTINGS
+    // QUIC_PARAM_GLOBAL_MEMORY_BUDGET
     //
     {
-        TestScopeLogger LogScope0("QUIC_PARAM_CONFIGURATION_SETTINGS");
+        TestScopeLogger LogScope0("QUIC_PARAM_GLOBAL_MEMORY_BUDGET");
+        GlobalSettingScope ParamScope(QUIC_PARAM_GLOBAL_MEMORY_BUDGET);
+        struct PressureContext {
+            static void QUIC_API Callback(void* Context, QUIC_MEMORY_PRESSURE_LEVEL Level) {
+                *(QUIC_MEMORY_PRESSURE_LEVEL*)Context = Level;
+            }
+        };
+        QUIC_MEMORY_PRESSURE_LEVEL ReportedLevel = QUIC_MEMORY_PRESSURE_NONE;
+        QUIC_MEMORY_BUDGET Budget = { 1, PressureContext::Callback, &ReportedLevel };
         {
             TestScopeLogger LogScope1("SetParam");
-            //
-            // QuicSettingsSettingsToInternal fail
-            //
             {
-                TestScopeLogger LogScope2("QuicSettingsSettingsToInternal fail");
-                MsQuicConfiguration Configuration(Registration, Alpn);
-                QUIC_SETTINGS Settings{0};
+                TestScopeLogger LogScope2("Invalid length");
                 TEST_QUIC_STATUS(
                     QUIC_STATUS_INVALID_PARAMETER,
                     MsQuic->SetParam(
                         nullptr,
-                        QUIC_PARAM_CONFIGURATION_SETTINGS,
-                        sizeof(QUIC_SETTINGS)-8,
-                        &Settings));
+                        QUIC_PARAM_GLOBAL_MEMORY_BUDGET,
+                        sizeof(Budget.Limit),
+                        &Budget.Limit));
             }
+            TEST_QUIC_SUCCEEDED(
+                MsQuic->SetParam(
+                    nullptr,
+                    QUIC_PARAM_GLOBAL_MEMORY_BUDGET,
+                    sizeof(Budget),
+                    &Budget));
 
             //
-            // QuicSettingApply fail
+            // Half of a one byte budget is already in use, so the level
+            // changes (and is reported) right away.
             //
-            {
-                TestScopeLogger LogScope2("QuicSettingApply fail");
-                MsQuicConfiguration Configuration(Registration, Alpn);
-                SettingApplyTests(Configuration.Handle, QUIC_PARAM_CONFIGURATION_SETTINGS);
-            }
+            TEST_NOT_EQUAL(QUIC_MEMORY_PRESSURE_NONE, ReportedLevel);
         }
 
-        //
-        // GetParam
-        //
         {
             TestScopeLogger LogScope1("GetParam");
-            MsQuicConfiguration Configuration(Registration, Alpn);
-            uint32_t Length = 0;
-            TEST_QUIC_STATUS(
-                QUIC_STATUS_BUFFER_TOO_SMALL,
-                MsQuic->GetParam(
-                    Configuration.Handle,
-                    QUIC_PARAM_CONFIGURATION_SETTINGS,
-                    &Length,
-                    nullptr));
-            TEST_TRUE(Length >= sizeof(QUIC_SETTINGS));
+            SimpleGetParamTest(nullptr, QUIC_PARAM_GLOBAL_MEMORY_BUDGET, sizeof(Budget), &Budget);
 
-            Length = 1;
-            TEST_QUIC_STATUS(
-                QUIC_STATUS_BUFFER_TOO_SMALL,
-                MsQuic->GetParam(
-                    Configuration.Handle,
-                    QUIC_PARAM_CONFIGURATION_SETTINGS,
-                    &Length,
-                    nullptr));
-            TEST_EQUAL(Length, SETTINGS_SIZE_THRU_FIELD(QUIC_SETTINGS, MtuDiscoveryMissingProbeCount));
-
-            QUIC_SETTINGS Settings{0};
+            QUIC_MEMORY_PRESSURE_LEVEL Level = QUIC_MEMORY_PRESSURE_NONE;
+            uint32_t Length = sizeof(Level);
             TEST_QUIC_SUCCEEDED(
                 MsQuic->GetParam(
-                    Configuration.Handle,
-                    QUIC_PARAM_CONFIGURATION_SETTINGS,
+                    nullptr,
+                    QUIC_PARAM_GLOBAL_MEMORY_PRESSURE,
                     &Length,
-                    &Settings));
-            // TODO: how to compare with default?
-            //       QuicSettingsSetDefault is not accessible from test
+                    &Level));
+            TEST_EQUAL(ReportedLevel, Level);
         }
     }
 
     //
-    // QUIC_PARAM_CONFIGURATION_TICKET_KEYS
+    // QUIC_PARAM_GLOBAL_SOURCE_RATE_LIMIT
     //
     {
-        TestScopeLogger LogScope0("QUIC_PARAM_CONFIGURATION_TICKET_KEYS");
+        TestScopeLogger LogScope0("QUIC_PARAM_GLOBAL_SOURCE_RATE_LIMIT");
+        GlobalSettingScope ParamScope(QUIC_PARAM_GLOBAL_SOURCE_RATE_LIMIT);
+        QUIC_SOURCE_RATE_LIMIT Limit = { 100, 1000, 24, 48 };
         {
             TestScopeLogger LogScope1("SetParam");
-            //
-            // Set before MsQuic->ConfigurationLoadCredential which is Configuration->SecurityConfig == NULL
-            //
             {
-                TestScopeLogger LogScope2("Set before MsQuic->ConfigurationLoadCredential which is Configuration->SecurityConfig == NULL");
-                MsQuicConfiguration Configuration(Registration, Alpn);
-                QUIC_TICKET_KEY_CONFIG Config{0};
+                TestScopeLogger LogScope2("Invalid prefix length");
+                QUIC_SOURCE_RATE_LIMIT BadLimit = Limit;
+                BadLimit.Ipv4PrefixLength = 33;
                 TEST_QUIC_STATUS(
-                    QUIC_STATUS_INVALID_STATE,
+                    QUIC_STATUS_INVALID_PARAMETER,
                     MsQuic->SetParam(
-                        Configuration,
-                        QUIC_PARAM_CONFIGURATION_TICKET_KEYS,
-                        sizeof(Config),
-                        &Config));
+                        nullptr,
+                        QUIC_PARAM_GLOBAL_SOURCE_RATE_LIMIT,
+                        sizeof(BadLimit),
+                        &BadLimit));
             }
-
-            //
-            // SetParam for client is not supported
-            //
             {
-                TestScopeLogger LogScope2("SetParam for client is not supported");
-                MsQuicConfiguration Configuration(Registration, Alpn);
-                QUIC_CREDENTIAL_CONFIG CredConfig = {};
-                CredConfig.Flags = QUIC_CREDENTIAL_FLAG_CLIENT;
-                Configuration.LoadCredential(&CredConfig);
-                QUIC_TICKET_KEY_CONFIG Config = {};
+                TestScopeLogger LogScope2("Invalid rate");
+                QUIC_SOURCE_RATE_LIMIT BadLimit = Limit;
+                BadLimit.DropRate = QUIC_SOURCE_RATE_LIMIT_MAX_RATE + 1;
                 TEST_QUIC_STATUS(
-                    QUIC_STATUS_NOT_SUPPORTED,
+                    QUIC_STATUS_INVALID_PARAMETER,
                     MsQuic->SetParam(
-                        Configuration,
-                        QUIC_PARAM_CONFIGURATION_TICKET_KEYS,
-                        sizeof(Config),
-                        &Config));
-            }
-
-            //
-            // Good with self-signed key
-            //
-            {
-                TestScopeLogger LogScope2("Good tests are covered by QuicTestValidateConfiguration");
+                        nullptr,
+                        QUIC_PARAM_GLOBAL_SOURCE_RATE_LIMIT,
+                        sizeof(BadLimit),
+                        &BadLimit));
             }
+            TEST_QUIC_SUCCEEDED(
+                MsQuic->SetParam(
+                    nullptr,
+                    QUIC_PARAM_GLOBAL_SOURCE_RATE_LIMIT,
+                    sizeof(Limit),
+                    &Limit));
         }
 
-        //
-        // GetParam
-        //
         {
-            TestScopeLogger LogScope1("GetParam is not allowed");
-            MsQuicConfiguration Configuration(Registration, Alpn);
-            TEST_QUIC_STATUS(
-                QUIC_STATUS_INVALID_PARAMETER,
-                MsQuic->GetParam(
-                    Configuration,
-                    QUIC_PARAM_CONFIGURATION_TICKET_KEYS,
-                    nullptr,
-                    nullptr));
+            TestScopeLogger LogScope1("GetParam");
+            SimpleGetParamTest(nullptr, QUIC_PARAM_GLOBAL_SOURCE_RATE_LIMIT, sizeof(Limit), &Limit);
         }
     }
 
     //
-    // QUIC_PARAM_CONFIGURATION_VERSION_SETTINGS
+    // QUIC_PARAM_GLOBAL_ZERO_RTT_ANTI_REPLAY
     //
     {
-        TestScopeLogger LogScope("QUIC_PARAM_CONFIGURATION_VERSION_SETTINGS is covered by QuicTestVersionSettings");
-    }
-
-#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
-    //
-    // QUIC_PARAM_CONFIGURATION_VERSION_NEG_ENABLED
-    //
-    {
-
-        TestScopeLogger LogScope0("QUIC_PARAM_CONFIGURATION_VERSION_NEG_ENABLED");
-        MsQuicConfiguration Configuration(Registration, Alpn);
-        BOOLEAN ExpectedFlag = TRUE;
-        //
-        // SetParam
-        //
+        TestScopeLogger LogScope0("QUIC_PARAM_GLOBAL_ZERO_RTT_ANTI_REPLAY");
+        GlobalSettingScope ParamScope(QUIC_PARAM_GLOBAL_ZERO_RTT_ANTI_REPLAY);
+        QUIC_ZERO_RTT_ANTI_REPLAY AntiReplay = { 10000, 1000 };
         {
+            TestScopeLogger LogScope1("SetParam");
+            {
+                TestScopeLogger LogScope2("No entries");
+                QUIC_ZERO_RTT_ANTI_REPLAY BadAntiReplay = { 10000, 0 };
+                TEST_QUIC_STATUS(
+                    QUIC_STATUS_INVALID_PARAMETER,
+                    MsQuic->SetParam(
+                        nullptr,
+                        QUIC_PARAM_GLOBAL_ZERO_RTT_ANTI_REPLAY,
+                        sizeof(BadAntiReplay),
+                        &BadAntiReplay));
+            }
+            {
+                TestScopeLogger LogScope2("Too many entries");
+                QUIC_ZERO_RTT_ANTI_REPLAY BadAntiReplay = { 10000, QUIC_ZERO_RTT_ANTI_REPLAY_MAX_ENTRIES + 1 };
+                TEST_QUIC_STATUS(
+                    QUIC_STATUS_INVALID_PARAMETER,
+                    MsQuic->SetParam(
+                        nullptr,
+                        QUIC_PARAM_GLOBAL_ZERO_RTT_ANTI_REPLAY,
+                        sizeof(BadAntiReplay),
+                        &BadAntiReplay));
+            }
             TEST_QUIC_SUCCEEDED(
                 MsQuic->SetParam(
-                    Configuration,
-                    QUIC_PARAM_CONFIGURATION_VERSION_NEG_ENABLED,
-                    sizeof(ExpectedFlag),
-                    &ExpectedFlag));
+                    nullptr,
+                    QUIC_PARAM_GLOBAL_ZERO_RTT_ANTI_REPLAY,
+                    sizeof(AntiReplay),
+                    &AntiReplay));
         }
 
-        //
-        // GetParam
-        //
         {
-            uint32_t Length = 0;
-            TEST_QUIC_STATUS(
-                QUIC_STATUS_BUFFER_TOO_SMALL,
-                MsQuic->GetParam(
-                    Configuration,
-                    QUIC_PARAM_CONFIGURATION_VERSION_NEG_ENABLED,
-                    &Length,
-                    nullptr));
-            TEST_EQUAL(Length, sizeof(BOOLEAN));
-
-            BOOLEAN Flag = FALSE;
-            TEST_QUIC_SUCCEEDED(
-                MsQuic->GetParam(
-                    Configuration,
-                    QUIC_PARAM_CONFIGURATION_VERSION_NEG_ENABLED,
-                    &Length,
-                    &Flag));
-            TEST_EQUAL(Flag, ExpectedFlag);
+            TestScopeLogger LogScope1("GetParam");
+            SimpleGetParamTest(nullptr, QUIC_PARAM_GLOBAL_ZERO_RTT_ANTI_REPLAY, sizeof(AntiReplay), &AntiReplay);
         }
     }
-#endif
-}
 
-// Used by Listener and Connection
-void CibirIDTests(HQUIC Handle, uint32_t Param) {
     //
-    // buffer length test
+    // QUIC_PARAM_GLOBAL_TIMER_SLACK
     //
     {
-        TestScopeLogger LogScope0("Buffer length test");
-        //
-        // Buffer is bigger than QUIC_MAX_CIBIR_LENGTH + 1
-        //
+        TestScopeLogger LogScope0("QUIC_PARAM_GLOBAL_TIMER_SLACK");
+        GlobalSettingScope ParamScope(QUIC_PARAM_GLOBAL_TIMER_SLACK);
         {
-            TestScopeLogger LogScope1("Buffer is bigger than QUIC_MAX_CIBIR_LENGTH + 1");
-            uint8_t Cibir[128] = {0};
+            TestScopeLogger LogScope1("GetParam default");
+            uint32_t Expected = 0;
+            SimpleGetParamTest(nullptr, QUIC_PARAM_GLOBAL_TIMER_SLACK, sizeof(Expected), &Expected);
+        }
+
+        uint32_t Slack = 500;
+        {
+            TestScopeLogger LogScope1("SetParam");
             TEST_QUIC_STATUS(
                 QUIC_STATUS_INVALID_PARAMETER,
                 MsQuic->SetParam(
-                    Handle,
-                    Param,
-                    sizeof(Cibir),
-                    &Cibir));
-        }
+                    nullptr,
+                    QUIC_PARAM_GLOBAL_TIMER_SLACK,
+                    sizeof(Slack) - 1,
+                    &Slack));
 
-        //
-        // BufferLength == 1
-        //
-        {
-            TestScopeLogger LogScope1("BufferLength == 1");
-            uint8_t Cibir[1] = {0};
+            uint32_t TooLong = 10001;
             TEST_QUIC_STATUS(
                 QUIC_STATUS_INVALID_PARAMETER,
                 MsQuic->SetParam(
-                    Handle,
-                    Param,
-                    sizeof(Cibir),
-                    &Cibir));
-        }
+                    nullptr,
+                    QUIC_PARAM_GLOBAL_TIMER_SLACK,
+                    sizeof(TooLong),
+                    &TooLong));
 
-        //
-        // Good without value, length 0
-        //
-        {
-            TestScopeLogger LogScope1("no value, Bufferlength == 0");
             TEST_QUIC_SUCCEEDED(
                 MsQuic->SetParam(
-                    Handle,
-                    Param,
-                    0,
-                    nullptr));
+                    nullptr,
+                    QUIC_PARAM_GLOBAL_TIMER_SLACK,
+                    sizeof(Slack),
+                    &Slack));
+        }
+
+        {
+            TestScopeLogger LogScope1("GetParam");
+            SimpleGetParamTest(nullptr, QUIC_PARAM_GLOBAL_TIMER_SLACK, sizeof(Slack), &Slack);
         }
     }
 
     //
-    // Buffer starts from non-zero is not supported
-    // NOTE: This can be removed once this case is supported
+    // QUIC_PARAM_GLOBAL_QLOG_HANDLER
     //
     {
-        TestScopeLogger LogScope0("Buffer starts from non-zero is not supported");
-        uint8_t Cibir[6] = {128};
-        TEST_QUIC_STATUS(
-            QUIC_STATUS_NOT_SUPPORTED,
-            MsQuic->SetParam(
-                Handle,
-                Param,
-                sizeof(Cibir),
-                &Cibir));
+        TestScopeLogger LogScope0("QUIC_PARAM_GLOBAL_QLOG_HANDLER");
+        GlobalSettingScope ParamScope(QUIC_PARAM_GLOBAL_QLOG_HANDLER);
+        uint32_t BytesWritten = 0;
+        QUIC_QLOG_HANDLER Handler = { QlogTestHandler, &BytesWritten };
+        {
+            TestScopeLogger LogScope1("SetParam");
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_INVALID_PARAMETER,
+                MsQuic->SetParam(
+                    nullptr,
+                    QUIC_PARAM_GLOBAL_QLOG_HANDLER,
+                    sizeof(Handler) - 1,
+                    &Handler));
+            TEST_QUIC_SUCCEEDED(
+                MsQuic->SetParam(
+                    nullptr,
+                    QUIC_PARAM_GLOBAL_QLOG_HANDLER,
+                    sizeof(Handler),
+                    &Handler));
+            TEST_NOT_EQUAL(BytesWritten, 0u); // The qlog header.
+        }
+
+        {
+            TestScopeLogger LogScope1("GetParam");
+            SimpleGetParamTest(nullptr, QUIC_PARAM_GLOBAL_QLOG_HANDLER, sizeof(Handler), &Handler);
+        }
     }
 
     //
-    // Good setting
+    // QUIC_PARAM_GLOBAL_PERF_EXPORT
     //
     {
-        uint8_t Cibir[6] = {0};
+        TestScopeLogger LogScope0("QUIC_PARAM_GLOBAL_PERF_EXPORT");
+        GlobalSettingScope ParamScope(QUIC_PARAM_GLOBAL_PERF_EXPORT);
+        const uint32_t ExportLength = (uint32_t)QUIC_PERF_EXPORT_SIZE(1);
+        UniquePtrArray<uint64_t> ExportBuffer(new(std::nothrow) uint64_t[(ExportLength + 7) / 8]);
+        TEST_TRUE(ExportBuffer);
+        QUIC_PERF_EXPORT Export = { ExportBuffer.get(), ExportLength, QUIC_PERF_EXPORT_MIN_INTERVAL_US };
+        {
+            TestScopeLogger LogScope1("SetParam");
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_INVALID_PARAMETER,
+                MsQuic->SetParam(
+                    nullptr,
+                    QUIC_PARAM_GLOBAL_PERF_EXPORT,
+                    sizeof(Export) - 1,
+                    &Export));
+
+            QUIC_PERF_EXPORT InvalidExport = Export;
+            InvalidExport.BufferLength = ExportLength - 1;
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_INVALID_PARAMETER,
+                MsQuic->SetParam(
+                    nullptr,
+                    QUIC_PARAM_GLOBAL_PERF_EXPORT,
+                    sizeof(InvalidExport),
+                    &InvalidExport));
+
+            InvalidExport = Export;
+            InvalidExport.IntervalUs = QUIC_PERF_EXPORT_MIN_INTERVAL_US - 1;
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_INVALID_PARAMETER,
+                MsQuic->SetParam(
+                    nullptr,
+                    QUIC_PARAM_GLOBAL_PERF_EXPORT,
+                    sizeof(InvalidExport),
+                    &InvalidExport));
+
+            TEST_QUIC_SUCCEEDED(
+                MsQuic->SetParam(
+                    nullptr,
+                    QUIC_PARAM_GLOBAL_PERF_EXPORT,
+                    sizeof(Export),
+                    &Export));
+            const QUIC_PERF_EXPORT_HEADER* Header =
+                (const QUIC_PERF_EXPORT_HEADER*)ExportBuffer.get();
+            TEST_EQUAL(QUIC_PERF_EXPORT_VERSION, Header->Version);
+            TEST_EQUAL(1u, Header->ProcessorCount);
+            TEST_EQUAL((uint32_t)QUIC_PERF_COUNTER_MAX, Header->CounterCount);
+            TEST_EQUAL((uint32_t)QUIC_PERF_HISTOGRAM_MAX, Header->HistogramCount);
+        }
+
+        {
+            TestScopeLogger LogScope1("GetParam");
+            SimpleGetParamTest(nullptr, QUIC_PARAM_GLOBAL_PERF_EXPORT, sizeof(Export), &Export);
+        }
+
+        //
+        // Stop the export before the buffer is freed.
+        //
+        QUIC_PERF_EXPORT NoExport = { nullptr, 0, 0 };
         TEST_QUIC_SUCCEEDED(
             MsQuic->SetParam(
-                Handle,
-                Param,
-                sizeof(Cibir),
-                &Cibir));
+                nullptr,
+                QUIC_PARAM_GLOBAL_PERF_EXPORT,
+                sizeof(NoExport),
+                &NoExport));
     }
-}
-
-void QuicTestListenerParam()
-{
-    MsQuicRegistration Registration;
-    TEST_TRUE(Registration.IsValid());
-    MsQuicAlpn Alpn("MsQuicTest");
-    QUIC_ADDR ExpectedAddress;
-    QuicAddrFromString("123.45.67.89", 4433, &ExpectedAddress);
 
     //
-    // QUIC_PARAM_LISTENER_LOCAL_ADDRESS
+    // QUIC_PARAM_GLOBAL_PERF_STAGE_CYCLES
     //
     {
-        TestScopeLogger LogScope0("QUIC_PARAM_LISTENER_LOCAL_ADDRESS");
-        //
-        // SetParam
-        //
+        TestScopeLogger LogScope0("QUIC_PARAM_GLOBAL_PERF_STAGE_CYCLES");
         {
             TestScopeLogger LogScope1("SetParam is not allowed");
-            MsQuicListener Listener(Registration, CleanUpManual, DummyListenerCallback<MsQuicListener*>, nullptr);
-            TEST_TRUE(Listener.IsValid());
-            QUIC_ADDR Dummy = {0};
+            QUIC_PERF_STAGE_CYCLES StageCycles[QUIC_PERF_STAGE_MAX] = {};
             TEST_QUIC_STATUS(
                 QUIC_STATUS_INVALID_PARAMETER,
-                Listener.SetParam(
-                    QUIC_PARAM_LISTENER_LOCAL_ADDRESS,
-                    sizeof(Dummy),
-                    &Dummy));
+                MsQuic->SetParam(
+                    nullptr,
+                    QUIC_PARAM_GLOBAL_PERF_STAGE_CYCLES,
+                    sizeof(StageCycles),
+                    StageCycles));
         }
 
-        //
-        // GetParam
-        //
         {
+            //
+            // Only supported when built with QUIC_ENABLE_STAGE_CYCLES.
+            //
             TestScopeLogger LogScope1("GetParam");
-            MsQuicListener Listener(Registration, CleanUpManual, DummyListenerCallback<MsQuicListener*>, nullptr);
-            TEST_TRUE(Listener.IsValid());
-
-            TEST_QUIC_SUCCEEDED(Listener.Start(Alpn, &ExpectedAddress));
-
             uint32_t Length = 0;
-            TEST_QUIC_STATUS(
-                QUIC_STATUS_BUFFER_TOO_SMALL,
-                Listener.GetParam(
-                    QUIC_PARAM_LISTENER_LOCAL_ADDRESS,
-                    &Length,
-                    nullptr));
-            TEST_EQUAL(Length, sizeof(QUIC_ADDR))
-
-            QUIC_ADDR Address = {0};
-            TEST_QUIC_SUCCEEDED(
-                Listener.GetParam(
-                    QUIC_PARAM_LISTENER_LOCAL_ADDRESS,
+            QUIC_STATUS Status =
+                MsQuic->GetParam(
+                    nullptr,
+                    QUIC_PARAM_GLOBAL_PERF_STAGE_CYCLES,
                     &Length,
-                    &Address));
-            TEST_EQUAL(memcmp((void*)&Address, (void*)&ExpectedAddress, sizeof(QUIC_ADDR)), 0);
+                    nullptr);
+            if (Status != QUIC_STATUS_NOT_SUPPORTED) {
+                TEST_QUIC_STATUS(QUIC_STATUS_BUFFER_TOO_SMALL, Status);
+                TEST_EQUAL(Length, sizeof(QUIC_PERF_STAGE_CYCLES) * QUIC_PERF_STAGE_MAX);
+                QUIC_PERF_STAGE_CYCLES StageCycles[QUIC_PERF_STAGE_MAX];
+                TEST_QUIC_SUCCEEDED(
+                    MsQuic->GetParam(
+                        nullptr,
+                        QUIC_PARAM_GLOBAL_PERF_STAGE_CYCLES,
+                        &Length,
+                        StageCycles));
+            }
         }
     }
 
     //
-    // QUIC_PARAM_LISTENER_STATS
+    // QUIC_PARAM_GLOBAL_PACKET_CAPTURE
     //
     {
-        TestScopeLogger LogScope0("QUIC_PARAM_LISTENER_STATS");
-        //
-        // SetParam
-        //
+        TestScopeLogger LogScope0("QUIC_PARAM_GLOBAL_PACKET_CAPTURE");
+        GlobalSettingScope ParamScope(QUIC_PARAM_GLOBAL_PACKET_CAPTURE);
+        uint32_t BytesWritten = 0;
+        QUIC_PACKET_CAPTURE_CONFIG Config = { PacketCaptureTestHandler, &BytesWritten, 100 };
         {
-            TestScopeLogger LogScope1("SetParam is not allowed");
-            MsQuicListener Listener(Registration, CleanUpManual, DummyListenerCallback<MsQuicListener*>, nullptr);
-            TEST_TRUE(Listener.IsValid());
-            QUIC_LISTENER_STATISTICS Dummy = {0};
+            TestScopeLogger LogScope1("SetParam");
             TEST_QUIC_STATUS(
                 QUIC_STATUS_INVALID_PARAMETER,
-                Listener.SetParam(
-                    QUIC_PARAM_LISTENER_STATS,
-                    sizeof(Dummy),
-                    &Dummy));
+                MsQuic->SetParam(
+                    nullptr,
+                    QUIC_PARAM_GLOBAL_PACKET_CAPTURE,
+                    sizeof(Config) - 1,
+                    &Config));
+            TEST_QUIC_SUCCEEDED(
+                MsQuic->SetParam(
+                    nullptr,
+                    QUIC_PARAM_GLOBAL_PACKET_CAPTURE,
+                    sizeof(Config),
+                    &Config));
+            TEST_NOT_EQUAL(BytesWritten, 0u); // The pcapng headers.
         }
 
-        //
-        // GetParam
-        //
         {
             TestScopeLogger LogScope1("GetParam");
-            MsQuicListener Listener(Registration, CleanUpManual, DummyListenerCallback<MsQuicListener*>, nullptr);
-            TEST_TRUE(Listener.IsValid());
-
-            uint32_t Length = 0;
-            TEST_QUIC_STATUS(
-                QUIC_STATUS_BUFFER_TOO_SMALL,
-                Listener.GetParam(
-                    QUIC_PARAM_LISTENER_STATS,
-                    &Length,
-                    nullptr));
-            TEST_EQUAL(Length, sizeof(QUIC_LISTENER_STATISTICS))
-
-            QUIC_LISTENER_STATISTICS Stats = {65535, 65535, 65535};
-            TEST_QUIC_SUCCEEDED(
-                Listener.GetParam(
-                    QUIC_PARAM_LISTENER_STATS,
-                    &Length,
-                    &Stats));
-            TEST_EQUAL(Stats.TotalAcceptedConnections, 0);
-            TEST_EQUAL(Stats.TotalRejectedConnections, 0);
-            TEST_EQUAL(Stats.BindingRecvDroppedPackets, 0);
-            // TODO: Stateful test after accept/rejecting connection
+            SimpleGetParamTest(nullptr, QUIC_PARAM_GLOBAL_PACKET_CAPTURE, sizeof(Config), &Config);
         }
     }
 
-#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+#if DEBUG
     //
-    // QUIC_PARAM_LISTENER_CIBIR_ID
+    // QUIC_PARAM_GLOBAL_PLATFORM_WORKER_POOL
     //
     {
-        TestScopeLogger LogScope0("QUIC_PARAM_LISTENER_CIBIR_ID");
-        //
-        // SetParam
-        //
+        TestScopeLogger LogScope0("QUIC_PARAM_GLOBAL_PLATFORM_WORKER_POOL");
         {
             TestScopeLogger LogScope1("SetParam");
-            MsQuicListener Listener(Registration, CleanUpManual, DummyListenerCallback<MsQuicListener*> , nullptr);
-            TEST_TRUE(Listener.IsValid());
-            CibirIDTests(Listener.Handle, QUIC_PARAM_LISTENER_CIBIR_ID);
+            //
+            // Invalid features
+            //
+            {
+                TestScopeLogger LogScope2("SetParam is not allowed");
+                TEST_QUIC_STATUS(
+                    QUIC_STATUS_INVALID_PARAMETER,
+                    MsQuic->SetParam(
+                        nullptr,
+                        QUIC_PARAM_GLOBAL_PLATFORM_WORKER_POOL,
+                        0,
+                        nullptr));
+            }
         }
 
-        //
-        // GetParam
-        //
         {
-            TestScopeLogger LogScope1("GetParam");
-            MsQuicListener Listener(Registration, CleanUpManual, DummyListenerCallback<MsQuicListener*>, nullptr);
-            TEST_TRUE(Listener.IsValid());
-            uint32_t Length = 65535;
-            TEST_QUIC_SUCCEEDED(
-                Listener.GetParam(
-                    QUIC_PARAM_LISTENER_CIBIR_ID,
+            TestScopeLogger LogScope2("GetParam. Failed by missing MsQuicLib.WorkerPool");
+            uint32_t Length = 0;
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_BUFFER_TOO_SMALL,
+                MsQuic->GetParam(
+                    nullptr,
+                    QUIC_PARAM_GLOBAL_PLATFORM_WORKER_POOL,
                     &Length,
                     nullptr));
-            TEST_EQUAL(Length, 0);
-            // TODO: Stateful test once Listener->CibrId is filled
+            TEST_EQUAL(Length, sizeof(CXPLAT_WORKER_POOL*));
+
+            CXPLAT_WORKER_POOL* WorkerPool = 0;
+            TEST_QUIC_SUCCEEDED(
+                MsQuic->GetParam(
+                    nullptr,
+                    QUIC_PARAM_GLOBAL_PLATFORM_WORKER_POOL,
+                    &Length,
+                    &WorkerPool));
         }
     }
 #endif
+
+    //
+    // Invalid parameter
+    //
+    {
+        TestScopeLogger LogScope("Invalid parameter for Global SetParam");
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_PARAMETER,
+            MsQuic->SetParam(
+                nullptr,
+                QUIC_PARAM_PREFIX_GLOBAL | 0x00234567,
+                0,
+                nullptr));
+    }
+
+    QuicTestStatefulGlobalSetParam();
 }
 
-void QuicTest_QUIC_PARAM_CONN_QUIC_VERSION(MsQuicRegistration& Registration, MsQuicConfiguration& ClientConfiguration)
+void QuicTestCommonParam()
 {
-    TestScopeLogger LogScope0("QUIC_PARAM_CONN_QUIC_VERSION");
-    MsQuicConnection Connection(Registration);
-    TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
     //
-    // SetParam
+    // Null hundle
+    //
+    {
+        TestScopeLogger LogScope("Null handle with non-global param");
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_PARAMETER,
+            MsQuic->SetParam(
+                nullptr,
+                0, // Any param other than GLOBAL
+                0,
+                nullptr));
+
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_PARAMETER,
+            MsQuic->GetParam(
+                nullptr,
+                0,
+                nullptr,
+                nullptr));
+    }
+
+    MsQuicRegistration Registration;
+    TEST_TRUE(Registration.IsValid());
+
+    //
+    // Global param with handle
+    //
+    {
+        TestScopeLogger LogScope("Global param with handle");
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_PARAMETER,
+            MsQuic->SetParam(
+                Registration.Handle,
+                QUIC_PARAM_PREFIX_GLOBAL,
+                0,
+                nullptr));
+
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_PARAMETER,
+            MsQuic->GetParam(
+                Registration.Handle,
+                QUIC_PARAM_PREFIX_GLOBAL,
+                nullptr,
+                nullptr));
+    }
+
+    //
+    // Invalid handle type
+    //
+    {
+        TestScopeLogger LogScope("Invalid handle type");
+        MsQuicConnection Connection(Registration);
+        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+        auto OriginalType = ((uint8_t*)Connection.Handle)[0];
+        ((uint8_t*)Connection.Handle)[0] = 128; // Invalid
+
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_PARAMETER,
+            MsQuic->SetParam(
+                Connection.Handle,
+                0,
+                0,
+                nullptr));
+
+        uint32_t DummyLength = 0;
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_PARAMETER,
+            MsQuic->GetParam(
+                Connection.Handle,
+                0,
+                &DummyLength,
+                nullptr));
+
+        ((uint8_t*)Connection.Handle)[0] = OriginalType;
+    }
+}
+
+void QuicTestRegistrationParam()
+{
+    MsQuicRegistration Registration;
+    TEST_TRUE(Registration.IsValid());
+    //
+    // Get-only parameter
     //
     {
-        TestScopeLogger LogScope1("SetParam is not allowed");
         uint32_t Dummy = 0;
         TEST_QUIC_STATUS(
             QUIC_STATUS_INVALID_PARAMETER,
-            Connection.SetParam(
-                QUIC_PARAM_CONN_QUIC_VERSION,
+            MsQuic->SetParam(
+                Registration.Handle,
+                QUIC_PARAM_PREFIX_REGISTRATION,
                 sizeof(Dummy),
                 &Dummy));
     }
 
-    //
-    // GetParam
-    //
     {
-        TestScopeLogger LogScope1("GetParam");
-        uint32_t Length = 0;
+        uint32_t Length = 65535;
+        uint32_t Buffer = 65535;
         TEST_QUIC_STATUS(
-            QUIC_STATUS_BUFFER_TOO_SMALL,
-            Connection.GetParam(
-                QUIC_PARAM_CONN_QUIC_VERSION,
+            QUIC_STATUS_INVALID_PARAMETER,
+            MsQuic->GetParam(
+                Registration.Handle,
+                QUIC_PARAM_PREFIX_REGISTRATION | 0xFFFF,
                 &Length,
-                nullptr));
-        TEST_EQUAL(Length, sizeof(uint32_t));
+                &Buffer));
+        TEST_EQUAL(Length, 65535);
+        TEST_EQUAL(Buffer, 65535);
+    }
 
-        uint32_t Version = 65535;
+    //
+    // QUIC_PARAM_REGISTRATION_SEND_BUFFER_USAGE
+    //
+    {
+        TestScopeLogger LogScope0("QUIC_PARAM_REGISTRATION_SEND_BUFFER_USAGE");
         {
-            TestScopeLogger LogScope2("Version == 0 before start");
-            TEST_QUIC_SUCCEEDED(
-                Connection.GetParam(
-                    QUIC_PARAM_CONN_QUIC_VERSION,
-                    &Length,
-                    &Version));
-            TEST_EQUAL(Version, 0);
+            TestScopeLogger LogScope1("SetParam is not allowed");
+            uint64_t Usage = 0;
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_INVALID_PARAMETER,
+                MsQuic->SetParam(
+                    Registration.Handle,
+                    QUIC_PARAM_REGISTRATION_SEND_BUFFER_USAGE,
+                    sizeof(Usage),
+                    &Usage));
         }
 
         {
-            TestScopeLogger LogScope2("Version == 1 after start");
-            TEST_QUIC_SUCCEEDED(
-                MsQuic->ConnectionStart(
-                    Connection.Handle,
-                    ClientConfiguration,
-                    QUIC_ADDRESS_FAMILY_INET,
-                    "localhost",
-                    4433));
-            TEST_QUIC_SUCCEEDED(
-                Connection.GetParam(
-                    QUIC_PARAM_CONN_QUIC_VERSION,
-                    &Length,
-                    &Version));
-            TEST_EQUAL(Version, 1);
+            TestScopeLogger LogScope1("GetParam");
+            uint64_t Usage = 0;
+            SimpleGetParamTest(Registration.Handle, QUIC_PARAM_REGISTRATION_SEND_BUFFER_USAGE, sizeof(Usage), &Usage);
         }
     }
-}
 
-void QuicTest_QUIC_PARAM_CONN_LOCAL_ADDRESS(MsQuicRegistration& Registration, MsQuicConfiguration& ClientConfiguration)
-{
-    TestScopeLogger LogScope0("QUIC_PARAM_CONN_LOCAL_ADDRESS");
     //
-    // SetParam
+    // QUIC_PARAM_REGISTRATION_MEMORY_USAGE
     //
     {
-        TestScopeLogger LogScope1("SetParam");
-        //
-        // Connection ClosedLocally
-        //
+        TestScopeLogger LogScope0("QUIC_PARAM_REGISTRATION_MEMORY_USAGE");
         {
-            TestScopeLogger LogScope2("Connection is closed locally");
-            TEST_TRUE(ClientConfiguration.IsValid());
-            MsQuicConnection Connection(Registration);
-            TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
-            SimulateConnBadStartState(Connection, ClientConfiguration);
-
-            QUIC_ADDR Dummy = {};
+            TestScopeLogger LogScope1("SetParam is not allowed");
+            QUIC_MEMORY_USAGE Usage = {};
             TEST_QUIC_STATUS(
-                QUIC_STATUS_INVALID_STATE,
-                Connection.SetParam(
-                    QUIC_PARAM_CONN_LOCAL_ADDRESS,
-                    sizeof(Dummy),
-                    &Dummy));
+                QUIC_STATUS_INVALID_PARAMETER,
+                MsQuic->SetParam(
+                    Registration.Handle,
+                    QUIC_PARAM_REGISTRATION_MEMORY_USAGE,
+                    sizeof(Usage),
+                    &Usage));
         }
 
-        //
-        // Connection is started, but not handshake confirmed
-        //
         {
-            TestScopeLogger LogScope2("Connection is started, but not handshake confirmed");
+            TestScopeLogger LogScope1("GetParam");
+            QUIC_MEMORY_USAGE Usage = {};
+            SimpleGetParamTest(Registration.Handle, QUIC_PARAM_REGISTRATION_MEMORY_USAGE, sizeof(Usage), &Usage);
+
+            //
+            // Each open connection is included in the aggregate.
+            //
             MsQuicConnection Connection(Registration);
             TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+            uint32_t Length = sizeof(Usage);
             TEST_QUIC_SUCCEEDED(
-                MsQuic->ConnectionStart(
-                    Connection.Handle,
-                    ClientConfiguration,
-                    QUIC_ADDRESS_FAMILY_INET,
-                    "localhost",
-                    4433));
+                MsQuic->GetParam(
+                    Registration.Handle,
+                    QUIC_PARAM_REGISTRATION_MEMORY_USAGE,
+                    &Length,
+                    &Usage));
+            TEST_NOT_EQUAL(0u, Usage.ConnectionBytes);
+        }
+    }
 
-            QUIC_ADDR Dummy = {};
-            TEST_QUIC_STATUS(
-                QUIC_STATUS_INVALID_STATE,
-                Connection.SetParam(
-                    QUIC_PARAM_CONN_LOCAL_ADDRESS,
-                    sizeof(Dummy),
-                    &Dummy));
+    //
+    // QUIC_PARAM_REGISTRATION_EVENT_QUEUE_ENABLED
+    //
+    {
+        TestScopeLogger LogScope0("QUIC_PARAM_REGISTRATION_EVENT_QUEUE_ENABLED");
+        {
+            TestScopeLogger LogScope1("GetParam");
+            BOOLEAN Enabled = TRUE;
+            SimpleGetParamTest(Registration.Handle, QUIC_PARAM_REGISTRATION_EVENT_QUEUE_ENABLED, sizeof(Enabled), &Enabled);
+            TEST_FALSE(Enabled);
         }
 
-        //
-        // Good before ConnectioStart
-        //
         {
-            TestScopeLogger LogScope2("Good before ConnectionStart");
+            TestScopeLogger LogScope1("SetParam with invalid length");
+            uint32_t Enabled = TRUE;
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_INVALID_PARAMETER,
+                MsQuic->SetParam(
+                    Registration.Handle,
+                    QUIC_PARAM_REGISTRATION_EVENT_QUEUE_ENABLED,
+                    sizeof(Enabled),
+                    &Enabled));
+        }
+
+        {
+            TestScopeLogger LogScope1("SetParam after opening a connection");
             MsQuicConnection Connection(Registration);
             TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
-            QUIC_ADDR Dummy = {};
+            BOOLEAN Enabled = TRUE;
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_INVALID_STATE,
+                MsQuic->SetParam(
+                    Registration.Handle,
+                    QUIC_PARAM_REGISTRATION_EVENT_QUEUE_ENABLED,
+                    sizeof(Enabled),
+                    &Enabled));
+        }
+
+        {
+            TestScopeLogger LogScope1("Nothing to poll when disabled");
+            QUIC_QUEUED_EVENT Event;
+            TEST_EQUAL(0u, MsQuic->RegistrationPollEvents(Registration.Handle, &Event, 1, 0));
+        }
+
+        {
+            TestScopeLogger LogScope1("SetParam");
+            BOOLEAN Enabled = TRUE;
             TEST_QUIC_SUCCEEDED(
-                Connection.SetParam(
-                    QUIC_PARAM_CONN_LOCAL_ADDRESS,
-                    sizeof(Dummy),
-                    &Dummy));
+                MsQuic->SetParam(
+                    Registration.Handle,
+                    QUIC_PARAM_REGISTRATION_EVENT_QUEUE_ENABLED,
+                    sizeof(Enabled),
+                    &Enabled));
+            uint32_t Length = sizeof(Enabled);
+            Enabled = FALSE;
+            TEST_QUIC_SUCCEEDED(
+                MsQuic->GetParam(
+                    Registration.Handle,
+                    QUIC_PARAM_REGISTRATION_EVENT_QUEUE_ENABLED,
+                    &Length,
+                    &Enabled));
+            TEST_TRUE(Enabled);
+
+            QUIC_QUEUED_EVENT Event;
+            TEST_EQUAL(0u, MsQuic->RegistrationPollEvents(Registration.Handle, &Event, 1, 0));
         }
 
-        {// TODO: good after start, need to set Connection->State.HandshakeConfirmed
+        {
+            TestScopeLogger LogScope1("Can't be disabled once enabled");
+            BOOLEAN Enabled = FALSE;
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_INVALID_STATE,
+                MsQuic->SetParam(
+                    Registration.Handle,
+                    QUIC_PARAM_REGISTRATION_EVENT_QUEUE_ENABLED,
+                    sizeof(Enabled),
+                    &Enabled));
         }
     }
 
     //
-    // GetParam
+    // QUIC_PARAM_REGISTRATION_QOS
     //
     {
-        TestScopeLogger LogScope1("GetParam");
+        TestScopeLogger LogScope0("QUIC_PARAM_REGISTRATION_QOS");
         {
-            MsQuicConnection Connection(Registration);
-            TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
-            uint32_t Length = 0;
-            TEST_QUIC_STATUS(
-                QUIC_STATUS_BUFFER_TOO_SMALL,
-                Connection.GetParam(
-                    QUIC_PARAM_CONN_LOCAL_ADDRESS,
-                    &Length,
-                    nullptr));
-            TEST_EQUAL(Length, sizeof(QUIC_ADDR));
+            TestScopeLogger LogScope1("GetParam");
+            QUIC_REGISTRATION_QOS Qos = { 0, 1 };
+            SimpleGetParamTest(Registration.Handle, QUIC_PARAM_REGISTRATION_QOS, sizeof(Qos), &Qos);
+            TEST_EQUAL(1u, Qos.SchedulingWeight);
+            TEST_EQUAL(0ull, Qos.MaxEgressRate);
+        }
 
-            QUIC_ADDR Addr = {};
-            //
-            // !Connection->Stae.LocalAddressSet
-            //
-            {
-                TestScopeLogger LogScope2("!Connection->Stae.LocalAddressSet");
-                TEST_QUIC_STATUS(
-                    QUIC_STATUS_INVALID_STATE,
-                    Connection.GetParam(
-                        QUIC_PARAM_CONN_LOCAL_ADDRESS,
-                        &Length,
-                        &Addr));
-            }
+        {
+            TestScopeLogger LogScope1("SetParam with invalid weight");
+            QUIC_REGISTRATION_QOS Qos = { 0, 0 };
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_INVALID_PARAMETER,
+                MsQuic->SetParam(
+                    Registration.Handle,
+                    QUIC_PARAM_REGISTRATION_QOS,
+                    sizeof(Qos),
+                    &Qos));
+            Qos.SchedulingWeight = QUIC_REGISTRATION_QOS_MAX_WEIGHT + 1;
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_INVALID_PARAMETER,
+                MsQuic->SetParam(
+                    Registration.Handle,
+                    QUIC_PARAM_REGISTRATION_QOS,
+                    sizeof(Qos),
+                    &Qos));
+        }
 
-            //
-            // Good
-            //
-            {
-                TEST_QUIC_SUCCEEDED(
-                    MsQuic->ConnectionStart(
-                        Connection.Handle,
-                        ClientConfiguration,
-                        QUIC_ADDRESS_FAMILY_INET,
-                        "127.0.0.1",
-                        4433));
-                TEST_QUIC_SUCCEEDED(
-                    Connection.GetParam(
-                        QUIC_PARAM_CONN_LOCAL_ADDRESS,
-                        &Length,
-                        &Addr));
-                QUIC_ADDR Expected = {0};
-                QuicAddrFromString("127.0.0.1", 4433, &Expected);
-                TEST_EQUAL(memcmp((void*)&Addr.Ipv4.sin_addr, (void*)&Expected.Ipv4.sin_addr, sizeof(struct in_addr)), 0);
-                TEST_NOT_EQUAL(Addr.Ipv4.sin_port, Expected.Ipv4.sin_port);
-            }
+        {
+            TestScopeLogger LogScope1("SetParam");
+            QUIC_REGISTRATION_QOS Qos = { 8, 1000000 };
+            TEST_QUIC_SUCCEEDED(
+                MsQuic->SetParam(
+                    Registration.Handle,
+                    QUIC_PARAM_REGISTRATION_QOS,
+                    sizeof(Qos),
+                    &Qos));
+            uint32_t Length = sizeof(Qos);
+            CxPlatZeroMemory(&Qos, sizeof(Qos));
+            TEST_QUIC_SUCCEEDED(
+                MsQuic->GetParam(
+                    Registration.Handle,
+                    QUIC_PARAM_REGISTRATION_QOS,
+                    &Length,
+                    &Qos));
+            TEST_EQUAL(8u, Qos.SchedulingWeight);
+            TEST_EQUAL(1000000ull, Qos.MaxEgressRate);
         }
     }
 }
 
-void QuicTest_QUIC_PARAM_CONN_REMOTE_ADDRESS(MsQuicRegistration& Registration, MsQuicConfiguration& ClientConfiguration)
+#define SETTINGS_SIZE_THRU_FIELD(SettingsType, Field) \
+    (FIELD_OFFSET(SettingsType, Field) + sizeof(((SettingsType*)0)->Field))
+
+void QuicTestConfigurationParam()
 {
-    TestScopeLogger LogScope0("QUIC_PARAM_CONN_REMOTE_ADDRESS");
+    MsQuicRegistration Registration;
+    TEST_TRUE(Registration.IsValid());
+    MsQuicAlpn Alpn("MsQuicTest");
+
+    //
+    // QUIC_PARAM_CONFIGURATION_SETTINGS
+    //
     {
-        TestScopeLogger LogScope1("SetParam");
+        TestScopeLogger LogScope0("QUIC_PARAM_CONFIGURATION_SETTINGS");
         {
+            TestScopeLogger LogScope1("SetParam");
             //
-            // QUIC_STATUS_INVALID_STATE (connection failed to started)
-            //
-            {
-                TestScopeLogger LogScope2("QUIC_CONN_BAD_START_STATE");
-                MsQuicConnection Connection(Registration);
-                TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
-                SimulateConnBadStartState(Connection, ClientConfiguration);
-
-                QUIC_ADDR Dummy = {};
-                TEST_TRUE(QuicAddrFromString("127.0.0.1", 0, &Dummy));
-                TEST_QUIC_STATUS(
-                    QUIC_STATUS_INVALID_STATE,
-                    Connection.SetParam(
-                        QUIC_PARAM_CONN_REMOTE_ADDRESS,
-                        sizeof(Dummy),
-                        &Dummy));
-            }
-
-            //
-            // QUIC_STATUS_INVALID_PARAMETER (0.0.0.0)
-            //
-            {
-                MsQuicConnection Connection(Registration);
-                TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
-                const QUIC_ADDR ZeroAddr = {0};
-                TEST_QUIC_STATUS(
-                    QUIC_STATUS_INVALID_PARAMETER,
-                    Connection.SetParam(
-                        QUIC_PARAM_CONN_REMOTE_ADDRESS,
-                        sizeof(ZeroAddr),
-                        &ZeroAddr));
-            }
-
-            //
-            // QUIC_STATUS_INVALID_PARAMETER (too small)
+            // QuicSettingsSettingsToInternal fail
             //
             {
-                MsQuicConnection Connection(Registration);
-                TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
-                QUIC_ADDR Dummy = {};
-                TEST_TRUE(QuicAddrFromString("127.0.0.1", 0, &Dummy));
+                TestScopeLogger LogScope2("QuicSettingsSettingsToInternal fail");
+                MsQuicConfiguration Configuration(Registration, Alpn);
+                QUIC_SETTINGS Settings{0};
                 TEST_QUIC_STATUS(
                     QUIC_STATUS_INVALID_PARAMETER,
-                    Connection.SetParam(
-                        QUIC_PARAM_CONN_REMOTE_ADDRESS,
-                        sizeof(Dummy)-1,
-                        &Dummy));
+                    MsQuic->SetParam(
+                        nullptr,
+                        QUIC_PARAM_CONFIGURATION_SETTINGS,
+                        sizeof(QUIC_SETTINGS)-8,
+                        &Settings));
             }
 
             //
-            // Good
+            // QuicSettingApply fail
             //
             {
-                MsQuicConnection Connection(Registration);
-                TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
-                QUIC_ADDR Dummy = {};
-                TEST_TRUE(QuicAddrFromString("127.0.0.1", 0, &Dummy));
-                TEST_QUIC_SUCCEEDED(
-                    Connection.SetParam(
-                        QUIC_PARAM_CONN_REMOTE_ADDRESS,
-                        sizeof(Dummy),
-                        &Dummy));
+                TestScopeLogger LogScope2("QuicSettingApply fail");
+                MsQuicConfiguration Configuration(Registration, Alpn);
+                SettingApplyTests(Configuration.Handle, QUIC_PARAM_CONFIGURATION_SETTINGS);
             }
         }
-    }
 
-    //
-    // GetParam
-    //
-    {
-        TestScopeLogger LogScope1("GetParam");
+        //
+        // GetParam
+        //
         {
-            MsQuicConnection Connection(Registration);
-            TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+            TestScopeLogger LogScope1("GetParam");
+            MsQuicConfiguration Configuration(Registration, Alpn);
             uint32_t Length = 0;
             TEST_QUIC_STATUS(
                 QUIC_STATUS_BUFFER_TOO_SMALL,
-                Connection.GetParam(
-                    QUIC_PARAM_CONN_REMOTE_ADDRESS,
+                MsQuic->GetParam(
+                    Configuration.Handle,
+                    QUIC_PARAM_CONFIGURATION_SETTINGS,
                     &Length,
                     nullptr));
-            TEST_EQUAL(Length, sizeof(QUIC_ADDR));
+            TEST_TRUE(Length >= sizeof(QUIC_SETTINGS));
+
+            Length = 1;
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_BUFFER_TOO_SMALL,
+                MsQuic->GetParam(
+                    Configuration.Handle,
+                    QUIC_PARAM_CONFIGURATION_SETTINGS,
+                    &Length,
+                    nullptr));
+            TEST_EQUAL(Length, SETTINGS_SIZE_THRU_FIELD(QUIC_SETTINGS, MtuDiscoveryMissingProbeCount));
+
+            QUIC_SETTINGS Settings{0};
+            TEST_QUIC_SUCCEEDED(
+                MsQuic->GetParam(
+                    Configuration.Handle,
+                    QUIC_PARAM_CONFIGURATION_SETTINGS,
+                    &Length,
+                    &Settings));
+            // TODO: how to compare with default?
+            //       QuicSettingsSetDefault is not accessible from test
+        }
+    }
 
+    //
+    // QUIC_PARAM_CONFIGURATION_TICKET_KEYS
+    //
+    {
+        TestScopeLogger LogScope0("QUIC_PARAM_CONFIGURATION_TICKET_KEYS");
+        {
+            TestScopeLogger LogScope1("SetParam");
             //
-            // !Connection->State.RemoteAddressSet
+            // Set before MsQuic->ConfigurationLoadCredential which is Configuration->SecurityConfig == NULL
             //
-            QUIC_ADDR Addr = {};
             {
-                TestScopeLogger LogScope2("!Connection->State.RemoteAddressSet");
+                TestScopeLogger LogScope2("Set before MsQuic->ConfigurationLoadCredential which is Configuration->SecurityConfig == NULL");
+                MsQuicConfiguration Configuration(Registration, Alpn);
+                QUIC_TICKET_KEY_CONFIG Config{0};
                 TEST_QUIC_STATUS(
                     QUIC_STATUS_INVALID_STATE,
-                    Connection.GetParam(
-                        QUIC_PARAM_CONN_REMOTE_ADDRESS,
-                        &Length,
-                        &Addr));
+                    MsQuic->SetParam(
+                        Configuration,
+                        QUIC_PARAM_CONFIGURATION_TICKET_KEYS,
+                        sizeof(Config),
+                        &Config));
             }
 
             //
-            // Good
+            // SetParam for client is not supported
             //
             {
-                TEST_QUIC_SUCCEEDED(
-                    MsQuic->ConnectionStart(
-                        Connection.Handle,
-                        ClientConfiguration,
-                        QUIC_ADDRESS_FAMILY_INET,
-                        "127.0.0.1",
-                        4433));
-                TEST_QUIC_SUCCEEDED(
-                    Connection.GetParam(
-                        QUIC_PARAM_CONN_REMOTE_ADDRESS,
-                        &Length,
-                        &Addr));
-                QUIC_ADDR Expected = {0};
-                QuicAddrFromString("127.0.0.1", 4433, &Expected);
-                TEST_EQUAL(memcmp((void*)&Addr, (void*)&Expected, sizeof(QUIC_ADDR)), 0);
+                TestScopeLogger LogScope2("SetParam for client is not supported");
+                MsQuicConfiguration Configuration(Registration, Alpn);
+                QUIC_CREDENTIAL_CONFIG CredConfig = {};
+                CredConfig.Flags = QUIC_CREDENTIAL_FLAG_CLIENT;
+                Configuration.LoadCredential(&CredConfig);
+                QUIC_TICKET_KEY_CONFIG Config = {};
+                TEST_QUIC_STATUS(
+                    QUIC_STATUS_NOT_SUPPORTED,
+                    MsQuic->SetParam(
+                        Configuration,
+                        QUIC_PARAM_CONFIGURATION_TICKET_KEYS,
+                        sizeof(Config),
+                        &Config));
+            }
+
+            //
+            // Good with self-signed key
+            //
+            {
+                TestScopeLogger LogScope2("Good tests are covered by QuicTestValidateConfiguration");
             }
         }
+
+        //
+        // GetParam
+        //
+        {
+            TestScopeLogger LogScope1("GetParam is not allowed");
+            MsQuicConfiguration Configuration(Registration, Alpn);
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_INVALID_PARAMETER,
+                MsQuic->GetParam(
+                    Configuration,
+                    QUIC_PARAM_CONFIGURATION_TICKET_KEYS,
+                    nullptr,
+                    nullptr));
+        }
+    }
+
+    //
+    // QUIC_PARAM_CONFIGURATION_VERSION_SETTINGS
+    //
+    {
+        TestScopeLogger LogScope("QUIC_PARAM_CONFIGURATION_VERSION_SETTINGS is covered by QuicTestVersionSettings");
+    }
+
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+    //
+    // QUIC_PARAM_CONFIGURATION_VERSION_NEG_ENABLED
+    //
+    {
+
+        TestScopeLogger LogScope0("QUIC_PARAM_CONFIGURATION_VERSION_NEG_ENABLED");
+        MsQuicConfiguration Configuration(Registration, Alpn);
+        BOOLEAN ExpectedFlag = TRUE;
+        //
+        // SetParam
+        //
+        {
+            TEST_QUIC_SUCCEEDED(
+                MsQuic->SetParam(
+                    Configuration,
+                    QUIC_PARAM_CONFIGURATION_VERSION_NEG_ENABLED,
+                    sizeof(ExpectedFlag),
+                    &ExpectedFlag));
+        }
+
+        //
+        // GetParam
+        //
+        {
+            uint32_t Length = 0;
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_BUFFER_TOO_SMALL,
+                MsQuic->GetParam(
+                    Configuration,
+                    QUIC_PARAM_CONFIGURATION_VERSION_NEG_ENABLED,
+                    &Length,
+                    nullptr));
+            TEST_EQUAL(Length, sizeof(BOOLEAN));
+
+            BOOLEAN Flag = FALSE;
+            TEST_QUIC_SUCCEEDED(
+                MsQuic->GetParam(
+                    Configuration,
+                    QUIC_PARAM_CONFIGURATION_VERSION_NEG_ENABLED,
+                    &Length,
+                    &Flag));
+            TEST_EQUAL(Flag, ExpectedFlag);
+        }
+    }
+#endif
+}
+
+// Used by Listener and Connection
+void CibirIDTests(HQUIC Handle, uint32_t Param) {
+    //
+    // buffer length test
+    //
+    {
+        TestScopeLogger LogScope0("Buffer length test");
+        //
+        // Buffer is bigger than QUIC_MAX_CIBIR_LENGTH + 1
+        //
+        {
+            TestScopeLogger LogScope1("Buffer is bigger than QUIC_MAX_CIBIR_LENGTH + 1");
+            uint8_t Cibir[128] = {0};
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_INVALID_PARAMETER,
+                MsQuic->SetParam(
+                    Handle,
+                    Param,
+                    sizeof(Cibir),
+                    &Cibir));
+        }
+
+        //
+        // BufferLength == 1
+        //
+        {
+            TestScopeLogger LogScope1("BufferLength == 1");
+            uint8_t Cibir[1] = {0};
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_INVALID_PARAMETER,
+                MsQuic->SetParam(
+                    Handle,
+                    Param,
+                    sizeof(Cibir),
+                    &Cibir));
+        }
+
+        //
+        // Good without value, length 0
+        //
+        {
+            TestScopeLogger LogScope1("no value, Bufferlength == 0");
+            TEST_QUIC_SUCCEEDED(
+                MsQuic->SetParam(
+                    Handle,
+                    Param,
+                    0,
+                    nullptr));
+        }
+    }
+
+    //
+    // Buffer starts from non-zero is not supported
+    // NOTE: This can be removed once this case is supported
+    //
+    {
+        TestScopeLogger LogScope0("Buffer starts from non-zero is not supported");
+        uint8_t Cibir[6] = {128};
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_NOT_SUPPORTED,
+            MsQuic->SetParam(
+                Handle,
+                Param,
+                sizeof(Cibir),
+                &Cibir));
+    }
+
+    //
+    // Good setting
+    //
+    {
+        uint8_t Cibir[6] = {0};
+        TEST_QUIC_SUCCEEDED(
+            MsQuic->SetParam(
+                Handle,
+                Param,
+                sizeof(Cibir),
+                &Cibir));
+    }
+}
+
+void QuicTestListenerParam()
+{
+    MsQuicRegistration Registration;
+    TEST_TRUE(Registration.IsValid());
+    MsQuicAlpn Alpn("MsQuicTest");
+    QUIC_ADDR ExpectedAddress;
+    QuicAddrFromString("123.45.67.89", 4433, &ExpectedAddress);
+
+    //
+    // QUIC_PARAM_LISTENER_LOCAL_ADDRESS
+    //
+    {
+        TestScopeLogger LogScope0("QUIC_PARAM_LISTENER_LOCAL_ADDRESS");
+        //
+        // SetParam
+        //
+        {
+            TestScopeLogger LogScope1("SetParam is not allowed");
+            MsQuicListener Listener(Registration, CleanUpManual, DummyListenerCallback<MsQuicListener*>, nullptr);
+            TEST_TRUE(Listener.IsValid());
+            QUIC_ADDR Dummy = {0};
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_INVALID_PARAMETER,
+                Listener.SetParam(
+                    QUIC_PARAM_LISTENER_LOCAL_ADDRESS,
+                    sizeof(Dummy),
+                    &Dummy));
+        }
+
+        //
+        // GetParam
+        //
+        {
+            TestScopeLogger LogScope1("GetParam");
+            MsQuicListener Listener(Registration, CleanUpManual, DummyListenerCallback<MsQuicListener*>, nullptr);
+            TEST_TRUE(Listener.IsValid());
+
+            TEST_QUIC_SUCCEEDED(Listener.Start(Alpn, &ExpectedAddress));
+
+            uint32_t Length = 0;
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_BUFFER_TOO_SMALL,
+                Listener.GetParam(
+                    QUIC_PARAM_LISTENER_LOCAL_ADDRESS,
+                    &Length,
+                    nullptr));
+            TEST_EQUAL(Length, sizeof(QUIC_ADDR))
+
+            QUIC_ADDR Address = {0};
+            TEST_QUIC_SUCCEEDED(
+                Listener.GetParam(
+                    QUIC_PARAM_LISTENER_LOCAL_ADDRESS,
+                    &Length,
+                    &Address));
+            TEST_EQUAL(memcmp((void*)&Address, (void*)&ExpectedAddress, sizeof(QUIC_ADDR)), 0);
+        }
+    }
+
+    //
+    // QUIC_PARAM_LISTENER_STATS
+    //
+    {
+        TestScopeLogger LogScope0("QUIC_PARAM_LISTENER_STATS");
+        //
+        // SetParam
+        //
+        {
+            TestScopeLogger LogScope1("SetParam is not allowed");
+            MsQuicListener Listener(Registration, CleanUpManual, DummyListenerCallback<MsQuicListener*>, nullptr);
+            TEST_TRUE(Listener.IsValid());
+            QUIC_LISTENER_STATISTICS Dummy = {0};
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_INVALID_PARAMETER,
+                Listener.SetParam(
+                    QUIC_PARAM_LISTENER_STATS,
+                    sizeof(Dummy),
+                    &Dummy));
+        }
+
+        //
+        // GetParam
+        //
+        {
+            TestScopeLogger LogScope1("GetParam");
+            MsQuicListener Listener(Registration, CleanUpManual, DummyListenerCallback<MsQuicListener*>, nullptr);
+            TEST_TRUE(Listener.IsValid());
+
+            uint32_t Length = 0;
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_BUFFER_TOO_SMALL,
+                Listener.GetParam(
+                    QUIC_PARAM_LISTENER_STATS,
+                    &Length,
+                    nullptr));
+            TEST_EQUAL(Length, sizeof(QUIC_LISTENER_STATISTICS))
+
+            QUIC_LISTENER_STATISTICS Stats = {65535, 65535, 65535};
+            TEST_QUIC_SUCCEEDED(
+                Listener.GetParam(
+                    QUIC_PARAM_LISTENER_STATS,
+                    &Length,
+                    &Stats));
+            TEST_EQUAL(Stats.TotalAcceptedConnections, 0);
+            TEST_EQUAL(Stats.TotalRejectedConnections, 0);
+            TEST_EQUAL(Stats.BindingRecvDroppedPackets, 0);
+            // TODO: Stateful test after accept/rejecting connection
+        }
+    }
+
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+    //
+    // QUIC_PARAM_LISTENER_CIBIR_ID
+    //
+    {
+        TestScopeLogger LogScope0("QUIC_PARAM_LISTENER_CIBIR_ID");
+        //
+        // SetParam
+        //
+        {
+            TestScopeLogger LogScope1("SetParam");
+            MsQuicListener Listener(Registration, CleanUpManual, DummyListenerCallback<MsQuicListener*> , nullptr);
+            TEST_TRUE(Listener.IsValid());
+            CibirIDTests(Listener.Handle, QUIC_PARAM_LISTENER_CIBIR_ID);
+        }
+
+        //
+        // GetParam
+        //
+        {
+            TestScopeLogger LogScope1("GetParam");
+            MsQuicListener Listener(Registration, CleanUpManual, DummyListenerCallback<MsQuicListener*>, nullptr);
+            TEST_TRUE(Listener.IsValid());
+            uint32_t Length = 65535;
+            TEST_QUIC_SUCCEEDED(
+                Listener.GetParam(
+                    QUIC_PARAM_LISTENER_CIBIR_ID,
+                    &Length,
+                    nullptr));
+            TEST_EQUAL(Length, 0);
+            // TODO: Stateful test once Listener->CibrId is filled
+        }
+    }
+
+    //
+    // QUIC_PARAM_LISTENER_PREFERRED_ADDRESS
+    //
+    {
+        TestScopeLogger LogScope0("QUIC_PARAM_LISTENER_PREFERRED_ADDRESS");
+        MsQuicListener Listener(Registration, CleanUpManual, DummyListenerCallback<MsQuicListener*>, nullptr);
+        TEST_TRUE(Listener.IsValid());
+
+        QUIC_PREFERRED_ADDRESS PreferredAddress = {};
+        {
+            TestScopeLogger LogScope1("Wrong family is not allowed");
+            TEST_TRUE(QuicAddrFromString("fd00::11", 4433, &PreferredAddress.Ipv4Address));
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_INVALID_PARAMETER,
+                Listener.SetParam(
+                    QUIC_PARAM_LISTENER_PREFERRED_ADDRESS,
+                    sizeof(PreferredAddress),
+                    &PreferredAddress));
+        }
+
+        {
+            TestScopeLogger LogScope1("Zero port is not allowed");
+            TEST_TRUE(QuicAddrFromString("192.168.1.11", 0, &PreferredAddress.Ipv4Address));
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_INVALID_PARAMETER,
+                Listener.SetParam(
+                    QUIC_PARAM_LISTENER_PREFERRED_ADDRESS,
+                    sizeof(PreferredAddress),
+                    &PreferredAddress));
+        }
+
+        {
+            TestScopeLogger LogScope1("SetParam/GetParam");
+            TEST_TRUE(QuicAddrFromString("192.168.1.11", 4433, &PreferredAddress.Ipv4Address));
+            TEST_QUIC_SUCCEEDED(
+                Listener.SetParam(
+                    QUIC_PARAM_LISTENER_PREFERRED_ADDRESS,
+                    sizeof(PreferredAddress),
+                    &PreferredAddress));
+
+            uint32_t Length = 0;
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_BUFFER_TOO_SMALL,
+                Listener.GetParam(
+                    QUIC_PARAM_LISTENER_PREFERRED_ADDRESS,
+                    &Length,
+                    nullptr));
+            TEST_EQUAL(Length, sizeof(QUIC_PREFERRED_ADDRESS));
+
+            QUIC_PREFERRED_ADDRESS Actual = {};
+            TEST_QUIC_SUCCEEDED(
+                Listener.GetParam(
+                    QUIC_PARAM_LISTENER_PREFERRED_ADDRESS,
+                    &Length,
+                    &Actual));
+            TEST_TRUE(QuicAddrCompare(&Actual.Ipv4Address, &PreferredAddress.Ipv4Address));
+            TEST_EQUAL(QuicAddrGetFamily(&Actual.Ipv6Address), QUIC_ADDRESS_FAMILY_UNSPEC);
+        }
+
+        {
+            TestScopeLogger LogScope1("Clear");
+            TEST_QUIC_SUCCEEDED(
+                Listener.SetParam(
+                    QUIC_PARAM_LISTENER_PREFERRED_ADDRESS,
+                    0,
+                    nullptr));
+            QUIC_PREFERRED_ADDRESS Actual = {};
+            uint32_t Length = sizeof(Actual);
+            TEST_QUIC_SUCCEEDED(
+                Listener.GetParam(
+                    QUIC_PARAM_LISTENER_PREFERRED_ADDRESS,
+                    &Length,
+                    &Actual));
+            TEST_EQUAL(QuicAddrGetFamily(&Actual.Ipv4Address), QUIC_ADDRESS_FAMILY_UNSPEC);
+        }
+    }
+
+    //
+    // QUIC_PARAM_LISTENER_DRAIN
+    //
+    {
+        TestScopeLogger LogScope0("QUIC_PARAM_LISTENER_DRAIN");
+        MsQuicListener Listener(Registration, CleanUpManual, DummyListenerCallback<MsQuicListener*>, nullptr);
+        TEST_TRUE(Listener.IsValid());
+
+        uint8_t Draining = 1;
+        uint32_t Length = sizeof(Draining);
+        TEST_QUIC_SUCCEEDED(
+            Listener.GetParam(
+                QUIC_PARAM_LISTENER_DRAIN,
+                &Length,
+                &Draining));
+        TEST_EQUAL(Draining, FALSE);
+
+        Draining = TRUE;
+        TEST_QUIC_SUCCEEDED(
+            Listener.SetParam(
+                QUIC_PARAM_LISTENER_DRAIN,
+                sizeof(Draining),
+                &Draining));
+        Draining = FALSE;
+        TEST_QUIC_SUCCEEDED(
+            Listener.GetParam(
+                QUIC_PARAM_LISTENER_DRAIN,
+                &Length,
+                &Draining));
+        TEST_EQUAL(Draining, TRUE);
+    }
+
+    //
+    // QUIC_PARAM_LISTENER_PARTITIONED
+    //
+    {
+        TestScopeLogger LogScope0("QUIC_PARAM_LISTENER_PARTITIONED");
+        MsQuicListener Listener(Registration, CleanUpManual, DummyListenerCallback<MsQuicListener*>, nullptr);
+        TEST_TRUE(Listener.IsValid());
+
+        uint8_t Partitioned = 1;
+        uint32_t Length = sizeof(Partitioned);
+        TEST_QUIC_SUCCEEDED(
+            Listener.GetParam(
+                QUIC_PARAM_LISTENER_PARTITIONED,
+                &Length,
+                &Partitioned));
+        TEST_EQUAL(Partitioned, FALSE);
+
+        Partitioned = TRUE;
+        TEST_QUIC_SUCCEEDED(
+            Listener.SetParam(
+                QUIC_PARAM_LISTENER_PARTITIONED,
+                sizeof(Partitioned),
+                &Partitioned));
+        Partitioned = FALSE;
+        TEST_QUIC_SUCCEEDED(
+            Listener.GetParam(
+                QUIC_PARAM_LISTENER_PARTITIONED,
+                &Length,
+                &Partitioned));
+        TEST_EQUAL(Partitioned, TRUE);
+
+        QUIC_LISTENER_STATISTICS Stats;
+        Length = sizeof(Stats);
+        TEST_QUIC_SUCCEEDED(
+            Listener.GetParam(
+                QUIC_PARAM_LISTENER_STATS,
+                &Length,
+                &Stats));
+        TEST_EQUAL(Stats.TotalAcceptedConnections, 0);
+        TEST_EQUAL(Stats.TotalRejectedConnections, 0);
+
+        Partitioned = FALSE;
+        TEST_QUIC_SUCCEEDED(
+            Listener.SetParam(
+                QUIC_PARAM_LISTENER_PARTITIONED,
+                sizeof(Partitioned),
+                &Partitioned));
+    }
+
+    //
+    // QUIC_PARAM_LISTENER_SNI_CONFIGURATIONS
+    //
+    {
+        TestScopeLogger LogScope0("QUIC_PARAM_LISTENER_SNI_CONFIGURATIONS");
+        MsQuicListener Listener(Registration, CleanUpManual, DummyListenerCallback<MsQuicListener*>, nullptr);
+        TEST_TRUE(Listener.IsValid());
+
+        MsQuicConfiguration ServerConfiguration(Registration, Alpn, ServerSelfSignedCredConfig);
+        TEST_QUIC_SUCCEEDED(ServerConfiguration.GetInitStatus());
+        MsQuicConfiguration NoCredConfiguration(Registration, Alpn);
+        TEST_QUIC_SUCCEEDED(NoCredConfiguration.GetInitStatus());
+
+        QUIC_LISTENER_SNI_CONFIGURATION Mappings[] = {
+            { "example.com", ServerConfiguration },
+            { "*.example.com", ServerConfiguration },
+            { nullptr, ServerConfiguration },
+        };
+
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_PARAMETER,
+            Listener.SetParam(
+                QUIC_PARAM_LISTENER_SNI_CONFIGURATIONS,
+                sizeof(Mappings) - 1,
+                Mappings));
+
+        QUIC_LISTENER_SNI_CONFIGURATION Duplicate[] = {
+            { "example.com", ServerConfiguration },
+            { "EXAMPLE.com", ServerConfiguration },
+        };
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_PARAMETER,
+            Listener.SetParam(
+                QUIC_PARAM_LISTENER_SNI_CONFIGURATIONS,
+                sizeof(Duplicate),
+                Duplicate));
+
+        QUIC_LISTENER_SNI_CONFIGURATION BadWildcard[] = {
+            { "*example.com", ServerConfiguration },
+        };
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_PARAMETER,
+            Listener.SetParam(
+                QUIC_PARAM_LISTENER_SNI_CONFIGURATIONS,
+                sizeof(BadWildcard),
+                BadWildcard));
+
+        QUIC_LISTENER_SNI_CONFIGURATION NoCred[] = {
+            { "example.com", NoCredConfiguration },
+        };
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_PARAMETER,
+            Listener.SetParam(
+                QUIC_PARAM_LISTENER_SNI_CONFIGURATIONS,
+                sizeof(NoCred),
+                NoCred));
+
+        TEST_QUIC_SUCCEEDED(
+            Listener.SetParam(
+                QUIC_PARAM_LISTENER_SNI_CONFIGURATIONS,
+                sizeof(Mappings),
+                Mappings));
+
+        //
+        // Replacing and clearing the map.
+        //
+        TEST_QUIC_SUCCEEDED(
+            Listener.SetParam(
+                QUIC_PARAM_LISTENER_SNI_CONFIGURATIONS,
+                sizeof(Mappings[0]),
+                Mappings));
+        TEST_QUIC_SUCCEEDED(
+            Listener.SetParam(
+                QUIC_PARAM_LISTENER_SNI_CONFIGURATIONS,
+                0,
+                nullptr));
+
+        uint32_t Length = 0;
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_PARAMETER,
+            Listener.GetParam(
+                QUIC_PARAM_LISTENER_SNI_CONFIGURATIONS,
+                &Length,
+                nullptr));
+    }
+#endif
+}
+
+void QuicTest_QUIC_PARAM_CONN_QUIC_VERSION(MsQuicRegistration& Registration, MsQuicConfiguration& ClientConfiguration)
+{
+    TestScopeLogger LogScope0("QUIC_PARAM_CONN_QUIC_VERSION");
+    MsQuicConnection Connection(Registration);
+    TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+    //
+    // SetParam
+    //
+    {
+        TestScopeLogger LogScope1("SetParam is not allowed");
+        uint32_t Dummy = 0;
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_PARAMETER,
+            Connection.SetParam(
+                QUIC_PARAM_CONN_QUIC_VERSION,
+                sizeof(Dummy),
+                &Dummy));
+    }
+
+    //
+    // GetParam
+    //
+    {
+        TestScopeLogger LogScope1("GetParam");
+        uint32_t Length = 0;
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_BUFFER_TOO_SMALL,
+            Connection.GetParam(
+                QUIC_PARAM_CONN_QUIC_VERSION,
+                &Length,
+                nullptr));
+        TEST_EQUAL(Length, sizeof(uint32_t));
+
+        uint32_t Version = 65535;
+        {
+            TestScopeLogger LogScope2("Version == 0 before start");
+            TEST_QUIC_SUCCEEDED(
+                Connection.GetParam(
+                    QUIC_PARAM_CONN_QUIC_VERSION,
+                    &Length,
+                    &Version));
+            TEST_EQUAL(Version, 0);
+        }
+
+        {
+            TestScopeLogger LogScope2("Version == 1 after start");
+            TEST_QUIC_SUCCEEDED(
+                MsQuic->ConnectionStart(
+                    Connection.Handle,
+                    ClientConfiguration,
+                    QUIC_ADDRESS_FAMILY_INET,
+                    "localhost",
+                    4433));
+            TEST_QUIC_SUCCEEDED(
+                Connection.GetParam(
+                    QUIC_PARAM_CONN_QUIC_VERSION,
+                    &Length,
+                    &Version));
+            TEST_EQUAL(Version, 1);
+        }
+    }
+}
+
+void QuicTest_QUIC_PARAM_CONN_LOCAL_ADDRESS(MsQuicRegistration& Registration, MsQuicConfiguration& ClientConfiguration)
+{
+    TestScopeLogger LogScope0("QUIC_PARAM_CONN_LOCAL_ADDRESS");
+    //
+    // SetParam
+    //
+    {
+        TestScopeLogger LogScope1("SetParam");
+        //
+        // Connection ClosedLocally
+        //
+        {
+            TestScopeLogger LogScope2("Connection is closed locally");
+            TEST_TRUE(ClientConfiguration.IsValid());
+            MsQuicConnection Connection(Registration);
+            TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+            SimulateConnBadStartState(Connection, ClientConfiguration);
+
+            QUIC_ADDR Dummy = {};
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_INVALID_STATE,
+                Connection.SetParam(
+                    QUIC_PARAM_CONN_LOCAL_ADDRESS,
+                    sizeof(Dummy),
+                    &Dummy));
+        }
+
+        //
+        // Connection is started, but not handshake confirmed
+        //
+        {
+            TestScopeLogger LogScope2("Connection is started, but not handshake confirmed");
+            MsQuicConnection Connection(Registration);
+            TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+            TEST_QUIC_SUCCEEDED(
+                MsQuic->ConnectionStart(
+                    Connection.Handle,
+                    ClientConfiguration,
+                    QUIC_ADDRESS_FAMILY_INET,
+                    "localhost",
+                    4433));
+
+            QUIC_ADDR Dummy = {};
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_INVALID_STATE,
+                Connection.SetParam(
+                    QUIC_PARAM_CONN_LOCAL_ADDRESS,
+                    sizeof(Dummy),
+                    &Dummy));
+        }
+
+        //
+        // Good before ConnectioStart
+        //
+        {
+            TestScopeLogger LogScope2("Good before ConnectionStart");
+            MsQuicConnection Connection(Registration);
+            TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+            QUIC_ADDR Dummy = {};
+            TEST_QUIC_SUCCEEDED(
+                Connection.SetParam(
+                    QUIC_PARAM_CONN_LOCAL_ADDRESS,
+                    sizeof(Dummy),
+                    &Dummy));
+        }
+
+        {// TODO: good after start, need to set Connection->State.HandshakeConfirmed
+        }
+    }
+
+    //
+    // GetParam
+    //
+    {
+        TestScopeLogger LogScope1("GetParam");
+        {
+            MsQuicConnection Connection(Registration);
+            TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+            uint32_t Length = 0;
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_BUFFER_TOO_SMALL,
+                Connection.GetParam(
+                    QUIC_PARAM_CONN_LOCAL_ADDRESS,
+                    &Length,
+                    nullptr));
+            TEST_EQUAL(Length, sizeof(QUIC_ADDR));
+
+            QUIC_ADDR Addr = {};
+            //
+            // !Connection->Stae.LocalAddressSet
+            //
+            {
+                TestScopeLogger LogScope2("!Connection->Stae.LocalAddressSet");
+                TEST_QUIC_STATUS(
+                    QUIC_STATUS_INVALID_STATE,
+                    Connection.GetParam(
+                        QUIC_PARAM_CONN_LOCAL_ADDRESS,
+                        &Length,
+                        &Addr));
+            }
+
+            //
+            // Good
+            //
+            {
+                TEST_QUIC_SUCCEEDED(
+                    MsQuic->ConnectionStart(
+                        Connection.Handle,
+                        ClientConfiguration,
+                        QUIC_ADDRESS_FAMILY_INET,
+                        "127.0.0.1",
+                        4433));
+                TEST_QUIC_SUCCEEDED(
+                    Connection.GetParam(
+                        QUIC_PARAM_CONN_LOCAL_ADDRESS,
+                        &Length,
+                        &Addr));
+                QUIC_ADDR Expected = {0};
+                QuicAddrFromString("127.0.0.1", 4433, &Expected);
+                TEST_EQUAL(memcmp((void*)&Addr.Ipv4.sin_addr, (void*)&Expected.Ipv4.sin_addr, sizeof(struct in_addr)), 0);
+                TEST_NOT_EQUAL(Addr.Ipv4.sin_port, Expected.Ipv4.sin_port);
+            }
+        }
+    }
+}
+
+void QuicTest_QUIC_PARAM_CONN_REMOTE_ADDRESS(MsQuicRegistration& Registration, MsQuicConfiguration& ClientConfiguration)
+{
+    TestScopeLogger LogScope0("QUIC_PARAM_CONN_REMOTE_ADDRESS");
+    {
+        TestScopeLogger LogScope1("SetParam");
+        {
+            //
+            // QUIC_STATUS_INVALID_STATE (connection failed to started)
+            //
+            {
+                TestScopeLogger LogScope2("QUIC_CONN_BAD_START_STATE");
+                MsQuicConnection Connection(Registration);
+                TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+                SimulateConnBadStartState(Connection, ClientConfiguration);
+
+                QUIC_ADDR Dummy = {};
+                TEST_TRUE(QuicAddrFromString("127.0.0.1", 0, &Dummy));
+                TEST_QUIC_STATUS(
+                    QUIC_STATUS_INVALID_STATE,
+                    Connection.SetParam(
+                        QUIC_PARAM_CONN_REMOTE_ADDRESS,
+                        sizeof(Dummy),
+                        &Dummy));
+            }
+
+            //
+            // QUIC_STATUS_INVALID_PARAMETER (0.0.0.0)
+            //
+            {
+                MsQuicConnection Connection(Registration);
+                TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+                const QUIC_ADDR ZeroAddr = {0};
+                TEST_QUIC_STATUS(
+                    QUIC_STATUS_INVALID_PARAMETER,
+                    Connection.SetParam(
+                        QUIC_PARAM_CONN_REMOTE_ADDRESS,
+                        sizeof(ZeroAddr),
+                        &ZeroAddr));
+            }
+
+            //
+            // QUIC_STATUS_INVALID_PARAMETER (too small)
+            //
+            {
+                MsQuicConnection Connection(Registration);
+                TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+                QUIC_ADDR Dummy = {};
+                TEST_TRUE(QuicAddrFromString("127.0.0.1", 0, &Dummy));
+                TEST_QUIC_STATUS(
+                    QUIC_STATUS_INVALID_PARAMETER,
+                    Connection.SetParam(
+                        QUIC_PARAM_CONN_REMOTE_ADDRESS,
+                        sizeof(Dummy)-1,
+                        &Dummy));
+            }
+
+            //
+            // Good
+            //
+            {
+                MsQuicConnection Connection(Registration);
+                TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+                QUIC_ADDR Dummy = {};
+                TEST_TRUE(QuicAddrFromString("127.0.0.1", 0, &Dummy));
+                TEST_QUIC_SUCCEEDED(
+                    Connection.SetParam(
+                        QUIC_PARAM_CONN_REMOTE_ADDRESS,
+                        sizeof(Dummy),
+                        &Dummy));
+            }
+        }
+    }
+
+    //
+    // GetParam
+    //
+    {
+        TestScopeLogger LogScope1("GetParam");
+        {
+            MsQuicConnection Connection(Registration);
+            TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+            uint32_t Length = 0;
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_BUFFER_TOO_SMALL,
+                Connection.GetParam(
+                    QUIC_PARAM_CONN_REMOTE_ADDRESS,
+                    &Length,
+                    nullptr));
+            TEST_EQUAL(Length, sizeof(QUIC_ADDR));
+
+            //
+            // !Connection->State.RemoteAddressSet
+            //
+            QUIC_ADDR Addr = {};
+            {
+                TestScopeLogger LogScope2("!Connection->State.RemoteAddressSet");
+                TEST_QUIC_STATUS(
+                    QUIC_STATUS_INVALID_STATE,
+                    Connection.GetParam(
+                        QUIC_PARAM_CONN_REMOTE_ADDRESS,
+                        &Length,
+                        &Addr));
+            }
+
+            //
+            // Good
+            //
+            {
+                TEST_QUIC_SUCCEEDED(
+                    MsQuic->ConnectionStart(
+                        Connection.Handle,
+                        ClientConfiguration,
+                        QUIC_ADDRESS_FAMILY_INET,
+                        "127.0.0.1",
+                        4433));
+                TEST_QUIC_SUCCEEDED(
+                    Connection.GetParam(
+                        QUIC_PARAM_CONN_REMOTE_ADDRESS,
+                        &Length,
+                        &Addr));
+                QUIC_ADDR Expected = {0};
+                QuicAddrFromString("127.0.0.1", 4433, &Expected);
+                TEST_EQUAL(memcmp((void*)&Addr, (void*)&Expected, sizeof(QUIC_ADDR)), 0);
+            }
+        }
+    }
+}
+
+void QuicTest_QUIC_PARAM_CONN_IDEAL_PROCESSOR(MsQuicRegistration& Registration)
+{
+    TestScopeLogger LogScope0("QUIC_PARAM_CONN_IDEAL_PROCESSOR");
+    {
+        TestScopeLogger LogScope1("SetParam is not allowed");
+        MsQuicConnection Connection(Registration);
+        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+        uint16_t Dummy = 8;
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_PARAMETER,
+            Connection.SetParam(
+                QUIC_PARAM_CONN_IDEAL_PROCESSOR,
+                sizeof(Dummy),
+                &Dummy));
+    }
+
+    //
+    // GetParam
+    //
+    {
+        TestScopeLogger LogScope1("GetParam");
+        MsQuicConnection Connection(Registration);
+        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_IDEAL_PROCESSOR, sizeof(uint16_t), nullptr);
+    }
+}
+
+void QuicTest_QUIC_PARAM_CONN_SETTINGS(MsQuicRegistration& Registration, MsQuicConfiguration& ClientConfiguration)
+{
+    TestScopeLogger LogScope0("QUIC_PARAM_CONN_SETTINGS");
+    {
+        TestScopeLogger LogScope1("SetParam");
+        //
+        // QuicConnApplyNewSettings
+        //
+        {
+            TestScopeLogger LogScope2("QuicConnApplyNewSettings");
+            //
+            // Before ConnectionStart
+            //
+            {
+                TestScopeLogger LogScope3("Before ConnectionStart");
+                MsQuicConnection Connection(Registration);
+                TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+                SettingApplyTests(Connection.Handle, QUIC_PARAM_CONN_SETTINGS);
+            }
+
+            //
+            // After ConnectionStart
+            //
+            {
+                TestScopeLogger LogScope3("After ConnectionStart");
+                // Internally AllowMtuEcnChanges become FALSE
+                MsQuicConnection Connection(Registration);
+                TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+                TEST_QUIC_SUCCEEDED(
+                    MsQuic->ConnectionStart(
+                        Connection.Handle,
+                        ClientConfiguration,
+                        QUIC_ADDRESS_FAMILY_INET,
+                        "localhost",
+                        4433));
+                CxPlatSleep(100);
+
+                SettingApplyTests(Connection.Handle, QUIC_PARAM_CONN_SETTINGS, FALSE);
+            }
+        }
+
+        //
+        // Good
+        //
+        {
+            MsQuicConnection Connection(Registration);
+            TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+            QUIC_SETTINGS Settings{0};
+
+            TEST_QUIC_SUCCEEDED(
+                MsQuic->SetParam(
+                    Connection.Handle,
+                    QUIC_PARAM_CONN_SETTINGS,
+                    sizeof(QUIC_SETTINGS),
+                    &Settings));
+        }
+    }
+
+    //
+    // GetParam
+    //
+    {
+        TestScopeLogger LogScope1("GetParam");
+        MsQuicConnection Connection(Registration);
+        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_SETTINGS, sizeof(QUIC_SETTINGS), nullptr, true);
+    }
+}
+
+void QuicTest_QUIC_PARAM_CONN_STATISTICS(MsQuicRegistration& Registration)
+{
+    TestScopeLogger LogScope0("QUIC_PARAM_CONN_STATISTICS");
+    {
+        TestScopeLogger LogScope1("SetParam is not allowed");
+        MsQuicConnection Connection(Registration);
+        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+        QUIC_STATISTICS Dummy = {};
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_PARAMETER,
+            Connection.SetParam(
+                QUIC_PARAM_CONN_STATISTICS,
+                sizeof(Dummy),
+                &Dummy));
+    }
+
+    //
+    // GetParam
+    //
+    {
+        TestScopeLogger LogScope1("GetParam");
+        MsQuicConnection Connection(Registration);
+        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_STATISTICS, sizeof(QUIC_STATISTICS), nullptr, true);
+    }
+}
+
+void QuicTest_QUIC_PARAM_CONN_STATISTICS_PLAT(MsQuicRegistration& Registration)
+{
+    TestScopeLogger LogScope0("QUIC_PARAM_CONN_STATISTICS_PLAT is get only");
+    {
+        TestScopeLogger LogScope1("SetParam is not allowed");
+        MsQuicConnection Connection(Registration);
+        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+        QUIC_STATISTICS Dummy = {};
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_PARAMETER,
+            Connection.SetParam(
+                QUIC_PARAM_CONN_STATISTICS_PLAT,
+                sizeof(Dummy),
+                &Dummy));
+    }
+
+    //
+    // GetParam
+    //
+    {
+        TestScopeLogger LogScope1("GetParam");
+        MsQuicConnection Connection(Registration);
+        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_STATISTICS_PLAT, sizeof(QUIC_STATISTICS), nullptr, true);
+    }
+}
+
+void QuicTest_QUIC_PARAM_CONN_SHARE_UDP_BINDING(MsQuicRegistration& Registration, MsQuicConfiguration& ClientConfiguration)
+{
+    TestScopeLogger LogScope0("QUIC_PARAM_CONN_SHARE_UDP_BINDING");
+    BOOLEAN Data = TRUE;
+    MsQuicConnection Connection(Registration);
+    TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+    //
+    // SetParam
+    //
+    {
+        TestScopeLogger LogScope1("SetParam");
+        //
+        // QUIC_CONN_BAD_START_STATE
+        //
+        {
+            TestScopeLogger LogScope2("QUIC_CONN_BAD_START_STATE");
+            MsQuicConnection ConnInval(Registration);
+            SimulateConnBadStartState(ConnInval, ClientConfiguration);
+
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_INVALID_STATE,
+                ConnInval.SetParam(
+                    QUIC_PARAM_CONN_SHARE_UDP_BINDING,
+                    sizeof(Data),
+                    &Data));
+        }
+
+
+        //
+        // Good
+        //
+        {
+            TEST_QUIC_SUCCEEDED(
+                Connection.SetParam(
+                    QUIC_PARAM_CONN_SHARE_UDP_BINDING,
+                    sizeof(Data),
+                    &Data));
+        }
+    }
+
+    //
+    // GetParam
+    //
+    {
+        TestScopeLogger LogScope2("GetParam");
+        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_SHARE_UDP_BINDING, sizeof(BOOLEAN), &Data);
+    }
+}
+
+void QuicTest_QUIC_PARAM_CONN_LOCAL_BIDI_STREAM_COUNT(MsQuicRegistration& Registration)
+{
+    TestScopeLogger LogScope0("QUIC_PARAM_CONN_LOCAL_BIDI_STREAM_COUNT");
+    {
+        TestScopeLogger LogScope1("SetParam is not allowed");
+        MsQuicConnection Connection(Registration);
+        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+        uint16_t Dummy = 0;
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_PARAMETER,
+            Connection.SetParam(
+                QUIC_PARAM_CONN_LOCAL_BIDI_STREAM_COUNT,
+                sizeof(Dummy),
+                &Dummy));
+    }
+
+    {
+        TestScopeLogger LogScope1("GetParam");
+        MsQuicConnection Connection(Registration);
+        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+        // There is no stream yet
+        uint16_t Count = 0;
+        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_LOCAL_BIDI_STREAM_COUNT, sizeof(uint16_t), &Count);
+    }
+}
+
+void QuicTest_QUIC_PARAM_CONN_LOCAL_UNIDI_STREAM_COUNT(MsQuicRegistration& Registration)
+{
+    TestScopeLogger LogScope0("QUIC_PARAM_CONN_LOCAL_UNIDI_STREAM_COUNT");
+    {
+        TestScopeLogger LogScope1("SetParam is not allowed");
+        MsQuicConnection Connection(Registration);
+        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+        uint16_t Dummy = 0;
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_PARAMETER,
+            Connection.SetParam(
+                QUIC_PARAM_CONN_LOCAL_UNIDI_STREAM_COUNT,
+                sizeof(Dummy),
+                &Dummy));
+    }
+
+    {
+        TestScopeLogger LogScope1("GetParam");
+        MsQuicConnection Connection(Registration);
+        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+        // There is no stream yet
+        uint16_t Count = 0;
+        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_LOCAL_UNIDI_STREAM_COUNT, sizeof(uint16_t), &Count);
+    }
+}
+
+void QuicTest_QUIC_PARAM_CONN_MAX_STREAM_IDS(MsQuicRegistration& Registration)
+{
+    TestScopeLogger LogScope0("QUIC_PARAM_CONN_MAX_STREAM_IDS");
+    {
+        TestScopeLogger LogScope1("SetParam is not allowed");
+        MsQuicConnection Connection(Registration);
+        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+        uint16_t Dummy = 0;
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_PARAMETER,
+            Connection.SetParam(
+                QUIC_PARAM_CONN_MAX_STREAM_IDS,
+                sizeof(Dummy),
+                &Dummy));
+    }
+
+    {
+        TestScopeLogger LogScope1("GetParam");
+        MsQuicConnection Connection(Registration);
+        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+        // There is no stream yet
+        // 4 is defined in stream.h as NUMBER_OF_STREAM_TYPES
+        uint8_t NumberOfStreamTypes = 4;
+        uint64_t IDs[4] = {0, 1, 2, 3}; // Refer quicStreamSetGetMaxStreamIDs()
+        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_MAX_STREAM_IDS, sizeof(uint64_t) * NumberOfStreamTypes, IDs);
+    }
+}
+
+void QuicTest_QUIC_PARAM_CONN_CLOSE_REASON_PHRASE(MsQuicRegistration& Registration)
+{
+    TestScopeLogger LogScope0("QUIC_PARAM_CONN_CLOSE_REASON_PHRASE");
+    MsQuicConnection Connection(Registration); // shared with Set/GetParam
+    TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+    char MainReason[] = "This is main reason";
+    {
+        TestScopeLogger LogScope1("SetParam");
+        // //
+        // // BufferLength is longer than QUIC_MAX_CONN_CLOSE_REASON_LENGTH
+        // //
+        // {
+        //     TestScopeLogger LogScope2("BufferLength is longer than QUIC_MAX_CONN_CLOSE_REASON_LENGTH");
+        //     MsQuicConnection ConnInval(Registration);
+        //     TEST_QUIC_SUCCEEDED(ConnInval.GetInitStatus());
+        //     char Reason[2048] = {};
+        //     TEST_QUIC_STATUS(
+        //         QUIC_STATUS_INVALID_PARAMETER,
+        //         ConnInval.SetParam(
+        //             QUIC_PARAM_CONN_CLOSE_REASON_PHRASE,
+        //             sizeof(Reason),
+        //             &Reason));
+        // }
+
+    //     //
+    //     // Non null termination
+    //     //
+    //     {
+    //         TestScopeLogger LogScope2("Non null termination");
+    //         MsQuicConnection ConnInval(Registration);
+    //         TEST_QUIC_SUCCEEDED(ConnInval.GetInitStatus());
+    //         char Reason[] = "This is reason";
+    //         Reason[sizeof(Reason)-1] = 'X';
+    //         TEST_QUIC_STATUS(
+    //             QUIC_STATUS_INVALID_PARAMETER,
+    //             ConnInval.SetParam(
+    //                 QUIC_PARAM_CONN_CLOSE_REASON_PHRASE,
+    //                 sizeof(Reason),
+    //                 &Reason));
+    //     }
+
+        //
+        // Good, set twice to call update part
+        //
+        {
+            TestScopeLogger LogScope2("Good, set twice to call update part");
+            // char ReasonDummy[] = "This is reason";
+            // TEST_QUIC_SUCCEEDED(
+            //     Connection.SetParam(
+            //         QUIC_PARAM_CONN_CLOSE_REASON_PHRASE,
+            //         sizeof(ReasonDummy),
+            //         &ReasonDummy));
+
+            TEST_QUIC_SUCCEEDED(
+                Connection.SetParam(
+                    QUIC_PARAM_CONN_CLOSE_REASON_PHRASE,
+                    sizeof(MainReason),
+                    &MainReason));
+        }
+    // }
+
+    // //
+    // // GetParam
+    // //
+    // {
+    //     //
+    //     // if (Connection->CloseReasonPhrase == NULL)
+    //     //
+    //     {
+    //         TestScopeLogger LogScope2("if (Connection->CloseReasonPhrase == NULL)");
+    //         MsQuicConnection ConnInval(Registration);
+    //         TEST_QUIC_SUCCEEDED(ConnInval.GetInitStatus());
+    //         uint32_t Length = 0;
+    //         TEST_QUIC_STATUS(
+    //             QUIC_STATUS_NOT_FOUND,
+    //             ConnInval.GetParam(
+    //                 QUIC_PARAM_CONN_CLOSE_REASON_PHRASE,
+    //                 &Length,
+    //                 nullptr));
+    //     }
+
+    //     //
+    //     // Good
+    //     //
+    //     {
+    //         SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_CLOSE_REASON_PHRASE, 0, nullptr);
+    //         //SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_CLOSE_REASON_PHRASE, sizeof(MainReason), MainReason);
+    //     }
+    }
+}
+
+void QuicTest_QUIC_PARAM_CONN_STREAM_SCHEDULING_SCHEME(MsQuicRegistration& Registration)
+{
+    TestScopeLogger LogScope0("QUIC_PARAM_CONN_STREAM_SCHEDULING_SCHEME");
+    {
+        TestScopeLogger LogScope1("SetParam");
+        {
+            //
+            // Invalid scheme
+            //
+            {
+                TestScopeLogger LogScope2("Invalid scheme");
+                MsQuicConnection Connection(Registration);
+                TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+                QUIC_STREAM_SCHEDULING_SCHEME Scheme = QUIC_STREAM_SCHEDULING_SCHEME_COUNT;
+                TEST_QUIC_STATUS(
+                    QUIC_STATUS_INVALID_PARAMETER,
+                        Connection.SetParam(
+                        QUIC_PARAM_CONN_STREAM_SCHEDULING_SCHEME,
+                        sizeof(Scheme),
+                        &Scheme));
+            }
+
+            //
+            // Good
+            //
+            for (uint32_t Scheme = 0; Scheme < QUIC_STREAM_SCHEDULING_SCHEME_COUNT; Scheme++) {
+                MsQuicConnection Connection(Registration);
+                TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+                TEST_QUIC_SUCCEEDED(
+                    Connection.SetParam(
+                        QUIC_PARAM_CONN_STREAM_SCHEDULING_SCHEME,
+                        sizeof(Scheme),
+                        &Scheme));
+            }
+        }
+    }
+
+    //
+    // GetParam
+    //
+    {
+        TestScopeLogger LogScope1("GetParam");
+        MsQuicConnection Connection(Registration);
+        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+        uint32_t Scheme = QUIC_STREAM_SCHEDULING_SCHEME_FIFO;
+        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_STREAM_SCHEDULING_SCHEME, sizeof(QUIC_STREAM_SCHEDULING_SCHEME), &Scheme);
+    }
+}
+
+void QuicTest_QUIC_PARAM_CONN_DATAGRAM_RECEIVE_ENABLED(MsQuicRegistration& Registration, MsQuicConfiguration& ClientConfiguration)
+{
+    TestScopeLogger LogScope0("QUIC_PARAM_CONN_DATAGRAM_RECEIVE_ENABLED");
+    MsQuicConnection Connection(Registration);
+    TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+    BOOLEAN Flag = TRUE;
+    {
+        TestScopeLogger LogScope1("SetParam");
+        //
+        // QUIC_CONN_BAD_START_STATE
+        //
+        {
+            TestScopeLogger LogScope2("QUIC_CONN_BAD_START_STATE");
+            MsQuicConnection ConnInval(Registration);
+            TEST_QUIC_SUCCEEDED(ConnInval.GetInitStatus());
+            SimulateConnBadStartState(ConnInval, ClientConfiguration);
+
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_INVALID_STATE,
+                ConnInval.SetParam(
+                    QUIC_PARAM_CONN_DATAGRAM_RECEIVE_ENABLED,
+                    sizeof(Flag),
+                    &Flag));
+        }
+
+        //
+        // Good
+        //
+        {
+            TEST_QUIC_SUCCEEDED(
+                Connection.SetParam(
+                    QUIC_PARAM_CONN_DATAGRAM_RECEIVE_ENABLED,
+                    sizeof(Flag),
+                    &Flag));
+        }
+    }
+
+    //
+    // GetParam
+    //
+    {
+        TestScopeLogger LogScope1("GetParam");
+        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_DATAGRAM_RECEIVE_ENABLED, sizeof(BOOLEAN), &Flag);
+    }
+}
+
+void QuicTest_QUIC_PARAM_CONN_DATAGRAM_SEND_ENABLED(MsQuicRegistration& Registration)
+{
+    TestScopeLogger LogScope0("QUIC_PARAM_CONN_DATAGRAM_SEND_ENABLED");
+    {
+        TestScopeLogger LogScope1("SetParam is not allowed");
+        MsQuicConnection Connection(Registration);
+        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+        uint8_t Dummy = 0;
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_PARAMETER,
+            Connection.SetParam(
+                QUIC_PARAM_CONN_DATAGRAM_SEND_ENABLED,
+                sizeof(Dummy),
+                &Dummy));
+    }
+
+    {
+        TestScopeLogger LogScope1("GetParam");
+        MsQuicConnection Connection(Registration);
+        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+        BOOLEAN Enabled = TRUE;
+        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_DATAGRAM_SEND_ENABLED, sizeof(BOOLEAN), &Enabled);
+    }
+}
+
+void QuicTest_QUIC_PARAM_CONN_DISABLE_1RTT_ENCRYPTION(MsQuicRegistration& Registration, MsQuicConfiguration& ClientConfiguration)
+{
+#ifdef QUIC_API_ENABLE_INSECURE_FEATURES
+    TestScopeLogger LogScope0("QUIC_PARAM_CONN_DISABLE_1RTT_ENCRYPTION");
+    MsQuicConnection Connection(Registration);
+    TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+    BOOLEAN Flag = TRUE;
+    //
+    // The peer didn't negotiate the feature
+    //
+    {
+        {
+            MsQuicConnection ConnInval(Registration);
+            TEST_QUIC_SUCCEEDED(ConnInval.GetInitStatus());
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_INVALID_STATE,
+                ConnInval.SetParam(
+                    QUIC_PARAM_CONN_DISABLE_1RTT_ENCRYPTION,
+                    sizeof(Flag),
+                    &Flag));
+        }
+
+        //
+        // Good
+        //
+        {
+            TEST_QUIC_SUCCEEDED(
+                Connection.SetParam(
+                    QUIC_PARAM_CONN_DISABLE_1RTT_ENCRYPTION,
+                    sizeof(Flag),
+                    &Flag));
+        }
+    }
+
+    //
+    // GetParam
+    //
+    {
+        TestScopeLogger LogScope1("GetParam");
+        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_DISABLE_1RTT_ENCRYPTION, sizeof(BOOLEAN), &Flag);
+    }
+#else
+    UNREFERENCED_PARAMETER(Registration);
+    UNREFERENCED_PARAMETER(ClientConfiguration);
+#endif
+}
+
+void QuicTest_QUIC_PARAM_CONN_PEER_CERTIFICATE_VALID(MsQuicRegistration& Registration)
+{
+    TestScopeLogger LogScope0("QUIC_PARAM_CONN_PEER_CERTIFICATE_VALID");
+    {
+        TestScopeLogger LogScope1("SetParam");
+        MsQuicConnection Connection(Registration);
+        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+
+        //
+        // Good with True/False
+        //
+        for (uint8_t i = 0; i < 2; i++) {
+            BOOLEAN Result = FALSE + i;
+            TEST_QUIC_SUCCEEDED(
+                Connection.SetParam(
+                    QUIC_PARAM_CONN_PEER_CERTIFICATE_VALID,
+                    sizeof(Result),
+                    &Result));
+        }
+    }
+
+    {
+        TestScopeLogger LogScope1("GetParam is not allowed");
+    }
+}
+
+void QuicTest_QUIC_PARAM_CONN_LOCAL_INTERFACE(MsQuicRegistration& Registration, MsQuicConfiguration& ClientConfiguration)
+{
+    TestScopeLogger LogScope0("QUIC_PARAM_CONN_LOCAL_INTERFACE");
+
+    uint32_t Index = 0;
+    //
+    // QUIC_CONN_BAD_START_STATE
+    //
+    {
+        TestScopeLogger LogScope1("QUIC_CONN_BAD_START_STATE");
+        MsQuicConnection Connection(Registration);
+        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+        SimulateConnBadStartState(Connection, ClientConfiguration);
+
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_STATE,
+            Connection.SetParam(
+                QUIC_PARAM_CONN_LOCAL_INTERFACE,
+                sizeof(Index),
+                &Index));
+    }
+
+    //
+    // Good
+    //
+    {
+        MsQuicConnection Connection(Registration);
+        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+        TEST_QUIC_SUCCEEDED(
+            Connection.SetParam(
+                QUIC_PARAM_CONN_LOCAL_INTERFACE,
+                sizeof(Index),
+                &Index));
+    }
+
+    {
+        TestScopeLogger LogScope1("GetParam is not allowed");
+    }
+}
+
+void QuicTest_QUIC_PARAM_CONN_TLS_SECRETS(MsQuicRegistration& Registration, MsQuicConfiguration& ClientConfiguration)
+{
+    TestScopeLogger LogScope0("QUIC_PARAM_CONN_TLS_SECRETS");
+    {
+        TestScopeLogger LogScope1("SetParam");
+        QUIC_TLS_SECRETS Secrets = {};
+        //
+        // QUIC_CONN_BAD_START_STATE
+        //
+        {
+            TestScopeLogger LogScope2("QUIC_CONN_BAD_START_STATE");
+            MsQuicConnection Connection(Registration);
+            TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+            SimulateConnBadStartState(Connection, ClientConfiguration);
+
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_INVALID_STATE,
+                Connection.SetParam(
+                    QUIC_PARAM_CONN_TLS_SECRETS,
+                    sizeof(Secrets),
+                    &Secrets));
+        }
+
+        //
+        // Good
+        //
+        {
+            MsQuicConnection Connection(Registration);
+            TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+            TEST_QUIC_SUCCEEDED(
+                Connection.SetParam(
+                    QUIC_PARAM_CONN_TLS_SECRETS,
+                    sizeof(Secrets),
+                    &Secrets));
+        }
+    }
+
+    {
+        TestScopeLogger LogScope1("GetParam is not allowed");
+    }
+}
+
+void QuicTest_QUIC_PARAM_CONN_CIBIR_ID(MsQuicRegistration& Registration, MsQuicConfiguration& ClientConfiguration)
+{
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+    TestScopeLogger LogScope0("QUIC_PARAM_CONN_CIBIR_ID");
+    {
+        TestScopeLogger LogScope1("SetParam");
+        //
+        // QUIC_CONN_BAD_START_STATE
+        //
+        {
+            TestScopeLogger LogScope2("QUIC_CONN_BAD_START_STATE");
+            MsQuicConnection Connection(Registration);
+            TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+            SimulateConnBadStartState(Connection, ClientConfiguration);
+
+            uint8_t Id[5] = {};
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_INVALID_STATE,
+                Connection.SetParam(
+                    QUIC_PARAM_CONN_CIBIR_ID,
+                    sizeof(Id),
+                    &Id));
+        }
+
+        //
+        // !Connection->State.ShareBinding
+        //
+        {
+            TestScopeLogger LogScope2("SharedBinding is disabled");
+            MsQuicConnection Connection(Registration);
+            TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+            uint8_t Id[4] = {};
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_INVALID_STATE,
+                Connection.SetParam(
+                    QUIC_PARAM_CONN_CIBIR_ID,
+                    sizeof(Id),
+                    &Id));
+        }
+
+
+        //
+        // CIBIR_ID common
+        //
+        {
+            TestScopeLogger LogScope2("SharedBinding is enabled");
+            MsQuicConnection Connection(Registration);
+            TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+            BOOLEAN Flag = TRUE;
+            TEST_QUIC_SUCCEEDED(
+                Connection.SetParam(
+                    QUIC_PARAM_CONN_SHARE_UDP_BINDING,
+                    sizeof(Flag),
+                    &Flag));
+
+            // Will be enabled once Listener test is merged
+            // CibirIDTests(Connection.Handle, QUIC_PARAM_CONN_CIBIR_ID);
+        }
+    }
+
+    {
+        TestScopeLogger LogScope1("GetParam is not allowed");
     }
+#else
+    UNREFERENCED_PARAMETER(Registration);
+    UNREFERENCED_PARAMETER(ClientConfiguration);
+#endif
 }
 
-void QuicTest_QUIC_PARAM_CONN_IDEAL_PROCESSOR(MsQuicRegistration& Registration)
+void QuicTest_QUIC_PARAM_CONN_STATISTICS_V2(MsQuicRegistration& Registration)
 {
-    TestScopeLogger LogScope0("QUIC_PARAM_CONN_IDEAL_PROCESSOR");
+    TestScopeLogger LogScope0("QUIC_PARAM_CONN_STATISTICS_V2 is get only");
     {
-        TestScopeLogger LogScope1("SetParam is not allowed");
+        TestScopeLogger LogScope1("GetParam");
         MsQuicConnection Connection(Registration);
         TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
-        uint16_t Dummy = 8;
+        uint16_t Dummy = 0;
         TEST_QUIC_STATUS(
             QUIC_STATUS_INVALID_PARAMETER,
             Connection.SetParam(
-                QUIC_PARAM_CONN_IDEAL_PROCESSOR,
+                QUIC_PARAM_CONN_STATISTICS_V2,
                 sizeof(Dummy),
                 &Dummy));
     }
 
-    //
-    // GetParam
-    //
     {
         TestScopeLogger LogScope1("GetParam");
         MsQuicConnection Connection(Registration);
         TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
-        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_IDEAL_PROCESSOR, sizeof(uint16_t), nullptr);
+        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_STATISTICS_V2, sizeof(QUIC_STATISTICS_V2), nullptr, true);
+    }
+
+    {
+        TestScopeLogger LogScope1("GetParam with an older struct size");
+        MsQuicConnection Connection(Registration);
+        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+        QUIC_STATISTICS_V2 Stats;
+        CxPlatZeroMemory(&Stats, sizeof(Stats));
+        Stats.SendAppLimitedTimeUs = UINT64_MAX;
+        uint32_t Length = QUIC_STATISTICS_V2_SIZE_4;
+        TEST_QUIC_SUCCEEDED(
+            Connection.GetParam(
+                QUIC_PARAM_CONN_STATISTICS_V2,
+                &Length,
+                &Stats));
+        TEST_EQUAL(Length, QUIC_STATISTICS_V2_SIZE_4);
+        TEST_EQUAL(Stats.SendAppLimitedTimeUs, UINT64_MAX);
+
+        Length = sizeof(Stats);
+        TEST_QUIC_SUCCEEDED(
+            Connection.GetParam(
+                QUIC_PARAM_CONN_STATISTICS_V2,
+                &Length,
+                &Stats));
+        TEST_EQUAL(Length, (uint32_t)sizeof(Stats));
+        TEST_EQUAL(Stats.SendAppLimitedTimeUs, 0);
     }
 }
 
-void QuicTest_QUIC_PARAM_CONN_SETTINGS(MsQuicRegistration& Registration, MsQuicConfiguration& ClientConfiguration)
+void QuicTest_QUIC_PARAM_CONN_STATISTICS_V2_PLAT(MsQuicRegistration& Registration)
 {
-    TestScopeLogger LogScope0("QUIC_PARAM_CONN_SETTINGS");
+    TestScopeLogger LogScope0("QUIC_PARAM_CONN_STATISTICS_V2_PLAT");
     {
-        TestScopeLogger LogScope1("SetParam");
-        //
-        // QuicConnApplyNewSettings
-        //
-        {
-            TestScopeLogger LogScope2("QuicConnApplyNewSettings");
-            //
-            // Before ConnectionStart
-            //
-            {
-                TestScopeLogger LogScope3("Before ConnectionStart");
-                MsQuicConnection Connection(Registration);
-                TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
-                SettingApplyTests(Connection.Handle, QUIC_PARAM_CONN_SETTINGS);
-            }
+        TestScopeLogger LogScope1("GetParam");
+        MsQuicConnection Connection(Registration);
+        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+        uint16_t Dummy = 0;
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_PARAMETER,
+            Connection.SetParam(
+                QUIC_PARAM_CONN_STATISTICS_V2_PLAT,
+                sizeof(Dummy),
+                &Dummy));
+    }
 
-            //
-            // After ConnectionStart
-            //
-            {
-                TestScopeLogger LogScope3("After ConnectionStart");
-                // Internally AllowMtuEcnChanges become FALSE
-                MsQuicConnection Connection(Registration);
-                TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
-                TEST_QUIC_SUCCEEDED(
-                    MsQuic->ConnectionStart(
-                        Connection.Handle,
-                        ClientConfiguration,
-                        QUIC_ADDRESS_FAMILY_INET,
-                        "localhost",
-                        4433));
-                CxPlatSleep(100);
+    {
+        TestScopeLogger LogScope1("GetParam");
+        MsQuicConnection Connection(Registration);
+        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_STATISTICS_V2_PLAT, sizeof(QUIC_STATISTICS_V2), nullptr, true);
+    }
+}
 
-                SettingApplyTests(Connection.Handle, QUIC_PARAM_CONN_SETTINGS, FALSE);
-            }
-        }
 
+void QuicTest_QUIC_PARAM_CONN_ORIG_DEST_CID(MsQuicRegistration& Registration, MsQuicConfiguration& ClientConfiguration) {
+    //
+    // This is the unit test for checking to see if a server has the correct original dest CID.
+    //
+    TestScopeLogger LogScope0("QUIC_PARAM_CONN_ORIG_DEST_CID");
+    {
+        MsQuicConnection Connection(Registration);
+        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+        TEST_QUIC_SUCCEEDED(
+          Connection.Start(
+              ClientConfiguration,
+              QUIC_ADDRESS_FAMILY_INET,
+              "localhost",
+              4433));
+        MsQuic->ConnectionSetConfiguration(Connection.Handle, ClientConfiguration);
         //
-        // Good
+        // 8 bytes is the expected minimum size of the CID.
         //
-        {
-            MsQuicConnection Connection(Registration);
-            TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
-            QUIC_SETTINGS Settings{0};
-
-            TEST_QUIC_SUCCEEDED(
-                MsQuic->SetParam(
-                    Connection.Handle,
-                    QUIC_PARAM_CONN_SETTINGS,
-                    sizeof(QUIC_SETTINGS),
-                    &Settings));
-        }
+        uint32_t SizeOfBuffer = 8;
+        uint8_t Buffer[8] = {0};
+        uint8_t ZeroBuffer[8] = {0};
+        TestScopeLogger LogScope1("GetParam test success case");
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_SUCCESS,
+            Connection.GetParam(
+                QUIC_PARAM_CONN_ORIG_DEST_CID,
+                &SizeOfBuffer,
+                Buffer
+            )
+        )
+        TEST_NOT_EQUAL(memcmp(Buffer, ZeroBuffer, sizeof(Buffer)), 0);
     }
-
-    //
-    // GetParam
-    //
     {
-        TestScopeLogger LogScope1("GetParam");
         MsQuicConnection Connection(Registration);
         TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
-        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_SETTINGS, sizeof(QUIC_SETTINGS), nullptr, true);
+        TEST_QUIC_SUCCEEDED(
+          Connection.Start(
+              ClientConfiguration,
+              QUIC_ADDRESS_FAMILY_INET,
+              "localhost",
+              4433));
+        uint32_t SizeOfBuffer = 8;
+        TestScopeLogger LogScope1("GetParam null buffer check");
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_PARAMETER,
+            Connection.GetParam(
+                QUIC_PARAM_CONN_ORIG_DEST_CID,
+                &SizeOfBuffer,
+                nullptr
+            )
+        )
+    }
+    {
+        MsQuicConnection Connection(Registration);
+        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+        TEST_QUIC_SUCCEEDED(
+          Connection.Start(
+              ClientConfiguration,
+              QUIC_ADDRESS_FAMILY_INET,
+              "localhost",
+              4433));
+        uint32_t SizeOfBuffer = 1;
+        TestScopeLogger LogScope1("GetParam buffer too small check");
+        uint8_t Buffer[1];
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_BUFFER_TOO_SMALL,
+            Connection.GetParam(
+                QUIC_PARAM_CONN_ORIG_DEST_CID,
+                &SizeOfBuffer,
+                Buffer
+            )
+        )
+    }
+    {
+        MsQuicConnection Connection(Registration);
+        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+        TEST_QUIC_SUCCEEDED(
+          Connection.Start(
+              ClientConfiguration,
+              QUIC_ADDRESS_FAMILY_INET,
+              "localhost",
+              4433));
+        uint32_t SizeOfBuffer = 100;
+        uint8_t Buffer[100] = {0};
+        uint8_t ZeroBuffer[100] = {0};
+        TestScopeLogger LogScope1("GetParam size of buffer bigger than needed");
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_SUCCESS,
+            Connection.GetParam(
+                QUIC_PARAM_CONN_ORIG_DEST_CID,
+                &SizeOfBuffer,
+                Buffer
+            )
+        )
+        TEST_NOT_EQUAL(memcmp(Buffer, ZeroBuffer, sizeof(Buffer)), 0);
+        //
+        // There is no way the CID written should be 100 bytes according to the RFC.
+        //
+        TEST_TRUE(SizeOfBuffer < 100);
+    }
+    {
+        MsQuicConnection Connection(Registration);
+        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+        TEST_QUIC_SUCCEEDED(
+          Connection.Start(
+              ClientConfiguration,
+              QUIC_ADDRESS_FAMILY_INET,
+              "localhost",
+              4433));
+        uint32_t SizeOfBuffer = 0;
+        TestScopeLogger LogScope1("GetParam check OrigDestCID size with nullptr");
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_BUFFER_TOO_SMALL,
+            Connection.GetParam(
+                QUIC_PARAM_CONN_ORIG_DEST_CID,
+                &SizeOfBuffer,
+                nullptr
+            )
+        )
+        TEST_TRUE(SizeOfBuffer >= 8);
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_PARAMETER,
+            Connection.GetParam(
+                QUIC_PARAM_CONN_ORIG_DEST_CID,
+                &SizeOfBuffer,
+                nullptr
+            )
+        )
     }
 }
 
-void QuicTest_QUIC_PARAM_CONN_STATISTICS(MsQuicRegistration& Registration)
+void QuicTest_QUIC_PARAM_CONN_SEND_MEMORY_REGION(MsQuicRegistration& Registration)
 {
-    TestScopeLogger LogScope0("QUIC_PARAM_CONN_STATISTICS");
+    TestScopeLogger LogScope0("QUIC_PARAM_CONN_SEND_MEMORY_REGION");
+    uint8_t Memory[64];
     {
-        TestScopeLogger LogScope1("SetParam is not allowed");
+        TestScopeLogger LogScope1("SetParam");
         MsQuicConnection Connection(Registration);
         TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
-        QUIC_STATISTICS Dummy = {};
+
+        QUIC_BUFFER Region = { sizeof(Memory), Memory };
         TEST_QUIC_STATUS(
             QUIC_STATUS_INVALID_PARAMETER,
             Connection.SetParam(
-                QUIC_PARAM_CONN_STATISTICS,
-                sizeof(Dummy),
-                &Dummy));
-    }
-
-    //
-    // GetParam
-    //
-    {
-        TestScopeLogger LogScope1("GetParam");
-        MsQuicConnection Connection(Registration);
-        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
-        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_STATISTICS, sizeof(QUIC_STATISTICS), nullptr, true);
-    }
-}
+                QUIC_PARAM_CONN_SEND_MEMORY_REGION,
+                sizeof(Region) - 1,
+                &Region));
 
-void QuicTest_QUIC_PARAM_CONN_STATISTICS_PLAT(MsQuicRegistration& Registration)
-{
-    TestScopeLogger LogScope0("QUIC_PARAM_CONN_STATISTICS_PLAT is get only");
-    {
-        TestScopeLogger LogScope1("SetParam is not allowed");
-        MsQuicConnection Connection(Registration);
-        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
-        QUIC_STATISTICS Dummy = {};
+        QUIC_BUFFER EmptyRegion = { 0, Memory };
         TEST_QUIC_STATUS(
             QUIC_STATUS_INVALID_PARAMETER,
             Connection.SetParam(
-                QUIC_PARAM_CONN_STATISTICS_PLAT,
-                sizeof(Dummy),
-                &Dummy));
+                QUIC_PARAM_CONN_SEND_MEMORY_REGION,
+                sizeof(EmptyRegion),
+                &EmptyRegion));
+
+        //
+        // Only a limited number of regions can be registered.
+        //
+        for (uint32_t i = 0; i < 8; ++i) {
+            TEST_QUIC_SUCCEEDED(
+                Connection.SetParam(
+                    QUIC_PARAM_CONN_SEND_MEMORY_REGION,
+                    sizeof(Region),
+                    &Region));
+        }
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_STATE,
+            Connection.SetParam(
+                QUIC_PARAM_CONN_SEND_MEMORY_REGION,
+                sizeof(Region),
+                &Region));
     }
 
-    //
-    // GetParam
-    //
     {
-        TestScopeLogger LogScope1("GetParam");
+        TestScopeLogger LogScope1("GetParam is not allowed");
         MsQuicConnection Connection(Registration);
         TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
-        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_STATISTICS_PLAT, sizeof(QUIC_STATISTICS), nullptr, true);
+        uint32_t Length = sizeof(QUIC_BUFFER);
+        QUIC_BUFFER Region;
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_PARAMETER,
+            Connection.GetParam(
+                QUIC_PARAM_CONN_SEND_MEMORY_REGION,
+                &Length,
+                &Region));
     }
 }
 
-void QuicTest_QUIC_PARAM_CONN_SHARE_UDP_BINDING(MsQuicRegistration& Registration, MsQuicConfiguration& ClientConfiguration)
+void QuicTest_QUIC_PARAM_CONN_DATAGRAM_BATCH_RECEIVE_ENABLED(MsQuicRegistration& Registration, MsQuicConfiguration& ClientConfiguration)
 {
-    TestScopeLogger LogScope0("QUIC_PARAM_CONN_SHARE_UDP_BINDING");
-    BOOLEAN Data = TRUE;
+    TestScopeLogger LogScope0("QUIC_PARAM_CONN_DATAGRAM_BATCH_RECEIVE_ENABLED");
     MsQuicConnection Connection(Registration);
     TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
-    //
-    // SetParam
-    //
+    BOOLEAN Flag = TRUE;
     {
         TestScopeLogger LogScope1("SetParam");
-        //
-        // QUIC_CONN_BAD_START_STATE
-        //
         {
             TestScopeLogger LogScope2("QUIC_CONN_BAD_START_STATE");
             MsQuicConnection ConnInval(Registration);
+            TEST_QUIC_SUCCEEDED(ConnInval.GetInitStatus());
             SimulateConnBadStartState(ConnInval, ClientConfiguration);
 
             TEST_QUIC_STATUS(
                 QUIC_STATUS_INVALID_STATE,
                 ConnInval.SetParam(
-                    QUIC_PARAM_CONN_SHARE_UDP_BINDING,
-                    sizeof(Data),
-                    &Data));
+                    QUIC_PARAM_CONN_DATAGRAM_BATCH_RECEIVE_ENABLED,
+                    sizeof(Flag),
+                    &Flag));
         }
 
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_PARAMETER,
+            Connection.SetParam(
+                QUIC_PARAM_CONN_DATAGRAM_BATCH_RECEIVE_ENABLED,
+                sizeof(Flag) + 1,
+                &Flag));
 
-        //
-        // Good
-        //
-        {
-            TEST_QUIC_SUCCEEDED(
-                Connection.SetParam(
-                    QUIC_PARAM_CONN_SHARE_UDP_BINDING,
-                    sizeof(Data),
-                    &Data));
-        }
+        TEST_QUIC_SUCCEEDED(
+            Connection.SetParam(
+                QUIC_PARAM_CONN_DATAGRAM_BATCH_RECEIVE_ENABLED,
+                sizeof(Flag),
+                &Flag));
     }
 
-    //
-    // GetParam
-    //
     {
-        TestScopeLogger LogScope2("GetParam");
-        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_SHARE_UDP_BINDING, sizeof(BOOLEAN), &Data);
+        TestScopeLogger LogScope1("GetParam");
+        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_DATAGRAM_BATCH_RECEIVE_ENABLED, sizeof(BOOLEAN), &Flag);
     }
 }
 
-void QuicTest_QUIC_PARAM_CONN_LOCAL_BIDI_STREAM_COUNT(MsQuicRegistration& Registration)
+void QuicTest_QUIC_PARAM_CONN_SEND_FLUSH_BUDGET(MsQuicRegistration& Registration)
 {
-    TestScopeLogger LogScope0("QUIC_PARAM_CONN_LOCAL_BIDI_STREAM_COUNT");
+    TestScopeLogger LogScope0("QUIC_PARAM_CONN_SEND_FLUSH_BUDGET");
+    MsQuicConnection Connection(Registration);
+    TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
     {
-        TestScopeLogger LogScope1("SetParam is not allowed");
-        MsQuicConnection Connection(Registration);
-        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
-        uint16_t Dummy = 0;
+        TestScopeLogger LogScope1("GetParam default");
+        uint32_t Expected = 200; // QUIC_EXECUTION_PROFILE_LOW_LATENCY
+        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_SEND_FLUSH_BUDGET, sizeof(uint32_t), &Expected);
+    }
+
+    {
+        TestScopeLogger LogScope1("SetParam");
+        uint32_t Budget = 1000;
         TEST_QUIC_STATUS(
             QUIC_STATUS_INVALID_PARAMETER,
             Connection.SetParam(
-                QUIC_PARAM_CONN_LOCAL_BIDI_STREAM_COUNT,
-                sizeof(Dummy),
-                &Dummy));
-    }
+                QUIC_PARAM_CONN_SEND_FLUSH_BUDGET,
+                sizeof(Budget) - 1,
+                &Budget));
 
-    {
-        TestScopeLogger LogScope1("GetParam");
-        MsQuicConnection Connection(Registration);
-        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
-        // There is no stream yet
-        uint16_t Count = 0;
-        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_LOCAL_BIDI_STREAM_COUNT, sizeof(uint16_t), &Count);
+        TEST_QUIC_SUCCEEDED(
+            Connection.SetParam(
+                QUIC_PARAM_CONN_SEND_FLUSH_BUDGET,
+                sizeof(Budget),
+                &Budget));
+        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_SEND_FLUSH_BUDGET, sizeof(uint32_t), &Budget);
+
+        //
+        // Zero restores the execution profile's default.
+        //
+        Budget = 0;
+        TEST_QUIC_SUCCEEDED(
+            Connection.SetParam(
+                QUIC_PARAM_CONN_SEND_FLUSH_BUDGET,
+                sizeof(Budget),
+                &Budget));
+        uint32_t Expected = 200;
+        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_SEND_FLUSH_BUDGET, sizeof(uint32_t), &Expected);
     }
 }
 
-void QuicTest_QUIC_PARAM_CONN_LOCAL_UNIDI_STREAM_COUNT(MsQuicRegistration& Registration)
+void QuicTest_QUIC_PARAM_CONN_SEND_COALESCING_DELAY(MsQuicRegistration& Registration)
 {
-    TestScopeLogger LogScope0("QUIC_PARAM_CONN_LOCAL_UNIDI_STREAM_COUNT");
+    TestScopeLogger LogScope0("QUIC_PARAM_CONN_SEND_COALESCING_DELAY");
+    MsQuicConnection Connection(Registration);
+    TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
     {
-        TestScopeLogger LogScope1("SetParam is not allowed");
-        MsQuicConnection Connection(Registration);
-        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
-        uint16_t Dummy = 0;
-        TEST_QUIC_STATUS(
-            QUIC_STATUS_INVALID_PARAMETER,
-            Connection.SetParam(
-                QUIC_PARAM_CONN_LOCAL_UNIDI_STREAM_COUNT,
-                sizeof(Dummy),
-                &Dummy));
+        TestScopeLogger LogScope1("GetParam default");
+        uint32_t Expected = 0;
+        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_SEND_COALESCING_DELAY, sizeof(uint32_t), &Expected);
     }
 
     {
-        TestScopeLogger LogScope1("GetParam");
-        MsQuicConnection Connection(Registration);
-        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
-        // There is no stream yet
-        uint16_t Count = 0;
-        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_LOCAL_UNIDI_STREAM_COUNT, sizeof(uint16_t), &Count);
-    }
-}
+        TestScopeLogger LogScope1("SetParam");
+        uint32_t Delay = 1000;
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_PARAMETER,
+            Connection.SetParam(
+                QUIC_PARAM_CONN_SEND_COALESCING_DELAY,
+                sizeof(Delay) - 1,
+                &Delay));
 
-void QuicTest_QUIC_PARAM_CONN_MAX_STREAM_IDS(MsQuicRegistration& Registration)
-{
-    TestScopeLogger LogScope0("QUIC_PARAM_CONN_MAX_STREAM_IDS");
-    {
-        TestScopeLogger LogScope1("SetParam is not allowed");
-        MsQuicConnection Connection(Registration);
-        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
-        uint16_t Dummy = 0;
+        uint32_t TooLong = 25001;
         TEST_QUIC_STATUS(
             QUIC_STATUS_INVALID_PARAMETER,
             Connection.SetParam(
-                QUIC_PARAM_CONN_MAX_STREAM_IDS,
-                sizeof(Dummy),
-                &Dummy));
-    }
+                QUIC_PARAM_CONN_SEND_COALESCING_DELAY,
+                sizeof(TooLong),
+                &TooLong));
 
-    {
-        TestScopeLogger LogScope1("GetParam");
-        MsQuicConnection Connection(Registration);
-        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
-        // There is no stream yet
-        // 4 is defined in stream.h as NUMBER_OF_STREAM_TYPES
-        uint8_t NumberOfStreamTypes = 4;
-        uint64_t IDs[4] = {0, 1, 2, 3}; // Refer quicStreamSetGetMaxStreamIDs()
-        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_MAX_STREAM_IDS, sizeof(uint64_t) * NumberOfStreamTypes, IDs);
+        TEST_QUIC_SUCCEEDED(
+            Connection.SetParam(
+                QUIC_PARAM_CONN_SEND_COALESCING_DELAY,
+                sizeof(Delay),
+                &Delay));
+        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_SEND_COALESCING_DELAY, sizeof(uint32_t), &Delay);
+
+        Delay = 0;
+        TEST_QUIC_SUCCEEDED(
+            Connection.SetParam(
+                QUIC_PARAM_CONN_SEND_COALESCING_DELAY,
+                sizeof(Delay),
+                &Delay));
+        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_SEND_COALESCING_DELAY, sizeof(uint32_t), &Delay);
     }
 }
 
-void QuicTest_QUIC_PARAM_CONN_CLOSE_REASON_PHRASE(MsQuicRegistration& Registration)
+void QuicTest_QUIC_PARAM_CONN_ADDRESS_RACE_DELAY(MsQuicRegistration& Registration)
 {
-    TestScopeLogger LogScope0("QUIC_PARAM_CONN_CLOSE_REASON_PHRASE");
-    MsQuicConnection Connection(Registration); // shared with Set/GetParam
+    TestScopeLogger LogScope0("QUIC_PARAM_CONN_ADDRESS_RACE_DELAY");
+    MsQuicConnection Connection(Registration);
     TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
-    char MainReason[] = "This is main reason";
     {
-        TestScopeLogger LogScope1("SetParam");
-        // //
-        // // BufferLength is longer than QUIC_MAX_CONN_CLOSE_REASON_LENGTH
-        // //
-        // {
-        //     TestScopeLogger LogScope2("BufferLength is longer than QUIC_MAX_CONN_CLOSE_REASON_LENGTH");
-        //     MsQuicConnection ConnInval(Registration);
-        //     TEST_QUIC_SUCCEEDED(ConnInval.GetInitStatus());
-        //     char Reason[2048] = {};
-        //     TEST_QUIC_STATUS(
-        //         QUIC_STATUS_INVALID_PARAMETER,
-        //         ConnInval.SetParam(
-        //             QUIC_PARAM_CONN_CLOSE_REASON_PHRASE,
-        //             sizeof(Reason),
-        //             &Reason));
-        // }
-
-    //     //
-    //     // Non null termination
-    //     //
-    //     {
-    //         TestScopeLogger LogScope2("Non null termination");
-    //         MsQuicConnection ConnInval(Registration);
-    //         TEST_QUIC_SUCCEEDED(ConnInval.GetInitStatus());
-    //         char Reason[] = "This is reason";
-    //         Reason[sizeof(Reason)-1] = 'X';
-    //         TEST_QUIC_STATUS(
-    //             QUIC_STATUS_INVALID_PARAMETER,
-    //             ConnInval.SetParam(
-    //                 QUIC_PARAM_CONN_CLOSE_REASON_PHRASE,
-    //                 sizeof(Reason),
-    //                 &Reason));
-    //     }
-
-        //
-        // Good, set twice to call update part
-        //
-        {
-            TestScopeLogger LogScope2("Good, set twice to call update part");
-            // char ReasonDummy[] = "This is reason";
-            // TEST_QUIC_SUCCEEDED(
-            //     Connection.SetParam(
-            //         QUIC_PARAM_CONN_CLOSE_REASON_PHRASE,
-            //         sizeof(ReasonDummy),
-            //         &ReasonDummy));
+        TestScopeLogger LogScope1("GetParam default");
+        uint32_t Expected = 0;
+        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_ADDRESS_RACE_DELAY, sizeof(uint32_t), &Expected);
+    }
 
-            TEST_QUIC_SUCCEEDED(
-                Connection.SetParam(
-                    QUIC_PARAM_CONN_CLOSE_REASON_PHRASE,
-                    sizeof(MainReason),
-                    &MainReason));
-        }
-    // }
+    {
+        TestScopeLogger LogScope1("SetParam");
+        uint32_t Delay = 250;
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_PARAMETER,
+            Connection.SetParam(
+                QUIC_PARAM_CONN_ADDRESS_RACE_DELAY,
+                sizeof(Delay) - 1,
+                &Delay));
 
-    // //
-    // // GetParam
-    // //
-    // {
-    //     //
-    //     // if (Connection->CloseReasonPhrase == NULL)
-    //     //
-    //     {
-    //         TestScopeLogger LogScope2("if (Connection->CloseReasonPhrase == NULL)");
-    //         MsQuicConnection ConnInval(Registration);
-    //         TEST_QUIC_SUCCEEDED(ConnInval.GetInitStatus());
-    //         uint32_t Length = 0;
-    //         TEST_QUIC_STATUS(
-    //             QUIC_STATUS_NOT_FOUND,
-    //             ConnInval.GetParam(
-    //                 QUIC_PARAM_CONN_CLOSE_REASON_PHRASE,
-    //                 &Length,
-    //                 nullptr));
-    //     }
+        uint32_t TooLong = 10001;
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_PARAMETER,
+            Connection.SetParam(
+                QUIC_PARAM_CONN_ADDRESS_RACE_DELAY,
+                sizeof(TooLong),
+                &TooLong));
 
-    //     //
-    //     // Good
-    //     //
-    //     {
-    //         SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_CLOSE_REASON_PHRASE, 0, nullptr);
-    //         //SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_CLOSE_REASON_PHRASE, sizeof(MainReason), MainReason);
-    //     }
+        TEST_QUIC_SUCCEEDED(
+            Connection.SetParam(
+                QUIC_PARAM_CONN_ADDRESS_RACE_DELAY,
+                sizeof(Delay),
+                &Delay));
+        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_ADDRESS_RACE_DELAY, sizeof(uint32_t), &Delay);
     }
 }
 
-void QuicTest_QUIC_PARAM_CONN_STREAM_SCHEDULING_SCHEME(MsQuicRegistration& Registration)
+void QuicTest_QUIC_PARAM_CONN_DATAGRAM_FEC(MsQuicRegistration& Registration)
 {
-    TestScopeLogger LogScope0("QUIC_PARAM_CONN_STREAM_SCHEDULING_SCHEME");
+    TestScopeLogger LogScope0("QUIC_PARAM_CONN_DATAGRAM_FEC");
+    MsQuicConnection Connection(Registration);
+    TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
     {
-        TestScopeLogger LogScope1("SetParam");
-        {
-            //
-            // Invalid scheme
-            //
-            {
-                TestScopeLogger LogScope2("Invalid scheme");
-                MsQuicConnection Connection(Registration);
-                TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
-                QUIC_STREAM_SCHEDULING_SCHEME Scheme = QUIC_STREAM_SCHEDULING_SCHEME_COUNT;
-                TEST_QUIC_STATUS(
-                    QUIC_STATUS_INVALID_PARAMETER,
-                        Connection.SetParam(
-                        QUIC_PARAM_CONN_STREAM_SCHEDULING_SCHEME,
-                        sizeof(Scheme),
-                        &Scheme));
-            }
-
-            //
-            // Good
-            //
-            for (uint32_t Scheme = 0; Scheme < QUIC_STREAM_SCHEDULING_SCHEME_COUNT; Scheme++) {
-                MsQuicConnection Connection(Registration);
-                TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
-                TEST_QUIC_SUCCEEDED(
-                    Connection.SetParam(
-                        QUIC_PARAM_CONN_STREAM_SCHEDULING_SCHEME,
-                        sizeof(Scheme),
-                        &Scheme));
-            }
-        }
+        TestScopeLogger LogScope1("GetParam default");
+        QUIC_DATAGRAM_FEC_CONFIG Expected = { 0, 0 };
+        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_DATAGRAM_FEC, sizeof(Expected), &Expected);
     }
 
-    //
-    // GetParam
-    //
     {
-        TestScopeLogger LogScope1("GetParam");
-        MsQuicConnection Connection(Registration);
-        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
-        uint32_t Scheme = QUIC_STREAM_SCHEDULING_SCHEME_FIFO;
-        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_STREAM_SCHEDULING_SCHEME, sizeof(QUIC_STREAM_SCHEDULING_SCHEME), &Scheme);
+        TestScopeLogger LogScope1("SetParam");
+        QUIC_DATAGRAM_FEC_CONFIG Config = { 2, 8 };
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_PARAMETER,
+            Connection.SetParam(
+                QUIC_PARAM_CONN_DATAGRAM_FEC,
+                sizeof(Config) - 1,
+                &Config));
+
+        QUIC_DATAGRAM_FEC_CONFIG BadConfigs[] = {
+            { 1, 8 },
+            { 8, 4 },
+            { 2, QUIC_DATAGRAM_FEC_MAX_BLOCK_SIZE + 1 }
+        };
+        for (auto& BadConfig : BadConfigs) {
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_INVALID_PARAMETER,
+                Connection.SetParam(
+                    QUIC_PARAM_CONN_DATAGRAM_FEC,
+                    sizeof(BadConfig),
+                    &BadConfig));
+        }
+
+        TEST_QUIC_SUCCEEDED(
+            Connection.SetParam(
+                QUIC_PARAM_CONN_DATAGRAM_FEC,
+                sizeof(Config),
+                &Config));
+        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_DATAGRAM_FEC, sizeof(Config), &Config);
     }
 }
 
-void QuicTest_QUIC_PARAM_CONN_DATAGRAM_RECEIVE_ENABLED(MsQuicRegistration& Registration, MsQuicConfiguration& ClientConfiguration)
+void QuicTest_QUIC_PARAM_CONN_STANDBY_PATHS(MsQuicRegistration& Registration)
 {
-    TestScopeLogger LogScope0("QUIC_PARAM_CONN_DATAGRAM_RECEIVE_ENABLED");
+    TestScopeLogger LogScope0("QUIC_PARAM_CONN_STANDBY_PATHS");
     MsQuicConnection Connection(Registration);
     TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
-    BOOLEAN Flag = TRUE;
+    {
+        TestScopeLogger LogScope1("GetParam default");
+        QUIC_STANDBY_PATHS Expected;
+        CxPlatZeroMemory(&Expected, sizeof(Expected));
+        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_STANDBY_PATHS, sizeof(Expected), &Expected);
+    }
+
     {
         TestScopeLogger LogScope1("SetParam");
-        //
-        // QUIC_CONN_BAD_START_STATE
-        //
-        {
-            TestScopeLogger LogScope2("QUIC_CONN_BAD_START_STATE");
-            MsQuicConnection ConnInval(Registration);
-            TEST_QUIC_SUCCEEDED(ConnInval.GetInitStatus());
-            SimulateConnBadStartState(ConnInval, ClientConfiguration);
+        QUIC_STANDBY_PATHS Config;
+        CxPlatZeroMemory(&Config, sizeof(Config));
+        Config.ProbeIntervalMs = 500;
+        Config.LocalAddressCount = 1;
+        Config.LocalAddresses[0] = QuicAddr(QUIC_ADDRESS_FAMILY_INET, true).SockAddr;
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_PARAMETER,
+            Connection.SetParam(
+                QUIC_PARAM_CONN_STANDBY_PATHS,
+                sizeof(Config) - 1,
+                &Config));
 
-            TEST_QUIC_STATUS(
-                QUIC_STATUS_INVALID_STATE,
-                ConnInval.SetParam(
-                    QUIC_PARAM_CONN_DATAGRAM_RECEIVE_ENABLED,
-                    sizeof(Flag),
-                    &Flag));
-        }
+        QUIC_STANDBY_PATHS BadConfig = Config;
+        BadConfig.LocalAddressCount = QUIC_MAX_STANDBY_PATHS + 1;
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_PARAMETER,
+            Connection.SetParam(
+                QUIC_PARAM_CONN_STANDBY_PATHS,
+                sizeof(BadConfig),
+                &BadConfig));
 
-        //
-        // Good
-        //
-        {
-            TEST_QUIC_SUCCEEDED(
-                Connection.SetParam(
-                    QUIC_PARAM_CONN_DATAGRAM_RECEIVE_ENABLED,
-                    sizeof(Flag),
-                    &Flag));
-        }
-    }
+        BadConfig = Config;
+        BadConfig.ProbeIntervalMs = 60001;
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_PARAMETER,
+            Connection.SetParam(
+                QUIC_PARAM_CONN_STANDBY_PATHS,
+                sizeof(BadConfig),
+                &BadConfig));
 
-    //
-    // GetParam
-    //
-    {
-        TestScopeLogger LogScope1("GetParam");
-        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_DATAGRAM_RECEIVE_ENABLED, sizeof(BOOLEAN), &Flag);
+        BadConfig = Config;
+        BadConfig.LocalAddresses[0] = QuicAddr(QUIC_ADDRESS_FAMILY_INET).SockAddr;
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_PARAMETER,
+            Connection.SetParam(
+                QUIC_PARAM_CONN_STANDBY_PATHS,
+                sizeof(BadConfig),
+                &BadConfig));
+
+        TEST_QUIC_SUCCEEDED(
+            Connection.SetParam(
+                QUIC_PARAM_CONN_STANDBY_PATHS,
+                sizeof(Config),
+                &Config));
+        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_STANDBY_PATHS, sizeof(Config), &Config);
+
+        Config.LocalAddressCount = 0;
+        TEST_QUIC_SUCCEEDED(
+            Connection.SetParam(
+                QUIC_PARAM_CONN_STANDBY_PATHS,
+                sizeof(Config),
+                &Config));
+        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_STANDBY_PATHS, sizeof(Config), &Config);
     }
 }
 
-void QuicTest_QUIC_PARAM_CONN_DATAGRAM_SEND_ENABLED(MsQuicRegistration& Registration)
+static
+QUIC_STATUS
+QUIC_API
+TestStreamCompress(
+    _In_opt_ void*,
+    _In_reads_bytes_(InputLength) const uint8_t*,
+    _In_ uint32_t InputLength,
+    _Out_writes_bytes_to_(*OutputLength, *OutputLength) uint8_t*,
+    _Inout_ uint32_t* OutputLength
+    )
 {
-    TestScopeLogger LogScope0("QUIC_PARAM_CONN_DATAGRAM_SEND_ENABLED");
+    UNREFERENCED_PARAMETER(InputLength);
+    UNREFERENCED_PARAMETER(OutputLength);
+    return QUIC_STATUS_NOT_SUPPORTED;
+}
+
+static
+QUIC_STATUS
+QUIC_API
+TestStreamDecompress(
+    _In_opt_ void*,
+    _In_reads_bytes_(InputLength) const uint8_t*,
+    _In_ uint32_t InputLength,
+    _Out_writes_bytes_(OutputLength) uint8_t*,
+    _In_ uint32_t OutputLength
+    )
+{
+    UNREFERENCED_PARAMETER(InputLength);
+    UNREFERENCED_PARAMETER(OutputLength);
+    return QUIC_STATUS_NOT_SUPPORTED;
+}
+
+void QuicTest_QUIC_PARAM_CONN_STREAM_COMPRESSION(MsQuicRegistration& Registration)
+{
+    TestScopeLogger LogScope0("QUIC_PARAM_CONN_STREAM_COMPRESSION");
+    MsQuicConnection Connection(Registration);
+    TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
     {
-        TestScopeLogger LogScope1("SetParam is not allowed");
-        MsQuicConnection Connection(Registration);
-        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
-        uint8_t Dummy = 0;
+        TestScopeLogger LogScope1("GetParam default");
+        QUIC_STREAM_COMPRESSION_CONFIG Expected = { 0, nullptr, nullptr, nullptr };
+        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_STREAM_COMPRESSION, sizeof(Expected), &Expected);
+    }
+
+    {
+        TestScopeLogger LogScope1("SetParam");
+        QUIC_STREAM_COMPRESSION_CONFIG Config = {
+            42, nullptr, TestStreamCompress, TestStreamDecompress };
         TEST_QUIC_STATUS(
             QUIC_STATUS_INVALID_PARAMETER,
             Connection.SetParam(
-                QUIC_PARAM_CONN_DATAGRAM_SEND_ENABLED,
-                sizeof(Dummy),
-                &Dummy));
+                QUIC_PARAM_CONN_STREAM_COMPRESSION,
+                sizeof(Config) - 1,
+                &Config));
+
+        QUIC_STREAM_COMPRESSION_CONFIG BadConfig = Config;
+        BadConfig.Decompress = nullptr;
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_PARAMETER,
+            Connection.SetParam(
+                QUIC_PARAM_CONN_STREAM_COMPRESSION,
+                sizeof(BadConfig),
+                &BadConfig));
+
+        TEST_QUIC_SUCCEEDED(
+            Connection.SetParam(
+                QUIC_PARAM_CONN_STREAM_COMPRESSION,
+                sizeof(Config),
+                &Config));
+        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_STREAM_COMPRESSION, sizeof(Config), &Config);
+    }
+}
+
+void QuicTest_QUIC_PARAM_CONN_DATAGRAM_SEND_POLICY(MsQuicRegistration& Registration)
+{
+    TestScopeLogger LogScope0("QUIC_PARAM_CONN_DATAGRAM_SEND_POLICY");
+    MsQuicConnection Connection(Registration);
+    TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+    {
+        TestScopeLogger LogScope1("GetParam default");
+        QUIC_DATAGRAM_SEND_POLICY Expected = { 0, 0 };
+        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_DATAGRAM_SEND_POLICY, sizeof(Expected), &Expected);
     }
 
     {
-        TestScopeLogger LogScope1("GetParam");
-        MsQuicConnection Connection(Registration);
-        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
-        BOOLEAN Enabled = TRUE;
-        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_DATAGRAM_SEND_ENABLED, sizeof(BOOLEAN), &Enabled);
+        TestScopeLogger LogScope1("SetParam");
+        QUIC_DATAGRAM_SEND_POLICY Policy = { 50000, 100000 };
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_PARAMETER,
+            Connection.SetParam(
+                QUIC_PARAM_CONN_DATAGRAM_SEND_POLICY,
+                sizeof(Policy) - 1,
+                &Policy));
+
+        TEST_QUIC_SUCCEEDED(
+            Connection.SetParam(
+                QUIC_PARAM_CONN_DATAGRAM_SEND_POLICY,
+                sizeof(Policy),
+                &Policy));
+        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_DATAGRAM_SEND_POLICY, sizeof(Policy), &Policy);
     }
 }
 
-void QuicTest_QUIC_PARAM_CONN_DISABLE_1RTT_ENCRYPTION(MsQuicRegistration& Registration, MsQuicConfiguration& ClientConfiguration)
+void QuicTest_QUIC_PARAM_CONN_STREAM_BATCH_RECEIVE_ENABLED(MsQuicRegistration& Registration, MsQuicConfiguration& ClientConfiguration)
 {
-#ifdef QUIC_API_ENABLE_INSECURE_FEATURES
-    TestScopeLogger LogScope0("QUIC_PARAM_CONN_DISABLE_1RTT_ENCRYPTION");
+    TestScopeLogger LogScope0("QUIC_PARAM_CONN_STREAM_BATCH_RECEIVE_ENABLED");
     MsQuicConnection Connection(Registration);
     TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
-    BOOLEAN Flag = TRUE;
-    //
-    // The peer didn't negotiate the feature
-    //
+    BOOLEAN Flag = FALSE;
     {
+        TestScopeLogger LogScope1("GetParam default");
+        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_STREAM_BATCH_RECEIVE_ENABLED, sizeof(BOOLEAN), &Flag);
+    }
+
+    Flag = TRUE;
+    {
+        TestScopeLogger LogScope1("SetParam");
         {
+            TestScopeLogger LogScope2("QUIC_CONN_BAD_START_STATE");
             MsQuicConnection ConnInval(Registration);
             TEST_QUIC_SUCCEEDED(ConnInval.GetInitStatus());
+            SimulateConnBadStartState(ConnInval, ClientConfiguration);
+
             TEST_QUIC_STATUS(
                 QUIC_STATUS_INVALID_STATE,
                 ConnInval.SetParam(
-                    QUIC_PARAM_CONN_DISABLE_1RTT_ENCRYPTION,
+                    QUIC_PARAM_CONN_STREAM_BATCH_RECEIVE_ENABLED,
                     sizeof(Flag),
                     &Flag));
         }
 
-        //
-        // Good
-        //
-        {
-            TEST_QUIC_SUCCEEDED(
-                Connection.SetParam(
-                    QUIC_PARAM_CONN_DISABLE_1RTT_ENCRYPTION,
-                    sizeof(Flag),
-                    &Flag));
-        }
-    }
-
-    //
-    // GetParam
-    //
-    {
-        TestScopeLogger LogScope1("GetParam");
-        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_DISABLE_1RTT_ENCRYPTION, sizeof(BOOLEAN), &Flag);
-    }
-#else
-    UNREFERENCED_PARAMETER(Registration);
-    UNREFERENCED_PARAMETER(ClientConfiguration);
-#endif
-}
-
-void QuicTest_QUIC_PARAM_CONN_PEER_CERTIFICATE_VALID(MsQuicRegistration& Registration)
-{
-    TestScopeLogger LogScope0("QUIC_PARAM_CONN_PEER_CERTIFICATE_VALID");
-    {
-        TestScopeLogger LogScope1("SetParam");
-        MsQuicConnection Connection(Registration);
-        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_PARAMETER,
+            Connection.SetParam(
+                QUIC_PARAM_CONN_STREAM_BATCH_RECEIVE_ENABLED,
+                sizeof(Flag) + 1,
+                &Flag));
 
-        //
-        // Good with True/False
-        //
-        for (uint8_t i = 0; i < 2; i++) {
-            BOOLEAN Result = FALSE + i;
-            TEST_QUIC_SUCCEEDED(
-                Connection.SetParam(
-                    QUIC_PARAM_CONN_PEER_CERTIFICATE_VALID,
-                    sizeof(Result),
-                    &Result));
-        }
+        TEST_QUIC_SUCCEEDED(
+            Connection.SetParam(
+                QUIC_PARAM_CONN_STREAM_BATCH_RECEIVE_ENABLED,
+                sizeof(Flag),
+                &Flag));
     }
 
     {
-        TestScopeLogger LogScope1("GetParam is not allowed");
+        TestScopeLogger LogScope1("GetParam");
+        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_STREAM_BATCH_RECEIVE_ENABLED, sizeof(BOOLEAN), &Flag);
     }
 }
 
-void QuicTest_QUIC_PARAM_CONN_LOCAL_INTERFACE(MsQuicRegistration& Registration, MsQuicConfiguration& ClientConfiguration)
+void QuicTest_QUIC_PARAM_CONN_LATENCY_HISTOGRAMS(MsQuicRegistration& Registration)
 {
-    TestScopeLogger LogScope0("QUIC_PARAM_CONN_LOCAL_INTERFACE");
-
-    uint32_t Index = 0;
-    //
-    // QUIC_CONN_BAD_START_STATE
-    //
-    {
-        TestScopeLogger LogScope1("QUIC_CONN_BAD_START_STATE");
-        MsQuicConnection Connection(Registration);
-        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
-        SimulateConnBadStartState(Connection, ClientConfiguration);
+    TestScopeLogger LogScope0("QUIC_PARAM_CONN_LATENCY_HISTOGRAMS");
+    MsQuicConnection Connection(Registration);
+    TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+    BOOLEAN Flag = FALSE;
+    {
+        TestScopeLogger LogScope1("GetParam default");
+        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_LATENCY_HISTOGRAMS_ENABLED, sizeof(BOOLEAN), &Flag);
 
+        QUIC_CONNECTION_LATENCY_HISTOGRAMS Histograms;
+        uint32_t Length = sizeof(Histograms);
         TEST_QUIC_STATUS(
             QUIC_STATUS_INVALID_STATE,
-            Connection.SetParam(
-                QUIC_PARAM_CONN_LOCAL_INTERFACE,
-                sizeof(Index),
-                &Index));
+            Connection.GetParam(
+                QUIC_PARAM_CONN_LATENCY_HISTOGRAMS,
+                &Length,
+                &Histograms));
     }
 
-    //
-    // Good
-    //
+    Flag = TRUE;
     {
-        MsQuicConnection Connection(Registration);
-        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+        TestScopeLogger LogScope1("SetParam");
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_PARAMETER,
+            Connection.SetParam(
+                QUIC_PARAM_CONN_LATENCY_HISTOGRAMS_ENABLED,
+                sizeof(Flag) + 1,
+                &Flag));
+
         TEST_QUIC_SUCCEEDED(
             Connection.SetParam(
-                QUIC_PARAM_CONN_LOCAL_INTERFACE,
-                sizeof(Index),
-                &Index));
+                QUIC_PARAM_CONN_LATENCY_HISTOGRAMS_ENABLED,
+                sizeof(Flag),
+                &Flag));
+        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_LATENCY_HISTOGRAMS_ENABLED, sizeof(BOOLEAN), &Flag);
     }
 
     {
-        TestScopeLogger LogScope1("GetParam is not allowed");
+        TestScopeLogger LogScope1("GetParam histograms");
+        uint32_t Length = 0;
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_BUFFER_TOO_SMALL,
+            Connection.GetParam(
+                QUIC_PARAM_CONN_LATENCY_HISTOGRAMS,
+                &Length,
+                nullptr));
+        TEST_EQUAL(Length, sizeof(QUIC_CONNECTION_LATENCY_HISTOGRAMS));
+
+        QUIC_CONNECTION_LATENCY_HISTOGRAMS Histograms;
+        TEST_QUIC_SUCCEEDED(
+            Connection.GetParam(
+                QUIC_PARAM_CONN_LATENCY_HISTOGRAMS,
+                &Length,
+                &Histograms));
+        TEST_EQUAL(Histograms.Rtt.Count, 0ull); // Not started.
+    }
+
+    Flag = FALSE;
+    {
+        TestScopeLogger LogScope1("SetParam disable");
+        TEST_QUIC_SUCCEEDED(
+            Connection.SetParam(
+                QUIC_PARAM_CONN_LATENCY_HISTOGRAMS_ENABLED,
+                sizeof(Flag),
+                &Flag));
+        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_LATENCY_HISTOGRAMS_ENABLED, sizeof(BOOLEAN), &Flag);
     }
 }
 
-void QuicTest_QUIC_PARAM_CONN_TLS_SECRETS(MsQuicRegistration& Registration, MsQuicConfiguration& ClientConfiguration)
+void QuicTest_QUIC_PARAM_CONN_QLOG_ENABLED(MsQuicRegistration& Registration)
 {
-    TestScopeLogger LogScope0("QUIC_PARAM_CONN_TLS_SECRETS");
+    TestScopeLogger LogScope0("QUIC_PARAM_CONN_QLOG_ENABLED");
+    MsQuicConnection Connection(Registration);
+    TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+    BOOLEAN Flag = FALSE;
     {
-        TestScopeLogger LogScope1("SetParam");
-        QUIC_TLS_SECRETS Secrets = {};
-        //
-        // QUIC_CONN_BAD_START_STATE
-        //
-        {
-            TestScopeLogger LogScope2("QUIC_CONN_BAD_START_STATE");
-            MsQuicConnection Connection(Registration);
-            TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
-            SimulateConnBadStartState(Connection, ClientConfiguration);
+        TestScopeLogger LogScope1("GetParam default");
+        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_QLOG_ENABLED, sizeof(BOOLEAN), &Flag);
+    }
 
-            TEST_QUIC_STATUS(
-                QUIC_STATUS_INVALID_STATE,
-                Connection.SetParam(
-                    QUIC_PARAM_CONN_TLS_SECRETS,
-                    sizeof(Secrets),
-                    &Secrets));
-        }
+    Flag = TRUE;
+    {
+        TestScopeLogger LogScope1("SetParam");
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_PARAMETER,
+            Connection.SetParam(
+                QUIC_PARAM_CONN_QLOG_ENABLED,
+                sizeof(Flag) + 1,
+                &Flag));
 
-        //
-        // Good
-        //
-        {
-            MsQuicConnection Connection(Registration);
-            TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
-            TEST_QUIC_SUCCEEDED(
-                Connection.SetParam(
-                    QUIC_PARAM_CONN_TLS_SECRETS,
-                    sizeof(Secrets),
-                    &Secrets));
-        }
+        TEST_QUIC_SUCCEEDED(
+            Connection.SetParam(
+                QUIC_PARAM_CONN_QLOG_ENABLED,
+                sizeof(Flag),
+                &Flag));
+        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_QLOG_ENABLED, sizeof(BOOLEAN), &Flag);
     }
 
+    Flag = FALSE;
     {
-        TestScopeLogger LogScope1("GetParam is not allowed");
+        TestScopeLogger LogScope1("SetParam disable");
+        TEST_QUIC_SUCCEEDED(
+            Connection.SetParam(
+                QUIC_PARAM_CONN_QLOG_ENABLED,
+                sizeof(Flag),
+                &Flag));
+        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_QLOG_ENABLED, sizeof(BOOLEAN), &Flag);
     }
 }
 
-void QuicTest_QUIC_PARAM_CONN_CIBIR_ID(MsQuicRegistration& Registration, MsQuicConfiguration& ClientConfiguration)
+void QuicTest_QUIC_PARAM_CONN_PACKET_CAPTURE_ENABLED(MsQuicRegistration& Registration)
 {
-#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
-    TestScopeLogger LogScope0("QUIC_PARAM_CONN_CIBIR_ID");
+    TestScopeLogger LogScope0("QUIC_PARAM_CONN_PACKET_CAPTURE_ENABLED");
+    MsQuicConnection Connection(Registration);
+    TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+    BOOLEAN Flag = FALSE;
     {
-        TestScopeLogger LogScope1("SetParam");
-        //
-        // QUIC_CONN_BAD_START_STATE
-        //
-        {
-            TestScopeLogger LogScope2("QUIC_CONN_BAD_START_STATE");
-            MsQuicConnection Connection(Registration);
-            TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
-            SimulateConnBadStartState(Connection, ClientConfiguration);
-
-            uint8_t Id[5] = {};
-            TEST_QUIC_STATUS(
-                QUIC_STATUS_INVALID_STATE,
-                Connection.SetParam(
-                    QUIC_PARAM_CONN_CIBIR_ID,
-                    sizeof(Id),
-                    &Id));
-        }
-
-        //
-        // !Connection->State.ShareBinding
-        //
-        {
-            TestScopeLogger LogScope2("SharedBinding is disabled");
-            MsQuicConnection Connection(Registration);
-            TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
-            uint8_t Id[4] = {};
-            TEST_QUIC_STATUS(
-                QUIC_STATUS_INVALID_STATE,
-                Connection.SetParam(
-                    QUIC_PARAM_CONN_CIBIR_ID,
-                    sizeof(Id),
-                    &Id));
-        }
-
-
-        //
-        // CIBIR_ID common
-        //
-        {
-            TestScopeLogger LogScope2("SharedBinding is enabled");
-            MsQuicConnection Connection(Registration);
-            TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
-            BOOLEAN Flag = TRUE;
-            TEST_QUIC_SUCCEEDED(
-                Connection.SetParam(
-                    QUIC_PARAM_CONN_SHARE_UDP_BINDING,
-                    sizeof(Flag),
-                    &Flag));
-
-            // Will be enabled once Listener test is merged
-            // CibirIDTests(Connection.Handle, QUIC_PARAM_CONN_CIBIR_ID);
-        }
+        TestScopeLogger LogScope1("GetParam default");
+        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_PACKET_CAPTURE_ENABLED, sizeof(BOOLEAN), &Flag);
     }
 
+    Flag = TRUE;
     {
-        TestScopeLogger LogScope1("GetParam is not allowed");
+        TestScopeLogger LogScope1("SetParam");
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_PARAMETER,
+            Connection.SetParam(
+                QUIC_PARAM_CONN_PACKET_CAPTURE_ENABLED,
+                sizeof(Flag) + 1,
+                &Flag));
+
+        TEST_QUIC_SUCCEEDED(
+            Connection.SetParam(
+                QUIC_PARAM_CONN_PACKET_CAPTURE_ENABLED,
+                sizeof(Flag),
+                &Flag));
+        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_PACKET_CAPTURE_ENABLED, sizeof(BOOLEAN), &Flag);
     }
-#else
-    UNREFERENCED_PARAMETER(Registration);
-    UNREFERENCED_PARAMETER(ClientConfiguration);
-#endif
 }
 
-void QuicTest_QUIC_PARAM_CONN_STATISTICS_V2(MsQuicRegistration& Registration)
+void QuicTest_QUIC_PARAM_CONN_DATAGRAM_UDP_RELAY(MsQuicRegistration& Registration)
 {
-    TestScopeLogger LogScope0("QUIC_PARAM_CONN_STATISTICS_V2 is get only");
+    TestScopeLogger LogScope0("QUIC_PARAM_CONN_DATAGRAM_UDP_RELAY");
+    MsQuicConnection Connection(Registration);
+    TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+
+    QUIC_DATAGRAM_UDP_RELAY Relay;
+    CxPlatZeroMemory(&Relay, sizeof(Relay));
+    Relay.QuarterStreamId = 1;
+    Relay.RemoteAddress = QuicAddr(QUIC_ADDRESS_FAMILY_INET, true).SockAddr;
+    QuicAddrSetPort(&Relay.RemoteAddress, 4433);
     {
-        TestScopeLogger LogScope1("GetParam");
-        MsQuicConnection Connection(Registration);
-        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
-        uint16_t Dummy = 0;
+        TestScopeLogger LogScope1("SetParam with bad length");
         TEST_QUIC_STATUS(
             QUIC_STATUS_INVALID_PARAMETER,
             Connection.SetParam(
-                QUIC_PARAM_CONN_STATISTICS_V2,
-                sizeof(Dummy),
-                &Dummy));
+                QUIC_PARAM_CONN_DATAGRAM_UDP_RELAY,
+                sizeof(Relay) - 1,
+                &Relay));
     }
 
     {
-        TestScopeLogger LogScope1("GetParam");
-        MsQuicConnection Connection(Registration);
-        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
-        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_STATISTICS_V2, sizeof(QUIC_STATISTICS_V2), nullptr, true);
+        TestScopeLogger LogScope1("SetParam without datagram receive");
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_STATE,
+            Connection.SetParam(
+                QUIC_PARAM_CONN_DATAGRAM_UDP_RELAY,
+                sizeof(Relay),
+                &Relay));
     }
-}
 
-void QuicTest_QUIC_PARAM_CONN_STATISTICS_V2_PLAT(MsQuicRegistration& Registration)
-{
-    TestScopeLogger LogScope0("QUIC_PARAM_CONN_STATISTICS_V2_PLAT");
+    TEST_QUIC_SUCCEEDED(
+        Connection.SetSettings(MsQuicSettings().SetDatagramReceiveEnabled(true)));
+
     {
-        TestScopeLogger LogScope1("GetParam");
-        MsQuicConnection Connection(Registration);
-        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
-        uint16_t Dummy = 0;
+        TestScopeLogger LogScope1("SetParam with an invalid context ID");
+        QUIC_DATAGRAM_UDP_RELAY BadRelay = Relay;
+        BadRelay.ContextId = UINT64_MAX;
         TEST_QUIC_STATUS(
             QUIC_STATUS_INVALID_PARAMETER,
             Connection.SetParam(
-                QUIC_PARAM_CONN_STATISTICS_V2_PLAT,
-                sizeof(Dummy),
-                &Dummy));
+                QUIC_PARAM_CONN_DATAGRAM_UDP_RELAY,
+                sizeof(BadRelay),
+                &BadRelay));
     }
 
     {
-        TestScopeLogger LogScope1("GetParam");
-        MsQuicConnection Connection(Registration);
-        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
-        SimpleGetParamTest(Connection.Handle, QUIC_PARAM_CONN_STATISTICS_V2_PLAT, sizeof(QUIC_STATISTICS_V2), nullptr, true);
+        TestScopeLogger LogScope1("Add and replace");
+        TEST_QUIC_SUCCEEDED(
+            Connection.SetParam(
+                QUIC_PARAM_CONN_DATAGRAM_UDP_RELAY,
+                sizeof(Relay),
+                &Relay));
+        TEST_QUIC_SUCCEEDED(
+            Connection.SetParam(
+                QUIC_PARAM_CONN_DATAGRAM_UDP_RELAY,
+                sizeof(Relay),
+                &Relay));
+    }
+
+    {
+        TestScopeLogger LogScope1("Remove");
+        QuicAddrSetFamily(&Relay.RemoteAddress, QUIC_ADDRESS_FAMILY_UNSPEC);
+        TEST_QUIC_SUCCEEDED(
+            Connection.SetParam(
+                QUIC_PARAM_CONN_DATAGRAM_UDP_RELAY,
+                sizeof(Relay),
+                &Relay));
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_NOT_FOUND,
+            Connection.SetParam(
+                QUIC_PARAM_CONN_DATAGRAM_UDP_RELAY,
+                sizeof(Relay),
+                &Relay));
     }
 }
 
+void QuicTest_QUIC_PARAM_CONN_FLIGHT_RECORDER(MsQuicRegistration& Registration)
+{
+    TestScopeLogger LogScope0("QUIC_PARAM_CONN_FLIGHT_RECORDER");
+    MsQuicConnection Connection(Registration);
+    TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+    {
+        TestScopeLogger LogScope1("SetParam is not allowed");
+        QUIC_FLIGHT_RECORDER_EVENT Event = {};
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_INVALID_PARAMETER,
+            Connection.SetParam(
+                QUIC_PARAM_CONN_FLIGHT_RECORDER,
+                sizeof(Event),
+                &Event));
+    }
 
-void QuicTest_QUIC_PARAM_CONN_ORIG_DEST_CID(MsQuicRegistration& Registration, MsQuicConfiguration& ClientConfiguration) {
-    //
-    // This is the unit test for checking to see if a server has the correct original dest CID.
-    //
-    TestScopeLogger LogScope0("QUIC_PARAM_CONN_ORIG_DEST_CID");
     {
-        MsQuicConnection Connection(Registration);
-        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
-        TEST_QUIC_SUCCEEDED(
-          Connection.Start(
-              ClientConfiguration,
-              QUIC_ADDRESS_FAMILY_INET,
-              "localhost",
-              4433));
-        MsQuic->ConnectionSetConfiguration(Connection.Handle, ClientConfiguration);
+        TestScopeLogger LogScope1("GetParam records API calls");
         //
-        // 8 bytes is the expected minimum size of the CID.
+        // The failed SetParam above was recorded as an API call too.
         //
-        uint32_t SizeOfBuffer = 8;
-        uint8_t Buffer[8] = {0};
-        uint8_t ZeroBuffer[8] = {0};
-        TestScopeLogger LogScope1("GetParam test success case");
+        QUIC_FLIGHT_RECORDER_EVENT Events[2];
+        uint32_t Length = 0;
         TEST_QUIC_STATUS(
-            QUIC_STATUS_SUCCESS,
+            QUIC_STATUS_BUFFER_TOO_SMALL,
             Connection.GetParam(
-                QUIC_PARAM_CONN_ORIG_DEST_CID,
-                &SizeOfBuffer,
-                Buffer
-            )
-        )
-        TEST_NOT_EQUAL(memcmp(Buffer, ZeroBuffer, sizeof(Buffer)), 0);
-    }
-    {
-        MsQuicConnection Connection(Registration);
-        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+                QUIC_PARAM_CONN_FLIGHT_RECORDER,
+                &Length,
+                nullptr));
+        TEST_EQUAL(sizeof(QUIC_FLIGHT_RECORDER_EVENT), Length);
+
+        BOOLEAN Flag = FALSE;
         TEST_QUIC_SUCCEEDED(
-          Connection.Start(
-              ClientConfiguration,
-              QUIC_ADDRESS_FAMILY_INET,
-              "localhost",
-              4433));
-        uint32_t SizeOfBuffer = 8;
-        TestScopeLogger LogScope1("GetParam null buffer check");
+            Connection.SetParam(
+                QUIC_PARAM_CONN_QLOG_ENABLED,
+                sizeof(Flag),
+                &Flag));
+
+        Length = sizeof(Events);
+        TEST_QUIC_SUCCEEDED(
+            Connection.GetParam(
+                QUIC_PARAM_CONN_FLIGHT_RECORDER,
+                &Length,
+                Events));
+        TEST_EQUAL(sizeof(Events), Length);
+        for (uint32_t i = 0; i < ARRAYSIZE(Events); ++i) {
+            TEST_EQUAL((uint32_t)QUIC_FLIGHT_RECORDER_EVENT_API_CALL, Events[i].Type);
+            TEST_EQUAL((uint64_t)QUIC_TRACE_API_SET_PARAM, Events[i].Value);
+        }
+        TEST_TRUE(Events[0].TimeUs <= Events[1].TimeUs);
+    }
+}
+
+void QuicTest_QUIC_PARAM_CONN_MEMORY_USAGE(MsQuicRegistration& Registration)
+{
+    TestScopeLogger LogScope0("QUIC_PARAM_CONN_MEMORY_USAGE");
+    MsQuicConnection Connection(Registration);
+    TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+    {
+        TestScopeLogger LogScope1("SetParam is not allowed");
+        QUIC_MEMORY_USAGE Usage = {};
         TEST_QUIC_STATUS(
             QUIC_STATUS_INVALID_PARAMETER,
-            Connection.GetParam(
-                QUIC_PARAM_CONN_ORIG_DEST_CID,
-                &SizeOfBuffer,
-                nullptr
-            )
-        )
+            Connection.SetParam(
+                QUIC_PARAM_CONN_MEMORY_USAGE,
+                sizeof(Usage),
+                &Usage));
     }
+
     {
-        MsQuicConnection Connection(Registration);
-        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
-        TEST_QUIC_SUCCEEDED(
-          Connection.Start(
-              ClientConfiguration,
-              QUIC_ADDRESS_FAMILY_INET,
-              "localhost",
-              4433));
-        uint32_t SizeOfBuffer = 1;
-        TestScopeLogger LogScope1("GetParam buffer too small check");
-        uint8_t Buffer[1];
+        TestScopeLogger LogScope1("GetParam");
+        QUIC_MEMORY_USAGE Usage = {};
+        uint32_t Length = sizeof(Usage) - 1;
         TEST_QUIC_STATUS(
             QUIC_STATUS_BUFFER_TOO_SMALL,
             Connection.GetParam(
-                QUIC_PARAM_CONN_ORIG_DEST_CID,
-                &SizeOfBuffer,
-                Buffer
-            )
-        )
-    }
-    {
-        MsQuicConnection Connection(Registration);
-        TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+                QUIC_PARAM_CONN_MEMORY_USAGE,
+                &Length,
+                &Usage));
+        TEST_EQUAL(sizeof(Usage), Length);
+
         TEST_QUIC_SUCCEEDED(
-          Connection.Start(
-              ClientConfiguration,
-              QUIC_ADDRESS_FAMILY_INET,
-              "localhost",
-              4433));
-        uint32_t SizeOfBuffer = 100;
-        uint8_t Buffer[100] = {0};
-        uint8_t ZeroBuffer[100] = {0};
-        TestScopeLogger LogScope1("GetParam size of buffer bigger than needed");
-        TEST_QUIC_STATUS(
-            QUIC_STATUS_SUCCESS,
             Connection.GetParam(
-                QUIC_PARAM_CONN_ORIG_DEST_CID,
-                &SizeOfBuffer,
-                Buffer
-            )
-        )
-        TEST_NOT_EQUAL(memcmp(Buffer, ZeroBuffer, sizeof(Buffer)), 0);
+                QUIC_PARAM_CONN_MEMORY_USAGE,
+                &Length,
+                &Usage));
+        TEST_NOT_EQUAL(0u, Usage.ConnectionBytes);
+        TEST_NOT_EQUAL(0u, Usage.PathBytes);
+        TEST_NOT_EQUAL(0u, Usage.PacketSpaceBytes);
+        TEST_EQUAL(0u, Usage.StreamBytes);
+        TEST_EQUAL(0u, Usage.SendBufferBytes);
+
         //
-        // There is no way the CID written should be 100 bytes according to the RFC.
+        // Opening a stream charges the stream object, but nothing else.
         //
-        TEST_TRUE(SizeOfBuffer < 100);
+        MsQuicStream Stream(Connection, QUIC_STREAM_OPEN_FLAG_NONE);
+        TEST_QUIC_SUCCEEDED(Stream.GetInitStatus());
+        TEST_QUIC_SUCCEEDED(
+            Connection.GetParam(
+                QUIC_PARAM_CONN_MEMORY_USAGE,
+                &Length,
+                &Usage));
+        TEST_NOT_EQUAL(0u, Usage.StreamBytes);
+        TEST_EQUAL(0u, Usage.RecvBufferBytes);
     }
+}
+
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+struct CustomCcTestContext {
+    uint32_t ResetCount {0};
+    uint32_t Window {0};
+};
+
+static
+uint32_t
+QUIC_API
+CustomCcTestReset(
+    _In_opt_ void* Context,
+    _In_ BOOLEAN,
+    _In_ uint16_t DatagramPayloadLength
+    )
+{
+    auto TestContext = (CustomCcTestContext*)Context;
+    TestContext->ResetCount++;
+    TestContext->Window = 20 * DatagramPayloadLength;
+    return TestContext->Window;
+}
+
+static
+uint32_t
+QUIC_API
+CustomCcTestOnDataAcknowledged(
+    _In_opt_ void* Context,
+    _In_ const QUIC_CUSTOM_CC_ACK_EVENT*
+    )
+{
+    return ((CustomCcTestContext*)Context)->Window;
+}
+
+static
+uint32_t
+QUIC_API
+CustomCcTestOnDataLost(
+    _In_opt_ void* Context,
+    _In_ const QUIC_CUSTOM_CC_LOSS_EVENT*
+    )
+{
+    return ((CustomCcTestContext*)Context)->Window;
+}
+#endif
+
+void QuicTest_QUIC_PARAM_CONN_CUSTOM_CONGESTION_CONTROL(MsQuicRegistration& Registration, MsQuicConfiguration& ClientConfiguration)
+{
+#ifdef QUIC_API_ENABLE_PREVIEW_FEATURES
+    TestScopeLogger LogScope0("QUIC_PARAM_CONN_CUSTOM_CONGESTION_CONTROL");
+    CustomCcTestContext TestContext;
+    QUIC_CUSTOM_CONGESTION_CONTROL Custom;
+    CxPlatZeroMemory(&Custom, sizeof(Custom));
+    Custom.Name = "Test";
+    Custom.Context = &TestContext;
+    Custom.Reset = CustomCcTestReset;
+    Custom.OnDataAcknowledged = CustomCcTestOnDataAcknowledged;
+    Custom.OnDataLost = CustomCcTestOnDataLost;
     {
+        TestScopeLogger LogScope1("SetParam");
+        {
+            TestScopeLogger LogScope2("QUIC_CONN_BAD_START_STATE");
+            MsQuicConnection ConnInval(Registration);
+            TEST_QUIC_SUCCEEDED(ConnInval.GetInitStatus());
+            SimulateConnBadStartState(ConnInval, ClientConfiguration);
+
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_INVALID_STATE,
+                ConnInval.SetParam(
+                    QUIC_PARAM_CONN_CUSTOM_CONGESTION_CONTROL,
+                    sizeof(Custom),
+                    &Custom));
+        }
+
         MsQuicConnection Connection(Registration);
         TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
-        TEST_QUIC_SUCCEEDED(
-          Connection.Start(
-              ClientConfiguration,
-              QUIC_ADDRESS_FAMILY_INET,
-              "localhost",
-              4433));
-        uint32_t SizeOfBuffer = 0;
-        TestScopeLogger LogScope1("GetParam check OrigDestCID size with nullptr");
+
         TEST_QUIC_STATUS(
-            QUIC_STATUS_BUFFER_TOO_SMALL,
-            Connection.GetParam(
-                QUIC_PARAM_CONN_ORIG_DEST_CID,
-                &SizeOfBuffer,
-                nullptr
-            )
-        )
-        TEST_TRUE(SizeOfBuffer >= 8);
+            QUIC_STATUS_INVALID_PARAMETER,
+            Connection.SetParam(
+                QUIC_PARAM_CONN_CUSTOM_CONGESTION_CONTROL,
+                sizeof(Custom) - 1,
+                &Custom));
+
+        //
+        // Reset, OnDataAcknowledged and OnDataLost are required.
+        //
+        QUIC_CUSTOM_CONGESTION_CONTROL Incomplete = Custom;
+        Incomplete.OnDataLost = nullptr;
         TEST_QUIC_STATUS(
             QUIC_STATUS_INVALID_PARAMETER,
+            Connection.SetParam(
+                QUIC_PARAM_CONN_CUSTOM_CONGESTION_CONTROL,
+                sizeof(Incomplete),
+                &Incomplete));
+        TEST_EQUAL(TestContext.ResetCount, 0u);
+
+        TEST_QUIC_SUCCEEDED(
+            Connection.SetParam(
+                QUIC_PARAM_CONN_CUSTOM_CONGESTION_CONTROL,
+                sizeof(Custom),
+                &Custom));
+        TEST_TRUE(TestContext.ResetCount > 0);
+
+        //
+        // The window returned by the app is the one in use.
+        //
+        QUIC_STATISTICS_V2 Stats;
+        uint32_t StatsLength = sizeof(Stats);
+        TEST_QUIC_SUCCEEDED(
             Connection.GetParam(
-                QUIC_PARAM_CONN_ORIG_DEST_CID,
-                &SizeOfBuffer,
-                nullptr
-            )
-        )
+                QUIC_PARAM_CONN_STATISTICS_V2,
+                &StatsLength,
+                &Stats));
+        TEST_EQUAL(Stats.SendCongestionWindow, TestContext.Window);
     }
+#else
+    UNREFERENCED_PARAMETER(Registration);
+    UNREFERENCED_PARAMETER(ClientConfiguration);
+#endif
 }
 
 void QuicTestConnectionParam()
@@ -4528,6 +6797,23 @@ void QuicTestConnectionParam()
     QuicTest_QUIC_PARAM_CONN_STATISTICS_V2(Registration);
     QuicTest_QUIC_PARAM_CONN_STATISTICS_V2_PLAT(Registration);
     QuicTest_QUIC_PARAM_CONN_ORIG_DEST_CID(Registration, ClientConfiguration);
+    QuicTest_QUIC_PARAM_CONN_SEND_MEMORY_REGION(Registration);
+    QuicTest_QUIC_PARAM_CONN_DATAGRAM_BATCH_RECEIVE_ENABLED(Registration, ClientConfiguration);
+    QuicTest_QUIC_PARAM_CONN_SEND_FLUSH_BUDGET(Registration);
+    QuicTest_QUIC_PARAM_CONN_CUSTOM_CONGESTION_CONTROL(Registration, ClientConfiguration);
+    QuicTest_QUIC_PARAM_CONN_MEMORY_USAGE(Registration);
+    QuicTest_QUIC_PARAM_CONN_SEND_COALESCING_DELAY(Registration);
+    QuicTest_QUIC_PARAM_CONN_STREAM_BATCH_RECEIVE_ENABLED(Registration, ClientConfiguration);
+    QuicTest_QUIC_PARAM_CONN_LATENCY_HISTOGRAMS(Registration);
+    QuicTest_QUIC_PARAM_CONN_QLOG_ENABLED(Registration);
+    QuicTest_QUIC_PARAM_CONN_FLIGHT_RECORDER(Registration);
+    QuicTest_QUIC_PARAM_CONN_PACKET_CAPTURE_ENABLED(Registration);
+    QuicTest_QUIC_PARAM_CONN_DATAGRAM_UDP_RELAY(Registration);
+    QuicTest_QUIC_PARAM_CONN_ADDRESS_RACE_DELAY(Registration);
+    QuicTest_QUIC_PARAM_CONN_DATAGRAM_FEC(Registration);
+    QuicTest_QUIC_PARAM_CONN_STANDBY_PATHS(Registration);
+    QuicTest_QUIC_PARAM_CONN_STREAM_COMPRESSION(Registration);
+    QuicTest_QUIC_PARAM_CONN_DATAGRAM_SEND_POLICY(Registration);
 }
 
 //
@@ -5137,6 +7423,202 @@ void QuicTestStreamParam()
         }
     }
 
+    //
+    // QUIC_PARAM_STREAM_PRIORITY_PARAMETERS
+    //
+    {
+        TestScopeLogger LogScope0("QUIC_PARAM_STREAM_PRIORITY_PARAMETERS");
+        QUIC_STREAM_SCHEDULING_SCHEME Scheme = QUIC_STREAM_SCHEDULING_SCHEME_EXTENSIBLE_PRIORITY;
+        TEST_QUIC_SUCCEEDED(
+            Connection.SetParam(
+                QUIC_PARAM_CONN_STREAM_SCHEDULING_SCHEME,
+                sizeof(Scheme),
+                &Scheme));
+        MsQuicStream Stream(Connection, QUIC_STREAM_OPEN_FLAG_NONE);
+        Stream.Start(QUIC_STREAM_START_FLAG_IMMEDIATE); // IMMEDIATE to set Stream->SendFlags != 0
+
+        //
+        // GetParam default
+        //
+        {
+            TestScopeLogger LogScope1("GetParam default");
+            uint32_t Length = 0;
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_BUFFER_TOO_SMALL,
+                MsQuic->GetParam(
+                    Stream.Handle,
+                    QUIC_PARAM_STREAM_PRIORITY_PARAMETERS,
+                    &Length,
+                    nullptr));
+            TEST_EQUAL(Length, sizeof(QUIC_STREAM_PRIORITY_PARAMETERS));
+
+            QUIC_STREAM_PRIORITY_PARAMETERS Params = {0, TRUE};
+            TEST_QUIC_SUCCEEDED(
+                MsQuic->GetParam(
+                    Stream.Handle,
+                    QUIC_PARAM_STREAM_PRIORITY_PARAMETERS,
+                    &Length,
+                    &Params));
+            TEST_EQUAL(Params.Urgency, QUIC_STREAM_PRIORITY_URGENCY_DEFAULT);
+            TEST_FALSE(Params.Incremental);
+        }
+
+        //
+        // SetParam
+        //
+        {
+            TestScopeLogger LogScope1("SetParam invalid urgency");
+            QUIC_STREAM_PRIORITY_PARAMETERS Params = {QUIC_STREAM_PRIORITY_URGENCY_MAX + 1, FALSE};
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_INVALID_PARAMETER,
+                MsQuic->SetParam(
+                    Stream.Handle,
+                    QUIC_PARAM_STREAM_PRIORITY_PARAMETERS,
+                    sizeof(Params),
+                    &Params));
+        }
+
+        {
+            TestScopeLogger LogScope1("SetParam");
+            QUIC_STREAM_PRIORITY_PARAMETERS Expected = {1, TRUE};
+            TEST_QUIC_SUCCEEDED(
+                MsQuic->SetParam(
+                    Stream.Handle,
+                    QUIC_PARAM_STREAM_PRIORITY_PARAMETERS,
+                    sizeof(Expected),
+                    &Expected));
+
+            QUIC_STREAM_PRIORITY_PARAMETERS Params = {0, FALSE};
+            uint32_t Length = sizeof(Params);
+            TEST_QUIC_SUCCEEDED(
+                MsQuic->GetParam(
+                    Stream.Handle,
+                    QUIC_PARAM_STREAM_PRIORITY_PARAMETERS,
+                    &Length,
+                    &Params));
+            TEST_EQUAL(Params.Urgency, Expected.Urgency);
+            TEST_TRUE(Params.Incremental);
+        }
+
+        //
+        // Requeue the stream under each of the other schemes.
+        //
+        for (uint32_t i = 0; i < QUIC_STREAM_SCHEDULING_SCHEME_COUNT; ++i) {
+            Scheme = (QUIC_STREAM_SCHEDULING_SCHEME)i;
+            TEST_QUIC_SUCCEEDED(
+                Connection.SetParam(
+                    QUIC_PARAM_CONN_STREAM_SCHEDULING_SCHEME,
+                    sizeof(Scheme),
+                    &Scheme));
+        }
+    }
+
+    //
+    // QUIC_PARAM_CONN_STREAM_GROUP and QUIC_PARAM_STREAM_GROUP
+    //
+    {
+        TestScopeLogger LogScope0("QUIC_PARAM_STREAM_GROUP");
+        MsQuicStream Stream(Connection, QUIC_STREAM_OPEN_FLAG_NONE);
+        Stream.Start(QUIC_STREAM_START_FLAG_IMMEDIATE); // IMMEDIATE to set Stream->SendFlags != 0
+
+        {
+            TestScopeLogger LogScope1("GetParam default");
+            uint16_t GroupId = 0;
+            SimpleGetParamTest(Stream.Handle, QUIC_PARAM_STREAM_GROUP, sizeof(GroupId), &GroupId);
+        }
+
+        {
+            TestScopeLogger LogScope1("SetParam unconfigured group");
+            uint16_t GroupId = 1;
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_INVALID_STATE,
+                MsQuic->SetParam(
+                    Stream.Handle,
+                    QUIC_PARAM_STREAM_GROUP,
+                    sizeof(GroupId),
+                    &GroupId));
+        }
+
+        QUIC_STREAM_GROUP_PARAMETERS Group = {
+            1, 0x1000, 0x10, 1, QUIC_STREAM_GROUP_SCHEME_INTERLEAVED };
+        {
+            TestScopeLogger LogScope1("Configure invalid group");
+            QUIC_STREAM_GROUP_PARAMETERS Invalid = Group;
+            Invalid.GroupId = QUIC_STREAM_GROUP_MAX + 1;
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_INVALID_PARAMETER,
+                Connection.SetParam(
+                    QUIC_PARAM_CONN_STREAM_GROUP,
+                    sizeof(Invalid),
+                    &Invalid));
+            Invalid = Group;
+            Invalid.Urgency = QUIC_STREAM_PRIORITY_URGENCY_MAX + 1;
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_INVALID_PARAMETER,
+                Connection.SetParam(
+                    QUIC_PARAM_CONN_STREAM_GROUP,
+                    sizeof(Invalid),
+                    &Invalid));
+        }
+
+        {
+            TestScopeLogger LogScope1("Join group");
+            TEST_QUIC_SUCCEEDED(
+                Connection.SetParam(
+                    QUIC_PARAM_CONN_STREAM_GROUP,
+                    sizeof(Group),
+                    &Group));
+            uint16_t GroupId = Group.GroupId;
+            TEST_QUIC_SUCCEEDED(
+                MsQuic->SetParam(
+                    Stream.Handle,
+                    QUIC_PARAM_STREAM_GROUP,
+                    sizeof(GroupId),
+                    &GroupId));
+            SimpleGetParamTest(Stream.Handle, QUIC_PARAM_STREAM_GROUP, sizeof(GroupId), &GroupId);
+            SimpleGetParamTest(Stream.Handle, QUIC_PARAM_STREAM_PRIORITY, sizeof(Group.Priority), &Group.Priority);
+
+            uint16_t Priority = 0;
+            TEST_QUIC_STATUS(
+                QUIC_STATUS_INVALID_STATE,
+                MsQuic->SetParam(
+                    Stream.Handle,
+                    QUIC_PARAM_STREAM_PRIORITY,
+                    sizeof(Priority),
+                    &Priority));
+        }
+
+        {
+            TestScopeLogger LogScope1("Reconfigure group");
+            Group.Priority = 0x2000;
+            Group.Scheme = QUIC_STREAM_GROUP_SCHEME_SEQUENTIAL;
+            TEST_QUIC_SUCCEEDED(
+                Connection.SetParam(
+                    QUIC_PARAM_CONN_STREAM_GROUP,
+                    sizeof(Group),
+                    &Group));
+            SimpleGetParamTest(Stream.Handle, QUIC_PARAM_STREAM_PRIORITY, sizeof(Group.Priority), &Group.Priority);
+        }
+
+        {
+            TestScopeLogger LogScope1("Leave group");
+            uint16_t GroupId = 0;
+            TEST_QUIC_SUCCEEDED(
+                MsQuic->SetParam(
+                    Stream.Handle,
+                    QUIC_PARAM_STREAM_GROUP,
+                    sizeof(GroupId),
+                    &GroupId));
+            uint16_t Priority = 0x7FFF;
+            TEST_QUIC_SUCCEEDED(
+                MsQuic->SetParam(
+                    Stream.Handle,
+                    QUIC_PARAM_STREAM_PRIORITY,
+                    sizeof(Priority),
+                    &Priority));
+        }
+    }
+
     //
     // QUIC_PARAM_STREAM_STATISTICS
     //
@@ -3955,6 +3955,109 @@ QuicTestStreamBlockUnblockConnFlowControl(
     TEST_TRUE(Context.NeedsStreamCount == 2);
 }
 
+struct ConnectionPoolTestContext {
+    CxPlatEvent ServerStreamStarted;
+    volatile long ServerConnectionCount {0};
+
+    static QUIC_STATUS ServerConnCallback(_In_ MsQuicConnection*, _In_opt_ void* Context, _Inout_ QUIC_CONNECTION_EVENT* Event) {
+        auto TestContext = (ConnectionPoolTestContext*)Context;
+        if (Event->Type == QUIC_CONNECTION_EVENT_CONNECTED) {
+            InterlockedIncrement(&TestContext->ServerConnectionCount);
+        } else if (Event->Type == QUIC_CONNECTION_EVENT_PEER_STREAM_STARTED) {
+            new(std::nothrow) MsQuicStream(Event->PEER_STREAM_STARTED.Stream, CleanUpAutoDelete);
+            TestContext->ServerStreamStarted.Set();
+        }
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    static QUIC_STATUS ClientStreamCallback(_In_ MsQuicStream*, _In_opt_ void* Context, _Inout_ QUIC_STREAM_EVENT* Event) {
+        if (Event->Type == QUIC_STREAM_EVENT_SHUTDOWN_COMPLETE) {
+            ((CxPlatEvent*)Context)->Set();
+        }
+        return QUIC_STATUS_SUCCESS;
+    }
+};
+
+void
+QuicTestConnectionPool(
+    _In_ int Family
+    )
+{
+    const uint32_t StreamCount = 5;
+    const uint32_t IdleTimeoutMs = 100;
+
+    MsQuicRegistration Registration(true);
+    TEST_QUIC_SUCCEEDED(Registration.GetInitStatus());
+
+    MsQuicConfiguration ServerConfiguration(Registration, "MsQuicTest", MsQuicSettings().SetPeerBidiStreamCount(2), ServerSelfSignedCredConfig);
+    TEST_QUIC_SUCCEEDED(ServerConfiguration.GetInitStatus());
+
+    MsQuicConfiguration ClientConfiguration(Registration, "MsQuicTest", MsQuicCredentialConfig());
+    TEST_QUIC_SUCCEEDED(ClientConfiguration.GetInitStatus());
+
+    ConnectionPoolTestContext Context;
+    MsQuicAutoAcceptListener Listener(Registration, ServerConfiguration, ConnectionPoolTestContext::ServerConnCallback, &Context);
+    TEST_QUIC_SUCCEEDED(Listener.GetInitStatus());
+    QUIC_ADDRESS_FAMILY QuicAddrFamily = (Family == 4) ? QUIC_ADDRESS_FAMILY_INET : QUIC_ADDRESS_FAMILY_INET6;
+    QuicAddr ServerLocalAddr(QuicAddrFamily);
+    TEST_QUIC_SUCCEEDED(Listener.Start("MsQuicTest", &ServerLocalAddr.SockAddr));
+    TEST_QUIC_SUCCEEDED(Listener.GetLocalAddr(ServerLocalAddr));
+
+    MsQuicConnectionPool Pool(Registration, 2, IdleTimeoutMs);
+    MsQuicStream* Streams[StreamCount] = {0};
+    CxPlatEvent StreamShutdownComplete[StreamCount];
+    uint8_t RawBuffer[100] = {0};
+    QUIC_BUFFER Buffer { sizeof(RawBuffer), RawBuffer };
+
+    //
+    // The server allows two streams per connection, so the first two streams
+    // share a connection and the next two share a second one. The pool is
+    // then at its limit, so the last stream waits for credits.
+    //
+    const uint32_t ExpectedConnections[StreamCount] = { 1, 1, 2, 2, 2 };
+    for (uint32_t i = 0; i < StreamCount; ++i) {
+        TEST_QUIC_SUCCEEDED(
+            Pool.OpenStream(
+                ClientConfiguration,
+                QUIC_TEST_LOOPBACK_FOR_AF(QuicAddrFamily),
+                ServerLocalAddr.GetPort(),
+                QUIC_STREAM_OPEN_FLAG_NONE,
+                QUIC_STREAM_START_FLAG_IMMEDIATE,
+                CleanUpManual,
+                ConnectionPoolTestContext::ClientStreamCallback,
+                &StreamShutdownComplete[i],
+                &Streams[i]));
+        TEST_QUIC_SUCCEEDED(Streams[i]->Send(&Buffer));
+        TEST_EQUAL(ExpectedConnections[i], Pool.GetConnectionCount());
+        if (i < StreamCount - 1) {
+            //
+            // Once the server has the stream, the client has the server's
+            // stream credits too.
+            //
+            TEST_TRUE(Context.ServerStreamStarted.WaitTimeout(TestWaitTimeout));
+        }
+    }
+    TEST_EQUAL(2, Context.ServerConnectionCount);
+
+    for (uint32_t i = 0; i < StreamCount; ++i) {
+        TEST_QUIC_SUCCEEDED(Streams[i]->Shutdown(0));
+        TEST_TRUE(StreamShutdownComplete[i].WaitTimeout(TestWaitTimeout));
+        delete Streams[i];
+    }
+
+    //
+    // Without streams, both connections are evicted once idle.
+    //
+    CxPlatSleep(2 * IdleTimeoutMs);
+    Pool.EvictIdle();
+    uint32_t Waited = 0;
+    while (Pool.GetConnectionCount() != 0 && Waited < TestWaitTimeout) {
+        CxPlatSleep(10);
+        Waited += 10;
+    }
+    TEST_EQUAL(0u, Pool.GetConnectionCount());
+}
+
 void
 QuicTestConnectAndIdleForDestCidChange(
     void
@@ -224,6 +224,25 @@ QuicTestDatagramSend(
                 }
                 TEST_EQUAL(1, Client.GetDatagramsAcknowledged());
 
+                //
+                // Each buffer of a batch is sent as its own datagram.
+                //
+                const QUIC_BUFFER DatagramBatch[] = { DatagramBuffer, DatagramBuffer, DatagramBuffer };
+                TEST_QUIC_SUCCEEDED(
+                    MsQuic->DatagramSendBatch(
+                        Client.GetConnection(),
+                        DatagramBatch,
+                        ARRAYSIZE(DatagramBatch),
+                        QUIC_SEND_FLAG_NONE,
+                        nullptr));
+
+                Tries = 0;
+                while (Client.GetDatagramsAcknowledged() != 4 && ++Tries < 10) {
+                    CxPlatSleep(100);
+                }
+                TEST_EQUAL(4, Client.GetDatagramsSent());
+                TEST_EQUAL(4, Client.GetDatagramsAcknowledged());
+
 #if QUIC_TEST_DATAPATH_HOOKS_ENABLED
                 const uint32_t InitialLostCount = Client.GetDatagramsSuspectLost();
                 LossHelper.DropPackets(1);
@@ -237,10 +256,10 @@ QuicTestDatagramSend(
                         nullptr));
 
                 Tries = 0;
-                while (Client.GetDatagramsSent() != 2 && ++Tries < 10) {
+                while (Client.GetDatagramsSent() != 5 && ++Tries < 10) {
                     CxPlatSleep(100);
                 }
-                TEST_EQUAL(2, Client.GetDatagramsSent());
+                TEST_EQUAL(5, Client.GetDatagramsSent());
 
                 //
                 // Even though the test only drops a single packet, it is
@@ -119,3 +119,65 @@ QuicTestLocalPathChanges(
         PeerStreamsChanged.Reset();
     }
 }
+
+void
+QuicTestLocalAddressMigration(
+    _In_ int Family
+    )
+{
+    PathTestContext Context;
+    CxPlatEvent PeerStreamsChanged;
+    MsQuicRegistration Registration{true};
+    TEST_QUIC_SUCCEEDED(Registration.GetInitStatus());
+
+    MsQuicConfiguration ServerConfiguration(Registration, "MsQuicTest", ServerSelfSignedCredConfig);
+    TEST_QUIC_SUCCEEDED(ServerConfiguration.GetInitStatus());
+
+    MsQuicConfiguration ClientConfiguration(Registration, "MsQuicTest", MsQuicCredentialConfig{});
+    TEST_QUIC_SUCCEEDED(ClientConfiguration.GetInitStatus());
+
+    MsQuicAutoAcceptListener Listener(Registration, ServerConfiguration, PathTestContext::ConnCallback, &Context);
+    TEST_QUIC_SUCCEEDED(Listener.GetInitStatus());
+    QUIC_ADDRESS_FAMILY QuicAddrFamily = (Family == 4) ? QUIC_ADDRESS_FAMILY_INET : QUIC_ADDRESS_FAMILY_INET6;
+    QuicAddr ServerLocalAddr(QuicAddrFamily);
+    TEST_QUIC_SUCCEEDED(Listener.Start("MsQuicTest", &ServerLocalAddr.SockAddr));
+    TEST_QUIC_SUCCEEDED(Listener.GetLocalAddr(ServerLocalAddr));
+
+    MsQuicConnection Connection(Registration, CleanUpManual, ClientCallback, &PeerStreamsChanged);
+    TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+
+    TEST_QUIC_SUCCEEDED(Connection.Start(ClientConfiguration, ServerLocalAddr.GetFamily(), QUIC_TEST_LOOPBACK_FOR_AF(ServerLocalAddr.GetFamily()), ServerLocalAddr.GetPort()));
+    TEST_TRUE(Connection.HandshakeCompleteEvent.WaitTimeout(TestWaitTimeout));
+    TEST_NOT_EQUAL(nullptr, Context.Connection);
+    TEST_TRUE(Context.Connection->HandshakeCompleteEvent.WaitTimeout(TestWaitTimeout));
+
+    QUIC_STATISTICS_V2 Stats;
+    TEST_QUIC_SUCCEEDED(Connection.GetStatistics(&Stats));
+    const uint32_t DestCidUpdateCount = Stats.DestCidUpdateCount;
+
+    QuicAddr OrigLocalAddr;
+    TEST_QUIC_SUCCEEDED(Connection.GetLocalAddr(OrigLocalAddr));
+
+    //
+    // Move the client to a new (ephemeral) local port. The new path should be
+    // used right away and with a fresh destination CID.
+    //
+    QuicAddr NewLocalAddr(OrigLocalAddr, 0);
+    TEST_QUIC_SUCCEEDED(Connection.SetLocalAddr(NewLocalAddr));
+    TEST_QUIC_SUCCEEDED(Connection.GetLocalAddr(NewLocalAddr));
+    TEST_NOT_EQUAL(OrigLocalAddr.GetPort(), NewLocalAddr.GetPort());
+
+    TEST_TRUE(Context.PeerAddrChangedEvent.WaitTimeout(TestWaitTimeout));
+    QuicAddr ServerRemoteAddr;
+    TEST_QUIC_SUCCEEDED(Context.Connection->GetRemoteAddr(ServerRemoteAddr));
+    TEST_TRUE(QuicAddrCompare(&NewLocalAddr.SockAddr, &ServerRemoteAddr.SockAddr));
+
+    TEST_QUIC_SUCCEEDED(Connection.GetStatistics(&Stats));
+    TEST_TRUE(Stats.DestCidUpdateCount > DestCidUpdateCount);
+
+    //
+    // The server raises the stream count on each address change, which is
+    // only seen by the client if data flows on the new path.
+    //
+    TEST_TRUE(PeerStreamsChanged.WaitTimeout(TestWaitTimeout));
+}
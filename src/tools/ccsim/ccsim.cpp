@@ -0,0 +1,854 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Congestion control simulator. Drives the core library's congestion control
+    algorithms with a single bulk sender over a simulated bottleneck link, in
+    virtual time, and reports throughput, queuing delay and retransmissions.
+
+    The simulator plays the part of loss detection and the send path: it keeps
+    the sent packet metadata, samples RTT, detects losses by packet and time
+    threshold, fires PTOs and honors the pacing allowance, all the same way the
+    core library does. The link is either a fixed rate FIFO with a drop-tail
+    buffer, or replays a recorded delivery trace. Everything is driven by a
+    seeded random generator, so runs are reproducible.
+
+--*/
+
+#pragma warning(disable:4200)  // nonstandard extension used: bit field types other than int
+#pragma warning(disable:4201)  // nonstandard extension used: nameless struct/union
+#pragma warning(disable:4204)  // nonstandard extension used: non-constant aggregate initializer
+#pragma warning(disable:4214)  // nonstandard extension used: zero-sized array in struct/union
+
+#include "precomp.h" // from 'core' dir
+#include "msquichelper.h"
+
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <queue>
+#include <random>
+#include <vector>
+
+#define SIM_DEFAULT_BANDWIDTH_KBPS  100000
+#define SIM_DEFAULT_RTT_MS          40
+#define SIM_DEFAULT_DURATION_MS     10000
+#define SIM_DEFAULT_MTU             1500
+#define SIM_DEFAULT_ACK_FREQUENCY   2
+
+//
+// Each delivery opportunity in a trace carries one packet of up to this size.
+//
+#define SIM_TRACE_OPPORTUNITY_SIZE  1500
+
+struct SimConfig {
+    QUIC_CONGESTION_CONTROL_ALGORITHM Algorithm {QUIC_CONGESTION_CONTROL_ALGORITHM_CUBIC};
+    uint64_t BandwidthBps {SIM_DEFAULT_BANDWIDTH_KBPS * 1000ull};
+    uint64_t OneWayDelayUs {MS_TO_US(SIM_DEFAULT_RTT_MS) / 2};
+    uint64_t BufferBytes {0};
+    double LossRate {0};
+    uint64_t AckAggregationUs {0};
+    uint32_t AckFrequency {SIM_DEFAULT_ACK_FREQUENCY};
+    uint64_t EcnThresholdUs {0};
+    uint64_t DurationUs {MS_TO_US(SIM_DEFAULT_DURATION_MS)};
+    uint64_t SampleIntervalUs {0};
+    uint64_t Seed {1};
+    uint16_t Mtu {SIM_DEFAULT_MTU};
+    BOOLEAN PacingEnabled {TRUE};
+    BOOLEAN HyStartEnabled {FALSE};
+    std::vector<uint64_t> Trace; // Delivery opportunities, in microseconds.
+};
+
+enum SimEventType {
+    SIM_EVENT_RECEIVE,
+    SIM_EVENT_ACK_TIMER,
+    SIM_EVENT_ACK,
+    SIM_EVENT_FLUSH,
+    SIM_EVENT_PTO,
+    SIM_EVENT_SAMPLE,
+};
+
+struct SimEvent {
+    uint64_t Time;
+    uint64_t Sequence; // Keeps events with equal times in FIFO order.
+    SimEventType Type;
+    uint64_t Value;
+    BOOLEAN Ce;
+    bool operator>(const SimEvent& Other) const {
+        return Time != Other.Time ? Time > Other.Time : Sequence > Other.Sequence;
+    }
+};
+
+struct SimAck {
+    std::vector<uint64_t> PacketNumbers;
+    uint64_t CeCount;
+    uint64_t AckDelay;
+    uint64_t SendTime;
+};
+
+//
+// The bottleneck link. Packets queue in a drop-tail buffer and leave either at
+// the configured rate or at the trace's delivery opportunities.
+//
+class SimLink {
+    const SimConfig& Config;
+    std::deque<std::pair<uint64_t, uint16_t>> Queue; // Departure time, length.
+    uint64_t QueuedBytes {0};
+    uint64_t FreeTimeNs {0};
+    uint64_t NextOpportunity {0};
+
+    uint64_t OpportunityTime(uint64_t Index) const {
+        const uint64_t Count = Config.Trace.size();
+        return TimeStart + Config.Trace[Index % Count] + (Index / Count) * Config.Trace.back();
+    }
+
+public:
+    uint64_t TimeStart {0};
+    uint64_t DroppedPackets {0};
+
+    SimLink(const SimConfig& Config) : Config(Config) { }
+
+    //
+    // Returns FALSE if the packet is dropped. Otherwise returns when it leaves
+    // the link.
+    //
+    BOOLEAN
+    Enqueue(
+        _In_ uint64_t TimeNow,
+        _In_ uint16_t Length,
+        _Out_ uint64_t* Departure
+        ) {
+        while (!Queue.empty() && Queue.front().first <= TimeNow) {
+            QueuedBytes -= Queue.front().second;
+            Queue.pop_front();
+        }
+        if (QueuedBytes + Length > Config.BufferBytes) {
+            DroppedPackets++;
+            return FALSE;
+        }
+        if (Config.Trace.empty()) {
+            //
+            // Track the link in nanoseconds so that rounding doesn't add up.
+            //
+            const uint64_t StartNs = CXPLAT_MAX(TimeNow * 1000, FreeTimeNs);
+            FreeTimeNs = StartNs + (Length * 8ull * 1000000000ull) / Config.BandwidthBps;
+            *Departure = (FreeTimeNs + 999) / 1000;
+        } else {
+            //
+            // Opportunities that pass while the queue is empty are wasted.
+            //
+            while (OpportunityTime(NextOpportunity) < TimeNow) {
+                NextOpportunity++;
+            }
+            *Departure = OpportunityTime(NextOpportunity++);
+        }
+        Queue.emplace_back(*Departure, Length);
+        QueuedBytes += Length;
+        return TRUE;
+    }
+
+    uint64_t GetQueuedBytes() const { return QueuedBytes; }
+};
+
+class Simulator {
+    const SimConfig& Config;
+    SimLink Link;
+    std::mt19937_64 Random;
+    std::priority_queue<SimEvent, std::vector<SimEvent>, std::greater<SimEvent>> Events;
+    uint64_t EventSequence {0};
+    uint64_t TimeStart {0};
+    uint64_t TimeNow {0};
+
+    QUIC_CONNECTION* Connection {nullptr};
+    QUIC_CONGESTION_CONTROL* Cc {nullptr};
+    uint16_t PacketLength {0};
+
+    //
+    // Sender (loss detection and send) state.
+    //
+    std::map<uint64_t, QUIC_SENT_PACKET_METADATA*> Outstanding;
+    uint64_t NextPacketNumber {0};
+    uint64_t LargestAck {UINT64_MAX};
+    uint64_t TotalBytesSent {0};
+    uint64_t TotalBytesAcked {0};
+    uint64_t TotalBytesSentAtLastAck {0};
+    uint64_t TimeOfLastPacketAcked {0};
+    uint64_t TimeOfLastAckedPacketSent {0};
+    uint64_t AdjustedLastAckedTime {0};
+    uint64_t LastSendTime {0};
+    uint64_t PeerCeCount {0};
+    uint32_t PtoCount {0};
+    uint64_t PtoGeneration {0};
+    BOOLEAN FlushScheduled {FALSE};
+
+    //
+    // Receiver state.
+    //
+    std::vector<uint64_t> PendingAcks;
+    uint64_t ExpectedPacketNumber {0};
+    uint64_t LargestReceivedTime {0};
+    uint64_t ReceivedCeCount {0};
+    uint64_t AckTimerGeneration {0};
+    BOOLEAN AckTimerArmed {FALSE};
+    std::map<uint64_t, SimAck> AcksInFlight;
+    uint64_t NextAckId {0};
+
+    //
+    // Results.
+    //
+    enum : uint8_t { PACKET_DELIVERED = 1, PACKET_LOST = 2 };
+    std::vector<uint8_t> PacketState;
+    std::vector<uint32_t> QueueDelays;
+    uint64_t GoodputBytes {0};
+    uint64_t PacketsSent {0};
+    uint64_t PacketsLost {0};
+    uint64_t RandomDrops {0};
+    uint64_t PtoCountTotal {0};
+    uint64_t SrttSum {0};
+    uint64_t SrttSamples {0};
+
+    void Schedule(uint64_t Time, SimEventType Type, uint64_t Value = 0, BOOLEAN Ce = FALSE) {
+        Events.push({Time, EventSequence++, Type, Value, Ce});
+    }
+
+    uint64_t GetPtoPeriod() const {
+        const QUIC_PATH* Path = &Connection->Paths[0];
+        uint64_t Pto =
+            Path->SmoothedRtt +
+            CXPLAT_MAX(4 * Path->RttVariance, (uint64_t)MS_TO_US(1)) +
+            MS_TO_US(QUIC_TP_MAX_ACK_DELAY_DEFAULT);
+        return Pto << CXPLAT_MIN(PtoCount, 8u);
+    }
+
+    void ArmPto() {
+        if (!Outstanding.empty()) {
+            Schedule(LastSendTime + GetPtoPeriod(), SIM_EVENT_PTO, ++PtoGeneration);
+        }
+    }
+
+    void SendPacket() {
+        QUIC_SENT_PACKET_METADATA* Packet =
+            (QUIC_SENT_PACKET_METADATA*)CXPLAT_ALLOC_NONPAGED(sizeof(QUIC_SENT_PACKET_METADATA), QUIC_POOL_TOOL);
+        CXPLAT_FRE_ASSERT(Packet != nullptr);
+        CxPlatZeroMemory(Packet, sizeof(*Packet));
+
+        Packet->PacketNumber = NextPacketNumber++;
+        Packet->PacketLength = PacketLength;
+        Packet->SentTime = TimeNow;
+        Packet->Flags.IsAckEliciting = TRUE;
+        Packet->Flags.IsAppLimited = QuicCongestionControlIsAppLimited(Cc);
+        TotalBytesSent += PacketLength;
+        Packet->TotalBytesSent = TotalBytesSent;
+        if (TimeOfLastPacketAcked != 0) {
+            Packet->Flags.HasLastAckedPacketInfo = TRUE;
+            Packet->LastAckedPacketInfo.SentTime = TimeOfLastAckedPacketSent;
+            Packet->LastAckedPacketInfo.AckTime = TimeOfLastPacketAcked;
+            Packet->LastAckedPacketInfo.AdjustedAckTime = AdjustedLastAckedTime;
+            Packet->LastAckedPacketInfo.TotalBytesSent = TotalBytesSentAtLastAck;
+            Packet->LastAckedPacketInfo.TotalBytesAcked = TotalBytesAcked;
+        }
+        Outstanding[Packet->PacketNumber] = Packet;
+        PacketState.push_back(0);
+        PacketsSent++;
+        LastSendTime = TimeNow;
+
+        Connection->Send.NextPacketNumber = NextPacketNumber;
+        QuicCongestionControlOnDataSent(Cc, PacketLength);
+
+        std::uniform_real_distribution<double> Uniform(0.0, 1.0);
+        uint64_t Departure;
+        if (Config.LossRate > 0 && Uniform(Random) < Config.LossRate) {
+            RandomDrops++;
+        } else if (Link.Enqueue(TimeNow, PacketLength, &Departure)) {
+            const uint64_t QueueDelay = Departure - TimeNow;
+            const BOOLEAN Ce =
+                Config.EcnThresholdUs != 0 && QueueDelay > Config.EcnThresholdUs;
+            QueueDelays.push_back((uint32_t)CXPLAT_MIN(QueueDelay, UINT32_MAX));
+            Schedule(Departure + Config.OneWayDelayUs, SIM_EVENT_RECEIVE, Packet->PacketNumber, Ce);
+        }
+    }
+
+    //
+    // Mirrors a send flush: the congestion control's allowance is computed
+    // once, and the flush is retried after the pacing interval if pacing,
+    // rather than the congestion window, is what stopped it.
+    //
+    void Flush() {
+        const uint64_t TimeSinceLastSend =
+            Connection->Send.LastFlushTimeValid ?
+                CxPlatTimeDiff64(Connection->Send.LastFlushTime, TimeNow) : 0;
+        uint32_t Allowance =
+            QuicCongestionControlGetSendAllowance(
+                Cc, TimeSinceLastSend, Connection->Send.LastFlushTimeValid);
+        Connection->Send.LastFlushTime = TimeNow;
+        Connection->Send.LastFlushTimeValid = TRUE;
+
+        while (Allowance > 0) {
+            SendPacket();
+            Allowance = Allowance > PacketLength ? Allowance - PacketLength : 0;
+        }
+        ArmPto();
+
+        if (QuicCongestionControlCanSend(Cc) && !FlushScheduled) {
+            FlushScheduled = TRUE;
+            Schedule(TimeNow + QUIC_SEND_PACING_INTERVAL, SIM_EVENT_FLUSH);
+        }
+    }
+
+    void DetectLostPackets() {
+        if (LargestAck == UINT64_MAX) {
+            return;
+        }
+        const QUIC_PATH* Path = &Connection->Paths[0];
+        const uint64_t LossDelay =
+            CXPLAT_MAX(
+                QUIC_TIME_REORDER_THRESHOLD(CXPLAT_MAX(Path->LatestRttSample, Path->SmoothedRtt)),
+                (uint64_t)MS_TO_US(1));
+
+        uint64_t LargestLost = 0;
+        uint32_t LostBytes = 0;
+        while (!Outstanding.empty()) {
+            QUIC_SENT_PACKET_METADATA* Packet = Outstanding.begin()->second;
+            if (Packet->PacketNumber > LargestAck ||
+                (Packet->PacketNumber + QUIC_PACKET_REORDER_THRESHOLD > LargestAck &&
+                 CxPlatTimeDiff64(Packet->SentTime, TimeNow) < LossDelay)) {
+                break; // Later packets are neither older nor further behind.
+            }
+            Outstanding.erase(Outstanding.begin());
+            LargestLost = Packet->PacketNumber;
+            LostBytes += Packet->PacketLength;
+            PacketsLost++;
+            if (PacketState[Packet->PacketNumber] & PACKET_DELIVERED) {
+                GoodputBytes -= Packet->PacketLength;
+            }
+            PacketState[Packet->PacketNumber] |= PACKET_LOST;
+            CXPLAT_FREE(Packet, QUIC_POOL_TOOL);
+        }
+
+        if (LostBytes != 0) {
+            QUIC_LOSS_EVENT LossEvent;
+            CxPlatZeroMemory(&LossEvent, sizeof(LossEvent));
+            LossEvent.LargestPacketNumberLost = LargestLost;
+            LossEvent.LargestSentPacketNumber = NextPacketNumber - 1;
+            LossEvent.NumRetransmittableBytes = LostBytes;
+            QuicCongestionControlOnDataLost(Cc, &LossEvent);
+        }
+    }
+
+    void OnReceive(uint64_t PacketNumber, BOOLEAN Ce) {
+        if (!(PacketState[PacketNumber] & PACKET_LOST)) {
+            GoodputBytes += PacketLength;
+        }
+        PacketState[PacketNumber] |= PACKET_DELIVERED;
+
+        const BOOLEAN OutOfOrder = PacketNumber != ExpectedPacketNumber;
+        if (PacketNumber >= ExpectedPacketNumber) {
+            ExpectedPacketNumber = PacketNumber + 1;
+            LargestReceivedTime = TimeNow;
+        }
+        if (Ce) {
+            ReceivedCeCount++;
+        }
+        PendingAcks.push_back(PacketNumber);
+
+        if (PendingAcks.size() >= Config.AckFrequency || OutOfOrder || Ce) {
+            SendAck();
+        } else if (!AckTimerArmed) {
+            AckTimerArmed = TRUE;
+            Schedule(
+                TimeNow + MS_TO_US(QUIC_TP_MAX_ACK_DELAY_DEFAULT),
+                SIM_EVENT_ACK_TIMER,
+                ++AckTimerGeneration);
+        }
+    }
+
+    void SendAck() {
+        if (PendingAcks.empty()) {
+            return;
+        }
+        SimAck Ack;
+        Ack.PacketNumbers.swap(PendingAcks);
+        Ack.CeCount = ReceivedCeCount;
+        Ack.AckDelay = TimeNow - LargestReceivedTime;
+        Ack.SendTime = TimeNow;
+        if (Config.AckAggregationUs != 0) {
+            //
+            // Aggregation holds ACKs in the network, so it isn't part of the
+            // ACK delay reported by the receiver.
+            //
+            Ack.SendTime =
+                ((TimeNow + Config.AckAggregationUs - 1) / Config.AckAggregationUs) *
+                Config.AckAggregationUs;
+        }
+        AckTimerArmed = FALSE;
+        ++AckTimerGeneration;
+
+        const uint64_t AckId = NextAckId++;
+        Schedule(Ack.SendTime + Config.OneWayDelayUs, SIM_EVENT_ACK, AckId);
+        AcksInFlight.emplace(AckId, std::move(Ack));
+    }
+
+    void OnAck(const SimAck& Ack) {
+        QUIC_PATH* Path = &Connection->Paths[0];
+        QUIC_SENT_PACKET_METADATA* AckedPackets = nullptr;
+        QUIC_SENT_PACKET_METADATA** AckedPacketsTail = &AckedPackets;
+        uint32_t AckedBytes = 0;
+        uint64_t MinRtt = UINT64_MAX;
+        BOOLEAN NewLargestAck = FALSE;
+        BOOLEAN IsLargestAckedPacketAppLimited = FALSE;
+        uint64_t LargestAckSentTime = 0;
+
+        for (uint64_t PacketNumber : Ack.PacketNumbers) {
+            auto It = Outstanding.find(PacketNumber);
+            if (It == Outstanding.end()) {
+                continue; // Already declared lost.
+            }
+            QUIC_SENT_PACKET_METADATA* Packet = It->second;
+            Outstanding.erase(It);
+
+            MinRtt = CXPLAT_MIN(MinRtt, CxPlatTimeDiff64(Packet->SentTime, TimeNow));
+            if (LargestAck == UINT64_MAX || LargestAck < PacketNumber) {
+                LargestAck = PacketNumber;
+                LargestAckSentTime = Packet->SentTime;
+                IsLargestAckedPacketAppLimited = Packet->Flags.IsAppLimited;
+                NewLargestAck = TRUE;
+            }
+
+            AckedBytes += Packet->PacketLength;
+            TotalBytesAcked += Packet->PacketLength;
+            TotalBytesSentAtLastAck = Packet->TotalBytesSent;
+            TimeOfLastPacketAcked = TimeNow;
+            TimeOfLastAckedPacketSent = Packet->SentTime;
+            AdjustedLastAckedTime = TimeNow - Ack.AckDelay;
+
+            Packet->Next = nullptr;
+            *AckedPacketsTail = Packet;
+            AckedPacketsTail = &Packet->Next;
+        }
+
+        if (NewLargestAck) {
+            uint64_t LatestRtt = MinRtt;
+            if (LatestRtt >= Ack.AckDelay) {
+                LatestRtt -= Ack.AckDelay;
+            }
+            QuicConnUpdateRtt(
+                Connection,
+                Path,
+                LatestRtt,
+                LargestAckSentTime - TimeStart,
+                Ack.SendTime - TimeStart);
+            SrttSum += Path->SmoothedRtt;
+            SrttSamples++;
+
+            if (Config.EcnThresholdUs != 0 && Ack.CeCount > PeerCeCount) {
+                QUIC_ECN_EVENT EcnEvent;
+                EcnEvent.LargestPacketNumberAcked = LargestAck;
+                EcnEvent.LargestSentPacketNumber = NextPacketNumber - 1;
+                EcnEvent.NewCeCount = Ack.CeCount - PeerCeCount;
+                PeerCeCount = Ack.CeCount;
+                QuicCongestionControlOnEcn(Cc, &EcnEvent);
+            }
+
+            DetectLostPackets();
+        }
+
+        if (NewLargestAck || AckedBytes > 0) {
+            QUIC_ACK_EVENT AckEvent;
+            CxPlatZeroMemory(&AckEvent, sizeof(AckEvent));
+            AckEvent.TimeNow = TimeNow;
+            AckEvent.LargestAck = LargestAck;
+            AckEvent.LargestSentPacketNumber = NextPacketNumber - 1;
+            AckEvent.NumRetransmittableBytes = AckedBytes;
+            AckEvent.SmoothedRtt = Path->SmoothedRtt;
+            AckEvent.MinRtt = MinRtt;
+            AckEvent.OneWayDelay = Path->OneWayDelay;
+            AckEvent.AdjustedAckTime = TimeNow - Ack.AckDelay;
+            AckEvent.AckedPackets = AckedPackets;
+            AckEvent.NumTotalAckedRetransmittableBytes = TotalBytesAcked;
+            AckEvent.IsLargestAckedPacketAppLimited = IsLargestAckedPacketAppLimited;
+            AckEvent.MinRttValid = MinRtt != UINT64_MAX;
+            if (QuicCongestionControlOnDataAcknowledged(Cc, &AckEvent)) {
+                //
+                // Unblocked. The algorithm resets the last flush time with the
+                // real clock, so set it back to virtual time.
+                //
+                Connection->Send.LastFlushTime = TimeNow;
+            }
+        }
+
+        while (AckedPackets != nullptr) {
+            QUIC_SENT_PACKET_METADATA* Packet = AckedPackets;
+            AckedPackets = AckedPackets->Next;
+            CXPLAT_FREE(Packet, QUIC_POOL_TOOL);
+        }
+
+        if (AckedBytes > 0) {
+            PtoCount = 0;
+        }
+        Flush();
+    }
+
+    void OnPto() {
+        DetectLostPackets();
+        if (Outstanding.empty()) {
+            return;
+        }
+        PtoCount++;
+        PtoCountTotal++;
+        QuicCongestionControlSetExemption(Cc, 2);
+        SendPacket();
+        SendPacket();
+        ArmPto();
+    }
+
+    void PrintSample() {
+        printf("%10.3f %12u %12u %12llu %10.3f\n",
+            (double)(TimeNow - TimeStart) / 1000.0,
+            QuicCongestionControlGetCongestionWindow(Cc),
+            (uint32_t)(Outstanding.size() * PacketLength),
+            (unsigned long long)Link.GetQueuedBytes(),
+            (double)Connection->Paths[0].SmoothedRtt / 1000.0);
+    }
+
+public:
+    Simulator(const SimConfig& Config) : Config(Config), Link(Config), Random(Config.Seed) { }
+
+    ~Simulator() {
+        for (auto& Entry : Outstanding) {
+            CXPLAT_FREE(Entry.second, QUIC_POOL_TOOL);
+        }
+        if (Connection != nullptr) {
+            CXPLAT_FREE(Connection, QUIC_POOL_TOOL);
+        }
+    }
+
+    BOOLEAN Initialize() {
+        //
+        // The congestion control algorithms only need the connection's
+        // settings, its first path and a few send fields.
+        //
+        Connection = (QUIC_CONNECTION*)CXPLAT_ALLOC_NONPAGED(sizeof(QUIC_CONNECTION), QUIC_POOL_TOOL);
+        if (Connection == nullptr) {
+            return FALSE;
+        }
+        CxPlatZeroMemory(Connection, sizeof(*Connection));
+        QuicSettingsSetDefault(&Connection->Settings);
+        Connection->Settings.CongestionControlAlgorithm = (uint16_t)Config.Algorithm;
+        Connection->Settings.PacingEnabled = Config.PacingEnabled;
+        Connection->Settings.HyStartEnabled = Config.HyStartEnabled;
+        Connection->Settings.EcnEnabled = Config.EcnThresholdUs != 0;
+
+        QUIC_PATH* Path = &Connection->Paths[0];
+        Connection->PathsCount = 1;
+        Path->InUse = TRUE;
+        Path->IsActive = TRUE;
+        Path->Mtu = Config.Mtu;
+        Path->MinRtt = UINT32_MAX;
+        Path->SmoothedRtt = MS_TO_US(Connection->Settings.InitialRttMs);
+        Path->RttVariance = Path->SmoothedRtt / 2;
+        QuicAddrSetFamily(&Path->Route.RemoteAddress, QUIC_ADDRESS_FAMILY_INET);
+        PacketLength = QuicPathGetDatagramPayloadSize(Path);
+
+        //
+        // Some algorithms stamp their state with the real clock when they are
+        // initialized, so start virtual time there.
+        //
+        TimeStart = TimeNow = CxPlatTimeUs64();
+        Connection->Stats.Timing.Start = TimeStart;
+        Link.TimeStart = TimeStart;
+
+        Cc = &Connection->CongestionControl;
+        QuicCongestionControlInitialize(Cc, &Connection->Settings);
+        return TRUE;
+    }
+
+    void Run() {
+        const uint64_t TimeEnd = TimeStart + Config.DurationUs;
+        Schedule(TimeStart, SIM_EVENT_FLUSH);
+        if (Config.SampleIntervalUs != 0) {
+            printf("%10s %12s %12s %12s %10s\n", "Time(ms)", "Cwnd", "InFlight", "Queued", "SRTT(ms)");
+            Schedule(TimeStart, SIM_EVENT_SAMPLE);
+        }
+
+        while (!Events.empty() && Events.top().Time <= TimeEnd) {
+            const SimEvent Event = Events.top();
+            Events.pop();
+            TimeNow = Event.Time;
+
+            switch (Event.Type) {
+            case SIM_EVENT_RECEIVE:
+                OnReceive(Event.Value, Event.Ce);
+                break;
+            case SIM_EVENT_ACK_TIMER:
+                if (AckTimerArmed && Event.Value == AckTimerGeneration) {
+                    SendAck();
+                }
+                break;
+            case SIM_EVENT_ACK: {
+                auto It = AcksInFlight.find(Event.Value);
+                OnAck(It->second);
+                AcksInFlight.erase(It);
+                break;
+            }
+            case SIM_EVENT_FLUSH:
+                FlushScheduled = FALSE;
+                Flush();
+                break;
+            case SIM_EVENT_PTO:
+                if (Event.Value == PtoGeneration) {
+                    OnPto();
+                }
+                break;
+            case SIM_EVENT_SAMPLE:
+                PrintSample();
+                Schedule(TimeNow + Config.SampleIntervalUs, SIM_EVENT_SAMPLE);
+                break;
+            }
+        }
+        TimeNow = TimeEnd;
+    }
+
+    void PrintResults() {
+        const double Seconds = (double)Config.DurationUs / 1000000.0;
+        const double GoodputMbps = (double)GoodputBytes * 8 / Seconds / 1000000.0;
+
+        std::sort(QueueDelays.begin(), QueueDelays.end());
+        auto Percentile = [&](double P) -> double {
+            if (QueueDelays.empty()) {
+                return 0;
+            }
+            size_t Index = (size_t)(P * (double)(QueueDelays.size() - 1));
+            return (double)QueueDelays[Index] / 1000.0;
+        };
+        double QueueDelaySum = 0;
+        for (uint32_t Delay : QueueDelays) {
+            QueueDelaySum += Delay;
+        }
+
+        printf("Algorithm:     %s\n", Cc->Name);
+        printf("Duration:      %.3f s\n", Seconds);
+        if (Config.Trace.empty()) {
+            printf("Throughput:    %.2f Mbps (%.1f%% of %.2f Mbps)\n",
+                GoodputMbps,
+                100.0 * GoodputMbps * 1000000.0 / (double)Config.BandwidthBps,
+                (double)Config.BandwidthBps / 1000000.0);
+        } else {
+            printf("Throughput:    %.2f Mbps\n", GoodputMbps);
+        }
+        printf("Queue delay:   avg %.3f ms, p50 %.3f ms, p95 %.3f ms, p99 %.3f ms\n",
+            QueueDelays.empty() ? 0 : QueueDelaySum / (double)QueueDelays.size() / 1000.0,
+            Percentile(0.50),
+            Percentile(0.95),
+            Percentile(0.99));
+        printf("Smoothed RTT:  avg %.3f ms\n",
+            SrttSamples == 0 ? 0 : (double)SrttSum / (double)SrttSamples / 1000.0);
+        printf("Retransmits:   %.3f%% (%llu of %llu packets)\n",
+            PacketsSent == 0 ? 0 : 100.0 * (double)PacketsLost / (double)PacketsSent,
+            (unsigned long long)PacketsLost,
+            (unsigned long long)PacketsSent);
+        printf("Drops:         %llu buffer, %llu random\n",
+            (unsigned long long)Link.DroppedPackets,
+            (unsigned long long)RandomDrops);
+        printf("PTOs:          %llu\n", (unsigned long long)PtoCountTotal);
+    }
+};
+
+//
+// Reads a delivery trace in the Mahimahi format: one timestamp (in ms) per
+// line, each an opportunity to deliver one packet. The trace repeats.
+//
+BOOLEAN
+ReadTrace(
+    _In_z_ const char* FileName,
+    _Inout_ std::vector<uint64_t>& Trace
+    )
+{
+    FILE* File = fopen(FileName, "r");
+    if (File == nullptr) {
+        printf("Failed to open trace '%s'.\n", FileName);
+        return FALSE;
+    }
+    char Line[64];
+    while (fgets(Line, sizeof(Line), File) != nullptr) {
+        char* End;
+        const uint64_t TimeMs = strtoull(Line, &End, 10);
+        if (End == Line) {
+            continue; // Skip empty lines.
+        }
+        if (!Trace.empty() && MS_TO_US(TimeMs) < Trace.back()) {
+            printf("Trace timestamps must not decrease.\n");
+            fclose(File);
+            return FALSE;
+        }
+        Trace.push_back(MS_TO_US(TimeMs));
+    }
+    fclose(File);
+    if (Trace.empty() || Trace.back() == 0) {
+        printf("Trace '%s' has no delivery opportunities.\n", FileName);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+BOOLEAN
+ParseAlgorithm(
+    _In_z_ const char* Name,
+    _Out_ QUIC_CONGESTION_CONTROL_ALGORITHM* Algorithm
+    )
+{
+    static const struct {
+        const char* Name;
+        QUIC_CONGESTION_CONTROL_ALGORITHM Algorithm;
+    } Algorithms[] = {
+        { "cubic", QUIC_CONGESTION_CONTROL_ALGORITHM_CUBIC },
+        { "bbr", QUIC_CONGESTION_CONTROL_ALGORITHM_BBR },
+        { "bbr3", QUIC_CONGESTION_CONTROL_ALGORITHM_BBR3 },
+        { "prague", QUIC_CONGESTION_CONTROL_ALGORITHM_PRAGUE },
+        { "copa", QUIC_CONGESTION_CONTROL_ALGORITHM_COPA },
+    };
+    for (size_t i = 0; i < ARRAYSIZE(Algorithms); ++i) {
+        if (strlen(Name) == strlen(Algorithms[i].Name) &&
+            IsValue(Name, Algorithms[i].Name)) {
+            *Algorithm = Algorithms[i].Algorithm;
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+void
+PrintUsage()
+{
+    printf(
+        "quicccsim runs a congestion control algorithm over a simulated bottleneck link.\n"
+        "\n"
+        "Usage:\n"
+        "  quicccsim [options]\n"
+        "\n"
+        "Options:\n"
+        "  -cc:<cubic|bbr|bbr3|prague|copa>  Congestion control algorithm. (def:cubic)\n"
+        "  -bw:<kbps>                        Bottleneck bandwidth. (def:%u)\n"
+        "  -rtt:<ms>                         Base round trip time. (def:%u)\n"
+        "  -buffer:<bytes>                   Bottleneck buffer size. (def:one BDP)\n"
+        "  -loss:<percent>                   Random (non-congestive) loss rate. (def:0)\n"
+        "  -ackagg:<us>                      Hold ACKs in the network until the next multiple of this. (def:0)\n"
+        "  -ackfreq:<packets>                Packets received before an ACK is sent. (def:%u)\n"
+        "  -ecn:<us>                         Mark CE on packets queued longer than this. (def:0, off)\n"
+        "  -trace:<file>                     Replay a Mahimahi delivery trace instead of a fixed rate.\n"
+        "  -duration:<ms>                    Simulated time. (def:%u)\n"
+        "  -mtu:<bytes>                      Path MTU. (def:%u)\n"
+        "  -pacing:<0/1>                     Enable pacing. (def:1)\n"
+        "  -hystart:<0/1>                    Enable HyStart. (def:0)\n"
+        "  -seed:<number>                    Random seed. (def:1)\n"
+        "  -sample:<ms>                      Print the state at this interval. (def:0, off)\n",
+        SIM_DEFAULT_BANDWIDTH_KBPS,
+        SIM_DEFAULT_RTT_MS,
+        SIM_DEFAULT_ACK_FREQUENCY,
+        SIM_DEFAULT_DURATION_MS,
+        SIM_DEFAULT_MTU);
+}
+
+int
+QUIC_MAIN_EXPORT
+main(
+    _In_ int argc,
+    _In_reads_(argc) _Null_terminated_ char* argv[]
+    )
+{
+    if (GetFlag(argc, argv, "help") || GetFlag(argc, argv, "?")) {
+        PrintUsage();
+        return 0;
+    }
+
+    SimConfig Config;
+    const char* Value;
+    uint32_t Value32;
+    uint64_t Value64;
+
+    if (TryGetValue(argc, argv, "cc", &Value) &&
+        !ParseAlgorithm(Value, &Config.Algorithm)) {
+        printf("Unknown congestion control algorithm '%s'.\n", Value);
+        return -1;
+    }
+    if (TryGetValue(argc, argv, "bw", &Value64)) {
+        if (Value64 == 0) {
+            printf("Bandwidth must not be zero.\n");
+            return -1;
+        }
+        Config.BandwidthBps = Value64 * 1000;
+    }
+    if (TryGetValue(argc, argv, "rtt", &Value32)) {
+        Config.OneWayDelayUs = MS_TO_US((uint64_t)Value32) / 2;
+    }
+    if (TryGetValue(argc, argv, "loss", &Value)) {
+        Config.LossRate = atof(Value) / 100.0;
+    }
+    TryGetValue(argc, argv, "ackagg", &Config.AckAggregationUs);
+    if (TryGetValue(argc, argv, "ackfreq", &Value32) && Value32 != 0) {
+        Config.AckFrequency = Value32;
+    }
+    TryGetValue(argc, argv, "ecn", &Config.EcnThresholdUs);
+    if (TryGetValue(argc, argv, "duration", &Value64)) {
+        Config.DurationUs = MS_TO_US(Value64);
+    }
+    if (TryGetValue(argc, argv, "sample", &Value64)) {
+        Config.SampleIntervalUs = MS_TO_US(Value64);
+    }
+    TryGetValue(argc, argv, "seed", &Config.Seed);
+    if (TryGetValue(argc, argv, "mtu", &Value32)) {
+        if (Value32 < QUIC_DPLPMTUD_MIN_MTU || Value32 > CXPLAT_MAX_MTU) {
+            printf("MTU must be between %u and %u.\n", QUIC_DPLPMTUD_MIN_MTU, CXPLAT_MAX_MTU);
+            return -1;
+        }
+        Config.Mtu = (uint16_t)Value32;
+    }
+    if (TryGetValue(argc, argv, "pacing", &Value32)) {
+        Config.PacingEnabled = Value32 != 0;
+    }
+    if (TryGetValue(argc, argv, "hystart", &Value32)) {
+        Config.HyStartEnabled = Value32 != 0;
+    }
+    if (Config.Algorithm == QUIC_CONGESTION_CONTROL_ALGORITHM_PRAGUE &&
+        Config.EcnThresholdUs == 0) {
+        printf("Warning: Prague expects CE marking (-ecn).\n");
+    }
+
+    CxPlatSystemLoad();
+    CxPlatInitialize();
+
+    int ErrorCode = -1;
+    if (TryGetValue(argc, argv, "trace", &Value) && !ReadTrace(Value, Config.Trace)) {
+        goto Exit;
+    }
+    if (!TryGetValue(argc, argv, "buffer", &Config.BufferBytes)) {
+        //
+        // Default to one bandwidth-delay product of buffering.
+        //
+        const uint64_t BandwidthBps =
+            Config.Trace.empty() ?
+                Config.BandwidthBps :
+                (Config.Trace.size() * SIM_TRACE_OPPORTUNITY_SIZE * 8ull * 1000000ull) / Config.Trace.back();
+        Config.BufferBytes =
+            CXPLAT_MAX(
+                (BandwidthBps * 2 * Config.OneWayDelayUs) / (8ull * 1000000ull),
+                (uint64_t)(4 * Config.Mtu));
+    }
+
+    {
+        Simulator Sim(Config);
+        if (Sim.Initialize()) {
+            Sim.Run();
+            Sim.PrintResults();
+            ErrorCode = 0;
+        }
+    }
+
+Exit:
+    CxPlatUninitialize();
+    CxPlatSystemUnload();
+
+    return ErrorCode;
+}
@@ -8,6 +8,13 @@ Abstract:
     This tool creates a terminating QUIC proxy to forward all incoming traffic
     to a specified target.
 
+    By default, stream data is relayed without copying: each receive is left
+    pending and its buffers are sent by reference on the peer stream (send
+    buffering is disabled), then the receive is completed when the send
+    completes. Datagrams are only valid during their receive callback, so
+    they are copied once. On exit, the relay throughput is printed, along with
+    the throughput per core of MsQuic worker time.
+
     N.B. Better synchronization between peer objects is needed around teardown.
 
 --*/
@@ -16,22 +23,26 @@ Abstract:
 
 #include "msquichelper.h"
 #include "msquic.hpp"
+#include <atomic>
 
 const char* Alpn;
 uint16_t FrontEndPort;
 const char* BackEndTarget;
 uint16_t BackEndPort;
 QUIC_CERTIFICATE_HASH Cert;
-bool BufferedMode = true;
+bool BufferedMode = false;
 uint32_t FlowControlWindow = 0;
 
+std::atomic<uint64_t> StreamBytesRelayed{0};
+std::atomic<uint64_t> DatagramBytesRelayed{0};
+
 const MsQuicApi* MsQuic;
 MsQuicRegistration* Registration;
 MsQuicConfiguration* FrontEndConfiguration;
 MsQuicConfiguration* BackEndConfiguration;
 
 #define USAGE \
-    "Usage: quicforward <alpn> <local-port> <target-name/ip>:<target-port> <thumbprint> [0/1-buffered-mode] [fc-window]\n"
+    "Usage: quicforward <alpn> <local-port> <target-name/ip>:<target-port> <thumbprint> [0/1-buffered-mode (def:0)] [fc-window]\n"
 
 bool ParseArgs(int argc, char **argv) {
     if (argc < 5) {
@@ -125,8 +136,14 @@ QUIC_STATUS StreamCallback(
     case QUIC_STREAM_EVENT_SEND_COMPLETE: {
         auto SendContext = (ForwardedSend*)Event->SEND_COMPLETE.ClientContext;
         //printf("s[%p] Sent %llu bytes\n", Stream, SendContext->TotalLength);
-        if (!BufferedMode && !Event->SEND_COMPLETE.Canceled && PeerStream) {
-            PeerStream->ReceiveComplete(SendContext->TotalLength);
+        if (!Event->SEND_COMPLETE.Canceled) {
+            StreamBytesRelayed += SendContext->TotalLength;
+            if (!BufferedMode && PeerStream) {
+                //
+                // Releases the receive buffers that were sent by reference.
+                //
+                PeerStream->ReceiveComplete(SendContext->TotalLength);
+            }
         }
         ForwardedSend::Delete(SendContext);
         break;
@@ -176,6 +193,30 @@ QUIC_STATUS ConnectionCallback(
         //printf("s[%p] Started -> [%p]\n", LocalStream, PeerStream);
         break;
     }
+    case QUIC_CONNECTION_EVENT_DATAGRAM_RECEIVED: {
+        if (!PeerConn || !PeerConn->Handle) { break; }
+        const QUIC_BUFFER* Received = Event->DATAGRAM_RECEIVED.Buffer;
+        auto SendBuffer = (QUIC_BUFFER*)malloc(sizeof(QUIC_BUFFER) + Received->Length);
+        if (!SendBuffer) { break; }
+        SendBuffer->Length = Received->Length;
+        SendBuffer->Buffer = (uint8_t*)(SendBuffer + 1);
+        memcpy(SendBuffer->Buffer, Received->Buffer, Received->Length);
+        if (QUIC_FAILED(MsQuic->DatagramSend(PeerConn->Handle, SendBuffer, 1, QUIC_SEND_FLAG_NONE, SendBuffer))) {
+            free(SendBuffer); // Dropped, e.g. too large for the peer.
+        }
+        break;
+    }
+    case QUIC_CONNECTION_EVENT_DATAGRAM_SEND_STATE_CHANGED: {
+        const QUIC_DATAGRAM_SEND_STATE State = Event->DATAGRAM_SEND_STATE_CHANGED.State;
+        if (QUIC_DATAGRAM_SEND_STATE_IS_FINAL(State)) {
+            auto SendBuffer = (QUIC_BUFFER*)Event->DATAGRAM_SEND_STATE_CHANGED.ClientContext;
+            if (State != QUIC_DATAGRAM_SEND_CANCELED) {
+                DatagramBytesRelayed += SendBuffer->Length;
+            }
+            free(SendBuffer);
+        }
+        break;
+    }
     case QUIC_CONNECTION_EVENT_SHUTDOWN_COMPLETE:
         //printf("c[%p] Shutdown complete\n", Connection);
         if (PeerConn) PeerConn->Context = nullptr;
@@ -203,6 +244,36 @@ QUIC_STATUS ListenerCallback(
     return QUIC_STATUS_SUCCESS;
 }
 
+//
+// Total busy time of all MsQuic workers, to express the relay throughput per
+// core. Datapath threads aren't included.
+//
+uint64_t GetWorkerBusyTimeUs() {
+    uint64_t BusyTimeUs = 0;
+    QUIC_WORKER_STATISTICS Workers[256];
+    uint32_t Length = sizeof(Workers);
+    if (QUIC_SUCCEEDED(MsQuic->GetParam(nullptr, QUIC_PARAM_GLOBAL_WORKER_STATISTICS, &Length, Workers))) {
+        for (uint32_t i = 0; i < Length / sizeof(QUIC_WORKER_STATISTICS); ++i) {
+            BusyTimeUs += Workers[i].BusyTimeUs;
+        }
+    }
+    return BusyTimeUs;
+}
+
+void PrintRelayStats(uint64_t ElapsedUs, uint64_t BusyTimeUs) {
+    const uint64_t StreamBytes = StreamBytesRelayed;
+    const uint64_t DatagramBytes = DatagramBytesRelayed;
+    const uint64_t Bits = (StreamBytes + DatagramBytes) * 8;
+    printf("Relayed %llu stream bytes and %llu datagram bytes in %llu ms\n",
+        (unsigned long long)StreamBytes,
+        (unsigned long long)DatagramBytes,
+        (unsigned long long)US_TO_MS(ElapsedUs));
+    printf("%.3f Gbps, %.3f Gbps per worker core (%llu ms busy)\n",
+        ElapsedUs ? (double)Bits / ElapsedUs / 1000 : 0.0,
+        BusyTimeUs ? (double)Bits / BusyTimeUs / 1000 : 0.0,
+        (unsigned long long)US_TO_MS(BusyTimeUs));
+}
+
 int QUIC_MAIN_EXPORT main(int argc, char **argv) {
     if (!ParseArgs(argc, argv)) {
         printf(USAGE);
@@ -217,6 +288,7 @@ int QUIC_MAIN_EXPORT main(int argc, char **argv) {
     MsQuicSettings Settings;
     Settings.SetSendBufferingEnabled(false);
     Settings.SetStreamMultiReceiveEnabled(true);
+    Settings.SetDatagramReceiveEnabled(true);
     Settings.SetPeerBidiStreamCount(1000);
     Settings.SetPeerUnidiStreamCount(1000);
     if (FlowControlWindow) {
@@ -233,7 +305,10 @@ int QUIC_MAIN_EXPORT main(int argc, char **argv) {
     CXPLAT_FRE_ASSERT(Listener.IsValid());
     CXPLAT_FRE_ASSERT(QUIC_SUCCEEDED(Listener.Start(Alpn, QuicAddr(QUIC_ADDRESS_FAMILY_UNSPEC, FrontEndPort))));
 
+    const uint64_t StartTimeUs = CxPlatTimeUs64();
+    const uint64_t StartBusyTimeUs = GetWorkerBusyTimeUs();
     printf("Press Enter to exit.\n\n");
     getchar();
+    PrintRelayStats(CxPlatTimeUs64() - StartTimeUs, GetWorkerBusyTimeUs() - StartBusyTimeUs);
     return 0;
 }
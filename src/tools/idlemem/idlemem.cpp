@@ -0,0 +1,383 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Measures the memory cost of idle connections and streams. Connects a
+    number of client/server connection pairs over loopback in one process,
+    lets them go idle and reports the bytes each one holds, broken down by
+    object type from the registrations' memory accounting, next to what the
+    process's allocator saw. Optional limits make it usable as a regression
+    gate.
+
+--*/
+
+#include <vector>
+
+#define QUIC_TEST_APIS 1 // Needed for self signed cert API
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include "msquichelper.h"
+#include "msquic.hpp"
+
+#ifdef _WIN32
+#include <psapi.h>
+#elif defined(__linux__)
+#include <malloc.h>
+#include <unistd.h>
+#else
+#include <sys/resource.h>
+#endif
+
+const MsQuicApi* MsQuic;
+
+static struct {
+    uint32_t ConnectionCount {1000};
+    uint32_t StreamCount {4};               // Per connection
+    uint32_t IdleMs {2000};
+    bool ShareBinding {true};
+    uint64_t MaxConnectionBytes {0};        // Accounted bytes, either side
+    uint64_t MaxStreamBytes {0};
+} Settings;
+
+volatile long ClientConnected;
+volatile long ServerConnected;
+volatile long ServerStreams;
+
+//
+// Bytes the process currently has allocated. This is glibc's count of bytes
+// in use where available, which doesn't depend on page granularity, and
+// otherwise the process's private or resident memory.
+//
+uint64_t GetAllocatedBytes() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS_EX Counters;
+    return
+        GetProcessMemoryInfo(
+            GetCurrentProcess(),
+            (PROCESS_MEMORY_COUNTERS*)&Counters,
+            sizeof(Counters)) ? Counters.PrivateUsage : 0;
+#elif defined(__linux__) && defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    struct mallinfo2 Info = mallinfo2();
+    return (uint64_t)Info.uordblks + (uint64_t)Info.hblkhd;
+#elif defined(__linux__)
+    FILE* File = fopen("/proc/self/statm", "r");
+    if (File == nullptr) return 0;
+    unsigned long long Size = 0, Resident = 0;
+    int Count = fscanf(File, "%llu %llu", &Size, &Resident);
+    fclose(File);
+    return Count == 2 ? Resident * (uint64_t)sysconf(_SC_PAGESIZE) : 0;
+#else
+    struct rusage Usage;
+    return getrusage(RUSAGE_SELF, &Usage) == 0 ? (uint64_t)Usage.ru_maxrss : 0; // Peak; bytes on macOS
+#endif
+}
+
+struct MemorySample {
+    QUIC_MEMORY_USAGE Client {};
+    QUIC_MEMORY_USAGE Server {};
+    uint64_t AllocatedBytes {0};
+
+    void Take(const MsQuicRegistration& ClientRegistration, const MsQuicRegistration& ServerRegistration) {
+        uint32_t Length = sizeof(Client);
+        if (QUIC_FAILED(MsQuic->GetParam(ClientRegistration, QUIC_PARAM_REGISTRATION_MEMORY_USAGE, &Length, &Client))) {
+            Client = {};
+        }
+        Length = sizeof(Server);
+        if (QUIC_FAILED(MsQuic->GetParam(ServerRegistration, QUIC_PARAM_REGISTRATION_MEMORY_USAGE, &Length, &Server))) {
+            Server = {};
+        }
+        AllocatedBytes = GetAllocatedBytes();
+    }
+};
+
+static
+uint64_t
+TotalBytes(
+    const QUIC_MEMORY_USAGE& Usage
+    ) {
+    return
+        Usage.ConnectionBytes + Usage.PathBytes + Usage.PacketSpaceBytes + Usage.TlsBytes +
+        Usage.StreamBytes + Usage.SendBufferBytes + Usage.RecvBufferBytes +
+        Usage.SentPacketMetadataBytes;
+}
+
+//
+// Prints what changed between two samples, divided by Count.
+//
+static
+void
+PrintBreakdown(
+    const char* Title,
+    const MemorySample& Begin,
+    const MemorySample& End,
+    uint64_t Count
+    ) {
+    printf("\n%s (%llu)\n", Title, (unsigned long long)Count);
+    printf("%-20s %10s %10s\n", "", "client", "server");
+
+#define PRINT_ROW(Name, Field) \
+    printf("%-20s %10lld %10lld\n", Name, \
+        (long long)(End.Client.Field - Begin.Client.Field) / (long long)Count, \
+        (long long)(End.Server.Field - Begin.Server.Field) / (long long)Count)
+
+    PRINT_ROW("connection", ConnectionBytes);
+    PRINT_ROW("paths", PathBytes);
+    PRINT_ROW("packet spaces", PacketSpaceBytes);
+    PRINT_ROW("tls", TlsBytes);
+    PRINT_ROW("streams", StreamBytes);
+    PRINT_ROW("send buffers", SendBufferBytes);
+    PRINT_ROW("recv buffers", RecvBufferBytes);
+    PRINT_ROW("sent packets", SentPacketMetadataBytes);
+
+#undef PRINT_ROW
+
+    const int64_t ClientTotal = (int64_t)(TotalBytes(End.Client) - TotalBytes(Begin.Client));
+    const int64_t ServerTotal = (int64_t)(TotalBytes(End.Server) - TotalBytes(Begin.Server));
+    printf("%-20s %10lld %10lld\n", "total accounted",
+        (long long)ClientTotal / (long long)Count, (long long)ServerTotal / (long long)Count);
+
+    //
+    // The allocator sees both sides, and everything the accounting misses:
+    // the TLS library's state, bindings, pools and the app's own objects.
+    //
+    const int64_t Allocated = (int64_t)(End.AllocatedBytes - Begin.AllocatedBytes);
+    printf("%-20s %21lld\n", "allocator (pair)", (long long)Allocated / (long long)Count);
+    printf("%-20s %21lld\n", "unaccounted (pair)",
+        (long long)(Allocated - ClientTotal - ServerTotal) / (long long)Count);
+}
+
+QUIC_STATUS
+ClientConnectionCallback(
+    _In_ MsQuicConnection* /* Connection */,
+    _In_opt_ void* /* Context */,
+    _Inout_ QUIC_CONNECTION_EVENT* Event
+    ) {
+    if (Event->Type == QUIC_CONNECTION_EVENT_CONNECTED) {
+        InterlockedIncrement(&ClientConnected);
+    }
+    return QUIC_STATUS_SUCCESS;
+}
+
+QUIC_STATUS
+ServerConnectionCallback(
+    _In_ MsQuicConnection* /* Connection */,
+    _In_opt_ void* /* Context */,
+    _Inout_ QUIC_CONNECTION_EVENT* Event
+    ) {
+    if (Event->Type == QUIC_CONNECTION_EVENT_CONNECTED) {
+        InterlockedIncrement(&ServerConnected);
+    } else if (Event->Type == QUIC_CONNECTION_EVENT_PEER_STREAM_STARTED) {
+        new(std::nothrow) MsQuicStream(Event->PEER_STREAM_STARTED.Stream, CleanUpAutoDelete, MsQuicStream::NoOpCallback);
+        InterlockedIncrement(&ServerStreams);
+    }
+    return QUIC_STATUS_SUCCESS;
+}
+
+//
+// Waits for Value to reach Target. Gives up if it stops making progress.
+//
+static
+bool
+WaitFor(
+    const char* What,
+    volatile long* Value,
+    long Target
+    ) {
+    long LastValue = -1;
+    uint64_t LastProgressTime = CxPlatTimeMs64();
+    while (*Value < Target) {
+        if (*Value != LastValue) {
+            LastValue = *Value;
+            LastProgressTime = CxPlatTimeMs64();
+        } else if (CxPlatTimeMs64() - LastProgressTime > 10 * 1000) {
+            printf("%s stalled at %ld of %ld\n", What, LastValue, Target);
+            return false;
+        }
+        CxPlatSleep(10);
+    }
+    return true;
+}
+
+//
+// Connects the pairs and prints what they cost. The connections are left for
+// the caller to clean up, by closing the registrations.
+//
+static
+bool
+RunBenchmark(
+    const MsQuicRegistration& ClientRegistration,
+    const MsQuicRegistration& ServerRegistration,
+    const QUIC_CREDENTIAL_CONFIG& CertConfig
+    ) {
+    MsQuicAlpn Alpn("idlemem");
+
+    //
+    // No keep-alives or idle timeout: the connections must stay open, and
+    // quiet, while they are measured.
+    //
+    MsQuicSettings QuicSettings;
+    QuicSettings.SetIdleTimeoutMs(0);
+    QuicSettings.SetPeerBidiStreamCount((uint16_t)Settings.StreamCount);
+
+    MsQuicConfiguration ServerConfig(ServerRegistration, Alpn, QuicSettings, MsQuicCredentialConfig(CertConfig));
+    MsQuicConfiguration ClientConfig(
+        ClientRegistration, Alpn, QuicSettings,
+        MsQuicCredentialConfig(QUIC_CREDENTIAL_FLAG_CLIENT | QUIC_CREDENTIAL_FLAG_NO_CERTIFICATE_VALIDATION));
+    if (!ServerConfig.IsValid() || !ClientConfig.IsValid()) {
+        printf("Failed to create the configurations\n");
+        return false;
+    }
+
+    MsQuicAutoAcceptListener Listener(ServerRegistration, ServerConfig, ServerConnectionCallback);
+    QuicAddr ServerAddress(QUIC_ADDRESS_FAMILY_INET, true);
+    if (QUIC_FAILED(Listener.Start(Alpn, &ServerAddress.SockAddr)) ||
+        QUIC_FAILED(Listener.GetLocalAddr(ServerAddress))) {
+        printf("Failed to start the listener\n");
+        return false;
+    }
+
+    MemorySample Baseline, Connected, WithStreams;
+    Baseline.Take(ClientRegistration, ServerRegistration);
+
+    std::vector<MsQuicConnection*> Connections;
+    QuicAddr LocalAddress;
+    for (uint32_t i = 0; i < Settings.ConnectionCount; ++i) {
+        auto Connection = new(std::nothrow) MsQuicConnection(ClientRegistration, CleanUpAutoDelete, ClientConnectionCallback);
+        if (Connection == nullptr || !Connection->IsValid()) {
+            delete Connection;
+            break;
+        }
+        Connection->SetRemoteAddr(ServerAddress);
+        if (Settings.ShareBinding) {
+            Connection->SetShareUdpBinding();
+            if (i != 0) Connection->SetLocalAddr(LocalAddress);
+        }
+        if (QUIC_FAILED(Connection->Start(ClientConfig, "localhost", ServerAddress.GetPort()))) {
+            delete Connection;
+            break;
+        }
+        if (Settings.ShareBinding && i == 0) Connection->GetLocalAddr(LocalAddress);
+        Connections.push_back(Connection);
+    }
+
+    const long Pairs = (long)Connections.size();
+    if (Pairs == 0 ||
+        !WaitFor("Client handshakes", &ClientConnected, Pairs) ||
+        !WaitFor("Server handshakes", &ServerConnected, Pairs)) {
+        return false;
+    }
+    CxPlatSleep(Settings.IdleMs);
+    Connected.Take(ClientRegistration, ServerRegistration);
+    PrintBreakdown("Bytes per idle connection", Baseline, Connected, (uint64_t)Pairs);
+
+    bool Result = true;
+    const uint64_t ConnectionBytes =
+        CXPLAT_MAX(
+            TotalBytes(Connected.Client) - TotalBytes(Baseline.Client),
+            TotalBytes(Connected.Server) - TotalBytes(Baseline.Server)) / (uint64_t)Pairs;
+    if (Settings.MaxConnectionBytes != 0 && ConnectionBytes > Settings.MaxConnectionBytes) {
+        printf("\nFAILED: %llu bytes per connection is over the limit of %llu\n",
+            (unsigned long long)ConnectionBytes, (unsigned long long)Settings.MaxConnectionBytes);
+        Result = false;
+    }
+
+    if (Settings.StreamCount == 0) {
+        return Result;
+    }
+
+    for (auto Connection : Connections) {
+        for (uint32_t i = 0; i < Settings.StreamCount; ++i) {
+            auto Stream = new(std::nothrow) MsQuicStream(*Connection, QUIC_STREAM_OPEN_FLAG_NONE, CleanUpAutoDelete);
+            if (Stream == nullptr || QUIC_FAILED(Stream->Start(QUIC_STREAM_START_FLAG_IMMEDIATE))) {
+                delete Stream;
+            }
+        }
+    }
+    const long Streams = Pairs * (long)Settings.StreamCount;
+    if (!WaitFor("Streams", &ServerStreams, Streams)) {
+        return false;
+    }
+    CxPlatSleep(Settings.IdleMs);
+    WithStreams.Take(ClientRegistration, ServerRegistration);
+    PrintBreakdown("Bytes per idle stream", Connected, WithStreams, (uint64_t)Streams);
+
+    const uint64_t StreamBytes =
+        CXPLAT_MAX(
+            TotalBytes(WithStreams.Client) - TotalBytes(Connected.Client),
+            TotalBytes(WithStreams.Server) - TotalBytes(Connected.Server)) / (uint64_t)Streams;
+    if (Settings.MaxStreamBytes != 0 && StreamBytes > Settings.MaxStreamBytes) {
+        printf("\nFAILED: %llu bytes per stream is over the limit of %llu\n",
+            (unsigned long long)StreamBytes, (unsigned long long)Settings.MaxStreamBytes);
+        Result = false;
+    }
+
+    return Result;
+}
+
+void PrintUsage() {
+    printf("Usage: quicidlemem [options]\n"
+        "\n"
+        "  -conns:<count>            Connection pairs to create. (def:1000)\n"
+        "  -streams:<count>          Streams to open on each connection. (def:4)\n"
+        "  -idle:<ms>                Time to let the connections idle before measuring. (def:2000)\n"
+        "  -share:<0/1>              Share one client UDP socket between the connections. (def:1)\n"
+        "  -max_conn_bytes:<bytes>   Fail if a connection holds more than this. (def:0, no limit)\n"
+        "  -max_stream_bytes:<bytes> Fail if a stream holds more than this. (def:0, no limit)\n");
+}
+
+int
+QUIC_MAIN_EXPORT
+main(int argc, char **argv) {
+    if (GetFlag(argc, argv, "?") || GetFlag(argc, argv, "help")) {
+        PrintUsage();
+        return 1;
+    }
+
+    uint8_t ShareBinding = 1;
+    TryGetValue(argc, argv, "conns", &Settings.ConnectionCount);
+    TryGetValue(argc, argv, "streams", &Settings.StreamCount);
+    TryGetValue(argc, argv, "idle", &Settings.IdleMs);
+    TryGetValue(argc, argv, "share", &ShareBinding);
+    TryGetValue(argc, argv, "max_conn_bytes", &Settings.MaxConnectionBytes);
+    TryGetValue(argc, argv, "max_stream_bytes", &Settings.MaxStreamBytes);
+    Settings.ShareBinding = ShareBinding != 0;
+    if (Settings.ConnectionCount == 0 || Settings.StreamCount > UINT16_MAX) {
+        PrintUsage();
+        return 1;
+    }
+
+    MsQuic = new(std::nothrow) MsQuicApi;
+    if (MsQuic == nullptr || QUIC_FAILED(MsQuic->GetInitStatus())) {
+        printf("MsQuicOpen2 failed\n");
+        delete MsQuic;
+        return 1;
+    }
+
+    auto CertConfig = CxPlatGetSelfSignedCert(CXPLAT_SELF_SIGN_CERT_USER, FALSE, NULL);
+    if (CertConfig == nullptr) {
+        printf("Failed to create a self signed certificate\n");
+        delete MsQuic;
+        return 1;
+    }
+
+    bool Result;
+    {
+        //
+        // Closing the registrations shuts down the connections and waits for
+        // them to be cleaned up.
+        //
+        MsQuicRegistration ClientRegistration("idlemem-client", QUIC_EXECUTION_PROFILE_LOW_LATENCY, true);
+        MsQuicRegistration ServerRegistration("idlemem-server", QUIC_EXECUTION_PROFILE_LOW_LATENCY, true);
+        Result =
+            ClientRegistration.IsValid() && ServerRegistration.IsValid() &&
+            RunBenchmark(ClientRegistration, ServerRegistration, *CertConfig);
+    }
+
+    CxPlatFreeSelfSignedCert(CertConfig);
+    delete MsQuic;
+    return Result ? 0 : 1;
+}
@@ -15,6 +15,9 @@ const QUIC_API_TABLE* MsQuic;
 HQUIC Configuration;
 const char* RootFolderPath;
 const char* UploadFolderPath;
+BOOLEAN UseMappedFiles = FALSE;
+
+const char Http11OkHeader[] = "HTTP/1.1 200 OK\r\nConnection: Close\r\n\r\n";
 
 const QUIC_BUFFER SupportedALPNs[] = {
     { sizeof("hq-interop") - 1, (uint8_t*)"hq-interop" },
@@ -34,6 +37,7 @@ PrintUsage()
            " [-file:<cert_filepath> AND -key:<cert_key_filepath>]"
            " [-port:<####> (def:%u)]  [-retry:<0/1> (def:%u)]"
            " [-upload:<path>]"
+           " [-mmap:<0/1> (def:0)]"
            " [-enableVNE:<0/1>]\n\n",
            DEFAULT_QUIC_HTTP_SERVER_PORT, DEFAULT_QUIC_HTTP_SERVER_RETRY);
 
@@ -77,6 +81,7 @@ main(
     TryGetValue(argc, argv, "upload", &UploadFolderPath);
     TryGetValue(argc, argv, "sslkeylogfile", &SslKeyLogFileParam);
     TryGetValue(argc, argv, "enablevne", &EnableVNE);
+    TryGetValue(argc, argv, "mmap", &UseMappedFiles);
 
     //
     // Required parameters.
@@ -104,6 +109,15 @@ main(
     Settings.IsSet.ServerResumptionLevel = TRUE;
     Settings.GreaseQuicBitEnabled = TRUE; // Enable Grease Quic Bit
     Settings.IsSet.GreaseQuicBitEnabled = TRUE;
+    if (UseMappedFiles) {
+        //
+        // MsQuic then references the mapped pages until SEND_COMPLETE instead
+        // of copying them into its own send buffer.
+        //
+        Settings.SendBufferingEnabled = FALSE;
+        Settings.IsSet.SendBufferingEnabled = TRUE;
+        printf("Serving files from memory mappings.\n");
+    }
     if (EnableVNE) {
         uint32_t SupportedVersions[] = {QUIC_VERSION_2_H, QUIC_VERSION_1_H, QUIC_VERSION_DRAFT_29_H, QUIC_VERSION_1_MS_H};
         QUIC_VERSION_SETTINGS VersionSettings{0};
@@ -160,7 +174,9 @@ main(
 
 HttpRequest::HttpRequest(HttpConnection *connection, HQUIC stream, bool Unidirectional) :
     Connection(connection), QuicStream(stream), File(nullptr),
-    Shutdown(false), WriteHttp11Header(false)
+    Shutdown(false), WriteHttp11Header(false), MappedOffset(0),
+    MappedInFlight(0), IdealSendBuffer(MAPPED_SEND_DEFAULT_IDEAL),
+    MappedSends{}, MappedSendHead(0), MappedSendCount(0)
 {
     MsQuic->SetCallbackHandler(
         QuicStream,
@@ -225,6 +241,10 @@ HttpRequest::Process()
     }
 
     printf("[%s] GET '%s'\n", GetRemoteAddr(MsQuic, QuicStream).Address, PathStart);
+    if (UseMappedFiles && Mapping.Open(FullFilePath)) {
+        SendMappedData();
+        return;
+    }
     File = fopen(FullFilePath, "rb"); // In case of failure, SendData still works.
 
     SendData();
@@ -293,6 +313,63 @@ HttpRequest::SendData()
     }
 }
 
+void
+HttpRequest::SendMappedData()
+{
+    //
+    // Keep about the ideal send buffer size queued, one mapped chunk per send,
+    // and refill as sends complete.
+    //
+    while (!Shutdown &&
+           MappedSendCount < MAX_MAPPED_SENDS &&
+           (MappedSendCount == 0 || MappedInFlight < IdealSendBuffer)) {
+        QUIC_BUFFER* Send = &MappedSends[(MappedSendHead + MappedSendCount) % MAX_MAPPED_SENDS];
+        QUIC_SEND_FLAGS Flags = QUIC_SEND_FLAG_NONE;
+        if (WriteHttp11Header) {
+            Send->Buffer = (uint8_t*)Http11OkHeader;
+            Send->Length = sizeof(Http11OkHeader) - 1;
+            WriteHttp11Header = false;
+        } else {
+            uint64_t Remaining = Mapping.Length - MappedOffset;
+            Send->Buffer = (uint8_t*)Mapping.Data + MappedOffset;
+            Send->Length = (uint32_t)(Remaining < MAPPED_SEND_SIZE ? Remaining : MAPPED_SEND_SIZE);
+            MappedOffset += Send->Length;
+            if (MappedOffset == Mapping.Length) {
+                Flags |= QUIC_SEND_FLAG_FIN;
+                Shutdown = true;
+            } else if (MappedSendCount + 1 < MAX_MAPPED_SENDS &&
+                       MappedInFlight + Send->Length < IdealSendBuffer) {
+                Flags |= QUIC_SEND_FLAG_DELAY_SEND; // More is queued right behind.
+            }
+        }
+
+        QUIC_STATUS Status;
+        if (QUIC_FAILED(
+            Status =
+            MsQuic->StreamSend(
+                QuicStream,
+                Send,
+                1,
+                Flags,
+                this))) {
+            printf("[%s] Send failed, 0x%x\n", GetRemoteAddr(MsQuic, QuicStream).Address, Status);
+            Abort(HttpRequestSendFailed);
+            return;
+        }
+        MappedInFlight += Send->Length;
+        MappedSendCount++;
+    }
+}
+
+void
+HttpRequest::CompleteMappedSend()
+{
+    MappedInFlight -= MappedSends[MappedSendHead].Length;
+    MappedSendHead = (MappedSendHead + 1) % MAX_MAPPED_SENDS;
+    MappedSendCount--;
+    SendMappedData();
+}
+
 bool
 HttpRequest::ReceiveUniDiData(
     _In_ const QUIC_BUFFER* Buffers,
@@ -381,7 +458,17 @@ HttpRequest::QuicBidiCallbackHandler(
         }
         break;
     case QUIC_STREAM_EVENT_SEND_COMPLETE:
-        pThis->SendData();
+        if (pThis->Mapping.Opened) {
+            pThis->CompleteMappedSend();
+        } else {
+            pThis->SendData();
+        }
+        break;
+    case QUIC_STREAM_EVENT_IDEAL_SEND_BUFFER_SIZE:
+        pThis->IdealSendBuffer = Event->IDEAL_SEND_BUFFER_SIZE.ByteCount;
+        if (pThis->Mapping.Opened) {
+            pThis->SendMappedData();
+        }
         break;
     case QUIC_STREAM_EVENT_PEER_SEND_SHUTDOWN:
         pThis->Process();
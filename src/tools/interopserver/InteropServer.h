@@ -12,8 +12,16 @@
 #include "msquichelper.h"
 #include "quic_versions.h"
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 extern const QUIC_API_TABLE* MsQuic;
 extern HQUIC Configuration;
+extern BOOLEAN UseMappedFiles;
 
 const QUIC_BUFFER QuackBuffer = { sizeof("quack") - 1, (uint8_t*)"quack" };
 const QUIC_BUFFER QuackAckBuffer = { sizeof("quack-ack") - 1, (uint8_t*)"quack-ack" };
@@ -38,6 +46,21 @@ const QUIC_BUFFER QuackAckBuffer = { sizeof("quack-ack") - 1, (uint8_t*)"quack-a
 //
 #define IO_SIZE 64 * 1024
 
+//
+// The size of each send queued straight from a mapped file.
+//
+#define MAPPED_SEND_SIZE 256 * 1024
+
+//
+// The maximum number of mapped sends outstanding per request.
+//
+#define MAX_MAPPED_SENDS 16
+
+//
+// The in-flight target until MsQuic indicates an ideal send buffer size.
+//
+#define MAPPED_SEND_DEFAULT_IDEAL 128 * 1024
+
 //
 // Siduck error code for invalid payload.
 //
@@ -74,6 +97,74 @@ struct HttpSendBuffer {
     }
 };
 
+//
+// A read-only mapping of a file being served, so its pages can be passed to
+// StreamSend without copying. The file must not be truncated while mapped.
+//
+struct MappedFile {
+    const uint8_t* Data {nullptr};
+    uint64_t Length {0};
+    bool Opened {false};
+    ~MappedFile() { Close(); }
+    bool Open(const char* Path) {
+#ifdef _WIN32
+        HANDLE File =
+            CreateFileA(
+                Path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (File == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        LARGE_INTEGER Size;
+        if (!GetFileSizeEx(File, &Size)) {
+            CloseHandle(File);
+            return false;
+        }
+        Length = (uint64_t)Size.QuadPart;
+        if (Length != 0) {
+            HANDLE Mapping = CreateFileMappingA(File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (Mapping != nullptr) {
+                Data = (const uint8_t*)MapViewOfFile(Mapping, FILE_MAP_READ, 0, 0, 0);
+                CloseHandle(Mapping); // The view keeps the mapping alive.
+            }
+        }
+        CloseHandle(File);
+#else
+        int Fd = open(Path, O_RDONLY | O_CLOEXEC);
+        if (Fd < 0) {
+            return false;
+        }
+        struct stat Stat;
+        if (fstat(Fd, &Stat) != 0 || !S_ISREG(Stat.st_mode)) {
+            close(Fd);
+            return false;
+        }
+        Length = (uint64_t)Stat.st_size;
+        if (Length != 0) {
+            void* Address = mmap(nullptr, (size_t)Length, PROT_READ, MAP_PRIVATE, Fd, 0);
+            if (Address != MAP_FAILED) {
+                (void)madvise(Address, (size_t)Length, MADV_SEQUENTIAL);
+                Data = (const uint8_t*)Address;
+            }
+        }
+        close(Fd);
+#endif
+        Opened = Length == 0 || Data != nullptr;
+        return Opened;
+    }
+    void Close() {
+        if (Data != nullptr) {
+#ifdef _WIN32
+            UnmapViewOfFile(Data);
+#else
+            munmap((void*)Data, (size_t)Length);
+#endif
+            Data = nullptr;
+        }
+        Opened = false;
+    }
+};
+
 struct HttpConnection;
 
 enum HttpRequestErrorCodes {
@@ -96,6 +187,17 @@ private:
     HttpSendBuffer Buffer;
     bool Shutdown;
     bool WriteHttp11Header;
+    //
+    // State for serving directly from a file mapping. Sends complete in
+    // order, so the outstanding QUIC_BUFFERs form a ring.
+    //
+    MappedFile Mapping;
+    uint64_t MappedOffset;
+    uint64_t MappedInFlight;
+    uint64_t IdealSendBuffer;
+    QUIC_BUFFER MappedSends[MAX_MAPPED_SENDS];
+    uint32_t MappedSendHead;
+    uint32_t MappedSendCount;
 private:
     ~HttpRequest();
     void Abort(HttpRequestErrorCodes ErrorCode) {
@@ -107,6 +209,8 @@ private:
     }
     void Process();
     void SendData();
+    void SendMappedData();
+    void CompleteMappedSend();
     bool ReceiveUniDiData(
         _In_ const QUIC_BUFFER* Buffers,
         _In_ uint32_t BufferCount
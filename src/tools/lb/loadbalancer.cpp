@@ -6,23 +6,229 @@
 Abstract:
 
     Load balances QUIC traffic from a public address to a set of private
-    addresses. Requires the use of NAT'ing. Don't use in production.
+    addresses. Packets are routed on the server ID that QUIC-LB servers encode
+    in their connection IDs, falling back to a consistent hash of the
+    destination CID (e.g. for the client chosen CIDs of Initial packets).
+    Requires the use of NAT'ing.
 
 --*/
 
+#define QUIC_API_ENABLE_PREVIEW_FEATURES 1 // For XDP
+
 #include <vector>
 #include <unordered_map>
 #include <mutex>
+#include <shared_mutex>
+#include <atomic>
+#include <thread>
+#include <chrono>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
 
 #include "quic_datapath.h"
 #include "quic_toeplitz.h"
+#include "quic_crypt.h"
 #include "msquichelper.h"
 
+//
+// The maximum length of a QUIC v1 connection ID.
+//
+#define LB_MAX_CID_LENGTH 20
+
+//
+// The number of leading destination CID bytes hashed for packets that aren't
+// routable by server ID. QUIC v1 clients pick at least 8 byte CIDs.
+//
+#define LB_HASH_CID_LENGTH 8
+
+//
+// The maximum number of distinct destinations per receive batch before the
+// batch is flushed early.
+//
+#define LB_MAX_BATCH_DESTINATIONS 16
+
+//
+// The longest server ID and nonce, together, that QUIC-LB allows.
+//
+#define LB_MAX_PLAINTEXT_LENGTH 19
+
+//
+// MsQuic servers follow the QUIC-LB bytes with a 2 byte partition ID and a
+// 7 byte payload.
+//
+#define LB_MSQUIC_CID_SUFFIX_LENGTH 9
+
 bool Verbose = false;
 CXPLAT_DATAPATH* Datapath;
 CXPLAT_WORKER_POOL WorkerPool;
-struct LbInterface* PublicInterface;
-std::vector<QUIC_ADDR> PrivateAddrs;
+struct LbPublicInterface* PublicInterface;
+
+struct LbBackend {
+    QUIC_ADDR Address;
+    uint64_t ServerId;
+};
+std::vector<LbBackend> Backends;
+
+//
+// The QUIC-LB config the servers use (only the ConfigId, ServerIdLength,
+// NonceLength, Encrypt and Key fields matter here) and the backend for each
+// server ID.
+//
+QUIC_LOAD_BALANCING_CONFIG LbConfig;
+bool LbConfigSet = false;
+uint8_t LbCidLength;
+std::unordered_map<uint64_t, uint32_t> ServerIds;
+
+//
+// AES-ECB keys for decrypting server IDs, one per processor since a key can't
+// be used concurrently.
+//
+struct LbKey {
+    std::mutex Lock;
+    CXPLAT_HP_KEY* Key {nullptr};
+};
+LbKey* Keys;
+
+std::atomic<uint64_t> ForwardedCount;
+std::atomic<uint64_t> DroppedCount;
+
+//
+// QUIC-LB four-pass cipher over the server ID and nonce. The halves share the
+// middle nibble if the length is odd. Decryption runs the passes in reverse.
+//
+void
+LbFourPass(
+    _In_ CXPLAT_HP_KEY* Key,
+    _In_range_(2, LB_MAX_PLAINTEXT_LENGTH) uint8_t Length,
+    _Inout_updates_(Length) uint8_t* Block,
+    _In_ bool Decrypt
+    )
+{
+    const uint8_t HalfLength = (Length + 1) / 2;
+    const bool Odd = (Length & 1) != 0;
+    uint8_t Left[(LB_MAX_PLAINTEXT_LENGTH + 1) / 2];
+    uint8_t Right[(LB_MAX_PLAINTEXT_LENGTH + 1) / 2];
+    uint8_t Input[CXPLAT_HP_SAMPLE_LENGTH];
+    uint8_t Mask[CXPLAT_HP_SAMPLE_LENGTH];
+
+    CxPlatCopyMemory(Left, Block, HalfLength);
+    CxPlatCopyMemory(Right, Block + Length - HalfLength, HalfLength);
+    if (Odd) {
+        Left[HalfLength - 1] &= 0xF0;
+        Right[0] &= 0x0F;
+    }
+
+    for (uint8_t i = 0; i < 4; ++i) {
+        const uint8_t Pass = Decrypt ? 4 - i : 1 + i;
+        CxPlatZeroMemory(Input, sizeof(Input));
+        if (Pass & 1) {
+            CxPlatCopyMemory(Input, Left, HalfLength);
+            Input[sizeof(Input) - 2] = Length;
+            Input[sizeof(Input) - 1] = Pass;
+            (void)CxPlatHpComputeMask(Key, 1, Input, Mask);
+            for (uint8_t j = 0; j < HalfLength; ++j) {
+                Right[j] ^= Mask[sizeof(Mask) - HalfLength + j];
+            }
+            if (Odd) {
+                Right[0] &= 0x0F;
+            }
+        } else {
+            Input[0] = Length;
+            Input[1] = Pass;
+            CxPlatCopyMemory(Input + sizeof(Input) - HalfLength, Right, HalfLength);
+            (void)CxPlatHpComputeMask(Key, 1, Input, Mask);
+            for (uint8_t j = 0; j < HalfLength; ++j) {
+                Left[j] ^= Mask[j];
+            }
+            if (Odd) {
+                Left[HalfLength - 1] &= 0xF0;
+            }
+        }
+    }
+
+    CxPlatCopyMemory(Block, Left, HalfLength);
+    if (Odd) {
+        Block[HalfLength - 1] |= Right[0];
+        CxPlatCopyMemory(Block + HalfLength, Right + 1, HalfLength - 1);
+    } else {
+        CxPlatCopyMemory(Block + HalfLength, Right, HalfLength);
+    }
+}
+
+//
+// Maps a key to one of Buckets buckets, moving only 1/Buckets of the keys
+// when a bucket is added (Lamping and Veach's jump consistent hash).
+//
+uint32_t
+LbJumpHash(
+    _In_ uint64_t Key,
+    _In_ uint32_t Buckets
+    )
+{
+    int64_t Bucket = -1, Next = 0;
+    while (Next < (int64_t)Buckets) {
+        Bucket = Next;
+        Key = Key * 2862933555777941757ULL + 1;
+        Next = (int64_t)((Bucket + 1) * ((double)(1LL << 31) / (double)((Key >> 33) + 1)));
+    }
+    return (uint32_t)Bucket;
+}
+
+//
+// Returns the backend for a datagram, or UINT32_MAX to drop it.
+//
+uint32_t
+LbRoute(
+    _In_reads_(Length) const uint8_t* Buffer,
+    _In_ uint16_t Length
+    )
+{
+    const uint8_t* Cid;
+    uint8_t CidLength;
+    if (Length == 0) {
+        return UINT32_MAX;
+    }
+    if (Buffer[0] & 0x80) { // Long header
+        if (Length < 6 || Buffer[5] > LB_MAX_CID_LENGTH || Length < 6 + Buffer[5]) {
+            return UINT32_MAX;
+        }
+        CidLength = Buffer[5];
+        Cid = Buffer + 6;
+    } else {
+        CidLength = (uint8_t)CXPLAT_MIN(Length - 1, LB_MAX_CID_LENGTH);
+        Cid = Buffer + 1;
+    }
+
+    if (LbConfigSet &&
+        CidLength >= LbCidLength &&
+        (Cid[0] >> 5) == LbConfig.ConfigId) {
+        uint8_t Block[LB_MAX_PLAINTEXT_LENGTH];
+        CxPlatCopyMemory(Block, Cid + 1, LbCidLength - 1);
+        if (LbConfig.Encrypt) {
+            LbKey& Key = Keys[CxPlatProcCurrentNumber() % CxPlatProcCount()];
+            std::lock_guard<std::mutex> Scope(Key.Lock);
+            LbFourPass(Key.Key, LbCidLength - 1, Block, true);
+        }
+        uint64_t ServerId = 0;
+        CxPlatCopyMemory(&ServerId, Block, LbConfig.ServerIdLength);
+        auto Entry = ServerIds.find(ServerId);
+        if (Entry != ServerIds.end()) {
+            return Entry->second;
+        }
+    }
+
+    //
+    // Not routable by server ID: FNV-1a hash the start of the CID, so all
+    // load balancers agree on the backend.
+    //
+    uint64_t Hash = 14695981039346656037ULL;
+    for (uint8_t i = 0; i < CXPLAT_MIN(CidLength, LB_HASH_CID_LENGTH); ++i) {
+        Hash = (Hash ^ Cid[i]) * 1099511628211ULL;
+    }
+    return LbJumpHash(Hash, (uint32_t)Backends.size());
+}
 
 struct LbInterface {
     bool IsPublic;
@@ -54,65 +260,97 @@ struct LbInterface {
         CxPlatSocketDelete(Socket);
     }
 
+    //
+    // Takes ownership of (and returns) the receive data.
+    //
     virtual void Receive(_In_ CXPLAT_RECV_DATA* RecvDataChain) = 0;
 
-    void Send(_In_ CXPLAT_RECV_DATA* RecvDataChain, _In_opt_ const QUIC_ADDR* PeerAddress = nullptr) {
-        QUIC_ADDR RemoteAddress;
-        if (PeerAddress == nullptr) {
-            CxPlatSocketGetRemoteAddress(Socket, &RemoteAddress);
-            PeerAddress = &RemoteAddress;
-        }
-        CXPLAT_ROUTE Route = {0};
-        Route.LocalAddress = LocalAddress;
-        Route.RemoteAddress = *PeerAddress;
-        CXPLAT_SEND_DATA* Send = nullptr;
-        CXPLAT_SEND_CONFIG SendConfig = { &Route, MAX_UDP_PAYLOAD_LENGTH, CXPLAT_ECN_NON_ECT, 0 };
-        while (RecvDataChain) {
-            if (!Send) {
-                Send = CxPlatSendDataAlloc(Socket, &SendConfig);
+    //
+    // Copies the datagrams into as few sends as possible. Datagrams of the
+    // same size are packed into one (segmented) send, which may only end with
+    // a smaller one.
+    //
+    uint32_t Send(_In_ CXPLAT_RECV_DATA* RecvDataChain, _In_ const CXPLAT_ROUTE* PeerRoute) {
+        CXPLAT_ROUTE Route = *PeerRoute;
+        CXPLAT_SEND_CONFIG SendConfig = { &Route, 0, CXPLAT_ECN_NON_ECT, 0, 0 };
+        CXPLAT_SEND_DATA* SendData = nullptr;
+        uint32_t Count = 0;
+        for (; RecvDataChain; RecvDataChain = RecvDataChain->Next) {
+            const uint16_t Length = RecvDataChain->BufferLength;
+            if (Length == 0) {
+                continue;
             }
-            if (Send) {
-                auto Buffer = CxPlatSendDataAllocBuffer(Send, MAX_UDP_PAYLOAD_LENGTH);
-                if (!Buffer) {
-                    (void)CxPlatSocketSend(Socket, &Route, Send);
-                    Send = CxPlatSendDataAlloc(Socket, &SendConfig);
-                    if (Send) {
-                        Buffer = CxPlatSendDataAllocBuffer(Send, MAX_UDP_PAYLOAD_LENGTH);
-                    }
+            QUIC_BUFFER* Buffer = nullptr;
+            if (SendData && Length <= SendConfig.MaxPacketSize) {
+                Buffer = CxPlatSendDataAllocBuffer(SendData, Length);
+            }
+            if (!Buffer) {
+                if (SendData) {
+                    CxPlatSocketSend(Socket, &Route, SendData);
+                }
+                SendConfig.MaxPacketSize = Length;
+                SendData = CxPlatSendDataAlloc(Socket, &SendConfig);
+                if (!SendData) {
+                    continue;
                 }
-                if (Buffer) {
-                    Buffer->Length = RecvDataChain->BufferLength;
-                    CxPlatCopyMemory(Buffer->Buffer, RecvDataChain->Buffer, RecvDataChain->BufferLength);
+                Buffer = CxPlatSendDataAllocBuffer(SendData, Length);
+                if (!Buffer) {
+                    continue;
                 }
             }
-            RecvDataChain = RecvDataChain->Next;
+            CxPlatCopyMemory(Buffer->Buffer, RecvDataChain->Buffer, Length);
+            Buffer->Length = Length;
+            Count++;
         }
-        if (Send) {
-            (void)CxPlatSocketSend(Socket, &Route, Send);
+        if (SendData) {
+            CxPlatSocketSend(Socket, &Route, SendData);
         }
+        return Count;
     }
 };
 
 //
 // Represents a NAT'ed socket from the load balancer back to a single private
-// server address.
+// server address, for a single public client address.
 //
 struct LbPrivateInterface : public LbInterface {
-    const QUIC_ADDR PeerAddress {0};
+    const CXPLAT_ROUTE PeerRoute;
+    CXPLAT_ROUTE Route;
+    std::atomic<bool> RouteResolved {false};
 
-    LbPrivateInterface(_In_ const QUIC_ADDR* PrivateAddress, _In_ const QUIC_ADDR* PeerAddress)
-        : LbInterface(PrivateAddress, false), PeerAddress(*PeerAddress) {
+    LbPrivateInterface(_In_ const QUIC_ADDR* PrivateAddress, _In_ const CXPLAT_ROUTE* PeerRoute)
+        : LbInterface(PrivateAddress, false), PeerRoute(*PeerRoute) {
+        CxPlatZeroMemory(&Route, sizeof(Route));
+        Route.LocalAddress = LocalAddress;
+        Route.RemoteAddress = *PrivateAddress;
+        if (QUIC_SUCCEEDED(CxPlatResolveRoute(Socket, &Route, 0, this, ResolveRouteComplete)) &&
+            Route.State == RouteResolved) {
+            RouteResolved = true;
+        }
         if (Verbose) {
             QUIC_ADDR_STR PeerStr, PrivateStr;
-            QuicAddrToString(PeerAddress, &PeerStr);
+            QuicAddrToString(&PeerRoute->RemoteAddress, &PeerStr);
             QuicAddrToString(PrivateAddress, &PrivateStr);
             printf("New private interface, %s => %s\n", PeerStr.Address, PrivateStr.Address);
         }
     }
 
-    void Receive(_In_ CXPLAT_RECV_DATA* RecvDataChain) {
-        PublicInterface->Send(RecvDataChain, &PeerAddress);
+    static void ResolveRouteComplete(
+        _Inout_ void* Context,
+        _When_(Succeeded == FALSE, _Reserved_)
+        _When_(Succeeded == TRUE, _In_reads_bytes_(6))
+            const uint8_t* PhysicalAddress,
+        _In_ uint8_t PathId,
+        _In_ BOOLEAN Succeeded
+        ) {
+        auto This = (LbPrivateInterface*)Context;
+        if (Succeeded) {
+            CxPlatResolveRouteComplete(This, &This->Route, PhysicalAddress, PathId);
+            This->RouteResolved = true;
+        }
     }
+
+    void Receive(_In_ CXPLAT_RECV_DATA* RecvDataChain);
 };
 
 //
@@ -120,111 +358,450 @@ struct LbPrivateInterface : public LbInterface {
 // packets between public clients and back end (private) server addresses.
 //
 struct LbPublicInterface : public LbInterface {
+    struct Key {
+        QUIC_ADDR Peer;
+        uint32_t Backend;
+    };
+
     struct Hasher {
         CXPLAT_TOEPLITZ_HASH Toeplitz;
         Hasher() {
             CxPlatRandom(CXPLAT_TOEPLITZ_KEY_SIZE, &Toeplitz.HashKey);
             CxPlatToeplitzHashInitialize(&Toeplitz);
         }
-        size_t operator() (const std::pair<QUIC_ADDR, QUIC_ADDR> key) const {
-            uint32_t Key = 0, Offset;
-            CxPlatToeplitzHashComputeAddr(&Toeplitz, &key.first, &Key, &Offset);
-            CxPlatToeplitzHashComputeAddr(&Toeplitz, &key.second, &Key, &Offset);
-            return Key;
+        size_t operator() (const Key& key) const {
+            uint32_t Hash = 0, Offset;
+            CxPlatToeplitzHashComputeAddr(&Toeplitz, &key.Peer, &Hash, &Offset);
+            return Hash ^ key.Backend;
         }
     };
 
     struct EqualFn {
-        bool operator() (const std::pair<QUIC_ADDR, QUIC_ADDR>& t1, const std::pair<QUIC_ADDR, QUIC_ADDR>& t2) const {
-            return QuicAddrCompare(&t1.second, &t2.second);
+        bool operator() (const Key& t1, const Key& t2) const {
+            return t1.Backend == t2.Backend && QuicAddrCompare(&t1.Peer, &t2.Peer);
         }
     };
 
-    std::unordered_map<std::pair<QUIC_ADDR, QUIC_ADDR>, LbPrivateInterface*, Hasher, EqualFn> PrivateInterfaces;
-    std::mutex Lock;
-    uint32_t NextInterface = 0;
+    std::unordered_map<Key, LbPrivateInterface*, Hasher, EqualFn> PrivateInterfaces;
+    std::shared_mutex Lock;
 
     LbPublicInterface(_In_ const QUIC_ADDR* PublicAddress) : LbInterface(PublicAddress, true) { }
 
     ~LbPublicInterface() {
-        // TODO - Iterate over private interfaces and delete
+        for (auto& Entry : PrivateInterfaces) {
+            delete Entry.second;
+        }
     }
 
     void Receive(_In_ CXPLAT_RECV_DATA* RecvDataChain) {
-        auto PrivateInterface =
-            GetPrivateInterface(
-                &RecvDataChain->Route->LocalAddress,
-                &RecvDataChain->Route->RemoteAddress);
-        PrivateInterface->Send(RecvDataChain);
+        //
+        // Route the whole batch first, collecting per destination chains so
+        // that each is forwarded with as few sends as possible.
+        //
+        struct {
+            LbPrivateInterface* Interface;
+            CXPLAT_RECV_DATA* Head;
+            CXPLAT_RECV_DATA** Tail;
+        } Batches[LB_MAX_BATCH_DESTINATIONS];
+        uint32_t BatchCount = 0;
+        CXPLAT_RECV_DATA* Dropped = nullptr;
+
+        while (RecvDataChain) {
+            CXPLAT_RECV_DATA* Datagram = RecvDataChain;
+            RecvDataChain = RecvDataChain->Next;
+            Datagram->Next = nullptr;
+
+            const uint32_t Backend = LbRoute(Datagram->Buffer, Datagram->BufferLength);
+            LbPrivateInterface* Interface =
+                Backend == UINT32_MAX ? nullptr : GetPrivateInterface(Datagram->Route, Backend);
+            if (!Interface) {
+                Datagram->Next = Dropped;
+                Dropped = Datagram;
+                continue;
+            }
+
+            uint32_t i = 0;
+            while (i < BatchCount && Batches[i].Interface != Interface) {
+                ++i;
+            }
+            if (i == BatchCount) {
+                if (BatchCount == LB_MAX_BATCH_DESTINATIONS) {
+                    Flush(Batches[0].Interface, Batches[0].Head);
+                    Batches[0] = Batches[--BatchCount];
+                    i = BatchCount;
+                }
+                Batches[i].Interface = Interface;
+                Batches[i].Head = nullptr;
+                Batches[i].Tail = &Batches[i].Head;
+                BatchCount++;
+            }
+            *Batches[i].Tail = Datagram;
+            Batches[i].Tail = &Datagram->Next;
+        }
+
+        for (uint32_t i = 0; i < BatchCount; ++i) {
+            Flush(Batches[i].Interface, Batches[i].Head);
+        }
+        if (Dropped) {
+            uint64_t Count = 0;
+            for (auto Datagram = Dropped; Datagram; Datagram = Datagram->Next) {
+                Count++;
+            }
+            DroppedCount.fetch_add(Count, std::memory_order_relaxed);
+            CxPlatRecvDataReturn(Dropped);
+        }
     }
 
-    LbInterface* GetPrivateInterface(_In_ const QUIC_ADDR* Local, _In_ const QUIC_ADDR* Remote) {
-        std::lock_guard<std::mutex> Scope(Lock);
-        auto& Entry = PrivateInterfaces[std::pair{*Local, *Remote}];
+    static void Flush(_In_ LbPrivateInterface* Interface, _In_ CXPLAT_RECV_DATA* Chain) {
+        if (Interface->RouteResolved) {
+            ForwardedCount.fetch_add(
+                Interface->Send(Chain, &Interface->Route), std::memory_order_relaxed);
+        }
+        CxPlatRecvDataReturn(Chain);
+    }
+
+    LbPrivateInterface* GetPrivateInterface(_In_ const CXPLAT_ROUTE* PeerRoute, _In_ uint32_t Backend) {
+        const Key key { PeerRoute->RemoteAddress, Backend };
+        {
+            std::shared_lock<std::shared_mutex> Scope(Lock);
+            auto Entry = PrivateInterfaces.find(key);
+            if (Entry != PrivateInterfaces.end()) {
+                return Entry->second;
+            }
+        }
+        std::unique_lock<std::shared_mutex> Scope(Lock);
+        auto& Entry = PrivateInterfaces[key];
         if (!Entry) {
-            Entry = new LbPrivateInterface(&PrivateAddrs[NextInterface++ % PrivateAddrs.size()], Remote);
+            Entry = new LbPrivateInterface(&Backends[Backend].Address, PeerRoute);
         }
         return Entry;
     }
 };
 
+void LbPrivateInterface::Receive(_In_ CXPLAT_RECV_DATA* RecvDataChain) {
+    ForwardedCount.fetch_add(
+        PublicInterface->Send(RecvDataChain, &PeerRoute), std::memory_order_relaxed);
+    CxPlatRecvDataReturn(RecvDataChain);
+}
+
 void LbReceive(_In_ CXPLAT_SOCKET*, _In_ void* Context, _In_ CXPLAT_RECV_DATA* RecvDataChain) {
     ((LbInterface*)(Context))->Receive(RecvDataChain);
-    CxPlatRecvDataReturn(RecvDataChain);
 }
 
 void NoOpUnreachable(_In_ CXPLAT_SOCKET*,_In_ void*, _In_ const QUIC_ADDR*) { }
 
+uint64_t
+LbProcessCpuTimeUs(
+    void
+    )
+{
+#ifdef _WIN32
+    FILETIME Creation, Exit, Kernel, User;
+    if (!GetProcessTimes(GetCurrentProcess(), &Creation, &Exit, &Kernel, &User)) {
+        return 0;
+    }
+    return
+        (((uint64_t)Kernel.dwHighDateTime << 32 | Kernel.dwLowDateTime) +
+         ((uint64_t)User.dwHighDateTime << 32 | User.dwLowDateTime)) / 10;
+#else
+    struct rusage Usage;
+    if (getrusage(RUSAGE_SELF, &Usage) != 0) {
+        return 0;
+    }
+    return
+        (uint64_t)(Usage.ru_utime.tv_sec + Usage.ru_stime.tv_sec) * 1000000 +
+        (uint64_t)(Usage.ru_utime.tv_usec + Usage.ru_stime.tv_usec);
+#endif
+}
+
+//
+// Keeps the benchmark's routing results from being optimized away.
+//
+volatile uint32_t LbBenchmarkResult;
+
+//
+// Measures how many packets per second a single core can route, for server
+// ID routable short header packets and for hashed Initial packets.
+//
+void
+LbBenchmark(
+    _In_ uint32_t DurationMs
+    )
+{
+    const uint32_t PacketCount = 1024;
+    const uint8_t CidLength = LbCidLength + LB_MSQUIC_CID_SUFFIX_LENGTH;
+    std::vector<uint8_t> Packets(PacketCount * 64);
+    std::vector<uint32_t> Expected(PacketCount);
+
+    CXPLAT_HP_KEY* Key = nullptr;
+    if (LbConfig.Encrypt &&
+        QUIC_FAILED(CxPlatHpKeyCreate(CXPLAT_AEAD_AES_128_GCM, LbConfig.Key, &Key))) {
+        printf("CxPlatHpKeyCreate failed.\n");
+        exit(1);
+    }
+
+    for (uint32_t Initial = 0; Initial < 2; ++Initial) {
+        for (uint32_t i = 0; i < PacketCount; ++i) {
+            uint8_t* Packet = &Packets[i * 64];
+            CxPlatRandom(64, Packet);
+            uint8_t* Cid;
+            if (Initial) {
+                Packet[0] = 0xC0;
+                Packet[5] = 8;
+                Cid = Packet + 6;
+                Cid[0] |= 0xE0; // Unroutable
+                Expected[i] = UINT32_MAX;
+            } else {
+                Packet[0] = 0x40;
+                Cid = Packet + 1;
+                Expected[i] = i % Backends.size();
+                Cid[0] = (uint8_t)((LbConfig.ConfigId << 5) | (CidLength - 1));
+                CxPlatCopyMemory(Cid + 1, &Backends[Expected[i]].ServerId, LbConfig.ServerIdLength);
+                if (Key) {
+                    LbFourPass(Key, LbCidLength - 1, Cid + 1, false);
+                }
+            }
+        }
+
+        for (uint32_t i = 0; i < PacketCount; ++i) {
+            const uint32_t Backend = LbRoute(&Packets[i * 64], 64);
+            if (Expected[i] != UINT32_MAX && Backend != Expected[i]) {
+                printf("Routed packet %u to backend %u, expected %u!\n", i, Backend, Expected[i]);
+                exit(1);
+            }
+        }
+
+        uint64_t Routed = 0;
+        uint32_t Result = 0;
+        const uint64_t Start = CxPlatTimeUs64();
+        uint64_t Elapsed;
+        do {
+            for (uint32_t i = 0; i < PacketCount; ++i) {
+                Result ^= LbRoute(&Packets[i * 64], 64);
+            }
+            Routed += PacketCount;
+            Elapsed = CxPlatTimeDiff64(Start, CxPlatTimeUs64());
+        } while (Elapsed < (uint64_t)DurationMs * 1000);
+
+        LbBenchmarkResult = Result;
+
+        printf(
+            "%-28s %.2f Mpps per core\n",
+            Initial ? "Initial (consistent hash):" : (Key ? "Short header (encrypted):" : "Short header (plaintext):"),
+            (double)Routed / (double)Elapsed);
+    }
+
+    CxPlatHpKeyFree(Key);
+}
+
+bool
+ParseHex(
+    _In_z_ const char* Hex,
+    _In_ uint32_t Length,
+    _Out_writes_(Length) uint8_t* Bytes
+    )
+{
+    if (strlen(Hex) != Length * 2) {
+        return false;
+    }
+    for (uint32_t i = 0; i < Length; ++i) {
+        unsigned int Byte;
+        if (sscanf(Hex + i * 2, "%2x", &Byte) != 1) {
+            return false;
+        }
+        Bytes[i] = (uint8_t)Byte;
+    }
+    return true;
+}
+
+void
+PrintUsage(
+    void
+    )
+{
+    printf(
+        "Usage: quiclb -pub:<address> -priv:<address>[/<server id>],... [options]\n"
+        "       quiclb -bench[:<ms>] [-lb:...]\n"
+        "\n"
+        "Options:\n"
+        "  -lb:<config id>,<server id len>,<nonce len>[,<key>]\n"
+        "                 QUIC-LB config of the servers. Server IDs and the AES-128\n"
+        "                 key are hex. Without a key, server IDs are in plaintext.\n"
+        "  -xdp           Use the XDP datapath, when available.\n"
+        "  -stats         Print forwarding rates every second.\n"
+        "  -v             Verbose logging.\n");
+}
+
 int
 QUIC_MAIN_EXPORT
 main(int argc, char **argv)
 {
     const char* PublicAddress = "";
     const char* PrivateAddresses = "";
-    if (!TryGetValue(argc, argv, "pub", &PublicAddress) ||
+    const char* Config = nullptr;
+    uint32_t BenchmarkMs = 0;
+    const bool Benchmark = GetFlag(argc, argv, "bench");
+    if (Benchmark) {
+        BenchmarkMs = 2000;
+        TryGetValue(argc, argv, "bench", &BenchmarkMs);
+    } else if (!TryGetValue(argc, argv, "pub", &PublicAddress) ||
         !TryGetValue(argc, argv, "priv", &PrivateAddresses)) {
-        printf("Usage: quiclb -pub:<address> -priv:<address>,<address>\n");
+        PrintUsage();
         exit(1);
     }
     Verbose = GetFlag(argc, argv, "v") || GetFlag(argc, argv, "verbose");
-
-    QUIC_ADDR PublicAddr;
-    if (!QuicAddrFromString(PublicAddress, 0, &PublicAddr) ||
-        !QuicAddrGetPort(&PublicAddr)) {
-        printf("Failed to decode -pub address: %s.\n", PublicAddress);
-        exit(1);
+    const bool PrintStats = GetFlag(argc, argv, "stats");
+
+    if (TryGetValue(argc, argv, "lb", &Config)) {
+        char KeyHex[2 * QUIC_LOAD_BALANCING_KEY_LENGTH + 1] = "";
+        unsigned int ConfigId, ServerIdLength, NonceLength;
+        int Fields = sscanf(Config, "%u,%u,%u,%32s", &ConfigId, &ServerIdLength, &NonceLength, KeyHex);
+        if (Fields < 3 ||
+            ConfigId > 6 ||
+            ServerIdLength == 0 || ServerIdLength > sizeof(uint64_t) ||
+            NonceLength < QUIC_LOAD_BALANCING_MIN_NONCE_LENGTH ||
+            ServerIdLength + NonceLength > LB_MAX_PLAINTEXT_LENGTH) {
+            printf("Invalid -lb config: %s. Server IDs up to 8 bytes are supported.\n", Config);
+            exit(1);
+        }
+        LbConfig.ConfigId = (uint8_t)ConfigId;
+        LbConfig.ServerIdLength = (uint8_t)ServerIdLength;
+        LbConfig.NonceLength = (uint8_t)NonceLength;
+        if (Fields == 4) {
+            if (ServerIdLength + NonceLength == CXPLAT_HP_SAMPLE_LENGTH ||
+                !ParseHex(KeyHex, QUIC_LOAD_BALANCING_KEY_LENGTH, LbConfig.Key)) {
+                printf("Invalid -lb key: %s. Single-pass (16 byte) configs aren't supported.\n", KeyHex);
+                exit(1);
+            }
+            LbConfig.Encrypt = TRUE;
+        }
+        LbCidLength = (uint8_t)(1 + ServerIdLength + NonceLength);
+        LbConfigSet = true;
     }
 
-    while (true) {
-        char* End = (char*)strchr(PrivateAddresses, ',');
-        if (End) { *End = 0; }
+    if (Benchmark) {
+        if (!LbConfigSet) {
+            LbConfig.ConfigId = 0; // MsQuic's default QUIC-LB layout
+            LbConfig.ServerIdLength = 3;
+            LbConfig.NonceLength = 4;
+            LbCidLength = 8;
+            LbConfigSet = true;
+        }
+        for (uint32_t i = 0; i < 16; ++i) {
+            LbBackend Backend = {};
+            Backend.ServerId = i + 1;
+            ServerIds[Backend.ServerId] = i;
+            Backends.push_back(Backend);
+        }
 
-        QUIC_ADDR PrivateAddr;
-        if (!QuicAddrFromString(PrivateAddresses, 0, &PrivateAddr) ||
-            !QuicAddrGetPort(&PrivateAddr)) {
-            printf("Failed to decode -priv address: %s.\n", PrivateAddresses);
+    } else {
+        QUIC_ADDR PublicAddr;
+        if (!QuicAddrFromString(PublicAddress, 0, &PublicAddr) ||
+            !QuicAddrGetPort(&PublicAddr)) {
+            printf("Failed to decode -pub address: %s.\n", PublicAddress);
             exit(1);
         }
-        PrivateAddrs.push_back(PrivateAddr);
 
-        if (!End) { break; }
-        PrivateAddresses = End + 1;
+        while (true) {
+            char* End = (char*)strchr(PrivateAddresses, ',');
+            if (End) { *End = 0; }
+
+            LbBackend Backend = {};
+            char* ServerId = (char*)strchr(PrivateAddresses, '/');
+            if (ServerId) { *ServerId++ = 0; }
+            if (!QuicAddrFromString(PrivateAddresses, 0, &Backend.Address) ||
+                !QuicAddrGetPort(&Backend.Address)) {
+                printf("Failed to decode -priv address: %s.\n", PrivateAddresses);
+                exit(1);
+            }
+            if (ServerId) {
+                if (!LbConfigSet ||
+                    !ParseHex(ServerId, LbConfig.ServerIdLength, (uint8_t*)&Backend.ServerId)) {
+                    printf("Invalid server ID (or missing -lb config): %s.\n", ServerId);
+                    exit(1);
+                }
+                ServerIds[Backend.ServerId] = (uint32_t)Backends.size();
+            }
+            Backends.push_back(Backend);
+
+            if (!End) { break; }
+            PrivateAddresses = End + 1;
+        }
     }
 
     CxPlatSystemLoad();
     CxPlatInitialize();
-    CxPlatWorkerPoolInit(&WorkerPool);
 
-    CXPLAT_UDP_DATAPATH_CALLBACKS LbUdpCallbacks { LbReceive, NoOpUnreachable };
-    CxPlatDataPathInitialize(0, &LbUdpCallbacks, nullptr, &WorkerPool, nullptr, &Datapath);
-    PublicInterface = new LbPublicInterface(&PublicAddr);
+    if (LbConfig.Encrypt) {
+        Keys = new LbKey[CxPlatProcCount()];
+        for (uint32_t i = 0; i < CxPlatProcCount(); ++i) {
+            if (QUIC_FAILED(CxPlatHpKeyCreate(CXPLAT_AEAD_AES_128_GCM, LbConfig.Key, &Keys[i].Key))) {
+                printf("CxPlatHpKeyCreate failed.\n");
+                exit(1);
+            }
+        }
+    }
+
+    if (Benchmark) {
+        LbBenchmark(BenchmarkMs);
+
+    } else {
+        QUIC_ADDR PublicAddr;
+        QuicAddrFromString(PublicAddress, 0, &PublicAddr);
+
+        CxPlatWorkerPoolInit(&WorkerPool);
+        QUIC_EXECUTION_CONFIG ExecutionConfig = { QUIC_EXECUTION_CONFIG_FLAG_XDP, 0, 0, {0} };
+        CXPLAT_UDP_DATAPATH_CALLBACKS LbUdpCallbacks { LbReceive, NoOpUnreachable };
+        if (QUIC_FAILED(
+            CxPlatDataPathInitialize(
+                0,
+                &LbUdpCallbacks,
+                nullptr,
+                &WorkerPool,
+                GetFlag(argc, argv, "xdp") ? &ExecutionConfig : nullptr,
+                &Datapath))) {
+            printf("CxPlatDataPathInitialize failed.\n");
+            exit(1);
+        }
+        PublicInterface = new LbPublicInterface(&PublicAddr);
+
+        if (PrintStats) {
+            printf("Press Ctrl+C to exit.\n\n");
+            uint64_t LastForwarded = 0, LastCpuUs = LbProcessCpuTimeUs();
+            uint64_t LastTime = CxPlatTimeUs64();
+            while (true) {
+                std::this_thread::sleep_for(std::chrono::seconds(1));
+                const uint64_t Forwarded = ForwardedCount.load(std::memory_order_relaxed);
+                const uint64_t CpuUs = LbProcessCpuTimeUs();
+                const uint64_t Now = CxPlatTimeUs64();
+                const uint64_t ElapsedUs = CxPlatTimeDiff64(LastTime, Now);
+                const uint64_t Packets = Forwarded - LastForwarded;
+                printf(
+                    "Forwarded %.3f Mpps, %.3f Mpps per core (%.1f cores busy), %llu dropped\n",
+                    (double)Packets / (double)ElapsedUs,
+                    CpuUs == LastCpuUs ? 0.0 : (double)Packets / (double)(CpuUs - LastCpuUs),
+                    (double)(CpuUs - LastCpuUs) / (double)ElapsedUs,
+                    (unsigned long long)DroppedCount.load(std::memory_order_relaxed));
+                LastForwarded = Forwarded;
+                LastCpuUs = CpuUs;
+                LastTime = Now;
+            }
+        }
+
+        printf("Press Enter to exit.\n\n");
+        getchar();
 
-    printf("Press Enter to exit.\n\n");
-    getchar();
+        delete PublicInterface;
+        CxPlatDataPathUninitialize(Datapath);
+        CxPlatWorkerPoolUninit(&WorkerPool);
+    }
 
-    delete PublicInterface;
-    CxPlatDataPathUninitialize(Datapath);
-    CxPlatWorkerPoolUninit(&WorkerPool);
+    if (Keys) {
+        for (uint32_t i = 0; i < CxPlatProcCount(); ++i) {
+            CxPlatHpKeyFree(Keys[i].Key);
+        }
+        delete[] Keys;
+    }
     CxPlatUninitialize();
     CxPlatSystemUnload();
 
@@ -9,6 +9,13 @@
 #include "quic_datapath.h"
 #include "msquic.hpp"
 
+#ifdef _WIN32
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
 const MsQuicApi* MsQuic;
 CXPLAT_WORKER_POOL WorkerPool;
 volatile long ConnectedCount;
@@ -42,9 +49,190 @@ QUIC_STATUS ConnectionCallback(_In_ struct MsQuicConnection* , _In_opt_ void* ,
     return QUIC_STATUS_SUCCESS;
 }
 
+//
+// The process's resident memory. Falls back to the peak on platforms without
+// a cheap way to read the current value.
+//
+uint64_t GetResidentBytes() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS Counters;
+    return GetProcessMemoryInfo(GetCurrentProcess(), &Counters, sizeof(Counters)) ? Counters.WorkingSetSize : 0;
+#elif defined(__linux__)
+    FILE* File = fopen("/proc/self/statm", "r");
+    if (File == nullptr) return 0;
+    unsigned long long Size = 0, Resident = 0;
+    int Count = fscanf(File, "%llu %llu", &Size, &Resident);
+    fclose(File);
+    return Count == 2 ? Resident * (uint64_t)sysconf(_SC_PAGESIZE) : 0;
+#else
+    struct rusage Usage;
+    return getrusage(RUSAGE_SELF, &Usage) == 0 ? (uint64_t)Usage.ru_maxrss : 0; // Bytes on macOS
+#endif
+}
+
+uint64_t GetProcessCpuTimeUs() {
+#ifdef _WIN32
+    FILETIME CreationTime, ExitTime, KernelTime, UserTime;
+    if (!GetProcessTimes(GetCurrentProcess(), &CreationTime, &ExitTime, &KernelTime, &UserTime)) {
+        return 0;
+    }
+    const uint64_t Kernel = ((uint64_t)KernelTime.dwHighDateTime << 32) | KernelTime.dwLowDateTime;
+    const uint64_t User = ((uint64_t)UserTime.dwHighDateTime << 32) | UserTime.dwLowDateTime;
+    return NS100_TO_US(Kernel + User);
+#else
+    struct rusage Usage;
+    if (getrusage(RUSAGE_SELF, &Usage) != 0) {
+        return 0;
+    }
+    return
+        S_TO_US((uint64_t)Usage.ru_utime.tv_sec) + (uint64_t)Usage.ru_utime.tv_usec +
+        S_TO_US((uint64_t)Usage.ru_stime.tv_sec) + (uint64_t)Usage.ru_stime.tv_usec;
+#endif
+}
+
+//
+// A snapshot of the cost of the connections open at one point in time.
+//
+struct LoadSample {
+    uint64_t TimeUs {0};
+    uint64_t CpuTimeUs {0};
+    uint64_t ResidentBytes {0};
+    uint64_t LibraryBytes {0};      // Registration memory usage, all categories
+    uint64_t WorkerBusyUs {0};      // Summed over all the workers
+    uint64_t TimerConnections {0};  // Connections with a timer armed
+    int64_t DatagramsSent {0};
+
+    void Take(HQUIC Registration) {
+        TimeUs = CxPlatTimeUs64();
+        CpuTimeUs = GetProcessCpuTimeUs();
+        ResidentBytes = GetResidentBytes();
+
+        QUIC_MEMORY_USAGE Usage = {0};
+        uint32_t Length = sizeof(Usage);
+        if (QUIC_SUCCEEDED(MsQuic->GetParam(Registration, QUIC_PARAM_REGISTRATION_MEMORY_USAGE, &Length, &Usage))) {
+            LibraryBytes =
+                Usage.ConnectionBytes + Usage.StreamBytes + Usage.SendBufferBytes +
+                Usage.RecvBufferBytes + Usage.SentPacketMetadataBytes + Usage.TlsBytes +
+                Usage.PathBytes + Usage.PacketSpaceBytes;
+        }
+
+        int64_t Counters[QUIC_PERF_COUNTER_MAX] = {0};
+        Length = sizeof(Counters);
+        if (QUIC_SUCCEEDED(MsQuic->GetParam(nullptr, QUIC_PARAM_GLOBAL_PERF_COUNTERS, &Length, Counters))) {
+            DatagramsSent = Counters[QUIC_PERF_COUNTER_UDP_SEND];
+        }
+
+        WorkerBusyUs = TimerConnections = 0;
+        QUIC_WORKER_STATISTICS Workers[256];
+        Length = sizeof(Workers);
+        if (QUIC_SUCCEEDED(MsQuic->GetParam(nullptr, QUIC_PARAM_GLOBAL_WORKER_STATISTICS, &Length, Workers))) {
+            for (uint32_t i = 0; i < Length / sizeof(QUIC_WORKER_STATISTICS); ++i) {
+                WorkerBusyUs += Workers[i].BusyTimeUs;
+                TimerConnections += Workers[i].TimerWheelConnectionCount;
+            }
+        }
+    }
+};
+
+//
+// Ramps up to ConnectionCount connections, StepCount at a time. After each
+// step, the connections are left idle for DwellMs and the cost of keeping them
+// open is printed.
+//
+void RunScalingSteps(
+    MsQuicRegistration& Registration,
+    MsQuicConfiguration& Config,
+    const char* ServerName,
+    const QuicAddr& ServerAddress,
+    uint32_t ConnectionCount,
+    uint32_t StepCount,
+    uint32_t DwellMs,
+    uint32_t SocketCount) {
+
+    QuicAddr* LocalAddresses = new(std::nothrow) QuicAddr[SocketCount];
+    if (LocalAddresses == nullptr) return;
+    LoadSample Baseline;
+    Baseline.Take(Registration);
+
+    printf("%10s %8s %10s %10s %8s %10s %10s %10s %10s\n",
+        "conns", "hs/s", "rss/conn", "quic/conn", "idle cpu", "busy us/s", "timers", "sends/s", "us/send");
+
+    uint32_t Started = 0;
+    while (Started < ConnectionCount) {
+        const uint32_t Target = CXPLAT_MIN(Started + StepCount, ConnectionCount);
+
+        //
+        // Open this step's connections, spread over the shared sockets, and
+        // wait for their handshakes to finish (or stall).
+        //
+        const uint64_t StepStart = CxPlatTimeUs64();
+        const long ConnectedBefore = ConnectedCount;
+        for (; Started < Target; ++Started) {
+            const uint32_t Socket = Started % SocketCount;
+            auto Connection = new(std::nothrow) MsQuicConnection(Registration, CleanUpAutoDelete, ConnectionCallback);
+            Connection->SetRemoteAddr(ServerAddress);
+            Connection->SetShareUdpBinding();
+            if (Started >= SocketCount) Connection->SetLocalAddr(LocalAddresses[Socket]);
+            InterlockedIncrement(&ConnectionsActive);
+            Connection->Start(Config, ServerName, 443);
+            if (Started < SocketCount) Connection->GetLocalAddr(LocalAddresses[Socket]);
+        }
+        long LastProgress = -1;
+        uint64_t LastProgressTime = CxPlatTimeMs64();
+        while (true) {
+            const long Done = ConnectedCount + ((long)Started - ConnectionsActive);
+            if (Done >= (long)Started) break;
+            if (Done != LastProgress) {
+                LastProgress = Done;
+                LastProgressTime = CxPlatTimeMs64();
+            } else if (CxPlatTimeMs64() - LastProgressTime > 10 * 1000) {
+                printf("Handshakes stalled at %ld of %u\n", Done, Started);
+                break;
+            }
+            CxPlatSleep(10);
+        }
+        const uint64_t HandshakeTime = CxPlatTimeUs64() - StepStart;
+        const uint64_t Handshakes = (uint64_t)(ConnectedCount - ConnectedBefore);
+
+        //
+        // Measure the steady state cost of keeping them all open.
+        //
+        LoadSample Begin, End;
+        Begin.Take(Registration);
+        CxPlatSleep(DwellMs);
+        End.Take(Registration);
+
+        const uint64_t Open = (uint64_t)(ConnectionsActive > 0 ? ConnectionsActive : 0);
+        const uint64_t Elapsed = CXPLAT_MAX(End.TimeUs - Begin.TimeUs, 1ull);
+        const uint64_t CpuTime = End.CpuTimeUs - Begin.CpuTimeUs;
+        const uint64_t Sends = (uint64_t)(End.DatagramsSent - Begin.DatagramsSent);
+        printf("%10llu %8llu %10llu %10llu %7.2f%% %10llu %10llu %10llu %10llu\n",
+            (unsigned long long)Open,
+            (unsigned long long)(HandshakeTime ? Handshakes * 1000 * 1000 / HandshakeTime : 0),
+            (unsigned long long)(Open && End.ResidentBytes > Baseline.ResidentBytes ? (End.ResidentBytes - Baseline.ResidentBytes) / Open : 0),
+            (unsigned long long)(Open && End.LibraryBytes > Baseline.LibraryBytes ? (End.LibraryBytes - Baseline.LibraryBytes) / Open : 0),
+            (double)CpuTime * 100 / Elapsed,
+            (unsigned long long)((End.WorkerBusyUs - Begin.WorkerBusyUs) * 1000 * 1000 / Elapsed),
+            (unsigned long long)End.TimerConnections,
+            (unsigned long long)(Sends * 1000 * 1000 / Elapsed),
+            (unsigned long long)(Sends ? CpuTime / Sends : 0));
+    }
+
+    Registration.Shutdown(QUIC_CONNECTION_SHUTDOWN_FLAG_SILENT, 0);
+    while (ConnectionsActive != 0) {
+        CxPlatSleep(100);
+    }
+    delete [] LocalAddresses;
+}
+
 int QUIC_MAIN_EXPORT main(int argc, char **argv) {
     if (argc < 2) {
-        printf("Usage: quicload.exe <server_name> [conn_count] [keep_alive_ms] [poll_ms] [share_udp]\n");
+        printf("Usage: quicload.exe <server_name> [conn_count] [keep_alive_ms] [poll_ms] [share_udp] [step_count] [socket_count]\n");
+        printf("\n");
+        printf("With a step_count, ramps up to conn_count connections step_count at a time, over\n");
+        printf("socket_count (def:1) shared local sockets. After each step the connections idle\n");
+        printf("for poll_ms and the memory per connection, handshake rate and idle (timer and\n");
+        printf("keep-alive) CPU cost are printed.\n");
         return 1;
     }
 
@@ -56,6 +244,8 @@ int QUIC_MAIN_EXPORT main(int argc, char **argv) {
     const uint32_t KeepAliveMs = argc > 3 ? atoi(argv[3]) : 60 * 1000;
     const uint32_t PollMs = argc > 4 ? atoi(argv[4]) : 10 * 1000;
     const bool ShareUdp = argc > 5 ? (atoi(argv[5]) ? true : false) : true;
+    const uint32_t StepCount = argc > 6 ? atoi(argv[6]) : 0;
+    const uint32_t SocketCount = argc > 7 ? CXPLAT_MAX(atoi(argv[7]), 1) : 1;
 
     MsQuic = new(std::nothrow) MsQuicApi;
     {
@@ -69,22 +259,28 @@ int QUIC_MAIN_EXPORT main(int argc, char **argv) {
         QUIC_ADDR_STR AddrStr;
         QuicAddrToString(&ServerAddress.SockAddr, &AddrStr);
         printf("Starting %u connections to %s [%s]\n\n", ConnectionCount, ServerName, AddrStr.Address);
-        QuicAddr LocalAddress = {0};
-        ConnectionsActive = ConnectionCount;
-        uint64_t Start = CxPlatTimeMs64();
-        for (uint32_t i = 0; i < ConnectionCount; ++i) {
-            auto Connection = new(std::nothrow) MsQuicConnection(Registration, CleanUpAutoDelete, ConnectionCallback);
-            Connection->SetRemoteAddr(ServerAddress);
-            if (ShareUdp) {
-                Connection->SetShareUdpBinding();
-                if (i != 0) Connection->SetLocalAddr(LocalAddress);
+        if (StepCount != 0) {
+            RunScalingSteps(
+                Registration, Config, ServerName, ServerAddress,
+                ConnectionCount, StepCount, PollMs, SocketCount);
+        } else {
+            QuicAddr LocalAddress = {0};
+            ConnectionsActive = ConnectionCount;
+            uint64_t Start = CxPlatTimeMs64();
+            for (uint32_t i = 0; i < ConnectionCount; ++i) {
+                auto Connection = new(std::nothrow) MsQuicConnection(Registration, CleanUpAutoDelete, ConnectionCallback);
+                Connection->SetRemoteAddr(ServerAddress);
+                if (ShareUdp) {
+                    Connection->SetShareUdpBinding();
+                    if (i != 0) Connection->SetLocalAddr(LocalAddress);
+                }
+                Connection->Start(Config, ServerName, 443);
+                if (ShareUdp && i == 0) Connection->GetLocalAddr(LocalAddress);
+            }
+            while (ConnectionsActive != 0) {
+                printf("%4llu: %u connected, %u active\n", (long long unsigned)(CxPlatTimeMs64() - Start) / 1000, (uint32_t)ConnectedCount, (uint32_t)ConnectionsActive);
+                CxPlatSleep(PollMs);
             }
-            Connection->Start(Config, ServerName, 443);
-            if (ShareUdp && i == 0) Connection->GetLocalAddr(LocalAddress);
-        }
-        while (ConnectionsActive != 0) {
-            printf("%4llu: %u connected, %u active\n", (long long unsigned)(CxPlatTimeMs64() - Start) / 1000, (uint32_t)ConnectedCount, (uint32_t)ConnectionsActive);
-            CxPlatSleep(PollMs);
         }
     }
 
@@ -0,0 +1,731 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Runs a QUIC server that accepts connections and drains their streams, and
+    serves MsQuic's library, worker, listener and (sampled) connection
+    statistics as OpenMetrics text over HTTP, for Prometheus style scrapers.
+
+    A scrape costs the same no matter how many connections there are. The
+    library counters and latency histograms are copied out of a
+    QUIC_PARAM_GLOBAL_PERF_EXPORT buffer that MsQuic's workers keep up to date
+    on their own, the worker and listener statistics are a single GetParam
+    each, and only a small, fixed number of sampled connections are queried.
+
+--*/
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <stdarg.h>
+
+#include "msquichelper.h"
+#include "msquic.hpp"
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <unistd.h>
+#define closesocket close
+#endif
+
+#define USAGE \
+    "Usage: quicmetrics [options]\n" \
+    "\n" \
+    "  -alpn:<alpn>          The ALPN the QUIC server accepts. (def:sink)\n" \
+    "  -port:<port>          The UDP port the QUIC server listens on. (def:4433)\n" \
+    "  -metrics:<port>       The TCP port metrics are served on, at /metrics. (def:9464)\n" \
+    "  -interval:<ms>        How often MsQuic refreshes the library counters. (def:1000)\n" \
+    "  -sample:<n>           Sample 1 in n accepted connections. (def:1000)\n" \
+    "  -maxsampled:<n>       The most connections sampled at once. (def:16)\n" \
+    "\n" \
+    "  Server certificate (one is required):\n" \
+    "  -cert_hash:<hash>     SHA1 hash of a certificate in the certificate store.\n" \
+    "  -cert_file:<path> -cert_key:<path>\n" \
+    "                        Certificate and private key files.\n"
+
+const MsQuicApi* MsQuic;
+HQUIC Configuration;
+
+uint16_t MetricsPort = 9464;
+uint32_t ExportIntervalMs = 1000;
+uint32_t SampleRate = 1000;
+uint32_t MaxSampled = 16;
+
+//
+// The export buffer holds a single entry, so MsQuic sums every processor into
+// it.
+//
+uint64_t PerfExportBuffer[(QUIC_PERF_EXPORT_SIZE(1) + 7) / 8];
+
+//
+// The sampled connections, by slot. The slot index is the "slot" label of
+// their metrics. A connection that shuts down while a scrape may be querying
+// it is only closed once the scrape is done.
+//
+struct SampledConnections {
+    std::mutex Lock;
+    std::vector<HQUIC> Slots;
+    std::vector<HQUIC> PendingClose;
+    bool Scraping {false};
+} Sampled;
+
+std::atomic<uint64_t> AcceptedCount {0};
+
+struct MetricInfo {
+    const char* Name;
+    const char* Help;
+    bool Gauge;
+};
+
+static const MetricInfo PerfCounterInfo[] = {
+    { "quic_conn_created", "Connections ever allocated.", false },
+    { "quic_conn_handshake_fail", "Connections that failed during the handshake.", false },
+    { "quic_conn_app_reject", "Connections rejected by the application.", false },
+    { "quic_conn_resumed", "Connections resumed.", false },
+    { "quic_conn_active", "Connections currently allocated.", true },
+    { "quic_conn_connected", "Connections currently in the connected state.", true },
+    { "quic_conn_protocol_errors", "Connections shut down with a protocol error.", false },
+    { "quic_conn_no_alpn", "Connection attempts with no matching ALPN.", false },
+    { "quic_strm_active", "Streams currently allocated.", true },
+    { "quic_pkts_suspected_lost", "Packets suspected lost.", false },
+    { "quic_pkts_dropped", "Packets dropped for any reason.", false },
+    { "quic_pkts_decryption_fail", "Packets that failed decryption.", false },
+    { "quic_udp_recv", "UDP datagrams received.", false },
+    { "quic_udp_send", "UDP datagrams sent.", false },
+    { "quic_udp_recv_bytes", "UDP payload bytes received.", false },
+    { "quic_udp_send_bytes", "UDP payload bytes sent.", false },
+    { "quic_udp_recv_events", "UDP receive events.", false },
+    { "quic_udp_send_calls", "UDP send API calls.", false },
+    { "quic_app_send_bytes", "Bytes sent by applications.", false },
+    { "quic_app_recv_bytes", "Bytes received by applications.", false },
+    { "quic_conn_queue_depth", "Connections currently queued for processing.", true },
+    { "quic_conn_oper_queue_depth", "Connection operations currently queued.", true },
+    { "quic_conn_oper_queued", "Connection operations queued.", false },
+    { "quic_conn_oper_completed", "Connection operations processed.", false },
+    { "quic_work_oper_queue_depth", "Worker operations currently queued.", true },
+    { "quic_work_oper_queued", "Worker operations queued.", false },
+    { "quic_work_oper_completed", "Worker operations processed.", false },
+    { "quic_path_validated", "Path challenges that succeeded.", false },
+    { "quic_path_failure", "Path challenges that failed.", false },
+    { "quic_send_stateless_reset", "Stateless reset packets sent.", false },
+    { "quic_send_stateless_retry", "Stateless retry packets sent.", false },
+    { "quic_conn_load_reject", "Connections rejected due to worker load.", false },
+};
+
+static_assert(
+    ARRAYSIZE(PerfCounterInfo) == QUIC_PERF_COUNTER_MAX,
+    "Every perf counter needs a metric");
+
+static const MetricInfo PerfHistogramInfo[] = {
+    { "quic_handshake_time_microseconds", "Time from connection start until the handshake completes.", false },
+    { "quic_queue_delay_microseconds", "Time connections waited to be processed by their worker.", false },
+    { "quic_rtt_microseconds", "RTT samples.", false },
+};
+
+static_assert(
+    ARRAYSIZE(PerfHistogramInfo) == QUIC_PERF_HISTOGRAM_MAX,
+    "Every perf histogram needs a metric");
+
+void
+Append(
+    _Inout_ std::string& Output,
+    _In_z_ _Printf_format_string_ const char* Format,
+    ...
+    )
+{
+    char Line[512];
+    va_list Args;
+    va_start(Args, Format);
+    int Length = vsnprintf(Line, sizeof(Line), Format, Args);
+    va_end(Args);
+    if (Length > 0) {
+        Output.append(Line, CXPLAT_MIN((size_t)Length, sizeof(Line) - 1));
+    }
+}
+
+void
+AppendFamily(
+    _Inout_ std::string& Output,
+    _In_ const MetricInfo& Info
+    )
+{
+    Append(Output, "# TYPE %s %s\n", Info.Name, Info.Gauge ? "gauge" : "counter");
+    Append(Output, "# HELP %s %s\n", Info.Name, Info.Help);
+}
+
+//
+// Reads the export buffer without locking, retrying if MsQuic was in the
+// middle of updating it (see QUIC_PARAM_GLOBAL_PERF_EXPORT).
+//
+bool
+ReadPerfExport(
+    _Out_ QUIC_PERF_EXPORT_PROCESSOR* Entry
+    )
+{
+    const QUIC_PERF_EXPORT_HEADER* Header = (const QUIC_PERF_EXPORT_HEADER*)PerfExportBuffer;
+    for (uint32_t Attempt = 0; Attempt < 100; ++Attempt) {
+        const int64_t Start = Header->Sequence;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if ((Start & 1) == 0) {
+            memcpy(Entry, Header + 1, sizeof(*Entry));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (Start == Header->Sequence) {
+                return true;
+            }
+        }
+        std::this_thread::yield();
+    }
+    return false;
+}
+
+void
+AppendLibraryMetrics(
+    _Inout_ std::string& Output
+    )
+{
+    QUIC_PERF_EXPORT_PROCESSOR Entry;
+    if (!ReadPerfExport(&Entry)) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < QUIC_PERF_COUNTER_MAX; ++i) {
+        const MetricInfo& Info = PerfCounterInfo[i];
+        AppendFamily(Output, Info);
+        Append(
+            Output, "%s%s %lld\n",
+            Info.Name, Info.Gauge ? "" : "_total", (long long)Entry.Counters[i]);
+    }
+
+    //
+    // Bucket i counts values below QUIC_LATENCY_HISTOGRAM_BUCKET_LOW(i + 1).
+    // Only every power of two boundary is exported, which keeps the series
+    // count down. The values are whole microseconds, so "le" is one less
+    // than the boundary.
+    //
+    for (uint32_t i = 0; i < QUIC_PERF_HISTOGRAM_MAX; ++i) {
+        const char* Name = PerfHistogramInfo[i].Name;
+        const QUIC_LATENCY_HISTOGRAM& Histogram = Entry.Histograms[i];
+        Append(Output, "# TYPE %s histogram\n", Name);
+        Append(Output, "# UNIT %s microseconds\n", Name);
+        Append(Output, "# HELP %s %s\n", Name, PerfHistogramInfo[i].Help);
+        uint64_t Cumulative = 0;
+        for (uint32_t j = 0; j < QUIC_LATENCY_HISTOGRAM_BUCKET_COUNT; ++j) {
+            Cumulative += Histogram.Buckets[j];
+            if ((j & 3) == 3) {
+                Append(
+                    Output, "%s_bucket{le=\"%llu\"} %llu\n", Name,
+                    (unsigned long long)(QUIC_LATENCY_HISTOGRAM_BUCKET_LOW(j + 1) - 1),
+                    (unsigned long long)Cumulative);
+            }
+        }
+        Append(Output, "%s_bucket{le=\"+Inf\"} %llu\n", Name, (unsigned long long)Histogram.Count);
+        Append(Output, "%s_sum %llu\n", Name, (unsigned long long)Histogram.Sum);
+        Append(Output, "%s_count %llu\n", Name, (unsigned long long)Histogram.Count);
+    }
+}
+
+void
+AppendWorkerMetrics(
+    _Inout_ std::string& Output
+    )
+{
+    //
+    // The worker count only changes when registrations are opened or closed,
+    // so one retry is enough.
+    //
+    std::vector<QUIC_WORKER_STATISTICS> Workers;
+    uint32_t Length = 0;
+    QUIC_STATUS Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+    for (uint32_t Attempt = 0; Attempt < 2 && Status == QUIC_STATUS_BUFFER_TOO_SMALL; ++Attempt) {
+        Workers.resize(Length / sizeof(QUIC_WORKER_STATISTICS));
+        Status =
+            MsQuic->GetParam(
+                nullptr,
+                QUIC_PARAM_GLOBAL_WORKER_STATISTICS,
+                &Length,
+                Workers.data());
+    }
+    if (QUIC_FAILED(Status)) {
+        return;
+    }
+    Workers.resize(Length / sizeof(QUIC_WORKER_STATISTICS));
+
+    static const MetricInfo WorkerInfo[] = {
+        { "quic_worker_connections", "Connections owned by the worker.", true },
+        { "quic_worker_timer_connections", "Connections with a timer armed.", true },
+        { "quic_worker_busy_seconds", "Time spent processing connections.", false },
+        { "quic_worker_idle_seconds", "Time not spent processing connections.", false },
+        { "quic_worker_operations", "Connection operations processed.", false },
+        { "quic_worker_send_flushes_cut_short", "Send flushes stopped by the scheduling budget.", false },
+        { "quic_worker_queue_delay_average_microseconds", "Average time connections waited to be processed.", true },
+    };
+
+    for (uint32_t i = 0; i < ARRAYSIZE(WorkerInfo); ++i) {
+        const MetricInfo& Info = WorkerInfo[i];
+        AppendFamily(Output, Info);
+        for (uint32_t j = 0; j < (uint32_t)Workers.size(); ++j) {
+            const QUIC_WORKER_STATISTICS& Worker = Workers[j];
+            char Value[32];
+            switch (i) {
+            case 0: snprintf(Value, sizeof(Value), "%u", Worker.ConnectionCount); break;
+            case 1: snprintf(Value, sizeof(Value), "%llu", (unsigned long long)Worker.TimerWheelConnectionCount); break;
+            case 2: snprintf(Value, sizeof(Value), "%.6f", Worker.BusyTimeUs / 1000000.0); break;
+            case 3: snprintf(Value, sizeof(Value), "%.6f", Worker.IdleTimeUs / 1000000.0); break;
+            case 4: snprintf(Value, sizeof(Value), "%llu", (unsigned long long)Worker.OperationsProcessed); break;
+            case 5: snprintf(Value, sizeof(Value), "%llu", (unsigned long long)Worker.SendFlushesCutShort); break;
+            default: snprintf(Value, sizeof(Value), "%u", Worker.AverageQueueDelayUs); break;
+            }
+            Append(
+                Output, "%s%s{worker=\"%u\",partition=\"%hu\"} %s\n",
+                Info.Name, Info.Gauge ? "" : "_total", j, Worker.PartitionIndex, Value);
+        }
+    }
+}
+
+void
+AppendListenerMetrics(
+    _Inout_ std::string& Output,
+    _In_ const MsQuicListener& Listener
+    )
+{
+    QUIC_LISTENER_STATISTICS Stats;
+    if (QUIC_FAILED(Listener.GetStatistics(Stats))) {
+        return;
+    }
+
+    static const MetricInfo ListenerInfo[] = {
+        { "quic_listener_accepted_connections", "Connections accepted by the listener.", false },
+        { "quic_listener_rejected_connections", "Connections rejected by the listener.", false },
+        { "quic_listener_binding_recv_dropped_packets", "Packets dropped by the listener's binding.", false },
+    };
+    const uint64_t Values[] = {
+        Stats.TotalAcceptedConnections,
+        Stats.TotalRejectedConnections,
+        Stats.BindingRecvDroppedPackets
+    };
+
+    for (uint32_t i = 0; i < ARRAYSIZE(ListenerInfo); ++i) {
+        AppendFamily(Output, ListenerInfo[i]);
+        Append(Output, "%s_total %llu\n", ListenerInfo[i].Name, (unsigned long long)Values[i]);
+    }
+}
+
+void
+AppendConnectionMetrics(
+    _Inout_ std::string& Output
+    )
+{
+    std::vector<HQUIC> Slots;
+    {
+        std::lock_guard<std::mutex> Lock(Sampled.Lock);
+        Sampled.Scraping = true;
+        Slots = Sampled.Slots;
+    }
+
+    std::vector<QUIC_STATISTICS_V2> Stats(Slots.size());
+    std::vector<bool> Valid(Slots.size());
+    uint32_t SampledCount = 0;
+    for (size_t i = 0; i < Slots.size(); ++i) {
+        if (Slots[i] != nullptr) {
+            uint32_t Length = sizeof(Stats[i]);
+            Valid[i] =
+                QUIC_SUCCEEDED(
+                MsQuic->GetParam(
+                    Slots[i],
+                    QUIC_PARAM_CONN_STATISTICS_V2,
+                    &Length,
+                    &Stats[i]));
+            SampledCount += Valid[i] ? 1 : 0;
+        }
+    }
+
+    std::vector<HQUIC> PendingClose;
+    {
+        std::lock_guard<std::mutex> Lock(Sampled.Lock);
+        Sampled.Scraping = false;
+        PendingClose.swap(Sampled.PendingClose);
+    }
+    for (HQUIC Connection : PendingClose) {
+        MsQuic->ConnectionClose(Connection);
+    }
+
+    Append(Output, "# TYPE quic_sampled_connections gauge\n");
+    Append(Output, "# HELP quic_sampled_connections Connections currently sampled.\n");
+    Append(Output, "quic_sampled_connections %u\n", SampledCount);
+
+    static const MetricInfo ConnectionInfo[] = {
+        { "quic_sampled_connection_rtt_microseconds", "Smoothed RTT.", true },
+        { "quic_sampled_connection_min_rtt_microseconds", "Minimum RTT.", true },
+        { "quic_sampled_connection_congestion_window_bytes", "Congestion window.", true },
+        { "quic_sampled_connection_send_packets", "Packets sent.", false },
+        { "quic_sampled_connection_send_suspected_lost_packets", "Packets suspected lost.", false },
+        { "quic_sampled_connection_send_bytes", "UDP payload bytes sent.", false },
+        { "quic_sampled_connection_recv_bytes", "UDP payload bytes received.", false },
+    };
+
+    for (uint32_t i = 0; i < ARRAYSIZE(ConnectionInfo); ++i) {
+        const MetricInfo& Info = ConnectionInfo[i];
+        AppendFamily(Output, Info);
+        for (size_t j = 0; j < Slots.size(); ++j) {
+            if (!Valid[j]) {
+                continue;
+            }
+            const QUIC_STATISTICS_V2& Conn = Stats[j];
+            uint64_t Value;
+            switch (i) {
+            case 0: Value = Conn.Rtt; break;
+            case 1: Value = Conn.MinRtt; break;
+            case 2: Value = Conn.SendCongestionWindow; break;
+            case 3: Value = Conn.SendTotalPackets; break;
+            case 4: Value = Conn.SendSuspectedLostPackets; break;
+            case 5: Value = Conn.SendTotalBytes; break;
+            default: Value = Conn.RecvTotalBytes; break;
+            }
+            Append(
+                Output, "%s%s{slot=\"%u\"} %llu\n",
+                Info.Name, Info.Gauge ? "" : "_total", (uint32_t)j, (unsigned long long)Value);
+        }
+    }
+}
+
+std::string
+BuildMetrics(
+    _In_ const MsQuicListener& Listener
+    )
+{
+    std::string Output;
+    Output.reserve(64 * 1024);
+    AppendLibraryMetrics(Output);
+    AppendWorkerMetrics(Output);
+    AppendListenerMetrics(Output, Listener);
+    AppendConnectionMetrics(Output);
+    Output.append("# EOF\n");
+    return Output;
+}
+
+//
+// A minimal HTTP/1.1 server: one request per TCP connection, handled one at
+// a time, which is plenty for a scraper.
+//
+void
+ServeMetrics(
+    _In_ SOCKET ListenSocket,
+    _In_ const MsQuicListener* Listener
+    )
+{
+    while (true) {
+        SOCKET Client = accept(ListenSocket, nullptr, nullptr);
+        if (Client == INVALID_SOCKET) {
+            break;
+        }
+
+        char Request[4096];
+        size_t RequestLength = 0;
+        while (RequestLength < sizeof(Request) - 1) {
+            int Received =
+                (int)recv(Client, Request + RequestLength, (int)(sizeof(Request) - 1 - RequestLength), 0);
+            if (Received <= 0) {
+                break;
+            }
+            RequestLength += (size_t)Received;
+            Request[RequestLength] = '\0';
+            if (strstr(Request, "\r\n\r\n") != nullptr) {
+                break;
+            }
+        }
+        Request[RequestLength] = '\0';
+
+        std::string Response;
+        if (strncmp(Request, "GET /metrics ", sizeof("GET /metrics ") - 1) == 0) {
+            std::string Body = BuildMetrics(*Listener);
+            Append(
+                Response,
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Type: application/openmetrics-text; version=1.0.0; charset=utf-8\r\n"
+                "Content-Length: %llu\r\n"
+                "Connection: close\r\n\r\n",
+                (unsigned long long)Body.size());
+            Response += Body;
+        } else {
+            Response =
+                "HTTP/1.1 404 Not Found\r\n"
+                "Content-Length: 0\r\n"
+                "Connection: close\r\n\r\n";
+        }
+
+        size_t Sent = 0;
+        while (Sent < Response.size()) {
+            int Result = (int)send(Client, Response.data() + Sent, (int)(Response.size() - Sent), 0);
+            if (Result <= 0) {
+                break;
+            }
+            Sent += (size_t)Result;
+        }
+        closesocket(Client);
+    }
+}
+
+SOCKET
+OpenMetricsSocket(
+    )
+{
+    SOCKET Socket = socket(AF_INET6, SOCK_STREAM, IPPROTO_TCP);
+    if (Socket == INVALID_SOCKET) {
+        return INVALID_SOCKET;
+    }
+
+    int Option = 0;
+    (void)setsockopt(Socket, IPPROTO_IPV6, IPV6_V6ONLY, (const char*)&Option, sizeof(Option));
+    Option = 1;
+    (void)setsockopt(Socket, SOL_SOCKET, SO_REUSEADDR, (const char*)&Option, sizeof(Option));
+
+    QuicAddr Address(QUIC_ADDRESS_FAMILY_INET6, MetricsPort);
+    if (bind(Socket, (const sockaddr*)&Address.SockAddr, sizeof(Address.SockAddr.Ipv6)) == SOCKET_ERROR ||
+        listen(Socket, 16) == SOCKET_ERROR) {
+        closesocket(Socket);
+        return INVALID_SOCKET;
+    }
+    return Socket;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Function_class_(QUIC_STREAM_CALLBACK)
+QUIC_STATUS
+QUIC_API
+StreamCallback(
+    _In_ HQUIC Stream,
+    _In_opt_ void* /* Context */,
+    _Inout_ QUIC_STREAM_EVENT* Event
+    )
+{
+    switch (Event->Type) {
+    case QUIC_STREAM_EVENT_PEER_SEND_SHUTDOWN:
+        MsQuic->StreamShutdown(Stream, QUIC_STREAM_SHUTDOWN_FLAG_GRACEFUL, 0);
+        break;
+    case QUIC_STREAM_EVENT_SHUTDOWN_COMPLETE:
+        MsQuic->StreamClose(Stream);
+        break;
+    default:
+        break;
+    }
+    return QUIC_STATUS_SUCCESS; // Received data is always fully consumed.
+}
+
+void
+ReleaseSlot(
+    _In_ HQUIC Connection,
+    _In_ size_t Slot
+    )
+{
+    std::lock_guard<std::mutex> Lock(Sampled.Lock);
+    if (Sampled.Slots[Slot] == Connection) {
+        Sampled.Slots[Slot] = nullptr;
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Function_class_(QUIC_CONNECTION_CALLBACK)
+QUIC_STATUS
+QUIC_API
+ConnectionCallback(
+    _In_ HQUIC Connection,
+    _In_opt_ void* Context,
+    _Inout_ QUIC_CONNECTION_EVENT* Event
+    )
+{
+    switch (Event->Type) {
+    case QUIC_CONNECTION_EVENT_PEER_STREAM_STARTED:
+        MsQuic->SetCallbackHandler(
+            Event->PEER_STREAM_STARTED.Stream, (void*)StreamCallback, nullptr);
+        break;
+    case QUIC_CONNECTION_EVENT_SHUTDOWN_COMPLETE: {
+        //
+        // The context is the sampling slot plus one, or zero if the
+        // connection isn't sampled.
+        //
+        const size_t Slot = (size_t)Context;
+        if (Slot != 0) {
+            std::lock_guard<std::mutex> Lock(Sampled.Lock);
+            Sampled.Slots[Slot - 1] = nullptr;
+            if (Sampled.Scraping) {
+                Sampled.PendingClose.push_back(Connection);
+                break;
+            }
+        }
+        MsQuic->ConnectionClose(Connection);
+        break;
+    }
+    default:
+        break;
+    }
+    return QUIC_STATUS_SUCCESS;
+}
+
+QUIC_STATUS
+ListenerCallback(
+    _In_ MsQuicListener* /* Listener */,
+    _In_opt_ void* /* Context */,
+    _Inout_ QUIC_LISTENER_EVENT* Event
+    )
+{
+    if (Event->Type != QUIC_LISTENER_EVENT_NEW_CONNECTION) {
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    HQUIC Connection = Event->NEW_CONNECTION.Connection;
+    size_t Slot = 0;
+    if (AcceptedCount.fetch_add(1) % SampleRate == 0) {
+        std::lock_guard<std::mutex> Lock(Sampled.Lock);
+        for (size_t i = 0; i < Sampled.Slots.size(); ++i) {
+            if (Sampled.Slots[i] == nullptr) {
+                Sampled.Slots[i] = Connection;
+                Slot = i + 1;
+                break;
+            }
+        }
+    }
+
+    MsQuic->SetCallbackHandler(Connection, (void*)ConnectionCallback, (void*)Slot);
+    QUIC_STATUS Status = MsQuic->ConnectionSetConfiguration(Connection, Configuration);
+    if (QUIC_FAILED(Status) && Slot != 0) {
+        ReleaseSlot(Connection, Slot - 1); // MsQuic closes the connection itself.
+    }
+    return Status;
+}
+
+int
+QUIC_MAIN_EXPORT
+main(
+    _In_ int argc,
+    _In_reads_(argc) _Null_terminated_ char* argv[]
+    )
+{
+    if (GetFlag(argc, argv, "help") || GetFlag(argc, argv, "?")) {
+        printf(USAGE);
+        return 0;
+    }
+
+    const char* Alpn = "sink";
+    uint16_t Port = 4433;
+    TryGetValue(argc, argv, "alpn", &Alpn);
+    TryGetValue(argc, argv, "port", &Port);
+    TryGetValue(argc, argv, "metrics", &MetricsPort);
+    TryGetValue(argc, argv, "interval", &ExportIntervalMs);
+    TryGetValue(argc, argv, "sample", &SampleRate);
+    TryGetValue(argc, argv, "maxsampled", &MaxSampled);
+    if (SampleRate == 0) {
+        SampleRate = 1;
+    }
+    Sampled.Slots.resize(MaxSampled, nullptr);
+
+#ifdef _WIN32
+    WSADATA WsaData;
+    if (WSAStartup(MAKEWORD(2, 2), &WsaData) != 0) {
+        printf("WSAStartup failed.\n");
+        return 1;
+    }
+#endif
+
+    int ErrorCode = 1;
+    SOCKET MetricsSocket = INVALID_SOCKET;
+    std::thread MetricsThread;
+
+    MsQuicApi _MsQuic;
+    if (!_MsQuic.IsValid()) {
+        printf("MsQuicOpen2 failed, 0x%x\n", _MsQuic.GetInitStatus());
+        return 1;
+    }
+    MsQuic = &_MsQuic;
+
+    QUIC_PERF_EXPORT Export = {
+        PerfExportBuffer,
+        (uint32_t)sizeof(PerfExportBuffer),
+        CXPLAT_MAX(ExportIntervalMs * 1000, QUIC_PERF_EXPORT_MIN_INTERVAL_US)
+    };
+    QUIC_STATUS Status =
+        MsQuic->SetParam(
+            nullptr,
+            QUIC_PARAM_GLOBAL_PERF_EXPORT,
+            sizeof(Export),
+            &Export);
+    if (QUIC_FAILED(Status)) {
+        printf("Setting the perf export failed, 0x%x\n", Status);
+        return 1;
+    }
+
+    {
+        MsQuicRegistration Registration("quicmetrics", QUIC_EXECUTION_PROFILE_LOW_LATENCY, true);
+        if (!Registration.IsValid()) {
+            printf("RegistrationOpen failed, 0x%x\n", Registration.GetInitStatus());
+            goto Exit;
+        }
+
+        MsQuicSettings Settings;
+        Settings.SetPeerBidiStreamCount(1000);
+        Settings.SetPeerUnidiStreamCount(1000);
+        Settings.SetServerResumptionLevel(QUIC_SERVER_RESUME_AND_ZERORTT);
+        MsQuicAlpn Alpns(Alpn);
+        Configuration =
+            GetServerConfigurationFromArgs(
+                argc, argv, MsQuic, Registration, Alpns, Alpns.Length(), &Settings, sizeof(Settings));
+        if (Configuration == nullptr) {
+            printf("Failed to load the server certificate.\n\n");
+            printf(USAGE);
+            goto Exit;
+        }
+
+        {
+            MsQuicListener Listener(Registration, CleanUpManual, ListenerCallback);
+            if (!Listener.IsValid() ||
+                QUIC_FAILED(Status = Listener.Start(Alpns, QuicAddr(QUIC_ADDRESS_FAMILY_UNSPEC, Port)))) {
+                printf("Starting the listener on port %hu failed.\n", Port);
+                FreeServerConfiguration(MsQuic, Configuration);
+                goto Exit;
+            }
+
+            MetricsSocket = OpenMetricsSocket();
+            if (MetricsSocket == INVALID_SOCKET) {
+                printf("Listening for metrics scrapes on TCP port %hu failed.\n", MetricsPort);
+                FreeServerConfiguration(MsQuic, Configuration);
+                goto Exit;
+            }
+            MetricsThread = std::thread(ServeMetrics, MetricsSocket, &Listener);
+
+            printf("Serving metrics at http://*:%hu/metrics. Press Enter to exit.\n\n", MetricsPort);
+            (void)getchar();
+
+#ifdef _WIN32
+            closesocket(MetricsSocket);
+#else
+            shutdown(MetricsSocket, SHUT_RDWR); // Unblocks accept.
+            closesocket(MetricsSocket);
+#endif
+            MetricsThread.join();
+        }
+
+        //
+        // Closes every remaining connection through its SHUTDOWN_COMPLETE
+        // event, so the registration can be closed.
+        //
+        Registration.Shutdown(QUIC_CONNECTION_SHUTDOWN_FLAG_SILENT, 0);
+        FreeServerConfiguration(MsQuic, Configuration);
+        ErrorCode = 0;
+    }
+
+Exit:
+
+    QUIC_PERF_EXPORT NoExport = { nullptr, 0, 0 };
+    MsQuic->SetParam(nullptr, QUIC_PARAM_GLOBAL_PERF_EXPORT, sizeof(NoExport), &NoExport);
+
+#ifdef _WIN32
+    WSACleanup();
+#endif
+
+    return ErrorCode;
+}
@@ -11,6 +11,7 @@
 #include <vector>
 #include <map>
 #include <mutex>
+#include <atomic>
 #include <algorithm>
 
 #define QUIC_TEST_APIS 1 // Needed for self signed cert API
@@ -369,13 +370,261 @@ static struct {
     uint8_t LossPercent;
     int32_t AllocFailDenominator;
     uint32_t RepeatCount;
+    uint64_t SlowCallUs; // Non-zero enables the performance mode
 } SpinSettings;
 
+//
+// Performance mode. Every MsQuic API call is timed, and so are the app's event
+// callbacks, which run on MsQuic's worker threads: anything slow inside one
+// stalls every connection on that worker. Calls slower than SlowCallUs are
+// flagged, as they point at lock contention or a pathological slow path.
+//
+
+typedef enum {
+    SpinQuicPerfConnectionOpen = 0,
+    SpinQuicPerfConnectionClose,
+    SpinQuicPerfConnectionShutdown,
+    SpinQuicPerfConnectionStart,
+    SpinQuicPerfConnectionSetConfiguration,
+    SpinQuicPerfConnectionSendResumptionTicket,
+    SpinQuicPerfStreamOpen,
+    SpinQuicPerfStreamClose,
+    SpinQuicPerfStreamStart,
+    SpinQuicPerfStreamShutdown,
+    SpinQuicPerfStreamSend,
+    SpinQuicPerfStreamReceiveComplete,
+    SpinQuicPerfStreamReceiveSetEnabled,
+    SpinQuicPerfDatagramSend,
+    SpinQuicPerfCompleteTicketValidation,
+    SpinQuicPerfCompleteCertificateValidation,
+    SpinQuicPerfSetParam,
+    SpinQuicPerfGetParam,
+    SpinQuicPerfListenerStart,
+    SpinQuicPerfListenerStop,
+    SpinQuicPerfConnectionCallback,
+    SpinQuicPerfStreamCallback,
+    SpinQuicPerfListenerCallback,
+    SpinQuicPerfCount    // Always the last element
+} SpinQuicPerfEntry;
+
+static const char* const SpinQuicPerfNames[SpinQuicPerfCount] = {
+    "ConnectionOpen",
+    "ConnectionClose",
+    "ConnectionShutdown",
+    "ConnectionStart",
+    "ConnectionSetConfiguration",
+    "ConnectionSendResumption",
+    "StreamOpen",
+    "StreamClose",
+    "StreamStart",
+    "StreamShutdown",
+    "StreamSend",
+    "StreamReceiveComplete",
+    "StreamReceiveSetEnabled",
+    "DatagramSend",
+    "CompleteTicketValidation",
+    "CompleteCertValidation",
+    "SetParam",
+    "GetParam",
+    "ListenerStart",
+    "ListenerStop",
+    "(connection callback)",
+    "(stream callback)",
+    "(listener callback)",
+};
+
+struct SpinQuicPerfStats {
+    std::atomic<uint64_t> Count {0};
+    std::atomic<uint64_t> TotalUs {0};
+    std::atomic<uint64_t> MaxUs {0};
+    std::atomic<uint64_t> SlowCount {0};
+    std::atomic<uint64_t> WorkerCount {0};      // Made on a worker thread, from a callback
+    std::atomic<uint64_t> WorkerSlowCount {0};
+};
+
+static SpinQuicPerfStats SpinQuicPerf[SpinQuicPerfCount];
+static std::atomic<uint64_t> SpinQuicQueueDelay[QUIC_WORKER_QUEUE_DELAY_BUCKET_COUNT];
+static std::atomic<uint32_t> SpinQuicMaxAverageQueueDelayUs {0};
+
+//
+// Non-zero while the thread is running one of the app's callbacks.
+//
+static thread_local uint32_t SpinQuicCallbackDepth = 0;
+
+void SpinQuicPerfRecord(SpinQuicPerfEntry Entry, uint64_t TimeUs, bool OnWorker)
+{
+    auto& Stats = SpinQuicPerf[Entry];
+    Stats.Count++;
+    Stats.TotalUs += TimeUs;
+    if (OnWorker) {
+        Stats.WorkerCount++;
+    }
+
+    bool NewMax = false;
+    uint64_t Max = Stats.MaxUs.load();
+    while (TimeUs > Max) {
+        if (Stats.MaxUs.compare_exchange_weak(Max, TimeUs)) {
+            NewMax = true;
+            break;
+        }
+    }
+
+    if (TimeUs >= SpinSettings.SlowCallUs) {
+        Stats.SlowCount++;
+        if (OnWorker) {
+            Stats.WorkerSlowCount++;
+        }
+        if (NewMax) { // Only report each new worst case, to keep the output readable.
+            printf("Slow %s: %llu us%s\n",
+                SpinQuicPerfNames[Entry],
+                (unsigned long long)TimeUs,
+                OnWorker ? " (blocking a worker thread)" : "");
+        }
+    }
+}
+
+struct SpinQuicPerfTimer {
+    SpinQuicPerfEntry Entry;
+    uint64_t Start;
+    SpinQuicPerfTimer(SpinQuicPerfEntry Entry) : Entry(Entry), Start(CxPlatTimeUs64()) { }
+    ~SpinQuicPerfTimer() {
+        SpinQuicPerfRecord(Entry, CxPlatTimeUs64() - Start, SpinQuicCallbackDepth != 0);
+    }
+};
+
+struct SpinQuicCallbackScope {
+    SpinQuicPerfEntry Entry;
+    uint64_t Start {0};
+    SpinQuicCallbackScope(SpinQuicPerfEntry Entry) : Entry(Entry) {
+        ++SpinQuicCallbackDepth;
+        if (SpinSettings.SlowCallUs) {
+            Start = CxPlatTimeUs64();
+        }
+    }
+    ~SpinQuicCallbackScope() {
+        --SpinQuicCallbackDepth;
+        if (SpinSettings.SlowCallUs) {
+            SpinQuicPerfRecord(Entry, CxPlatTimeUs64() - Start, true);
+        }
+    }
+};
+
+//
+// Replaces an entry in the API table with a timed wrapper that forwards to it.
+//
+template<SpinQuicPerfEntry Entry, typename Fn>
+struct SpinQuicTimedApi;
+
+template<SpinQuicPerfEntry Entry, typename R, typename... Args>
+struct SpinQuicTimedApi<Entry, R (QUIC_API *)(Args...)> {
+    typedef R (QUIC_API *Fn)(Args...);
+    static Fn& Real() { static Fn Value; return Value; }
+    static R QUIC_API Call(Args... Arguments) {
+        SpinQuicPerfTimer Timer(Entry);
+        return Real()(Arguments...);
+    }
+};
+
+#define SPIN_QUIC_TIME_API(Entry, Name) \
+    SpinQuicTimedApi<Entry, decltype(MsQuic.Name)>::Real() = MsQuic.Name; \
+    MsQuic.Name = SpinQuicTimedApi<Entry, decltype(MsQuic.Name)>::Call
+
+void SpinQuicPerfHookApi()
+{
+    SPIN_QUIC_TIME_API(SpinQuicPerfConnectionOpen, ConnectionOpen);
+    SPIN_QUIC_TIME_API(SpinQuicPerfConnectionClose, ConnectionClose);
+    SPIN_QUIC_TIME_API(SpinQuicPerfConnectionShutdown, ConnectionShutdown);
+    SPIN_QUIC_TIME_API(SpinQuicPerfConnectionStart, ConnectionStart);
+    SPIN_QUIC_TIME_API(SpinQuicPerfConnectionSetConfiguration, ConnectionSetConfiguration);
+    SPIN_QUIC_TIME_API(SpinQuicPerfConnectionSendResumptionTicket, ConnectionSendResumptionTicket);
+    SPIN_QUIC_TIME_API(SpinQuicPerfStreamOpen, StreamOpen);
+    SPIN_QUIC_TIME_API(SpinQuicPerfStreamClose, StreamClose);
+    SPIN_QUIC_TIME_API(SpinQuicPerfStreamStart, StreamStart);
+    SPIN_QUIC_TIME_API(SpinQuicPerfStreamShutdown, StreamShutdown);
+    SPIN_QUIC_TIME_API(SpinQuicPerfStreamSend, StreamSend);
+    SPIN_QUIC_TIME_API(SpinQuicPerfStreamReceiveComplete, StreamReceiveComplete);
+    SPIN_QUIC_TIME_API(SpinQuicPerfStreamReceiveSetEnabled, StreamReceiveSetEnabled);
+    SPIN_QUIC_TIME_API(SpinQuicPerfDatagramSend, DatagramSend);
+    SPIN_QUIC_TIME_API(SpinQuicPerfCompleteTicketValidation, ConnectionResumptionTicketValidationComplete);
+    SPIN_QUIC_TIME_API(SpinQuicPerfCompleteCertificateValidation, ConnectionCertificateValidationComplete);
+    SPIN_QUIC_TIME_API(SpinQuicPerfSetParam, SetParam);
+    SPIN_QUIC_TIME_API(SpinQuicPerfGetParam, GetParam);
+    SPIN_QUIC_TIME_API(SpinQuicPerfListenerStart, ListenerStart);
+    SPIN_QUIC_TIME_API(SpinQuicPerfListenerStop, ListenerStop);
+}
+
+//
+// Adds the operation queue delays seen by the registration's workers. Uses the
+// run's own (untimed) API table.
+//
+void SpinQuicPerfCollectQueueDelay(const QUIC_API_TABLE* Api, HQUIC Registration)
+{
+    uint32_t Length = 0;
+    if (Api->GetParam(
+            nullptr,
+            QUIC_PARAM_GLOBAL_WORKER_STATISTICS,
+            &Length,
+            nullptr) != QUIC_STATUS_BUFFER_TOO_SMALL) {
+        return;
+    }
+    std::vector<QUIC_WORKER_STATISTICS> Workers(Length / sizeof(QUIC_WORKER_STATISTICS));
+    if (QUIC_FAILED(
+        Api->GetParam(
+            nullptr,
+            QUIC_PARAM_GLOBAL_WORKER_STATISTICS,
+            &Length,
+            Workers.data()))) {
+        return;
+    }
+    for (uint32_t i = 0; i < Length / sizeof(QUIC_WORKER_STATISTICS); ++i) {
+        if (Workers[i].Registration != Registration) {
+            continue;
+        }
+        for (uint32_t j = 0; j < QUIC_WORKER_QUEUE_DELAY_BUCKET_COUNT; ++j) {
+            SpinQuicQueueDelay[j] += Workers[i].QueueDelayHistogram[j];
+        }
+        uint32_t Max = SpinQuicMaxAverageQueueDelayUs.load();
+        while (Workers[i].AverageQueueDelayUs > Max &&
+               !SpinQuicMaxAverageQueueDelayUs.compare_exchange_weak(Max, Workers[i].AverageQueueDelayUs)) {
+        }
+    }
+}
+
+void SpinQuicPerfPrint()
+{
+    printf("\n%-28s %10s %10s %10s %8s %12s %12s\n",
+        "Call", "Count", "Avg (us)", "Max (us)", "Slow", "On Worker", "Slow Worker");
+    for (uint32_t i = 0; i < SpinQuicPerfCount; ++i) {
+        const auto& Stats = SpinQuicPerf[i];
+        if (Stats.Count == 0) {
+            continue;
+        }
+        printf("%-28s %10llu %10llu %10llu %8llu %12llu %12llu\n",
+            SpinQuicPerfNames[i],
+            (unsigned long long)Stats.Count,
+            (unsigned long long)(Stats.TotalUs / Stats.Count),
+            (unsigned long long)Stats.MaxUs,
+            (unsigned long long)Stats.SlowCount,
+            (unsigned long long)Stats.WorkerCount,
+            (unsigned long long)Stats.WorkerSlowCount);
+    }
+
+    static const char* const Buckets[QUIC_WORKER_QUEUE_DELAY_BUCKET_COUNT] = {
+        "<10us", "<100us", "<1ms", "<10ms", "<100ms", ">=100ms"
+    };
+    printf("\nWorker queue delay:");
+    for (uint32_t i = 0; i < QUIC_WORKER_QUEUE_DELAY_BUCKET_COUNT; ++i) {
+        printf(" %s %llu", Buckets[i], (unsigned long long)SpinQuicQueueDelay[i]);
+    }
+    printf(" (worst worker average %u us)\n", SpinQuicMaxAverageQueueDelayUs.load());
+}
+
 void SpinQuicGetRandomParam(HQUIC Handle, uint16_t ThreadID);
 void SpinQuicSetRandomStreamParam(HQUIC Stream, uint16_t ThreadID);
 
 QUIC_STATUS QUIC_API SpinQuicHandleStreamEvent(HQUIC Stream, void* , QUIC_STREAM_EVENT *Event)
 {
+    SpinQuicCallbackScope Scope(SpinQuicPerfStreamCallback);
     auto ctx = SpinQuicStream::Get(Stream);
     auto ThreadID = ctx->Connection.ThreadID;
 
@@ -443,6 +692,7 @@ Exit:
 
 QUIC_STATUS QUIC_API SpinQuicHandleConnectionEvent(HQUIC Connection, void* , QUIC_CONNECTION_EVENT *Event)
 {
+    SpinQuicCallbackScope Scope(SpinQuicPerfConnectionCallback);
     auto ctx = SpinQuicConnection::Get(Connection);
     auto ThreadID = ctx->ThreadID;
 
@@ -516,6 +766,7 @@ struct ListenerContext {
 
 QUIC_STATUS QUIC_API SpinQuicServerHandleListenerEvent(HQUIC /* Listener */, void* Context , QUIC_LISTENER_EVENT* Event)
 {
+    SpinQuicCallbackScope Scope(SpinQuicPerfListenerCallback);
     HQUIC ServerConfiguration = ((ListenerContext*)Context)->ServerConfiguration;
     auto& Connections = *((ListenerContext*)Context)->Connections;
     uint16_t ThreadID = ((ListenerContext*)Context)->ThreadID;
@@ -834,8 +1085,9 @@ void SpinQuicSetRandomConnectionParam(HQUIC Connection, uint16_t ThreadID)
 void SpinQuicSetRandomStreamParam(HQUIC Stream, uint16_t ThreadID)
 {
     SetParamHelper Helper;
+    QUIC_STREAM_PRIORITY_PARAMETERS PriorityParams;
 
-    switch (0x08000000 | (GetRandom(6))) {
+    switch (0x08000000 | (GetRandom(7))) {
     case QUIC_PARAM_STREAM_ID:                                      // QUIC_UINT62
         break; // Get Only
     case QUIC_PARAM_STREAM_0RTT_LENGTH:                             // QUIC_ADDR
@@ -849,6 +1101,12 @@ void SpinQuicSetRandomStreamParam(HQUIC Stream, uint16_t ThreadID)
         break; // Get Only
     case QUIC_PARAM_STREAM_RELIABLE_OFFSET:
         Helper.SetUint64(QUIC_PARAM_STREAM_RELIABLE_OFFSET, (uint64_t)GetRandom(UINT64_MAX));
+        break;
+    case QUIC_PARAM_STREAM_PRIORITY_PARAMETERS:                     // QUIC_STREAM_PRIORITY_PARAMETERS
+        PriorityParams.Urgency = (uint8_t)GetRandom(QUIC_STREAM_PRIORITY_URGENCY_MAX + 1);
+        PriorityParams.Incremental = (BOOLEAN)GetRandom(2);
+        Helper.SetPtr(QUIC_PARAM_STREAM_PRIORITY_PARAMETERS, &PriorityParams, sizeof(PriorityParams));
+        break;
     default:
         break;
     }
@@ -1352,6 +1610,8 @@ void PrintHelpText(void)
           "  -target:<ip>           default: '127.0.0.1'\n" \
           "  -timeout:<count_ms>    default: 60000\n" \
           "  -repeat_count:<count>  default: 1\n" \
+          "  -perf:<slow_us>        default: 0 (off). Times API calls and callbacks,\n" \
+          "                         flagging those that take slow_us or longer.\n" \
           );
     exit(1);
 }
@@ -1497,6 +1757,10 @@ CXPLAT_THREAD_CALLBACK(RunThread, Context)
             CxPlatThreadDelete(&Threads[0]);
         }
 
+        if (SpinSettings.SlowCallUs) {
+            SpinQuicPerfCollectQueueDelay(Gb.MsQuic, Gb.Registration);
+        }
+
     } while (false);
 
     CXPLAT_THREAD_RETURN(0);
@@ -1543,6 +1807,10 @@ void start() {
 
         MsQuicClose(TempMsQuic);
 
+        if (SpinSettings.SlowCallUs) {
+            SpinQuicPerfHookApi();
+        }
+
 #ifndef FUZZING
         uint16_t ThreadID = UINT16_MAX;
         if (ExecConfig) {
@@ -1590,6 +1858,10 @@ void start() {
                 CxPlatThreadDelete(&Threads[j]);
             }
         }
+
+        if (SpinSettings.SlowCallUs) {
+            SpinQuicPerfPrint();
+        }
     }
 
     CxPlatLockUninitialize(&RunThreadLock);
@@ -1664,6 +1936,7 @@ main(int argc, char **argv)
     TryGetValue(argc, argv, "loss", &SpinSettings.LossPercent);
     TryGetValue(argc, argv, "repeat_count", &SpinSettings.RepeatCount);
     TryGetValue(argc, argv, "alloc_fail", &SpinSettings.AllocFailDenominator);
+    TryGetValue(argc, argv, "perf", &SpinSettings.SlowCallUs);
 
     if (SpinSettings.RepeatCount == 0) {
         printf("Must specify a non 0 repeat count\n");
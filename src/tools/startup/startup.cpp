@@ -0,0 +1,268 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Measures the cost of a cold start: opening the library, the first
+    registration and configuration, loading credentials and the first
+    connection, up to the first byte of a response over loopback. Also prints
+    the library's own breakdown of its startup (platform and TLS provider
+    init, worker pool and datapath creation). Each process only gets one cold
+    start, so run it repeatedly to get a distribution.
+
+--*/
+
+#include <chrono>
+
+#define QUIC_TEST_APIS 1 // Needed for self signed cert API
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include "msquichelper.h"
+#include "msquic.hpp"
+
+const MsQuicApi* MsQuic;
+
+static uint64_t MaxFirstByteUs = 0; // Zero means no limit
+
+//
+// The library's clock isn't usable before MsQuicOpen2, so the phases are timed
+// with the standard library's.
+//
+static
+uint64_t
+NowUs(
+    ) {
+    return
+        (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static
+void
+PrintPhase(
+    const char* Name,
+    uint64_t TimeUs
+    ) {
+    printf("%-34s %10llu us\n", Name, (unsigned long long)TimeUs);
+}
+
+static uint8_t RequestData[] = "GET /";
+static uint8_t ResponseData[] = "HTTP/1.0 200 OK";
+static const QUIC_BUFFER Request = { sizeof(RequestData), RequestData };
+static const QUIC_BUFFER Response = { sizeof(ResponseData), ResponseData };
+
+struct ClientState {
+    uint64_t ConnectedTime {0};
+    uint64_t FirstByteTime {0};
+    CXPLAT_EVENT Done;
+    ClientState() { CxPlatEventInitialize(&Done, TRUE, FALSE); }
+    ~ClientState() { CxPlatEventUninitialize(Done); }
+};
+
+QUIC_STATUS
+ClientConnectionCallback(
+    _In_ MsQuicConnection* /* Connection */,
+    _In_opt_ void* Context,
+    _Inout_ QUIC_CONNECTION_EVENT* Event
+    ) {
+    auto State = (ClientState*)Context;
+    if (Event->Type == QUIC_CONNECTION_EVENT_CONNECTED) {
+        State->ConnectedTime = NowUs();
+    } else if (Event->Type == QUIC_CONNECTION_EVENT_SHUTDOWN_COMPLETE) {
+        CxPlatEventSet(State->Done); // Don't wait if the connection failed.
+    }
+    return QUIC_STATUS_SUCCESS;
+}
+
+QUIC_STATUS
+ClientStreamCallback(
+    _In_ MsQuicStream* /* Stream */,
+    _In_opt_ void* Context,
+    _Inout_ QUIC_STREAM_EVENT* Event
+    ) {
+    auto State = (ClientState*)Context;
+    if (Event->Type == QUIC_STREAM_EVENT_RECEIVE &&
+        Event->RECEIVE.TotalBufferLength != 0 &&
+        State->FirstByteTime == 0) {
+        State->FirstByteTime = NowUs();
+        CxPlatEventSet(State->Done);
+    }
+    return QUIC_STATUS_SUCCESS;
+}
+
+QUIC_STATUS
+ServerStreamCallback(
+    _In_ MsQuicStream* /* Stream */,
+    _In_opt_ void* /* Context */,
+    _Inout_ QUIC_STREAM_EVENT* /* Event */
+    ) {
+    return QUIC_STATUS_SUCCESS;
+}
+
+QUIC_STATUS
+ServerConnectionCallback(
+    _In_ MsQuicConnection* /* Connection */,
+    _In_opt_ void* /* Context */,
+    _Inout_ QUIC_CONNECTION_EVENT* Event
+    ) {
+    if (Event->Type == QUIC_CONNECTION_EVENT_PEER_STREAM_STARTED) {
+        //
+        // Respond as soon as the request's stream shows up.
+        //
+        auto Stream = new(std::nothrow) MsQuicStream(Event->PEER_STREAM_STARTED.Stream, CleanUpAutoDelete, ServerStreamCallback);
+        if (Stream != nullptr) {
+            Stream->Send(&Response, 1, QUIC_SEND_FLAG_FIN);
+        }
+    }
+    return QUIC_STATUS_SUCCESS;
+}
+
+//
+// Opens everything the first connection needs, timing each step, and waits
+// for the first byte of the response.
+//
+static
+bool
+RunBenchmark(
+    const QUIC_CREDENTIAL_CONFIG& CertConfig
+    ) {
+    MsQuicAlpn Alpn("startup");
+    MsQuicSettings ServerSettings;
+    ServerSettings.SetPeerBidiStreamCount(1);
+
+    uint64_t Start = NowUs();
+    MsQuicRegistration Registration("startup", QUIC_EXECUTION_PROFILE_LOW_LATENCY, true);
+    PrintPhase("RegistrationOpen", NowUs() - Start);
+    if (!Registration.IsValid()) {
+        printf("RegistrationOpen failed, 0x%x\n", Registration.GetInitStatus());
+        return false;
+    }
+
+    Start = NowUs();
+    MsQuicConfiguration ClientConfig(Registration, Alpn);
+    PrintPhase("ConfigurationOpen (client)", NowUs() - Start);
+    Start = NowUs();
+    MsQuicCredentialConfig ClientCredConfig(QUIC_CREDENTIAL_FLAG_CLIENT | QUIC_CREDENTIAL_FLAG_NO_CERTIFICATE_VALIDATION);
+    QUIC_STATUS Status = ClientConfig.IsValid() ? ClientConfig.LoadCredential(&ClientCredConfig) : ClientConfig.GetInitStatus();
+    PrintPhase("LoadCredential (client)", NowUs() - Start);
+    if (QUIC_FAILED(Status)) {
+        printf("Client configuration failed, 0x%x\n", Status);
+        return false;
+    }
+
+    Start = NowUs();
+    MsQuicConfiguration ServerConfig(Registration, Alpn, ServerSettings);
+    PrintPhase("ConfigurationOpen (server)", NowUs() - Start);
+    Start = NowUs();
+    Status = ServerConfig.IsValid() ? ServerConfig.LoadCredential(&CertConfig) : ServerConfig.GetInitStatus();
+    PrintPhase("LoadCredential (server, cert parse)", NowUs() - Start);
+    if (QUIC_FAILED(Status)) {
+        printf("Server configuration failed, 0x%x\n", Status);
+        return false;
+    }
+
+    Start = NowUs();
+    MsQuicAutoAcceptListener Listener(Registration, ServerConfig, ServerConnectionCallback);
+    QuicAddr ServerAddress(QUIC_ADDRESS_FAMILY_INET, true);
+    if (QUIC_FAILED(Status = Listener.Start(Alpn, &ServerAddress.SockAddr)) ||
+        QUIC_FAILED(Status = Listener.GetLocalAddr(ServerAddress))) {
+        printf("Failed to start the listener, 0x%x\n", Status);
+        return false;
+    }
+    PrintPhase("ListenerStart", NowUs() - Start);
+
+    ClientState State;
+    const uint64_t ConnectionStart = NowUs();
+    MsQuicConnection Connection(Registration, CleanUpManual, ClientConnectionCallback, &State);
+    if (!Connection.IsValid()) {
+        printf("ConnectionOpen failed, 0x%x\n", Connection.GetInitStatus());
+        return false;
+    }
+    if (QUIC_FAILED(Status = Connection.Start(ClientConfig, "localhost", ServerAddress.GetPort()))) {
+        printf("ConnectionStart failed, 0x%x\n", Status);
+        return false;
+    }
+    PrintPhase("ConnectionOpen + ConnectionStart", NowUs() - ConnectionStart);
+
+    //
+    // The request is queued until the handshake completes.
+    //
+    MsQuicStream Stream(Connection, QUIC_STREAM_OPEN_FLAG_NONE, CleanUpManual, ClientStreamCallback, &State);
+    if (!Stream.IsValid() ||
+        QUIC_FAILED(Status = Stream.Send(&Request, 1, QUIC_SEND_FLAG_START | QUIC_SEND_FLAG_FIN))) {
+        printf("Failed to send the request\n");
+        return false;
+    }
+
+    if (!CxPlatEventWaitWithTimeout(State.Done, 10 * 1000) || State.FirstByteTime == 0) {
+        printf("No response\n");
+        return false;
+    }
+    PrintPhase("Handshake", State.ConnectedTime - ConnectionStart);
+    const uint64_t FirstByteUs = State.FirstByteTime - ConnectionStart;
+    PrintPhase("Time to first byte", FirstByteUs);
+
+    if (MaxFirstByteUs != 0 && FirstByteUs > MaxFirstByteUs) {
+        printf("\nFAILED: time to first byte is over the limit of %llu us\n",
+            (unsigned long long)MaxFirstByteUs);
+        return false;
+    }
+    return true;
+}
+
+void PrintUsage() {
+    printf("Usage: quicstartup [options]\n"
+        "\n"
+        "  -max_ttfb_us:<us>   Fail if the time to first byte is over this. (def:0, no limit)\n");
+}
+
+int
+QUIC_MAIN_EXPORT
+main(int argc, char **argv) {
+    if (GetFlag(argc, argv, "?") || GetFlag(argc, argv, "help")) {
+        PrintUsage();
+        return 1;
+    }
+    TryGetValue(argc, argv, "max_ttfb_us", &MaxFirstByteUs);
+
+    const uint64_t ProcessStart = NowUs();
+    MsQuic = new(std::nothrow) MsQuicApi;
+    if (MsQuic == nullptr || QUIC_FAILED(MsQuic->GetInitStatus())) {
+        printf("MsQuicOpen2 failed\n");
+        delete MsQuic;
+        return 1;
+    }
+    PrintPhase("MsQuicOpen2", NowUs() - ProcessStart);
+
+    //
+    // Creating the certificate isn't part of a real cold start; the
+    // credential load below parses it.
+    //
+    auto CertConfig = CxPlatGetSelfSignedCert(CXPLAT_SELF_SIGN_CERT_USER, FALSE, NULL);
+    if (CertConfig == nullptr) {
+        printf("Failed to create a self signed certificate\n");
+        delete MsQuic;
+        return 1;
+    }
+
+    bool Result = RunBenchmark(*CertConfig);
+
+    QUIC_STARTUP_TIMINGS Timings;
+    uint32_t Length = sizeof(Timings);
+    if (QUIC_SUCCEEDED(
+        MsQuic->GetParam(nullptr, QUIC_PARAM_GLOBAL_STARTUP_TIMINGS, &Length, &Timings))) {
+        printf("\nLibrary internals\n");
+        PrintPhase("  library init", Timings.LibraryInitUs);
+        PrintPhase("    platform init", Timings.PlatformInitUs);
+        PrintPhase("      TLS provider init", Timings.CryptoInitUs);
+        PrintPhase("  datapath init", Timings.DatapathInitUs);
+        PrintPhase("    worker pool start", Timings.WorkerPoolStartUs);
+    }
+
+    CxPlatFreeSelfSignedCert(CertConfig);
+    delete MsQuic;
+    return Result ? 0 : 1;
+}